@@ -67,6 +67,49 @@ int arch_dcache_flush_and_invd_range(void *start_addr, size_t size)
 	return 0;
 }
 
+/* Same as the SCB_*DCache_by_Addr() functions but with a single pair of
+ * barriers for the whole list of ranges, instead of one per range.
+ */
+static ALWAYS_INLINE void dcache_ranges_op(const struct sys_cache_range *ranges,
+					   size_t count, volatile uint32_t *op)
+{
+	__DSB();
+
+	for (size_t i = 0; i < count; i++) {
+		uintptr_t addr = ROUND_DOWN((uintptr_t)ranges[i].addr,
+					    __SCB_DCACHE_LINE_SIZE);
+		uintptr_t end = (uintptr_t)ranges[i].addr + ranges[i].size;
+
+		for (; addr < end; addr += __SCB_DCACHE_LINE_SIZE) {
+			*op = addr;
+		}
+	}
+
+	__DSB();
+	__ISB();
+}
+
+int arch_dcache_flush_ranges(const struct sys_cache_range *ranges, size_t count)
+{
+	dcache_ranges_op(ranges, count, &SCB->DCCMVAC);
+
+	return 0;
+}
+
+int arch_dcache_invd_ranges(const struct sys_cache_range *ranges, size_t count)
+{
+	dcache_ranges_op(ranges, count, &SCB->DCIMVAC);
+
+	return 0;
+}
+
+int arch_dcache_flush_and_invd_ranges(const struct sys_cache_range *ranges, size_t count)
+{
+	dcache_ranges_op(ranges, count, &SCB->DCCIMVAC);
+
+	return 0;
+}
+
 void arch_icache_enable(void)
 {
 	SCB_EnableICache();
@@ -0,0 +1,35 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/arch/arm/aarch32/cortex_m/cmsis.h>
+
+/* EXC_RETURN values, which are never return addresses of thread code */
+#define EXC_RETURN_MIN 0xF0000000UL
+
+size_t arch_profiler_sample(uintptr_t *buf, size_t size)
+{
+	/*
+	 * Threads run on the process stack, on which the exception entry
+	 * stacked the basic frame of the interrupted thread. If the interrupt
+	 * preempted another one, this is the frame of the thread which that
+	 * interrupt preempted.
+	 */
+	const struct __basic_sf *frame = (const struct __basic_sf *)__get_PSP();
+	size_t count = 0;
+
+	buf[count++] = frame->pc;
+
+	/*
+	 * Without unwind tables, the link register is the only caller known,
+	 * which is exact for leaf functions.
+	 */
+	if (count < size && frame->lr < EXC_RETURN_MIN) {
+		buf[count++] = frame->lr & ~1UL;
+	}
+
+	return count;
+}
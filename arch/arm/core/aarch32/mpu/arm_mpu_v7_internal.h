@@ -21,6 +21,56 @@ static void mpu_init(void)
 	/* No specific configuration at init for ARMv7-M MPU. */
 }
 
+#if defined(CONFIG_ARM_MPU_REGION_CACHE)
+/* Number of MPU regions whose configuration is cached, regions above are
+ * always programmed.
+ */
+#define REGION_CACHE_SIZE 16
+
+/* Configuration last programmed into each MPU region */
+static struct arm_mpu_region region_cache[REGION_CACHE_SIZE];
+
+/* MPU regions holding their configuration in region_cache, and MPU
+ * regions known to be disabled
+ */
+static uint32_t region_cache_valid;
+static uint32_t region_cache_clear;
+
+/* This internal function records the configuration of an MPU region,
+ * returning true if the region already holds it.
+ */
+static bool region_cache_update(const uint32_t index,
+	const struct arm_mpu_region *region_conf)
+{
+	struct arm_mpu_region *cached;
+
+	if (index >= REGION_CACHE_SIZE) {
+		return false;
+	}
+
+	cached = &region_cache[index];
+
+	if (((region_cache_valid & BIT(index)) != 0U) &&
+	    (cached->base == region_conf->base) &&
+#if defined(CONFIG_CPU_AARCH32_CORTEX_R)
+	    (cached->size == region_conf->size) &&
+#endif
+	    (cached->attr.rasr == region_conf->attr.rasr)) {
+		return true;
+	}
+
+	cached->base = region_conf->base;
+#if defined(CONFIG_CPU_AARCH32_CORTEX_R)
+	cached->size = region_conf->size;
+#endif
+	cached->attr.rasr = region_conf->attr.rasr;
+	region_cache_valid |= BIT(index);
+	region_cache_clear &= ~BIT(index);
+
+	return false;
+}
+#endif /* CONFIG_ARM_MPU_REGION_CACHE */
+
 /* This internal function performs MPU region initialization.
  *
  * Note:
@@ -29,6 +79,12 @@ static void mpu_init(void)
 static void region_init(const uint32_t index,
 	const struct arm_mpu_region *region_conf)
 {
+#if defined(CONFIG_ARM_MPU_REGION_CACHE)
+	if (region_cache_update(index, region_conf)) {
+		return;
+	}
+#endif
+
 	/* Select the region you want to access */
 	set_region_number(index);
 
@@ -202,6 +258,23 @@ static inline int mpu_buffer_validate(void *addr, size_t size, int write)
 
 #endif /* CONFIG_USERSPACE */
 
+/* This internal function disables an MPU region. */
+static void region_clear(const uint32_t index)
+{
+#if defined(CONFIG_ARM_MPU_REGION_CACHE)
+	if (index < REGION_CACHE_SIZE) {
+		if ((region_cache_clear & BIT(index)) != 0U) {
+			return;
+		}
+
+		region_cache_clear |= BIT(index);
+		region_cache_valid &= ~BIT(index);
+	}
+#endif
+
+	ARM_MPU_ClrRegion(index);
+}
+
 static int mpu_configure_region(const uint8_t index,
 	const struct z_arm_mpu_partition *new_region);
 
@@ -262,7 +335,7 @@ static int mpu_configure_dynamic_mpu_regions(const struct z_arm_mpu_partition
 
 		/* Disable the non-programmed MPU regions. */
 		for (int i = mpu_reg_index; i < get_num_regions(); i++) {
-			ARM_MPU_ClrRegion(i);
+			region_clear(i);
 		}
 	}
 
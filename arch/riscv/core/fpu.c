@@ -7,7 +7,7 @@
 
 #include <zephyr/kernel.h>
 #include <zephyr/kernel_structs.h>
-#include <kernel_arch_interface.h>
+#include <kernel_internal.h>
 #include <zephyr/sys/atomic.h>
 
 /* to be found in fpu.S */
@@ -118,7 +118,11 @@ void z_riscv_flush_local_fpu(void)
 		}
 
 		/* dirty means active use */
+#ifdef CONFIG_FPU_LAZY_SWITCH_HISTORY
+		z_fpu_usage_record(owner, dirty);
+#else
 		owner->arch.fpu_recently_used = dirty;
+#endif
 
 		/* disable FPU access */
 		csr_clear(mstatus, MSTATUS_FS);
@@ -243,6 +247,20 @@ void z_riscv_fpu_trap(z_arch_esf_t *esf)
 	z_riscv_fpu_load();
 }
 
+/*
+ * Whether the thread is expected to use the FPU again soon: it did so in
+ * the last period it owned the FPU, or with the usage history in enough
+ * of its recent ones.
+ */
+static inline bool fpu_used_often(struct k_thread *thread)
+{
+#ifdef CONFIG_FPU_LAZY_SWITCH_HISTORY
+	return z_fpu_usage_frequent(thread);
+#else
+	return thread->arch.fpu_recently_used;
+#endif
+}
+
 /*
  * Perform lazy FPU context switching by simply granting or denying
  * access to FP regs based on FPU ownership before leaving the last
@@ -262,7 +280,7 @@ static bool fpu_access_allowed(unsigned int exc_update_level)
 			/* everything is already in place */
 			return true;
 		}
-		if (_current->arch.fpu_recently_used) {
+		if (fpu_used_often(_current)) {
 			/*
 			 * Before this thread was context-switched out,
 			 * it made active use of the FPU, but someone else
@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <kernel_internal.h>
+
+static inline bool in_thread_stack(const struct k_thread *thread, uintptr_t addr)
+{
+#if defined(CONFIG_THREAD_STACK_INFO)
+	return addr > thread->stack_info.start &&
+	       addr <= thread->stack_info.start + thread->stack_info.size &&
+	       (addr & (sizeof(uintptr_t) - 1)) == 0;
+#else
+	return false;
+#endif
+}
+
+size_t arch_profiler_sample(uintptr_t *buf, size_t size)
+{
+	/*
+	 * On entry to the first level interrupt, _isr_wrapper saves the
+	 * exception stack frame on the thread stack, then the thread stack
+	 * pointer below the top of the interrupt stack.
+	 */
+	const z_arch_esf_t *esf =
+		*(const z_arch_esf_t **)(_current_cpu->irq_stack - 16);
+	const struct k_thread *thread = _current;
+	uintptr_t *fp;
+	size_t count = 0;
+
+	buf[count++] = esf->mepc;
+
+	if (IS_ENABLED(CONFIG_OMIT_FRAME_POINTER) ||
+	    !IS_ENABLED(CONFIG_OVERRIDE_FRAME_POINTER_DEFAULT)) {
+		return count;
+	}
+
+	/*
+	 * In the prologue and epilogue of a function s0 is still the frame
+	 * pointer of its caller, whose return address is then only in ra.
+	 * Otherwise ra duplicates the function or its caller, which the host
+	 * script folds.
+	 */
+	if (count < size) {
+		buf[count++] = esf->ra;
+	}
+
+	/* Frames hold the return address then the frame pointer of the caller
+	 * just below the frame pointer.
+	 */
+	fp = (uintptr_t *)esf->s0;
+	while (count < size && in_thread_stack(thread, (uintptr_t)fp)) {
+		uintptr_t *caller_fp = (uintptr_t *)fp[-2];
+
+		buf[count++] = fp[-1];
+
+		/* The stack grows down, caller frames are above */
+		if (caller_fp <= fp) {
+			break;
+		}
+
+		fp = caller_fp;
+	}
+
+	return count;
+}
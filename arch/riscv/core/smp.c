@@ -69,14 +69,15 @@ static atomic_val_t cpu_pending_ipi[CONFIG_MP_MAX_NUM_CPUS];
 #define IPI_SCHED	0
 #define IPI_FPU_FLUSH	1
 
-void arch_sched_ipi(void)
+static void send_sched_ipi(uint32_t cpu_bitmap)
 {
 	unsigned int key = arch_irq_lock();
 	unsigned int id = _current_cpu->id;
 	unsigned int num_cpus = arch_num_cpus();
 
 	for (unsigned int i = 0; i < num_cpus; i++) {
-		if (i != id && _kernel.cpus[i].arch.online) {
+		if ((i != id) && _kernel.cpus[i].arch.online &&
+		    ((cpu_bitmap & BIT(i)) != 0)) {
 			atomic_set_bit(&cpu_pending_ipi[i], IPI_SCHED);
 			MSIP(_kernel.cpus[i].arch.hartid) = 1;
 		}
@@ -85,6 +86,16 @@ void arch_sched_ipi(void)
 	arch_irq_unlock(key);
 }
 
+void arch_sched_ipi(void)
+{
+	send_sched_ipi(BIT_MASK(CONFIG_MP_MAX_NUM_CPUS));
+}
+
+void arch_sched_directed_ipi(uint32_t cpu_bitmap)
+{
+	send_sched_ipi(cpu_bitmap);
+}
+
 #ifdef CONFIG_FPU_SHARING
 void z_riscv_flush_fpu_ipi(unsigned int cpu)
 {
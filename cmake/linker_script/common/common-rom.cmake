@@ -92,6 +92,9 @@ if(CONFIG_NET_SOCKETS)
   zephyr_iterable_section(NAME net_socket_register KVMA RAM_REGION GROUP RODATA_REGION SUBALIGN 4)
 endif()
 
+if(CONFIG_NET_TCP_CONGESTION_AVOIDANCE)
+  zephyr_iterable_section(NAME tcp_ca_ops KVMA RAM_REGION GROUP RODATA_REGION SUBALIGN 4)
+endif()
 
 if(CONFIG_NET_L2_PPP)
   zephyr_iterable_section(NAME ppp_protocol_handler KVMA RAM_REGION GROUP RODATA_REGION SUBALIGN 4)
@@ -210,6 +213,10 @@ if(CONFIG_INPUT)
   zephyr_iterable_section(NAME input_listener KVMA RAM_REGION GROUP RODATA_REGION SUBALIGN 4)
 endif()
 
+if(CONFIG_INPUT_FRAMES)
+  zephyr_iterable_section(NAME input_frame_listener KVMA RAM_REGION GROUP RODATA_REGION SUBALIGN 4)
+endif()
+
 if(CONFIG_USBD_MSC_CLASS)
   zephyr_iterable_section(NAME usbd_msc_lun KVMA RAM_REGION GROUP RODATA_REGION SUBALIGN 4)
 endif()
@@ -1323,14 +1323,27 @@ endmacro()
 # This directive will relocate the target my_lib to SRAM:
 # zephyr_code_relocate(LIBRARY my_lib SRAM)
 #
+# The FUNCTIONS directive will relocate only the code of the given functions,
+# relying on each function being built in its own section (see
+# arch/common/CMakeLists.txt). Functions are looked up in the FILES or
+# LIBRARY given, or in all the object files of the build if none is given.
+# This directive will relocate two functions of the kernel to ITCM:
+# zephyr_code_relocate(FUNCTIONS z_add_timeout z_abort_timeout LOCATION ITCM_TEXT)
+#
+# The PROFILE directive is the same as FUNCTIONS but reads the function
+# names from a file, one per line, as printed by
+# scripts/profiling/profiler_report.py --hot. Lines starting with # are
+# ignored.
+# zephyr_code_relocate(PROFILE hot.txt LOCATION ITCM_TEXT)
+#
 # The following optional arguments are supported:
 # - NOCOPY: this flag indicates that the file data does not need to be copied
 #   at boot time (For example, for flash XIP).
 # - PHDR [program_header]: add program header. Used on Xtensa platforms.
 function(zephyr_code_relocate)
   set(options NOCOPY)
-  set(single_args LIBRARY LOCATION PHDR)
-  set(multi_args FILES)
+  set(single_args LIBRARY LOCATION PHDR PROFILE)
+  set(multi_args FILES FUNCTIONS)
   cmake_parse_arguments(CODE_REL "${options}" "${single_args}"
     "${multi_args}" ${ARGN})
   # Argument validation
@@ -1338,9 +1351,31 @@ function(zephyr_code_relocate)
     message(FATAL_ERROR "zephyr_code_relocate(${ARGV0} ...) "
       "given unknown arguments: ${CODE_REL_UNPARSED_ARGUMENTS}")
   endif()
-  if((NOT CODE_REL_FILES) AND (NOT CODE_REL_LIBRARY))
-    message(FATAL_ERROR
-      "zephyr_code_relocate() requires either FILES or LIBRARY be provided")
+  if(CODE_REL_PROFILE)
+    if(NOT IS_ABSOLUTE ${CODE_REL_PROFILE})
+      set(CODE_REL_PROFILE ${CMAKE_CURRENT_SOURCE_DIR}/${CODE_REL_PROFILE})
+    endif()
+    if(NOT EXISTS ${CODE_REL_PROFILE})
+      message(FATAL_ERROR "zephyr_code_relocate() PROFILE file "
+        "${CODE_REL_PROFILE} not found")
+    endif()
+    file(STRINGS ${CODE_REL_PROFILE} profile_functions REGEX "^[^#]")
+    foreach(function ${profile_functions})
+      string(STRIP "${function}" function)
+      list(APPEND CODE_REL_FUNCTIONS ${function})
+    endforeach()
+    set_property(DIRECTORY APPEND PROPERTY CMAKE_CONFIGURE_DEPENDS
+      ${CODE_REL_PROFILE})
+    if(NOT CODE_REL_FUNCTIONS)
+      message(WARNING "zephyr_code_relocate() PROFILE file "
+        "${CODE_REL_PROFILE} lists no function, nothing is relocated")
+      return()
+    endif()
+  endif()
+  if((NOT CODE_REL_FILES) AND (NOT CODE_REL_LIBRARY) AND
+     (NOT CODE_REL_FUNCTIONS))
+    message(FATAL_ERROR "zephyr_code_relocate() requires either FILES, "
+      "LIBRARY, FUNCTIONS or PROFILE be provided")
   endif()
   if(CODE_REL_FILES AND CODE_REL_LIBRARY)
     message(FATAL_ERROR "zephyr_code_relocate() only accepts "
@@ -1386,6 +1421,12 @@ function(zephyr_code_relocate)
   if(CODE_REL_PHDR)
     set(CODE_REL_LOCATION "${CODE_REL_LOCATION}\ :${CODE_REL_PHDR}")
   endif()
+  if(CODE_REL_FUNCTIONS)
+    # Function names never contain ":", so the function list is appended
+    # after the file list and split from its end.
+    string(REPLACE ";" "," function_list "${CODE_REL_FUNCTIONS}")
+    set(file_list "${file_list}:FUNCTIONS:${function_list}")
+  endif()
   # We use the "|" character to separate code relocation directives instead
   # of using CMake lists. This way, the ";" character can be reserved for
   # generator expression file lists.
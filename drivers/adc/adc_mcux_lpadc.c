@@ -52,6 +52,18 @@ struct mcux_lpadc_data {
 	uint16_t *repeat_buffer;
 	uint32_t channels;
 	lpadc_conv_command_config_t cmd_config[CONFIG_LPADC_CHANNEL_COUNT];
+#ifdef CONFIG_ADC_STREAM
+	adc_stream_callback stream_callback;
+	void *stream_user_data;
+	uint16_t *stream_buffer;
+	/* number of samples in each half of the buffer */
+	size_t stream_count;
+	size_t stream_pos;
+	uint64_t stream_timestamp;
+	uint8_t stream_resolution;
+	/* channel of the command looping back to the first one */
+	uint8_t stream_loop;
+#endif /* CONFIG_ADC_STREAM */
 };
 
 
@@ -147,7 +159,8 @@ static int mcux_lpadc_channel_setup(const struct device *dev,
 	return 0;
 }
 
-static int mcux_lpadc_start_read(const struct device *dev,
+/* Set up and chain the conversion commands of the channels of a sequence */
+static int mcux_lpadc_setup_sequence(const struct device *dev,
 		 const struct adc_sequence *sequence)
 {
 	const struct mcux_lpadc_config *config = dev->config;
@@ -245,10 +258,24 @@ static int mcux_lpadc_start_read(const struct device *dev,
 		}
 	};
 
+	return 0;
+}
+
+static int mcux_lpadc_start_read(const struct device *dev,
+		 const struct adc_sequence *sequence)
+{
+	struct mcux_lpadc_data *data = dev->data;
+	int error;
+
+	error = mcux_lpadc_setup_sequence(dev, sequence);
+	if (error) {
+		return error;
+	}
+
 	data->buffer = sequence->buffer;
 
 	adc_context_start_read(&data->ctx, sequence);
-	int error = adc_context_wait_for_completion(&data->ctx);
+	error = adc_context_wait_for_completion(&data->ctx);
 
 	return error;
 }
@@ -318,27 +345,24 @@ static void adc_context_update_buffer_pointer(struct adc_context *ctx,
 	}
 }
 
-static void mcux_lpadc_isr(const struct device *dev)
+static bool mcux_lpadc_get_result(ADC_Type *base, lpadc_conv_result_t *conv_result)
 {
-	const struct mcux_lpadc_config *config = dev->config;
-	struct mcux_lpadc_data *data = dev->data;
-	ADC_Type *base = config->base;
-
-	lpadc_conv_result_t conv_result;
-	lpadc_sample_channel_mode_t conv_mode;
-	int16_t result;
-	uint16_t channel;
-
 #if (defined(FSL_FEATURE_LPADC_FIFO_COUNT) \
 	&& (FSL_FEATURE_LPADC_FIFO_COUNT == 2U))
-	LPADC_GetConvResult(base, &conv_result, 0U);
+	return LPADC_GetConvResult(base, conv_result, 0U);
 #else
-	LPADC_GetConvResult(base, &conv_result);
+	return LPADC_GetConvResult(base, conv_result);
 #endif /* FSL_FEATURE_LPADC_FIFO_COUNT */
+}
+
+static int16_t mcux_lpadc_result_value(struct mcux_lpadc_data *data,
+				       const lpadc_conv_result_t *conv_result,
+				       uint8_t resolution)
+{
+	lpadc_sample_channel_mode_t conv_mode;
+	uint16_t channel = conv_result->commandIdSource - 1;
+	int16_t result;
 
-	channel = conv_result.commandIdSource - 1;
-	LOG_DBG("Finished channel %d. Raw result is 0x%04x",
-		channel, conv_result.convValue);
 	/*
 	 * For 12 or 13 bit resolution the the LSBs will be 0, so a bit shift
 	 * is needed. For differential modes, the ADC conversion to
@@ -349,24 +373,89 @@ static void mcux_lpadc_isr(const struct device *dev)
 	 * in differential mode
 	 */
 	conv_mode = data->cmd_config[channel].sampleChannelMode;
-	if (data->ctx.sequence.resolution < 15) {
-		result = ((conv_result.convValue >> 3) & 0xFFF);
+	if (resolution < 15) {
+		result = ((conv_result->convValue >> 3) & 0xFFF);
 #if defined(FSL_FEATURE_LPADC_HAS_CMDL_DIFF) && FSL_FEATURE_LPADC_HAS_CMDL_DIFF
 		if (conv_mode == kLPADC_SampleChannelDiffBothSideAB ||
 		    conv_mode == kLPADC_SampleChannelDiffBothSideBA) {
 #else
 		if (conv_mode == kLPADC_SampleChannelDiffBothSide) {
 #endif
-			if ((conv_result.convValue & 0x8000)) {
+			if ((conv_result->convValue & 0x8000)) {
 				/* 13 bit mode, MSB is sign bit. (2's complement) */
 				result -= 0x1000;
 			}
 		}
-		*data->buffer++ = result;
-	} else {
-		*data->buffer++ = conv_result.convValue;
+		return result;
 	}
 
+	return conv_result->convValue;
+}
+
+#ifdef CONFIG_ADC_STREAM
+static void mcux_lpadc_stream_isr(const struct device *dev)
+{
+	const struct mcux_lpadc_config *config = dev->config;
+	struct mcux_lpadc_data *data = dev->data;
+	lpadc_conv_result_t conv_result;
+	struct adc_stream_data stream_data;
+	size_t samplings;
+	uint64_t timestamp;
+
+	/* Drain the FIFO, the conversions go on in the meantime */
+	while (data->stream_callback != NULL &&
+	       mcux_lpadc_get_result(config->base, &conv_result)) {
+		data->stream_buffer[data->stream_pos++] =
+			mcux_lpadc_result_value(data, &conv_result, data->stream_resolution);
+
+		if (data->stream_pos % data->stream_count != 0) {
+			continue;
+		}
+
+		/* One half of the buffer is filled, the other one is next */
+		timestamp = k_ticks_to_ns_floor64(k_uptime_ticks());
+		samplings = data->stream_count / POPCOUNT(data->channels);
+
+		stream_data.buffer = &data->stream_buffer[data->stream_pos - data->stream_count];
+		stream_data.size = data->stream_count * sizeof(uint16_t);
+		stream_data.timestamp_ns = timestamp;
+		stream_data.period_ns = data->stream_timestamp == 0 ? 0 :
+					(timestamp - data->stream_timestamp) / samplings;
+		data->stream_timestamp = timestamp;
+
+		if (data->stream_pos == 2 * data->stream_count) {
+			data->stream_pos = 0;
+		}
+
+		data->stream_callback(dev, 0, &stream_data, data->stream_user_data);
+	}
+}
+#endif /* CONFIG_ADC_STREAM */
+
+static void mcux_lpadc_isr(const struct device *dev)
+{
+	const struct mcux_lpadc_config *config = dev->config;
+	struct mcux_lpadc_data *data = dev->data;
+	ADC_Type *base = config->base;
+
+	lpadc_conv_result_t conv_result;
+	uint16_t channel;
+
+#ifdef CONFIG_ADC_STREAM
+	if (data->stream_callback != NULL) {
+		mcux_lpadc_stream_isr(dev);
+		return;
+	}
+#endif /* CONFIG_ADC_STREAM */
+
+	mcux_lpadc_get_result(base, &conv_result);
+
+	channel = conv_result.commandIdSource - 1;
+	LOG_DBG("Finished channel %d. Raw result is 0x%04x",
+		channel, conv_result.convValue);
+
+	*data->buffer++ = mcux_lpadc_result_value(data, &conv_result,
+						  data->ctx.sequence.resolution);
 
 	data->channels &= ~BIT(channel);
 
@@ -379,6 +468,98 @@ static void mcux_lpadc_isr(const struct device *dev)
 	}
 }
 
+#ifdef CONFIG_ADC_STREAM
+static int mcux_lpadc_stream_start(const struct device *dev,
+				   const struct adc_sequence *sequence,
+				   adc_stream_callback callback, void *user_data)
+{
+	const struct mcux_lpadc_config *config = dev->config;
+	struct mcux_lpadc_data *data = dev->data;
+	uint8_t channel_count = POPCOUNT(sequence->channels);
+	uint8_t first;
+	int error;
+
+	if (callback == NULL || channel_count == 0) {
+		return -EINVAL;
+	}
+
+	if (sequence->options != NULL && sequence->options->interval_us != 0) {
+		LOG_ERR("Continuous sampling is paced by the ADC clock");
+		return -ENOTSUP;
+	}
+
+	if (sequence->buffer_size < 2 * channel_count * sizeof(uint16_t)) {
+		LOG_ERR("Provided buffer is too small");
+		return -ENOMEM;
+	}
+
+	adc_context_lock(&data->ctx, false, NULL);
+
+	error = mcux_lpadc_setup_sequence(dev, sequence);
+	if (error) {
+		adc_context_release(&data->ctx, error);
+		return error;
+	}
+
+	/* Loop the last command of the chain back to the first one */
+	first = find_lsb_set(sequence->channels) - 1;
+	data->stream_loop = find_msb_set(sequence->channels) - 1;
+	data->cmd_config[data->stream_loop].chainedNextCommandNumber = first + 1;
+	LPADC_SetConvCommandConfig(config->base, data->stream_loop + 1,
+				   &data->cmd_config[data->stream_loop]);
+
+	/* Each half of the buffer holds whole samplings */
+	data->stream_buffer = sequence->buffer;
+	data->stream_count = sequence->buffer_size / (2 * channel_count * sizeof(uint16_t)) *
+			     channel_count;
+	data->stream_pos = 0;
+	data->stream_timestamp = 0;
+	data->stream_resolution = sequence->resolution;
+	data->stream_user_data = user_data;
+	data->channels = sequence->channels;
+	data->stream_callback = callback;
+
+	mcux_lpadc_start_channel(dev);
+
+	/* The device is released when the sampling stops */
+	return 0;
+}
+
+static int mcux_lpadc_stream_stop(const struct device *dev)
+{
+	const struct mcux_lpadc_config *config = dev->config;
+	struct mcux_lpadc_data *data = dev->data;
+	ADC_Type *base = config->base;
+	unsigned int key;
+
+	if (data->stream_callback == NULL) {
+		return -EALREADY;
+	}
+
+	key = irq_lock();
+	data->stream_callback = NULL;
+	irq_unlock(key);
+
+	/* End the chain again, and let the conversion in progress finish */
+	data->cmd_config[data->stream_loop].chainedNextCommandNumber = 0;
+	LPADC_SetConvCommandConfig(base, data->stream_loop + 1,
+				   &data->cmd_config[data->stream_loop]);
+	while ((base->STAT & ADC_STAT_ADC_ACTIVE_MASK) != 0U) {
+	}
+
+#if (defined(FSL_FEATURE_LPADC_FIFO_COUNT) \
+	&& (FSL_FEATURE_LPADC_FIFO_COUNT == 2U))
+	LPADC_DoResetFIFO0(base);
+#else
+	LPADC_DoResetFIFO(base);
+#endif /* FSL_FEATURE_LPADC_FIFO_COUNT */
+
+	adc_context_release(&data->ctx, 0);
+
+	return 0;
+}
+#endif /* CONFIG_ADC_STREAM */
+
 static int mcux_lpadc_init(const struct device *dev)
 {
 	const struct mcux_lpadc_config *config = dev->config;
@@ -453,6 +634,10 @@ static const struct adc_driver_api mcux_lpadc_driver_api = {
 #ifdef CONFIG_ADC_ASYNC
 	.read_async = mcux_lpadc_read_async,
 #endif
+#ifdef CONFIG_ADC_STREAM
+	.stream_start = mcux_lpadc_stream_start,
+	.stream_stop = mcux_lpadc_stream_stop,
+#endif
 };
 
 
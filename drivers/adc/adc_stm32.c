@@ -126,6 +126,10 @@ static const uint32_t table_seq_len[] = {
 /* Number of different sampling time values */
 #define STM32_NB_SAMPLING_TIME	8
 
+#if defined(CONFIG_ADC_STREAM) && defined(CONFIG_ADC_STM32_DMA)
+#define HAS_STREAM
+#endif
+
 #ifdef CONFIG_ADC_STM32_DMA
 struct stream {
 	const struct device *dma_dev;
@@ -154,6 +158,14 @@ struct adc_stm32_data {
 	volatile int dma_error;
 	struct stream dma;
 #endif
+
+#ifdef HAS_STREAM
+	adc_stream_callback stream_callback;
+	void *stream_user_data;
+	/* size of each half of the buffer */
+	size_t stream_size;
+	uint64_t stream_timestamp;
+#endif /* HAS_STREAM */
 };
 
 struct adc_stm32_cfg {
@@ -176,7 +188,7 @@ static bool init_irq = true;
 
 #ifdef CONFIG_ADC_STM32_DMA
 static int adc_stm32_dma_start(const struct device *dev,
-			       void *buffer, size_t channel_count)
+			       void *buffer, size_t channel_count, bool circular)
 {
 	const struct adc_stm32_cfg *config = dev->config;
 	ADC_TypeDef *adc = (ADC_TypeDef *)config->base;
@@ -194,11 +206,11 @@ static int adc_stm32_dma_start(const struct device *dev,
 	/* Source and destination */
 	blk_cfg->source_address = (uint32_t)LL_ADC_DMA_GetRegAddr(adc, LL_ADC_DMA_REG_REGULAR_DATA);
 	blk_cfg->source_addr_adj = DMA_ADDR_ADJ_NO_CHANGE;
-	blk_cfg->source_reload_en = 0;
+	blk_cfg->source_reload_en = circular;
 
 	blk_cfg->dest_address = (uint32_t)buffer;
 	blk_cfg->dest_addr_adj = DMA_ADDR_ADJ_INCREMENT;
-	blk_cfg->dest_reload_en = 0;
+	blk_cfg->dest_reload_en = circular;
 
 	/* Manually set the FIFO threshold to 1/4 because the
 	 * dmamux DTS entry does not contain fifo threshold
@@ -216,20 +228,26 @@ static int adc_stm32_dma_start(const struct device *dev,
 		return ret;
 	}
 
-	/* Allow ADC to create DMA request and set to one-shot mode,
-	 * as implemented in HAL drivers, if applicable.
+	/* Allow ADC to create DMA request and set to one-shot mode, or to keep
+	 * requesting it for a circular transfer, as implemented in HAL drivers,
+	 * if applicable.
 	 */
 #if defined(ADC_VER_V5_V90)
+	uint32_t mode = circular ? LL_ADC_REG_DMA_TRANSFER_UNLIMITED
+				 : LL_ADC_REG_DMA_TRANSFER_LIMITED;
+
 	if (adc == ADC3) {
-		LL_ADC_REG_SetDMATransferMode(adc,
-			ADC3_CFGR_DMACONTREQ(LL_ADC_REG_DMA_TRANSFER_LIMITED));
+		LL_ADC_REG_SetDMATransferMode(adc, ADC3_CFGR_DMACONTREQ(mode));
 		LL_ADC_EnableDMAReq(adc);
 	} else {
-		LL_ADC_REG_SetDataTransferMode(adc,
-			ADC_CFGR_DMACONTREQ(LL_ADC_REG_DMA_TRANSFER_LIMITED));
+		LL_ADC_REG_SetDataTransferMode(adc, ADC_CFGR_DMACONTREQ(mode));
 	}
 #elif defined(ADC_VER_V5_X)
-	LL_ADC_REG_SetDataTransferMode(adc, LL_ADC_REG_DMA_TRANSFER_LIMITED);
+	LL_ADC_REG_SetDataTransferMode(adc, circular ? LL_ADC_REG_DMA_TRANSFER_UNLIMITED
+						     : LL_ADC_REG_DMA_TRANSFER_LIMITED);
+#elif defined(HAS_STREAM) && defined(LL_ADC_REG_DMA_TRANSFER_LIMITED)
+	LL_ADC_REG_SetDMATransfer(adc, circular ? LL_ADC_REG_DMA_TRANSFER_UNLIMITED
+						: LL_ADC_REG_DMA_TRANSFER_LIMITED);
 #endif
 
 	data->dma_error = 0;
@@ -704,6 +722,60 @@ static void adc_stm32_teardown_channels(const struct device *dev)
 	adc_stm32_enable(adc);
 }
 
+#ifdef HAS_STREAM
+static void adc_stm32_stream_teardown(const struct device *dev)
+{
+	const struct adc_stm32_cfg *config = dev->config;
+	struct adc_stm32_data *data = dev->data;
+	ADC_TypeDef *adc = (ADC_TypeDef *)config->base;
+	unsigned int key;
+
+	key = irq_lock();
+	data->stream_callback = NULL;
+	irq_unlock(key);
+
+#if !defined(CONFIG_SOC_SERIES_STM32F1X) && \
+	!DT_HAS_COMPAT_STATUS_OKAY(st_stm32f4_adc)
+	LL_ADC_REG_StopConversion(adc);
+	while (LL_ADC_REG_IsStopConversionOngoing(adc) != 0) {
+	}
+#endif
+	LL_ADC_REG_SetContinuousMode(adc, LL_ADC_REG_CONV_SINGLE);
+
+	dma_stop(data->dma.dma_dev, data->dma.channel);
+	adc_stm32_teardown_channels(dev);
+}
+
+/* The DMA is half way through the buffer, or wrapped around it */
+static void adc_stm32_stream_event(const struct device *dev, int status)
+{
+	struct adc_stm32_data *data = dev->data;
+	adc_stream_callback callback = data->stream_callback;
+	void *user_data = data->stream_user_data;
+	uint64_t timestamp = k_ticks_to_ns_floor64(k_uptime_ticks());
+	size_t count = data->stream_size / (data->channel_count * sizeof(uint16_t));
+	struct adc_stream_data stream_data;
+
+	if (status < 0) {
+		LOG_ERR("Continuous sampling stopped, DMA reported error %d", status);
+		adc_stm32_stream_teardown(dev);
+		adc_context_release(&data->ctx, 0);
+		callback(dev, status, NULL, user_data);
+		return;
+	}
+
+	stream_data.buffer = (uint8_t *)data->repeat_buffer +
+			     (status == DMA_STATUS_BLOCK ? 0 : data->stream_size);
+	stream_data.size = data->stream_size;
+	stream_data.timestamp_ns = timestamp;
+	stream_data.period_ns = data->stream_timestamp == 0 ? 0 :
+				(timestamp - data->stream_timestamp) / count;
+	data->stream_timestamp = timestamp;
+
+	callback(dev, 0, &stream_data, user_data);
+}
+#endif /* HAS_STREAM */
+
 #ifdef CONFIG_ADC_STM32_DMA
 static void dma_callback(const struct device *dev, void *user_data,
 			 uint32_t channel, int status)
@@ -715,6 +787,13 @@ static void dma_callback(const struct device *dev, void *user_data,
 
 	LOG_DBG("dma callback");
 
+#ifdef HAS_STREAM
+	if (channel == data->dma.channel && data->stream_callback != NULL) {
+		adc_stm32_stream_event(data->dev, status);
+		return;
+	}
+#endif /* HAS_STREAM */
+
 	if (channel == data->dma.channel) {
 #if !DT_HAS_COMPAT_STATUS_OKAY(st_stm32f1_adc)
 		if (LL_ADC_IsActiveFlag_OVR(adc) || (status >= 0)) {
@@ -821,8 +900,9 @@ static int set_resolution(const struct device *dev,
 	return 0;
 }
 
-static int start_read(const struct device *dev,
-		      const struct adc_sequence *sequence)
+/* Configure the ADC for the channels, resolution and buffer of a sequence */
+static int adc_stm32_setup_sequence(const struct device *dev,
+				    const struct adc_sequence *sequence)
 {
 	const struct adc_stm32_cfg *config = dev->config;
 	struct adc_stm32_data *data = dev->data;
@@ -993,6 +1073,20 @@ static int start_read(const struct device *dev,
 #endif
 #endif /* CONFIG_ADC_STM32_DMA */
 
+	return 0;
+}
+
+static int start_read(const struct device *dev,
+		      const struct adc_sequence *sequence)
+{
+	struct adc_stm32_data *data = dev->data;
+	int err;
+
+	err = adc_stm32_setup_sequence(dev, sequence);
+	if (err) {
+		return err;
+	}
+
 	/* This call will start the DMA */
 	adc_context_start_read(&data->ctx, sequence);
 
@@ -1014,7 +1108,7 @@ static void adc_context_start_sampling(struct adc_context *ctx)
 	data->repeat_buffer = data->buffer;
 
 #ifdef CONFIG_ADC_STM32_DMA
-	adc_stm32_dma_start(data->dev, data->buffer, data->channel_count);
+	adc_stm32_dma_start(data->dev, data->buffer, data->channel_count, false);
 #endif
 	adc_stm32_start_conversion(data->dev);
 }
@@ -1089,6 +1183,83 @@ static int adc_stm32_read_async(const struct device *dev,
 }
 #endif
 
+#ifdef HAS_STREAM
+static int adc_stm32_stream_start(const struct device *dev,
+				  const struct adc_sequence *sequence,
+				  adc_stream_callback callback, void *user_data)
+{
+	const struct adc_stm32_cfg *config = dev->config;
+	struct adc_stm32_data *data = dev->data;
+	ADC_TypeDef *adc = (ADC_TypeDef *)config->base;
+	size_t sampling_size;
+	int err;
+
+	if (callback == NULL) {
+		return -EINVAL;
+	}
+
+	if (sequence->options != NULL && sequence->options->interval_us != 0) {
+		LOG_ERR("Continuous sampling is paced by the ADC clock");
+		return -ENOTSUP;
+	}
+
+	adc_context_lock(&data->ctx, false, NULL);
+
+	err = adc_stm32_setup_sequence(dev, sequence);
+	if (err) {
+		goto release;
+	}
+
+	sampling_size = data->channel_count * sizeof(uint16_t);
+	if (sequence->buffer_size < 2 * sampling_size) {
+		LOG_ERR("Provided buffer is too small (%u/%u)",
+			sequence->buffer_size, 2 * sampling_size);
+		err = -ENOMEM;
+		goto release;
+	}
+
+	/* Each half of the buffer holds whole samplings */
+	data->stream_size = sequence->buffer_size / (2 * sampling_size) * sampling_size;
+	data->stream_user_data = user_data;
+	data->stream_timestamp = 0;
+	data->repeat_buffer = data->buffer;
+	data->stream_callback = callback;
+
+	err = adc_stm32_dma_start(dev, data->buffer,
+				  2 * data->stream_size / sizeof(uint16_t), true);
+	if (err) {
+		data->stream_callback = NULL;
+		adc_stm32_teardown_channels(dev);
+		goto release;
+	}
+
+	LL_ADC_REG_SetContinuousMode(adc, LL_ADC_REG_CONV_CONTINUOUS);
+	adc_stm32_start_conversion(dev);
+
+	/* The device is released when the sampling stops */
+	return 0;
+
+release:
+	adc_context_release(&data->ctx, err);
+
+	return err;
+}
+
+static int adc_stm32_stream_stop(const struct device *dev)
+{
+	struct adc_stm32_data *data = dev->data;
+
+	if (data->stream_callback == NULL) {
+		return -EALREADY;
+	}
+
+	adc_stm32_stream_teardown(dev);
+	adc_context_release(&data->ctx, 0);
+
+	return 0;
+}
+#endif /* HAS_STREAM */
+
 static int adc_stm32_check_acq_time(const struct device *dev, uint16_t acq_time)
 {
 	const struct adc_stm32_cfg *config =
@@ -1384,6 +1555,10 @@ static const struct adc_driver_api api_stm32_driver_api = {
 	.read = adc_stm32_read,
 #ifdef CONFIG_ADC_ASYNC
 	.read_async = adc_stm32_read_async,
+#endif
+#ifdef HAS_STREAM
+	.stream_start = adc_stm32_stream_start,
+	.stream_stop = adc_stm32_stream_stop,
 #endif
 	.ref_internal = STM32_ADC_VREF_MV, /* VREF is usually connected to VDD */
 };
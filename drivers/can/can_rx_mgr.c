@@ -0,0 +1,435 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+
+#include <zephyr/drivers/can.h>
+#include <zephyr/drivers/can/rx_mgr.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/logging/log.h>
+
+LOG_MODULE_REGISTER(can_rx_mgr, CONFIG_CAN_LOG_LEVEL);
+
+BUILD_ASSERT(IS_POWER_OF_TWO(CONFIG_CAN_RX_MGR_HASH_BUCKETS),
+	     "The number of hash buckets must be a power of two");
+
+/* The hardware filters being merged are tracked in a 32-bit mask */
+BUILD_ASSERT(CONFIG_CAN_RX_MGR_MAX_HW_FILTERS < 32);
+
+/* Flags of which the filters and the frames must agree for a match */
+#define CLASS_FLAGS (CAN_FILTER_IDE | CAN_FILTER_FDF)
+
+static uint32_t id_mask(const struct can_filter *filter)
+{
+	return (filter->flags & CAN_FILTER_IDE) != 0 ? CAN_EXT_ID_MASK : CAN_STD_ID_MASK;
+}
+
+/* Filters of a single identifier are dispatched through the hash table */
+static bool is_exact(const struct can_filter *filter)
+{
+	return filter->mask == id_mask(filter);
+}
+
+static uint32_t hash_id(uint32_t id, uint8_t flags)
+{
+	id ^= (uint32_t)(flags & CLASS_FLAGS) << 29;
+
+	return ((id * 2654435761U) >> 16) & (CONFIG_CAN_RX_MGR_HASH_BUCKETS - 1);
+}
+
+static void dispatch_chain(struct can_rx_mgr *mgr, int16_t idx, struct can_frame *frame,
+			   bool *matched)
+{
+	struct can_rx_mgr_filter *f;
+
+	for (; idx >= 0; idx = f->next) {
+		f = &mgr->filters[idx];
+
+		if (can_frame_matches_filter(frame, &f->filter)) {
+			f->callback(mgr->dev, frame, f->user_data);
+			*matched = true;
+		}
+	}
+}
+
+/* The hardware filters do not overlap, a frame comes through a single one of them */
+static void can_rx_mgr_rx(const struct device *dev, struct can_frame *frame, void *user_data)
+{
+	struct can_rx_mgr *mgr = user_data;
+	bool hash_matched = false;
+	bool list_matched = false;
+	k_spinlock_key_t key;
+	uint8_t flags;
+
+	ARG_UNUSED(dev);
+
+	flags = ((frame->flags & CAN_FRAME_IDE) != 0 ? CAN_FILTER_IDE : 0) |
+		((frame->flags & CAN_FRAME_FDF) != 0 ? CAN_FILTER_FDF : 0);
+
+	key = k_spin_lock(&mgr->lock);
+
+	mgr->stats.frames++;
+
+	dispatch_chain(mgr, mgr->buckets[hash_id(frame->id, flags)], frame, &hash_matched);
+	dispatch_chain(mgr, mgr->masked, frame, &list_matched);
+
+	if (hash_matched) {
+		mgr->stats.hash_hits++;
+	}
+
+	if (list_matched) {
+		mgr->stats.list_hits++;
+	}
+
+	if (!hash_matched && !list_matched) {
+		mgr->stats.unmatched++;
+	}
+
+	k_spin_unlock(&mgr->lock, key);
+}
+
+static bool same_class(const struct can_filter *a, const struct can_filter *b)
+{
+	return (a->flags & CLASS_FLAGS) == (b->flags & CLASS_FLAGS);
+}
+
+static bool overlap(const struct can_filter *a, const struct can_filter *b)
+{
+	return same_class(a, b) && ((a->id ^ b->id) & a->mask & b->mask) == 0;
+}
+
+/* Widen a filter to accept the frames of another one too */
+static void merge(struct can_filter *a, const struct can_filter *b)
+{
+	a->mask = a->mask & b->mask & ~(a->id ^ b->id);
+	a->id &= a->mask;
+	a->flags |= b->flags;
+}
+
+/* Add a filter to the hardware ones, merging it with those it overlaps */
+static void bank_insert(struct can_filter *banks, size_t *n_banks, const struct can_filter *filter)
+{
+	struct can_filter cur = *filter;
+	size_t i = 0;
+
+	cur.id &= cur.mask;
+
+	while (i < *n_banks) {
+		if (overlap(&banks[i], &cur)) {
+			merge(&cur, &banks[i]);
+			banks[i] = banks[--(*n_banks)];
+			i = 0;
+		} else {
+			i++;
+		}
+	}
+
+	banks[(*n_banks)++] = cur;
+}
+
+/* Filter resulting from merging two hardware filters, widened over those it then overlaps */
+static void merge_result(const struct can_filter *banks, size_t n_banks, size_t i, size_t j,
+			 struct can_filter *merged)
+{
+	uint32_t absorbed = BIT(i) | BIT(j);
+	bool changed = true;
+
+	*merged = banks[i];
+	merge(merged, &banks[j]);
+
+	while (changed) {
+		changed = false;
+
+		for (size_t k = 0; k < n_banks; k++) {
+			if ((absorbed & BIT(k)) == 0 && overlap(&banks[k], merged)) {
+				merge(merged, &banks[k]);
+				absorbed |= BIT(k);
+				changed = true;
+			}
+		}
+	}
+}
+
+/* Merge the two hardware filters of the given type resulting in the most specific filter */
+static bool bank_merge_best(struct can_filter *banks, size_t *n_banks, bool ide)
+{
+	struct can_filter merged;
+	struct can_filter best;
+	int best_bits = -1;
+	size_t best_i = 0;
+	size_t best_j = 0;
+	int bits;
+
+	for (size_t i = 0; i < *n_banks; i++) {
+		if (((banks[i].flags & CAN_FILTER_IDE) != 0) != ide) {
+			continue;
+		}
+
+		for (size_t j = i + 1; j < *n_banks; j++) {
+			if (!same_class(&banks[i], &banks[j])) {
+				continue;
+			}
+
+			merge_result(banks, *n_banks, i, j, &merged);
+			bits = POPCOUNT(merged.mask);
+
+			if (bits > best_bits) {
+				best_bits = bits;
+				best = merged;
+				best_i = i;
+				best_j = j;
+			}
+		}
+	}
+
+	if (best_bits < 0) {
+		return false;
+	}
+
+	/* Remove the highest index first, the last bank moves into the removed one */
+	banks[best_j] = banks[--(*n_banks)];
+	banks[best_i] = banks[--(*n_banks)];
+	bank_insert(banks, n_banks, &best);
+
+	return true;
+}
+
+static size_t bank_count(const struct can_filter *banks, size_t n_banks, bool ide)
+{
+	size_t n = 0;
+
+	for (size_t i = 0; i < n_banks; i++) {
+		if (((banks[i].flags & CAN_FILTER_IDE) != 0) == ide) {
+			n++;
+		}
+	}
+
+	return n;
+}
+
+/*
+ * Merge two hardware filters, of the identifiers of the type over its maximum or else of the type
+ * with the most hardware filters, false if none can be merged.
+ */
+static bool bank_reduce(struct can_filter *banks, size_t *n_banks, size_t max_std,
+			size_t max_ext)
+{
+	size_t n_std = bank_count(banks, *n_banks, false);
+	size_t n_ext = bank_count(banks, *n_banks, true);
+	bool ide;
+
+	if (n_std > max_std) {
+		return bank_merge_best(banks, n_banks, false);
+	}
+
+	if (n_ext > max_ext) {
+		return bank_merge_best(banks, n_banks, true);
+	}
+
+	ide = n_ext > n_std;
+
+	return bank_merge_best(banks, n_banks, ide) || bank_merge_best(banks, n_banks, !ide);
+}
+
+static int max_filters(const struct device *dev, bool ide)
+{
+	int ret = can_get_max_filters(dev, ide);
+
+	if (ret < 0) {
+		return CONFIG_CAN_RX_MGR_MAX_HW_FILTERS;
+	}
+
+	return MIN(ret, CONFIG_CAN_RX_MGR_MAX_HW_FILTERS);
+}
+
+static void hw_remove_all(struct can_rx_mgr *mgr)
+{
+	for (uint16_t i = 0; i < mgr->stats.hw_filters; i++) {
+		can_remove_rx_filter(mgr->dev, mgr->hw_ids[i]);
+	}
+
+	mgr->stats.hw_filters = 0;
+}
+
+/* Pack the filters into at most limit hardware filters, and add them to the controller */
+static int hw_pack(struct can_rx_mgr *mgr, size_t limit)
+{
+	struct can_filter banks[CONFIG_CAN_RX_MGR_MAX_HW_FILTERS + 1];
+	size_t max_std = max_filters(mgr->dev, false);
+	size_t max_ext = max_filters(mgr->dev, true);
+	size_t n_banks = 0;
+	int ret;
+
+	for (size_t i = 0; i < ARRAY_SIZE(mgr->filters); i++) {
+		if (!mgr->filters[i].used) {
+			continue;
+		}
+
+		bank_insert(banks, &n_banks, &mgr->filters[i].filter);
+
+		/* Keep room for the next filter */
+		if (n_banks > CONFIG_CAN_RX_MGR_MAX_HW_FILTERS &&
+		    !bank_reduce(banks, &n_banks, max_std, max_ext)) {
+			return -ENOSPC;
+		}
+	}
+
+	while (n_banks > limit || bank_count(banks, n_banks, false) > max_std ||
+	       bank_count(banks, n_banks, true) > max_ext) {
+		if (!bank_reduce(banks, &n_banks, max_std, max_ext)) {
+			return -ENOSPC;
+		}
+	}
+
+	for (size_t i = 0; i < n_banks; i++) {
+		ret = can_add_rx_filter(mgr->dev, can_rx_mgr_rx, mgr, &banks[i]);
+		if (ret < 0) {
+			hw_remove_all(mgr);
+
+			/* Some hardware filters are shared between the types of identifiers */
+			if (ret == -ENOSPC && i > 0) {
+				return hw_pack(mgr, i);
+			}
+
+			return ret;
+		}
+
+		mgr->hw_ids[mgr->stats.hw_filters++] = ret;
+	}
+
+	LOG_DBG("%zu hardware filters", n_banks);
+
+	return 0;
+}
+
+static int hw_update(struct can_rx_mgr *mgr)
+{
+	hw_remove_all(mgr);
+
+	return hw_pack(mgr, CONFIG_CAN_RX_MGR_MAX_HW_FILTERS);
+}
+
+static int16_t *chain_head(struct can_rx_mgr *mgr, const struct can_filter *filter)
+{
+	if (is_exact(filter)) {
+		return &mgr->buckets[hash_id(filter->id, filter->flags)];
+	}
+
+	return &mgr->masked;
+}
+
+static void chain_remove(struct can_rx_mgr *mgr, int16_t idx)
+{
+	int16_t *link = chain_head(mgr, &mgr->filters[idx].filter);
+
+	while (*link != idx) {
+		link = &mgr->filters[*link].next;
+	}
+
+	*link = mgr->filters[idx].next;
+	mgr->filters[idx].used = false;
+}
+
+void can_rx_mgr_init(struct can_rx_mgr *mgr, const struct device *dev)
+{
+	memset(mgr, 0, sizeof(*mgr));
+	mgr->dev = dev;
+	mgr->masked = -1;
+	k_mutex_init(&mgr->mutex);
+
+	for (size_t i = 0; i < ARRAY_SIZE(mgr->buckets); i++) {
+		mgr->buckets[i] = -1;
+	}
+}
+
+int can_rx_mgr_add_filter(struct can_rx_mgr *mgr, can_rx_callback_t callback,
+			  void *user_data, const struct can_filter *filter)
+{
+	struct can_rx_mgr_filter *f = NULL;
+	k_spinlock_key_t key;
+	int16_t *head;
+	int16_t idx;
+	int ret;
+
+	if (filter == NULL || callback == NULL ||
+	    (filter->flags & (CAN_FILTER_DATA | CAN_FILTER_RTR)) == 0 ||
+	    (filter->id & ~id_mask(filter)) != 0) {
+		return -EINVAL;
+	}
+
+	(void)k_mutex_lock(&mgr->mutex, K_FOREVER);
+
+	for (idx = 0; idx < ARRAY_SIZE(mgr->filters); idx++) {
+		if (!mgr->filters[idx].used) {
+			f = &mgr->filters[idx];
+			break;
+		}
+	}
+
+	if (f == NULL) {
+		k_mutex_unlock(&mgr->mutex);
+		return -ENOSPC;
+	}
+
+	f->filter = *filter;
+	f->filter.mask &= id_mask(filter);
+	f->callback = callback;
+	f->user_data = user_data;
+
+	key = k_spin_lock(&mgr->lock);
+	head = chain_head(mgr, &f->filter);
+	f->next = *head;
+	f->used = true;
+	*head = idx;
+	k_spin_unlock(&mgr->lock, key);
+
+	ret = hw_update(mgr);
+	if (ret < 0) {
+		LOG_ERR("Failed to add the hardware filters: %d", ret);
+
+		key = k_spin_lock(&mgr->lock);
+		chain_remove(mgr, idx);
+		k_spin_unlock(&mgr->lock, key);
+
+		/* Restore the previous hardware filters */
+		(void)hw_update(mgr);
+	}
+
+	k_mutex_unlock(&mgr->mutex);
+
+	return ret < 0 ? ret : idx;
+}
+
+void can_rx_mgr_remove_filter(struct can_rx_mgr *mgr, int filter_id)
+{
+	k_spinlock_key_t key;
+
+	if (filter_id < 0 || filter_id >= ARRAY_SIZE(mgr->filters)) {
+		return;
+	}
+
+	(void)k_mutex_lock(&mgr->mutex, K_FOREVER);
+
+	if (mgr->filters[filter_id].used) {
+		key = k_spin_lock(&mgr->lock);
+		chain_remove(mgr, filter_id);
+		k_spin_unlock(&mgr->lock, key);
+
+		(void)hw_update(mgr);
+	}
+
+	k_mutex_unlock(&mgr->mutex);
+}
+
+void can_rx_mgr_get_stats(struct can_rx_mgr *mgr, struct can_rx_mgr_stats *stats)
+{
+	k_spinlock_key_t key = k_spin_lock(&mgr->lock);
+
+	*stats = mgr->stats;
+
+	k_spin_unlock(&mgr->lock, key);
+}
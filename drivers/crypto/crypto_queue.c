@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file Crypto request queue.
+ *
+ * Requests are run by a dedicated work queue thread, which calls the
+ * synchronous API of the driver a session belongs to. Drivers thus need no
+ * change to be used asynchronously, and the submitter (e.g. the network
+ * stack) is not held up while the operation is carried out.
+ */
+
+#include <zephyr/crypto/crypto.h>
+#include <zephyr/crypto/queue.h>
+#include <zephyr/init.h>
+#include <zephyr/kernel.h>
+
+#define LOG_LEVEL CONFIG_CRYPTO_LOG_LEVEL
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(crypto_queue);
+
+static K_KERNEL_STACK_DEFINE(crypto_queue_stack, CONFIG_CRYPTO_QUEUE_STACK_SIZE);
+static struct k_work_q crypto_queue;
+
+static int crypto_req_run(struct crypto_req *req)
+{
+	switch (req->type) {
+	case CRYPTO_REQ_CBC:
+		return cipher_cbc_op(req->cipher.ctx, req->cipher.pkt,
+				     req->cipher.iv);
+	case CRYPTO_REQ_CTR:
+		return cipher_ctr_op(req->cipher.ctx, req->cipher.pkt,
+				     req->cipher.iv);
+	case CRYPTO_REQ_CCM:
+		return cipher_ccm_op(req->aead.ctx, req->aead.pkt,
+				     req->aead.nonce);
+	case CRYPTO_REQ_GCM:
+		return cipher_gcm_op(req->aead.ctx, req->aead.pkt,
+				     req->aead.nonce);
+	case CRYPTO_REQ_HASH:
+		if (req->hash.finish) {
+			return hash_compute(req->hash.ctx, req->hash.pkt);
+		}
+		return hash_update(req->hash.ctx, req->hash.pkt);
+	default:
+		return -EINVAL;
+	}
+}
+
+static void crypto_req_handler(struct k_work *work)
+{
+	struct crypto_req *req = CONTAINER_OF(work, struct crypto_req, work);
+	int ret;
+
+	ret = crypto_req_run(req);
+	if (ret != 0) {
+		LOG_DBG("request %p (type %d) failed: %d", req, req->type, ret);
+	}
+
+	if (req->cb != NULL) {
+		req->cb(req, ret);
+	}
+}
+
+static bool crypto_req_is_valid(const struct crypto_req *req)
+{
+	uint16_t flags;
+
+	switch (req->type) {
+	case CRYPTO_REQ_CBC:
+	case CRYPTO_REQ_CTR:
+		if ((req->cipher.ctx == NULL) || (req->cipher.pkt == NULL)) {
+			return false;
+		}
+		flags = req->cipher.ctx->flags;
+		break;
+	case CRYPTO_REQ_CCM:
+	case CRYPTO_REQ_GCM:
+		if ((req->aead.ctx == NULL) || (req->aead.pkt == NULL)) {
+			return false;
+		}
+		flags = req->aead.ctx->flags;
+		break;
+	case CRYPTO_REQ_HASH:
+		if ((req->hash.ctx == NULL) || (req->hash.pkt == NULL)) {
+			return false;
+		}
+		flags = req->hash.ctx->flags;
+		break;
+	default:
+		return false;
+	}
+
+	/* completion is reported by the queue, not by the driver */
+	return (flags & CAP_SYNC_OPS) != 0U;
+}
+
+int crypto_queue_submit(struct crypto_req *req)
+{
+	if (!crypto_req_is_valid(req)) {
+		return -EINVAL;
+	}
+
+	if (k_work_is_pending(&req->work)) {
+		return -EBUSY;
+	}
+
+	k_work_init(&req->work, crypto_req_handler);
+
+	return (k_work_submit_to_queue(&crypto_queue, &req->work) < 0) ?
+	       -EBUSY : 0;
+}
+
+static int crypto_queue_init(void)
+{
+	const struct k_work_queue_config cfg = {
+		.name = "crypto_queue",
+	};
+
+	k_work_queue_start(&crypto_queue, crypto_queue_stack,
+			   K_KERNEL_STACK_SIZEOF(crypto_queue_stack),
+			   CONFIG_CRYPTO_QUEUE_PRIORITY, &cfg);
+
+	return 0;
+}
+
+SYS_INIT(crypto_queue_init, POST_KERNEL, CONFIG_CRYPTO_INIT_PRIORITY);
@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file Crypto session cache.
+ *
+ * Keeps cipher sessions alive once released, so that the next user of the
+ * same key does not begin a new session, which for hardware drivers means
+ * loading and expanding the key again.
+ */
+
+#include <string.h>
+#include <zephyr/crypto/crypto.h>
+#include <zephyr/crypto/queue.h>
+#include <zephyr/kernel.h>
+
+#define LOG_LEVEL CONFIG_CRYPTO_LOG_LEVEL
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(crypto_session_cache);
+
+struct session_entry {
+	struct cipher_ctx ctx;
+	uint8_t key[CONFIG_CRYPTO_SESSION_CACHE_KEY_MAX];
+	enum cipher_algo algo;
+	enum cipher_mode mode;
+	enum cipher_op op;
+	/* number of users, 0 when idle */
+	uint16_t refs;
+	bool valid;
+	/* last use, for LRU eviction */
+	uint32_t stamp;
+};
+
+static struct session_entry sessions[CONFIG_CRYPTO_SESSION_CACHE_SIZE];
+static uint32_t stamp;
+static K_MUTEX_DEFINE(lock);
+
+static bool session_matches(const struct session_entry *e,
+			    const struct device *dev,
+			    const struct cipher_ctx *params,
+			    enum cipher_algo algo, enum cipher_mode mode,
+			    enum cipher_op op)
+{
+	return e->valid && (e->ctx.device == dev) && (e->algo == algo) &&
+	       (e->mode == mode) && (e->op == op) &&
+	       (e->ctx.keylen == params->keylen) &&
+	       (e->ctx.flags == params->flags) &&
+	       (memcmp(&e->ctx.mode_params, &params->mode_params,
+		       sizeof(params->mode_params)) == 0) &&
+	       (memcmp(e->key, params->key.bit_stream, params->keylen) == 0);
+}
+
+static void session_free(struct session_entry *e)
+{
+	int ret;
+
+	ret = cipher_free_session(e->ctx.device, &e->ctx);
+	if (ret != 0) {
+		LOG_WRN("failed to free session: %d", ret);
+	}
+
+	memset(e, 0, sizeof(*e));
+}
+
+static struct session_entry *session_evict(void)
+{
+	struct session_entry *lru = NULL;
+
+	for (size_t i = 0; i < ARRAY_SIZE(sessions); i++) {
+		struct session_entry *e = &sessions[i];
+
+		if (!e->valid) {
+			return e;
+		}
+
+		if ((e->refs == 0U) &&
+		    ((lru == NULL) || ((int32_t)(e->stamp - lru->stamp) < 0))) {
+			lru = e;
+		}
+	}
+
+	if (lru != NULL) {
+		session_free(lru);
+	}
+
+	return lru;
+}
+
+struct cipher_ctx *crypto_session_cache_get(const struct device *dev,
+					    const struct cipher_ctx *params,
+					    enum cipher_algo algo,
+					    enum cipher_mode mode,
+					    enum cipher_op op)
+{
+	struct session_entry *e = NULL;
+	int ret;
+
+	if (params->keylen > sizeof(e->key)) {
+		return NULL;
+	}
+
+	k_mutex_lock(&lock, K_FOREVER);
+
+	for (size_t i = 0; i < ARRAY_SIZE(sessions); i++) {
+		if (session_matches(&sessions[i], dev, params, algo, mode, op)) {
+			e = &sessions[i];
+			goto out;
+		}
+	}
+
+	e = session_evict();
+	if (e == NULL) {
+		LOG_DBG("all sessions in use");
+		goto out;
+	}
+
+	memcpy(e->key, params->key.bit_stream, params->keylen);
+	e->ctx.key.bit_stream = e->key;
+	e->ctx.keylen = params->keylen;
+	e->ctx.flags = params->flags;
+	e->ctx.mode_params = params->mode_params;
+	e->ctx.app_sessn_state = params->app_sessn_state;
+	e->algo = algo;
+	e->mode = mode;
+	e->op = op;
+
+	ret = cipher_begin_session(dev, &e->ctx, algo, mode, op);
+	if (ret != 0) {
+		LOG_DBG("failed to begin session: %d", ret);
+		memset(e, 0, sizeof(*e));
+		e = NULL;
+		goto out;
+	}
+
+	e->valid = true;
+
+out:
+	if (e != NULL) {
+		e->refs++;
+		e->stamp = stamp++;
+	}
+
+	k_mutex_unlock(&lock);
+
+	return (e != NULL) ? &e->ctx : NULL;
+}
+
+void crypto_session_cache_put(struct cipher_ctx *ctx)
+{
+	struct session_entry *e = CONTAINER_OF(ctx, struct session_entry, ctx);
+
+	__ASSERT_NO_MSG((e >= sessions) && (e < &sessions[ARRAY_SIZE(sessions)]));
+
+	k_mutex_lock(&lock, K_FOREVER);
+
+	__ASSERT_NO_MSG(e->refs > 0U);
+	e->refs--;
+
+	k_mutex_unlock(&lock);
+}
+
+void crypto_session_cache_flush(void)
+{
+	k_mutex_lock(&lock, K_FOREVER);
+
+	for (size_t i = 0; i < ARRAY_SIZE(sessions); i++) {
+		if (sessions[i].valid && (sessions[i].refs == 0U)) {
+			session_free(&sessions[i]);
+		}
+	}
+
+	k_mutex_unlock(&lock);
+}
@@ -11,6 +11,7 @@
 #include <errno.h>
 #include <zephyr/init.h>
 #include <zephyr/device.h>
+#include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
 
 LOG_MODULE_REGISTER(ramdisk, CONFIG_RAMDISK_LOG_LEVEL);
@@ -49,6 +50,11 @@ static int disk_ram_access_read(struct disk_info *disk, uint8_t *buff,
 
 	memcpy(buff, lba_to_address(sector), count * RAMDISK_SECTOR_SIZE);
 
+#ifdef CONFIG_DISK_RAM_SIMULATE_TIMING
+	k_busy_wait(CONFIG_DISK_RAM_ACCESS_TIME_US +
+		    count * CONFIG_DISK_RAM_READ_SECTOR_TIME_US);
+#endif
+
 	return 0;
 }
 
@@ -65,6 +71,11 @@ static int disk_ram_access_write(struct disk_info *disk, const uint8_t *buff,
 
 	memcpy(lba_to_address(sector), buff, count * RAMDISK_SECTOR_SIZE);
 
+#ifdef CONFIG_DISK_RAM_SIMULATE_TIMING
+	k_busy_wait(CONFIG_DISK_RAM_ACCESS_TIME_US +
+		    count * CONFIG_DISK_RAM_WRITE_SECTOR_TIME_US);
+#endif
+
 	return 0;
 }
 
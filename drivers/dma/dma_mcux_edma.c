@@ -88,6 +88,8 @@ struct call_back {
 	void *user_data;
 	dma_callback_t dma_callback;
 	struct dma_mcux_channel_transfer_edma_settings transfer_settings;
+	/* Blocks of the descriptor ring completed since the last dequeue */
+	uint32_t completed;
 	bool busy;
 };
 
@@ -125,10 +127,17 @@ static void nxp_edma_callback(edma_handle_t *handle, void *param, bool transferD
 	struct call_back *data = (struct call_back *)param;
 	uint32_t channel = handle->channel;
 
+	if (handle->tcdPool != NULL) {
+		data->completed += tcds;
+	}
+
 	if (transferDone) {
 		/* DMA is no longer busy when there are no remaining TCDs to transfer */
 		data->busy = (handle->tcdPool != NULL) && (handle->tcdUsed > 0);
 		ret = DMA_STATUS_COMPLETE;
+	} else if (handle->tcdPool != NULL) {
+		/* A block of a scatter/gather list is done, the next one is loaded */
+		ret = DMA_STATUS_BLOCK;
 	}
 	LOG_DBG("transfer %d", tcds);
 	data->dma_callback(data->dev, data->user_data, channel, ret);
@@ -175,6 +184,21 @@ static void dma_mcux_edma_error_irq_handler(const struct device *dev)
 #endif
 }
 
+/*
+ * The transfer type only gives the address increments of the channel, let the
+ * blocks keep an address, such as a dummy buffer in a scatter/gather list.
+ */
+static void dma_mcux_edma_addr_adj(edma_transfer_config_t *transfer_config,
+				   const struct dma_block_config *block_config)
+{
+	if (block_config->source_addr_adj == DMA_ADDR_ADJ_NO_CHANGE) {
+		transfer_config->srcOffset = 0;
+	}
+	if (block_config->dest_addr_adj == DMA_ADDR_ADJ_NO_CHANGE) {
+		transfer_config->destOffset = 0;
+	}
+}
+
 /* Configure a channel */
 static int dma_mcux_edma_configure(const struct device *dev, uint32_t channel,
 				   struct dma_config *config)
@@ -288,6 +312,7 @@ static int dma_mcux_edma_configure(const struct device *dev, uint32_t channel,
 				config->dest_data_size,
 				config->source_burst_length,
 				block_config->block_size, transfer_type);
+			dma_mcux_edma_addr_adj(&data->transferConfig, block_config);
 
 			const status_t submit_status =
 				EDMA_SubmitTransfer(p_handle, &(data->transferConfig));
@@ -307,6 +332,7 @@ static int dma_mcux_edma_configure(const struct device *dev, uint32_t channel,
 				     config->dest_data_size,
 				     config->source_burst_length,
 				     block_config->block_size, transfer_type);
+		dma_mcux_edma_addr_adj(&data->transferConfig, block_config);
 
 		const status_t submit_status =
 			EDMA_SubmitTransfer(p_handle, &(data->transferConfig));
@@ -330,6 +356,7 @@ static int dma_mcux_edma_configure(const struct device *dev, uint32_t channel,
 	}
 
 	data->busy = false;
+	data->completed = 0;
 	if (config->dma_callback) {
 		LOG_DBG("INSTALL call back on channel %d", channel);
 		data->user_data = config->user_data;
@@ -395,6 +422,35 @@ static int dma_mcux_edma_resume(const struct device *dev, uint32_t channel)
 }
 
 
+/* Submit a block with the settings of the channel, called with the IRQs locked */
+static int dma_mcux_edma_submit(const struct device *dev, uint32_t channel,
+				uint32_t src, uint32_t dst, size_t size)
+{
+	struct call_back *data = DEV_CHANNEL_DATA(dev, channel);
+
+	EDMA_PrepareTransfer(
+		&(data->transferConfig),
+		(void *)src,
+		data->transfer_settings.source_data_size,
+		(void *)dst,
+		data->transfer_settings.dest_data_size,
+		data->transfer_settings.source_burst_length,
+		size,
+		data->transfer_settings.transfer_type);
+
+	const status_t submit_status =
+		EDMA_SubmitTransfer(DEV_EDMA_HANDLE(dev, channel), &(data->transferConfig));
+
+	if (submit_status == kStatus_EDMA_QueueFull) {
+		return -ENOMEM;
+	} else if (submit_status != kStatus_Success) {
+		LOG_ERR("Error submitting EDMA Transfer: 0x%x", submit_status);
+		return -EFAULT;
+	}
+
+	return 0;
+}
+
 static int dma_mcux_edma_reload(const struct device *dev, uint32_t channel,
 				uint32_t src, uint32_t dst, size_t size)
 {
@@ -417,22 +473,47 @@ static int dma_mcux_edma_reload(const struct device *dev, uint32_t channel,
 		goto cleanup;
 	}
 
-	EDMA_PrepareTransfer(
-		&(data->transferConfig),
-		(void *)src,
-		data->transfer_settings.source_data_size,
-		(void *)dst,
-		data->transfer_settings.dest_data_size,
-		data->transfer_settings.source_burst_length,
-		size,
-		data->transfer_settings.transfer_type);
+	ret = dma_mcux_edma_submit(dev, channel, src, dst, size);
+	if (ret == -ENOMEM) {
+		LOG_ERR("EDMA TCD queue is full");
+		ret = -EFAULT;
+	}
 
-	const status_t submit_status =
-		EDMA_SubmitTransfer(DEV_EDMA_HANDLE(dev, channel), &(data->transferConfig));
+cleanup:
+	irq_unlock(key);
+	return ret;
+}
 
-	if (submit_status != kStatus_Success) {
-		LOG_ERR("Error submitting EDMA Transfer: 0x%x", submit_status);
+/*
+ * The TCD pool of a scatter/gather channel is its descriptor ring: the block is
+ * linked to the last TCD, and the channel restarted if it already completed.
+ */
+static int dma_mcux_edma_enqueue(const struct device *dev, uint32_t channel,
+				 uint32_t src, uint32_t dst, size_t size)
+{
+	struct call_back *data = DEV_CHANNEL_DATA(dev, channel);
+	const unsigned int key = irq_lock();
+	int ret;
+
+	if (!data->transfer_settings.valid) {
 		ret = -EFAULT;
+		goto cleanup;
+	}
+
+	if (data->edma_handle.tcdPool == NULL) {
+		LOG_ERR("Configure the channel with scatter/gather to queue blocks");
+		ret = -ENOTSUP;
+		goto cleanup;
+	}
+
+	ret = dma_mcux_edma_submit(dev, channel, src, dst, size);
+	if (ret != 0) {
+		goto cleanup;
+	}
+
+	if (!data->busy) {
+		data->busy = true;
+		EDMA_StartTransfer(DEV_EDMA_HANDLE(dev, channel));
 	}
 
 cleanup:
@@ -440,6 +521,18 @@ cleanup:
 	return ret;
 }
 
+static int dma_mcux_edma_dequeue(const struct device *dev, uint32_t channel)
+{
+	struct call_back *data = DEV_CHANNEL_DATA(dev, channel);
+	const unsigned int key = irq_lock();
+	int completed = data->completed;
+
+	data->completed = 0;
+	irq_unlock(key);
+
+	return completed;
+}
+
 static int dma_mcux_edma_get_status(const struct device *dev, uint32_t channel,
 				    struct dma_status *status)
 {
@@ -488,6 +581,8 @@ static const struct dma_driver_api dma_mcux_edma_api = {
 	.resume = dma_mcux_edma_resume,
 	.get_status = dma_mcux_edma_get_status,
 	.chan_filter = dma_mcux_edma_channel_filter,
+	.enqueue = dma_mcux_edma_enqueue,
+	.dequeue = dma_mcux_edma_dequeue,
 };
 
 static int dma_mcux_edma_init(const struct device *dev)
@@ -85,6 +85,62 @@ static void dma_stm32_clear_stream_irq(const struct device *dev, uint32_t id)
 	stm32_dma_clear_stream_irq(dma, id);
 }
 
+/* Program the addresses and the data counter of a disabled stream */
+static int dma_stm32_set_block(DMA_TypeDef *dma, struct dma_stm32_stream *stream,
+			       uint32_t id, uint32_t src, uint32_t dst, size_t size)
+{
+	switch (stream->direction) {
+	case MEMORY_TO_PERIPHERAL:
+		LL_DMA_SetMemoryAddress(dma, dma_stm32_id_to_stream(id), src);
+		LL_DMA_SetPeriphAddress(dma, dma_stm32_id_to_stream(id), dst);
+		break;
+	case MEMORY_TO_MEMORY:
+	case PERIPHERAL_TO_MEMORY:
+		LL_DMA_SetPeriphAddress(dma, dma_stm32_id_to_stream(id), src);
+		LL_DMA_SetMemoryAddress(dma, dma_stm32_id_to_stream(id), dst);
+		break;
+	default:
+		return -EINVAL;
+	}
+
+	if (stream->source_periph) {
+		LL_DMA_SetDataLength(dma, dma_stm32_id_to_stream(id),
+				     size / stream->src_size);
+	} else {
+		LL_DMA_SetDataLength(dma, dma_stm32_id_to_stream(id),
+				     size / stream->dst_size);
+	}
+
+	return 0;
+}
+
+#if CONFIG_DMA_STM32_QUEUE_SIZE > 0
+/* Start the next queued block of a stream which completed its transfer */
+static bool dma_stm32_next_block(DMA_TypeDef *dma, struct dma_stm32_stream *stream,
+				 uint32_t id)
+{
+	struct dma_stm32_block *block;
+
+	stream->completed++;
+
+	if (stream->queue_len == 0) {
+		return false;
+	}
+
+	block = &stream->queue[stream->queue_head];
+	stream->queue_head = (stream->queue_head + 1) % CONFIG_DMA_STM32_QUEUE_SIZE;
+	stream->queue_len--;
+
+	/* The data counter is only writable once the stream is disabled */
+	(void)stm32_dma_disable_stream(dma, id);
+	(void)dma_stm32_set_block(dma, stream, id, block->src, block->dst, block->size);
+	stream->busy = true;
+	stm32_dma_enable_stream(dma, id);
+
+	return true;
+}
+#endif /* CONFIG_DMA_STM32_QUEUE_SIZE > 0 */
+
 static void dma_stm32_irq_handler(const struct device *dev, uint32_t id)
 {
 	const struct dma_stm32_config *config = dev->config;
@@ -110,7 +166,8 @@ static void dma_stm32_irq_handler(const struct device *dev, uint32_t id)
 #else
 	callback_arg = id + STM32_DMA_STREAM_OFFSET;
 #endif /* CONFIG_DMAMUX_STM32 */
-	if (!IS_ENABLED(CONFIG_DMAMUX_STM32)) {
+	/* A circular stream keeps transferring after its interrupts */
+	if (!IS_ENABLED(CONFIG_DMAMUX_STM32) && !stream->cyclic) {
 		stream->busy = false;
 	}
 
@@ -123,12 +180,21 @@ static void dma_stm32_irq_handler(const struct device *dev, uint32_t id)
 		stream->dma_callback(dev, stream->user_data, callback_arg, DMA_STATUS_BLOCK);
 	} else if (stm32_dma_is_tc_irq_active(dma, id)) {
 #ifdef CONFIG_DMAMUX_STM32
-		stream->busy = false;
+		if (!stream->cyclic) {
+			stream->busy = false;
+		}
 #endif
 		/* Let HAL DMA handle flags on its own */
 		if (!stream->hal_override) {
 			dma_stm32_clear_tc(dma, id);
 		}
+#if CONFIG_DMA_STM32_QUEUE_SIZE > 0
+		if (!stream->hal_override && dma_stm32_next_block(dma, stream, id)) {
+			stream->dma_callback(dev, stream->user_data, callback_arg,
+					     DMA_STATUS_BLOCK);
+			return;
+		}
+#endif /* CONFIG_DMA_STM32_QUEUE_SIZE > 0 */
 		stream->dma_callback(dev, stream->user_data, callback_arg, DMA_STATUS_COMPLETE);
 	} else if (stm32_dma_is_unexpected_irq_happened(dma, id)) {
 		LOG_ERR("Unexpected irq happened.");
@@ -361,6 +427,11 @@ DMA_STM32_EXPORT_API int dma_stm32_configure(const struct device *dev,
 	stream->user_data       = config->user_data;
 	stream->src_size	= config->source_data_size;
 	stream->dst_size	= config->dest_data_size;
+#if CONFIG_DMA_STM32_QUEUE_SIZE > 0
+	stream->queue_head	= 0;
+	stream->queue_len	= 0;
+	stream->completed	= 0;
+#endif /* CONFIG_DMA_STM32_QUEUE_SIZE > 0 */
 
 	/* Check dest or source memory address, warn if 0 */
 	if (config->head_block->source_address == 0) {
@@ -437,6 +508,7 @@ DMA_STM32_EXPORT_API int dma_stm32_configure(const struct device *dev,
 	} else {
 		DMA_InitStruct.Mode = LL_DMA_MODE_NORMAL;
 	}
+	stream->cyclic = config->head_block->source_reload_en;
 
 	stream->source_periph = (stream->direction == PERIPHERAL_TO_MEMORY);
 
@@ -531,28 +603,10 @@ DMA_STM32_EXPORT_API int dma_stm32_reload(const struct device *dev, uint32_t id,
 		return -EBUSY;
 	}
 
-	switch (stream->direction) {
-	case MEMORY_TO_PERIPHERAL:
-		LL_DMA_SetMemoryAddress(dma, dma_stm32_id_to_stream(id), src);
-		LL_DMA_SetPeriphAddress(dma, dma_stm32_id_to_stream(id), dst);
-		break;
-	case MEMORY_TO_MEMORY:
-	case PERIPHERAL_TO_MEMORY:
-		LL_DMA_SetPeriphAddress(dma, dma_stm32_id_to_stream(id), src);
-		LL_DMA_SetMemoryAddress(dma, dma_stm32_id_to_stream(id), dst);
-		break;
-	default:
+	if (dma_stm32_set_block(dma, stream, id, src, dst, size) != 0) {
 		return -EINVAL;
 	}
 
-	if (stream->source_periph) {
-		LL_DMA_SetDataLength(dma, dma_stm32_id_to_stream(id),
-				     size / stream->src_size);
-	} else {
-		LL_DMA_SetDataLength(dma, dma_stm32_id_to_stream(id),
-				     size / stream->dst_size);
-	}
-
 	/* When reloading the dma, the stream is busy again before enabling */
 	stream->busy = true;
 
@@ -620,12 +674,98 @@ DMA_STM32_EXPORT_API int dma_stm32_stop(const struct device *dev, uint32_t id)
 	dma_stm32_clear_stream_irq(dev, id);
 	dma_stm32_disable_stream(dma, id);
 
+#if CONFIG_DMA_STM32_QUEUE_SIZE > 0
+	stream->queue_len = 0;
+#endif /* CONFIG_DMA_STM32_QUEUE_SIZE > 0 */
+
 	/* Finally, flag stream as free */
 	stream->busy = false;
 
 	return 0;
 }
 
+#if CONFIG_DMA_STM32_QUEUE_SIZE > 0
+DMA_STM32_EXPORT_API int dma_stm32_enqueue(const struct device *dev, uint32_t id,
+					   uint32_t src, uint32_t dst, size_t size)
+{
+	const struct dma_stm32_config *config = dev->config;
+	DMA_TypeDef *dma = (DMA_TypeDef *)(config->base);
+	struct dma_stm32_stream *stream;
+	struct dma_stm32_block *block;
+	unsigned int key;
+	int ret = 0;
+
+	/* Give channel from index 0 */
+	id = id - STM32_DMA_STREAM_OFFSET;
+
+	if (id >= config->max_streams) {
+		return -EINVAL;
+	}
+
+	stream = &config->streams[id];
+
+	/* A circular stream never completes to move on to the next block */
+	if (stream->hal_override || stream->cyclic) {
+		return -ENOTSUP;
+	}
+
+	if (size > DMA_STM32_MAX_DATA_ITEMS) {
+		return -EINVAL;
+	}
+
+	key = irq_lock();
+
+	/* Idle once the completion is handled, or configured and not started yet */
+	if (!stream->busy || (!stm32_dma_is_enabled_stream(dma, id) &&
+			      !stm32_dma_is_tc_irq_active(dma, id))) {
+		(void)stm32_dma_disable_stream(dma, id);
+		ret = dma_stm32_set_block(dma, stream, id, src, dst, size);
+		if (ret == 0) {
+			stream->busy = true;
+			dma_stm32_clear_stream_irq(dev, id);
+			stm32_dma_enable_stream(dma, id);
+		}
+	} else if (stream->queue_len == CONFIG_DMA_STM32_QUEUE_SIZE) {
+		ret = -ENOMEM;
+	} else {
+		block = &stream->queue[(stream->queue_head + stream->queue_len) %
+				       CONFIG_DMA_STM32_QUEUE_SIZE];
+		block->src = src;
+		block->dst = dst;
+		block->size = size;
+		stream->queue_len++;
+	}
+
+	irq_unlock(key);
+
+	return ret;
+}
+
+DMA_STM32_EXPORT_API int dma_stm32_dequeue(const struct device *dev, uint32_t id)
+{
+	const struct dma_stm32_config *config = dev->config;
+	struct dma_stm32_stream *stream;
+	unsigned int key;
+	int completed;
+
+	/* Give channel from index 0 */
+	id = id - STM32_DMA_STREAM_OFFSET;
+
+	if (id >= config->max_streams) {
+		return -EINVAL;
+	}
+
+	stream = &config->streams[id];
+
+	key = irq_lock();
+	completed = stream->completed;
+	stream->completed = 0;
+	irq_unlock(key);
+
+	return completed;
+}
+#endif /* CONFIG_DMA_STM32_QUEUE_SIZE > 0 */
+
 static int dma_stm32_init(const struct device *dev)
 {
 	const struct dma_stm32_config *config = dev->config;
@@ -686,6 +826,10 @@ static const struct dma_driver_api dma_funcs = {
 	.start		 = dma_stm32_start,
 	.stop		 = dma_stm32_stop,
 	.get_status	 = dma_stm32_get_status,
+#if CONFIG_DMA_STM32_QUEUE_SIZE > 0
+	.enqueue	 = dma_stm32_enqueue,
+	.dequeue	 = dma_stm32_dequeue,
+#endif /* CONFIG_DMA_STM32_QUEUE_SIZE > 0 */
 };
 
 #ifdef CONFIG_DMAMUX_STM32
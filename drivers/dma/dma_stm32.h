@@ -15,6 +15,14 @@
 /* Maximum data sent in single transfer (Bytes) */
 #define DMA_STM32_MAX_DATA_ITEMS	0xffff
 
+#if CONFIG_DMA_STM32_QUEUE_SIZE > 0
+struct dma_stm32_block {
+	uint32_t src;
+	uint32_t dst;
+	size_t size;
+};
+#endif /* CONFIG_DMA_STM32_QUEUE_SIZE > 0 */
+
 struct dma_stm32_stream {
 	uint32_t direction;
 #ifdef CONFIG_DMAMUX_STM32
@@ -22,11 +30,20 @@ struct dma_stm32_stream {
 #endif /* CONFIG_DMAMUX_STM32 */
 	bool source_periph;
 	bool hal_override;
+	bool cyclic;
 	volatile bool busy;
 	uint32_t src_size;
 	uint32_t dst_size;
 	void *user_data; /* holds the client data */
 	dma_callback_t dma_callback;
+#if CONFIG_DMA_STM32_QUEUE_SIZE > 0
+	/* blocks queued after the one being transferred */
+	struct dma_stm32_block queue[CONFIG_DMA_STM32_QUEUE_SIZE];
+	uint8_t queue_head;
+	uint8_t queue_len;
+	/* blocks completed since the last dequeue */
+	uint32_t completed;
+#endif /* CONFIG_DMA_STM32_QUEUE_SIZE > 0 */
 };
 
 struct dma_stm32_data {
@@ -108,6 +125,11 @@ int dma_stm32_start(const struct device *dev, uint32_t id);
 int dma_stm32_stop(const struct device *dev, uint32_t id);
 int dma_stm32_get_status(const struct device *dev, uint32_t id,
 				struct dma_status *stat);
+#if CONFIG_DMA_STM32_QUEUE_SIZE > 0
+int dma_stm32_enqueue(const struct device *dev, uint32_t id,
+		      uint32_t src, uint32_t dst, size_t size);
+int dma_stm32_dequeue(const struct device *dev, uint32_t id);
+#endif /* CONFIG_DMA_STM32_QUEUE_SIZE > 0 */
 #else
 #define DMA_STM32_EXPORT_API static
 #endif /* CONFIG_DMAMUX_STM32 */
@@ -93,6 +93,9 @@ typedef int (*dma_reload_fn)(const struct device *dev, uint32_t id,
 			uint32_t src, uint32_t dst, size_t size);
 typedef int (*dma_status_fn)(const struct device *dev, uint32_t id,
 				struct dma_status *stat);
+typedef int (*dma_enqueue_fn)(const struct device *dev, uint32_t id,
+			uint32_t src, uint32_t dst, size_t size);
+typedef int (*dma_dequeue_fn)(const struct device *dev, uint32_t id);
 
 struct dmamux_stm32_dma_fops {
 	dma_configure_fn configure;
@@ -100,6 +103,8 @@ struct dmamux_stm32_dma_fops {
 	dma_stop_fn stop;
 	dma_reload_fn reload;
 	dma_status_fn get_status;
+	dma_enqueue_fn enqueue;
+	dma_dequeue_fn dequeue;
 };
 
 #if (defined(CONFIG_DMA_STM32_V1) || defined(CONFIG_DMA_STM32_V2)) && \
@@ -110,6 +115,10 @@ static const struct dmamux_stm32_dma_fops dmamux1 = {
 	dma_stm32_stop,
 	dma_stm32_reload,
 	dma_stm32_get_status,
+#if CONFIG_DMA_STM32_QUEUE_SIZE > 0
+	dma_stm32_enqueue,
+	dma_stm32_dequeue,
+#endif /* CONFIG_DMA_STM32_QUEUE_SIZE > 0 */
 };
 #endif
 
@@ -254,6 +263,46 @@ int dmamux_stm32_reload(const struct device *dev, uint32_t id,
 	return 0;
 }
 
+int dmamux_stm32_enqueue(const struct device *dev, uint32_t id,
+			 uint32_t src, uint32_t dst, size_t size)
+{
+	const struct dmamux_stm32_config *dev_config = dev->config;
+	const struct dmamux_stm32_dma_fops *dma_device = get_dma_fops(dev_config);
+
+	/* check if this channel is valid */
+	if (id >= dev_config->channel_nb) {
+		LOG_ERR("channel ID %d is too big.", id);
+		return -EINVAL;
+	}
+
+	if (dma_device->enqueue == NULL) {
+		return -ENOSYS;
+	}
+
+	return dma_device->enqueue(dev_config->mux_channels[id].dev_dma,
+				   dev_config->mux_channels[id].dma_id,
+				   src, dst, size);
+}
+
+int dmamux_stm32_dequeue(const struct device *dev, uint32_t id)
+{
+	const struct dmamux_stm32_config *dev_config = dev->config;
+	const struct dmamux_stm32_dma_fops *dma_device = get_dma_fops(dev_config);
+
+	/* check if this channel is valid */
+	if (id >= dev_config->channel_nb) {
+		LOG_ERR("channel ID %d is too big.", id);
+		return -EINVAL;
+	}
+
+	if (dma_device->dequeue == NULL) {
+		return -ENOSYS;
+	}
+
+	return dma_device->dequeue(dev_config->mux_channels[id].dev_dma,
+				   dev_config->mux_channels[id].dma_id);
+}
+
 int dmamux_stm32_get_status(const struct device *dev, uint32_t id,
 				struct dma_status *stat)
 {
@@ -326,6 +375,8 @@ static const struct dma_driver_api dma_funcs = {
 	.start		 = dmamux_stm32_start,
 	.stop		 = dmamux_stm32_stop,
 	.get_status	 = dmamux_stm32_get_status,
+	.enqueue	 = dmamux_stm32_enqueue,
+	.dequeue	 = dmamux_stm32_dequeue,
 };
 
 /*
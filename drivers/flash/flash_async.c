@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/init.h>
+#include <zephyr/drivers/flash.h>
+
+/* Operations of the drivers without asynchronous support, executed in order
+ * of submission by calling the synchronous API.
+ */
+static K_KERNEL_STACK_DEFINE(flash_async_stack, CONFIG_FLASH_ASYNC_STACK_SIZE);
+static struct k_work_q flash_async_work_q;
+
+static void flash_async_work_handler(struct k_work *work)
+{
+	struct flash_async_op *op = CONTAINER_OF(work, struct flash_async_op, work);
+	int rc;
+
+	switch (op->type) {
+	case FLASH_ASYNC_OP_READ:
+		rc = flash_read(op->dev, op->offset, op->data, op->len);
+		break;
+	case FLASH_ASYNC_OP_WRITE:
+		rc = flash_write(op->dev, op->offset, op->data, op->len);
+		break;
+	case FLASH_ASYNC_OP_ERASE:
+		rc = flash_erase(op->dev, op->offset, op->len);
+		break;
+	default:
+		rc = -EINVAL;
+		break;
+	}
+
+	/* The callback may submit the operation again */
+	op->cb(op->dev, op, rc);
+}
+
+int z_flash_async_submit(const struct device *dev, struct flash_async_op *op)
+{
+	int rc;
+
+	if (op->cb == NULL) {
+		return -EINVAL;
+	}
+
+	op->dev = dev;
+
+	/* An operation submitted again from its callback is still running,
+	 * its work item must not be initialized again.
+	 */
+	if (op->work.handler != flash_async_work_handler ||
+	    !(k_work_busy_get(&op->work) & K_WORK_RUNNING)) {
+		k_work_init(&op->work, flash_async_work_handler);
+	}
+
+	rc = k_work_submit_to_queue(&flash_async_work_q, &op->work);
+
+	return (rc < 0) ? rc : 0;
+}
+
+static int flash_async_init(void)
+{
+	k_work_queue_init(&flash_async_work_q);
+	k_work_queue_start(&flash_async_work_q, flash_async_stack,
+			   K_KERNEL_STACK_SIZEOF(flash_async_stack),
+			   CONFIG_FLASH_ASYNC_THREAD_PRIORITY, NULL);
+	k_thread_name_set(&flash_async_work_q.thread, "flash_async");
+
+	return 0;
+}
+
+SYS_INIT(flash_async_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
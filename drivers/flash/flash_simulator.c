@@ -50,6 +50,12 @@
 
 #define MOCK_FLASH(addr) (mock_flash + (addr) - FLASH_SIMULATOR_BASE_OFFSET)
 
+#ifdef CONFIG_FLASH_SIMULATOR_SIMULATE_TIMING
+/* time of an operation: minimum time plus time of each of n bytes or units */
+#define FLASH_SIM_TIME_US(min_us, n, unit_ns) \
+	((min_us) + (uint32_t)(((uint64_t)(n) * (unit_ns)) / NSEC_PER_USEC))
+#endif
+
 /* maximum number of pages that can be tracked by the stats module */
 #define STATS_PAGE_COUNT_THRESHOLD 256
 
@@ -201,9 +207,11 @@ static int flash_sim_read(const struct device *dev, const off_t offset,
 	FLASH_SIM_STATS_INCN(flash_sim_stats, bytes_read, len);
 
 #ifdef CONFIG_FLASH_SIMULATOR_SIMULATE_TIMING
-	k_busy_wait(CONFIG_FLASH_SIMULATOR_MIN_READ_TIME_US);
-	FLASH_SIM_STATS_INCN(flash_sim_stats, flash_read_time_us,
-		   CONFIG_FLASH_SIMULATOR_MIN_READ_TIME_US);
+	uint32_t time_us = FLASH_SIM_TIME_US(CONFIG_FLASH_SIMULATOR_MIN_READ_TIME_US, len,
+					     CONFIG_FLASH_SIMULATOR_READ_BYTE_TIME_NS);
+
+	k_busy_wait(time_us);
+	FLASH_SIM_STATS_INCN(flash_sim_stats, flash_read_time_us, time_us);
 #endif
 
 	return 0;
@@ -275,10 +283,13 @@ static int flash_sim_write(const struct device *dev, const off_t offset,
 	FLASH_SIM_STATS_INCN(flash_sim_stats, bytes_written, len);
 
 #ifdef CONFIG_FLASH_SIMULATOR_SIMULATE_TIMING
+	uint32_t time_us = FLASH_SIM_TIME_US(CONFIG_FLASH_SIMULATOR_MIN_WRITE_TIME_US,
+					     len / FLASH_SIMULATOR_PROG_UNIT,
+					     CONFIG_FLASH_SIMULATOR_WRITE_UNIT_TIME_NS);
+
 	/* wait before returning */
-	k_busy_wait(CONFIG_FLASH_SIMULATOR_MIN_WRITE_TIME_US);
-	FLASH_SIM_STATS_INCN(flash_sim_stats, flash_write_time_us,
-		   CONFIG_FLASH_SIMULATOR_MIN_WRITE_TIME_US);
+	k_busy_wait(time_us);
+	FLASH_SIM_STATS_INCN(flash_sim_stats, flash_write_time_us, time_us);
 #endif
 
 	return 0;
@@ -329,10 +340,14 @@ static int flash_sim_erase(const struct device *dev, const off_t offset,
 	}
 
 #ifdef CONFIG_FLASH_SIMULATOR_SIMULATE_TIMING
+	uint32_t time_us = FLASH_SIM_TIME_US(CONFIG_FLASH_SIMULATOR_MIN_ERASE_TIME_US,
+					     len / FLASH_SIMULATOR_ERASE_UNIT,
+					     CONFIG_FLASH_SIMULATOR_ERASE_UNIT_TIME_US *
+					     (uint64_t)NSEC_PER_USEC);
+
 	/* wait before returning */
-	k_busy_wait(CONFIG_FLASH_SIMULATOR_MIN_ERASE_TIME_US);
-	FLASH_SIM_STATS_INCN(flash_sim_stats, flash_erase_time_us,
-		   CONFIG_FLASH_SIMULATOR_MIN_ERASE_TIME_US);
+	k_busy_wait(time_us);
+	FLASH_SIM_STATS_INCN(flash_sim_stats, flash_erase_time_us, time_us);
 #endif
 
 	return 0;
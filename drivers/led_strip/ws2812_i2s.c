@@ -47,46 +47,48 @@ struct ws2812_i2s_cfg {
 	uint8_t nibble_zero;
 };
 
+struct ws2812_i2s_data {
+	/* I2S symbols of each nibble of the color values, LSbit first */
+	uint16_t nibble_syms[16];
+	uint32_t reset_word;
+#if defined(CONFIG_WS2812_STRIP_ASYNC)
+	/* Uptime, in ticks, once the last frame is sent */
+	int64_t tx_end;
+#endif
+};
+
 /* Serialize an 8-bit color channel value into two 16-bit I2S values (or 1 32-bit
- * word).
+ * word), a nibble at a time.
  */
-static inline void ws2812_i2s_ser(uint32_t *word, uint8_t color, const uint8_t sym_one,
-				  const uint8_t sym_zero)
+static inline void ws2812_i2s_ser(uint32_t *word, uint8_t color, const uint16_t *nibble_syms)
 {
-	*word = 0;
-	for (uint16_t i = 0; i < 8; i++) {
-		if ((1 << i) & color) {
-			*word |= sym_one << (i * 4);
-		} else {
-			*word |= sym_zero << (i * 4);
-		}
-	}
-
 	/* Swap the two I2S values due to the (audio) channel TX order. */
-	*word = (*word >> 16) | (*word << 16);
+	*word = ((uint32_t)nibble_syms[color & 0x0F] << 16) | nibble_syms[color >> 4];
+}
+
+/* Wait until the last frame is sent, and the I2S stream ready again. */
+static void ws2812_i2s_wait(const struct device *dev)
+{
+#if defined(CONFIG_WS2812_STRIP_ASYNC)
+	struct ws2812_i2s_data *data = dev->data;
+	int64_t remaining = data->tx_end - k_uptime_ticks();
+
+	if (remaining > 0) {
+		k_sleep(K_TICKS(remaining));
+	}
+#endif
 }
 
 static int ws2812_strip_update_rgb(const struct device *dev, struct led_rgb *pixels,
 				   size_t num_pixels)
 {
 	const struct ws2812_i2s_cfg *cfg = dev->config;
-	uint8_t sym_one, sym_zero;
-	uint32_t reset_word;
+	struct ws2812_i2s_data *data = dev->data;
 	uint32_t *tx_buf;
 	uint32_t flush_time_us;
 	void *mem_block;
 	int ret;
 
-	if (cfg->active_low) {
-		sym_one = (~cfg->nibble_one) & 0x0F;
-		sym_zero = (~cfg->nibble_zero) & 0x0F;
-		reset_word = 0xFFFFFFFF;
-	} else {
-		sym_one = cfg->nibble_one & 0x0F;
-		sym_zero = cfg->nibble_zero & 0x0F;
-		reset_word = 0;
-	}
-
 	/* Acquire memory for the I2S payload. */
 	ret = k_mem_slab_alloc(cfg->mem_slab, &mem_block, K_SECONDS(10));
 	if (ret < 0) {
@@ -97,7 +99,7 @@ static int ws2812_strip_update_rgb(const struct device *dev, struct led_rgb *pix
 
 	/* Add a pre-data reset, so the first pixel isn't skipped by the strip. */
 	for (uint16_t i = 0; i < WS2812_I2S_PRE_DELAY_WORDS; i++) {
-		*tx_buf = reset_word;
+		*tx_buf = data->reset_word;
 		tx_buf++;
 	}
 
@@ -109,11 +111,8 @@ static int ws2812_strip_update_rgb(const struct device *dev, struct led_rgb *pix
 		for (uint16_t j = 0; j < cfg->num_colors; j++) {
 			uint8_t pixel;
 
+			/* The color mapping is checked at init */
 			switch (cfg->color_mapping[j]) {
-			/* White channel is not supported by LED strip API. */
-			case LED_COLOR_ID_WHITE:
-				pixel = 0;
-				break;
 			case LED_COLOR_ID_RED:
 				pixel = pixels[i].r;
 				break;
@@ -123,19 +122,24 @@ static int ws2812_strip_update_rgb(const struct device *dev, struct led_rgb *pix
 			case LED_COLOR_ID_BLUE:
 				pixel = pixels[i].b;
 				break;
+			/* White channel is not supported by LED strip API. */
 			default:
-				return -EINVAL;
+				pixel = 0;
+				break;
 			}
-			ws2812_i2s_ser(tx_buf, pixel, sym_one, sym_zero);
+			ws2812_i2s_ser(tx_buf, pixel, data->nibble_syms);
 			tx_buf++;
 		}
 	}
 
 	for (uint16_t i = 0; i < cfg->reset_words; i++) {
-		*tx_buf = reset_word;
+		*tx_buf = data->reset_word;
 		tx_buf++;
 	}
 
+	/* The frame was encoded while the last one may have been sent. */
+	ws2812_i2s_wait(dev);
+
 	/* Flush the buffer on the wire. */
 	ret = i2s_write(cfg->dev, mem_block, cfg->tx_buf_bytes);
 	if (ret < 0) {
@@ -158,7 +162,12 @@ static int ws2812_strip_update_rgb(const struct device *dev, struct led_rgb *pix
 
 	/* Wait until transaction is over */
 	flush_time_us = cfg->lrck_period * cfg->tx_buf_bytes / sizeof(uint32_t);
+#if defined(CONFIG_WS2812_STRIP_ASYNC)
+	data->tx_end = k_uptime_ticks() +
+		       k_us_to_ticks_ceil64(flush_time_us + cfg->extra_wait_time_us);
+#else
 	k_usleep(flush_time_us + cfg->extra_wait_time_us);
+#endif
 
 	return ret;
 }
@@ -173,6 +182,8 @@ static int ws2812_strip_update_channels(const struct device *dev, uint8_t *chann
 static int ws2812_i2s_init(const struct device *dev)
 {
 	const struct ws2812_i2s_cfg *cfg = dev->config;
+	struct ws2812_i2s_data *data = dev->data;
+	uint8_t sym_one, sym_zero;
 	struct i2s_config config;
 	uint32_t lrck_hz;
 	int ret;
@@ -212,6 +223,23 @@ static int ws2812_i2s_init(const struct device *dev)
 		}
 	}
 
+	if (cfg->active_low) {
+		sym_one = (~cfg->nibble_one) & 0x0F;
+		sym_zero = (~cfg->nibble_zero) & 0x0F;
+		data->reset_word = 0xFFFFFFFF;
+	} else {
+		sym_one = cfg->nibble_one & 0x0F;
+		sym_zero = cfg->nibble_zero & 0x0F;
+		data->reset_word = 0;
+	}
+
+	for (uint16_t i = 0; i < ARRAY_SIZE(data->nibble_syms); i++) {
+		data->nibble_syms[i] = 0;
+		for (uint16_t j = 0; j < 4; j++) {
+			data->nibble_syms[i] |= (i & BIT(j) ? sym_one : sym_zero) << (j * 4);
+		}
+	}
+
 	return 0;
 }
 
@@ -242,6 +270,8 @@ static const struct led_strip_driver_api ws2812_i2s_api = {
                                                                                                    \
 	K_MEM_SLAB_DEFINE_STATIC(ws2812_i2s_##idx##_slab, WS2812_I2S_BUFSIZE(idx), 2, 4);          \
                                                                                                    \
+	static struct ws2812_i2s_data ws2812_i2s_##idx##_data;                                     \
+                                                                                                   \
 	static const uint8_t ws2812_i2s_##idx##_color_mapping[] =                                  \
 		DT_INST_PROP(idx, color_mapping);                                                  \
                                                                                                    \
@@ -259,7 +289,8 @@ static const struct led_strip_driver_api ws2812_i2s_api = {
 		.nibble_zero = DT_INST_PROP(idx, nibble_zero),                                     \
 	};                                                                                         \
                                                                                                    \
-	DEVICE_DT_INST_DEFINE(idx, ws2812_i2s_init, NULL, NULL, &ws2812_i2s_##idx##_cfg,           \
+	DEVICE_DT_INST_DEFINE(idx, ws2812_i2s_init, NULL, &ws2812_i2s_##idx##_data,                \
+			      &ws2812_i2s_##idx##_cfg,                                             \
 			      POST_KERNEL, CONFIG_LED_STRIP_INIT_PRIORITY, &ws2812_i2s_api);
 
 DT_INST_FOREACH_STATUS_OKAY(WS2812_I2S_DEVICE)
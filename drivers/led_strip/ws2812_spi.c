@@ -49,6 +49,23 @@ struct ws2812_spi_cfg {
 	uint16_t reset_delay;
 };
 
+struct ws2812_spi_data {
+	/* SPI frames of each nibble of the color values, MSbit first */
+	uint8_t nibble_frames[16][4];
+#if defined(CONFIG_WS2812_STRIP_ASYNC)
+	struct spi_buf buf;
+	struct spi_buf_set tx;
+	struct k_sem tx_sem;
+	/* Cycle count at the end of the last transfer */
+	uint32_t tx_end;
+	/* Buffer encoded next, while the other one may be sent */
+	uint8_t back;
+	/* Pixels of the last update, missing from the back buffer */
+	size_t last_offset;
+	size_t last_count;
+#endif
+};
+
 static const struct ws2812_spi_cfg *dev_cfg(const struct device *dev)
 {
 	return dev->config;
@@ -57,16 +74,13 @@ static const struct ws2812_spi_cfg *dev_cfg(const struct device *dev)
 /*
  * Serialize an 8-bit color channel value into an equivalent sequence
  * of SPI frames, MSbit first, where a one bit becomes SPI frame
- * one_frame, and zero bit becomes zero_frame.
+ * one_frame, and zero bit becomes zero_frame, a nibble at a time.
  */
 static inline void ws2812_spi_ser(uint8_t buf[8], uint8_t color,
-				  const uint8_t one_frame, const uint8_t zero_frame)
+				  const uint8_t nibble_frames[16][4])
 {
-	int i;
-
-	for (i = 0; i < 8; i++) {
-		buf[i] = color & BIT(7 - i) ? one_frame : zero_frame;
-	}
+	memcpy(&buf[0], nibble_frames[color >> 4], 4);
+	memcpy(&buf[4], nibble_frames[color & 0x0F], 4);
 }
 
 /*
@@ -91,43 +105,25 @@ static inline void ws2812_reset_delay(uint16_t delay)
 	k_usleep(delay);
 }
 
-static int ws2812_strip_update_rgb(const struct device *dev,
-				   struct led_rgb *pixels,
-				   size_t num_pixels)
+/*
+ * Convert pixel data into SPI frames. Each frame has pixel data
+ * in color mapping on-wire format (e.g. GRB, GRBW, RGB, etc).
+ */
+static void ws2812_spi_encode(const struct device *dev, uint8_t *px_buf,
+			      const struct led_rgb *pixels, size_t num_pixels)
 {
 	const struct ws2812_spi_cfg *cfg = dev_cfg(dev);
-	const uint8_t one = cfg->one_frame, zero = cfg->zero_frame;
-	struct spi_buf buf = {
-		.buf = cfg->px_buf,
-		.len = cfg->px_buf_size,
-	};
-	const struct spi_buf_set tx = {
-		.buffers = &buf,
-		.count = 1
-	};
-	uint8_t *px_buf = cfg->px_buf;
+	struct ws2812_spi_data *data = dev->data;
 	size_t i;
-	int rc;
 
-	if (!num_pixels_ok(cfg, num_pixels)) {
-		return -ENOMEM;
-	}
-
-	/*
-	 * Convert pixel data into SPI frames. Each frame has pixel data
-	 * in color mapping on-wire format (e.g. GRB, GRBW, RGB, etc).
-	 */
 	for (i = 0; i < num_pixels; i++) {
 		uint8_t j;
 
 		for (j = 0; j < cfg->num_colors; j++) {
 			uint8_t pixel;
 
+			/* The color mapping is checked at init */
 			switch (cfg->color_mapping[j]) {
-			/* White channel is not supported by LED strip API. */
-			case LED_COLOR_ID_WHITE:
-				pixel = 0;
-				break;
 			case LED_COLOR_ID_RED:
 				pixel = pixels[i].r;
 				break;
@@ -137,13 +133,95 @@ static int ws2812_strip_update_rgb(const struct device *dev,
 			case LED_COLOR_ID_BLUE:
 				pixel = pixels[i].b;
 				break;
+			/* White channel is not supported by LED strip API. */
 			default:
-				return -EINVAL;
+				pixel = 0;
+				break;
 			}
-			ws2812_spi_ser(px_buf, pixel, one, zero);
+			ws2812_spi_ser(px_buf, pixel, data->nibble_frames);
 			px_buf += 8;
 		}
 	}
+}
+
+#if defined(CONFIG_WS2812_STRIP_ASYNC)
+static void ws2812_spi_tx_done(const struct device *dev, int result,
+			       void *user_data)
+{
+	struct ws2812_spi_data *data = user_data;
+
+	if (result < 0) {
+		LOG_ERR("Failed to send pixel data: %d", result);
+	}
+
+	data->tx_end = k_cycle_get_32();
+	k_sem_give(&data->tx_sem);
+}
+
+/*
+ * Encode the pixels into the back buffer while the front one may be sent,
+ * then send it once the front one is latched by the strip.
+ */
+static int ws2812_spi_update(const struct device *dev,
+			     const struct led_rgb *pixels, size_t offset,
+			     size_t num_pixels)
+{
+	const struct ws2812_spi_cfg *cfg = dev_cfg(dev);
+	struct ws2812_spi_data *data = dev->data;
+	const size_t px_size = cfg->num_colors * 8;
+	uint8_t *px_buf = &cfg->px_buf[data->back * cfg->px_buf_size];
+	const uint8_t *front = &cfg->px_buf[(data->back ^ 1) * cfg->px_buf_size];
+	uint32_t elapsed;
+	int rc;
+
+	/* The back buffer misses the pixels of the last update */
+	memcpy(&px_buf[data->last_offset * px_size],
+	       &front[data->last_offset * px_size], data->last_count * px_size);
+	ws2812_spi_encode(dev, &px_buf[offset * px_size], pixels, num_pixels);
+
+	k_sem_take(&data->tx_sem, K_FOREVER);
+	elapsed = k_cyc_to_us_floor32(k_cycle_get_32() - data->tx_end);
+	if (elapsed < cfg->reset_delay) {
+		ws2812_reset_delay(cfg->reset_delay - elapsed);
+	}
+
+	/* The pixels after the updated ones keep their color */
+	data->buf.buf = px_buf;
+	data->buf.len = (offset + num_pixels) * px_size;
+
+	rc = spi_transceive_cb(cfg->bus.bus, &cfg->bus.config, &data->tx, NULL,
+			       ws2812_spi_tx_done, data);
+	if (rc < 0) {
+		k_sem_give(&data->tx_sem);
+		return rc;
+	}
+
+	data->back ^= 1;
+	data->last_offset = offset;
+	data->last_count = num_pixels;
+
+	return 0;
+}
+#else
+static int ws2812_spi_update(const struct device *dev,
+			     const struct led_rgb *pixels, size_t offset,
+			     size_t num_pixels)
+{
+	const struct ws2812_spi_cfg *cfg = dev_cfg(dev);
+	const size_t px_size = cfg->num_colors * 8;
+	struct spi_buf buf = {
+		.buf = cfg->px_buf,
+		/* The pixels after the updated ones keep their color */
+		.len = (offset + num_pixels) * px_size,
+	};
+	const struct spi_buf_set tx = {
+		.buffers = &buf,
+		.count = 1
+	};
+	int rc;
+
+	ws2812_spi_encode(dev, &cfg->px_buf[offset * px_size], pixels,
+			  num_pixels);
 
 	/*
 	 * Display the pixel data.
@@ -153,6 +231,29 @@ static int ws2812_strip_update_rgb(const struct device *dev,
 
 	return rc;
 }
+#endif
+
+static int ws2812_strip_update_rgb_range(const struct device *dev,
+					 struct led_rgb *pixels,
+					 size_t offset, size_t num_pixels)
+{
+	const struct ws2812_spi_cfg *cfg = dev_cfg(dev);
+	size_t end;
+
+	if (size_add_overflow(offset, num_pixels, &end) ||
+	    !num_pixels_ok(cfg, end)) {
+		return -ENOMEM;
+	}
+
+	return ws2812_spi_update(dev, pixels, offset, num_pixels);
+}
+
+static int ws2812_strip_update_rgb(const struct device *dev,
+				   struct led_rgb *pixels,
+				   size_t num_pixels)
+{
+	return ws2812_strip_update_rgb_range(dev, pixels, 0, num_pixels);
+}
 
 static int ws2812_strip_update_channels(const struct device *dev,
 					uint8_t *channels,
@@ -165,6 +266,8 @@ static int ws2812_strip_update_channels(const struct device *dev,
 static int ws2812_spi_init(const struct device *dev)
 {
 	const struct ws2812_spi_cfg *cfg = dev_cfg(dev);
+	struct ws2812_spi_data *data = dev->data;
+	size_t num_bufs = IS_ENABLED(CONFIG_WS2812_STRIP_ASYNC) ? 2 : 1;
 	uint8_t i;
 
 	if (!spi_is_ready_dt(&cfg->bus)) {
@@ -187,12 +290,31 @@ static int ws2812_spi_init(const struct device *dev)
 		}
 	}
 
+	for (i = 0; i < ARRAY_SIZE(data->nibble_frames); i++) {
+		for (uint8_t j = 0; j < 4; j++) {
+			data->nibble_frames[i][j] = i & BIT(3 - j) ?
+				cfg->one_frame : cfg->zero_frame;
+		}
+	}
+
+	/* Start from black pixels, for the range updates */
+	for (size_t off = 0; off < num_bufs * cfg->px_buf_size; off += 8) {
+		ws2812_spi_ser(&cfg->px_buf[off], 0, data->nibble_frames);
+	}
+
+#if defined(CONFIG_WS2812_STRIP_ASYNC)
+	data->tx.buffers = &data->buf;
+	data->tx.count = 1;
+	k_sem_init(&data->tx_sem, 1, 1);
+#endif
+
 	return 0;
 }
 
 static const struct led_strip_driver_api ws2812_spi_api = {
 	.update_rgb = ws2812_strip_update_rgb,
 	.update_channels = ws2812_strip_update_channels,
+	.update_rgb_range = ws2812_strip_update_rgb_range,
 };
 
 #define WS2812_SPI_NUM_PIXELS(idx) \
@@ -205,6 +327,9 @@ static const struct led_strip_driver_api ws2812_spi_api = {
 	(DT_INST_PROP(idx, spi_zero_frame))
 #define WS2812_SPI_BUFSZ(idx) \
 	(WS2812_NUM_COLORS(idx) * 8 * WS2812_SPI_NUM_PIXELS(idx))
+/* Two buffers sent in turn by the asynchronous transfers */
+#define WS2812_SPI_NUM_BUFS \
+	COND_CODE_1(CONFIG_WS2812_STRIP_ASYNC, (2), (1))
 
 /*
  * Retrieve the channel to color mapping (e.g. RGB, BGR, GRB, ...) from the
@@ -221,7 +346,9 @@ static const struct led_strip_driver_api ws2812_spi_api = {
 
 #define WS2812_SPI_DEVICE(idx)						 \
 									 \
-	static uint8_t ws2812_spi_##idx##_px_buf[WS2812_SPI_BUFSZ(idx)]; \
+	static uint8_t ws2812_spi_##idx##_px_buf[WS2812_SPI_NUM_BUFS *	 \
+						 WS2812_SPI_BUFSZ(idx)]; \
+	static struct ws2812_spi_data ws2812_spi_##idx##_data;		 \
 									 \
 	WS2812_COLOR_MAPPING(idx);					 \
 									 \
@@ -239,7 +366,7 @@ static const struct led_strip_driver_api ws2812_spi_api = {
 	DEVICE_DT_INST_DEFINE(idx,					 \
 			      ws2812_spi_init,				 \
 			      NULL,					 \
-			      NULL,					 \
+			      &ws2812_spi_##idx##_data,			 \
 			      &ws2812_spi_##idx##_cfg,			 \
 			      POST_KERNEL,				 \
 			      CONFIG_LED_STRIP_INIT_PRIORITY,		 \
@@ -226,8 +226,116 @@ static int process_cmd(const struct modem_cmd *cmd, size_t match_len,
 	return ret;
 }
 
+static bool cmd_matches(struct modem_cmd_handler_data *data,
+			const struct modem_cmd *cmd)
+{
+	/* match on "empty" cmd */
+	return cmd->cmd[0] == '\0' || starts_with(data->rx_buf, cmd->cmd);
+}
+
+#if CONFIG_MODEM_CMD_HANDLER_INDEX_SIZE > 0
+static uint16_t cmd_key(const struct modem_cmd *cmd)
+{
+	return ((uint8_t)cmd->cmd[0] << 8) | (uint8_t)cmd->cmd[1];
+}
+
+/* key of the line at the beginning of rx_buf, which ends with a CR/LF */
+static uint16_t rx_key(struct net_buf *buf)
+{
+	uint8_t c[2] = { 0 };
+
+	(void)net_buf_linearize(c, sizeof(c), buf, 0, sizeof(c));
+
+	return (c[0] << 8) | c[1];
+}
+
+static void cmds_index_build(struct modem_cmd_handler_data *data, int j)
+{
+	const struct modem_cmd *cmds = data->cmds[j];
+	uint8_t *index = data->cmds_index[j];
+	size_t n_short = 0;
+	size_t n = 0;
+	size_t i, k;
+
+	data->cmds_indexed[j] = cmds != NULL &&
+		data->cmds_len[j] <= CONFIG_MODEM_CMD_HANDLER_INDEX_SIZE;
+	if (!data->cmds_indexed[j]) {
+		if (cmds != NULL) {
+			LOG_DBG("%zu commands, table %d not indexed",
+				data->cmds_len[j], j);
+		}
+
+		return;
+	}
+
+	for (i = 0; i < data->cmds_len[j]; i++) {
+		if (cmds[i].cmd_len < 2U) {
+			/* shift the longer commands up to keep these first */
+			memmove(&index[n_short + 1], &index[n_short],
+				n - n_short);
+			index[n_short++] = i;
+			n++;
+			continue;
+		}
+
+		/* insert after the commands of lower or equal key */
+		for (k = n; k > n_short &&
+		     cmd_key(&cmds[index[k - 1]]) > cmd_key(&cmds[i]); k--) {
+			index[k] = index[k - 1];
+		}
+
+		index[k] = i;
+		n++;
+	}
+
+	data->cmds_index_short[j] = n_short;
+}
+
 /*
- * check 3 arrays of commands for a match in match_buf:
+ * Walk the short commands and the commands of the key of the line in the
+ * order of the table, for the first one of the table matching to be found.
+ */
+static const struct modem_cmd *find_indexed_cmd_match(
+		struct modem_cmd_handler_data *data, int j, uint16_t key)
+{
+	const struct modem_cmd *cmds = data->cmds[j];
+	const uint8_t *index = data->cmds_index[j];
+	size_t n_short = data->cmds_index_short[j];
+	size_t lo = n_short, hi = data->cmds_len[j];
+	size_t s = 0, l, mid, i;
+	bool in_key;
+
+	while (lo < hi) {
+		mid = lo + (hi - lo) / 2;
+		if (cmd_key(&cmds[index[mid]]) < key) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+
+	l = lo;
+
+	while (true) {
+		in_key = l < data->cmds_len[j] && cmd_key(&cmds[index[l]]) == key;
+
+		if (s < n_short && (!in_key || index[s] < index[l])) {
+			i = index[s++];
+		} else if (in_key) {
+			i = index[l++];
+		} else {
+			return NULL;
+		}
+
+		if (cmd_matches(data, &cmds[i])) {
+			return &cmds[i];
+		}
+	}
+}
+#endif
+
+/*
+ * check 3 arrays of commands for a match at the beginning of rx_buf:
  * - response handlers[0]
  * - unsolicited handlers[1]
  * - current assigned handlers[2]
@@ -235,20 +343,33 @@ static int process_cmd(const struct modem_cmd *cmd, size_t match_len,
 static const struct modem_cmd *find_cmd_match(
 		struct modem_cmd_handler_data *data)
 {
+	const struct modem_cmd *cmd;
 	int j;
 	size_t i;
+#if CONFIG_MODEM_CMD_HANDLER_INDEX_SIZE > 0
+	uint16_t key = rx_key(data->rx_buf);
+#endif
 
 	for (j = 0; j < ARRAY_SIZE(data->cmds); j++) {
 		if (!data->cmds[j] || data->cmds_len[j] == 0U) {
 			continue;
 		}
 
+#if CONFIG_MODEM_CMD_HANDLER_INDEX_SIZE > 0
+		if (j < CMD_HANDLER && data->cmds_indexed[j]) {
+			cmd = find_indexed_cmd_match(data, j, key);
+			if (cmd) {
+				return cmd;
+			}
+
+			continue;
+		}
+#endif
+
 		for (i = 0; i < data->cmds_len[j]; i++) {
-			/* match on "empty" cmd */
-			if (strlen(data->cmds[j][i].cmd) == 0 ||
-			    strncmp(data->match_buf, data->cmds[j][i].cmd,
-				    data->cmds[j][i].cmd_len) == 0) {
-				return &data->cmds[j][i];
+			cmd = &data->cmds[j][i];
+			if (cmd_matches(data, cmd)) {
+				return cmd;
 			}
 		}
 	}
@@ -327,6 +448,39 @@ static int cmd_handler_process_iface_data(struct modem_cmd_handler_data *data,
 	}
 }
 
+/* copy the binary data passed through out of rx_buf */
+static void passthrough_rx_buf(struct modem_cmd_handler_data *data)
+{
+	size_t room, len;
+
+	k_sem_take(&data->sem_parse_lock, K_FOREVER);
+
+	while (data->rx_buf && data->passthrough_len > 0) {
+		len = MIN(data->rx_buf->len, data->passthrough_len);
+		room = data->passthrough_buf_len - data->passthrough_copied;
+
+		if (data->passthrough_buf && room > 0) {
+			memcpy(&data->passthrough_buf[data->passthrough_copied],
+			       data->rx_buf->data, MIN(len, room));
+			data->passthrough_copied += MIN(len, room);
+		}
+
+		data->passthrough_len -= len;
+		net_buf_pull(data->rx_buf, len);
+		if (!data->rx_buf->len) {
+			data->rx_buf = net_buf_frag_del(NULL, data->rx_buf);
+		}
+	}
+
+	if (data->passthrough_len == 0 && data->passthrough_cb) {
+		data->passthrough_cb(data, data->passthrough_copied,
+				     data->passthrough_user_data);
+		data->passthrough_cb = NULL;
+	}
+
+	k_sem_give(&data->sem_parse_lock);
+}
+
 static void cmd_handler_process_rx_buf(struct modem_cmd_handler_data *data)
 {
 	const struct modem_cmd *cmd;
@@ -337,6 +491,11 @@ static void cmd_handler_process_rx_buf(struct modem_cmd_handler_data *data)
 
 	/* process all of the data in the net_buf */
 	while (data->rx_buf && data->rx_buf->len) {
+		if (data->passthrough_len > 0) {
+			passthrough_rx_buf(data);
+			continue;
+		}
+
 		skipcrlf(data);
 		if (!data->rx_buf || !data->rx_buf->len) {
 			break;
@@ -368,24 +527,33 @@ static void cmd_handler_process_rx_buf(struct modem_cmd_handler_data *data)
 			break;
 		}
 
-		/* load match_buf with content up to the next CR/LF */
 		/* NOTE: keep room in match_buf for ending NUL char */
-		match_len = net_buf_linearize(data->match_buf,
-					      data->match_buf_len - 1,
-					      data->rx_buf, 0, len);
-		if ((data->match_buf_len - 1) < match_len) {
+		match_len = MIN(len, data->match_buf_len - 1);
+		if (match_len < len) {
 			LOG_ERR("Match buffer size (%zu) is too small for "
-				"incoming command size: %zu!  Truncating!",
-				data->match_buf_len - 1, match_len);
+				"incoming command size: %u!  Truncating!",
+				data->match_buf_len - 1, len);
+		}
+
+		k_sem_take(&data->sem_parse_lock, K_FOREVER);
+
+		cmd = find_cmd_match(data);
+
+		/*
+		 * load match_buf with content up to the next CR/LF, only
+		 * needed for the parameters to be parsed
+		 */
+		if (IS_ENABLED(CONFIG_MODEM_CONTEXT_VERBOSE_DEBUG) ||
+		    (cmd && cmd->arg_count_max > 0U)) {
+			(void)net_buf_linearize(data->match_buf, match_len,
+						data->rx_buf, 0, match_len);
+			data->match_buf[match_len] = '\0';
 		}
 
 #if defined(CONFIG_MODEM_CONTEXT_VERBOSE_DEBUG)
 		LOG_HEXDUMP_DBG(data->match_buf, match_len, "RECV");
 #endif
 
-		k_sem_take(&data->sem_parse_lock, K_FOREVER);
-
-		cmd = find_cmd_match(data);
 		if (cmd) {
 			LOG_DBG("match cmd [%s] (len:%zu)",
 				cmd->cmd, match_len);
@@ -409,6 +577,12 @@ static void cmd_handler_process_rx_buf(struct modem_cmd_handler_data *data)
 				break;
 			}
 
+			if (data->passthrough_len > 0) {
+				/* the rest of the line is binary data */
+				k_sem_give(&data->sem_parse_lock);
+				continue;
+			}
+
 			frag = NULL;
 			/*
 			 * We've handled the current line.
@@ -492,6 +666,37 @@ int modem_cmd_handler_update_cmds(struct modem_cmd_handler_data *data,
 	return 0;
 }
 
+int modem_cmd_handler_passthrough(struct modem_cmd_handler_data *data,
+				  uint8_t *buf, size_t buf_len, size_t len,
+				  modem_cmd_passthrough_cb_t cb,
+				  void *user_data)
+{
+	if (!data || len == 0) {
+		return -EINVAL;
+	}
+
+	data->passthrough_buf = buf;
+	data->passthrough_buf_len = buf ? buf_len : 0;
+	data->passthrough_copied = 0;
+	data->passthrough_cb = cb;
+	data->passthrough_user_data = user_data;
+	data->passthrough_len = len;
+
+	return 0;
+}
+
+void modem_cmd_handler_passthrough_drop(struct modem_cmd_handler_data *data)
+{
+	k_sem_take(&data->sem_parse_lock, K_FOREVER);
+
+	/* keep skipping the data, which is not made of commands */
+	data->passthrough_buf = NULL;
+	data->passthrough_buf_len = 0;
+	data->passthrough_cb = NULL;
+
+	k_sem_give(&data->sem_parse_lock);
+}
+
 int modem_cmd_send_ext(struct modem_iface *iface,
 		       struct modem_cmd_handler *handler,
 		       const struct modem_cmd *handler_cmds,
@@ -691,12 +896,19 @@ int modem_cmd_handler_init(struct modem_cmd_handler *handler,
 	data->cmds[CMD_UNSOL] = config->unsol_cmds;
 	data->cmds_len[CMD_UNSOL] = config->unsol_cmds_len;
 
+#if CONFIG_MODEM_CMD_HANDLER_INDEX_SIZE > 0
+	cmds_index_build(data, CMD_RESP);
+	cmds_index_build(data, CMD_UNSOL);
+#endif
+
 	/* Process end of line */
 	data->eol_len = data->eol == NULL ? 0 : strlen(data->eol);
 
 	/* Store optional user data */
 	data->user_data = config->user_data;
 
+	data->passthrough_len = 0;
+
 	/* Initialize command handler data members */
 	k_sem_init(&data->sem_tx_lock, 1, 1);
 	k_sem_init(&data->sem_parse_lock, 1, 1);
@@ -96,10 +96,38 @@ struct setup_cmd {
 	struct modem_cmd handle_cmd;
 };
 
+/**
+ * @brief Callback called once the binary data passed through is received
+ *
+ * @param data Command handler data reference
+ * @param len Number of bytes copied to the buffer
+ * @param user_data User data given to modem_cmd_handler_passthrough()
+ */
+typedef void (*modem_cmd_passthrough_cb_t)(struct modem_cmd_handler_data *data,
+					   size_t len, void *user_data);
+
 struct modem_cmd_handler_data {
 	const struct modem_cmd *cmds[CMD_MAX];
 	size_t cmds_len[CMD_MAX];
 
+#if CONFIG_MODEM_CMD_HANDLER_INDEX_SIZE > 0
+	/*
+	 * response and unsolicited commands sorted by their first two
+	 * characters, after the commands of less than two characters
+	 */
+	uint8_t cmds_index[CMD_HANDLER][CONFIG_MODEM_CMD_HANDLER_INDEX_SIZE];
+	uint8_t cmds_index_short[CMD_HANDLER];
+	bool cmds_indexed[CMD_HANDLER];
+#endif
+
+	/* binary data passed through */
+	uint8_t *passthrough_buf;
+	size_t passthrough_buf_len;
+	size_t passthrough_len;
+	size_t passthrough_copied;
+	modem_cmd_passthrough_cb_t passthrough_cb;
+	void *passthrough_user_data;
+
 	char *match_buf;
 	size_t match_buf_len;
 
@@ -158,6 +186,40 @@ int modem_cmd_handler_update_cmds(struct modem_cmd_handler_data *data,
 				  size_t handler_cmds_len,
 				  bool reset_error_flag);
 
+/**
+ * @brief  pass binary data received through to a buffer
+ *
+ * Called from a command handler, once the rx buffer starts with the data.
+ * The next @a len bytes received are copied to @a buf as they arrive,
+ * without being scanned for commands nor kept in the rx buffer, the bytes
+ * which do not fit in @a buf being dropped. @a cb is called once all of
+ * them have been received.
+ *
+ * @param  data: command handler data reference
+ * @param  buf: buffer of the data, NULL to drop it
+ * @param  buf_len: size of the buffer
+ * @param  len: number of bytes of data
+ * @param  cb: callback called once the data is received, or NULL
+ * @param  user_data: user data of the callback
+ *
+ * @retval 0 if ok, < 0 if error.
+ */
+int modem_cmd_handler_passthrough(struct modem_cmd_handler_data *data,
+				  uint8_t *buf, size_t buf_len, size_t len,
+				  modem_cmd_passthrough_cb_t cb,
+				  void *user_data);
+
+/**
+ * @brief  drop the rest of the binary data passed through
+ *
+ * The buffer given to modem_cmd_handler_passthrough() is no longer written
+ * once this function returns, for it to be released before all of the data
+ * is received, such as on a timeout. The callback is not called.
+ *
+ * @param  data: command handler data reference
+ */
+void modem_cmd_handler_passthrough_drop(struct modem_cmd_handler_data *data);
+
 /**
  * @brief  send AT command to interface with behavior defined by flags
  *
@@ -118,7 +118,9 @@ static int on_cmd_sockread_common(int socket_fd,
 {
 	struct modem_socket	 *sock = NULL;
 	struct socket_read_data	 *sock_data;
-	int ret, i;
+	uint8_t			 *recv_buf = NULL;
+	size_t			 recv_buf_len = 0;
+	int ret;
 	int socket_data_length;
 	int bytes_to_skip;
 
@@ -136,27 +138,20 @@ static int on_cmd_sockread_common(int socket_fd,
 	socket_data_length = find_len(data->rx_buf->data);
 
 	/* No (or not enough) data available on the socket. */
-	bytes_to_skip = digits(socket_data_length) + 2 + 4;
+	bytes_to_skip = digits(socket_data_length) + 2;
 	if (socket_data_length <= 0) {
 		LOG_ERR("Length problem (%d).  Aborting!", socket_data_length);
 		return -EAGAIN;
 	}
 
-	/* check to make sure we have all of the data. */
-	if (net_buf_frags_len(data->rx_buf) < (socket_data_length + bytes_to_skip)) {
+	/* check to make sure we have all of the header. */
+	if (net_buf_frags_len(data->rx_buf) < bytes_to_skip) {
 		LOG_DBG("Not enough data -- wait!");
 		return -EAGAIN;
 	}
 
 	/* Skip "len" and CRLF */
-	bytes_to_skip = digits(socket_data_length) + 2;
-	for (i = 0; i < bytes_to_skip; i++) {
-		net_buf_pull_u8(data->rx_buf);
-	}
-
-	if (!data->rx_buf->len) {
-		data->rx_buf = net_buf_frag_del(NULL, data->rx_buf);
-	}
+	data->rx_buf = net_buf_skip(data->rx_buf, bytes_to_skip);
 
 	sock = modem_socket_from_fd(&mdata.socket_config, socket_fd);
 	if (!sock) {
@@ -172,9 +167,9 @@ static int on_cmd_sockread_common(int socket_fd,
 		goto exit;
 	}
 
-	ret = net_buf_linearize(sock_data->recv_buf, sock_data->recv_buf_len,
-				data->rx_buf, 0, (uint16_t)socket_data_length);
-	data->rx_buf = net_buf_skip(data->rx_buf, ret);
+	recv_buf = (uint8_t *)sock_data->recv_buf;
+	recv_buf_len = sock_data->recv_buf_len;
+	ret = MIN(socket_data_length, recv_buf_len);
 	sock_data->recv_read_len = ret;
 	if (ret != socket_data_length) {
 		LOG_ERR("Total copied data is different then received data!"
@@ -183,6 +178,10 @@ static int on_cmd_sockread_common(int socket_fd,
 	}
 
 exit:
+	/* copy the data to the socket buffer as it is received, or drop it */
+	(void)modem_cmd_handler_passthrough(data, recv_buf, recv_buf_len,
+					    socket_data_length, NULL, NULL);
+
 	/* remove packet from list (ignore errors) */
 	(void)modem_socket_packet_size_update(&mdata.socket_config, sock,
 					      -socket_data_length);
@@ -611,6 +610,8 @@ static ssize_t offload_recvfrom(void *obj, void *buf, size_t len,
 			     data_cmd, ARRAY_SIZE(data_cmd), sendbuf, &mdata.sem_response,
 			     MDM_CMD_TIMEOUT);
 	if (ret < 0) {
+		/* the data may still be received, not into buf */
+		modem_cmd_handler_passthrough_drop(&mdata.cmd_handler_data);
 		errno = -ret;
 		ret = -1;
 		goto exit;
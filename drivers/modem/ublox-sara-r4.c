@@ -779,6 +779,8 @@ static int on_cmd_sockread_common(int socket_id,
 {
 	struct modem_socket *sock = NULL;
 	struct socket_read_data *sock_data;
+	uint8_t *recv_buf = NULL;
+	size_t recv_buf_len = 0;
 	int ret;
 
 	if (!len) {
@@ -801,12 +803,6 @@ static int on_cmd_sockread_common(int socket_id,
 		return -EAGAIN;
 	}
 
-	/* check to make sure we have all of the data (minus quotes) */
-	if ((net_buf_frags_len(data->rx_buf) - 2) < socket_data_length) {
-		LOG_DBG("Not enough data -- wait!");
-		return -EAGAIN;
-	}
-
 	/* skip quote */
 	len--;
 	net_buf_pull_u8(data->rx_buf);
@@ -828,9 +824,9 @@ static int on_cmd_sockread_common(int socket_id,
 		goto exit;
 	}
 
-	ret = net_buf_linearize(sock_data->recv_buf, sock_data->recv_buf_len,
-				data->rx_buf, 0, (uint16_t)socket_data_length);
-	data->rx_buf = net_buf_skip(data->rx_buf, ret);
+	recv_buf = (uint8_t *)sock_data->recv_buf;
+	recv_buf_len = sock_data->recv_buf_len;
+	ret = MIN(socket_data_length, recv_buf_len);
 	sock_data->recv_read_len = ret;
 	if (ret != socket_data_length) {
 		LOG_ERR("Total copied data is different then received data!"
@@ -839,6 +835,10 @@ static int on_cmd_sockread_common(int socket_id,
 	}
 
 exit:
+	/* copy the data to the socket buffer as it is received, or drop it */
+	(void)modem_cmd_handler_passthrough(data, recv_buf, recv_buf_len,
+					    socket_data_length, NULL, NULL);
+
 	/* remove packet from list (ignore errors) */
 	(void)modem_socket_packet_size_update(&mdata.socket_config, sock,
 					      -socket_data_length);
@@ -1659,6 +1659,8 @@ static ssize_t offload_recvfrom(void *obj, void *buf, size_t len,
 			     cmd, ARRAY_SIZE(cmd), sendbuf, &mdata.sem_response,
 			     MDM_CMD_TIMEOUT);
 	if (ret < 0) {
+		/* the data may still be received, not into buf */
+		modem_cmd_handler_passthrough_drop(&mdata.cmd_handler_data);
 		errno = -ret;
 		ret = -1;
 		goto exit;
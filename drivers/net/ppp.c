@@ -29,6 +29,7 @@ LOG_MODULE_REGISTER(net_ppp, LOG_LEVEL);
 #include <zephyr/net/net_core.h>
 #include <zephyr/sys/ring_buffer.h>
 #include <zephyr/sys/crc.h>
+#include <zephyr/sys/byteorder.h>
 #include <zephyr/drivers/uart.h>
 #include <zephyr/drivers/console/uart_mux.h>
 #include <zephyr/random/rand32.h>
@@ -39,6 +40,15 @@ LOG_MODULE_REGISTER(net_ppp, LOG_LEVEL);
 #define UART_BUF_LEN CONFIG_NET_PPP_UART_BUF_LEN
 #define UART_TX_BUF_LEN CONFIG_NET_PPP_ASYNC_UART_TX_BUF_LEN
 
+#if defined(CONFIG_NET_PPP_ASYNC_UART)
+/* The send buffer is used in two halves, one is filled while the UART
+ * is transmitting the other one.
+ */
+#define SEND_BUF_LEN (UART_TX_BUF_LEN / 2)
+#else
+#define SEND_BUF_LEN UART_BUF_LEN
+#endif
+
 enum ppp_driver_state {
 	STATE_HDLC_FRAME_START,
 	STATE_HDLC_FRAME_ADDRESS,
@@ -69,6 +79,8 @@ struct ppp_driver_context {
 
 	/* ppp buf use when sending data */
 	uint8_t send_buf[UART_TX_BUF_LEN];
+	/* half of send_buf being filled */
+	uint8_t send_half;
 #else
 	/* ppp buf use when sending data */
 	uint8_t send_buf[UART_BUF_LEN];
@@ -253,8 +265,10 @@ static void uart_recovery(struct k_work *work)
 }
 #endif
 
-static int ppp_save_byte(struct ppp_driver_context *ppp, uint8_t byte)
+static int ppp_save_bytes(struct ppp_driver_context *ppp, const uint8_t *data,
+			  size_t len)
 {
+	size_t chunk;
 	int ret;
 
 	if (!ppp->pkt) {
@@ -276,33 +290,37 @@ static int ppp_save_byte(struct ppp_driver_context *ppp, uint8_t byte)
 	 * needed. Normally it would just print too much data.
 	 */
 	if (0) {
-		LOG_DBG("Saving byte %02x", byte);
+		LOG_HEXDUMP_DBG(data, len, "Saving");
 	}
 
-	/* This is not very intuitive but we must allocate new buffer
-	 * before we write a byte to last available cursor position.
-	 */
-	if (ppp->available == 1) {
-		ret = net_pkt_alloc_buffer(ppp->pkt,
-					   CONFIG_NET_BUF_DATA_SIZE,
-					   AF_UNSPEC, K_NO_WAIT);
-		if (ret < 0) {
-			LOG_ERR("[%p] cannot allocate new data buffer", ppp);
-			goto out_of_mem;
+	while (len > 0) {
+		/* This is not very intuitive but we must allocate new buffer
+		 * before we write a byte to last available cursor position.
+		 */
+		if (ppp->available <= 1) {
+			ret = net_pkt_alloc_buffer(ppp->pkt,
+						   CONFIG_NET_BUF_DATA_SIZE,
+						   AF_UNSPEC, K_NO_WAIT);
+			if (ret < 0) {
+				LOG_ERR("[%p] cannot allocate new data buffer", ppp);
+				goto out_of_mem;
+			}
+
+			ppp->available = net_pkt_available_buffer(ppp->pkt);
 		}
 
-		ppp->available = net_pkt_available_buffer(ppp->pkt);
-	}
+		chunk = MIN(len, ppp->available - 1);
 
-	if (ppp->available) {
-		ret = net_pkt_write_u8(ppp->pkt, byte);
+		ret = net_pkt_write(ppp->pkt, data, chunk);
 		if (ret < 0) {
 			LOG_ERR("[%p] Cannot write to pkt %p (%d)",
 				ppp, ppp->pkt, ret);
 			goto out_of_mem;
 		}
 
-		ppp->available--;
+		ppp->available -= chunk;
+		data += chunk;
+		len -= chunk;
 	}
 
 	return 0;
@@ -313,6 +331,11 @@ out_of_mem:
 	return -ENOMEM;
 }
 
+static inline int ppp_save_byte(struct ppp_driver_context *ppp, uint8_t byte)
+{
+	return ppp_save_bytes(ppp, &byte, 1);
+}
+
 static const char *ppp_driver_state_str(enum ppp_driver_state state)
 {
 #if (CONFIG_NET_PPP_LOG_LEVEL >= LOG_LEVEL_DBG)
@@ -350,12 +373,25 @@ static void ppp_change_state(struct ppp_driver_context *ctx,
 	ctx->state = new_state;
 }
 
+static inline uint8_t *ppp_send_buf(struct ppp_driver_context *ppp)
+{
+#if defined(CONFIG_NET_PPP_ASYNC_UART)
+	return &ppp->send_buf[ppp->send_half * SEND_BUF_LEN];
+#else
+	return ppp->send_buf;
+#endif
+}
+
 static int ppp_send_flush(struct ppp_driver_context *ppp, int off)
 {
 	if (IS_ENABLED(CONFIG_NET_TEST)) {
 		return 0;
 	}
-	uint8_t *buf = ppp->send_buf;
+	uint8_t *buf = ppp_send_buf(ppp);
+
+	if (off == 0) {
+		return 0;
+	}
 
 	/* If we're using gsm_mux, We don't want to use poll_out because sending
 	 * one byte at a time causes each byte to get wrapped in muxing headers.
@@ -368,6 +404,9 @@ static int ppp_send_flush(struct ppp_driver_context *ppp, int off)
 #if defined(CONFIG_NET_PPP_ASYNC_UART)
 		int ret;
 
+		/* Wait for the other half to be sent, the next bytes go
+		 * there while this one is being transmitted.
+		 */
 		k_sem_take(&uarte_tx_finished, K_FOREVER);
 
 		ret = uart_tx(ppp->dev, buf, off,
@@ -375,6 +414,8 @@ static int ppp_send_flush(struct ppp_driver_context *ppp, int off)
 		if (ret) {
 			LOG_ERR("uart_tx() failed, err %d", ret);
 			k_sem_give(&uarte_tx_finished);
+		} else {
+			ppp->send_half ^= 1U;
 		}
 #endif
 	} else {
@@ -389,19 +430,55 @@ static int ppp_send_flush(struct ppp_driver_context *ppp, int off)
 static int ppp_send_bytes(struct ppp_driver_context *ppp,
 			  const uint8_t *data, int len, int off)
 {
+	uint8_t *buf = ppp_send_buf(ppp);
 	int i;
 
 	for (i = 0; i < len; i++) {
-		ppp->send_buf[off++] = data[i];
+		buf[off++] = data[i];
 
-		if (off >= sizeof(ppp->send_buf)) {
+		if (off >= SEND_BUF_LEN) {
 			off = ppp_send_flush(ppp, off);
+			buf = ppp_send_buf(ppp);
 		}
 	}
 
 	return off;
 }
 
+static inline bool ppp_needs_escape(uint8_t byte)
+{
+	return byte == 0x7e || byte == 0x7d || byte < 0x20;
+}
+
+/* Copy a whole buffer to the send buffer, escaping the bytes RFC 1662
+ * ch. 4.2 requires.
+ */
+static int ppp_send_escaped(struct ppp_driver_context *ppp,
+			    const uint8_t *data, size_t len, int off)
+{
+	uint8_t *buf = ppp_send_buf(ppp);
+	const uint8_t *end = data + len;
+
+	while (data < end) {
+		uint8_t byte = *data++;
+
+		/* Always leave room for an escaped byte */
+		if (off >= SEND_BUF_LEN - 1) {
+			off = ppp_send_flush(ppp, off);
+			buf = ppp_send_buf(ppp);
+		}
+
+		if (ppp_needs_escape(byte)) {
+			buf[off++] = 0x7d;
+			byte ^= 0x20;
+		}
+
+		buf[off++] = byte;
+	}
+
+	return off;
+}
+
 #if defined(CONFIG_PPP_CLIENT_CLIENTSERVER)
 
 #define CLIENT "CLIENT"
@@ -706,17 +783,6 @@ static bool calc_fcs(struct net_pkt *pkt, uint16_t *fcs, uint16_t protocol)
 	return true;
 }
 
-static uint16_t ppp_escape_byte(uint8_t byte, int *offset)
-{
-	if (byte == 0x7e || byte == 0x7d || byte < 0x20) {
-		*offset = 0;
-		return (0x7d << 8) | (byte ^ 0x20);
-	}
-
-	*offset = 1;
-	return byte;
-}
-
 static int ppp_send(const struct device *dev, struct net_pkt *pkt)
 {
 	struct ppp_driver_context *ppp = dev->data;
@@ -724,9 +790,9 @@ static int ppp_send(const struct device *dev, struct net_pkt *pkt)
 	uint16_t protocol = 0;
 	int send_off = 0;
 	uint32_t sync_addr_ctrl;
-	uint16_t fcs, escaped;
+	uint8_t fcs_bytes[2];
+	uint16_t fcs;
 	uint8_t byte;
-	int i, offset;
 
 #if defined(CONFIG_NET_TEST)
 	return 0;
@@ -763,15 +829,8 @@ static int ppp_send(const struct device *dev, struct net_pkt *pkt)
 				  sizeof(sync_addr_ctrl), send_off);
 
 	if (protocol > 0) {
-		escaped = htons(ppp_escape_byte(protocol, &offset));
-		send_off = ppp_send_bytes(ppp, (uint8_t *)&escaped + offset,
-					  offset ? 1 : 2,
-					  send_off);
-
-		escaped = htons(ppp_escape_byte(protocol >> 8, &offset));
-		send_off = ppp_send_bytes(ppp, (uint8_t *)&escaped + offset,
-					  offset ? 1 : 2,
-					  send_off);
+		send_off = ppp_send_escaped(ppp, (const uint8_t *)&protocol,
+					    sizeof(protocol), send_off);
 	}
 
 	/* Note that we do not print the first four bytes and FCS bytes at the
@@ -783,27 +842,13 @@ static int ppp_send(const struct device *dev, struct net_pkt *pkt)
 	}
 
 	while (buf) {
-		for (i = 0; i < buf->len; i++) {
-			/* Escape illegal bytes */
-			escaped = htons(ppp_escape_byte(buf->data[i], &offset));
-			send_off = ppp_send_bytes(ppp,
-						  (uint8_t *)&escaped + offset,
-						  offset ? 1 : 2,
-						  send_off);
-		}
-
+		send_off = ppp_send_escaped(ppp, buf->data, buf->len, send_off);
 		buf = buf->frags;
 	}
 
-	escaped = htons(ppp_escape_byte(fcs, &offset));
-	send_off = ppp_send_bytes(ppp, (uint8_t *)&escaped + offset,
-				  offset ? 1 : 2,
-				  send_off);
-
-	escaped = htons(ppp_escape_byte(fcs >> 8, &offset));
-	send_off = ppp_send_bytes(ppp, (uint8_t *)&escaped + offset,
-				  offset ? 1 : 2,
-				  send_off);
+	/* FCS is sent least significant byte first */
+	sys_put_le16(fcs, fcs_bytes);
+	send_off = ppp_send_escaped(ppp, fcs_bytes, sizeof(fcs_bytes), send_off);
 
 	byte = 0x7e;
 	send_off = ppp_send_bytes(ppp, &byte, 1, send_off);
@@ -814,10 +859,45 @@ static int ppp_send(const struct device *dev, struct net_pkt *pkt)
 }
 
 #if !defined(CONFIG_NET_TEST)
+/* Deframe a whole buffer. Runs of plain bytes inside a frame are saved in
+ * one go, only the flags and escapes go through ppp_input_byte().
+ */
+static void ppp_input(struct ppp_driver_context *ppp, const uint8_t *data,
+		      size_t len)
+{
+	const uint8_t *end = data + len;
+	const uint8_t *run;
+
+	while (data < end) {
+		if (ppp->state == STATE_HDLC_FRAME_DATA && !ppp->next_escaped) {
+			run = data;
+
+			while (data < end && *data != 0x7e && *data != 0x7d) {
+				data++;
+			}
+
+			if (data > run) {
+				if (ppp_save_bytes(ppp, run, data - run) < 0) {
+					ppp_change_state(ppp, STATE_HDLC_FRAME_START);
+				}
+
+				continue;
+			}
+		}
+
+		if (ppp_input_byte(ppp, *data++) == 0) {
+			/* Ignore empty or too short frames */
+			if (ppp->pkt && net_pkt_get_len(ppp->pkt) > 3) {
+				ppp_process_msg(ppp);
+			}
+		}
+	}
+}
+
 static int ppp_consume_ringbuf(struct ppp_driver_context *ppp)
 {
 	uint8_t *data;
-	size_t len, tmp;
+	size_t len;
 	int ret;
 
 	len = ring_buf_get_claim(&ppp->rx_ringbuf, &data,
@@ -832,16 +912,7 @@ static int ppp_consume_ringbuf(struct ppp_driver_context *ppp)
 		LOG_HEXDUMP_DBG(data, len, ppp->dev->name);
 	}
 
-	tmp = len;
-
-	do {
-		if (ppp_input_byte(ppp, *data++) == 0) {
-			/* Ignore empty or too short frames */
-			if (ppp->pkt && net_pkt_get_len(ppp->pkt) > 3) {
-				ppp_process_msg(ppp);
-			}
-		}
-	} while (--tmp);
+	ppp_input(ppp, data, len);
 
 	ret = ring_buf_get_finish(&ppp->rx_ringbuf, len);
 	if (ret < 0) {
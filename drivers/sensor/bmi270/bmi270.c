@@ -776,6 +776,10 @@ static const struct sensor_driver_api bmi270_driver_api = {
 #if defined(CONFIG_BMI270_TRIGGER)
 	.trigger_set = bmi270_trigger_set,
 #endif
+#if defined(CONFIG_BMI270_STREAM)
+	.submit = bmi270_submit,
+	.get_decoder = bmi270_get_decoder,
+#endif
 };
 
 static const struct bmi270_feature_config bmi270_feature_max_fifo = {
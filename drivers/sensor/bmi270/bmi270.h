@@ -28,6 +28,7 @@
 #define BMI270_REG_SENSORTIME_0    0x18
 #define BMI270_REG_EVENT           0x1B
 #define BMI270_REG_INT_STATUS_0    0x1C
+#define BMI270_REG_INT_STATUS_1    0x1D
 #define BMI270_REG_SC_OUT_0        0x1E
 #define BMI270_REG_WR_GEST_ACT     0x20
 #define BMI270_REG_INTERNAL_STATUS 0x21
@@ -44,6 +45,7 @@
 #define BMI270_REG_FIFO_DOWNS      0x45
 #define BMI270_REG_FIFO_WTM_0      0x46
 #define BMI270_REG_FIFO_CONFIG_0   0x48
+#define BMI270_REG_FIFO_CONFIG_1   0x49
 #define BMI270_REG_SATURATION      0x4A
 #define BMI270_REG_AUX_DEV_ID      0x4B
 #define BMI270_REG_AUX_IF_CONF     0x4C
@@ -125,12 +127,46 @@
 
 #define BMI270_INT_STATUS_ANY_MOTION		BIT(6)
 
+#define BMI270_INT_STATUS_1_FFULL		BIT(0)
+#define BMI270_INT_STATUS_1_FWM			BIT(1)
+
+#define BMI270_FIFO_LENGTH_MSK			GENMASK(13, 0)
+#define BMI270_FIFO_WTM_MSK			GENMASK(12, 0)
+
+#define BMI270_FIFO_CONFIG_1_HEADER_EN		BIT(4)
+#define BMI270_FIFO_CONFIG_1_AUX_EN		BIT(5)
+#define BMI270_FIFO_CONFIG_1_ACC_EN		BIT(6)
+#define BMI270_FIFO_CONFIG_1_GYR_EN		BIT(7)
+
+/* Headers of the FIFO frames in header mode */
+#define BMI270_FIFO_HEADER_MODE_MSK		GENMASK(7, 6)
+#define BMI270_FIFO_HEADER_MODE_REGULAR		0x80
+#define BMI270_FIFO_HEADER_MODE_CONTROL		0x40
+#define BMI270_FIFO_HEADER_ACC			BIT(2)
+#define BMI270_FIFO_HEADER_GYR			BIT(3)
+#define BMI270_FIFO_HEADER_AUX			BIT(4)
+#define BMI270_FIFO_HEADER_EMPTY		0x80
+#define BMI270_FIFO_HEADER_SKIP			0x40
+#define BMI270_FIFO_HEADER_SENSORTIME		0x44
+#define BMI270_FIFO_HEADER_CONFIG_CHANGE	0x48
+
+/* Sizes of the FIFO frame payloads */
+#define BMI270_FIFO_ACC_LEN			6
+#define BMI270_FIFO_GYR_LEN			6
+#define BMI270_FIFO_AUX_LEN			8
+#define BMI270_FIFO_SKIP_LEN			1
+#define BMI270_FIFO_SENSORTIME_LEN		3
+#define BMI270_FIFO_CONFIG_CHANGE_LEN		4
+#define BMI270_FIFO_FRAME_MAX_LEN \
+	(1 + BMI270_FIFO_AUX_LEN + BMI270_FIFO_GYR_LEN + BMI270_FIFO_ACC_LEN)
+#define BMI270_FIFO_SIZE			2048
+
 #define BMI270_CHIP_ID 0x24
 
 #define BMI270_CMD_G_TRIGGER  0x02
 #define BMI270_CMD_USR_GAIN   0x03
 #define BMI270_CMD_NVM_PROG   0xA0
-#define BMI270_CMD_FIFO_FLUSH OxB0
+#define BMI270_CMD_FIFO_FLUSH 0xB0
 #define BMI270_CMD_SOFT_RESET 0xB6
 
 #define BMI270_POWER_ON_TIME                500
@@ -285,8 +321,31 @@ struct bmi270_data {
 	struct k_work trig_work;
 #endif
 #endif /* CONFIG_BMI270_TRIGGER */
+
+#ifdef CONFIG_BMI270_STREAM
+	struct rtio_iodev_sqe *streaming_sqe;
+	bool streaming;
+#endif
 };
 
+/*
+ * Buffer of the asynchronous API: the header is followed by fifo_count bytes of FIFO frames in
+ * header mode, the timestamp being the one of the last frame. One-shot reads are encoded as a
+ * single frame.
+ */
+struct bmi270_fifo_data {
+	uint64_t timestamp;
+	uint8_t int_status;
+	uint8_t acc_range;
+	uint16_t gyr_range;
+	uint8_t acc_odr: 4;
+	uint8_t gyr_odr: 4;
+	uint8_t acc_en: 1;
+	uint8_t gyr_en: 1;
+	uint8_t reserved: 6;
+	uint16_t fifo_count;
+} __packed;
+
 struct bmi270_feature_reg {
 	/* Which feature page the register resides in */
 	uint8_t page;
@@ -367,4 +426,13 @@ int bmi270_trigger_set(const struct device *dev,
 int bmi270_init_interrupts(const struct device *dev);
 #endif
 
+#ifdef CONFIG_BMI270_STREAM
+int bmi270_submit(const struct device *dev, struct rtio_iodev_sqe *iodev_sqe);
+
+int bmi270_get_decoder(const struct device *dev, const struct sensor_decoder_api **decoder);
+
+/* Read the FIFO into the streaming read, called from the trigger thread */
+void bmi270_fifo_event(const struct device *dev);
+#endif
+
 #endif /* ZEPHYR_DRIVERS_SENSOR_BMI270_BMI270_H_ */
@@ -0,0 +1,361 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#define DT_DRV_COMPAT bosch_bmi270
+
+#include <errno.h>
+
+#include <zephyr/drivers/sensor.h>
+#include <zephyr/sys/byteorder.h>
+
+#include "bmi270.h"
+
+/*
+ * The frames have a variable length, so the frame iterator is the offset of the next frame in
+ * the FIFO data, and the channel iterator the next of the channels below.
+ */
+static const enum sensor_channel bmi270_channels[] = {
+	SENSOR_CHAN_ACCEL_X, SENSOR_CHAN_ACCEL_Y, SENSOR_CHAN_ACCEL_Z,
+	SENSOR_CHAN_GYRO_X,  SENSOR_CHAN_GYRO_Y,  SENSOR_CHAN_GYRO_Z,
+};
+
+/* Length of the frame starting at @p frame, 0 at the end of the FIFO data */
+static uint16_t bmi270_frame_len(const uint8_t *frame, uint16_t remaining)
+{
+	uint8_t header = frame[0];
+	uint16_t len = 1;
+
+	if (header == BMI270_FIFO_HEADER_EMPTY) {
+		return 0;
+	}
+
+	switch (header & BMI270_FIFO_HEADER_MODE_MSK) {
+	case BMI270_FIFO_HEADER_MODE_REGULAR:
+		if (header & BMI270_FIFO_HEADER_AUX) {
+			len += BMI270_FIFO_AUX_LEN;
+		}
+		if (header & BMI270_FIFO_HEADER_GYR) {
+			len += BMI270_FIFO_GYR_LEN;
+		}
+		if (header & BMI270_FIFO_HEADER_ACC) {
+			len += BMI270_FIFO_ACC_LEN;
+		}
+		break;
+	case BMI270_FIFO_HEADER_MODE_CONTROL:
+		switch (header) {
+		case BMI270_FIFO_HEADER_SKIP:
+			len += BMI270_FIFO_SKIP_LEN;
+			break;
+		case BMI270_FIFO_HEADER_SENSORTIME:
+			len += BMI270_FIFO_SENSORTIME_LEN;
+			break;
+		case BMI270_FIFO_HEADER_CONFIG_CHANGE:
+			len += BMI270_FIFO_CONFIG_CHANGE_LEN;
+			break;
+		default:
+			return 0;
+		}
+		break;
+	default:
+		return 0;
+	}
+
+	return len <= remaining ? len : 0;
+}
+
+static bool bmi270_is_data_frame(uint8_t header)
+{
+	return (header & BMI270_FIFO_HEADER_MODE_MSK) == BMI270_FIFO_HEADER_MODE_REGULAR &&
+	       (header & (BMI270_FIFO_HEADER_ACC | BMI270_FIFO_HEADER_GYR)) != 0;
+}
+
+/* Get the sample of a channel position in a data frame, NULL if the frame does not hold it */
+static const uint8_t *bmi270_frame_sample(const uint8_t *frame, int pos)
+{
+	uint8_t header = frame[0];
+	const uint8_t *gyr = &frame[1];
+	const uint8_t *acc;
+
+	if (header & BMI270_FIFO_HEADER_AUX) {
+		gyr += BMI270_FIFO_AUX_LEN;
+	}
+
+	acc = gyr;
+	if (header & BMI270_FIFO_HEADER_GYR) {
+		acc += BMI270_FIFO_GYR_LEN;
+	}
+
+	if (pos < 3) {
+		return (header & BMI270_FIFO_HEADER_ACC) ? &acc[pos * 2] : NULL;
+	}
+
+	return (header & BMI270_FIFO_HEADER_GYR) ? &gyr[(pos - 3) * 2] : NULL;
+}
+
+/* Count the data frames, and find the index of the one at the @p offset */
+static uint16_t bmi270_count_frames(const struct bmi270_fifo_data *edata, uint32_t offset,
+				    int *index)
+{
+	const uint8_t *frames = (const uint8_t *)edata + sizeof(*edata);
+	uint16_t count = 0;
+	uint16_t len;
+
+	*index = -1;
+
+	for (uint32_t i = 0; i < edata->fifo_count; i += len) {
+		len = bmi270_frame_len(&frames[i], edata->fifo_count - i);
+		if (len == 0) {
+			break;
+		}
+
+		if (bmi270_is_data_frame(frames[i])) {
+			if (i == offset) {
+				*index = count;
+			}
+			count++;
+		}
+	}
+
+	return count;
+}
+
+static int bmi270_get_shift(enum sensor_channel channel, const struct bmi270_fifo_data *edata,
+			    int8_t *shift)
+{
+	switch (channel) {
+	case SENSOR_CHAN_ACCEL_XYZ:
+	case SENSOR_CHAN_ACCEL_X:
+	case SENSOR_CHAN_ACCEL_Y:
+	case SENSOR_CHAN_ACCEL_Z:
+		/* 2 g is 19.6 m/s^2, doubling with the range */
+		switch (edata->acc_range) {
+		case 2:
+			*shift = 5;
+			return 0;
+		case 4:
+			*shift = 6;
+			return 0;
+		case 8:
+			*shift = 7;
+			return 0;
+		case 16:
+			*shift = 8;
+			return 0;
+		default:
+			return -EINVAL;
+		}
+	case SENSOR_CHAN_GYRO_XYZ:
+	case SENSOR_CHAN_GYRO_X:
+	case SENSOR_CHAN_GYRO_Y:
+	case SENSOR_CHAN_GYRO_Z:
+		/* 125 dps is 2.18 rad/s, doubling with the range */
+		switch (edata->gyr_range) {
+		case 125:
+			*shift = 2;
+			return 0;
+		case 250:
+			*shift = 3;
+			return 0;
+		case 500:
+			*shift = 4;
+			return 0;
+		case 1000:
+			*shift = 5;
+			return 0;
+		case 2000:
+			*shift = 6;
+			return 0;
+		default:
+			return -EINVAL;
+		}
+	default:
+		return -EINVAL;
+	}
+}
+
+static void bmi270_convert(const struct bmi270_fifo_data *edata, int pos, int16_t raw, q31_t *out)
+{
+	int64_t micro;
+	int8_t shift;
+
+	if (bmi270_get_shift(bmi270_channels[pos], edata, &shift) != 0) {
+		*out = 0;
+		return;
+	}
+
+	/* Same conversions as the fetch API, in micro m/s^2 and micro rad/s */
+	if (pos < 3) {
+		micro = ((int64_t)raw * SENSOR_G * edata->acc_range) / INT16_MAX;
+	} else {
+		micro = ((int64_t)raw * edata->gyr_range * SENSOR_PI) / (180LL * INT16_MAX);
+	}
+
+	micro = micro * ((int64_t)INT32_MAX + 1) / (INT64_C(1000000) << shift);
+	*out = CLAMP(micro, INT32_MIN, INT32_MAX);
+}
+
+static int bmi270_decoder_decode(const uint8_t *buffer, sensor_frame_iterator_t *fit,
+				 sensor_channel_iterator_t *cit, enum sensor_channel *channels,
+				 q31_t *values, uint8_t max_count)
+{
+	const struct bmi270_fifo_data *edata = (const struct bmi270_fifo_data *)buffer;
+	const uint8_t *frames = buffer + sizeof(*edata);
+	const uint8_t *sample;
+	int count = 0;
+	uint16_t len;
+	int pos;
+
+	while (count == 0 && *fit < edata->fifo_count) {
+		const uint8_t *frame = &frames[*fit];
+
+		len = bmi270_frame_len(frame, edata->fifo_count - *fit);
+		if (len == 0) {
+			/* End of the data */
+			*fit = edata->fifo_count;
+			*cit = 0;
+			break;
+		}
+
+		if (bmi270_is_data_frame(frame[0])) {
+			while (*cit < ARRAY_SIZE(bmi270_channels) && count < max_count) {
+				pos = *cit;
+				*cit += 1;
+
+				sample = bmi270_frame_sample(frame, pos);
+				if (sample == NULL) {
+					continue;
+				}
+
+				channels[count] = bmi270_channels[pos];
+				bmi270_convert(edata, pos, sys_get_le16(sample), &values[count]);
+				count++;
+			}
+
+			if (*cit < ARRAY_SIZE(bmi270_channels)) {
+				/* Out of room, the frame is not fully decoded */
+				break;
+			}
+		}
+
+		*fit += len;
+		*cit = 0;
+	}
+
+	return count;
+}
+
+static int bmi270_decoder_get_frame_count(const uint8_t *buffer, uint16_t *frame_count)
+{
+	int index;
+
+	*frame_count = bmi270_count_frames((const struct bmi270_fifo_data *)buffer, 0, &index);
+
+	return 0;
+}
+
+/* Period of the frames in nanoseconds, the ODRs doubling from 100 Hz at 0x08 */
+static uint64_t bmi270_odr_period_ns(uint8_t odr)
+{
+	if (odr == 0) {
+		return 0;
+	}
+
+	return odr <= BMI270_ACC_ODR_100_HZ ? (UINT64_C(10000000) << (BMI270_ACC_ODR_100_HZ - odr))
+					    : (UINT64_C(10000000) >> (odr - BMI270_ACC_ODR_100_HZ));
+}
+
+/* The frames are pushed at the fastest of the rates of the enabled sensors */
+static uint64_t bmi270_fifo_period_ns(const struct bmi270_fifo_data *edata)
+{
+	uint64_t acc_period = edata->acc_en ? bmi270_odr_period_ns(edata->acc_odr) : 0;
+	uint64_t gyr_period = edata->gyr_en ? bmi270_odr_period_ns(edata->gyr_odr) : 0;
+
+	if (acc_period == 0) {
+		return gyr_period;
+	}
+	if (gyr_period == 0) {
+		return acc_period;
+	}
+
+	return MIN(acc_period, gyr_period);
+}
+
+static int bmi270_decoder_get_frame_timestamp(const uint8_t *buffer, sensor_frame_iterator_t fit,
+					      uint64_t *timestamp_ns)
+{
+	const struct bmi270_fifo_data *edata = (const struct bmi270_fifo_data *)buffer;
+	uint16_t frame_count;
+	int index;
+
+	frame_count = bmi270_count_frames(edata, fit, &index);
+	if (index < 0) {
+		return -EINVAL;
+	}
+
+	/* The header timestamp is the one of the last frame, the frames are one period apart */
+	*timestamp_ns = edata->timestamp - (frame_count - 1 - index) * bmi270_fifo_period_ns(edata);
+
+	return 0;
+}
+
+static int bmi270_decoder_get_timestamp(const uint8_t *buffer, uint64_t *timestamp_ns)
+{
+	const struct bmi270_fifo_data *edata = (const struct bmi270_fifo_data *)buffer;
+	const uint8_t *frames = buffer + sizeof(*edata);
+	uint16_t len;
+
+	/* Timestamp of the first data frame */
+	for (uint32_t i = 0; i < edata->fifo_count; i += len) {
+		if (bmi270_is_data_frame(frames[i])) {
+			return bmi270_decoder_get_frame_timestamp(buffer, i, timestamp_ns);
+		}
+
+		len = bmi270_frame_len(&frames[i], edata->fifo_count - i);
+		if (len == 0) {
+			break;
+		}
+	}
+
+	*timestamp_ns = edata->timestamp;
+	return 0;
+}
+
+static int bmi270_decoder_get_shift(const uint8_t *buffer, enum sensor_channel channel_type,
+				    int8_t *shift)
+{
+	return bmi270_get_shift(channel_type, (const struct bmi270_fifo_data *)buffer, shift);
+}
+
+static bool bmi270_decoder_has_trigger(const uint8_t *buffer, enum sensor_trigger_type trigger)
+{
+	const struct bmi270_fifo_data *edata = (const struct bmi270_fifo_data *)buffer;
+
+	switch (trigger) {
+	case SENSOR_TRIG_FIFO_WATERMARK:
+		return (edata->int_status & BMI270_INT_STATUS_1_FWM) != 0;
+	case SENSOR_TRIG_FIFO_FULL:
+		return (edata->int_status & BMI270_INT_STATUS_1_FFULL) != 0;
+	default:
+		return false;
+	}
+}
+
+SENSOR_DECODER_API_DT_DEFINE() = {
+	.get_frame_count = bmi270_decoder_get_frame_count,
+	.get_timestamp = bmi270_decoder_get_timestamp,
+	.get_shift = bmi270_decoder_get_shift,
+	.decode = bmi270_decoder_decode,
+	.get_frame_timestamp = bmi270_decoder_get_frame_timestamp,
+	.has_trigger = bmi270_decoder_has_trigger,
+};
+
+int bmi270_get_decoder(const struct device *dev, const struct sensor_decoder_api **decoder)
+{
+	ARG_UNUSED(dev);
+	*decoder = &SENSOR_DECODER_NAME();
+
+	return 0;
+}
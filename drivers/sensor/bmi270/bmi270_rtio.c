@@ -0,0 +1,330 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+
+#include <zephyr/drivers/sensor.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(bmi270);
+
+#include "bmi270.h"
+
+static bool bmi270_is_accel(enum sensor_channel chan)
+{
+	return chan == SENSOR_CHAN_ACCEL_X || chan == SENSOR_CHAN_ACCEL_Y ||
+	       chan == SENSOR_CHAN_ACCEL_Z || chan == SENSOR_CHAN_ACCEL_XYZ;
+}
+
+static bool bmi270_is_gyro(enum sensor_channel chan)
+{
+	return chan == SENSOR_CHAN_GYRO_X || chan == SENSOR_CHAN_GYRO_Y ||
+	       chan == SENSOR_CHAN_GYRO_Z || chan == SENSOR_CHAN_GYRO_XYZ;
+}
+
+static int bmi270_fifo_header_init(const struct device *dev, struct bmi270_fifo_data *edata)
+{
+	struct bmi270_data *data = dev->data;
+	uint8_t pwr_ctrl;
+	int ret;
+
+	ret = bmi270_reg_read(dev, BMI270_REG_PWR_CTRL, &pwr_ctrl, 1);
+	if (ret != 0) {
+		return ret;
+	}
+
+	edata->int_status = 0;
+	edata->acc_range = data->acc_range;
+	edata->gyr_range = data->gyr_range;
+	edata->acc_odr = data->acc_odr;
+	edata->gyr_odr = data->gyr_odr;
+	edata->acc_en = (pwr_ctrl & BMI270_PWR_CTRL_ACC_EN) != 0;
+	edata->gyr_en = (pwr_ctrl & BMI270_PWR_CTRL_GYR_EN) != 0;
+	edata->reserved = 0;
+	edata->fifo_count = 0;
+
+	return 0;
+}
+
+/* One-shot reads are encoded as a single FIFO frame, so that the decoder only has one format */
+static void bmi270_submit_one_shot(const struct device *dev, struct rtio_iodev_sqe *iodev_sqe)
+{
+	const struct sensor_read_config *cfg = iodev_sqe->sqe.iodev->data;
+	const uint32_t min_buf_len = sizeof(struct bmi270_fifo_data) + 1 + BMI270_FIFO_GYR_LEN +
+				     BMI270_FIFO_ACC_LEN;
+	struct bmi270_fifo_data *edata;
+	uint8_t header = BMI270_FIFO_HEADER_MODE_REGULAR;
+	uint8_t regs[BMI270_FIFO_ACC_LEN + BMI270_FIFO_GYR_LEN];
+	uint32_t buf_len;
+	uint8_t *frame;
+	uint8_t *buf;
+	int ret;
+
+	for (size_t i = 0; i < cfg->count; i++) {
+		if (bmi270_is_accel(cfg->channels[i])) {
+			header |= BMI270_FIFO_HEADER_ACC;
+		} else if (bmi270_is_gyro(cfg->channels[i])) {
+			header |= BMI270_FIFO_HEADER_GYR;
+		} else if (cfg->channels[i] == SENSOR_CHAN_ALL) {
+			header |= BMI270_FIFO_HEADER_ACC | BMI270_FIFO_HEADER_GYR;
+		} else {
+			LOG_ERR("Unsupported channel %d", cfg->channels[i]);
+			rtio_iodev_sqe_err(iodev_sqe, -ENOTSUP);
+			return;
+		}
+	}
+
+	ret = rtio_sqe_rx_buf(iodev_sqe, min_buf_len, min_buf_len, &buf, &buf_len);
+	if (ret != 0) {
+		LOG_ERR("Failed to get a read buffer of size %u bytes", min_buf_len);
+		rtio_iodev_sqe_err(iodev_sqe, ret);
+		return;
+	}
+
+	edata = (struct bmi270_fifo_data *)buf;
+	ret = bmi270_fifo_header_init(dev, edata);
+	if (ret == 0) {
+		ret = bmi270_reg_read(dev, BMI270_REG_ACC_X_LSB, regs, sizeof(regs));
+	}
+	if (ret != 0) {
+		rtio_iodev_sqe_err(iodev_sqe, ret);
+		return;
+	}
+
+	edata->timestamp = k_ticks_to_ns_floor64(k_uptime_ticks());
+
+	/* The frames hold the gyroscope before the accelerometer */
+	frame = buf + sizeof(*edata);
+	frame[0] = header;
+	edata->fifo_count = 1;
+	if (header & BMI270_FIFO_HEADER_GYR) {
+		memcpy(&frame[edata->fifo_count], &regs[BMI270_FIFO_ACC_LEN], BMI270_FIFO_GYR_LEN);
+		edata->fifo_count += BMI270_FIFO_GYR_LEN;
+	}
+	if (header & BMI270_FIFO_HEADER_ACC) {
+		memcpy(&frame[edata->fifo_count], regs, BMI270_FIFO_ACC_LEN);
+		edata->fifo_count += BMI270_FIFO_ACC_LEN;
+	}
+
+	rtio_iodev_sqe_ok(iodev_sqe, 0);
+}
+
+static int bmi270_stream_configure(const struct device *dev, bool enable, uint16_t fifo_wtm)
+{
+	uint8_t int_map_data;
+	uint8_t fifo_config_1 = 0;
+	uint8_t wtm[2];
+	uint8_t cmd = BMI270_CMD_FIFO_FLUSH;
+	int ret;
+
+	ret = bmi270_reg_read(dev, BMI270_REG_INT_MAP_DATA, &int_map_data, 1);
+	if (ret != 0) {
+		return ret;
+	}
+
+	int_map_data &= ~(BMI270_INT_MAP_DATA_FWM_INT2 | BMI270_INT_MAP_DATA_FFULL_INT2);
+
+	if (enable) {
+		sys_put_le16(fifo_wtm & BMI270_FIFO_WTM_MSK, wtm);
+		ret = bmi270_reg_write(dev, BMI270_REG_FIFO_WTM_0, wtm, sizeof(wtm));
+		if (ret != 0) {
+			return ret;
+		}
+
+		fifo_config_1 = BMI270_FIFO_CONFIG_1_GYR_EN | BMI270_FIFO_CONFIG_1_ACC_EN |
+				BMI270_FIFO_CONFIG_1_HEADER_EN;
+		int_map_data |= BMI270_INT_MAP_DATA_FWM_INT2 | BMI270_INT_MAP_DATA_FFULL_INT2;
+	}
+
+	ret = bmi270_reg_write(dev, BMI270_REG_FIFO_CONFIG_1, &fifo_config_1, 1);
+	if (ret != 0) {
+		return ret;
+	}
+
+	ret = bmi270_reg_write(dev, BMI270_REG_CMD, &cmd, 1);
+	if (ret != 0) {
+		return ret;
+	}
+
+	return bmi270_reg_write(dev, BMI270_REG_INT_MAP_DATA, &int_map_data, 1);
+}
+
+static void bmi270_submit_stream(const struct device *dev, struct rtio_iodev_sqe *iodev_sqe)
+{
+	const struct sensor_read_config *cfg = iodev_sqe->sqe.iodev->data;
+	const struct bmi270_config *dev_cfg = dev->config;
+	struct bmi270_data *data = dev->data;
+	/* Without watermark trigger, only interrupt when the FIFO is full */
+	uint16_t fifo_wtm = BMI270_FIFO_WTM_MSK;
+	int ret;
+
+	if (!dev_cfg->int2.port) {
+		rtio_iodev_sqe_err(iodev_sqe, -ENOTSUP);
+		return;
+	}
+
+	for (size_t i = 0; i < cfg->count; i++) {
+		switch (cfg->triggers[i].trigger) {
+		case SENSOR_TRIG_FIFO_WATERMARK:
+			fifo_wtm = CONFIG_BMI270_STREAM_FIFO_WATERMARK *
+				   (1 + BMI270_FIFO_GYR_LEN + BMI270_FIFO_ACC_LEN);
+			break;
+		case SENSOR_TRIG_FIFO_FULL:
+			break;
+		default:
+			LOG_ERR("Unsupported stream trigger %d", cfg->triggers[i].trigger);
+			rtio_iodev_sqe_err(iodev_sqe, -ENOTSUP);
+			return;
+		}
+	}
+
+	k_mutex_lock(&data->trigger_mutex, K_FOREVER);
+
+	/* Resubmissions of the multishot read keep the FIFO running */
+	if (!data->streaming) {
+		ret = bmi270_stream_configure(dev, true, fifo_wtm);
+		if (ret != 0) {
+			k_mutex_unlock(&data->trigger_mutex);
+			LOG_ERR("Failed to enable the FIFO (%d)", ret);
+			rtio_iodev_sqe_err(iodev_sqe, ret);
+			return;
+		}
+		data->streaming = true;
+	}
+
+	data->streaming_sqe = iodev_sqe;
+
+	k_mutex_unlock(&data->trigger_mutex);
+}
+
+int bmi270_submit(const struct device *dev, struct rtio_iodev_sqe *iodev_sqe)
+{
+	const struct sensor_read_config *cfg = iodev_sqe->sqe.iodev->data;
+
+	if (cfg->is_streaming) {
+		bmi270_submit_stream(dev, iodev_sqe);
+	} else {
+		bmi270_submit_one_shot(dev, iodev_sqe);
+	}
+
+	return 0;
+}
+
+static enum sensor_stream_data_opt bmi270_stream_opt(const struct sensor_read_config *cfg,
+						     uint8_t int_status, bool *triggered)
+{
+	enum sensor_stream_data_opt opt = SENSOR_STREAM_DATA_NOP;
+
+	*triggered = false;
+
+	for (size_t i = 0; i < cfg->count; i++) {
+		const struct sensor_stream_trigger *trig = &cfg->triggers[i];
+
+		if ((trig->trigger == SENSOR_TRIG_FIFO_WATERMARK &&
+		     (int_status & BMI270_INT_STATUS_1_FWM)) ||
+		    (trig->trigger == SENSOR_TRIG_FIFO_FULL &&
+		     (int_status & BMI270_INT_STATUS_1_FFULL))) {
+			*triggered = true;
+			/* Including the data wins over dropping it, which wins over leaving it */
+			if (trig->opt == SENSOR_STREAM_DATA_INCLUDE ||
+			    (trig->opt == SENSOR_STREAM_DATA_DROP &&
+			     opt == SENSOR_STREAM_DATA_NOP)) {
+				opt = trig->opt;
+			}
+		}
+	}
+
+	return opt;
+}
+
+void bmi270_fifo_event(const struct device *dev)
+{
+	struct bmi270_data *data = dev->data;
+	struct rtio_iodev_sqe *iodev_sqe = data->streaming_sqe;
+	const struct sensor_read_config *cfg;
+	enum sensor_stream_data_opt opt;
+	struct bmi270_fifo_data *edata;
+	uint8_t cmd = BMI270_CMD_FIFO_FLUSH;
+	uint8_t length[2];
+	uint16_t fifo_count;
+	uint8_t int_status;
+	uint64_t timestamp;
+	uint32_t min_buf_len;
+	uint32_t buf_len;
+	bool triggered;
+	uint8_t *buf;
+	int ret;
+
+	data->streaming_sqe = NULL;
+
+	if (FIELD_GET(RTIO_SQE_CANCELED, iodev_sqe->sqe.flags)) {
+		(void)bmi270_stream_configure(dev, false, 0);
+		data->streaming = false;
+		rtio_iodev_sqe_err(iodev_sqe, -ECANCELED);
+		return;
+	}
+
+	cfg = iodev_sqe->sqe.iodev->data;
+
+	ret = bmi270_reg_read(dev, BMI270_REG_INT_STATUS_1, &int_status, 1);
+	if (ret != 0) {
+		goto err;
+	}
+
+	opt = bmi270_stream_opt(cfg, int_status, &triggered);
+	if (!triggered) {
+		/* Data ready interrupt, keep waiting */
+		data->streaming_sqe = iodev_sqe;
+		return;
+	}
+
+	ret = bmi270_reg_read(dev, BMI270_REG_FIFO_LENGTH_0, length, sizeof(length));
+	if (ret != 0) {
+		goto err;
+	}
+
+	/* The last frame in the FIFO was sampled at most one period before its length is read */
+	timestamp = k_ticks_to_ns_floor64(k_uptime_ticks());
+
+	fifo_count = sys_get_le16(length) & BMI270_FIFO_LENGTH_MSK;
+	if (opt != SENSOR_STREAM_DATA_INCLUDE) {
+		fifo_count = 0;
+	}
+
+	min_buf_len = sizeof(struct bmi270_fifo_data) + fifo_count;
+	ret = rtio_sqe_rx_buf(iodev_sqe, min_buf_len, min_buf_len, &buf, &buf_len);
+	if (ret != 0) {
+		LOG_ERR("Failed to get a read buffer of size %u bytes", min_buf_len);
+		(void)bmi270_reg_write(dev, BMI270_REG_CMD, &cmd, 1);
+		goto err;
+	}
+
+	edata = (struct bmi270_fifo_data *)buf;
+	ret = bmi270_fifo_header_init(dev, edata);
+	if (ret != 0) {
+		goto err;
+	}
+
+	edata->timestamp = timestamp;
+	edata->int_status = int_status;
+	edata->fifo_count = fifo_count;
+
+	if (fifo_count > 0) {
+		ret = bmi270_reg_read(dev, BMI270_REG_FIFO_DATA, buf + sizeof(*edata), fifo_count);
+	} else if (opt == SENSOR_STREAM_DATA_DROP) {
+		ret = bmi270_reg_write(dev, BMI270_REG_CMD, &cmd, 1);
+	}
+	if (ret != 0) {
+		goto err;
+	}
+
+	rtio_iodev_sqe_ok(iodev_sqe, 0);
+	return;
+
+err:
+	LOG_ERR("Failed to read the FIFO (%d)", ret);
+	rtio_iodev_sqe_err(iodev_sqe, ret);
+}
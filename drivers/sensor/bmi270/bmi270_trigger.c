@@ -76,6 +76,13 @@ static void bmi270_thread_cb(const struct device *dev)
 	if (atomic_test_and_clear_bit(&data->int_flags, INT_FLAGS_INT2)) {
 		k_mutex_lock(&data->trigger_mutex, K_FOREVER);
 
+#ifdef CONFIG_BMI270_STREAM
+		/* INT2 also carries the FIFO interrupts when streaming */
+		if (data->streaming_sqe != NULL) {
+			bmi270_fifo_event(dev);
+		}
+#endif
+
 		if (data->drdy_handler != NULL) {
 			data->drdy_handler(dev, data->drdy_trigger);
 		}
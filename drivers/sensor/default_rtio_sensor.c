@@ -22,8 +22,10 @@ static void sensor_iodev_submit(struct rtio_iodev_sqe *iodev_sqe)
 
 	if (api->submit != NULL) {
 		api->submit(dev, iodev_sqe);
-	} else {
+	} else if (!cfg->is_streaming) {
 		sensor_submit_fallback(dev, iodev_sqe);
+	} else {
+		rtio_iodev_sqe_err(iodev_sqe, -ENOTSUP);
 	}
 }
 
@@ -342,9 +344,119 @@ static int decode(const uint8_t *buffer, sensor_frame_iterator_t *fit,
 	return count;
 }
 
+/**
+ * @brief Index of the axis of a channel in a decoded frame
+ *
+ * @param[in] channel The channel to decode, possibly a 3 axis one
+ * @param[in] decoded The single axis channel which was decoded
+ * @return The index of @p decoded in the values of @p channel or negative if not part of it
+ */
+static inline int channel_axis(enum sensor_channel channel, enum sensor_channel decoded)
+{
+	if (!SENSOR_CHANNEL_3_AXIS(channel)) {
+		return decoded == channel ? 0 : -1;
+	}
+
+	/* The single axis channels come right before their 3 axis one */
+	if (decoded >= channel - 3 && decoded < channel) {
+		return decoded - (channel - 3);
+	}
+
+	return -1;
+}
+
+/**
+ * @brief Default decoder decode the samples of a channel
+ *
+ * The buffer only holds a single frame, the values of which are already scaled with the shift of
+ * the buffer.
+ *
+ * @param[in]     buffer The data buffer to decode
+ * @param[in]     channel The channel to decode
+ * @param[in,out] fit The starting frame iterator
+ * @param[out]    values The decoded q31 values
+ * @param[in]     max_count The maximum number of values to decode
+ * @return > 0 The number of decoded values
+ * @return 0 Nothing else to decode on this @p buffer
+ */
+static int decode_channel(const uint8_t *buffer, enum sensor_channel channel,
+			  sensor_frame_iterator_t *fit, q31_t *values, uint16_t max_count)
+{
+	const struct sensor_data_generic_header *header =
+		(const struct sensor_data_generic_header *)buffer;
+	const q31_t *q =
+		(const q31_t *)(buffer + sizeof(struct sensor_data_generic_header) +
+				header->num_channels * sizeof(enum sensor_channel));
+	const int num_axes = SENSOR_CHANNEL_3_AXIS(channel) ? 3 : 1;
+	int found = 0;
+	int axis;
+
+	if (*fit != 0 || max_count < num_axes) {
+		return 0;
+	}
+
+	for (size_t i = 0; i < header->num_channels; ++i) {
+		axis = channel_axis(channel, header->channels[i]);
+		if (axis >= 0) {
+			values[axis] = q[i];
+			found |= BIT(axis);
+		}
+	}
+
+	*fit = 1;
+	return found == BIT_MASK(num_axes) ? num_axes : 0;
+}
+
 const struct sensor_decoder_api __sensor_default_decoder = {
 	.get_frame_count = get_frame_count,
 	.get_timestamp = get_timestamp,
 	.get_shift = get_shift,
 	.decode = decode,
+	.decode_channel = decode_channel,
 };
+
+int sensor_decode_channel(const struct sensor_decoder_api *decoder, const uint8_t *buffer,
+			  enum sensor_channel channel, sensor_frame_iterator_t *fit, q31_t *values,
+			  uint16_t max_count)
+{
+	const int num_axes = SENSOR_CHANNEL_3_AXIS(channel) ? 3 : 1;
+	enum sensor_channel channels[8];
+	q31_t frame_values[8];
+	sensor_channel_iterator_t cit;
+	int count = 0;
+	int found;
+	int axis;
+	int rc;
+
+	if (decoder->decode_channel != NULL) {
+		return decoder->decode_channel(buffer, channel, fit, values, max_count);
+	}
+
+	/* Decode whole frames, keeping the samples of the channel */
+	while (count + num_axes <= max_count) {
+		cit = 0;
+		found = 0;
+
+		do {
+			rc = decoder->decode(buffer, fit, &cit, channels, frame_values,
+					     ARRAY_SIZE(channels));
+			if (rc <= 0) {
+				return count > 0 ? count : rc;
+			}
+
+			for (int i = 0; i < rc; ++i) {
+				axis = channel_axis(channel, channels[i]);
+				if (axis >= 0) {
+					values[count + axis] = frame_values[i];
+					found |= BIT(axis);
+				}
+			}
+		} while (cit != 0);
+
+		if (found == BIT_MASK(num_axes)) {
+			count += num_axes;
+		}
+	}
+
+	return count;
+}
@@ -411,6 +411,9 @@ struct icm42688_dev_data {
 	const struct sensor_trigger *data_ready_trigger;
 	struct k_mutex mutex;
 #endif /* CONFIG_ICM42688_TRIGGER */
+#ifdef CONFIG_ICM42688_STREAM
+	struct rtio_iodev_sqe *streaming_sqe;
+#endif /* CONFIG_ICM42688_STREAM */
 
 	int16_t readings[7];
 };
@@ -560,32 +563,39 @@ static inline void icm42688_gyro_dps(const struct icm42688_cfg *cfg, int32_t in,
 }
 
 /**
- * @brief Convert icm42688 accelerometer value to useful m/s^2 values
+ * @brief Get the icm42688 accelerometer raw value equivalent for 1g
  *
  * @param cfg icm42688_cfg current device configuration
- * @param in raw data value in int32_t format
- * @param out_ms meters/s^2 (whole) output in int32_t
- * @param out_ums micrometers/s^2 output as uint32_t
+ * @return The raw value of 1g in the accelerometer full scale
  */
-static inline void icm42688_accel_ms(const struct icm42688_cfg *cfg, int32_t in, int32_t *out_ms,
-				     int32_t *out_ums)
+static inline int64_t icm42688_accel_ms_sensitivity(const struct icm42688_cfg *cfg)
 {
-	int64_t sensitivity = 0; /* value equivalent for 1g */
-
 	switch (cfg->accel_fs) {
 	case ICM42688_ACCEL_FS_2G:
-		sensitivity = 16384;
-		break;
+		return 16384;
 	case ICM42688_ACCEL_FS_4G:
-		sensitivity = 8192;
-		break;
+		return 8192;
 	case ICM42688_ACCEL_FS_8G:
-		sensitivity = 4096;
-		break;
+		return 4096;
 	case ICM42688_ACCEL_FS_16G:
-		sensitivity = 2048;
-		break;
+		return 2048;
+	default:
+		return 0;
 	}
+}
+
+/**
+ * @brief Convert icm42688 accelerometer value to useful m/s^2 values
+ *
+ * @param cfg icm42688_cfg current device configuration
+ * @param in raw data value in int32_t format
+ * @param out_ms meters/s^2 (whole) output in int32_t
+ * @param out_ums micrometers/s^2 output as uint32_t
+ */
+static inline void icm42688_accel_ms(const struct icm42688_cfg *cfg, int32_t in, int32_t *out_ms,
+				     int32_t *out_ums)
+{
+	int64_t sensitivity = icm42688_accel_ms_sensitivity(cfg);
 
 	/* Convert to micrometers/s^2 */
 	int64_t in_ms = in * SENSOR_G;
@@ -598,44 +608,47 @@ static inline void icm42688_accel_ms(const struct icm42688_cfg *cfg, int32_t in,
 }
 
 /**
- * @brief Convert icm42688 gyroscope value to useful rad/s values
+ * @brief Get the icm42688 gyroscope raw value equivalent for 10 deg/s
  *
  * @param cfg icm42688_cfg current device configuration
- * @param in raw data value in int32_t format
- * @param out_rads whole rad/s output in int32_t
- * @param out_urads microrad/s as uint32_t
+ * @return The raw value of 10 deg/s in the gyroscope full scale
  */
-static inline void icm42688_gyro_rads(const struct icm42688_cfg *cfg, int32_t in, int32_t *out_rads,
-				      int32_t *out_urads)
+static inline int64_t icm42688_gyro_rads_sensitivity(const struct icm42688_cfg *cfg)
 {
-	int64_t sensitivity = 0; /* value equivalent for 10x gyro reading deg/s */
-
 	switch (cfg->gyro_fs) {
 	case ICM42688_GYRO_FS_2000:
-		sensitivity = 164;
-		break;
+		return 164;
 	case ICM42688_GYRO_FS_1000:
-		sensitivity = 328;
-		break;
+		return 328;
 	case ICM42688_GYRO_FS_500:
-		sensitivity = 655;
-		break;
+		return 655;
 	case ICM42688_GYRO_FS_250:
-		sensitivity = 1310;
-		break;
+		return 1310;
 	case ICM42688_GYRO_FS_125:
-		sensitivity = 2620;
-		break;
+		return 2620;
 	case ICM42688_GYRO_FS_62_5:
-		sensitivity = 5243;
-		break;
+		return 5243;
 	case ICM42688_GYRO_FS_31_25:
-		sensitivity = 10486;
-		break;
+		return 10486;
 	case ICM42688_GYRO_FS_15_625:
-		sensitivity = 20972;
-		break;
+		return 20972;
+	default:
+		return 0;
 	}
+}
+
+/**
+ * @brief Convert icm42688 gyroscope value to useful rad/s values
+ *
+ * @param cfg icm42688_cfg current device configuration
+ * @param in raw data value in int32_t format
+ * @param out_rads whole rad/s output in int32_t
+ * @param out_urads microrad/s as uint32_t
+ */
+static inline void icm42688_gyro_rads(const struct icm42688_cfg *cfg, int32_t in, int32_t *out_rads,
+				      int32_t *out_urads)
+{
+	int64_t sensitivity = icm42688_gyro_rads_sensitivity(cfg);
 
 	int64_t in10_rads = (int64_t)in * SENSOR_PI * 10LL;
 
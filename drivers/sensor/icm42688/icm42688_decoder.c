@@ -8,6 +8,7 @@
 #include "icm42688_reg.h"
 #include "icm42688.h"
 #include <errno.h>
+#include <zephyr/sys/byteorder.h>
 
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(ICM42688_DECODER, CONFIG_SENSOR_LOG_LEVEL);
@@ -99,6 +100,19 @@ static enum sensor_channel icm42688_get_channel_from_position(int pos)
 	}
 }
 
+static inline q31_t icm42688_micro_to_q31(int64_t intermediate, int8_t shift)
+{
+	if (shift < 0) {
+		intermediate =
+			intermediate * ((int64_t)INT32_MAX + 1) * (1 << -shift) / INT64_C(1000000);
+	} else if (shift > 0) {
+		intermediate =
+			intermediate * ((int64_t)INT32_MAX + 1) / ((1 << shift) * INT64_C(1000000));
+	}
+
+	return CLAMP(intermediate, INT32_MIN, INT32_MAX);
+}
+
 int icm42688_convert_raw_to_q31(struct icm42688_cfg *cfg, enum sensor_channel chan, int32_t reading,
 				q31_t *out)
 {
@@ -133,18 +147,56 @@ int icm42688_convert_raw_to_q31(struct icm42688_cfg *cfg, enum sensor_channel ch
 		return -ENOTSUP;
 	}
 	intermediate = ((int64_t)whole * INT64_C(1000000) + fraction);
-	if (shift < 0) {
-		intermediate =
-			intermediate * ((int64_t)INT32_MAX + 1) * (1 << -shift) / INT64_C(1000000);
-	} else if (shift > 0) {
-		intermediate =
-			intermediate * ((int64_t)INT32_MAX + 1) / ((1 << shift) * INT64_C(1000000));
-	}
-	*out = CLAMP(intermediate, INT32_MIN, INT32_MAX);
+	*out = icm42688_micro_to_q31(intermediate, shift);
 
 	return 0;
 }
 
+/* Conversion of the raw readings of a channel, computed once for all the frames of a buffer */
+struct icm42688_q31_scale {
+	int64_t num;
+	int64_t den;
+	int8_t shift;
+};
+
+static int icm42688_get_q31_scale(const struct icm42688_cfg *cfg, enum sensor_channel chan,
+				  struct icm42688_q31_scale *scale)
+{
+	int rc;
+
+	rc = icm42688_get_shift(chan, cfg->accel_fs, cfg->gyro_fs, &scale->shift);
+	if (rc != 0) {
+		return rc;
+	}
+
+	/* Same micro units as icm42688_accel_ms() and icm42688_gyro_rads() */
+	switch (chan) {
+	case SENSOR_CHAN_ACCEL_XYZ:
+	case SENSOR_CHAN_ACCEL_X:
+	case SENSOR_CHAN_ACCEL_Y:
+	case SENSOR_CHAN_ACCEL_Z:
+		scale->num = SENSOR_G;
+		scale->den = icm42688_accel_ms_sensitivity(cfg);
+		return 0;
+	case SENSOR_CHAN_GYRO_XYZ:
+	case SENSOR_CHAN_GYRO_X:
+	case SENSOR_CHAN_GYRO_Y:
+	case SENSOR_CHAN_GYRO_Z:
+		scale->num = SENSOR_PI * 10LL;
+		scale->den = icm42688_gyro_rads_sensitivity(cfg) * 180LL;
+		return 0;
+	default:
+		/* The temperature has an offset, it is converted sample by sample */
+		return -ENOTSUP;
+	}
+}
+
+static inline q31_t icm42688_scale_to_q31(const struct icm42688_q31_scale *scale,
+					  int32_t reading)
+{
+	return icm42688_micro_to_q31((int64_t)reading * scale->num / scale->den, scale->shift);
+}
+
 static int icm42688_get_channel_position(enum sensor_channel chan)
 {
 	switch (chan) {
@@ -269,17 +321,326 @@ static int icm42688_one_shot_decode(const uint8_t *buffer, sensor_frame_iterator
 	return count;
 }
 
+/* Sample period in nanoseconds of the ODR register values, shared by the accel and gyro */
+static const uint32_t icm42688_odr_period_ns[] = {
+	[ICM42688_ACCEL_ODR_32000] = 31250,
+	[ICM42688_ACCEL_ODR_16000] = 62500,
+	[ICM42688_ACCEL_ODR_8000] = 125000,
+	[ICM42688_ACCEL_ODR_4000] = 250000,
+	[ICM42688_ACCEL_ODR_2000] = 500000,
+	[ICM42688_ACCEL_ODR_1000] = 1000000,
+	[ICM42688_ACCEL_ODR_200] = 5000000,
+	[ICM42688_ACCEL_ODR_100] = 10000000,
+	[ICM42688_ACCEL_ODR_50] = 20000000,
+	[ICM42688_ACCEL_ODR_25] = 40000000,
+	[ICM42688_ACCEL_ODR_12_5] = 80000000,
+	[ICM42688_ACCEL_ODR_6_25] = 160000000,
+	[ICM42688_ACCEL_ODR_3_125] = 320000000,
+	[ICM42688_ACCEL_ODR_1_5625] = 640000000,
+	[ICM42688_ACCEL_ODR_500] = 2000000,
+};
+
+/* The FIFO packets are pushed at the fastest of the accel and gyro ODRs */
+static uint64_t icm42688_fifo_period_ns(const struct icm42688_fifo_data *edata)
+{
+	uint32_t accel_period = icm42688_odr_period_ns[edata->accel_odr];
+	uint32_t gyro_period = icm42688_odr_period_ns[edata->gyro_odr];
+
+	if (accel_period == 0) {
+		return gyro_period;
+	}
+	if (gyro_period == 0) {
+		return accel_period;
+	}
+
+	return MIN(accel_period, gyro_period);
+}
+
+static uint16_t icm42688_fifo_frame_count(const struct icm42688_fifo_data *edata)
+{
+	return edata->fifo_count / FIFO_PACKET_SIZE;
+}
+
+/* Get the raw reading of a channel position from a FIFO packet, false if it is not valid */
+static bool icm42688_fifo_reading(const uint8_t *packet, int pos, int32_t *reading)
+{
+	uint8_t header = packet[0];
+	int16_t value;
+
+	if (FIELD_GET(BIT_FIFO_HEADER_MSG, header)) {
+		/* Empty FIFO */
+		return false;
+	}
+
+	switch (pos) {
+	case 0:
+		/* The 8 bit temperature has 64 times the resolution of the 16 bit register */
+		*reading = (int8_t)packet[13] * 64;
+		return true;
+	case 1:
+	case 2:
+	case 3:
+		if (!FIELD_GET(BIT_FIFO_HEADER_ACCEL, header)) {
+			return false;
+		}
+		value = sys_get_be16(&packet[1 + (pos - 1) * 2]);
+		break;
+	default:
+		if (!FIELD_GET(BIT_FIFO_HEADER_GYRO, header)) {
+			return false;
+		}
+		value = sys_get_be16(&packet[7 + (pos - 4) * 2]);
+		break;
+	}
+
+	/* Samples not available yet are flagged with the most negative value */
+	if (value == INT16_MIN) {
+		return false;
+	}
+
+	*reading = value;
+	return true;
+}
+
+static int icm42688_fifo_decode(const uint8_t *buffer, sensor_frame_iterator_t *fit,
+				sensor_channel_iterator_t *cit, enum sensor_channel *channels,
+				q31_t *values, uint8_t max_count)
+{
+	const struct icm42688_fifo_data *edata = (const struct icm42688_fifo_data *)buffer;
+	const uint8_t *packets = buffer + sizeof(struct icm42688_fifo_data);
+	uint16_t frame_count = icm42688_fifo_frame_count(edata);
+	struct icm42688_cfg cfg = {
+		.accel_fs = edata->header.accel_fs,
+		.gyro_fs = edata->header.gyro_fs,
+	};
+	enum sensor_channel chan;
+	int32_t reading;
+	int count = 0;
+	int pos;
+
+	/* Decode the channels of the current frame, moving past the frames without any */
+	while (count == 0 && *fit < frame_count) {
+		const uint8_t *packet = &packets[*fit * FIFO_PACKET_SIZE];
+
+		while (*cit < 7 && count < max_count) {
+			pos = *cit;
+			*cit += 1;
+
+			if (!icm42688_fifo_reading(packet, pos, &reading)) {
+				continue;
+			}
+
+			chan = icm42688_get_channel_from_position(pos);
+			channels[count] = chan;
+			icm42688_convert_raw_to_q31(&cfg, chan, reading, &values[count]);
+			count++;
+		}
+
+		if (*cit >= 7) {
+			*fit += 1;
+			*cit = 0;
+		}
+	}
+
+	return count;
+}
+
 static int icm42688_decoder_decode(const uint8_t *buffer, sensor_frame_iterator_t *fit,
 				   sensor_channel_iterator_t *cit, enum sensor_channel *channels,
 				   q31_t *values, uint8_t max_count)
 {
+	const struct icm42688_decoder_header *header =
+		(const struct icm42688_decoder_header *)buffer;
+
+	if (header->is_fifo) {
+		return icm42688_fifo_decode(buffer, fit, cit, channels, values, max_count);
+	}
+
 	return icm42688_one_shot_decode(buffer, fit, cit, channels, values, max_count);
 }
 
+/* Channel positions of the samples of a channel, false if it is not decoded */
+static bool icm42688_channel_positions(enum sensor_channel chan, int *first_pos, int *num_axes)
+{
+	switch (chan) {
+	case SENSOR_CHAN_ACCEL_XYZ:
+	case SENSOR_CHAN_GYRO_XYZ:
+		*num_axes = 3;
+		break;
+	case SENSOR_CHAN_DIE_TEMP:
+	case SENSOR_CHAN_ACCEL_X:
+	case SENSOR_CHAN_ACCEL_Y:
+	case SENSOR_CHAN_ACCEL_Z:
+	case SENSOR_CHAN_GYRO_X:
+	case SENSOR_CHAN_GYRO_Y:
+	case SENSOR_CHAN_GYRO_Z:
+		*num_axes = 1;
+		break;
+	default:
+		return false;
+	}
+
+	*first_pos = icm42688_get_channel_position(chan);
+	return true;
+}
+
+static void icm42688_convert_batch(struct icm42688_cfg *cfg, enum sensor_channel chan,
+				   const int32_t *readings, q31_t *values, int count)
+{
+	struct icm42688_q31_scale scale;
+
+	if (icm42688_get_q31_scale(cfg, chan, &scale) != 0) {
+		for (int i = 0; i < count; i++) {
+			icm42688_convert_raw_to_q31(cfg, chan, readings[i], &values[i]);
+		}
+		return;
+	}
+
+	for (int i = 0; i < count; i++) {
+		values[i] = icm42688_scale_to_q31(&scale, readings[i]);
+	}
+}
+
+static int icm42688_one_shot_decode_channel(const uint8_t *buffer, enum sensor_channel chan,
+					    sensor_frame_iterator_t *fit, q31_t *values,
+					    uint16_t max_count)
+{
+	const struct icm42688_encoded_data *edata = (const struct icm42688_encoded_data *)buffer;
+	struct icm42688_cfg cfg = {
+		.accel_fs = edata->header.accel_fs,
+		.gyro_fs = edata->header.gyro_fs,
+	};
+	int32_t readings[3];
+	int first_pos;
+	int num_axes;
+
+	if (!icm42688_channel_positions(chan, &first_pos, &num_axes)) {
+		return -EINVAL;
+	}
+
+	if (*fit != 0 || max_count < num_axes) {
+		return 0;
+	}
+
+	*fit = 1;
+
+	if ((edata->channels & (BIT_MASK(num_axes) << first_pos)) !=
+	    (BIT_MASK(num_axes) << first_pos)) {
+		return 0;
+	}
+
+	for (int axis = 0; axis < num_axes; axis++) {
+		readings[axis] = edata->readings[first_pos + axis];
+	}
+
+	icm42688_convert_batch(&cfg, chan, readings, values, num_axes);
+
+	return num_axes;
+}
+
+static int icm42688_fifo_decode_channel(const uint8_t *buffer, enum sensor_channel chan,
+					sensor_frame_iterator_t *fit, q31_t *values,
+					uint16_t max_count)
+{
+	const struct icm42688_fifo_data *edata = (const struct icm42688_fifo_data *)buffer;
+	const uint8_t *packets = buffer + sizeof(struct icm42688_fifo_data);
+	uint16_t frame_count = icm42688_fifo_frame_count(edata);
+	struct icm42688_cfg cfg = {
+		.accel_fs = edata->header.accel_fs,
+		.gyro_fs = edata->header.gyro_fs,
+	};
+	/* Raw readings of a chunk of frames, converted together */
+	int32_t readings[48];
+	int chunk_count;
+	int first_pos;
+	int num_axes;
+	int count = 0;
+	int axis;
+
+	if (!icm42688_channel_positions(chan, &first_pos, &num_axes)) {
+		return -EINVAL;
+	}
+
+	while (*fit < frame_count && count + num_axes <= max_count) {
+		chunk_count = 0;
+
+		/* Gather the raw readings of the frames holding all the axes of the channel */
+		while (*fit < frame_count && count + chunk_count + num_axes <= max_count &&
+		       chunk_count + num_axes <= ARRAY_SIZE(readings)) {
+			const uint8_t *packet = &packets[*fit * FIFO_PACKET_SIZE];
+
+			for (axis = 0; axis < num_axes; axis++) {
+				if (!icm42688_fifo_reading(packet, first_pos + axis,
+							   &readings[chunk_count + axis])) {
+					break;
+				}
+			}
+
+			if (axis == num_axes) {
+				chunk_count += num_axes;
+			}
+			*fit += 1;
+		}
+
+		icm42688_convert_batch(&cfg, chan, readings, &values[count], chunk_count);
+		count += chunk_count;
+	}
+
+	return count;
+}
+
+static int icm42688_decoder_decode_channel(const uint8_t *buffer, enum sensor_channel chan,
+					   sensor_frame_iterator_t *fit, q31_t *values,
+					   uint16_t max_count)
+{
+	const struct icm42688_decoder_header *header =
+		(const struct icm42688_decoder_header *)buffer;
+
+	if (header->is_fifo) {
+		return icm42688_fifo_decode_channel(buffer, chan, fit, values, max_count);
+	}
+
+	return icm42688_one_shot_decode_channel(buffer, chan, fit, values, max_count);
+}
+
 static int icm42688_decoder_get_frame_count(const uint8_t *buffer, uint16_t *frame_count)
 {
-	ARG_UNUSED(buffer);
-	*frame_count = 1;
+	const struct icm42688_decoder_header *header =
+		(const struct icm42688_decoder_header *)buffer;
+
+	if (header->is_fifo) {
+		*frame_count = icm42688_fifo_frame_count((const struct icm42688_fifo_data *)buffer);
+	} else {
+		*frame_count = 1;
+	}
+
+	return 0;
+}
+
+static int icm42688_decoder_get_frame_timestamp(const uint8_t *buffer, sensor_frame_iterator_t fit,
+						uint64_t *timestamp_ns)
+{
+	const struct icm42688_decoder_header *header =
+		(const struct icm42688_decoder_header *)buffer;
+	const struct icm42688_fifo_data *edata = (const struct icm42688_fifo_data *)buffer;
+	uint16_t frame_count;
+
+	if (!header->is_fifo) {
+		if (fit != 0) {
+			return -EINVAL;
+		}
+		*timestamp_ns = header->timestamp;
+		return 0;
+	}
+
+	frame_count = icm42688_fifo_frame_count(edata);
+	if (fit >= frame_count) {
+		return -EINVAL;
+	}
+
+	/* The header timestamp is the one of the last frame, the frames are one period apart */
+	*timestamp_ns = header->timestamp - (frame_count - 1 - fit) * icm42688_fifo_period_ns(edata);
+
 	return 0;
 }
 
@@ -288,10 +649,33 @@ static int icm42688_decoder_get_timestamp(const uint8_t *buffer, uint64_t *times
 	const struct icm42688_decoder_header *header =
 		(const struct icm42688_decoder_header *)buffer;
 
+	if (header->is_fifo &&
+	    icm42688_fifo_frame_count((const struct icm42688_fifo_data *)buffer) > 0) {
+		return icm42688_decoder_get_frame_timestamp(buffer, 0, timestamp_ns);
+	}
+
 	*timestamp_ns = header->timestamp;
 	return 0;
 }
 
+static bool icm42688_decoder_has_trigger(const uint8_t *buffer, enum sensor_trigger_type trigger)
+{
+	const struct icm42688_fifo_data *edata = (const struct icm42688_fifo_data *)buffer;
+
+	if (!edata->header.is_fifo) {
+		return false;
+	}
+
+	switch (trigger) {
+	case SENSOR_TRIG_FIFO_WATERMARK:
+		return FIELD_GET(BIT_INT_STATUS_FIFO_THS, edata->int_status);
+	case SENSOR_TRIG_FIFO_FULL:
+		return FIELD_GET(BIT_INT_STATUS_FIFO_FULL, edata->int_status);
+	default:
+		return false;
+	}
+}
+
 static int icm42688_decoder_get_shift(const uint8_t *buffer, enum sensor_channel channel_type,
 				      int8_t *shift)
 {
@@ -306,6 +690,9 @@ SENSOR_DECODER_API_DT_DEFINE() = {
 	.get_timestamp = icm42688_decoder_get_timestamp,
 	.get_shift = icm42688_decoder_get_shift,
 	.decode = icm42688_decoder_decode,
+	.get_frame_timestamp = icm42688_decoder_get_frame_timestamp,
+	.has_trigger = icm42688_decoder_has_trigger,
+	.decode_channel = icm42688_decoder_decode_channel,
 };
 
 int icm42688_get_decoder(const struct device *dev, const struct sensor_decoder_api **decoder)
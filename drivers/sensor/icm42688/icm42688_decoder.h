@@ -27,6 +27,18 @@ struct icm42688_encoded_data {
 	int16_t readings[7];
 };
 
+/*
+ * Buffer of a streaming read: the header is followed by fifo_count bytes of FIFO packets, the
+ * header timestamp being the one of the last packet.
+ */
+struct icm42688_fifo_data {
+	struct icm42688_decoder_header header;
+	uint8_t int_status;
+	uint8_t gyro_odr: 4;
+	uint8_t accel_odr: 4;
+	uint16_t fifo_count;
+} __attribute__((__packed__));
+
 int icm42688_encode(const struct device *dev, const enum sensor_channel *const channels,
 		    const size_t num_channels, uint8_t *buf);
 
@@ -258,6 +258,15 @@
 #define BIT_FIFO_ACCEL_EN      BIT(1)
 #define BIT_FIFO_TEMP_EN       BIT(0)
 
+/* FIFO packet 3 header */
+#define BIT_FIFO_HEADER_ODR_GYRO  BIT(0)
+#define BIT_FIFO_HEADER_ODR_ACCEL BIT(1)
+#define MASK_FIFO_HEADER_TMST	  GENMASK(3, 2)
+#define BIT_FIFO_HEADER_20	  BIT(4)
+#define BIT_FIFO_HEADER_GYRO	  BIT(5)
+#define BIT_FIFO_HEADER_ACCEL	  BIT(6)
+#define BIT_FIFO_HEADER_MSG	  BIT(7)
+
 /* Bank0 INT_SOURCE0 */
 #define BIT_UI_FSYNC_INT1_EN	    BIT(6)
 #define BIT_PLL_RDY_INT1_EN	    BIT(5)
@@ -282,6 +291,8 @@
 #define ACCEL_DATA_SIZE	      6
 #define GYRO_DATA_SIZE	      6
 #define TEMP_DATA_SIZE	      2
+#define FIFO_PACKET_SIZE      16 /* header, accel, gyro, temp and timestamp */
+#define FIFO_SIZE	      2048
 #define MCLK_POLL_INTERVAL_US 250
 #define MCLK_POLL_ATTEMPTS    100
 #define SOFT_RESET_TIME_MS    2 /* 1ms + elbow room */
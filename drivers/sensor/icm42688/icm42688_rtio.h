@@ -9,4 +9,10 @@
 
 int icm42688_submit(const struct device *sensor, struct rtio_iodev_sqe *iodev_sqe);
 
+/** Start streaming the FIFO, completing @p iodev_sqe at each FIFO trigger */
+void icm42688_submit_stream(const struct device *sensor, struct rtio_iodev_sqe *iodev_sqe);
+
+/** Read the FIFO into the streaming read, called from the trigger thread */
+void icm42688_fifo_event(const struct device *dev);
+
 #endif /* ZEPHYR_DRIVERS_SENSOR_ICM42688_RTIO_H_ */
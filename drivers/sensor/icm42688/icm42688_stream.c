@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/drivers/sensor.h>
+#include <zephyr/sys/byteorder.h>
+#include "icm42688.h"
+#include "icm42688_decoder.h"
+#include "icm42688_reg.h"
+#include "icm42688_rtio.h"
+#include "icm42688_spi.h"
+#include "icm42688_trigger.h"
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(ICM42688_RTIO, CONFIG_SENSOR_LOG_LEVEL);
+
+static int icm42688_stream_configure(const struct device *dev, bool fifo_en, uint16_t fifo_wm)
+{
+	struct icm42688_dev_data *data = dev->data;
+	struct icm42688_cfg new_config = data->cfg;
+
+	if (data->cfg.fifo_en == fifo_en && data->cfg.fifo_wm == fifo_wm) {
+		return 0;
+	}
+
+	new_config.fifo_en = fifo_en;
+	new_config.fifo_wm = fifo_wm;
+
+	return icm42688_safely_configure(dev, &new_config);
+}
+
+void icm42688_submit_stream(const struct device *dev, struct rtio_iodev_sqe *iodev_sqe)
+{
+	const struct sensor_read_config *cfg = iodev_sqe->sqe.iodev->data;
+	struct icm42688_dev_data *data = dev->data;
+	/* Without watermark trigger, only interrupt when the FIFO is full */
+	uint16_t fifo_wm = FIFO_SIZE;
+	int rc;
+
+	for (size_t i = 0; i < cfg->count; i++) {
+		switch (cfg->triggers[i].trigger) {
+		case SENSOR_TRIG_FIFO_WATERMARK:
+			fifo_wm = CONFIG_ICM42688_STREAM_FIFO_WATERMARK * FIFO_PACKET_SIZE;
+			break;
+		case SENSOR_TRIG_FIFO_FULL:
+			break;
+		default:
+			LOG_ERR("Unsupported stream trigger %d", cfg->triggers[i].trigger);
+			rtio_iodev_sqe_err(iodev_sqe, -ENOTSUP);
+			return;
+		}
+	}
+
+	icm42688_lock(dev);
+
+	rc = icm42688_stream_configure(dev, true, fifo_wm);
+	if (rc != 0) {
+		icm42688_unlock(dev);
+		LOG_ERR("Failed to enable the FIFO");
+		rtio_iodev_sqe_err(iodev_sqe, rc);
+		return;
+	}
+
+	data->streaming_sqe = iodev_sqe;
+
+	icm42688_unlock(dev);
+}
+
+static enum sensor_stream_data_opt icm42688_stream_opt(const struct sensor_read_config *cfg,
+						       uint8_t int_status, bool *triggered)
+{
+	enum sensor_stream_data_opt opt = SENSOR_STREAM_DATA_NOP;
+
+	*triggered = false;
+
+	for (size_t i = 0; i < cfg->count; i++) {
+		const struct sensor_stream_trigger *trig = &cfg->triggers[i];
+
+		if ((trig->trigger == SENSOR_TRIG_FIFO_WATERMARK &&
+		     FIELD_GET(BIT_INT_STATUS_FIFO_THS, int_status)) ||
+		    (trig->trigger == SENSOR_TRIG_FIFO_FULL &&
+		     FIELD_GET(BIT_INT_STATUS_FIFO_FULL, int_status))) {
+			*triggered = true;
+			/* Including the data wins over dropping it, which wins over leaving it */
+			if (trig->opt == SENSOR_STREAM_DATA_INCLUDE ||
+			    (trig->opt == SENSOR_STREAM_DATA_DROP &&
+			     opt == SENSOR_STREAM_DATA_NOP)) {
+				opt = trig->opt;
+			}
+		}
+	}
+
+	return opt;
+}
+
+void icm42688_fifo_event(const struct device *dev)
+{
+	struct icm42688_dev_data *data = dev->data;
+	const struct icm42688_dev_cfg *dev_cfg = dev->config;
+	struct rtio_iodev_sqe *iodev_sqe = data->streaming_sqe;
+	const struct sensor_read_config *cfg;
+	struct icm42688_fifo_data *edata;
+	enum sensor_stream_data_opt opt;
+	uint8_t count_buf[2];
+	uint16_t fifo_count;
+	uint8_t int_status;
+	uint64_t timestamp;
+	uint32_t min_buf_len;
+	uint32_t buf_len;
+	uint8_t *buf;
+	bool triggered;
+	int rc;
+
+	if (iodev_sqe == NULL) {
+		return;
+	}
+
+	data->streaming_sqe = NULL;
+
+	if (FIELD_GET(RTIO_SQE_CANCELED, iodev_sqe->sqe.flags)) {
+		(void)icm42688_stream_configure(dev, false, 0);
+		rtio_iodev_sqe_err(iodev_sqe, -ECANCELED);
+		return;
+	}
+
+	cfg = iodev_sqe->sqe.iodev->data;
+
+	rc = icm42688_spi_read(&dev_cfg->spi, REG_INT_STATUS, &int_status, 1);
+	if (rc != 0) {
+		goto err;
+	}
+
+	opt = icm42688_stream_opt(cfg, int_status, &triggered);
+	if (!triggered) {
+		/* Not a FIFO interrupt, keep waiting */
+		data->streaming_sqe = iodev_sqe;
+		return;
+	}
+
+	rc = icm42688_spi_read(&dev_cfg->spi, REG_FIFO_COUNTH, count_buf, sizeof(count_buf));
+	if (rc != 0) {
+		goto err;
+	}
+
+	/* The last frame in the FIFO was sampled at most one period before its count is read */
+	timestamp = k_ticks_to_ns_floor64(k_uptime_ticks());
+
+	/* Only read whole packets */
+	fifo_count = sys_get_be16(count_buf);
+	fifo_count -= fifo_count % FIFO_PACKET_SIZE;
+	if (opt != SENSOR_STREAM_DATA_INCLUDE) {
+		fifo_count = 0;
+	}
+
+	min_buf_len = sizeof(struct icm42688_fifo_data) + fifo_count;
+	rc = rtio_sqe_rx_buf(iodev_sqe, min_buf_len, min_buf_len, &buf, &buf_len);
+	if (rc != 0) {
+		LOG_ERR("Failed to get a read buffer of size %u bytes", min_buf_len);
+		(void)icm42688_spi_single_write(&dev_cfg->spi, REG_SIGNAL_PATH_RESET,
+						FIELD_PREP(BIT_FIFO_FLUSH, 1));
+		goto err;
+	}
+
+	edata = (struct icm42688_fifo_data *)buf;
+	edata->header.timestamp = timestamp;
+	edata->header.is_fifo = true;
+	edata->header.accel_fs = data->cfg.accel_fs;
+	edata->header.gyro_fs = data->cfg.gyro_fs;
+	edata->int_status = int_status;
+	edata->accel_odr = data->cfg.accel_odr;
+	edata->gyro_odr = data->cfg.gyro_odr;
+	edata->fifo_count = fifo_count;
+
+	if (fifo_count > 0) {
+		rc = icm42688_spi_read(&dev_cfg->spi, REG_FIFO_DATA, buf + sizeof(*edata),
+				       fifo_count);
+		if (rc != 0) {
+			goto err;
+		}
+	} else if (opt == SENSOR_STREAM_DATA_DROP) {
+		rc = icm42688_spi_single_write(&dev_cfg->spi, REG_SIGNAL_PATH_RESET,
+					       FIELD_PREP(BIT_FIFO_FLUSH, 1));
+		if (rc != 0) {
+			goto err;
+		}
+	}
+
+	rtio_iodev_sqe_ok(iodev_sqe, 0);
+	return;
+
+err:
+	LOG_ERR("Failed to read the FIFO");
+	rtio_iodev_sqe_err(iodev_sqe, rc);
+}
@@ -705,6 +705,10 @@ static const struct sensor_driver_api lsm6dso_driver_api = {
 #endif
 	.sample_fetch = lsm6dso_sample_fetch,
 	.channel_get = lsm6dso_channel_get,
+#if CONFIG_LSM6DSO_STREAM
+	.submit = lsm6dso_submit,
+	.get_decoder = lsm6dso_get_decoder,
+#endif
 };
 
 static int lsm6dso_init_chip(const struct device *dev)
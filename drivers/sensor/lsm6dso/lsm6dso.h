@@ -36,6 +36,19 @@
 /* Gyro sensor sensitivity grain is 4.375 udps/LSB */
 #define GAIN_UNIT_G				(4375LL)
 
+/* FIFO words: a tag followed by a 6 byte sample */
+#define LSM6DSO_FIFO_WORD_SIZE			7
+#define LSM6DSO_FIFO_TAG_SENSOR(tag)		((tag) >> 3)
+#define LSM6DSO_FIFO_TAG_CNT(tag)		(((tag) >> 1) & 0x3)
+#define LSM6DSO_FIFO_TAG_GYRO_NC		0x01
+#define LSM6DSO_FIFO_TAG_XL_NC			0x02
+
+/* FIFO_STATUS2 */
+#define LSM6DSO_FIFO_STATUS2_DIFF_MSK		GENMASK(1, 0)
+#define LSM6DSO_FIFO_STATUS2_FULL		BIT(5)
+#define LSM6DSO_FIFO_STATUS2_OVR		BIT(6)
+#define LSM6DSO_FIFO_STATUS2_WTM		BIT(7)
+
 #define SENSOR_PI_DOUBLE			(SENSOR_PI / 1000000.0)
 #define SENSOR_DEG2RAD_DOUBLE			(SENSOR_PI_DOUBLE / 180)
 #define SENSOR_G_DOUBLE				(SENSOR_G / 1000000.0)
@@ -114,8 +127,28 @@ struct lsm6dso_data {
 	struct k_work work;
 #endif
 #endif /* CONFIG_LSM6DSO_TRIGGER */
+
+#ifdef CONFIG_LSM6DSO_STREAM
+	struct rtio_iodev_sqe *streaming_sqe;
+	bool streaming;
+#endif /* CONFIG_LSM6DSO_STREAM */
 };
 
+/*
+ * Buffer of the asynchronous API: the header is followed by fifo_count FIFO words, the
+ * timestamp being the one of the last words. One-shot reads are encoded as the words of a
+ * single time slot.
+ */
+struct lsm6dso_fifo_data {
+	uint64_t timestamp;
+	uint8_t fifo_status2;
+	uint8_t accel_odr: 4;
+	uint8_t gyro_odr: 4;
+	uint32_t acc_gain;
+	uint32_t gyro_gain;
+	uint16_t fifo_count;
+} __packed;
+
 #if defined(CONFIG_LSM6DSO_SENSORHUB)
 int lsm6dso_shub_init(const struct device *dev);
 int lsm6dso_shub_fetch_external_devs(const struct device *dev);
@@ -133,4 +166,13 @@ int lsm6dso_trigger_set(const struct device *dev,
 int lsm6dso_init_interrupt(const struct device *dev);
 #endif
 
+#ifdef CONFIG_LSM6DSO_STREAM
+int lsm6dso_submit(const struct device *dev, struct rtio_iodev_sqe *iodev_sqe);
+
+int lsm6dso_get_decoder(const struct device *dev, const struct sensor_decoder_api **decoder);
+
+/* Read the FIFO into the streaming read, called from the trigger thread */
+void lsm6dso_fifo_event(const struct device *dev);
+#endif
+
 #endif /* ZEPHYR_DRIVERS_SENSOR_LSM6DSO_LSM6DSO_H_ */
@@ -0,0 +1,290 @@
+/* ST Microelectronics LSM6DSO 6-axis IMU sensor driver
+ *
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#define DT_DRV_COMPAT st_lsm6dso
+
+#include <errno.h>
+
+#include <zephyr/drivers/sensor.h>
+#include <zephyr/sys/byteorder.h>
+
+#include "lsm6dso.h"
+
+/*
+ * The words of a time slot share their tag counter. The frame iterator is the index of the
+ * first word of the next time slot, and the channel iterator the next of the channels below.
+ */
+static const enum sensor_channel lsm6dso_channels[] = {
+	SENSOR_CHAN_ACCEL_X, SENSOR_CHAN_ACCEL_Y, SENSOR_CHAN_ACCEL_Z,
+	SENSOR_CHAN_GYRO_X,  SENSOR_CHAN_GYRO_Y,  SENSOR_CHAN_GYRO_Z,
+};
+
+/* Periods of the output data rates in nanoseconds, from 12.5 Hz to 6.66 kHz */
+static const uint32_t lsm6dso_odr_period_ns[] = {
+	0, 80000000, 38461538, 19230769, 9615385, 4807692,
+	2403846, 1200480, 602410, 300300, 150150,
+};
+
+static const uint8_t *lsm6dso_word(const struct lsm6dso_fifo_data *edata, uint32_t index)
+{
+	return (const uint8_t *)edata + sizeof(*edata) + index * LSM6DSO_FIFO_WORD_SIZE;
+}
+
+/* Index of the first word after the time slot starting at @p index */
+static uint32_t lsm6dso_frame_end(const struct lsm6dso_fifo_data *edata, uint32_t index)
+{
+	uint8_t cnt = LSM6DSO_FIFO_TAG_CNT(lsm6dso_word(edata, index)[0]);
+
+	do {
+		index++;
+	} while (index < edata->fifo_count &&
+		 LSM6DSO_FIFO_TAG_CNT(lsm6dso_word(edata, index)[0]) == cnt);
+
+	return index;
+}
+
+/* Get the sample of a channel position in a time slot, NULL if the slot does not hold it */
+static const uint8_t *lsm6dso_frame_sample(const struct lsm6dso_fifo_data *edata,
+					   uint32_t start, uint32_t end, int pos)
+{
+	uint8_t sensor = pos < 3 ? LSM6DSO_FIFO_TAG_XL_NC : LSM6DSO_FIFO_TAG_GYRO_NC;
+
+	for (uint32_t i = start; i < end; i++) {
+		const uint8_t *word = lsm6dso_word(edata, i);
+
+		if (LSM6DSO_FIFO_TAG_SENSOR(word[0]) == sensor) {
+			return &word[1 + (pos % 3) * 2];
+		}
+	}
+
+	return NULL;
+}
+
+/* Count the time slots, and find the index of the one starting at the word @p start */
+static uint16_t lsm6dso_count_frames(const struct lsm6dso_fifo_data *edata, uint32_t start,
+				     int *index)
+{
+	uint16_t count = 0;
+
+	*index = -1;
+
+	for (uint32_t i = 0; i < edata->fifo_count; i = lsm6dso_frame_end(edata, i)) {
+		if (i == start) {
+			*index = count;
+		}
+		count++;
+	}
+
+	return count;
+}
+
+/* Full scale of a channel in micro m/s^2 or micro rad/s */
+static int64_t lsm6dso_full_scale(const struct lsm6dso_fifo_data *edata, int pos)
+{
+	/* Same conversions as the fetch API, from ug/LSB and udps/LSB */
+	if (pos < 3) {
+		return (INT64_C(32768) * edata->acc_gain * SENSOR_G) / 1000000LL;
+	}
+
+	return (INT64_C(32768) * edata->gyro_gain * SENSOR_PI) / (180LL * 1000000LL);
+}
+
+static int lsm6dso_get_shift(enum sensor_channel channel, const struct lsm6dso_fifo_data *edata,
+			     int8_t *shift)
+{
+	int64_t full_scale;
+	int8_t s = 0;
+
+	switch (channel) {
+	case SENSOR_CHAN_ACCEL_XYZ:
+	case SENSOR_CHAN_ACCEL_X:
+	case SENSOR_CHAN_ACCEL_Y:
+	case SENSOR_CHAN_ACCEL_Z:
+		full_scale = lsm6dso_full_scale(edata, 0);
+		break;
+	case SENSOR_CHAN_GYRO_XYZ:
+	case SENSOR_CHAN_GYRO_X:
+	case SENSOR_CHAN_GYRO_Y:
+	case SENSOR_CHAN_GYRO_Z:
+		full_scale = lsm6dso_full_scale(edata, 3);
+		break;
+	default:
+		return -EINVAL;
+	}
+
+	if (full_scale == 0) {
+		return -EINVAL;
+	}
+
+	/* Smallest power of two above the full scale */
+	while ((INT64_C(1000000) << s) <= full_scale) {
+		s++;
+	}
+
+	*shift = s;
+	return 0;
+}
+
+static void lsm6dso_convert(const struct lsm6dso_fifo_data *edata, int pos, int16_t raw,
+			    q31_t *out)
+{
+	int64_t micro;
+	int8_t shift;
+
+	if (lsm6dso_get_shift(lsm6dso_channels[pos], edata, &shift) != 0) {
+		*out = 0;
+		return;
+	}
+
+	if (pos < 3) {
+		micro = ((int64_t)raw * edata->acc_gain * SENSOR_G) / 1000000LL;
+	} else {
+		micro = ((int64_t)raw * edata->gyro_gain * SENSOR_PI) / (180LL * 1000000LL);
+	}
+
+	micro = micro * ((int64_t)INT32_MAX + 1) / (INT64_C(1000000) << shift);
+	*out = CLAMP(micro, INT32_MIN, INT32_MAX);
+}
+
+static int lsm6dso_decoder_decode(const uint8_t *buffer, sensor_frame_iterator_t *fit,
+				  sensor_channel_iterator_t *cit, enum sensor_channel *channels,
+				  q31_t *values, uint8_t max_count)
+{
+	const struct lsm6dso_fifo_data *edata = (const struct lsm6dso_fifo_data *)buffer;
+	const uint8_t *sample;
+	int count = 0;
+	uint32_t end;
+	int pos;
+
+	while (count == 0 && *fit < edata->fifo_count) {
+		end = lsm6dso_frame_end(edata, *fit);
+
+		while (*cit < ARRAY_SIZE(lsm6dso_channels) && count < max_count) {
+			pos = *cit;
+			*cit += 1;
+
+			sample = lsm6dso_frame_sample(edata, *fit, end, pos);
+			if (sample == NULL) {
+				continue;
+			}
+
+			channels[count] = lsm6dso_channels[pos];
+			lsm6dso_convert(edata, pos, sys_get_le16(sample), &values[count]);
+			count++;
+		}
+
+		if (*cit < ARRAY_SIZE(lsm6dso_channels)) {
+			/* Out of room, the frame is not fully decoded */
+			break;
+		}
+
+		*fit = end;
+		*cit = 0;
+	}
+
+	return count;
+}
+
+static int lsm6dso_decoder_get_frame_count(const uint8_t *buffer, uint16_t *frame_count)
+{
+	int index;
+
+	*frame_count = lsm6dso_count_frames((const struct lsm6dso_fifo_data *)buffer, 0, &index);
+
+	return 0;
+}
+
+static uint64_t lsm6dso_odr_period(uint8_t odr)
+{
+	return odr < ARRAY_SIZE(lsm6dso_odr_period_ns) ? lsm6dso_odr_period_ns[odr] : 0;
+}
+
+/* The time slots are pushed at the fastest of the batch data rates */
+static uint64_t lsm6dso_fifo_period_ns(const struct lsm6dso_fifo_data *edata)
+{
+	uint64_t accel_period = lsm6dso_odr_period(edata->accel_odr);
+	uint64_t gyro_period = lsm6dso_odr_period(edata->gyro_odr);
+
+	if (accel_period == 0) {
+		return gyro_period;
+	}
+	if (gyro_period == 0) {
+		return accel_period;
+	}
+
+	return MIN(accel_period, gyro_period);
+}
+
+static int lsm6dso_decoder_get_frame_timestamp(const uint8_t *buffer,
+					       sensor_frame_iterator_t fit,
+					       uint64_t *timestamp_ns)
+{
+	const struct lsm6dso_fifo_data *edata = (const struct lsm6dso_fifo_data *)buffer;
+	uint16_t frame_count;
+	int index;
+
+	frame_count = lsm6dso_count_frames(edata, fit, &index);
+	if (index < 0) {
+		return -EINVAL;
+	}
+
+	/* The header timestamp is the one of the last slot, the slots are one period apart */
+	*timestamp_ns = edata->timestamp - (frame_count - 1 - index) * lsm6dso_fifo_period_ns(edata);
+
+	return 0;
+}
+
+static int lsm6dso_decoder_get_timestamp(const uint8_t *buffer, uint64_t *timestamp_ns)
+{
+	const struct lsm6dso_fifo_data *edata = (const struct lsm6dso_fifo_data *)buffer;
+
+	if (edata->fifo_count == 0) {
+		*timestamp_ns = edata->timestamp;
+		return 0;
+	}
+
+	/* Timestamp of the first time slot */
+	return lsm6dso_decoder_get_frame_timestamp(buffer, 0, timestamp_ns);
+}
+
+static int lsm6dso_decoder_get_shift(const uint8_t *buffer, enum sensor_channel channel_type,
+				     int8_t *shift)
+{
+	return lsm6dso_get_shift(channel_type, (const struct lsm6dso_fifo_data *)buffer, shift);
+}
+
+static bool lsm6dso_decoder_has_trigger(const uint8_t *buffer, enum sensor_trigger_type trigger)
+{
+	const struct lsm6dso_fifo_data *edata = (const struct lsm6dso_fifo_data *)buffer;
+
+	switch (trigger) {
+	case SENSOR_TRIG_FIFO_WATERMARK:
+		return (edata->fifo_status2 & LSM6DSO_FIFO_STATUS2_WTM) != 0;
+	case SENSOR_TRIG_FIFO_FULL:
+		return (edata->fifo_status2 &
+			(LSM6DSO_FIFO_STATUS2_FULL | LSM6DSO_FIFO_STATUS2_OVR)) != 0;
+	default:
+		return false;
+	}
+}
+
+SENSOR_DECODER_API_DT_DEFINE() = {
+	.get_frame_count = lsm6dso_decoder_get_frame_count,
+	.get_timestamp = lsm6dso_decoder_get_timestamp,
+	.get_shift = lsm6dso_decoder_get_shift,
+	.decode = lsm6dso_decoder_decode,
+	.get_frame_timestamp = lsm6dso_decoder_get_frame_timestamp,
+	.has_trigger = lsm6dso_decoder_has_trigger,
+};
+
+int lsm6dso_get_decoder(const struct device *dev, const struct sensor_decoder_api **decoder)
+{
+	ARG_UNUSED(dev);
+	*decoder = &SENSOR_DECODER_NAME();
+
+	return 0;
+}
@@ -0,0 +1,402 @@
+/* ST Microelectronics LSM6DSO 6-axis IMU sensor driver
+ *
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/drivers/sensor.h>
+#include <zephyr/logging/log.h>
+
+#include "lsm6dso.h"
+
+LOG_MODULE_DECLARE(LSM6DSO, CONFIG_SENSOR_LOG_LEVEL);
+
+/* Fill the header from the current accelerometer and gyroscope configuration */
+static int lsm6dso_fifo_header_init(const struct device *dev, struct lsm6dso_fifo_data *edata)
+{
+	const struct lsm6dso_config *cfg = dev->config;
+	struct lsm6dso_data *data = dev->data;
+	stmdev_ctx_t *ctx = (stmdev_ctx_t *)&cfg->ctx;
+	uint8_t ctrl[2];
+	int ret;
+
+	/* CTRL1_XL and CTRL2_G, the ODRs being in the upper nibbles */
+	ret = lsm6dso_read_reg(ctx, LSM6DSO_CTRL1_XL, ctrl, sizeof(ctrl));
+	if (ret < 0) {
+		return ret;
+	}
+
+	edata->accel_odr = ctrl[0] >> 4;
+	edata->gyro_odr = ctrl[1] >> 4;
+	edata->acc_gain = data->acc_gain;
+	edata->gyro_gain = data->gyro_gain;
+
+	return 0;
+}
+
+static void lsm6dso_submit_one_shot(const struct device *dev, struct rtio_iodev_sqe *iodev_sqe)
+{
+	const struct sensor_read_config *read_cfg = iodev_sqe->sqe.iodev->data;
+	const struct lsm6dso_config *cfg = dev->config;
+	stmdev_ctx_t *ctx = (stmdev_ctx_t *)&cfg->ctx;
+	const uint32_t min_buf_len =
+		sizeof(struct lsm6dso_fifo_data) + 2 * LSM6DSO_FIFO_WORD_SIZE;
+	struct lsm6dso_fifo_data *edata;
+	bool accel = false;
+	bool gyro = false;
+	uint8_t sample[12];
+	uint32_t buf_len;
+	uint8_t *words;
+	uint8_t *buf;
+	int ret;
+
+	for (size_t i = 0; i < read_cfg->count; i++) {
+		switch (read_cfg->channels[i]) {
+		case SENSOR_CHAN_ACCEL_X:
+		case SENSOR_CHAN_ACCEL_Y:
+		case SENSOR_CHAN_ACCEL_Z:
+		case SENSOR_CHAN_ACCEL_XYZ:
+			accel = true;
+			break;
+		case SENSOR_CHAN_GYRO_X:
+		case SENSOR_CHAN_GYRO_Y:
+		case SENSOR_CHAN_GYRO_Z:
+		case SENSOR_CHAN_GYRO_XYZ:
+			gyro = true;
+			break;
+		case SENSOR_CHAN_ALL:
+			accel = true;
+			gyro = true;
+			break;
+		default:
+			LOG_ERR("Unsupported channel %d", read_cfg->channels[i]);
+			rtio_iodev_sqe_err(iodev_sqe, -ENOTSUP);
+			return;
+		}
+	}
+
+	ret = rtio_sqe_rx_buf(iodev_sqe, min_buf_len, min_buf_len, &buf, &buf_len);
+	if (ret != 0) {
+		LOG_ERR("Failed to get a read buffer of size %u bytes", min_buf_len);
+		rtio_iodev_sqe_err(iodev_sqe, ret);
+		return;
+	}
+
+	edata = (struct lsm6dso_fifo_data *)buf;
+	ret = lsm6dso_fifo_header_init(dev, edata);
+	if (ret < 0) {
+		goto err;
+	}
+
+	/* OUTX_L_G to OUTZ_H_A, the gyroscope sample being before the accelerometer one */
+	ret = lsm6dso_read_reg(ctx, LSM6DSO_OUTX_L_G, sample, sizeof(sample));
+	if (ret < 0) {
+		goto err;
+	}
+
+	edata->timestamp = k_ticks_to_ns_floor64(k_uptime_ticks());
+	edata->fifo_status2 = 0;
+	edata->fifo_count = 0;
+
+	/* Encode the sample as the FIFO words of a single time slot */
+	words = buf + sizeof(*edata);
+	if (accel) {
+		words[0] = LSM6DSO_FIFO_TAG_XL_NC << 3;
+		memcpy(&words[1], &sample[6], 6);
+		words += LSM6DSO_FIFO_WORD_SIZE;
+		edata->fifo_count++;
+	}
+	if (gyro) {
+		words[0] = LSM6DSO_FIFO_TAG_GYRO_NC << 3;
+		memcpy(&words[1], &sample[0], 6);
+		edata->fifo_count++;
+	}
+
+	rtio_iodev_sqe_ok(iodev_sqe, 0);
+	return;
+
+err:
+	LOG_ERR("Failed to read the sample");
+	rtio_iodev_sqe_err(iodev_sqe, ret);
+}
+
+static int lsm6dso_fifo_int_set(const struct device *dev, bool fifo_th, bool fifo_full)
+{
+	const struct lsm6dso_config *cfg = dev->config;
+	stmdev_ctx_t *ctx = (stmdev_ctx_t *)&cfg->ctx;
+	int ret;
+
+	if (cfg->int_pin == 1) {
+		lsm6dso_int1_ctrl_t int1_ctrl;
+
+		ret = lsm6dso_read_reg(ctx, LSM6DSO_INT1_CTRL, (uint8_t *)&int1_ctrl, 1);
+		if (ret < 0) {
+			return ret;
+		}
+
+		int1_ctrl.int1_fifo_th = fifo_th;
+		int1_ctrl.int1_fifo_full = fifo_full;
+		return lsm6dso_write_reg(ctx, LSM6DSO_INT1_CTRL, (uint8_t *)&int1_ctrl, 1);
+	} else {
+		lsm6dso_int2_ctrl_t int2_ctrl;
+
+		ret = lsm6dso_read_reg(ctx, LSM6DSO_INT2_CTRL, (uint8_t *)&int2_ctrl, 1);
+		if (ret < 0) {
+			return ret;
+		}
+
+		int2_ctrl.int2_fifo_th = fifo_th;
+		int2_ctrl.int2_fifo_full = fifo_full;
+		return lsm6dso_write_reg(ctx, LSM6DSO_INT2_CTRL, (uint8_t *)&int2_ctrl, 1);
+	}
+}
+
+/* Discard the FIFO content by going through bypass mode */
+static int lsm6dso_fifo_flush(const struct device *dev)
+{
+	const struct lsm6dso_config *cfg = dev->config;
+	stmdev_ctx_t *ctx = (stmdev_ctx_t *)&cfg->ctx;
+	int ret;
+
+	ret = lsm6dso_fifo_mode_set(ctx, LSM6DSO_BYPASS_MODE);
+	if (ret < 0) {
+		return ret;
+	}
+
+	return lsm6dso_fifo_mode_set(ctx, LSM6DSO_STREAM_MODE);
+}
+
+/*
+ * Batch the accelerometer and the gyroscope at their output data rates in continuous mode,
+ * or stop the FIFO.
+ */
+static int lsm6dso_stream_configure(const struct device *dev, bool enable, bool fifo_th,
+				    bool fifo_full)
+{
+	const struct lsm6dso_config *cfg = dev->config;
+	stmdev_ctx_t *ctx = (stmdev_ctx_t *)&cfg->ctx;
+	struct lsm6dso_fifo_data edata;
+	int ret;
+
+	if (!enable) {
+		ret = lsm6dso_fifo_int_set(dev, false, false);
+		if (ret < 0) {
+			return ret;
+		}
+
+		return lsm6dso_fifo_mode_set(ctx, LSM6DSO_BYPASS_MODE);
+	}
+
+	ret = lsm6dso_fifo_header_init(dev, &edata);
+	if (ret < 0) {
+		return ret;
+	}
+
+	ret = lsm6dso_fifo_watermark_set(ctx, CONFIG_LSM6DSO_STREAM_FIFO_WATERMARK);
+	if (ret < 0) {
+		return ret;
+	}
+
+	/* The batch data rate codes are the ODR ones */
+	ret = lsm6dso_fifo_xl_batch_set(ctx, (lsm6dso_bdr_xl_t)edata.accel_odr);
+	if (ret < 0) {
+		return ret;
+	}
+
+	ret = lsm6dso_fifo_gy_batch_set(ctx, (lsm6dso_bdr_gy_t)edata.gyro_odr);
+	if (ret < 0) {
+		return ret;
+	}
+
+	ret = lsm6dso_fifo_flush(dev);
+	if (ret < 0) {
+		return ret;
+	}
+
+	return lsm6dso_fifo_int_set(dev, fifo_th, fifo_full);
+}
+
+static void lsm6dso_submit_stream(const struct device *dev, struct rtio_iodev_sqe *iodev_sqe)
+{
+	const struct sensor_read_config *read_cfg = iodev_sqe->sqe.iodev->data;
+	const struct lsm6dso_config *cfg = dev->config;
+	struct lsm6dso_data *data = dev->data;
+	bool fifo_full = false;
+	bool fifo_th = false;
+	int ret;
+
+	if (!cfg->trig_enabled) {
+		LOG_ERR("Streaming requires the interrupt line");
+		rtio_iodev_sqe_err(iodev_sqe, -ENOTSUP);
+		return;
+	}
+
+	for (size_t i = 0; i < read_cfg->count; i++) {
+		switch (read_cfg->triggers[i].trigger) {
+		case SENSOR_TRIG_FIFO_WATERMARK:
+			fifo_th = true;
+			break;
+		case SENSOR_TRIG_FIFO_FULL:
+			fifo_full = true;
+			break;
+		default:
+			LOG_ERR("Unsupported stream trigger %d", read_cfg->triggers[i].trigger);
+			rtio_iodev_sqe_err(iodev_sqe, -ENOTSUP);
+			return;
+		}
+	}
+
+	/* Resubmissions of a multishot read keep the FIFO running */
+	if (!data->streaming) {
+		ret = lsm6dso_stream_configure(dev, true, fifo_th, fifo_full);
+		if (ret < 0) {
+			LOG_ERR("Failed to enable the FIFO");
+			rtio_iodev_sqe_err(iodev_sqe, ret);
+			return;
+		}
+		data->streaming = true;
+	}
+
+	data->streaming_sqe = iodev_sqe;
+}
+
+int lsm6dso_submit(const struct device *dev, struct rtio_iodev_sqe *iodev_sqe)
+{
+	const struct sensor_read_config *read_cfg = iodev_sqe->sqe.iodev->data;
+
+	if (read_cfg->is_streaming) {
+		lsm6dso_submit_stream(dev, iodev_sqe);
+	} else {
+		lsm6dso_submit_one_shot(dev, iodev_sqe);
+	}
+
+	return 0;
+}
+
+static enum sensor_stream_data_opt lsm6dso_stream_opt(const struct sensor_read_config *read_cfg,
+						      uint8_t fifo_status2, bool *triggered)
+{
+	enum sensor_stream_data_opt opt = SENSOR_STREAM_DATA_NOP;
+
+	*triggered = false;
+
+	for (size_t i = 0; i < read_cfg->count; i++) {
+		const struct sensor_stream_trigger *trig = &read_cfg->triggers[i];
+
+		if ((trig->trigger == SENSOR_TRIG_FIFO_WATERMARK &&
+		     (fifo_status2 & LSM6DSO_FIFO_STATUS2_WTM)) ||
+		    (trig->trigger == SENSOR_TRIG_FIFO_FULL &&
+		     (fifo_status2 & (LSM6DSO_FIFO_STATUS2_FULL | LSM6DSO_FIFO_STATUS2_OVR)))) {
+			*triggered = true;
+			/* Including the data wins over dropping it, which wins over leaving it */
+			if (trig->opt == SENSOR_STREAM_DATA_INCLUDE ||
+			    (trig->opt == SENSOR_STREAM_DATA_DROP &&
+			     opt == SENSOR_STREAM_DATA_NOP)) {
+				opt = trig->opt;
+			}
+		}
+	}
+
+	return opt;
+}
+
+void lsm6dso_fifo_event(const struct device *dev)
+{
+	const struct lsm6dso_config *cfg = dev->config;
+	struct lsm6dso_data *data = dev->data;
+	stmdev_ctx_t *ctx = (stmdev_ctx_t *)&cfg->ctx;
+	struct rtio_iodev_sqe *iodev_sqe = data->streaming_sqe;
+	const struct sensor_read_config *read_cfg;
+	struct lsm6dso_fifo_data *edata;
+	enum sensor_stream_data_opt opt;
+	uint8_t fifo_status[2];
+	uint16_t fifo_count;
+	uint64_t timestamp;
+	uint32_t min_buf_len;
+	uint32_t buf_len;
+	uint8_t *buf;
+	bool triggered;
+	int ret;
+
+	if (iodev_sqe == NULL) {
+		return;
+	}
+
+	data->streaming_sqe = NULL;
+
+	if (FIELD_GET(RTIO_SQE_CANCELED, iodev_sqe->sqe.flags)) {
+		(void)lsm6dso_stream_configure(dev, false, false, false);
+		data->streaming = false;
+		rtio_iodev_sqe_err(iodev_sqe, -ECANCELED);
+		return;
+	}
+
+	read_cfg = iodev_sqe->sqe.iodev->data;
+
+	/* FIFO_STATUS1 and FIFO_STATUS2 */
+	ret = lsm6dso_read_reg(ctx, LSM6DSO_FIFO_STATUS1, fifo_status, sizeof(fifo_status));
+	if (ret < 0) {
+		goto err;
+	}
+
+	/* The last word in the FIFO was sampled at most one period before its count is read */
+	timestamp = k_ticks_to_ns_floor64(k_uptime_ticks());
+
+	opt = lsm6dso_stream_opt(read_cfg, fifo_status[1], &triggered);
+	if (!triggered) {
+		/* Not a FIFO interrupt, keep waiting */
+		data->streaming_sqe = iodev_sqe;
+		return;
+	}
+
+	fifo_count = fifo_status[0] |
+		     (uint16_t)FIELD_GET(LSM6DSO_FIFO_STATUS2_DIFF_MSK, fifo_status[1]) << 8;
+	if (opt != SENSOR_STREAM_DATA_INCLUDE) {
+		fifo_count = 0;
+	}
+
+	min_buf_len = sizeof(struct lsm6dso_fifo_data) + fifo_count * LSM6DSO_FIFO_WORD_SIZE;
+	ret = rtio_sqe_rx_buf(iodev_sqe, min_buf_len, min_buf_len, &buf, &buf_len);
+	if (ret != 0) {
+		LOG_ERR("Failed to get a read buffer of size %u bytes", min_buf_len);
+		(void)lsm6dso_fifo_flush(dev);
+		goto err;
+	}
+
+	edata = (struct lsm6dso_fifo_data *)buf;
+	ret = lsm6dso_fifo_header_init(dev, edata);
+	if (ret < 0) {
+		goto err;
+	}
+
+	edata->timestamp = timestamp;
+	edata->fifo_status2 = fifo_status[1];
+	edata->fifo_count = fifo_count;
+
+	if (fifo_count > 0) {
+		/*
+		 * Reading past FIFO_DATA_OUT_Z_H rolls back to FIFO_DATA_OUT_TAG, so all the
+		 * words come in a single burst.
+		 */
+		ret = lsm6dso_read_reg(ctx, LSM6DSO_FIFO_DATA_OUT_TAG, buf + sizeof(*edata),
+				       fifo_count * LSM6DSO_FIFO_WORD_SIZE);
+		if (ret < 0) {
+			goto err;
+		}
+	} else if (opt == SENSOR_STREAM_DATA_DROP) {
+		ret = lsm6dso_fifo_flush(dev);
+		if (ret < 0) {
+			goto err;
+		}
+	}
+
+	rtio_iodev_sqe_ok(iodev_sqe, 0);
+	return;
+
+err:
+	LOG_ERR("Failed to read the FIFO");
+	rtio_iodev_sqe_err(iodev_sqe, ret);
+}
@@ -176,6 +176,19 @@ static void lsm6dso_handle_interrupt(const struct device *dev)
 	stmdev_ctx_t *ctx = (stmdev_ctx_t *)&cfg->ctx;
 	lsm6dso_status_reg_t status;
 
+#if defined(CONFIG_LSM6DSO_STREAM)
+	if (lsm6dso->streaming_sqe != NULL) {
+		lsm6dso_fifo_event(dev);
+
+		/* Nothing reads the samples to clear the data ready flags */
+		if (lsm6dso->handler_drdy_acc == NULL && lsm6dso->handler_drdy_gyr == NULL) {
+			gpio_pin_interrupt_configure_dt(&cfg->gpio_drdy,
+							GPIO_INT_EDGE_TO_ACTIVE);
+			return;
+		}
+	}
+#endif
+
 	while (1) {
 		if (lsm6dso_status_reg_get(ctx, &status) < 0) {
 			LOG_DBG("failed reading status reg");
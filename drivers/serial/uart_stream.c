@@ -0,0 +1,301 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include <zephyr/drivers/serial/uart_stream.h>
+#include <zephyr/logging/log.h>
+
+LOG_MODULE_REGISTER(uart_stream, CONFIG_UART_LOG_LEVEL);
+
+/*
+ * The chunks go around the ring in order: the driver is given the chunk after the ones in use,
+ * fills it, and releases it. They are in use until they are released and fully read, the oldest
+ * one being the one read from.
+ */
+
+static uint8_t *chunk_ptr(struct uart_stream *stream, uint8_t chunk)
+{
+	return &stream->buffer[chunk * stream->chunk_size];
+}
+
+static uint8_t next_chunk(uint8_t chunk)
+{
+	return (chunk + 1) % CONFIG_UART_STREAM_CHUNKS;
+}
+
+/* Take the next free chunk for the driver, NULL if all of them are in use */
+static uint8_t *take_chunk(struct uart_stream *stream)
+{
+	uint8_t *buf;
+
+	if (stream->used == CONFIG_UART_STREAM_CHUNKS) {
+		return NULL;
+	}
+
+	buf = chunk_ptr(stream, stream->wr_chunk);
+	stream->len[stream->wr_chunk] = 0;
+	stream->wr_chunk = next_chunk(stream->wr_chunk);
+	stream->used++;
+	stream->held++;
+
+	return buf;
+}
+
+/* Free the oldest chunks once released by the driver and fully read */
+static void reclaim_chunks(struct uart_stream *stream)
+{
+	while (stream->used > stream->held &&
+	       stream->rd_off == stream->len[stream->rd_chunk]) {
+		stream->rd_chunk = next_chunk(stream->rd_chunk);
+		stream->rd_off = 0;
+		stream->used--;
+	}
+}
+
+/* Enable the reception on a free chunk, called with the lock held, returns the chunk or NULL */
+static uint8_t *restart_take(struct uart_stream *stream)
+{
+	uint8_t *buf;
+
+	if (!stream->running || stream->enabled) {
+		return NULL;
+	}
+
+	buf = take_chunk(stream);
+	if (buf != NULL) {
+		stream->enabled = true;
+	}
+
+	return buf;
+}
+
+static int restart(struct uart_stream *stream, uint8_t *buf)
+{
+	k_spinlock_key_t key;
+	int ret;
+
+	ret = uart_rx_enable(stream->dev, buf, stream->chunk_size, stream->timeout_us);
+	if (ret != 0) {
+		LOG_ERR("Failed to enable the reception: %d", ret);
+
+		/* Give back the chunk, the stream stops */
+		key = k_spin_lock(&stream->lock);
+		stream->enabled = false;
+		stream->running = false;
+		stream->wr_chunk = (stream->wr_chunk + CONFIG_UART_STREAM_CHUNKS - 1) %
+				   CONFIG_UART_STREAM_CHUNKS;
+		stream->used--;
+		stream->held--;
+		k_spin_unlock(&stream->lock, key);
+	}
+
+	return ret;
+}
+
+static void uart_stream_callback(const struct device *dev, struct uart_event *evt,
+				 void *user_data)
+{
+	struct uart_stream *stream = user_data;
+	k_spinlock_key_t key;
+	uint8_t *buf = NULL;
+	uint8_t chunk;
+
+	key = k_spin_lock(&stream->lock);
+
+	switch (evt->type) {
+	case UART_RX_RDY:
+		chunk = (evt->data.rx.buf - stream->buffer) / stream->chunk_size;
+		stream->len[chunk] = evt->data.rx.offset + evt->data.rx.len;
+		k_poll_signal_raise(&stream->signal, 0);
+		break;
+	case UART_RX_BUF_REQUEST:
+		/* Without a free chunk, the reception stops when the current one is full */
+		buf = take_chunk(stream);
+		break;
+	case UART_RX_BUF_RELEASED:
+		stream->held--;
+		reclaim_chunks(stream);
+		break;
+	case UART_RX_DISABLED:
+		stream->enabled = false;
+		buf = restart_take(stream);
+		break;
+	case UART_RX_STOPPED:
+		LOG_WRN("Reception stopped: %d", evt->data.rx_stop.reason);
+		k_poll_signal_raise(&stream->signal, evt->data.rx_stop.reason);
+		break;
+	default:
+		k_spin_unlock(&stream->lock, key);
+		if (stream->callback != NULL) {
+			stream->callback(dev, evt, stream->user_data);
+		}
+		return;
+	}
+
+	k_spin_unlock(&stream->lock, key);
+
+	/* Call the driver back without the lock, it may raise events synchronously */
+	if (buf == NULL) {
+		return;
+	}
+
+	if (evt->type == UART_RX_BUF_REQUEST) {
+		(void)uart_rx_buf_rsp(dev, buf, stream->chunk_size);
+	} else {
+		(void)restart(stream, buf);
+	}
+}
+
+int uart_stream_init(struct uart_stream *stream, const struct device *dev,
+		     uint8_t *buffer, size_t size, int32_t timeout_us)
+{
+	if (size < CONFIG_UART_STREAM_CHUNKS) {
+		return -EINVAL;
+	}
+
+	memset(stream, 0, sizeof(*stream));
+	stream->dev = dev;
+	stream->buffer = buffer;
+	stream->chunk_size = size / CONFIG_UART_STREAM_CHUNKS;
+	stream->timeout_us = timeout_us;
+	k_poll_signal_init(&stream->signal);
+
+	return 0;
+}
+
+void uart_stream_callback_set(struct uart_stream *stream, uart_callback_t callback,
+			      void *user_data)
+{
+	k_spinlock_key_t key = k_spin_lock(&stream->lock);
+
+	stream->callback = callback;
+	stream->user_data = user_data;
+
+	k_spin_unlock(&stream->lock, key);
+}
+
+int uart_stream_start(struct uart_stream *stream)
+{
+	k_spinlock_key_t key;
+	uint8_t *buf;
+	int ret;
+
+	ret = uart_callback_set(stream->dev, uart_stream_callback, stream);
+	if (ret != 0) {
+		return ret;
+	}
+
+	key = k_spin_lock(&stream->lock);
+
+	if (stream->running) {
+		k_spin_unlock(&stream->lock, key);
+		return -EALREADY;
+	}
+
+	stream->running = true;
+	buf = restart_take(stream);
+
+	k_spin_unlock(&stream->lock, key);
+
+	/* All the chunks hold unread data, the reception starts once one is read */
+	if (buf == NULL) {
+		return 0;
+	}
+
+	return restart(stream, buf);
+}
+
+int uart_stream_stop(struct uart_stream *stream)
+{
+	k_spinlock_key_t key;
+	bool enabled;
+
+	key = k_spin_lock(&stream->lock);
+
+	if (!stream->running) {
+		k_spin_unlock(&stream->lock, key);
+		return -EALREADY;
+	}
+
+	stream->running = false;
+	enabled = stream->enabled;
+
+	k_spin_unlock(&stream->lock, key);
+
+	return enabled ? uart_rx_disable(stream->dev) : 0;
+}
+
+size_t uart_stream_claim(struct uart_stream *stream, uint8_t **data)
+{
+	k_spinlock_key_t key;
+	size_t len;
+
+	key = k_spin_lock(&stream->lock);
+
+	reclaim_chunks(stream);
+
+	len = stream->used > 0 ? stream->len[stream->rd_chunk] - stream->rd_off : 0;
+	if (len > 0) {
+		*data = chunk_ptr(stream, stream->rd_chunk) + stream->rd_off;
+	} else {
+		/* Anything received from now on raises the signal again */
+		k_poll_signal_reset(&stream->signal);
+	}
+
+	k_spin_unlock(&stream->lock, key);
+
+	return len;
+}
+
+int uart_stream_finish(struct uart_stream *stream, size_t size)
+{
+	k_spinlock_key_t key;
+	uint8_t *buf;
+
+	key = k_spin_lock(&stream->lock);
+
+	if (stream->used == 0 || size > stream->len[stream->rd_chunk] - stream->rd_off) {
+		k_spin_unlock(&stream->lock, key);
+		return -EINVAL;
+	}
+
+	stream->rd_off += size;
+	reclaim_chunks(stream);
+
+	/* The reception stopped for the lack of a free chunk */
+	buf = restart_take(stream);
+
+	k_spin_unlock(&stream->lock, key);
+
+	if (buf != NULL) {
+		(void)restart(stream, buf);
+	}
+
+	return 0;
+}
+
+size_t uart_stream_read(struct uart_stream *stream, uint8_t *data, size_t size)
+{
+	size_t copied = 0;
+	uint8_t *claimed;
+	size_t len;
+
+	while (copied < size) {
+		len = uart_stream_claim(stream, &claimed);
+		if (len == 0) {
+			break;
+		}
+
+		len = MIN(len, size - copied);
+		memcpy(&data[copied], claimed, len);
+		(void)uart_stream_finish(stream, len);
+		copied += len;
+	}
+
+	return copied;
+}
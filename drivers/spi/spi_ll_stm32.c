@@ -86,6 +86,11 @@ static const struct mem_region nocache_mem_regions[] = {
  */
 uint32_t dummy_rx_tx_buffer;
 
+#ifdef CONFIG_SPI_STM32_RTIO
+static void spi_stm32_iodev_dma_callback(const struct device *dev,
+					 uint32_t channel, int status);
+#endif
+
 /* This function is executed in the interrupt context */
 static void dma_callback(const struct device *dev, void *arg,
 			 uint32_t channel, int status)
@@ -93,6 +98,13 @@ static void dma_callback(const struct device *dev, void *arg,
 	/* arg directly holds the spi device */
 	struct spi_stm32_data *data = arg;
 
+#ifdef CONFIG_SPI_STM32_RTIO
+	if (data->txn_head != NULL) {
+		spi_stm32_iodev_dma_callback(data->dev, channel, status);
+		return;
+	}
+#endif
+
 	if (status < 0) {
 		LOG_ERR("DMA callback error with channel %d.", channel);
 		data->status_flags |= SPI_STM32_DMA_ERROR_FLAG;
@@ -446,6 +458,12 @@ static void spi_stm32_complete(const struct device *dev, int status)
 	ll_func_disable_spi(spi);
 
 #ifdef CONFIG_SPI_STM32_INTERRUPT
+#ifdef CONFIG_SPI_STM32_RTIO
+	if (data->txn_head != NULL) {
+		/* RTIO transactions are not waited for through the context */
+		return;
+	}
+#endif
 	spi_context_complete(&data->ctx, dev, status);
 #endif
 }
@@ -619,12 +637,19 @@ static int spi_stm32_configure(const struct device *dev,
 	return 0;
 }
 
+#ifdef CONFIG_SPI_STM32_RTIO
+static void spi_stm32_iodev_next(const struct device *dev);
+#endif
+
 static int spi_stm32_release(const struct device *dev,
 			     const struct spi_config *config)
 {
 	struct spi_stm32_data *data = dev->data;
 
 	spi_context_unlock_unconditionally(&data->ctx);
+#ifdef CONFIG_SPI_STM32_RTIO
+	spi_stm32_iodev_next(dev);
+#endif
 
 	return 0;
 }
@@ -713,6 +738,10 @@ static int transceive(const struct device *dev,
 
 end:
 	spi_context_release(&data->ctx, ret);
+#ifdef CONFIG_SPI_STM32_RTIO
+	/* Start the RTIO transactions submitted while the bus was locked */
+	spi_stm32_iodev_next(dev);
+#endif
 
 	return ret;
 }
@@ -909,9 +938,268 @@ static int transceive_dma(const struct device *dev,
 
 end:
 	spi_context_release(&data->ctx, ret);
+#ifdef CONFIG_SPI_STM32_RTIO
+	/* Start the RTIO transactions submitted while the bus was locked */
+	spi_stm32_iodev_next(dev);
+#endif
 
 	return ret;
 }
+
+#ifdef CONFIG_SPI_STM32_RTIO
+
+static void spi_stm32_iodev_complete(const struct device *dev, int status)
+{
+	const struct spi_stm32_config *cfg = dev->config;
+	struct spi_stm32_data *data = dev->data;
+	struct rtio_iodev_sqe *txn_head = data->txn_head;
+	SPI_TypeDef *spi = cfg->spi;
+	k_spinlock_key_t key;
+
+	spi_stm32_complete(dev, status);
+	/* disable spi instance after completion */
+	LL_SPI_Disable(spi);
+	/* The Config. Reg. on some mcus is write un-protected when SPI is disabled */
+	LL_SPI_DisableDMAReq_TX(spi);
+	LL_SPI_DisableDMAReq_RX(spi);
+
+	dma_stop(data->dma_rx.dma_dev, data->dma_rx.channel);
+	dma_stop(data->dma_tx.dma_dev, data->dma_tx.channel);
+
+	key = k_spin_lock(&data->lock);
+	data->txn_head = NULL;
+	data->txn_curr = NULL;
+	k_sem_give(&data->ctx.lock);
+	k_spin_unlock(&data->lock, key);
+
+	spi_stm32_iodev_next(dev);
+
+	if (status != 0) {
+		rtio_iodev_sqe_err(txn_head, status);
+	} else {
+		rtio_iodev_sqe_ok(txn_head, 0);
+	}
+}
+
+/*
+ * Load the current submission in the DMA channels, returns its length, 0 if it
+ * has nothing to transfer.
+ */
+static int spi_stm32_iodev_load(const struct device *dev)
+{
+	const struct spi_stm32_config *cfg __maybe_unused = dev->config;
+	struct spi_stm32_data *data = dev->data;
+	const struct rtio_sqe *sqe = &data->txn_curr->sqe;
+	const uint8_t *tx_buf = NULL;
+	uint8_t *rx_buf = NULL;
+	size_t len;
+	int ret;
+
+	switch (sqe->op) {
+	case RTIO_OP_RX:
+		rx_buf = sqe->buf;
+		len = sqe->buf_len;
+		break;
+	case RTIO_OP_TX:
+		tx_buf = sqe->buf;
+		len = sqe->buf_len;
+		break;
+	case RTIO_OP_TINY_TX:
+		tx_buf = sqe->tiny_buf;
+		len = sqe->tiny_buf_len;
+		break;
+	case RTIO_OP_TXRX:
+		tx_buf = sqe->tx_buf;
+		rx_buf = sqe->rx_buf;
+		len = sqe->txrx_buf_len;
+		break;
+	default:
+		LOG_ERR("Invalid op code %d for submission %p", sqe->op, (void *)sqe);
+		return -EINVAL;
+	}
+
+	if (len == 0) {
+		return 0;
+	}
+
+#ifdef CONFIG_SOC_SERIES_STM32H7X
+	if ((tx_buf != NULL && !buf_in_nocache((uintptr_t)tx_buf, len)) ||
+	    (rx_buf != NULL && !buf_in_nocache((uintptr_t)rx_buf, len))) {
+		return -EFAULT;
+	}
+#endif /* CONFIG_SOC_SERIES_STM32H7X */
+
+	data->status_flags = 0;
+
+	/* The lengths of the submissions are in bytes */
+	ret = spi_stm32_dma_rx_load(dev, rx_buf, len);
+	if (ret != 0) {
+		return ret;
+	}
+
+	ret = spi_stm32_dma_tx_load(dev, tx_buf, len);
+	if (ret != 0) {
+		return ret;
+	}
+
+#if !DT_HAS_COMPAT_STATUS_OKAY(st_stm32h7_spi)
+	/* toggle the DMA request to restart the transfer */
+	LL_SPI_EnableDMAReq_RX(cfg->spi);
+	LL_SPI_EnableDMAReq_TX(cfg->spi);
+#endif /* ! st_stm32h7_spi */
+
+	return len;
+}
+
+/* Load the next submission of the transaction with data to transfer */
+static void spi_stm32_iodev_continue(const struct device *dev)
+{
+	struct spi_stm32_data *data = dev->data;
+	int ret = 0;
+
+	while (data->txn_curr != NULL) {
+		ret = spi_stm32_iodev_load(dev);
+		if (ret != 0) {
+			break;
+		}
+		data->txn_curr = rtio_txn_next(data->txn_curr);
+	}
+
+	if (ret < 0) {
+		spi_stm32_iodev_complete(dev, ret);
+	} else if (data->txn_curr == NULL) {
+		spi_stm32_iodev_complete(dev, 0);
+	}
+}
+
+/* This function is executed in the interrupt context */
+static void spi_stm32_iodev_dma_callback(const struct device *dev,
+					 uint32_t channel, int status)
+{
+	const struct spi_stm32_config *cfg = dev->config;
+	struct spi_stm32_data *data = dev->data;
+	SPI_TypeDef *spi = cfg->spi;
+
+	if (status < 0) {
+		LOG_ERR("DMA callback error with channel %d.", channel);
+		if (!(data->status_flags & SPI_STM32_DMA_ERROR_FLAG)) {
+			data->status_flags |= SPI_STM32_DMA_ERROR_FLAG;
+			spi_stm32_iodev_complete(dev, -EIO);
+		}
+		return;
+	}
+
+	if (status == DMA_STATUS_BLOCK) {
+		/* Half of the submission is transferred */
+		return;
+	}
+
+	if (channel == data->dma_tx.channel) {
+		data->status_flags |= SPI_STM32_DMA_TX_DONE_FLAG;
+	} else if (channel == data->dma_rx.channel) {
+		data->status_flags |= SPI_STM32_DMA_RX_DONE_FLAG;
+	}
+
+	if ((data->status_flags & SPI_STM32_DMA_DONE_FLAG) != SPI_STM32_DMA_DONE_FLAG) {
+		return;
+	}
+
+#ifdef SPI_SR_FTLVL
+	while (LL_SPI_GetTxFIFOLevel(spi) > 0) {
+	}
+#endif
+
+	/* wait until spi is no more busy (spi TX fifo is really empty) */
+	while (ll_func_spi_dma_busy(spi) == 0) {
+	}
+
+#if !DT_HAS_COMPAT_STATUS_OKAY(st_stm32h7_spi)
+	/* toggle the DMA transfer request */
+	LL_SPI_DisableDMAReq_TX(spi);
+	LL_SPI_DisableDMAReq_RX(spi);
+#endif /* ! st_stm32h7_spi */
+
+	data->txn_curr = rtio_txn_next(data->txn_curr);
+	spi_stm32_iodev_continue(dev);
+}
+
+static void spi_stm32_iodev_start(const struct device *dev)
+{
+	const struct spi_stm32_config *cfg = dev->config;
+	struct spi_stm32_data *data = dev->data;
+	struct spi_dt_spec *spi_dt_spec = data->txn_head->sqe.iodev->data;
+	SPI_TypeDef *spi = cfg->spi;
+	int ret;
+
+	data->txn_curr = data->txn_head;
+
+	ret = spi_stm32_configure(dev, &spi_dt_spec->config);
+	if (ret != 0) {
+		spi_stm32_iodev_complete(dev, ret);
+		return;
+	}
+
+#if DT_HAS_COMPAT_STATUS_OKAY(st_stm32h7_spi)
+	/* set request before enabling (else SPI CFG1 reg is write protected) */
+	LL_SPI_EnableDMAReq_RX(spi);
+	LL_SPI_EnableDMAReq_TX(spi);
+
+	LL_SPI_Enable(spi);
+	if (LL_SPI_GetMode(spi) == LL_SPI_MODE_MASTER) {
+		LL_SPI_StartMasterTransfer(spi);
+	}
+#else
+	LL_SPI_Enable(spi);
+#endif /* st_stm32h7_spi */
+
+	/* This is turned off in spi_stm32_complete(). */
+	spi_stm32_cs_control(dev, true);
+
+	spi_stm32_iodev_continue(dev);
+}
+
+static void spi_stm32_iodev_next(const struct device *dev)
+{
+	struct spi_stm32_data *data = dev->data;
+	struct rtio_mpsc_node *next;
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&data->lock);
+
+	/* The bus is in use by a transaction or a blocking call */
+	if (data->txn_head != NULL || k_sem_take(&data->ctx.lock, K_NO_WAIT) != 0) {
+		k_spin_unlock(&data->lock, key);
+		return;
+	}
+
+	next = rtio_mpsc_pop(&data->iodev_sq);
+	if (next == NULL) {
+		k_sem_give(&data->ctx.lock);
+		k_spin_unlock(&data->lock, key);
+		return;
+	}
+
+	data->txn_head = CONTAINER_OF(next, struct rtio_iodev_sqe, q);
+
+	k_spin_unlock(&data->lock, key);
+
+	spi_stm32_iodev_start(dev);
+}
+
+static void spi_stm32_iodev_submit(const struct device *dev,
+				   struct rtio_iodev_sqe *iodev_sqe)
+{
+	struct spi_stm32_data *data = dev->data;
+
+	if ((data->dma_tx.dma_dev == NULL) || (data->dma_rx.dma_dev == NULL)) {
+		rtio_iodev_sqe_err(iodev_sqe, -ENOTSUP);
+		return;
+	}
+
+	rtio_mpsc_push(&data->iodev_sq, &iodev_sqe->q);
+	spi_stm32_iodev_next(dev);
+}
+#endif /* CONFIG_SPI_STM32_RTIO */
 #endif /* CONFIG_SPI_STM32_DMA */
 
 static int spi_stm32_transceive(const struct device *dev,
@@ -947,6 +1235,9 @@ static const struct spi_driver_api api_funcs = {
 	.transceive = spi_stm32_transceive,
 #ifdef CONFIG_SPI_ASYNC
 	.transceive_async = spi_stm32_transceive_async,
+#endif
+#ifdef CONFIG_SPI_STM32_RTIO
+	.iodev_submit = spi_stm32_iodev_submit,
 #endif
 	.release = spi_stm32_release,
 };
@@ -1021,6 +1312,11 @@ static int spi_stm32_init(const struct device *dev)
 
 #endif /* CONFIG_SPI_STM32_DMA */
 
+#ifdef CONFIG_SPI_STM32_RTIO
+	data->dev = dev;
+	rtio_mpsc_init(&data->iodev_sq);
+#endif /* CONFIG_SPI_STM32_RTIO */
+
 	err = spi_context_cs_configure_all(&data->ctx);
 	if (err < 0) {
 		return err;
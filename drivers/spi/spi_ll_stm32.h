@@ -63,6 +63,13 @@ struct spi_stm32_data {
 	struct stream dma_rx;
 	struct stream dma_tx;
 #endif /* CONFIG_SPI_STM32_DMA */
+#ifdef CONFIG_SPI_STM32_RTIO
+	const struct device *dev;
+	struct k_spinlock lock;
+	struct rtio_mpsc iodev_sq;
+	struct rtio_iodev_sqe *txn_head;
+	struct rtio_iodev_sqe *txn_curr;
+#endif /* CONFIG_SPI_STM32_RTIO */
 };
 
 #ifdef CONFIG_SPI_STM32_DMA
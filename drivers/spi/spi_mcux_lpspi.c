@@ -65,6 +65,14 @@ struct spi_mcux_data {
 	/* dummy value used to read RX data into when rx buf is null */
 	uint32_t dummy_rx_buffer;
 #endif
+#ifdef CONFIG_SPI_MCUX_LPSPI_RTIO
+	struct k_spinlock lock;
+	struct rtio_mpsc iodev_sq;
+	struct rtio_iodev_sqe *txn_head;
+	/* DMA lists of the transaction in progress, one block per submission */
+	struct dma_block_config rtio_tx_blks[CONFIG_SPI_MCUX_LPSPI_RTIO_DMA_BLOCKS];
+	struct dma_block_config rtio_rx_blks[CONFIG_SPI_MCUX_LPSPI_RTIO_DMA_BLOCKS];
+#endif
 };
 
 static void spi_mcux_transfer_next_packet(const struct device *dev)
@@ -249,6 +257,12 @@ static int spi_mcux_configure(const struct device *dev,
 
 #ifdef CONFIG_SPI_MCUX_LPSPI_DMA
 
+#ifdef CONFIG_SPI_MCUX_LPSPI_RTIO
+static void spi_mcux_iodev_dma_callback(const struct device *dev,
+					uint32_t channel, int status);
+static void spi_mcux_iodev_next(const struct device *dev);
+#endif
+
 /* This function is executed in the interrupt context */
 static void spi_mcux_dma_callback(const struct device *dev, void *arg,
 			 uint32_t channel, int status)
@@ -257,6 +271,13 @@ static void spi_mcux_dma_callback(const struct device *dev, void *arg,
 	const struct device *spi_dev = arg;
 	struct spi_mcux_data *data = (struct spi_mcux_data *)spi_dev->data;
 
+#ifdef CONFIG_SPI_MCUX_LPSPI_RTIO
+	if (data->txn_head != NULL) {
+		spi_mcux_iodev_dma_callback(spi_dev, channel, status);
+		return;
+	}
+#endif
+
 	if (status < 0) {
 		LOG_ERR("DMA callback error with channel %d.", channel);
 		data->status_flags |= SPI_MCUX_LPSPI_DMA_ERROR_FLAG;
@@ -468,10 +489,261 @@ static int transceive_dma(const struct device *dev,
 
 out:
 	spi_context_release(&data->ctx, ret);
+#ifdef CONFIG_SPI_MCUX_LPSPI_RTIO
+	/* Start the RTIO transactions submitted while the bus was locked */
+	spi_mcux_iodev_next(dev);
+#endif
 
 	return ret;
 }
 
+#ifdef CONFIG_SPI_MCUX_LPSPI_RTIO
+
+/* Fill the DMA blocks of a submission, returns its length */
+static int spi_mcux_iodev_blocks(const struct device *dev,
+				 const struct rtio_sqe *sqe,
+				 struct dma_block_config *tx_blk,
+				 struct dma_block_config *rx_blk)
+{
+	const struct spi_mcux_config *cfg = dev->config;
+	struct spi_mcux_data *data = dev->data;
+	const uint8_t *tx_buf = NULL;
+	uint8_t *rx_buf = NULL;
+	size_t len;
+
+	switch (sqe->op) {
+	case RTIO_OP_RX:
+		rx_buf = sqe->buf;
+		len = sqe->buf_len;
+		break;
+	case RTIO_OP_TX:
+		tx_buf = sqe->buf;
+		len = sqe->buf_len;
+		break;
+	case RTIO_OP_TINY_TX:
+		tx_buf = sqe->tiny_buf;
+		len = sqe->tiny_buf_len;
+		break;
+	case RTIO_OP_TXRX:
+		tx_buf = sqe->tx_buf;
+		rx_buf = sqe->rx_buf;
+		len = sqe->txrx_buf_len;
+		break;
+	default:
+		LOG_ERR("Invalid op code %d for submission %p", sqe->op, (void *)sqe);
+		return -EINVAL;
+	}
+
+	memset(tx_blk, 0, sizeof(struct dma_block_config));
+	tx_blk->source_gather_en = 1;
+	tx_blk->block_size = len;
+	if (tx_buf == NULL) {
+		/* Send NOPs from the dummy buffer, which is not incremented */
+		tx_blk->source_address = (uint32_t)&data->dummy_tx_buffer;
+		tx_blk->source_addr_adj = DMA_ADDR_ADJ_NO_CHANGE;
+	} else {
+		tx_blk->source_address = (uint32_t)tx_buf;
+	}
+	tx_blk->dest_address = LPSPI_GetTxRegisterAddress(cfg->base);
+	tx_blk->dest_addr_adj = DMA_ADDR_ADJ_NO_CHANGE;
+
+	memset(rx_blk, 0, sizeof(struct dma_block_config));
+	rx_blk->dest_scatter_en = 1;
+	rx_blk->block_size = len;
+	if (rx_buf == NULL) {
+		rx_blk->dest_address = (uint32_t)&data->dummy_rx_buffer;
+		rx_blk->dest_addr_adj = DMA_ADDR_ADJ_NO_CHANGE;
+	} else {
+		rx_blk->dest_address = (uint32_t)rx_buf;
+	}
+	rx_blk->source_address = LPSPI_GetRxRegisterAddress(cfg->base);
+	rx_blk->source_addr_adj = DMA_ADDR_ADJ_NO_CHANGE;
+
+	return len;
+}
+
+static void spi_mcux_iodev_complete(const struct device *dev, int status)
+{
+	const struct spi_mcux_config *cfg = dev->config;
+	struct spi_mcux_data *data = dev->data;
+	struct rtio_iodev_sqe *txn_head = data->txn_head;
+	LPSPI_Type *base = cfg->base;
+	k_spinlock_key_t key;
+
+	if (status == 0) {
+		while ((LPSPI_GetStatusFlags(base) & kLPSPI_ModuleBusyFlag)) {
+			/* wait until module is idle */
+		}
+	} else {
+		dma_stop(data->dma_tx.dma_dev, data->dma_tx.channel);
+		dma_stop(data->dma_rx.dma_dev, data->dma_rx.channel);
+	}
+
+	LPSPI_DisableDMA(base, kLPSPI_TxDmaEnable | kLPSPI_RxDmaEnable);
+	spi_context_cs_control(&data->ctx, false);
+
+	key = k_spin_lock(&data->lock);
+	data->txn_head = NULL;
+	k_sem_give(&data->ctx.lock);
+	k_spin_unlock(&data->lock, key);
+
+	spi_mcux_iodev_next(dev);
+
+	if (status != 0) {
+		rtio_iodev_sqe_err(txn_head, status);
+	} else {
+		rtio_iodev_sqe_ok(txn_head, 0);
+	}
+}
+
+/* This function is executed in the interrupt context */
+static void spi_mcux_iodev_dma_callback(const struct device *dev,
+					uint32_t channel, int status)
+{
+	struct spi_mcux_data *data = dev->data;
+
+	if (status < 0) {
+		LOG_ERR("DMA callback error with channel %d.", channel);
+		if (!(data->status_flags & SPI_MCUX_LPSPI_DMA_ERROR_FLAG)) {
+			data->status_flags |= SPI_MCUX_LPSPI_DMA_ERROR_FLAG;
+			spi_mcux_iodev_complete(dev, -EIO);
+		}
+		return;
+	}
+
+	/*
+	 * Only the end of the RX list matters: the last frame is received
+	 * after it was sent.
+	 */
+	if (status != DMA_STATUS_BLOCK && channel == data->dma_rx.channel) {
+		spi_mcux_iodev_complete(dev, 0);
+	}
+}
+
+/* Load the whole transaction in the DMA lists and start it */
+static void spi_mcux_iodev_start(const struct device *dev)
+{
+	const struct spi_mcux_config *cfg = dev->config;
+	struct spi_mcux_data *data = dev->data;
+	struct rtio_iodev_sqe *txn_curr = data->txn_head;
+	struct spi_dt_spec *spi_dt_spec = txn_curr->sqe.iodev->data;
+	struct dma_config tx_cfg = data->dma_tx.dma_cfg;
+	struct dma_config rx_cfg = data->dma_rx.dma_cfg;
+	LPSPI_Type *base = cfg->base;
+	size_t count = 0;
+	int ret;
+
+	ret = spi_mcux_configure(dev, &spi_dt_spec->config);
+
+	for (; ret == 0 && txn_curr != NULL; txn_curr = rtio_txn_next(txn_curr)) {
+		if (count == CONFIG_SPI_MCUX_LPSPI_RTIO_DMA_BLOCKS) {
+			LOG_ERR("Transaction longer than %d submissions",
+				CONFIG_SPI_MCUX_LPSPI_RTIO_DMA_BLOCKS);
+			ret = -ENOMEM;
+			break;
+		}
+
+		ret = spi_mcux_iodev_blocks(dev, &txn_curr->sqe,
+					    &data->rtio_tx_blks[count],
+					    &data->rtio_rx_blks[count]);
+		if (ret > 0) {
+			if (count > 0) {
+				data->rtio_tx_blks[count - 1].next_block =
+					&data->rtio_tx_blks[count];
+				data->rtio_rx_blks[count - 1].next_block =
+					&data->rtio_rx_blks[count];
+			}
+			count++;
+		}
+		ret = MIN(ret, 0);
+	}
+
+	if (ret == 0 && count == 0) {
+		/* Nothing to transfer */
+		spi_mcux_iodev_complete(dev, 0);
+		return;
+	}
+
+	data->status_flags = 0U;
+
+	tx_cfg.channel_direction = MEMORY_TO_PERIPHERAL;
+	tx_cfg.source_burst_length = 1;
+	tx_cfg.head_block = &data->rtio_tx_blks[0];
+	tx_cfg.block_count = count;
+	tx_cfg.user_data = (struct device *)dev;
+
+	rx_cfg.channel_direction = PERIPHERAL_TO_MEMORY;
+	rx_cfg.source_burst_length = 1;
+	rx_cfg.head_block = &data->rtio_rx_blks[0];
+	rx_cfg.block_count = count;
+	rx_cfg.user_data = (struct device *)dev;
+
+	if (ret == 0) {
+		ret = dma_config(data->dma_tx.dma_dev, data->dma_tx.channel, &tx_cfg);
+	}
+	if (ret == 0) {
+		ret = dma_config(data->dma_rx.dma_dev, data->dma_rx.channel, &rx_cfg);
+	}
+	if (ret != 0) {
+		spi_mcux_iodev_complete(dev, ret);
+		return;
+	}
+
+	/* DMA is fast enough watermarks are not required */
+	LPSPI_SetFifoWatermarks(base, 0U, 0U);
+
+	spi_context_cs_control(&data->ctx, true);
+
+	ret = dma_start(data->dma_tx.dma_dev, data->dma_tx.channel);
+	if (ret == 0) {
+		ret = dma_start(data->dma_rx.dma_dev, data->dma_rx.channel);
+	}
+	if (ret != 0) {
+		spi_mcux_iodev_complete(dev, ret);
+		return;
+	}
+
+	LPSPI_EnableDMA(base, kLPSPI_TxDmaEnable | kLPSPI_RxDmaEnable);
+}
+
+static void spi_mcux_iodev_next(const struct device *dev)
+{
+	struct spi_mcux_data *data = dev->data;
+	struct rtio_mpsc_node *next;
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&data->lock);
+
+	/* The bus is in use by a transaction or a blocking call */
+	if (data->txn_head != NULL || k_sem_take(&data->ctx.lock, K_NO_WAIT) != 0) {
+		k_spin_unlock(&data->lock, key);
+		return;
+	}
+
+	next = rtio_mpsc_pop(&data->iodev_sq);
+	if (next == NULL) {
+		k_sem_give(&data->ctx.lock);
+		k_spin_unlock(&data->lock, key);
+		return;
+	}
+
+	data->txn_head = CONTAINER_OF(next, struct rtio_iodev_sqe, q);
+
+	k_spin_unlock(&data->lock, key);
+
+	spi_mcux_iodev_start(dev);
+}
+
+static void spi_mcux_iodev_submit(const struct device *dev,
+				  struct rtio_iodev_sqe *iodev_sqe)
+{
+	struct spi_mcux_data *data = dev->data;
+
+	rtio_mpsc_push(&data->iodev_sq, &iodev_sqe->q);
+	spi_mcux_iodev_next(dev);
+}
+#endif /* CONFIG_SPI_MCUX_LPSPI_RTIO */
+
 #else
 
 static int transceive(const struct device *dev,
@@ -537,6 +809,9 @@ static int spi_mcux_release(const struct device *dev,
 	struct spi_mcux_data *data = dev->data;
 
 	spi_context_unlock_unconditionally(&data->ctx);
+#ifdef CONFIG_SPI_MCUX_LPSPI_RTIO
+	spi_mcux_iodev_next(dev);
+#endif
 
 	return 0;
 }
@@ -558,6 +833,10 @@ static int spi_mcux_init(const struct device *dev)
 
 	data->dev = dev;
 
+#ifdef CONFIG_SPI_MCUX_LPSPI_RTIO
+	rtio_mpsc_init(&data->iodev_sq);
+#endif
+
 #ifdef CONFIG_SPI_MCUX_LPSPI_DMA
 	if (!device_is_ready(data->dma_tx.dma_dev)) {
 		LOG_ERR("%s device is not ready", data->dma_tx.dma_dev->name);
@@ -584,6 +863,9 @@ static const struct spi_driver_api spi_mcux_driver_api = {
 	.transceive = spi_mcux_transceive,
 #ifdef CONFIG_SPI_ASYNC
 	.transceive_async = spi_mcux_transceive_async,
+#endif
+#ifdef CONFIG_SPI_MCUX_LPSPI_RTIO
+	.iodev_submit = spi_mcux_iodev_submit,
 #endif
 	.release = spi_mcux_release,
 };
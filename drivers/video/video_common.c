@@ -4,21 +4,34 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 #include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
 
 #include <zephyr/drivers/video.h>
 
+#if defined(CONFIG_VIDEO_BUFFER_NET_BUF)
+#include <zephyr/net/buf.h>
+#endif
+
+/* Each buffer may lose up to the alignment in front of its data */
 K_HEAP_DEFINE(video_buffer_pool,
-	      CONFIG_VIDEO_BUFFER_POOL_SZ_MAX *
+	      (CONFIG_VIDEO_BUFFER_POOL_SZ_MAX + CONFIG_VIDEO_BUFFER_POOL_ALIGN) *
 	      CONFIG_VIDEO_BUFFER_POOL_NUM_MAX);
 
 static struct video_buffer video_buf[CONFIG_VIDEO_BUFFER_POOL_NUM_MAX];
 
 struct mem_block {
 	void *data;
+	/* Number of references to the buffer, 0 when free */
+	atomic_t refcount;
 };
 
 static struct mem_block video_block[CONFIG_VIDEO_BUFFER_POOL_NUM_MAX];
 
+static struct mem_block *vbuf_to_block(struct video_buffer *vbuf)
+{
+	return &video_block[vbuf - video_buf];
+}
+
 struct video_buffer *video_buffer_alloc(size_t size)
 {
 	struct video_buffer *vbuf = NULL;
@@ -27,7 +40,7 @@ struct video_buffer *video_buffer_alloc(size_t size)
 
 	/* find available video buffer */
 	for (i = 0; i < ARRAY_SIZE(video_buf); i++) {
-		if (video_buf[i].buffer == NULL) {
+		if (atomic_cas(&video_block[i].refcount, 0, 1)) {
 			vbuf = &video_buf[i];
 			block = &video_block[i];
 			break;
@@ -39,8 +52,11 @@ struct video_buffer *video_buffer_alloc(size_t size)
 	}
 
 	/* Alloc buffer memory */
-	block->data = k_heap_alloc(&video_buffer_pool, size, K_FOREVER);
+	block->data = k_heap_aligned_alloc(&video_buffer_pool,
+					   CONFIG_VIDEO_BUFFER_POOL_ALIGN,
+					   size, K_FOREVER);
 	if (block->data == NULL) {
+		atomic_clear(&block->refcount);
 		return NULL;
 	}
 
@@ -51,21 +67,58 @@ struct video_buffer *video_buffer_alloc(size_t size)
 	return vbuf;
 }
 
+struct video_buffer *video_buffer_ref(struct video_buffer *vbuf)
+{
+	(void)atomic_inc(&vbuf_to_block(vbuf)->refcount);
+
+	return vbuf;
+}
+
 void video_buffer_release(struct video_buffer *vbuf)
 {
-	struct mem_block *block = NULL;
-	int i;
+	struct mem_block *block = vbuf_to_block(vbuf);
+	atomic_val_t refcount;
 
-	/* vbuf to block */
-	for (i = 0; i < ARRAY_SIZE(video_block); i++) {
-		if (video_block[i].data == vbuf->buffer) {
-			block = &video_block[i];
-			break;
-		}
+	do {
+		refcount = atomic_get(&block->refcount);
+	} while (refcount > 1 && !atomic_cas(&block->refcount, refcount, refcount - 1));
+
+	if (refcount > 1) {
+		return;
 	}
 
+	/* Last reference, the buffer is freed before it can be allocated again */
 	vbuf->buffer = NULL;
-	if (block) {
-		k_heap_free(&video_buffer_pool, block->data);
+	k_heap_free(&video_buffer_pool, block->data);
+	block->data = NULL;
+	atomic_clear(&block->refcount);
+}
+
+#if defined(CONFIG_VIDEO_BUFFER_NET_BUF)
+static void video_net_buf_destroy(struct net_buf *buf)
+{
+	struct video_buffer *vbuf = *(struct video_buffer **)net_buf_user_data(buf);
+
+	net_buf_destroy(buf);
+	video_buffer_release(vbuf);
+}
+
+NET_BUF_POOL_DEFINE(video_net_buf_pool, CONFIG_VIDEO_BUFFER_NET_BUF_COUNT, 0,
+		    sizeof(struct video_buffer *), video_net_buf_destroy);
+
+struct net_buf *video_buffer_net_buf(struct video_buffer *vbuf,
+				     k_timeout_t timeout)
+{
+	struct net_buf *buf;
+
+	buf = net_buf_alloc_with_data(&video_net_buf_pool, vbuf->buffer,
+				      vbuf->bytesused, timeout);
+	if (buf == NULL) {
+		return NULL;
 	}
+
+	*(struct video_buffer **)net_buf_user_data(buf) = video_buffer_ref(vbuf);
+
+	return buf;
 }
+#endif /* CONFIG_VIDEO_BUFFER_NET_BUF */
@@ -68,7 +68,9 @@ typedef struct z_riscv_fp_context z_riscv_fp_context_t;
 struct _thread_arch {
 #ifdef CONFIG_FPU_SHARING
 	struct z_riscv_fp_context saved_fp_context;
+#ifndef CONFIG_FPU_LAZY_SWITCH_HISTORY
 	bool fpu_recently_used;
+#endif
 	uint8_t exception_depth;
 #endif
 #ifdef CONFIG_USERSPACE
@@ -0,0 +1,271 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Audio processing graph
+ */
+
+#ifndef ZEPHYR_INCLUDE_AUDIO_GRAPH_H_
+#define ZEPHYR_INCLUDE_AUDIO_GRAPH_H_
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/slist.h>
+#include <zephyr/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Audio processing graph
+ * @defgroup audio_graph Audio processing graph
+ * @ingroup audio_interface
+ *
+ * The blocks of audio received from I2S or DMIC are pushed to the nodes of a
+ * graph, which process them one block at a time and pass them to the next
+ * node without copying: the blocks are the ones of the memory slab of the
+ * graph, given to the drivers.
+ *
+ * All the nodes are run from a single thread, the node run first being the
+ * one holding the block of earliest deadline, set when the block is pushed to
+ * the graph.
+ *
+ * @{
+ */
+
+struct audio_graph;
+struct audio_node;
+
+/**
+ * @brief Process blocks of audio.
+ *
+ * The node is given a block on each of its inputs, and processes them into the
+ * block of its first input, or into another block of the slab of the graph
+ * replacing it, which is passed to the next node. The node may also set the
+ * first block to NULL once it took ownership of it, such as a sink writing it
+ * to an I2S device.
+ *
+ * The blocks of the other inputs, if not set to NULL, are freed.
+ *
+ * @param node The node.
+ * @param blocks The blocks of the inputs of the node.
+ *
+ * @retval 0 On success.
+ * @retval -errno On failure, the blocks are freed.
+ */
+typedef int (*audio_node_process_t)(struct audio_node *node, void **blocks);
+
+/** @brief Block queued to a node */
+struct audio_graph_block {
+	void *data;
+	/* Cycles at which the block was pushed to the graph */
+	uint32_t timestamp;
+	/* Cycles by which the block should have gone through the graph */
+	uint32_t deadline;
+};
+
+/** @brief Statistics of a node */
+struct audio_node_stats {
+	/** Blocks processed */
+	uint32_t blocks;
+	/** Blocks dropped, not processed or not accepted by the next node */
+	uint32_t dropped;
+	/** Processing failures */
+	uint32_t errors;
+	/** Time spent processing the blocks */
+	uint64_t busy_ns;
+	/** Longest time spent processing a block */
+	uint32_t max_ns;
+};
+
+/**
+ * @brief Node of an audio graph
+ *
+ * The fields are internal to the graph, see audio_node_init().
+ */
+struct audio_node {
+	sys_snode_t node;
+	const char *name;
+	audio_node_process_t process;
+	void *user_data;
+	struct audio_graph *graph;
+	struct audio_node *next;
+	uint8_t next_port;
+	uint8_t n_inputs;
+	/* Blocks queued on each input */
+	struct audio_graph_block queue[CONFIG_AUDIO_GRAPH_MAX_INPUTS]
+				      [CONFIG_AUDIO_GRAPH_QUEUE_DEPTH];
+	uint8_t head[CONFIG_AUDIO_GRAPH_MAX_INPUTS];
+	uint8_t count[CONFIG_AUDIO_GRAPH_MAX_INPUTS];
+	struct audio_node_stats stats;
+};
+
+/** @brief Statistics of a graph */
+struct audio_graph_stats {
+	/** Blocks which went through the graph */
+	uint32_t blocks;
+	/** Blocks which went through the graph after their deadline */
+	uint32_t late;
+	/** Time from the push of the blocks to the end of the graph */
+	uint64_t latency_ns;
+	uint32_t min_latency_ns;
+	uint32_t max_latency_ns;
+	/** Uptime at which the statistics were reset */
+	int64_t start_ticks;
+};
+
+/**
+ * @brief Audio graph
+ *
+ * The fields are internal to the graph, see audio_graph_init().
+ */
+struct audio_graph {
+	sys_snode_t node;
+	struct k_mem_slab *slab;
+	uint32_t deadline_cycles;
+	sys_slist_t nodes;
+	struct audio_graph_stats stats;
+};
+
+/**
+ * @brief Initialize an audio graph.
+ *
+ * @param graph The graph.
+ * @param slab Memory slab of the blocks of audio, the one given to the drivers.
+ * @param deadline_us Time allowed for a block to go through the graph.
+ */
+void audio_graph_init(struct audio_graph *graph, struct k_mem_slab *slab,
+		      uint32_t deadline_us);
+
+/**
+ * @brief Initialize a node.
+ *
+ * @param node The node.
+ * @param name Name of the node, in the reports.
+ * @param process Function processing the blocks.
+ * @param n_inputs Number of inputs, at most
+ *                 :kconfig:option:`CONFIG_AUDIO_GRAPH_MAX_INPUTS`.
+ * @param user_data User data of the node.
+ */
+void audio_node_init(struct audio_node *node, const char *name,
+		     audio_node_process_t process, uint8_t n_inputs,
+		     void *user_data);
+
+/**
+ * @brief Add a node to a graph.
+ *
+ * The nodes are added before the graph is started.
+ *
+ * @param graph The graph.
+ * @param node The node, initialized.
+ */
+void audio_graph_add(struct audio_graph *graph, struct audio_node *node);
+
+/**
+ * @brief Connect the output of a node to the input of another one.
+ *
+ * A node without a next one is a sink, the blocks it outputs are freed.
+ *
+ * @param src The node producing the blocks.
+ * @param dst The node consuming them, in the same graph.
+ * @param port Input of @p dst.
+ *
+ * @retval 0 On success.
+ * @retval -EINVAL If the input or the graph is not valid.
+ */
+int audio_graph_connect(struct audio_node *src, struct audio_node *dst,
+			uint8_t port);
+
+/**
+ * @brief Start running the nodes of a graph.
+ *
+ * @param graph The graph.
+ */
+void audio_graph_start(struct audio_graph *graph);
+
+/**
+ * @brief Stop running the nodes of a graph.
+ *
+ * The blocks queued to the nodes are freed. The graph should no longer be
+ * pushed blocks.
+ *
+ * @param graph The graph.
+ */
+void audio_graph_stop(struct audio_graph *graph);
+
+/**
+ * @brief Push a block to an input of a node.
+ *
+ * Can be called from any context, such as the thread reading the blocks from
+ * an I2S or DMIC device. The graph owns the block on success.
+ *
+ * @param node The node.
+ * @param port Input of the node.
+ * @param block Block of the slab of the graph.
+ *
+ * @retval 0 On success.
+ * @retval -EINVAL If the input is not valid.
+ * @retval -ENOBUFS If the queue of the input is full.
+ */
+int audio_graph_push(struct audio_node *node, uint8_t port, void *block);
+
+/**
+ * @brief Get a block of the slab of a graph.
+ *
+ * @param node The node processing the blocks.
+ *
+ * @return The block, NULL if none is free.
+ */
+void *audio_node_block_alloc(struct audio_node *node);
+
+/**
+ * @brief Free a block of the slab of a graph.
+ *
+ * @param node The node processing the blocks.
+ * @param block The block.
+ */
+void audio_node_block_free(struct audio_node *node, void *block);
+
+/**
+ * @brief Get the size of the blocks of a graph.
+ *
+ * @param node A node of the graph.
+ *
+ * @return The size of the blocks, in bytes.
+ */
+static inline size_t audio_node_block_size(const struct audio_node *node)
+{
+	return node->graph->slab->block_size;
+}
+
+/**
+ * @brief Reset the statistics of a graph and its nodes.
+ *
+ * @param graph The graph.
+ */
+void audio_graph_stats_reset(struct audio_graph *graph);
+
+/**
+ * @brief Log the statistics of a graph and its nodes.
+ *
+ * The load of a node is the share of the time since the reset of the
+ * statistics spent processing blocks, and the latency the time from the push
+ * of a block to the end of the graph.
+ *
+ * @param graph The graph.
+ */
+void audio_graph_stats_report(struct audio_graph *graph);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_AUDIO_GRAPH_H_ */
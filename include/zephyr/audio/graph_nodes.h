@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Nodes of audio processing graphs
+ */
+
+#ifndef ZEPHYR_INCLUDE_AUDIO_GRAPH_NODES_H_
+#define ZEPHYR_INCLUDE_AUDIO_GRAPH_NODES_H_
+
+#include <zephyr/audio/graph.h>
+#include <zephyr/dsp/dsp.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @addtogroup audio_graph
+ *
+ * The nodes below process blocks of Q15 samples, using the DSP subsystem.
+ *
+ * @{
+ */
+
+/** @brief Node scaling the samples, in place */
+struct audio_node_gain {
+	struct audio_node node;
+	q15_t scale_fract;
+	int8_t shift;
+};
+
+/**
+ * @brief Initialize a gain node.
+ *
+ * The samples are multiplied by @p scale_fract then shifted by @p shift bits,
+ * with saturation, see zdsp_scale_q15().
+ *
+ * @param gain The node.
+ * @param name Name of the node.
+ * @param scale_fract Fractional part of the gain.
+ * @param shift Number of bits to shift the samples by.
+ */
+void audio_node_gain_init(struct audio_node_gain *gain, const char *name,
+			  q15_t scale_fract, int8_t shift);
+
+/**
+ * @brief Initialize a mixer node.
+ *
+ * The node has two inputs, of which the samples are added with saturation
+ * into the block of the first one, see zdsp_add_q15().
+ *
+ * @param mixer The node.
+ * @param name Name of the node.
+ */
+void audio_node_mixer_init(struct audio_node *mixer, const char *name);
+
+#if defined(CONFIG_AUDIO_GRAPH_BIQUAD) || defined(__DOXYGEN__)
+
+/** @brief Node filtering a single channel through a cascade of biquads */
+struct audio_node_biquad {
+	struct audio_node node;
+	arm_biquad_casd_df1_inst_q15 inst;
+	q15_t state[4 * CONFIG_AUDIO_GRAPH_BIQUAD_MAX_STAGES];
+};
+
+/**
+ * @brief Initialize a biquad node.
+ *
+ * The blocks are filtered in place with the CMSIS-DSP biquad cascade of
+ * direct form I, see arm_biquad_cascade_df1_init_q15() for the layout of
+ * @p coeffs, which must stay valid while the node is in use.
+ *
+ * @param biquad The node.
+ * @param name Name of the node.
+ * @param n_stages Number of second order stages.
+ * @param coeffs Coefficients, 6 per stage.
+ * @param post_shift Shift of the accumulator to the Q15 samples.
+ *
+ * @retval 0 On success.
+ * @retval -EINVAL If there are too many stages.
+ */
+int audio_node_biquad_init(struct audio_node_biquad *biquad, const char *name,
+			   uint8_t n_stages, const q15_t *coeffs, int8_t post_shift);
+
+#endif /* CONFIG_AUDIO_GRAPH_BIQUAD */
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_AUDIO_GRAPH_NODES_H_ */
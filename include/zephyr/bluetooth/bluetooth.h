@@ -2200,6 +2200,99 @@ void bt_le_scan_cb_register(struct bt_le_scan_cb *cb);
  */
 void bt_le_scan_cb_unregister(struct bt_le_scan_cb *cb);
 
+/** Host-side scan filter options. */
+enum {
+	/** Match any report. */
+	BT_LE_SCAN_FILTER_OPT_NONE = 0,
+
+	/** Match the advertiser address in @ref bt_le_scan_filter.addr. */
+	BT_LE_SCAN_FILTER_OPT_ADDR = BIT(0),
+
+	/** Match reports with an RSSI of at least @ref bt_le_scan_filter.rssi. */
+	BT_LE_SCAN_FILTER_OPT_RSSI = BIT(1),
+
+	/**
+	 * @brief Match reports containing the AD type in
+	 *        @ref bt_le_scan_filter.ad_type.
+	 */
+	BT_LE_SCAN_FILTER_OPT_AD_TYPE = BIT(2),
+};
+
+/**
+ * @brief Host-side scan filter.
+ *
+ * A report matches the filter when it satisfies all the rules enabled in
+ * @ref bt_le_scan_filter.options.
+ */
+struct bt_le_scan_filter {
+	/** Bit-field of BT_LE_SCAN_FILTER_OPT_* rules to apply. */
+	uint8_t options;
+
+	/**
+	 * @brief Address to match.
+	 *
+	 * Matched against both the address in the report and the identity
+	 * address it resolves to.
+	 */
+	bt_addr_le_t addr;
+
+	/** Lowest accepted RSSI in dBm. */
+	int8_t rssi;
+
+	/** AD type that must be present in the advertising data. */
+	uint8_t ad_type;
+
+	/** Number of reports that matched the filter. */
+	uint32_t matched;
+
+	sys_snode_t node;
+};
+
+/** Host-side scan filter statistics. */
+struct bt_le_scan_filter_stats {
+	/** Number of advertising reports received from the controller. */
+	uint32_t received;
+
+	/** Number of reports dropped because no filter matched. */
+	uint32_t filtered;
+
+	/** Number of reports dropped as duplicates. */
+	uint32_t duplicates;
+};
+
+/**
+ * @brief Register a host-side scan filter.
+ *
+ * Once at least one filter is registered, advertising reports are only
+ * delivered to @ref bt_le_scan_cb listeners and to the callback given to
+ * @ref bt_le_scan_start if they match any of the registered filters. The
+ * filters are evaluated before the listeners are invoked, and do not
+ * affect connection establishment.
+ *
+ * @note Requires @kconfig{CONFIG_BT_SCAN_FILTER}.
+ *
+ * @param filter Filter. Must point to memory that remains valid.
+ *
+ * @return Zero on success, -EALREADY if the filter is already registered.
+ */
+int bt_le_scan_filter_register(struct bt_le_scan_filter *filter);
+
+/**
+ * @brief Unregister a host-side scan filter.
+ *
+ * @param filter Filter registered with @ref bt_le_scan_filter_register.
+ */
+void bt_le_scan_filter_unregister(struct bt_le_scan_filter *filter);
+
+/**
+ * @brief Get host-side scan filter statistics.
+ *
+ * @note Requires @kconfig{CONFIG_BT_SCAN_FILTER}.
+ *
+ * @param stats Statistics to fill.
+ */
+void bt_le_scan_filter_stats_get(struct bt_le_scan_filter_stats *stats);
+
 /**
  * @brief Add device (LE) to filter accept list.
  *
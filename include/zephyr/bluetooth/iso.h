@@ -982,6 +982,59 @@ struct bt_iso_info {
 int bt_iso_chan_get_info(const struct bt_iso_chan *chan,
 			 struct bt_iso_info *info);
 
+/** @brief ISO channel statistics
+ *
+ *  Jitter values are estimated as in RFC 3550, relative to the ISO interval
+ *  for transmitted SDUs and to the SDU timestamps for received SDUs.
+ */
+struct bt_iso_chan_stats {
+	/** Number of SDUs queued with bt_iso_chan_send() */
+	uint32_t tx_sdus;
+
+	/** Number of SDUs reported as completed by the controller */
+	uint32_t tx_completed;
+
+	/** Number of SDUs queued more than one ISO interval after their
+	 *  nominal slot
+	 */
+	uint32_t tx_late;
+
+	/** Latency in us from queuing to completion of the last SDU */
+	uint32_t tx_latency_us;
+
+	/** Maximum latency in us from queuing to completion of an SDU */
+	uint32_t tx_latency_max_us;
+
+	/** Jitter in us of the SDU queuing times */
+	uint32_t tx_jitter_us;
+
+	/** Number of SDUs received */
+	uint32_t rx_sdus;
+
+	/** Number of received SDUs flagged as lost */
+	uint32_t rx_lost;
+
+	/** Number of received SDUs flagged as containing errors */
+	uint32_t rx_errors;
+
+	/** Jitter in us of the SDU reception times */
+	uint32_t rx_jitter_us;
+};
+
+/** @brief Get ISO channel statistics
+ *
+ *  The statistics are reset when the channel is connected.
+ *
+ *  Only available when @kconfig{CONFIG_BT_ISO_STATS} is enabled.
+ *
+ *  @param chan  Channel object.
+ *  @param stats Channel statistics object.
+ *
+ *  @return Zero on success or (negative) error code on failure.
+ */
+int bt_iso_chan_get_stats(const struct bt_iso_chan *chan,
+			  struct bt_iso_chan_stats *stats);
+
 /** @brief Get ISO transmission timing info
  *
  *  @details Reads timing information for transmitted ISO packet on an ISO channel.
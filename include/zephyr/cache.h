@@ -43,6 +43,19 @@ extern "C" {
 
 /** @endcond */
 
+/**
+ * @brief Address range of a list of ranges to maintain in the cache
+ *
+ * A list of ranges describes for instance the fragments of a buffer handed to
+ * a DMA controller, see sys_cache_data_flush_ranges().
+ */
+struct sys_cache_range {
+	/** Starting address of the range */
+	void *addr;
+	/** Range size */
+	size_t size;
+};
+
 /**
  * @brief Enable the d-cache
  *
@@ -387,6 +400,132 @@ static ALWAYS_INLINE int sys_cache_instr_flush_and_invd_range(void *addr, size_t
 	return -ENOTSUP;
 }
 
+/**
+ * @brief Flush a list of address ranges in the d-cache
+ *
+ * Flush the specified address ranges of the data cache, as
+ * sys_cache_data_flush_range() does for each range, but waiting for the
+ * completion of the operations only once for the whole list when the
+ * architecture supports it. This is intended for buffers made of several
+ * fragments, like net_buf chains, which are handed to a DMA controller.
+ *
+ * @note This function is not a system call.
+ *
+ * @param ranges Address ranges to flush.
+ * @param count Number of ranges.
+ *
+ * @retval 0 If succeeded.
+ * @retval -ENOTSUP If not supported.
+ * @retval -errno Negative errno for other failures.
+ */
+static ALWAYS_INLINE int sys_cache_data_flush_ranges(const struct sys_cache_range *ranges,
+						     size_t count)
+{
+#if defined(CONFIG_CACHE_MANAGEMENT) && defined(CONFIG_DCACHE)
+#if defined(CONFIG_ARCH_CACHE) && defined(CONFIG_ARCH_HAS_DCACHE_RANGES)
+	return cache_data_flush_ranges(ranges, count);
+#else
+	for (size_t i = 0; i < count; i++) {
+		int ret = cache_data_flush_range(ranges[i].addr, ranges[i].size);
+
+		if (ret != 0) {
+			return ret;
+		}
+	}
+
+	return 0;
+#endif
+#endif
+	ARG_UNUSED(ranges);
+	ARG_UNUSED(count);
+
+	return -ENOTSUP;
+}
+
+/**
+ * @brief Invalidate a list of address ranges in the d-cache
+ *
+ * Invalidate the specified address ranges of the data cache, as
+ * sys_cache_data_invd_range() does for each range, but waiting for the
+ * completion of the operations only once for the whole list when the
+ * architecture supports it. This is intended for buffers made of several
+ * fragments, like net_buf chains, which are handed to a DMA controller.
+ *
+ * @note This function is not a system call.
+ *
+ * @param ranges Address ranges to invalidate.
+ * @param count Number of ranges.
+ *
+ * @retval 0 If succeeded.
+ * @retval -ENOTSUP If not supported.
+ * @retval -errno Negative errno for other failures.
+ */
+static ALWAYS_INLINE int sys_cache_data_invd_ranges(const struct sys_cache_range *ranges,
+						    size_t count)
+{
+#if defined(CONFIG_CACHE_MANAGEMENT) && defined(CONFIG_DCACHE)
+#if defined(CONFIG_ARCH_CACHE) && defined(CONFIG_ARCH_HAS_DCACHE_RANGES)
+	return cache_data_invd_ranges(ranges, count);
+#else
+	for (size_t i = 0; i < count; i++) {
+		int ret = cache_data_invd_range(ranges[i].addr, ranges[i].size);
+
+		if (ret != 0) {
+			return ret;
+		}
+	}
+
+	return 0;
+#endif
+#endif
+	ARG_UNUSED(ranges);
+	ARG_UNUSED(count);
+
+	return -ENOTSUP;
+}
+
+/**
+ * @brief Flush and Invalidate a list of address ranges in the d-cache
+ *
+ * Flush and Invalidate the specified address ranges of the data cache, as
+ * sys_cache_data_flush_and_invd_range() does for each range, but waiting for the
+ * completion of the operations only once for the whole list when the
+ * architecture supports it. This is intended for buffers made of several
+ * fragments, like net_buf chains, which are handed to a DMA controller.
+ *
+ * @note This function is not a system call.
+ *
+ * @param ranges Address ranges to flush and invalidate.
+ * @param count Number of ranges.
+ *
+ * @retval 0 If succeeded.
+ * @retval -ENOTSUP If not supported.
+ * @retval -errno Negative errno for other failures.
+ */
+static ALWAYS_INLINE int sys_cache_data_flush_and_invd_ranges(const struct sys_cache_range *ranges,
+							      size_t count)
+{
+#if defined(CONFIG_CACHE_MANAGEMENT) && defined(CONFIG_DCACHE)
+#if defined(CONFIG_ARCH_CACHE) && defined(CONFIG_ARCH_HAS_DCACHE_RANGES)
+	return cache_data_flush_and_invd_ranges(ranges, count);
+#else
+	for (size_t i = 0; i < count; i++) {
+		int ret = cache_data_flush_and_invd_range(ranges[i].addr, ranges[i].size);
+
+		if (ret != 0) {
+			return ret;
+		}
+	}
+
+	return 0;
+#endif
+#endif
+	ARG_UNUSED(ranges);
+	ARG_UNUSED(count);
+
+	return -ENOTSUP;
+}
+
 /**
  *
  * @brief Get the the d-cache line size.
@@ -184,6 +184,7 @@ typedef void (*isotp_tx_callback_t)(int error_nr, void *arg);
 
 struct isotp_send_ctx;
 struct isotp_recv_ctx;
+struct isotp_rx_mux;
 
 /**
  * @brief Bind an address to a receiving context.
@@ -222,6 +223,62 @@ int isotp_bind(struct isotp_recv_ctx *ctx, const struct device *can_dev,
  */
 void isotp_unbind(struct isotp_recv_ctx *ctx);
 
+#if defined(CONFIG_ISOTP_RX_MUX) || defined(__DOXYGEN__)
+/**
+ * @brief Initialize a receive multiplexer
+ *
+ * The multiplexer attaches a single filter to the CAN device, and dispatches
+ * the frames it accepts to the contexts bound to it with isotp_bind_mux,
+ * through a hash table of their identifiers. This saves the filters of the
+ * CAN device when receiving from many peers, such as the ECUs answering a
+ * diagnostic tester.
+ *
+ * @param mux     Multiplexer to initialize.
+ * @param can_dev The CAN device to be used for receiving.
+ * @param filter  Filter accepting the frames of all the contexts to be bound.
+ *
+ * @retval ISOTP_N_OK on success
+ * @retval ISOTP_NO_FREE_FILTER if CAN device has no filters left.
+ */
+int isotp_rx_mux_init(struct isotp_rx_mux *mux, const struct device *can_dev,
+		      const struct can_filter *filter);
+
+/**
+ * @brief Detach a receive multiplexer from the CAN device
+ *
+ * The contexts bound to the multiplexer must be unbound first.
+ *
+ * @param mux Multiplexer to detach.
+ */
+void isotp_rx_mux_deinit(struct isotp_rx_mux *mux);
+
+/**
+ * @brief Bind a configuration to a receive multiplexer
+ *
+ * This function is similar to isotp_bind, but the frames are received through
+ * the filter of the multiplexer instead of a filter of the context. The
+ * context is unbound with isotp_unbind.
+ *
+ * @param ctx     Context to store the internal states.
+ * @param mux     Multiplexer receiving the frames.
+ * @param rx_addr Identifier for incoming data, accepted by the filter of the
+ *                multiplexer.
+ * @param tx_addr Identifier for FC frames.
+ * @param opts    Flow control options.
+ * @param timeout Timeout for FF SF buffer allocation.
+ *
+ * @retval ISOTP_N_OK on success
+ * @retval ISOTP_NO_FREE_FILTER if the filter of the multiplexer does not
+ *         accept the identifier for incoming data.
+ * @retval ISOTP_NO_NET_BUF_LEFT if there is no FF SF buffer left.
+ */
+int isotp_bind_mux(struct isotp_recv_ctx *ctx, struct isotp_rx_mux *mux,
+		   const struct isotp_msg_id *rx_addr,
+		   const struct isotp_msg_id *tx_addr,
+		   const struct isotp_fc_opts *opts,
+		   k_timeout_t timeout);
+#endif /* CONFIG_ISOTP_RX_MUX */
+
 /**
  * @brief Read out received data from fifo.
  *
@@ -430,7 +487,21 @@ struct isotp_recv_ctx {
 	uint8_t bs;
 	uint8_t wft;
 	uint8_t sn_expected : 4;
+#ifdef CONFIG_ISOTP_RX_MUX
+	struct isotp_rx_mux *mux;
+	sys_snode_t mux_node;
+#endif
+};
+
+#ifdef CONFIG_ISOTP_RX_MUX
+struct isotp_rx_mux {
+	int filter_id;
+	const struct device *can_dev;
+	struct can_filter filter;
+	struct k_spinlock lock;
+	sys_slist_t buckets[CONFIG_ISOTP_RX_MUX_BUCKETS];
 };
+#endif
 
 /** @endcond */
 
@@ -0,0 +1,220 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Crypto request queue and session cache APIs
+ *
+ * [Experimental] Users should note that the APIs can change
+ * as a part of ongoing development.
+ */
+
+#ifndef ZEPHYR_INCLUDE_CRYPTO_QUEUE_H_
+#define ZEPHYR_INCLUDE_CRYPTO_QUEUE_H_
+
+#include <zephyr/crypto/crypto.h>
+#include <zephyr/kernel.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Crypto request queue
+ * @defgroup crypto_queue Crypto request queue
+ * @ingroup crypto
+ *
+ * Requests are run one after the other by a dedicated thread, using the
+ * synchronous API of the driver the session belongs to, so that callers
+ * (e.g. the network stack) keep going while the operation is carried out.
+ * @{
+ */
+
+/** Type of a queued crypto request */
+enum crypto_req_type {
+	CRYPTO_REQ_CBC,
+	CRYPTO_REQ_CTR,
+	CRYPTO_REQ_CCM,
+	CRYPTO_REQ_GCM,
+	CRYPTO_REQ_HASH,
+};
+
+struct crypto_req;
+
+/**
+ * @brief Crypto request completion callback.
+ *
+ * Invoked from the queue thread.
+ *
+ * @param req Completed request.
+ * @param status Result of the operation.
+ */
+typedef void (*crypto_req_cb_t)(struct crypto_req *req, int status);
+
+/** Queued crypto request */
+struct crypto_req {
+	/** @cond INTERNAL_HIDDEN */
+	struct k_work work;
+	/** @endcond */
+
+	/** Request type, selecting the union member below */
+	enum crypto_req_type type;
+
+	union {
+		/** CRYPTO_REQ_CBC, CRYPTO_REQ_CTR */
+		struct {
+			struct cipher_ctx *ctx;
+			struct cipher_pkt *pkt;
+			uint8_t *iv;
+		} cipher;
+
+		/** CRYPTO_REQ_CCM, CRYPTO_REQ_GCM */
+		struct {
+			struct cipher_ctx *ctx;
+			struct cipher_aead_pkt *pkt;
+			uint8_t *nonce;
+		} aead;
+
+		/** CRYPTO_REQ_HASH */
+		struct {
+			struct hash_ctx *ctx;
+			struct hash_pkt *pkt;
+			bool finish;
+		} hash;
+	};
+
+	/** Completion callback */
+	crypto_req_cb_t cb;
+
+	/** Free for the submitter to use */
+	void *user_data;
+};
+
+/**
+ * @brief Queue a crypto request.
+ *
+ * @funcprops \isr_ok
+ *
+ * The session the request refers to must have been begun with
+ * @ref CAP_SYNC_OPS. A request must be zero-initialized before its first
+ * submission; it may be submitted again from its callback.
+ *
+ * @param req Request, which must remain valid until its callback has been
+ * invoked, as well as every buffer it refers to.
+ *
+ * @retval 0 If the request has been queued.
+ * @retval -EBUSY If @p req is already queued.
+ * @retval -EINVAL If the request is malformed or its session not synchronous.
+ */
+int crypto_queue_submit(struct crypto_req *req);
+
+/**
+ * @brief Queue an AEAD (CCM or GCM) cipher operation.
+ *
+ * @param req Request to use.
+ * @param ctx Session, whose mode selects CCM or GCM.
+ * @param pkt AEAD packet.
+ * @param nonce Nonce for the operation.
+ * @param cb Completion callback.
+ * @param user_data Stored in the request for @p cb to use.
+ *
+ * @return See crypto_queue_submit().
+ */
+static inline int crypto_queue_aead_op(struct crypto_req *req,
+				       struct cipher_ctx *ctx,
+				       struct cipher_aead_pkt *pkt,
+				       uint8_t *nonce, crypto_req_cb_t cb,
+				       void *user_data)
+{
+	req->type = (ctx->ops.cipher_mode == CRYPTO_CIPHER_MODE_GCM) ?
+		    CRYPTO_REQ_GCM : CRYPTO_REQ_CCM;
+	req->aead.ctx = ctx;
+	req->aead.pkt = pkt;
+	req->aead.nonce = nonce;
+	req->cb = cb;
+	req->user_data = user_data;
+
+	return crypto_queue_submit(req);
+}
+
+/**
+ * @brief Queue a hash operation.
+ *
+ * @param req Request to use.
+ * @param ctx Hash session.
+ * @param pkt Hash packet.
+ * @param finish True to compute the final hash (hash_compute()), false to
+ * feed more data (hash_update()).
+ * @param cb Completion callback.
+ * @param user_data Stored in the request for @p cb to use.
+ *
+ * @return See crypto_queue_submit().
+ */
+static inline int crypto_queue_hash_op(struct crypto_req *req,
+				       struct hash_ctx *ctx,
+				       struct hash_pkt *pkt, bool finish,
+				       crypto_req_cb_t cb, void *user_data)
+{
+	req->type = CRYPTO_REQ_HASH;
+	req->hash.ctx = ctx;
+	req->hash.pkt = pkt;
+	req->hash.finish = finish;
+	req->cb = cb;
+	req->user_data = user_data;
+
+	return crypto_queue_submit(req);
+}
+
+/**
+ * @brief Obtain a cipher session from the session cache.
+ *
+ * Sessions are looked up by device, algorithm, mode, operation, key and
+ * session parameters. A matching session is reused as is, otherwise the
+ * least recently used idle session is freed and a new one begun in its
+ * place. Sessions used for every packet with the same key (e.g. a TLS
+ * connection) therefore do not reload the key each time.
+ *
+ * @param dev Crypto device.
+ * @param params Session parameters (key, keylen, flags, mode parameters),
+ * as would be given to cipher_begin_session(). The key is copied.
+ * @param algo Cipher algorithm.
+ * @param mode Cipher mode.
+ * @param op Cipher operation.
+ *
+ * @return Session to use, to be released with crypto_session_cache_put(),
+ * NULL if no session could be begun or all sessions are in use.
+ */
+struct cipher_ctx *crypto_session_cache_get(const struct device *dev,
+					    const struct cipher_ctx *params,
+					    enum cipher_algo algo,
+					    enum cipher_mode mode,
+					    enum cipher_op op);
+
+/**
+ * @brief Release a session obtained from the session cache.
+ *
+ * The session is kept alive for later reuse.
+ *
+ * @param ctx Session to release.
+ */
+void crypto_session_cache_put(struct cipher_ctx *ctx);
+
+/**
+ * @brief Free all idle sessions of the session cache.
+ *
+ * Must be called before the keys they use are destroyed.
+ */
+void crypto_session_cache_flush(void);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_CRYPTO_QUEUE_H_ */
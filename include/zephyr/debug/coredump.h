@@ -135,6 +135,20 @@ struct coredump_cmd_copy_arg {
 
 #define	COREDUMP_MEM_HDR_ID		'M'
 #define COREDUMP_MEM_HDR_VER		1
+/* Same header, memory byte stream is run-length encoded */
+#define COREDUMP_MEM_HDR_VER_RLE	2
+
+/*
+ * Run-length encoding of memory byte streams, made of control bytes
+ * each followed by:
+ * - ctrl < COREDUMP_RLE_REPEAT: (ctrl + 1) literal bytes,
+ * - otherwise: one byte, to be repeated
+ *   (ctrl - COREDUMP_RLE_REPEAT + COREDUMP_RLE_RUN_MIN) times.
+ */
+#define COREDUMP_RLE_REPEAT		0x80
+#define COREDUMP_RLE_LITERAL_MAX	COREDUMP_RLE_REPEAT
+#define COREDUMP_RLE_RUN_MIN		3
+#define COREDUMP_RLE_RUN_MAX		(0xff - COREDUMP_RLE_REPEAT + COREDUMP_RLE_RUN_MIN)
 
 /* Target code */
 enum coredump_tgt_code {
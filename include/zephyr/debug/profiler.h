@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_DEBUG_PROFILER_H_
+#define ZEPHYR_INCLUDE_DEBUG_PROFILER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @defgroup profiler Sampling profiler
+ *  @ingroup os_services
+ *  @brief Statistical profiler sampling the interrupted program counter
+ *
+ *  The profiler periodically samples the program counter of the running
+ *  thread, optionally followed by the return addresses of its callers,
+ *  from the system timer interrupt. The samples are stored in a buffer per
+ *  CPU of @kconfig{CONFIG_PROFILER_BUFFER_SIZE} words, each sample being the
+ *  number of addresses followed by the addresses. Sampling stops for a CPU
+ *  when its buffer is full.
+ *
+ *  The samples are symbolized on the host with
+ *  scripts/profiling/profiler_report.py.
+ *  @{
+ */
+
+/** @brief Start sampling
+ *
+ *  Clears the sample buffers and starts sampling.
+ *
+ *  @param frequency Sampling frequency in Hz, at most the system tick rate.
+ *  @param count Number of samples after which sampling stops, 0 to sample
+ *               until profiler_stop() is called.
+ *
+ *  @retval 0 on success.
+ *  @retval -EINVAL if the frequency is 0 or higher than the tick rate.
+ *  @retval -EALREADY if the profiler is already running.
+ */
+int profiler_start(uint32_t frequency, uint32_t count);
+
+/** @brief Stop sampling */
+void profiler_stop(void);
+
+/** @brief Get the samples of a CPU
+ *
+ *  Must only be called while the profiler is stopped.
+ *
+ *  @param cpu CPU index.
+ *  @param samples Set to the sample buffer of the CPU.
+ *
+ *  @return Number of words of the buffer holding samples.
+ */
+size_t profiler_samples_get(uint8_t cpu, const uintptr_t **samples);
+
+/** @brief Get the number of samples dropped because a buffer was full
+ *
+ *  @param cpu CPU index.
+ *
+ *  @return Number of samples dropped since the profiler was started.
+ */
+uint32_t profiler_dropped_get(uint8_t cpu);
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_DEBUG_PROFILER_H_ */
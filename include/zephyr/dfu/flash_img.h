@@ -15,7 +15,9 @@
 #ifndef ZEPHYR_INCLUDE_DFU_FLASH_IMG_H_
 #define ZEPHYR_INCLUDE_DFU_FLASH_IMG_H_
 
+#include <stdbool.h>
 #include <zephyr/storage/stream_flash.h>
+#include <zephyr/sys/util.h>
 
 /**
  * @brief Abstraction layer to write firmware images to flash
@@ -29,10 +31,42 @@
 extern "C" {
 #endif
 
+#ifdef CONFIG_IMG_LZ4
+/** Magic number starting an LZ4 compressed image stream */
+#define FLASH_IMG_LZ4_MAGIC 0x345a4c49
+
+/** Size of the header of an LZ4 compressed image stream */
+#define FLASH_IMG_LZ4_HDR_SIZE 12
+
+/** Flag of the block length word marking a block stored uncompressed */
+#define FLASH_IMG_LZ4_BLOCK_STORED BIT(31)
+
+/** Worst case size of a compressed block, the same as LZ4_COMPRESSBOUND() */
+#define FLASH_IMG_LZ4_BOUND(size) ((size) + ((size) / 255) + 16)
+
+/** LZ4 decompression state of flash_img_lz4_enable(), the fields are internal */
+struct flash_img_lz4 {
+	uint8_t in[FLASH_IMG_LZ4_BOUND(CONFIG_IMG_LZ4_BLOCK_SIZE)];
+	uint8_t out[CONFIG_IMG_LZ4_BLOCK_SIZE];
+	/** Bytes collected in the input buffer, and bytes needed to go on */
+	size_t in_len;
+	size_t in_need;
+	/** Size of the decompressed image and of its blocks, from the header */
+	size_t image_size;
+	size_t block_size;
+	/** Decompressed bytes written */
+	size_t out_total;
+	uint8_t state;
+};
+#endif
+
 struct flash_img_context {
 	uint8_t buf[CONFIG_IMG_BLOCK_BUF_SIZE];
 	const struct flash_area *flash_area;
 	struct stream_flash_ctx stream;
+#ifdef CONFIG_IMG_LZ4
+	struct flash_img_lz4 *lz4;
+#endif
 };
 
 /**
@@ -94,6 +128,40 @@ size_t flash_img_bytes_written(struct flash_img_context *ctx);
 int flash_img_buffered_write(struct flash_img_context *ctx, const uint8_t *data,
 		    size_t len, bool flush);
 
+/**
+ * @brief Decompress the data written to the image.
+ *
+ * The data given to flash_img_buffered_write() afterwards is an LZ4
+ * compressed image stream, decompressed on the fly into the flash. The stream
+ * is made of a header of FLASH_IMG_LZ4_HDR_SIZE bytes, then of blocks.
+ *
+ * The header holds three little-endian 32-bit words: FLASH_IMG_LZ4_MAGIC, the
+ * size of the decompressed image, and the size of the decompressed blocks,
+ * at most @kconfig{CONFIG_IMG_LZ4_BLOCK_SIZE}.
+ *
+ * Each block starts with a little-endian 32-bit word holding the length of
+ * its data, followed by the data: an LZ4 block compressed independently of the
+ * others, or the data itself when FLASH_IMG_LZ4_BLOCK_STORED is set in the
+ * length word. All the blocks but the last decompress to the block size.
+ *
+ * The function is enabled via CONFIG_IMG_LZ4 Kconfig option.
+ *
+ * @param ctx context, initialized and with no data written yet.
+ * @param lz4 decompression state, in use until the final write.
+ */
+void flash_img_lz4_enable(struct flash_img_context *ctx, struct flash_img_lz4 *lz4);
+
+/**
+ * @brief Check whether data starts an LZ4 compressed image stream.
+ *
+ * @param data start of the data
+ * @param len length of the data
+ * @param image_size set to the size of the decompressed image, if it does
+ *
+ * @return true if the data starts with a valid stream header.
+ */
+bool flash_img_lz4_is_stream(const uint8_t *data, size_t len, size_t *image_size);
+
 /**
  * @brief  Verify flash memory length bytes integrity from a flash area. The
  * start point is indicated by an offset value.
@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Framebuffer with dirty rectangle tracking
+ */
+
+#ifndef ZEPHYR_INCLUDE_DISPLAY_FB_DIRTY_H_
+#define ZEPHYR_INCLUDE_DISPLAY_FB_DIRTY_H_
+
+#include <zephyr/device.h>
+#include <zephyr/kernel.h>
+#include <zephyr/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Framebuffer with dirty rectangle tracking
+ * @defgroup fb_dirty Framebuffer with dirty rectangle tracking
+ * @ingroup display_interface
+ *
+ * The application renders a whole frame in a framebuffer held in memory, and
+ * marks the rectangles it changed. Only these rectangles, merged when they
+ * overlap or when there are too many of them, are written to the display.
+ *
+ * With two framebuffers, the rectangles are written from a work queue while
+ * the application renders the next frame in the other framebuffer, so that
+ * the CPU is not held by the transfers to the display, which the drivers
+ * usually do by DMA.
+ *
+ * @{
+ */
+
+/** @brief Rectangle of a framebuffer */
+struct fb_dirty_rect {
+	uint16_t x;
+	uint16_t y;
+	uint16_t width;
+	uint16_t height;
+};
+
+/**
+ * @brief Framebuffer instance
+ *
+ * The fields are internal to the framebuffer.
+ */
+struct fb_dirty {
+	const struct device *dev;
+	uint8_t *bufs[2];
+	uint16_t width;
+	uint16_t height;
+	uint8_t pixel_size;
+	/* Framebuffer rendered into */
+	uint8_t back;
+	/* Rectangles changed in the rendered framebuffer */
+	struct fb_dirty_rect rects[CONFIG_FB_DIRTY_MAX_RECTS];
+	uint8_t n_rects;
+	/* Rectangles being written to the display, from the other framebuffer */
+	struct fb_dirty_rect flush_rects[CONFIG_FB_DIRTY_MAX_RECTS];
+	uint8_t n_flush_rects;
+	int flush_err;
+	struct k_work work;
+	/* Given when no rectangle is being written */
+	struct k_sem idle;
+};
+
+/**
+ * @brief Initialize a framebuffer.
+ *
+ * The size of the framebuffers is the one of a frame in the current pixel
+ * format of the display, which must have a whole number of bytes per pixel.
+ *
+ * @param fb The framebuffer instance.
+ * @param dev Display device.
+ * @param buf0 First framebuffer.
+ * @param buf1 Second framebuffer, NULL to write the rectangles synchronously
+ *             from the only framebuffer.
+ * @param size Size of each framebuffer.
+ *
+ * @retval 0 On success.
+ * @retval -ENOTSUP If the pixel format of the display is not supported.
+ * @retval -EINVAL If the framebuffers are too small for a frame.
+ */
+int fb_dirty_init(struct fb_dirty *fb, const struct device *dev, uint8_t *buf0,
+		  uint8_t *buf1, size_t size);
+
+/**
+ * @brief Get the framebuffer to render into.
+ *
+ * The framebuffer holds the frame last flushed, to be updated in place.
+ * Its rows are the width of the display apart.
+ *
+ * @param fb The framebuffer instance.
+ *
+ * @return The framebuffer.
+ */
+static inline uint8_t *fb_dirty_buffer(struct fb_dirty *fb)
+{
+	return fb->bufs[fb->back];
+}
+
+/**
+ * @brief Mark a rectangle of the framebuffer as changed.
+ *
+ * The rectangle is clipped to the display, and merged with the rectangles
+ * already marked that it overlaps or touches. When all the rectangles are
+ * in use, it is merged with the one growing the least.
+ *
+ * @param fb The framebuffer instance.
+ * @param rect Changed rectangle.
+ */
+void fb_dirty_mark(struct fb_dirty *fb, const struct fb_dirty_rect *rect);
+
+/**
+ * @brief Write the changed rectangles to the display.
+ *
+ * With two framebuffers, the rectangles are written from the work queue of
+ * the framebuffers, and the application goes on rendering in the other
+ * framebuffer once the changed rectangles are copied to it. This waits for
+ * the previous flush to be done.
+ *
+ * @param fb The framebuffer instance.
+ *
+ * @retval 0 On success.
+ * @retval -errno Error of the display when writing the previous rectangles
+ *                of the framebuffer, or these ones when flushing
+ *                synchronously.
+ */
+int fb_dirty_flush(struct fb_dirty *fb);
+
+/**
+ * @brief Wait for the rectangles being written to the display.
+ *
+ * @param fb The framebuffer instance.
+ * @param timeout Waiting period for the flush to be done.
+ *
+ * @retval 0 On success.
+ * @retval -EAGAIN If the flush is not done within the timeout.
+ * @retval -errno Error of the display when writing the rectangles.
+ */
+int fb_dirty_sync(struct fb_dirty *fb, k_timeout_t timeout);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_DISPLAY_FB_DIRTY_H_ */
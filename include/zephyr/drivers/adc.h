@@ -592,6 +592,64 @@ typedef int (*adc_api_read_async)(const struct device *dev,
 				  const struct adc_sequence *sequence,
 				  struct k_poll_signal *async);
 
+/**
+ * @brief Samplings delivered by a continuous sampling.
+ */
+struct adc_stream_data {
+	/**
+	 * Samplings, laid out as in the buffer of an @ref adc_sequence. This
+	 * is one half of the buffer given to adc_stream_start().
+	 */
+	void *buffer;
+
+	/** Size of the samplings in bytes. */
+	size_t size;
+
+	/** Uptime when the last sampling of the buffer completed, in ns. */
+	uint64_t timestamp_ns;
+
+	/**
+	 * Time between two samplings in ns, measured over the buffer. It is 0
+	 * for the first buffer of the stream. The sampling at index i of the
+	 * n samplings completed at timestamp_ns - (n - 1 - i) * period_ns.
+	 */
+	uint32_t period_ns;
+};
+
+/**
+ * @brief Type definition of the callback of a continuous sampling.
+ *
+ * It is called from the interrupt context of the driver, each time one half
+ * of the buffer is filled, and must be done with the half before the other
+ * one is filled in turn.
+ *
+ * @param dev       Pointer to the device structure for the driver instance.
+ * @param status    0 if @p data holds new samplings, negative error code if
+ *                  the sampling stopped on an error, @p data is then NULL.
+ * @param data      Samplings of the filled half of the buffer.
+ * @param user_data Pointer to the user data given to adc_stream_start().
+ */
+typedef void (*adc_stream_callback)(const struct device *dev, int status,
+				    const struct adc_stream_data *data,
+				    void *user_data);
+
+/**
+ * @brief Type definition of ADC API function for starting a continuous
+ *        sampling.
+ * See adc_stream_start() for argument descriptions.
+ */
+typedef int (*adc_api_stream_start)(const struct device *dev,
+				    const struct adc_sequence *sequence,
+				    adc_stream_callback callback,
+				    void *user_data);
+
+/**
+ * @brief Type definition of ADC API function for stopping a continuous
+ *        sampling.
+ * See adc_stream_stop() for argument descriptions.
+ */
+typedef int (*adc_api_stream_stop)(const struct device *dev);
+
 /**
  * @brief ADC driver API
  *
@@ -602,6 +660,10 @@ __subsystem struct adc_driver_api {
 	adc_api_read          read;
 #ifdef CONFIG_ADC_ASYNC
 	adc_api_read_async    read_async;
+#endif
+#ifdef CONFIG_ADC_STREAM
+	adc_api_stream_start  stream_start;
+	adc_api_stream_stop   stream_stop;
 #endif
 	uint16_t ref_internal;	/* mV */
 };
@@ -718,6 +780,73 @@ static inline int z_impl_adc_read_async(const struct device *dev,
 }
 #endif /* CONFIG_ADC_ASYNC */
 
+#if defined(CONFIG_ADC_STREAM) || defined(__DOXYGEN__)
+/**
+ * @brief Start sampling continuously.
+ *
+ * @note This function is available only if @kconfig{CONFIG_ADC_STREAM}
+ * is selected.
+ *
+ * The samplings are paced by the hardware and moved to the buffer of the
+ * sequence without the intervention of the CPU, which is split in two halves
+ * filled in turn: @p callback is given one half while the other is filled.
+ * The options of the sequence are not supported, other than an interval of 0.
+ * The device is held until adc_stream_stop() is called.
+ *
+ * @param dev       Pointer to the device structure for the driver instance.
+ * @param sequence  Structure specifying the channels, resolution and buffer of
+ *                  the samplings. The buffer must hold at least two samplings.
+ * @param callback  Callback called with each half of the buffer once filled.
+ * @param user_data Pointer to user data given to @p callback.
+ *
+ * @retval 0        On success.
+ * @retval -EINVAL  If a parameter with an invalid value has been provided.
+ * @retval -ENOMEM  If the provided buffer is too small to hold two samplings.
+ * @retval -ENOTSUP If the driver or the requested options are not supported.
+ */
+static inline int adc_stream_start(const struct device *dev,
+				   const struct adc_sequence *sequence,
+				   adc_stream_callback callback,
+				   void *user_data)
+{
+	const struct adc_driver_api *api =
+				(const struct adc_driver_api *)dev->api;
+
+	if (api->stream_start == NULL) {
+		return -ENOTSUP;
+	}
+
+	return api->stream_start(dev, sequence, callback, user_data);
+}
+
+/**
+ * @brief Stop a continuous sampling.
+ *
+ * @note This function is available only if @kconfig{CONFIG_ADC_STREAM}
+ * is selected.
+ *
+ * The callback is not called anymore once this function returns, the half of
+ * the buffer being filled is discarded.
+ *
+ * @param dev Pointer to the device structure for the driver instance.
+ *
+ * @retval 0        On success.
+ * @retval -EALREADY If the device was not sampling continuously.
+ * @retval -ENOTSUP If the driver does not support continuous sampling.
+ */
+static inline int adc_stream_stop(const struct device *dev)
+{
+	const struct adc_driver_api *api =
+				(const struct adc_driver_api *)dev->api;
+
+	if (api->stream_stop == NULL) {
+		return -ENOTSUP;
+	}
+
+	return api->stream_stop(dev);
+}
+#endif /* CONFIG_ADC_STREAM */
+
 /**
  * @brief Get the internal reference voltage.
  *
@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_DRIVERS_CAN_RX_MGR_H_
+#define ZEPHYR_INCLUDE_DRIVERS_CAN_RX_MGR_H_
+
+#include <zephyr/drivers/can.h>
+#include <zephyr/kernel.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief CAN RX filter manager
+ * @defgroup can_rx_mgr CAN RX filter manager
+ * @ingroup can_interface
+ *
+ * The RX filter manager takes more filters than the CAN controller has. The
+ * filters are packed into the hardware filters of the controller, merging the
+ * masks of the filters of neighbouring identifiers when there are not enough
+ * of them, and the frames accepted by the hardware filters are dispatched to
+ * the callbacks of the matching filters in software: through a hash table for
+ * the filters of a single identifier, and through a list for the others.
+ *
+ * @{
+ */
+
+/** @cond INTERNAL_HIDDEN */
+
+struct can_rx_mgr_filter {
+	struct can_filter filter;
+	can_rx_callback_t callback;
+	void *user_data;
+	/* Next filter of the hash bucket, or of the list of masked filters */
+	int16_t next;
+	bool used;
+};
+
+/** @endcond */
+
+/** @brief Statistics of an RX filter manager */
+struct can_rx_mgr_stats {
+	/** Frames accepted by the hardware filters */
+	uint32_t frames;
+	/** Frames matching filters of a single identifier */
+	uint32_t hash_hits;
+	/** Frames matching masked filters */
+	uint32_t list_hits;
+	/** Frames accepted by merged hardware filters, matching no filter */
+	uint32_t unmatched;
+	/** Hardware filters in use */
+	uint16_t hw_filters;
+};
+
+/**
+ * @brief CAN RX filter manager
+ *
+ * The fields are internal to the manager.
+ */
+struct can_rx_mgr {
+	const struct device *dev;
+	/* Serializes the changes of the filters */
+	struct k_mutex mutex;
+	/* Protects the filters against the dispatch of the frames */
+	struct k_spinlock lock;
+	struct can_rx_mgr_filter filters[CONFIG_CAN_RX_MGR_MAX_FILTERS];
+	int16_t buckets[CONFIG_CAN_RX_MGR_HASH_BUCKETS];
+	int16_t masked;
+	int hw_ids[CONFIG_CAN_RX_MGR_MAX_HW_FILTERS];
+	struct can_rx_mgr_stats stats;
+};
+
+/**
+ * @brief Initialize an RX filter manager.
+ *
+ * The manager must be the only user of the RX filters of the controller.
+ *
+ * @param mgr The RX filter manager.
+ * @param dev Pointer to the device structure for the driver instance.
+ */
+void can_rx_mgr_init(struct can_rx_mgr *mgr, const struct device *dev);
+
+/**
+ * @brief Add a callback function for a given CAN filter.
+ *
+ * The hardware filters are packed again, which may make the controller miss
+ * frames while they are being replaced. The callback is called in interrupt
+ * context, with the lock of the manager held: it must not add or remove
+ * filters.
+ *
+ * @param mgr       The RX filter manager.
+ * @param callback  This function is called whenever a frame matching the
+ *                  filter is received.
+ * @param user_data User data to pass to callback function.
+ * @param filter    Pointer to a @a can_filter structure defining the filter.
+ *
+ * @retval filter_id on success.
+ * @retval -ENOSPC if there are no free filters.
+ * @retval -EINVAL if the requested filter type is invalid.
+ * @retval -errno if the hardware filters could not be added.
+ */
+int can_rx_mgr_add_filter(struct can_rx_mgr *mgr, can_rx_callback_t callback,
+			  void *user_data, const struct can_filter *filter);
+
+/**
+ * @brief Remove a filter.
+ *
+ * @param mgr       The RX filter manager.
+ * @param filter_id Filter ID returned by can_rx_mgr_add_filter().
+ */
+void can_rx_mgr_remove_filter(struct can_rx_mgr *mgr, int filter_id);
+
+/**
+ * @brief Get the statistics of an RX filter manager.
+ *
+ * @param mgr   The RX filter manager.
+ * @param stats Statistics.
+ */
+void can_rx_mgr_get_stats(struct can_rx_mgr *mgr, struct can_rx_mgr_stats *stats);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_DRIVERS_CAN_RX_MGR_H_ */
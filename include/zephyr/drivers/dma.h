@@ -281,6 +281,16 @@ typedef int (*dma_api_reload)(const struct device *dev, uint32_t channel,
 			      uint32_t src, uint32_t dst, size_t size);
 #endif
 
+#ifdef CONFIG_DMA_64BIT
+typedef int (*dma_api_enqueue)(const struct device *dev, uint32_t channel,
+			       uint64_t src, uint64_t dst, size_t size);
+#else
+typedef int (*dma_api_enqueue)(const struct device *dev, uint32_t channel,
+			       uint32_t src, uint32_t dst, size_t size);
+#endif
+
+typedef int (*dma_api_dequeue)(const struct device *dev, uint32_t channel);
+
 typedef int (*dma_api_start)(const struct device *dev, uint32_t channel);
 
 typedef int (*dma_api_stop)(const struct device *dev, uint32_t channel);
@@ -320,6 +330,8 @@ __subsystem struct dma_driver_api {
 	dma_api_get_status get_status;
 	dma_api_get_attribute get_attribute;
 	dma_api_chan_filter chan_filter;
+	dma_api_enqueue enqueue;
+	dma_api_dequeue dequeue;
 };
 /**
  * @endcond
@@ -376,6 +388,73 @@ static inline int dma_reload(const struct device *dev, uint32_t channel,
 	return -ENOSYS;
 }
 
+/**
+ * @brief Queue a block on the descriptor ring of a DMA channel
+ *
+ * The channel keeps the settings of its last dma_config() and the block is
+ * appended to the blocks it is transferring, so that a peripheral such as an
+ * I2S or ADC can stream without reconfiguring the channel. The call is the
+ * doorbell of the ring: it restarts the channel when it ran out of blocks.
+ *
+ * The callback of the channel is called with DMA_STATUS_BLOCK when a block
+ * completes and others are pending, and DMA_STATUS_COMPLETE when the ring
+ * runs empty. The function can be called from the callback.
+ *
+ * @param dev     Pointer to the device structure for the driver instance.
+ * @param channel Numeric identification of the channel
+ * @param src     source address of the block
+ * @param dst     destination address of the block
+ * @param size    size of the block
+ *
+ * @retval 0 if successful.
+ * @retval -ENOMEM if the ring of the channel is full.
+ * @retval -ENOSYS if not implemented.
+ * @retval Negative errno code if failure.
+ */
+#ifdef CONFIG_DMA_64BIT
+static inline int dma_enqueue(const struct device *dev, uint32_t channel,
+			      uint64_t src, uint64_t dst, size_t size)
+#else
+static inline int dma_enqueue(const struct device *dev, uint32_t channel,
+			      uint32_t src, uint32_t dst, size_t size)
+#endif
+{
+	const struct dma_driver_api *api =
+		(const struct dma_driver_api *)dev->api;
+
+	if (api->enqueue) {
+		return api->enqueue(dev, channel, src, dst, size);
+	}
+
+	return -ENOSYS;
+}
+
+/**
+ * @brief Retire the completed blocks of the descriptor ring of a DMA channel
+ *
+ * The blocks complete in the order they were queued with dma_enqueue(), so
+ * the count tells how many of the oldest blocks can be given back to their
+ * owner.
+ *
+ * @param dev     Pointer to the device structure for the driver instance.
+ * @param channel Numeric identification of the channel
+ *
+ * @retval Number of blocks completed since the last call.
+ * @retval -ENOSYS if not implemented.
+ * @retval Negative errno code if failure.
+ */
+static inline int dma_dequeue(const struct device *dev, uint32_t channel)
+{
+	const struct dma_driver_api *api =
+		(const struct dma_driver_api *)dev->api;
+
+	if (api->dequeue) {
+		return api->dequeue(dev, channel);
+	}
+
+	return -ENOSYS;
+}
+
 /**
  * @brief Enables DMA channel and starts the transfer, the channel must be
  *        configured beforehand.
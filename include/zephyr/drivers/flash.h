@@ -26,6 +26,9 @@
 #include <stddef.h>
 #include <sys/types.h>
 #include <zephyr/device.h>
+#ifdef CONFIG_FLASH_ASYNC
+#include <zephyr/kernel.h>
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -59,6 +62,54 @@ struct flash_parameters {
 	uint8_t erase_value; /* Byte value of erased flash */
 };
 
+#if defined(CONFIG_FLASH_ASYNC) || defined(__DOXYGEN__)
+/** Type of an asynchronous flash operation */
+enum flash_async_op_type {
+	FLASH_ASYNC_OP_READ,
+	FLASH_ASYNC_OP_WRITE,
+	FLASH_ASYNC_OP_ERASE,
+};
+
+struct flash_async_op;
+
+/**
+ * @typedef flash_async_callback_t
+ * @brief Callback invoked on completion of an asynchronous flash operation.
+ *
+ * It is invoked from the thread executing the operation, and may submit
+ * the operation again.
+ *
+ * @param dev Flash device
+ * @param op Completed operation
+ * @param result 0 on success, negative errno code of the operation on fail.
+ */
+typedef void (*flash_async_callback_t)(const struct device *dev,
+				       struct flash_async_op *op, int result);
+
+/**
+ * Asynchronous flash operation, owned by the driver from its submission
+ * until its callback is invoked.
+ */
+struct flash_async_op {
+	/** Type of the operation */
+	enum flash_async_op_type type;
+	/** Offset of the operation */
+	off_t offset;
+	/** Buffer read into or written from, unused by an erase */
+	void *data;
+	/** Number of bytes to read, write or erase */
+	size_t len;
+	/** Callback invoked on completion, must not be NULL */
+	flash_async_callback_t cb;
+	/** User data of the callback */
+	void *user_data;
+	/** @cond INTERNAL_HIDDEN */
+	const struct device *dev;
+	struct k_work work;
+	/** @endcond */
+};
+#endif /* CONFIG_FLASH_ASYNC */
+
 /**
  * @}
  */
@@ -127,6 +178,10 @@ typedef int (*flash_api_sfdp_read)(const struct device *dev, off_t offset,
 typedef int (*flash_api_read_jedec_id)(const struct device *dev, uint8_t *id);
 typedef int (*flash_api_ex_op)(const struct device *dev, uint16_t code,
 			       const uintptr_t in, void *out);
+#if defined(CONFIG_FLASH_ASYNC)
+typedef int (*flash_api_async_submit)(const struct device *dev,
+				      struct flash_async_op *op);
+#endif /* CONFIG_FLASH_ASYNC */
 
 __subsystem struct flash_driver_api {
 	flash_api_read read;
@@ -143,6 +198,9 @@ __subsystem struct flash_driver_api {
 #if defined(CONFIG_FLASH_EX_OP_ENABLED)
 	flash_api_ex_op ex_op;
 #endif /* CONFIG_FLASH_EX_OP_ENABLED */
+#if defined(CONFIG_FLASH_ASYNC)
+	flash_api_async_submit async_submit;
+#endif /* CONFIG_FLASH_ASYNC */
 };
 
 /**
@@ -493,6 +551,42 @@ static inline int z_impl_flash_ex_op(const struct device *dev, uint16_t code,
 #endif /* CONFIG_FLASH_EX_OP_ENABLED */
 }
 
+#if defined(CONFIG_FLASH_ASYNC) || defined(__DOXYGEN__)
+/** @cond INTERNAL_HIDDEN */
+int z_flash_async_submit(const struct device *dev, struct flash_async_op *op);
+/** @endcond */
+
+/**
+ *  @brief  Submit an asynchronous flash operation
+ *
+ *  The operation is queued behind the operations previously submitted for
+ *  the device, and executed in order by the driver if it supports this API
+ *  or else by the flash work queue, a thread of priority
+ *  @kconfig{CONFIG_FLASH_ASYNC_THREAD_PRIORITY} calling flash_read(),
+ *  flash_write() and flash_erase(). The alignment rules of these functions
+ *  apply. The operation and its buffer must stay valid until its callback
+ *  is invoked.
+ *
+ *  @param  dev             : flash device
+ *  @param  op              : operation to submit
+ *
+ *  @return  0 on success, negative errno code if the operation cannot be
+ *           queued, in which case its callback is not invoked.
+ */
+static inline int flash_async_submit(const struct device *dev,
+				     struct flash_async_op *op)
+{
+	const struct flash_driver_api *api =
+		(const struct flash_driver_api *)dev->api;
+
+	if (api->async_submit != NULL) {
+		return api->async_submit(dev, op);
+	}
+
+	return z_flash_async_submit(dev, op);
+}
+#endif /* CONFIG_FLASH_ASYNC */
+
 #ifdef __cplusplus
 }
 #endif
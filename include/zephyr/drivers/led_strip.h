@@ -22,6 +22,7 @@
  * @{
  */
 
+#include <errno.h>
 #include <zephyr/types.h>
 #include <zephyr/device.h>
 
@@ -71,14 +72,26 @@ typedef int (*led_api_update_channels)(const struct device *dev,
 				       uint8_t *channels,
 				       size_t num_channels);
 
+/**
+ * @typedef led_api_update_rgb_range
+ * @brief Optional callback API for updating a range of an RGB LED strip
+ *
+ * @see led_strip_update_rgb_range() for argument descriptions.
+ */
+typedef int (*led_api_update_rgb_range)(const struct device *dev,
+					struct led_rgb *pixels,
+					size_t offset, size_t num_pixels);
+
 /**
  * @brief LED strip driver API
  *
- * This is the mandatory API any LED strip driver needs to expose.
+ * This is the mandatory API any LED strip driver needs to expose, the
+ * update of ranges being optional.
  */
 struct led_strip_driver_api {
 	led_api_update_rgb update_rgb;
 	led_api_update_channels update_channels;
+	led_api_update_rgb_range update_rgb_range;
 };
 
 /**
@@ -105,6 +118,40 @@ static inline int led_strip_update_rgb(const struct device *dev,
 	return api->update_rgb(dev, pixels, num_pixels);
 }
 
+/**
+ * @brief Update a range of the pixels of an LED strip made of RGB pixels
+ *
+ * Important:
+ *     This routine may overwrite @a pixels.
+ *
+ * This routine immediately updates the strip display, the pixels from
+ * @a offset taking the given values and the other ones keeping the values
+ * of the previous updates. Drivers only encode the updated pixels, and may
+ * stop sending the pixel data after them.
+ *
+ * @param dev LED strip device
+ * @param pixels Array of pixel data of the range
+ * @param offset Index of the first pixel of the range on the strip
+ * @param num_pixels Length of pixels array
+ * @retval 0 on success
+ * @retval -ENOSYS if the driver does not support the update of ranges
+ * @retval -errno negative on other errors
+ * @warning May overwrite @a pixels
+ */
+static inline int led_strip_update_rgb_range(const struct device *dev,
+					     struct led_rgb *pixels,
+					     size_t offset, size_t num_pixels)
+{
+	const struct led_strip_driver_api *api =
+		(const struct led_strip_driver_api *)dev->api;
+
+	if (api->update_rgb_range == NULL) {
+		return -ENOSYS;
+	}
+
+	return api->update_rgb_range(dev, pixels, offset, num_pixels);
+}
+
 /**
  * @brief Update an LED strip on a per-channel basis.
  *
@@ -246,6 +246,12 @@ enum sensor_trigger_type {
 
 	/** Trigger fires when no motion has been detected for a while. */
 	SENSOR_TRIG_STATIONARY,
+
+	/** Trigger fires when the FIFO watermark has been reached. */
+	SENSOR_TRIG_FIFO_WATERMARK,
+
+	/** Trigger fires when the FIFO becomes full. */
+	SENSOR_TRIG_FIFO_FULL,
 	/**
 	 * Number of all common sensor triggers.
 	 */
@@ -500,6 +506,52 @@ struct sensor_decoder_api {
 	int (*decode)(const uint8_t *buffer, sensor_frame_iterator_t *fit,
 		      sensor_channel_iterator_t *cit, enum sensor_channel *channels, q31_t *values,
 		      uint8_t max_count);
+
+	/**
+	 * @brief Get the timestamp associated with a frame
+	 *
+	 * May be NULL if all the frames of a buffer share the timestamp given by
+	 * @ref get_timestamp.
+	 *
+	 * @param[in]  buffer The buffer provided on the :c:struct:`rtio` context.
+	 * @param[in]  fit The frame iterator of the frame, as updated by @ref decode
+	 * @param[out] timestamp_ns The closest timestamp for when the frame was generated
+	 * @return 0 on success
+	 * @return -EINVAL if there is no such frame in the buffer
+	 */
+	int (*get_frame_timestamp)(const uint8_t *buffer, sensor_frame_iterator_t fit,
+				   uint64_t *timestamp_ns);
+
+	/**
+	 * @brief Check if the given trigger type is present
+	 *
+	 * May be NULL for decoders of drivers which do not stream.
+	 *
+	 * @param[in] buffer The buffer provided on the :c:struct:`rtio` context
+	 * @param[in] trigger The trigger type in question
+	 * @return Whether the trigger is present in the buffer
+	 */
+	bool (*has_trigger)(const uint8_t *buffer, enum sensor_trigger_type trigger);
+
+	/**
+	 * @brief Decode the samples of a channel over consecutive frames
+	 *
+	 * The samples are written contiguously, frames which do not hold the channel being
+	 * skipped. The samples of a 3 axis channel are interleaved, x, y and z for each frame.
+	 * The values share the shift given by @ref get_shift for the whole buffer.
+	 *
+	 * May be NULL, :c:func:`sensor_decode_channel` then falls back on @ref decode.
+	 *
+	 * @param[in]     buffer The buffer provided on the :c:struct:`rtio` context
+	 * @param[in]     channel The channel to decode
+	 * @param[in,out] fit The frame iterator, moved past the last frame decoded
+	 * @param[out]    values The scaled samples
+	 * @param[in]     max_count The maximum number of values to decode
+	 * @return The number of values decoded, 0 once all the frames are decoded
+	 * @return <0 on error
+	 */
+	int (*decode_channel)(const uint8_t *buffer, enum sensor_channel channel,
+			      sensor_frame_iterator_t *fit, q31_t *values, uint16_t max_count);
 };
 
 /**
@@ -511,13 +563,37 @@ struct sensor_decoder_api {
 typedef int (*sensor_get_decoder_t)(const struct device *dev,
 				    const struct sensor_decoder_api **api);
 
+/**
+ * @brief Options for what to do with the associated data when a trigger is consumed
+ */
+enum sensor_stream_data_opt {
+	/** @brief Include whatever data is associated with the trigger */
+	SENSOR_STREAM_DATA_INCLUDE = 0,
+	/** @brief Do nothing with the associated trigger data, it may be consumed later */
+	SENSOR_STREAM_DATA_NOP = 1,
+	/** @brief Flush/clear whatever data is associated with the trigger */
+	SENSOR_STREAM_DATA_DROP = 2,
+};
+
+/**
+ * @brief Trigger of a streaming read and what to do with its data
+ */
+struct sensor_stream_trigger {
+	enum sensor_trigger_type trigger;
+	enum sensor_stream_data_opt opt;
+};
+
 /*
  * Internal data structure used to store information about the IODevice for async reading and
  * streaming sensor data.
  */
 struct sensor_read_config {
 	const struct device *sensor;
-	enum sensor_channel *const channels;
+	const bool is_streaming;
+	union {
+		enum sensor_channel *const channels;
+		struct sensor_stream_trigger *const triggers;
+	};
 	size_t count;
 	const size_t max;
 };
@@ -546,6 +622,36 @@ struct sensor_read_config {
 	};                                                                                         \
 	RTIO_IODEV_DEFINE(name, &__sensor_iodev_api, &__sensor_read_config_##name)
 
+/**
+ * @brief Define a stream instance of a sensor
+ *
+ * Use this macro to generate a :c:struct:`rtio_iodev` for streaming the data of a sensor, each
+ * of the triggers given producing a completion. Example:
+ *
+ * @code(.c)
+ * SENSOR_DT_STREAM_IODEV(icm42688_stream, DT_NODELABEL(icm42688),
+ *     {SENSOR_TRIG_FIFO_WATERMARK, SENSOR_STREAM_DATA_INCLUDE},
+ *     {SENSOR_TRIG_FIFO_FULL, SENSOR_STREAM_DATA_NOP});
+ *
+ * int main(void) {
+ *   struct rtio_sqe *handle;
+ *   sensor_stream(&icm42688_stream, &rtio, NULL, &handle);
+ *   k_msleep(1000);
+ *   rtio_sqe_cancel(handle);
+ * }
+ * @endcode
+ */
+#define SENSOR_DT_STREAM_IODEV(name, dt_node, ...)                                                 \
+	static struct sensor_stream_trigger __trigger_array_##name[] = {__VA_ARGS__};              \
+	static struct sensor_read_config __sensor_read_config_##name = {                           \
+		.sensor = DEVICE_DT_GET(dt_node),                                                  \
+		.is_streaming = true,                                                              \
+		.triggers = __trigger_array_##name,                                                \
+		.count = ARRAY_SIZE(__trigger_array_##name),                                       \
+		.max = ARRAY_SIZE(__trigger_array_##name),                                         \
+	};                                                                                         \
+	RTIO_IODEV_DEFINE(name, &__sensor_iodev_api, &__sensor_read_config_##name)
+
 /* Used to submit an RTIO sqe to the sensor's iodev */
 typedef int (*sensor_submit_t)(const struct device *sensor, struct rtio_iodev_sqe *sqe);
 
@@ -851,6 +957,10 @@ static inline int z_impl_sensor_reconfigure_read_iodev(struct rtio_iodev *iodev,
 {
 	struct sensor_read_config *cfg = (struct sensor_read_config *)iodev->data;
 
+	if (cfg->is_streaming) {
+		return -EINVAL;
+	}
+
 	if (cfg->max < num_channels) {
 		return -ENOMEM;
 	}
@@ -894,6 +1004,45 @@ static inline int sensor_read(struct rtio_iodev *iodev, struct rtio *ctx, void *
 	return 0;
 }
 
+/**
+ * @brief Stream data from a sensor.
+ *
+ * Using @p iodev, start streaming the data of the device with the provided RTIO context @p ctx.
+ * Each trigger of the stream produces a completion holding a buffer from the RTIO's internal
+ * mempool, for instance a batch of FIFO frames, until the stream is stopped by canceling
+ * @p handle with :c:func:`rtio_sqe_cancel`. Drivers which do not implement streaming complete
+ * the stream with -ENOTSUP.
+ *
+ * @param[in] iodev The iodev created by :c:macro:`SENSOR_DT_STREAM_IODEV`
+ * @param[in] ctx The RTIO context to service the stream
+ * @param[in] userdata Optional userdata that will be available with each completion
+ * @param[out] handle Where to store the handle of the stream
+ * @return 0 on success
+ * @return < 0 on error
+ */
+static inline int sensor_stream(struct rtio_iodev *iodev, struct rtio *ctx, void *userdata,
+				struct rtio_sqe **handle)
+{
+	if (IS_ENABLED(CONFIG_USERSPACE)) {
+		struct rtio_sqe sqe;
+
+		rtio_sqe_prep_read_multishot(&sqe, iodev, RTIO_PRIO_NORM, userdata);
+		rtio_sqe_copy_in_get_handles(ctx, &sqe, handle, 1);
+	} else {
+		struct rtio_sqe *sqe = rtio_sqe_acquire(ctx);
+
+		if (sqe == NULL) {
+			return -ENOMEM;
+		}
+		if (handle != NULL) {
+			*handle = sqe;
+		}
+		rtio_sqe_prep_read_multishot(sqe, iodev, RTIO_PRIO_NORM, userdata);
+	}
+	rtio_submit(ctx, 0);
+	return 0;
+}
+
 /**
  * @typedef sensor_processing_callback_t
  * @brief Callback function used with the helper processing function.
@@ -921,6 +1070,26 @@ typedef void (*sensor_processing_callback_t)(int result, uint8_t *buf, uint32_t
  */
 void sensor_processing_with_callback(struct rtio *ctx, sensor_processing_callback_t cb);
 
+/**
+ * @brief Decode the samples of a channel over the frames of a buffer into an array
+ *
+ * Converts a whole FIFO batch with a single call instead of one call to
+ * :c:member:`sensor_decoder_api.decode` per frame. Uses the decode_channel function of the
+ * decoder, or its decode function if it has none.
+ *
+ * @param[in]     decoder The decoder of the buffer
+ * @param[in]     buffer The buffer provided on the :c:struct:`rtio` context
+ * @param[in]     channel The channel to decode, the samples of 3 axis channels being interleaved
+ * @param[in,out] fit The frame iterator, moved past the last frame decoded
+ * @param[out]    values The scaled samples, sharing the shift of the channel
+ * @param[in]     max_count The maximum number of values to decode
+ * @return The number of values decoded, 0 once all the frames are decoded
+ * @return <0 on error
+ */
+int sensor_decode_channel(const struct sensor_decoder_api *decoder, const uint8_t *buffer,
+			  enum sensor_channel channel, sensor_frame_iterator_t *fit, q31_t *values,
+			  uint16_t max_count);
+
 #endif /* defined(CONFIG_SENSOR_ASYNC_API) || defined(__DOXYGEN__) */
 
 /**
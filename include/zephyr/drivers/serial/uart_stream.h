@@ -0,0 +1,189 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Stream of received data on top of the asynchronous UART API
+ */
+
+#ifndef ZEPHYR_INCLUDE_DRIVERS_SERIAL_UART_STREAM_H_
+#define ZEPHYR_INCLUDE_DRIVERS_SERIAL_UART_STREAM_H_
+
+#include <zephyr/device.h>
+#include <zephyr/drivers/uart.h>
+#include <zephyr/kernel.h>
+#include <zephyr/spinlock.h>
+#include <zephyr/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief UART stream
+ * @defgroup uart_stream UART stream
+ * @ingroup uart_interface
+ *
+ * The stream owns a ring buffer split in @kconfig{CONFIG_UART_STREAM_CHUNKS}
+ * chunks, which are handed over to the driver as reception buffers, so that
+ * the data is read in place, where the driver (usually its DMA) wrote it.
+ * The data is made available as soon as the driver reports it, on a full
+ * buffer or on the reception timeout, which detects an idle line.
+ *
+ * @{
+ */
+
+/**
+ * @brief UART stream instance
+ *
+ * The fields are internal to the stream.
+ */
+struct uart_stream {
+	const struct device *dev;
+	uint8_t *buffer;
+	size_t chunk_size;
+	int32_t timeout_us;
+	uart_callback_t callback;
+	void *user_data;
+	struct k_spinlock lock;
+	/* Raised when data was received, or the reception stopped on an error */
+	struct k_poll_signal signal;
+	/* Bytes received in each chunk */
+	size_t len[CONFIG_UART_STREAM_CHUNKS];
+	/* Chunk read from and offset of its next byte to read */
+	uint8_t rd_chunk;
+	size_t rd_off;
+	/* Next chunk to give to the driver */
+	uint8_t wr_chunk;
+	/* Chunks given to the driver or holding unread data */
+	uint8_t used;
+	/* Chunks given to the driver */
+	uint8_t held;
+	bool running;
+	bool enabled;
+};
+
+/**
+ * @brief Initialize a UART stream.
+ *
+ * @param stream The stream instance.
+ * @param dev UART device supporting the asynchronous API.
+ * @param buffer Ring buffer of the stream.
+ * @param size Size of the ring buffer, split in equal chunks.
+ * @param timeout_us Inactivity period after which the data received in a
+ *                   chunk is made available, see uart_rx_enable().
+ *
+ * @retval 0 On success.
+ * @retval -EINVAL If the buffer is too small to be split in chunks.
+ */
+int uart_stream_init(struct uart_stream *stream, const struct device *dev,
+		     uint8_t *buffer, size_t size, int32_t timeout_us);
+
+/**
+ * @brief Set the callback of the other events of the UART.
+ *
+ * The stream sets the callback of the asynchronous API of the UART, the
+ * events which are not about the reception, such as the transmission
+ * events, are forwarded to this callback.
+ *
+ * @param stream The stream instance.
+ * @param callback Callback of the other events, can be NULL.
+ * @param user_data Data passed to the callback.
+ */
+void uart_stream_callback_set(struct uart_stream *stream, uart_callback_t callback,
+			      void *user_data);
+
+/**
+ * @brief Start receiving.
+ *
+ * @param stream The stream instance.
+ *
+ * @retval 0 On success.
+ * @retval -EALREADY If the stream is already receiving.
+ * @retval -errno Other negative errno value in case of failure.
+ */
+int uart_stream_start(struct uart_stream *stream);
+
+/**
+ * @brief Stop receiving.
+ *
+ * The data received until the driver is disabled can still be read.
+ *
+ * @param stream The stream instance.
+ *
+ * @retval 0 On success.
+ * @retval -EALREADY If the stream is not receiving.
+ * @retval -errno Other negative errno value in case of failure.
+ */
+int uart_stream_stop(struct uart_stream *stream);
+
+/**
+ * @brief Claim the received data without copying it.
+ *
+ * Get a pointer to the oldest received data, which is contiguous in the ring
+ * buffer, so the data may be claimed in more than one call. The data must be
+ * released with uart_stream_finish() before claiming again.
+ *
+ * When no data is left, the poll signal of the stream is reset, ready to be
+ * polled for new data.
+ *
+ * @param stream The stream instance.
+ * @param data Set to the address of the claimed data.
+ *
+ * @return Number of bytes claimed, 0 if none is available.
+ */
+size_t uart_stream_claim(struct uart_stream *stream, uint8_t **data);
+
+/**
+ * @brief Release claimed data.
+ *
+ * The chunks fully read are given back to the driver. If the reception had
+ * stopped because all of them were holding unread data, it is restarted.
+ *
+ * @param stream The stream instance.
+ * @param size Number of bytes consumed, at most the number of bytes claimed.
+ *
+ * @retval 0 On success.
+ * @retval -EINVAL If more bytes than available are released.
+ */
+int uart_stream_finish(struct uart_stream *stream, size_t size);
+
+/**
+ * @brief Copy out received data.
+ *
+ * @param stream The stream instance.
+ * @param data Destination of the data.
+ * @param size Size of the destination.
+ *
+ * @return Number of bytes copied.
+ */
+size_t uart_stream_read(struct uart_stream *stream, uint8_t *data, size_t size);
+
+/**
+ * @brief Initialize a poll event to wait for received data.
+ *
+ * The event is signaled with 0 when data is received, or with the reason of
+ * uart_rx_stop_reason when the reception stops on an error. The stream
+ * recovers on its own from such errors.
+ *
+ * @param stream The stream instance.
+ * @param event Poll event to initialize.
+ */
+static inline void uart_stream_poll_event_init(struct uart_stream *stream,
+					       struct k_poll_event *event)
+{
+	k_poll_event_init(event, K_POLL_TYPE_SIGNAL, K_POLL_MODE_NOTIFY_ONLY, &stream->signal);
+}
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_DRIVERS_SERIAL_UART_STREAM_H_ */
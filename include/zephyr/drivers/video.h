@@ -561,19 +561,55 @@ static inline int video_set_signal(const struct device *dev,
 /**
  * @brief Allocate video buffer.
  *
+ * The buffer is allocated with a single reference, held by the caller.
+ *
  * @param size Size of the video buffer.
  *
  * @retval pointer to allocated video buffer
  */
 struct video_buffer *video_buffer_alloc(size_t size);
 
+/**
+ * @brief Take a reference to a video buffer.
+ *
+ * The frame can be handed over to several consumers, such as a network
+ * connection or a display, each of them releasing its reference once done
+ * with the frame, without copying it. The buffer must not be enqueued to a
+ * driver while other references to it are held.
+ *
+ * @param buf Pointer to the video buffer.
+ *
+ * @retval The video buffer.
+ */
+struct video_buffer *video_buffer_ref(struct video_buffer *buf);
+
 /**
  * @brief Release a video buffer.
  *
+ * The buffer is freed with its last reference.
+ *
  * @param buf Pointer to the video buffer to release.
  */
 void video_buffer_release(struct video_buffer *buf);
 
+struct net_buf;
+
+/**
+ * @brief Wrap the frame of a video buffer in a network buffer.
+ *
+ * The network buffer points to the bytes used in the video buffer, and holds
+ * a reference to it until the network buffer is freed.
+ *
+ * Requires :kconfig:option:`CONFIG_VIDEO_BUFFER_NET_BUF`.
+ *
+ * @param buf Pointer to the video buffer.
+ * @param timeout Waiting period for a network buffer.
+ *
+ * @retval The network buffer, NULL if none is available within the timeout.
+ */
+struct net_buf *video_buffer_net_buf(struct video_buffer *buf,
+				     k_timeout_t timeout);
+
 
 /* fourcc - four-character-code */
 #define video_fourcc(a, b, c, d)\
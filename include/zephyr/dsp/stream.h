@@ -0,0 +1,188 @@
+/* Copyright (c) 2023 Zephyr Project
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file zephyr/dsp/stream.h
+ *
+ * @brief Public APIs for DSP block streaming
+ */
+
+#ifndef INCLUDE_ZEPHYR_DSP_STREAM_H_
+#define INCLUDE_ZEPHYR_DSP_STREAM_H_
+
+#include <errno.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <zephyr/dsp/dsp.h>
+#include <zephyr/sys/util.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @ingroup math_dsp
+ * @defgroup math_dsp_stream Block Streaming
+ *
+ * Chains of processing stages, e.g. filters, applied in place to blocks of
+ * samples. The blocks are typically allocated from a k_mem_slab, as done by
+ * the I2S and DMIC drivers, or from an RTIO mempool, and are passed from one
+ * stage to the next without being copied.
+ *
+ * Each stage keeps its own state across blocks. The state of filters grows
+ * with the block size: the ZDSP_*_STATE_LEN() macros give the size for the
+ * block size of the stream, which is the largest block it accepts.
+ * @{
+ */
+
+/**
+ * @brief Function processing a block of samples in place
+ *
+ * @param[in]     ctx        stage context, e.g. a filter instance
+ * @param[in,out] block      samples
+ * @param[in]     block_size number of samples
+ */
+typedef void (*zdsp_stage_fn_t)(void *ctx, void *block, uint32_t block_size);
+
+/**
+ * @brief Stage of a stream
+ */
+struct zdsp_stage {
+	/** Processing function */
+	zdsp_stage_fn_t fn;
+	/** Context passed to the processing function */
+	void *ctx;
+#if defined(CONFIG_DSP_STREAM_STATS) || defined(__DOXYGEN__)
+	/** Cycles spent in the processing function, see k_cycle_get_32() */
+	uint64_t cycles;
+	/** Number of blocks processed */
+	uint32_t blocks;
+#endif /* CONFIG_DSP_STREAM_STATS */
+};
+
+/**
+ * @brief Stream of blocks going through a chain of stages
+ */
+struct zdsp_stream {
+	/** Stages, in processing order */
+	struct zdsp_stage *stages;
+	/** Number of stages */
+	size_t num_stages;
+	/** Maximum number of samples in a block */
+	uint32_t block_size;
+};
+
+/**
+ * @brief Static initializer of a stage
+ *
+ * @param _fn  processing function
+ * @param _ctx context passed to the processing function
+ */
+#define ZDSP_STAGE(_fn, _ctx)                                                                      \
+	{                                                                                          \
+		.fn = (_fn), .ctx = (_ctx),                                                        \
+	}
+
+/**
+ * @brief Statically define a stream
+ *
+ * @param _name       name of the stream
+ * @param _block_size maximum number of samples in a block
+ * @param ...         stages, see ZDSP_STAGE()
+ */
+#define ZDSP_STREAM_DEFINE(_name, _block_size, ...)                                                \
+	static struct zdsp_stage _name##_stages[] = {__VA_ARGS__};                                 \
+	static struct zdsp_stream _name = {                                                        \
+		.stages = _name##_stages,                                                          \
+		.num_stages = ARRAY_SIZE(_name##_stages),                                          \
+		.block_size = (_block_size),                                                       \
+	}
+
+/**
+ * @brief Process a block through all the stages of a stream
+ *
+ * The stages are run in order, in the calling thread, and each of them
+ * processes the block in place.
+ *
+ * @param[in]     stream     stream
+ * @param[in,out] block      samples
+ * @param[in]     block_size number of samples, at most the block size of the
+ *                           stream
+ *
+ * @retval 0 on success
+ * @retval -EINVAL if the block is larger than the block size of the stream
+ */
+int zdsp_stream_process(struct zdsp_stream *stream, void *block, uint32_t block_size);
+
+#if defined(CONFIG_DSP_STREAM_STATS) || defined(__DOXYGEN__)
+/**
+ * @brief Reset the cycle counters of the stages of a stream
+ *
+ * @param[in] stream stream
+ */
+void zdsp_stream_stats_reset(struct zdsp_stream *stream);
+#endif /* CONFIG_DSP_STREAM_STATS */
+
+/** @brief Length of the state of a FIR filter, in samples */
+#define ZDSP_FIR_STATE_LEN(num_taps, block_size) ((num_taps) + (block_size) - 1)
+
+/** @brief Length of the state of a Direct Form I biquad cascade, in samples */
+#define ZDSP_BIQUAD_DF1_STATE_LEN(num_stages) (4 * (num_stages))
+
+/** @brief Length of the state of a Direct Form II transposed biquad cascade, in samples */
+#define ZDSP_BIQUAD_DF2T_STATE_LEN(num_stages) (2 * (num_stages))
+
+#if defined(CONFIG_DSP_BACKEND_CMSIS) && defined(CONFIG_CMSIS_DSP_FILTERING)
+/*
+ * Stages for the CMSIS-DSP filters, all of which can process in place.
+ * The context is the filter instance, initialized with the matching
+ * arm_*_init_*() function.
+ */
+
+static inline void zdsp_stage_fir_q15(void *ctx, void *block, uint32_t block_size)
+{
+	arm_fir_q15(ctx, block, block, block_size);
+}
+
+static inline void zdsp_stage_fir_q31(void *ctx, void *block, uint32_t block_size)
+{
+	arm_fir_q31(ctx, block, block, block_size);
+}
+
+static inline void zdsp_stage_fir_f32(void *ctx, void *block, uint32_t block_size)
+{
+	arm_fir_f32(ctx, block, block, block_size);
+}
+
+static inline void zdsp_stage_biquad_df1_q15(void *ctx, void *block, uint32_t block_size)
+{
+	arm_biquad_cascade_df1_q15(ctx, block, block, block_size);
+}
+
+static inline void zdsp_stage_biquad_df1_q31(void *ctx, void *block, uint32_t block_size)
+{
+	arm_biquad_cascade_df1_q31(ctx, block, block, block_size);
+}
+
+static inline void zdsp_stage_biquad_df1_f32(void *ctx, void *block, uint32_t block_size)
+{
+	arm_biquad_cascade_df1_f32(ctx, block, block, block_size);
+}
+
+static inline void zdsp_stage_biquad_df2t_f32(void *ctx, void *block, uint32_t block_size)
+{
+	arm_biquad_cascade_df2T_f32(ctx, block, block, block_size);
+}
+#endif /* CONFIG_DSP_BACKEND_CMSIS && CONFIG_CMSIS_DSP_FILTERING */
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INCLUDE_ZEPHYR_DSP_STREAM_H_ */
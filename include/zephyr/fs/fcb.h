@@ -82,6 +82,21 @@ struct fcb_entry_ctx {
  */
 #define FCB_FLAGS_CRC_DISABLED BIT(0)
 
+/**
+ * @brief Summary of an FCB sector
+ *
+ * Kept by FCB, with @kconfig{CONFIG_FCB_SECTOR_SUMMARY}, for the sectors which
+ * are no longer appended to.
+ */
+struct fcb_sector_summary {
+	uint32_t fss_end;
+	/**< Offset of the end of the last element, 0 if the summary is unknown */
+
+	uint32_t fss_cnt; /**< Number of valid elements */
+
+	bool fss_clean; /**< All the elements of the sector are valid */
+};
+
 /**
  * @brief FCB instance structure
  *
@@ -139,6 +154,12 @@ struct fcb {
 	const uint8_t f_flags;
 	/**< Flags for configuring the FCB. */
 #endif
+#ifdef CONFIG_FCB_SECTOR_SUMMARY
+	struct fcb_sector_summary *f_summaries;
+	/**< Array of f_sector_cnt sector summaries, filled in by FCB.
+	 * NULL if summaries should not be kept.
+	 */
+#endif
 };
 
 /**
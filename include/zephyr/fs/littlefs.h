@@ -99,6 +99,25 @@ struct fs_littlefs {
 					  CONFIG_FS_LITTLEFS_CACHE_SIZE, \
 					  CONFIG_FS_LITTLEFS_LOOKAHEAD_SIZE)
 
+/** @brief Statistics of the littlefs shared cache */
+struct fs_littlefs_cache_stats {
+	/** Number of cache lines read from RAM */
+	uint32_t hits;
+	/** Number of cache lines read from flash */
+	uint32_t misses;
+};
+
+/** @brief Get the statistics of the shared cache.
+ *
+ * Requires @kconfig{CONFIG_FS_LITTLEFS_SHARED_CACHE}.
+ *
+ * @param stats filled with the statistics since boot or the last reset.
+ */
+void fs_littlefs_cache_stats_get(struct fs_littlefs_cache_stats *stats);
+
+/** @brief Reset the statistics of the shared cache. */
+void fs_littlefs_cache_stats_reset(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -60,6 +60,30 @@ struct nvs_fs {
 #if CONFIG_NVS_LOOKUP_CACHE
 	uint32_t lookup_cache[CONFIG_NVS_LOOKUP_CACHE_SIZE];
 #endif
+#if CONFIG_NVS_LOOKUP_CACHE_EXACT
+	/** IDs of the lookup cache entries */
+	uint16_t lookup_cache_id[CONFIG_NVS_LOOKUP_CACHE_SIZE];
+	/** Flag indicating that an ID did not fit in the lookup cache */
+	bool lookup_cache_full;
+#endif
+#if CONFIG_NVS_LOOKUP_CACHE_CHECKPOINT
+	/** Number of ATEs written since the last lookup cache checkpoint */
+	uint32_t lookup_cache_ckpt_ates;
+#endif
+#if CONFIG_NVS_GC_BACKGROUND
+	/** Background garbage collection work */
+	struct k_work gc_work;
+	/** Signaled when the background erase of a sector is done */
+	struct k_condvar gc_erase_done;
+	/** Address of the sector waiting to be erased */
+	uint32_t gc_erase_addr;
+	/** Flag indicating that the sector at gc_erase_addr must be erased */
+	bool gc_erase_pending;
+	/** Flag indicating that the work queue is erasing the sector */
+	bool gc_erase_busy;
+	/** Flag indicating that an entry was written since the sector opened */
+	bool gc_written;
+#endif
 };
 
 /**
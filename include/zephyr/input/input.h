@@ -142,6 +142,34 @@ struct input_listener {
 		.callback = _callback,                                         \
 	}
 
+/**
+ * @brief Input frame listener callback structure.
+ */
+struct input_frame_listener {
+	/** @ref device pointer or NULL. */
+	const struct device *dev;
+	/** The callback function. */
+	void (*callback)(const struct input_event *evts, size_t n_evts);
+};
+
+/**
+ * @brief Register a callback structure for the input frames of a device.
+ *
+ * The callback is given the events of a device up to the one with the sync
+ * flag set, at once.
+ *
+ * Requires :kconfig:option:`CONFIG_INPUT_FRAMES`.
+ *
+ * @param _dev @ref device pointer or NULL.
+ * @param _callback The callback function.
+ */
+#define INPUT_FRAME_CALLBACK_DEFINE(_dev, _callback)                           \
+	static const STRUCT_SECTION_ITERABLE(input_frame_listener,             \
+					     _input_frame_listener__##_callback) = { \
+		.dev = _dev,                                                   \
+		.callback = _callback,                                         \
+	}
+
 #ifdef __cplusplus
 }
 #endif
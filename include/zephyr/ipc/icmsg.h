@@ -41,14 +41,28 @@ struct icmsg_config_t {
 	struct mbox_channel mbox_rx;
 };
 
+/** TX buffer reserved in the shared memory. */
+struct icmsg_tx_buf {
+	char *data;
+	/* Reserved size. */
+	uint16_t size;
+	/* Length of the message, 0 until it is sent. */
+	uint16_t len;
+};
+
 struct icmsg_data_t {
 	/* Tx/Rx buffers. */
 	struct spsc_pbuf *tx_ib;
 	struct spsc_pbuf *rx_ib;
-	atomic_t tx_buffer_state;
 #ifdef CONFIG_IPC_SERVICE_ICMSG_SHMEM_ACCESS_SYNC
 	struct k_mutex tx_lock;
 #endif
+	/* Reserved TX buffers, in the order of the reservations. */
+	struct icmsg_tx_buf tx_bufs[CONFIG_IPC_SERVICE_ICMSG_TX_BUFFERS];
+	uint8_t tx_head;
+	uint8_t tx_count;
+	/* Messages sent since the remote was last notified. */
+	uint8_t tx_unnotified;
 
 	/* Callbacks for an endpoint. */
 	const struct ipc_service_cb *cb;
@@ -123,10 +137,15 @@ int icmsg_close(const struct icmsg_config_t *conf,
  *
  *
  *  @retval 0 on success.
+ *  When TX buffers reserved with @ref icmsg_get_tx_buffer are not sent yet,
+ *  the message is held until they are, so that the remote receives the
+ *  messages in the order their buffers were reserved.
+ *
  *  @retval -EBUSY when the instance has not finished handshake with the remote
  *                 instance.
  *  @retval -ENODATA when the requested data to send is empty.
- *  @retval -EBADMSG when the requested data to send is too big.
+ *  @retval -EINVAL when the requested data to send is too big.
+ *  @retval -ENOMEM when the requested data does not fit in the free space.
  *  @retval -ENOBUFS when there are no TX buffers available.
  *  @retval other errno codes from dependent modules.
  */
@@ -161,6 +180,10 @@ int icmsg_send(const struct icmsg_config_t *conf,
  *  released by the backend), (2) when using @ref icmsg_drop_tx_buffer on a
  *  buffer not sent.
  *
+ *  Up to @kconfig{CONFIG_IPC_SERVICE_ICMSG_TX_BUFFERS} buffers can be reserved
+ *  at a time. They follow each other in the shared memory, and the messages
+ *  are received by the remote in the order the buffers were reserved.
+ *
  *  @param[in] conf Structure containing configuration parameters for the icmsg
  *                  instance.
  *  @param[inout] dev_data Structure containing run-time data used by the icmsg
@@ -171,7 +194,6 @@ int icmsg_send(const struct icmsg_config_t *conf,
  *		       maximum allowed size.
  *
  *  @retval -ENOBUFS when there are no TX buffers available.
- *  @retval -EALREADY when a buffer was already claimed and not yet released.
  *  @retval -ENOMEM when the requested size is too big (and the size parameter
  *		    contains the maximum allowed size).
  *
@@ -184,7 +206,8 @@ int icmsg_get_tx_buffer(const struct icmsg_config_t *conf,
 /** @brief Drop and release a TX buffer
  *
  *  Drop and release a TX buffer. It is possible to drop only TX buffers
- *  obtained by using @ref icmsg_get_tx_buffer.
+ *  obtained by using @ref icmsg_get_tx_buffer. When several buffers are
+ *  reserved, only the last one reserved can be dropped.
  *
  *  @param[in] conf Structure containing configuration parameters for the icmsg
  *                  instance.
@@ -192,9 +215,9 @@ int icmsg_get_tx_buffer(const struct icmsg_config_t *conf,
  *                         instance.
  *  @param[in] data Pointer to the TX buffer.
  *
- *  @retval -EALREADY when the buffer was already dropped.
- *  @retval -ENXIO when the buffer was not obtained using @ref
- *		   ipc_service_get_tx_buffer
+ *  @retval -EALREADY when the buffer was already dropped or sent, or was not
+ *		      obtained using @ref icmsg_get_tx_buffer.
+ *  @retval -EBUSY when buffers reserved after this one are not released.
  *
  *  @retval 0 on success.
  */
@@ -218,6 +241,9 @@ int icmsg_drop_tx_buffer(const struct icmsg_config_t *conf,
  *  If this function returns an error, @ref icmsg_drop_tx_buffer can be used
  *  to drop the TX buffer.
  *
+ *  A message shorter than the buffer can only be sent from the last buffer
+ *  reserved, since the buffers reserved after it start at its end.
+ *
  *  @param[in] conf Structure containing configuration parameters for the icmsg
  *                  instance.
  *  @param[inout] dev_data Structure containing run-time data used by the icmsg
@@ -233,6 +259,8 @@ int icmsg_drop_tx_buffer(const struct icmsg_config_t *conf,
  *  @retval -EBADMSG when the requested data to send is too big.
  *  @retval -ENXIO when the buffer was not obtained using @ref
  *		   ipc_service_get_tx_buffer
+ *  @retval -EINVAL when the message is shorter than a buffer reserved before
+ *		    other ones.
  *  @retval other errno codes from dependent modules.
  */
 int icmsg_send_nocopy(const struct icmsg_config_t *conf,
@@ -21,6 +21,9 @@
 #include <zephyr/toolchain.h>
 #include <zephyr/tracing/tracing_macros.h>
 #include <zephyr/sys/mem_stats.h>
+#ifdef CONFIG_KERNEL_OBJ_STATS
+#include <zephyr/kernel/obj_stats.h>
+#endif
 #include <zephyr/sys/iterable_sections.h>
 
 #ifdef __cplusplus
@@ -72,6 +75,7 @@ struct k_sem;
 struct k_msgq;
 struct k_mbox;
 struct k_pipe;
+struct k_pktq;
 struct k_queue;
 struct k_fifo;
 struct k_lifo;
@@ -434,6 +438,26 @@ static inline void k_thread_heap_assign(struct k_thread *thread,
  */
 __syscall int k_thread_stack_space_get(const struct k_thread *thread,
 				       size_t *unused_ptr);
+
+#ifdef CONFIG_STACK_WATERMARK
+/**
+ * @brief Obtain stack usage information cheaply for the specified thread
+ *
+ * This is k_thread_stack_space_get(), except that the stack is only
+ * inspected from where the previous call on the same thread found the
+ * boundary of its unused part, so the cost of a call depends on how much
+ * the stack usage grew since the previous one. Gaps in the used part of
+ * the stack of more than @kconfig{CONFIG_STACK_WATERMARK_GAP} bytes still
+ * holding the fill pattern may hide deeper usage.
+ *
+ * @param thread Thread to inspect stack information
+ * @param unused_ptr Output parameter, filled in with the unused stack space
+ *	of the target thread in bytes.
+ * @return as with k_thread_stack_space_get()
+ */
+__syscall int k_thread_stack_watermark_get(const struct k_thread *thread,
+					   size_t *unused_ptr);
+#endif
 #endif
 
 #if (CONFIG_HEAP_MEM_POOL_SIZE > 0)
@@ -878,6 +902,42 @@ __syscall void k_thread_priority_set(k_tid_t thread, int prio);
  *
  */
 __syscall void k_thread_deadline_set(k_tid_t thread, int deadline);
+
+#ifdef CONFIG_SCHED_CBS
+/**
+ * @brief Give a thread a CPU budget per period
+ *
+ * The thread becomes a constant bandwidth server: the kernel manages
+ * its deadline, and once it has run for @a budget_us within a period
+ * it is throttled, i.e. not scheduled, until the next period starts.
+ * A thread may thus never take more than budget_us / period_us of a
+ * CPU, whatever its priority and however long it stays runnable.
+ * Sleeping does not let it save up budget for later.
+ *
+ * The deadline only orders threads of the same static priority, so
+ * servers are normally given the same priority.  Admission control
+ * rejects reservations making the bandwidth of all servers exceed
+ * @kconfig{CONFIG_SCHED_CBS_MAX_UTILIZATION} percent of each CPU.
+ *
+ * Budgets are enforced at tick granularity, so the budget overrun is
+ * at most one tick per period.
+ *
+ * @note You should enable @kconfig{CONFIG_SCHED_CBS} in your project
+ * configuration.
+ *
+ * @param thread Thread to set the budget of
+ * @param budget_us Budget per period in microseconds, or 0 to remove
+ *                  the reservation of @a thread
+ * @param period_us Period in microseconds
+ *
+ * @retval 0 Reservation set.
+ * @retval -EINVAL The budget is larger than the period, or the period is
+ *                 too long for cycle-based deadlines.
+ * @retval -ENOSPC The reservation would overcommit the CPUs.
+ */
+__syscall int k_thread_cbs_set(k_tid_t thread, uint32_t budget_us,
+			       uint32_t period_us);
+#endif
 #endif
 
 #ifdef CONFIG_SCHED_CPU_MASK
@@ -1561,6 +1621,26 @@ extern void k_timer_init(struct k_timer *timer,
 __syscall void k_timer_start(struct k_timer *timer,
 			     k_timeout_t duration, k_timeout_t period);
 
+/**
+ * @brief Start a timer whose expiries may be deferred.
+ *
+ * This routine behaves like k_timer_start(), except that each expiry of
+ * the timer may be deferred by up to @a slack, so that it can be handled
+ * together with other timeouts expiring in the same window. The period
+ * is still counted from the requested expiry, so deferred expiries don't
+ * accumulate drift.
+ *
+ * The slack is ignored unless CONFIG_TIMEOUT_SLACK is enabled.
+ *
+ * @param timer     Address of timer.
+ * @param duration  Initial timer duration.
+ * @param period    Timer period.
+ * @param slack     Maximum deferral of each expiry.
+ */
+__syscall void k_timer_start_slack(struct k_timer *timer,
+				   k_timeout_t duration, k_timeout_t period,
+				   k_timeout_t slack);
+
 /**
  * @brief Stop a timer.
  *
@@ -1833,15 +1913,35 @@ struct k_queue {
 
 	_POLL_EVENT;
 
+#ifdef CONFIG_QUEUE_LOCKFREE
+	/* Items appended without taking the lock, most recent first */
+	atomic_ptr_t lockfree_head;
+	/* Number of threads pending (or about to pend) on wait_q */
+	atomic_t waiters;
+#endif
+
+#ifdef CONFIG_KERNEL_OBJ_STATS_QUEUE
+	struct k_obj_stats stats;
+#endif
+
 	SYS_PORT_TRACING_TRACKING_FIELD(k_queue)
 };
 
+#ifdef CONFIG_QUEUE_LOCKFREE
+#define Z_QUEUE_LOCKFREE_INIT \
+	.lockfree_head = ATOMIC_PTR_INIT(NULL), \
+	.waiters = ATOMIC_INIT(0),
+#else
+#define Z_QUEUE_LOCKFREE_INIT
+#endif
+
 #define Z_QUEUE_INITIALIZER(obj) \
 	{ \
 	.data_q = SYS_SFLIST_STATIC_INIT(&obj.data_q), \
 	.lock = { }, \
 	.wait_q = Z_WAIT_Q_INIT(&obj.wait_q),	\
 	_POLL_EVENT_OBJ_INIT(obj)		\
+	Z_QUEUE_LOCKFREE_INIT			\
 	}
 
 extern void *z_queue_node_peek(sys_sfnode_t *node, bool needs_free);
@@ -2067,6 +2167,11 @@ __syscall int k_queue_is_empty(struct k_queue *queue);
 
 static inline int z_impl_k_queue_is_empty(struct k_queue *queue)
 {
+#ifdef CONFIG_QUEUE_LOCKFREE
+	if (atomic_ptr_get(&queue->lockfree_head) != NULL) {
+		return 0;
+	}
+#endif
 	return (int)sys_sflist_is_empty(&queue->data_q);
 }
 
@@ -2198,15 +2303,28 @@ __syscall int k_futex_wake(struct k_futex *futex, bool wake_all);
 
 struct k_event {
 	_wait_q_t         wait_q;
+#ifdef CONFIG_EVENTS_WAITER_INDEX
+	_wait_q_t         bucket_q[CONFIG_EVENTS_WAITER_INDEX_BUCKETS];
+#endif
 	uint32_t          events;
 	struct k_spinlock lock;
 
 	SYS_PORT_TRACING_TRACKING_FIELD(k_event)
 };
 
+#ifdef CONFIG_EVENTS_WAITER_INDEX
+#define Z_EVENT_BUCKET_INIT(i, obj) Z_WAIT_Q_INIT(&obj.bucket_q[i])
+#define Z_EVENT_BUCKETS_INIT(obj) \
+	.bucket_q = { LISTIFY(CONFIG_EVENTS_WAITER_INDEX_BUCKETS, \
+			      Z_EVENT_BUCKET_INIT, (,), obj) },
+#else
+#define Z_EVENT_BUCKETS_INIT(obj)
+#endif
+
 #define Z_EVENT_INITIALIZER(obj) \
 	{ \
 	.wait_q = Z_WAIT_Q_INIT(&obj.wait_q), \
+	Z_EVENT_BUCKETS_INIT(obj) \
 	.events = 0 \
 	}
 
@@ -2882,6 +3000,11 @@ struct k_mutex {
 	/** Original thread priority */
 	int owner_orig_prio;
 
+#ifdef CONFIG_KERNEL_OBJ_STATS_MUTEX
+	/** Contention statistics */
+	struct k_obj_stats stats;
+#endif
+
 	SYS_PORT_TRACING_TRACKING_FIELD(k_mutex)
 };
 
@@ -3066,6 +3189,10 @@ struct k_sem {
 
 	_POLL_EVENT;
 
+#ifdef CONFIG_KERNEL_OBJ_STATS_SEM
+	struct k_obj_stats stats;
+#endif
+
 	SYS_PORT_TRACING_TRACKING_FIELD(k_sem)
 
 };
@@ -3148,6 +3275,22 @@ __syscall int k_sem_take(struct k_sem *sem, k_timeout_t timeout);
  */
 __syscall void k_sem_give(struct k_sem *sem);
 
+/**
+ * @brief Give a semaphore several times.
+ *
+ * This routine has the same effect as calling k_sem_give() @a n times
+ * in a row: up to @a n waiting threads are woken up, highest priority
+ * first, and whatever is left over is added to the count, which stays
+ * capped at the semaphore's limit.  The semaphore is locked and the
+ * scheduler invoked only once.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param sem Address of the semaphore.
+ * @param n Number of times to give the semaphore.
+ */
+__syscall void k_sem_give_n(struct k_sem *sem, unsigned int n);
+
 /**
  * @brief Resets a semaphore's count to zero.
  *
@@ -3417,6 +3560,82 @@ void k_work_queue_start(struct k_work_q *queue,
 			k_thread_stack_t *stack, size_t stack_size,
 			int prio, const struct k_work_queue_config *cfg);
 
+#if defined(CONFIG_WORKQUEUE_POOL) || defined(__DOXYGEN__)
+struct k_work_q_pool;
+
+/** @brief Start the work queues of a pool.
+ *
+ * The pool must have been defined with K_WORK_Q_POOL_DEFINE().  Each work
+ * queue of the pool gets its own thread.  With CONFIG_SCHED_CPU_MASK the
+ * threads are pinned to successive CPUs.
+ *
+ * @param pool pointer to the pool.
+ *
+ * @param prio initial priority of the work queue threads
+ *
+ * @param cfg optional additional configuration parameters, applied to all
+ * the work queues of the pool.  Pass @c NULL if not required.
+ */
+void k_work_q_pool_start(struct k_work_q_pool *pool, int prio,
+			 const struct k_work_queue_config *cfg);
+
+/** @brief Submit a work item to a work queue pool.
+ *
+ * The item is queued to the pool's work queue for the calling CPU, from
+ * where an idle worker of the pool may take it over.  Otherwise this
+ * behaves like k_work_submit_to_queue(), including resubmission of a running
+ * item to the queue running it.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param pool pointer to the pool.
+ *
+ * @param work pointer to the work item.
+ *
+ * @return as for k_work_submit_to_queue()
+ */
+int k_work_q_pool_submit(struct k_work_q_pool *pool, struct k_work *work);
+#endif /* CONFIG_WORKQUEUE_POOL */
+
+#if defined(CONFIG_WORKQUEUE_STATS) || defined(__DOXYGEN__)
+struct k_work_queue_stats;
+
+/** @brief Get the statistics of a work queue.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param queue pointer to the queue structure.
+ *
+ * @param stats where to store a copy of the statistics.
+ *
+ * @retval 0 on success
+ * @retval -EINVAL if a NULL pointer was passed
+ */
+int k_work_queue_stats_get(struct k_work_q *queue,
+			   struct k_work_queue_stats *stats);
+
+/** @brief Reset the statistics of a work queue.
+ *
+ * Everything but the current number of pending items is cleared, and the
+ * maximum number of pending items restarts from the current one.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param queue pointer to the queue structure.
+ */
+void k_work_queue_stats_reset(struct k_work_q *queue);
+
+/** @brief Iterate over all started work queues.
+ *
+ * @param user_cb function called for each queue.
+ *
+ * @param user_data passed to @p user_cb.
+ */
+void k_work_queue_foreach(void (*user_cb)(struct k_work_q *queue,
+					  void *user_data),
+			  void *user_data);
+#endif /* CONFIG_WORKQUEUE_STATS */
+
 /** @brief Access the thread that animates a work queue.
  *
  * This is necessary to grant a work queue thread access to things the work
@@ -3661,6 +3880,46 @@ int k_work_reschedule_for_queue(struct k_work_q *queue,
 extern int k_work_reschedule(struct k_work_delayable *dwork,
 				     k_timeout_t delay);
 
+/** @brief Submit an idle work item to the system work queue after a delay,
+ * allowing the submission to be deferred.
+ *
+ * This is k_work_schedule() where the submission may happen up to @p slack
+ * after @p delay, so that its timeout can expire together with others.
+ * The slack is ignored unless CONFIG_TIMEOUT_SLACK is enabled.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param dwork pointer to the delayable work item.
+ *
+ * @param delay the time to wait before submitting the work item.
+ *
+ * @param slack the maximum additional delay.
+ *
+ * @return as with k_work_schedule_for_queue().
+ */
+int k_work_schedule_slack(struct k_work_delayable *dwork,
+			  k_timeout_t delay, k_timeout_t slack);
+
+/** @brief Reschedule a work item to the system work queue after a delay,
+ * allowing the submission to be deferred.
+ *
+ * This is k_work_reschedule() where the submission may happen up to
+ * @p slack after @p delay, so that its timeout can expire together with
+ * others.  The slack is ignored unless CONFIG_TIMEOUT_SLACK is enabled.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param dwork pointer to the delayable work item.
+ *
+ * @param delay the time to wait before submitting the work item.
+ *
+ * @param slack the maximum additional delay.
+ *
+ * @return as with k_work_reschedule_for_queue().
+ */
+int k_work_reschedule_slack(struct k_work_delayable *dwork,
+			    k_timeout_t delay, k_timeout_t slack);
+
 /** @brief Flush delayable work.
  *
  * If the work is scheduled, it is immediately submitted.  Then the caller
@@ -3834,6 +4093,11 @@ struct k_work {
 	 * It can be RUNNING and CANCELING simultaneously.
 	 */
 	uint32_t flags;
+
+#ifdef CONFIG_WORKQUEUE_STATS
+	/* Cycle count when the item was last queued. */
+	uint32_t queued_cycles;
+#endif
 };
 
 #define Z_WORK_INITIALIZER(work_handler) { \
@@ -3959,6 +4223,49 @@ struct k_work_queue_config {
 	bool no_yield;
 };
 
+#if defined(CONFIG_WORKQUEUE_STATS) || defined(__DOXYGEN__)
+/** @brief Statistics about one work handler function of a work queue. */
+struct k_work_handler_stats {
+	/** The handler, NULL if the entry is unused. */
+	k_work_handler_t handler;
+
+	/** Number of times the handler ran. */
+	uint32_t count;
+
+	/** Longest run of the handler, in hardware cycles. */
+	uint32_t max_cycles;
+
+	/** Total time spent in the handler, in hardware cycles. */
+	uint64_t total_cycles;
+};
+
+/** @brief Statistics about a work queue.
+ *
+ * The histograms have power-of-two buckets in microseconds: bucket 0
+ * counts values under 1 us, bucket i values under 2^i us that don't fit
+ * a lower bucket, and the last bucket all longer values.
+ */
+struct k_work_queue_stats {
+	/** Time from submission to start of the handler. */
+	uint32_t latency_hist[CONFIG_WORKQUEUE_STATS_HIST_BUCKETS];
+
+	/** Time spent in the handler. */
+	uint32_t runtime_hist[CONFIG_WORKQUEUE_STATS_HIST_BUCKETS];
+
+	/** Number of items currently pending. */
+	uint32_t depth;
+
+	/** Largest number of items pending at once. */
+	uint32_t max_depth;
+
+	/** Tally of the first handlers seen. */
+	struct k_work_handler_stats handlers[CONFIG_WORKQUEUE_STATS_HANDLERS];
+
+	/** Number of items run whose handler didn't fit in @c handlers. */
+	uint32_t other_handlers;
+};
+#endif /* CONFIG_WORKQUEUE_STATS */
+
 /** @brief A structure used to hold work until it can be processed. */
 struct k_work_q {
 	/* The thread that animates the work. */
@@ -3979,8 +4286,58 @@ struct k_work_q {
 
 	/* Flags describing queue state. */
 	uint32_t flags;
+
+#ifdef CONFIG_WORKQUEUE_POOL
+	/* Pool sharing work with this queue, if any. */
+	struct k_work_q_pool *pool;
+#endif
+
+#ifdef CONFIG_WORKQUEUE_STATS
+	/* Node in the list of started queues. */
+	sys_snode_t stats_node;
+
+	struct k_work_queue_stats stats;
+#endif
 };
 
+#if defined(CONFIG_WORKQUEUE_POOL) || defined(__DOXYGEN__)
+/** @brief A set of work queues sharing their work. */
+struct k_work_q_pool {
+	/* The work queues of the pool. */
+	struct k_work_q *queues;
+
+	/* Their thread stacks, stack_stride bytes apart. */
+	k_thread_stack_t *stacks;
+	size_t stack_size;
+	size_t stack_stride;
+
+	/* Number of work queues. */
+	uint8_t num_queues;
+};
+
+/**
+ * @brief Statically define a work queue pool.
+ *
+ * The pool still has to be started with k_work_q_pool_start().
+ *
+ * @param name name of the pool.
+ * @param n number of work queues in the pool.
+ * @param size stack size of each work queue thread.
+ */
+#define K_WORK_Q_POOL_DEFINE(name, n, size)				\
+	static struct k_work_q _k_work_q_pool_queues_##name[n];		\
+	static K_THREAD_STACK_ARRAY_DEFINE(_k_work_q_pool_stacks_##name,	\
+					   n, size);			\
+	struct k_work_q_pool name = {					\
+		.queues = _k_work_q_pool_queues_##name,			\
+		.stacks = _k_work_q_pool_stacks_##name[0],		\
+		.stack_size = K_THREAD_STACK_SIZEOF(			\
+			_k_work_q_pool_stacks_##name[0]),		\
+		.stack_stride = sizeof(_k_work_q_pool_stacks_##name[0]),	\
+		.num_queues = (n),					\
+	}
+#endif /* CONFIG_WORKQUEUE_POOL */
+
 /* Provide the implementation for inline functions declared above */
 
 static inline bool k_work_is_pending(const struct k_work *work)
@@ -4379,6 +4736,11 @@ struct k_msgq {
 	/** Message queue */
 	uint8_t flags;
 
+#ifdef CONFIG_KERNEL_OBJ_STATS_MSGQ
+	/** Contention statistics */
+	struct k_obj_stats stats;
+#endif
+
 	SYS_PORT_TRACING_TRACKING_FIELD(k_msgq)
 };
 /**
@@ -4807,6 +5169,8 @@ struct k_pipe {
 	size_t         bytes_used;      /**< # bytes used in buffer */
 	size_t         read_index;      /**< Where in buffer to read from */
 	size_t         write_index;     /**< Where in buffer to write */
+	size_t         put_claimed;     /**< # bytes claimed for writing */
+	size_t         get_claimed;     /**< # bytes claimed for reading */
 	struct k_spinlock lock;		/**< Synchronization lock */
 
 	struct {
@@ -4818,6 +5182,10 @@ struct k_pipe {
 
 	uint8_t	       flags;		/**< Flags */
 
+#ifdef CONFIG_KERNEL_OBJ_STATS_PIPE
+	struct k_obj_stats stats;	/**< Contention statistics */
+#endif
+
 	SYS_PORT_TRACING_TRACKING_FIELD(k_pipe)
 };
 
@@ -4833,6 +5201,8 @@ struct k_pipe {
 	.bytes_used = 0,                                            \
 	.read_index = 0,                                            \
 	.write_index = 0,                                           \
+	.put_claimed = 0,                                           \
+	.get_claimed = 0,                                           \
 	.lock = {},                                                 \
 	.wait_q = {                                                 \
 		.readers = Z_WAIT_Q_INIT(&obj.wait_q.readers),       \
@@ -4973,6 +5343,95 @@ __syscall size_t k_pipe_read_avail(struct k_pipe *pipe);
  */
 __syscall size_t k_pipe_write_avail(struct k_pipe *pipe);
 
+/**
+ * @brief Claim space in the pipe buffer for writing in place.
+ *
+ * This routine returns a pointer to the contiguous free area of the pipe
+ * buffer that follows any area already claimed, so that the caller can
+ * produce data directly into it.  The data becomes readable once it is
+ * committed with k_pipe_put_commit().  Claims accumulate until the next
+ * commit.
+ *
+ * While space is claimed, k_pipe_put() doesn't write any data and
+ * k_pipe_get() doesn't take data from waiting writers, so that no data
+ * overtakes the claimed space.
+ *
+ * @note Not available from user mode, as the pipe buffer is kernel memory.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param pipe Address of the pipe.
+ * @param data Address of the pointer to set to the claimed area.
+ * @param size Requested number of bytes.
+ *
+ * @return Number of bytes claimed, possibly less than @a size, and zero
+ *         if the buffer is full or the pipe is unbuffered.
+ */
+size_t k_pipe_put_claim(struct k_pipe *pipe, unsigned char **data,
+			size_t size);
+
+/**
+ * @brief Commit data written in place into the pipe buffer.
+ *
+ * This routine makes the first @a size bytes of the area claimed with
+ * k_pipe_put_claim() readable, hands them to waiting readers, and
+ * releases the rest of the claim.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param pipe Address of the pipe.
+ * @param size Number of bytes written, at most the number claimed.
+ *
+ * @retval 0 Data committed.
+ * @retval -EINVAL @a size exceeds the number of bytes claimed.
+ */
+int k_pipe_put_commit(struct k_pipe *pipe, size_t size);
+
+/**
+ * @brief Claim data in the pipe buffer for reading in place.
+ *
+ * This routine returns a pointer to the contiguous readable area of the
+ * pipe buffer that follows any area already claimed, so that the caller
+ * can consume data directly from it.  The space is released once it is
+ * finished with k_pipe_get_finish().  Claims accumulate until the next
+ * finish.
+ *
+ * While data is claimed, k_pipe_get() doesn't read any data and
+ * k_pipe_put() only writes to the pipe buffer, so that no data overtakes
+ * the claimed data; the claiming thread is expected to be the only reader
+ * of the pipe.
+ *
+ * @note Not available from user mode, as the pipe buffer is kernel memory.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param pipe Address of the pipe.
+ * @param data Address of the pointer to set to the claimed area.
+ * @param size Requested number of bytes.
+ *
+ * @return Number of bytes claimed, possibly less than @a size, and zero
+ *         if the buffer is empty or the pipe is unbuffered.
+ */
+size_t k_pipe_get_claim(struct k_pipe *pipe, unsigned char **data,
+			size_t size);
+
+/**
+ * @brief Release data read in place from the pipe buffer.
+ *
+ * This routine frees the first @a size bytes of the area claimed with
+ * k_pipe_get_claim(), refills the buffer from waiting writers, and
+ * releases the rest of the claim.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param pipe Address of the pipe.
+ * @param size Number of bytes consumed, at most the number claimed.
+ *
+ * @retval 0 Data released.
+ * @retval -EINVAL @a size exceeds the number of bytes claimed.
+ */
+int k_pipe_get_finish(struct k_pipe *pipe, size_t size);
+
 /**
  * @brief Flush the pipe of write data
  *
@@ -5004,6 +5463,15 @@ __syscall void k_pipe_buffer_flush(struct k_pipe *pipe);
  * @cond INTERNAL_HIDDEN
  */
 
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+/* Per-CPU magazine of free blocks of a memory slab */
+struct z_mem_slab_cpu_cache {
+	struct k_spinlock lock;
+	char *free_list;
+	uint32_t count;
+};
+#endif
+
 struct k_mem_slab {
 	_wait_q_t wait_q;
 	struct k_spinlock lock;
@@ -5011,10 +5479,25 @@ struct k_mem_slab {
 	size_t block_size;
 	char *buffer;
 	char *free_list;
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	/* Updated outside of the slab lock by the per-CPU caches */
+	atomic_t num_used;
+#ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
+	atomic_t max_used;
+#endif
+	/* Number of threads that may be about to wait for a block */
+	atomic_t waiters;
+	struct z_mem_slab_cpu_cache cpu_cache[CONFIG_MP_MAX_NUM_CPUS];
+#else
 	uint32_t num_used;
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
 	uint32_t max_used;
 #endif
+#endif
+
+#ifdef CONFIG_KERNEL_OBJ_STATS_MEM_SLAB
+	struct k_obj_stats stats;
+#endif
 
 	SYS_PORT_TRACING_TRACKING_FIELD(k_mem_slab)
 };
@@ -5167,7 +5650,11 @@ extern void k_mem_slab_free(struct k_mem_slab *slab, void **mem);
  */
 static inline uint32_t k_mem_slab_num_used_get(struct k_mem_slab *slab)
 {
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	return (uint32_t)atomic_get(&slab->num_used);
+#else
 	return slab->num_used;
+#endif
 }
 
 /**
@@ -5182,7 +5669,10 @@ static inline uint32_t k_mem_slab_num_used_get(struct k_mem_slab *slab)
  */
 static inline uint32_t k_mem_slab_max_used_get(struct k_mem_slab *slab)
 {
-#ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
+#if defined(CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION) && \
+	defined(CONFIG_MEM_SLAB_CPU_CACHE)
+	return (uint32_t)atomic_get(&slab->max_used);
+#elif defined(CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION)
 	return slab->max_used;
 #else
 	ARG_UNUSED(slab);
@@ -5202,7 +5692,7 @@ static inline uint32_t k_mem_slab_max_used_get(struct k_mem_slab *slab)
  */
 static inline uint32_t k_mem_slab_num_free_get(struct k_mem_slab *slab)
 {
-	return slab->num_blocks - slab->num_used;
+	return slab->num_blocks - k_mem_slab_num_used_get(slab);
 }
 
 /**
@@ -5241,10 +5731,28 @@ int k_mem_slab_runtime_stats_reset_max(struct k_mem_slab *slab);
 
 /* kernel synchronized heap struct */
 
+#ifdef CONFIG_KHEAP_CPU_CACHE
+#define Z_KHEAP_CACHE_CLASSES (DIV_ROUND_UP(CONFIG_KHEAP_CPU_CACHE_MAX_SIZE, 8) + 1)
+
+/* Per-CPU cache of freed blocks of a k_heap, one list per usable size
+ * in 8 byte units.
+ */
+struct z_heap_cpu_cache {
+	struct k_spinlock lock;
+	void *lists[Z_KHEAP_CACHE_CLASSES];
+	uint32_t count;
+};
+#endif
+
 struct k_heap {
 	struct sys_heap heap;
 	_wait_q_t wait_q;
 	struct k_spinlock lock;
+#ifdef CONFIG_KHEAP_CPU_CACHE
+	/* Number of threads that may be about to wait for memory */
+	atomic_t waiters;
+	struct z_heap_cpu_cache cpu_cache[CONFIG_MP_MAX_NUM_CPUS];
+#endif
 };
 
 /**
@@ -5485,6 +5993,9 @@ enum _poll_types_bits {
 	/* pipe data availability */
 	_POLL_TYPE_PIPE_DATA_AVAILABLE,
 
+	/* packet queue data availability */
+	_POLL_TYPE_PKTQ_DATA_AVAILABLE,
+
 	_POLL_NUM_TYPES
 };
 
@@ -5513,6 +6024,9 @@ enum _poll_states_bits {
 	/* data is available to read from a pipe */
 	_POLL_STATE_PIPE_DATA_AVAILABLE,
 
+	/* a packet is available to read from a packet queue */
+	_POLL_STATE_PKTQ_DATA_AVAILABLE,
+
 	_POLL_NUM_STATES
 };
 
@@ -5545,6 +6059,7 @@ enum _poll_states_bits {
 #define K_POLL_TYPE_FIFO_DATA_AVAILABLE K_POLL_TYPE_DATA_AVAILABLE
 #define K_POLL_TYPE_MSGQ_DATA_AVAILABLE Z_POLL_TYPE_BIT(_POLL_TYPE_MSGQ_DATA_AVAILABLE)
 #define K_POLL_TYPE_PIPE_DATA_AVAILABLE Z_POLL_TYPE_BIT(_POLL_TYPE_PIPE_DATA_AVAILABLE)
+#define K_POLL_TYPE_PKTQ_DATA_AVAILABLE Z_POLL_TYPE_BIT(_POLL_TYPE_PKTQ_DATA_AVAILABLE)
 
 /* public - polling modes */
 enum k_poll_modes {
@@ -5562,6 +6077,7 @@ enum k_poll_modes {
 #define K_POLL_STATE_FIFO_DATA_AVAILABLE K_POLL_STATE_DATA_AVAILABLE
 #define K_POLL_STATE_MSGQ_DATA_AVAILABLE Z_POLL_STATE_BIT(_POLL_STATE_MSGQ_DATA_AVAILABLE)
 #define K_POLL_STATE_PIPE_DATA_AVAILABLE Z_POLL_STATE_BIT(_POLL_STATE_PIPE_DATA_AVAILABLE)
+#define K_POLL_STATE_PKTQ_DATA_AVAILABLE Z_POLL_STATE_BIT(_POLL_STATE_PKTQ_DATA_AVAILABLE)
 #define K_POLL_STATE_CANCELLED Z_POLL_STATE_BIT(_POLL_STATE_CANCELLED)
 
 /* public - poll signal object */
@@ -5621,6 +6137,9 @@ struct k_poll_event {
 		struct k_msgq *msgq;
 #ifdef CONFIG_PIPES
 		struct k_pipe *pipe;
+#endif
+#ifdef CONFIG_PKTQ
+		struct k_pktq *pktq;
 #endif
 	};
 };
@@ -5770,6 +6289,84 @@ __syscall void k_poll_signal_check(struct k_poll_signal *sig,
 
 __syscall int k_poll_signal_raise(struct k_poll_signal *sig, int result);
 
+/**
+ * @brief Persistent poll event set
+ *
+ * A set of poll events registered once with k_poll_set_init(), and then
+ * waited for any number of times with k_poll_set_wait(). Unlike with
+ * k_poll(), the events stay registered on their objects between waits,
+ * and a wait only returns the events that triggered: its cost depends on
+ * the number of triggered events, not on the size of the set.
+ */
+struct k_poll_set {
+	/** @cond INTERNAL_HIDDEN */
+	struct z_poller poller;
+	_wait_q_t wait_q;
+	struct k_poll_event *events;
+	int num_events;
+	/* Triggered events, not returned yet */
+	sys_dlist_t ready;
+	/* Events returned by the last wait, armed again by the next one */
+	sys_dlist_t returned;
+	/** @endcond */
+};
+
+/**
+ * @brief Initialize a persistent poll event set
+ *
+ * Registers all the events of @p events on their objects. Events whose
+ * condition is already met are immediately ready.
+ *
+ * @note Only available to supervisor threads.
+ *
+ * @param set The poll event set to initialize.
+ * @param events The events of the set, initialized with
+ *               k_poll_event_init(), which belong to the set until
+ *               k_poll_set_cleanup() is called.
+ * @param num_events The number of events in the array.
+ */
+void k_poll_set_init(struct k_poll_set *set, struct k_poll_event *events,
+		     int num_events);
+
+/**
+ * @brief Wait for events of a persistent poll event set
+ *
+ * Waits until at least one event of @p set has triggered, and returns up to
+ * @p max_ready triggered events, whose state field tells what happened as
+ * with k_poll(). Events are returned in the order in which they triggered,
+ * those that do not fit in @p ready are returned by the next call.
+ *
+ * The returned events are not watched until the next call, which arms them
+ * again: an event whose condition is still met at that point (e.g. a
+ * semaphore that was not taken) is then immediately returned again. The
+ * state field of these events is reset by the next call, it must not be
+ * reset by the caller.
+ *
+ * @note Only available to supervisor threads.
+ *
+ * @param set The poll event set.
+ * @param ready Array filled with pointers to the triggered events.
+ * @param max_ready The size of the @p ready array.
+ * @param timeout Waiting period for an event to trigger,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @return The number of events stored in @p ready (at least 1).
+ * @retval -EAGAIN Waiting period timed out.
+ */
+int k_poll_set_wait(struct k_poll_set *set, struct k_poll_event **ready,
+		    int max_ready, k_timeout_t timeout);
+
+/**
+ * @brief Tear down a persistent poll event set
+ *
+ * Unregisters the events of @p set from their objects, after which both
+ * the set and its events may be reused or discarded. No thread may be
+ * waiting on the set.
+ *
+ * @param set The poll event set.
+ */
+void k_poll_set_cleanup(struct k_poll_set *set);
+
 /**
  * @internal
  */
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_KERNEL_BOOT_PROFILE_H_
+#define ZEPHYR_INCLUDE_KERNEL_BOOT_PROFILE_H_
+
+#include <stdint.h>
+#include <zephyr/init.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Boot profile
+ * @defgroup boot_profile Boot profile
+ * @ingroup kernel_apis
+ *
+ * With CONFIG_BOOT_PROFILE the kernel timestamps the BSS clearing, the data
+ * copy, each init level and init function, and the call to main(). The spans
+ * are kept in a no-init section, so that they stay readable until the next
+ * boot starts recording again.
+ *
+ * @{
+ */
+
+/** @brief Step of the boot recorded by the boot profile */
+enum boot_profile_step {
+	/** BSS clearing */
+	BOOT_PROFILE_BSS_ZERO,
+	/** Copy of the data section from ROM */
+	BOOT_PROFILE_DATA_COPY,
+	/** Init level, see @ref boot_profile_span.level */
+	BOOT_PROFILE_LEVEL,
+	/** Init function, see @ref boot_profile_span.entry */
+	BOOT_PROFILE_INIT,
+	/** Call to main(), an empty span */
+	BOOT_PROFILE_MAIN,
+};
+
+/** @brief Span of time taken by a step of the boot */
+struct boot_profile_span {
+	/** Init entry of a @ref BOOT_PROFILE_INIT span, NULL otherwise */
+	const struct init_entry *entry;
+	/** Cycle count at the start of the step */
+	uint32_t start_cycles;
+	/** Cycle count at the end of the step */
+	uint32_t end_cycles;
+	/** Step, see @ref boot_profile_step */
+	uint8_t step;
+	/** Init level of a @ref BOOT_PROFILE_LEVEL or @ref BOOT_PROFILE_INIT span */
+	uint8_t level;
+};
+
+#if defined(CONFIG_BOOT_PROFILE) || defined(__DOXYGEN__)
+
+/** @brief Callback called for each span of the boot profile */
+typedef void (*boot_profile_cb_t)(const struct boot_profile_span *span,
+				  void *user_data);
+
+/**
+ * @brief Iterate over the boot profile.
+ *
+ * Spans are listed in the order in which they started.
+ *
+ * @param cb Callback called for each span.
+ * @param user_data User data passed to the callback.
+ *
+ * @return Number of spans that could not be recorded, the records being all
+ * used.
+ */
+int boot_profile_foreach(boot_profile_cb_t cb, void *user_data);
+
+/**
+ * @brief Read the cycle counter timestamping the boot profile.
+ *
+ * The default implementation returns 0 until the system timer is initialized,
+ * at the end of the PRE_KERNEL_2 level, then k_cycle_get_32(). SoCs with a
+ * cycle counter running from reset can override it to time the early boot,
+ * its rate having to be the one of k_cycle_get_32().
+ *
+ * @return Cycle count.
+ */
+uint32_t z_boot_profile_cycles(void);
+
+#endif /* CONFIG_BOOT_PROFILE */
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_KERNEL_BOOT_PROFILE_H_ */
@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_KERNEL_OBJ_STATS_H_
+#define ZEPHYR_INCLUDE_KERNEL_OBJ_STATS_H_
+
+#include <zephyr/spinlock.h>
+#include <zephyr/sys/slist.h>
+#include <zephyr/stats/stats.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Kernel object statistics
+ * @defgroup kernel_obj_stats Kernel object statistics
+ * @ingroup kernel_apis
+ *
+ * The semaphores, mutexes, message queues, pipes, queues and memory slabs
+ * selected with CONFIG_KERNEL_OBJ_STATS_* count, on their slow paths, how
+ * often they are found unavailable and how long the threads pend on them.
+ * The counters of an object registered with k_obj_stats_register() are a
+ * group of the statistics subsystem.
+ *
+ * @{
+ */
+
+#if defined(CONFIG_KERNEL_OBJ_STATS) || defined(__DOXYGEN__)
+
+/** @brief Counters of a kernel object, a group of the statistics subsystem */
+STATS_SECT_START(k_obj)
+	/** Times the object was found unavailable */
+	STATS_SECT_ENTRY64(contentions)
+	/** Times a thread pended on the object */
+	STATS_SECT_ENTRY64(pends)
+	/** Total time pended on the object in microseconds */
+	STATS_SECT_ENTRY64(wait_us)
+	/** Longest time pended on the object in microseconds */
+	STATS_SECT_ENTRY64(max_wait_us)
+STATS_SECT_END;
+
+/** @brief Statistics of a kernel object */
+struct k_obj_stats {
+	/** Counters of the object */
+	STATS_SECT_DECL(k_obj) counters;
+	/** @cond INTERNAL_HIDDEN */
+	struct k_spinlock lock;
+	sys_snode_t node;
+	/** @endcond */
+};
+
+/**
+ * @brief Register the statistics of a kernel object.
+ *
+ * The counters are reset, then listed under @a name by the statistics
+ * subsystem and by k_obj_stats_foreach(). Object statistics are not
+ * unregistered: the object must not be deleted afterwards.
+ *
+ * @param stats Statistics of the object, such as &sem.stats.
+ * @param name Name of the statistics group, which must remain valid.
+ *
+ * @retval 0 on success.
+ * @retval -EALREADY if a group of the same name is already registered.
+ */
+int k_obj_stats_register(struct k_obj_stats *stats, const char *name);
+
+/**
+ * @brief Register the statistics of a kernel object.
+ *
+ * @param obj Kernel object, such as &sem.
+ * @param name Name of the statistics group, which must remain valid.
+ *
+ * @return See k_obj_stats_register().
+ */
+#define K_OBJ_STATS_REGISTER(obj, name) \
+	k_obj_stats_register(&(obj)->stats, (name))
+
+/** @brief Callback called for each registered kernel object */
+typedef void (*k_obj_stats_user_cb_t)(const char *name,
+				      const STATS_SECT_DECL(k_obj) *counters,
+				      void *user_data);
+
+/**
+ * @brief Iterate over the registered kernel object statistics.
+ *
+ * The callback is given a consistent copy of the counters of each object.
+ *
+ * @param user_cb Callback called for each registered object.
+ * @param user_data User data passed to the callback.
+ */
+void k_obj_stats_foreach(k_obj_stats_user_cb_t user_cb, void *user_data);
+
+#endif /* CONFIG_KERNEL_OBJ_STATS */
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_KERNEL_OBJ_STATS_H_ */
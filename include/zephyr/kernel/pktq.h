@@ -0,0 +1,229 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ *
+ * @brief Packet queue kernel objects.
+ */
+
+#ifndef ZEPHYR_INCLUDE_KERNEL_PKTQ_H_
+#define ZEPHYR_INCLUDE_KERNEL_PKTQ_H_
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/mpsc_pbuf.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Packet Queue APIs
+ * @defgroup pktq_apis Packet Queue APIs
+ * @ingroup kernel_apis
+ * @{
+ */
+
+/**
+ * @brief Packet Queue Structure
+ */
+struct k_pktq {
+	/** Packet buffer */
+	struct mpsc_pbuf_buffer buf;
+	/** Threads waiting for a packet */
+	_wait_q_t wait_q;
+	/** Lock */
+	struct k_spinlock lock;
+	/** Packet claimed but not yet handed to the reader */
+	const union mpsc_pbuf_generic *pending;
+
+	_POLL_EVENT;
+};
+
+/**
+ * @cond INTERNAL_HIDDEN
+ */
+
+/* Header word in front of every packet */
+struct z_pktq_hdr {
+	MPSC_PBUF_HDR;
+	uint32_t len: 32 - MPSC_PBUF_HDR_BITS;
+};
+
+uint32_t z_pktq_get_wlen(const union mpsc_pbuf_generic *packet);
+
+static inline bool z_pktq_is_pending(struct k_pktq *pktq)
+{
+	return (pktq->pending != NULL) || mpsc_pbuf_is_pending(&pktq->buf);
+}
+
+#define Z_PKTQ_INITIALIZER(obj, q_buffer, q_wlen) \
+	{ \
+	.buf = { \
+		.flags = IS_POWER_OF_TWO(q_wlen) ? MPSC_PBUF_SIZE_POW2 : 0, \
+		.get_wlen = z_pktq_get_wlen, \
+		.buf = q_buffer, \
+		.size = q_wlen, \
+		.sem = Z_SEM_INITIALIZER(obj.buf.sem, 0, 1), \
+	}, \
+	.wait_q = Z_WAIT_Q_INIT(&obj.wait_q), \
+	.pending = NULL, \
+	_POLL_EVENT_OBJ_INIT(obj) \
+	}
+
+/**
+ * INTERNAL_HIDDEN @endcond
+ */
+
+/**
+ * @brief Statically define and initialize a packet queue.
+ *
+ * The packet queue can be accessed outside the module where it is defined
+ * using:
+ *
+ * @code extern struct k_pktq <name>; @endcode
+ *
+ * Every packet takes a 4 byte header plus its length rounded up to a
+ * multiple of 4 bytes in the buffer.
+ *
+ * @param q_name Name of the packet queue.
+ * @param q_size Size of the packet queue buffer (in bytes), a multiple of 4.
+ */
+#define K_PKTQ_DEFINE(q_name, q_size) \
+	static uint32_t __noinit \
+		_k_pktq_buf_##q_name[(q_size) / sizeof(uint32_t)]; \
+	struct k_pktq q_name = \
+		Z_PKTQ_INITIALIZER(q_name, _k_pktq_buf_##q_name, \
+				   (q_size) / sizeof(uint32_t))
+
+/**
+ * @brief Initialize a packet queue.
+ *
+ * @param pktq Address of the packet queue.
+ * @param buffer Pointer to a 4 byte aligned buffer for the packets.
+ * @param size Size of @a buffer (in bytes), a multiple of 4.
+ */
+void k_pktq_init(struct k_pktq *pktq, void *buffer, size_t size);
+
+/**
+ * @brief Allocate space for a packet in a packet queue.
+ *
+ * The space is reserved in the packet queue buffer and must be filled in
+ * and handed to the reader with k_pktq_commit(). Several packets may be
+ * allocated before committing them, the reader gets packets in the order
+ * they were allocated.
+ *
+ * @funcprops \isr_ok
+ *
+ * @note Not available from user mode, use k_pktq_put() instead.
+ *
+ * @param pktq Address of the packet queue.
+ * @param len Length of the packet (in bytes).
+ * @param timeout Waiting period for space in the packet queue, or one of
+ *                the special values K_NO_WAIT and K_FOREVER. Must be
+ *                K_NO_WAIT when called from an ISR.
+ *
+ * @return 4 byte aligned address of the packet data, or NULL if no space
+ *         could be allocated.
+ */
+void *k_pktq_alloc(struct k_pktq *pktq, size_t len, k_timeout_t timeout);
+
+/**
+ * @brief Commit a packet to a packet queue.
+ *
+ * Makes a packet allocated with k_pktq_alloc() available to the reader and
+ * wakes it up.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param pktq Address of the packet queue.
+ * @param data Packet data returned by k_pktq_alloc().
+ */
+void k_pktq_commit(struct k_pktq *pktq, void *data);
+
+/**
+ * @brief Claim the oldest packet of a packet queue.
+ *
+ * The packet is read in place in the packet queue buffer, and must be
+ * released with k_pktq_free() once it is no longer needed. A packet queue
+ * has a single reader.
+ *
+ * @funcprops \isr_ok
+ *
+ * @note Not available from user mode, use k_pktq_get() instead.
+ *
+ * @param pktq Address of the packet queue.
+ * @param len Address where the length of the packet is stored.
+ * @param timeout Waiting period for a packet, or one of the special values
+ *                K_NO_WAIT and K_FOREVER. Must be K_NO_WAIT when called
+ *                from an ISR.
+ *
+ * @return Address of the packet data, or NULL if no packet was available.
+ */
+const void *k_pktq_claim(struct k_pktq *pktq, size_t *len,
+			 k_timeout_t timeout);
+
+/**
+ * @brief Release a packet claimed from a packet queue.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param pktq Address of the packet queue.
+ * @param data Packet data returned by k_pktq_claim().
+ */
+void k_pktq_free(struct k_pktq *pktq, const void *data);
+
+/**
+ * @brief Copy a packet into a packet queue.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param pktq Address of the packet queue.
+ * @param data Pointer to the packet data.
+ * @param len Length of the packet (in bytes).
+ * @param timeout Waiting period for space in the packet queue, or one of
+ *                the special values K_NO_WAIT and K_FOREVER. Must be
+ *                K_NO_WAIT when called from an ISR.
+ *
+ * @retval 0 Packet queued.
+ * @retval -ENOMSG Returned without waiting.
+ * @retval -EAGAIN Waiting period timed out.
+ * @retval -EINVAL Packet does not fit in the packet queue buffer.
+ */
+__syscall int k_pktq_put(struct k_pktq *pktq, const void *data, size_t len,
+			 k_timeout_t timeout);
+
+/**
+ * @brief Copy the oldest packet out of a packet queue.
+ *
+ * A packet that does not fit in @a data is left in the packet queue.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param pktq Address of the packet queue.
+ * @param data Address of the area to hold the packet.
+ * @param size Size of @a data (in bytes).
+ * @param timeout Waiting period for a packet, or one of the special values
+ *                K_NO_WAIT and K_FOREVER. Must be K_NO_WAIT when called
+ *                from an ISR.
+ *
+ * @return Length of the packet on success, or
+ * @retval -ENOMSG Returned without waiting.
+ * @retval -EAGAIN Waiting period timed out.
+ * @retval -EMSGSIZE The packet is larger than @a size.
+ */
+__syscall int k_pktq_get(struct k_pktq *pktq, void *data, size_t size,
+			 k_timeout_t timeout);
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#include <syscalls/pktq.h>
+
+#endif /* ZEPHYR_INCLUDE_KERNEL_PKTQ_H_ */
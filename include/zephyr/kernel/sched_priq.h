@@ -44,15 +44,21 @@ void z_priq_rb_remove(struct _priq_rb *pq, struct k_thread *thread);
 struct k_thread *z_priq_rb_best(struct _priq_rb *pq);
 
 /* Traditional/textbook "multi-queue" structure.  Separate lists for a
- * small number (max 32 here) of fixed priorities.  This corresponds
- * to the original Zephyr scheduler.  RAM requirements are
- * comparatively high, but performance is very fast.  Won't work with
- * features like deadline scheduling which need large priority spaces
- * to represent their requirements.
+ * small number of fixed priorities, with a bitmap of the non-empty ones
+ * for O(1) lookup of the best thread.  This corresponds to the original
+ * Zephyr scheduler.  RAM requirements are comparatively high, but
+ * performance is very fast.  With deadline scheduling, threads of the
+ * same priority are kept sorted by deadline within their list, which
+ * makes insertion O(N) in the number of threads of that priority only.
  */
+#define Z_PRIQ_MQ_NUM_PRIO (CONFIG_NUM_COOP_PRIORITIES + \
+			    CONFIG_NUM_PREEMPT_PRIORITIES + 1)
+#define Z_PRIQ_MQ_BITMAP_SIZE DIV_ROUND_UP(Z_PRIQ_MQ_NUM_PRIO, 32)
+
 struct _priq_mq {
-	sys_dlist_t queues[32];
-	unsigned int bitmask; /* bit 1<<i set if queues[i] is non-empty */
+	sys_dlist_t queues[Z_PRIQ_MQ_NUM_PRIO];
+	/* bit (i % 32) of bitmask[i / 32] set if queues[i] is non-empty */
+	uint32_t bitmask[Z_PRIQ_MQ_BITMAP_SIZE];
 };
 
 struct k_thread *z_priq_mq_best(struct _priq_mq *pq);
@@ -26,6 +26,18 @@ struct k_cycle_stats {
 	uint64_t  longest;      /**< \# of cycles in longest usage window */
 	uint32_t  num_windows;  /**< \# of usage windows */
 	/** @} */
+#endif
+#if defined(CONFIG_SCHED_THREAD_USAGE_LATENCY) || defined(__DOXYGEN__)
+	/**
+	 * @name Fields available when CONFIG_SCHED_THREAD_USAGE_LATENCY is selected.
+	 * @{
+	 */
+	uint32_t  ready0;       /**< when made ready to run, 0 if not pending */
+	uint32_t  preemptions;  /**< \# of switches out while runnable */
+	uint32_t  latency_max;  /**< longest ready to run latency in cycles */
+	/** ready to run latency histogram */
+	uint32_t  latency_hist[CONFIG_SCHED_THREAD_USAGE_LATENCY_BUCKETS];
+	/** @} */
 #endif
 	bool      track_usage;  /**< true if gathering usage stats */
 };
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ *
+ * @brief Batches of kernel object operations run by one system call.
+ */
+
+#ifndef ZEPHYR_INCLUDE_KERNEL_SYSCALL_BATCH_H_
+#define ZEPHYR_INCLUDE_KERNEL_SYSCALL_BATCH_H_
+
+#include <zephyr/kernel.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief System Call Batch APIs
+ * @defgroup syscall_batch_apis System Call Batch APIs
+ * @ingroup kernel_apis
+ *
+ * A user thread signalling several kernel objects in a row pays for one
+ * privilege transition, and one verification of its arguments, per call.
+ * k_syscall_batch() runs a vector of such non-blocking operations with a
+ * single system call.
+ *
+ * @{
+ */
+
+/** @brief Operation of a system call batch */
+enum k_syscall_batch_op {
+	/** k_sem_give() on a struct k_sem */
+	K_SYSCALL_BATCH_SEM_GIVE,
+	/** k_msgq_put() on a struct k_msgq, without waiting */
+	K_SYSCALL_BATCH_MSGQ_PUT,
+	/** k_poll_signal_raise() on a struct k_poll_signal */
+	K_SYSCALL_BATCH_POLL_SIGNAL_RAISE,
+};
+
+/** @brief Entry of a system call batch */
+struct k_syscall_batch_entry {
+	/** Operation, see @ref k_syscall_batch_op */
+	uint8_t op;
+	/** Kernel object operated on */
+	void *obj;
+	union {
+		/** Message of a @ref K_SYSCALL_BATCH_MSGQ_PUT */
+		const void *data;
+		/** Result of a @ref K_SYSCALL_BATCH_POLL_SIGNAL_RAISE */
+		int signal_result;
+	};
+	/** Return value of the operation, set by k_syscall_batch() */
+	int ret;
+};
+
+/**
+ * @brief Run a batch of kernel object operations.
+ *
+ * The operations are run in order, none of them waiting. A failed operation
+ * does not stop the batch, its error being stored in its entry.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param entries Operations to run.
+ * @param count Number of operations, at most
+ *              CONFIG_SYSCALL_BATCH_MAX_ENTRIES.
+ *
+ * @return Number of failed operations, or
+ * @retval -EINVAL An entry has an unknown operation, no operation being run.
+ */
+__syscall int k_syscall_batch(struct k_syscall_batch_entry *entries,
+			      size_t count);
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#include <syscalls/syscall_batch.h>
+
+#endif /* ZEPHYR_INCLUDE_KERNEL_SYSCALL_BATCH_H_ */
@@ -105,6 +105,20 @@ struct _thread_base {
 	int prio_deadline;
 #endif
 
+#ifdef CONFIG_SCHED_CBS
+	/* Constant bandwidth server, in k_cycle_get_32() units: budget
+	 * and period of the reservation (zero period when none), budget
+	 * left in the current period and time of the last switch in.
+	 */
+	uint32_t cbs_budget;
+	uint32_t cbs_period;
+	int32_t cbs_remaining;
+	uint32_t cbs_start;
+
+	/* Timeout replenishing the budget of a throttled thread */
+	struct _timeout cbs_replenish;
+#endif
+
 	uint32_t order_key;
 
 #ifdef CONFIG_SMP
@@ -124,6 +138,13 @@ struct _thread_base {
 	uint8_t cpu_mask;
 #endif
 
+#ifdef CONFIG_FPU_LAZY_SWITCH_HISTORY
+	/* One bit per FP ownership period, most recent in bit 0, set
+	 * when the thread modified the FP registers in that period
+	 */
+	uint8_t fpu_history;
+#endif
+
 	/* data returned by APIs */
 	void *swap_data;
 
@@ -167,6 +188,13 @@ struct _thread_stack_info {
 	 * is the initial stack pointer for a thread. May be 0.
 	 */
 	size_t delta;
+
+#ifdef CONFIG_STACK_WATERMARK
+	/* Unused space found by the last k_thread_stack_watermark_get(),
+	 * the stack below it still holds the fill pattern
+	 */
+	size_t unused;
+#endif
 };
 
 typedef struct _thread_stack_info _thread_stack_info_t;
@@ -182,6 +210,20 @@ struct _mem_domain_info {
 
 #endif /* CONFIG_USERSPACE */
 
+#if defined(CONFIG_USERSPACE_OBJ_CACHE)
+struct z_object;
+
+/* Kernel objects last looked up by the system calls of a thread */
+struct _thread_obj_cache {
+	const void *obj[CONFIG_USERSPACE_OBJ_CACHE_SIZE];
+	struct z_object *ko[CONFIG_USERSPACE_OBJ_CACHE_SIZE];
+#ifdef CONFIG_DYNAMIC_OBJECTS
+	/* Generation of the dynamic objects the entries are valid for */
+	uint32_t gen;
+#endif
+};
+#endif /* CONFIG_USERSPACE_OBJ_CACHE */
+
 #ifdef CONFIG_THREAD_USERSPACE_LOCAL_DATA
 struct _thread_userspace_local_data {
 #if defined(CONFIG_ERRNO) && !defined(CONFIG_ERRNO_IN_TLS) && !defined(CONFIG_LIBC_ERRNO)
@@ -214,6 +256,19 @@ typedef struct k_thread_runtime_stats {
 	uint64_t average_cycles;      /* average # of non-idle cycles */
 #endif
 
+#ifdef CONFIG_SCHED_THREAD_USAGE_LATENCY
+	/*
+	 * For threads, the following fields refer to the time from being
+	 * made ready to run to being switched in, and to the number of
+	 * times the thread was switched out while still runnable. For
+	 * CPUs, they cover all the threads switched in on the CPU.
+	 */
+
+	uint32_t preemptions;         /* # of switches out while runnable */
+	uint32_t peak_latency_cycles; /* longest ready to run latency */
+	uint32_t latency_hist[CONFIG_SCHED_THREAD_USAGE_LATENCY_BUCKETS];
+#endif
+
 #ifdef CONFIG_SCHED_THREAD_USAGE_ALL
 	/*
 	 * This field is always zero for individual threads. It only comes
@@ -313,6 +368,11 @@ struct k_thread {
 	void *syscall_frame;
 #endif /* CONFIG_USERSPACE */
 
+#if defined(CONFIG_USERSPACE_OBJ_CACHE)
+	/** kernel object lookup cache */
+	struct _thread_obj_cache obj_cache;
+#endif
+
 
 #if defined(CONFIG_USE_SWITCH)
 	/* When using __switch() a few previously arch-specific items
@@ -62,6 +62,9 @@ extern "C" {
 /* Thread is being aborted */
 #define _THREAD_ABORTING (BIT(5))
 
+/* Thread has used up its CPU budget for the current period */
+#define _THREAD_THROTTLED (BIT(6))
+
 /* Thread is present in the ready queue */
 #define _THREAD_QUEUED (BIT(7))
 
@@ -93,6 +96,11 @@ struct _ready_q {
 #elif defined(CONFIG_SCHED_MULTIQ)
 	struct _priq_mq runq;
 #endif
+
+#ifdef CONFIG_SCHED_CPU_RUNQ
+	/* number of threads in runq, to find the busiest CPU */
+	unsigned int count;
+#endif
 };
 
 typedef struct _ready_q _ready_q_t;
@@ -110,7 +118,7 @@ struct _cpu {
 	/* one assigned idle thread per CPU */
 	struct k_thread *idle_thread;
 
-#ifdef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#ifdef CONFIG_SCHED_CPU_READY_Q
 	struct _ready_q ready_q;
 #endif
 
@@ -139,6 +147,11 @@ struct _cpu {
 
 	uint32_t usage0;
 
+#ifdef CONFIG_SCHED_THREAD_USAGE_LATENCY
+	/* Thread last switched in, to detect actual switches */
+	struct k_thread *usage_thread;
+#endif
+
 #ifdef CONFIG_SCHED_THREAD_USAGE_ALL
 	struct k_cycle_stats usage;
 #endif
@@ -161,7 +174,7 @@ struct z_kernel {
 	 * ready queue: can be big, keep after small fields, since some
 	 * assembly (e.g. ARC) are limited in the encoding of the offset
 	 */
-#ifndef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#ifndef CONFIG_SCHED_CPU_READY_Q
 	struct _ready_q ready_q;
 #endif
 
@@ -184,8 +197,8 @@ struct z_kernel {
 #endif
 
 #if defined(CONFIG_SMP) && defined(CONFIG_SCHED_IPI_SUPPORTED)
-	/* Need to signal an IPI at the next scheduling point */
-	bool pending_ipi;
+	/* Bitmap of CPUs to signal an IPI at the next scheduling point */
+	atomic_t pending_ipi;
 #endif
 };
 
@@ -247,6 +260,15 @@ struct _timeout {
 #else
 	int32_t dticks;
 #endif
+#ifdef CONFIG_TIMEOUT_PER_CPU
+	/* Index of the per-CPU queue the timeout is armed on */
+	uint8_t queue;
+#endif
+#ifdef CONFIG_TIMEOUT_SLACK
+	/* Ticks the expiry may be deferred by, and was when last armed */
+	uint32_t slack;
+	uint32_t deferred;
+#endif
 };
 
 typedef void (*k_thread_timeslice_fn_t)(struct k_thread *thread, void *data);
@@ -64,6 +64,10 @@ struct log_backend_api {
 	void (*process)(const struct log_backend *const backend,
 			union log_msg_generic *msg);
 
+	/* Optional, processes several messages at once. */
+	void (*process_batch)(const struct log_backend *const backend,
+			      union log_msg_generic **msgs, size_t count);
+
 	void (*dropped)(const struct log_backend *const backend, uint32_t cnt);
 	void (*panic)(const struct log_backend *const backend);
 	void (*init)(const struct log_backend *const backend);
@@ -180,6 +184,35 @@ static inline void log_backend_msg_process(const struct log_backend *const backe
 	backend->api->process(backend, msg);
 }
 
+/**
+ * @brief Process a batch of messages.
+ *
+ * Function is used in deferred mode when CONFIG_LOG_PROCESS_BATCH_SIZE is
+ * larger than 1. Messages are processed one by one if the backend does not
+ * implement batch processing. On return, content of all messages is processed
+ * by the backend and memory can be freed.
+ *
+ * @param[in] backend  Pointer to the backend instance.
+ * @param[in] msgs     Array of messages, oldest first.
+ * @param[in] count    Number of messages in the array.
+ */
+static inline void log_backend_msg_batch_process(const struct log_backend *const backend,
+						 union log_msg_generic **msgs,
+						 size_t count)
+{
+	__ASSERT_NO_MSG(backend != NULL);
+	__ASSERT_NO_MSG(msgs != NULL);
+
+	if (backend->api->process_batch) {
+		backend->api->process_batch(backend, msgs, count);
+		return;
+	}
+
+	for (size_t i = 0; i < count; i++) {
+		backend->api->process(backend, msgs[i]);
+	}
+}
+
 /**
  * @brief Notify backend about dropped log messages.
  *
@@ -36,6 +36,27 @@ static inline uint32_t log_backend_std_get_flags(void)
 	return flags;
 }
 
+/** @brief Format a batch of messages with a single output flush.
+ *
+ * @param output	Log output instance.
+ * @param func		Format function.
+ * @param msgs		Array of messages.
+ * @param count		Number of messages.
+ * @param flags		Formatting flags.
+ */
+static inline void
+log_backend_std_batch_process(const struct log_output *const output,
+			      log_format_func_t func,
+			      union log_msg_generic **msgs, size_t count,
+			      uint32_t flags)
+{
+	for (size_t i = 0; i < count; i++) {
+		func(output, &msgs[i]->log, flags | LOG_OUTPUT_FLAG_SKIP_FLUSH);
+	}
+
+	log_output_flush(output);
+}
+
 /** @brief Put a standard logger backend into panic mode.
  *
  * @param output	Log output instance.
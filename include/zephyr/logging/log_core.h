@@ -213,6 +213,60 @@ static inline char z_log_minimal_level_to_char(int level)
  *
  * @param ... String with arguments.
  */
+/** @brief Rate limiting state of a logging call site. */
+struct log_ratelimit_site {
+	/** Source of the messages, NULL until the site is first used. */
+	const void *source;
+	/** Uptime in milliseconds of the last token refill. */
+	uint32_t last;
+	/** Messages suppressed since the last message emitted by the site. */
+	uint32_t pending;
+	/** Total number of messages suppressed. */
+	uint32_t suppressed;
+	/** Line of the call site. */
+	uint16_t line;
+	/** Level of the messages. */
+	uint8_t level;
+	/** Remaining tokens. */
+	uint8_t tokens;
+};
+
+/** @brief Check if a call site is allowed to log a message.
+ *
+ * Token bucket of @kconfig{CONFIG_LOG_RATELIMIT_SITE_BURST} tokens, a token
+ * is added every @kconfig{CONFIG_LOG_RATELIMIT_SITE_INTERVAL_MS} milliseconds.
+ * When the site is allowed again after messages were suppressed a message
+ * with the number of suppressed messages is logged first.
+ *
+ * @param site Call site.
+ * @param source Source of the message.
+ * @param level Level of the message.
+ *
+ * @return true if message can be logged, false if it is suppressed.
+ */
+bool z_log_ratelimit_site_check(struct log_ratelimit_site *site,
+				const void *source, uint8_t level);
+
+/** @internal
+ * @brief Rate limit messages from a call site, used in a do-while block of a
+ * logging macro.
+ *
+ * Messages logged from user context are not rate limited as the call site
+ * state is not accessible from the user mode.
+ */
+#if defined(CONFIG_LOG_RATELIMIT_SITE)
+#define Z_LOG_RATELIMIT_SITE(_src, _level, _is_user_context) \
+	static STRUCT_SECTION_ITERABLE(log_ratelimit_site, _log_site) = { \
+		.line = __LINE__, \
+	}; \
+	if (((_level) <= CONFIG_LOG_RATELIMIT_SITE_LEVEL) && !(_is_user_context) && \
+	    !z_log_ratelimit_site_check(&_log_site, _src, _level)) { \
+		break; \
+	}
+#else
+#define Z_LOG_RATELIMIT_SITE(_src, _level, _is_user_context)
+#endif
+
 #define Z_LOG2(_level, _inst, _source, _dsource, ...) do { \
 	if (!Z_LOG_CONST_LEVEL_CHECK(_level)) { \
 		break; \
@@ -236,6 +290,7 @@ static inline char z_log_minimal_level_to_char(int level)
 	int _mode; \
 	void *_src = IS_ENABLED(CONFIG_LOG_RUNTIME_FILTERING) ? \
 		(void *)_dsource : (void *)_source; \
+	Z_LOG_RATELIMIT_SITE(_src, _level, is_user_context) \
 	Z_LOG_MSG_CREATE(UTIL_NOT(IS_ENABLED(CONFIG_USERSPACE)), _mode, \
 				  Z_LOG_LOCAL_DOMAIN_ID, _src, _level, NULL,\
 			  0, __VA_ARGS__); \
@@ -312,6 +367,7 @@ static inline char z_log_minimal_level_to_char(int level)
 	int mode; \
 	void *_src = IS_ENABLED(CONFIG_LOG_RUNTIME_FILTERING) ? \
 		(void *)_dsource : (void *)_source; \
+	Z_LOG_RATELIMIT_SITE(_src, _level, is_user_context) \
 	Z_LOG_MSG_CREATE(UTIL_NOT(IS_ENABLED(CONFIG_USERSPACE)), mode, \
 				  Z_LOG_LOCAL_DOMAIN_ID, _src, _level, \
 			  _data, _len, \
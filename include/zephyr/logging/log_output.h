@@ -50,6 +50,13 @@ extern "C" {
  */
 #define LOG_OUTPUT_FLAG_FORMAT_SYSLOG		BIT(6)
 
+/** @brief Flag leaving the formatted message in the output buffer.
+ *
+ * The buffer is written out when full or on log_output_flush(), which allows
+ * formatting several messages with a single write.
+ */
+#define LOG_OUTPUT_FLAG_SKIP_FLUSH		BIT(7)
+
 /**@} */
 
 /** @brief Supported backend logging format types for use
@@ -83,6 +90,17 @@ struct log_output_control_block {
 	atomic_t offset;
 	void *ctx;
 	const char *hostname;
+#if defined(CONFIG_LOG_OUTPUT_FAST_FORMAT)
+	/* Seconds of the cached timestamp prefix. */
+	log_timestamp_t ts_sec;
+	/* Format of the cached timestamp prefix, 0 if nothing is cached. */
+	uint8_t ts_kind;
+	uint8_t ts_len;
+	char ts_str[24];
+	/* Last source name and its length. */
+	const char *source;
+	size_t source_len;
+#endif
 };
 
 /** @brief Log_output instance structure. */
@@ -250,6 +250,51 @@ int lorawan_start(void);
  */
 int lorawan_send(uint8_t port, uint8_t *data, uint8_t len, enum lorawan_message_type type);
 
+#ifdef CONFIG_LORAWAN_UPLINK_QUEUE
+
+/**
+ * @brief Callback reporting the outcome of a message queued for sending
+ *
+ * @param status     0 if the frame carrying the message was sent, negative
+ *                   errno code as returned by @ref lorawan_send otherwise
+ * @param latency_ms Time from the call to @ref lorawan_send_async until the
+ *                   end of the transmission, in milliseconds
+ * @param user_data  User data given to @ref lorawan_send_async
+ */
+typedef void (*lorawan_uplink_cb_t)(int status, uint32_t latency_ms, void *user_data);
+
+/**
+ * @brief Queue data for sending to the LoRaWAN network
+ *
+ * The data is copied and sent from a dedicated thread, in the order it was
+ * queued. Frames that the regional duty-cycle restrictions do not allow to be
+ * sent yet are sent as soon as they do.
+ *
+ * With CONFIG_LORAWAN_UPLINK_QUEUE_AGGREGATE, queued messages for the same
+ * port and of the same type are concatenated into one frame, up to the
+ * maximum payload size of the current datarate. The payload format of the
+ * port must then allow the receiver to split them, e.g. by using fixed size
+ * or length-prefixed records.
+ *
+ * @param port       Port to be used for sending data, must not be 0.
+ * @param data       Data buffer to be sent
+ * @param len        Length of the buffer to be sent, at most
+ *                   CONFIG_LORAWAN_UPLINK_QUEUE_MSG_SIZE bytes.
+ * @param type       Specifies if the message shall be confirmed or unconfirmed.
+ *                   Must be one of @ref lorawan_message_type.
+ * @param cb         Callback called once the message was sent or dropped,
+ *                   can be NULL.
+ * @param user_data  User data passed to the callback
+ *
+ * @return 0 if the message was queued, -EINVAL if the parameters are invalid,
+ *         -EMSGSIZE if the message is too long or -ENOSPC if the queue is full
+ */
+int lorawan_send_async(uint8_t port, const uint8_t *data, uint8_t len,
+		       enum lorawan_message_type type, lorawan_uplink_cb_t cb,
+		       void *user_data);
+
+#endif /* CONFIG_LORAWAN_UPLINK_QUEUE */
+
 /**
  * @brief Set the current device class
  *
@@ -191,6 +191,10 @@ struct img_mgmt_state {
 	/** Hash of image data; used for resumption of a partial upload. */
 	uint8_t data_sha_len;
 	uint8_t data_sha[IMG_MGMT_DATA_SHA_LEN];
+#ifdef CONFIG_IMG_LZ4
+	/** Whether the image data is an LZ4 compressed image stream. */
+	bool compressed;
+#endif
 };
 
 /** Describes what to do during processing of an upload request. */
@@ -205,6 +209,12 @@ struct img_mgmt_upload_action {
 	bool proceed;
 	/** Whether to erase the destination flash area. */
 	bool erase;
+#ifdef CONFIG_IMG_LZ4
+	/** Whether the image data is an LZ4 compressed image stream. */
+	bool compressed;
+	/** The size of the image once decompressed. */
+	size_t image_size;
+#endif
 #ifdef CONFIG_MCUMGR_GRP_IMG_VERBOSE_ERR
 	/** "rsn" string to be sent as explanation for "rc" code */
 	const char *rc_rsn;
@@ -358,6 +358,41 @@ struct modbus_user_callbacks {
 
 	/** Floating Point Holding Register write callback */
 	int (*holding_reg_wr_fp)(uint16_t addr, float reg);
+
+	/**
+	 * Input Registers read callback, for a range of registers.
+	 * Used instead of input_reg_rd if set.
+	 */
+	int (*input_regs_rd)(uint16_t addr, uint16_t *regs, uint16_t num);
+
+	/**
+	 * Holding Registers read callback, for a range of registers.
+	 * Used instead of holding_reg_rd if set.
+	 */
+	int (*holding_regs_rd)(uint16_t addr, uint16_t *regs, uint16_t num);
+
+	/**
+	 * Holding Registers write callback, for a range of registers.
+	 * Used instead of holding_reg_wr if set.
+	 */
+	int (*holding_regs_wr)(uint16_t addr, const uint16_t *regs, uint16_t num);
+};
+
+/**
+ * @brief Registers mapped in memory
+ *
+ * The requests for registers of the map are served from memory, without
+ * calling the user callbacks, which serve the registers outside of the map.
+ * The registers are in host byte order, and are read and written by the
+ * server from the work queue of the interface.
+ */
+struct modbus_reg_map {
+	/** Registers, NULL if there is no map */
+	uint16_t *regs;
+	/** Address of the first register */
+	uint16_t start_addr;
+	/** Number of registers */
+	uint16_t num_regs;
 };
 
 /**
@@ -425,6 +460,10 @@ struct modbus_server_param {
 	struct modbus_user_callbacks *user_cb;
 	/** Modbus unit ID of the server */
 	uint8_t unit_id;
+	/** Holding registers mapped in memory */
+	struct modbus_reg_map holding_regs;
+	/** Input registers mapped in memory */
+	struct modbus_reg_map input_regs;
 };
 
 struct modbus_raw_cb {
@@ -535,6 +574,42 @@ void modbus_raw_set_server_failure(struct modbus_adu *adu);
  */
 int modbus_raw_backend_txn(const int iface, struct modbus_adu *adu);
 
+/**
+ * @brief Process a request with a raw ADU server interface
+ *
+ * Unlike modbus_raw_submit_rx, the request is processed in the context of
+ * the caller, and the response is written to the ADU passed by the pointer
+ * instead of being passed to the raw ADU callback. This allows several
+ * threads, such as the ones serving the connections of a Modbus TCP server,
+ * to share a server interface.
+ *
+ * @param iface      Modbus server interface index
+ * @param adu        Pointer to the RAW ADU struct of the request, overwritten
+ *                   by the response
+ *
+ * @retval           0 If there is a response to send
+ * @retval           -ENODATA If the request is not answered, such as a
+ *                   broadcast request
+ * @retval           -ENODEV If the interface is not a raw ADU server
+ */
+int modbus_raw_server_txn(const int iface, struct modbus_adu *adu);
+
+/**
+ * @brief Start a Modbus TCP server
+ *
+ * The server accepts up to @kconfig{CONFIG_MODBUS_TCP_SERVER_MAX_CLIENTS}
+ * connections, and answers the requests of all of them from a single thread,
+ * through a raw ADU server interface.
+ *
+ * @param iface      Modbus raw ADU server interface index
+ * @param port       TCP port to listen on, usually 502
+ *
+ * @retval           0 If the server was started
+ * @retval           -EALREADY If the server is already started
+ * @retval           -ENODEV If the interface is not a raw ADU server
+ */
+int modbus_tcp_server_start(const int iface, uint16_t port);
+
 #ifdef __cplusplus
 }
 #endif
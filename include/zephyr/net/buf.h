@@ -963,6 +963,16 @@ struct net_buf_data_alloc {
 	void *alloc_data;
 };
 
+/** @cond INTERNAL_HIDDEN */
+#if defined(CONFIG_NET_BUF_POOL_CPU_CACHE) && (CONFIG_NET_BUF_POOL_CPU_CACHE > 0)
+struct net_buf_pool_cache {
+	struct k_spinlock lock;
+	uint8_t count;
+	struct net_buf *bufs[CONFIG_NET_BUF_POOL_CPU_CACHE];
+};
+#endif
+/** @endcond */
+
 /**
  * @brief Network buffer pool representation.
  *
@@ -1003,6 +1013,16 @@ struct net_buf_pool {
 
 	/** Start of buffer storage array */
 	struct net_buf * const __bufs;
+
+#if defined(CONFIG_NET_BUF_POOL_CPU_CACHE) && (CONFIG_NET_BUF_POOL_CPU_CACHE > 0)
+	/** @cond INTERNAL_HIDDEN */
+	/* Free buffers kept aside for each CPU */
+	struct net_buf_pool_cache cache[CONFIG_MP_MAX_NUM_CPUS];
+
+	/* Number of threads about to wait for a free buffer */
+	atomic_t waiters;
+	/** @endcond */
+#endif
 };
 
 /** @cond INTERNAL_HIDDEN */
@@ -1288,6 +1308,27 @@ struct net_buf * __must_check net_buf_alloc_len(struct net_buf_pool *pool,
 						k_timeout_t timeout);
 #endif
 
+/**
+ * @brief Allocate a chain of buffers from a pool.
+ *
+ * Allocate @p count buffers of @p size bytes each and link them together
+ * as fragments of the first one. The buffers that are free are taken from
+ * the pool at once, which is cheaper than allocating them one by one.
+ *
+ * @param pool Which pool to allocate the buffers from.
+ * @param size Amount of data each buffer must be able to fit.
+ * @param count Number of buffers to allocate.
+ * @param timeout Affects the action taken should the pool run out of
+ *        buffers, as for net_buf_alloc_len(). The timeout applies to the
+ *        whole allocation.
+ *
+ * @return First buffer of the chain, or NULL if not all of the buffers
+ *         could be allocated. In that case no buffer is kept allocated.
+ */
+struct net_buf * __must_check net_buf_alloc_bulk(struct net_buf_pool *pool,
+						 size_t size, size_t count,
+						 k_timeout_t timeout);
+
 /**
  * @brief Allocate a new buffer from a pool but with external data pointer.
  *
@@ -1429,6 +1470,19 @@ void net_buf_unref_debug(struct net_buf *buf, const char *func, int line);
 void net_buf_unref(struct net_buf *buf);
 #endif
 
+/**
+ * @brief Decrements the reference count of a buffer and its fragments.
+ *
+ * Same as net_buf_unref(), but the buffers reaching a reference count of
+ * zero are returned to their pool together: one pool operation for each run
+ * of consecutive fragments of the same pool, instead of one per buffer.
+ * Buffers of pools with a destroy callback are passed to the callback one
+ * by one.
+ *
+ * @param buf A valid pointer on a buffer
+ */
+void net_buf_unref_chain_bulk(struct net_buf *buf);
+
 /**
  * @brief Increment the reference count of a buffer.
  *
@@ -2372,6 +2426,43 @@ struct net_buf *net_buf_frag_del(struct net_buf *parent, struct net_buf *frag);
 size_t net_buf_linearize(void *dst, size_t dst_len,
 			 struct net_buf *src, size_t offset, size_t len);
 
+/**
+ * @brief Flush the data of a net_buf chain in the d-cache
+ *
+ * Flush the data of all the fragments of the chain in the data cache, so
+ * that it can be read by a DMA controller, for instance before transmitting
+ * the chain. The fragments are flushed by batches, waiting for the completion
+ * of the cache operations once per batch rather than once per fragment, see
+ * sys_cache_data_flush_ranges().
+ *
+ * @param buf Head of the fragment chain.
+ *
+ * @retval 0 If succeeded.
+ * @retval -ENOTSUP If not supported.
+ * @retval -errno Negative errno for other failures.
+ */
+int net_buf_cache_flush(struct net_buf *buf);
+
+/**
+ * @brief Invalidate the space of a net_buf chain in the d-cache
+ *
+ * Invalidate all the fragments of the chain in the data cache, from their
+ * data pointer to the end of their data buffer, so that the data written
+ * there by a DMA controller is read, for instance after receiving into the
+ * chain. The fragments are invalidated by batches, see
+ * sys_cache_data_invd_ranges().
+ *
+ * @note The invalidated ranges should be aligned to the d-cache line, see
+ *       sys_cache_data_invd_range().
+ *
+ * @param buf Head of the fragment chain.
+ *
+ * @retval 0 If succeeded.
+ * @retval -ENOTSUP If not supported.
+ * @retval -errno Negative errno for other failures.
+ */
+int net_buf_cache_invd(struct net_buf *buf);
+
 /**
  * @typedef net_buf_allocator_cb
  * @brief Network buffer allocator callback.
@@ -13,7 +13,9 @@
 #ifndef ZEPHYR_INCLUDE_NET_CAPTURE_H_
 #define ZEPHYR_INCLUDE_NET_CAPTURE_H_
 
+#include <string.h>
 #include <zephyr/kernel.h>
+#include <zephyr/net/net_ip.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -211,6 +213,16 @@ static inline void net_capture_pkt(struct net_if *iface, struct net_pkt *pkt)
 }
 #endif
 
+#if defined(CONFIG_NET_CAPTURE_RING)
+void net_capture_ring_pkt(struct net_if *iface, struct net_pkt *pkt);
+#else
+static inline void net_capture_ring_pkt(struct net_if *iface, struct net_pkt *pkt)
+{
+	ARG_UNUSED(iface);
+	ARG_UNUSED(pkt);
+}
+#endif
+
 struct net_capture_info {
 	const struct device *capture_dev;
 	struct net_if *capture_iface;
@@ -250,6 +262,144 @@ static inline void net_capture_foreach(net_capture_cb_t cb, void *user_data)
 
 /** @endcond */
 
+/**
+ * @brief Filter selecting the packets captured into the capture ring.
+ *
+ * A zero field matches any packet. Packets that are not IPv4 or IPv6 only
+ * match a filter without any field set.
+ */
+struct net_capture_filter {
+	/** Address family, AF_INET or AF_INET6 */
+	sa_family_t family;
+
+	/** Transport protocol, IPPROTO_UDP, IPPROTO_TCP, ... */
+	uint8_t proto;
+
+	/** Source or destination port, host byte order */
+	uint16_t port;
+
+	/** Source or destination address, AF_UNSPEC for any address */
+	struct net_addr addr;
+};
+
+/** @brief Counters of the capture ring. */
+struct net_capture_ring_stats {
+	/** Packets recorded into the ring */
+	uint32_t captured;
+
+	/** Packets recorded with only their first
+	 *  CONFIG_NET_CAPTURE_RING_SNAPLEN bytes
+	 */
+	uint32_t truncated;
+
+	/** Packets not matching the filter */
+	uint32_t filtered;
+
+	/** Packets lost because the ring was full */
+	uint32_t dropped;
+};
+
+#if defined(CONFIG_NET_CAPTURE_RING) || defined(__DOXYGEN__)
+/**
+ * @brief Start capturing the packets received by a network interface into
+ *        the capture ring.
+ *
+ * @details The packets are recorded as pcapng Enhanced Packet Blocks in a
+ * preallocated ring of CONFIG_NET_CAPTURE_RING_SIZE bytes, without
+ * generating any network traffic. The timestamp of a packet is its
+ * driver or PTP timestamp when set, the system uptime otherwise, in
+ * nanoseconds. Records are removed from the ring with
+ * net_capture_ring_read(). Records left from a previous capture are
+ * discarded.
+ *
+ * @param iface Network interface to capture
+ * @param filter Packets to capture, NULL to capture all the packets
+ *
+ * @return 0 if ok, <0 if error
+ */
+int net_capture_ring_enable(struct net_if *iface,
+			    const struct net_capture_filter *filter);
+
+/**
+ * @brief Stop capturing packets into the capture ring.
+ *
+ * @details Records already in the ring are kept until they are read.
+ *
+ * @return 0 if ok, <0 if error
+ */
+int net_capture_ring_disable(void);
+
+/**
+ * @brief Get the pcapng header of the records of the capture ring.
+ *
+ * @details The header consists of a Section Header Block and the
+ * Interface Description Block of the captured network interface. It must
+ * precede the records read with net_capture_ring_read() in a pcapng file.
+ *
+ * @param buf Buffer receiving the header
+ * @param len Length of the buffer
+ *
+ * @return Length of the header, or <0 if error
+ */
+int net_capture_ring_header(uint8_t *buf, size_t len);
+
+/**
+ * @brief Read the records of the capture ring.
+ *
+ * @details Copies and removes as many whole records as fit in the buffer.
+ * The function can be called while capturing.
+ *
+ * @param buf Buffer receiving the records
+ * @param len Length of the buffer
+ *
+ * @return Number of bytes copied, 0 if the ring is empty, or -ENOBUFS if
+ *         the next record does not fit the buffer
+ */
+int net_capture_ring_read(uint8_t *buf, size_t len);
+
+/**
+ * @brief Get the counters of the capture ring.
+ *
+ * @param stats Counters since the capture ring was last enabled
+ */
+void net_capture_ring_stats_get(struct net_capture_ring_stats *stats);
+#else
+static inline int net_capture_ring_enable(struct net_if *iface,
+					  const struct net_capture_filter *filter)
+{
+	ARG_UNUSED(iface);
+	ARG_UNUSED(filter);
+
+	return -ENOTSUP;
+}
+
+static inline int net_capture_ring_disable(void)
+{
+	return -ENOTSUP;
+}
+
+static inline int net_capture_ring_header(uint8_t *buf, size_t len)
+{
+	ARG_UNUSED(buf);
+	ARG_UNUSED(len);
+
+	return -ENOTSUP;
+}
+
+static inline int net_capture_ring_read(uint8_t *buf, size_t len)
+{
+	ARG_UNUSED(buf);
+	ARG_UNUSED(len);
+
+	return -ENOTSUP;
+}
+
+static inline void net_capture_ring_stats_get(struct net_capture_ring_stats *stats)
+{
+	memset(stats, 0, sizeof(*stats));
+}
+#endif /* CONFIG_NET_CAPTURE_RING */
+
 /**
  * @}
  */
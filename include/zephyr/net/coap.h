@@ -229,6 +229,14 @@ struct coap_observer {
 	uint8_t tkl;
 };
 
+/**
+ * @brief Position of an option in a parsed CoAP packet.
+ */
+struct coap_option_index {
+	uint16_t code; /* Option number */
+	uint16_t offset; /* Offset of the option header in the packet */
+};
+
 /**
  * @brief Representation of a CoAP Packet.
  */
@@ -239,6 +247,11 @@ struct coap_packet {
 	uint8_t hdr_len; /* CoAP header length */
 	uint16_t opt_len; /* Total options length (delta + len + value) */
 	uint16_t delta; /* Used for delta calculation in CoAP packet */
+#if defined(CONFIG_COAP_OPTION_INDEX)
+	bool opt_indexed; /* Options are described by opt_index */
+	uint8_t opt_count; /* Number of options in opt_index */
+	struct coap_option_index opt_index[CONFIG_COAP_OPTION_INDEX_SIZE];
+#endif
 #if defined(CONFIG_COAP_KEEP_USER_DATA)
 	void *user_data; /* Application specific user data */
 #endif
@@ -456,6 +469,23 @@ int coap_find_options(const struct coap_packet *cpkt, uint16_t code,
 int coap_packet_append_option(struct coap_packet *cpkt, uint16_t code,
 			      const uint8_t *value, uint16_t len);
 
+/**
+ * @brief Appends a set of options to the packet.
+ *
+ * The options may be given in any order, they are encoded in numeric
+ * order of their codes in a single pass. Options with the same code
+ * keep their relative order, so repeated options like Uri-Path can be
+ * given in sequence. The @a delta field of each option holds its code.
+ *
+ * @param cpkt Packet to be updated
+ * @param options Array of options to add to the packet
+ * @param num Number of elements in the options array
+ *
+ * @return 0 in case of success or negative in case of error.
+ */
+int coap_packet_append_options(struct coap_packet *cpkt,
+			       const struct coap_option *options, size_t num);
+
 /**
  * @brief Remove an option from the packet.
  *
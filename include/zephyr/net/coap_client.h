@@ -32,7 +32,9 @@
  * This callback is called for responses to CoAP client requests.
  * It is used to indicate errors, response codes from server or to deliver payload.
  * Blockwise transfers cause this callback to be called sequentially with increasing payload offset
- * and only partial content in buffer pointed by payload parameter.
+ * and only partial content in buffer pointed by payload parameter. This also holds when
+ * :kconfig:option:`CONFIG_COAP_CLIENT_BLOCK_WINDOW` keeps several block requests in flight,
+ * blocks received out of order are held back until the preceding ones are delivered.
  *
  * @param result_code Result code of the response. Negative if there was a failure in send.
  *                    @ref coap_response_code for positive.
@@ -77,6 +79,24 @@ struct coap_client_option {
 };
 
 /** @cond INTERNAL_HIDDEN */
+#if CONFIG_COAP_CLIENT_BLOCK_WINDOW > 1
+enum coap_client_block_state {
+	COAP_CLIENT_BLOCK_FREE,
+	COAP_CLIENT_BLOCK_IN_FLIGHT,
+	COAP_CLIENT_BLOCK_RECEIVED,
+};
+
+struct coap_client_block {
+	struct coap_pending pending;
+	uint32_t num;
+	enum coap_client_block_state state;
+	uint8_t response_code;
+	bool last;
+	uint16_t len;
+	uint8_t payload[CONFIG_COAP_CLIENT_BLOCK_SIZE];
+};
+#endif
+
 struct coap_client_internal_request {
 	uint8_t request_token[COAP_TOKEN_MAX_LEN];
 	uint32_t offset;
@@ -89,6 +109,13 @@ struct coap_client_internal_request {
 	struct coap_pending pending;
 	struct coap_client_request coap_request;
 	struct coap_packet request;
+#if CONFIG_COAP_CLIENT_BLOCK_WINDOW > 1
+	bool window_active;
+	uint32_t window_blocks;
+	uint32_t window_next;
+	uint32_t window_deliver;
+	struct coap_client_block window[CONFIG_COAP_CLIENT_BLOCK_WINDOW];
+#endif
 };
 
 struct coap_client {
@@ -446,6 +446,40 @@ static inline int dns_cancel_addr_info(uint16_t dns_id)
 	return dns_resolve_cancel(dns_resolve_get_default(), dns_id);
 }
 
+/**
+ * @typedef dns_cache_cb_t
+ * @brief Callback used while iterating over the DNS cache.
+ *
+ * @param query Name that was resolved.
+ * @param type Type of the query.
+ * @param info Cached address, or NULL if the name is cached as having no
+ * address of this type.
+ * @param ttl Remaining time to live of the entry in seconds.
+ * @param user_data A valid pointer to user data or NULL
+ */
+typedef void (*dns_cache_cb_t)(const char *query, enum dns_query_type type,
+			       const struct dns_addrinfo *info, uint32_t ttl,
+			       void *user_data);
+
+/**
+ * @brief Go through all the entries of the DNS cache.
+ *
+ * @details The cache is locked while the callback is called, so the
+ * callback must not resolve any name.
+ * Needs :kconfig:option:`CONFIG_DNS_RESOLVER_CACHE`.
+ *
+ * @param cb User supplied callback function to call.
+ * @param user_data User specified data.
+ */
+void dns_cache_foreach(dns_cache_cb_t cb, void *user_data);
+
+/**
+ * @brief Remove all the entries of the DNS cache.
+ *
+ * @details Needs :kconfig:option:`CONFIG_DNS_RESOLVER_CACHE`.
+ */
+void dns_cache_flush(void);
+
 /**
  * @}
  */
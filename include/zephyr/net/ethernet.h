@@ -179,6 +179,9 @@ enum ethernet_hw_caps {
 
 	/** TXTIME supported */
 	ETHERNET_TXTIME			= BIT(19),
+
+	/** TCP segmentation offload supported */
+	ETHERNET_HW_TX_TSO		= BIT(20),
 };
 
 /** @cond INTERNAL_HIDDEN */
@@ -31,10 +31,33 @@ extern "C" {
 
 /** @cond INTERNAL_HIDDEN */
 
+#if defined(CONFIG_NET_ETHERNET_BRIDGE_FDB_SIZE)
+#define ETH_BRIDGE_FDB_SIZE CONFIG_NET_ETHERNET_BRIDGE_FDB_SIZE
+#else
+#define ETH_BRIDGE_FDB_SIZE 0
+#endif
+
+struct net_if;
+
+/* Station learned from the source address of a bridged packet */
+struct eth_bridge_fdb_entry {
+	sys_snode_t node;
+	struct net_if *iface;
+	uint32_t last_seen;
+	uint8_t addr[6];
+};
+
 struct eth_bridge {
 	struct k_mutex lock;
 	sys_slist_t interfaces;
 	sys_slist_t listeners;
+#if ETH_BRIDGE_FDB_SIZE > 0
+	/* Forwarding database, entries are hashed on the MAC address and
+	 * unused while their iface is NULL.
+	 */
+	sys_slist_t fdb_buckets[ETH_BRIDGE_FDB_SIZE];
+	struct eth_bridge_fdb_entry fdb[ETH_BRIDGE_FDB_SIZE];
+#endif
 	bool initialized;
 };
 
@@ -115,6 +138,19 @@ int eth_bridge_iface_remove(struct eth_bridge *br, struct net_if *iface);
  */
 int eth_bridge_iface_allow_tx(struct net_if *iface, bool allow);
 
+/**
+ * @brief Forget the stations learned by a bridge
+ *
+ * Packets to the forgotten stations are flooded to all the interfaces of
+ * the bridge until their location is learned again. Learning is enabled
+ * with @kconfig{CONFIG_NET_ETHERNET_BRIDGE_FDB_SIZE}.
+ *
+ * @param br A pointer to an initialized bridge object
+ * @param iface Only forget the stations learned on this interface, or
+ *        NULL to forget all of them
+ */
+void eth_bridge_fdb_flush(struct eth_bridge *br, struct net_if *iface);
+
 /**
  * @brief Add (register) a listener to the bridge
  *
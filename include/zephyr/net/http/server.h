@@ -0,0 +1,192 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_NET_HTTP_SERVER_H_
+#define ZEPHYR_INCLUDE_NET_HTTP_SERVER_H_
+
+/**
+ * @brief HTTP server API
+ * @defgroup http_server HTTP server API
+ * @ingroup networking
+ * @{
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <zephyr/sys/util.h>
+#include <zephyr/net/http/method.h>
+#include <zephyr/net/http/parser.h>
+#include <zephyr/net/http/service.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @cond INTERNAL_HIDDEN */
+#if defined(CONFIG_HTTP_SERVER)
+#define HTTP_SERVER_CLIENT_BUFFER_SIZE CONFIG_HTTP_SERVER_CLIENT_BUFFER_SIZE
+#define HTTP_SERVER_MAX_URL_LENGTH CONFIG_HTTP_SERVER_MAX_URL_LENGTH
+#else
+#define HTTP_SERVER_CLIENT_BUFFER_SIZE 0
+#define HTTP_SERVER_MAX_URL_LENGTH 0
+#endif
+/** @endcond */
+
+/** Type of an HTTP resource */
+enum http_resource_type {
+	/** Constant data served from memory */
+	HTTP_RESOURCE_TYPE_STATIC,
+	/** Data produced by an application callback */
+	HTTP_RESOURCE_TYPE_DYNAMIC,
+	/** File served from the file system */
+	HTTP_RESOURCE_TYPE_FS,
+};
+
+/**
+ * @brief Common part of the detail of an HTTP resource
+ *
+ * The @a detail of a resource defined with @ref HTTP_RESOURCE_DEFINE points to
+ * one of the http_resource_detail_* structures, which all start with this
+ * structure.
+ */
+struct http_resource_detail {
+	/** Bitmask of the methods allowed on the resource, BIT(HTTP_GET), ... */
+	uint32_t bitmask_of_supported_http_methods;
+	/** Type of the resource */
+	enum http_resource_type type;
+	/** Value of the Content-Type header, or NULL */
+	const char *content_type;
+	/** Value of the Content-Encoding header, or NULL */
+	const char *content_encoding;
+};
+
+/** Detail of a resource of type HTTP_RESOURCE_TYPE_STATIC */
+struct http_resource_detail_static {
+	/** Common resource detail */
+	struct http_resource_detail common;
+	/** Data of the resource */
+	const void *static_data;
+	/** Length of the data of the resource */
+	size_t static_data_len;
+};
+
+/** Detail of a resource of type HTTP_RESOURCE_TYPE_FS */
+struct http_resource_detail_fs {
+	/** Common resource detail */
+	struct http_resource_detail common;
+	/** Path of the file to serve */
+	const char *path;
+};
+
+struct http_client_ctx;
+
+/**
+ * @brief Callback of a resource of type HTTP_RESOURCE_TYPE_DYNAMIC
+ *
+ * Invoked for every segment of the request body as it is received, and once
+ * more with @p final set when the whole request was received. The response is
+ * produced with http_server_send_chunk(), from any of the invocations. A
+ * response is sent with chunked transfer encoding and terminated after the
+ * final invocation returns.
+ *
+ * @param client Client connection of the request
+ * @param data Segment of the request body, NULL for the final invocation
+ * @param len Length of the segment
+ * @param final True for the final invocation
+ * @param user_data User data of the resource
+ *
+ * @return 0 on success, a negative error code to abort the response.
+ */
+typedef int (*http_resource_dynamic_cb_t)(struct http_client_ctx *client,
+					  const uint8_t *data, size_t len,
+					  bool final, void *user_data);
+
+/** Detail of a resource of type HTTP_RESOURCE_TYPE_DYNAMIC */
+struct http_resource_detail_dynamic {
+	/** Common resource detail */
+	struct http_resource_detail common;
+	/** Callback producing the response */
+	http_resource_dynamic_cb_t cb;
+	/** User data passed to the callback */
+	void *user_data;
+};
+
+/** Client connection of the HTTP server */
+struct http_client_ctx {
+	/** Socket of the connection */
+	int fd;
+	/** Service the connection was accepted by */
+	const struct http_service_desc *service;
+	/** Resource of the request being received, NULL if not found */
+	const struct http_resource_detail *resource;
+	/** Method of the request being received */
+	enum http_method method;
+
+	/** @cond INTERNAL_HIDDEN */
+	struct http_parser parser;
+	int64_t last_activity;
+	size_t url_len;
+	uint16_t status;
+	bool keep_alive : 1;
+	bool http_1_0 : 1;
+	bool response_started : 1;
+	bool url_overflow : 1;
+	char url[HTTP_SERVER_MAX_URL_LENGTH + 1];
+	uint8_t buffer[HTTP_SERVER_CLIENT_BUFFER_SIZE];
+	/** @endcond */
+};
+
+/**
+ * @brief Start the HTTP server
+ *
+ * Opens a listening socket for each service defined with
+ * @ref HTTP_SERVICE_DEFINE and starts serving their static resources from a
+ * dedicated thread. Connections are taken from a pool of
+ * @kconfig{CONFIG_HTTP_SERVER_MAX_CLIENTS} entries and are kept open between
+ * requests until the client closes them or they are idle for
+ * @kconfig{CONFIG_HTTP_SERVER_IDLE_TIMEOUT} milliseconds.
+ *
+ * @return 0 on success, a negative error code otherwise.
+ */
+int http_server_start(void);
+
+/**
+ * @brief Stop the HTTP server
+ *
+ * Closes all the connections and listening sockets and waits for the server
+ * thread to exit.
+ *
+ * @return 0 on success, a negative error code otherwise.
+ */
+int http_server_stop(void);
+
+/**
+ * @brief Send a chunk of the response of a dynamic resource
+ *
+ * Only valid from the callback of a resource of type
+ * HTTP_RESOURCE_TYPE_DYNAMIC. The response header is sent along with the
+ * first chunk.
+ *
+ * @param client Client connection passed to the callback
+ * @param data Data of the chunk
+ * @param len Length of the chunk, nothing is sent if 0
+ *
+ * @return 0 on success, a negative error code otherwise.
+ */
+int http_server_send_chunk(struct http_client_ctx *client, const void *data,
+			   size_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+
+#endif /* ZEPHYR_INCLUDE_NET_HTTP_SERVER_H_ */
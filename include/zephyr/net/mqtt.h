@@ -76,6 +76,12 @@ enum mqtt_evt_type {
 
 	/** Ping Response from server. */
 	MQTT_EVT_PINGRESP,
+
+	/** Segment of the payload of a received PUBLISH message that was not
+	 *  read in the MQTT_EVT_PUBLISH callback. Only notified when
+	 *  @kconfig{CONFIG_MQTT_PUBLISH_STREAM} is enabled.
+	 */
+	MQTT_EVT_PUBLISH_PAYLOAD,
 };
 
 /** @brief MQTT version protocol level. */
@@ -279,6 +285,21 @@ struct mqtt_subscription_list {
  * @brief Defines event parameters notified along with asynchronous events
  *        to the application.
  */
+/** @brief Parameters for a segment of a received PUBLISH payload. */
+struct mqtt_publish_payload_param {
+	/** Payload segment, only valid during the event callback. */
+	const uint8_t *data;
+
+	/** Length of the payload segment. */
+	uint32_t len;
+
+	/** Offset of the segment in the message payload. */
+	uint32_t offset;
+
+	/** Length of the whole message payload. */
+	uint32_t total_len;
+};
+
 union mqtt_evt_param {
 	/** Parameters accompanying MQTT_EVT_CONNACK event. */
 	struct mqtt_connack_param connack;
@@ -308,6 +329,9 @@ union mqtt_evt_param {
 
 	/** Parameters accompanying MQTT_EVT_UNSUBACK event. */
 	struct mqtt_unsuback_param unsuback;
+
+	/** Parameters accompanying MQTT_EVT_PUBLISH_PAYLOAD event. */
+	struct mqtt_publish_payload_param publish_payload;
 };
 
 /** @brief Defines MQTT asynchronous event notified to the application. */
@@ -468,6 +492,18 @@ struct mqtt_internal {
 
 	/** Internal. Remaining payload length to read. */
 	uint32_t remaining_payload;
+
+#if defined(CONFIG_MQTT_PUBLISH_STREAM)
+	/** Internal. Payload length of the PUBLISH message being received. */
+	uint32_t payload_len;
+#endif
+
+#if CONFIG_MQTT_PUBLISH_WINDOW > 0
+	/** Internal. Message IDs of the published messages not acknowledged
+	 *  yet, 0 for a free entry.
+	 */
+	uint16_t unacked_publish[CONFIG_MQTT_PUBLISH_WINDOW];
+#endif
 };
 
 /**
@@ -603,6 +639,8 @@ int mqtt_connect(struct mqtt_client *client);
  *                  Shall not be NULL.
  *
  * @return 0 or a negative error code (errno.h) indicating reason of failure.
+ *         -EAGAIN if @kconfig{CONFIG_MQTT_PUBLISH_WINDOW} QoS 1 or QoS 2
+ *         messages are already waiting for their acknowledgment.
  */
 int mqtt_publish(struct mqtt_client *client,
 		 const struct mqtt_publish_param *param);
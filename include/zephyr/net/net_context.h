@@ -315,10 +315,10 @@ __net_socket struct net_context {
 		k_timeout_t sndtimeo;
 #endif
 #if defined(CONFIG_NET_CONTEXT_RCVBUF)
-		uint16_t rcvbuf;
+		uint32_t rcvbuf;
 #endif
 #if defined(CONFIG_NET_CONTEXT_SNDBUF)
-		uint16_t sndbuf;
+		uint32_t sndbuf;
 #endif
 #if defined(CONFIG_NET_CONTEXT_DSCP_ECN)
 		uint8_t dscp_ecn;
@@ -975,6 +975,30 @@ int net_context_sendto(struct net_context *context,
 		       k_timeout_t timeout,
 		       void *user_data);
 
+/**
+ * @brief Send network buffers as is to a peer specified by address.
+ *
+ * @details This function sends a UDP datagram holding the data of the
+ * given network buffers without copying it, which is useful with
+ * buffers pointing to external data. The network buffers are always
+ * consumed, they are released when sending fails, or once the network
+ * device has sent the datagram.
+ *
+ * @param context The network context to use.
+ * @param frags Network buffers holding the data to send.
+ * @param dst_addr Destination address, or NULL to use the address set by
+ * net_context_connect().
+ * @param addrlen Length of the address in @a dst_addr
+ * @param timeout Currently this value is not used.
+ *
+ * @return numbers of bytes sent on success, a negative errno otherwise
+ */
+int net_context_sendto_buf(struct net_context *context,
+			   struct net_buf *frags,
+			   const struct sockaddr *dst_addr,
+			   socklen_t addrlen,
+			   k_timeout_t timeout);
+
 /**
  * @brief Send data in iovec to a peer specified in msghdr struct.
  *
@@ -2228,6 +2228,16 @@ bool net_if_need_calc_rx_checksum(struct net_if *iface);
  */
 bool net_if_need_calc_tx_checksum(struct net_if *iface);
 
+/**
+ * @brief Check if TCP super-segments need to be split in segments by the IP
+ * stack before sending them, or if the network device can do it.
+ *
+ * @param iface Network interface
+ *
+ * @return True if segmentation needs to be done, false otherwise.
+ */
+bool net_if_need_tx_segmentation(struct net_if *iface);
+
 /**
  * @brief Get interface according to index
  *
@@ -276,6 +276,18 @@ struct net_pkt {
 	uint16_t vlan_tci;
 #endif /* CONFIG_NET_VLAN */
 
+#if defined(CONFIG_NET_TC_RX_STEERING)
+	/* Flow hash of a received packet, 0 if not computed */
+	uint32_t rx_hash;
+#endif /* CONFIG_NET_TC_RX_STEERING */
+
+#if defined(CONFIG_NET_TCP_GSO)
+	/* Payload length of the segments a TCP super-segment is split into
+	 * before it is sent, 0 if the packet is not a super-segment.
+	 */
+	uint16_t gso_size;
+#endif /* CONFIG_NET_TCP_GSO */
+
 #if defined(NET_PKT_HAS_CONTROL_BLOCK)
 	/* TODO: Evolve this into a union of orthogonal
 	 *       control block declarations if further L2
@@ -953,6 +965,56 @@ static inline void net_pkt_set_vlan_tci(struct net_pkt *pkt, uint16_t tci)
 }
 #endif
 
+#if defined(CONFIG_NET_TC_RX_STEERING)
+static inline uint32_t net_pkt_rx_hash(struct net_pkt *pkt)
+{
+	return pkt->rx_hash;
+}
+
+static inline void net_pkt_set_rx_hash(struct net_pkt *pkt, uint32_t hash)
+{
+	pkt->rx_hash = hash;
+}
+#else
+static inline uint32_t net_pkt_rx_hash(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+
+static inline void net_pkt_set_rx_hash(struct net_pkt *pkt, uint32_t hash)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(hash);
+}
+#endif
+
+#if defined(CONFIG_NET_TCP_GSO)
+static inline uint16_t net_pkt_gso_size(struct net_pkt *pkt)
+{
+	return pkt->gso_size;
+}
+
+static inline void net_pkt_set_gso_size(struct net_pkt *pkt, uint16_t size)
+{
+	pkt->gso_size = size;
+}
+#else
+static inline uint16_t net_pkt_gso_size(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+
+static inline void net_pkt_set_gso_size(struct net_pkt *pkt, uint16_t size)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(size);
+}
+#endif
+
 #if defined(CONFIG_NET_PKT_TIMESTAMP) || defined(CONFIG_NET_PKT_TXTIME)
 static inline struct net_ptp_time *net_pkt_timestamp(struct net_pkt *pkt)
 {
@@ -1607,6 +1669,71 @@ void net_pkt_get_info(struct k_mem_slab **rx,
 		      struct net_buf_pool **rx_data,
 		      struct net_buf_pool **tx_data);
 
+#if CONFIG_NET_BUF_LARGE_DATA_SIZE > 0
+/**
+ * @brief Get information about the large fragment RX and TX DATA pools.
+ *
+ * @param rx_data Pointer to large RX DATA pool is returned.
+ * @param tx_data Pointer to large TX DATA pool is returned.
+ */
+void net_pkt_get_large_info(struct net_buf_pool **rx_data,
+			    struct net_buf_pool **tx_data);
+#endif
+
+#if defined(CONFIG_NET_PKT_ALLOC_STATS)
+/** Number of buckets of the requested data size histogram */
+#define NET_PKT_ALLOC_STATS_BUCKETS 8
+
+/** Allocation statistics of one of the predefined packet or data pools */
+struct net_pkt_pool_stats {
+	/** Number of successful allocations */
+	uint32_t allocs;
+	/** Number of failed allocations */
+	uint32_t failures;
+	/** Total time spent allocating, in microseconds */
+	uint64_t wait_us;
+	/** Longest time spent in a single allocation, in microseconds */
+	uint32_t max_wait_us;
+	/** Highest number of items in use at the same time */
+	uint16_t high_water;
+	/** Number of items in the pool */
+	uint16_t count;
+};
+
+/** Allocation statistics of the predefined RX, TX and DATA pools */
+struct net_pkt_alloc_stats {
+	/** RX packet pool */
+	struct net_pkt_pool_stats rx;
+	/** TX packet pool */
+	struct net_pkt_pool_stats tx;
+	/** RX DATA pool */
+	struct net_pkt_pool_stats rx_data;
+	/** TX DATA pool */
+	struct net_pkt_pool_stats tx_data;
+	/** Sizes of the data allocations: bucket i counts the allocations
+	 *  of up to 32 << i bytes, the last bucket the larger ones.
+	 */
+	uint32_t size_hist[NET_PKT_ALLOC_STATS_BUCKETS];
+	/** Number of buffers making up the data allocations */
+	uint32_t data_frags;
+	/** Number of calls to net_pkt_compact() */
+	uint32_t compactions;
+};
+
+/**
+ * @brief Get the allocation statistics of the predefined pools.
+ *
+ * @param stats Statistics collected since boot or the last call to
+ *        net_pkt_clear_alloc_stats() are returned.
+ */
+void net_pkt_get_alloc_stats(struct net_pkt_alloc_stats *stats);
+
+/**
+ * @brief Clear the allocation statistics of the predefined pools.
+ */
+void net_pkt_clear_alloc_stats(void);
+#endif /* CONFIG_NET_PKT_ALLOC_STATS */
+
 /** @cond INTERNAL_HIDDEN */
 
 #if defined(CONFIG_NET_DEBUG_NET_PKT_ALLOC)
@@ -2017,6 +2144,24 @@ struct net_pkt *net_pkt_rx_clone(struct net_pkt *pkt, k_timeout_t timeout);
 struct net_pkt *net_pkt_shallow_clone(struct net_pkt *pkt,
 				      k_timeout_t timeout);
 
+/**
+ * @brief Clone the beginning of a pkt.
+ *
+ * @details The attributes of the original pkt and its first @a len bytes
+ *          are copied to a new pkt with room for @a size bytes. The cursor
+ *          of the new pkt is left after the copied data, so that more data
+ *          can be written after it.
+ *
+ * @param pkt Original pkt to be cloned
+ * @param len Number of bytes to copy from the beginning of the pkt
+ * @param size Size of the buffer to allocate, at least @a len
+ * @param timeout Timeout to wait for free packet and buffer
+ *
+ * @return NULL if error, cloned packet otherwise.
+ */
+struct net_pkt *net_pkt_clone_head(struct net_pkt *pkt, size_t len,
+				   size_t size, k_timeout_t timeout);
+
 /**
  * @brief Read some data from a net_pkt
  *
@@ -405,6 +405,68 @@ static inline ssize_t zsock_send(int sock, const void *buf, size_t len,
 __syscall ssize_t zsock_sendmsg(int sock, const struct msghdr *msg,
 				int flags);
 
+/**
+ * @brief Send several datagrams with a single call
+ *
+ * @details
+ * Send the messages of @a msgvec in order as with zsock_sendmsg(), with
+ * a single socket lookup and lock. The network stack processes the
+ * datagrams once they are all queued, instead of being woken up for each
+ * of them. The number of bytes sent for each message is stored in its
+ * msg_len field.
+ * This function is also exposed as ``sendmmsg()``
+ * if :kconfig:option:`CONFIG_NET_SOCKETS_POSIX_NAMES` is defined.
+ *
+ * @param sock Socket descriptor
+ * @param msgvec Messages to send
+ * @param vlen Number of messages in @a msgvec
+ * @param flags Flags, as for zsock_sendmsg()
+ *
+ * @return Number of messages sent, or -1 with errno set if the first one
+ *         could not be sent.
+ */
+int zsock_sendmmsg(int sock, struct mmsghdr *msgvec, unsigned int vlen,
+		   int flags);
+
+/**
+ * @brief Callback reporting that a buffer given to zsock_sendto_nocopy()
+ * is no longer used by the network stack
+ *
+ * @param buf Buffer given to zsock_sendto_nocopy()
+ * @param len Length of the buffer
+ * @param user_data User data given to zsock_sendto_nocopy()
+ */
+typedef void (*zsock_send_done_cb_t)(const void *buf, size_t len,
+				     void *user_data);
+
+/**
+ * @brief Send data from a caller-owned buffer without copying it
+ *
+ * @details
+ * Sends a datagram of a native UDP socket with the data referenced in
+ * place. The buffer must be left untouched until @a cb is called, which
+ * happens once the datagram has been sent by the network device, or
+ * when sending it fails. The callback may be called from the network
+ * TX thread or from the network driver, and must not block.
+ *
+ * Not available from user mode. Requires
+ * :kconfig:option:`CONFIG_NET_SOCKETS_SEND_NOCOPY`.
+ *
+ * @param sock Socket file descriptor
+ * @param buf Data to send
+ * @param len Length of the data
+ * @param flags ZSOCK_MSG_DONTWAIT, or 0
+ * @param dest_addr Destination address, or NULL for a connected socket
+ * @param addrlen Length of the address in @a dest_addr
+ * @param cb Callback called when the buffer is no longer used
+ * @param user_data User data passed to @a cb
+ *
+ * @return Number of bytes sent, or -1 with errno set on error.
+ */
+ssize_t zsock_sendto_nocopy(int sock, const void *buf, size_t len, int flags,
+			    const struct sockaddr *dest_addr, socklen_t addrlen,
+			    zsock_send_done_cb_t cb, void *user_data);
+
 /**
  * @brief Receive data from an arbitrary network address
  *
@@ -439,6 +501,64 @@ static inline ssize_t zsock_recv(int sock, void *buf, size_t max_len,
 	return zsock_recvfrom(sock, buf, max_len, flags, NULL, NULL);
 }
 
+struct net_pkt;
+
+/**
+ * @brief Receive data without copying it
+ *
+ * @details
+ * Hands over the next received network packet of a native TCP or UDP
+ * socket instead of copying its data. The packet cursor is set at the
+ * start of the data, which can be read with net_pkt_read() or walked
+ * through the net_buf fragments of the packet. The packet must be
+ * released with zsock_recv_pkt_release() once the data has been used,
+ * the network buffers it holds are not available to the stack until
+ * then. For stream sockets, the data is acknowledged to the peer when
+ * the packet is handed over.
+ *
+ * Not available from user mode, nor for offloaded or TLS sockets.
+ *
+ * @param sock Socket file descriptor
+ * @param pkt Address where the received packet is stored. Set to NULL
+ *            at the end of a stream.
+ * @param flags ZSOCK_MSG_DONTWAIT, or 0
+ *
+ * @return Length of the data in the packet, 0 at the end of a stream,
+ *         or -1 with errno set on error.
+ */
+ssize_t zsock_recv_pkt(int sock, struct net_pkt **pkt, int flags);
+
+/**
+ * @brief Receive several datagrams with a single call
+ *
+ * @details
+ * Receive datagrams into the messages of @a msgvec, with a single socket
+ * lookup and lock. Only the first datagram is waited for, according to
+ * @a flags and the socket timeout, the call then returns as soon as no
+ * more datagrams are queued. The source address of each datagram is
+ * stored in msg_name if given, its length in msg_len and ZSOCK_MSG_TRUNC
+ * is set in msg_flags if it did not fit in msg_iov.
+ * This function is also exposed as ``recvmmsg()``
+ * if :kconfig:option:`CONFIG_NET_SOCKETS_POSIX_NAMES` is defined.
+ *
+ * @param sock Socket descriptor
+ * @param msgvec Messages to receive into
+ * @param vlen Number of messages in @a msgvec
+ * @param flags Flags, as for zsock_recvfrom(), except ZSOCK_MSG_PEEK
+ *
+ * @return Number of messages received, or -1 with errno set if none
+ *         could be received.
+ */
+int zsock_recvmmsg(int sock, struct mmsghdr *msgvec, unsigned int vlen,
+		   int flags);
+
+/**
+ * @brief Release a packet received with zsock_recv_pkt()
+ *
+ * @param pkt Packet returned by zsock_recv_pkt()
+ */
+void zsock_recv_pkt_release(struct net_pkt *pkt);
+
 /**
  * @brief Control blocking/non-blocking mode of a socket
  *
@@ -810,6 +930,13 @@ static inline ssize_t sendmsg(int sock, const struct msghdr *message,
 	return zsock_sendmsg(sock, message, flags);
 }
 
+/** POSIX wrapper for @ref zsock_sendmmsg */
+static inline int sendmmsg(int sock, struct mmsghdr *msgvec,
+			   unsigned int vlen, int flags)
+{
+	return zsock_sendmmsg(sock, msgvec, vlen, flags);
+}
+
 /** POSIX wrapper for @ref zsock_recvfrom */
 static inline ssize_t recvfrom(int sock, void *buf, size_t max_len, int flags,
 			       struct sockaddr *src_addr, socklen_t *addrlen)
@@ -817,6 +944,20 @@ static inline ssize_t recvfrom(int sock, void *buf, size_t max_len, int flags,
 	return zsock_recvfrom(sock, buf, max_len, flags, src_addr, addrlen);
 }
 
+struct timespec;
+
+/** POSIX wrapper for @ref zsock_recvmmsg, the timeout is not supported and
+ * the socket receive timeout applies instead
+ */
+static inline int recvmmsg(int sock, struct mmsghdr *msgvec,
+			   unsigned int vlen, int flags,
+			   struct timespec *timeout)
+{
+	ARG_UNUSED(timeout);
+
+	return zsock_recvmmsg(sock, msgvec, vlen, flags);
+}
+
 /** POSIX wrapper for @ref zsock_poll */
 static inline int poll(struct zsock_pollfd *fds, int nfds, int timeout)
 {
@@ -1021,6 +1162,8 @@ struct ifreq {
 /* Socket options for IPPROTO_TCP level */
 /** sockopt: Disable TCP buffering (ignored, for compatibility) */
 #define TCP_NODELAY 1
+/** sockopt: Name of the congestion control algorithm of the connection */
+#define TCP_CONGESTION 13
 
 /* Socket options for IPPROTO_IP level */
 /** sockopt: Set or receive the Type-Of-Service value for an outgoing packet. */
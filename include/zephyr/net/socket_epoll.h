@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_NET_SOCKET_EPOLL_H_
+#define ZEPHYR_INCLUDE_NET_SOCKET_EPOLL_H_
+
+/**
+ * @brief BSD Sockets compatible API
+ * @defgroup bsd_sockets BSD Sockets compatible API
+ * @ingroup networking
+ * @{
+ */
+
+#include <zephyr/toolchain.h>
+#include <zephyr/types.h>
+#include <zephyr/sys/util.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Data available for reading */
+#define ZSOCK_EPOLLIN 0x001
+/** Priority data available for reading */
+#define ZSOCK_EPOLLPRI 0x002
+/** Space available for writing */
+#define ZSOCK_EPOLLOUT 0x004
+/** Error condition, always reported */
+#define ZSOCK_EPOLLERR 0x008
+/** Hang up, always reported */
+#define ZSOCK_EPOLLHUP 0x010
+/** Stop reporting events after the first report, until re-armed with
+ * ZSOCK_EPOLL_CTL_MOD
+ */
+#define ZSOCK_EPOLLONESHOT BIT(30)
+
+/** Add a file descriptor to the interest list */
+#define ZSOCK_EPOLL_CTL_ADD 1
+/** Remove a file descriptor from the interest list */
+#define ZSOCK_EPOLL_CTL_DEL 2
+/** Change the events of a file descriptor in the interest list */
+#define ZSOCK_EPOLL_CTL_MOD 3
+
+/** User data returned along with the events of a file descriptor */
+typedef union zsock_epoll_data {
+	void *ptr;
+	int fd;
+	uint32_t u32;
+	uint64_t u64;
+} zsock_epoll_data_t;
+
+/** Events of a file descriptor */
+struct zsock_epoll_event {
+	/** Events, a combination of ZSOCK_EPOLLIN, ZSOCK_EPOLLOUT, ... */
+	uint32_t events;
+	/** User data */
+	zsock_epoll_data_t data;
+};
+
+/**
+ * @brief Create an epoll instance
+ *
+ * @details
+ * The returned file descriptor holds a persistent list of file
+ * descriptors of interest. Their readiness is pushed to the epoll
+ * instance as it changes, so waiting for events costs in proportion to
+ * the number of ready file descriptors instead of the number of file
+ * descriptors of interest. The file descriptor is released with
+ * zsock_close().
+ * This function is also exposed as ``epoll_create1()``
+ * if :kconfig:option:`CONFIG_NET_SOCKETS_POSIX_NAMES` is defined.
+ *
+ * @param flags Must be 0
+ *
+ * @return File descriptor of the epoll instance, or -1 with errno set.
+ */
+__syscall int zsock_epoll_create1(int flags);
+
+/**
+ * @brief Change the interest list of an epoll instance
+ *
+ * @details
+ * Events are level triggered: a file descriptor is reported by every
+ * zsock_epoll_wait() call as long as it is ready. A file descriptor
+ * closed while in the interest list is removed from it.
+ * This function is also exposed as ``epoll_ctl()``
+ * if :kconfig:option:`CONFIG_NET_SOCKETS_POSIX_NAMES` is defined.
+ *
+ * @param epfd Epoll instance file descriptor
+ * @param op ZSOCK_EPOLL_CTL_ADD, ZSOCK_EPOLL_CTL_DEL or ZSOCK_EPOLL_CTL_MOD
+ * @param fd File descriptor to add, remove or change
+ * @param event Events of interest and user data, ignored for
+ *              ZSOCK_EPOLL_CTL_DEL
+ *
+ * @return 0 on success, or -1 with errno set.
+ */
+__syscall int zsock_epoll_ctl(int epfd, int op, int fd,
+			      struct zsock_epoll_event *event);
+
+/**
+ * @brief Wait for events of the file descriptors of an epoll instance
+ *
+ * @details
+ * This function is also exposed as ``epoll_wait()``
+ * if :kconfig:option:`CONFIG_NET_SOCKETS_POSIX_NAMES` is defined.
+ *
+ * @param epfd Epoll instance file descriptor
+ * @param events Array receiving the events of the ready file descriptors
+ * @param maxevents Size of @a events
+ * @param timeout Time to wait in milliseconds, -1 to wait forever
+ *
+ * @return Number of ready file descriptors, 0 on timeout, or -1 with
+ *         errno set.
+ */
+__syscall int zsock_epoll_wait(int epfd, struct zsock_epoll_event *events,
+			       int maxevents, int timeout);
+
+#ifdef CONFIG_NET_SOCKETS_POSIX_NAMES
+
+#define EPOLLIN ZSOCK_EPOLLIN
+#define EPOLLPRI ZSOCK_EPOLLPRI
+#define EPOLLOUT ZSOCK_EPOLLOUT
+#define EPOLLERR ZSOCK_EPOLLERR
+#define EPOLLHUP ZSOCK_EPOLLHUP
+#define EPOLLONESHOT ZSOCK_EPOLLONESHOT
+
+#define EPOLL_CTL_ADD ZSOCK_EPOLL_CTL_ADD
+#define EPOLL_CTL_DEL ZSOCK_EPOLL_CTL_DEL
+#define EPOLL_CTL_MOD ZSOCK_EPOLL_CTL_MOD
+
+#define epoll_data_t zsock_epoll_data_t
+#define epoll_event zsock_epoll_event
+
+static inline int epoll_create1(int flags)
+{
+	return zsock_epoll_create1(flags);
+}
+
+static inline int epoll_create(int size)
+{
+	ARG_UNUSED(size);
+
+	return zsock_epoll_create1(0);
+}
+
+static inline int epoll_ctl(int epfd, int op, int fd,
+			    struct zsock_epoll_event *event)
+{
+	return zsock_epoll_ctl(epfd, op, fd, event);
+}
+
+static inline int epoll_wait(int epfd, struct zsock_epoll_event *events,
+			     int maxevents, int timeout)
+{
+	return zsock_epoll_wait(epfd, events, maxevents, timeout);
+}
+
+#endif /* CONFIG_NET_SOCKETS_POSIX_NAMES */
+
+#ifdef __cplusplus
+}
+#endif
+
+#include <syscalls/socket_epoll.h>
+
+/**
+ * @}
+ */
+
+#endif /* ZEPHYR_INCLUDE_NET_SOCKET_EPOLL_H_ */
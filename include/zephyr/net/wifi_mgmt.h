@@ -67,6 +67,8 @@ enum net_request_wifi_cmd {
 	NET_REQUEST_WIFI_CMD_REG_DOMAIN,
 	/** Set power save timeout */
 	NET_REQUEST_WIFI_CMD_PS_TIMEOUT,
+	/** Get the buffered scan results */
+	NET_REQUEST_WIFI_CMD_SCAN_RESULTS,
 	NET_REQUEST_WIFI_CMD_MAX
 };
 
@@ -129,6 +131,11 @@ NET_MGMT_DEFINE_REQUEST_HANDLER(NET_REQUEST_WIFI_REG_DOMAIN);
 
 NET_MGMT_DEFINE_REQUEST_HANDLER(NET_REQUEST_WIFI_PS_TIMEOUT);
 
+#define NET_REQUEST_WIFI_SCAN_RESULTS			\
+	(_NET_WIFI_BASE | NET_REQUEST_WIFI_CMD_SCAN_RESULTS)
+
+NET_MGMT_DEFINE_REQUEST_HANDLER(NET_REQUEST_WIFI_SCAN_RESULTS);
+
 /** Wi-Fi management events */
 enum net_event_wifi_cmd {
 	/** Scan results available */
@@ -256,6 +263,22 @@ struct wifi_scan_result {
 	uint8_t mac_length;
 };
 
+/** Buffered Wi-Fi scan results, see NET_REQUEST_WIFI_SCAN_RESULTS.
+ *
+ * With CONFIG_WIFI_MGMT_SCAN_RESULTS_BUFFER_SIZE set, the results of a scan
+ * are kept, one per BSSID, instead of being provided one at a time by
+ * NET_EVENT_WIFI_SCAN_RESULT events. They are retrieved once the
+ * NET_EVENT_WIFI_SCAN_DONE event is received, strongest first.
+ */
+struct wifi_scan_results {
+	/** Array the results are copied to */
+	struct wifi_scan_result *results;
+	/** Number of entries of the array */
+	size_t max_count;
+	/** Set to the number of results copied */
+	size_t count;
+};
+
 /** Wi-Fi connect request parameters */
 struct wifi_connect_req_params {
 	/** SSID */
@@ -44,6 +44,12 @@ struct zperf_download_params {
 	uint16_t port;
 };
 
+/** Number of buckets of the one-way latency histogram. Bucket 0 counts the
+ *  latencies below 2 us, bucket i the ones from 2^i to 2^(i+1) - 1 us and the
+ *  last bucket all the larger ones.
+ */
+#define ZPERF_LATENCY_HIST_BUCKETS 16
+
 struct zperf_results {
 	uint32_t nb_packets_sent;
 	uint32_t nb_packets_rcvd;
@@ -55,6 +61,14 @@ struct zperf_results {
 	uint32_t client_time_in_us;
 	uint32_t packet_size;
 	uint32_t nb_packets_errors;
+	/* One-way latency of the received UDP packets, from the timestamp
+	 * they carry. Only meaningful if the clocks of both ends are
+	 * synchronized, like for two interfaces of the same device.
+	 */
+	uint32_t latency_min_in_us;
+	uint32_t latency_avg_in_us;
+	uint32_t latency_max_in_us;
+	uint32_t latency_hist[ZPERF_LATENCY_HIST_BUCKETS];
 };
 
 /**
@@ -122,6 +136,25 @@ int zperf_udp_upload_async(const struct zperf_upload_params *param,
 int zperf_tcp_upload_async(const struct zperf_upload_params *param,
 			   zperf_callback callback, void *user_data);
 
+/**
+ * @brief Synchronous upload over parallel streams. The function blocks until
+ *        all the streams are complete.
+ *
+ * Each stream uses its own socket and thread, with the same parameters. With
+ * UDP, the rate applies to each of the streams. The stream threads are spread
+ * over the CPUs when CONFIG_SCHED_CPU_MASK is enabled.
+ *
+ * @param param Upload parameters.
+ * @param proto Protocol of the streams, IPPROTO_UDP or IPPROTO_TCP.
+ * @param streams Number of streams, up to CONFIG_NET_ZPERF_MAX_STREAMS.
+ * @param results Array of @p streams session results, one for each stream.
+ *
+ * @return 0 if all the sessions completed successfully, a negative error code
+ *         otherwise.
+ */
+int zperf_upload_streams(const struct zperf_upload_params *param, int proto,
+			 size_t streams, struct zperf_results *results);
+
 /**
  * @brief Start UDP server.
  *
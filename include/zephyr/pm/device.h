@@ -120,6 +120,26 @@ typedef int (*pm_device_action_cb_t)(const struct device *dev,
 typedef bool (*pm_device_action_failed_cb_t)(const struct device *dev,
 					 int err);
 
+/**
+ * @brief Device runtime PM statistics
+ */
+struct pm_device_runtime_stats {
+	/** Number of times the device was suspended */
+	uint32_t suspend_count;
+	/** Number of times the device was resumed */
+	uint32_t resume_count;
+	/** Number of queued suspends cancelled by a get (hysteresis hits) */
+	uint32_t cancel_count;
+	/** Duration of the last suspend action, in microseconds */
+	uint32_t suspend_last_us;
+	/** Longest suspend action, in microseconds */
+	uint32_t suspend_max_us;
+	/** Duration of the last resume action, in microseconds */
+	uint32_t resume_last_us;
+	/** Longest resume action, in microseconds */
+	uint32_t resume_max_us;
+};
+
 /**
  * @brief Device PM info
  */
@@ -135,7 +155,13 @@ struct pm_device {
 	uint32_t usage;
 	/** Work object for asynchronous calls */
 	struct k_work_delayable work;
+	/** Delay before an asynchronous suspend is carried out, in ms */
+	uint32_t suspend_delay_ms;
 #endif /* CONFIG_PM_DEVICE_RUNTIME */
+#if defined(CONFIG_PM_DEVICE_RUNTIME_STATS) || defined(__DOXYGEN__)
+	/** Runtime PM statistics */
+	struct pm_device_runtime_stats stats;
+#endif /* CONFIG_PM_DEVICE_RUNTIME_STATS */
 #ifdef CONFIG_PM_DEVICE_POWER_DOMAIN
 	/** Power Domain it belongs */
 	const struct device *domain;
@@ -153,7 +179,8 @@ struct pm_device {
 #ifdef CONFIG_PM_DEVICE_RUNTIME
 #define Z_PM_DEVICE_RUNTIME_INIT(obj)			\
 	.lock = Z_SEM_INITIALIZER(obj.lock, 1, 1),	\
-	.event = Z_EVENT_INITIALIZER(obj.event),
+	.event = Z_EVENT_INITIALIZER(obj.event),	\
+	.suspend_delay_ms = CONFIG_PM_DEVICE_RUNTIME_SUSPEND_DELAY_MS,
 #else
 #define Z_PM_DEVICE_RUNTIME_INIT(obj)
 #endif /* CONFIG_PM_DEVICE_RUNTIME */
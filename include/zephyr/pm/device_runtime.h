@@ -9,6 +9,8 @@
 #define ZEPHYR_INCLUDE_PM_DEVICE_RUNTIME_H_
 
 #include <zephyr/device.h>
+#include <zephyr/kernel.h>
+#include <zephyr/pm/device.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -21,6 +23,31 @@ extern "C" {
  * @{
  */
 
+/**
+ * @brief Asynchronous get completion callback.
+ *
+ * @param dev Device instance.
+ * @param ret Result of the get operation, as returned by
+ * pm_device_runtime_get().
+ * @param user_data User data given to pm_device_runtime_req_init().
+ */
+typedef void (*pm_device_runtime_cb_t)(const struct device *dev, int ret,
+				       void *user_data);
+
+/**
+ * @brief Asynchronous get request.
+ *
+ * @see pm_device_runtime_get_async()
+ */
+struct pm_device_runtime_req {
+	/** @cond INTERNAL_HIDDEN */
+	struct k_work work;
+	const struct device *dev;
+	pm_device_runtime_cb_t cb;
+	void *user_data;
+	/** @endcond */
+};
+
 #if defined(CONFIG_PM_DEVICE_RUNTIME) || defined(__DOXYGEN__)
 /**
  * @brief Automatically enable device runtime based on devicetree properties
@@ -95,6 +122,39 @@ int pm_device_runtime_disable(const struct device *dev);
  */
 int pm_device_runtime_get(const struct device *dev);
 
+/**
+ * @brief Initialize an asynchronous get request.
+ *
+ * @param req Request to initialize.
+ * @param cb Callback invoked once the device is resumed (or failed to).
+ * @param user_data User data passed to @p cb.
+ */
+void pm_device_runtime_req_init(struct pm_device_runtime_req *req,
+				pm_device_runtime_cb_t cb, void *user_data);
+
+/**
+ * @brief Resume a device based on usage count (asynchronously).
+ *
+ * Same as pm_device_runtime_get(), but the resume is carried out by the system
+ * work queue, and the request callback notified when it finishes. If the
+ * device is already in use (or runtime PM is not enabled for it), the callback
+ * is invoked right away from the calling context.
+ *
+ * On success of the callback, the device has to be released with
+ * pm_device_runtime_put() or pm_device_runtime_put_async() as usual.
+ *
+ * @funcprops \pre_kernel_ok, \async, \isr_ok
+ *
+ * @param dev Device instance.
+ * @param req Request, initialized with pm_device_runtime_req_init(). It must
+ * remain valid until the callback is invoked.
+ *
+ * @retval 0 If the request has been completed or queued.
+ * @retval -EBUSY If @p req is still pending.
+ */
+int pm_device_runtime_get_async(const struct device *dev,
+				struct pm_device_runtime_req *req);
+
 /**
  * @brief Suspend a device based on usage count.
  *
@@ -142,6 +202,42 @@ int pm_device_runtime_put(const struct device *dev);
  */
 int pm_device_runtime_put_async(const struct device *dev);
 
+/**
+ * @brief Set the delay applied before an asynchronous suspend.
+ *
+ * Putting a device asynchronously schedules its suspend after this delay. A
+ * get happening in the meantime cancels the suspend, so devices used in
+ * bursts are not powered down and up again between each use. When a device
+ * with a non-zero delay is a power domain, its children release it
+ * asynchronously too.
+ *
+ * The default is given by @kconfig{CONFIG_PM_DEVICE_RUNTIME_SUSPEND_DELAY_MS}.
+ *
+ * @funcprops \pre_kernel_ok, \isr_ok
+ *
+ * @param dev Device instance.
+ * @param delay_ms Delay in milliseconds.
+ *
+ * @retval 0 If it succeeds.
+ * @retval -ENOTSUP If the device does not support PM.
+ */
+int pm_device_runtime_suspend_delay_set(const struct device *dev,
+					uint32_t delay_ms);
+
+#if defined(CONFIG_PM_DEVICE_RUNTIME_STATS) || defined(__DOXYGEN__)
+/**
+ * @brief Obtain the runtime PM statistics of a device.
+ *
+ * @param dev Device instance.
+ * @param stats Where to store the statistics.
+ *
+ * @retval 0 If it succeeds.
+ * @retval -ENOTSUP If the device does not support PM.
+ */
+int pm_device_runtime_stats_get(const struct device *dev,
+				struct pm_device_runtime_stats *stats);
+#endif /* CONFIG_PM_DEVICE_RUNTIME_STATS */
+
 /**
  * @brief Check if device runtime is enabled for a given device.
  *
@@ -182,6 +278,21 @@ static inline int pm_device_runtime_get(const struct device *dev)
 	return 0;
 }
 
+static inline void pm_device_runtime_req_init(struct pm_device_runtime_req *req,
+					      pm_device_runtime_cb_t cb,
+					      void *user_data)
+{
+	req->cb = cb;
+	req->user_data = user_data;
+}
+
+static inline int pm_device_runtime_get_async(const struct device *dev,
+					      struct pm_device_runtime_req *req)
+{
+	req->cb(dev, 0, req->user_data);
+	return 0;
+}
+
 static inline int pm_device_runtime_put(const struct device *dev)
 {
 	ARG_UNUSED(dev);
@@ -194,6 +305,14 @@ static inline int pm_device_runtime_put_async(const struct device *dev)
 	return 0;
 }
 
+static inline int pm_device_runtime_suspend_delay_set(const struct device *dev,
+						      uint32_t delay_ms)
+{
+	ARG_UNUSED(dev);
+	ARG_UNUSED(delay_ms);
+	return 0;
+}
+
 static inline bool pm_device_runtime_is_enabled(const struct device *dev)
 {
 	ARG_UNUSED(dev);
@@ -32,6 +32,7 @@
 #include <zephyr/device.h>
 #include <zephyr/kernel.h>
 #include <zephyr/rtio/rtio_mpsc.h>
+#include <zephyr/rtio/rtio_spsc.h>
 #include <zephyr/sys/__assert.h>
 #include <zephyr/sys/atomic.h>
 #include <zephyr/sys/mem_blocks.h>
@@ -138,6 +139,20 @@ extern "C" {
  */
 #define RTIO_SQE_NO_RESPONSE BIT(5)
 
+/**
+ * @brief The SQE is chained to a periodic delay, which submits it again each period
+ *
+ * Set by the executor, see :c:func:`rtio_sqe_prep_delay`.
+ */
+#define RTIO_SQE_PERIODIC BIT(6)
+
+/**
+ * @brief The SQE chained to a periodic delay runs for the current period
+ *
+ * Set by the executor.
+ */
+#define RTIO_SQE_PERIODIC_RUNNING BIT(7)
+
 /**
  * @}
  */
@@ -277,6 +292,14 @@ struct rtio_sqe {
 			uint8_t *rx_buf;
 		};
 
+#if defined(CONFIG_RTIO_DELAY) || defined(DOXYGEN)
+		/** OP_DELAY */
+		struct {
+			k_timeout_t timeout; /**< Delay, or period of a multishot delay */
+			struct _timeout to; /**< Used by the executor */
+		} delay;
+#endif /* CONFIG_RTIO_DELAY */
+
 	};
 };
 
@@ -317,6 +340,46 @@ struct rtio_block_pool {
 	const uint32_t blk_size;
 };
 
+#if defined(CONFIG_RTIO_USER_RING) || defined(DOXYGEN)
+/**
+ * @brief Submission ring shared with user mode, used with the rtio_spsc macros
+ */
+struct rtio_sq_ring {
+	struct rtio_spsc _spsc;
+	struct rtio_sqe *const buffer;
+};
+
+/**
+ * @brief Completion ring shared with user mode, used with the rtio_spsc macros
+ */
+struct rtio_cq_ring {
+	struct rtio_spsc _spsc;
+	struct rtio_cqe *const buffer;
+};
+
+/**
+ * @brief Kernel side of the rings of an RTIO context shared with user mode
+ *
+ * Only the producer index of the submission ring and the consumer index of
+ * the completion ring are read from the shared memory, everything else the
+ * kernel relies on is kept here out of reach of user mode.
+ */
+struct rtio_ring {
+	struct rtio_sq_ring *const sq;
+	struct rtio_cq_ring *const cq;
+	struct rtio_sqe *const sqes;
+	struct rtio_cqe *const cqes;
+	const unsigned long sq_mask;
+	const unsigned long cq_mask;
+	/* Submissions consumed from the submission ring */
+	unsigned long sq_out;
+	/* Completions produced to the completion ring */
+	unsigned long cq_in;
+	/* Serializes the completions, produced from many contexts */
+	struct k_spinlock lock;
+};
+#endif /* CONFIG_RTIO_USER_RING */
+
 /**
  * @brief An RTIO context containing what can be viewed as a pair of queues.
  *
@@ -370,6 +433,11 @@ struct rtio {
 
 	/* Completion queue */
 	struct rtio_mpsc cq;
+
+#ifdef CONFIG_RTIO_USER_RING
+	/* Rings shared with user mode, if defined with RTIO_DEFINE_WITH_RING */
+	struct rtio_ring *ring;
+#endif
 };
 
 /** The memory partition associated with all RTIO context information */
@@ -458,6 +526,9 @@ struct rtio_iodev {
 /** An operation that transceives (reads and writes simultaneously) */
 #define RTIO_OP_TXRX (RTIO_OP_CALLBACK+1)
 
+/** An operation that completes after a delay */
+#define RTIO_OP_DELAY (RTIO_OP_TXRX+1)
+
 
 /**
  * @brief Prepare a nop (no op) submission
@@ -602,6 +673,37 @@ static inline void rtio_sqe_prep_transceive(struct rtio_sqe *sqe,
 	sqe->userdata = userdata;
 }
 
+#if defined(CONFIG_RTIO_DELAY) || defined(DOXYGEN)
+/**
+ * @brief Prepare a delay op submission
+ *
+ * The delay is done by the executor from the system timeout queue, so that a
+ * chain can wait between two operations without involving a thread.
+ *
+ * With :c:macro:`RTIO_SQE_MULTISHOT` the delay is periodic: it completes once
+ * per period until canceled, each period being counted from the end of the
+ * previous one rather than from the completion. If it is also flagged with
+ * :c:macro:`RTIO_SQE_CHAINED`, the submissions chained to it are submitted
+ * again each period, and reused rather than released. A period ending while
+ * they still run completes with -EBUSY, without submitting them.
+ *
+ * @param sqe Submission to prepare
+ * @param timeout Delay, or period of a multishot delay
+ * @param userdata User data returned in the completions
+ */
+static inline void rtio_sqe_prep_delay(struct rtio_sqe *sqe,
+				       k_timeout_t timeout,
+				       void *userdata)
+{
+	memset(sqe, 0, sizeof(struct rtio_sqe));
+	sqe->op = RTIO_OP_DELAY;
+	sqe->prio = 0;
+	sqe->iodev = NULL;
+	sqe->delay.timeout = timeout;
+	sqe->userdata = userdata;
+}
+#endif /* CONFIG_RTIO_DELAY */
+
 static inline struct rtio_iodev_sqe *rtio_sqe_pool_alloc(struct rtio_sqe_pool *pool)
 {
 	struct rtio_mpsc_node *node = rtio_mpsc_pop(&pool->free_q);
@@ -744,7 +846,7 @@ static inline void rtio_block_pool_free(struct rtio_block_pool *pool, void *buf,
 		.blk_size = blk_sz,								\
 	}
 
-#define Z_RTIO_DEFINE(name, _sqe_pool, _cqe_pool, _block_pool)                                     \
+#define Z_RTIO_DEFINE(name, _sqe_pool, _cqe_pool, _block_pool, _ring)                              \
 	IF_ENABLED(CONFIG_RTIO_SUBMIT_SEM,                                                         \
 		   (static K_SEM_DEFINE(_submit_sem_##name, 0, K_SEM_MAX_LIMIT)))                  \
 	IF_ENABLED(CONFIG_RTIO_CONSUME_SEM,                                                        \
@@ -760,6 +862,7 @@ static inline void rtio_block_pool_free(struct rtio_block_pool *pool, void *buf,
 		IF_ENABLED(CONFIG_RTIO_SYS_MEM_BLOCKS, (.block_pool = _block_pool,))               \
 		.sq = RTIO_MPSC_INIT((name.sq)),                                                   \
 		.cq = RTIO_MPSC_INIT((name.cq)),                                                   \
+		IF_ENABLED(CONFIG_RTIO_USER_RING, (.ring = _ring,))                                \
 	}
 
 /**
@@ -772,7 +875,7 @@ static inline void rtio_block_pool_free(struct rtio_block_pool *pool, void *buf,
 #define RTIO_DEFINE(name, sq_sz, cq_sz)					\
 	Z_RTIO_SQE_POOL_DEFINE(name##_sqe_pool, sq_sz);			\
 	Z_RTIO_CQE_POOL_DEFINE(name##_cqe_pool, cq_sz);			\
-	Z_RTIO_DEFINE(name, &name##_sqe_pool, &name##_cqe_pool, NULL)	\
+	Z_RTIO_DEFINE(name, &name##_sqe_pool, &name##_cqe_pool, NULL, NULL)	\
 
 /* clang-format on */
 
@@ -790,7 +893,81 @@ static inline void rtio_block_pool_free(struct rtio_block_pool *pool, void *buf,
 	Z_RTIO_SQE_POOL_DEFINE(name##_sqe_pool, sq_sz);		\
 	Z_RTIO_CQE_POOL_DEFINE(name##_cqe_pool, cq_sz);			\
 	Z_RTIO_BLOCK_POOL_DEFINE(name##_block_pool, blk_size, num_blks, balign); \
-	Z_RTIO_DEFINE(name, &name##_sqe_pool, &name##_cqe_pool, &name##_block_pool)
+	Z_RTIO_DEFINE(name, &name##_sqe_pool, &name##_cqe_pool, &name##_block_pool, NULL)
+
+#define Z_RTIO_RING_DEFINE(name, sq_sz, cq_sz)						\
+	BUILD_ASSERT(IS_POWER_OF_TWO(sq_sz) && IS_POWER_OF_TWO(cq_sz));			\
+	RTIO_BMEM struct rtio_sqe _ring_sqes_##name[sq_sz];					\
+	RTIO_BMEM struct rtio_cqe _ring_cqes_##name[cq_sz];					\
+	RTIO_DMEM struct rtio_sq_ring _ring_sq_##name =						\
+		RTIO_SPSC_INITIALIZER(sq_sz, _ring_sqes_##name);				\
+	RTIO_DMEM struct rtio_cq_ring _ring_cq_##name =						\
+		RTIO_SPSC_INITIALIZER(cq_sz, _ring_cqes_##name);				\
+	static struct rtio_ring _ring_##name = {						\
+		.sq = &_ring_sq_##name,								\
+		.cq = &_ring_cq_##name,								\
+		.sqes = _ring_sqes_##name,							\
+		.cqes = _ring_cqes_##name,							\
+		.sq_mask = (sq_sz) - 1,								\
+		.cq_mask = (cq_sz) - 1,								\
+	}
+
+/**
+ * @brief Statically define and initialize an RTIO context with rings shared with user mode
+ *
+ * The submission and completion rings are allocated to the rtio_partition, so
+ * that a user thread with the partition in its memory domain produces the
+ * submissions and consumes the completions in place with the rtio_spsc
+ * macros, see RTIO_RING_SQ() and RTIO_RING_CQ(). A call to rtio_submit() copies
+ * and verifies the submissions produced so far in a single system call. The
+ * completions are produced to the completion ring rather than to the queue
+ * read by rtio_cqe_consume() and rtio_cqe_copy_out().
+ *
+ * @param name Name of the RTIO
+ * @param sq_sz Size of the submission queue entry pool and ring, must be power of 2
+ * @param cq_sz Size of the completion ring, must be power of 2
+ */
+#define RTIO_DEFINE_WITH_RING(name, sq_sz, cq_sz)					\
+	Z_RTIO_SQE_POOL_DEFINE(name##_sqe_pool, sq_sz);					\
+	Z_RTIO_CQE_POOL_DEFINE(name##_cqe_pool, 1);					\
+	Z_RTIO_RING_DEFINE(name, sq_sz, cq_sz);						\
+	Z_RTIO_DEFINE(name, &name##_sqe_pool, &name##_cqe_pool, NULL, &_ring_##name)
+
+/**
+ * @brief Statically define and initialize an RTIO context with rings shared with user mode
+ *        and a memory pool
+ *
+ * See RTIO_DEFINE_WITH_RING(). The memory pool is allocated to the
+ * rtio_partition as well, so that the buffers of the completions are read in place.
+ *
+ * @param name Name of the RTIO
+ * @param sq_sz Size of the submission queue entry pool and ring, must be power of 2
+ * @param cq_sz Size of the completion ring, must be power of 2
+ * @param num_blks Number of blocks in the memory pool
+ * @param blk_size The number of bytes in each block
+ * @param balign The block alignment
+ */
+#define RTIO_DEFINE_WITH_RING_AND_MEMPOOL(name, sq_sz, cq_sz, num_blks, blk_size, balign)	\
+	Z_RTIO_SQE_POOL_DEFINE(name##_sqe_pool, sq_sz);					\
+	Z_RTIO_CQE_POOL_DEFINE(name##_cqe_pool, 1);					\
+	Z_RTIO_BLOCK_POOL_DEFINE(name##_block_pool, blk_size, num_blks, balign);		\
+	Z_RTIO_RING_DEFINE(name, sq_sz, cq_sz);						\
+	Z_RTIO_DEFINE(name, &name##_sqe_pool, &name##_cqe_pool, &name##_block_pool,		\
+		      &_ring_##name)
+
+/**
+ * @brief Submission ring of an RTIO context defined with RTIO_DEFINE_WITH_RING()
+ *
+ * @param name Name of the RTIO
+ */
+#define RTIO_RING_SQ(name) (&_ring_sq_##name)
+
+/**
+ * @brief Completion ring of an RTIO context defined with RTIO_DEFINE_WITH_RING()
+ *
+ * @param name Name of the RTIO
+ */
+#define RTIO_RING_CQ(name) (&_ring_cq_##name)
 
 /* clang-format on */
 
@@ -1061,6 +1238,9 @@ static inline int z_impl_rtio_cqe_get_mempool_buffer(const struct rtio *r, struc
 void rtio_executor_submit(struct rtio *r);
 void rtio_executor_ok(struct rtio_iodev_sqe *iodev_sqe, int result);
 void rtio_executor_err(struct rtio_iodev_sqe *iodev_sqe, int result);
+#ifdef CONFIG_RTIO_USER_RING
+int rtio_ring_cqe_submit(struct rtio_ring *ring, int result, void *userdata, uint32_t flags);
+#endif
 
 /**
  * @brief Inform the executor of a submission completion with success
@@ -1119,15 +1299,24 @@ static inline void rtio_iodev_cancel_all(struct rtio_iodev *iodev)
  */
 static inline void rtio_cqe_submit(struct rtio *r, int result, void *userdata, uint32_t flags)
 {
-	struct rtio_cqe *cqe = rtio_cqe_acquire(r);
+#ifdef CONFIG_RTIO_USER_RING
+	if (r->ring != NULL) {
+		if (rtio_ring_cqe_submit(r->ring, result, userdata, flags) != 0) {
+			atomic_inc(&r->xcqcnt);
+		}
+	} else
+#endif
+	{
+		struct rtio_cqe *cqe = rtio_cqe_acquire(r);
 
-	if (cqe == NULL) {
-		atomic_inc(&r->xcqcnt);
-	} else {
-		cqe->result = result;
-		cqe->userdata = userdata;
-		cqe->flags = flags;
-		rtio_cqe_produce(r, cqe);
+		if (cqe == NULL) {
+			atomic_inc(&r->xcqcnt);
+		} else {
+			cqe->result = result;
+			cqe->userdata = userdata;
+			cqe->flags = flags;
+			rtio_cqe_produce(r, cqe);
+		}
 	}
 
 	atomic_inc(&r->cq_count);
@@ -1199,6 +1388,38 @@ static inline int rtio_sqe_rx_buf(const struct rtio_iodev_sqe *iodev_sqe, uint32
 	return 0;
 }
 
+/**
+ * @brief Prepare the buffers of a transaction for a DMA transfer
+ *
+ * Flush the transmit buffers and flush and invalidate the receive buffers of
+ * the submission and of the following ones in its transaction in the d-cache,
+ * waiting for the completion of the cache operations once for all the
+ * buffers, see sys_cache_data_flush_ranges(). Receive buffers from the RTIO
+ * mempool are only handled once obtained with rtio_sqe_rx_buf().
+ *
+ * @param[in] iodev_sqe First submission of the transaction
+ *
+ * @retval 0 If succeeded.
+ * @retval -ENOTSUP If not supported.
+ * @retval -errno Negative errno for other failures.
+ */
+int rtio_txn_cache_flush(const struct rtio_iodev_sqe *iodev_sqe);
+
+/**
+ * @brief Invalidate the receive buffers of a transaction after a DMA transfer
+ *
+ * Invalidate the receive buffers of the submission and of the following ones
+ * in its transaction in the d-cache, waiting for the completion of the cache
+ * operations once for all the buffers, see sys_cache_data_invd_ranges().
+ *
+ * @param[in] iodev_sqe First submission of the transaction
+ *
+ * @retval 0 If succeeded.
+ * @retval -ENOTSUP If not supported.
+ * @retval -errno Negative errno for other failures.
+ */
+int rtio_txn_cache_invd(const struct rtio_iodev_sqe *iodev_sqe);
+
 /**
  * @brief Release memory that was allocated by the RTIO's memory pool
  *
@@ -1387,6 +1608,9 @@ static inline int z_impl_rtio_cqe_copy_out(struct rtio *r,
  * submission chain, freeing submission queue events when done, and
  * producing completion queue events as submissions are completed.
  *
+ * Made from user mode, this also copies the submissions produced to the
+ * submission ring of a context defined with RTIO_DEFINE_WITH_RING().
+ *
  * @param r RTIO context
  * @param wait_count Number of submissions to wait for completion of.
  *
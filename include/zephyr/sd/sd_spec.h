@@ -244,6 +244,7 @@ enum sd_support_flag {
 	SD_3000MV_FLAG = BIT(6),
 	SD_CMD23_FLAG = BIT(7),
 	SD_SPEED_CLASS_CONTROL_FLAG = BIT(8),
+	SD_MMC_CACHE_FLAG = BIT(9),
 };
 
 
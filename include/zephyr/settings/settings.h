@@ -230,6 +230,15 @@ int settings_subsys_init(void);
  */
 int settings_register(struct settings_handler *cf);
 
+/**
+ * Deregister a handler registered with @ref settings_register.
+ *
+ * @param handler Structure given to @ref settings_register.
+ *
+ * @return true if the handler was registered, false otherwise.
+ */
+bool settings_deregister(struct settings_handler *handler);
+
 /**
  * Load serialized items from registered persistence sources. Handlers for
  * serialized item subtrees registered earlier will be called for encountered
@@ -326,6 +335,40 @@ int settings_save_one(const char *name, const void *value, size_t val_len);
  */
 int settings_delete(const char *name);
 
+/**
+ * Start a transaction of settings writes.
+ *
+ * Until settings_txn_commit() or settings_txn_abort(), the values written by
+ * settings_save_one() and settings_delete() from the calling thread are kept
+ * in a buffer of @kconfig{CONFIG_SETTINGS_TXN_BUFFER_SIZE} bytes, only the
+ * last value written to a name being kept. Other threads accessing the
+ * settings wait for the end of the transaction. Loads during the transaction
+ * return the values persisted before it.
+ *
+ * @return 0 on success, -EALREADY if the calling thread already started a
+ * transaction.
+ */
+int settings_txn_begin(void);
+
+/**
+ * Write the values of the transaction to persisted storage and end it.
+ *
+ * The values are written in order of their last write in the transaction,
+ * in a single pass of the storage back-end. A power loss during the commit
+ * can leave part of the values written.
+ *
+ * @return 0 on success, -EINVAL if no transaction was started, or the error
+ * of the first value which could not be written.
+ */
+int settings_txn_commit(void);
+
+/**
+ * Drop the values of the transaction and end it.
+ *
+ * @return 0 on success, -EINVAL if no transaction was started.
+ */
+int settings_txn_abort(void);
+
 /**
  * Call commit for all settings handler. This should apply all
  * settings which has been set, but not applied yet.
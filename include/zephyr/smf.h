@@ -107,8 +107,74 @@ struct smf_ctx {
 	 * used to track state machine context
 	 */
 	uint32_t internal;
+#ifdef CONFIG_SMF_TRANSITION_TABLE
+	/** Transition table of the states, NULL if there is none */
+	const struct smf_table *table;
+#endif
+};
+
+#ifdef CONFIG_SMF_TRANSITION_TABLE
+/** Index of no state in a transition table */
+#define SMF_TABLE_NONE UINT8_MAX
+
+/**
+ * Transition table of a state machine, whose states must all be in one
+ * array of less than SMF_TABLE_NONE states.
+ */
+struct smf_table {
+	/** The states of the state machine */
+	const struct smf_state *states;
+	/** Number of states */
+	uint8_t num_states;
+	/** Nearest ancestor with a run action of each state */
+	uint8_t *run_parent;
+	/**
+	 * Deepest common ancestor of the parents of each pair of current
+	 * and target states, indexed by current * num_states + target
+	 */
+	uint8_t *lca;
 };
 
+/**
+ * @brief Defines the transition table of an array of states
+ *
+ * @param _name   Name of the table
+ * @param _states Array of states
+ */
+#define SMF_TABLE_DEFINE(_name, _states)					\
+	BUILD_ASSERT(ARRAY_SIZE(_states) < SMF_TABLE_NONE,			\
+		     "too many states for a transition table");			\
+	static uint8_t _name##_run_parent[ARRAY_SIZE(_states)];		\
+	static uint8_t _name##_lca[ARRAY_SIZE(_states) * ARRAY_SIZE(_states)];	\
+	static struct smf_table _name = {					\
+		.states = _states,						\
+		.num_states = ARRAY_SIZE(_states),				\
+		.run_parent = _name##_run_parent,				\
+		.lca = _name##_lca,						\
+	}
+
+/**
+ * @brief Computes a transition table
+ *
+ * Must be called once before the table is used by any state machine,
+ * calling it again recomputes the same table.
+ *
+ * @param table Transition table
+ */
+void smf_table_init(struct smf_table *table);
+
+/**
+ * @brief Initializes a state machine using a transition table, and sets
+ *        its initial state.
+ *
+ * @param ctx        State machine context
+ * @param table      Transition table holding all the states of the machine
+ * @param init_state Initial state the state machine starts in.
+ */
+void smf_set_initial_table(struct smf_ctx *ctx, const struct smf_table *table,
+			   const struct smf_state *init_state);
+#endif /* CONFIG_SMF_TRANSITION_TABLE */
+
 /**
  * @brief Initializes the state machine and sets its initial state.
  *
@@ -147,6 +213,32 @@ void smf_set_terminate(struct smf_ctx *ctx, int32_t val);
  */
 int32_t smf_run_state(struct smf_ctx *ctx);
 
+#ifdef CONFIG_SMF_EVENT_QUEUE
+/**
+ * @brief Waits for an event and runs one iteration of a state machine
+ *
+ * Reads an event from a message queue into @p event, where the state
+ * actions can find it, and then runs the state machine as with
+ * smf_run_state().
+ *
+ * Once the state machine terminated, the termination value is returned
+ * without waiting for nor reading an event. Without
+ * CONFIG_SMF_ANCESTOR_SUPPORT, as with smf_run_state(), the iteration
+ * calling smf_set_terminate() returns 0 and the termination value is
+ * returned by the next call.
+ *
+ * @param ctx     State machine context
+ * @param events  Message queue the events are posted to
+ * @param event   Buffer of the size of a message of @p events
+ * @param timeout Time to wait for an event
+ * @return	  As with smf_run_state(), or -EAGAIN if no event was
+ *		  received before the timeout while the state machine is
+ *		  running.
+ */
+int32_t smf_run_event(struct smf_ctx *ctx, struct k_msgq *events, void *event,
+		      k_timeout_t timeout);
+#endif /* CONFIG_SMF_EVENT_QUEUE */
+
 #ifdef __cplusplus
 }
 #endif
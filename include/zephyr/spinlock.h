@@ -35,6 +35,31 @@ struct z_spinlock_key {
 	int key;
 };
 
+/**
+ * @brief Spinlock contention statistics
+ *
+ * Kept for each spinlock when CONFIG_SPINLOCK_STATS is enabled.
+ */
+struct k_spinlock_stats {
+	/** Number of times the lock was taken */
+	uint32_t acquisitions;
+	/** Number of times the lock was found held and had to be waited for */
+	uint32_t contentions;
+	/** Longest wait for the lock, in cycles */
+	uint32_t max_spin_cycles;
+	/** Total time spent waiting for the lock, in cycles */
+	uint64_t spin_cycles;
+};
+
+#ifdef CONFIG_SPINLOCK_MCS
+/* MCS queue node, one per CPU waiting for or holding a lock */
+struct z_spin_mcs_node {
+	atomic_ptr_t next;
+	atomic_t wait;
+	bool used;
+};
+#endif
+
 /**
  * @brief Kernel Spin Lock
  *
@@ -44,8 +69,22 @@ struct z_spinlock_key {
  */
 struct k_spinlock {
 #ifdef CONFIG_SMP
+#if defined(CONFIG_SPINLOCK_TICKET)
+	/* Next ticket to hand out, and ticket of the current holder */
+	atomic_t tail;
+	atomic_t owner;
+#elif defined(CONFIG_SPINLOCK_MCS)
+	/* Last node queued for the lock, NULL if unlocked */
+	atomic_ptr_t tail;
+	/* Queue node of the current holder */
+	struct z_spin_mcs_node *holder;
+#else
 	atomic_t locked;
 #endif
+#ifdef CONFIG_SPINLOCK_STATS
+	struct k_spinlock_stats stats;
+#endif
+#endif /* CONFIG_SMP */
 
 #ifdef CONFIG_SPIN_VALIDATE
 	/* Stores the thread that holds the lock with the locking CPU
@@ -129,6 +168,111 @@ static ALWAYS_INLINE void z_spinlock_validate_post(struct k_spinlock *l)
 #endif /* CONFIG_SPIN_VALIDATE */
 }
 
+/* Time spent waiting for a lock, for CONFIG_SPINLOCK_STATS */
+struct z_spin_wait {
+	uint32_t start;
+	bool spun;
+};
+
+static ALWAYS_INLINE void z_spin_wait_tick(struct z_spin_wait *w)
+{
+	ARG_UNUSED(w);
+#ifdef CONFIG_SPINLOCK_STATS
+	if (!w->spun) {
+		w->spun = true;
+		w->start = sys_clock_cycle_get_32();
+	}
+#endif
+}
+
+static ALWAYS_INLINE void z_spinlock_stats_post(struct k_spinlock *l,
+						struct z_spin_wait *w)
+{
+	ARG_UNUSED(l);
+	ARG_UNUSED(w);
+#ifdef CONFIG_SPINLOCK_STATS
+	l->stats.acquisitions++;
+	if (w->spun) {
+		uint32_t delta = sys_clock_cycle_get_32() - w->start;
+
+		l->stats.contentions++;
+		l->stats.spin_cycles += delta;
+		l->stats.max_spin_cycles = MAX(l->stats.max_spin_cycles, delta);
+	}
+#endif
+}
+
+#ifdef CONFIG_SPINLOCK_MCS
+bool z_spin_mcs_trylock(struct k_spinlock *l);
+void z_spin_mcs_lock(struct k_spinlock *l, struct z_spin_wait *w);
+void z_spin_mcs_unlock(struct k_spinlock *l);
+#endif
+
+#ifdef CONFIG_SMP
+static ALWAYS_INLINE void z_spin_acquire(struct k_spinlock *l,
+					 struct z_spin_wait *w)
+{
+#if defined(CONFIG_SPINLOCK_TICKET)
+	atomic_val_t ticket = atomic_inc(&l->tail);
+
+	while (atomic_get(&l->owner) != ticket) {
+		z_spin_wait_tick(w);
+		arch_spin_relax();
+	}
+#elif defined(CONFIG_SPINLOCK_MCS)
+	z_spin_mcs_lock(l, w);
+#else
+	while (!atomic_cas(&l->locked, 0, 1)) {
+		z_spin_wait_tick(w);
+		arch_spin_relax();
+	}
+#endif
+}
+
+static ALWAYS_INLINE bool z_spin_try_acquire(struct k_spinlock *l)
+{
+#if defined(CONFIG_SPINLOCK_TICKET)
+	atomic_val_t owner = atomic_get(&l->owner);
+
+	return atomic_cas(&l->tail, owner, owner + 1);
+#elif defined(CONFIG_SPINLOCK_MCS)
+	return z_spin_mcs_trylock(l);
+#else
+	return atomic_cas(&l->locked, 0, 1);
+#endif
+}
+
+static ALWAYS_INLINE void z_spin_do_release(struct k_spinlock *l)
+{
+#if defined(CONFIG_SPINLOCK_TICKET)
+	(void)atomic_inc(&l->owner);
+#elif defined(CONFIG_SPINLOCK_MCS)
+	z_spin_mcs_unlock(l);
+#else
+	/* Strictly we don't need atomic_clear() here (which is an
+	 * exchange operation that returns the old value).  We are always
+	 * setting a zero and (because we hold the lock) know the existing
+	 * state won't change due to a race.  But some architectures need
+	 * a memory barrier when used like this, and we don't have a
+	 * Zephyr framework for that.
+	 */
+	atomic_clear(&l->locked);
+#endif
+}
+
+/* Internal function: tells whether the lock is held by any CPU */
+static ALWAYS_INLINE bool z_spin_is_locked(struct k_spinlock *l)
+{
+#if defined(CONFIG_SPINLOCK_TICKET)
+	return atomic_get(&l->tail) != atomic_get(&l->owner);
+#elif defined(CONFIG_SPINLOCK_MCS)
+	return atomic_ptr_get(&l->tail) != NULL;
+#else
+	return atomic_get(&l->locked) != 0;
+#endif
+}
+#endif /* CONFIG_SMP */
+
 /**
  * @brief Lock a spinlock
  *
@@ -161,6 +305,7 @@ static ALWAYS_INLINE k_spinlock_key_t k_spin_lock(struct k_spinlock *l)
 {
 	ARG_UNUSED(l);
 	k_spinlock_key_t k;
+	struct z_spin_wait w = { 0 };
 
 	/* Note that we need to use the underlying arch-specific lock
 	 * implementation.  The "irq_lock()" API in SMP context is
@@ -170,11 +315,10 @@ static ALWAYS_INLINE k_spinlock_key_t k_spin_lock(struct k_spinlock *l)
 
 	z_spinlock_validate_pre(l);
 #ifdef CONFIG_SMP
-	while (!atomic_cas(&l->locked, 0, 1)) {
-		arch_spin_relax();
-	}
+	z_spin_acquire(l, &w);
 #endif
 	z_spinlock_validate_post(l);
+	z_spinlock_stats_post(l, &w);
 
 	return k;
 }
@@ -196,15 +340,17 @@ static ALWAYS_INLINE k_spinlock_key_t k_spin_lock(struct k_spinlock *l)
 static ALWAYS_INLINE int k_spin_trylock(struct k_spinlock *l, k_spinlock_key_t *k)
 {
 	int key = arch_irq_lock();
+	struct z_spin_wait w = { 0 };
 
 	z_spinlock_validate_pre(l);
 #ifdef CONFIG_SMP
-	if (!atomic_cas(&l->locked, 0, 1)) {
+	if (!z_spin_try_acquire(l)) {
 		arch_irq_unlock(key);
 		return -EBUSY;
 	}
 #endif
 	z_spinlock_validate_post(l);
+	z_spinlock_stats_post(l, &w);
 
 	k->key = key;
 
@@ -249,14 +395,7 @@ static ALWAYS_INLINE void k_spin_unlock(struct k_spinlock *l,
 #endif /* CONFIG_SPIN_VALIDATE */
 
 #ifdef CONFIG_SMP
-	/* Strictly we don't need atomic_clear() here (which is an
-	 * exchange operation that returns the old value).  We are always
-	 * setting a zero and (because we hold the lock) know the existing
-	 * state won't change due to a race.  But some architectures need
-	 * a memory barrier when used like this, and we don't have a
-	 * Zephyr framework for that.
-	 */
-	atomic_clear(&l->locked);
+	z_spin_do_release(l);
 #endif
 	arch_irq_unlock(key.key);
 }
@@ -273,7 +412,7 @@ static ALWAYS_INLINE void k_spin_release(struct k_spinlock *l)
 	__ASSERT(z_spin_unlock_valid(l), "Not my spinlock %p", l);
 #endif
 #ifdef CONFIG_SMP
-	atomic_clear(&l->locked);
+	z_spin_do_release(l);
 #endif
 }
 
@@ -345,6 +484,37 @@ static ALWAYS_INLINE void z_spin_onexit(__maybe_unused k_spinlock_key_t *k)
 	for (k_spinlock_key_t __i K_SPINLOCK_ONEXIT = {}, __key = k_spin_lock(lck); !__i.key;      \
 	     k_spin_unlock(lck, __key), __i.key = 1)
 
+#if defined(CONFIG_SPINLOCK_STATS) || defined(__DOXYGEN__)
+/**
+ * @brief Get the contention statistics of a spinlock
+ *
+ * The lock is taken to read the statistics, which counts as an
+ * acquisition.
+ *
+ * @param l A pointer to the spinlock
+ * @param stats Filled with the statistics of @p l
+ */
+static inline void k_spinlock_stats_get(struct k_spinlock *l,
+					struct k_spinlock_stats *stats)
+{
+	K_SPINLOCK(l) {
+		*stats = l->stats;
+	}
+}
+
+/**
+ * @brief Reset the contention statistics of a spinlock
+ *
+ * @param l A pointer to the spinlock
+ */
+static inline void k_spinlock_stats_reset(struct k_spinlock *l)
+{
+	K_SPINLOCK(l) {
+		l->stats = (struct k_spinlock_stats) { 0 };
+	}
+}
+#endif /* CONFIG_SPINLOCK_STATS */
+
 /** @} */
 
 #ifdef __cplusplus
@@ -101,6 +101,40 @@ int disk_access_write(const char *pdrv, const uint8_t *data_buf,
  */
 int disk_access_ioctl(const char *pdrv, uint8_t cmd, void *buff);
 
+#if defined(CONFIG_DISK_CACHE) || defined(__DOXYGEN__)
+/**
+ * @brief Disk cache statistics
+ *
+ * The accesses are counted per cache line, that is per group of
+ * @kconfig{CONFIG_DISK_CACHE_LINE_SECTORS} sectors accessed.
+ */
+struct disk_cache_stats {
+	/** Accesses to lines found in the cache */
+	uint32_t hits;
+	/** Accesses to lines missing from the cache */
+	uint32_t misses;
+	/** Lines read ahead of a missing line */
+	uint32_t read_ahead;
+	/** Dirty lines written back to the disk */
+	uint32_t write_backs;
+};
+
+/**
+ * @brief Get the disk cache statistics
+ *
+ * The statistics are those of all the disks since boot or since the last
+ * call to disk_cache_stats_reset().
+ *
+ * @param[out] stats        Statistics
+ */
+void disk_cache_stats_get(struct disk_cache_stats *stats);
+
+/**
+ * @brief Reset the disk cache statistics
+ */
+void disk_cache_stats_reset(void);
+#endif /* CONFIG_DISK_CACHE */
+
 #ifdef __cplusplus
 }
 #endif
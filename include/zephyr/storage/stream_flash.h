@@ -45,6 +45,19 @@ extern "C" {
  */
 typedef int (*stream_flash_callback_t)(uint8_t *buf, size_t len, size_t offset);
 
+#ifdef CONFIG_STREAM_FLASH_ASYNC
+/** @cond INTERNAL_HIDDEN */
+struct stream_flash_async_buf {
+	size_t bytes; /* Number of payload bytes written */
+	int rc; /* Result of the write */
+#ifdef CONFIG_STREAM_FLASH_ERASE
+	struct flash_async_op erase_op; /* Erase preceding the write */
+#endif
+	struct flash_async_op write_op;
+};
+/** @endcond */
+#endif
+
 /**
  * @brief Structure for stream flash context
  *
@@ -63,6 +76,14 @@ struct stream_flash_ctx {
 #ifdef CONFIG_STREAM_FLASH_ERASE
 	off_t last_erased_page_start_offset; /* Last erased offset */
 #endif
+#ifdef CONFIG_STREAM_FLASH_ASYNC
+	uint8_t *async_base; /* Write buffer parts, NULL if writes are sync */
+	uint8_t async_head; /* Index of the part being filled */
+	uint8_t async_pending; /* Number of parts being written to flash */
+	size_t async_bytes; /* Number of bytes being written to flash */
+	struct k_sem async_done; /* Given on completion of each write */
+	struct stream_flash_async_buf async[CONFIG_STREAM_FLASH_ASYNC_BUFFERS];
+#endif
 };
 
 /**
@@ -79,6 +100,12 @@ struct stream_flash_ctx {
  *             of the flash device minus the offset.
  * @param cb Callback to be invoked on completed flash write operations.
  *
+ * With @kconfig{CONFIG_STREAM_FLASH_ASYNC} and no callback, the write buffer
+ * is split in @kconfig{CONFIG_STREAM_FLASH_ASYNC_BUFFERS} parts, each a
+ * multiple of the write-block-size: one is filled while the others are
+ * written to flash asynchronously. The result of a write is then returned by
+ * a later call writing to flash, or by the flush.
+ *
  * @return non-negative on success, negative errno code on fail
  */
 int stream_flash_init(struct stream_flash_ctx *ctx, const struct device *fdev,
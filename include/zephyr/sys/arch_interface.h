@@ -476,6 +476,19 @@ static inline uint32_t arch_proc_id(void);
  */
 void arch_sched_ipi(void);
 
+#ifdef CONFIG_ARCH_HAS_DIRECTED_IPIS
+/**
+ * Send an interrupt to a set of CPUs
+ *
+ * This will invoke z_sched_ipi() on the CPUs set in @p cpu_bitmap
+ * (bit N for the CPU with ID N).  The bit of the calling CPU, if set,
+ * is ignored.
+ *
+ * @param cpu_bitmap Bitmap of the CPUs to interrupt
+ */
+void arch_sched_directed_ipi(uint32_t cpu_bitmap);
+#endif
+
 #endif /* CONFIG_SMP */
 
 /**
@@ -1155,6 +1168,32 @@ uint32_t arch_timing_freq_get_mhz(void);
 
 #endif /* CONFIG_TIMING_FUNCTIONS */
 
+/**
+ * @defgroup arch-profiler Architecture-specific profiler APIs
+ * @ingroup arch-interface
+ * @{
+ */
+
+#ifdef CONFIG_PROFILER
+/**
+ * @brief Sample the thread interrupted by the current interrupt
+ *
+ * Stores the program counter of the thread context interrupted by the
+ * interrupt being serviced, followed by the return addresses of its callers
+ * as far as the architecture is able to unwind them.
+ *
+ * Must only be called from an interrupt.
+ *
+ * @param buf Buffer receiving the addresses, innermost first
+ * @param size Number of entries of @p buf, at least 1
+ *
+ * @return Number of addresses stored, 0 if no sample could be taken
+ */
+size_t arch_profiler_sample(uintptr_t *buf, size_t size);
+#endif /* CONFIG_PROFILER */
+
+/** @} */
+
 #ifdef CONFIG_PCIE_MSI_MULTI_VECTOR
 
 struct msi_vector;
@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @ingroup hashmap_implementations
+ * @brief Open-Addressing / Robin Hood Hashmap Implementation
+ *
+ * Entries are probed linearly, an entry being inserted taking the bucket of
+ * any entry closer to its ideal bucket, which bounds the probe lengths.
+ * Removed entries are not replaced with tombstones, the entries after them
+ * are shifted back instead, so that lookups do not degrade with removals.
+ *
+ * @note Enable with @kconfig{CONFIG_SYS_HASH_MAP_OA_RH}
+ */
+
+#ifndef ZEPHYR_INCLUDE_SYS_HASH_MAP_OA_RH_H_
+#define ZEPHYR_INCLUDE_SYS_HASH_MAP_OA_RH_H_
+
+#include <stddef.h>
+
+#include <zephyr/sys/hash_function.h>
+#include <zephyr/sys/hash_map_api.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct sys_hashmap_oa_rh_data {
+	void *buckets;
+	size_t n_buckets;
+	size_t size;
+	/* Number of buckets reserved with sys_hashmap_oa_rh_reserve() */
+	size_t min_n_buckets;
+};
+
+/**
+ * @brief Declare a Open Addressing Robin Hood Hashmap (advanced)
+ *
+ * Declare a Open Addressing Robin Hood Hashmap with control over advanced parameters.
+ *
+ * @note The allocator @p _alloc is used for allocating internal Hashmap
+ * entries and does not interact with any user-provided keys or values.
+ *
+ * @param _name Name of the Hashmap.
+ * @param _hash_func Hash function pointer of type @ref sys_hash_func32_t.
+ * @param _alloc_func Allocator function pointer of type @ref sys_hashmap_allocator_t.
+ * @param ... Variant-specific details for @ref sys_hashmap_config.
+ */
+#define SYS_HASHMAP_OA_RH_DEFINE_ADVANCED(_name, _hash_func, _alloc_func, ...)                     \
+	SYS_HASHMAP_DEFINE_ADVANCED(_name, &sys_hashmap_oa_rh_api, sys_hashmap_config,             \
+				    sys_hashmap_oa_rh_data, _hash_func, _alloc_func, __VA_ARGS__)
+
+/**
+ * @brief Declare a Open Addressing Robin Hood Hashmap (advanced)
+ *
+ * Declare a Open Addressing Robin Hood Hashmap with control over advanced parameters.
+ *
+ * @note The allocator @p _alloc is used for allocating internal Hashmap
+ * entries and does not interact with any user-provided keys or values.
+ *
+ * @param _name Name of the Hashmap.
+ * @param _hash_func Hash function pointer of type @ref sys_hash_func32_t.
+ * @param _alloc_func Allocator function pointer of type @ref sys_hashmap_allocator_t.
+ * @param ... Details for @ref sys_hashmap_config.
+ */
+#define SYS_HASHMAP_OA_RH_DEFINE_STATIC_ADVANCED(_name, _hash_func, _alloc_func, ...)              \
+	SYS_HASHMAP_DEFINE_STATIC_ADVANCED(_name, &sys_hashmap_oa_rh_api, sys_hashmap_config,      \
+					   sys_hashmap_oa_rh_data, _hash_func, _alloc_func,        \
+					   __VA_ARGS__)
+
+/**
+ * @brief Declare a Open Addressing Robin Hood Hashmap statically
+ *
+ * Declare a Open Addressing Robin Hood Hashmap statically with default parameters.
+ *
+ * @param _name Name of the Hashmap.
+ */
+#define SYS_HASHMAP_OA_RH_DEFINE_STATIC(_name)                                                     \
+	SYS_HASHMAP_OA_RH_DEFINE_STATIC_ADVANCED(                                                  \
+		_name, sys_hash32, SYS_HASHMAP_DEFAULT_ALLOCATOR,                                  \
+		SYS_HASHMAP_CONFIG(SIZE_MAX, SYS_HASHMAP_DEFAULT_LOAD_FACTOR))
+
+/**
+ * @brief Declare a Open Addressing Robin Hood Hashmap
+ *
+ * Declare a Open Addressing Robin Hood Hashmap with default parameters.
+ *
+ * @param _name Name of the Hashmap.
+ */
+#define SYS_HASHMAP_OA_RH_DEFINE(_name)                                                            \
+	SYS_HASHMAP_OA_RH_DEFINE_ADVANCED(                                                         \
+		_name, sys_hash32, SYS_HASHMAP_DEFAULT_ALLOCATOR,                                  \
+		SYS_HASHMAP_CONFIG(SIZE_MAX, SYS_HASHMAP_DEFAULT_LOAD_FACTOR))
+
+#ifdef CONFIG_SYS_HASH_MAP_CHOICE_OA_RH
+#define SYS_HASHMAP_DEFAULT_DEFINE(_name)	 SYS_HASHMAP_OA_RH_DEFINE(_name)
+#define SYS_HASHMAP_DEFAULT_DEFINE_STATIC(_name) SYS_HASHMAP_OA_RH_DEFINE_STATIC(_name)
+#define SYS_HASHMAP_DEFAULT_DEFINE_ADVANCED(_name, _hash_func, _alloc_func, ...)                   \
+	SYS_HASHMAP_OA_RH_DEFINE_ADVANCED(_name, _hash_func, _alloc_func, __VA_ARGS__)
+#define SYS_HASHMAP_DEFAULT_DEFINE_STATIC_ADVANCED(_name, _hash_func, _alloc_func, ...)            \
+	SYS_HASHMAP_OA_RH_DEFINE_STATIC_ADVANCED(_name, _hash_func, _alloc_func, __VA_ARGS__)
+#endif
+
+extern const struct sys_hashmap_api sys_hashmap_oa_rh_api;
+
+/**
+ * @brief Preallocate the buckets of a Open Addressing Robin Hood Hashmap
+ *
+ * Allocate enough buckets to hold @p n_entries entries within the load factor of the Hashmap.
+ * Until the Hashmap is cleared, it is then neither grown nor shrunk while it holds up to
+ * @p n_entries entries, so that inserting or removing entries never allocates memory.
+ *
+ * @param map Open Addressing Robin Hood Hashmap.
+ * @param n_entries Number of entries to reserve buckets for.
+ *
+ * @retval 0 on success.
+ * @retval -EINVAL if @p n_entries exceeds the maximum size of @p map, or the one supported.
+ * @retval -ENOMEM if memory allocation failed.
+ */
+int sys_hashmap_oa_rh_reserve(struct sys_hashmap *map, size_t n_entries);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_SYS_HASH_MAP_OA_RH_H_ */
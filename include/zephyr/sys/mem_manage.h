@@ -119,6 +119,11 @@ struct k_mem_paging_stats_t {
 		/** Number of page faults while in ISR */
 		unsigned long			in_isr;
 #endif
+
+#ifdef CONFIG_DEMAND_PAGING_PREFETCH
+		/** Number of pages prefetched after a page fault */
+		unsigned long			prefetched;
+#endif
 	} pagefaults;
 
 	struct {
@@ -435,6 +440,31 @@ void k_mem_page_in(void *addr, size_t size);
  */
 void k_mem_pin(void *addr, size_t size);
 
+#ifdef CONFIG_DEMAND_PAGING_PREFETCH
+/**
+ * Mark or unmark a virtual region as accessed sequentially
+ *
+ * A page fault in a sequentially accessed region also pages in the next
+ * CONFIG_DEMAND_PAGING_PREFETCH_PAGES pages of the region, if they are not
+ * already paged in. This suits regions such as code executed mostly in
+ * order, or data streamed through.
+ *
+ * Prefetched pages count in the prefetched page fault statistics, not as
+ * page faults. Prefetching never evicts the faulting page, but may evict
+ * other pages to make room.
+ *
+ * @param addr Base page-aligned virtual address
+ * @param size Page-aligned region size
+ * @param sequential True to mark the region, false to remove a previously
+ *                   marked region with the same base address and size
+ * @retval 0 Success
+ * @retval -ENOMEM No room left for another region, see
+ *         CONFIG_DEMAND_PAGING_PREFETCH_REGIONS
+ * @retval -ENOENT The region to remove was not marked
+ */
+int k_mem_paging_prefetch_hint(void *addr, size_t size, bool sequential);
+#endif /* CONFIG_DEMAND_PAGING_PREFETCH */
+
 /**
  * Un-pin an aligned virtual data region
  *
@@ -11,9 +11,11 @@
  * sys_mutex behaves almost exactly like k_mutex, with the added advantage
  * that a sys_mutex instance can reside in user memory.
  *
- * Further enhancements will support locking/unlocking uncontended sys_mutexes
- * with simple atomic ops instead of syscalls, similar to Linux's
- * FUTEX_LOCK_PI and FUTEX_UNLOCK_PI
+ * With CONFIG_SYS_MUTEX_FAST, uncontended sys_mutexes are locked and
+ * unlocked with simple atomic ops instead of syscalls, similar to Linux's
+ * FUTEX_LOCK_PI and FUTEX_UNLOCK_PI.  The kernel only gets involved on
+ * contention or recursive locking, where it takes over the owner and
+ * applies priority inheritance as for k_mutex.
  */
 
 #ifdef __cplusplus
@@ -24,11 +26,14 @@ extern "C" {
 #include <zephyr/sys/atomic.h>
 #include <zephyr/types.h>
 #include <zephyr/sys_clock.h>
+#ifdef CONFIG_SYS_MUTEX_FAST
+#include <zephyr/kernel.h>
+#endif
 
 struct sys_mutex {
-	/* Currently unused, but will be used to store state for fast mutexes
-	 * that can be locked/unlocked with atomic ops if there is no
-	 * contention
+	/* With CONFIG_SYS_MUTEX_FAST, 0 if unlocked or the owner thread,
+	 * with bit 0 set while the kernel tracks the mutex. Otherwise
+	 * unused.
 	 */
 	atomic_t val;
 };
@@ -79,6 +84,30 @@ __syscall int z_sys_mutex_kernel_lock(struct sys_mutex *mutex,
 
 __syscall int z_sys_mutex_kernel_unlock(struct sys_mutex *mutex);
 
+#ifdef CONFIG_SYS_MUTEX_FAST
+/* Mutexes the kernel accepted from the current thread, by address. Only
+ * those are accessed directly, the others go through the system call
+ * which checks them.
+ */
+extern __thread struct sys_mutex *z_sys_mutex_cache[CONFIG_SYS_MUTEX_FAST_CACHE_SIZE];
+
+static inline struct sys_mutex **z_sys_mutex_cache_slot(struct sys_mutex *mutex)
+{
+	return &z_sys_mutex_cache[((uintptr_t)mutex / sizeof(*mutex)) %
+				  CONFIG_SYS_MUTEX_FAST_CACHE_SIZE];
+}
+
+static inline bool z_sys_mutex_checked(struct sys_mutex *mutex)
+{
+	return (mutex != NULL) && (*z_sys_mutex_cache_slot(mutex) == mutex);
+}
+
+static inline void z_sys_mutex_check_add(struct sys_mutex *mutex)
+{
+	*z_sys_mutex_cache_slot(mutex) = mutex;
+}
+#endif /* CONFIG_SYS_MUTEX_FAST */
+
 /**
  * @brief Lock a mutex.
  *
@@ -98,11 +127,33 @@ __syscall int z_sys_mutex_kernel_unlock(struct sys_mutex *mutex);
  * @retval -EAGAIN Waiting period timed out.
  * @retval -EACCES Caller has no access to provided mutex address
  * @retval -EINVAL Provided mutex not recognized by the kernel
+ * @retval -EPERM With CONFIG_SYS_MUTEX_FAST, the mutex is held by a thread
+ *                the caller has no permission on
+ *
+ * @note With CONFIG_SYS_MUTEX_FAST the mutex word is accessed directly
+ *       once the kernel accepted the mutex from the calling thread, so a
+ *       mutex made inaccessible after that faults instead of returning
+ *       -EACCES.
  */
 static inline int sys_mutex_lock(struct sys_mutex *mutex, k_timeout_t timeout)
 {
-	/* For now, make the syscall unconditionally */
+#ifdef CONFIG_SYS_MUTEX_FAST
+	int ret;
+
+	if (z_sys_mutex_checked(mutex) &&
+	    atomic_cas(&mutex->val, 0, (atomic_val_t)k_current_get())) {
+		return 0;
+	}
+
+	ret = z_sys_mutex_kernel_lock(mutex, timeout);
+	if (ret == 0) {
+		z_sys_mutex_check_add(mutex);
+	}
+
+	return ret;
+#else
 	return z_sys_mutex_kernel_lock(mutex, timeout);
+#endif
 }
 
 /**
@@ -124,7 +175,12 @@ static inline int sys_mutex_lock(struct sys_mutex *mutex, k_timeout_t timeout)
  */
 static inline int sys_mutex_unlock(struct sys_mutex *mutex)
 {
-	/* For now, make the syscall unconditionally */
+#ifdef CONFIG_SYS_MUTEX_FAST
+	if (z_sys_mutex_checked(mutex) &&
+	    atomic_cas(&mutex->val, (atomic_val_t)k_current_get(), 0)) {
+		return 0;
+	}
+#endif
 	return z_sys_mutex_kernel_unlock(mutex);
 }
 
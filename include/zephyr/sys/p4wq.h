@@ -34,6 +34,12 @@ struct k_p4wq_work {
 	bool sync;
 	struct k_sem done_sem;
 
+	/* Mask of the CPUs the item should preferably run on, zero
+	 * for no preference.  Only a hint: it selects which idle
+	 * queue thread gets woken up for the item.
+	 */
+	uint32_t cpu_hint;
+
 	/* reserved for implementation */
 	union {
 		struct rbnode rbnode;
@@ -41,12 +47,34 @@ struct k_p4wq_work {
 	};
 	struct k_thread *thread;
 	struct k_p4wq *queue;
+	/* Taken out of the queue by a thread, not yet running */
+	bool batched;
+#ifdef CONFIG_P4WQ_STATS
+	uint32_t submit_time;
+#endif
 };
 
 #define K_P4WQ_QUEUE_PER_THREAD		BIT(0)
 #define K_P4WQ_DELAYED_START		BIT(1)
 #define K_P4WQ_USER_CPU_MASK		BIT(2)
 
+/**
+ * @brief P4 Queue statistics
+ *
+ * Wait times are measured from submission to the entry of the
+ * handler, in k_cycle_get_32() units.
+ */
+struct k_p4wq_stats {
+	/* Number of work items that were run */
+	uint32_t items;
+	/* Number of work items run as part of a batch */
+	uint32_t batched;
+	/* Sum of the wait times of all work items */
+	uint64_t wait_total;
+	/* Longest wait time of a work item */
+	uint32_t wait_max;
+};
+
 /**
  * @brief P4 Queue
  *
@@ -74,6 +102,10 @@ struct k_p4wq {
 
 	/* K_P4WQ_* flags above */
 	uint32_t flags;
+
+#ifdef CONFIG_P4WQ_STATS
+	struct k_p4wq_stats stats;
+#endif
 };
 
 struct k_p4wq_initparam {
@@ -178,6 +210,12 @@ void k_p4wq_add_thread(struct k_p4wq *queue, struct k_thread *thread,
  * queue.  The memory should remain unchanged until k_p4wq_cancel() is
  * called or until the entry to the handler function.
  *
+ * With @kconfig{CONFIG_P4WQ_BATCH_SIZE} above one, a thread finding
+ * no idle thread to share the work with takes several items of the
+ * same priority out of the queue at once and runs them back to back.
+ * Those items are still considered queued by k_p4wq_cancel(), but a
+ * higher priority item submitted meanwhile runs first.
+ *
  * @note This call is a scheduling point, so if the submitted item (or
  * any other ready thread) has a higher priority than the current
  * thread and the current thread has a preemptible priority then the
@@ -208,4 +246,21 @@ int k_p4wq_wait(struct k_p4wq_work *work, k_timeout_t timeout);
 void k_p4wq_enable_static_thread(struct k_p4wq *queue, struct k_thread *thread,
 				 uint32_t cpu_mask);
 
+#ifdef CONFIG_P4WQ_STATS
+/**
+ * @brief Get the statistics of a P4 queue
+ *
+ * @param queue P4 Queue to query
+ * @param stats Where to store the statistics
+ */
+void k_p4wq_stats_get(struct k_p4wq *queue, struct k_p4wq_stats *stats);
+
+/**
+ * @brief Clear the statistics of a P4 queue
+ *
+ * @param queue P4 Queue whose statistics to clear
+ */
+void k_p4wq_stats_reset(struct k_p4wq *queue);
+#endif
+
 #endif /* ZEPHYR_INCLUDE_SYS_P4WQ_H_ */
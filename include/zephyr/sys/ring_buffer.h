@@ -48,6 +48,13 @@ struct ring_buf {
  *
  * @brief Simple ring buffer implementation.
  *
+ * A single producer and a single consumer can use a ring buffer concurrently
+ * without locking, including from an ISR and from a thread running on
+ * different CPUs: the data is ordered with the indexes exchanged by the
+ * producer and the consumer. The claim routines hand out the largest
+ * contiguous area available, up to the end of the buffer, which can be used
+ * directly as a DMA buffer.
+ *
  * @{
  */
 
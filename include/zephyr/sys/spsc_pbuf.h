@@ -7,6 +7,7 @@
 #ifndef ZEPHYR_INCLUDE_SYS_SPSC_PBUF_H_
 #define ZEPHYR_INCLUDE_SYS_SPSC_PBUF_H_
 
+#include <stdbool.h>
 #include <zephyr/cache.h>
 #include <zephyr/devicetree.h>
 
@@ -186,6 +187,28 @@ int spsc_pbuf_write(struct spsc_pbuf *pb, const char *buf, uint16_t len);
  */
 int spsc_pbuf_alloc(struct spsc_pbuf *pb, uint16_t len, char **buf);
 
+/**
+ * @brief Allocate space in the packet buffer after a packet not committed yet.
+ *
+ * Same as @ref spsc_pbuf_alloc but the space is allocated after the packet
+ * @p prev, so that several packets can be allocated before being committed.
+ * The packets must be committed in the order they were allocated, with
+ * @ref spsc_pbuf_commit_buf, and only the last one allocated can be committed
+ * with a smaller length than the one used for its allocation.
+ *
+ * @param[in]  pb	A buffer to which to write.
+ * @param[in]  prev	Previously allocated packet, not committed yet. If NULL
+ *			the call is equivalent to @ref spsc_pbuf_alloc.
+ * @param[in]  prev_len	Length of the previously allocated packet.
+ * @param[in]  len	Allocation length, see @ref spsc_pbuf_alloc.
+ * @param[out] buf	Location where buffer address is written on successful allocation.
+ *
+ * @retval non-negative Amount of space that got allocated. Can be equal or smaller than %p len.
+ * @retval -EINVAL if @p len is forbidden.
+ */
+int spsc_pbuf_alloc_after(struct spsc_pbuf *pb, const char *prev, uint16_t prev_len,
+			  uint16_t len, char **buf);
+
 /**
  * @brief Commit packet to the buffer.
  *
@@ -197,6 +220,22 @@ int spsc_pbuf_alloc(struct spsc_pbuf *pb, uint16_t len, char **buf);
  */
 void spsc_pbuf_commit(struct spsc_pbuf *pb, uint16_t len);
 
+/**
+ * @brief Commit a packet allocated at a given address.
+ *
+ * Commit the oldest packet allocated with @ref spsc_pbuf_alloc or
+ * @ref spsc_pbuf_alloc_after and not committed yet.
+ *
+ * @param pb	A buffer to which to write.
+ * @param buf	Address of the packet, as returned on allocation.
+ * @param len	Packet length. Must be equal or less than the length used for allocation.
+ *
+ * @retval true The buffer was empty, all the packets committed before had been
+ *		freed by the consumer.
+ * @retval false Otherwise.
+ */
+bool spsc_pbuf_commit_buf(struct spsc_pbuf *pb, const char *buf, uint16_t len);
+
 /**
  * @brief Read specified amount of data from the packet buffer.
  *
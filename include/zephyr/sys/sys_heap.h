@@ -150,6 +150,17 @@ void *sys_heap_aligned_alloc(struct sys_heap *heap, size_t align, size_t bytes);
  */
 void sys_heap_free(struct sys_heap *heap, void *mem);
 
+/**
+ * @cond INTERNAL_HIDDEN
+ *
+ * Same as sys_heap_free() but without heap listener notification, for
+ * allocators layered over a sys_heap that already notified the
+ * listeners of the free when it was requested.
+ */
+void z_sys_heap_free_unnotified(struct sys_heap *heap, void *mem);
+
+/** @endcond */
+
 /** @brief Expand the size of an existing allocation
  *
  * Returns a pointer to a new memory region with the same contents,
@@ -104,6 +104,25 @@ extern void z_dump_object_error(int retval, const void *obj,
  */
 extern struct z_object *z_object_find(const void *obj);
 
+/**
+ * Kernel object lookup on behalf of the current thread
+ *
+ * Same as z_object_find(), the objects last looked up by the current thread
+ * being cached with CONFIG_USERSPACE_OBJ_CACHE.
+ *
+ * @param obj Address of kernel object to get metadata
+ * @return Kernel object's metadata, or NULL if the parameter wasn't the
+ * memory address of a kernel object
+ */
+#ifdef CONFIG_USERSPACE_OBJ_CACHE
+extern struct z_object *z_object_find_cached(const void *obj);
+#else
+static inline struct z_object *z_object_find_cached(const void *obj)
+{
+	return z_object_find(obj);
+}
+#endif
+
 typedef void (*_wordlist_cb_func_t)(struct z_object *ko, void *context);
 
 /**
@@ -449,7 +468,7 @@ static inline int z_obj_validation_check(struct z_object *ko,
 
 #define Z_SYSCALL_IS_OBJ(ptr, type, init) \
 	Z_SYSCALL_VERIFY_MSG(z_obj_validation_check(			\
-				     z_object_find((const void *)ptr),	\
+				     z_object_find_cached((const void *)ptr), \
 				     (const void *)ptr,			\
 				     type, init) == 0, "access denied")
 
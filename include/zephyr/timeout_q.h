@@ -25,6 +25,34 @@ extern "C" {
 static inline void z_init_timeout(struct _timeout *to)
 {
 	sys_dnode_init(&to->node);
+#ifdef CONFIG_TIMEOUT_SLACK
+	to->slack = 0U;
+	to->deferred = 0U;
+#endif
+}
+
+/* Sets the slack the next z_add_timeout() calls on @a to may defer
+ * its expiry by, which is ignored unless CONFIG_TIMEOUT_SLACK=y
+ */
+static inline void z_timeout_slack_set(struct _timeout *to, k_timeout_t slack)
+{
+#ifdef CONFIG_TIMEOUT_SLACK
+	to->slack = (uint32_t)CLAMP(slack.ticks, 0, INT32_MAX);
+#else
+	ARG_UNUSED(to);
+	ARG_UNUSED(slack);
+#endif
+}
+
+/* Ticks the expiry of @a to was deferred by when last added */
+static inline k_ticks_t z_timeout_deferred(const struct _timeout *to)
+{
+#ifdef CONFIG_TIMEOUT_SLACK
+	return to->deferred;
+#else
+	ARG_UNUSED(to);
+	return 0;
+#endif
 }
 
 void z_add_timeout(struct _timeout *to, _timeout_func_t fn,
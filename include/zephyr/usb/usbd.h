@@ -154,6 +154,35 @@ struct usbd_status {
 	unsigned int rwup : 1;
 };
 
+/**
+ * USB device endpoint statistics
+ *
+ * The times are in cycles of the system timer, a request lasts from the
+ * moment it is the oldest one pending on the endpoint until its completion.
+ */
+struct usbd_ep_stats {
+	/** Number of completed requests */
+	uint32_t requests;
+	/** Number of requests completed with an error, or cancelled */
+	uint32_t errors;
+	/** Number of bytes transferred by the successful requests */
+	uint64_t bytes;
+	/** Number of requests queued and not completed yet */
+	uint32_t pending;
+	/** Highest number of pending requests */
+	uint32_t max_pending;
+	/** Duration of the last completed request */
+	uint32_t latency;
+	/** Highest duration of a request */
+	uint32_t max_latency;
+	/** Total time the endpoint had no request pending */
+	uint64_t idle;
+	/** Uptime in milliseconds when the statistics started */
+	int64_t since;
+	/** Start of the oldest pending request, or of the idle period */
+	uint32_t timestamp;
+};
+
 /**
  * USB device support runtime context
  *
@@ -177,6 +206,12 @@ struct usbd_contex {
 	struct usbd_status status;
 	/** Pointer to device descriptor */
 	void *desc;
+#if defined(CONFIG_USBD_EP_STATS) || defined(__DOXYGEN__)
+	/** Endpoint statistics, IN endpoints are in the upper half */
+	struct usbd_ep_stats ep_stats[32];
+	/** Endpoint statistics lock */
+	struct k_spinlock ep_stats_lock;
+#endif
 };
 
 /**
@@ -629,6 +664,35 @@ int usbd_ep_ctrl_enqueue(struct usbd_contex *const uds_ctx,
 int usbd_ep_enqueue(const struct usbd_class_node *const c_nd,
 		    struct net_buf *const buf);
 
+/**
+ * @brief Get the statistics of an endpoint
+ *
+ * Available with @kconfig{CONFIG_USBD_EP_STATS}. The statistics of the
+ * requests of the classes are collected, not the ones of the control
+ * endpoint. The throughput is the number of bytes over the time since the
+ * statistics started, the first request queued after a reset.
+ *
+ * @param[in]  uds_ctx Pointer to USB device support context
+ * @param[in]  ep      Endpoint address
+ * @param[out] stats   Copy of the endpoint statistics
+ *
+ * @return 0 on success, -ENOTSUP if the statistics are not collected
+ */
+int usbd_ep_stats_get(struct usbd_contex *uds_ctx, const uint8_t ep,
+		      struct usbd_ep_stats *stats);
+
+/**
+ * @brief Reset the statistics of an endpoint
+ *
+ * The number of pending requests is kept.
+ *
+ * @param[in] uds_ctx Pointer to USB device support context
+ * @param[in] ep      Endpoint address
+ *
+ * @return 0 on success, -ENOTSUP if the statistics are not collected
+ */
+int usbd_ep_stats_reset(struct usbd_contex *uds_ctx, const uint8_t ep);
+
 /**
  * @brief Remove all USB device controller requests from endpoint queue
  *
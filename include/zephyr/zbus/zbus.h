@@ -11,6 +11,10 @@
 #include <zephyr/kernel.h>
 #include <zephyr/sys/iterable_sections.h>
 
+#if defined(CONFIG_ZBUS_MSG_SUBSCRIBER)
+#include <zephyr/net/buf.h>
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -56,6 +60,19 @@ struct zbus_channel {
 	 * for accessing the channel.
 	 */
 	struct k_mutex *mutex;
+#if defined(CONFIG_ZBUS_CHANNEL_SEQLOCK) || defined(__DOXYGEN__)
+	/** Sequence counter of the lock-free reads. Points to the counter changed before and
+	 * after every change to the message, odd while the message is being changed. NULL when
+	 * the channel is only read with the mutex.
+	 */
+	atomic_t *seq;
+#endif /* CONFIG_ZBUS_CHANNEL_SEQLOCK */
+#if defined(CONFIG_ZBUS_CHANNEL_STATS) || defined(__DOXYGEN__)
+	/** Channel statistics. Points to the statistics updated by the event dispatcher while
+	 * holding the channel's mutex.
+	 */
+	struct zbus_channel_stats *stats;
+#endif /* CONFIG_ZBUS_CHANNEL_STATS */
 #if (CONFIG_ZBUS_RUNTIME_OBSERVERS_POOL_SIZE > 0) || defined(__DOXYGEN__)
 	/** Dynamic channel observer list. Represents the channel's observers list, it can be empty
 	 * or have listeners and subscribers mixed in any sequence. It can be changed in runtime.
@@ -69,6 +86,48 @@ struct zbus_channel {
 	const struct zbus_observer *const *observers;
 };
 
+#if defined(CONFIG_ZBUS_CHANNEL_STATS) || defined(__DOXYGEN__)
+
+/**
+ * @brief Channel statistics.
+ *
+ * The durations are in hardware cycles, see k_cyc_to_ns_floor64().
+ */
+struct zbus_channel_stats {
+	/** Number of notifications, from publishing or forced. */
+	uint32_t notify_count;
+	/** Longest time from the publish or notify call until all the observers were notified. */
+	uint32_t notify_cycles_max;
+	/** Total time from the publish or notify calls until all the observers were notified. */
+	uint64_t notify_cycles_total;
+	/** Number of calls to the synchronous listeners. */
+	uint32_t listener_count;
+	/** Longest execution time of a synchronous listener. */
+	uint32_t listener_cycles_max;
+	/** Total execution time of the synchronous listeners. */
+	uint64_t listener_cycles_total;
+};
+
+#endif /* CONFIG_ZBUS_CHANNEL_STATS */
+
+#if defined(CONFIG_ZBUS_ASYNC_LISTENER) || defined(__DOXYGEN__)
+
+/**
+ * @brief Work of an asynchronous listener.
+ *
+ * The fields are internal to zbus.
+ */
+struct zbus_async_listener_work {
+	/** Work item running the callback on the zbus work queue. */
+	struct k_work work;
+	/** Queue of the notifying channels' references. */
+	struct k_msgq *const queue;
+	/** The asynchronous listener. */
+	const struct zbus_observer *const obs;
+};
+
+#endif /* CONFIG_ZBUS_ASYNC_LISTENER */
+
 /**
  * @brief Type used to represent an observer.
  *
@@ -96,6 +155,20 @@ struct zbus_observer {
 
 	/** Observer callback function. It turns the observer into a listener. */
 	void (*const callback)(const struct zbus_channel *chan);
+
+#if defined(CONFIG_ZBUS_MSG_SUBSCRIBER) || defined(__DOXYGEN__)
+	/** Observer message FIFO. It turns the observer into a message subscriber, receiving
+	 * the snapshots of the messages.
+	 */
+	struct k_fifo *const message_fifo;
+#endif /* CONFIG_ZBUS_MSG_SUBSCRIBER */
+
+#if defined(CONFIG_ZBUS_ASYNC_LISTENER) || defined(__DOXYGEN__)
+	/** Observer work. It turns the listener into an asynchronous listener, whose callback
+	 * runs on the zbus work queue.
+	 */
+	struct zbus_async_listener_work *const async;
+#endif /* CONFIG_ZBUS_ASYNC_LISTENER */
 };
 
 /** @cond INTERNAL_HIDDEN */
@@ -136,6 +209,26 @@ struct zbus_observer {
 #define ZBUS_RUNTIME_OBSERVERS_LIST_INIT(_slist_name) /* No runtime observers */
 #endif
 
+#if defined(CONFIG_ZBUS_CHANNEL_SEQLOCK)
+#define ZBUS_CHANNEL_SEQ_INIT(_seq) .seq = (_seq),
+#else
+#define ZBUS_CHANNEL_SEQ_INIT(_seq)
+#endif
+
+#if defined(CONFIG_ZBUS_CHANNEL_STATS)
+#define ZBUS_CHANNEL_STATS_DECL(_stats_name) static struct zbus_channel_stats _stats_name
+#define ZBUS_CHANNEL_STATS_INIT(_stats_name) .stats = &_stats_name,
+#else
+#define ZBUS_CHANNEL_STATS_DECL(_stats_name)
+#define ZBUS_CHANNEL_STATS_INIT(_stats_name)
+#endif
+
+#if defined(CONFIG_ZBUS_ASYNC_LISTENER)
+#define _ZBUS_OBS_IS_ASYNC(_obs) ((_obs)->async != NULL)
+#else
+#define _ZBUS_OBS_IS_ASYNC(_obs) false
+#endif
+
 #if defined(CONFIG_ZBUS_STRUCTS_ITERABLE_ACCESS)
 #define _ZBUS_STRUCT_DECLARE(_type, _name) STRUCT_SECTION_ITERABLE(_type, _name)
 #else
@@ -177,6 +270,32 @@ struct zbus_observer {
  */
 #define ZBUS_OBSERVERS(...) __VA_ARGS__
 
+/** @cond INTERNAL_HIDDEN */
+
+/* _observers and _init_val are given in brackets, they can contain commas */
+#define _ZBUS_CHAN_DEFINE(_name, _type, _validator, _user_data, _observers, _init_val, _seq)  \
+	static _type _CONCAT(_zbus_message_, _name) = __DEBRACKET _init_val;                 \
+	static K_MUTEX_DEFINE(_CONCAT(_zbus_mutex_, _name));                                 \
+	ZBUS_RUNTIME_OBSERVERS_LIST_DECL(_CONCAT(_runtime_observers_, _name));               \
+	ZBUS_CHANNEL_STATS_DECL(_CONCAT(_zbus_stats_, _name));                               \
+	FOR_EACH_NONEMPTY_TERM(_ZBUS_OBS_EXTERN, (;), __DEBRACKET _observers)                \
+	static const struct zbus_observer *const _CONCAT(_zbus_observers_, _name)[] = {      \
+	FOR_EACH_NONEMPTY_TERM(ZBUS_REF, (,), __DEBRACKET _observers) NULL};                 \
+	const _ZBUS_STRUCT_DECLARE(zbus_channel, _name) = {                                  \
+		ZBUS_CHANNEL_NAME_INIT(_name)		       /* Name */                    \
+		.message_size = sizeof(_type),	               /* Message size */            \
+		.user_data = _user_data,		       /* User data */               \
+		.message = &_CONCAT(_zbus_message_, _name),    /* Reference to the message */\
+		.validator = (_validator),		       /* Validator function */      \
+		.mutex = &_CONCAT(_zbus_mutex_, _name),	       /* Channel's Mutex */         \
+		ZBUS_CHANNEL_SEQ_INIT(_seq)		       /* Sequence counter */        \
+		ZBUS_CHANNEL_STATS_INIT(_CONCAT(_zbus_stats_, _name)) /* Statistics */       \
+		ZBUS_RUNTIME_OBSERVERS_LIST_INIT(                                            \
+			_CONCAT(_runtime_observers_, _name))   /* Runtime observer list */   \
+		.observers = _CONCAT(_zbus_observers_, _name)} /* Static observer list */
+
+/** @endcond */
+
 /**
  * @brief Zbus channel definition.
  *
@@ -193,22 +312,35 @@ struct zbus_observer {
  * @param _init_val The message initialization.
  */
 #define ZBUS_CHAN_DEFINE(_name, _type, _validator, _user_data, _observers, _init_val)        \
-	static _type _CONCAT(_zbus_message_, _name) = _init_val;                             \
-	static K_MUTEX_DEFINE(_CONCAT(_zbus_mutex_, _name));                                 \
-	ZBUS_RUNTIME_OBSERVERS_LIST_DECL(_CONCAT(_runtime_observers_, _name));               \
-	FOR_EACH_NONEMPTY_TERM(_ZBUS_OBS_EXTERN, (;), _observers)                            \
-	static const struct zbus_observer *const _CONCAT(_zbus_observers_, _name)[] = {      \
-	FOR_EACH_NONEMPTY_TERM(ZBUS_REF, (,), _observers) NULL};                             \
-	const _ZBUS_STRUCT_DECLARE(zbus_channel, _name) = {                                  \
-		ZBUS_CHANNEL_NAME_INIT(_name)		       /* Name */                    \
-		.message_size = sizeof(_type),	               /* Message size */            \
-		.user_data = _user_data,		       /* User data */               \
-		.message = &_CONCAT(_zbus_message_, _name),    /* Reference to the message */\
-		.validator = (_validator),		       /* Validator function */      \
-		.mutex = &_CONCAT(_zbus_mutex_, _name),	       /* Channel's Mutex */         \
-		ZBUS_RUNTIME_OBSERVERS_LIST_INIT(                                            \
-			_CONCAT(_runtime_observers_, _name))   /* Runtime observer list */   \
-		.observers = _CONCAT(_zbus_observers_, _name)} /* Static observer list */
+	_ZBUS_CHAN_DEFINE(_name, _type, _validator, _user_data, (_observers), (_init_val), NULL)
+
+#if defined(CONFIG_ZBUS_CHANNEL_SEQLOCK) || defined(__DOXYGEN__)
+
+/**
+ * @brief Zbus lock-free channel definition.
+ *
+ * This macro defines a channel read without its mutex. The readers copy the message while it is
+ * not being changed and retry if it was changed during the copy, so they never block a publisher,
+ * nor wait for the observers to be notified. The readers only wait on the mutex while a publisher
+ * is changing the message, or after @kconfig{CONFIG_ZBUS_CHANNEL_SEQLOCK_READ_RETRIES} torn
+ * copies. Publishing, notifying and claiming use the mutex as on other channels.
+ *
+ * @param _name The channel's name.
+ * @param _type The Message type. It must be a struct or union.
+ * @param _validator The validator function.
+ * @param _user_data A pointer to the user data.
+ * @param _observers The observers list. The sequence indicates the priority of the observer. The
+ * first the highest priority.
+ * @param _init_val The message initialization.
+ *
+ * @see ZBUS_CHAN_DEFINE
+ */
+#define ZBUS_CHAN_SEQLOCK_DEFINE(_name, _type, _validator, _user_data, _observers, _init_val) \
+	static atomic_t _CONCAT(_zbus_seq_, _name);                                          \
+	_ZBUS_CHAN_DEFINE(_name, _type, _validator, _user_data, (_observers), (_init_val),   \
+			  &_CONCAT(_zbus_seq_, _name))
+
+#endif /* CONFIG_ZBUS_CHANNEL_SEQLOCK */
 
 /**
  * @brief Initialize a message.
@@ -242,6 +374,29 @@ struct zbus_observer {
 					       .enabled = true,                                    \
 				       .queue = &_zbus_observer_queue_##_name, .callback = NULL}
 
+#if defined(CONFIG_ZBUS_MSG_SUBSCRIBER) || defined(__DOXYGEN__)
+
+/**
+ * @brief Define and initialize a message subscriber.
+ *
+ * This macro defines an observer of message subscriber type. It defines a FIFO where the
+ * subscriber receives, for every notification, a snapshot of the channel's message taken when the
+ * notification was sent, and initialize the ``struct zbus_observer`` defining the subscriber.
+ * The messages are copied once for all the message subscribers of a channel, in buffers of a pool
+ * sized with @kconfig{CONFIG_ZBUS_MSG_SUBSCRIBER_NET_BUF_POOL_SIZE}.
+ *
+ * @param[in] _name The message subscriber's name.
+ */
+#define ZBUS_MSG_SUBSCRIBER_DEFINE(_name)                                                          \
+	static K_FIFO_DEFINE(_zbus_observer_fifo_##_name);                                        \
+	_ZBUS_STRUCT_DECLARE(zbus_observer,                                                        \
+			     _name) = {ZBUS_OBSERVER_NAME_INIT(_name) /* Name field */             \
+					       .enabled = true,                                    \
+				       .queue = NULL, .callback = NULL,                            \
+				       .message_fifo = &_zbus_observer_fifo_##_name}
+
+#endif /* CONFIG_ZBUS_MSG_SUBSCRIBER */
+
 /**
  * @brief Define and initialize a listener.
  *
@@ -258,6 +413,42 @@ struct zbus_observer {
 					       .enabled = true,                                    \
 				       .queue = NULL, .callback = (_cb)}
 
+#if defined(CONFIG_ZBUS_ASYNC_LISTENER) || defined(__DOXYGEN__)
+
+/** @cond INTERNAL_HIDDEN */
+
+void _zbus_async_listener_handler(struct k_work *work);
+
+/** @endcond */
+
+/**
+ * @brief Define and initialize an asynchronous listener.
+ *
+ * This macro defines an observer of asynchronous listener type. The callback is not called by the
+ * event dispatcher, but on the zbus work queue, so that a slow callback does not delay the
+ * notification of the other observers. The channel is not locked when the callback runs, the
+ * callback must read the channel to access the message, as a subscriber does.
+ *
+ * @param[in] _name The asynchronous listener's name.
+ * @param[in] _cb The callback function.
+ * @param[in] _queue_size The size of the queue of the notifications waiting for the callback.
+ */
+#define ZBUS_ASYNC_LISTENER_DEFINE(_name, _cb, _queue_size)                                        \
+	K_MSGQ_DEFINE(_zbus_observer_queue_##_name, sizeof(const struct zbus_channel *),           \
+		      _queue_size, sizeof(const struct zbus_channel *));                           \
+	_ZBUS_OBS_EXTERN(_name);                                                                   \
+	static struct zbus_async_listener_work _zbus_observer_work_##_name = {                     \
+		.work = Z_WORK_INITIALIZER(_zbus_async_listener_handler),                          \
+		.queue = &_zbus_observer_queue_##_name,                                            \
+		.obs = &_name};                                                                    \
+	_ZBUS_STRUCT_DECLARE(zbus_observer,                                                        \
+			     _name) = {ZBUS_OBSERVER_NAME_INIT(_name) /* Name field */             \
+					       .enabled = true,                                    \
+				       .queue = NULL, .callback = (_cb),                           \
+				       .async = &_zbus_observer_work_##_name}
+
+#endif /* CONFIG_ZBUS_ASYNC_LISTENER */
+
 /**
  *
  * @brief Publish to a channel
@@ -286,6 +477,9 @@ int zbus_chan_pub(const struct zbus_channel *chan, const void *msg, k_timeout_t
  *
  * This routine reads a message from a channel.
  *
+ * On a lock-free channel, the message is copied without the mutex, the timeout only applies when
+ * the message is being changed.
+ *
  * @param[in] chan The channel's reference.
  * @param[out] msg Reference to the message where the read function copies the channel's
  * message data to.
@@ -453,12 +647,79 @@ static inline void *zbus_chan_user_data(const struct zbus_channel *chan)
 	return chan->user_data;
 }
 
+#if defined(CONFIG_ZBUS_CHANNEL_STATS) || defined(__DOXYGEN__)
+
+/**
+ * @brief Get the channel's statistics.
+ *
+ * This routine copies the channel's statistics, read with the channel's mutex.
+ *
+ * @param[in] chan The channel's reference.
+ * @param[out] stats Reference to the statistics where the function copies the channel's ones to.
+ * @param[in] timeout Waiting period to lock the channel,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Statistics copied.
+ * @retval -EBUSY The channel is busy.
+ * @retval -EAGAIN Waiting period timed out.
+ * @retval -EFAULT A parameter is incorrect, or the function context is invalid (inside an ISR). The
+ * function only returns this value when the CONFIG_ZBUS_ASSERT_MOCK is enabled.
+ */
+int zbus_chan_stats_get(const struct zbus_channel *chan, struct zbus_channel_stats *stats,
+			k_timeout_t timeout);
+
+/**
+ * @brief Reset the channel's statistics.
+ *
+ * @param chan The channel's reference.
+ * @param timeout Waiting period to lock the channel,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Statistics reset.
+ * @retval -EBUSY The channel is busy.
+ * @retval -EAGAIN Waiting period timed out.
+ * @retval -EFAULT A parameter is incorrect, or the function context is invalid (inside an ISR). The
+ * function only returns this value when the CONFIG_ZBUS_ASSERT_MOCK is enabled.
+ */
+int zbus_chan_stats_reset(const struct zbus_channel *chan, k_timeout_t timeout);
+
+#endif /* CONFIG_ZBUS_CHANNEL_STATS */
+
 #if (CONFIG_ZBUS_RUNTIME_OBSERVERS_POOL_SIZE > 0) || defined(__DOXYGEN__)
 
+/** Priority of the runtime observers added with zbus_chan_add_obs(). */
+#define ZBUS_OBS_PRIO_DEFAULT 128
+
+/**
+ * @brief Add an observer to a channel with a priority.
+ *
+ * This routine adds an observer to the channel. The runtime observers are notified after the
+ * static ones, by increasing priority value, the observers of the same priority being notified in
+ * the order they were added. The order is kept by the channel's runtime observers list, so that it
+ * is not computed again on every notification.
+ *
+ * @param chan The channel's reference.
+ * @param obs The observer's reference to be added.
+ * @param prio The observer's priority, the lower value the first notified.
+ * @param timeout Waiting period to add an observer,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Observer added to the channel.
+ * @retval -EEXIST The observer is already a static observer of the channel.
+ * @retval -EALREADY The observer is already present in the channel's runtime observers list.
+ * @retval -ENOMEM Returned without waiting.
+ * @retval -EAGAIN Waiting period timed out.
+ * @retval -EINVAL Some parameter is invalid.
+ */
+int zbus_chan_add_obs_with_prio(const struct zbus_channel *chan, const struct zbus_observer *obs,
+				uint8_t prio, k_timeout_t timeout);
+
 /**
  * @brief Add an observer to a channel.
  *
- * This routine adds an observer to the channel.
+ * This routine adds an observer to the channel, with the priority @ref ZBUS_OBS_PRIO_DEFAULT.
+ *
+ * @see zbus_chan_add_obs_with_prio
  *
  * @param chan The channel's reference.
  * @param obs The observer's reference to be added.
@@ -508,6 +769,7 @@ struct k_mem_slab *zbus_runtime_obs_pool(void);
 struct zbus_observer_node {
 	sys_snode_t node;
 	const struct zbus_observer *obs;
+	uint8_t prio;
 };
 
 /** @endcond */
@@ -577,6 +839,59 @@ static inline const char *zbus_obs_name(const struct zbus_observer *obs)
 int zbus_sub_wait(const struct zbus_observer *sub, const struct zbus_channel **chan,
 		  k_timeout_t timeout);
 
+#if defined(CONFIG_ZBUS_MSG_SUBSCRIBER) || defined(__DOXYGEN__)
+
+/**
+ * @brief Wait for a channel message, without copying it.
+ *
+ * This routine makes the message subscriber wait for a notification. The notification comes as a
+ * channel reference and a buffer holding the snapshot of the channel's message, shared with the
+ * other message subscribers of the notification. The buffer must be released with
+ * net_buf_unref() once the message is not used anymore.
+ *
+ * @param[in] sub The message subscriber's reference.
+ * @param[out] chan The notification channel's reference.
+ * @param[out] buf The buffer holding the message, whose data must not be changed.
+ * @param[in] timeout Waiting period for a notification arrival,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Message received.
+ * @retval -ENOMSG Returned without waiting.
+ * @retval -EAGAIN Waiting period timed out.
+ * @retval -EINVAL The observer is not a message subscriber.
+ * @retval -EFAULT A parameter is incorrect, or the function context is invalid (inside an ISR). The
+ * function only returns this value when the CONFIG_ZBUS_ASSERT_MOCK is enabled.
+ */
+int zbus_sub_wait_msg_buf(const struct zbus_observer *sub, const struct zbus_channel **chan,
+			  struct net_buf **buf, k_timeout_t timeout);
+
+/**
+ * @brief Wait for a channel message.
+ *
+ * This routine makes the message subscriber wait for a notification, and copies the snapshot of
+ * the channel's message taken when the notification was sent. Unlike zbus_chan_read(), the channel
+ * is not accessed, and every published message is received, even if the channel was published
+ * again since.
+ *
+ * @param[in] sub The message subscriber's reference.
+ * @param[out] chan The notification channel's reference.
+ * @param[out] msg Reference to the message where the function copies the snapshot to. It must be
+ * large enough for the messages of all the channels observed.
+ * @param[in] timeout Waiting period for a notification arrival,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Message received.
+ * @retval -ENOMSG Returned without waiting.
+ * @retval -EAGAIN Waiting period timed out.
+ * @retval -EINVAL The observer is not a message subscriber.
+ * @retval -EFAULT A parameter is incorrect, or the function context is invalid (inside an ISR). The
+ * function only returns this value when the CONFIG_ZBUS_ASSERT_MOCK is enabled.
+ */
+int zbus_sub_wait_msg(const struct zbus_observer *sub, const struct zbus_channel **chan, void *msg,
+		      k_timeout_t timeout);
+
+#endif /* CONFIG_ZBUS_MSG_SUBSCRIBER */
+
 #if defined(CONFIG_ZBUS_STRUCTS_ITERABLE_ACCESS) || defined(__DOXYGEN__)
 /**
  *
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/linker/section_tags.h>
+#include <kernel_boot_profile.h>
+
+/* Recording starts before the BSS is cleared and the data copied, hence the
+ * no-init section, which also keeps the profile of the previous boot until
+ * the next one starts.
+ */
+static __pinned_noinit struct {
+	atomic_t count;
+	bool clock_ready;
+	struct boot_profile_span spans[CONFIG_BOOT_PROFILE_SPANS];
+} boot_profile;
+
+/* Set once the BSS is cleared, by architectures doing it in z_bss_zero() */
+static bool boot_profile_started;
+
+/* The recording functions are called from z_bss_zero() and z_data_copy(),
+ * which run before anything but the boot and pinned sections is mapped
+ */
+__pinned_func
+uint32_t __weak z_boot_profile_cycles(void)
+{
+	return boot_profile.clock_ready ? k_cycle_get_32() : 0U;
+}
+
+__boot_func
+void z_boot_profile_start(void)
+{
+	atomic_clear(&boot_profile.count);
+	boot_profile.clock_ready = false;
+}
+
+__boot_func
+void z_boot_profile_cstart(void)
+{
+	if (!boot_profile_started) {
+		z_boot_profile_start();
+	}
+}
+
+__pinned_func
+int z_boot_profile_enter(enum boot_profile_step step, uint8_t level,
+			 const struct init_entry *entry)
+{
+	atomic_val_t slot = atomic_inc(&boot_profile.count);
+
+	if (slot >= CONFIG_BOOT_PROFILE_SPANS) {
+		return -1;
+	}
+
+	boot_profile.spans[slot].entry = entry;
+	boot_profile.spans[slot].step = step;
+	boot_profile.spans[slot].level = level;
+	boot_profile.spans[slot].start_cycles = z_boot_profile_cycles();
+	boot_profile.spans[slot].end_cycles = boot_profile.spans[slot].start_cycles;
+
+	return slot;
+}
+
+__pinned_func
+void z_boot_profile_exit(int slot)
+{
+	if (slot < 0) {
+		return;
+	}
+
+	boot_profile.spans[slot].end_cycles = z_boot_profile_cycles();
+
+	if (boot_profile.spans[slot].step == BOOT_PROFILE_BSS_ZERO) {
+		boot_profile_started = true;
+	}
+}
+
+__pinned_func
+void z_boot_profile_clock_ready(void)
+{
+	boot_profile.clock_ready = true;
+}
+
+int boot_profile_foreach(boot_profile_cb_t cb, void *user_data)
+{
+	atomic_val_t count = atomic_get(&boot_profile.count);
+
+	for (atomic_val_t i = 0; i < MIN(count, CONFIG_BOOT_PROFILE_SPANS); i++) {
+		cb(&boot_profile.spans[i], user_data);
+	}
+
+	return MAX(count - CONFIG_BOOT_PROFILE_SPANS, 0);
+}
@@ -18,11 +18,85 @@
  * The state object is always zero-initialized, but this may not be
  * sufficient.
  */
+#ifdef CONFIG_DEVICE_NAME_HASH
+BUILD_ASSERT(IS_POWER_OF_TWO(CONFIG_DEVICE_NAME_HASH_SLOTS),
+	     "CONFIG_DEVICE_NAME_HASH_SLOTS must be a power of two");
+
+/* Open addressing index of the static devices, holding index + 1 of each
+ * device in the section, 0 for an empty slot.
+ */
+static uint16_t device_name_slots[CONFIG_DEVICE_NAME_HASH_SLOTS];
+static bool device_name_hashed;
+
+static uint32_t device_name_hash(const char *name)
+{
+	/* FNV-1a */
+	uint32_t hash = 2166136261U;
+
+	while (*name != '\0') {
+		hash = (hash ^ (uint8_t)*name++) * 16777619U;
+	}
+
+	return hash;
+}
+
+static void device_name_hash_init(void)
+{
+	const size_t mask = CONFIG_DEVICE_NAME_HASH_SLOTS - 1;
+	size_t cnt;
+
+	STRUCT_SECTION_COUNT(device, &cnt);
+	if (cnt > (CONFIG_DEVICE_NAME_HASH_SLOTS / 4U * 3U)) {
+		return;
+	}
+
+	for (size_t i = 0; i < cnt; i++) {
+		const struct device *dev;
+		size_t slot;
+
+		STRUCT_SECTION_GET(device, i, &dev);
+		if (dev->name == NULL) {
+			continue;
+		}
+
+		slot = device_name_hash(dev->name) & mask;
+		while (device_name_slots[slot] != 0U) {
+			slot = (slot + 1U) & mask;
+		}
+		device_name_slots[slot] = (uint16_t)(i + 1U);
+	}
+
+	device_name_hashed = true;
+}
+
+static const struct device *device_name_hash_find(const char *name)
+{
+	const size_t mask = CONFIG_DEVICE_NAME_HASH_SLOTS - 1;
+	size_t slot = device_name_hash(name) & mask;
+	const struct device *dev;
+
+	while (device_name_slots[slot] != 0U) {
+		STRUCT_SECTION_GET(device, device_name_slots[slot] - 1U, &dev);
+		if (z_device_is_ready(dev) &&
+		    ((dev->name == name) || (strcmp(name, dev->name) == 0))) {
+			return dev;
+		}
+		slot = (slot + 1U) & mask;
+	}
+
+	return NULL;
+}
+#endif /* CONFIG_DEVICE_NAME_HASH */
+
 void z_device_state_init(void)
 {
 	STRUCT_SECTION_FOREACH(device, dev) {
 		z_object_init(dev);
 	}
+
+#ifdef CONFIG_DEVICE_NAME_HASH
+	device_name_hash_init();
+#endif
 }
 
 const struct device *z_impl_device_get_binding(const char *name)
@@ -34,6 +108,12 @@ const struct device *z_impl_device_get_binding(const char *name)
 		return NULL;
 	}
 
+#ifdef CONFIG_DEVICE_NAME_HASH
+	if (device_name_hashed) {
+		return device_name_hash_find(name);
+	}
+#endif
+
 	/* Split the search into two loops: in the common scenario, where
 	 * device names are stored in ROM (and are referenced by the user
 	 * with CONFIG_* macros), only cheap pointer comparisons will be
@@ -10,8 +10,8 @@
  * Event objects are used to signal one or more threads that a custom set of
  * events has occurred. Threads wait on event objects until another thread or
  * ISR posts the desired set of events to the event object. Each time events
- * are posted to an event object, all threads waiting on that event object are
- * processed to determine if there is a match. All threads that whose wait
+ * are posted to an event object, the threads waiting on the newly set events
+ * are processed to determine if there is a match. All threads that whose wait
  * conditions match the current set of events now belonging to the event object
  * are awakened.
  *
@@ -32,6 +32,7 @@
 #include <zephyr/syscall_handler.h>
 #include <zephyr/tracing/tracing.h>
 #include <zephyr/sys/check.h>
+#include <zephyr/sys/math_extras.h>
 
 #define K_EVENT_WAIT_ANY      0x00   /* Wait for any events */
 #define K_EVENT_WAIT_ALL      0x01   /* Wait for all events */
@@ -44,6 +45,45 @@ struct event_walk_data {
 	uint32_t events;
 };
 
+#ifdef CONFIG_EVENTS_WAITER_INDEX
+#define EVENT_BUCKETS CONFIG_EVENTS_WAITER_INDEX_BUCKETS
+
+BUILD_ASSERT(IS_POWER_OF_TWO(EVENT_BUCKETS),
+	     "EVENTS_WAITER_INDEX_BUCKETS must be a power of two");
+
+/* Fold a set of events onto the buckets: event n goes to bucket n % EVENT_BUCKETS */
+static uint32_t event_buckets(uint32_t events)
+{
+	for (unsigned int shift = 16; shift >= EVENT_BUCKETS; shift >>= 1) {
+		events |= events >> shift;
+	}
+
+	return events & (uint32_t)BIT64_MASK(EVENT_BUCKETS);
+}
+
+/*
+ * Waiters whose events all fall on the same bucket pend on that bucket,
+ * the others on the shared wait queue.
+ */
+static _wait_q_t *event_wait_q(struct k_event *event, uint32_t events)
+{
+	uint32_t buckets = event_buckets(events);
+
+	if (!IS_POWER_OF_TWO(buckets)) {
+		return &event->wait_q;
+	}
+
+	return &event->bucket_q[u32_count_trailing_zeros(buckets)];
+}
+#else
+static _wait_q_t *event_wait_q(struct k_event *event, uint32_t events)
+{
+	ARG_UNUSED(events);
+
+	return &event->wait_q;
+}
+#endif /* CONFIG_EVENTS_WAITER_INDEX */
+
 void z_impl_k_event_init(struct k_event *event)
 {
 	event->events = 0;
@@ -53,6 +93,12 @@ void z_impl_k_event_init(struct k_event *event)
 
 	z_waitq_init(&event->wait_q);
 
+#ifdef CONFIG_EVENTS_WAITER_INDEX
+	for (int i = 0; i < EVENT_BUCKETS; i++) {
+		z_waitq_init(&event->bucket_q[i]);
+	}
+#endif
+
 	z_object_init(event);
 }
 
@@ -126,6 +172,7 @@ static uint32_t k_event_post_internal(struct k_event *event, uint32_t events,
 	struct k_thread  *thread;
 	struct event_walk_data data;
 	uint32_t previous_events;
+	uint32_t set_events;
 
 	data.head = NULL;
 	key = k_spin_lock(&event->lock);
@@ -136,6 +183,7 @@ static uint32_t k_event_post_internal(struct k_event *event, uint32_t events,
 	previous_events = event->events & events_mask;
 	events = (event->events & ~events_mask) |
 		 (events & events_mask);
+	set_events = events & ~event->events;
 	event->events = events;
 	data.events = events;
 	/*
@@ -146,9 +194,22 @@ static uint32_t k_event_post_internal(struct k_event *event, uint32_t events,
 	 * 1. Walk the waitq and create a linked list of threads to unpend.
 	 * 2. Unpend each of the threads in the linked list
 	 * 3. Ready each of the threads in the linked list
+	 *
+	 * The pended threads were not satisfied by the previous events, so
+	 * only those waiting on one of the newly set events can be.
 	 */
 
-	z_sched_waitq_walk(&event->wait_q, event_walk_op, &data);
+	if (set_events != 0) {
+		z_sched_waitq_walk(&event->wait_q, event_walk_op, &data);
+
+#ifdef CONFIG_EVENTS_WAITER_INDEX
+		for (uint32_t buckets = event_buckets(set_events); buckets != 0;
+		     buckets &= buckets - 1) {
+			z_sched_waitq_walk(&event->bucket_q[u32_count_trailing_zeros(buckets)],
+					   event_walk_op, &data);
+		}
+#endif
+	}
 
 	if (data.head != NULL) {
 		thread = data.head;
@@ -282,7 +343,8 @@ static uint32_t k_event_wait_internal(struct k_event *event, uint32_t events,
 	SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_event, wait, event, events,
 					   options, timeout);
 
-	if (z_pend_curr(&event->lock, key, &event->wait_q, timeout) == 0) {
+	if (z_pend_curr(&event->lock, key, event_wait_q(event, events),
+			timeout) == 0) {
 		/* Retrieve the set of events that woke the thread */
 		rv = thread->events;
 	}
@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Boot profile recording.
+ *
+ * A span is opened by z_boot_profile_enter(), which gives the slot to close
+ * it with, a negative slot when the records are all used.
+ */
+
+#ifndef ZEPHYR_KERNEL_INCLUDE_KERNEL_BOOT_PROFILE_H_
+#define ZEPHYR_KERNEL_INCLUDE_KERNEL_BOOT_PROFILE_H_
+
+#include <zephyr/kernel/boot_profile.h>
+
+#ifdef CONFIG_BOOT_PROFILE
+
+/* Start recording, before the BSS is cleared */
+void z_boot_profile_start(void);
+
+/* Start recording from z_cstart(), unless the BSS clearing was recorded */
+void z_boot_profile_cstart(void);
+
+int z_boot_profile_enter(enum boot_profile_step step, uint8_t level,
+			 const struct init_entry *entry);
+
+void z_boot_profile_exit(int slot);
+
+/* Timestamp with the system timer from now on */
+void z_boot_profile_clock_ready(void);
+
+#else
+
+static inline void z_boot_profile_start(void)
+{
+}
+
+static inline void z_boot_profile_cstart(void)
+{
+}
+
+static inline int z_boot_profile_enter(enum boot_profile_step step,
+				       uint8_t level,
+				       const struct init_entry *entry)
+{
+	ARG_UNUSED(step);
+	ARG_UNUSED(level);
+	ARG_UNUSED(entry);
+
+	return -1;
+}
+
+static inline void z_boot_profile_exit(int slot)
+{
+	ARG_UNUSED(slot);
+}
+
+static inline void z_boot_profile_clock_ready(void)
+{
+}
+
+#endif /* CONFIG_BOOT_PROFILE */
+
+#endif /* ZEPHYR_KERNEL_INCLUDE_KERNEL_BOOT_PROFILE_H_ */
@@ -168,6 +168,13 @@ extern uint8_t *z_priv_stack_find(k_thread_stack_t *stack);
 /* Calculate stack usage. */
 int z_stack_space_get(const uint8_t *stack_start, size_t size, size_t *unused_ptr);
 
+#ifdef CONFIG_STACK_WATERMARK
+/* Calculate stack usage, *unused_ptr is the result of the previous call
+ * on entry, or the size of the stack for the first one.
+ */
+int z_stack_watermark_get(const uint8_t *stack_start, size_t size, size_t *unused_ptr);
+#endif
+
 #ifdef CONFIG_USERSPACE
 bool z_stack_is_user_capable(k_thread_stack_t *stack);
 
@@ -177,6 +184,11 @@ void z_mem_domain_init_thread(struct k_thread *thread);
 /* Memory domain teardown hook, called from z_thread_abort() */
 void z_mem_domain_exit_thread(struct k_thread *thread);
 
+#ifdef CONFIG_USERSPACE_OBJ_CACHE
+/* Kernel object lookup cache setup, called from z_setup_new_thread() */
+void z_object_cache_init(struct k_thread *thread);
+#endif
+
 /* This spinlock:
  *
  * - Protects the full set of active k_mem_domain objects and their contents
@@ -217,6 +229,36 @@ void z_thread_mark_switched_out(void);
 
 #endif /* CONFIG_INSTRUMENT_THREAD_SWITCHING */
 
+#ifdef CONFIG_FPU_LAZY_SWITCH_HISTORY
+/**
+ * @brief Record the FP register use of a thread losing FP ownership
+ *
+ * Called by the arch layer when @a thread stops owning the FP registers.
+ *
+ * @param thread Thread that owned the FP registers
+ * @param used True if the thread modified the FP registers meanwhile
+ */
+static inline void z_fpu_usage_record(struct k_thread *thread, bool used)
+{
+	thread->base.fpu_history = (uint8_t)(thread->base.fpu_history << 1) |
+				   (used ? 1U : 0U);
+}
+
+/**
+ * @brief Tell whether the FP context of a thread should be switched eagerly
+ *
+ * @param thread Thread being switched in
+ *
+ * @return True if the thread used the FP registers often enough lately
+ *         to restore its FP context right away, rather than on first use.
+ */
+static inline bool z_fpu_usage_frequent(struct k_thread *thread)
+{
+	return (unsigned int)__builtin_popcount(thread->base.fpu_history) >=
+	       CONFIG_FPU_LAZY_SWITCH_THRESHOLD;
+}
+#endif /* CONFIG_FPU_LAZY_SWITCH_HISTORY */
+
 /* Init hook for page frame management, invoked immediately upon entry of
  * main thread, before POST_KERNEL tasks
  */
@@ -286,6 +328,35 @@ void z_paging_histogram_inc(struct k_mem_paging_histogram_t *hist,
 			    uint32_t cycles);
 #endif /* CONFIG_DEMAND_PAGING_TIMING_HISTOGRAM */
 
+#ifdef CONFIG_SYS_MUTEX_FAST
+/**
+ * Lock a k_mutex backing a sys_mutex
+ *
+ * Same as k_mutex_lock(), but also takes over an owner that locked the
+ * sys_mutex word @a val in user mode, and keeps @a val pointing to the
+ * owner while the kernel tracks the mutex.
+ *
+ * @param mutex Kernel mutex backing the sys_mutex
+ * @param val The sys_mutex word
+ * @param timeout Waiting period to lock the mutex
+ * @return Same as k_mutex_lock()
+ */
+int z_sys_mutex_lock(struct k_mutex *mutex, atomic_t *val,
+		     k_timeout_t timeout);
+
+/**
+ * Unlock a k_mutex backing a sys_mutex
+ *
+ * Same as k_mutex_unlock(), and clears @a val when nobody is waiting
+ * so that the next lock can be done in user mode again.
+ *
+ * @param mutex Kernel mutex backing the sys_mutex
+ * @param val The sys_mutex word
+ * @return Same as k_mutex_unlock(), or -EINVAL if the mutex isn't locked
+ */
+int z_sys_mutex_unlock(struct k_mutex *mutex, atomic_t *val);
+#endif /* CONFIG_SYS_MUTEX_FAST */
+
 #ifdef __cplusplus
 }
 #endif
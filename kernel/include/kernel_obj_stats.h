@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Kernel object statistics, recorded on the slow paths.
+ *
+ * The objects pass a NULL statistics pointer when their type is not
+ * selected, the calls then folding away.
+ */
+
+#ifndef ZEPHYR_KERNEL_INCLUDE_KERNEL_OBJ_STATS_H_
+#define ZEPHYR_KERNEL_INCLUDE_KERNEL_OBJ_STATS_H_
+
+#include <zephyr/kernel.h>
+
+#ifdef CONFIG_KERNEL_OBJ_STATS
+
+/* Count an object found unavailable */
+static inline void z_obj_stats_contended(struct k_obj_stats *stats)
+{
+	if (stats != NULL) {
+		k_spinlock_key_t key = k_spin_lock(&stats->lock);
+
+		stats->counters.contentions++;
+		k_spin_unlock(&stats->lock, key);
+	}
+}
+
+/* Pends may last longer than a wrap of the 32-bit cycle counter */
+static inline uint64_t z_obj_stats_now(void)
+{
+#ifdef CONFIG_TIMER_HAS_64BIT_CYCLE_COUNTER
+	return k_cycle_get_64();
+#else
+	return k_uptime_ticks();
+#endif
+}
+
+static inline uint64_t z_obj_stats_to_us(uint64_t t)
+{
+#ifdef CONFIG_TIMER_HAS_64BIT_CYCLE_COUNTER
+	return k_cyc_to_us_floor64(t);
+#else
+	return k_ticks_to_us_floor64(t);
+#endif
+}
+
+/* Start of a pend, to be given to z_obj_stats_pend_end() */
+static inline uint64_t z_obj_stats_pend_start(struct k_obj_stats *stats)
+{
+	return (stats != NULL) ? z_obj_stats_now() : 0U;
+}
+
+/* Account for a pend once it is over, whatever its outcome */
+static inline void z_obj_stats_pend_end(struct k_obj_stats *stats,
+					uint64_t start)
+{
+	if (stats != NULL) {
+		uint64_t us = z_obj_stats_to_us(z_obj_stats_now() - start);
+		k_spinlock_key_t key = k_spin_lock(&stats->lock);
+
+		stats->counters.pends++;
+		stats->counters.wait_us += us;
+		stats->counters.max_wait_us = MAX(stats->counters.max_wait_us, us);
+		k_spin_unlock(&stats->lock, key);
+	}
+}
+
+#else
+
+static inline void z_obj_stats_contended(void *stats)
+{
+	ARG_UNUSED(stats);
+}
+
+static inline uint64_t z_obj_stats_pend_start(void *stats)
+{
+	ARG_UNUSED(stats);
+
+	return 0U;
+}
+
+static inline void z_obj_stats_pend_end(void *stats, uint64_t start)
+{
+	ARG_UNUSED(stats);
+	ARG_UNUSED(start);
+}
+
+#endif /* CONFIG_KERNEL_OBJ_STATS */
+
+#endif /* ZEPHYR_KERNEL_INCLUDE_KERNEL_OBJ_STATS_H_ */
@@ -40,7 +40,7 @@ GEN_OFFSET_SYM(_cpu_t, fp_ctx);
 GEN_OFFSET_SYM(_kernel_t, idle);
 #endif
 
-#ifndef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#ifndef CONFIG_SCHED_CPU_READY_Q
 GEN_OFFSET_SYM(_kernel_t, ready_q);
 #endif
 
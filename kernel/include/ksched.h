@@ -56,6 +56,7 @@ bool z_set_prio(struct k_thread *thread, int prio);
 void *z_get_next_switch_handle(void *interrupted);
 void idle(void *unused1, void *unused2, void *unused3);
 void z_time_slice(void);
+void z_sched_cbs_tick(void);
 void z_reset_time_slice(struct k_thread *curr);
 void z_sched_abort(struct k_thread *thread);
 void z_sched_ipi(void);
@@ -108,7 +109,8 @@ static inline bool z_is_thread_prevented_from_running(struct k_thread *thread)
 	uint8_t state = thread->base.thread_state;
 
 	return (state & (_THREAD_PENDING | _THREAD_PRESTART | _THREAD_DEAD |
-			 _THREAD_DUMMY | _THREAD_SUSPENDED)) != 0U;
+			 _THREAD_DUMMY | _THREAD_SUSPENDED |
+			 _THREAD_THROTTLED)) != 0U;
 
 }
 
@@ -327,11 +329,25 @@ bool z_sched_wake(_wait_q_t *wait_q, int swap_retval, void *swap_data);
  */
 void z_sched_wake_thread(struct k_thread *thread, bool is_timeout);
 
+/**
+ * Wake up to n threads pending on the provided wait queue
+ *
+ * Like calling z_sched_wake() n times, but the scheduler lock is only
+ * taken once.  Threads are woken in priority order.
+ *
+ * @param wait_q Wait queue to wake up threads from
+ * @param n Maximum number of threads to wake up
+ * @param swap_retval Swap return value for woken threads
+ * @param swap_data Data return value to supplement swap_retval. May be NULL.
+ * @return Number of threads woken up
+ */
+unsigned int z_sched_wake_n(_wait_q_t *wait_q, unsigned int n,
+			    int swap_retval, void *swap_data);
+
 /**
  * Wake up all threads pending on the provided wait queue
  *
- * Convenience function to invoke z_sched_wake() on all threads in the queue
- * until there are no more to wake up.
+ * Convenience function to wake all threads in the queue.
  *
  * @param wait_q Wait queue to wake up the highest prio thread
  * @param swap_retval Swap return value for woken thread
@@ -342,14 +358,8 @@ void z_sched_wake_thread(struct k_thread *thread, bool is_timeout);
 static inline bool z_sched_wake_all(_wait_q_t *wait_q, int swap_retval,
 				    void *swap_data)
 {
-	bool woken = false;
-
-	while (z_sched_wake(wait_q, swap_retval, swap_data)) {
-		woken = true;
-	}
-
 	/* True if we woke at least one thread up */
-	return woken;
+	return z_sched_wake_n(wait_q, UINT_MAX, swap_retval, swap_data) != 0U;
 }
 
 /**
@@ -417,6 +427,16 @@ void z_sched_usage_stop(void);
 
 void z_sched_usage_start(struct k_thread *thread);
 
+/**
+ * @brief Record when a thread was made ready to run
+ *
+ * Called with the scheduler lock held whenever a thread is added to
+ * the run queue, to measure its latency until it is switched in.
+ * Threads preempted without being requeued are stamped when switched
+ * out.
+ */
+void z_sched_usage_ready(struct k_thread *thread);
+
 /**
  * @brief Retrieves CPU cycle usage data for specified core
  */
@@ -428,6 +448,15 @@ void z_sched_cpu_usage(uint8_t core_id, struct k_thread_runtime_stats *stats);
 void z_sched_thread_usage(struct k_thread *thread,
 			  struct k_thread_runtime_stats *stats);
 
+#ifdef CONFIG_SCHED_CBS
+/**
+ * @brief Charge the outgoing thread's CPU budget and arm the incoming one's
+ *
+ * @param thread Thread being switched in on the current CPU
+ */
+void z_sched_cbs_switch(struct k_thread *thread);
+#endif
+
 static inline void z_sched_usage_switch(struct k_thread *thread)
 {
 	ARG_UNUSED(thread);
@@ -435,6 +464,9 @@ static inline void z_sched_usage_switch(struct k_thread *thread)
 	z_sched_usage_stop();
 	z_sched_usage_start(thread);
 #endif
+#if defined(CONFIG_SCHED_CBS) && defined(CONFIG_USE_SWITCH)
+	z_sched_cbs_switch(thread);
+#endif
 }
 
 #endif /* ZEPHYR_KERNEL_INCLUDE_KSCHED_H_ */
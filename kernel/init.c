@@ -35,6 +35,7 @@
 #include <zephyr/timing/timing.h>
 #include <zephyr/logging/log.h>
 #include <zephyr/pm/device_runtime.h>
+#include <kernel_boot_profile.h>
 LOG_MODULE_REGISTER(os, CONFIG_KERNEL_LOG_LEVEL);
 
 
@@ -149,6 +150,10 @@ void z_bss_zero(void)
 		return;
 	}
 
+	z_boot_profile_start();
+
+	int slot = z_boot_profile_enter(BOOT_PROFILE_BSS_ZERO, 0, NULL);
+
 	z_early_memset(__bss_start, 0, __bss_end - __bss_start);
 #if DT_NODE_HAS_STATUS(DT_CHOSEN(zephyr_ccm), okay)
 	z_early_memset(&__ccm_bss_start, 0,
@@ -174,6 +179,8 @@ void z_bss_zero(void)
 	z_early_memset(&__gcov_bss_start, 0,
 		       ((uintptr_t) &__gcov_bss_end - (uintptr_t) &__gcov_bss_start));
 #endif
+
+	z_boot_profile_exit(slot);
 }
 
 #ifdef CONFIG_LINKER_USE_BOOT_SECTION
@@ -229,6 +236,160 @@ extern volatile uintptr_t __stack_chk_guard;
 __pinned_bss
 bool z_sys_post_kernel;
 
+static void z_sys_init_run_entry(const struct init_entry *entry,
+				 enum init_level level)
+{
+	const struct device *dev = entry->dev;
+	int slot = z_boot_profile_enter(BOOT_PROFILE_INIT, level, entry);
+
+	if (dev != NULL) {
+		int rc = 0;
+
+		if (entry->init_fn.dev != NULL) {
+			rc = entry->init_fn.dev(dev);
+			/* Mark device initialized. If initialization
+			 * failed, record the error condition.
+			 */
+			if (rc != 0) {
+				if (rc < 0) {
+					rc = -rc;
+				}
+				if (rc > UINT8_MAX) {
+					rc = UINT8_MAX;
+				}
+				dev->state->init_res = rc;
+			}
+		}
+
+		dev->state->initialized = true;
+
+		if (rc == 0) {
+			/* Run automatic device runtime enablement */
+			(void)pm_device_runtime_auto_enable(dev);
+		}
+	} else {
+		(void)entry->init_fn.sys();
+	}
+
+	z_boot_profile_exit(slot);
+}
+
+#ifdef CONFIG_INIT_PARALLEL
+static K_KERNEL_STACK_ARRAY_DEFINE(init_worker_stacks,
+				   CONFIG_INIT_PARALLEL_WORKERS,
+				   CONFIG_INIT_PARALLEL_STACK_SIZE);
+static struct k_thread init_workers[CONFIG_INIT_PARALLEL_WORKERS];
+
+/* Run of device init entries shared by the workers */
+static struct {
+	const struct init_entry *start;
+	const struct init_entry *next;
+	const struct init_entry *end;
+	enum init_level level;
+} init_batch;
+
+static K_MUTEX_DEFINE(init_batch_lock);
+static K_CONDVAR_DEFINE(init_batch_done);
+
+static bool init_dep_pending(const device_handle_t *deps, size_t count,
+			     const struct init_entry *entry)
+{
+	for (size_t i = 0; i < count; i++) {
+		const struct device *dep = device_from_handle(deps[i]);
+
+		if ((dep == NULL) || dep->state->initialized) {
+			continue;
+		}
+
+		/* Dependencies out of the batch, or after the device in link
+		 * order, are not initialized before it when run serially
+		 * either: only wait for those claimed before the device.
+		 */
+		for (const struct init_entry *e = init_batch.start; e < entry; e++) {
+			if (e->dev == dep) {
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+static bool init_entry_ready(const struct init_entry *entry)
+{
+	const device_handle_t *deps;
+	size_t count;
+
+	deps = device_required_handles_get(entry->dev, &count);
+	if ((deps != NULL) && init_dep_pending(deps, count, entry)) {
+		return false;
+	}
+
+	deps = device_injected_handles_get(entry->dev, &count);
+	if ((deps != NULL) && init_dep_pending(deps, count, entry)) {
+		return false;
+	}
+
+	return true;
+}
+
+/* Claim the entries of the batch in link order, each one being run once the
+ * entries it depends on, all claimed before it, have returned.
+ */
+static void init_worker(void *p1, void *p2, void *p3)
+{
+	const struct init_entry *entry;
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	k_mutex_lock(&init_batch_lock, K_FOREVER);
+	while (init_batch.next < init_batch.end) {
+		entry = init_batch.next++;
+
+		while (!init_entry_ready(entry)) {
+			k_condvar_wait(&init_batch_done, &init_batch_lock,
+				       K_FOREVER);
+		}
+		k_mutex_unlock(&init_batch_lock);
+
+		z_sys_init_run_entry(entry, init_batch.level);
+
+		k_mutex_lock(&init_batch_lock, K_FOREVER);
+		k_condvar_broadcast(&init_batch_done);
+	}
+	k_mutex_unlock(&init_batch_lock);
+}
+
+static void z_sys_init_run_batch(const struct init_entry *start,
+				 const struct init_entry *end,
+				 enum init_level level)
+{
+	size_t workers = MIN(end - start - 1, CONFIG_INIT_PARALLEL_WORKERS);
+
+	init_batch.start = start;
+	init_batch.next = start;
+	init_batch.end = end;
+	init_batch.level = level;
+
+	for (size_t i = 0; i < workers; i++) {
+		k_thread_create(&init_workers[i], init_worker_stacks[i],
+				K_KERNEL_STACK_SIZEOF(init_worker_stacks[i]),
+				init_worker, NULL, NULL, NULL,
+				CONFIG_MAIN_THREAD_PRIORITY, 0, K_NO_WAIT);
+		(void)k_thread_name_set(&init_workers[i], "init");
+	}
+
+	/* The main thread is a worker as well */
+	init_worker(NULL, NULL, NULL);
+
+	for (size_t i = 0; i < workers; i++) {
+		(void)k_thread_join(&init_workers[i], K_FOREVER);
+	}
+}
+#endif /* CONFIG_INIT_PARALLEL */
+
 /**
  * @brief Execute all the init entry initialization functions at a given level
  *
@@ -238,6 +399,9 @@ bool z_sys_post_kernel;
  * they need to be invoked, with symbols indicating where one level leaves
  * off and the next one begins.
  *
+ * With CONFIG_INIT_PARALLEL, the runs of device entries of the POST_KERNEL
+ * and APPLICATION levels are handed to the init workers.
+ *
  * @param level init level to run.
  */
 static void z_sys_init_run_level(enum init_level level)
@@ -255,39 +419,29 @@ static void z_sys_init_run_level(enum init_level level)
 		__init_end,
 	};
 	const struct init_entry *entry;
+	int slot = z_boot_profile_enter(BOOT_PROFILE_LEVEL, level, NULL);
 
 	for (entry = levels[level]; entry < levels[level+1]; entry++) {
-		const struct device *dev = entry->dev;
-
-		if (dev != NULL) {
-			int rc = 0;
-
-			if (entry->init_fn.dev != NULL) {
-				rc = entry->init_fn.dev(dev);
-				/* Mark device initialized. If initialization
-				 * failed, record the error condition.
-				 */
-				if (rc != 0) {
-					if (rc < 0) {
-						rc = -rc;
-					}
-					if (rc > UINT8_MAX) {
-						rc = UINT8_MAX;
-					}
-					dev->state->init_res = rc;
-				}
-			}
+#ifdef CONFIG_INIT_PARALLEL
+		const struct init_entry *end = entry;
 
-			dev->state->initialized = true;
-
-			if (rc == 0) {
-				/* Run automatic device runtime enablement */
-				(void)pm_device_runtime_auto_enable(dev);
+		if ((level == INIT_LEVEL_POST_KERNEL) ||
+		    (level == INIT_LEVEL_APPLICATION)) {
+			while ((end < levels[level+1]) && (end->dev != NULL)) {
+				end++;
 			}
-		} else {
-			(void)entry->init_fn.sys();
 		}
+
+		if ((end - entry) > 1) {
+			z_sys_init_run_batch(entry, end, level);
+			entry = end - 1;
+			continue;
+		}
+#endif
+		z_sys_init_run_entry(entry, level);
 	}
+
+	z_boot_profile_exit(slot);
 }
 
 extern void boot_banner(void);
@@ -348,6 +502,8 @@ static void bg_thread_main(void *unused1, void *unused2, void *unused3)
 
 	extern int main(void);
 
+	(void)z_boot_profile_enter(BOOT_PROFILE_MAIN, 0, NULL);
+
 	(void)main();
 
 	/* Mark nonessential since main() has no more work to do */
@@ -528,6 +684,8 @@ __boot_func
 FUNC_NO_STACK_PROTECTOR
 FUNC_NORETURN void z_cstart(void)
 {
+	z_boot_profile_cstart();
+
 	/* gcov hook needed to get the coverage report.*/
 	gcov_static_init();
 
@@ -553,6 +711,7 @@ FUNC_NORETURN void z_cstart(void)
 	/* perform basic hardware initialization */
 	z_sys_init_run_level(INIT_LEVEL_PRE_KERNEL_1);
 	z_sys_init_run_level(INIT_LEVEL_PRE_KERNEL_2);
+	z_boot_profile_clock_ready();
 
 #ifdef CONFIG_STACK_CANARIES
 	uintptr_t stack_guard;
@@ -10,12 +10,209 @@
 #include <zephyr/init.h>
 #include <zephyr/linker/linker-defs.h>
 #include <zephyr/sys/iterable_sections.h>
+#include <zephyr/sys/heap_listener.h>
+#include <string.h>
+
+#ifdef CONFIG_KHEAP_CPU_CACHE
+/* Lock the cache of the current CPU, with interrupts masked so that the
+ * thread can't migrate while it holds it.
+ */
+static struct z_heap_cpu_cache *cache_lock(struct k_heap *h, unsigned int *irq,
+					   k_spinlock_key_t *key)
+{
+	struct z_heap_cpu_cache *cache;
+
+	*irq = arch_irq_lock();
+	cache = &h->cpu_cache[arch_curr_cpu()->id];
+	*key = k_spin_lock(&cache->lock);
+
+	return cache;
+}
+
+static void cache_unlock(struct z_heap_cpu_cache *cache, unsigned int irq,
+			 k_spinlock_key_t key)
+{
+	k_spin_unlock(&cache->lock, key);
+	arch_irq_unlock(irq);
+}
+
+/* Free a chain of blocks linked through their first word.  Listeners
+ * were notified when the blocks entered the cache.
+ *
+ * Invoked with heap lock held.
+ */
+static void free_chain(struct k_heap *h, void *chain)
+{
+	while (chain != NULL) {
+		void *next = *(void **)chain;
+
+		z_sys_heap_free_unnotified(&h->heap, chain);
+		chain = next;
+	}
+}
+
+/* Return the blocks held in all CPU caches to the heap.
+ *
+ * Invoked with heap lock held.
+ *
+ * @return true if any block was returned.
+ */
+static bool cache_reclaim(struct k_heap *h)
+{
+	bool ret = false;
+
+	for (unsigned int i = 0; i < arch_num_cpus(); i++) {
+		struct z_heap_cpu_cache *cache = &h->cpu_cache[i];
+		void *lists[Z_KHEAP_CACHE_CLASSES];
+
+		K_SPINLOCK(&cache->lock) {
+			memcpy(lists, cache->lists, sizeof(lists));
+			memset(cache->lists, 0, sizeof(cache->lists));
+			ret = ret || (cache->count != 0U);
+			cache->count = 0U;
+		}
+
+		for (int c = 0; c < Z_KHEAP_CACHE_CLASSES; c++) {
+			free_chain(h, lists[c]);
+		}
+	}
+
+	return ret;
+}
+#endif /* CONFIG_KHEAP_CPU_CACHE */
+
+/* Take a block from the cache of the current CPU.
+ *
+ * @return the block, or NULL if the cache holds none of that size.
+ */
+static void *cache_alloc(struct k_heap *h, size_t align, size_t bytes)
+{
+#ifdef CONFIG_KHEAP_CPU_CACHE
+	struct z_heap_cpu_cache *cache;
+	k_spinlock_key_t key;
+	unsigned int irq;
+	void *ret;
+
+	/* Cached blocks are only guaranteed pointer alignment */
+	if ((bytes == 0U) || (bytes > CONFIG_KHEAP_CPU_CACHE_MAX_SIZE) ||
+	    (align > sizeof(void *))) {
+		return NULL;
+	}
+
+	cache = cache_lock(h, &irq, &key);
+
+	/* Blocks are filed by their usable size rounded down */
+	void **list = &cache->lists[DIV_ROUND_UP(bytes, 8)];
+
+	ret = *list;
+	if (ret != NULL) {
+		*list = *(void **)ret;
+		cache->count--;
+#ifdef CONFIG_SYS_HEAP_LISTENER
+		heap_listener_notify_alloc(HEAP_ID_FROM_POINTER(&h->heap), ret,
+					   sys_heap_usable_size(&h->heap, ret));
+#endif
+	}
+
+	cache_unlock(cache, irq, key);
+
+	return ret;
+#else
+	ARG_UNUSED(h);
+	ARG_UNUSED(align);
+	ARG_UNUSED(bytes);
+
+	return NULL;
+#endif
+}
+
+/* Put a block into the cache of the current CPU.  When the cache is full
+ * half of it is returned to the heap in one batch.  Blocks go straight
+ * to the heap when a thread may be waiting for memory.
+ *
+ * @return true if the block was freed.
+ */
+static bool cache_free(struct k_heap *h, void *mem)
+{
+#ifdef CONFIG_KHEAP_CPU_CACHE
+	struct z_heap_cpu_cache *cache;
+	k_spinlock_key_t key;
+	void *batch = NULL;
+	unsigned int irq;
+	size_t size;
+
+	if (mem == NULL) {
+		return false;
+	}
+
+	/* Blocks too small for any request size class aren't cached */
+	size = sys_heap_usable_size(&h->heap, mem);
+	if ((size < 8U) || (size > CONFIG_KHEAP_CPU_CACHE_MAX_SIZE)) {
+		return false;
+	}
+
+	cache = cache_lock(h, &irq, &key);
+
+	if (atomic_get(&h->waiters) != 0) {
+		cache_unlock(cache, irq, key);
+		return false;
+	}
+
+	if (cache->count == CONFIG_KHEAP_CPU_CACHE_DEPTH) {
+		/* Detach the largest blocks first */
+		for (int c = Z_KHEAP_CACHE_CLASSES - 1;
+		     cache->count > CONFIG_KHEAP_CPU_CACHE_DEPTH / 2; c--) {
+			while ((cache->lists[c] != NULL) &&
+			       (cache->count > CONFIG_KHEAP_CPU_CACHE_DEPTH / 2)) {
+				void *block = cache->lists[c];
+
+				cache->lists[c] = *(void **)block;
+				*(void **)block = batch;
+				batch = block;
+				cache->count--;
+			}
+		}
+	}
+
+#ifdef CONFIG_SYS_HEAP_LISTENER
+	heap_listener_notify_free(HEAP_ID_FROM_POINTER(&h->heap), mem, size);
+#endif
+	*(void **)mem = cache->lists[size / 8];
+	cache->lists[size / 8] = mem;
+	cache->count++;
+
+	cache_unlock(cache, irq, key);
+
+	if (batch != NULL) {
+		key = k_spin_lock(&h->lock);
+		free_chain(h, batch);
+		if (IS_ENABLED(CONFIG_MULTITHREADING) &&
+		    z_unpend_all(&h->wait_q) != 0) {
+			z_reschedule(&h->lock, key);
+		} else {
+			k_spin_unlock(&h->lock, key);
+		}
+	}
+
+	return true;
+#else
+	ARG_UNUSED(h);
+	ARG_UNUSED(mem);
+
+	return false;
+#endif
+}
 
 void k_heap_init(struct k_heap *h, void *mem, size_t bytes)
 {
 	z_waitq_init(&h->wait_q);
 	sys_heap_init(&h->heap, mem, bytes);
 
+#ifdef CONFIG_KHEAP_CPU_CACHE
+	h->waiters = 0;
+	(void)memset(h->cpu_cache, 0, sizeof(h->cpu_cache));
+#endif
+
 	SYS_PORT_TRACING_OBJ_INIT(k_heap, h);
 }
 
@@ -65,19 +262,37 @@ void *k_heap_aligned_alloc(struct k_heap *h, size_t align, size_t bytes,
 			k_timeout_t timeout)
 {
 	k_timepoint_t end = sys_timepoint_calc(timeout);
-	void *ret = NULL;
-
-	k_spinlock_key_t key = k_spin_lock(&h->lock);
+	void *ret;
+	k_spinlock_key_t key;
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_heap, aligned_alloc, h, timeout);
 
+	ret = cache_alloc(h, align, bytes);
+	if (ret != NULL) {
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_heap, aligned_alloc, h, timeout, ret);
+		return ret;
+	}
+
+	key = k_spin_lock(&h->lock);
+
 	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
 
 	bool blocked_alloc = false;
 
+#ifdef CONFIG_KHEAP_CPU_CACHE
+	/* Make frees bypass the caches while this thread may wait */
+	(void)atomic_inc(&h->waiters);
+#endif
+
 	while (ret == NULL) {
 		ret = sys_heap_aligned_alloc(&h->heap, align, bytes);
 
+#ifdef CONFIG_KHEAP_CPU_CACHE
+		if ((ret == NULL) && cache_reclaim(h)) {
+			ret = sys_heap_aligned_alloc(&h->heap, align, bytes);
+		}
+#endif
+
 		if (!IS_ENABLED(CONFIG_MULTITHREADING) ||
 		    (ret != NULL) || K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
 			break;
@@ -98,6 +313,10 @@ void *k_heap_aligned_alloc(struct k_heap *h, size_t align, size_t bytes,
 		key = k_spin_lock(&h->lock);
 	}
 
+#ifdef CONFIG_KHEAP_CPU_CACHE
+	(void)atomic_dec(&h->waiters);
+#endif
+
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_heap, aligned_alloc, h, timeout, ret);
 
 	k_spin_unlock(&h->lock, key);
@@ -117,7 +336,14 @@ void *k_heap_alloc(struct k_heap *h, size_t bytes, k_timeout_t timeout)
 
 void k_heap_free(struct k_heap *h, void *mem)
 {
-	k_spinlock_key_t key = k_spin_lock(&h->lock);
+	k_spinlock_key_t key;
+
+	if (cache_free(h, mem)) {
+		SYS_PORT_TRACING_OBJ_FUNC(k_heap, free, h);
+		return;
+	}
+
+	key = k_spin_lock(&h->lock);
 
 	sys_heap_free(&h->heap, mem);
 
@@ -12,9 +12,201 @@
 #include <zephyr/wait_q.h>
 #include <zephyr/sys/dlist.h>
 #include <ksched.h>
+#include <kernel_obj_stats.h>
 #include <zephyr/init.h>
 #include <zephyr/sys/check.h>
 #include <zephyr/sys/iterable_sections.h>
+#include <string.h>
+
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+#define CPU_CACHE_BATCH (CONFIG_MEM_SLAB_CPU_CACHE_SIZE / 2)
+#endif
+
+#ifdef CONFIG_KERNEL_OBJ_STATS_MEM_SLAB
+#define SLAB_STATS(slab) (&(slab)->stats)
+#else
+#define SLAB_STATS(slab) NULL
+#endif
+
+/* Account for a block handed out to the user. */
+static inline void used_inc(struct k_mem_slab *slab)
+{
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	atomic_val_t used = atomic_inc(&slab->num_used) + 1;
+
+#ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
+	atomic_val_t max = atomic_get(&slab->max_used);
+
+	while ((used > max) && !atomic_cas(&slab->max_used, max, used)) {
+		max = atomic_get(&slab->max_used);
+	}
+#endif
+#else
+	slab->num_used++;
+
+#ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
+	slab->max_used = MAX(slab->num_used, slab->max_used);
+#endif
+#endif
+}
+
+/* Account for a block returned by the user. */
+static inline void used_dec(struct k_mem_slab *slab)
+{
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	(void)atomic_dec(&slab->num_used);
+#else
+	slab->num_used--;
+#endif
+}
+
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+/* Move up to @p count blocks from the @p from to the @p to free list.
+ *
+ * @return the number of blocks moved.
+ */
+static uint32_t move_blocks(char **to, char **from, uint32_t count)
+{
+	uint32_t n;
+
+	for (n = 0U; (n < count) && (*from != NULL); n++) {
+		char *block = *from;
+
+		*from = *(char **)block;
+		*(char **)block = *to;
+		*to = block;
+	}
+
+	return n;
+}
+
+/* Lock the cache of the current CPU, with interrupts masked so that the
+ * thread can't migrate while it holds it.
+ */
+static struct z_mem_slab_cpu_cache *cache_lock(struct k_mem_slab *slab,
+					       unsigned int *irq,
+					       k_spinlock_key_t *key)
+{
+	struct z_mem_slab_cpu_cache *cache;
+
+	*irq = arch_irq_lock();
+	cache = &slab->cpu_cache[arch_curr_cpu()->id];
+	*key = k_spin_lock(&cache->lock);
+
+	return cache;
+}
+
+static void cache_unlock(struct z_mem_slab_cpu_cache *cache,
+			 unsigned int irq, k_spinlock_key_t key)
+{
+	k_spin_unlock(&cache->lock, key);
+	arch_irq_unlock(irq);
+}
+
+/* Return the blocks held in all CPU caches to the shared free list, so
+ * a thread about to fail or to wait doesn't miss any free block.
+ */
+static void cache_reclaim(struct k_mem_slab *slab)
+{
+	for (unsigned int i = 0; i < arch_num_cpus(); i++) {
+		struct z_mem_slab_cpu_cache *cache = &slab->cpu_cache[i];
+
+		K_SPINLOCK(&cache->lock) {
+			K_SPINLOCK(&slab->lock) {
+				(void)move_blocks(&slab->free_list,
+						  &cache->free_list,
+						  cache->count);
+			}
+			cache->count = 0U;
+		}
+	}
+}
+#endif /* CONFIG_MEM_SLAB_CPU_CACHE */
+
+/* Take a block from the cache of the current CPU, refilling the cache in
+ * a batch from the shared free list when it's empty.
+ *
+ * @return true if a block was allocated.
+ */
+static bool cache_alloc(struct k_mem_slab *slab, void **mem)
+{
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	struct z_mem_slab_cpu_cache *cache;
+	k_spinlock_key_t key;
+	unsigned int irq;
+	bool ret = false;
+
+	cache = cache_lock(slab, &irq, &key);
+
+	if (cache->count == 0U) {
+		K_SPINLOCK(&slab->lock) {
+			cache->count = move_blocks(&cache->free_list,
+						   &slab->free_list,
+						   CPU_CACHE_BATCH);
+		}
+	}
+
+	if (cache->count != 0U) {
+		*mem = cache->free_list;
+		cache->free_list = *(char **)(cache->free_list);
+		cache->count--;
+		used_inc(slab);
+		ret = true;
+	}
+
+	cache_unlock(cache, irq, key);
+
+	return ret;
+#else
+	ARG_UNUSED(slab);
+	ARG_UNUSED(mem);
+
+	return false;
+#endif
+}
+
+/* Put a block into the cache of the current CPU, draining half of the
+ * cache in a batch to the shared free list when it's full.  Blocks go
+ * straight to the shared path when a thread may be waiting for one.
+ *
+ * @return true if the block was freed.
+ */
+static bool cache_free(struct k_mem_slab *slab, void **mem)
+{
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	struct z_mem_slab_cpu_cache *cache;
+	k_spinlock_key_t key;
+	unsigned int irq;
+	bool ret = false;
+
+	cache = cache_lock(slab, &irq, &key);
+
+	if (atomic_get(&slab->waiters) == 0) {
+		if (cache->count == CONFIG_MEM_SLAB_CPU_CACHE_SIZE) {
+			K_SPINLOCK(&slab->lock) {
+				cache->count -= move_blocks(&slab->free_list,
+							    &cache->free_list,
+							    CPU_CACHE_BATCH);
+			}
+		}
+
+		**(char ***) mem = cache->free_list;
+		cache->free_list = *(char **) mem;
+		cache->count++;
+		used_dec(slab);
+		ret = true;
+	}
+
+	cache_unlock(cache, irq, key);
+
+	return ret;
+#else
+	ARG_UNUSED(slab);
+	ARG_UNUSED(mem);
+
+	return false;
+#endif
+}
 
 /**
  * @brief Initialize kernel memory slab subsystem.
@@ -88,6 +280,11 @@ int k_mem_slab_init(struct k_mem_slab *slab, void *buffer,
 	slab->max_used = 0U;
 #endif
 
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	slab->waiters = 0;
+	(void)memset(slab->cpu_cache, 0, sizeof(slab->cpu_cache));
+#endif
+
 	rc = create_free_list(slab);
 	if (rc < 0) {
 		goto out;
@@ -103,41 +300,66 @@ out:
 
 int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
 {
-	k_spinlock_key_t key = k_spin_lock(&slab->lock);
+	k_spinlock_key_t key;
+	uint64_t pend_start;
 	int result;
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, alloc, slab, timeout);
 
+	if (cache_alloc(slab, mem)) {
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, alloc, slab, timeout, 0);
+
+		return 0;
+	}
+
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	/* Make frees bypass the caches from now on, then collect the
+	 * blocks they hold.
+	 */
+	(void)atomic_inc(&slab->waiters);
+	cache_reclaim(slab);
+#endif
+
+	key = k_spin_lock(&slab->lock);
+
 	if (slab->free_list != NULL) {
 		/* take a free block */
 		*mem = slab->free_list;
 		slab->free_list = *(char **)(slab->free_list);
-		slab->num_used++;
-
-#ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
-		slab->max_used = MAX(slab->num_used, slab->max_used);
-#endif
+		used_inc(slab);
 
 		result = 0;
 	} else if (K_TIMEOUT_EQ(timeout, K_NO_WAIT) ||
 		   !IS_ENABLED(CONFIG_MULTITHREADING)) {
 		/* don't wait for a free block to become available */
+		z_obj_stats_contended(SLAB_STATS(slab));
 		*mem = NULL;
 		result = -ENOMEM;
 	} else {
 		SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_mem_slab, alloc, slab, timeout);
 
 		/* wait for a free block or timeout */
+		z_obj_stats_contended(SLAB_STATS(slab));
+		pend_start = z_obj_stats_pend_start(SLAB_STATS(slab));
 		result = z_pend_curr(&slab->lock, key, &slab->wait_q, timeout);
+		z_obj_stats_pend_end(SLAB_STATS(slab), pend_start);
 		if (result == 0) {
 			*mem = _current->base.swap_data;
 		}
 
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+		(void)atomic_dec(&slab->waiters);
+#endif
+
 		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, alloc, slab, timeout, result);
 
 		return result;
 	}
 
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	(void)atomic_dec(&slab->waiters);
+#endif
+
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, alloc, slab, timeout, result);
 
 	k_spin_unlock(&slab->lock, key);
@@ -147,9 +369,18 @@ int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
 
 void k_mem_slab_free(struct k_mem_slab *slab, void **mem)
 {
-	k_spinlock_key_t key = k_spin_lock(&slab->lock);
+	k_spinlock_key_t key;
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, free, slab);
+
+	if (cache_free(slab, mem)) {
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, free, slab);
+
+		return;
+	}
+
+	key = k_spin_lock(&slab->lock);
+
 	if (slab->free_list == NULL && IS_ENABLED(CONFIG_MULTITHREADING)) {
 		struct k_thread *pending_thread = z_unpend_first_thread(&slab->wait_q);
 
@@ -164,7 +395,7 @@ void k_mem_slab_free(struct k_mem_slab *slab, void **mem)
 	}
 	**(char ***) mem = slab->free_list;
 	slab->free_list = *(char **) mem;
-	slab->num_used--;
+	used_dec(slab);
 
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, free, slab);
 
@@ -179,10 +410,12 @@ int k_mem_slab_runtime_stats_get(struct k_mem_slab *slab, struct sys_memory_stat
 
 	k_spinlock_key_t key = k_spin_lock(&slab->lock);
 
-	stats->allocated_bytes = slab->num_used * slab->block_size;
-	stats->free_bytes = (slab->num_blocks - slab->num_used) * slab->block_size;
+	stats->allocated_bytes = k_mem_slab_num_used_get(slab) *
+				 slab->block_size;
+	stats->free_bytes = k_mem_slab_num_free_get(slab) * slab->block_size;
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
-	stats->max_allocated_bytes = slab->max_used * slab->block_size;
+	stats->max_allocated_bytes = k_mem_slab_max_used_get(slab) *
+				     slab->block_size;
 #else
 	stats->max_allocated_bytes = 0;
 #endif
@@ -201,7 +434,11 @@ int k_mem_slab_runtime_stats_reset_max(struct k_mem_slab *slab)
 
 	k_spinlock_key_t key = k_spin_lock(&slab->lock);
 
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	atomic_set(&slab->max_used, atomic_get(&slab->num_used));
+#else
 	slab->max_used = slab->num_used;
+#endif
 
 	k_spin_unlock(&slab->lock, key);
 
@@ -1337,6 +1337,13 @@ static inline void paging_stats_eviction_inc(struct k_thread *faulting_thread,
 #endif /* CONFIG_DEMAND_PAGING_STATS */
 }
 
+static inline void paging_stats_prefetch_inc(void)
+{
+#if defined(CONFIG_DEMAND_PAGING_STATS) && defined(CONFIG_DEMAND_PAGING_PREFETCH)
+	paging_stats.pagefaults.prefetched++;
+#endif
+}
+
 static inline struct z_page_frame *do_eviction_select(bool *dirty)
 {
 	struct z_page_frame *pf;
@@ -1371,7 +1378,7 @@ static inline struct z_page_frame *do_eviction_select(bool *dirty)
 	return pf;
 }
 
-static bool do_page_fault(void *addr, bool pin)
+static bool do_page_fault(void *addr, bool pin, bool prefetch)
 {
 	struct z_page_frame *pf;
 	int key, ret;
@@ -1450,7 +1457,11 @@ static bool do_page_fault(void *addr, bool pin)
 	__ASSERT(status == ARCH_PAGE_LOCATION_PAGED_OUT,
 		 "unexpected status value %d", status);
 
-	paging_stats_faults_inc(faulting_thread, key);
+	if (prefetch) {
+		paging_stats_prefetch_inc();
+	} else {
+		paging_stats_faults_inc(faulting_thread, key);
+	}
 
 	pf = free_page_frame_list_get();
 	if (pf == NULL) {
@@ -1503,7 +1514,7 @@ static void do_page_in(void *addr)
 {
 	bool ret;
 
-	ret = do_page_fault(addr, false);
+	ret = do_page_fault(addr, false, false);
 	__ASSERT(ret, "unmapped memory address %p", addr);
 	(void)ret;
 }
@@ -1520,7 +1531,7 @@ static void do_mem_pin(void *addr)
 {
 	bool ret;
 
-	ret = do_page_fault(addr, true);
+	ret = do_page_fault(addr, true, false);
 	__ASSERT(ret, "unmapped memory address %p", addr);
 	(void)ret;
 }
@@ -1533,9 +1544,152 @@ void k_mem_pin(void *addr, size_t size)
 	virt_region_foreach(addr, size, do_mem_pin);
 }
 
+#ifdef CONFIG_DEMAND_PAGING_PREFETCH
+struct prefetch_region {
+	uintptr_t start;
+	size_t size;
+};
+
+/* Regions hinted as sequentially accessed, unused entries have no size */
+static struct prefetch_region prefetch_regions[CONFIG_DEMAND_PAGING_PREFETCH_REGIONS];
+
+int k_mem_paging_prefetch_hint(void *addr, size_t size, bool sequential)
+{
+	uintptr_t start = POINTER_TO_UINT(addr);
+	struct prefetch_region *region = NULL;
+	int key, ret;
+
+	z_mem_assert_virtual_region(addr, size);
+
+	key = irq_lock();
+	for (size_t i = 0; i < ARRAY_SIZE(prefetch_regions); i++) {
+		struct prefetch_region *r = &prefetch_regions[i];
+
+		if (sequential ? (r->size == 0U) :
+		    (r->start == start && r->size == size)) {
+			region = r;
+			break;
+		}
+	}
+
+	if (region == NULL) {
+		ret = sequential ? -ENOMEM : -ENOENT;
+	} else {
+		region->start = start;
+		region->size = sequential ? size : 0U;
+		ret = 0;
+	}
+	irq_unlock(key);
+
+	return ret;
+}
+
+/* Returns the number of pages after the page at addr that are in the same
+ * hinted region, up to CONFIG_DEMAND_PAGING_PREFETCH_PAGES. Called with
+ * interrupts locked.
+ */
+static size_t prefetch_count(uintptr_t addr)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(prefetch_regions); i++) {
+		struct prefetch_region *r = &prefetch_regions[i];
+
+		if (addr - r->start < r->size) {
+			return MIN((r->start + r->size - addr) /
+				   CONFIG_MMU_PAGE_SIZE - 1U,
+				   CONFIG_DEMAND_PAGING_PREFETCH_PAGES);
+		}
+	}
+
+	return 0U;
+}
+
+/* Marks the page frame holding the page at addr busy, so that it is not
+ * evicted while the following pages are prefetched. Returns the page frame
+ * or NULL if the page is not paged in or already busy.
+ */
+static struct z_page_frame *prefetch_busy_get(uintptr_t addr)
+{
+	struct z_page_frame *pf = NULL;
+	uintptr_t phys;
+	int key;
+
+	key = irq_lock();
+	if (arch_page_location_get(UINT_TO_POINTER(addr), &phys) ==
+	    ARCH_PAGE_LOCATION_PAGED_IN) {
+		pf = z_phys_to_page_frame(phys);
+		if (z_page_frame_is_busy(pf)) {
+			pf = NULL;
+		} else {
+			pf->flags |= Z_PAGE_FRAME_BUSY;
+		}
+	}
+	irq_unlock(key);
+
+	return pf;
+}
+
+static void do_prefetch(void *addr)
+{
+	struct z_page_frame *busy[CONFIG_DEMAND_PAGING_PREFETCH_PAGES + 1];
+	uintptr_t page = POINTER_TO_UINT(addr) & ~(CONFIG_MMU_PAGE_SIZE - 1);
+	size_t count, num_busy = 0;
+	uintptr_t location;
+	int key;
+
+	key = irq_lock();
+	count = prefetch_count(page);
+	irq_unlock(key);
+
+	if (count == 0U) {
+		return;
+	}
+
+	/* Keep the faulting page and the prefetched ones from being evicted
+	 * to make room for the next prefetched pages.
+	 */
+	busy[num_busy] = prefetch_busy_get(page);
+	if (busy[num_busy] != NULL) {
+		num_busy++;
+	}
+
+	for (size_t i = 1; i <= count; i++) {
+		void *next = UINT_TO_POINTER(page + i * CONFIG_MMU_PAGE_SIZE);
+
+		key = irq_lock();
+		if (arch_page_location_get(next, &location) !=
+		    ARCH_PAGE_LOCATION_PAGED_OUT) {
+			irq_unlock(key);
+			continue;
+		}
+		irq_unlock(key);
+
+		(void)do_page_fault(next, false, true);
+
+		busy[num_busy] = prefetch_busy_get(POINTER_TO_UINT(next));
+		if (busy[num_busy] != NULL) {
+			num_busy++;
+		}
+	}
+
+	key = irq_lock();
+	for (size_t i = 0; i < num_busy; i++) {
+		busy[i]->flags &= ~Z_PAGE_FRAME_BUSY;
+	}
+	irq_unlock(key);
+}
+#endif /* CONFIG_DEMAND_PAGING_PREFETCH */
+
 bool z_page_fault(void *addr)
 {
-	return do_page_fault(addr, false);
+	bool result = do_page_fault(addr, false, false);
+
+#ifdef CONFIG_DEMAND_PAGING_PREFETCH
+	if (result) {
+		do_prefetch(addr);
+	}
+#endif /* CONFIG_DEMAND_PAGING_PREFETCH */
+
+	return result;
 }
 
 static void do_mem_unpin(void *addr)
@@ -17,6 +17,7 @@
 #include <zephyr/linker/sections.h>
 #include <string.h>
 #include <ksched.h>
+#include <kernel_obj_stats.h>
 #include <zephyr/wait_q.h>
 #include <zephyr/sys/dlist.h>
 #include <zephyr/sys/math_extras.h>
@@ -25,6 +26,12 @@
 #include <kernel_internal.h>
 #include <zephyr/sys/check.h>
 
+#ifdef CONFIG_KERNEL_OBJ_STATS_MSGQ
+#define MSGQ_STATS(msgq) (&(msgq)->stats)
+#else
+#define MSGQ_STATS(msgq) NULL
+#endif
+
 #ifdef CONFIG_POLL
 static inline void handle_poll_events(struct k_msgq *msgq, uint32_t state)
 {
@@ -119,6 +126,7 @@ int z_impl_k_msgq_put(struct k_msgq *msgq, const void *data, k_timeout_t timeout
 
 	struct k_thread *pending_thread;
 	k_spinlock_key_t key;
+	uint64_t pend_start;
 	int result;
 
 	key = k_spin_lock(&msgq->lock);
@@ -156,6 +164,7 @@ int z_impl_k_msgq_put(struct k_msgq *msgq, const void *data, k_timeout_t timeout
 		result = 0;
 	} else if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
 		/* don't wait for message space to become available */
+		z_obj_stats_contended(MSGQ_STATS(msgq));
 		result = -ENOMSG;
 	} else {
 		SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_msgq, put, msgq, timeout);
@@ -163,7 +172,10 @@ int z_impl_k_msgq_put(struct k_msgq *msgq, const void *data, k_timeout_t timeout
 		/* wait for put message success, failure, or timeout */
 		_current->base.swap_data = (void *) data;
 
+		z_obj_stats_contended(MSGQ_STATS(msgq));
+		pend_start = z_obj_stats_pend_start(MSGQ_STATS(msgq));
 		result = z_pend_curr(&msgq->lock, key, &msgq->wait_q, timeout);
+		z_obj_stats_pend_end(MSGQ_STATS(msgq), pend_start);
 		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, put, msgq, timeout, result);
 		return result;
 	}
@@ -211,6 +223,7 @@ int z_impl_k_msgq_get(struct k_msgq *msgq, void *data, k_timeout_t timeout)
 
 	k_spinlock_key_t key;
 	struct k_thread *pending_thread;
+	uint64_t pend_start;
 	int result;
 
 	key = k_spin_lock(&msgq->lock);
@@ -254,6 +267,7 @@ int z_impl_k_msgq_get(struct k_msgq *msgq, void *data, k_timeout_t timeout)
 		result = 0;
 	} else if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
 		/* don't wait for a message to become available */
+		z_obj_stats_contended(MSGQ_STATS(msgq));
 		result = -ENOMSG;
 	} else {
 		SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_msgq, get, msgq, timeout);
@@ -261,7 +275,10 @@ int z_impl_k_msgq_get(struct k_msgq *msgq, void *data, k_timeout_t timeout)
 		/* wait for get message success or timeout */
 		_current->base.swap_data = data;
 
+		z_obj_stats_contended(MSGQ_STATS(msgq));
+		pend_start = z_obj_stats_pend_start(MSGQ_STATS(msgq));
 		result = z_pend_curr(&msgq->lock, key, &msgq->wait_q, timeout);
+		z_obj_stats_pend_end(MSGQ_STATS(msgq), pend_start);
 		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, get, msgq, timeout, result);
 		return result;
 	}
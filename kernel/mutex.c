@@ -30,6 +30,7 @@
 #include <zephyr/kernel_structs.h>
 #include <zephyr/toolchain.h>
 #include <ksched.h>
+#include <kernel_obj_stats.h>
 #include <zephyr/wait_q.h>
 #include <errno.h>
 #include <zephyr/init.h>
@@ -92,11 +93,94 @@ static bool adjust_owner_prio(struct k_mutex *mutex, int32_t new_prio)
 	return false;
 }
 
-int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
+#ifdef CONFIG_SYS_MUTEX_FAST
+/* A sys_mutex word is 0 when the mutex is free, or the owner thread
+ * pointer.  While SYS_MUTEX_KERNEL is clear the owner took the mutex
+ * with a single atomic operation in user mode and the k_mutex doesn't
+ * know about it.  Once the flag is set the k_mutex holds the state
+ * and everybody goes through the kernel, until the mutex is released
+ * with nobody waiting.  All of this is done under the mutex lock.
+ */
+#define SYS_MUTEX_KERNEL BIT(0)
+
+static int sys_mutex_adopt(struct k_mutex *mutex, atomic_t *val)
 {
+	struct k_thread *owner;
+	struct z_object *ko;
+	atomic_val_t old;
+	int ret;
+
+	if (val == NULL) {
+		return 0;
+	}
+
+	old = atomic_or(val, SYS_MUTEX_KERNEL);
+	if ((old & SYS_MUTEX_KERNEL) != 0) {
+		return 0;
+	}
+
+	owner = (struct k_thread *)(old & ~SYS_MUTEX_KERNEL);
+	if (owner == NULL) {
+		return 0;
+	}
+
+	/* The word lives in user memory, don't trust it: the owner must be
+	 * a live thread, which a user mode caller has permission on, as it
+	 * gets its priority raised on contention.
+	 */
+	ko = z_object_find(owner);
+	if ((ko == NULL) || (ko->type != K_OBJ_THREAD) ||
+	    ((ko->flags & K_OBJ_FLAG_INITIALIZED) == 0U) ||
+	    ((owner->base.thread_state & _THREAD_DEAD) != 0U)) {
+		ret = -EINVAL;
+	} else if (((_current->base.user_options & K_USER) != 0U) &&
+		   (z_object_validate(ko, K_OBJ_THREAD, _OBJ_INIT_TRUE) != 0)) {
+		ret = -EPERM;
+	} else {
+		ret = 0;
+	}
+
+	if (ret != 0) {
+		/* Leave the word as it was */
+		(void)atomic_cas(val, old | SYS_MUTEX_KERNEL, old);
+		return ret;
+	}
+
+	__ASSERT_NO_MSG(mutex->lock_count == 0U);
+
+	mutex->owner = owner;
+	mutex->owner_orig_prio = owner->base.prio;
+	mutex->lock_count = 1U;
+
+	return 0;
+}
+
+static inline void sys_mutex_owner_set(atomic_t *val, struct k_thread *owner)
+{
+	if (val != NULL) {
+		atomic_set(val, (owner != NULL) ?
+			   ((atomic_val_t)owner | SYS_MUTEX_KERNEL) : 0);
+	}
+}
+#else
+#define sys_mutex_adopt(mutex, val) (ARG_UNUSED(val), 0)
+#define sys_mutex_owner_set(val, owner) ARG_UNUSED(val)
+#endif /* CONFIG_SYS_MUTEX_FAST */
+
+#ifdef CONFIG_KERNEL_OBJ_STATS_MUTEX
+#define MUTEX_STATS(mutex) (&(mutex)->stats)
+#else
+#define MUTEX_STATS(mutex) NULL
+#endif
+
+static int mutex_lock(struct k_mutex *mutex, atomic_t *val,
+		      k_timeout_t timeout)
+{
+	uint64_t pend_start;
 	int new_prio;
 	k_spinlock_key_t key;
 	bool resched = false;
+	int ret;
 
 	__ASSERT(!arch_is_in_isr(), "mutexes cannot be used inside ISRs");
 
@@ -104,6 +188,15 @@ int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 
 	key = k_spin_lock(&lock);
 
+	ret = sys_mutex_adopt(mutex, val);
+	if (unlikely(ret != 0)) {
+		k_spin_unlock(&lock, key);
+
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mutex, lock, mutex, timeout, ret);
+
+		return ret;
+	}
+
 	if (likely((mutex->lock_count == 0U) || (mutex->owner == _current))) {
 
 		mutex->owner_orig_prio = (mutex->lock_count == 0U) ?
@@ -112,6 +205,7 @@ int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 
 		mutex->lock_count++;
 		mutex->owner = _current;
+		sys_mutex_owner_set(val, _current);
 
 		LOG_DBG("%p took mutex %p, count: %d, orig prio: %d",
 			_current, mutex, mutex->lock_count,
@@ -124,6 +218,8 @@ int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 		return 0;
 	}
 
+	z_obj_stats_contended(MUTEX_STATS(mutex));
+
 	if (unlikely(K_TIMEOUT_EQ(timeout, K_NO_WAIT))) {
 		k_spin_unlock(&lock, key);
 
@@ -143,8 +239,12 @@ int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 		resched = adjust_owner_prio(mutex, new_prio);
 	}
 
+	pend_start = z_obj_stats_pend_start(MUTEX_STATS(mutex));
+
 	int got_mutex = z_pend_curr(&lock, key, &mutex->wait_q, timeout);
 
+	z_obj_stats_pend_end(MUTEX_STATS(mutex), pend_start);
+
 	LOG_DBG("on mutex %p got_mutex value: %d", mutex, got_mutex);
 
 	LOG_DBG("%p got mutex %p (y/n): %c", _current, mutex,
@@ -188,6 +288,11 @@ int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 	return -EAGAIN;
 }
 
+int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
+{
+	return mutex_lock(mutex, NULL, timeout);
+}
+
 #ifdef CONFIG_USERSPACE
 static inline int z_vrfy_k_mutex_lock(struct k_mutex *mutex,
 				      k_timeout_t timeout)
@@ -198,7 +303,7 @@ static inline int z_vrfy_k_mutex_lock(struct k_mutex *mutex,
 #include <syscalls/k_mutex_lock_mrsh.c>
 #endif
 
-int z_impl_k_mutex_unlock(struct k_mutex *mutex)
+static int mutex_unlock(struct k_mutex *mutex, atomic_t *val)
 {
 	struct k_thread *new_owner;
 
@@ -247,6 +352,7 @@ int z_impl_k_mutex_unlock(struct k_mutex *mutex)
 	new_owner = z_unpend_first_thread(&mutex->wait_q);
 
 	mutex->owner = new_owner;
+	sys_mutex_owner_set(val, new_owner);
 
 	LOG_DBG("new owner of mutex %p: %p (prio: %d)",
 		mutex, new_owner, new_owner ? new_owner->base.prio : -1000);
@@ -273,6 +379,11 @@ k_mutex_unlock_return:
 	return 0;
 }
 
+int z_impl_k_mutex_unlock(struct k_mutex *mutex)
+{
+	return mutex_unlock(mutex, NULL);
+}
+
 #ifdef CONFIG_USERSPACE
 static inline int z_vrfy_k_mutex_unlock(struct k_mutex *mutex)
 {
@@ -281,3 +392,35 @@ static inline int z_vrfy_k_mutex_unlock(struct k_mutex *mutex)
 }
 #include <syscalls/k_mutex_unlock_mrsh.c>
 #endif
+
+#ifdef CONFIG_SYS_MUTEX_FAST
+int z_sys_mutex_lock(struct k_mutex *mutex, atomic_t *val,
+		     k_timeout_t timeout)
+{
+	return mutex_lock(mutex, val, timeout);
+}
+
+int z_sys_mutex_unlock(struct k_mutex *mutex, atomic_t *val)
+{
+	bool locked = false;
+	int ret = 0;
+
+	/* Pick up an owner that locked the mutex in user mode before
+	 * looking at the k_mutex state
+	 */
+	K_SPINLOCK(&lock) {
+		ret = sys_mutex_adopt(mutex, val);
+		locked = mutex->lock_count != 0U;
+	}
+
+	if (ret != 0) {
+		return ret;
+	}
+
+	if (!locked) {
+		return -EINVAL;
+	}
+
+	return mutex_unlock(mutex, val);
+}
+#endif /* CONFIG_SYS_MUTEX_FAST */
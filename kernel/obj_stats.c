@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/kernel/obj_stats.h>
+
+STATS_NAME_START(k_obj)
+	STATS_NAME(k_obj, contentions)
+	STATS_NAME(k_obj, pends)
+	STATS_NAME(k_obj, wait_us)
+	STATS_NAME(k_obj, max_wait_us)
+STATS_NAME_END(k_obj);
+
+static sys_slist_t obj_stats_list = SYS_SLIST_STATIC_INIT(&obj_stats_list);
+static struct k_spinlock list_lock;
+
+int k_obj_stats_register(struct k_obj_stats *stats, const char *name)
+{
+	k_spinlock_key_t key;
+	int rc;
+
+	key = k_spin_lock(&stats->lock);
+	stats_init(&stats->counters.s_hdr,
+		   STATS_SIZE_INIT_PARMS(stats->counters, STATS_SIZE_64),
+		   STATS_NAME_INIT_PARMS(k_obj));
+	k_spin_unlock(&stats->lock, key);
+
+	/* Also serializes the registrations with the statistics subsystem */
+	key = k_spin_lock(&list_lock);
+	rc = stats_register(name, &stats->counters.s_hdr);
+	if (rc == 0) {
+		sys_slist_append(&obj_stats_list, &stats->node);
+	}
+	k_spin_unlock(&list_lock, key);
+
+	return rc;
+}
+
+void k_obj_stats_foreach(k_obj_stats_user_cb_t user_cb, void *user_data)
+{
+	STATS_SECT_DECL(k_obj) counters;
+	struct k_obj_stats *stats;
+	k_spinlock_key_t key;
+
+	/* Objects are only ever appended, the list can be walked unlocked */
+	SYS_SLIST_FOR_EACH_CONTAINER(&obj_stats_list, stats, node) {
+		key = k_spin_lock(&stats->lock);
+		counters = stats->counters;
+		k_spin_unlock(&stats->lock, key);
+
+		user_cb(counters.s_hdr.s_name, &counters, user_data);
+	}
+}
@@ -20,6 +20,13 @@
 #include <zephyr/syscall_handler.h>
 #include <kernel_internal.h>
 #include <zephyr/sys/check.h>
+#include <kernel_obj_stats.h>
+
+#ifdef CONFIG_KERNEL_OBJ_STATS_PIPE
+#define PIPE_STATS(pipe) (&(pipe)->stats)
+#else
+#define PIPE_STATS(pipe) NULL
+#endif
 
 struct waitq_walk_data {
 	sys_dlist_t *list;
@@ -39,6 +46,8 @@ void k_pipe_init(struct k_pipe *pipe, unsigned char *buffer, size_t size)
 	pipe->bytes_used = 0U;
 	pipe->read_index = 0U;
 	pipe->write_index = 0U;
+	pipe->put_claimed = 0U;
+	pipe->get_claimed = 0U;
 	pipe->lock = (struct k_spinlock){};
 	z_waitq_init(&pipe->wait_q.writers);
 	z_waitq_init(&pipe->wait_q.readers);
@@ -176,6 +185,8 @@ int k_pipe_cleanup(struct k_pipe *pipe)
 		pipe->bytes_used = 0U;
 		pipe->read_index = 0U;
 		pipe->write_index = 0U;
+		pipe->put_claimed = 0U;
+		pipe->get_claimed = 0U;
 		pipe->flags &= ~K_PIPE_FLAG_ALLOC;
 	}
 
@@ -369,6 +380,249 @@ static size_t pipe_write(struct k_pipe *pipe, sys_dlist_t *src_list,
 	return num_bytes_written;
 }
 
+/**
+ * @brief Refill the pipe buffer from waiting writers, if it is not full
+ */
+static void pipe_refill(struct k_pipe *pipe, bool *reschedule)
+{
+	struct _pipe_desc pipe_desc[2];
+	sys_dlist_t       src_list;
+	sys_dlist_t       pipe_list;
+
+	if ((pipe->bytes_used == pipe->size) || (pipe->put_claimed != 0U)) {
+		return;
+	}
+
+	sys_dlist_init(&src_list);
+	sys_dlist_init(&pipe_list);
+
+	(void) pipe_waiter_list_populate(&src_list,
+					 &pipe->wait_q.writers,
+					 pipe->size - pipe->bytes_used);
+
+	(void) pipe_buffer_list_populate(&pipe_list, pipe_desc,
+					 pipe->buffer, pipe->size,
+					 pipe->write_index,
+					 pipe->read_index);
+
+	(void) pipe_write(pipe, &src_list, &pipe_list, reschedule);
+}
+
+/**
+ * @brief Hand data from the pipe buffer to waiting readers
+ */
+static void pipe_feed_readers(struct k_pipe *pipe, bool *reschedule)
+{
+	struct _pipe_desc  pipe_desc[2];
+	struct _pipe_desc *src;
+	struct _pipe_desc *dest;
+	sys_dlist_t        src_list;
+	sys_dlist_t        dest_list;
+	size_t             bytes_copied;
+
+	if ((pipe->bytes_used == 0U) || (pipe->get_claimed != 0U)) {
+		return;
+	}
+
+	sys_dlist_init(&src_list);
+	sys_dlist_init(&dest_list);
+
+	(void) pipe_buffer_list_populate(&src_list, pipe_desc,
+					 pipe->buffer, pipe->size,
+					 pipe->read_index,
+					 pipe->write_index);
+
+	(void) pipe_waiter_list_populate(&dest_list,
+					 &pipe->wait_q.readers,
+					 pipe->bytes_used);
+
+	src = (struct _pipe_desc *)sys_dlist_get(&src_list);
+	dest = (struct _pipe_desc *)sys_dlist_get(&dest_list);
+
+	while ((src != NULL) && (dest != NULL)) {
+		bytes_copied = pipe_xfer(dest->buffer, dest->bytes_to_xfer,
+					 src->buffer, src->bytes_to_xfer);
+
+		dest->buffer        += bytes_copied;
+		dest->bytes_to_xfer -= bytes_copied;
+
+		src->buffer         += bytes_copied;
+		src->bytes_to_xfer  -= bytes_copied;
+
+		pipe->bytes_used -= bytes_copied;
+		pipe->read_index += bytes_copied;
+		if (pipe->read_index >= pipe->size) {
+			pipe->read_index -= pipe->size;
+		}
+
+		if (dest->bytes_to_xfer == 0U) {
+
+			/* The thread's read request has been satisfied. */
+
+			z_unpend_thread(dest->thread);
+			z_ready_thread(dest->thread);
+
+			*reschedule = true;
+
+			dest = (struct _pipe_desc *)sys_dlist_get(&dest_list);
+		}
+
+		if (src->bytes_to_xfer == 0U) {
+			src = (struct _pipe_desc *)sys_dlist_get(&src_list);
+		}
+	}
+}
+
+/**
+ * @brief Move data from waiting writers through the pipe buffer to waiting
+ *        readers, preserving the byte order
+ */
+static void pipe_settle(struct k_pipe *pipe, bool *reschedule)
+{
+	size_t bytes_used;
+
+	do {
+		pipe_feed_readers(pipe, reschedule);
+		bytes_used = pipe->bytes_used;
+		pipe_refill(pipe, reschedule);
+	} while (pipe->bytes_used != bytes_used);
+}
+
+/**
+ * @brief Check whether data may be handed from writers to readers directly
+ *
+ * Buffered bytes and claimed space come before the data of a writer, which
+ * must not overtake them.
+ */
+static inline bool pipe_direct_xfer_allowed(struct k_pipe *pipe)
+{
+	return (pipe->bytes_used == 0U) && (pipe->put_claimed == 0U) &&
+	       (pipe->get_claimed == 0U);
+}
+
+/**
+ * @brief Find the contiguous area of @a avail bytes starting @a offset
+ *        bytes after @a index in the pipe buffer
+ *
+ * @return Number of contiguous bytes, at most @a size
+ */
+static size_t pipe_claim_area(struct k_pipe *pipe, size_t index, size_t offset,
+			      size_t avail, size_t size, unsigned char **data)
+{
+	size_t start = index + offset;
+
+	if (start >= pipe->size) {
+		start -= pipe->size;
+	}
+
+	*data = &pipe->buffer[start];
+
+	return MIN(MIN(avail - offset, pipe->size - start), size);
+}
+
+size_t k_pipe_put_claim(struct k_pipe *pipe, unsigned char **data, size_t size)
+{
+	k_spinlock_key_t key;
+	size_t claimed;
+
+	if (pipe->buffer == NULL || pipe->size == 0U) {
+		return 0;
+	}
+
+	key = k_spin_lock(&pipe->lock);
+
+	claimed = pipe_claim_area(pipe, pipe->write_index, pipe->put_claimed,
+				  pipe->size - pipe->bytes_used, size, data);
+	pipe->put_claimed += claimed;
+
+	k_spin_unlock(&pipe->lock, key);
+
+	return claimed;
+}
+
+int k_pipe_put_commit(struct k_pipe *pipe, size_t size)
+{
+	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
+	bool reschedule_needed = false;
+
+	CHECKIF(size > pipe->put_claimed) {
+		k_spin_unlock(&pipe->lock, key);
+
+		return -EINVAL;
+	}
+
+	pipe->put_claimed = 0U;
+	pipe->bytes_used += size;
+	pipe->write_index += size;
+	if (pipe->write_index >= pipe->size) {
+		pipe->write_index -= pipe->size;
+	}
+
+	pipe_settle(pipe, &reschedule_needed);
+
+	if ((pipe->bytes_used != 0U) && (size != 0U)) {
+		handle_poll_events(pipe);
+	}
+
+	if (reschedule_needed) {
+		z_reschedule(&pipe->lock, key);
+	} else {
+		k_spin_unlock(&pipe->lock, key);
+	}
+
+	return 0;
+}
+
+size_t k_pipe_get_claim(struct k_pipe *pipe, unsigned char **data, size_t size)
+{
+	k_spinlock_key_t key;
+	size_t claimed;
+
+	if (pipe->buffer == NULL || pipe->size == 0U) {
+		return 0;
+	}
+
+	key = k_spin_lock(&pipe->lock);
+
+	claimed = pipe_claim_area(pipe, pipe->read_index, pipe->get_claimed,
+				  pipe->bytes_used, size, data);
+	pipe->get_claimed += claimed;
+
+	k_spin_unlock(&pipe->lock, key);
+
+	return claimed;
+}
+
+int k_pipe_get_finish(struct k_pipe *pipe, size_t size)
+{
+	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
+	bool reschedule_needed = false;
+
+	CHECKIF(size > pipe->get_claimed) {
+		k_spin_unlock(&pipe->lock, key);
+
+		return -EINVAL;
+	}
+
+	pipe->get_claimed = 0U;
+	pipe->bytes_used -= size;
+	pipe->read_index += size;
+	if (pipe->read_index >= pipe->size) {
+		pipe->read_index -= pipe->size;
+	}
+
+	/* Unclaimed data is available to waiting readers again */
+	pipe_settle(pipe, &reschedule_needed);
+
+	if (reschedule_needed) {
+		z_reschedule(&pipe->lock, key);
+	} else {
+		k_spin_unlock(&pipe->lock, key);
+	}
+
+	return 0;
+}
+
 int z_impl_k_pipe_put(struct k_pipe *pipe, void *data, size_t bytes_to_write,
 		     size_t *bytes_written, size_t min_xfer,
 		      k_timeout_t timeout)
@@ -380,6 +634,7 @@ int z_impl_k_pipe_put(struct k_pipe *pipe, void *data, size_t bytes_to_write,
 	sys_dlist_t        src_list;
 	size_t             bytes_can_write;
 	bool               reschedule_needed = false;
+	uint64_t           pend_start;
 
 	__ASSERT(((arch_is_in_isr() == false) ||
 		  K_TIMEOUT_EQ(timeout, K_NO_WAIT)), "");
@@ -399,15 +654,20 @@ int z_impl_k_pipe_put(struct k_pipe *pipe, void *data, size_t bytes_to_write,
 	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
 
 	/*
-	 * First, write to any waiting readers, if any exist.
+	 * First, write to any waiting readers, if any exist and no older
+	 * data is buffered or claimed.
 	 * Second, write to the pipe buffer, if it exists.
 	 */
 
-	bytes_can_write = pipe_waiter_list_populate(&dest_list,
-						    &pipe->wait_q.readers,
-						    bytes_to_write);
+	bytes_can_write = 0U;
+	if (pipe_direct_xfer_allowed(pipe)) {
+		bytes_can_write = pipe_waiter_list_populate(&dest_list,
+							    &pipe->wait_q.readers,
+							    bytes_to_write);
+	}
 
-	if (pipe->bytes_used != pipe->size) {
+	/* Space claimed for in place writing must be committed first */
+	if ((pipe->bytes_used != pipe->size) && (pipe->put_claimed == 0U)) {
 		bytes_can_write += pipe_buffer_list_populate(&dest_list,
 							     pipe_desc,
 							     pipe->buffer,
@@ -421,6 +681,7 @@ int z_impl_k_pipe_put(struct k_pipe *pipe, void *data, size_t bytes_to_write,
 
 		/* The request can not be fulfilled. */
 
+		z_obj_stats_contended(PIPE_STATS(pipe));
 		k_spin_unlock(&pipe->lock, key);
 		*bytes_written = 0U;
 
@@ -445,6 +706,9 @@ int z_impl_k_pipe_put(struct k_pipe *pipe, void *data, size_t bytes_to_write,
 	*bytes_written = pipe_write(pipe, &src_list,
 				    &dest_list, &reschedule_needed);
 
+	/* Readers skipped above get the buffered data in order */
+	pipe_feed_readers(pipe, &reschedule_needed);
+
 	/*
 	 * Only handle poll events if the pipe has had some bytes written and
 	 * there are bytes remaining after any pending readers have read from it
@@ -482,7 +746,10 @@ int z_impl_k_pipe_put(struct k_pipe *pipe, void *data, size_t bytes_to_write,
 
 	_current->base.swap_data = src_desc;
 
+	z_obj_stats_contended(PIPE_STATS(pipe));
+	pend_start = z_obj_stats_pend_start(PIPE_STATS(pipe));
 	z_sched_wait(&pipe->lock, key, &pipe->wait_q.writers, timeout, NULL);
+	z_obj_stats_pend_end(PIPE_STATS(pipe), pend_start);
 
 	/*
 	 * On SMP systems, threads in the processing list may timeout before
@@ -534,6 +801,7 @@ static int pipe_get_internal(k_spinlock_key_t key, struct k_pipe *pipe,
 	size_t         bytes_copied;
 	size_t         bytes_can_read = 0U;
 	bool           reschedule_needed = false;
+	uint64_t       pend_start;
 
 	/*
 	 * Data copying takes place in the following order.
@@ -544,24 +812,34 @@ static int pipe_get_internal(k_spinlock_key_t key, struct k_pipe *pipe,
 
 	sys_dlist_init(&src_list);
 
-	if (pipe->bytes_used != 0) {
-		bytes_can_read = pipe_buffer_list_populate(&src_list,
-							   pipe_desc,
-							   pipe->buffer,
-							   pipe->size,
-							   pipe->read_index,
-							   pipe->write_index);
-	}
+	/*
+	 * Data claimed for in place reading belongs to the claiming reader,
+	 * and neither buffered data nor the waiting writers may overtake it.
+	 * The waiting writers may not overtake claimed space either.
+	 */
+	if (pipe->get_claimed == 0U) {
+		if (pipe->bytes_used != 0) {
+			bytes_can_read = pipe_buffer_list_populate(&src_list,
+								   pipe_desc,
+								   pipe->buffer,
+								   pipe->size,
+								   pipe->read_index,
+								   pipe->write_index);
+		}
 
-	bytes_can_read += pipe_waiter_list_populate(&src_list,
-						    &pipe->wait_q.writers,
-						    bytes_to_read);
+		if (pipe->put_claimed == 0U) {
+			bytes_can_read += pipe_waiter_list_populate(&src_list,
+								    &pipe->wait_q.writers,
+								    bytes_to_read);
+		}
+	}
 
 	if ((bytes_can_read < min_xfer) &&
 	    (K_TIMEOUT_EQ(timeout, K_NO_WAIT))) {
 
 		/* The request can not be fulfilled. */
 
+		z_obj_stats_contended(PIPE_STATS(pipe));
 		k_spin_unlock(&pipe->lock, key);
 		*bytes_read = 0;
 
@@ -617,29 +895,7 @@ static int pipe_get_internal(k_spinlock_key_t key, struct k_pipe *pipe,
 		src_desc = (struct _pipe_desc *)sys_dlist_get(&src_list);
 	}
 
-	if (pipe->bytes_used != pipe->size) {
-		sys_dlist_t         pipe_list;
-
-		/*
-		 * The pipe is not full. If there are any waiting writers,
-		 * refill the pipe.
-		 */
-
-		sys_dlist_init(&src_list);
-		sys_dlist_init(&pipe_list);
-
-		(void) pipe_waiter_list_populate(&src_list,
-						 &pipe->wait_q.writers,
-						 pipe->size - pipe->bytes_used);
-
-		(void) pipe_buffer_list_populate(&pipe_list, pipe_desc,
-						 pipe->buffer, pipe->size,
-						 pipe->write_index,
-						 pipe->read_index);
-
-		(void) pipe_write(pipe, &src_list,
-				  &pipe_list, &reschedule_needed);
-	}
+	pipe_refill(pipe, &reschedule_needed);
 
 	/*
 	 * The immediate success conditions below are backwards
@@ -668,7 +924,10 @@ static int pipe_get_internal(k_spinlock_key_t key, struct k_pipe *pipe,
 
 	_current->base.swap_data = dest_desc;
 
+	z_obj_stats_contended(PIPE_STATS(pipe));
+	pend_start = z_obj_stats_pend_start(PIPE_STATS(pipe));
 	z_sched_wait(&pipe->lock, key, &pipe->wait_q.readers, timeout, NULL);
+	z_obj_stats_pend_end(PIPE_STATS(pipe), pend_start);
 
 	/*
 	 * On SMP systems, threads in the processing list may timeout before
@@ -748,6 +1007,7 @@ size_t z_impl_k_pipe_read_avail(struct k_pipe *pipe)
 	} else {
 		res = pipe->size - (pipe->read_index - pipe->write_index);
 	}
+	res -= pipe->get_claimed;
 
 	k_spin_unlock(&pipe->lock, key);
 
@@ -785,6 +1045,7 @@ size_t z_impl_k_pipe_write_avail(struct k_pipe *pipe)
 	} else {
 		res = pipe->size - (pipe->write_index - pipe->read_index);
 	}
+	res -= pipe->put_claimed;
 
 	k_spin_unlock(&pipe->lock, key);
 
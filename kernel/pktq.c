@@ -0,0 +1,239 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Packet queues.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/kernel_structs.h>
+#include <zephyr/kernel/pktq.h>
+
+#include <string.h>
+#include <ksched.h>
+#include <zephyr/wait_q.h>
+#include <zephyr/syscall_handler.h>
+#include <kernel_internal.h>
+
+#define PKTQ_HDR_WLEN (sizeof(struct z_pktq_hdr) / sizeof(uint32_t))
+
+BUILD_ASSERT(sizeof(struct z_pktq_hdr) == sizeof(uint32_t));
+
+static inline size_t pktq_wlen(size_t len)
+{
+	return PKTQ_HDR_WLEN + DIV_ROUND_UP(len, sizeof(uint32_t));
+}
+
+static inline struct z_pktq_hdr *pktq_hdr(const void *data)
+{
+	return (struct z_pktq_hdr *)data - 1;
+}
+
+uint32_t z_pktq_get_wlen(const union mpsc_pbuf_generic *packet)
+{
+	const struct z_pktq_hdr *hdr = (const struct z_pktq_hdr *)packet;
+
+	return pktq_wlen(hdr->len);
+}
+
+void k_pktq_init(struct k_pktq *pktq, void *buffer, size_t size)
+{
+	const struct mpsc_pbuf_buffer_config config = {
+		.buf = buffer,
+		.size = size / sizeof(uint32_t),
+		.get_wlen = z_pktq_get_wlen,
+	};
+
+	__ASSERT(((uintptr_t)buffer % sizeof(uint32_t)) == 0U,
+		 "unaligned packet queue buffer");
+
+	mpsc_pbuf_init(&pktq->buf, &config);
+	z_waitq_init(&pktq->wait_q);
+	pktq->lock = (struct k_spinlock) {};
+	pktq->pending = NULL;
+#ifdef CONFIG_POLL
+	sys_dlist_init(&pktq->poll_events);
+#endif
+
+	z_object_init(pktq);
+}
+
+void *k_pktq_alloc(struct k_pktq *pktq, size_t len, k_timeout_t timeout)
+{
+	struct z_pktq_hdr *hdr;
+
+	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
+
+	if (pktq_wlen(len) > pktq->buf.size) {
+		return NULL;
+	}
+
+	hdr = (struct z_pktq_hdr *)mpsc_pbuf_alloc(&pktq->buf, pktq_wlen(len),
+						   timeout);
+	if (hdr == NULL) {
+		return NULL;
+	}
+
+	hdr->len = len;
+
+	return hdr + 1;
+}
+
+void k_pktq_commit(struct k_pktq *pktq, void *data)
+{
+	k_spinlock_key_t key;
+
+	mpsc_pbuf_commit(&pktq->buf, (union mpsc_pbuf_generic *)pktq_hdr(data));
+
+	/* The reader checks for packets with the lock held before pending,
+	 * so it either sees this packet or is woken up here.
+	 */
+	key = k_spin_lock(&pktq->lock);
+
+#ifdef CONFIG_POLL
+	z_handle_obj_poll_events(&pktq->poll_events,
+				 K_POLL_STATE_PKTQ_DATA_AVAILABLE);
+#endif
+
+	if (z_unpend_all(&pktq->wait_q) != 0) {
+		z_reschedule(&pktq->lock, key);
+	} else {
+		k_spin_unlock(&pktq->lock, key);
+	}
+}
+
+/* Packets may be committed out of order, so a committed packet does not
+ * guarantee that the oldest one can be claimed: the reader goes back to
+ * waiting until the remaining time runs out.
+ */
+static const struct z_pktq_hdr *pktq_claim(struct k_pktq *pktq,
+					   k_timeout_t timeout)
+{
+	k_timepoint_t end = sys_timepoint_calc(timeout);
+	const union mpsc_pbuf_generic *packet;
+	k_spinlock_key_t key;
+
+	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
+
+	key = k_spin_lock(&pktq->lock);
+
+	while (true) {
+		packet = pktq->pending;
+		if (packet != NULL) {
+			pktq->pending = NULL;
+			break;
+		}
+
+		packet = mpsc_pbuf_claim(&pktq->buf);
+		if (packet != NULL) {
+			break;
+		}
+
+		timeout = sys_timepoint_timeout(end);
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			break;
+		}
+
+		(void)z_pend_curr(&pktq->lock, key, &pktq->wait_q, timeout);
+		key = k_spin_lock(&pktq->lock);
+	}
+
+	k_spin_unlock(&pktq->lock, key);
+
+	return (const struct z_pktq_hdr *)packet;
+}
+
+const void *k_pktq_claim(struct k_pktq *pktq, size_t *len,
+			 k_timeout_t timeout)
+{
+	const struct z_pktq_hdr *hdr = pktq_claim(pktq, timeout);
+
+	if (hdr == NULL) {
+		return NULL;
+	}
+
+	*len = hdr->len;
+
+	return hdr + 1;
+}
+
+void k_pktq_free(struct k_pktq *pktq, const void *data)
+{
+	mpsc_pbuf_free(&pktq->buf,
+		       (const union mpsc_pbuf_generic *)pktq_hdr(data));
+}
+
+int z_impl_k_pktq_put(struct k_pktq *pktq, const void *data, size_t len,
+		      k_timeout_t timeout)
+{
+	void *packet;
+
+	if (pktq_wlen(len) > pktq->buf.size) {
+		return -EINVAL;
+	}
+
+	packet = k_pktq_alloc(pktq, len, timeout);
+	if (packet == NULL) {
+		return K_TIMEOUT_EQ(timeout, K_NO_WAIT) ? -ENOMSG : -EAGAIN;
+	}
+
+	memcpy(packet, data, len);
+	k_pktq_commit(pktq, packet);
+
+	return 0;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_pktq_put(struct k_pktq *pktq, const void *data,
+				    size_t len, k_timeout_t timeout)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(pktq, K_OBJ_PKTQ));
+	Z_OOPS(Z_SYSCALL_MEMORY_READ(data, len));
+
+	return z_impl_k_pktq_put(pktq, data, len, timeout);
+}
+#include <syscalls/k_pktq_put_mrsh.c>
+#endif
+
+int z_impl_k_pktq_get(struct k_pktq *pktq, void *data, size_t size,
+		      k_timeout_t timeout)
+{
+	const struct z_pktq_hdr *hdr = pktq_claim(pktq, timeout);
+	k_spinlock_key_t key;
+	size_t len;
+
+	if (hdr == NULL) {
+		return K_TIMEOUT_EQ(timeout, K_NO_WAIT) ? -ENOMSG : -EAGAIN;
+	}
+
+	len = hdr->len;
+	if (len > size) {
+		/* Keep the packet for a read with a larger buffer */
+		key = k_spin_lock(&pktq->lock);
+		pktq->pending = (const union mpsc_pbuf_generic *)hdr;
+		k_spin_unlock(&pktq->lock, key);
+
+		return -EMSGSIZE;
+	}
+
+	memcpy(data, hdr + 1, len);
+	mpsc_pbuf_free(&pktq->buf, (const union mpsc_pbuf_generic *)hdr);
+
+	return (int)len;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_pktq_get(struct k_pktq *pktq, void *data,
+				    size_t size, k_timeout_t timeout)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(pktq, K_OBJ_PKTQ));
+	Z_OOPS(Z_SYSCALL_MEMORY_WRITE(data, size));
+
+	return z_impl_k_pktq_get(pktq, data, size, timeout);
+}
+#include <syscalls/k_pktq_get_mrsh.c>
+#endif
@@ -24,6 +24,9 @@
 #include <zephyr/sys/util.h>
 #include <zephyr/sys/__assert.h>
 #include <stdbool.h>
+#ifdef CONFIG_PKTQ
+#include <zephyr/kernel/pktq.h>
+#endif
 
 /* Single subsystem lock.  Locking per-event would be better on highly
  * contended SMP systems, but the original locking scheme here is
@@ -34,10 +37,11 @@
  */
 static struct k_spinlock lock;
 
-enum POLL_MODE { MODE_NONE, MODE_POLL, MODE_TRIGGERED };
+enum POLL_MODE { MODE_NONE, MODE_POLL, MODE_TRIGGERED, MODE_SET };
 
 static int signal_poller(struct k_poll_event *event, uint32_t state);
 static int signal_triggered_work(struct k_poll_event *event, uint32_t status);
+static int signal_poll_set(struct k_poll_event *event, uint32_t state);
 
 void k_poll_event_init(struct k_poll_event *event, uint32_t type,
 		       int mode, void *obj)
@@ -92,6 +96,15 @@ static inline bool is_condition_met(struct k_poll_event *event, uint32_t *state)
 			*state = K_POLL_STATE_PIPE_DATA_AVAILABLE;
 			return true;
 		}
+		break;
+#endif
+#ifdef CONFIG_PKTQ
+	case K_POLL_TYPE_PKTQ_DATA_AVAILABLE:
+		if (z_pktq_is_pending(event->pktq)) {
+			*state = K_POLL_STATE_PKTQ_DATA_AVAILABLE;
+			return true;
+		}
+		break;
 #endif
 	case K_POLL_TYPE_IGNORE:
 		break;
@@ -113,17 +126,22 @@ static inline void add_event(sys_dlist_t *events, struct k_poll_event *event,
 {
 	struct k_poll_event *pending;
 
+	/* Poll sets have no priority of their own: they are served after
+	 * threads, in registration order.
+	 */
 	pending = (struct k_poll_event *)sys_dlist_peek_tail(events);
-	if ((pending == NULL) ||
-		(z_sched_prio_cmp(poller_thread(pending->poller),
-							   poller_thread(poller)) > 0)) {
+	if ((pending == NULL) || (poller->mode == MODE_SET) ||
+		((pending->poller->mode != MODE_SET) &&
+		 (z_sched_prio_cmp(poller_thread(pending->poller),
+				   poller_thread(poller)) > 0))) {
 		sys_dlist_append(events, &event->_node);
 		return;
 	}
 
 	SYS_DLIST_FOR_EACH_CONTAINER(events, pending, _node) {
-		if (z_sched_prio_cmp(poller_thread(poller),
-					poller_thread(pending->poller)) > 0) {
+		if ((pending->poller->mode == MODE_SET) ||
+		    (z_sched_prio_cmp(poller_thread(poller),
+				      poller_thread(pending->poller)) > 0)) {
 			sys_dlist_insert(&pending->_node, &event->_node);
 			return;
 		}
@@ -158,6 +176,12 @@ static inline void register_event(struct k_poll_event *event,
 		__ASSERT(event->pipe != NULL, "invalid pipe\n");
 		add_event(&event->pipe->poll_events, event, poller);
 		break;
+#endif
+#ifdef CONFIG_PKTQ
+	case K_POLL_TYPE_PKTQ_DATA_AVAILABLE:
+		__ASSERT(event->pktq != NULL, "invalid packet queue\n");
+		add_event(&event->pktq->poll_events, event, poller);
+		break;
 #endif
 	case K_POLL_TYPE_IGNORE:
 		/* nothing to do */
@@ -199,6 +223,12 @@ static inline void clear_event_registration(struct k_poll_event *event)
 		__ASSERT(event->pipe != NULL, "invalid pipe\n");
 		remove_event = true;
 		break;
+#endif
+#ifdef CONFIG_PKTQ
+	case K_POLL_TYPE_PKTQ_DATA_AVAILABLE:
+		__ASSERT(event->pktq != NULL, "invalid packet queue\n");
+		remove_event = true;
+		break;
 #endif
 	case K_POLL_TYPE_IGNORE:
 		/* nothing to do */
@@ -420,6 +450,11 @@ static inline int z_vrfy_k_poll(struct k_poll_event *events,
 		case K_POLL_TYPE_PIPE_DATA_AVAILABLE:
 			Z_OOPS(Z_SYSCALL_OBJ(e->pipe, K_OBJ_PIPE));
 			break;
+#endif
+#ifdef CONFIG_PKTQ
+		case K_POLL_TYPE_PKTQ_DATA_AVAILABLE:
+			Z_OOPS(Z_SYSCALL_OBJ(e->pktq, K_OBJ_PKTQ));
+			break;
 #endif
 		default:
 			ret = -EINVAL;
@@ -451,6 +486,8 @@ static int signal_poll_event(struct k_poll_event *event, uint32_t state)
 			retcode = signal_poller(event, state);
 		} else if (poller->mode == MODE_TRIGGERED) {
 			retcode = signal_triggered_work(event, state);
+		} else if (poller->mode == MODE_SET) {
+			retcode = signal_poll_set(event, state);
 		} else {
 			/* Poller is not poll or triggered mode. No action needed.*/
 			;
@@ -813,3 +850,124 @@ int k_work_poll_cancel(struct k_work_poll *work)
 
 	return retval;
 }
+
+static int signal_poll_set(struct k_poll_event *event, uint32_t state)
+{
+	struct k_poll_set *set =
+		CONTAINER_OF(event->poller, struct k_poll_set, poller);
+	struct k_thread *thread;
+
+	ARG_UNUSED(state);
+
+	/* The object already unlinked the event from its list */
+	sys_dlist_append(&set->ready, &event->_node);
+
+	thread = z_unpend_first_thread(&set->wait_q);
+	if (thread != NULL) {
+		arch_thread_return_value_set(thread, 0);
+		z_ready_thread(thread);
+	}
+
+	return 0;
+}
+
+/* must be called with interrupts locked */
+static void poll_set_arm(struct k_poll_set *set, struct k_poll_event *event)
+{
+	uint32_t state;
+
+	event->state = K_POLL_STATE_NOT_READY;
+
+	if (is_condition_met(event, &state)) {
+		set_event_ready(event, state);
+		sys_dlist_append(&set->ready, &event->_node);
+	} else {
+		register_event(event, &set->poller);
+	}
+}
+
+void k_poll_set_init(struct k_poll_set *set, struct k_poll_event *events,
+		     int num_events)
+{
+	__ASSERT(events != NULL, "NULL events\n");
+	__ASSERT(num_events >= 0, "<0 events\n");
+
+	set->poller.is_polling = true;
+	set->poller.mode = MODE_SET;
+	z_waitq_init(&set->wait_q);
+	set->events = events;
+	set->num_events = num_events;
+	sys_dlist_init(&set->ready);
+	sys_dlist_init(&set->returned);
+
+	for (int ii = 0; ii < num_events; ii++) {
+		k_spinlock_key_t key = k_spin_lock(&lock);
+
+		poll_set_arm(set, &events[ii]);
+		k_spin_unlock(&lock, key);
+	}
+}
+
+int k_poll_set_wait(struct k_poll_set *set, struct k_poll_event **ready,
+		    int max_ready, k_timeout_t timeout)
+{
+	k_timepoint_t end = sys_timepoint_calc(timeout);
+	k_spinlock_key_t key;
+	sys_dnode_t *node;
+	int num_ready = 0;
+
+	__ASSERT(!arch_is_in_isr(), "");
+	__ASSERT(ready != NULL, "NULL ready\n");
+	__ASSERT(max_ready > 0, "no room for ready events\n");
+
+	key = k_spin_lock(&lock);
+
+	/* Watch the events handed out by the previous wait again */
+	while ((node = sys_dlist_get(&set->returned)) != NULL) {
+		poll_set_arm(set,
+			     CONTAINER_OF(node, struct k_poll_event, _node));
+		k_spin_unlock(&lock, key);
+		key = k_spin_lock(&lock);
+	}
+
+	while (sys_dlist_is_empty(&set->ready)) {
+		k_timeout_t remaining = sys_timepoint_timeout(end);
+
+		if (K_TIMEOUT_EQ(remaining, K_NO_WAIT)) {
+			k_spin_unlock(&lock, key);
+			return -EAGAIN;
+		}
+
+		/* Another waiter may have taken the events we were
+		 * woken up for, so check again.
+		 */
+		(void)z_pend_curr(&lock, key, &set->wait_q, remaining);
+		key = k_spin_lock(&lock);
+	}
+
+	while ((num_ready < max_ready) &&
+	       ((node = sys_dlist_get(&set->ready)) != NULL)) {
+		ready[num_ready++] = CONTAINER_OF(node, struct k_poll_event,
+						  _node);
+		sys_dlist_append(&set->returned, node);
+	}
+
+	k_spin_unlock(&lock, key);
+
+	return num_ready;
+}
+
+void k_poll_set_cleanup(struct k_poll_set *set)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	/* Events triggering from now on are left alone */
+	set->poller.mode = MODE_NONE;
+
+	/* Unlinks the events from their objects, or from our lists */
+	clear_event_registrations(set->events, set->num_events, key);
+	sys_dlist_init(&set->ready);
+	sys_dlist_init(&set->returned);
+
+	k_spin_unlock(&lock, key);
+}
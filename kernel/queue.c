@@ -21,6 +21,13 @@
 #include <zephyr/syscall_handler.h>
 #include <kernel_internal.h>
 #include <zephyr/sys/check.h>
+#include <kernel_obj_stats.h>
+
+#ifdef CONFIG_KERNEL_OBJ_STATS_QUEUE
+#define QUEUE_STATS(queue) (&(queue)->stats)
+#else
+#define QUEUE_STATS(queue) NULL
+#endif
 
 struct alloc_node {
 	sys_sfnode_t node;
@@ -63,6 +70,10 @@ void z_impl_k_queue_init(struct k_queue *queue)
 #if defined(CONFIG_POLL)
 	sys_dlist_init(&queue->poll_events);
 #endif
+#ifdef CONFIG_QUEUE_LOCKFREE
+	atomic_ptr_clear(&queue->lockfree_head);
+	atomic_clear(&queue->waiters);
+#endif
 
 	SYS_PORT_TRACING_OBJ_INIT(k_queue, queue);
 
@@ -91,6 +102,93 @@ static inline void handle_poll_events(struct k_queue *queue, uint32_t state)
 #endif
 }
 
+#ifdef CONFIG_QUEUE_LOCKFREE
+/* Lock-free append path.  While no thread waits on the queue,
+ * k_queue_append() pushes items onto lockfree_head with a CAS and never
+ * touches the spinlock.  Everything that takes the lock first moves
+ * those items, in append order, to the tail of data_q.
+ *
+ * A consumer increments waiters before checking for data a last time
+ * and pending, a producer checks waiters after pushing.  So either the
+ * consumer sees the new item, or the producer sees the consumer and
+ * hands the item over under the lock.
+ */
+static bool lockfree_append(struct k_queue *queue, void *data)
+{
+	sys_sfnode_t *node = data;
+	void *head;
+
+	if (atomic_get(&queue->waiters) != 0) {
+		return false;
+	}
+
+	do {
+		head = atomic_ptr_get(&queue->lockfree_head);
+		sys_sfnode_init(node, 0x0);
+		z_sfnode_next_set(node, head);
+	} while (!atomic_ptr_cas(&queue->lockfree_head, head, node));
+
+	return true;
+}
+
+/* Called with the queue lock held */
+static void lockfree_splice(struct k_queue *queue)
+{
+	sys_sfnode_t *node = atomic_ptr_clear(&queue->lockfree_head);
+	sys_sfnode_t *tail = node;
+	sys_sfnode_t *head = NULL;
+
+	if (node == NULL) {
+		return;
+	}
+
+	/* The lock-free list is newest first, reverse it */
+	while (node != NULL) {
+		sys_sfnode_t *next = z_sfnode_next_peek(node);
+
+		z_sfnode_next_set(node, head);
+		head = node;
+		node = next;
+	}
+
+	sys_sflist_append_list(&queue->data_q, head, tail);
+}
+
+/* Called with the queue lock held.  Returns true if a thread was woken. */
+static bool lockfree_flush(struct k_queue *queue)
+{
+	struct k_thread *thread;
+	bool woken = false;
+
+	lockfree_splice(queue);
+
+	while (!sys_sflist_is_empty(&queue->data_q)) {
+		thread = z_unpend_first_thread(&queue->wait_q);
+		if (thread == NULL) {
+			break;
+		}
+
+		prepare_thread_to_run(thread,
+			z_queue_node_peek(sys_sflist_get_not_empty(&queue->data_q),
+					  true));
+		woken = true;
+	}
+
+	return woken;
+}
+
+static void lockfree_sync(struct k_queue *queue)
+{
+	k_spinlock_key_t key = k_spin_lock(&queue->lock);
+
+	if (lockfree_flush(queue)) {
+		z_reschedule(&queue->lock, key);
+	} else {
+		k_spin_unlock(&queue->lock, key);
+	}
+}
+#endif /* CONFIG_QUEUE_LOCKFREE */
+
 void z_impl_k_queue_cancel_wait(struct k_queue *queue)
 {
 	SYS_PORT_TRACING_OBJ_FUNC(k_queue, cancel_wait, queue);
@@ -121,10 +219,29 @@ static int32_t queue_insert(struct k_queue *queue, void *prev, void *data,
 			    bool alloc, bool is_append)
 {
 	struct k_thread *first_pending_thread;
-	k_spinlock_key_t key = k_spin_lock(&queue->lock);
+	k_spinlock_key_t key;
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_queue, queue_insert, queue, alloc);
 
+#ifdef CONFIG_QUEUE_LOCKFREE
+	if (is_append && !alloc && lockfree_append(queue, data)) {
+		/* Raced with a consumer going to sleep, wake it up */
+		if (unlikely(atomic_get(&queue->waiters) != 0)) {
+			lockfree_sync(queue);
+		}
+
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_queue, queue_insert, queue, alloc, 0);
+
+		return 0;
+	}
+#endif
+
+	key = k_spin_lock(&queue->lock);
+
+#ifdef CONFIG_QUEUE_LOCKFREE
+	(void)lockfree_flush(queue);
+#endif
+
 	if (is_append) {
 		prev = sys_sflist_peek_tail(&queue->data_q);
 	}
@@ -255,6 +372,10 @@ int k_queue_append_list(struct k_queue *queue, void *head, void *tail)
 	k_spinlock_key_t key = k_spin_lock(&queue->lock);
 	struct k_thread *thread = NULL;
 
+#ifdef CONFIG_QUEUE_LOCKFREE
+	(void)lockfree_flush(queue);
+#endif
+
 	if (head != NULL) {
 		thread = z_unpend_first_thread(&queue->wait_q);
 	}
@@ -318,6 +439,10 @@ void *z_impl_k_queue_get(struct k_queue *queue, k_timeout_t timeout)
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_queue, get, queue, timeout);
 
+#ifdef CONFIG_QUEUE_LOCKFREE
+	lockfree_splice(queue);
+#endif
+
 	if (likely(!sys_sflist_is_empty(&queue->data_q))) {
 		sys_sfnode_t *node;
 
@@ -332,6 +457,8 @@ void *z_impl_k_queue_get(struct k_queue *queue, k_timeout_t timeout)
 
 	SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_queue, get, queue, timeout);
 
+	z_obj_stats_contended(QUEUE_STATS(queue));
+
 	if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
 		k_spin_unlock(&queue->lock, key);
 
@@ -340,8 +467,33 @@ void *z_impl_k_queue_get(struct k_queue *queue, k_timeout_t timeout)
 		return NULL;
 	}
 
+#ifdef CONFIG_QUEUE_LOCKFREE
+	/* Producers see this before deciding to skip the lock, anything
+	 * pushed before it must be picked up here.
+	 */
+	atomic_inc(&queue->waiters);
+	lockfree_splice(queue);
+	if (!sys_sflist_is_empty(&queue->data_q)) {
+		atomic_dec(&queue->waiters);
+		data = z_queue_node_peek(sys_sflist_get_not_empty(&queue->data_q),
+					 true);
+		k_spin_unlock(&queue->lock, key);
+
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_queue, get, queue, timeout, data);
+
+		return data;
+	}
+#endif
+
+	uint64_t pend_start = z_obj_stats_pend_start(QUEUE_STATS(queue));
 	int ret = z_pend_curr(&queue->lock, key, &queue->wait_q, timeout);
 
+	z_obj_stats_pend_end(QUEUE_STATS(queue), pend_start);
+
+#ifdef CONFIG_QUEUE_LOCKFREE
+	atomic_dec(&queue->waiters);
+#endif
+
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_queue, get, queue, timeout,
 		(ret != 0) ? NULL : _current->base.swap_data);
 
@@ -352,6 +504,10 @@ bool k_queue_remove(struct k_queue *queue, void *data)
 {
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_queue, remove, queue);
 
+#ifdef CONFIG_QUEUE_LOCKFREE
+	lockfree_sync(queue);
+#endif
+
 	bool ret = sys_sflist_find_and_remove(&queue->data_q, (sys_sfnode_t *)data);
 
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_queue, remove, queue, ret);
@@ -365,6 +521,10 @@ bool k_queue_unique_append(struct k_queue *queue, void *data)
 
 	sys_sfnode_t *test;
 
+#ifdef CONFIG_QUEUE_LOCKFREE
+	lockfree_sync(queue);
+#endif
+
 	SYS_SFLIST_FOR_EACH_NODE(&queue->data_q, test) {
 		if (test == (sys_sfnode_t *) data) {
 			SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_queue, unique_append, queue, false);
@@ -382,6 +542,10 @@ bool k_queue_unique_append(struct k_queue *queue, void *data)
 
 void *z_impl_k_queue_peek_head(struct k_queue *queue)
 {
+#ifdef CONFIG_QUEUE_LOCKFREE
+	lockfree_sync(queue);
+#endif
+
 	void *ret = z_queue_node_peek(sys_sflist_peek_head(&queue->data_q), false);
 
 	SYS_PORT_TRACING_OBJ_FUNC(k_queue, peek_head, queue, ret);
@@ -391,6 +555,10 @@ void *z_impl_k_queue_peek_head(struct k_queue *queue)
 
 void *z_impl_k_queue_peek_tail(struct k_queue *queue)
 {
+#ifdef CONFIG_QUEUE_LOCKFREE
+	lockfree_sync(queue);
+#endif
+
 	void *ret = z_queue_node_peek(sys_sflist_peek_tail(&queue->data_q), false);
 
 	SYS_PORT_TRACING_OBJ_FUNC(k_queue, peek_tail, queue, ret);
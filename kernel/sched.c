@@ -213,6 +213,12 @@ static ALWAYS_INLINE void *thread_runq(struct k_thread *thread)
 	cpu = m == 0 ? 0 : u32_count_trailing_zeros(m);
 
 	return &_kernel.cpus[cpu].ready_q.runq;
+#elif defined(CONFIG_SCHED_CPU_RUNQ)
+	/* Only ever updated when the thread is switched in (or placed
+	 * by runq_add()), so this can't change while it sits in the
+	 * queue.
+	 */
+	return &_kernel.cpus[thread->base.cpu].ready_q.runq;
 #else
 	return &_kernel.ready_q.runq;
 #endif
@@ -220,26 +226,108 @@ static ALWAYS_INLINE void *thread_runq(struct k_thread *thread)
 
 static ALWAYS_INLINE void *curr_cpu_runq(void)
 {
-#ifdef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#ifdef CONFIG_SCHED_CPU_READY_Q
 	return &arch_curr_cpu()->ready_q.runq;
 #else
 	return &_kernel.ready_q.runq;
 #endif
 }
 
+#ifdef CONFIG_SCHED_CPU_RUNQ
+/* Picks the ready queue of a thread that never ran: the least loaded
+ * CPU it may run on, where a CPU busy with a thread other than its
+ * idle thread counts one more.  Ties go to the current CPU.
+ */
+static ALWAYS_INLINE uint8_t runq_place(struct k_thread *thread)
+{
+	unsigned int num_cpus = arch_num_cpus();
+	uint8_t id = _current_cpu->id, best = id;
+	uint32_t best_load = UINT32_MAX;
+
+	for (unsigned int n = 0; n < num_cpus; n++, id = (id + 1) % num_cpus) {
+		struct k_thread *curr = _kernel.cpus[id].current;
+		uint32_t load;
+
+#ifdef CONFIG_SCHED_CPU_MASK
+		if ((thread->base.cpu_mask & BIT(id)) == 0) {
+			continue;
+		}
+#endif
+		/* Not started yet */
+		if (curr == NULL) {
+			continue;
+		}
+
+		load = _kernel.cpus[id].ready_q.count +
+		       (z_is_idle_thread_object(curr) ? 0U : 1U);
+		if (load < best_load) {
+			best_load = load;
+			best = id;
+		}
+	}
+
+	return best;
+}
+#endif
+
 static ALWAYS_INLINE void runq_add(struct k_thread *thread)
 {
+#ifdef CONFIG_SCHED_CPU_RUNQ
+	if (thread->base.cpu >= arch_num_cpus()) {
+		thread->base.cpu = runq_place(thread);
+	}
+#endif
 	_priq_run_add(thread_runq(thread), thread);
+#ifdef CONFIG_SCHED_CPU_RUNQ
+	_kernel.cpus[thread->base.cpu].ready_q.count++;
+#endif
 }
 
 static ALWAYS_INLINE void runq_remove(struct k_thread *thread)
 {
 	_priq_run_remove(thread_runq(thread), thread);
+#ifdef CONFIG_SCHED_CPU_RUNQ
+	_kernel.cpus[thread->base.cpu].ready_q.count--;
+#endif
 }
 
 static ALWAYS_INLINE struct k_thread *runq_best(void)
 {
+#ifdef CONFIG_SCHED_CPU_RUNQ
+	struct _ready_q *from = &arch_curr_cpu()->ready_q;
+	struct k_thread *best = _priq_run_best(&from->runq);
+	unsigned int num_cpus = arch_num_cpus();
+
+	/* Steal a peer's best thread if it is more important than
+	 * our own, or as important but waiting in a longer queue.
+	 * An idle CPU thus picks the busiest peer holding a thread of
+	 * the highest priority available.
+	 */
+	for (int i = 0; i < num_cpus; i++) {
+		struct _ready_q *rq = &_kernel.cpus[i].ready_q;
+		struct k_thread *thread;
+		int32_t cmp;
+
+		if ((rq == from) || (rq->count == 0U)) {
+			continue;
+		}
+
+		thread = _priq_run_best(&rq->runq);
+		if (thread == NULL) {
+			continue;
+		}
+
+		cmp = (best == NULL) ? 1 : z_sched_prio_cmp(thread, best);
+		if ((cmp > 0) || ((cmp == 0) && (rq->count > from->count))) {
+			best = thread;
+			from = rq;
+		}
+	}
+
+	return best;
+#else
 	return _priq_run_best(curr_cpu_runq());
+#endif
 }
 
 /* _current is never in the run queue until context switch on
@@ -252,6 +340,12 @@ static inline bool should_queue_thread(struct k_thread *th)
 
 static ALWAYS_INLINE void queue_thread(struct k_thread *thread)
 {
+#ifdef CONFIG_SCHED_THREAD_USAGE_LATENCY
+	/* Every path making a thread runnable again, wakeups and yields
+	 * alike, ends up here
+	 */
+	z_sched_usage_ready(thread);
+#endif
 	thread->base.thread_state |= _THREAD_QUEUED;
 	if (should_queue_thread(thread)) {
 		runq_add(thread);
@@ -272,20 +366,33 @@ static ALWAYS_INLINE void dequeue_thread(struct k_thread *thread)
 	}
 }
 
+#if defined(CONFIG_SMP) && defined(CONFIG_SCHED_IPI_SUPPORTED)
+static void send_ipi(uint32_t cpu_bitmap)
+{
+#ifdef CONFIG_ARCH_HAS_DIRECTED_IPIS
+	arch_sched_directed_ipi(cpu_bitmap);
+#else
+	ARG_UNUSED(cpu_bitmap);
+	arch_sched_ipi();
+#endif
+}
+#endif
+
 static void signal_pending_ipi(void)
 {
 	/* Synchronization note: you might think we need to lock these
 	 * two steps, but an IPI is idempotent.  It's OK if we do it
-	 * twice.  All we require is that if a CPU sees the flag true,
-	 * it is guaranteed to send the IPI, and if a core sets
+	 * twice.  All we require is that if a CPU sees a bit set, it
+	 * is guaranteed to send the IPI, and if a core sets a bit in
 	 * pending_ipi, the IPI will be sent the next time through
 	 * this code.
 	 */
 #if defined(CONFIG_SMP) && defined(CONFIG_SCHED_IPI_SUPPORTED)
 	if (arch_num_cpus() > 1) {
-		if (_kernel.pending_ipi) {
-			_kernel.pending_ipi = false;
-			arch_sched_ipi();
+		uint32_t cpu_bitmap = (uint32_t)atomic_clear(&_kernel.pending_ipi);
+
+		if (cpu_bitmap != 0U) {
+			send_ipi(cpu_bitmap);
 		}
 	}
 #endif
@@ -404,12 +511,55 @@ static void move_thread_to_end_of_prio_q(struct k_thread *thread)
 	update_cache(thread == _current);
 }
 
-static void flag_ipi(void)
+#define IPI_ALL_CPUS BIT_MASK(CONFIG_MP_MAX_NUM_CPUS)
+
+static void flag_ipi(uint32_t cpu_bitmap)
 {
 #if defined(CONFIG_SMP) && defined(CONFIG_SCHED_IPI_SUPPORTED)
 	if (arch_num_cpus() > 1) {
-		_kernel.pending_ipi = true;
+		atomic_or(&_kernel.pending_ipi, (atomic_val_t)cpu_bitmap);
 	}
+#else
+	ARG_UNUSED(cpu_bitmap);
+#endif
+}
+
+/* CPUs that may want to switch to a thread that just became runnable:
+ * those running something it preempts.  Without directed IPIs there
+ * is no point in narrowing this down, all CPUs get interrupted.
+ */
+static uint32_t ipi_mask_create(struct k_thread *thread)
+{
+#if defined(CONFIG_SMP) && defined(CONFIG_ARCH_HAS_DIRECTED_IPIS)
+	uint32_t ipi_mask = 0U;
+	unsigned int num_cpus = arch_num_cpus();
+	unsigned int id = _current_cpu->id;
+
+	for (unsigned int i = 0; i < num_cpus; i++) {
+		struct k_thread *cpu_thread = _kernel.cpus[i].current;
+
+		if ((i == id) || (cpu_thread == NULL)) {
+			continue;
+		}
+
+#ifdef CONFIG_SCHED_CPU_MASK
+		if ((thread->base.cpu_mask & BIT(i)) == 0U) {
+			continue;
+		}
+#endif
+
+		if (is_metairq(thread) ||
+		    ((z_sched_prio_cmp(thread, cpu_thread) > 0) &&
+		     is_preempt(cpu_thread))) {
+			ipi_mask |= BIT(i);
+		}
+	}
+
+	return ipi_mask;
+#else
+	ARG_UNUSED(thread);
+
+	return IPI_ALL_CPUS;
 #endif
 }
 
@@ -463,11 +613,10 @@ static void slice_timeout(struct _timeout *t)
 	slice_expired[cpu] = true;
 
 	/* We need an IPI if we just handled a timeslice expiration
-	 * for a different CPU.  Ideally this would be able to target
-	 * the specific core, but that's not part of the API yet.
+	 * for a different CPU.
 	 */
 	if (IS_ENABLED(CONFIG_SMP) && cpu != _current_cpu->id) {
-		flag_ipi();
+		flag_ipi(BIT(cpu));
 	}
 }
 
@@ -603,6 +752,38 @@ static bool thread_active_elsewhere(struct k_thread *thread)
 	return false;
 }
 
+#ifdef CONFIG_SCHED_CBS
+static inline bool is_cbs(struct k_thread *thread)
+{
+	return thread->base.cbs_period != 0U;
+}
+
+/* Constant bandwidth server wakeup rule: a thread waking up keeps its
+ * deadline only if the budget it has left can be used up by then
+ * without exceeding its bandwidth.  Otherwise it gets a fresh budget
+ * and deadline, so that sleeping does not let it save up CPU time.
+ */
+static void cbs_wakeup(struct k_thread *thread)
+{
+	uint32_t now;
+	int32_t left;
+
+	if (!is_cbs(thread)) {
+		return;
+	}
+
+	now = k_cycle_get_32();
+	left = (int32_t)((uint32_t)thread->base.prio_deadline - now);
+
+	if ((left <= 0) ||
+	    ((int64_t)thread->base.cbs_remaining * thread->base.cbs_period >=
+	     (int64_t)left * thread->base.cbs_budget)) {
+		thread->base.prio_deadline = now + thread->base.cbs_period;
+		thread->base.cbs_remaining = thread->base.cbs_budget;
+	}
+}
+#endif
+
 static void ready_thread(struct k_thread *thread)
 {
 #ifdef CONFIG_KERNEL_COHERENCE
@@ -615,9 +796,12 @@ static void ready_thread(struct k_thread *thread)
 	if (!z_is_thread_queued(thread) && z_is_thread_ready(thread)) {
 		SYS_PORT_TRACING_OBJ_FUNC(k_thread, sched_ready, thread);
 
+#ifdef CONFIG_SCHED_CBS
+		cbs_wakeup(thread);
+#endif
 		queue_thread(thread);
 		update_cache(0);
-		flag_ipi();
+		flag_ipi(ipi_mask_create(thread));
 	}
 }
 
@@ -940,7 +1124,10 @@ void z_thread_priority_set(struct k_thread *thread, int prio)
 {
 	bool need_sched = z_set_prio(thread, prio);
 
-	flag_ipi();
+	/* The thread may be running elsewhere and just have lost its
+	 * claim to that CPU, so this can't be narrowed down.
+	 */
+	flag_ipi(IPI_ALL_CPUS);
 
 	if (need_sched && _current->base.sched_locked == 0U) {
 		z_reschedule_unlocked();
@@ -1228,17 +1415,34 @@ struct k_thread *z_priq_rb_best(struct _priq_rb *pq)
 }
 
 #ifdef CONFIG_SCHED_MULTIQ
-# if (K_LOWEST_THREAD_PRIO - K_HIGHEST_THREAD_PRIO) > 31
-# error Too many priorities for multiqueue scheduler (max 32)
-# endif
-
 static ALWAYS_INLINE void z_priq_mq_add(struct _priq_mq *pq,
 					struct k_thread *thread)
 {
 	int priority_bit = thread->base.prio - K_HIGHEST_THREAD_PRIO;
+	sys_dlist_t *q = &pq->queues[priority_bit];
+	bool inserted = false;
 
-	sys_dlist_append(&pq->queues[priority_bit], &thread->base.qnode_dlist);
-	pq->bitmask |= BIT(priority_bit);
+#ifdef CONFIG_SCHED_DEADLINE
+	struct k_thread *t;
+
+	/* All threads in the list share a priority, so this only
+	 * orders by deadline
+	 */
+	SYS_DLIST_FOR_EACH_CONTAINER(q, t, base.qnode_dlist) {
+		if (z_sched_prio_cmp(thread, t) > 0) {
+			sys_dlist_insert(&t->base.qnode_dlist,
+					 &thread->base.qnode_dlist);
+			inserted = true;
+			break;
+		}
+	}
+#endif
+
+	if (!inserted) {
+		sys_dlist_append(q, &thread->base.qnode_dlist);
+	}
+
+	pq->bitmask[priority_bit / 32] |= BIT(priority_bit % 32);
 }
 
 static ALWAYS_INLINE void z_priq_mq_remove(struct _priq_mq *pq,
@@ -1248,24 +1452,29 @@ static ALWAYS_INLINE void z_priq_mq_remove(struct _priq_mq *pq,
 
 	sys_dlist_remove(&thread->base.qnode_dlist);
 	if (sys_dlist_is_empty(&pq->queues[priority_bit])) {
-		pq->bitmask &= ~BIT(priority_bit);
+		pq->bitmask[priority_bit / 32] &= ~BIT(priority_bit % 32);
 	}
 }
 #endif
 
 struct k_thread *z_priq_mq_best(struct _priq_mq *pq)
 {
-	if (!pq->bitmask) {
-		return NULL;
-	}
-
 	struct k_thread *thread = NULL;
-	sys_dlist_t *l = &pq->queues[__builtin_ctz(pq->bitmask)];
-	sys_dnode_t *n = sys_dlist_peek_head(l);
 
-	if (n != NULL) {
-		thread = CONTAINER_OF(n, struct k_thread, base.qnode_dlist);
+	for (int i = 0; i < ARRAY_SIZE(pq->bitmask); i++) {
+		if (pq->bitmask[i] == 0U) {
+			continue;
+		}
+
+		sys_dlist_t *l = &pq->queues[i * 32 + __builtin_ctz(pq->bitmask[i])];
+		sys_dnode_t *n = sys_dlist_peek_head(l);
+
+		if (n != NULL) {
+			thread = CONTAINER_OF(n, struct k_thread, base.qnode_dlist);
+		}
+		break;
 	}
+
 	return thread;
 }
 
@@ -1292,7 +1501,7 @@ void init_ready_q(struct _ready_q *rq)
 		}
 	};
 #elif defined(CONFIG_SCHED_MULTIQ)
-	for (int i = 0; i < ARRAY_SIZE(_kernel.ready_q.runq.queues); i++) {
+	for (int i = 0; i < ARRAY_SIZE(rq->runq.queues); i++) {
 		sys_dlist_init(&rq->runq.queues[i]);
 	}
 #else
@@ -1302,7 +1511,7 @@ void init_ready_q(struct _ready_q *rq)
 
 void z_sched_init(void)
 {
-#ifdef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#ifdef CONFIG_SCHED_CPU_READY_Q
 	for (int i = 0; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
 		init_ready_q(&_kernel.cpus[i].ready_q);
 	}
@@ -1382,7 +1591,238 @@ static inline void z_vrfy_k_thread_deadline_set(k_tid_t tid, int deadline)
 }
 #include <syscalls/k_thread_deadline_set_mrsh.c>
 #endif
+
+#ifdef CONFIG_SCHED_CBS
+
+/* Admission control limit, and bandwidth reserved by all servers, in
+ * millionths of a CPU
+ */
+#define CBS_MAX_UTILIZATION (CONFIG_SCHED_CBS_MAX_UTILIZATION * 10000U)
+
+static uint32_t cbs_utilization;
+
+/* Budget enforcement of the server running on each CPU */
+static struct _timeout cbs_timeouts[CONFIG_MP_MAX_NUM_CPUS];
+static struct k_thread *cbs_current[CONFIG_MP_MAX_NUM_CPUS];
+static bool cbs_expired[CONFIG_MP_MAX_NUM_CPUS];
+
+static inline uint32_t cbs_bandwidth(uint32_t budget, uint32_t period)
+{
+	return (period == 0U) ? 0U :
+		(uint32_t)(((uint64_t)budget * 1000000U) / period);
+}
+
+static void cbs_budget_timeout(struct _timeout *t);
+
+static void cbs_arm(int cpu, struct k_thread *thread)
+{
+	uint32_t left = (uint32_t)MAX(thread->base.cbs_remaining, 0);
+
+	cbs_expired[cpu] = false;
+	z_add_timeout(&cbs_timeouts[cpu], cbs_budget_timeout,
+		      K_TICKS(k_cyc_to_ticks_ceil32(left)));
+}
+
+void z_sched_cbs_switch(struct k_thread *thread)
+{
+	int cpu = _current_cpu->id;
+	struct k_thread *prev = cbs_current[cpu];
+	uint32_t now;
+
+	if (thread == prev) {
+		return;
+	}
+
+	cbs_current[cpu] = thread;
+	if (!z_is_inactive_timeout(&cbs_timeouts[cpu])) {
+		z_abort_timeout(&cbs_timeouts[cpu]);
+	}
+	cbs_expired[cpu] = false;
+
+	if (((prev == NULL) || !is_cbs(prev)) && !is_cbs(thread)) {
+		return;
+	}
+
+	now = k_cycle_get_32();
+
+	if ((prev != NULL) && is_cbs(prev)) {
+		prev->base.cbs_remaining -= (int32_t)(now - prev->base.cbs_start);
+	}
+
+	if (is_cbs(thread)) {
+		thread->base.cbs_start = now;
+		cbs_arm(cpu, thread);
+	}
+}
+
+static void cbs_replenish(struct _timeout *t)
+{
+	struct k_thread *thread = CONTAINER_OF(t, struct k_thread,
+					       base.cbs_replenish);
+
+	K_SPINLOCK(&sched_spinlock) {
+		thread->base.thread_state &= ~_THREAD_THROTTLED;
+		thread->base.cbs_remaining = thread->base.cbs_budget;
+		thread->base.prio_deadline += thread->base.cbs_period;
+		ready_thread(thread);
+	}
+}
+
+/* Called with the scheduler lock held once the budget timeout of the
+ * current CPU expired.
+ */
+static void cbs_throttle(void)
+{
+	int cpu = _current_cpu->id;
+	struct k_thread *thread = cbs_current[cpu];
+	uint32_t now = k_cycle_get_32();
+	int32_t until;
+
+	cbs_expired[cpu] = false;
+	if ((thread != _current) || !is_cbs(thread) ||
+	    ((thread->base.thread_state & _THREAD_THROTTLED) != 0U)) {
+		return;
+	}
+
+	thread->base.cbs_remaining -= (int32_t)(now - thread->base.cbs_start);
+	thread->base.cbs_start = now;
+
+	if (thread->base.cbs_remaining > 0) {
+		/* Expired early, the budget was rounded to ticks */
+		cbs_arm(cpu, thread);
+		return;
+	}
+
+	/* Out of budget: off the CPU until the current deadline, where
+	 * the next period starts.
+	 */
+	thread->base.thread_state |= _THREAD_THROTTLED;
+	if (z_is_thread_queued(thread)) {
+		dequeue_thread(thread);
+	}
+
+	until = (int32_t)((uint32_t)thread->base.prio_deadline - now);
+	until = MAX(until, 0);
+	z_add_timeout(&thread->base.cbs_replenish, cbs_replenish,
+		      K_TICKS(k_cyc_to_ticks_ceil32(until)));
+	update_cache(1);
+}
+
+static void cbs_budget_timeout(struct _timeout *t)
+{
+	int cpu = ARRAY_INDEX(cbs_timeouts, t);
+
+	/* The thread can only be taken off another CPU from there */
+	if (IS_ENABLED(CONFIG_SMP) && cpu != _current_cpu->id) {
+		cbs_expired[cpu] = true;
+		flag_ipi(BIT(cpu));
+		return;
+	}
+
+	K_SPINLOCK(&sched_spinlock) {
+		cbs_throttle();
+	}
+}
+
+/* Called out of each timer interrupt and IPI, for budgets that ran out
+ * while another CPU was processing the timeouts.
+ */
+void z_sched_cbs_tick(void)
+{
+	if (cbs_expired[_current_cpu->id]) {
+		K_SPINLOCK(&sched_spinlock) {
+			cbs_throttle();
+		}
+	}
+}
+
+/* Called with the scheduler lock held when a thread is gone */
+static void cbs_release(struct k_thread *thread)
+{
+	if (is_cbs(thread)) {
+		cbs_utilization -= cbs_bandwidth(thread->base.cbs_budget,
+						 thread->base.cbs_period);
+		thread->base.cbs_period = 0U;
+		thread->base.cbs_budget = 0U;
+	}
+	thread->base.thread_state &= ~_THREAD_THROTTLED;
+	z_abort_timeout(&thread->base.cbs_replenish);
+}
+
+int z_impl_k_thread_cbs_set(k_tid_t tid, uint32_t budget_us,
+			    uint32_t period_us)
+{
+	struct k_thread *thread = tid;
+	uint64_t budget = 0U;
+	uint64_t period = 0U;
+	uint32_t bandwidth;
+	uint32_t reserved;
+	bool throttled;
+	int ret = 0;
+
+	if (budget_us != 0U) {
+		if (budget_us > period_us) {
+			return -EINVAL;
+		}
+		period = k_us_to_cyc_floor64(period_us);
+		budget = MIN(k_us_to_cyc_ceil64(budget_us), period);
+		if ((period == 0U) || (period > INT32_MAX)) {
+			return -EINVAL;
+		}
+	}
+
+	bandwidth = cbs_bandwidth(budget, period);
+
+	K_SPINLOCK(&sched_spinlock) {
+		reserved = cbs_utilization -
+			cbs_bandwidth(thread->base.cbs_budget,
+				      thread->base.cbs_period);
+		if ((uint64_t)reserved + bandwidth >
+		    (uint64_t)CBS_MAX_UTILIZATION * arch_num_cpus()) {
+			ret = -ENOSPC;
+			K_SPINLOCK_BREAK;
+		}
+
+		throttled = (thread->base.thread_state & _THREAD_THROTTLED) != 0U;
+		cbs_release(thread);
+
+		cbs_utilization = reserved + bandwidth;
+		thread->base.cbs_budget = budget;
+		thread->base.cbs_period = period;
+		thread->base.cbs_remaining = budget;
+		if (period != 0U) {
+			thread->base.prio_deadline = k_cycle_get_32() + period;
+		}
+
+		if (z_is_thread_queued(thread)) {
+			dequeue_thread(thread);
+			queue_thread(thread);
+		} else if (throttled) {
+			ready_thread(thread);
+		}
+
+		/* Start the new budget right away if running here */
+		if (thread == _current) {
+			cbs_current[_current_cpu->id] = NULL;
+			z_sched_cbs_switch(thread);
+		}
+	}
+
+	return ret;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_thread_cbs_set(k_tid_t tid, uint32_t budget_us,
+					  uint32_t period_us)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(tid, K_OBJ_THREAD));
+
+	return z_impl_k_thread_cbs_set(tid, budget_us, period_us);
+}
+#include <syscalls/k_thread_cbs_set_mrsh.c>
 #endif
+#endif /* CONFIG_SCHED_CBS */
+#endif /* CONFIG_SCHED_DEADLINE */
 
 bool k_can_yield(void)
 {
@@ -1533,9 +1973,9 @@ void z_impl_k_wakeup(k_tid_t thread)
 	}
 
 	z_mark_thread_as_not_suspended(thread);
-	z_ready_thread(thread);
 
-	flag_ipi();
+	/* Flags the IPIs, with the mask built under the scheduler lock */
+	z_ready_thread(thread);
 
 	if (!arch_is_in_isr()) {
 		z_reschedule_unlocked();
@@ -1561,6 +2001,10 @@ void z_sched_ipi(void)
 		z_time_slice();
 	}
 #endif
+
+#ifdef CONFIG_SCHED_CBS
+	z_sched_cbs_tick();
+#endif
 }
 #endif
 
@@ -1711,6 +2155,9 @@ static void end_thread(struct k_thread *thread)
 			unpend_thread_no_timeout(thread);
 		}
 		(void)z_abort_thread_timeout(thread);
+#ifdef CONFIG_SCHED_CBS
+		cbs_release(thread);
+#endif
 		unpend_all(&thread->join_queue);
 		update_cache(1);
 
@@ -1767,7 +2214,7 @@ void z_thread_abort(struct k_thread *thread)
 		 * here, not deferred!
 		 */
 #ifdef CONFIG_SCHED_IPI_SUPPORTED
-		arch_sched_ipi();
+		send_ipi(BIT(thread->base.cpu));
 #endif
 	}
 
@@ -1922,6 +2369,32 @@ bool z_sched_wake(_wait_q_t *wait_q, int swap_retval, void *swap_data)
 	return ret;
 }
 
+unsigned int z_sched_wake_n(_wait_q_t *wait_q, unsigned int n,
+			    int swap_retval, void *swap_data)
+{
+	struct k_thread *thread;
+	unsigned int woken = 0U;
+
+	K_SPINLOCK(&sched_spinlock) {
+		while (woken < n) {
+			thread = _priq_wait_best(&wait_q->waitq);
+			if (thread == NULL) {
+				break;
+			}
+
+			z_thread_return_value_set_with_data(thread,
+							    swap_retval,
+							    swap_data);
+			unpend_thread_no_timeout(thread);
+			(void)z_abort_thread_timeout(thread);
+			ready_thread(thread);
+			woken++;
+		}
+	}
+
+	return woken;
+}
+
 int z_sched_wait(struct k_spinlock *lock, k_spinlock_key_t key,
 		 _wait_q_t *wait_q, k_timeout_t timeout, void **data)
 {
@@ -24,6 +24,7 @@
 #include <zephyr/wait_q.h>
 #include <zephyr/sys/dlist.h>
 #include <ksched.h>
+#include <kernel_obj_stats.h>
 #include <zephyr/init.h>
 #include <zephyr/syscall_handler.h>
 #include <zephyr/tracing/tracing.h>
@@ -121,8 +122,49 @@ static inline void z_vrfy_k_sem_give(struct k_sem *sem)
 #include <syscalls/k_sem_give_mrsh.c>
 #endif
 
+void z_impl_k_sem_give_n(struct k_sem *sem, unsigned int n)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	unsigned int woken;
+	bool resched;
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_sem, give, sem);
+
+	woken = z_sched_wake_n(&sem->wait_q, n, 0, NULL);
+	resched = (woken != 0U);
+
+	if (woken < n) {
+		sem->count += MIN(n - woken, sem->limit - sem->count);
+		resched = handle_poll_events(sem) || resched;
+	}
+
+	if (resched) {
+		z_reschedule(&lock, key);
+	} else {
+		k_spin_unlock(&lock, key);
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_sem, give, sem);
+}
+
+#ifdef CONFIG_USERSPACE
+static inline void z_vrfy_k_sem_give_n(struct k_sem *sem, unsigned int n)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(sem, K_OBJ_SEM));
+	z_impl_k_sem_give_n(sem, n);
+}
+#include <syscalls/k_sem_give_n_mrsh.c>
+#endif
+
+#ifdef CONFIG_KERNEL_OBJ_STATS_SEM
+#define SEM_STATS(sem) (&(sem)->stats)
+#else
+#define SEM_STATS(sem) NULL
+#endif
+
 int z_impl_k_sem_take(struct k_sem *sem, k_timeout_t timeout)
 {
+	uint64_t pend_start;
 	int ret = 0;
 
 	__ASSERT(((arch_is_in_isr() == false) ||
@@ -139,6 +181,8 @@ int z_impl_k_sem_take(struct k_sem *sem, k_timeout_t timeout)
 		goto out;
 	}
 
+	z_obj_stats_contended(SEM_STATS(sem));
+
 	if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
 		k_spin_unlock(&lock, key);
 		ret = -EBUSY;
@@ -147,7 +191,9 @@ int z_impl_k_sem_take(struct k_sem *sem, k_timeout_t timeout)
 
 	SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_sem, take, sem, timeout);
 
+	pend_start = z_obj_stats_pend_start(SEM_STATS(sem));
 	ret = z_pend_curr(&lock, key, &sem->wait_q, timeout);
+	z_obj_stats_pend_end(SEM_STATS(sem), pend_start);
 
 out:
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_sem, take, sem, timeout, ret);
@@ -157,17 +203,9 @@ out:
 
 void z_impl_k_sem_reset(struct k_sem *sem)
 {
-	struct k_thread *thread;
 	k_spinlock_key_t key = k_spin_lock(&lock);
 
-	while (true) {
-		thread = z_unpend_first_thread(&sem->wait_q);
-		if (thread == NULL) {
-			break;
-		}
-		arch_thread_return_value_set(thread, -EAGAIN);
-		z_ready_thread(thread);
-	}
+	(void)z_sched_wake_all(&sem->wait_q, -EAGAIN, NULL);
 	sem->count = 0;
 
 	SYS_PORT_TRACING_OBJ_FUNC(k_sem, reset, sem);
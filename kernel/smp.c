@@ -47,6 +47,92 @@ void z_smp_release_global_lock(struct k_thread *thread)
 	}
 }
 
+#ifdef CONFIG_SPINLOCK_MCS
+/* MCS queue nodes of each CPU, one per lock being held or waited for.
+ * Interrupts are masked while any spinlock is held, so this only needs
+ * to cover locks nested within each other.
+ */
+#define MCS_NODES_PER_CPU 8
+
+static struct z_spin_mcs_node mcs_nodes[CONFIG_MP_MAX_NUM_CPUS][MCS_NODES_PER_CPU];
+
+static struct z_spin_mcs_node *mcs_node_get(void)
+{
+	struct z_spin_mcs_node *nodes = mcs_nodes[arch_curr_cpu()->id];
+
+	for (int i = 0; i < MCS_NODES_PER_CPU; i++) {
+		if (!nodes[i].used) {
+			nodes[i].used = true;
+			atomic_ptr_clear(&nodes[i].next);
+			atomic_set(&nodes[i].wait, 1);
+			return &nodes[i];
+		}
+	}
+
+	__ASSERT(false, "Spinlocks nested too deep");
+	k_panic();
+	CODE_UNREACHABLE;
+}
+
+bool z_spin_mcs_trylock(struct k_spinlock *l)
+{
+	struct z_spin_mcs_node *node = mcs_node_get();
+
+	if (!atomic_ptr_cas(&l->tail, NULL, node)) {
+		node->used = false;
+		return false;
+	}
+
+	l->holder = node;
+
+	return true;
+}
+
+void z_spin_mcs_lock(struct k_spinlock *l, struct z_spin_wait *w)
+{
+	struct z_spin_mcs_node *node = mcs_node_get();
+	struct z_spin_mcs_node *prev;
+
+	/* Queue up behind the last waiter, and spin on our own node
+	 * (thus on our own cache line) until it hands the lock over.
+	 */
+	prev = atomic_ptr_set(&l->tail, node);
+	if (prev != NULL) {
+		(void)atomic_ptr_set(&prev->next, node);
+		while (atomic_get(&node->wait) != 0) {
+			z_spin_wait_tick(w);
+			arch_spin_relax();
+		}
+	}
+
+	l->holder = node;
+}
+
+void z_spin_mcs_unlock(struct k_spinlock *l)
+{
+	struct z_spin_mcs_node *node = l->holder;
+	struct z_spin_mcs_node *next = atomic_ptr_get(&node->next);
+
+	if (next == NULL) {
+		if (atomic_ptr_cas(&l->tail, node, NULL)) {
+			node->used = false;
+			return;
+		}
+
+		/* A waiter swapped itself in as the tail, but has not
+		 * linked itself behind us yet.
+		 */
+		do {
+			arch_spin_relax();
+			next = atomic_ptr_get(&node->next);
+		} while (next == NULL);
+	}
+
+	atomic_clear(&next->wait);
+	node->used = false;
+}
+#endif /* CONFIG_SPINLOCK_MCS */
+
 /* Tiny delay that relaxes bus traffic to avoid spamming a shared
  * memory bus looking at an atomic variable
  */
@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/kernel/syscall_batch.h>
+#include <zephyr/syscall_handler.h>
+#include <errno.h>
+
+static bool op_is_valid(uint8_t op)
+{
+	switch (op) {
+	case K_SYSCALL_BATCH_SEM_GIVE:
+	case K_SYSCALL_BATCH_MSGQ_PUT:
+		return true;
+	case K_SYSCALL_BATCH_POLL_SIGNAL_RAISE:
+		return IS_ENABLED(CONFIG_POLL);
+	default:
+		return false;
+	}
+}
+
+static int entry_run(struct k_syscall_batch_entry *entry)
+{
+	switch (entry->op) {
+	case K_SYSCALL_BATCH_SEM_GIVE:
+		z_impl_k_sem_give(entry->obj);
+		return 0;
+	case K_SYSCALL_BATCH_MSGQ_PUT:
+		return z_impl_k_msgq_put(entry->obj, entry->data, K_NO_WAIT);
+#ifdef CONFIG_POLL
+	case K_SYSCALL_BATCH_POLL_SIGNAL_RAISE:
+		return z_impl_k_poll_signal_raise(entry->obj,
+						  entry->signal_result);
+#endif
+	default:
+		return -EINVAL;
+	}
+}
+
+int z_impl_k_syscall_batch(struct k_syscall_batch_entry *entries,
+			   size_t count)
+{
+	int failed = 0;
+
+	if (count > CONFIG_SYSCALL_BATCH_MAX_ENTRIES) {
+		return -EINVAL;
+	}
+
+	for (size_t i = 0; i < count; i++) {
+		if (!op_is_valid(entries[i].op)) {
+			return -EINVAL;
+		}
+	}
+
+	for (size_t i = 0; i < count; i++) {
+		entries[i].ret = entry_run(&entries[i]);
+		if (entries[i].ret != 0) {
+			failed++;
+		}
+	}
+
+	return failed;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_syscall_batch(struct k_syscall_batch_entry *entries,
+					 size_t count)
+{
+	struct k_syscall_batch_entry copy[CONFIG_SYSCALL_BATCH_MAX_ENTRIES];
+	struct k_msgq *msgq;
+	int ret;
+
+	Z_OOPS(Z_SYSCALL_VERIFY(count <= CONFIG_SYSCALL_BATCH_MAX_ENTRIES));
+	Z_OOPS(z_user_from_copy(copy, entries, count * sizeof(copy[0])));
+
+	/* The copy is verified, then run: the caller can no longer change
+	 * the entries once they are checked.
+	 */
+	for (size_t i = 0; i < count; i++) {
+		switch (copy[i].op) {
+		case K_SYSCALL_BATCH_SEM_GIVE:
+			Z_OOPS(Z_SYSCALL_OBJ(copy[i].obj, K_OBJ_SEM));
+			break;
+		case K_SYSCALL_BATCH_MSGQ_PUT:
+			msgq = copy[i].obj;
+			Z_OOPS(Z_SYSCALL_OBJ(msgq, K_OBJ_MSGQ));
+			Z_OOPS(Z_SYSCALL_MEMORY_READ(copy[i].data,
+						     msgq->msg_size));
+			break;
+#ifdef CONFIG_POLL
+		case K_SYSCALL_BATCH_POLL_SIGNAL_RAISE:
+			Z_OOPS(Z_SYSCALL_OBJ(copy[i].obj, K_OBJ_POLL_SIGNAL));
+			break;
+#endif
+		default:
+			return -EINVAL;
+		}
+	}
+
+	ret = z_impl_k_syscall_batch(copy, count);
+
+	for (size_t i = 0; i < count; i++) {
+		Z_OOPS(z_user_to_copy(&entries[i].ret, &copy[i].ret,
+				      sizeof(copy[i].ret)));
+	}
+
+	return ret;
+}
+#include <syscalls/k_syscall_batch_mrsh.c>
+#endif /* CONFIG_USERSPACE */
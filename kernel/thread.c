@@ -277,8 +277,8 @@ const char *k_thread_state_str(k_tid_t thread_id, char *buf, size_t buf_size)
 	uint8_t     thread_state = thread_id->base.thread_state;
 	static const char  *states_str[8] = {"dummy", "pending", "prestart",
 					     "dead", "suspended", "aborting",
-					     "", "queued"};
-	static const size_t states_sz[8] = {5, 7, 8, 4, 9, 8, 0, 6};
+					     "throttled", "queued"};
+	static const size_t states_sz[8] = {5, 7, 8, 4, 9, 8, 9, 6};
 
 	if ((buf == NULL) || (buf_size == 0)) {
 		return "";
@@ -516,6 +516,9 @@ static char *setup_thread_stack(struct k_thread *new_thread,
 	new_thread->stack_info.start = (uintptr_t)stack_buf_start;
 	new_thread->stack_info.size = stack_buf_size;
 	new_thread->stack_info.delta = delta;
+#ifdef CONFIG_STACK_WATERMARK
+	new_thread->stack_info.unused = stack_buf_size;
+#endif
 #endif
 	stack_ptr -= delta;
 
@@ -545,6 +548,9 @@ char *z_setup_new_thread(struct k_thread *new_thread,
 	z_object_init(stack);
 	new_thread->stack_obj = stack;
 	new_thread->syscall_frame = NULL;
+#ifdef CONFIG_USERSPACE_OBJ_CACHE
+	z_object_cache_init(new_thread);
+#endif
 
 	/* Any given thread has access to itself */
 	k_object_access_grant(new_thread, new_thread);
@@ -628,6 +634,14 @@ char *z_setup_new_thread(struct k_thread *new_thread,
 #endif
 #ifdef CONFIG_SCHED_DEADLINE
 	new_thread->base.prio_deadline = 0;
+#endif
+#ifdef CONFIG_FPU_LAZY_SWITCH_HISTORY
+	new_thread->base.fpu_history = 0;
+#endif
+#ifdef CONFIG_SCHED_CBS
+	new_thread->base.cbs_budget = 0;
+	new_thread->base.cbs_period = 0;
+	z_init_timeout(&new_thread->base.cbs_replenish);
 #endif
 	new_thread->resource_pool = _current->resource_pool;
 
@@ -809,6 +823,11 @@ void z_init_thread_base(struct _thread_base *thread_base, int priority,
 	thread_base->is_idle = 0;
 #endif
 
+#ifdef CONFIG_SCHED_CPU_RUNQ
+	/* Never ran on any CPU, runq_add() picks its ready queue */
+	thread_base->cpu = CONFIG_MP_MAX_NUM_CPUS;
+#endif
+
 #ifdef CONFIG_TIMESLICE_PER_THREAD
 	thread_base->slice_ticks = 0;
 	thread_base->slice_expired = NULL;
@@ -940,10 +959,11 @@ void irq_offload(irq_offload_routine_t routine, const void *parameter)
 #error "Unsupported configuration for stack analysis"
 #endif
 
-int z_stack_space_get(const uint8_t *stack_start, size_t size, size_t *unused_ptr)
+/* Adjusts the bounds of a stack buffer to the part holding the fill
+ * pattern, if it can be inspected at all
+ */
+static int stack_inspect_bounds(const uint8_t **stack_start, size_t *size)
 {
-	size_t unused = 0;
-	const uint8_t *checked_stack = stack_start;
 	/* Take the address of any local variable as a shallow bound for the
 	 * stack pointer.  Addresses above it are guaranteed to be
 	 * accessible.
@@ -957,7 +977,7 @@ int z_stack_space_get(const uint8_t *stack_start, size_t size, size_t *unused_pt
 	 * This never happens when invoked from user mode, as user mode
 	 * will always run this function on the privilege elevation stack.
 	 */
-	if ((stack_pointer > stack_start) && (stack_pointer <= (stack_start + size)) &&
+	if ((stack_pointer > *stack_start) && (stack_pointer <= (*stack_start + *size)) &&
 	    IS_ENABLED(CONFIG_NO_UNUSED_STACK_INSPECTION)) {
 		/* TODO: We could add an arch_ API call to temporarily
 		 * disable the stack checking in the CPU, but this would
@@ -974,12 +994,25 @@ int z_stack_space_get(const uint8_t *stack_start, size_t size, size_t *unused_pt
 		 * FIXME: thread->stack_info.start ought to reflect
 		 * this!
 		 */
-		checked_stack += 4;
-		size -= 4;
+		*stack_start += 4;
+		*size -= 4;
+	}
+
+	return 0;
+}
+
+int z_stack_space_get(const uint8_t *stack_start, size_t size, size_t *unused_ptr)
+{
+	size_t unused = 0;
+	int ret;
+
+	ret = stack_inspect_bounds(&stack_start, &size);
+	if (ret != 0) {
+		return ret;
 	}
 
 	for (size_t i = 0; i < size; i++) {
-		if ((checked_stack[i]) == 0xaaU) {
+		if ((stack_start[i]) == 0xaaU) {
 			unused++;
 		} else {
 			break;
@@ -991,6 +1024,50 @@ int z_stack_space_get(const uint8_t *stack_start, size_t size, size_t *unused_pt
 	return 0;
 }
 
+#ifdef CONFIG_STACK_WATERMARK
+int z_stack_watermark_get(const uint8_t *stack_start, size_t size, size_t *unused_ptr)
+{
+	size_t unused, clean = 0, step = 1;
+	size_t i;
+	int ret;
+
+	ret = stack_inspect_bounds(&stack_start, &size);
+	if (ret != 0) {
+		return ret;
+	}
+
+	/* Stack usage only grows: everything below the previous boundary
+	 * held the pattern, and anything overwritten since then lies
+	 * between it and the new boundary.
+	 */
+	unused = MIN(*unused_ptr, size);
+
+	/* Skip the bulk of the newly used part by probing down with
+	 * doubling steps, as long as the probed bytes are overwritten
+	 */
+	while ((unused > step) && (stack_start[unused - step] != 0xaaU)) {
+		unused -= step;
+		step *= 2U;
+	}
+
+	/* Then walk down until a large enough run of pattern bytes, the
+	 * gaps left in stack frames are shorter than that
+	 */
+	for (i = unused; (i > 0) && (clean < CONFIG_STACK_WATERMARK_GAP); i--) {
+		if (stack_start[i - 1] == 0xaaU) {
+			clean++;
+		} else {
+			unused = i - 1;
+			clean = 0;
+		}
+	}
+
+	*unused_ptr = unused;
+
+	return 0;
+}
+#endif /* CONFIG_STACK_WATERMARK */
+
 int z_impl_k_thread_stack_space_get(const struct k_thread *thread,
 				    size_t *unused_ptr)
 {
@@ -1024,6 +1101,58 @@ int z_vrfy_k_thread_stack_space_get(const struct k_thread *thread,
 }
 #include <syscalls/k_thread_stack_space_get_mrsh.c>
 #endif /* CONFIG_USERSPACE */
+
+#ifdef CONFIG_STACK_WATERMARK
+int z_impl_k_thread_stack_watermark_get(const struct k_thread *thread,
+					size_t *unused_ptr)
+{
+	struct k_thread *t = (struct k_thread *)thread;
+	size_t unused = t->stack_info.unused;
+	int ret;
+
+	ret = z_stack_watermark_get((const uint8_t *)t->stack_info.start,
+				    t->stack_info.size, &unused);
+	if (ret != 0) {
+		return ret;
+	}
+
+	/* A concurrent call may have found a lower boundary already */
+	if (unused < t->stack_info.unused) {
+		t->stack_info.unused = unused;
+	}
+
+	*unused_ptr = unused;
+
+	return 0;
+}
+
+#ifdef CONFIG_USERSPACE
+int z_vrfy_k_thread_stack_watermark_get(const struct k_thread *thread,
+					size_t *unused_ptr)
+{
+	size_t unused;
+	int ret;
+
+	ret = Z_SYSCALL_OBJ(thread, K_OBJ_THREAD);
+	CHECKIF(ret != 0) {
+		return ret;
+	}
+
+	ret = z_impl_k_thread_stack_watermark_get(thread, &unused);
+	CHECKIF(ret != 0) {
+		return ret;
+	}
+
+	ret = z_user_to_copy(unused_ptr, &unused, sizeof(size_t));
+	CHECKIF(ret != 0) {
+		return ret;
+	}
+
+	return 0;
+}
+#include <syscalls/k_thread_stack_watermark_get_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+#endif /* CONFIG_STACK_WATERMARK */
 #endif /* CONFIG_INIT_STACKS && CONFIG_THREAD_STACK_INFO */
 
 #ifdef CONFIG_USERSPACE
@@ -1051,6 +1180,10 @@ void z_thread_mark_switched_in(void)
 	z_sched_usage_start(_current);
 #endif
 
+#if defined(CONFIG_SCHED_CBS) && !defined(CONFIG_USE_SWITCH)
+	z_sched_cbs_switch(_current);
+#endif
+
 #ifdef CONFIG_TRACING
 	SYS_PORT_TRACING_FUNC(k_thread, switched_in);
 #endif
@@ -1118,6 +1251,14 @@ int k_thread_runtime_stats_all_get(k_thread_runtime_stats_t *stats)
 		stats->average_cycles   += tmp_stats.average_cycles;
 #endif
 		stats->idle_cycles      += tmp_stats.idle_cycles;
+#ifdef CONFIG_SCHED_THREAD_USAGE_LATENCY
+		stats->preemptions      += tmp_stats.preemptions;
+		stats->peak_latency_cycles = MAX(stats->peak_latency_cycles,
+						 tmp_stats.peak_latency_cycles);
+		for (unsigned int j = 0; j < ARRAY_SIZE(stats->latency_hist); j++) {
+			stats->latency_hist[j] += tmp_stats.latency_hist[j];
+		}
+#endif
 	}
 #endif
 
@@ -14,16 +14,75 @@
 
 static uint64_t curr_tick;
 
-static sys_dlist_t timeout_list = SYS_DLIST_STATIC_INIT(&timeout_list);
-
-static struct k_spinlock timeout_lock;
-
 #define MAX_WAIT (IS_ENABLED(CONFIG_SYSTEM_CLOCK_SLOPPY_IDLE) \
 		  ? K_TICKS_FOREVER : INT_MAX)
 
 /* Ticks left to process in the currently-executing sys_clock_announce() */
 static int announce_remaining;
 
+#ifdef CONFIG_TIMEOUT_WHEEL
+#define WHEEL_BITS 5
+#define WHEEL_SLOTS BIT(WHEEL_BITS)
+#define WHEEL_MASK BIT_MASK(WHEEL_BITS)
+#define WHEEL_LEVELS CONFIG_TIMEOUT_WHEEL_LEVELS
+#define WHEEL_SPAN_BITS (WHEEL_BITS * WHEEL_LEVELS)
+#endif
+
+struct timeout_queue {
+#ifdef CONFIG_TIMEOUT_WHEEL
+	sys_dlist_t slots[WHEEL_LEVELS][WHEEL_SLOTS];
+	sys_dlist_t overflow;
+
+	/* Per-level bitmap of slots that may be non-empty.  Bits are set
+	 * on insertion and only cleared lazily when found stale, so that
+	 * z_abort_timeout() doesn't need to know the slot of a timeout.
+	 */
+	uint32_t pending[WHEEL_LEVELS];
+
+	/* Tick the wheel has been advanced to, never beyond curr_tick */
+	uint64_t now;
+
+	/* Cached expiry of the earliest timeout, UINT64_MAX if none.
+	 * Recomputed lazily once a timeout expiring then is removed.
+	 */
+	uint64_t next;
+	bool next_valid;
+
+	bool initialized;
+#else
+	sys_dlist_t list;
+
+	/* Tick the dticks of the first timeout in the list counts from */
+	uint64_t tick;
+#endif
+
+	struct k_spinlock lock;
+};
+
+#ifdef CONFIG_TIMEOUT_PER_CPU
+#define NUM_QUEUES CONFIG_MP_MAX_NUM_CPUS
+#else
+#define NUM_QUEUES 1
+#endif
+
+#ifdef CONFIG_TIMEOUT_WHEEL
+static struct timeout_queue queues[NUM_QUEUES];
+#else
+#define QUEUE_INIT(i, _) [i] = { .list = SYS_DLIST_STATIC_INIT(&queues[i].list) }
+
+static struct timeout_queue queues[NUM_QUEUES] = {
+	LISTIFY(NUM_QUEUES, QUEUE_INIT, (,))
+};
+#endif
+
+#ifdef CONFIG_TIMEOUT_PER_CPU
+/* Guards next_expiry, nests inside the queue locks */
+static struct k_spinlock timeout_lock;
+
+/* Absolute tick the timer driver was last programmed for */
+static uint64_t next_expiry = UINT64_MAX;
+#endif
+
 #if defined(CONFIG_TIMER_READS_ITS_FREQUENCY_AT_RUNTIME)
 int z_clock_hw_cycles_per_sec = CONFIG_SYS_CLOCK_HW_CYCLES_PER_SEC;
 
@@ -36,27 +95,47 @@ static inline int z_vrfy_sys_clock_hw_cycles_per_sec_runtime_get(void)
 #endif /* CONFIG_USERSPACE */
 #endif /* CONFIG_TIMER_READS_ITS_FREQUENCY_AT_RUNTIME */
 
-static struct _timeout *first(void)
+static struct timeout_queue *local_queue(void)
 {
-	sys_dnode_t *t = sys_dlist_peek_head(&timeout_list);
+#ifdef CONFIG_TIMEOUT_PER_CPU
+	/* Being migrated right after reading the CPU id is harmless,
+	 * any queue works and the local one merely avoids contention.
+	 */
+	return &queues[arch_curr_cpu()->id];
+#else
+	return &queues[0];
+#endif
+}
 
-	return t == NULL ? NULL : CONTAINER_OF(t, struct _timeout, node);
+static struct timeout_queue *queue_of(const struct _timeout *to)
+{
+#ifdef CONFIG_TIMEOUT_PER_CPU
+	return &queues[to->queue];
+#else
+	ARG_UNUSED(to);
+	return &queues[0];
+#endif
 }
 
-static struct _timeout *next(struct _timeout *t)
+/* Locks every queue, in index order, as needed to advance curr_tick */
+static k_spinlock_key_t lock_all(void)
 {
-	sys_dnode_t *n = sys_dlist_peek_next(&timeout_list, &t->node);
+	k_spinlock_key_t key = k_spin_lock(&queues[0].lock);
 
-	return n == NULL ? NULL : CONTAINER_OF(n, struct _timeout, node);
+	for (int i = 1; i < NUM_QUEUES; i++) {
+		(void)k_spin_lock(&queues[i].lock);
+	}
+
+	return key;
 }
 
-static void remove_timeout(struct _timeout *t)
+static void unlock_all(k_spinlock_key_t key)
 {
-	if (next(t) != NULL) {
-		next(t)->dticks += t->dticks;
+	for (int i = NUM_QUEUES - 1; i > 0; i--) {
+		k_spin_release(&queues[i].lock);
 	}
 
-	sys_dlist_remove(&t->node);
+	k_spin_unlock(&queues[0].lock, key);
 }
 
 static int32_t elapsed(void)
@@ -80,25 +159,491 @@ static int32_t elapsed(void)
 	return announce_remaining == 0 ? sys_clock_elapsed() : 0U;
 }
 
-static int32_t next_timeout(void)
+#ifdef CONFIG_TIMEOUT_WHEEL
+
+/* Hierarchical timing wheel.  Level N has WHEEL_SLOTS lists, slot S of
+ * level N holding the timeouts whose expiry tick has S in bits
+ * [N * WHEEL_BITS, (N + 1) * WHEEL_BITS) and matches the current wheel
+ * position in all bits above.  The dticks field stores the absolute
+ * expiry tick, so insertion is a single append to the slot picked by
+ * the highest bit in which the expiry differs from the wheel position,
+ * and removal is a plain dlist unlink.
+ *
+ * When the wheel reaches the start of a slot on level N > 0, the slot is
+ * cascaded into the lower levels.  Timeouts beyond the reach of the top
+ * level wait in an unsorted overflow list until the wheel gets there.
+ * All timeouts on a level expire before any timeout on a higher level,
+ * so the earliest one is always in the first pending slot of the lowest
+ * populated level.
+ */
+
+static void wheel_init(struct timeout_queue *q)
+{
+	q->next = UINT64_MAX;
+	q->next_valid = true;
+
+	for (int l = 0; l < WHEEL_LEVELS; l++) {
+		for (int s = 0; s < WHEEL_SLOTS; s++) {
+			sys_dlist_init(&q->slots[l][s]);
+		}
+	}
+	sys_dlist_init(&q->overflow);
+	q->now = curr_tick;
+	q->initialized = true;
+}
+
+static void wheel_place(struct timeout_queue *q, struct _timeout *t)
+{
+	uint64_t expiry = (uint64_t)t->dticks;
+	uint64_t diff = expiry ^ q->now;
+	int level, slot;
+
+	if (expiry <= q->now) {
+		expiry = q->now;
+		level = 0;
+	} else if (diff >= BIT64(WHEEL_SPAN_BITS)) {
+		sys_dlist_append(&q->overflow, &t->node);
+		return;
+	} else {
+		level = (find_msb_set((uint32_t)diff) - 1) / WHEEL_BITS;
+	}
+
+	slot = (expiry >> (level * WHEEL_BITS)) & WHEEL_MASK;
+	sys_dlist_append(&q->slots[level][slot], &t->node);
+	q->pending[level] |= BIT(slot);
+}
+
+/* First non-empty slot of a level at or after the wheel position, or -1 */
+static int wheel_next_slot(struct timeout_queue *q, int level)
+{
+	uint32_t cur = (q->now >> (level * WHEEL_BITS)) & WHEEL_MASK;
+	uint32_t mask;
+
+	while ((mask = q->pending[level] & ~BIT_MASK(cur)) != 0U) {
+		int slot = find_lsb_set(mask) - 1;
+
+		if (!sys_dlist_is_empty(&q->slots[level][slot])) {
+			return slot;
+		}
+		q->pending[level] &= ~BIT(slot);
+	}
+
+	return -1;
+}
+
+/* Tick at which the given slot of a level starts */
+static uint64_t wheel_slot_tick(struct timeout_queue *q, int level, int slot)
+{
+	int shift = level * WHEEL_BITS;
+
+	return ((q->now >> (shift + WHEEL_BITS)) << (shift + WHEEL_BITS)) |
+		((uint64_t)slot << shift);
+}
+
+static struct _timeout *wheel_min(sys_dlist_t *list)
+{
+	struct _timeout *t, *min = NULL;
+
+	SYS_DLIST_FOR_EACH_CONTAINER(list, t, node) {
+		if ((min == NULL) || (t->dticks < min->dticks)) {
+			min = t;
+		}
+	}
+
+	return min;
+}
+
+/* Next tick at which a timeout expires or a slot must be cascaded */
+static uint64_t wheel_next_event(struct timeout_queue *q)
+{
+	for (int l = 0; l < WHEEL_LEVELS; l++) {
+		int slot = wheel_next_slot(q, l);
+
+		if (slot >= 0) {
+			return wheel_slot_tick(q, l, slot);
+		}
+	}
+
+	if (!sys_dlist_is_empty(&q->overflow)) {
+		uint64_t expiry = wheel_min(&q->overflow)->dticks;
+
+		return (expiry >> WHEEL_SPAN_BITS) << WHEEL_SPAN_BITS;
+	}
+
+	return UINT64_MAX;
+}
+
+static void wheel_cascade(struct timeout_queue *q)
+{
+	struct _timeout *t, *tmp;
+	sys_dnode_t *node;
+
+	if ((q->now & BIT64_MASK(WHEEL_SPAN_BITS)) == 0U) {
+		SYS_DLIST_FOR_EACH_CONTAINER_SAFE(&q->overflow, t, tmp, node) {
+			if (((uint64_t)t->dticks >> WHEEL_SPAN_BITS) ==
+			    (q->now >> WHEEL_SPAN_BITS)) {
+				sys_dlist_remove(&t->node);
+				wheel_place(q, t);
+			}
+		}
+	}
+
+	for (int l = WHEEL_LEVELS - 1; l > 0; l--) {
+		int shift = l * WHEEL_BITS;
+		int slot = (q->now >> shift) & WHEEL_MASK;
+
+		if ((q->now & BIT64_MASK(shift)) != 0U) {
+			continue;
+		}
+
+		/* Everything in here lands on a lower level */
+		while ((node = sys_dlist_get(&q->slots[l][slot])) != NULL) {
+			wheel_place(q, CONTAINER_OF(node, struct _timeout, node));
+		}
+		q->pending[l] &= ~BIT(slot);
+	}
+}
+
+/* Expiry of the earliest timeout.  A level 0 slot only holds timeouts
+ * expiring on its own tick, or already expired ones in the slot of the
+ * wheel position, so the lists are only scanned when nothing expires
+ * within the next WHEEL_SLOTS ticks.
+ */
+static uint64_t wheel_next_expiry(struct timeout_queue *q)
+{
+	int slot = wheel_next_slot(q, 0);
+
+	if (slot >= 0) {
+		return wheel_slot_tick(q, 0, slot);
+	}
+
+	for (int l = 1; l < WHEEL_LEVELS; l++) {
+		slot = wheel_next_slot(q, l);
+		if (slot >= 0) {
+			return wheel_min(&q->slots[l][slot])->dticks;
+		}
+	}
+
+	if (!sys_dlist_is_empty(&q->overflow)) {
+		return wheel_min(&q->overflow)->dticks;
+	}
+
+	return UINT64_MAX;
+}
+
+/* Ticks from curr_tick to the expiry of the earliest timeout, or -1 */
+static int64_t queue_next_dticks(struct timeout_queue *q)
+{
+	if (!q->initialized) {
+		wheel_init(q);
+	}
+
+	if (!q->next_valid) {
+		q->next = wheel_next_expiry(q);
+		q->next_valid = true;
+	}
+
+	if (q->next == UINT64_MAX) {
+		return -1;
+	}
+
+	return MAX(0, (int64_t)(q->next - curr_tick));
+}
+
+/* Ticks from curr_tick to the expiry of the earliest timeout */
+static int64_t first_dticks(struct timeout_queue *q, struct _timeout *t)
+{
+	ARG_UNUSED(q);
+
+	return t->dticks - (int64_t)curr_tick;
+}
+
+static void insert_timeout(struct timeout_queue *q, struct _timeout *to)
+{
+	if (!q->initialized) {
+		wheel_init(q);
+	}
+
+	to->dticks += curr_tick;
+	wheel_place(q, to);
+
+	q->next = MIN(q->next, (uint64_t)to->dticks);
+}
+
+static void remove_timeout(struct timeout_queue *q, struct _timeout *t)
+{
+	/* Another timeout may expire on the same tick, or not */
+	if ((uint64_t)t->dticks <= q->next) {
+		q->next_valid = false;
+	}
+
+	sys_dlist_remove(&t->node);
+}
+
+/* Returns the next timeout expiring within the current announcement,
+ * advancing the wheel up to it (but never past the announced ticks).
+ */
+static struct _timeout *first_expired(struct timeout_queue *q)
+{
+	uint64_t limit = curr_tick + announce_remaining;
+	sys_dnode_t *node;
+
+	if (!q->initialized) {
+		wheel_init(q);
+	}
+
+	for (;;) {
+		node = sys_dlist_peek_head(&q->slots[0][q->now & WHEEL_MASK]);
+		if (node != NULL) {
+			return CONTAINER_OF(node, struct _timeout, node);
+		}
+
+		uint64_t next = wheel_next_event(q);
+
+		if (next > limit) {
+			q->now = limit;
+			return NULL;
+		}
+
+		q->now = next;
+		wheel_cascade(q);
+	}
+}
+
+/* Removes a timeout first_expired() returned, curr_tick is at its expiry */
+static void pop_timeout(struct timeout_queue *q, struct _timeout *t)
+{
+	t->dticks = 0;
+	remove_timeout(q, t);
+}
+
+/* must be locked */
+static k_ticks_t timeout_rem(struct timeout_queue *q,
+			     const struct _timeout *timeout)
+{
+	ARG_UNUSED(q);
+
+	if (z_is_inactive_timeout(timeout)) {
+		return 0;
+	}
+
+	return timeout->dticks - (int64_t)curr_tick - elapsed();
+}
+
+/* Expiries are absolute ticks, nothing to rebase */
+static void rebase_queue(struct timeout_queue *q)
+{
+	ARG_UNUSED(q);
+}
+
+#else /* !CONFIG_TIMEOUT_WHEEL */
+
+static struct _timeout *first(struct timeout_queue *q)
+{
+	sys_dnode_t *t = sys_dlist_peek_head(&q->list);
+
+	return t == NULL ? NULL : CONTAINER_OF(t, struct _timeout, node);
+}
+
+static struct _timeout *next(struct timeout_queue *q, struct _timeout *t)
+{
+	sys_dnode_t *n = sys_dlist_peek_next(&q->list, &t->node);
+
+	return n == NULL ? NULL : CONTAINER_OF(n, struct _timeout, node);
+}
+
+/* Ticks from curr_tick to the expiry of the first timeout */
+static int64_t first_dticks(struct timeout_queue *q, struct _timeout *t)
+{
+	return (int64_t)(q->tick - curr_tick) + t->dticks;
+}
+
+/* Ticks from curr_tick to the expiry of the first timeout, or -1 */
+static int64_t queue_next_dticks(struct timeout_queue *q)
+{
+	struct _timeout *t = first(q);
+
+	return (t == NULL) ? -1 : MAX(0, first_dticks(q, t));
+}
+
+static void insert_timeout(struct timeout_queue *q, struct _timeout *to)
+{
+	struct _timeout *t;
+
+	if (sys_dlist_is_empty(&q->list)) {
+		q->tick = curr_tick;
+	}
+
+	to->dticks += (k_ticks_t)(curr_tick - q->tick);
+
+	for (t = first(q); t != NULL; t = next(q, t)) {
+		if (t->dticks > to->dticks) {
+			t->dticks -= to->dticks;
+			sys_dlist_insert(&t->node, &to->node);
+			break;
+		}
+		to->dticks -= t->dticks;
+	}
+
+	if (t == NULL) {
+		sys_dlist_append(&q->list, &to->node);
+	}
+}
+
+static void remove_timeout(struct timeout_queue *q, struct _timeout *t)
+{
+	if (next(q, t) != NULL) {
+		next(q, t)->dticks += t->dticks;
+	}
+
+	sys_dlist_remove(&t->node);
+
+	if (sys_dlist_is_empty(&q->list)) {
+		q->tick = curr_tick;
+	}
+}
+
+static struct _timeout *first_expired(struct timeout_queue *q)
+{
+	struct _timeout *t = first(q);
+
+	return ((t != NULL) && (first_dticks(q, t) <= announce_remaining)) ?
+		t : NULL;
+}
+
+static void pop_timeout(struct timeout_queue *q, struct _timeout *t)
+{
+	q->tick += t->dticks;
+	t->dticks = 0;
+	remove_timeout(q, t);
+}
+
+/* must be locked */
+static k_ticks_t timeout_rem(struct timeout_queue *q,
+			     const struct _timeout *timeout)
+{
+	k_ticks_t ticks = 0;
+
+	if (z_is_inactive_timeout(timeout)) {
+		return 0;
+	}
+
+	for (struct _timeout *t = first(q); t != NULL; t = next(q, t)) {
+		ticks += t->dticks;
+		if (timeout == t) {
+			break;
+		}
+	}
+
+	return (k_ticks_t)(q->tick - curr_tick) + ticks - elapsed();
+}
+
+/* Makes the first timeout count from curr_tick again, so that the gap
+ * between q->tick and curr_tick never outgrows dticks.  Only called
+ * once every expired timeout has been popped, the first one is then
+ * still ahead of curr_tick.
+ */
+static void rebase_queue(struct timeout_queue *q)
+{
+	struct _timeout *t = first(q);
+
+	if (t != NULL) {
+		t->dticks -= (k_ticks_t)(curr_tick - q->tick);
+	}
+	q->tick = curr_tick;
+}
+
+#endif /* CONFIG_TIMEOUT_WHEEL */
+
+/* Ticks from curr_tick to the earliest timeout over all queues, or -1
+ * if there is none.  All queues must be locked.
+ */
+static int64_t next_dticks(void)
+{
+	int64_t ret = -1;
+
+	for (int i = 0; i < NUM_QUEUES; i++) {
+		int64_t dticks = queue_next_dticks(&queues[i]);
+
+		if ((dticks >= 0) && ((ret < 0) || (dticks < ret))) {
+			ret = dticks;
+		}
+	}
+
+	return ret;
+}
+
+static int32_t dticks_to_timeout(int64_t dticks)
 {
-	struct _timeout *to = first();
 	int32_t ticks_elapsed = elapsed();
 	int32_t ret;
 
-	if ((to == NULL) ||
-	    ((int64_t)(to->dticks - ticks_elapsed) > (int64_t)INT_MAX)) {
+	if ((dticks < 0) || ((dticks - ticks_elapsed) > (int64_t)INT_MAX)) {
 		ret = MAX_WAIT;
 	} else {
-		ret = MAX(0, to->dticks - ticks_elapsed);
+		ret = MAX(0, dticks - ticks_elapsed);
 	}
 
 	return ret;
 }
 
+static int32_t next_timeout(void)
+{
+	return dticks_to_timeout(next_dticks());
+}
+
+#ifdef CONFIG_TIMEOUT_SLACK
+/* Defers an expiry, in ticks from curr_tick, by up to the slack of the
+ * timeout so that it lands on a multiple of the largest power of two not
+ * above the slack plus one.  Timeouts whose windows overlap thus tend to
+ * expire on the same tick, and are all handled by one timer interrupt.
+ */
+static k_ticks_t apply_slack(struct _timeout *to, k_ticks_t dticks)
+{
+	uint64_t expiry = curr_tick + dticks;
+	uint64_t gran;
+
+	to->deferred = 0U;
+
+	if ((to->slack == 0U) || (!IS_ENABLED(CONFIG_TIMEOUT_64BIT) &&
+				  (dticks > (k_ticks_t)(INT32_MAX - to->slack)))) {
+		return dticks;
+	}
+
+	gran = BIT64(find_msb_set(to->slack + 1U) - 1);
+	to->deferred = ((expiry + to->slack) & ~(gran - 1U)) - expiry;
+
+	return dticks + to->deferred;
+}
+#endif
+
+/* Programs the timer driver after the next expiry of a queue was brought
+ * closer.  @a dticks counts from curr_tick, dticks_to_timeout() converts
+ * it to a timeout relative to the current time.
+ */
+static void arm_next(int64_t dticks)
+{
+#ifdef CONFIG_TIMEOUT_PER_CPU
+	/* Other queues (which we don't hold the lock of) may expire
+	 * earlier, so only ever bring the programmed expiry closer.
+	 * next_expiry is an absolute tick, like curr_tick + dticks.
+	 */
+	K_SPINLOCK(&timeout_lock) {
+		if ((curr_tick + dticks) < next_expiry) {
+			next_expiry = curr_tick + dticks;
+			sys_clock_set_timeout(dticks_to_timeout(dticks), false);
+		}
+	}
+#else
+	sys_clock_set_timeout(dticks_to_timeout(dticks), false);
+#endif
+}
+
 void z_add_timeout(struct _timeout *to, _timeout_func_t fn,
 		   k_timeout_t timeout)
 {
+	struct timeout_queue *q;
+
 	if (K_TIMEOUT_EQ(timeout, K_FOREVER)) {
 		return;
 	}
@@ -110,8 +655,11 @@ void z_add_timeout(struct _timeout *to, _timeout_func_t fn,
 	__ASSERT(!sys_dnode_is_linked(&to->node), "");
 	to->fn = fn;
 
-	K_SPINLOCK(&timeout_lock) {
-		struct _timeout *t;
+	q = local_queue();
+
+	K_SPINLOCK(&q->lock) {
+		int64_t prev = queue_next_dticks(q);
+		int64_t next;
 
 		if (IS_ENABLED(CONFIG_TIMEOUT_64BIT) &&
 		    Z_TICK_ABS(timeout.ticks) >= 0) {
@@ -122,32 +670,30 @@ void z_add_timeout(struct _timeout *to, _timeout_func_t fn,
 			to->dticks = timeout.ticks + 1 + elapsed();
 		}
 
-		for (t = first(); t != NULL; t = next(t)) {
-			if (t->dticks > to->dticks) {
-				t->dticks -= to->dticks;
-				sys_dlist_insert(&t->node, &to->node);
-				break;
-			}
-			to->dticks -= t->dticks;
-		}
+#ifdef CONFIG_TIMEOUT_SLACK
+		to->dticks = apply_slack(to, to->dticks);
+#endif
 
-		if (t == NULL) {
-			sys_dlist_append(&timeout_list, &to->node);
-		}
+#ifdef CONFIG_TIMEOUT_PER_CPU
+		to->queue = q - queues;
+#endif
+		insert_timeout(q, to);
 
-		if (to == first()) {
-			sys_clock_set_timeout(next_timeout(), false);
+		next = queue_next_dticks(q);
+		if ((prev < 0) || (next < prev)) {
+			arm_next(next);
 		}
 	}
 }
 
 int z_abort_timeout(struct _timeout *to)
 {
+	struct timeout_queue *q = queue_of(to);
 	int ret = -EINVAL;
 
-	K_SPINLOCK(&timeout_lock) {
+	K_SPINLOCK(&q->lock) {
 		if (sys_dnode_is_linked(&to->node)) {
-			remove_timeout(to);
+			remove_timeout(q, to);
 			ret = 0;
 		}
 	}
@@ -155,60 +701,64 @@ int z_abort_timeout(struct _timeout *to)
 	return ret;
 }
 
-/* must be locked */
-static k_ticks_t timeout_rem(const struct _timeout *timeout)
+k_ticks_t z_timeout_remaining(const struct _timeout *timeout)
 {
+	struct timeout_queue *q = queue_of(timeout);
 	k_ticks_t ticks = 0;
 
-	if (z_is_inactive_timeout(timeout)) {
-		return 0;
-	}
-
-	for (struct _timeout *t = first(); t != NULL; t = next(t)) {
-		ticks += t->dticks;
-		if (timeout == t) {
-			break;
-		}
+	K_SPINLOCK(&q->lock) {
+		ticks = timeout_rem(q, timeout);
 	}
 
-	return ticks - elapsed();
+	return ticks;
 }
 
-k_ticks_t z_timeout_remaining(const struct _timeout *timeout)
+k_ticks_t z_timeout_expires(const struct _timeout *timeout)
 {
+	struct timeout_queue *q = queue_of(timeout);
 	k_ticks_t ticks = 0;
 
-	K_SPINLOCK(&timeout_lock) {
-		ticks = timeout_rem(timeout);
+	K_SPINLOCK(&q->lock) {
+		ticks = curr_tick + timeout_rem(q, timeout);
 	}
 
 	return ticks;
 }
 
-k_ticks_t z_timeout_expires(const struct _timeout *timeout)
+int32_t z_get_next_timeout_expiry(void)
 {
-	k_ticks_t ticks = 0;
+	k_spinlock_key_t key = lock_all();
+	int32_t ret = next_timeout();
 
-	K_SPINLOCK(&timeout_lock) {
-		ticks = curr_tick + timeout_rem(timeout);
-	}
+	unlock_all(key);
 
-	return ticks;
+	return ret;
 }
 
-int32_t z_get_next_timeout_expiry(void)
+/* Queue holding the timeout that expires first within the current
+ * announcement, or NULL.
+ */
+static struct timeout_queue *first_expired_queue(struct _timeout **tp)
 {
-	int32_t ret = (int32_t) K_TICKS_FOREVER;
+	struct timeout_queue *ret = NULL;
 
-	K_SPINLOCK(&timeout_lock) {
-		ret = next_timeout();
+	*tp = NULL;
+	for (int i = 0; i < NUM_QUEUES; i++) {
+		struct _timeout *t = first_expired(&queues[i]);
+
+		if ((t != NULL) && ((*tp == NULL) ||
+		    (first_dticks(&queues[i], t) < first_dticks(ret, *tp)))) {
+			ret = &queues[i];
+			*tp = t;
+		}
 	}
+
 	return ret;
 }
 
 void sys_clock_announce(int32_t ticks)
 {
-	k_spinlock_key_t key = k_spin_lock(&timeout_lock);
+	k_spinlock_key_t key = lock_all();
 
 	/* We release the lock around the callbacks below, so on SMP
 	 * systems someone might be already running the loop.  Don't
@@ -218,50 +768,62 @@ void sys_clock_announce(int32_t ticks)
 	 */
 	if (IS_ENABLED(CONFIG_SMP) && (announce_remaining != 0)) {
 		announce_remaining += ticks;
-		k_spin_unlock(&timeout_lock, key);
+		unlock_all(key);
 		return;
 	}
 
 	announce_remaining = ticks;
 
+	struct timeout_queue *q;
 	struct _timeout *t;
 
-	for (t = first();
-	     (t != NULL) && (t->dticks <= announce_remaining);
-	     t = first()) {
-		int dt = t->dticks;
+	for (q = first_expired_queue(&t); q != NULL; q = first_expired_queue(&t)) {
+		int dt = MAX(0, first_dticks(q, t));
 
 		curr_tick += dt;
-		t->dticks = 0;
-		remove_timeout(t);
+		pop_timeout(q, t);
 
-		k_spin_unlock(&timeout_lock, key);
+		unlock_all(key);
 		t->fn(t);
-		key = k_spin_lock(&timeout_lock);
+		key = lock_all();
 		announce_remaining -= dt;
 	}
 
-	if (t != NULL) {
-		t->dticks -= announce_remaining;
-	}
-
 	curr_tick += announce_remaining;
 	announce_remaining = 0;
 
+	for (int i = 0; i < NUM_QUEUES; i++) {
+		rebase_queue(&queues[i]);
+	}
+
+#ifdef CONFIG_TIMEOUT_PER_CPU
+	K_SPINLOCK(&timeout_lock) {
+		int64_t dticks = next_dticks();
+
+		next_expiry = (dticks < 0) ? UINT64_MAX : (curr_tick + dticks);
+		sys_clock_set_timeout(dticks_to_timeout(dticks), false);
+	}
+#else
 	sys_clock_set_timeout(next_timeout(), false);
+#endif
 
-	k_spin_unlock(&timeout_lock, key);
+	unlock_all(key);
 
 #ifdef CONFIG_TIMESLICING
 	z_time_slice();
 #endif
+
+#ifdef CONFIG_SCHED_CBS
+	z_sched_cbs_tick();
+#endif
 }
 
 int64_t sys_clock_tick_get(void)
 {
+	struct timeout_queue *q = local_queue();
 	uint64_t t = 0U;
 
-	K_SPINLOCK(&timeout_lock) {
+	K_SPINLOCK(&q->lock) {
 		t = curr_tick + elapsed();
 	}
 	return t;
@@ -330,6 +892,39 @@ k_timeout_t sys_timepoint_timeout(k_timepoint_t timepoint)
 void z_impl_sys_clock_tick_set(uint64_t tick)
 {
 	curr_tick = tick;
+
+#ifdef CONFIG_TIMEOUT_WHEEL
+	struct timeout_queue *q = &queues[0];
+
+	/* Re-sort everything around the new wheel position */
+	if (q->initialized) {
+		sys_dlist_t all = SYS_DLIST_STATIC_INIT(&all);
+		sys_dnode_t *node;
+
+		for (int l = 0; l < WHEEL_LEVELS; l++) {
+			for (int s = 0; s < WHEEL_SLOTS; s++) {
+				while ((node = sys_dlist_get(&q->slots[l][s])) != NULL) {
+					sys_dlist_append(&all, node);
+				}
+			}
+			q->pending[l] = 0U;
+		}
+		while ((node = sys_dlist_get(&q->overflow)) != NULL) {
+			sys_dlist_append(&all, node);
+		}
+
+		q->now = tick;
+		q->next_valid = false;
+		while ((node = sys_dlist_get(&all)) != NULL) {
+			wheel_place(q, CONTAINER_OF(node, struct _timeout, node));
+		}
+	}
+#else
+	/* Armed timeouts keep their remaining ticks */
+	for (int i = 0; i < NUM_QUEUES; i++) {
+		queues[i].tick = tick;
+	}
+#endif
 }
 
 void z_vrfy_sys_clock_tick_set(uint64_t tick)
@@ -52,8 +52,11 @@ void z_timer_expiration_handler(struct _timeout *t)
 	    !K_TIMEOUT_EQ(timer->period, K_FOREVER)) {
 		k_timeout_t next = timer->period;
 
-		/* see note about z_add_timeout() in z_impl_k_timer_start() */
-		next.ticks = MAX(next.ticks - 1, 0);
+		/* see note about z_add_timeout() in z_impl_k_timer_start(),
+		 * the period also counts from the requested rather than the
+		 * actual expiry, so that slack doesn't accumulate
+		 */
+		next.ticks = MAX(next.ticks - 1 - z_timeout_deferred(t), 0);
 
 #ifdef CONFIG_TIMEOUT_64BIT
 		/* Exploit the fact that uptime during a kernel
@@ -128,11 +131,9 @@ void k_timer_init(struct k_timer *timer,
 }
 
 
-void z_impl_k_timer_start(struct k_timer *timer, k_timeout_t duration,
-			  k_timeout_t period)
+static void timer_start(struct k_timer *timer, k_timeout_t duration,
+			k_timeout_t period, k_timeout_t slack)
 {
-	SYS_PORT_TRACING_OBJ_FUNC(k_timer, start, timer, duration, period);
-
 	if (K_TIMEOUT_EQ(duration, K_FOREVER)) {
 		return;
 	}
@@ -158,10 +159,19 @@ void z_impl_k_timer_start(struct k_timer *timer, k_timeout_t duration,
 	timer->period = period;
 	timer->status = 0U;
 
+	z_timeout_slack_set(&timer->timeout, slack);
 	z_add_timeout(&timer->timeout, z_timer_expiration_handler,
 		     duration);
 }
 
+void z_impl_k_timer_start(struct k_timer *timer, k_timeout_t duration,
+			  k_timeout_t period)
+{
+	SYS_PORT_TRACING_OBJ_FUNC(k_timer, start, timer, duration, period);
+
+	timer_start(timer, duration, period, K_NO_WAIT);
+}
+
 #ifdef CONFIG_USERSPACE
 static inline void z_vrfy_k_timer_start(struct k_timer *timer,
 					k_timeout_t duration,
@@ -173,6 +183,26 @@ static inline void z_vrfy_k_timer_start(struct k_timer *timer,
 #include <syscalls/k_timer_start_mrsh.c>
 #endif
 
+void z_impl_k_timer_start_slack(struct k_timer *timer, k_timeout_t duration,
+				k_timeout_t period, k_timeout_t slack)
+{
+	SYS_PORT_TRACING_OBJ_FUNC(k_timer, start, timer, duration, period);
+
+	timer_start(timer, duration, period, slack);
+}
+
+#ifdef CONFIG_USERSPACE
+static inline void z_vrfy_k_timer_start_slack(struct k_timer *timer,
+					      k_timeout_t duration,
+					      k_timeout_t period,
+					      k_timeout_t slack)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(timer, K_OBJ_TIMER));
+	z_impl_k_timer_start_slack(timer, duration, period, slack);
+}
+#include <syscalls/k_timer_start_slack_mrsh.c>
+#endif
+
 void z_impl_k_timer_stop(struct k_timer *timer)
 {
 	SYS_PORT_TRACING_OBJ_FUNC(k_timer, stop, timer);
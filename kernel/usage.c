@@ -10,6 +10,7 @@
 #include <ksched.h>
 #include <zephyr/spinlock.h>
 #include <zephyr/sys/check.h>
+#include <string.h>
 
 /* Need one of these for this to work */
 #if !defined(CONFIG_USE_SWITCH) && !defined(CONFIG_INSTRUMENT_THREAD_SWITCHING)
@@ -71,19 +72,110 @@ static void sched_thread_update_usage(struct k_thread *thread, uint32_t cycles)
 #endif
 }
 
+#ifdef CONFIG_SCHED_THREAD_USAGE_LATENCY
+static inline uint32_t latency_bucket(uint32_t cycles)
+{
+	uint32_t bucket = find_msb_set(cycles >> CONFIG_SCHED_THREAD_USAGE_LATENCY_SHIFT);
+
+	return MIN(bucket, CONFIG_SCHED_THREAD_USAGE_LATENCY_BUCKETS - 1);
+}
+
+static void sched_update_latency(struct k_cycle_stats *usage, uint32_t cycles)
+{
+	usage->latency_hist[latency_bucket(cycles)]++;
+
+	if (usage->latency_max < cycles) {
+		usage->latency_max = cycles;
+	}
+}
+
+void z_sched_usage_ready(struct k_thread *thread)
+{
+	thread->base.usage.ready0 = usage_now();
+}
+
+/*
+ * Account for [thread] being switched in on [cpu] at [now]. Must be
+ * called with usage_lock held.
+ */
+static void sched_latency_switch(struct _cpu *cpu, struct k_thread *thread,
+				 uint32_t now)
+{
+	struct k_thread *prev = cpu->usage_thread;
+	uint32_t ready0 = thread->base.usage.ready0;
+
+	/* Execution windows are also restarted without a switch, e.g. on
+	 * interrupt exit. A thread requeued while running, e.g. yielding
+	 * with nothing else to run, was never kept waiting.
+	 */
+	if (thread == prev) {
+		thread->base.usage.ready0 = 0;
+		return;
+	}
+
+	cpu->usage_thread = thread;
+
+	if ((prev != NULL) && (prev != cpu->idle_thread) &&
+	    z_is_thread_ready(prev)) {
+		/* Preempted: waiting to run from now on */
+		prev->base.usage.ready0 = now;
+
+		if (prev->base.usage.track_usage) {
+			prev->base.usage.preemptions++;
+		}
+#ifdef CONFIG_SCHED_THREAD_USAGE_ALL
+		if (cpu->usage.track_usage) {
+			cpu->usage.preemptions++;
+		}
+#endif
+	}
+
+	if (ready0 == 0) {
+		return;
+	}
+
+	thread->base.usage.ready0 = 0;
+
+	if (thread->base.usage.track_usage) {
+		sched_update_latency(&thread->base.usage, now - ready0);
+	}
+#ifdef CONFIG_SCHED_THREAD_USAGE_ALL
+	if (cpu->usage.track_usage) {
+		sched_update_latency(&cpu->usage, now - ready0);
+	}
+#endif
+}
+
+static void sched_latency_copy(struct k_cycle_stats *usage,
+			       struct k_thread_runtime_stats *stats)
+{
+	stats->preemptions = usage->preemptions;
+	stats->peak_latency_cycles = usage->latency_max;
+	memcpy(stats->latency_hist, usage->latency_hist,
+	       sizeof(stats->latency_hist));
+}
+#endif
+
 void z_sched_usage_start(struct k_thread *thread)
 {
-#ifdef CONFIG_SCHED_THREAD_USAGE_ANALYSIS
+#if defined(CONFIG_SCHED_THREAD_USAGE_ANALYSIS) || \
+	defined(CONFIG_SCHED_THREAD_USAGE_LATENCY)
 	k_spinlock_key_t  key;
 
 	key = k_spin_lock(&usage_lock);
 
 	_current_cpu->usage0 = usage_now();   /* Always update */
 
+#ifdef CONFIG_SCHED_THREAD_USAGE_ANALYSIS
 	if (thread->base.usage.track_usage) {
 		thread->base.usage.num_windows++;
 		thread->base.usage.current = 0;
 	}
+#endif
+
+#ifdef CONFIG_SCHED_THREAD_USAGE_LATENCY
+	sched_latency_switch(_current_cpu, thread, _current_cpu->usage0);
+#endif
 
 	k_spin_unlock(&usage_lock, key);
 #else
@@ -161,6 +253,10 @@ void z_sched_cpu_usage(uint8_t cpu_id, struct k_thread_runtime_stats *stats)
 	}
 #endif
 
+#ifdef CONFIG_SCHED_THREAD_USAGE_LATENCY
+	sched_latency_copy(&_kernel.cpus[cpu_id].usage, stats);
+#endif
+
 	stats->idle_cycles =
 		_kernel.cpus[cpu_id].idle_thread->base.usage.total;
 
@@ -217,6 +313,10 @@ void z_sched_thread_usage(struct k_thread *thread,
 	}
 #endif
 
+#ifdef CONFIG_SCHED_THREAD_USAGE_LATENCY
+	sched_latency_copy(&thread->base.usage, stats);
+#endif
+
 #ifdef CONFIG_SCHED_THREAD_USAGE_ALL
 	stats->idle_cycles = 0;
 #endif
@@ -12,6 +12,7 @@
 #include <zephyr/kernel_structs.h>
 #include <zephyr/sys/sys_io.h>
 #include <ksched.h>
+#include <kernel_internal.h>
 #include <zephyr/syscall.h>
 #include <zephyr/syscall_handler.h>
 #include <zephyr/device.h>
@@ -183,6 +184,22 @@ extern void z_object_gperf_wordlist_foreach(_wordlist_cb_func_t func,
  */
 static sys_dlist_t obj_list = SYS_DLIST_STATIC_INIT(&obj_list);
 
+#ifdef CONFIG_USERSPACE_OBJ_CACHE
+/* Bumped whenever a dynamic object is freed, invalidating the object
+ * lookups cached by the threads.
+ */
+static atomic_t obj_cache_gen;
+
+static inline void obj_cache_invalidate(void)
+{
+	(void)atomic_inc(&obj_cache_gen);
+}
+#else
+static inline void obj_cache_invalidate(void)
+{
+}
+#endif /* CONFIG_USERSPACE_OBJ_CACHE */
+
 /*
  * TODO: Write some hash table code that will replace obj_list.
  */
@@ -470,6 +487,7 @@ void k_object_free(void *obj)
 	k_spin_unlock(&objfree_lock, key);
 
 	if (dyn != NULL) {
+		obj_cache_invalidate();
 		k_free(dyn->data);
 		k_free(dyn);
 	}
@@ -512,6 +530,64 @@ void z_object_wordlist_foreach(_wordlist_cb_func_t func, void *context)
 }
 #endif /* CONFIG_DYNAMIC_OBJECTS */
 
+#ifdef CONFIG_USERSPACE_OBJ_CACHE
+BUILD_ASSERT(IS_POWER_OF_TWO(CONFIG_USERSPACE_OBJ_CACHE_SIZE),
+	     "CONFIG_USERSPACE_OBJ_CACHE_SIZE must be a power of two");
+
+static void obj_cache_flush(struct _thread_obj_cache *cache)
+{
+	(void)memset(cache->obj, 0, sizeof(cache->obj));
+#ifdef CONFIG_DYNAMIC_OBJECTS
+	cache->gen = atomic_get(&obj_cache_gen);
+#endif
+}
+
+struct z_object *z_object_find_cached(const void *obj)
+{
+	struct _thread_obj_cache *cache;
+	struct z_object *ko;
+	size_t i;
+
+	/* The cache belongs to the thread, not to an interrupted one */
+	if (k_is_in_isr() || (obj == NULL)) {
+		return z_object_find(obj);
+	}
+
+	cache = &_current->obj_cache;
+	i = ((uintptr_t)obj / sizeof(void *)) &
+	    (CONFIG_USERSPACE_OBJ_CACHE_SIZE - 1);
+
+#ifdef CONFIG_DYNAMIC_OBJECTS
+	if (cache->gen != (uint32_t)atomic_get(&obj_cache_gen)) {
+		obj_cache_flush(cache);
+	}
+#endif
+
+	if (cache->obj[i] == obj) {
+		return cache->ko[i];
+	}
+
+	ko = z_object_find(obj);
+	if (ko != NULL) {
+		cache->ko[i] = ko;
+		cache->obj[i] = obj;
+#ifdef CONFIG_DYNAMIC_OBJECTS
+		/* Freed while looked up: the entry may already be stale */
+		if (cache->gen != (uint32_t)atomic_get(&obj_cache_gen)) {
+			obj_cache_flush(cache);
+		}
+#endif
+	}
+
+	return ko;
+}
+
+void z_object_cache_init(struct k_thread *thread)
+{
+	obj_cache_flush(&thread->obj_cache);
+}
+#endif /* CONFIG_USERSPACE_OBJ_CACHE */
+
 static unsigned int thread_index_get(struct k_thread *thread)
 {
 	struct z_object *ko;
@@ -572,6 +648,7 @@ static void unref_check(struct z_object *ko, uintptr_t index)
 	}
 
 	sys_dlist_remove(&dyn->dobj_list);
+	obj_cache_invalidate();
 	k_free(dyn->data);
 	k_free(dyn);
 out:
@@ -645,7 +722,13 @@ static int thread_perms_test(struct z_object *ko)
 		return 1;
 	}
 
+#ifdef CONFIG_USERSPACE_OBJ_CACHE
+	struct z_object *thread_ko = z_object_find_cached(_current);
+
+	index = (thread_ko != NULL) ? (int)thread_ko->data.thread_id : -1;
+#else
 	index = thread_index_get(_current);
+#endif
 	if (index != -1) {
 		return sys_bitfield_test_bit((mem_addr_t)&ko->perms, index);
 	}
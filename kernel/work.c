@@ -157,6 +157,120 @@ int k_work_busy_get(const struct k_work *work)
 	return ret;
 }
 
+#ifdef CONFIG_WORKQUEUE_STATS
+/* List of started work queues. */
+static sys_slist_t work_queues;
+
+static inline uint32_t stats_bucket(uint32_t cycles)
+{
+	uint32_t us = k_cyc_to_us_floor32(cycles);
+
+	return MIN(find_msb_set(us), CONFIG_WORKQUEUE_STATS_HIST_BUCKETS - 1);
+}
+
+static void stats_handler_tally(struct k_work_queue_stats *stats,
+				k_work_handler_t handler, uint32_t cycles)
+{
+	for (unsigned int i = 0; i < ARRAY_SIZE(stats->handlers); i++) {
+		struct k_work_handler_stats *hs = &stats->handlers[i];
+
+		if (hs->handler == NULL) {
+			hs->handler = handler;
+		}
+
+		if (hs->handler == handler) {
+			hs->count++;
+			hs->total_cycles += cycles;
+			hs->max_cycles = MAX(hs->max_cycles, cycles);
+			return;
+		}
+	}
+
+	stats->other_handlers++;
+}
+#endif /* CONFIG_WORKQUEUE_STATS */
+
+/* Account for a work item added to a queue's pending list.
+ *
+ * Invoked with work lock held.
+ */
+static inline void stats_queued(struct k_work_q *queue, struct k_work *work)
+{
+#ifdef CONFIG_WORKQUEUE_STATS
+	struct k_work_queue_stats *stats = &queue->stats;
+
+	work->queued_cycles = k_cycle_get_32();
+	stats->depth++;
+	stats->max_depth = MAX(stats->max_depth, stats->depth);
+#else
+	ARG_UNUSED(queue);
+	ARG_UNUSED(work);
+#endif
+}
+
+/* Account for a work item taken off a queue's pending list.  Flush items
+ * are internal and not accounted for.
+ *
+ * Invoked with work lock held.
+ */
+static inline void stats_dequeued(struct k_work_q *queue, struct k_work *work)
+{
+#ifdef CONFIG_WORKQUEUE_STATS
+	if (work->handler != handle_flush) {
+		queue->stats.depth--;
+	}
+#else
+	ARG_UNUSED(queue);
+	ARG_UNUSED(work);
+#endif
+}
+
+/* Account for a work item about to be run by @p queue.
+ *
+ * Invoked with work lock held.
+ *
+ * @return the cycle count at the start of the handler.
+ */
+static inline uint32_t stats_started(struct k_work_q *queue,
+				     struct k_work *work)
+{
+#ifdef CONFIG_WORKQUEUE_STATS
+	uint32_t now = k_cycle_get_32();
+
+	if (work->handler != handle_flush) {
+		queue->stats.latency_hist[stats_bucket(now - work->queued_cycles)]++;
+	}
+
+	return now;
+#else
+	ARG_UNUSED(queue);
+	ARG_UNUSED(work);
+
+	return 0;
+#endif
+}
+
+/* Account for the end of a handler run by @p queue.
+ *
+ * Invoked with work lock held.
+ */
+static inline void stats_finished(struct k_work_q *queue,
+				  k_work_handler_t handler, uint32_t start)
+{
+#ifdef CONFIG_WORKQUEUE_STATS
+	uint32_t cycles = k_cycle_get_32() - start;
+
+	if (handler != handle_flush) {
+		queue->stats.runtime_hist[stats_bucket(cycles)]++;
+		stats_handler_tally(&queue->stats, handler, cycles);
+	}
+#else
+	ARG_UNUSED(queue);
+	ARG_UNUSED(handler);
+	ARG_UNUSED(start);
+#endif
+}
+
 /* Add a flusher work item to the queue.
  *
  * Invoked with work lock held.
@@ -203,7 +317,9 @@ static inline void queue_remove_locked(struct k_work_q *queue,
 				       struct k_work *work)
 {
 	if (flag_test_and_clear(&work->flags, K_WORK_QUEUED_BIT)) {
-		(void)sys_slist_find_and_remove(&queue->pending, &work->node);
+		if (sys_slist_find_and_remove(&queue->pending, &work->node)) {
+			stats_dequeued(queue, work);
+		}
 	}
 }
 
@@ -229,6 +345,89 @@ static inline bool notify_queue_locked(struct k_work_q *queue)
 	return rv;
 }
 
+#ifdef CONFIG_WORKQUEUE_POOL
+/* Wake up an idle worker of the pool @p queue belongs to, so it can take
+ * over work queued on @p queue while that one is busy.
+ *
+ * Invoked with work lock held.
+ */
+static void notify_pool_locked(struct k_work_q *queue)
+{
+	struct k_work_q_pool *pool = queue->pool;
+
+	if (pool == NULL) {
+		return;
+	}
+
+	for (unsigned int i = 0; i < pool->num_queues; i++) {
+		struct k_work_q *peer = &pool->queues[i];
+
+		if ((peer != queue) && notify_queue_locked(peer)) {
+			break;
+		}
+	}
+}
+
+/* Take the oldest item queued on another worker of the pool.
+ *
+ * Flush items are left alone, as they must complete on the queue that
+ * runs the work they flush.  Those queued right behind the stolen item
+ * are flushes of that item, they move along with it.
+ *
+ * Invoked with work lock held, with the pending list of @p queue empty.
+ *
+ * @return the node of the stolen item, already reassigned to @p queue, or
+ * NULL if there was nothing to steal.
+ */
+static sys_snode_t *steal_work_locked(struct k_work_q *queue)
+{
+	struct k_work_q_pool *pool = queue->pool;
+
+	if (pool == NULL) {
+		return NULL;
+	}
+
+	for (unsigned int i = 0; i < pool->num_queues; i++) {
+		struct k_work_q *victim = &pool->queues[i];
+		sys_snode_t *node = sys_slist_peek_head(&victim->pending);
+		sys_snode_t *next;
+		struct k_work *work;
+
+		if ((victim == queue) || (node == NULL)) {
+			continue;
+		}
+
+		work = CONTAINER_OF(node, struct k_work, node);
+		if (work->handler == handle_flush) {
+			continue;
+		}
+
+		(void)sys_slist_get_not_empty(&victim->pending);
+		stats_dequeued(victim, work);
+		work->queue = queue;
+
+		while (true) {
+			next = sys_slist_peek_head(&victim->pending);
+			if ((next == NULL) ||
+			    (CONTAINER_OF(next, struct k_work, node)->handler
+			     != handle_flush)) {
+				break;
+			}
+
+			(void)sys_slist_get_not_empty(&victim->pending);
+			sys_slist_append(&queue->pending, next);
+		}
+
+		return node;
+	}
+
+	return NULL;
+}
+#else
+#define notify_pool_locked(queue) ARG_UNUSED(queue)
+#define steal_work_locked(queue) NULL
+#endif /* CONFIG_WORKQUEUE_POOL */
+
 /* Submit an work item to a queue if queue state allows new work.
  *
  * Submission is rejected if no queue is provided, or if the queue is
@@ -275,8 +474,11 @@ static inline int queue_submit_locked(struct k_work_q *queue,
 		ret = -EBUSY;
 	} else {
 		sys_slist_append(&queue->pending, &work->node);
+		stats_queued(queue, work);
 		ret = 1;
-		(void)notify_queue_locked(queue);
+		if (!notify_queue_locked(queue)) {
+			notify_pool_locked(queue);
+		}
 	}
 
 	return ret;
@@ -605,10 +807,19 @@ static void work_queue_main(void *workq_ptr, void *p2, void *p3)
 		struct k_work *work = NULL;
 		k_work_handler_t handler = NULL;
 		k_spinlock_key_t key = k_spin_lock(&lock);
+		uint32_t start = 0;
 		bool yield;
 
 		/* Check for and prepare any new work. */
 		node = sys_slist_get(&queue->pending);
+		if (node != NULL) {
+			stats_dequeued(queue,
+				       CONTAINER_OF(node, struct k_work, node));
+		} else if (!flag_test(&queue->flags, K_WORK_QUEUE_DRAIN_BIT)) {
+			/* Help out the other workers of the pool, if any */
+			node = steal_work_locked(queue);
+		}
+
 		if (node != NULL) {
 			/* Mark that there's some work active that's
 			 * not on the pending list.
@@ -631,6 +842,7 @@ static void work_queue_main(void *workq_ptr, void *p2, void *p3)
 			 * This means that if node is not NULL, then work will not be NULL.
 			 */
 			handler = work->handler;
+			start = stats_started(queue, work);
 		} else if (flag_test_and_clear(&queue->flags,
 					       K_WORK_QUEUE_DRAIN_BIT)) {
 			/* Not busy and draining: move threads waiting for
@@ -674,6 +886,8 @@ static void work_queue_main(void *workq_ptr, void *p2, void *p3)
 		 */
 		key = k_spin_lock(&lock);
 
+		stats_finished(queue, handler, start);
+
 		flag_clear(&work->flags, K_WORK_RUNNING_BIT);
 		if (flag_test(&work->flags, K_WORK_CANCELING_BIT)) {
 			finalize_cancel_locked(work);
@@ -703,11 +917,11 @@ void k_work_queue_init(struct k_work_q *queue)
 	SYS_PORT_TRACING_OBJ_INIT(k_work_queue, queue);
 }
 
-void k_work_queue_start(struct k_work_q *queue,
-			k_thread_stack_t *stack,
-			size_t stack_size,
-			int prio,
-			const struct k_work_queue_config *cfg)
+static void work_queue_create(struct k_work_q *queue,
+			      k_thread_stack_t *stack,
+			      size_t stack_size,
+			      int prio,
+			      const struct k_work_queue_config *cfg)
 {
 	__ASSERT_NO_MSG(queue);
 	__ASSERT_NO_MSG(stack);
@@ -720,6 +934,13 @@ void k_work_queue_start(struct k_work_q *queue,
 	z_waitq_init(&queue->notifyq);
 	z_waitq_init(&queue->drainq);
 
+#ifdef CONFIG_WORKQUEUE_STATS
+	K_SPINLOCK(&lock) {
+		queue->stats = (struct k_work_queue_stats) {};
+		sys_slist_append(&work_queues, &queue->stats_node);
+	}
+#endif
+
 	if ((cfg != NULL) && cfg->no_yield) {
 		flags |= K_WORK_QUEUE_NO_YIELD;
 	}
@@ -737,12 +958,115 @@ void k_work_queue_start(struct k_work_q *queue,
 	if ((cfg != NULL) && (cfg->name != NULL)) {
 		k_thread_name_set(&queue->thread, cfg->name);
 	}
+}
+
+void k_work_queue_start(struct k_work_q *queue,
+			k_thread_stack_t *stack,
+			size_t stack_size,
+			int prio,
+			const struct k_work_queue_config *cfg)
+{
+	work_queue_create(queue, stack, stack_size, prio, cfg);
 
 	k_thread_start(&queue->thread);
 
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_work_queue, start, queue);
 }
 
+#ifdef CONFIG_WORKQUEUE_POOL
+void k_work_q_pool_start(struct k_work_q_pool *pool, int prio,
+			 const struct k_work_queue_config *cfg)
+{
+	__ASSERT_NO_MSG(pool != NULL);
+	__ASSERT_NO_MSG(pool->num_queues > 0U);
+
+	for (unsigned int i = 0; i < pool->num_queues; i++) {
+		struct k_work_q *queue = &pool->queues[i];
+		k_thread_stack_t *stack = (k_thread_stack_t *)
+			((uint8_t *)pool->stacks + (i * pool->stack_stride));
+
+		k_work_queue_init(queue);
+		queue->pool = pool;
+		work_queue_create(queue, stack, pool->stack_size, prio, cfg);
+#ifdef CONFIG_SCHED_CPU_MASK
+		(void)k_thread_cpu_pin(&queue->thread, i % arch_num_cpus());
+#endif
+	}
+
+	for (unsigned int i = 0; i < pool->num_queues; i++) {
+		k_thread_start(&pool->queues[i].thread);
+
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_work_queue, start,
+					       &pool->queues[i]);
+	}
+}
+
+int k_work_q_pool_submit(struct k_work_q_pool *pool, struct k_work *work)
+{
+	__ASSERT_NO_MSG(pool != NULL);
+
+	unsigned int key = arch_irq_lock();
+	struct k_work_q *queue =
+		&pool->queues[_current_cpu->id % pool->num_queues];
+
+	arch_irq_unlock(key);
+
+	return k_work_submit_to_queue(queue, work);
+}
+#endif /* CONFIG_WORKQUEUE_POOL */
+
+#ifdef CONFIG_WORKQUEUE_STATS
+int k_work_queue_stats_get(struct k_work_q *queue,
+			   struct k_work_queue_stats *stats)
+{
+	if ((queue == NULL) || (stats == NULL)) {
+		return -EINVAL;
+	}
+
+	K_SPINLOCK(&lock) {
+		*stats = queue->stats;
+	}
+
+	return 0;
+}
+
+void k_work_queue_stats_reset(struct k_work_q *queue)
+{
+	__ASSERT_NO_MSG(queue != NULL);
+
+	K_SPINLOCK(&lock) {
+		uint32_t depth = queue->stats.depth;
+
+		queue->stats = (struct k_work_queue_stats) {
+			.depth = depth,
+			.max_depth = depth,
+		};
+	}
+}
+
+void k_work_queue_foreach(void (*user_cb)(struct k_work_q *queue,
+					  void *user_data),
+			  void *user_data)
+{
+	sys_snode_t *node;
+
+	__ASSERT_NO_MSG(user_cb != NULL);
+
+	K_SPINLOCK(&lock) {
+		node = sys_slist_peek_head(&work_queues);
+	}
+
+	/* Queues are never removed from the list, and only appended to
+	 * it, so it can be walked without holding the lock.
+	 */
+	while (node != NULL) {
+		user_cb(CONTAINER_OF(node, struct k_work_q, stats_node),
+			user_data);
+		node = sys_slist_peek_next(node);
+	}
+}
+#endif /* CONFIG_WORKQUEUE_STATS */
+
 int k_work_queue_drain(struct k_work_q *queue,
 		       bool plug)
 {
@@ -877,12 +1201,14 @@ int k_work_delayable_busy_get(const struct k_work_delayable *dwork)
  *
  * @param delay the delay to use before scheduling.
  *
+ * @param slack how much later than @p delay the submission may happen.
+ *
  * @retval from submit_to_queue_locked() if delay is K_NO_WAIT; otherwise
  * @retval 1 to indicate successfully scheduled.
  */
 static int schedule_for_queue_locked(struct k_work_q **queuep,
 				     struct k_work_delayable *dwork,
-				     k_timeout_t delay)
+				     k_timeout_t delay, k_timeout_t slack)
 {
 	int ret = 1;
 	struct k_work *work = &dwork->work;
@@ -895,6 +1221,7 @@ static int schedule_for_queue_locked(struct k_work_q **queuep,
 	dwork->queue = *queuep;
 
 	/* Add timeout */
+	z_timeout_slack_set(&dwork->timeout, slack);
 	z_add_timeout(&dwork->timeout, work_timeout, delay);
 
 	return ret;
@@ -961,7 +1288,8 @@ int k_work_schedule_for_queue(struct k_work_q *queue,
 
 	/* Schedule the work item if it's idle or running. */
 	if ((work_busy_get_locked(work) & ~K_WORK_RUNNING) == 0U) {
-		ret = schedule_for_queue_locked(&queue, dwork, delay);
+		ret = schedule_for_queue_locked(&queue, dwork, delay,
+						K_NO_WAIT);
 	}
 
 	k_spin_unlock(&lock, key);
@@ -998,7 +1326,7 @@ int k_work_reschedule_for_queue(struct k_work_q *queue,
 	(void)unschedule_locked(dwork);
 
 	/* Schedule the work item with the new parameters. */
-	ret = schedule_for_queue_locked(&queue, dwork, delay);
+	ret = schedule_for_queue_locked(&queue, dwork, delay, K_NO_WAIT);
 
 	k_spin_unlock(&lock, key);
 
@@ -1019,6 +1347,42 @@ int k_work_reschedule(struct k_work_delayable *dwork,
 	return ret;
 }
 
+int k_work_schedule_slack(struct k_work_delayable *dwork,
+			  k_timeout_t delay, k_timeout_t slack)
+{
+	__ASSERT_NO_MSG(dwork != NULL);
+
+	struct k_work *work = &dwork->work;
+	struct k_work_q *queue = &k_sys_work_q;
+	int ret = 0;
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	if ((work_busy_get_locked(work) & ~K_WORK_RUNNING) == 0U) {
+		ret = schedule_for_queue_locked(&queue, dwork, delay, slack);
+	}
+
+	k_spin_unlock(&lock, key);
+
+	return ret;
+}
+
+int k_work_reschedule_slack(struct k_work_delayable *dwork,
+			    k_timeout_t delay, k_timeout_t slack)
+{
+	__ASSERT_NO_MSG(dwork != NULL);
+
+	struct k_work_q *queue = &k_sys_work_q;
+	int ret = 0;
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	(void)unschedule_locked(dwork);
+	ret = schedule_for_queue_locked(&queue, dwork, delay, slack);
+
+	k_spin_unlock(&lock, key);
+
+	return ret;
+}
+
 int k_work_cancel_delayable(struct k_work_delayable *dwork)
 {
 	__ASSERT_NO_MSG(dwork != NULL);
@@ -9,6 +9,7 @@
 #include <zephyr/kernel.h>
 #include <kernel_internal.h>
 #include <zephyr/linker/linker-defs.h>
+#include <kernel_boot_profile.h>
 
 #ifdef CONFIG_STACK_CANARIES
 #ifdef CONFIG_STACK_CANARIES_TLS
@@ -25,6 +26,8 @@ extern volatile uintptr_t __stack_chk_guard;
  */
 void z_data_copy(void)
 {
+	int slot = z_boot_profile_enter(BOOT_PROFILE_DATA_COPY, 0, NULL);
+
 	z_early_memcpy(&__data_region_start, &__data_region_load_start,
 		       __data_region_end - __data_region_start);
 #ifdef CONFIG_ARCH_HAS_RAMFUNC_SUPPORT
@@ -72,4 +75,6 @@ void z_data_copy(void)
 		       _app_smem_end - _app_smem_start);
 #endif /* CONFIG_STACK_CANARIES */
 #endif /* CONFIG_USERSPACE */
+
+	z_boot_profile_exit(slot);
 }
@@ -0,0 +1,340 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <zephyr/sys/hash_map.h>
+#include <zephyr/sys/hash_map_oa_rh.h>
+#include <zephyr/sys/util.h>
+
+struct oarh_entry {
+	uint64_t key;
+	uint64_t value;
+	/* Distance to the ideal bucket plus one, zero for an unused bucket */
+	uint32_t dib;
+};
+
+BUILD_ASSERT(offsetof(struct sys_hashmap_oa_rh_data, buckets) ==
+	     offsetof(struct sys_hashmap_data, buckets));
+BUILD_ASSERT(offsetof(struct sys_hashmap_oa_rh_data, n_buckets) ==
+	     offsetof(struct sys_hashmap_data, n_buckets));
+BUILD_ASSERT(offsetof(struct sys_hashmap_oa_rh_data, size) ==
+	     offsetof(struct sys_hashmap_data, size));
+
+static struct oarh_entry *sys_hashmap_oa_rh_find(const struct sys_hashmap *map, uint64_t key)
+{
+	struct oarh_entry *entry;
+	const size_t n_buckets = map->data->n_buckets;
+	struct oarh_entry *const buckets = map->data->buckets;
+
+	if (n_buckets == 0) {
+		return NULL;
+	}
+
+	for (uint32_t dib = 1, j = map->hash_func(&key, sizeof(key));; ++dib, ++j) {
+		j &= (n_buckets - 1);
+		entry = &buckets[j];
+
+		/*
+		 * Past an entry closer to its ideal bucket than the key would be, the key would
+		 * have taken its bucket when inserted.
+		 */
+		if (entry->dib < dib) {
+			return NULL;
+		}
+
+		if (entry->key == key) {
+			return entry;
+		}
+	}
+}
+
+static void sys_hashmap_oa_rh_insert_new(struct sys_hashmap *map, uint64_t key, uint64_t value)
+{
+	struct oarh_entry tmp;
+	struct oarh_entry *entry;
+	struct sys_hashmap_oa_rh_data *data = (struct sys_hashmap_oa_rh_data *)map->data;
+	const size_t n_buckets = data->n_buckets;
+	struct oarh_entry *const buckets = data->buckets;
+	struct oarh_entry ins = {
+		.key = key,
+		.value = value,
+		.dib = 1,
+	};
+
+	__ASSERT_NO_MSG(data->size < n_buckets);
+
+	for (size_t j = map->hash_func(&key, sizeof(key));; ++j, ++ins.dib) {
+		j &= (n_buckets - 1);
+		entry = &buckets[j];
+
+		if (entry->dib == 0) {
+			*entry = ins;
+			++data->size;
+			return;
+		}
+
+		/* Take the bucket of an entry closer to its ideal bucket, and carry on with it */
+		if (entry->dib < ins.dib) {
+			tmp = *entry;
+			*entry = ins;
+			ins = tmp;
+		}
+	}
+}
+
+static int sys_hashmap_oa_rh_resize(struct sys_hashmap *map, size_t new_n_buckets)
+{
+	size_t old_size;
+	size_t old_n_buckets;
+	struct oarh_entry *entry;
+	struct oarh_entry *old_buckets;
+	struct oarh_entry *new_buckets;
+	struct sys_hashmap_oa_rh_data *data = (struct sys_hashmap_oa_rh_data *)map->data;
+
+	old_size = data->size;
+	old_n_buckets = data->n_buckets;
+	old_buckets = (struct oarh_entry *)data->buckets;
+
+	new_buckets = (struct oarh_entry *)map->alloc_func(NULL, new_n_buckets * sizeof(*entry));
+	if (new_buckets == NULL && new_n_buckets != 0) {
+		return -ENOMEM;
+	}
+
+	if (new_buckets != NULL) {
+		/* ensure all buckets are empty / initialized */
+		memset(new_buckets, 0, new_n_buckets * sizeof(*new_buckets));
+	}
+
+	data->size = 0;
+	data->buckets = new_buckets;
+	data->n_buckets = new_n_buckets;
+
+	/* re-insert all entries into the hashmap */
+	for (size_t i = 0, j = 0; i < old_n_buckets && j < old_size; ++i) {
+		entry = &old_buckets[i];
+
+		if (entry->dib != 0) {
+			sys_hashmap_oa_rh_insert_new(map, entry->key, entry->value);
+			++j;
+		}
+	}
+
+	/* free the old Hashmap */
+	map->alloc_func(old_buckets, 0);
+
+	return 0;
+}
+
+static int sys_hashmap_oa_rh_rehash(struct sys_hashmap *map, bool grow)
+{
+	size_t new_n_buckets = 0;
+	struct sys_hashmap_oa_rh_data *data = (struct sys_hashmap_oa_rh_data *)map->data;
+
+	if (!sys_hashmap_should_rehash(map, grow, 0, &new_n_buckets)) {
+		return 0;
+	}
+
+	/* keep the reserved buckets */
+	if (!grow && new_n_buckets < data->min_n_buckets) {
+		return 0;
+	}
+
+	if (map->data->size != SIZE_MAX && map->data->size == map->config->max_size) {
+		return -ENOSPC;
+	}
+
+	return sys_hashmap_oa_rh_resize(map, new_n_buckets);
+}
+
+static void sys_hashmap_oa_rh_iter_next(struct sys_hashmap_iterator *it)
+{
+	size_t i;
+	struct oarh_entry *entry;
+	const struct sys_hashmap *map = (const struct sys_hashmap *)it->map;
+	struct oarh_entry *buckets = map->data->buckets;
+
+	__ASSERT(it->size == map->data->size, "Concurrent modification!");
+	__ASSERT(sys_hashmap_iterator_has_next(it), "Attempt to access beyond current bound!");
+
+	if (it->pos == 0) {
+		it->state = buckets;
+	}
+
+	i = (struct oarh_entry *)it->state - buckets;
+	__ASSERT(i < map->data->n_buckets, "Invalid iterator state %p", it->state);
+
+	for (; i < map->data->n_buckets; ++i) {
+		entry = &buckets[i];
+		if (entry->dib != 0) {
+			it->state = &buckets[i + 1];
+			it->key = entry->key;
+			it->value = entry->value;
+			++it->pos;
+			return;
+		}
+	}
+
+	__ASSERT(false, "Entire Hashmap traversed and no entry was found");
+}
+
+/*
+ * Open Addressing / Robin Hood Hashmap API
+ */
+
+static void sys_hashmap_oa_rh_iter(const struct sys_hashmap *map, struct sys_hashmap_iterator *it)
+{
+	it->map = map;
+	it->next = sys_hashmap_oa_rh_iter_next;
+	it->pos = 0;
+	*((size_t *)&it->size) = map->data->size;
+}
+
+static void sys_hashmap_oa_rh_clear(struct sys_hashmap *map, sys_hashmap_callback_t cb,
+				    void *cookie)
+{
+	struct oarh_entry *entry;
+	struct sys_hashmap_oa_rh_data *data = (struct sys_hashmap_oa_rh_data *)map->data;
+	struct oarh_entry *buckets = data->buckets;
+
+	for (size_t i = 0, j = 0; cb != NULL && i < data->n_buckets && j < data->size; ++i) {
+		entry = &buckets[i];
+		if (entry->dib != 0) {
+			cb(entry->key, entry->value, cookie);
+			++j;
+		}
+	}
+
+	if (data->buckets != NULL) {
+		map->alloc_func(data->buckets, 0);
+		data->buckets = NULL;
+	}
+
+	data->n_buckets = 0;
+	data->size = 0;
+	data->min_n_buckets = 0;
+}
+
+static int sys_hashmap_oa_rh_insert(struct sys_hashmap *map, uint64_t key, uint64_t value,
+				    uint64_t *old_value)
+{
+	int ret;
+	struct oarh_entry *entry;
+
+	entry = sys_hashmap_oa_rh_find(map, key);
+	if (entry != NULL) {
+		if (old_value != NULL) {
+			*old_value = entry->value;
+		}
+
+		entry->value = value;
+
+		return 0;
+	}
+
+	ret = sys_hashmap_oa_rh_rehash(map, true);
+	if (ret < 0) {
+		return ret;
+	}
+
+	sys_hashmap_oa_rh_insert_new(map, key, value);
+
+	return 1;
+}
+
+static bool sys_hashmap_oa_rh_remove(struct sys_hashmap *map, uint64_t key, uint64_t *value)
+{
+	struct oarh_entry *entry;
+	struct oarh_entry *next;
+	struct sys_hashmap_oa_rh_data *data = (struct sys_hashmap_oa_rh_data *)map->data;
+	const size_t n_buckets = data->n_buckets;
+	struct oarh_entry *const buckets = data->buckets;
+
+	entry = sys_hashmap_oa_rh_find(map, key);
+	if (entry == NULL) {
+		return false;
+	}
+
+	if (value != NULL) {
+		*value = entry->value;
+	}
+
+	/* Shift back the following entries, up to an unused one or one in its ideal bucket */
+	for (size_t j = entry - buckets + 1;; ++j) {
+		next = &buckets[j & (n_buckets - 1)];
+		if (next->dib <= 1) {
+			break;
+		}
+
+		*entry = *next;
+		--entry->dib;
+		entry = next;
+	}
+
+	entry->dib = 0;
+	--data->size;
+
+	/* ignore a possible -ENOMEM since the table will remain intact */
+	(void)sys_hashmap_oa_rh_rehash(map, false);
+
+	return true;
+}
+
+static bool sys_hashmap_oa_rh_get(const struct sys_hashmap *map, uint64_t key, uint64_t *value)
+{
+	struct oarh_entry *entry;
+
+	entry = sys_hashmap_oa_rh_find(map, key);
+	if (entry == NULL) {
+		return false;
+	}
+
+	if (value != NULL) {
+		*value = entry->value;
+	}
+
+	return true;
+}
+
+int sys_hashmap_oa_rh_reserve(struct sys_hashmap *map, size_t n_entries)
+{
+	int ret;
+	size_t n_buckets = 1;
+	struct sys_hashmap_oa_rh_data *data = (struct sys_hashmap_oa_rh_data *)map->data;
+
+	if (n_entries > map->config->max_size || n_entries >= SIZE_MAX / 100) {
+		return -EINVAL;
+	}
+
+	/* smallest power of two keeping n_entries within the load factor */
+	while (n_buckets * map->config->load_factor < n_entries * 100) {
+		n_buckets <<= 1;
+	}
+
+	if (n_buckets > data->n_buckets) {
+		ret = sys_hashmap_oa_rh_resize(map, n_buckets);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	data->min_n_buckets = MAX(data->min_n_buckets, n_buckets);
+
+	return 0;
+}
+
+const struct sys_hashmap_api sys_hashmap_oa_rh_api = {
+	.iter = sys_hashmap_oa_rh_iter,
+	.clear = sys_hashmap_oa_rh_clear,
+	.insert = sys_hashmap_oa_rh_insert,
+	.remove = sys_hashmap_oa_rh_remove,
+	.get = sys_hashmap_oa_rh_get,
+};
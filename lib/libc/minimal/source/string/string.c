@@ -106,14 +106,42 @@ char *strrchr(const char *s, int c)
 
 size_t strlen(const char *s)
 {
-	size_t n = 0;
+	const char *start = s;
+
+#if !defined(CONFIG_MINIMAL_LIBC_OPTIMIZE_STRING_FOR_SIZE)
+	const uintptr_t mask = sizeof(mem_word_t) - 1;
+	const mem_word_t ones = (mem_word_t)-1 / 0xff;
+	const mem_word_t highs = ones << 7;
+
+	/* do byte-sized scanning until word-aligned or finished */
+
+	while (((uintptr_t)s) & mask) {
+		if (*s == '\0') {
+			return s - start;
+		}
+		s++;
+	}
+
+	/* do word-sized scanning until a word holds a null byte, an aligned
+	 * word never spans past the memory holding the string
+	 */
+
+	const mem_word_t *s_word = (const mem_word_t *)s;
+
+	while (((*s_word - ones) & ~*s_word & highs) == 0) {
+		s_word++;
+	}
+
+	s = (const char *)s_word;
+#endif
+
+	/* do byte-sized scanning until finished */
 
 	while (*s != '\0') {
 		s++;
-		n++;
 	}
 
-	return n;
+	return s - start;
 }
 
 /**
@@ -226,6 +254,40 @@ int memcmp(const void *m1, const void *m2, size_t n)
 		return 0;
 	}
 
+#if !defined(CONFIG_MINIMAL_LIBC_OPTIMIZE_STRING_FOR_SIZE)
+	const uintptr_t mask = sizeof(mem_word_t) - 1;
+
+	if ((((uintptr_t)c1 ^ (uintptr_t)c2) & mask) == 0) {
+
+		/* do byte-sized comparison until word-aligned */
+
+		while (((uintptr_t)c1) & mask) {
+			if ((n == 1) || (*c1 != *c2)) {
+				return *c1 - *c2;
+			}
+			c1++;
+			c2++;
+			n--;
+		}
+
+		/* skip the equal words, leaving at least one byte for the
+		 * byte-sized comparison to find the difference in
+		 */
+
+		const mem_word_t *w1 = (const mem_word_t *)c1;
+		const mem_word_t *w2 = (const mem_word_t *)c2;
+
+		while ((n > sizeof(mem_word_t)) && (*w1 == *w2)) {
+			w1++;
+			w2++;
+			n -= sizeof(mem_word_t);
+		}
+
+		c1 = (const char *)w1;
+		c2 = (const char *)w2;
+	}
+#endif
+
 	while ((--n > 0) && (*c1 == *c2)) {
 		c1++;
 		c2++;
@@ -278,7 +340,9 @@ void *memmove(void *d, const void *s, size_t n)
 
 void *memcpy(void *ZRESTRICT d, const void *ZRESTRICT s, size_t n)
 {
-	/* attempt word-sized copying only if buffers have identical alignment */
+	/* copy word-sized chunks whenever the buffers are long enough, shifting
+	 * the source words into place when the buffers have different alignment
+	 */
 
 	unsigned char *d_byte = (unsigned char *)d;
 	const unsigned char *s_byte = (const unsigned char *)s;
@@ -298,11 +362,29 @@ void *memcpy(void *ZRESTRICT d, const void *ZRESTRICT s, size_t n)
 			n--;
 		}
 
-		/* do word-sized copying as long as possible */
+		/* do word-sized copying as long as possible, four words at a
+		 * time so that the compiler can use multi-register loads and
+		 * stores
+		 */
 
 		mem_word_t *d_word = (mem_word_t *)d_byte;
 		const mem_word_t *s_word = (const mem_word_t *)s_byte;
 
+		while (n >= 4 * sizeof(mem_word_t)) {
+			mem_word_t w0 = s_word[0];
+			mem_word_t w1 = s_word[1];
+			mem_word_t w2 = s_word[2];
+			mem_word_t w3 = s_word[3];
+
+			d_word[0] = w0;
+			d_word[1] = w1;
+			d_word[2] = w2;
+			d_word[3] = w3;
+			d_word += 4;
+			s_word += 4;
+			n -= 4 * sizeof(mem_word_t);
+		}
+
 		while (n >= sizeof(mem_word_t)) {
 			*(d_word++) = *(s_word++);
 			n -= sizeof(mem_word_t);
@@ -310,6 +392,43 @@ void *memcpy(void *ZRESTRICT d, const void *ZRESTRICT s, size_t n)
 
 		d_byte = (unsigned char *)d_word;
 		s_byte = (unsigned char *)s_word;
+	} else if (n >= 2 * sizeof(mem_word_t)) {
+
+		/* do byte-sized copying until the destination is word-aligned */
+
+		while (((uintptr_t)d_byte) & mask) {
+			*(d_byte++) = *(s_byte++);
+			n--;
+		}
+
+		/* then build each destination word from the two aligned
+		 * source words it straddles. Aligned words never span past
+		 * the memory holding the source, the last one being only
+		 * read when it holds a byte still to copy.
+		 */
+
+		const unsigned int shift = ((uintptr_t)s_byte & mask) * 8;
+		mem_word_t *d_word = (mem_word_t *)d_byte;
+		const mem_word_t *s_word =
+			(const mem_word_t *)((uintptr_t)s_byte & ~mask);
+		mem_word_t lo = *(s_word++);
+
+		while (n >= sizeof(mem_word_t)) {
+			mem_word_t hi = *(s_word++);
+
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+			*(d_word++) = (lo >> shift) |
+				      (hi << (Z_MEM_WORD_T_WIDTH - shift));
+#else
+			*(d_word++) = (lo << shift) |
+				      (hi >> (Z_MEM_WORD_T_WIDTH - shift));
+#endif
+			lo = hi;
+			s_byte += sizeof(mem_word_t);
+			n -= sizeof(mem_word_t);
+		}
+
+		d_byte = (unsigned char *)d_word;
 	}
 #endif
 
@@ -357,6 +476,15 @@ void *memset(void *buf, int c, size_t n)
 	c_word |= c_word << 32;
 #endif
 
+	while (n >= 4 * sizeof(mem_word_t)) {
+		d_word[0] = c_word;
+		d_word[1] = c_word;
+		d_word[2] = c_word;
+		d_word[3] = c_word;
+		d_word += 4;
+		n -= 4 * sizeof(mem_word_t);
+	}
+
 	while (n >= sizeof(mem_word_t)) {
 		*(d_word++) = c_word;
 		n -= sizeof(mem_word_t);
@@ -19,6 +19,11 @@
 #include <zephyr/sys/util.h>
 #include <zephyr/sys/cbprintf.h>
 
+#ifdef CONFIG_CBPRINTF_FORMAT_PLAN_CACHE
+#include <zephyr/sys/atomic.h>
+#include <zephyr/linker/utils.h>
+#endif
+
 /* newlib doesn't declare this function unless __POSIX_VISIBLE >= 200809.  No
  * idea how to make that happen, so lets put it right here.
  */
@@ -665,6 +670,149 @@ static inline const char *extract_conversion(struct conversion *conv,
 	return sp;
 }
 
+#ifdef CONFIG_CBPRINTF_FORMAT_PLAN_CACHE
+
+/* Conversions of a format string, in the order they appear.
+ *
+ * An entry is claimed by the first format string using it and is never
+ * reused, so that it can be read without a lock once ready.
+ */
+struct format_plan {
+	atomic_t state;
+	const char *fmt;
+	uint8_t count;
+	struct {
+		struct conversion conv;
+		/* Length of the conversion specification */
+		uint8_t len;
+	} steps[CONFIG_CBPRINTF_FORMAT_PLAN_CONVERSIONS];
+};
+
+enum format_plan_state {
+	FORMAT_PLAN_EMPTY,
+	FORMAT_PLAN_BUILDING,
+	FORMAT_PLAN_READY,
+};
+
+static struct format_plan format_plans[CONFIG_CBPRINTF_FORMAT_PLAN_CACHE_SIZE];
+
+/* Only the format strings which cannot change are planned. */
+static inline bool format_is_const(const char *fmt)
+{
+#if defined(CBPRINTF_VIA_UNIT_TEST)
+	/* The host does not use Zephyr linker scripts, the unit test may
+	 * tell where its read-only data is.
+	 */
+#ifdef CBPRINTF_TEST_FORMAT_IS_CONST
+	return CBPRINTF_TEST_FORMAT_IS_CONST(fmt);
+#else
+	return false;
+#endif
+#else
+	return linker_is_in_rodata(fmt);
+#endif
+}
+
+static void format_plan_build(struct format_plan *plan, const char *fmt)
+{
+	const char *sp = fmt;
+	const char *ep;
+	uint8_t count = 0;
+
+	plan->fmt = fmt;
+
+	while ((*sp != 0) && (count < ARRAY_SIZE(plan->steps))) {
+		if (*sp != '%') {
+			++sp;
+			continue;
+		}
+
+		ep = extract_conversion(&plan->steps[count].conv, sp);
+		if ((ep - sp) > UINT8_MAX) {
+			/* Left for the formatter to parse, as the next ones */
+			break;
+		}
+
+		plan->steps[count].len = (uint8_t)(ep - sp);
+		++count;
+		sp = ep;
+	}
+
+	plan->count = count;
+}
+
+/* Get the plan of a format string, built on first use.
+ *
+ * @return the plan, or NULL if the format string is not planned.
+ */
+static const struct format_plan *format_plan_get(const char *fmt)
+{
+	uintptr_t addr = (uintptr_t)fmt;
+	struct format_plan *plan;
+
+	if (!format_is_const(fmt)) {
+		return NULL;
+	}
+
+	plan = &format_plans[(addr ^ (addr >> 8)) % ARRAY_SIZE(format_plans)];
+
+	if (atomic_get(&plan->state) == FORMAT_PLAN_READY) {
+		return (plan->fmt == fmt) ? plan : NULL;
+	}
+
+	/* Another context may be building it, the format is parsed then */
+	if (!atomic_cas(&plan->state, FORMAT_PLAN_EMPTY,
+			FORMAT_PLAN_BUILDING)) {
+		return NULL;
+	}
+
+	format_plan_build(plan, fmt);
+	atomic_set(&plan->state, FORMAT_PLAN_READY);
+
+	return plan;
+}
+
+/* Get the conversion specification at @p sp, the @p idx one of the format.
+ *
+ * @return pointer to the first character that follows the specification.
+ */
+static inline const char *next_conversion(const struct format_plan *plan,
+					  size_t idx,
+					  struct conversion *conv,
+					  const char *sp)
+{
+	if ((plan != NULL) && (idx < plan->count)) {
+		*conv = plan->steps[idx].conv;
+		return sp + plan->steps[idx].len;
+	}
+
+	return extract_conversion(conv, sp);
+}
+
+#else /* CONFIG_CBPRINTF_FORMAT_PLAN_CACHE */
+
+struct format_plan;
+
+static inline const struct format_plan *format_plan_get(const char *fmt)
+{
+	ARG_UNUSED(fmt);
+
+	return NULL;
+}
+
+static inline const char *next_conversion(const struct format_plan *plan,
+					  size_t idx,
+					  struct conversion *conv,
+					  const char *sp)
+{
+	ARG_UNUSED(plan);
+	ARG_UNUSED(idx);
+
+	return extract_conversion(conv, sp);
+}
+
+#endif /* CONFIG_CBPRINTF_FORMAT_PLAN_CACHE */
+
 #ifdef CONFIG_64BIT
 
 static void _ldiv5(uint64_t *v)
@@ -1341,6 +1489,8 @@ int z_cbvprintf_impl(cbprintf_cb out, void *ctx, const char *fp,
 	char buf[CONVERTED_BUFLEN];
 	size_t count = 0;
 	sint_value_type sint;
+	const struct format_plan *plan = format_plan_get(fp);
+	size_t conv_idx = 0;
 
 	const bool tagged_ap = (flags & Z_CBVPRINTF_PROCESS_FLAG_TAGGED_ARGS)
 			       == Z_CBVPRINTF_PROCESS_FLAG_TAGGED_ARGS;
@@ -1406,7 +1556,7 @@ int z_cbvprintf_impl(cbprintf_cb out, void *ctx, const char *fp,
 		const char *bpe = buf + sizeof(buf);
 		char sign = 0;
 
-		fp = extract_conversion(conv, sp);
+		fp = next_conversion(plan, conv_idx++, conv, sp);
 
 		/* If dynamic width is specified, process it,
 		 * otherwise set width if present.
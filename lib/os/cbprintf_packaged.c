@@ -905,6 +905,37 @@ bool is_ptr(const char *fmt, int n)
 	return false;
 }
 
+/* Function gets the bit mask of the pointer (%p) arguments among the 32 first
+ * ones, scanning the format once for all the string arguments of a package.
+ */
+static uint32_t ptr_args_mask(const char *fmt)
+{
+	char c;
+	bool mod = false;
+	int cnt = 0;
+	uint32_t mask = 0;
+
+	while (((c = *fmt++) != '\0') && (cnt < 32)) {
+		if (mod && is_fmt_spec(c)) {
+			if (c == 'p') {
+				mask |= BIT(cnt);
+			}
+			cnt++;
+			mod = false;
+		}
+		if (c == '%') {
+			mod = !mod;
+		}
+	}
+
+	return mask;
+}
+
+static inline bool arg_is_ptr(const char *fmt, uint32_t ptr_mask, uint8_t arg_idx)
+{
+	return (arg_idx < 32) ? ((ptr_mask & BIT(arg_idx)) != 0) : is_ptr(fmt, arg_idx);
+}
+
 int cbprintf_package_convert(void *in_packaged,
 			     size_t in_len,
 			     cbprintf_convert_cb cb,
@@ -965,6 +996,7 @@ int cbprintf_package_convert(void *in_packaged,
 	const char *fmt = *(const char **)(buf + sizeof(void *));
 	uint8_t *str_pos = &buf[args_size];
 	size_t strl_cnt = 0;
+	uint32_t ptr_mask = (fmt_present && rws_nbr > 0) ? ptr_args_mask(fmt) : 0;
 
 	/* If null destination, just calculate output length. */
 	if (cb == NULL) {
@@ -999,7 +1031,7 @@ int cbprintf_package_convert(void *in_packaged,
 			bool is_ro = ptr_in_rodata(str);
 			int len;
 
-			if (fmt_present && is_ptr(fmt, arg_idx)) {
+			if (fmt_present && arg_is_ptr(fmt, ptr_mask, arg_idx)) {
 				LOG_WRN("(unsigned) char * used for %%p argument. "
 					"It's recommended to cast it to void * because "
 					"it may cause misbehavior in certain "
@@ -1077,7 +1109,7 @@ calculate_string_length:
 		const char *str = *(const char **)&buf32[arg_pos];
 		bool is_ro = ptr_in_rodata(str);
 
-		if (fmt_present && is_ptr(fmt, arg_idx)) {
+		if (fmt_present && arg_is_ptr(fmt, ptr_mask, arg_idx)) {
 			continue;
 		}
 
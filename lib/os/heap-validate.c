@@ -83,6 +83,16 @@ static void get_alloc_info(struct z_heap *h, size_t *alloc_bytes,
 			*free_bytes += chunksz_to_bytes(h, chunk_size(h, c));
 		}
 	}
+
+#ifdef CONFIG_SYS_HEAP_SIZE_CLASSES
+	/* Chunks kept by the size classes are marked used but free */
+	for (unsigned int i = 0; i < SIZE_CLASSES; i++) {
+		for (c = h->size_classes[i]; c != 0; c = next_free_chunk(h, c)) {
+			*alloc_bytes -= chunksz_to_bytes(h, chunk_size(h, c));
+			*free_bytes += chunksz_to_bytes(h, chunk_size(h, c));
+		}
+	}
+#endif
 }
 
 bool sys_heap_validate(struct sys_heap *heap)
@@ -102,6 +112,18 @@ bool sys_heap_validate(struct sys_heap *heap)
 		return false;  /* Should have exactly consumed the buffer */
 	}
 
+#ifdef CONFIG_SYS_HEAP_SIZE_CLASSES
+	/* Size class lists must hold valid used chunks of their size */
+	for (unsigned int i = 0; i < SIZE_CLASSES; i++) {
+		for (c = h->size_classes[i]; c != 0; c = next_free_chunk(h, c)) {
+			if (!valid_chunk(h, c) || !chunk_used(h, c) ||
+			    chunk_size(h, c) != i + 1) {
+				return false;
+			}
+		}
+	}
+#endif
+
 #ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
 	/*
 	 * Validate sys_heap_runtime_stats_get API.
@@ -148,6 +148,155 @@ static void free_chunk(struct z_heap *h, chunkid_t c)
 	free_list_add(h, c);
 }
 
+#ifdef CONFIG_SYS_HEAP_SIZE_CLASSES
+static chunkid_t alloc_chunk(struct z_heap *h, chunksz_t sz);
+
+static inline bool is_size_class(chunksz_t sz)
+{
+	return sz <= SIZE_CLASSES;
+}
+
+/* Put a chunk, marked used, on the list of its size class.
+ * Does not update the statistics.
+ */
+static void size_class_push(struct z_heap *h, chunkid_t c)
+{
+	chunkid_t *head = &h->size_classes[chunk_size(h, c) - 1];
+
+	set_next_free_chunk(h, c, *head);
+	*head = c;
+}
+
+/* Carve a run of chunks of the given size out of a single free
+ * chunk.  The first one is returned and the others are put on the
+ * list of the size class.
+ */
+static chunkid_t size_class_carve(struct z_heap *h, chunksz_t sz)
+{
+	chunksz_t run = sz * CONFIG_SYS_HEAP_SIZE_CLASS_CARVE;
+	chunkid_t c;
+
+	if (run >= h->end_chunk) {
+		return 0;
+	}
+
+	c = alloc_chunk(h, run);
+	if (c == 0U) {
+		return 0;
+	}
+
+	if (chunk_size(h, c) > run) {
+		split_chunks(h, c, c + run);
+		free_list_add(h, c + run);
+	}
+
+	for (int i = CONFIG_SYS_HEAP_SIZE_CLASS_CARVE - 1; i > 0; i--) {
+		chunkid_t rc = c + i * sz;
+
+		split_chunks(h, c, rc);
+		set_chunk_used(h, rc, true);
+		size_class_push(h, rc);
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+		h->free_bytes += chunksz_to_bytes(h, sz);
+#endif
+	}
+
+	return c;
+}
+
+/* Take a chunk of the given size from its size class, carving new
+ * ones if the class is empty.
+ *
+ * @return the chunk, or 0 if @p sz has no size class or no memory
+ * could be carved.
+ */
+static chunkid_t size_class_alloc(struct z_heap *h, chunksz_t sz)
+{
+	if (!is_size_class(sz)) {
+		return 0;
+	}
+
+	chunkid_t *head = &h->size_classes[sz - 1];
+	chunkid_t c = *head;
+
+	if (c == 0U) {
+		return size_class_carve(h, sz);
+	}
+
+	*head = next_free_chunk(h, c);
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+	h->free_bytes -= chunksz_to_bytes(h, sz);
+#endif
+
+	return c;
+}
+
+/* Keep a freed chunk on its size class list if it has one. */
+static bool size_class_free(struct z_heap *h, chunkid_t c)
+{
+	if (!is_size_class(chunk_size(h, c))) {
+		return false;
+	}
+
+	size_class_push(h, c);
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+	h->free_bytes += chunksz_to_bytes(h, chunk_size(h, c));
+#endif
+
+	return true;
+}
+
+/* Return all the chunks held by the size classes to the buckets,
+ * merging them with their free neighbors.
+ *
+ * @return true if anything was returned.
+ */
+static bool size_class_flush(struct z_heap *h)
+{
+	bool flushed = false;
+
+	for (unsigned int i = 0; i < SIZE_CLASSES; i++) {
+		while (h->size_classes[i] != 0U) {
+			chunkid_t c = h->size_classes[i];
+
+			h->size_classes[i] = next_free_chunk(h, c);
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+			/* free_chunk() accounts for it again */
+			h->free_bytes -= chunksz_to_bytes(h, chunk_size(h, c));
+#endif
+			set_chunk_used(h, c, false);
+			free_chunk(h, c);
+			flushed = true;
+		}
+	}
+
+	return flushed;
+}
+#else
+static inline chunkid_t size_class_alloc(struct z_heap *h, chunksz_t sz)
+{
+	ARG_UNUSED(h);
+	ARG_UNUSED(sz);
+
+	return 0;
+}
+
+static inline bool size_class_free(struct z_heap *h, chunkid_t c)
+{
+	ARG_UNUSED(h);
+	ARG_UNUSED(c);
+
+	return false;
+}
+
+static inline bool size_class_flush(struct z_heap *h)
+{
+	ARG_UNUSED(h);
+
+	return false;
+}
+#endif /* CONFIG_SYS_HEAP_SIZE_CLASSES */
+
 /*
  * Return the closest chunk ID corresponding to given memory pointer.
  * Here "closest" is only meaningful in the context of sys_heap_aligned_alloc()
@@ -160,7 +309,7 @@ static chunkid_t mem_to_chunkid(struct z_heap *h, void *p)
 	return (mem - chunk_header_bytes(h) - base) / CHUNK_UNIT;
 }
 
-void sys_heap_free(struct sys_heap *heap, void *mem)
+static void heap_free(struct sys_heap *heap, void *mem, bool notify)
 {
 	if (mem == NULL) {
 		return; /* ISO C free() semantics */
@@ -184,19 +333,37 @@ void sys_heap_free(struct sys_heap *heap, void *mem)
 		 "corrupted heap bounds (buffer overflow?) for memory at %p",
 		 mem);
 
-	set_chunk_used(h, c, false);
 #ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
 	h->allocated_bytes -= chunksz_to_bytes(h, chunk_size(h, c));
 #endif
 
 #ifdef CONFIG_SYS_HEAP_LISTENER
-	heap_listener_notify_free(HEAP_ID_FROM_POINTER(heap), mem,
-				  chunksz_to_bytes(h, chunk_size(h, c)));
+	if (notify) {
+		heap_listener_notify_free(HEAP_ID_FROM_POINTER(heap), mem,
+					  chunksz_to_bytes(h, chunk_size(h, c)));
+	}
+#else
+	ARG_UNUSED(notify);
 #endif
 
+	if (size_class_free(h, c)) {
+		return;
+	}
+
+	set_chunk_used(h, c, false);
 	free_chunk(h, c);
 }
 
+void sys_heap_free(struct sys_heap *heap, void *mem)
+{
+	heap_free(heap, mem, true);
+}
+
+void z_sys_heap_free_unnotified(struct sys_heap *heap, void *mem)
+{
+	heap_free(heap, mem, false);
+}
+
 size_t sys_heap_usable_size(struct sys_heap *heap, void *mem)
 {
 	struct z_heap *h = heap->heap;
@@ -270,7 +437,14 @@ void *sys_heap_alloc(struct sys_heap *heap, size_t bytes)
 	}
 
 	chunksz_t chunk_sz = bytes_to_chunksz(h, bytes);
-	chunkid_t c = alloc_chunk(h, chunk_sz);
+	chunkid_t c = size_class_alloc(h, chunk_sz);
+
+	if (c == 0U) {
+		c = alloc_chunk(h, chunk_sz);
+	}
+	if (c == 0U && size_class_flush(h)) {
+		c = alloc_chunk(h, chunk_sz);
+	}
 	if (c == 0U) {
 		return NULL;
 	}
@@ -335,6 +509,9 @@ void *sys_heap_aligned_alloc(struct sys_heap *heap, size_t align, size_t bytes)
 	chunksz_t padded_sz = bytes_to_chunksz(h, bytes + align - gap);
 	chunkid_t c0 = alloc_chunk(h, padded_sz);
 
+	if (c0 == 0 && size_class_flush(h)) {
+		c0 = alloc_chunk(h, padded_sz);
+	}
 	if (c0 == 0) {
 		return NULL;
 	}
@@ -517,6 +694,12 @@ void sys_heap_init(struct sys_heap *heap, void *mem, size_t bytes)
 	h->max_allocated_bytes = 0;
 #endif
 
+#ifdef CONFIG_SYS_HEAP_SIZE_CLASSES
+	for (unsigned int i = 0; i < SIZE_CLASSES; i++) {
+		h->size_classes[i] = 0;
+	}
+#endif
+
 	int nb_buckets = bucket_idx(h, heap_sz) + 1;
 	chunksz_t chunk0_size = chunksz(sizeof(struct z_heap) +
 				     nb_buckets * sizeof(struct z_heap_bucket));
@@ -65,6 +65,17 @@ struct z_heap_bucket {
 	chunkid_t next;
 };
 
+#ifdef CONFIG_SYS_HEAP_SIZE_CLASSES
+/* Small chunks are kept on a per size class list when freed, still
+ * marked used and linked through their FREE_NEXT field, and handed
+ * out again as is without going through the buckets.  There is one
+ * class per chunk size up to the one holding the largest small
+ * allocation with the biggest chunk header.
+ */
+#define SIZE_CLASSES ((CONFIG_SYS_HEAP_SIZE_CLASS_MAX + 8U + CHUNK_UNIT - 1U) / \
+		      CHUNK_UNIT)
+#endif
+
 struct z_heap {
 	chunkid_t chunk0_hdr[2];
 	chunkid_t end_chunk;
@@ -73,6 +84,10 @@ struct z_heap {
 	size_t free_bytes;
 	size_t allocated_bytes;
 	size_t max_allocated_bytes;
+#endif
+#ifdef CONFIG_SYS_HEAP_SIZE_CLASSES
+	/* indexed by chunk size - 1 */
+	chunkid_t size_classes[SIZE_CLASSES];
 #endif
 	struct z_heap_bucket buckets[0];
 };
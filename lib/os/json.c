@@ -8,7 +8,6 @@
 #include <ctype.h>
 #include <errno.h>
 #include <limits.h>
-#include <zephyr/sys/printk.h>
 #include <zephyr/sys/util.h>
 #include <stdbool.h>
 #include <stdlib.h>
@@ -89,11 +88,23 @@ static int peek(struct json_lexer *lex)
 	return chr;
 }
 
+/* Whitespace allowed between the tokens by RFC 8259 */
+static bool is_json_space(int chr)
+{
+	return chr == ' ' || chr == '\n' || chr == '\r' || chr == '\t';
+}
+
 static void *lexer_string(struct json_lexer *lex)
 {
 	ignore(lex);
 
 	while (true) {
+		/* Skip the characters standing for themselves in a tight loop */
+		while (lex->pos < lex->end && *lex->pos != '"' &&
+		       *lex->pos != '\\' && *lex->pos != '\0') {
+			lex->pos++;
+		}
+
 		int chr = next(lex);
 
 		if (chr == '\0') {
@@ -215,6 +226,11 @@ static void *lexer_number(struct json_lexer *lex)
 static void *lexer_json(struct json_lexer *lex)
 {
 	while (true) {
+		while (lex->pos < lex->end && is_json_space(*lex->pos)) {
+			lex->pos++;
+		}
+		ignore(lex);
+
 		int chr = next(lex);
 
 		switch (chr) {
@@ -666,7 +682,9 @@ static int64_t obj_parse(struct json_obj *obj, const struct json_obj_descr *desc
 {
 	struct json_obj_key_value kv;
 	int64_t decoded_fields = 0;
-	size_t i;
+	/* Descriptor expected to match the next key */
+	size_t hint = 0;
+	size_t i, n;
 	int ret;
 
 	while (!obj_next(obj, &kv)) {
@@ -674,7 +692,12 @@ static int64_t obj_parse(struct json_obj *obj, const struct json_obj_descr *desc
 			return decoded_fields;
 		}
 
-		for (i = 0; i < descr_len; i++) {
+		/* The keys usually come in the order of the descriptors, so
+		 * the search starts after the last match and wraps around.
+		 */
+		for (n = 0; n < descr_len; n++) {
+			i = hint + n < descr_len ? hint + n : hint + n - descr_len;
+
 			void *decode_field = (char *)val + descr[i].offset;
 
 			/* Field has been decoded already, skip */
@@ -700,11 +723,12 @@ static int64_t obj_parse(struct json_obj *obj, const struct json_obj_descr *desc
 			}
 
 			decoded_fields |= (int64_t)1<<i;
+			hint = i + 1 < descr_len ? i + 1 : 0;
 			break;
 		}
 
 		/* Skip field, if no descriptor was found */
-		if (i >= descr_len) {
+		if (n >= descr_len) {
 			ret = skip_field(obj, &kv);
 			if (ret < 0) {
 				return ret;
@@ -805,19 +829,24 @@ static int json_escape_internal(const char *str,
 				json_append_bytes_t append_bytes,
 				void *data)
 {
-	const char *cur;
+	const char *cur = str;
+	const char *run;
 	int ret = 0;
 
-	for (cur = str; ret == 0 && *cur; cur++) {
-		char escaped = escape_as(*cur);
-
-		if (escaped) {
-			char bytes[2] = { '\\', escaped };
+	while (ret == 0 && *cur) {
+		/* Append the characters not to escape in a single call */
+		for (run = cur; *cur && !escape_as(*cur); cur++) {
+		}
 
-			ret = append_bytes(bytes, 2, data);
-		} else {
-			ret = append_bytes(cur, 1, data);
+		if (cur != run) {
+			ret = append_bytes(run, (size_t)(cur - run), data);
+			continue;
 		}
+
+		char bytes[2] = { '\\', escape_as(*cur) };
+
+		ret = append_bytes(bytes, 2, data);
+		cur++;
 	}
 
 	return ret;
@@ -964,17 +993,21 @@ static int num_encode(const int32_t *num, json_append_bytes_t append_bytes,
 		      void *data)
 {
 	char buf[3 * sizeof(int32_t)];
-	int ret;
+	char *digit = &buf[sizeof(buf)];
+	/* Negated as unsigned, INT32_MIN has no positive counterpart */
+	uint32_t value = *num < 0 ? 0U - (uint32_t)*num : (uint32_t)*num;
 
-	ret = snprintk(buf, sizeof(buf), "%d", *num);
-	if (ret < 0) {
-		return ret;
-	}
-	if (ret >= (int)sizeof(buf)) {
-		return -ENOMEM;
+	/* Written backwards from the end of the buffer, cheaper than snprintk() */
+	do {
+		*--digit = '0' + value % 10U;
+		value /= 10U;
+	} while (value != 0U);
+
+	if (*num < 0) {
+		*--digit = '-';
 	}
 
-	return append_bytes(buf, (size_t)ret, data);
+	return append_bytes(digit, (size_t)(&buf[sizeof(buf)] - digit), data);
 }
 
 static int float_ascii_encode(struct json_obj_token *num, json_append_bytes_t append_bytes,
@@ -1054,13 +1087,18 @@ int json_obj_encode(const struct json_obj_descr *descr, size_t descr_len,
 	}
 
 	for (i = 0; i < descr_len; i++) {
-		ret = str_encode((const char **)&descr[i].field_name,
-				 append_bytes, data);
+		/* Unless it has characters to escape, the key takes three appends */
+		ret = append_bytes("\"", 1, data);
+		if (ret < 0) {
+			return ret;
+		}
+
+		ret = json_escape_internal(descr[i].field_name, append_bytes, data);
 		if (ret < 0) {
 			return ret;
 		}
 
-		ret = append_bytes(":", 1, data);
+		ret = append_bytes("\":", 2, data);
 		if (ret < 0) {
 			return ret;
 		}
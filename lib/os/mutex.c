@@ -8,6 +8,11 @@
 #include <zephyr/sys/mutex.h>
 #include <zephyr/syscall_handler.h>
 #include <zephyr/kernel_structs.h>
+#include <kernel_internal.h>
+
+#ifdef CONFIG_SYS_MUTEX_FAST
+__thread struct sys_mutex *z_sys_mutex_cache[CONFIG_SYS_MUTEX_FAST_CACHE_SIZE];
+#endif
 
 static struct k_mutex *get_k_mutex(struct sys_mutex *mutex)
 {
@@ -38,7 +43,11 @@ int z_impl_z_sys_mutex_kernel_lock(struct sys_mutex *mutex, k_timeout_t timeout)
 		return -EINVAL;
 	}
 
+#ifdef CONFIG_SYS_MUTEX_FAST
+	return z_sys_mutex_lock(kernel_mutex, &mutex->val, timeout);
+#else
 	return k_mutex_lock(kernel_mutex, timeout);
+#endif
 }
 
 static inline int z_vrfy_z_sys_mutex_kernel_lock(struct sys_mutex *mutex,
@@ -56,11 +65,19 @@ int z_impl_z_sys_mutex_kernel_unlock(struct sys_mutex *mutex)
 {
 	struct k_mutex *kernel_mutex = get_k_mutex(mutex);
 
+#ifdef CONFIG_SYS_MUTEX_FAST
+	if (kernel_mutex == NULL) {
+		return -EINVAL;
+	}
+
+	return z_sys_mutex_unlock(kernel_mutex, &mutex->val);
+#else
 	if (kernel_mutex == NULL || kernel_mutex->lock_count == 0) {
 		return -EINVAL;
 	}
 
 	return k_mutex_unlock(kernel_mutex);
+#endif
 }
 
 static inline int z_vrfy_z_sys_mutex_kernel_unlock(struct sys_mutex *mutex)
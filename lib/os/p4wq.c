@@ -71,26 +71,85 @@ static inline bool item_lessthan(struct k_p4wq_work *a, struct k_p4wq_work *b)
 	return false;
 }
 
+static inline struct k_p4wq_work *p4wq_max(struct k_p4wq *queue)
+{
+	struct rbnode *r = rb_get_max(&queue->queue);
+
+	return r ? CONTAINER_OF(r, struct k_p4wq_work, rbnode) : NULL;
+}
+
+/* Take the next item to run, from the items this thread batched
+ * unless something more urgent was submitted meanwhile.  When no
+ * other thread is idle, also batch the following items of the same
+ * priority so they don't need to go through the queue again.
+ */
+static struct k_p4wq_work *p4wq_next(struct k_p4wq *queue, sys_dlist_t *batch)
+{
+	struct k_p4wq_work *w = SYS_DLIST_PEEK_HEAD_CONTAINER(batch, w, dlnode);
+	struct k_p4wq_work *max = p4wq_max(queue);
+
+	if (w != NULL && (max == NULL || !item_lessthan(w, max))) {
+		sys_dlist_remove(&w->dlnode);
+		w->batched = false;
+#ifdef CONFIG_P4WQ_STATS
+		queue->stats.batched++;
+#endif
+		return w;
+	}
+
+	if (max == NULL) {
+		return NULL;
+	}
+
+	rb_remove(&queue->queue, &max->rbnode);
+
+#if CONFIG_P4WQ_BATCH_SIZE > 1
+	if (w == NULL && z_waitq_head(&queue->waitq) == NULL) {
+		for (int i = 1; i < CONFIG_P4WQ_BATCH_SIZE; i++) {
+			struct k_p4wq_work *b = p4wq_max(queue);
+
+			if (b == NULL || b->priority != max->priority) {
+				break;
+			}
+
+			rb_remove(&queue->queue, &b->rbnode);
+			b->batched = true;
+			sys_dlist_append(batch, &b->dlnode);
+		}
+	}
+#endif
+
+	return max;
+}
+
 static FUNC_NORETURN void p4wq_loop(void *p0, void *p1, void *p2)
 {
 	ARG_UNUSED(p1);
 	ARG_UNUSED(p2);
 	struct k_p4wq *queue = p0;
-	k_spinlock_key_t k = k_spin_lock(&queue->lock);
+	sys_dlist_t batch;
+	k_spinlock_key_t k;
 
-	while (true) {
-		struct rbnode *r = rb_get_max(&queue->queue);
+	sys_dlist_init(&batch);
+	k = k_spin_lock(&queue->lock);
 
-		if (r) {
-			struct k_p4wq_work *w
-				= CONTAINER_OF(r, struct k_p4wq_work, rbnode);
+	while (true) {
+		struct k_p4wq_work *w = p4wq_next(queue, &batch);
 
-			rb_remove(&queue->queue, r);
+		if (w) {
 			w->thread = _current;
 			sys_dlist_append(&queue->active, &w->dlnode);
 			set_prio(_current, w);
 			thread_clear_requeued(_current);
 
+#ifdef CONFIG_P4WQ_STATS
+			uint32_t wait = k_cycle_get_32() - w->submit_time;
+
+			queue->stats.items++;
+			queue->stats.wait_total += wait;
+			queue->stats.wait_max = MAX(queue->stats.wait_max, wait);
+#endif
+
 			k_spin_unlock(&queue->lock, k);
 
 			w->handler(w);
@@ -214,6 +273,34 @@ void k_p4wq_enable_static_thread(struct k_p4wq *queue, struct k_thread *thread,
  */
 SYS_INIT(static_init, APPLICATION, 99);
 
+/* Wake up an idle thread for the item, if possible one that runs on
+ * the CPUs the item would like.
+ */
+static struct k_thread *p4wq_unpend_thread(struct k_p4wq *queue,
+					   struct k_p4wq_work *item)
+{
+#ifdef CONFIG_SMP
+	struct k_thread *th;
+
+	if (item->cpu_hint != 0U) {
+		_WAIT_Q_FOR_EACH(&queue->waitq, th) {
+#ifdef CONFIG_SCHED_CPU_MASK
+			uint32_t cpus = th->base.cpu_mask;
+#else
+			uint32_t cpus = BIT(th->base.cpu);
+#endif
+
+			if ((cpus & item->cpu_hint) != 0U) {
+				z_unpend_thread(th);
+				return th;
+			}
+		}
+	}
+#endif
+
+	return z_unpend_first_thread(&queue->waitq);
+}
+
 void k_p4wq_submit(struct k_p4wq *queue, struct k_p4wq_work *item)
 {
 	k_spinlock_key_t k = k_spin_lock(&queue->lock);
@@ -222,7 +309,12 @@ void k_p4wq_submit(struct k_p4wq *queue, struct k_p4wq_work *item)
 	 * k_thread_deadline_set()), but we store and use the absolute
 	 * cycle count.
 	 */
-	item->deadline += k_cycle_get_32();
+	uint32_t now = k_cycle_get_32();
+
+	item->deadline += now;
+#ifdef CONFIG_P4WQ_STATS
+	item->submit_time = now;
+#endif
 
 	/* Resubmission from within handler?  Remove from active list */
 	if (item->thread == _current) {
@@ -236,6 +328,7 @@ void k_p4wq_submit(struct k_p4wq *queue, struct k_p4wq_work *item)
 
 	rb_insert(&queue->queue, &item->rbnode);
 	item->queue = queue;
+	item->batched = false;
 
 	/* If there were other items already ahead of it in the queue,
 	 * then we don't need to revisit active thread state and can
@@ -274,7 +367,7 @@ void k_p4wq_submit(struct k_p4wq *queue, struct k_p4wq_work *item)
 	 * error: we are breaking our promise about run order.
 	 * Complain.
 	 */
-	struct k_thread *th = z_unpend_first_thread(&queue->waitq);
+	struct k_thread *th = p4wq_unpend_thread(queue, item);
 
 	if (th == NULL) {
 		LOG_WRN("Out of worker threads, priority guarantee violated");
@@ -299,8 +392,29 @@ bool k_p4wq_cancel(struct k_p4wq *queue, struct k_p4wq_work *item)
 	if (ret) {
 		rb_remove(&queue->queue, &item->rbnode);
 		k_sem_give(&item->done_sem);
+	} else if (item->batched) {
+		sys_dlist_remove(&item->dlnode);
+		item->batched = false;
+		k_sem_give(&item->done_sem);
+		ret = true;
 	}
 
 	k_spin_unlock(&queue->lock, k);
 	return ret;
 }
+
+#ifdef CONFIG_P4WQ_STATS
+void k_p4wq_stats_get(struct k_p4wq *queue, struct k_p4wq_stats *stats)
+{
+	K_SPINLOCK(&queue->lock) {
+		*stats = queue->stats;
+	}
+}
+
+void k_p4wq_stats_reset(struct k_p4wq *queue)
+{
+	K_SPINLOCK(&queue->lock) {
+		queue->stats = (struct k_p4wq_stats) {};
+	}
+}
+#endif
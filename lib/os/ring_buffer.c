@@ -7,8 +7,24 @@
  */
 
 #include <zephyr/sys/ring_buffer.h>
+#include <zephyr/sys/barrier.h>
 #include <string.h>
 
+/*
+ * The producer and the consumer each publish their tail to the other one.
+ * The accesses to the data must not be reordered with the ones to the tails,
+ * which on SMP requires a fence, a reader and a writer being able to run on
+ * different CPUs.
+ */
+static inline void ring_buf_barrier(void)
+{
+	if (IS_ENABLED(CONFIG_SMP)) {
+		barrier_dmem_fence_full();
+	} else {
+		compiler_barrier();
+	}
+}
+
 uint32_t ring_buf_put_claim(struct ring_buf *buf, uint8_t **data, uint32_t size)
 {
 	uint32_t free_space, wrap_size;
@@ -24,6 +40,8 @@ uint32_t ring_buf_put_claim(struct ring_buf *buf, uint8_t **data, uint32_t size)
 	wrap_size = buf->size - wrap_size;
 
 	free_space = ring_buf_space_get(buf);
+	/* the space freed by the consumer is written after it is seen freed */
+	ring_buf_barrier();
 	size = MIN(size, free_space);
 	size = MIN(size, wrap_size);
 
@@ -42,6 +60,8 @@ int ring_buf_put_finish(struct ring_buf *buf, uint32_t size)
 		return -EINVAL;
 	}
 
+	/* the data is written before being published to the consumer */
+	ring_buf_barrier();
 	buf->put_tail += size;
 	buf->put_head = buf->put_tail;
 
@@ -91,6 +111,8 @@ uint32_t ring_buf_get_claim(struct ring_buf *buf, uint8_t **data, uint32_t size)
 	wrap_size = buf->size - wrap_size;
 
 	available_size = ring_buf_size_get(buf);
+	/* the data published by the producer is read after it is seen published */
+	ring_buf_barrier();
 	size = MIN(size, available_size);
 	size = MIN(size, wrap_size);
 
@@ -109,6 +131,8 @@ int ring_buf_get_finish(struct ring_buf *buf, uint32_t size)
 		return -EINVAL;
 	}
 
+	/* the data is read before its space is handed back to the producer */
+	ring_buf_barrier();
 	buf->get_tail += size;
 	buf->get_head = buf->get_tail;
 
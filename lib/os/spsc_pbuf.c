@@ -133,7 +133,21 @@ struct spsc_pbuf *spsc_pbuf_init(void *buf, size_t blen, uint32_t flags)
 	return pb;
 }
 
-int spsc_pbuf_alloc(struct spsc_pbuf *pb, uint16_t len, char **buf)
+/* Index following a packet of @p len bytes stored at @p idx. */
+static uint32_t next_idx(uint32_t pblen, uint32_t idx, uint16_t len)
+{
+	idx += len + LEN_SZ;
+	idx = ROUND_UP(idx, sizeof(uint32_t));
+
+	return idx == pblen ? 0 : idx;
+}
+
+/* Allocate a packet at @p wr_idx. The write index of the buffer is set on a
+ * wrap only if @p publish is set, otherwise the packets allocated before are
+ * not committed yet and the write index is updated when they are.
+ */
+static int alloc_at(struct spsc_pbuf *pb, uint32_t wr_idx, bool publish,
+		    uint16_t len, char **buf)
 {
 	/* Length of the buffer and flags are immutable - avoid reloading. */
 	const uint32_t pblen = pb->common.len;
@@ -152,7 +166,6 @@ int spsc_pbuf_alloc(struct spsc_pbuf *pb, uint16_t len, char **buf)
 	cache_inv(rd_idx_loc, sizeof(*rd_idx_loc), flags);
 	__sync_synchronize();
 
-	uint32_t wr_idx = *wr_idx_loc;
 	uint32_t rd_idx = *rd_idx_loc;
 	int32_t free_space;
 
@@ -182,7 +195,9 @@ int spsc_pbuf_alloc(struct spsc_pbuf *pb, uint16_t len, char **buf)
 			cache_wb(&data_loc[wr_idx], sizeof(uint8_t), flags);
 
 			wr_idx = 0;
-			*wr_idx_loc = wr_idx;
+			if (publish) {
+				*wr_idx_loc = wr_idx;
+			}
 
 			/* Obligatory one word empty space. */
 			free_space = rd_idx - FREE_SPACE_DISTANCE;
@@ -198,31 +213,89 @@ int spsc_pbuf_alloc(struct spsc_pbuf *pb, uint16_t len, char **buf)
 	return len;
 }
 
-void spsc_pbuf_commit(struct spsc_pbuf *pb, uint16_t len)
+int spsc_pbuf_alloc(struct spsc_pbuf *pb, uint16_t len, char **buf)
 {
-	if (len == 0) {
-		return;
+	uint32_t *wr_idx_loc = get_wr_idx_loc(pb, pb->common.flags);
+
+	return alloc_at(pb, *wr_idx_loc, true, len, buf);
+}
+
+int spsc_pbuf_alloc_after(struct spsc_pbuf *pb, const char *prev, uint16_t prev_len,
+			  uint16_t len, char **buf)
+{
+	const uint8_t *data_loc = get_data_loc(pb, pb->common.flags);
+	uint32_t prev_idx;
+
+	if (prev == NULL) {
+		return spsc_pbuf_alloc(pb, len, buf);
 	}
 
+	prev_idx = (const uint8_t *)prev - data_loc - LEN_SZ;
+
+	return alloc_at(pb, next_idx(pb->common.len, prev_idx, prev_len), false, len, buf);
+}
+
+/* Commit the packet stored at @p wr_idx, returns the previous write index. */
+static uint32_t commit_at(struct spsc_pbuf *pb, uint32_t wr_idx, uint16_t len)
+{
 	/* Length of the buffer and flags are immutable - avoid reloading. */
 	const uint32_t pblen = pb->common.len;
 	const uint32_t flags = pb->common.flags;
 	uint32_t *wr_idx_loc = get_wr_idx_loc(pb, flags);
 	uint8_t *data_loc = get_data_loc(pb, flags);
-
-	uint32_t wr_idx = *wr_idx_loc;
+	uint32_t prev_wr_idx = *wr_idx_loc;
 
 	sys_put_be16(len, &data_loc[wr_idx]);
 	__sync_synchronize();
 	cache_wb(&data_loc[wr_idx], len + LEN_SZ, flags);
 
-	wr_idx += len + LEN_SZ;
-	wr_idx = ROUND_UP(wr_idx, sizeof(uint32_t));
-	wr_idx = wr_idx == pblen ? 0 : wr_idx;
-
-	*wr_idx_loc = wr_idx;
+	*wr_idx_loc = next_idx(pblen, wr_idx, len);
 	__sync_synchronize();
 	cache_wb(wr_idx_loc, sizeof(*wr_idx_loc), flags);
+
+	return prev_wr_idx;
+}
+
+void spsc_pbuf_commit(struct spsc_pbuf *pb, uint16_t len)
+{
+	if (len == 0) {
+		return;
+	}
+
+	(void)commit_at(pb, *get_wr_idx_loc(pb, pb->common.flags), len);
+}
+
+bool spsc_pbuf_commit_buf(struct spsc_pbuf *pb, const char *buf, uint16_t len)
+{
+	const uint32_t flags = pb->common.flags;
+	uint32_t *rd_idx_loc = get_rd_idx_loc(pb, flags);
+	uint8_t *data_loc = get_data_loc(pb, flags);
+	uint32_t prev_wr_idx;
+	uint32_t rd_idx;
+
+	if (len == 0) {
+		return false;
+	}
+
+	prev_wr_idx = commit_at(pb, (const uint8_t *)buf - data_loc - LEN_SZ, len);
+
+	/* The read index is loaded after the write index is stored, so either the
+	 * consumer sees the new packet or the index it reached is seen here.
+	 */
+	cache_inv(rd_idx_loc, sizeof(*rd_idx_loc), flags);
+	__sync_synchronize();
+	rd_idx = *rd_idx_loc;
+
+	if (rd_idx == prev_wr_idx) {
+		return true;
+	}
+
+	/* The consumer stopped on a padding a wrap followed, the buffer was empty
+	 * as well.
+	 */
+	cache_inv(&data_loc[rd_idx], sizeof(uint8_t), flags);
+
+	return prev_wr_idx == 0 && data_loc[rd_idx] == PADDING_MARK;
 }
 
 int spsc_pbuf_write(struct spsc_pbuf *pb, const char *buf, uint16_t len)
@@ -15,14 +15,15 @@
 int64_t timespec_to_timeoutms(const struct timespec *abstime);
 
 static struct k_condvar posix_cond_pool[CONFIG_MAX_PTHREAD_COND_COUNT];
+static uint16_t posix_cond_gen[CONFIG_MAX_PTHREAD_COND_COUNT];
 SYS_BITARRAY_DEFINE_STATIC(posix_cond_bitarray, CONFIG_MAX_PTHREAD_COND_COUNT);
 
 /*
  * We reserve the MSB to mark a pthread_cond_t as initialized (from the
- * perspective of the application). With a linear space, this means that
- * the theoretical pthread_cond_t range is [0,2147483647].
+ * perspective of the application), and the bits below for the generation
+ * of the pool slot.
  */
-BUILD_ASSERT(CONFIG_MAX_PTHREAD_COND_COUNT < PTHREAD_OBJ_MASK_INIT,
+BUILD_ASSERT(CONFIG_MAX_PTHREAD_COND_COUNT < PTHREAD_OBJ_MASK_IDX,
 	     "CONFIG_MAX_PTHREAD_COND_COUNT is too high");
 
 static inline size_t posix_cond_to_offset(struct k_condvar *cv)
@@ -32,7 +33,7 @@ static inline size_t posix_cond_to_offset(struct k_condvar *cv)
 
 static inline size_t to_posix_cond_idx(pthread_cond_t cond)
 {
-	return mark_pthread_obj_uninitialized(cond);
+	return posix_obj_idx(cond);
 }
 
 static struct k_condvar *get_posix_cond(pthread_cond_t cond)
@@ -50,7 +51,7 @@ static struct k_condvar *get_posix_cond(pthread_cond_t cond)
 		return NULL;
 	}
 
-	if (actually_initialized == 0) {
+	if (actually_initialized == 0 || posix_cond_gen[bit] != posix_obj_gen(cond)) {
 		/* The cond claims to be initialized but is actually not */
 		return NULL;
 	}
@@ -74,7 +75,7 @@ static struct k_condvar *to_posix_cond(pthread_cond_t *cvar)
 	}
 
 	/* Record the associated posix_cond in mu and mark as initialized */
-	*cvar = mark_pthread_obj_initialized(bit);
+	*cvar = posix_obj_handle(bit, posix_cond_gen[bit]);
 	cv = &posix_cond_pool[bit];
 
 	return cv;
@@ -182,6 +183,7 @@ int pthread_cond_destroy(pthread_cond_t *cvar)
 	}
 
 	bit = posix_cond_to_offset(cv);
+	posix_cond_gen[bit] = posix_obj_gen_next(posix_cond_gen[bit]);
 	err = sys_bitarray_free(&posix_cond_bitarray, 1, bit);
 	__ASSERT_NO_MSG(err == 0);
 
@@ -11,35 +11,33 @@
 #include <zephyr/posix/pthread_key.h>
 #include <zephyr/sys/bitarray.h>
 
-struct pthread_key_data {
-	sys_snode_t node;
-	pthread_thread_data thread_data;
-};
-
-static struct k_spinlock pthread_key_lock;
+typedef struct pthread_key_obj {
+	/* Optional destructor that is passed to pthread_key_create() */
+	void (*destructor)(void *value);
+} pthread_key_obj;
 
 /* This is non-standard (i.e. an implementation detail) */
 #define PTHREAD_KEY_INITIALIZER (-1)
 
 /*
  * We reserve the MSB to mark a pthread_key_t as initialized (from the
- * perspective of the application). With a linear space, this means that
- * the theoretical pthread_key_t range is [0,2147483647].
+ * perspective of the application), and the bits below for the generation
+ * of the pool slot.
+ *
+ * Each thread holds the data of every key, tagged with the generation of
+ * the key when it was set, so that the data of a deleted key is dropped
+ * without visiting the threads.
  */
-BUILD_ASSERT(CONFIG_MAX_PTHREAD_KEY_COUNT < PTHREAD_OBJ_MASK_INIT,
+BUILD_ASSERT(CONFIG_MAX_PTHREAD_KEY_COUNT < PTHREAD_OBJ_MASK_IDX,
 	     "CONFIG_MAX_PTHREAD_KEY_COUNT is too high");
 
 static pthread_key_obj posix_key_pool[CONFIG_MAX_PTHREAD_KEY_COUNT];
+static uint16_t posix_key_gen[CONFIG_MAX_PTHREAD_KEY_COUNT];
 SYS_BITARRAY_DEFINE_STATIC(posix_key_bitarray, CONFIG_MAX_PTHREAD_KEY_COUNT);
 
-static inline size_t posix_key_to_offset(pthread_key_obj *k)
-{
-	return k - posix_key_pool;
-}
-
 static inline size_t to_posix_key_idx(pthread_key_t key)
 {
-	return mark_pthread_obj_uninitialized(key);
+	return posix_obj_idx(key);
 }
 
 static pthread_key_obj *get_posix_key(pthread_key_t key)
@@ -47,7 +45,7 @@ static pthread_key_obj *get_posix_key(pthread_key_t key)
 	int actually_initialized;
 	size_t bit = to_posix_key_idx(key);
 
-	/* if the provided cond does not claim to be initialized, its invalid */
+	/* if the provided key does not claim to be initialized, its invalid */
 	if (!is_pthread_obj_initialized(key)) {
 		return NULL;
 	}
@@ -57,8 +55,8 @@ static pthread_key_obj *get_posix_key(pthread_key_t key)
 		return NULL;
 	}
 
-	if (actually_initialized == 0) {
-		/* The cond claims to be initialized but is actually not */
+	if (actually_initialized == 0 || posix_key_gen[bit] != posix_obj_gen(key)) {
+		/* The key claims to be initialized but is actually not */
 		return NULL;
 	}
 
@@ -80,11 +78,11 @@ static pthread_key_obj *to_posix_key(pthread_key_t *key)
 		return NULL;
 	}
 
-	/* Record the associated posix_cond in mu and mark as initialized */
-	*key = mark_pthread_obj_initialized(bit);
+	/* Record the associated posix_key in key and mark as initialized */
+	*key = posix_obj_handle(bit, posix_key_gen[bit]);
 	k = &posix_key_pool[bit];
 
-	/* Initialize the condition variable here */
+	/* Initialize the key here */
 	memset(k, 0, sizeof(*k));
 
 	return k;
@@ -106,8 +104,6 @@ int pthread_key_create(pthread_key_t *key,
 		return ENOMEM;
 	}
 
-	sys_slist_init(&(new_key->key_data_l));
-
 	new_key->destructor = destructor;
 
 	return 0;
@@ -120,34 +116,18 @@ int pthread_key_create(pthread_key_t *key,
  */
 int pthread_key_delete(pthread_key_t key)
 {
-	pthread_key_obj *key_obj;
-	struct pthread_key_data *key_data;
-	sys_snode_t *node_l, *next_node_l;
-	k_spinlock_key_t key_key;
-
-	key_key = k_spin_lock(&pthread_key_lock);
+	size_t bit;
+	int err;
 
-	key_obj = get_posix_key(key);
-	if (key_obj == NULL) {
-		k_spin_unlock(&pthread_key_lock, key_key);
+	if (get_posix_key(key) == NULL) {
 		return EINVAL;
 	}
 
-	/* Delete thread-specific elements associated with the key */
-	SYS_SLIST_FOR_EACH_NODE_SAFE(&(key_obj->key_data_l),
-			node_l, next_node_l) {
-
-		/* Remove the object from the list key_data_l */
-		key_data = (struct pthread_key_data *)
-			sys_slist_get(&(key_obj->key_data_l));
-
-		/* Deallocate the object's memory */
-		k_free((void *)key_data);
-	}
-
-	(void)sys_bitarray_free(&posix_key_bitarray, 1, 0);
-
-	k_spin_unlock(&pthread_key_lock, key_key);
+	/* The thread-specific data set for the key is no longer valid */
+	bit = to_posix_key_idx(key);
+	posix_key_gen[bit] = posix_obj_gen_next(posix_key_gen[bit]);
+	err = sys_bitarray_free(&posix_key_bitarray, 1, bit);
+	__ASSERT_NO_MSG(err == 0);
 
 	return 0;
 }
@@ -159,66 +139,20 @@ int pthread_key_delete(pthread_key_t key)
  */
 int pthread_setspecific(pthread_key_t key, const void *value)
 {
-	pthread_key_obj *key_obj;
 	struct posix_thread *thread = to_posix_thread(pthread_self());
-	struct pthread_key_data *key_data;
-	pthread_thread_data *thread_spec_data;
-	k_spinlock_key_t key_key;
-	sys_snode_t *node_l;
-	int retval = 0;
-
-	/* Traverse the list of keys set by the thread, looking for key.
-	 * If the key is already in the list, re-assign its value.
-	 * Else add the key to the thread's list.
-	 */
-	key_key = k_spin_lock(&pthread_key_lock);
-
-	key_obj = get_posix_key(key);
-	if (key_obj == NULL) {
-		k_spin_unlock(&pthread_key_lock, key_key);
-		return EINVAL;
-	}
-
-	SYS_SLIST_FOR_EACH_NODE(&(thread->key_list), node_l) {
-
-			thread_spec_data = (pthread_thread_data *)node_l;
-
-			if (thread_spec_data->key == key_obj) {
-
-				/* Key is already present so
-				 * associate thread specific data
-				 */
-				thread_spec_data->spec_data = (void *)value;
-				goto out;
-			}
-	}
-
-	if (node_l == NULL) {
-		key_data = k_malloc(sizeof(struct pthread_key_data));
-
-		if (key_data == NULL) {
-			retval = ENOMEM;
-			goto out;
-
-		} else {
-			/* Associate thread specific data, initialize new key */
-			key_data->thread_data.key = key_obj;
-			key_data->thread_data.spec_data = (void *)value;
-
-			/* Append new thread key data to thread's key list */
-			sys_slist_append((&thread->key_list),
-				(sys_snode_t *)(&key_data->thread_data));
+	struct posix_thread_key_data *data;
+	size_t bit;
 
-			/* Append new key data to the key object's list */
-			sys_slist_append(&(key_obj->key_data_l),
-					(sys_snode_t *)key_data);
-		}
+	if (thread == NULL || get_posix_key(key) == NULL) {
+		return EINVAL;
 	}
 
-out:
-	k_spin_unlock(&pthread_key_lock, key_key);
+	bit = to_posix_key_idx(key);
+	data = &thread->key_data[bit];
+	data->value = (void *)value;
+	data->gen = posix_obj_gen(key);
 
-	return retval;
+	return 0;
 }
 
 /**
@@ -228,35 +162,37 @@ out:
  */
 void *pthread_getspecific(pthread_key_t key)
 {
-	pthread_key_obj *key_obj;
 	struct posix_thread *thread = to_posix_thread(pthread_self());
-	pthread_thread_data *thread_spec_data;
-	void *value = NULL;
-	sys_snode_t *node_l;
-	k_spinlock_key_t key_key;
+	struct posix_thread_key_data *data;
 
-	key_key = k_spin_lock(&pthread_key_lock);
+	if (thread == NULL || get_posix_key(key) == NULL) {
+		return NULL;
+	}
 
-	key_obj = get_posix_key(key);
-	if (key_obj == NULL) {
-		k_spin_unlock(&pthread_key_lock, key_key);
+	data = &thread->key_data[to_posix_key_idx(key)];
+	if (data->gen != posix_obj_gen(key)) {
+		/* Set for a deleted key of the same slot */
 		return NULL;
 	}
 
-	node_l = sys_slist_peek_head(&(thread->key_list));
+	return data->value;
+}
 
-	/* Traverse the list of keys set by the thread, looking for key */
+void posix_thread_key_finalize(struct posix_thread *t)
+{
+	struct posix_thread_key_data *data;
+	pthread_key_obj *key_obj;
+	void *value;
 
-	SYS_SLIST_FOR_EACH_NODE(&(thread->key_list), node_l) {
-		thread_spec_data = (pthread_thread_data *)node_l;
-		if (thread_spec_data->key == key_obj) {
-			/* Key is present, so get the set thread data */
-			value = thread_spec_data->spec_data;
-			break;
+	for (size_t i = 0; i < CONFIG_MAX_PTHREAD_KEY_COUNT; i++) {
+		data = &t->key_data[i];
+		key_obj = get_posix_key(posix_obj_handle(i, data->gen));
+		if (key_obj == NULL || data->value == NULL || key_obj->destructor == NULL) {
+			continue;
 		}
-	}
 
-	k_spin_unlock(&pthread_key_lock, key_key);
-
-	return value;
+		value = data->value;
+		data->value = NULL;
+		(key_obj->destructor)(value);
+	}
 }
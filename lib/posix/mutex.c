@@ -27,14 +27,15 @@ static const struct pthread_mutexattr def_attr = {
 
 static struct k_mutex posix_mutex_pool[CONFIG_MAX_PTHREAD_MUTEX_COUNT];
 static uint8_t posix_mutex_type[CONFIG_MAX_PTHREAD_MUTEX_COUNT];
+static uint16_t posix_mutex_gen[CONFIG_MAX_PTHREAD_MUTEX_COUNT];
 SYS_BITARRAY_DEFINE_STATIC(posix_mutex_bitarray, CONFIG_MAX_PTHREAD_MUTEX_COUNT);
 
 /*
  * We reserve the MSB to mark a pthread_mutex_t as initialized (from the
- * perspective of the application). With a linear space, this means that
- * the theoretical pthread_mutex_t range is [0,2147483647].
+ * perspective of the application), and the bits below for the generation
+ * of the pool slot.
  */
-BUILD_ASSERT(CONFIG_MAX_PTHREAD_MUTEX_COUNT < PTHREAD_OBJ_MASK_INIT,
+BUILD_ASSERT(CONFIG_MAX_PTHREAD_MUTEX_COUNT < PTHREAD_OBJ_MASK_IDX,
 	"CONFIG_MAX_PTHREAD_MUTEX_COUNT is too high");
 
 static inline size_t posix_mutex_to_offset(struct k_mutex *m)
@@ -44,7 +45,7 @@ static inline size_t posix_mutex_to_offset(struct k_mutex *m)
 
 static inline size_t to_posix_mutex_idx(pthread_mutex_t mut)
 {
-	return mark_pthread_obj_uninitialized(mut);
+	return posix_obj_idx(mut);
 }
 
 static struct k_mutex *get_posix_mutex(pthread_mutex_t mu)
@@ -62,7 +63,7 @@ static struct k_mutex *get_posix_mutex(pthread_mutex_t mu)
 		return NULL;
 	}
 
-	if (actually_initialized == 0) {
+	if (actually_initialized == 0 || posix_mutex_gen[bit] != posix_obj_gen(mu)) {
 		/* The mutex claims to be initialized but is actually not */
 		return NULL;
 	}
@@ -87,7 +88,7 @@ struct k_mutex *to_posix_mutex(pthread_mutex_t *mu)
 	}
 
 	/* Record the associated posix_mutex in mu and mark as initialized */
-	*mu = mark_pthread_obj_initialized(bit);
+	*mu = posix_obj_handle(bit, posix_mutex_gen[bit]);
 
 	/* Initialize the posix_mutex */
 	m = &posix_mutex_pool[bit];
@@ -267,6 +268,7 @@ int pthread_mutex_destroy(pthread_mutex_t *mu)
 	}
 
 	bit = to_posix_mutex_idx(*mu);
+	posix_mutex_gen[bit] = posix_obj_gen_next(posix_mutex_gen[bit]);
 	err = sys_bitarray_free(&posix_mutex_bitarray, 1, bit);
 	__ASSERT_NO_MSG(err == 0);
 
@@ -14,6 +14,7 @@
 #include <zephyr/posix/pthread.h>
 #include <zephyr/sys/dlist.h>
 #include <zephyr/sys/slist.h>
+#include <zephyr/sys/util.h>
 
 /*
  * Bit used to mark a pthread object as initialized. Initialization status is
@@ -21,14 +22,35 @@
  */
 #define PTHREAD_OBJ_MASK_INIT 0x80000000
 
+/*
+ * The other bits of the threads, mutexes, conds and keys hold the index of
+ * the object in its pool, and the generation of the pool slot. The generation
+ * changes each time the slot is reused, so that a stale object is rejected
+ * rather than taken for the new one.
+ */
+#define PTHREAD_OBJ_IDX_BITS 16
+#define PTHREAD_OBJ_MASK_IDX BIT_MASK(PTHREAD_OBJ_IDX_BITS)
+#define PTHREAD_OBJ_MASK_GEN ((PTHREAD_OBJ_MASK_INIT - 1) & ~PTHREAD_OBJ_MASK_IDX)
+
+#ifdef CONFIG_PTHREAD_KEY
+struct posix_thread_key_data {
+	/* Value passed to pthread_setspecific() */
+	void *value;
+	/* Generation of the key when the value was set */
+	uint16_t gen;
+};
+#endif
+
 struct posix_thread {
 	struct k_thread thread;
 
 	/* List node for ready_q, run_q, or done_q */
 	sys_dnode_t q_node;
 
-	/* List of keys that thread has called pthread_setspecific() on */
-	sys_slist_t key_list;
+#ifdef CONFIG_PTHREAD_KEY
+	/* Thread-specific data, indexed like the key pool */
+	struct posix_thread_key_data key_data[CONFIG_MAX_PTHREAD_KEY_COUNT];
+#endif
 
 	/* Dynamic stack */
 	k_thread_stack_t *dynamic_stack;
@@ -45,25 +67,10 @@ struct posix_thread {
 
 	/* Queue ID (internal-only) */
 	uint8_t qid;
-};
 
-typedef struct pthread_key_obj {
-	/* List of pthread_key_data objects that contain thread
-	 * specific data for the key
-	 */
-	sys_slist_t key_data_l;
-
-	/* Optional destructor that is passed to pthread_key_create() */
-	void (*destructor)(void *value);
-} pthread_key_obj;
-
-typedef struct pthread_thread_data {
-	sys_snode_t node;
-
-	/* Key and thread specific data passed to pthread_setspecific() */
-	pthread_key_obj *key;
-	void *spec_data;
-} pthread_thread_data;
+	/* Generation of the pool slot */
+	uint16_t gen;
+};
 
 static inline bool is_pthread_obj_initialized(uint32_t obj)
 {
@@ -80,8 +87,35 @@ static inline uint32_t mark_pthread_obj_uninitialized(uint32_t obj)
 	return obj & ~PTHREAD_OBJ_MASK_INIT;
 }
 
+static inline uint32_t posix_obj_handle(size_t idx, uint16_t gen)
+{
+	return mark_pthread_obj_initialized((((uint32_t)gen << PTHREAD_OBJ_IDX_BITS) &
+					     PTHREAD_OBJ_MASK_GEN) | idx);
+}
+
+static inline size_t posix_obj_idx(uint32_t obj)
+{
+	return obj & PTHREAD_OBJ_MASK_IDX;
+}
+
+static inline uint16_t posix_obj_gen(uint32_t obj)
+{
+	return (obj & PTHREAD_OBJ_MASK_GEN) >> PTHREAD_OBJ_IDX_BITS;
+}
+
+/* Next generation of a pool slot, wrapping within the bits of the handle */
+static inline uint16_t posix_obj_gen_next(uint16_t gen)
+{
+	return (gen + 1) & (PTHREAD_OBJ_MASK_GEN >> PTHREAD_OBJ_IDX_BITS);
+}
+
 struct posix_thread *to_posix_thread(pthread_t pth);
 
+#ifdef CONFIG_PTHREAD_KEY
+/* call the destructors of the thread-specific data of an exiting thread */
+void posix_thread_key_finalize(struct posix_thread *t);
+#endif
+
 /* get and possibly initialize a posix_mutex */
 struct k_mutex *to_posix_mutex(pthread_mutex_t *mu);
 
@@ -66,10 +66,11 @@ static const struct pthread_attr init_pthread_attrs = {
 
 /*
  * We reserve the MSB to mark a pthread_t as initialized (from the
- * perspective of the application). With a linear space, this means that
- * the theoretical pthread_t range is [0,2147483647].
+ * perspective of the application), and the bits below for the generation
+ * of the pool slot. The highest index is reserved for the threads which
+ * are not pthreads.
  */
-BUILD_ASSERT(CONFIG_MAX_PTHREAD_COUNT < PTHREAD_OBJ_MASK_INIT,
+BUILD_ASSERT(CONFIG_MAX_PTHREAD_COUNT < PTHREAD_OBJ_MASK_IDX,
 	     "CONFIG_MAX_PTHREAD_COUNT is too high");
 
 static inline size_t posix_thread_to_offset(struct posix_thread *t)
@@ -79,7 +80,7 @@ static inline size_t posix_thread_to_offset(struct posix_thread *t)
 
 static inline size_t get_posix_thread_idx(pthread_t pth)
 {
-	return mark_pthread_obj_uninitialized(pth);
+	return posix_obj_idx(pth);
 }
 
 struct posix_thread *to_posix_thread(pthread_t pthread)
@@ -108,7 +109,8 @@ struct posix_thread *to_posix_thread(pthread_t pthread)
 	 */
 	actually_initialized =
 		!(t->qid == POSIX_THREAD_READY_Q ||
-		  (t->qid == POSIX_THREAD_DONE_Q && t->detachstate == PTHREAD_CREATE_DETACHED));
+		  (t->qid == POSIX_THREAD_DONE_Q && t->detachstate == PTHREAD_CREATE_DETACHED)) &&
+		t->gen == posix_obj_gen(pthread);
 	k_spin_unlock(&pthread_pool_lock, key);
 
 	if (!actually_initialized) {
@@ -126,8 +128,12 @@ pthread_t pthread_self(void)
 
 	t = (struct posix_thread *)CONTAINER_OF(k_current_get(), struct posix_thread, thread);
 	bit = posix_thread_to_offset(t);
+	if (bit >= CONFIG_MAX_PTHREAD_COUNT) {
+		/* not a pthread */
+		return posix_obj_handle(PTHREAD_OBJ_MASK_IDX, 0);
+	}
 
-	return mark_pthread_obj_initialized(bit);
+	return posix_obj_handle(bit, t->gen);
 }
 
 static bool is_posix_policy_prio_valid(uint32_t priority, int policy)
@@ -250,20 +256,11 @@ static K_WORK_DELAYABLE_DEFINE(posix_thread_recycle_work, posix_thread_recycle_w
 
 static void posix_thread_finalize(struct posix_thread *t, void *retval)
 {
-	sys_snode_t *node_l;
 	k_spinlock_key_t key;
-	pthread_key_obj *key_obj;
-	pthread_thread_data *thread_spec_data;
-
-	SYS_SLIST_FOR_EACH_NODE(&t->key_list, node_l) {
-		thread_spec_data = (pthread_thread_data *)node_l;
-		if (thread_spec_data != NULL) {
-			key_obj = thread_spec_data->key;
-			if (key_obj->destructor != NULL) {
-				(key_obj->destructor)(thread_spec_data->spec_data);
-			}
-		}
-	}
+
+#ifdef CONFIG_PTHREAD_KEY
+	posix_thread_key_finalize(t);
+#endif
 
 	/* move thread from run_q to done_q */
 	key = k_spin_lock(&pthread_pool_lock);
@@ -388,7 +385,11 @@ int pthread_create(pthread_t *th, const pthread_attr_t *_attr, void *(*threadrou
 			t->cancel_state = PTHREAD_CANCEL_ENABLE;
 		}
 		t->cancel_pending = false;
-		sys_slist_init(&t->key_list);
+#ifdef CONFIG_PTHREAD_KEY
+		memset(t->key_data, 0, sizeof(t->key_data));
+#endif
+		/* the handles of the previous thread of the slot are no longer valid */
+		t->gen = posix_obj_gen_next(t->gen);
 		t->dynamic_stack = _attr == NULL ? attr->stack : NULL;
 	}
 	k_spin_unlock(&pthread_pool_lock, key);
@@ -432,7 +433,7 @@ int pthread_create(pthread_t *th, const pthread_attr_t *_attr, void *(*threadrou
 	}
 
 	/* finally provide the initialized thread to the caller */
-	*th = mark_pthread_obj_initialized(posix_thread_to_offset(t));
+	*th = posix_obj_handle(posix_thread_to_offset(t), t->gen);
 
 	return 0;
 }
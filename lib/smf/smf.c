@@ -171,6 +171,180 @@ __unused static bool smf_execute_ancestor_exit_actions(
 	return false;
 }
 
+#ifdef CONFIG_SMF_TRANSITION_TABLE
+static uint8_t table_index(const struct smf_table *table,
+			   const struct smf_state *state)
+{
+	if (state == NULL) {
+		return SMF_TABLE_NONE;
+	}
+
+	__ASSERT(state >= table->states &&
+		 state < &table->states[table->num_states],
+		 "state %p not in transition table", state);
+
+	return state - table->states;
+}
+
+static const struct smf_state *table_state(const struct smf_table *table,
+					   uint8_t index)
+{
+	return index == SMF_TABLE_NONE ? NULL : &table->states[index];
+}
+
+void smf_table_init(struct smf_table *table)
+{
+	for (uint8_t i = 0; i < table->num_states; i++) {
+		const struct smf_state *state = table->states[i].parent;
+
+		while (state != NULL && state->run == NULL) {
+			state = state->parent;
+		}
+		table->run_parent[i] = table_index(table, state);
+
+		for (uint8_t j = 0; j < table->num_states; j++) {
+			const struct smf_state *lca = table->states[i].parent;
+
+			/* Same common ancestor as share_paren() finds at run time */
+			while (lca != NULL && !share_paren(table->states[j].parent, lca)) {
+				lca = lca->parent;
+			}
+			table->lca[i * table->num_states + j] = table_index(table, lca);
+		}
+	}
+}
+
+/**
+ * @brief Execute the entry actions of the ancestors of a state below another
+ *
+ * @param ctx State machine context
+ * @param state The entry actions of this state's ancestors are executed
+ * @param lca Ancestor of @p state whose entry action and above are not executed
+ * @return true if the state machine should terminate, else false
+ */
+static bool smf_table_entry_actions(struct smf_ctx *const ctx,
+				    const struct smf_state *state,
+				    const struct smf_state *lca)
+{
+	struct internal_ctx * const internal = (void *) &ctx->internal;
+	const struct smf_state *parent = state->parent;
+
+	if (parent == lca) {
+		return false;
+	}
+
+	/* Outermost ancestor first, the recursion is as deep as the
+	 * number of states entered
+	 */
+	if (smf_table_entry_actions(ctx, parent, lca)) {
+		return true;
+	}
+
+	if (parent->entry) {
+		parent->entry(ctx);
+
+		/* No need to continue if terminate was set */
+		if (internal->terminate) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/**
+ * @brief Execute the exit actions of the ancestors of the current state
+ *        below another
+ *
+ * @param ctx State machine context
+ * @param lca Ancestor of the current state whose exit action and above are
+ *            not executed
+ * @return true if the state machine should terminate, else false
+ */
+static bool smf_table_exit_actions(struct smf_ctx *const ctx,
+				   const struct smf_state *lca)
+{
+	struct internal_ctx * const internal = (void *) &ctx->internal;
+
+	for (const struct smf_state *tmp_state = ctx->current->parent;
+	     tmp_state != lca;
+	     tmp_state = tmp_state->parent) {
+		if (tmp_state->exit) {
+			tmp_state->exit(ctx);
+
+			/* No need to continue if terminate was set */
+			if (internal->terminate) {
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+/**
+ * @brief Execute the run actions of the ancestors of the current state
+ *
+ * @param ctx State machine context
+ * @return true if the state machine should terminate, else false
+ */
+static bool smf_table_run_actions(struct smf_ctx *ctx)
+{
+	struct internal_ctx * const internal = (void *) &ctx->internal;
+	const struct smf_table *table = ctx->table;
+
+	if (internal->new_state) {
+		internal->new_state = false;
+		return false;
+	}
+
+	if (internal->terminate) {
+		return true;
+	}
+
+	for (uint8_t i = table->run_parent[table_index(table, ctx->current)];
+	     i != SMF_TABLE_NONE;
+	     i = table->run_parent[i]) {
+		table->states[i].run(ctx);
+
+		/* No need to continue if terminate was set */
+		if (internal->terminate) {
+			return true;
+		}
+
+		if (internal->new_state) {
+			break;
+		}
+	}
+
+	internal->new_state = false;
+
+	return false;
+}
+
+void smf_set_initial_table(struct smf_ctx *ctx, const struct smf_table *table,
+			   const struct smf_state *init_state)
+{
+	struct internal_ctx * const internal = (void *) &ctx->internal;
+
+	internal->exit = false;
+	internal->terminate = false;
+	internal->new_state = false;
+	ctx->current = init_state;
+	ctx->previous = NULL;
+	ctx->terminate_val = 0;
+	ctx->table = table;
+
+	if (smf_table_entry_actions(ctx, init_state, NULL)) {
+		return;
+	}
+
+	if (init_state->entry) {
+		init_state->entry(ctx);
+	}
+}
+#endif /* CONFIG_SMF_TRANSITION_TABLE */
+
 void smf_set_initial(struct smf_ctx *ctx, const struct smf_state *init_state)
 {
 	struct internal_ctx * const internal = (void *) &ctx->internal;
@@ -180,6 +354,9 @@ void smf_set_initial(struct smf_ctx *ctx, const struct smf_state *init_state)
 	ctx->current = init_state;
 	ctx->previous = NULL;
 	ctx->terminate_val = 0;
+#ifdef CONFIG_SMF_TRANSITION_TABLE
+	ctx->table = NULL;
+#endif
 
 	if (IS_ENABLED(CONFIG_SMF_ANCESTOR_SUPPORT)) {
 		internal->new_state = false;
@@ -198,6 +375,10 @@ void smf_set_initial(struct smf_ctx *ctx, const struct smf_state *init_state)
 void smf_set_state(struct smf_ctx *const ctx, const struct smf_state *target)
 {
 	struct internal_ctx * const internal = (void *) &ctx->internal;
+#ifdef CONFIG_SMF_TRANSITION_TABLE
+	const struct smf_table *table = ctx->table;
+	const struct smf_state *lca = NULL;
+#endif
 
 	/*
 	 * It does not make sense to call set_state in an exit phase of a state
@@ -211,6 +392,16 @@ void smf_set_state(struct smf_ctx *const ctx, const struct smf_state *target)
 
 	internal->exit = true;
 
+#ifdef CONFIG_SMF_TRANSITION_TABLE
+	if (table != NULL && target != NULL) {
+		uint8_t lca_index = table->lca[table_index(table, ctx->current) *
+					       table->num_states +
+					       table_index(table, target)];
+
+		lca = table_state(table, lca_index);
+	}
+#endif
+
 	/* Execute the current states exit action */
 	if (ctx->current->exit) {
 		ctx->current->exit(ctx);
@@ -227,6 +418,13 @@ void smf_set_state(struct smf_ctx *const ctx, const struct smf_state *target)
 	if (IS_ENABLED(CONFIG_SMF_ANCESTOR_SUPPORT)) {
 		internal->new_state = true;
 
+#ifdef CONFIG_SMF_TRANSITION_TABLE
+		if (table != NULL) {
+			if (smf_table_exit_actions(ctx, lca)) {
+				return;
+			}
+		} else
+#endif
 		if (smf_execute_ancestor_exit_actions(ctx, target)) {
 			return;
 		}
@@ -239,6 +437,13 @@ void smf_set_state(struct smf_ctx *const ctx, const struct smf_state *target)
 	ctx->current = target;
 
 	if (IS_ENABLED(CONFIG_SMF_ANCESTOR_SUPPORT)) {
+#ifdef CONFIG_SMF_TRANSITION_TABLE
+		if (table != NULL) {
+			if (smf_table_entry_actions(ctx, target, lca)) {
+				return;
+			}
+		} else
+#endif
 		if (smf_execute_ancestor_entry_actions(ctx, target)) {
 			return;
 		}
@@ -276,6 +481,13 @@ int32_t smf_run_state(struct smf_ctx *const ctx)
 	}
 
 	if (IS_ENABLED(CONFIG_SMF_ANCESTOR_SUPPORT)) {
+#ifdef CONFIG_SMF_TRANSITION_TABLE
+		if (ctx->table != NULL) {
+			if (smf_table_run_actions(ctx)) {
+				return ctx->terminate_val;
+			}
+		} else
+#endif
 		if (smf_execute_ancestor_run_actions(ctx)) {
 			return ctx->terminate_val;
 		}
@@ -283,3 +495,24 @@ int32_t smf_run_state(struct smf_ctx *const ctx)
 
 	return 0;
 }
+
+#ifdef CONFIG_SMF_EVENT_QUEUE
+int32_t smf_run_event(struct smf_ctx *ctx, struct k_msgq *events, void *event,
+		      k_timeout_t timeout)
+{
+	struct internal_ctx * const internal = (void *) &ctx->internal;
+
+	/* Without ancestor support, termination is only reported by the
+	 * iteration after the one setting it, the queue may be empty by then.
+	 */
+	if (internal->terminate) {
+		return ctx->terminate_val;
+	}
+
+	if (k_msgq_get(events, event, timeout) != 0) {
+		return -EAGAIN;
+	}
+
+	return smf_run_state(ctx);
+}
+#endif /* CONFIG_SMF_EVENT_QUEUE */
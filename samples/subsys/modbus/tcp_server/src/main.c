@@ -10,7 +10,6 @@
 #include <zephyr/drivers/gpio.h>
 #include <zephyr/modbus/modbus.h>
 
-#include <zephyr/net/socket.h>
 
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(tcp_modbus, LOG_LEVEL_INF);
@@ -119,37 +118,14 @@ static struct modbus_user_callbacks mbs_cbs = {
 	.holding_reg_wr = holding_reg_wr,
 };
 
-static struct modbus_adu tmp_adu;
-K_SEM_DEFINE(received, 0, 1);
 static int server_iface;
 
-static int server_raw_cb(const int iface, const struct modbus_adu *adu,
-			void *user_data)
-{
-	LOG_DBG("Server raw callback from interface %d", iface);
-
-	tmp_adu.trans_id = adu->trans_id;
-	tmp_adu.proto_id = adu->proto_id;
-	tmp_adu.length = adu->length;
-	tmp_adu.unit_id = adu->unit_id;
-	tmp_adu.fc = adu->fc;
-	memcpy(tmp_adu.data, adu->data,
-	       MIN(adu->length, CONFIG_MODBUS_BUFFER_SIZE));
-
-	LOG_HEXDUMP_DBG(tmp_adu.data, tmp_adu.length, "resp");
-	k_sem_give(&received);
-
-	return 0;
-}
-
 const static struct modbus_iface_param server_param = {
 	.mode = MODBUS_MODE_RAW,
 	.server = {
 		.user_cb = &mbs_cbs,
 		.unit_id = 1,
 	},
-	.rawcb.raw_tx_cb = server_raw_cb,
-	.rawcb.user_data = NULL
 };
 
 static int init_modbus_server(void)
@@ -167,61 +143,9 @@ static int init_modbus_server(void)
 	return modbus_init_server(server_iface, server_param);
 }
 
-static int modbus_tcp_reply(int client, struct modbus_adu *adu)
-{
-	uint8_t header[MODBUS_MBAP_AND_FC_LENGTH];
-
-	modbus_raw_put_header(adu, header);
-	if (send(client, header, sizeof(header), 0) < 0) {
-		return -errno;
-	}
-
-	if (send(client, adu->data, adu->length, 0) < 0) {
-		return -errno;
-	}
-
-	return 0;
-}
-
-static int modbus_tcp_connection(int client)
-{
-	uint8_t header[MODBUS_MBAP_AND_FC_LENGTH];
-	int rc;
-	int data_len;
-
-	rc = recv(client, header, sizeof(header), MSG_WAITALL);
-	if (rc <= 0) {
-		return rc == 0 ? -ENOTCONN : -errno;
-	}
-
-	LOG_HEXDUMP_DBG(header, sizeof(header), "h:>");
-	modbus_raw_get_header(&tmp_adu, header);
-	data_len = tmp_adu.length;
-
-	rc = recv(client, tmp_adu.data, data_len, MSG_WAITALL);
-	if (rc <= 0) {
-		return rc == 0 ? -ENOTCONN : -errno;
-	}
-
-	LOG_HEXDUMP_DBG(tmp_adu.data, tmp_adu.length, "d:>");
-	if (modbus_raw_submit_rx(server_iface, &tmp_adu)) {
-		LOG_ERR("Failed to submit raw ADU");
-		return -EIO;
-	}
-
-	if (k_sem_take(&received, K_MSEC(1000)) != 0) {
-		LOG_ERR("MODBUS RAW wait time expired");
-		modbus_raw_set_server_failure(&tmp_adu);
-	}
-
-	return modbus_tcp_reply(client, &tmp_adu);
-}
-
 int main(void)
 {
-	int serv;
-	struct sockaddr_in bind_addr;
-	static int counter;
+	int err;
 
 	if (init_modbus_server()) {
 		LOG_ERR("Modbus TCP server initialization failed");
@@ -233,56 +157,13 @@ int main(void)
 		return 0;
 	}
 
-	serv = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
-
-	if (serv < 0) {
-		LOG_ERR("error: socket: %d", errno);
-		return 0;
-	}
-
-	bind_addr.sin_family = AF_INET;
-	bind_addr.sin_addr.s_addr = htonl(INADDR_ANY);
-	bind_addr.sin_port = htons(MODBUS_TCP_PORT);
-
-	if (bind(serv, (struct sockaddr *)&bind_addr, sizeof(bind_addr)) < 0) {
-		LOG_ERR("error: bind: %d", errno);
-		return 0;
-	}
-
-	if (listen(serv, 5) < 0) {
-		LOG_ERR("error: listen: %d", errno);
+	err = modbus_tcp_server_start(server_iface, MODBUS_TCP_PORT);
+	if (err != 0) {
+		LOG_ERR("Failed to start Modbus TCP server (%d)", err);
 		return 0;
 	}
 
 	LOG_INF("Started MODBUS TCP server example on port %d", MODBUS_TCP_PORT);
 
-	while (1) {
-		struct sockaddr_in client_addr;
-		socklen_t client_addr_len = sizeof(client_addr);
-		char addr_str[INET_ADDRSTRLEN];
-		int client;
-		int rc;
-
-		client = accept(serv, (struct sockaddr *)&client_addr,
-				&client_addr_len);
-
-		if (client < 0) {
-			LOG_ERR("error: accept: %d", errno);
-			continue;
-		}
-
-		inet_ntop(client_addr.sin_family, &client_addr.sin_addr,
-			  addr_str, sizeof(addr_str));
-		LOG_INF("Connection #%d from %s",
-			counter++, addr_str);
-
-		do {
-			rc = modbus_tcp_connection(client);
-		} while (!rc);
-
-		close(client);
-		LOG_INF("Connection from %s closed, errno %d",
-			addr_str, rc);
-	}
 	return 0;
 }
@@ -17,6 +17,29 @@ LOG_MODULE_REGISTER(main);
 
 #define MY_PORT 5000
 #define MAX_CLIENT_QUEUE 1
+#define STATS_FRAMES 30
+
+/* Time spent waiting for the frames and sending them, over STATS_FRAMES */
+struct stage_stats {
+	uint32_t start;
+	uint64_t capture_ns;
+	uint64_t send_ns;
+};
+
+static void stats_print(struct stage_stats *stats)
+{
+	uint64_t ns = k_cyc_to_ns_floor64(k_cycle_get_32() - stats->start);
+
+	printk("\n%u.%02u fps, capture wait %u us, send %u us per frame\n",
+	       (uint32_t)((uint64_t)STATS_FRAMES * NSEC_PER_SEC / ns),
+	       (uint32_t)((uint64_t)STATS_FRAMES * NSEC_PER_SEC * 100 / ns % 100),
+	       (uint32_t)(stats->capture_ns / STATS_FRAMES / NSEC_PER_USEC),
+	       (uint32_t)(stats->send_ns / STATS_FRAMES / NSEC_PER_USEC));
+
+	stats->start = k_cycle_get_32();
+	stats->capture_ns = 0;
+	stats->send_ns = 0;
+}
 
 static ssize_t sendall(int sock, const void *buf, size_t len)
 {
@@ -40,6 +63,8 @@ int main(void)
 	struct video_buffer *buffers[2], *vbuf;
 	int i, ret, sock, client;
 	struct video_format fmt;
+	struct stage_stats stats;
+	uint32_t start;
 	const struct device *const video = DEVICE_DT_GET_ONE(nxp_imx_csi);
 
 	/* Prepare Network */
@@ -120,7 +145,9 @@ int main(void)
 
 		/* Capture loop */
 		i = 0;
+		stats = (struct stage_stats){ .start = k_cycle_get_32() };
 		do {
+			start = k_cycle_get_32();
 			ret = video_dequeue(video, VIDEO_EP_OUT, &vbuf,
 					    K_FOREVER);
 			if (ret) {
@@ -128,10 +155,19 @@ int main(void)
 				return 0;
 			}
 
+			stats.capture_ns += k_cyc_to_ns_floor64(k_cycle_get_32() - start);
+
 			printk("\rSending frame %d", i++);
 
 			/* Send video buffer to TCP client */
+			start = k_cycle_get_32();
 			ret = sendall(client, vbuf->buffer, vbuf->bytesused);
+			stats.send_ns += k_cyc_to_ns_floor64(k_cycle_get_32() - start);
+
+			if (i % STATS_FRAMES == 0) {
+				stats_print(&stats);
+			}
+
 			if (ret && ret != -EAGAIN) {
 				/* client disconnected */
 				printk("\nTCP: Client disconnected %d\n", ret);
@@ -94,6 +94,7 @@ kobjects = OrderedDict([
     ("k_msgq", (None, False, True)),
     ("k_mutex", (None, False, True)),
     ("k_pipe", (None, False, True)),
+    ("k_pktq", ("CONFIG_PKTQ", False, False)),
     ("k_queue", (None, False, True)),
     ("k_poll_signal", (None, False, True)),
     ("k_sem", (None, False, True)),
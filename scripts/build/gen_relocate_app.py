@@ -20,6 +20,12 @@ One can also specify the program header for a given memory region:
 
    SRAM2\\ :phdr0:COPY:/home/xyz/zephyr/samples/hello_world/src/main.c
 
+or relocate only the code of some functions, looked up in the given files or
+in all the object files if no file is given:
+
+   ITCM_TEXT:COPY:/home/xyz/zephyr/kernel/timeout.c:FUNCTIONS:z_add_timeout
+   ITCM_TEXT:COPY::FUNCTIONS:z_add_timeout,net_conn_input
+
 To invoke this script::
 
    python3 gen_relocate_app.py -i input_string -o generated_linker -c generated_code
@@ -36,6 +42,9 @@ Configuration that needs to be sent to the python script.
 
 Multiple regions can be appended together like SRAM2_DATA_BSS
 this will place data and bss inside SRAM2.
+
+The size of the sections relocated to each memory region is printed, so
+that the budget of small memories like ITCM can be tracked.
 """
 
 
@@ -94,6 +103,7 @@ class SectionKind(Enum):
 class OutputSection(NamedTuple):
     obj_file_name: str
     section_name: str
+    size: int = 0
 
 
 PRINT_TEMPLATE = """
@@ -218,12 +228,41 @@ def region_is_default_ram(region_name: str) -> bool:
     return region_name == args.default_ram_region
 
 
-def find_sections(filename: str) -> 'dict[SectionKind, list[OutputSection]]':
+def function_of_section(name: str):
+    """
+    Return the name of the function whose code is in the section with the
+    given name, or None if it is not a code section.
+
+    >>> function_of_section(".text.unlikely.z_add_timeout")
+    'z_add_timeout'
+    >>> function_of_section(".text.calc_chksum.part.0")
+    'calc_chksum'
+    """
+    for prefix in (".text.", ".literal."):
+        if name.startswith(prefix):
+            name = name[len(prefix):]
+            break
+    else:
+        return None
+
+    for qualifier in ("unlikely.", "hot.", "startup.", "exit."):
+        if name.startswith(qualifier):
+            name = name[len(qualifier):]
+            break
+
+    # Functions cloned by the compiler have a suffix like .part.0
+    return name.split(".")[0]
+
+
+def find_sections(filename: str, functions=None) -> 'dict[SectionKind, list[OutputSection]]':
     """
     Locate relocatable sections in the given object file.
 
     The output value maps categories of sections to the list of actual sections
     located in the object file that fit in that category.
+
+    If a set of function names is given, only the code sections of these
+    functions are located, and the functions found are added to found_functions.
     """
     obj_file_path = Path(filename)
 
@@ -240,8 +279,15 @@ def find_sections(filename: str) -> 'dict[SectionKind, list[OutputSection]]':
             if section_kind is None:
                 continue
 
+            if functions is not None:
+                function = function_of_section(section.name)
+                if function not in functions:
+                    continue
+                found_functions.add(function)
+
             out[section_kind].append(
-                OutputSection(obj_file_path.name, section.name)
+                OutputSection(obj_file_path.name, section.name,
+                              section["sh_size"])
             )
 
             # Common variables will be placed in the .bss section
@@ -428,6 +474,17 @@ def generate_memcpy_code(memory_type, full_list_of_sections, code_generation):
     return code_generation
 
 
+def print_region_usage(complete_list_of_sections):
+    for memory_type, full_list_of_sections in \
+            sorted(complete_list_of_sections.items()):
+        memory_type = memory_type.split("|", 1)[0]
+        # Alignment padding is not accounted for, see the linker memory
+        # usage report for the final figure.
+        size = sum(section.size for sections in full_list_of_sections.values()
+                   for section in sections)
+        print(f"Code relocation: {size} bytes relocated to {memory_type}")
+
+
 def dump_header_file(header_file, code_generation):
     code_string = ''
     # create a dummy void function if there is no code to generate for
@@ -485,23 +542,39 @@ def get_obj_filename(searchpath, filename):
                     return fullname
 
 
+def get_all_obj_filenames(searchpath):
+    for dirpath, _, files in os.walk(searchpath):
+        for filename in files:
+            if filename.endswith(".obj"):
+                yield os.path.join(dirpath, filename)
+
+
 # Extracts all possible components for the input strin:
-# <mem_region>[\ :program_header]:<flag>:<file_name>
-# Returns a 4-tuple with them: (mem_region, program_header, flag, file_name)
+# <mem_region>[\ :program_header]:<flag>:<file_name>[:FUNCTIONS:<functions>]
+# Returns a 5-tuple with them:
+# (mem_region, program_header, flag, file_name, functions)
 # If no `program_header` is defined, returns an empty string
+# If no `functions` are defined, returns None
 def parse_input_string(line):
     line = line.replace(' :', ':')
 
+    functions = None
+    if ':FUNCTIONS:' in line:
+        line, _, function_list = line.rpartition(':FUNCTIONS:')
+        functions = {f.split('.')[0] for f in function_list.split(',') if f}
+
     flag_sep = ':NOCOPY:' if ':NOCOPY' in line else ':COPY:'
     mem_region_phdr, copy_flag, file_name = line.partition(flag_sep)
     copy_flag = copy_flag.replace(':', '')
 
     mem_region, _, phdr = mem_region_phdr.partition(':')
 
-    return mem_region, phdr, copy_flag, file_name
+    return mem_region, phdr, copy_flag, file_name, functions
 
 
-# Create a dict with key as memory type and files as a list of values.
+# Create a dict with key as memory type and a list of (file, functions)
+# as values, where functions is None to relocate the whole file and file is
+# None to look up the functions in all the files.
 # Also, return another dict with program headers for memory regions
 def create_dict_wrt_mem():
     # need to support wild card *
@@ -515,15 +588,17 @@ def create_dict_wrt_mem():
         if ':' not in line:
             continue
 
-        mem_region, phdr, copy_flag, file_list = parse_input_string(line)
+        mem_region, phdr, copy_flag, file_list, functions = parse_input_string(line)
 
         # Handle any program header
         if phdr != '':
             phdrs[mem_region] = f':{phdr}'
 
         # Split file names by semicolons, to support generator expressions
-        file_glob_list = file_list.split(';')
+        file_glob_list = file_list.split(';') if file_list else []
         file_name_list = []
+        if functions is not None and not file_glob_list:
+            file_name_list.append(None)
         # Use glob matching on each file in the list
         for file_glob in file_glob_list:
             glob_results = glob.glob(file_glob)
@@ -540,20 +615,24 @@ def create_dict_wrt_mem():
             continue
         if args.verbose:
             print("Memory region ", mem_region, " Selected for files:", file_name_list)
+            if functions is not None:
+                print("Memory region ", mem_region, " Selected for functions:",
+                      sorted(functions))
 
         mem_region = "|".join((mem_region, copy_flag))
 
-        if mem_region in rel_dict:
-            rel_dict[mem_region].extend(file_name_list)
-        else:
-            rel_dict[mem_region] = file_name_list
+        if mem_region not in rel_dict:
+            rel_dict[mem_region] = []
+        rel_dict[mem_region].extend((f, functions) for f in file_name_list)
 
     return rel_dict, phdrs
 
 
 def main():
     global mpu_align
+    global found_functions
     mpu_align = {}
+    found_functions = set()
     parse_args()
     searchpath = args.directory
     linker_file = args.output
@@ -570,16 +649,21 @@ def main():
     for memory_type, files in rel_dict.items():
         full_list_of_sections: 'dict[SectionKind, list[OutputSection]]' = defaultdict(list)
 
-        for filename in files:
-            obj_filename = get_obj_filename(searchpath, filename)
-            # the obj file wasn't found. Probably not compiled.
-            if not obj_filename:
-                continue
+        for filename, functions in files:
+            if filename is None:
+                obj_filenames = get_all_obj_filenames(searchpath)
+            else:
+                obj_filenames = [get_obj_filename(searchpath, filename)]
 
-            file_sections = find_sections(obj_filename)
-            # Merge sections from file into collection of sections for all files
-            for category, sections in file_sections.items():
-                full_list_of_sections[category].extend(sections)
+            for obj_filename in obj_filenames:
+                # the obj file wasn't found. Probably not compiled.
+                if not obj_filename:
+                    continue
+
+                file_sections = find_sections(obj_filename, functions)
+                # Merge sections from file into collection of sections for all files
+                for category, sections in file_sections.items():
+                    full_list_of_sections[category].extend(sections)
 
         # cleanup and attach the sections to the memory type after cleanup.
         sections_by_category = assign_to_correct_mem_region(memory_type, full_list_of_sections)
@@ -587,6 +671,14 @@ def main():
             for (category, sections) in section_category_map.items():
                 complete_list_of_sections[region][category].extend(sections)
 
+    missing_functions = set().union(
+        *(functions for files in rel_dict.values()
+          for _, functions in files if functions is not None)) - found_functions
+    for function in sorted(missing_functions):
+        warnings.warn("Function: " + function + " Not found")
+
+    print_region_usage(complete_list_of_sections)
+
     generate_linker_script(linker_file, sram_data_linker_file,
                            sram_bss_linker_file, complete_list_of_sections, phdrs)
 
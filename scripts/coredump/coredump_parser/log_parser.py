@@ -20,9 +20,13 @@ LOG_ARCH_HDR_SIZE = struct.calcsize(LOG_ARCH_HDR_STRUCT)
 
 COREDUMP_MEM_HDR_ID = b'M'
 COREDUMP_MEM_HDR_VER = 1
+COREDUMP_MEM_HDR_VER_RLE = 2
 LOG_MEM_HDR_STRUCT = "<cH"
 LOG_MEM_HDR_SIZE = struct.calcsize(LOG_MEM_HDR_STRUCT)
 
+COREDUMP_RLE_REPEAT = 0x80
+COREDUMP_RLE_RUN_MIN = 3
+
 
 logger = logging.getLogger("parser")
 
@@ -81,12 +85,39 @@ class CoredumpLogFile:
 
         return True
 
+    def read_rle(self, size):
+        # Keep sync with rle_output() in coredump_core.c
+        data = bytearray()
+
+        while len(data) < size:
+            ctrl = self.fd.read(1)
+            if not ctrl:
+                return None
+
+            ctrl = ctrl[0]
+            if ctrl < COREDUMP_RLE_REPEAT:
+                literal = self.fd.read(ctrl + 1)
+                if len(literal) != ctrl + 1:
+                    return None
+                data += literal
+            else:
+                value = self.fd.read(1)
+                if not value:
+                    return None
+                data += value * (ctrl - COREDUMP_RLE_REPEAT + COREDUMP_RLE_RUN_MIN)
+
+        if len(data) != size:
+            return None
+
+        return bytes(data)
+
     def parse_memory_section(self):
         hdr = self.fd.read(LOG_MEM_HDR_SIZE)
         _, hdr_ver = struct.unpack(LOG_MEM_HDR_STRUCT, hdr)
 
-        if hdr_ver != COREDUMP_MEM_HDR_VER:
-            logger.error(f"Memory block version: {hdr_ver}, expected {COREDUMP_MEM_HDR_VER}!")
+        if hdr_ver not in (COREDUMP_MEM_HDR_VER, COREDUMP_MEM_HDR_VER_RLE):
+            logger.error(f"Memory block version: {hdr_ver}, expected {COREDUMP_MEM_HDR_VER} "
+                         f"or {COREDUMP_MEM_HDR_VER_RLE}!")
             return False
 
         # Figure out how to read the start and end addresses
@@ -103,7 +134,13 @@ class CoredumpLogFile:
 
         size = eaddr - saddr
 
-        data = self.fd.read(size)
+        if hdr_ver == COREDUMP_MEM_HDR_VER_RLE:
+            data = self.read_rle(size)
+            if data is None:
+                logger.error("Truncated compressed memory block")
+                return False
+        else:
+            data = self.fd.read(size)
 
         mem = {"start": saddr, "end": eaddr, "data": data}
         self.memory_regions.append(mem)
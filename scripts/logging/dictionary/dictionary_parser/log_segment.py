@@ -0,0 +1,132 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2023 Zephyr Project
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""
+Segments of Compressed Log Files
+
+This extracts the log data from the files written by the file system
+backend with CONFIG_LOG_BACKEND_FS_COMPRESS enabled. The format must be
+kept in sync with subsys/logging/backends/log_backend_fs.c.
+"""
+
+import logging
+import struct
+
+
+SEGMENT_MAGIC = 0x5a4c
+SEGMENT_FLAG_STORED = 0x01
+
+# magic, flags, reserved, index, raw_len, data_len
+FMT_SEGMENT_HDR = "<HBBIHH"
+SEGMENT_HDR_LEN = struct.calcsize(FMT_SEGMENT_HDR)
+
+LZ_MIN_MATCH = 3
+
+
+logger = logging.getLogger("parser")
+
+
+def decompress(data, raw_len):
+    """Decompress one segment, returns None if data is corrupted"""
+    out = bytearray()
+    offset = 0
+
+    while len(out) < raw_len:
+        if offset >= len(data):
+            return None
+
+        ctrl = data[offset]
+        offset += 1
+
+        for item in range(8):
+            if len(out) >= raw_len:
+                break
+
+            if ctrl & (1 << item):
+                if offset + 2 > len(data):
+                    return None
+
+                distance = data[offset] | ((data[offset + 1] & 0x0f) << 8)
+                length = (data[offset + 1] >> 4) + LZ_MIN_MATCH
+                offset += 2
+
+                if distance == 0 or distance > len(out):
+                    return None
+
+                # Byte by byte as the reference may overlap the output
+                for _ in range(length):
+                    out.append(out[-distance])
+            else:
+                if offset >= len(data):
+                    return None
+
+                out.append(data[offset])
+                offset += 1
+
+    return bytes(out)
+
+
+def extract_segments(filedata):
+    """
+    Return the list of (index, data) of the segments found in a log file.
+
+    Data which does not belong to a valid segment, for example a segment
+    partially written before a reset, is skipped.
+    """
+    segments = []
+    offset = 0
+
+    while offset + SEGMENT_HDR_LEN <= len(filedata):
+        magic, flags, _, index, raw_len, data_len = \
+            struct.unpack_from(FMT_SEGMENT_HDR, filedata, offset)
+
+        start = offset + SEGMENT_HDR_LEN
+        end = start + data_len
+
+        if magic != SEGMENT_MAGIC or end > len(filedata):
+            offset += 1
+            continue
+
+        payload = filedata[start:end]
+        if flags & SEGMENT_FLAG_STORED:
+            raw = payload if data_len == raw_len else None
+        else:
+            raw = decompress(payload, raw_len)
+
+        if raw is None:
+            logger.debug("Corrupted segment at offset %d", offset)
+            offset += 1
+            continue
+
+        segments.append((index, raw))
+        offset = end
+
+    return segments
+
+
+def read_segmented_files(filenames):
+    """
+    Read and decompress log files, in the given order, and return the list
+    of segments. Each segment starts on a message boundary so it can be
+    parsed on its own.
+    """
+    segments = []
+    next_index = None
+
+    for filename in filenames:
+        with open(filename, "rb") as logfile:
+            filedata = logfile.read()
+
+        for index, raw in extract_segments(filedata):
+            if index == 0 and next_index not in (None, 0):
+                logger.debug("# Device restarted")
+            elif next_index is not None and index != next_index:
+                logger.debug("# %d segment(s) missing", (index - next_index) & 0xffffffff)
+
+            next_index = (index + 1) & 0xffffffff
+            segments.append(raw)
+
+    return segments
@@ -18,6 +18,7 @@ import sys
 
 import dictionary_parser
 from dictionary_parser.log_database import LogDatabase
+from dictionary_parser.log_segment import read_segmented_files
 
 
 LOGGER_FORMAT = "%(message)s"
@@ -31,11 +32,15 @@ def parse_args():
     argparser = argparse.ArgumentParser(allow_abbrev=False)
 
     argparser.add_argument("dbfile", help="Dictionary Logging Database file")
-    argparser.add_argument("logfile", help="Log Data file")
+    argparser.add_argument("logfile", nargs="+",
+                           help="Log Data file, or files in rotation order with --fs-segments")
     argparser.add_argument("--hex", action="store_true",
                            help="Log Data file is in hexadecimal strings")
     argparser.add_argument("--rawhex", action="store_true",
                            help="Log file only contains hexadecimal log data")
+    argparser.add_argument("--fs-segments", action="store_true",
+                           help="Log Data files are compressed files written by the "
+                                "file system backend")
     argparser.add_argument("--debug", action="store_true",
                            help="Print extra debugging information")
 
@@ -47,16 +52,17 @@ def read_log_file(args):
     Read the log from file
     """
     logdata = None
+    logfilename = args.logfile[0]
 
     # Open log data file for reading
     if args.hex:
         if args.rawhex:
             # Simply log file with only hexadecimal data
-            logdata = dictionary_parser.utils.convert_hex_file_to_bin(args.logfile)
+            logdata = dictionary_parser.utils.convert_hex_file_to_bin(logfilename)
         else:
             hexdata = ''
 
-            with open(args.logfile, "r", encoding="iso-8859-1") as hexfile:
+            with open(logfilename, "r", encoding="iso-8859-1") as hexfile:
                 for line in hexfile.readlines():
                     hexdata += line.strip()
 
@@ -89,9 +95,9 @@ def read_log_file(args):
 
             logdata = binascii.unhexlify(hexdata[:idx])
     else:
-        logfile = open(args.logfile, "rb")
+        logfile = open(logfilename, "rb")
         if not logfile:
-            logger.error("ERROR: Cannot open binary log data file: %s, exiting...", args.logfile)
+            logger.error("ERROR: Cannot open binary log data file: %s, exiting...", logfilename)
             sys.exit(1)
 
         logdata = logfile.read()
@@ -118,9 +124,18 @@ def main():
         logger.error("ERROR: Cannot open database file: %s, exiting...", args.dbfile)
         sys.exit(1)
 
-    logdata = read_log_file(args)
-    if logdata is None:
-        logger.error("ERROR: cannot read log from file: %s, exiting...", args.logfile)
+    if args.fs_segments:
+        # Segments start on message boundaries, parse them separately
+        # so that a corrupted segment does not affect the following ones.
+        logdata = read_segmented_files(args.logfile)
+    elif len(args.logfile) > 1:
+        logger.error("ERROR: multiple log files require --fs-segments, exiting...")
+        sys.exit(1)
+    else:
+        logdata = [read_log_file(args)]
+
+    if logdata is None or None in logdata:
+        logger.error("ERROR: cannot read log from file: %s, exiting...", ", ".join(args.logfile))
         sys.exit(1)
 
     log_parser = dictionary_parser.get_parser(database)
@@ -132,7 +147,9 @@ def main():
         else:
             logger.debug("# Endianness: Big")
 
-        ret = log_parser.parse_log_data(logdata, debug=args.debug)
+        ret = True
+        for data in logdata:
+            ret = log_parser.parse_log_data(data, debug=args.debug) and ret
         if not ret:
             logger.error("ERROR: there were error(s) parsing log data")
             sys.exit(1)
@@ -0,0 +1,171 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2023 Zephyr Project
+#
+# SPDX-License-Identifier: Apache-2.0
+"""
+Symbolize the samples of the sampling profiler (CONFIG_PROFILER).
+
+Record and print the samples from the shell, saving the console output to a
+file:
+
+    uart:~$ profiler start 1000 5000
+    uart:~$ profiler dump
+
+Then print the flat profile, the functions sorted by the number of samples
+taken in them:
+
+    ./scripts/profiling/profiler_report.py build/zephyr/zephyr.elf console.log
+
+or the call graph as folded stacks, one line per call stack with its number
+of samples, which flamegraph.pl and speedscope take as input:
+
+    ./scripts/profiling/profiler_report.py --folded build/zephyr/zephyr.elf console.log
+
+or the list of the hottest functions, the fewest that account for the given
+percentage of the samples, which zephyr_code_relocate(PROFILE) takes as input
+to relocate them to faster memory:
+
+    ./scripts/profiling/profiler_report.py --hot 80 build/zephyr/zephyr.elf console.log > hot.txt
+"""
+
+import argparse
+import bisect
+import collections
+import re
+import sys
+
+from elftools.elf.elffile import ELFFile
+from elftools.elf.sections import SymbolTableSection
+
+CPU_RE = re.compile(r"profiler: cpu (\d+) dropped (\d+)")
+SAMPLE_RE = re.compile(r"profiler:((?: [0-9a-f]+)+)\s*$")
+
+
+class Symbols:
+    """Function symbols of an ELF file, looked up by address"""
+
+    def __init__(self, elf_path):
+        functions = {}
+
+        with open(elf_path, "rb") as f:
+            elf = ELFFile(f)
+            for section in elf.iter_sections():
+                if not isinstance(section, SymbolTableSection):
+                    continue
+                for sym in section.iter_symbols():
+                    if sym["st_info"]["type"] != "STT_FUNC" or sym["st_size"] == 0:
+                        continue
+                    # Thumb functions have the lowest bit set
+                    start = sym["st_value"] & ~1
+                    functions[start] = (start + sym["st_size"], sym.name)
+
+        self.starts = sorted(functions)
+        self.functions = [functions[start] for start in self.starts]
+
+    def lookup(self, addr):
+        i = bisect.bisect_right(self.starts, addr) - 1
+        if i >= 0:
+            end, name = self.functions[i]
+            if addr < end:
+                return name
+
+        return f"0x{addr:x}"
+
+
+def parse_args():
+    parser = argparse.ArgumentParser(
+        description=__doc__,
+        formatter_class=argparse.RawDescriptionHelpFormatter, allow_abbrev=False)
+    parser.add_argument("elf", help="ELF file of the profiled image")
+    parser.add_argument("log", help="console output of 'profiler dump'")
+    parser.add_argument("--folded", action="store_true",
+                        help="print the call graph as folded stacks")
+    parser.add_argument("--hot", type=float, metavar="PERCENT",
+                        help="print the hottest functions which account for "
+                             "PERCENT of the samples, one per line")
+    parser.add_argument("--cpu", type=int,
+                        help="only report the samples of this CPU")
+    return parser.parse_args()
+
+
+def read_samples(log_path, cpu_filter):
+    """Return the call stacks sampled, innermost address first"""
+    samples = []
+    cpu = 0
+
+    with open(log_path, errors="replace") as f:
+        for line in f:
+            match = CPU_RE.search(line)
+            if match:
+                cpu = int(match.group(1))
+                if int(match.group(2)):
+                    print(f"cpu {cpu}: {match.group(2)} samples dropped",
+                          file=sys.stderr)
+                continue
+
+            match = SAMPLE_RE.search(line)
+            if match and (cpu_filter is None or cpu == cpu_filter):
+                samples.append([int(a, 16) for a in match.group(1).split()])
+
+    return samples
+
+
+def symbolize(symbols, addrs):
+    """Return the functions of a call stack, outermost first"""
+    names = []
+
+    for i, addr in enumerate(addrs):
+        name = symbols.lookup(addr)
+        # The second address may be the link register, which duplicates the
+        # sampled function or the next frame.
+        if i <= 2 and names and names[-1] == name:
+            continue
+        names.append(name)
+
+    return list(reversed(names))
+
+
+def main():
+    args = parse_args()
+    symbols = Symbols(args.elf)
+    samples = read_samples(args.log, args.cpu)
+
+    if not samples:
+        sys.exit("No samples found")
+
+    stacks = [symbolize(symbols, s) for s in samples]
+
+    if args.folded:
+        folded = collections.Counter(";".join(s) for s in stacks)
+        for stack, count in folded.most_common():
+            print(f"{stack} {count}")
+        return
+
+    flat = collections.Counter(s[-1] for s in stacks)
+
+    if args.hot is not None:
+        print(f"# {args.hot}% of {len(stacks)} samples")
+        count = 0
+        for name, n in flat.most_common():
+            if 100 * count >= args.hot * len(stacks):
+                break
+            count += n
+            # Samples outside of any function cannot be relocated
+            if not name.startswith("0x"):
+                print(name)
+        return
+
+    # Samples of the functions and their callees, each function counted once
+    # per stack in case of recursion
+    total = collections.Counter(f for s in stacks for f in set(s))
+
+    print(f"{len(stacks)} samples")
+    print(f"{'self':>7} {'self %':>7} {'total':>7} {'total %':>7}  function")
+    for name, count in flat.most_common():
+        print(f"{count:7} {100 * count / len(stacks):6.2f}% "
+              f"{total[name]:7} {100 * total[name] / len(stacks):6.2f}%  {name}")
+
+
+if __name__ == "__main__":
+    main()
@@ -16,6 +16,9 @@ Generate trace using samples/subsys/tracing for example:
     cp build/channel0_0 ctf/
     cp subsys/tracing/ctf/tsdl/metadata ctf/
     ./scripts/tracing/parse_ctf.py -t ctf
+
+With CONFIG_TRACING_BUFFER_PER_CPU or CONFIG_TRACING_CTF_COMPACT, copy the
+metadata generated in build/zephyr/ctf/ instead.
 """
 
 import sys
@@ -46,6 +49,8 @@ def main():
     msg_it = bt2.TraceCollectionMessageIterator(args.trace)
     last_event_ns_from_origin = None
     timeline = []
+    # Threads the compact thread switch events refer to, by stream and index
+    interned = {}
 
     def get_thread(name):
         for t in timeline:
@@ -68,7 +73,28 @@ def main():
 
         dt = datetime.datetime.fromtimestamp(ns_from_origin / 1e9)
 
-        if event.name in [
+        event_name = event.name
+        payload = event.payload_field
+
+        if event_name in ['thread_intern', 'thread_switched_out_compact',
+                          'thread_switched_in_compact']:
+            # Per CPU streams have the CPU in their packet context
+            try:
+                stream = int(event.packet.context_field['cpu_id'])
+            except (AttributeError, KeyError, TypeError):
+                stream = 0
+
+            if event_name == 'thread_intern':
+                interned[(stream, int(payload['index']))] = {
+                    'thread_id': int(payload['thread_id']),
+                    'name': str(payload['name']),
+                }
+                continue
+
+            event_name = event_name[:-len('_compact')]
+            payload = interned.get((stream, int(payload['thread'])), {})
+
+        if event_name in [
                 'thread_switched_out',
                 'thread_switched_in',
                 'thread_pending',
@@ -79,24 +105,24 @@ def main():
                 'thread_abort'
                 ]:
 
-            cpu = event.payload_field.get("cpu", None)
-            thread_id = event.payload_field.get("thread_id", None)
-            thread_name = event.payload_field.get("name", None)
+            cpu = payload.get("cpu", None)
+            thread_id = payload.get("thread_id", None)
+            thread_name = payload.get("name", None)
 
             th = {}
-            if event.name in ['thread_switched_out', 'thread_switched_in'] and cpu is not None:
+            if event_name in ['thread_switched_out', 'thread_switched_in'] and cpu is not None:
                 cpu_string = f"(cpu: {cpu})"
             else:
                 cpu_string = ""
 
             if thread_name:
-                print(f"{dt} (+{diff_s:.6f} s): {event.name}: {thread_name} {cpu_string}")
+                print(f"{dt} (+{diff_s:.6f} s): {event_name}: {thread_name} {cpu_string}")
             elif thread_id:
-                print(f"{dt} (+{diff_s:.6f} s): {event.name}: {thread_id} {cpu_string}")
+                print(f"{dt} (+{diff_s:.6f} s): {event_name}: {thread_id} {cpu_string}")
             else:
-                print(f"{dt} (+{diff_s:.6f} s): {event.name}")
+                print(f"{dt} (+{diff_s:.6f} s): {event_name}")
 
-            if event.name in ['thread_switched_out', 'thread_switched_in']:
+            if event_name in ['thread_switched_out', 'thread_switched_in']:
                 if thread_name:
                     th = get_thread(thread_name)
                     if not th:
@@ -106,38 +132,38 @@ def main():
                     if not th:
                         th['name'] = thread_id
 
-                if event.name in ['thread_switched_out']:
+                if event_name in ['thread_switched_out']:
                     th['out'] = ns_from_origin
                     tin = th.get('in', None)
                     tout = th.get('out', None)
                     if tout is not None and tin is not None:
                         diff = tout - tin
                         th['runtime'] = diff
-                elif event.name in ['thread_switched_in']:
+                elif event_name in ['thread_switched_in']:
                     th['in'] = ns_from_origin
 
                     timeline.append(th)
 
-        elif event.name in ['thread_info']:
-            stack_size = event.payload_field['stack_size']
-            print(f"{dt} (+{diff_s:.6f} s): {event.name} (Stack size: {stack_size})")
-        elif event.name in ['start_call', 'end_call']:
-            if event.payload_field['id'] == 39:
+        elif event_name in ['thread_info']:
+            stack_size = payload['stack_size']
+            print(f"{dt} (+{diff_s:.6f} s): {event_name} (Stack size: {stack_size})")
+        elif event_name in ['start_call', 'end_call']:
+            if payload['id'] == 39:
                 c = Fore.GREEN
-            elif event.payload_field['id'] in [37, 38]:
+            elif payload['id'] in [37, 38]:
                 c = Fore.CYAN
             else:
                 c = Fore.YELLOW
-            print(c + f"{dt} (+{diff_s:.6f} s): {event.name} {event.payload_field['id']}" + Fore.RESET)
-        elif event.name in ['semaphore_init', 'semaphore_take', 'semaphore_give']:
+            print(c + f"{dt} (+{diff_s:.6f} s): {event_name} {payload['id']}" + Fore.RESET)
+        elif event_name in ['semaphore_init', 'semaphore_take', 'semaphore_give']:
             c = Fore.CYAN
-            print(c + f"{dt} (+{diff_s:.6f} s): {event.name} ({event.payload_field['id']})" + Fore.RESET)
-        elif event.name in ['mutex_init', 'mutex_take', 'mutex_give']:
+            print(c + f"{dt} (+{diff_s:.6f} s): {event_name} ({payload['id']})" + Fore.RESET)
+        elif event_name in ['mutex_init', 'mutex_take', 'mutex_give']:
             c = Fore.MAGENTA
-            print(c + f"{dt} (+{diff_s:.6f} s): {event.name} ({event.payload_field['id']})" + Fore.RESET)
+            print(c + f"{dt} (+{diff_s:.6f} s): {event_name} ({payload['id']})" + Fore.RESET)
 
         else:
-            print(f"{dt} (+{diff_s:.6f} s): {event.name}")
+            print(f"{dt} (+{diff_s:.6f} s): {event_name}")
 
         last_event_ns_from_origin = ns_from_origin
 
@@ -160,7 +160,7 @@ void soc_mp_startup(uint32_t cpu)
 		DSPBR_BCTL_WAITIPCG | DSPBR_BCTL_WAITIPPG;
 }
 
-void arch_sched_ipi(void)
+void arch_sched_directed_ipi(uint32_t cpu_bitmap)
 {
 	uint32_t curr = arch_proc_id();
 
@@ -168,12 +168,18 @@ void arch_sched_ipi(void)
 	unsigned int num_cpus = arch_num_cpus();
 
 	for (int core = 0; core < num_cpus; core++) {
-		if (core != curr && soc_cpus_active[core]) {
+		if ((core != curr) && soc_cpus_active[core] &&
+		    ((cpu_bitmap & BIT(core)) != 0)) {
 			IDC[core].agents[1].ipc.idr = INTEL_ADSP_IPC_BUSY;
 		}
 	}
 }
 
+void arch_sched_ipi(void)
+{
+	arch_sched_directed_ipi(BIT_MASK(CONFIG_MP_MAX_NUM_CPUS));
+}
+
 #if CONFIG_MP_MAX_NUM_CPUS > 1
 int soc_adsp_halt_cpu(int id)
 {
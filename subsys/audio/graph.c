@@ -0,0 +1,386 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include <zephyr/audio/graph.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/util.h>
+
+LOG_MODULE_REGISTER(audio_graph, CONFIG_AUDIO_GRAPH_LOG_LEVEL);
+
+/* The graphs started, of which the nodes are run by the thread */
+static sys_slist_t graphs = SYS_SLIST_STATIC_INIT(&graphs);
+static struct k_spinlock lock;
+static K_SEM_DEFINE(ready_sem, 0, 1);
+
+/* Deadlines wrap around with the cycle counter */
+static bool before(uint32_t a, uint32_t b)
+{
+	return (int32_t)(a - b) < 0;
+}
+
+static void queue_put(struct audio_node *node, uint8_t port,
+		      const struct audio_graph_block *block)
+{
+	uint8_t idx = (node->head[port] + node->count[port]) %
+		      CONFIG_AUDIO_GRAPH_QUEUE_DEPTH;
+
+	node->queue[port][idx] = *block;
+	node->count[port]++;
+}
+
+static void queue_get(struct audio_node *node, uint8_t port,
+		      struct audio_graph_block *block)
+{
+	*block = node->queue[port][node->head[port]];
+	node->head[port] = (node->head[port] + 1) % CONFIG_AUDIO_GRAPH_QUEUE_DEPTH;
+	node->count[port]--;
+}
+
+static bool queue_full(const struct audio_node *node, uint8_t port)
+{
+	return node->count[port] == CONFIG_AUDIO_GRAPH_QUEUE_DEPTH;
+}
+
+/* Earliest deadline of the blocks on the inputs, false if one of them is empty */
+static bool node_deadline(const struct audio_node *node, uint32_t *deadline)
+{
+	uint32_t port_deadline;
+
+	for (uint8_t port = 0; port < node->n_inputs; port++) {
+		if (node->count[port] == 0) {
+			return false;
+		}
+
+		port_deadline = node->queue[port][node->head[port]].deadline;
+		if (port == 0 || before(port_deadline, *deadline)) {
+			*deadline = port_deadline;
+		}
+	}
+
+	return true;
+}
+
+/* Take the blocks of the ready node of earliest deadline, called with the lock held */
+static struct audio_node *take_next(void **blocks, struct audio_graph_block *merged)
+{
+	struct audio_node *next = NULL;
+	struct audio_graph_block block;
+	struct audio_graph *graph;
+	struct audio_node *node;
+	uint32_t next_deadline;
+	uint32_t deadline;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&graphs, graph, node) {
+		SYS_SLIST_FOR_EACH_CONTAINER(&graph->nodes, node, node) {
+			if (!node_deadline(node, &deadline)) {
+				continue;
+			}
+
+			if (next == NULL || before(deadline, next_deadline)) {
+				next = node;
+				next_deadline = deadline;
+			}
+		}
+	}
+
+	if (next == NULL) {
+		return NULL;
+	}
+
+	/* The output carries the oldest block and the earliest deadline */
+	for (uint8_t port = 0; port < next->n_inputs; port++) {
+		queue_get(next, port, &block);
+		blocks[port] = block.data;
+
+		if (port == 0 || before(block.timestamp, merged->timestamp)) {
+			merged->timestamp = block.timestamp;
+		}
+	}
+
+	merged->deadline = next_deadline;
+
+	return next;
+}
+
+static void block_free(struct audio_graph *graph, void *block)
+{
+	k_mem_slab_free(graph->slab, &block);
+}
+
+static void graph_done(struct audio_graph *graph,
+		       const struct audio_graph_block *block, uint32_t now)
+{
+	struct audio_graph_stats *stats = &graph->stats;
+	uint32_t ns = k_cyc_to_ns_floor64(now - block->timestamp);
+
+	stats->blocks++;
+	stats->latency_ns += ns;
+	stats->min_latency_ns = MIN(stats->min_latency_ns, ns);
+	stats->max_latency_ns = MAX(stats->max_latency_ns, ns);
+
+	if (before(block->deadline, now)) {
+		stats->late++;
+	}
+}
+
+static void node_run(struct audio_node *node, void **blocks,
+		     struct audio_graph_block *block)
+{
+	struct audio_graph *graph = node->graph;
+	struct audio_node *next = node->next;
+	k_spinlock_key_t key;
+	uint32_t start;
+	uint32_t now;
+	uint32_t ns;
+	int ret;
+
+	start = k_cycle_get_32();
+	ret = node->process(node, blocks);
+	now = k_cycle_get_32();
+
+	for (uint8_t port = 1; port < node->n_inputs; port++) {
+		if (blocks[port] != NULL) {
+			block_free(graph, blocks[port]);
+		}
+	}
+
+	key = k_spin_lock(&lock);
+
+	ns = k_cyc_to_ns_floor64(now - start);
+	node->stats.blocks++;
+	node->stats.busy_ns += ns;
+	node->stats.max_ns = MAX(node->stats.max_ns, ns);
+
+	if (ret < 0) {
+		node->stats.errors++;
+		next = NULL;
+	} else if (next == NULL || blocks[0] == NULL) {
+		graph_done(graph, block, now);
+		next = NULL;
+	} else if (queue_full(next, node->next_port)) {
+		next->stats.dropped++;
+		next = NULL;
+	} else {
+		block->data = blocks[0];
+		queue_put(next, node->next_port, block);
+	}
+
+	k_spin_unlock(&lock, key);
+
+	if (ret < 0) {
+		LOG_WRN("%s failed to process a block: %d", node->name, ret);
+	}
+
+	/* Freed unless passed to the next node or taken by a sink */
+	if (next == NULL && blocks[0] != NULL) {
+		block_free(graph, blocks[0]);
+	}
+}
+
+static void audio_graph_thread(void)
+{
+	void *blocks[CONFIG_AUDIO_GRAPH_MAX_INPUTS];
+	struct audio_graph_block block;
+	struct audio_node *node;
+	k_spinlock_key_t key;
+
+	while (true) {
+		(void)k_sem_take(&ready_sem, K_FOREVER);
+
+		while (true) {
+			key = k_spin_lock(&lock);
+			node = take_next(blocks, &block);
+			k_spin_unlock(&lock, key);
+
+			if (node == NULL) {
+				break;
+			}
+
+			node_run(node, blocks, &block);
+		}
+	}
+}
+
+K_THREAD_DEFINE(audio_graph, CONFIG_AUDIO_GRAPH_THREAD_STACK_SIZE,
+		audio_graph_thread, NULL, NULL, NULL,
+		CONFIG_AUDIO_GRAPH_THREAD_PRIORITY, 0, 0);
+
+void audio_graph_init(struct audio_graph *graph, struct k_mem_slab *slab,
+		      uint32_t deadline_us)
+{
+	memset(graph, 0, sizeof(*graph));
+	graph->slab = slab;
+	graph->deadline_cycles = k_us_to_cyc_ceil32(deadline_us);
+	sys_slist_init(&graph->nodes);
+	audio_graph_stats_reset(graph);
+}
+
+void audio_node_init(struct audio_node *node, const char *name,
+		     audio_node_process_t process, uint8_t n_inputs,
+		     void *user_data)
+{
+	__ASSERT(n_inputs > 0 && n_inputs <= CONFIG_AUDIO_GRAPH_MAX_INPUTS,
+		 "Invalid number of inputs %u", n_inputs);
+
+	memset(node, 0, sizeof(*node));
+	node->name = name;
+	node->process = process;
+	node->n_inputs = n_inputs;
+	node->user_data = user_data;
+}
+
+void audio_graph_add(struct audio_graph *graph, struct audio_node *node)
+{
+	node->graph = graph;
+	sys_slist_append(&graph->nodes, &node->node);
+}
+
+int audio_graph_connect(struct audio_node *src, struct audio_node *dst,
+			uint8_t port)
+{
+	if (port >= dst->n_inputs || src->graph == NULL ||
+	    src->graph != dst->graph) {
+		return -EINVAL;
+	}
+
+	src->next = dst;
+	src->next_port = port;
+
+	return 0;
+}
+
+void audio_graph_start(struct audio_graph *graph)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	sys_slist_append(&graphs, &graph->node);
+
+	k_spin_unlock(&lock, key);
+}
+
+void audio_graph_stop(struct audio_graph *graph)
+{
+	struct audio_graph_block block;
+	struct audio_node *node;
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&lock);
+
+	(void)sys_slist_find_and_remove(&graphs, &graph->node);
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&graph->nodes, node, node) {
+		for (uint8_t port = 0; port < node->n_inputs; port++) {
+			while (node->count[port] > 0) {
+				queue_get(node, port, &block);
+				block_free(graph, block.data);
+			}
+		}
+	}
+
+	k_spin_unlock(&lock, key);
+}
+
+int audio_graph_push(struct audio_node *node, uint8_t port, void *block)
+{
+	struct audio_graph_block queued = {
+		.data = block,
+		.timestamp = k_cycle_get_32(),
+	};
+	k_spinlock_key_t key;
+
+	if (port >= node->n_inputs) {
+		return -EINVAL;
+	}
+
+	queued.deadline = queued.timestamp + node->graph->deadline_cycles;
+
+	key = k_spin_lock(&lock);
+
+	if (queue_full(node, port)) {
+		node->stats.dropped++;
+		k_spin_unlock(&lock, key);
+		return -ENOBUFS;
+	}
+
+	queue_put(node, port, &queued);
+
+	k_spin_unlock(&lock, key);
+
+	k_sem_give(&ready_sem);
+
+	return 0;
+}
+
+void *audio_node_block_alloc(struct audio_node *node)
+{
+	void *block;
+
+	if (k_mem_slab_alloc(node->graph->slab, &block, K_NO_WAIT) != 0) {
+		return NULL;
+	}
+
+	return block;
+}
+
+void audio_node_block_free(struct audio_node *node, void *block)
+{
+	block_free(node->graph, block);
+}
+
+void audio_graph_stats_reset(struct audio_graph *graph)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	struct audio_node *node;
+
+	memset(&graph->stats, 0, sizeof(graph->stats));
+	graph->stats.min_latency_ns = UINT32_MAX;
+	graph->stats.start_ticks = k_uptime_ticks();
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&graph->nodes, node, node) {
+		memset(&node->stats, 0, sizeof(node->stats));
+	}
+
+	k_spin_unlock(&lock, key);
+}
+
+void audio_graph_stats_report(struct audio_graph *graph)
+{
+	struct audio_graph_stats stats;
+	struct audio_node_stats node_stats;
+	struct audio_node *node;
+	k_spinlock_key_t key;
+	uint64_t elapsed_ns;
+	uint32_t load;
+
+	key = k_spin_lock(&lock);
+	stats = graph->stats;
+	k_spin_unlock(&lock, key);
+
+	elapsed_ns = MAX(k_ticks_to_ns_floor64(k_uptime_ticks() - stats.start_ticks), 1);
+
+	LOG_INF("%u blocks, %u late, latency min %u avg %u max %u us", stats.blocks,
+		stats.late, stats.blocks ? stats.min_latency_ns / NSEC_PER_USEC : 0,
+		stats.blocks ? (uint32_t)(stats.latency_ns / stats.blocks / NSEC_PER_USEC) : 0,
+		stats.max_latency_ns / NSEC_PER_USEC);
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&graph->nodes, node, node) {
+		key = k_spin_lock(&lock);
+		node_stats = node->stats;
+		k_spin_unlock(&lock, key);
+
+		/* Load in hundredths of percent */
+		load = node_stats.busy_ns * 10000U / elapsed_ns;
+
+		LOG_INF("%s: load %u.%02u%%, %u blocks, %u dropped, %u errors, max %u us",
+			node->name, load / 100, load % 100, node_stats.blocks,
+			node_stats.dropped, node_stats.errors,
+			node_stats.max_ns / NSEC_PER_USEC);
+	}
+}
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+
+#include <zephyr/audio/graph_nodes.h>
+#include <zephyr/sys/util.h>
+
+static uint32_t block_samples(const struct audio_node *node)
+{
+	return audio_node_block_size(node) / sizeof(q15_t);
+}
+
+static int gain_process(struct audio_node *node, void **blocks)
+{
+	struct audio_node_gain *gain = CONTAINER_OF(node, struct audio_node_gain, node);
+
+	zdsp_scale_q15(blocks[0], gain->scale_fract, gain->shift, blocks[0],
+		       block_samples(node));
+
+	return 0;
+}
+
+void audio_node_gain_init(struct audio_node_gain *gain, const char *name,
+			  q15_t scale_fract, int8_t shift)
+{
+	audio_node_init(&gain->node, name, gain_process, 1, NULL);
+	gain->scale_fract = scale_fract;
+	gain->shift = shift;
+}
+
+static int mixer_process(struct audio_node *node, void **blocks)
+{
+	zdsp_add_q15(blocks[0], blocks[1], blocks[0], block_samples(node));
+
+	return 0;
+}
+
+void audio_node_mixer_init(struct audio_node *mixer, const char *name)
+{
+	audio_node_init(mixer, name, mixer_process, 2, NULL);
+}
+
+#if defined(CONFIG_AUDIO_GRAPH_BIQUAD)
+static int biquad_process(struct audio_node *node, void **blocks)
+{
+	struct audio_node_biquad *biquad = CONTAINER_OF(node, struct audio_node_biquad, node);
+
+	/* The cascade runs in place, each stage filtering the output of the previous one */
+	arm_biquad_cascade_df1_q15(&biquad->inst, blocks[0], blocks[0], block_samples(node));
+
+	return 0;
+}
+
+int audio_node_biquad_init(struct audio_node_biquad *biquad, const char *name,
+			   uint8_t n_stages, const q15_t *coeffs, int8_t post_shift)
+{
+	if (n_stages == 0 || n_stages > CONFIG_AUDIO_GRAPH_BIQUAD_MAX_STAGES) {
+		return -EINVAL;
+	}
+
+	audio_node_init(&biquad->node, name, biquad_process, 1, NULL);
+	arm_biquad_cascade_df1_init_q15(&biquad->inst, n_stages, coeffs, biquad->state,
+					post_shift);
+
+	return 0;
+}
+#endif /* CONFIG_AUDIO_GRAPH_BIQUAD */
@@ -6,6 +6,7 @@
  */
 
 #include <stdbool.h>
+#include <string.h>
 #include <zephyr/types.h>
 #include <soc.h>
 
@@ -332,6 +333,12 @@ struct ticker_instance {
 						     * the trigger (compare
 						     * value)
 						     */
+
+#if defined(CONFIG_BT_TICKER_STATS)
+	struct ticker_stats stats;	/* Job, worker and scheduling
+					 * statistics
+					 */
+#endif /* CONFIG_BT_TICKER_STATS */
 };
 
 BUILD_ASSERT(sizeof(struct ticker_node)    == TICKER_NODE_T_SIZE);
@@ -367,6 +374,121 @@ static inline void ticker_next_elapsed(uint8_t *ticks_elapsed_index)
 	*ticks_elapsed_index = idx;
 }
 
+#if defined(CONFIG_BT_TICKER_STATS)
+/**
+ * @brief Get counter value for statistics
+ *
+ * @return Current counter value
+ * @internal
+ */
+static inline uint32_t ticker_stats_cnt_get(void)
+{
+	return cntr_cnt_get();
+}
+
+/**
+ * @brief Account a ticker_job execution
+ *
+ * @param instance    Pointer to ticker instance
+ * @param ticks_start Counter value when the job started
+ * @internal
+ */
+static inline void ticker_stats_job(struct ticker_instance *instance,
+				    uint32_t ticks_start)
+{
+	struct ticker_stats *stats = &instance->stats;
+	uint32_t ticks;
+
+	ticks = ticker_ticks_diff_get(cntr_cnt_get(), ticks_start);
+
+	stats->job_count++;
+	stats->job_ticks_last = ticks;
+	stats->job_ticks_total += ticks;
+	if (ticks > stats->job_ticks_max) {
+		stats->job_ticks_max = ticks;
+	}
+}
+
+/**
+ * @brief Account a ticker_worker execution
+ *
+ * @param instance    Pointer to ticker instance
+ * @param ticks_start Counter value when the worker started
+ * @param expired     Number of ticker nodes expired by the worker
+ * @internal
+ */
+static inline void ticker_stats_worker(struct ticker_instance *instance,
+				       uint32_t ticks_start, uint8_t expired)
+{
+	struct ticker_stats *stats = &instance->stats;
+	uint32_t ticks;
+
+	ticks = ticker_ticks_diff_get(cntr_cnt_get(), ticks_start);
+
+	stats->worker_count++;
+	if (ticks > stats->worker_ticks_max) {
+		stats->worker_ticks_max = ticks;
+	}
+	if (expired > stats->worker_expired_max) {
+		stats->worker_expired_max = expired;
+	}
+}
+
+/**
+ * @brief Account a ticker node expiry skipped due to slot collision
+ *
+ * @param instance Pointer to ticker instance
+ * @internal
+ */
+static inline void ticker_stats_skip(struct ticker_instance *instance)
+{
+	instance->stats.skip_count++;
+}
+
+/**
+ * @brief Account a ticker node enqueue
+ *
+ * @param instance Pointer to ticker instance
+ * @param walk     Number of ticker nodes traversed to find the insertion
+ *                 point
+ * @internal
+ */
+static inline void ticker_stats_enqueue(struct ticker_instance *instance,
+					uint8_t walk)
+{
+	struct ticker_stats *stats = &instance->stats;
+
+	stats->enqueue_count++;
+	if (walk > stats->enqueue_walk_max) {
+		stats->enqueue_walk_max = walk;
+	}
+}
+#else /* !CONFIG_BT_TICKER_STATS */
+static inline uint32_t ticker_stats_cnt_get(void)
+{
+	return 0U;
+}
+
+static inline void ticker_stats_job(struct ticker_instance *instance,
+				    uint32_t ticks_start)
+{
+}
+
+static inline void ticker_stats_worker(struct ticker_instance *instance,
+				       uint32_t ticks_start, uint8_t expired)
+{
+}
+
+static inline void ticker_stats_skip(struct ticker_instance *instance)
+{
+}
+
+static inline void ticker_stats_enqueue(struct ticker_instance *instance,
+					uint8_t walk)
+{
+}
+#endif /* !CONFIG_BT_TICKER_STATS */
+
 #if defined(CONFIG_BT_TICKER_LOW_LAT)
 /**
  * @brief Get ticker expiring in a specific slot
@@ -552,11 +674,13 @@ static uint8_t ticker_enqueue(struct ticker_instance *instance, uint8_t id)
 	uint32_t ticks_to_expire;
 	uint8_t previous;
 	uint8_t current;
+	uint8_t walk;
 
 	node = &instance->nodes[0];
 	ticker_new = &node[id];
 	ticks_to_expire = ticker_new->ticks_to_expire;
 	current = instance->ticker_id_head;
+	walk = 0U;
 
 	/* Find insertion point for new ticker node and adjust ticks_to_expire
 	 * relative to insertion point
@@ -580,8 +704,11 @@ static uint8_t ticker_enqueue(struct ticker_instance *instance, uint8_t id)
 
 		previous = current;
 		current = ticker_current->next;
+		walk++;
 	}
 
+	ticker_stats_enqueue(instance, walk);
+
 	/* Link in new ticker node and adjust ticks_to_expire to relative value
 	 */
 	ticker_new->ticks_to_expire = ticks_to_expire;
@@ -628,10 +755,12 @@ static uint8_t ticker_enqueue(struct ticker_instance *instance, uint8_t id)
 	uint8_t previous;
 	uint8_t current;
 	uint8_t collide;
+	uint8_t walk;
 
 	node = &instance->nodes[0];
 	ticker_new = &node[id];
 	ticks_to_expire = ticker_new->ticks_to_expire;
+	walk = 0U;
 
 	collide = ticker_id_slot_previous = TICKER_NULL;
 	current = instance->ticker_id_head;
@@ -659,8 +788,11 @@ static uint8_t ticker_enqueue(struct ticker_instance *instance, uint8_t id)
 		}
 		previous = current;
 		current = ticker_current->next;
+		walk++;
 	}
 
+	ticker_stats_enqueue(instance, walk);
+
 	/* Check for collision for new ticker node at insertion point */
 	collide = ticker_by_slot_get(&node[0], current,
 				     ticks_to_expire + ticker_new->ticks_slot);
@@ -1210,10 +1342,12 @@ static void ticker_job_update_expire_infos(struct ticker_instance *instance)
 void ticker_worker(void *param)
 {
 	struct ticker_instance *instance = param;
+	uint32_t ticks_stats_start;
 	struct ticker_node *node;
 	uint32_t ticks_elapsed;
 	uint32_t ticks_expired;
 	uint8_t ticker_id_head;
+	uint8_t expired;
 
 	/* Defer worker if job running */
 	instance->worker_trigger = 1U;
@@ -1227,6 +1361,9 @@ void ticker_worker(void *param)
 		return;
 	}
 
+	ticks_stats_start = ticker_stats_cnt_get();
+	expired = 0U;
+
 	/* Get ticks elapsed since last job execution */
 	ticks_elapsed = ticker_ticks_diff_get(cntr_cnt_get(),
 					      instance->ticks_current);
@@ -1314,6 +1451,7 @@ void ticker_worker(void *param)
 			 * ticker_job_reschedule_in_window when completed.
 			 */
 			ticker->lazy_current++;
+			ticker_stats_skip(instance);
 
 			if ((ticker->must_expire == 0U) ||
 			    (ticker->lazy_periodic >= ticker->lazy_current) ||
@@ -1355,6 +1493,7 @@ void ticker_worker(void *param)
 
 		/* Scheduled timeout is acknowledged to be complete */
 		ticker->ack--;
+		expired++;
 
 		if (ticker->timeout_func) {
 			uint32_t ticks_at_expire;
@@ -1440,6 +1579,8 @@ void ticker_worker(void *param)
 
 	instance->worker_trigger = 0U;
 
+	ticker_stats_worker(instance, ticks_stats_start, expired);
+
 	/* Enqueue the ticker job with chain=1 (do not inline) */
 	instance->sched_cb(TICKER_CALL_ID_WORKER, TICKER_CALL_ID_JOB, 1,
 			   instance);
@@ -3022,6 +3163,7 @@ void ticker_job(void *param)
 	struct ticker_instance *instance = param;
 	uint8_t flag_compare_update;
 	uint8_t ticker_id_old_head;
+	uint32_t ticks_stats_start;
 	uint8_t compare_trigger;
 	uint32_t ticks_previous;
 	uint32_t ticks_elapsed;
@@ -3045,6 +3187,7 @@ void ticker_job(void *param)
 		return;
 	}
 	instance->job_guard = 1U;
+	ticks_stats_start = ticker_stats_cnt_get();
 
 	/* Back up the previous known tick */
 	ticks_previous = instance->ticks_current;
@@ -3144,6 +3287,8 @@ void ticker_job(void *param)
 		compare_trigger = 0U;
 	}
 
+	ticker_stats_job(instance, ticks_stats_start);
+
 	/* Permit worker to run */
 	instance->job_guard = 0U;
 
@@ -3235,6 +3380,10 @@ uint8_t ticker_init(uint8_t instance_index, uint8_t count_node, void *node,
 	instance->ticks_elapsed_first = 0U;
 	instance->ticks_elapsed_last = 0U;
 
+#if defined(CONFIG_BT_TICKER_STATS)
+	(void)memset(&instance->stats, 0, sizeof(instance->stats));
+#endif /* CONFIG_BT_TICKER_STATS */
+
 #if !defined(CONFIG_BT_TICKER_SLOT_AGNOSTIC)
 	instance->ticker_id_slot_previous = TICKER_NULL;
 	instance->ticks_slot_previous = 0U;
@@ -3262,6 +3411,53 @@ bool ticker_is_initialized(uint8_t instance_index)
 	return !!(_instance[instance_index].count_node);
 }
 
+#if defined(CONFIG_BT_TICKER_STATS)
+/**
+ * @brief Get ticker instance statistics
+ *
+ * @details Copies the statistics accumulated by ticker_job and
+ * ticker_worker since initialization or the last ticker_stats_reset. The
+ * copy is not synchronized with the ticker execution contexts, fields may
+ * be updated while being copied.
+ *
+ * @param instance_index Index of ticker instance
+ * @param stats          Pointer to statistics to fill
+ *
+ * @return TICKER_STATUS_SUCCESS, or TICKER_STATUS_FAILURE if the instance
+ * index is invalid
+ */
+uint8_t ticker_stats_get(uint8_t instance_index, struct ticker_stats *stats)
+{
+	if (instance_index >= TICKER_INSTANCE_MAX) {
+		return TICKER_STATUS_FAILURE;
+	}
+
+	(void)memcpy(stats, &_instance[instance_index].stats, sizeof(*stats));
+
+	return TICKER_STATUS_SUCCESS;
+}
+
+/**
+ * @brief Reset ticker instance statistics
+ *
+ * @param instance_index Index of ticker instance
+ *
+ * @return TICKER_STATUS_SUCCESS, or TICKER_STATUS_FAILURE if the instance
+ * index is invalid
+ */
+uint8_t ticker_stats_reset(uint8_t instance_index)
+{
+	if (instance_index >= TICKER_INSTANCE_MAX) {
+		return TICKER_STATUS_FAILURE;
+	}
+
+	(void)memset(&_instance[instance_index].stats, 0,
+		     sizeof(_instance[instance_index].stats));
+
+	return TICKER_STATUS_SUCCESS;
+}
+#endif /* CONFIG_BT_TICKER_STATS */
+
 /**
  * @brief Trigger the ticker worker
  *
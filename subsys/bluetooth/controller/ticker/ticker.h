@@ -203,6 +203,32 @@ void ticker_job_sched(uint8_t instance_index, uint8_t user_id);
 uint32_t ticker_ticks_now_get(void);
 uint32_t ticker_ticks_diff_get(uint32_t ticks_now, uint32_t ticks_old);
 
+#if defined(CONFIG_BT_TICKER_STATS)
+/** \brief Ticker instance statistics, tick values are in counter ticks.
+ */
+struct ticker_stats {
+	uint32_t job_count;          /* Number of ticker_job executions */
+	uint32_t job_ticks_last;     /* Duration of the last ticker_job */
+	uint32_t job_ticks_max;      /* Longest ticker_job duration */
+	uint64_t job_ticks_total;    /* Accumulated ticker_job duration */
+	uint32_t worker_count;       /* Number of ticker_worker executions */
+	uint32_t worker_ticks_max;   /* Longest ticker_worker duration,
+				      * including the timeout callbacks
+				      */
+	uint32_t skip_count;         /* Expiries skipped due to slot
+				      * collision
+				      */
+	uint32_t enqueue_count;      /* Number of ticker node insertions */
+	uint8_t  worker_expired_max; /* Most nodes expired in one worker */
+	uint8_t  enqueue_walk_max;   /* Most nodes traversed to find an
+				      * insertion point
+				      */
+};
+
+uint8_t ticker_stats_get(uint8_t instance_index, struct ticker_stats *stats);
+uint8_t ticker_stats_reset(uint8_t instance_index);
+#endif /* CONFIG_BT_TICKER_STATS */
+
 #if !defined(CONFIG_BT_TICKER_LOW_LAT) && \
 	!defined(CONFIG_BT_TICKER_SLOT_AGNOSTIC)
 uint8_t ticker_priority_set(uint8_t instance_index, uint8_t user_id,
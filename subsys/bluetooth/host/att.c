@@ -148,6 +148,10 @@ struct bt_att {
 		uint16_t prev_conn_rsp_result;
 		uint16_t prev_conn_req_result;
 		uint8_t prev_conn_req_missing_chans;
+#if defined(CONFIG_BT_EATT_TX_SPREAD)
+		/* Position of the bearer to try first for the next PDU */
+		uint8_t tx_next;
+#endif /* CONFIG_BT_EATT_TX_SPREAD */
 	} eatt;
 #endif /* CONFIG_BT_EATT */
 };
@@ -356,7 +360,9 @@ static struct net_buf *get_first_buf_matching_chan(struct k_fifo *fifo, struct b
 
 		while ((buf = net_buf_get(fifo, K_NO_WAIT))) {
 			if (!ret &&
-			    att_chan_matches_chan_opt(chan, bt_att_tx_meta_data(buf)->chan_opt)) {
+			    att_chan_matches_chan_opt(chan, bt_att_tx_meta_data(buf)->chan_opt) &&
+			    (!IS_ENABLED(CONFIG_BT_EATT_TX_SPREAD) ||
+			     net_buf_frags_len(buf) <= bt_att_mtu(chan))) {
 				ret = buf;
 			} else {
 				net_buf_put(&skipped, buf);
@@ -761,6 +767,45 @@ static int bt_att_chan_send(struct bt_att_chan *chan, struct net_buf *buf)
 	return chan_send(chan, buf);
 }
 
+#if defined(CONFIG_BT_EATT_TX_SPREAD)
+static void att_send_process(struct bt_att *att)
+{
+	struct bt_att_chan *chan;
+	size_t count = sys_slist_len(&att->chans);
+
+	if (count == 0) {
+		return;
+	}
+
+	/* Enhanced bearers first, starting after the last one used */
+	for (size_t i = 0; i < count; i++) {
+		size_t pos = (att->eatt.tx_next + i) % count;
+		size_t n = 0;
+
+		SYS_SLIST_FOR_EACH_CONTAINER(&att->chans, chan, node) {
+			if (n++ == pos) {
+				break;
+			}
+		}
+
+		if (!bt_att_is_enhanced(chan)) {
+			continue;
+		}
+
+		if (!process_queue(chan, &att->tx_queue)) {
+			att->eatt.tx_next = pos + 1;
+			return;
+		}
+	}
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&att->chans, chan, node) {
+		if (!bt_att_is_enhanced(chan) &&
+		    !process_queue(chan, &att->tx_queue)) {
+			return;
+		}
+	}
+}
+#else
 static void att_send_process(struct bt_att *att)
 {
 	struct bt_att_chan *chan, *tmp, *prev = NULL;
@@ -785,6 +830,7 @@ static void att_send_process(struct bt_att *att)
 		prev = chan;
 	}
 }
+#endif /* CONFIG_BT_EATT_TX_SPREAD */
 
 static void bt_att_chan_send_rsp(struct bt_att_chan *chan, struct net_buf *buf)
 {
@@ -414,7 +414,7 @@ static struct bt_conn_tx *conn_tx_alloc(void)
 }
 
 int bt_conn_send_iso_cb(struct bt_conn *conn, struct net_buf *buf,
-			bt_conn_tx_cb_t cb, bool has_ts)
+			bt_conn_tx_cb_t cb, void *user_data, bool has_ts)
 {
 	if (buf->user_data_size < CONFIG_BT_CONN_TX_USER_DATA_SIZE) {
 		LOG_ERR("not enough room in user_data %d < %d",
@@ -428,7 +428,7 @@ int bt_conn_send_iso_cb(struct bt_conn *conn, struct net_buf *buf,
 	 */
 	tx_data(buf)->iso_has_ts = has_ts;
 
-	int err = bt_conn_send_cb(conn, buf, cb, NULL);
+	int err = bt_conn_send_cb(conn, buf, cb, user_data);
 
 	if (err) {
 		return err;
@@ -961,6 +961,98 @@ void bt_conn_process_tx(struct bt_conn *conn)
 	}
 }
 
+#if defined(CONFIG_BT_CONN_TX_BATCH)
+static uint16_t conn_tx_interval(struct bt_conn *conn)
+{
+#if defined(CONFIG_BT_CONN)
+	if (conn->type == BT_CONN_TYPE_LE) {
+		return conn->le.interval;
+	}
+#endif /* CONFIG_BT_CONN */
+
+	return 0U;
+}
+
+static uint8_t conn_tx_weight(struct bt_conn *conn, uint16_t min_interval)
+{
+	uint16_t interval = conn_tx_interval(conn);
+
+	if (interval == 0U || min_interval == 0U) {
+		return 1U;
+	}
+
+	return CLAMP(interval / min_interval, 1U,
+		     CONFIG_BT_CONN_TX_BATCH_MAX_WEIGHT);
+}
+
+static bool conn_tx_ready(struct bt_conn *conn)
+{
+	struct k_sem *pkts = bt_conn_get_pkts(conn);
+
+	return conn->state == BT_CONN_CONNECTED && pkts != NULL &&
+	       k_sem_count_get(pkts) > 0 && !k_fifo_is_empty(&conn->tx_queue);
+}
+
+void bt_conn_process_tx_batch(struct bt_conn *conns[], size_t count)
+{
+	static size_t next;
+	uint16_t min_interval = UINT16_MAX;
+	size_t start;
+	bool sent;
+
+	if (count == 0) {
+		return;
+	}
+
+	for (size_t i = 0; i < count; i++) {
+		uint16_t interval = conn_tx_interval(conns[i]);
+
+		if (interval != 0U) {
+			min_interval = MIN(min_interval, interval);
+		}
+	}
+
+	/* Rotate the connection served first, so that when the controller
+	 * buffers run out it is not always the same connections that miss
+	 * out.
+	 */
+	start = next++ % count;
+
+	/* Every ready connection gets one call as without batching, which
+	 * also takes care of the cleanup of the disconnected ones.
+	 */
+	for (size_t i = 0; i < count; i++) {
+		bt_conn_process_tx(conns[(start + i) % count]);
+	}
+
+	/* Then keep going round-robin until the controller buffers or the
+	 * data run out.
+	 */
+	do {
+		sent = false;
+
+		for (size_t i = 0; i < count; i++) {
+			struct bt_conn *conn = conns[(start + i) % count];
+			uint8_t n = conn_tx_weight(conn, min_interval);
+
+			while (n-- > 0U && conn_tx_ready(conn)) {
+				struct k_sem *pkts = bt_conn_get_pkts(conn);
+				unsigned int avail = k_sem_count_get(pkts);
+
+				bt_conn_process_tx(conn);
+
+				/* Move on if no controller buffer was used */
+				if (k_sem_count_get(pkts) >= avail) {
+					break;
+				}
+
+				sent = true;
+			}
+		}
+	} while (sent);
+}
+#endif /* CONFIG_BT_CONN_TX_BATCH */
+
 static void process_unack_tx(struct bt_conn *conn)
 {
 	/* Return any unacknowledged packets */
@@ -132,6 +132,26 @@ struct bt_conn_iso {
 
 	/** Stored information about the ISO stream */
 	struct bt_iso_info info;
+
+#if defined(CONFIG_BT_ISO_STATS)
+	/** Statistics of the ISO stream */
+	struct bt_iso_chan_stats stats;
+
+	/* Cycle count at which the last SDU was queued */
+	uint32_t tx_last;
+
+	/* Cycle count of the nominal slot of the last queued SDU */
+	uint32_t tx_due;
+
+	/* Cycle count at which the last SDU was received */
+	uint32_t rx_last;
+
+	/* Timestamp of the last received SDU */
+	uint32_t rx_last_ts;
+
+	/* True if the last received SDU had a timestamp */
+	bool rx_has_ts;
+#endif /* CONFIG_BT_ISO_STATS */
 };
 
 typedef void (*bt_conn_tx_cb_t)(struct bt_conn *conn, void *user_data, int err);
@@ -250,7 +270,7 @@ int bt_conn_send_cb(struct bt_conn *conn, struct net_buf *buf,
  * Return values & buf ownership same as parent.
  */
 int bt_conn_send_iso_cb(struct bt_conn *conn, struct net_buf *buf,
-			bt_conn_tx_cb_t cb, bool has_ts);
+			bt_conn_tx_cb_t cb, void *user_data, bool has_ts);
 
 static inline int bt_conn_send(struct bt_conn *conn, struct net_buf *buf)
 {
@@ -425,3 +445,4 @@ struct k_sem *bt_conn_get_pkts(struct bt_conn *conn);
 /* k_poll related helpers for the TX thread */
 int bt_conn_prepare_events(struct k_poll_event events[]);
 void bt_conn_process_tx(struct bt_conn *conn);
+void bt_conn_process_tx_batch(struct bt_conn *conns[], size_t count);
@@ -1150,6 +1150,137 @@ BT_GATT_SERVICE_DEFINE(_1_gatt_svc,
 #endif /* CONFIG_BT_GATT_SERVICE_CHANGED */
 );
 
+#if defined(CONFIG_BT_GATT_DB_INDEX)
+/* Attributes of the database in ascending handle order */
+struct gatt_index_attr {
+	const struct bt_gatt_attr *attr;
+	uint16_t handle;
+};
+
+/* Attributes with a 16-bit UUID, by UUID then ascending handle order */
+struct gatt_index_uuid {
+	uint16_t uuid;
+	uint16_t idx;
+};
+
+static struct gatt_index {
+	struct gatt_index_attr attrs[CONFIG_BT_GATT_DB_INDEX_SIZE];
+	struct gatt_index_uuid uuids[CONFIG_BT_GATT_DB_INDEX_SIZE];
+	uint16_t attr_count;
+	uint16_t uuid_count;
+	bool valid;
+} gatt_index;
+
+/* Get the 16-bit form of a UUID, if it is has one */
+static bool gatt_index_uuid16(const struct bt_uuid *uuid, uint16_t *val)
+{
+	switch (uuid->type) {
+	case BT_UUID_TYPE_16:
+		*val = BT_UUID_16(uuid)->val;
+		return true;
+	case BT_UUID_TYPE_32:
+		if (BT_UUID_32(uuid)->val > UINT16_MAX) {
+			return false;
+		}
+
+		*val = BT_UUID_32(uuid)->val;
+		return true;
+	case BT_UUID_TYPE_128: {
+		struct bt_uuid_16 uuid16 = {
+			.uuid = { BT_UUID_TYPE_16 },
+			.val = sys_get_le16(&BT_UUID_128(uuid)->val[12]),
+		};
+
+		/* Only if derived from the Bluetooth base UUID */
+		if (bt_uuid_cmp(uuid, &uuid16.uuid)) {
+			return false;
+		}
+
+		*val = uuid16.val;
+		return true;
+	}
+	default:
+		return false;
+	}
+}
+
+static bool gatt_index_add(const struct bt_gatt_attr *attr, uint16_t handle)
+{
+	struct gatt_index_uuid *entry;
+	uint16_t uuid;
+	size_t i;
+
+	if (gatt_index.attr_count == ARRAY_SIZE(gatt_index.attrs)) {
+		return false;
+	}
+
+	gatt_index.attrs[gatt_index.attr_count].attr = attr;
+	gatt_index.attrs[gatt_index.attr_count].handle = handle;
+
+	if (gatt_index_uuid16(attr->uuid, &uuid)) {
+		/* Insertion sort, attributes are added in handle order so
+		 * entries with the same UUID stay sorted by handle.
+		 */
+		for (i = gatt_index.uuid_count;
+		     i > 0 && gatt_index.uuids[i - 1].uuid > uuid; i--) {
+			gatt_index.uuids[i] = gatt_index.uuids[i - 1];
+		}
+
+		entry = &gatt_index.uuids[i];
+		entry->uuid = uuid;
+		entry->idx = gatt_index.attr_count;
+		gatt_index.uuid_count++;
+	}
+
+	gatt_index.attr_count++;
+
+	return true;
+}
+
+/* Shall be called whenever services are added or removed */
+static void gatt_index_rebuild(void)
+{
+	uint16_t handle = 1;
+
+	gatt_index.valid = false;
+	gatt_index.attr_count = 0U;
+	gatt_index.uuid_count = 0U;
+
+	STRUCT_SECTION_FOREACH(bt_gatt_service_static, static_svc) {
+		for (size_t i = 0; i < static_svc->attr_count; i++, handle++) {
+			if (!gatt_index_add(&static_svc->attrs[i], handle)) {
+				goto full;
+			}
+		}
+	}
+
+#if defined(CONFIG_BT_GATT_DYNAMIC_DB)
+	struct bt_gatt_service *svc;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&db, svc, node) {
+		for (size_t i = 0; i < svc->attr_count; i++) {
+			if (!gatt_index_add(&svc->attrs[i],
+					    svc->attrs[i].handle)) {
+				goto full;
+			}
+		}
+	}
+#endif /* CONFIG_BT_GATT_DYNAMIC_DB */
+
+	gatt_index.valid = true;
+
+	return;
+
+full:
+	LOG_WRN("Too many attributes for the index, "
+		"increase CONFIG_BT_GATT_DB_INDEX_SIZE");
+}
+#else
+static inline void gatt_index_rebuild(void)
+{
+}
+#endif /* CONFIG_BT_GATT_DB_INDEX */
+
 #if defined(CONFIG_BT_GATT_DYNAMIC_DB)
 static uint8_t found_attr(const struct bt_gatt_attr *attr, uint16_t handle,
 			  void *user_data)
@@ -1231,6 +1362,7 @@ populate:
 	}
 
 	gatt_insert(svc, last_handle);
+	gatt_index_rebuild();
 
 	return 0;
 }
@@ -1454,6 +1586,8 @@ static void bt_gatt_service_init(void)
 	STRUCT_SECTION_FOREACH(bt_gatt_service_static, svc) {
 		last_static_handle += svc->attr_count;
 	}
+
+	gatt_index_rebuild();
 }
 
 void bt_gatt_init(void)
@@ -1631,6 +1765,8 @@ static int gatt_unregister(struct bt_gatt_service *svc)
 		return -ENOENT;
 	}
 
+	gatt_index_rebuild();
+
 	for (uint16_t i = 0; i < svc->attr_count; i++) {
 		struct bt_gatt_attr *attr = &svc->attrs[i];
 
@@ -1991,6 +2127,91 @@ static void foreach_attr_type_dyndb(uint16_t start_handle, uint16_t end_handle,
 #endif /* CONFIG_BT_GATT_DYNAMIC_DB */
 }
 
+#if defined(CONFIG_BT_GATT_DB_INDEX)
+/* Index of the first attribute with a handle of at least @a handle */
+static size_t gatt_index_find_handle(uint16_t handle)
+{
+	size_t lo = 0, hi = gatt_index.attr_count;
+
+	while (lo < hi) {
+		size_t mid = lo + (hi - lo) / 2;
+
+		if (gatt_index.attrs[mid].handle < handle) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+
+	return lo;
+}
+
+/* Index of the first @a uuid entry with a handle of at least @a handle */
+static size_t gatt_index_find_uuid(uint16_t uuid, uint16_t handle)
+{
+	size_t lo = 0, hi = gatt_index.uuid_count;
+
+	while (lo < hi) {
+		size_t mid = lo + (hi - lo) / 2;
+		const struct gatt_index_uuid *entry = &gatt_index.uuids[mid];
+
+		if (entry->uuid < uuid ||
+		    (entry->uuid == uuid &&
+		     gatt_index.attrs[entry->idx].handle < handle)) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+
+	return lo;
+}
+
+static bool gatt_index_foreach(uint16_t start_handle, uint16_t end_handle,
+			       const struct bt_uuid *uuid,
+			       const void *attr_data, uint16_t num_matches,
+			       bt_gatt_attr_func_t func, void *user_data)
+{
+	const struct gatt_index_attr *entry;
+	uint16_t uuid16;
+	size_t i;
+
+	if (!gatt_index.valid) {
+		return false;
+	}
+
+	if (uuid && gatt_index_uuid16(uuid, &uuid16)) {
+		for (i = gatt_index_find_uuid(uuid16, start_handle);
+		     i < gatt_index.uuid_count &&
+		     gatt_index.uuids[i].uuid == uuid16; i++) {
+			entry = &gatt_index.attrs[gatt_index.uuids[i].idx];
+
+			if (gatt_foreach_iter(entry->attr, entry->handle,
+					      start_handle, end_handle, NULL,
+					      attr_data, &num_matches, func,
+					      user_data) == BT_GATT_ITER_STOP) {
+				break;
+			}
+		}
+
+		return true;
+	}
+
+	for (i = gatt_index_find_handle(start_handle);
+	     i < gatt_index.attr_count; i++) {
+		entry = &gatt_index.attrs[i];
+
+		if (gatt_foreach_iter(entry->attr, entry->handle, start_handle,
+				      end_handle, uuid, attr_data, &num_matches,
+				      func, user_data) == BT_GATT_ITER_STOP) {
+			break;
+		}
+	}
+
+	return true;
+}
+#endif /* CONFIG_BT_GATT_DB_INDEX */
+
 void bt_gatt_foreach_attr_type(uint16_t start_handle, uint16_t end_handle,
 			       const struct bt_uuid *uuid,
 			       const void *attr_data, uint16_t num_matches,
@@ -2002,6 +2223,13 @@ void bt_gatt_foreach_attr_type(uint16_t start_handle, uint16_t end_handle,
 		num_matches = UINT16_MAX;
 	}
 
+#if defined(CONFIG_BT_GATT_DB_INDEX)
+	if (gatt_index_foreach(start_handle, end_handle, uuid, attr_data,
+			       num_matches, func, user_data)) {
+		return;
+	}
+#endif /* CONFIG_BT_GATT_DB_INDEX */
+
 	if (start_handle <= last_static_handle) {
 		uint16_t handle = 1;
 
@@ -2385,6 +2613,43 @@ static void gatt_add_nfy_to_buf(struct net_buf *buf,
 }
 
 #if (CONFIG_BT_GATT_NOTIFY_MULTIPLE_FLUSH_MS != 0)
+#if defined(CONFIG_BT_EATT_TX_SPREAD)
+/* Largest batched PDU: the largest ATT_MTU of the connection, rounded down
+ * to fill whole Link Layer packets if that needs more than one.
+ */
+static size_t gatt_notify_mult_max_len(struct bt_conn *conn)
+{
+	size_t mtu = bt_att_get_mtu(conn);
+
+#if defined(CONFIG_BT_USER_DATA_LEN_UPDATE)
+	size_t ll_len = conn->le.data_len.tx_max_len;
+	size_t l2cap_len = mtu + BT_L2CAP_HDR_SIZE;
+
+	if (ll_len != 0U && l2cap_len > ll_len) {
+		mtu = (l2cap_len / ll_len) * ll_len - BT_L2CAP_HDR_SIZE;
+	}
+#endif /* CONFIG_BT_USER_DATA_LEN_UPDATE */
+
+	return mtu;
+}
+#endif /* CONFIG_BT_EATT_TX_SPREAD */
+
+static bool gatt_notify_mult_fits(struct bt_conn *conn, struct net_buf *buf,
+				  size_t len)
+{
+	if (net_buf_tailroom(buf) < len) {
+		return false;
+	}
+
+#if defined(CONFIG_BT_EATT_TX_SPREAD)
+	if (buf->len + len > gatt_notify_mult_max_len(conn)) {
+		return false;
+	}
+#endif /* CONFIG_BT_EATT_TX_SPREAD */
+
+	return true;
+}
+
 static int gatt_notify_mult(struct bt_conn *conn, uint16_t handle,
 			    struct bt_gatt_notify_params *params)
 {
@@ -2393,7 +2658,8 @@ static int gatt_notify_mult(struct bt_conn *conn, uint16_t handle,
 	/* Check if we can fit more data into it, in case it doesn't fit send
 	 * the existing buffer and proceed to create a new one
 	 */
-	if (*buf && ((net_buf_tailroom(*buf) < sizeof(struct bt_att_notify_mult) + params->len) ||
+	if (*buf && (!gatt_notify_mult_fits(conn, *buf,
+					   sizeof(struct bt_att_notify_mult) + params->len) ||
 	    !bt_att_tx_meta_data_match(*buf, params->func, params->user_data,
 				       BT_ATT_CHAN_OPT(params)))) {
 		int ret;
@@ -448,6 +448,7 @@ static void hci_num_completed_packets(struct net_buf *buf)
 	for (i = 0; i < evt->num_handles; i++) {
 		uint16_t handle, count;
 		struct bt_conn *conn;
+		bool notify = false;
 
 		handle = sys_le16_to_cpu(evt->h[i].handle);
 		count = sys_le16_to_cpu(evt->h[i].count);
@@ -490,10 +491,17 @@ static void hci_num_completed_packets(struct net_buf *buf)
 			sys_slist_append(&conn->tx_complete, &tx->node);
 			irq_unlock(key);
 
-			k_work_submit(&conn->tx_complete_work);
+			notify = true;
 			k_sem_give(bt_conn_get_pkts(conn));
 		}
 
+		/* A single work item runs the callbacks of all the packets
+		 * completed for the connection.
+		 */
+		if (notify) {
+			k_work_submit(&conn->tx_complete_work);
+		}
+
 		bt_conn_unref(conn);
 	}
 }
@@ -2695,8 +2703,31 @@ static void send_cmd(void)
 	}
 }
 
+#if defined(CONFIG_BT_CONN)
+#if defined(CONFIG_BT_ISO)
+/* command FIFO + conn_change signal + MAX_CONN + ISO_MAX_CHAN */
+#define EV_COUNT (2 + CONFIG_BT_MAX_CONN + CONFIG_BT_ISO_MAX_CHAN)
+#else
+/* command FIFO + conn_change signal + MAX_CONN */
+#define EV_COUNT (2 + CONFIG_BT_MAX_CONN)
+#endif /* CONFIG_BT_ISO */
+#else
+#if defined(CONFIG_BT_ISO)
+/* command FIFO + conn_change signal + ISO_MAX_CHAN */
+#define EV_COUNT (2 + CONFIG_BT_ISO_MAX_CHAN)
+#else
+/* command FIFO */
+#define EV_COUNT 1
+#endif /* CONFIG_BT_ISO */
+#endif /* CONFIG_BT_CONN */
+
 static void process_events(struct k_poll_event *ev, int count)
 {
+#if defined(CONFIG_BT_CONN_TX_BATCH)
+	struct bt_conn *ready[EV_COUNT];
+	size_t ready_count = 0;
+#endif /* CONFIG_BT_CONN_TX_BATCH */
+
 	LOG_DBG("count %d", count);
 
 	for (; count; ev++, count--) {
@@ -2723,7 +2754,11 @@ static void process_events(struct k_poll_event *ev, int count)
 					conn = CONTAINER_OF(ev->fifo,
 							    struct bt_conn,
 							    tx_queue);
+#if defined(CONFIG_BT_CONN_TX_BATCH)
+					ready[ready_count++] = conn;
+#else
 					bt_conn_process_tx(conn);
+#endif /* CONFIG_BT_CONN_TX_BATCH */
 				}
 			}
 			break;
@@ -2734,25 +2769,11 @@ static void process_events(struct k_poll_event *ev, int count)
 			break;
 		}
 	}
-}
 
-#if defined(CONFIG_BT_CONN)
-#if defined(CONFIG_BT_ISO)
-/* command FIFO + conn_change signal + MAX_CONN + ISO_MAX_CHAN */
-#define EV_COUNT (2 + CONFIG_BT_MAX_CONN + CONFIG_BT_ISO_MAX_CHAN)
-#else
-/* command FIFO + conn_change signal + MAX_CONN */
-#define EV_COUNT (2 + CONFIG_BT_MAX_CONN)
-#endif /* CONFIG_BT_ISO */
-#else
-#if defined(CONFIG_BT_ISO)
-/* command FIFO + conn_change signal + ISO_MAX_CHAN */
-#define EV_COUNT (2 + CONFIG_BT_ISO_MAX_CHAN)
-#else
-/* command FIFO */
-#define EV_COUNT 1
-#endif /* CONFIG_BT_ISO */
-#endif /* CONFIG_BT_CONN */
+#if defined(CONFIG_BT_CONN_TX_BATCH)
+	bt_conn_process_tx_batch(ready, ready_count);
+#endif /* CONFIG_BT_CONN_TX_BATCH */
+}
 
 static void hci_tx_thread(void *p1, void *p2, void *p3)
 {
@@ -56,6 +56,25 @@ NET_BUF_POOL_FIXED_DEFINE(iso_frag_pool, CONFIG_BT_ISO_TX_FRAG_COUNT,
 
 struct bt_conn iso_conns[CONFIG_BT_ISO_MAX_CHAN];
 
+#if defined(CONFIG_BT_ISO_STATS)
+/* Update an RFC 3550 jitter estimate with the deviation of a transit time */
+static inline void iso_stats_jitter(uint32_t *jitter_us, int32_t deviation_us)
+{
+	int32_t jitter = (int32_t)*jitter_us;
+
+	if (deviation_us < 0) {
+		deviation_us = -deviation_us;
+	}
+
+	*jitter_us = (uint32_t)(jitter + (deviation_us - jitter) / 16);
+}
+
+static inline uint32_t iso_stats_interval_us(const struct bt_conn *iso)
+{
+	return iso->iso.info.iso_interval * 1250U;
+}
+#endif /* CONFIG_BT_ISO_STATS */
+
 /* TODO: Allow more than one server? */
 #if defined(CONFIG_BT_ISO_CENTRAL)
 struct bt_iso_cig cigs[CONFIG_BT_ISO_MAX_CIG];
@@ -89,6 +108,20 @@ static void bt_iso_send_cb(struct bt_conn *iso, void *user_data, int err)
 
 	ops = chan->ops;
 
+#if defined(CONFIG_BT_ISO_STATS)
+	if (!err) {
+		struct bt_iso_chan_stats *stats = &iso->iso.stats;
+		uint32_t latency_us;
+
+		latency_us = k_cyc_to_us_floor32(k_cycle_get_32() -
+						 POINTER_TO_UINT(user_data));
+
+		stats->tx_completed++;
+		stats->tx_latency_us = latency_us;
+		stats->tx_latency_max_us = MAX(stats->tx_latency_max_us, latency_us);
+	}
+#endif /* CONFIG_BT_ISO_STATS */
+
 	if (!err && ops != NULL && ops->sent != NULL) {
 		ops->sent(chan);
 	}
@@ -398,6 +431,10 @@ void bt_iso_connected(struct bt_conn *iso)
 		return;
 	}
 
+#if defined(CONFIG_BT_ISO_STATS)
+	(void)memset(&iso->iso.stats, 0, sizeof(iso->iso.stats));
+#endif /* CONFIG_BT_ISO_STATS */
+
 	bt_iso_chan_set_state(chan, BT_ISO_STATE_CONNECTED);
 
 	if (chan->ops->connected) {
@@ -565,6 +602,31 @@ int bt_iso_chan_get_info(const struct bt_iso_chan *chan,
 	return 0;
 }
 
+#if defined(CONFIG_BT_ISO_STATS)
+int bt_iso_chan_get_stats(const struct bt_iso_chan *chan,
+			  struct bt_iso_chan_stats *stats)
+{
+	CHECKIF(chan == NULL) {
+		LOG_DBG("chan is NULL");
+		return -EINVAL;
+	}
+
+	CHECKIF(chan->iso == NULL) {
+		LOG_DBG("chan->iso is NULL");
+		return -EINVAL;
+	}
+
+	CHECKIF(stats == NULL) {
+		LOG_DBG("stats is NULL");
+		return -EINVAL;
+	}
+
+	(void)memcpy(stats, &chan->iso->iso.stats, sizeof(*stats));
+
+	return 0;
+}
+#endif /* CONFIG_BT_ISO_STATS */
+
 #if defined(CONFIG_BT_ISO_UNICAST) || defined(CONFIG_BT_ISO_SYNC_RECEIVER)
 struct net_buf *bt_iso_get_rx(k_timeout_t timeout)
 {
@@ -578,6 +640,45 @@ struct net_buf *bt_iso_get_rx(k_timeout_t timeout)
 	return buf;
 }
 
+#if defined(CONFIG_BT_ISO_STATS)
+static void iso_stats_rx(struct bt_conn *iso, const struct bt_iso_recv_info *info)
+{
+	struct bt_iso_chan_stats *stats = &iso->iso.stats;
+	uint32_t now = k_cycle_get_32();
+	bool has_ts = (info->flags & BT_ISO_FLAGS_TS) != 0U;
+
+	stats->rx_sdus++;
+
+	if (info->flags & BT_ISO_FLAGS_LOST) {
+		stats->rx_lost++;
+	} else if (info->flags & BT_ISO_FLAGS_ERROR) {
+		stats->rx_errors++;
+	}
+
+	if (stats->rx_sdus > 1U) {
+		uint32_t expected_us;
+		uint32_t spacing_us;
+
+		/* Compare to the SDU timestamps if available, otherwise to the
+		 * ISO interval
+		 */
+		if (has_ts && iso->iso.rx_has_ts) {
+			expected_us = info->ts - iso->iso.rx_last_ts;
+		} else {
+			expected_us = iso_stats_interval_us(iso);
+		}
+
+		spacing_us = k_cyc_to_us_floor32(now - iso->iso.rx_last);
+		iso_stats_jitter(&stats->rx_jitter_us,
+				 (int32_t)(spacing_us - expected_us));
+	}
+
+	iso->iso.rx_last = now;
+	iso->iso.rx_last_ts = info->ts;
+	iso->iso.rx_has_ts = has_ts;
+}
+#endif /* CONFIG_BT_ISO_STATS */
+
 void bt_iso_recv(struct bt_conn *iso, struct net_buf *buf, uint8_t flags)
 {
 	struct bt_hci_iso_data_hdr *hdr;
@@ -713,6 +814,10 @@ void bt_iso_recv(struct bt_conn *iso, struct net_buf *buf, uint8_t flags)
 		return;
 	}
 
+#if defined(CONFIG_BT_ISO_STATS)
+	iso_stats_rx(iso, iso_info(iso->rx));
+#endif /* CONFIG_BT_ISO_STATS */
+
 	chan = iso_chan(iso);
 	if (chan == NULL) {
 		LOG_ERR("Could not lookup chan from receiving ISO");
@@ -746,11 +851,44 @@ static uint16_t iso_chan_max_data_len(const struct bt_iso_chan *chan,
 	return max_data_len;
 }
 
+#if defined(CONFIG_BT_ISO_STATS)
+/* Account an SDU queued at cycle count @p now */
+static void iso_stats_tx(struct bt_conn *iso, uint32_t now)
+{
+	struct bt_iso_chan_stats *stats = &iso->iso.stats;
+	uint32_t interval = k_us_to_cyc_floor32(iso_stats_interval_us(iso));
+
+	stats->tx_sdus++;
+
+	if (stats->tx_sdus == 1U || interval == 0U) {
+		iso->iso.tx_due = now;
+	} else {
+		uint32_t spacing_us = k_cyc_to_us_floor32(now - iso->iso.tx_last);
+
+		iso_stats_jitter(&stats->tx_jitter_us,
+				 (int32_t)(spacing_us - iso_stats_interval_us(iso)));
+
+		/* SDUs are expected once every ISO interval. Restart the
+		 * nominal schedule from a late SDU.
+		 */
+		iso->iso.tx_due += interval;
+		if ((int32_t)(now - iso->iso.tx_due) > (int32_t)interval) {
+			stats->tx_late++;
+			iso->iso.tx_due = now;
+		}
+	}
+
+	iso->iso.tx_last = now;
+}
+#endif /* CONFIG_BT_ISO_STATS */
+
 int bt_iso_chan_send(struct bt_iso_chan *chan, struct net_buf *buf,
 		     uint16_t seq_num, uint32_t ts)
 {
+	void *user_data = NULL;
 	uint16_t max_data_len;
 	struct bt_conn *iso_conn;
+	int err;
 
 	CHECKIF(!chan || !buf) {
 		LOG_DBG("Invalid parameters: chan %p buf %p", chan, buf);
@@ -806,10 +944,24 @@ int bt_iso_chan_send(struct bt_iso_chan *chan, struct net_buf *buf,
 								     BT_ISO_DATA_VALID));
 	}
 
-	return bt_conn_send_iso_cb(iso_conn,
-				   buf,
-				   bt_iso_send_cb,
-				   ts != BT_ISO_TIMESTAMP_NONE);
+#if defined(CONFIG_BT_ISO_STATS)
+	/* Cycle count at which the SDU was queued, for the latency */
+	user_data = UINT_TO_POINTER(k_cycle_get_32());
+#endif /* CONFIG_BT_ISO_STATS */
+
+	err = bt_conn_send_iso_cb(iso_conn,
+				  buf,
+				  bt_iso_send_cb,
+				  user_data,
+				  ts != BT_ISO_TIMESTAMP_NONE);
+
+#if defined(CONFIG_BT_ISO_STATS)
+	if (!err) {
+		iso_stats_tx(iso_conn, POINTER_TO_UINT(user_data));
+	}
+#endif /* CONFIG_BT_ISO_STATS */
+
+	return err;
 }
 
 #if defined(CONFIG_BT_ISO_CENTRAL) || defined(CONFIG_BT_ISO_BROADCASTER)
@@ -436,6 +436,196 @@ static uint8_t get_adv_props_legacy(uint8_t evt_type)
 	}
 }
 
+#if defined(CONFIG_BT_SCAN_FILTER)
+static sys_slist_t scan_filters = SYS_SLIST_STATIC_INIT(&scan_filters);
+static struct bt_le_scan_filter_stats scan_filter_stats;
+
+#if defined(CONFIG_BT_SCAN_FILTER_DEDUP)
+/* Number of consecutive table entries searched for a report */
+#define SCAN_DEDUP_PROBE_MAX 4
+
+struct scan_dedup_entry {
+	/* Hash of the report, 0 if the entry is free */
+	uint32_t hash;
+	/* Uptime at which the report was delivered */
+	uint32_t timestamp;
+};
+
+static struct scan_dedup_entry scan_dedup[CONFIG_BT_SCAN_FILTER_DEDUP_SIZE];
+
+/* FNV-1a */
+static uint32_t scan_dedup_hash(uint32_t hash, const void *data, size_t len)
+{
+	const uint8_t *p = data;
+
+	while (len--) {
+		hash ^= *p++;
+		hash *= 16777619U;
+	}
+
+	return hash;
+}
+
+static void scan_dedup_reset(void)
+{
+	(void)memset(scan_dedup, 0, sizeof(scan_dedup));
+}
+
+/* Return true if an identical report was delivered within the time window,
+ * otherwise remember the report.
+ */
+static bool scan_dedup_check(const bt_addr_le_t *addr, uint8_t adv_type,
+			     const uint8_t *data, uint16_t len)
+{
+	struct scan_dedup_entry *victim = NULL;
+	uint32_t now = k_uptime_get_32();
+	bool victim_free = false;
+	uint32_t hash;
+	size_t idx;
+
+	hash = scan_dedup_hash(2166136261U, addr, sizeof(*addr));
+	hash = scan_dedup_hash(hash, &adv_type, sizeof(adv_type));
+	hash = scan_dedup_hash(hash, data, len);
+	if (hash == 0U) {
+		hash = 1U;
+	}
+
+	idx = hash % ARRAY_SIZE(scan_dedup);
+
+	for (uint8_t i = 0U; i < SCAN_DEDUP_PROBE_MAX; i++) {
+		struct scan_dedup_entry *entry = &scan_dedup[idx];
+		uint32_t age = now - entry->timestamp;
+		bool expired;
+
+		expired = (entry->hash == 0U) ||
+			  (age >= CONFIG_BT_SCAN_FILTER_DEDUP_TIMEOUT);
+
+		if (!expired && entry->hash == hash) {
+			return true;
+		}
+
+		/* Replace the first free entry, or else the oldest one */
+		if (expired) {
+			if (!victim_free) {
+				victim = entry;
+				victim_free = true;
+			}
+		} else if (!victim_free &&
+			   (victim == NULL || age > now - victim->timestamp)) {
+			victim = entry;
+		}
+
+		idx = (idx + 1) % ARRAY_SIZE(scan_dedup);
+	}
+
+	victim->hash = hash;
+	victim->timestamp = now;
+
+	return false;
+}
+#else
+static inline void scan_dedup_reset(void)
+{
+}
+#endif /* CONFIG_BT_SCAN_FILTER_DEDUP */
+
+static bool scan_filter_has_ad_type(const uint8_t *data, uint16_t len,
+				    uint8_t type)
+{
+	while (len > 1) {
+		uint8_t field_len = data[0];
+
+		/* Stop at early termination or a malformed field */
+		if (field_len == 0U || field_len > len - 1) {
+			break;
+		}
+
+		if (data[1] == type) {
+			return true;
+		}
+
+		data += field_len + 1;
+		len -= field_len + 1;
+	}
+
+	return false;
+}
+
+static bool scan_filter_match(const struct bt_le_scan_filter *filter,
+			      const bt_addr_le_t *addr,
+			      const bt_addr_le_t *id_addr,
+			      const struct bt_le_scan_recv_info *info,
+			      const uint8_t *data, uint16_t len)
+{
+	if ((filter->options & BT_LE_SCAN_FILTER_OPT_ADDR) &&
+	    !bt_addr_le_eq(&filter->addr, addr) &&
+	    !bt_addr_le_eq(&filter->addr, id_addr)) {
+		return false;
+	}
+
+	if ((filter->options & BT_LE_SCAN_FILTER_OPT_RSSI) &&
+	    info->rssi < filter->rssi) {
+		return false;
+	}
+
+	if ((filter->options & BT_LE_SCAN_FILTER_OPT_AD_TYPE) &&
+	    !scan_filter_has_ad_type(data, len, filter->ad_type)) {
+		return false;
+	}
+
+	return true;
+}
+
+/* Return true if the report is to be delivered to the scan callbacks */
+static bool scan_filter_accept(const bt_addr_le_t *addr,
+			       const bt_addr_le_t *id_addr,
+			       const struct bt_le_scan_recv_info *info,
+			       const uint8_t *data, uint16_t len)
+{
+	struct bt_le_scan_filter *filter;
+	bool accept;
+
+	scan_filter_stats.received++;
+
+	accept = sys_slist_is_empty(&scan_filters);
+
+	/* Evaluate all filters so that each one counts its matches */
+	SYS_SLIST_FOR_EACH_CONTAINER(&scan_filters, filter, node) {
+		if (scan_filter_match(filter, addr, id_addr, info, data, len)) {
+			filter->matched++;
+			accept = true;
+		}
+	}
+
+	if (!accept) {
+		scan_filter_stats.filtered++;
+		return false;
+	}
+
+#if defined(CONFIG_BT_SCAN_FILTER_DEDUP)
+	if (atomic_test_bit(bt_dev.flags, BT_DEV_SCAN_FILTER_DUP) &&
+	    scan_dedup_check(addr, info->adv_type, data, len)) {
+		scan_filter_stats.duplicates++;
+		return false;
+	}
+#endif /* CONFIG_BT_SCAN_FILTER_DEDUP */
+
+	return true;
+}
+#else
+static inline void scan_dedup_reset(void)
+{
+}
+
+static inline bool scan_filter_accept(const bt_addr_le_t *addr,
+				      const bt_addr_le_t *id_addr,
+				      const struct bt_le_scan_recv_info *info,
+				      const uint8_t *data, uint16_t len)
+{
+	return true;
+}
+#endif /* CONFIG_BT_SCAN_FILTER */
+
 static void le_adv_recv(bt_addr_le_t *addr, struct bt_le_scan_recv_info *info,
 			struct net_buf_simple *buf, uint16_t len)
 {
@@ -463,6 +653,13 @@ static void le_adv_recv(bt_addr_le_t *addr, struct bt_le_scan_recv_info *info,
 				bt_lookup_id_addr(BT_ID_DEFAULT, addr));
 	}
 
+	if (!scan_filter_accept(addr, &id_addr, info, buf->data, len)) {
+#if defined(CONFIG_BT_CENTRAL)
+		check_pending_conn(&id_addr, addr, info->adv_props);
+#endif /* CONFIG_BT_CENTRAL */
+		return;
+	}
+
 	if (scan_dev_found_cb) {
 		net_buf_simple_save(buf, &state);
 
@@ -1483,6 +1680,7 @@ int bt_le_scan_start(const struct bt_le_scan_param *param, bt_le_scan_cb_t cb)
 
 	atomic_set_bit_to(bt_dev.flags, BT_DEV_SCAN_FILTER_DUP,
 			  param->options & BT_LE_SCAN_OPT_FILTER_DUPLICATE);
+	scan_dedup_reset();
 
 #if defined(CONFIG_BT_FILTER_ACCEPT_LIST)
 	atomic_set_bit_to(bt_dev.flags, BT_DEV_SCAN_FILTERED,
@@ -1571,6 +1769,34 @@ void bt_le_scan_cb_unregister(struct bt_le_scan_cb *cb)
 	sys_slist_find_and_remove(&scan_cbs, &cb->node);
 }
 
+#if defined(CONFIG_BT_SCAN_FILTER)
+int bt_le_scan_filter_register(struct bt_le_scan_filter *filter)
+{
+	struct bt_le_scan_filter *registered;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&scan_filters, registered, node) {
+		if (registered == filter) {
+			return -EALREADY;
+		}
+	}
+
+	filter->matched = 0U;
+	sys_slist_append(&scan_filters, &filter->node);
+
+	return 0;
+}
+
+void bt_le_scan_filter_unregister(struct bt_le_scan_filter *filter)
+{
+	sys_slist_find_and_remove(&scan_filters, &filter->node);
+}
+
+void bt_le_scan_filter_stats_get(struct bt_le_scan_filter_stats *stats)
+{
+	*stats = scan_filter_stats;
+}
+#endif /* CONFIG_BT_SCAN_FILTER */
+
 #if defined(CONFIG_BT_PER_ADV_SYNC)
 uint8_t bt_le_per_adv_sync_get_index(struct bt_le_per_adv_sync *per_adv_sync)
 {
@@ -39,6 +39,39 @@ NET_BUF_POOL_VAR_DEFINE(isotp_tx_pool, CONFIG_ISOTP_TX_BUF_COUNT,
 			CONFIG_ISOTP_BUF_TX_DATA_POOL_SIZE, 0, NULL);
 #endif
 
+#ifdef CONFIG_ISOTP_WORKQUEUE
+static K_THREAD_STACK_DEFINE(isotp_work_q_stack, CONFIG_ISOTP_WORKQUEUE_STACK_SIZE);
+static struct k_work_q isotp_work_q;
+
+static int isotp_work_q_init(void)
+{
+	const struct k_work_queue_config cfg = {.name = "isotp_wq"};
+
+	k_work_queue_init(&isotp_work_q);
+	k_work_queue_start(&isotp_work_q, isotp_work_q_stack,
+			   K_THREAD_STACK_SIZEOF(isotp_work_q_stack),
+			   CONFIG_ISOTP_WORKQUEUE_PRIORITY, &cfg);
+
+	return 0;
+}
+
+SYS_INIT(isotp_work_q_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
+#endif
+
+#ifdef CONFIG_ISOTP_RX_MUX
+BUILD_ASSERT(IS_POWER_OF_TWO(CONFIG_ISOTP_RX_MUX_BUCKETS),
+	     "The number of hash buckets must be a power of two");
+#endif
+
+static inline void isotp_work_submit(struct k_work *work)
+{
+#ifdef CONFIG_ISOTP_WORKQUEUE
+	k_work_submit_to_queue(&isotp_work_q, work);
+#else
+	k_work_submit(work);
+#endif
+}
+
 static void receive_state_machine(struct isotp_recv_ctx *ctx);
 
 /*
@@ -53,7 +86,7 @@ static void receive_pool_free(struct net_buf *buf)
 
 	SYS_SLIST_FOR_EACH_NODE(&global_ctx.alloc_list, ctx_node) {
 		ctx = CONTAINER_OF(ctx_node, struct isotp_recv_ctx, alloc_node);
-		k_work_submit(&ctx->work);
+		isotp_work_submit(&ctx->work);
 	}
 }
 
@@ -66,7 +99,7 @@ static void receive_ff_sf_pool_free(struct net_buf *buf)
 
 	SYS_SLIST_FOR_EACH_NODE(&global_ctx.ff_sf_alloc_list, ctx_node) {
 		ctx = CONTAINER_OF(ctx_node, struct isotp_recv_ctx, alloc_node);
-		k_work_submit(&ctx->work);
+		isotp_work_submit(&ctx->work);
 	}
 }
 
@@ -85,7 +118,7 @@ static void receive_can_tx(const struct device *dev, int error, void *arg)
 	if (error != 0) {
 		LOG_ERR("Error sending FC frame (%d)", error);
 		receive_report_error(ctx, ISOTP_N_ERROR);
-		k_work_submit(&ctx->work);
+		isotp_work_submit(&ctx->work);
 	}
 }
 
@@ -203,7 +236,7 @@ static void receive_timeout_handler(struct _timeout *to)
 		break;
 	}
 
-	k_work_submit(&ctx->work);
+	isotp_work_submit(&ctx->work);
 }
 
 static int receive_alloc_buffer(struct isotp_recv_ctx *ctx)
@@ -480,7 +513,7 @@ static void process_cf(struct isotp_recv_ctx *ctx, struct can_frame *frame)
 		LOG_DBG("Waiting for CF but got something else (%d)",
 			frame->data[index] >> ISOTP_PCI_TYPE_POS);
 		receive_report_error(ctx, ISOTP_N_UNEXP_PDU);
-		k_work_submit(&ctx->work);
+		isotp_work_submit(&ctx->work);
 		return;
 	}
 
@@ -491,7 +524,7 @@ static void process_cf(struct isotp_recv_ctx *ctx, struct can_frame *frame)
 	if ((frame->data[index++] & ISOTP_PCI_SN_MASK) != ctx->sn_expected++) {
 		LOG_ERR("Sequence number mismatch");
 		receive_report_error(ctx, ISOTP_N_WRONG_SN);
-		k_work_submit(&ctx->work);
+		isotp_work_submit(&ctx->work);
 		return;
 	}
 
@@ -557,7 +590,7 @@ static void receive_can_rx(const struct device *dev, struct can_frame *frame, vo
 		LOG_INF("Got a frame in a state where it is unexpected.");
 	}
 
-	k_work_submit(&ctx->work);
+	isotp_work_submit(&ctx->work);
 }
 
 static inline int attach_ff_filter(struct isotp_recv_ctx *ctx)
@@ -586,11 +619,116 @@ static inline int attach_ff_filter(struct isotp_recv_ctx *ctx)
 	return 0;
 }
 
-int isotp_bind(struct isotp_recv_ctx *ctx, const struct device *can_dev,
-	       const struct isotp_msg_id *rx_addr,
-	       const struct isotp_msg_id *tx_addr,
-	       const struct isotp_fc_opts *opts,
-	       k_timeout_t timeout)
+#ifdef CONFIG_ISOTP_RX_MUX
+/* The identifiers of fixed addressing vary with the priority and source address */
+static uint32_t mux_key(uint32_t id, bool fixed_addr)
+{
+	return fixed_addr ? id & ISOTP_FIXED_ADDR_RX_MASK : id;
+}
+
+static sys_slist_t *mux_bucket(struct isotp_rx_mux *mux, uint32_t key)
+{
+	return &mux->buckets[((key * 2654435761U) >> 16) &
+			     (CONFIG_ISOTP_RX_MUX_BUCKETS - 1)];
+}
+
+static void mux_dispatch(struct isotp_rx_mux *mux, struct can_frame *frame,
+			 bool fixed_addr)
+{
+	uint8_t ide = (frame->flags & CAN_FRAME_IDE) != 0 ? 1 : 0;
+	uint32_t key = mux_key(frame->id, fixed_addr);
+	struct isotp_recv_ctx *ctx, *next;
+
+	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(mux_bucket(mux, key), ctx, next, mux_node) {
+		if (ctx->rx_addr.ide == ide &&
+		    ctx->rx_addr.use_fixed_addr == fixed_addr &&
+		    mux_key(ctx->rx_addr.ext_id, fixed_addr) == key) {
+			receive_can_rx(mux->can_dev, frame, ctx);
+		}
+	}
+}
+
+static void mux_can_rx(const struct device *dev, struct can_frame *frame, void *arg)
+{
+	struct isotp_rx_mux *mux = (struct isotp_rx_mux *)arg;
+	k_spinlock_key_t key;
+
+	ARG_UNUSED(dev);
+
+	key = k_spin_lock(&mux->lock);
+	mux_dispatch(mux, frame, false);
+	if ((frame->flags & CAN_FRAME_IDE) != 0) {
+		mux_dispatch(mux, frame, true);
+	}
+	k_spin_unlock(&mux->lock, key);
+}
+
+int isotp_rx_mux_init(struct isotp_rx_mux *mux, const struct device *can_dev,
+		      const struct can_filter *filter)
+{
+	__ASSERT(mux, "mux is NULL");
+	__ASSERT(can_dev, "CAN device is NULL");
+	__ASSERT(filter, "filter is NULL");
+
+	memset(mux, 0, sizeof(*mux));
+	mux->can_dev = can_dev;
+	mux->filter = *filter;
+
+	for (size_t i = 0; i < ARRAY_SIZE(mux->buckets); i++) {
+		sys_slist_init(&mux->buckets[i]);
+	}
+
+	mux->filter_id = can_add_rx_filter(can_dev, mux_can_rx, mux, filter);
+	if (mux->filter_id < 0) {
+		LOG_ERR("Error attaching mux filter [%d]", mux->filter_id);
+		return ISOTP_NO_FREE_FILTER;
+	}
+
+	return ISOTP_N_OK;
+}
+
+void isotp_rx_mux_deinit(struct isotp_rx_mux *mux)
+{
+	if (mux->filter_id >= 0) {
+		can_remove_rx_filter(mux->can_dev, mux->filter_id);
+		mux->filter_id = -1;
+	}
+}
+
+static int attach_mux(struct isotp_recv_ctx *ctx, struct isotp_rx_mux *mux)
+{
+	uint32_t mask = ctx->rx_addr.use_fixed_addr ? ISOTP_FIXED_ADDR_RX_MASK :
+						      CAN_EXT_ID_MASK;
+	bool ide = (mux->filter.flags & CAN_FILTER_IDE) != 0;
+	k_spinlock_key_t key;
+
+	/* All the frames of the context must be accepted by the filter */
+	if (ide != (ctx->rx_addr.ide != 0) ||
+	    ((ctx->rx_addr.ext_id ^ mux->filter.id) & mux->filter.mask & mask) != 0 ||
+	    (mux->filter.mask & ~mask) != 0) {
+		LOG_ERR("Mux filter does not accept 0x%x", ctx->rx_addr.ext_id);
+		return ISOTP_NO_FREE_FILTER;
+	}
+
+	ctx->mux = mux;
+	ctx->filter_id = -1;
+
+	key = k_spin_lock(&mux->lock);
+	sys_slist_append(mux_bucket(mux, mux_key(ctx->rx_addr.ext_id,
+						 ctx->rx_addr.use_fixed_addr)),
+			 &ctx->mux_node);
+	k_spin_unlock(&mux->lock, key);
+
+	return 0;
+}
+#endif /* CONFIG_ISOTP_RX_MUX */
+
+static int bind(struct isotp_recv_ctx *ctx, const struct device *can_dev,
+		struct isotp_rx_mux *mux,
+		const struct isotp_msg_id *rx_addr,
+		const struct isotp_msg_id *tx_addr,
+		const struct isotp_fc_opts *opts,
+		k_timeout_t timeout)
 {
 	int ret;
 
@@ -620,7 +758,20 @@ int isotp_bind(struct isotp_recv_ctx *ctx, const struct device *can_dev,
 		return ISOTP_NO_NET_BUF_LEFT;
 	}
 
+	k_work_init(&ctx->work, receive_work_handler);
+	z_init_timeout(&ctx->timeout);
+
+#ifdef CONFIG_ISOTP_RX_MUX
+	ctx->mux = NULL;
+	if (mux != NULL) {
+		ret = attach_mux(ctx, mux);
+	} else {
+		ret = attach_ff_filter(ctx);
+	}
+#else
+	ARG_UNUSED(mux);
 	ret = attach_ff_filter(ctx);
+#endif
 	if (ret) {
 		LOG_ERR("Can't attach filter for binding");
 		net_buf_unref(ctx->buf);
@@ -628,12 +779,31 @@ int isotp_bind(struct isotp_recv_ctx *ctx, const struct device *can_dev,
 		return ret;
 	}
 
-	k_work_init(&ctx->work, receive_work_handler);
-	z_init_timeout(&ctx->timeout);
-
 	return ISOTP_N_OK;
 }
 
+int isotp_bind(struct isotp_recv_ctx *ctx, const struct device *can_dev,
+	       const struct isotp_msg_id *rx_addr,
+	       const struct isotp_msg_id *tx_addr,
+	       const struct isotp_fc_opts *opts,
+	       k_timeout_t timeout)
+{
+	return bind(ctx, can_dev, NULL, rx_addr, tx_addr, opts, timeout);
+}
+
+#ifdef CONFIG_ISOTP_RX_MUX
+int isotp_bind_mux(struct isotp_recv_ctx *ctx, struct isotp_rx_mux *mux,
+		   const struct isotp_msg_id *rx_addr,
+		   const struct isotp_msg_id *tx_addr,
+		   const struct isotp_fc_opts *opts,
+		   k_timeout_t timeout)
+{
+	__ASSERT(mux, "mux is NULL");
+
+	return bind(ctx, mux->can_dev, mux, rx_addr, tx_addr, opts, timeout);
+}
+#endif
+
 void isotp_unbind(struct isotp_recv_ctx *ctx)
 {
 	struct net_buf *buf;
@@ -642,6 +812,18 @@ void isotp_unbind(struct isotp_recv_ctx *ctx)
 		can_remove_rx_filter(ctx->can_dev, ctx->filter_id);
 	}
 
+#ifdef CONFIG_ISOTP_RX_MUX
+	if (ctx->mux != NULL) {
+		k_spinlock_key_t key = k_spin_lock(&ctx->mux->lock);
+
+		sys_slist_find_and_remove(mux_bucket(ctx->mux, mux_key(
+				ctx->rx_addr.ext_id, ctx->rx_addr.use_fixed_addr)),
+			&ctx->mux_node);
+		k_spin_unlock(&ctx->mux->lock, key);
+		ctx->mux = NULL;
+	}
+#endif
+
 	z_abort_timeout(&ctx->timeout);
 
 	sys_slist_find_and_remove(&global_ctx.ff_sf_alloc_list,
@@ -742,7 +924,7 @@ static void send_can_tx_cb(const struct device *dev, int error, void *arg)
 		ctx->state = ISOTP_TX_WAIT_FIN;
 	}
 
-	k_work_submit(&ctx->work);
+	isotp_work_submit(&ctx->work);
 }
 
 static void send_timeout_handler(struct _timeout *to)
@@ -755,7 +937,7 @@ static void send_timeout_handler(struct _timeout *to)
 		LOG_ERR("Reception of next FC has timed out");
 	}
 
-	k_work_submit(&ctx->work);
+	isotp_work_submit(&ctx->work);
 }
 
 static void send_process_fc(struct isotp_send_ctx *ctx,
@@ -834,7 +1016,7 @@ static void send_can_rx_cb(const struct device *dev, struct can_frame *frame, vo
 		send_report_error(ctx, ISOTP_N_UNEXP_PDU);
 	}
 
-	k_work_submit(&ctx->work);
+	isotp_work_submit(&ctx->work);
 }
 
 static size_t get_ctx_data_length(struct isotp_send_ctx *ctx)
@@ -1188,7 +1370,7 @@ static int send(struct isotp_send_ctx *ctx, const struct device *can_dev,
 
 		LOG_DBG("Starting work to send FF");
 		ctx->state = ISOTP_TX_SEND_FF;
-		k_work_submit(&ctx->work);
+		isotp_work_submit(&ctx->work);
 	} else {
 		LOG_DBG("Sending single frame");
 		ctx->filter_id = -1;
@@ -5,6 +5,7 @@
  */
 
 #include <errno.h>
+#include <string.h>
 #include <kernel_internal.h>
 #include <zephyr/toolchain.h>
 #include <zephyr/debug/coredump.h>
@@ -58,9 +59,36 @@ static void dump_header(unsigned int reason)
 	backend_api->buffer_output((uint8_t *)&hdr, sizeof(hdr));
 }
 
+#if defined(CONFIG_DEBUG_COREDUMP_MEMORY_DUMP_MIN) || \
+	defined(CONFIG_DEBUG_COREDUMP_MEMORY_DUMP_THREADS)
+static void dump_thread_stack(struct k_thread *thread)
+{
+	uintptr_t start_addr = thread->stack_info.start;
+	uintptr_t end_addr = start_addr + thread->stack_info.size;
+
+#if defined(CONFIG_DEBUG_COREDUMP_MEMORY_DUMP_THREADS) && defined(CONFIG_INIT_STACKS)
+	/* skip the part of the stack that was never used */
+#ifdef CONFIG_STACK_GROWS_UP
+	while ((end_addr > start_addr) &&
+	       (*(uint8_t *)UINT_TO_POINTER(end_addr - 1) == 0xaaU)) {
+		end_addr--;
+	}
+#else
+	while ((start_addr < end_addr) &&
+	       (*(uint8_t *)UINT_TO_POINTER(start_addr) == 0xaaU)) {
+		start_addr++;
+	}
+#endif
+#endif
+
+	coredump_memory_dump(start_addr, end_addr);
+}
+#endif
+
 static void dump_thread(struct k_thread *thread)
 {
-#ifdef CONFIG_DEBUG_COREDUMP_MEMORY_DUMP_MIN
+#if defined(CONFIG_DEBUG_COREDUMP_MEMORY_DUMP_MIN) || \
+	defined(CONFIG_DEBUG_COREDUMP_MEMORY_DUMP_THREADS)
 	uintptr_t end_addr;
 
 	/*
@@ -77,12 +105,28 @@ static void dump_thread(struct k_thread *thread)
 
 	coredump_memory_dump(POINTER_TO_UINT(thread), end_addr);
 
-	end_addr = thread->stack_info.start + thread->stack_info.size;
-
-	coredump_memory_dump(thread->stack_info.start, end_addr);
+	dump_thread_stack(thread);
 #endif
 }
 
+#ifdef CONFIG_DEBUG_COREDUMP_MEMORY_DUMP_THREADS
+static void dump_threads(struct k_thread *current)
+{
+	/*
+	 * Walk the thread list without locking: the system is going
+	 * down and the lock may well be held by the faulting context.
+	 */
+	for (struct k_thread *t = _kernel.threads; t != NULL; t = t->next_thread) {
+		if (t != current) {
+			dump_thread(t);
+		}
+	}
+
+	coredump_memory_dump(POINTER_TO_UINT(&_kernel),
+			     POINTER_TO_UINT(&_kernel) + sizeof(_kernel));
+}
+#endif
+
 #if defined(CONFIG_COREDUMP_DEVICE)
 static void process_coredump_dev_memory(const struct device *dev)
 {
@@ -132,6 +176,10 @@ void coredump(unsigned int reason, const z_arch_esf_t *esf,
 		dump_thread(thread);
 	}
 
+#ifdef CONFIG_DEBUG_COREDUMP_MEMORY_DUMP_THREADS
+	dump_threads(thread);
+#endif
+
 	process_memory_region_list();
 
 	z_coredump_end();
@@ -157,6 +205,82 @@ void coredump_buffer_output(uint8_t *buf, size_t buflen)
 	backend_api->buffer_output(buf, buflen);
 }
 
+#ifdef CONFIG_DEBUG_COREDUMP_COMPRESS
+/* Encoded output is staged so that backends are not fed byte by byte */
+static uint8_t rle_buf[64];
+static size_t rle_len;
+
+static void rle_put(const uint8_t *data, size_t len)
+{
+	while (len > 0) {
+		size_t n = MIN(len, sizeof(rle_buf) - rle_len);
+
+		memcpy(&rle_buf[rle_len], data, n);
+		rle_len += n;
+		data += n;
+		len -= n;
+
+		if (rle_len == sizeof(rle_buf)) {
+			backend_api->buffer_output(rle_buf, rle_len);
+			rle_len = 0;
+		}
+	}
+}
+
+static void rle_put_literal(const uint8_t *data, size_t len)
+{
+	while (len > 0) {
+		size_t n = MIN(len, COREDUMP_RLE_LITERAL_MAX);
+		uint8_t ctrl = (uint8_t)(n - 1U);
+
+		rle_put(&ctrl, 1);
+		rle_put(data, n);
+		data += n;
+		len -= n;
+	}
+}
+
+/**
+ * Output a memory region run-length encoded, which takes care of the
+ * zeroed (BSS, unused heap) and pattern filled (stacks) areas that make
+ * up most of a RAM dump.
+ */
+static void rle_output(const uint8_t *buf, size_t len)
+{
+	size_t lit_start = 0;
+	size_t i = 0;
+
+	while (i < len) {
+		size_t run = 1;
+
+		while (((i + run) < len) && (run < COREDUMP_RLE_RUN_MAX) &&
+		       (buf[i + run] == buf[i])) {
+			run++;
+		}
+
+		if (run >= COREDUMP_RLE_RUN_MIN) {
+			uint8_t rep[2] = {
+				COREDUMP_RLE_REPEAT + run - COREDUMP_RLE_RUN_MIN,
+				buf[i],
+			};
+
+			rle_put_literal(&buf[lit_start], i - lit_start);
+			rle_put(rep, sizeof(rep));
+			lit_start = i + run;
+		}
+
+		i += run;
+	}
+
+	rle_put_literal(&buf[lit_start], len - lit_start);
+
+	if (rle_len > 0) {
+		backend_api->buffer_output(rle_buf, rle_len);
+		rle_len = 0;
+	}
+}
+#endif /* CONFIG_DEBUG_COREDUMP_COMPRESS */
+
 void coredump_memory_dump(uintptr_t start_addr, uintptr_t end_addr)
 {
 	struct coredump_mem_hdr_t m;
@@ -174,7 +298,8 @@ void coredump_memory_dump(uintptr_t start_addr, uintptr_t end_addr)
 	len = end_addr - start_addr;
 
 	m.id = COREDUMP_MEM_HDR_ID;
-	m.hdr_version = COREDUMP_MEM_HDR_VER;
+	m.hdr_version = IS_ENABLED(CONFIG_DEBUG_COREDUMP_COMPRESS) ?
+			COREDUMP_MEM_HDR_VER_RLE : COREDUMP_MEM_HDR_VER;
 
 	if (sizeof(uintptr_t) == 8) {
 		m.start	= sys_cpu_to_le64(start_addr);
@@ -186,7 +311,11 @@ void coredump_memory_dump(uintptr_t start_addr, uintptr_t end_addr)
 
 	coredump_buffer_output((uint8_t *)&m, sizeof(m));
 
+#ifdef CONFIG_DEBUG_COREDUMP_COMPRESS
+	rle_output((uint8_t *)start_addr, len);
+#else
 	coredump_buffer_output((uint8_t *)start_addr, len);
+#endif
 }
 
 int coredump_query(enum coredump_query_id query_id, void *arg)
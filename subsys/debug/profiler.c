@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/** @file
+ *  @brief Sampling profiler implementation
+ */
+
+#include <errno.h>
+#include <stdlib.h>
+#include <zephyr/kernel.h>
+#include <zephyr/debug/profiler.h>
+#include <zephyr/shell/shell.h>
+
+#define PROFILER_DEPTH CONFIG_PROFILER_STACK_DEPTH
+
+struct profiler_cpu {
+	uintptr_t buf[CONFIG_PROFILER_BUFFER_SIZE];
+	size_t used;
+	uint32_t dropped;
+};
+
+/* Each buffer is only written from the timer interrupt on its CPU */
+static struct profiler_cpu profiler_cpus[CONFIG_MP_MAX_NUM_CPUS];
+static uint32_t profiler_remaining;
+static bool profiler_running;
+
+static void profiler_sample(struct k_timer *timer)
+{
+	struct profiler_cpu *cpu = &profiler_cpus[arch_curr_cpu()->id];
+	size_t space = CONFIG_PROFILER_BUFFER_SIZE - cpu->used;
+	size_t count = 0;
+
+	if (space > 1) {
+		count = arch_profiler_sample(&cpu->buf[cpu->used + 1],
+					     MIN(space - 1, PROFILER_DEPTH));
+	}
+
+	if (count > 0) {
+		cpu->buf[cpu->used] = count;
+		cpu->used += count + 1;
+	} else {
+		cpu->dropped++;
+	}
+
+	if (profiler_remaining > 0 && --profiler_remaining == 0) {
+		k_timer_stop(timer);
+		profiler_running = false;
+	}
+}
+
+static K_TIMER_DEFINE(profiler_timer, profiler_sample, NULL);
+
+int profiler_start(uint32_t frequency, uint32_t count)
+{
+	k_timeout_t period;
+
+	if (frequency == 0U || frequency > CONFIG_SYS_CLOCK_TICKS_PER_SEC) {
+		return -EINVAL;
+	}
+
+	if (profiler_running) {
+		return -EALREADY;
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(profiler_cpus); i++) {
+		profiler_cpus[i].used = 0;
+		profiler_cpus[i].dropped = 0;
+	}
+
+	profiler_remaining = count;
+	profiler_running = true;
+
+	period = K_TICKS(CONFIG_SYS_CLOCK_TICKS_PER_SEC / frequency);
+	k_timer_start(&profiler_timer, period, period);
+
+	return 0;
+}
+
+void profiler_stop(void)
+{
+	k_timer_stop(&profiler_timer);
+	profiler_running = false;
+}
+
+size_t profiler_samples_get(uint8_t cpu, const uintptr_t **samples)
+{
+	if (cpu >= ARRAY_SIZE(profiler_cpus)) {
+		return 0;
+	}
+
+	*samples = profiler_cpus[cpu].buf;
+
+	return profiler_cpus[cpu].used;
+}
+
+uint32_t profiler_dropped_get(uint8_t cpu)
+{
+	if (cpu >= ARRAY_SIZE(profiler_cpus)) {
+		return 0;
+	}
+
+	return profiler_cpus[cpu].dropped;
+}
+
+#if defined(CONFIG_PROFILER_SHELL)
+static int cmd_profiler_start(const struct shell *sh, size_t argc, char **argv)
+{
+	uint32_t frequency = strtoul(argv[1], NULL, 10);
+	uint32_t count = 0;
+	int ret;
+
+	if (argc > 2) {
+		/* Duration in milliseconds */
+		count = (uint32_t)(((uint64_t)strtoul(argv[2], NULL, 10) *
+				    frequency) / MSEC_PER_SEC);
+		count = MAX(count, 1U);
+	}
+
+	ret = profiler_start(frequency, count);
+	if (ret == -EINVAL) {
+		shell_error(sh, "Frequency must be between 1 and %d Hz",
+			    CONFIG_SYS_CLOCK_TICKS_PER_SEC);
+	} else if (ret == -EALREADY) {
+		shell_error(sh, "Profiler already running");
+	}
+
+	return ret;
+}
+
+static int cmd_profiler_stop(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(sh);
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	profiler_stop();
+
+	return 0;
+}
+
+/* Output parsed by scripts/profiling/profiler_report.py */
+static int cmd_profiler_dump(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	if (profiler_running) {
+		shell_error(sh, "Profiler running, stop it first");
+		return -EBUSY;
+	}
+
+	for (uint8_t cpu = 0; cpu < arch_num_cpus(); cpu++) {
+		const uintptr_t *samples;
+		size_t used = profiler_samples_get(cpu, &samples);
+
+		shell_print(sh, "profiler: cpu %u dropped %u", cpu,
+			    profiler_dropped_get(cpu));
+
+		for (size_t i = 0; i < used; i += samples[i] + 1) {
+			shell_fprintf(sh, SHELL_NORMAL, "profiler:");
+			for (size_t j = 1; j <= samples[i]; j++) {
+				shell_fprintf(sh, SHELL_NORMAL, " %lx",
+					      (unsigned long)samples[i + j]);
+			}
+			shell_fprintf(sh, SHELL_NORMAL, "\n");
+		}
+	}
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_profiler,
+	SHELL_CMD_ARG(start, NULL,
+		      "Start sampling <frequency in Hz> [duration in ms]",
+		      cmd_profiler_start, 2, 1),
+	SHELL_CMD_ARG(stop, NULL, "Stop sampling", cmd_profiler_stop, 1, 0),
+	SHELL_CMD_ARG(dump, NULL, "Print the samples", cmd_profiler_dump, 1, 0),
+	SHELL_SUBCMD_SET_END
+);
+
+SHELL_CMD_REGISTER(profiler, &sub_profiler, "Sampling profiler", NULL);
+#endif /* CONFIG_PROFILER_SHELL */
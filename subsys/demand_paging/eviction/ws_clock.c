@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Working set clock eviction algorithm for demand paging
+ */
+#include <zephyr/kernel.h>
+#include <mmu.h>
+#include <kernel_arch_interface.h>
+#include <zephyr/init.h>
+
+/* Each page frame has an age: the number of sampling periods since its
+ * page was last seen accessed. Pages accessed within the last
+ * CONFIG_EVICTION_WS_CLOCK_WINDOW periods form the working set and are
+ * only evicted when nothing else can be.
+ *
+ * A clock hand goes round the page frames from one eviction to the
+ * next, so that the search starts where the previous one stopped rather
+ * than always from the first page frames. A page accessed since the last
+ * sample gets a second chance: its age is reset and the hand moves on.
+ * The first old and clean page found is evicted. Old dirty pages cost a
+ * page-out, so they are only evicted when the hand went all the way
+ * round without finding an old clean page. If the hand went all the way
+ * round and found no old page either, the oldest page is evicted.
+ */
+static uint8_t ages[Z_NUM_PAGE_FRAMES];
+static size_t hand;
+
+static inline uint8_t *pf_age(struct z_page_frame *pf)
+{
+	return &ages[pf - z_page_frames];
+}
+
+static void ws_clock_periodic_update(struct k_timer *timer)
+{
+	uintptr_t phys, flags;
+	struct z_page_frame *pf;
+	unsigned int key = irq_lock();
+
+	Z_PAGE_FRAME_FOREACH(phys, pf) {
+		uint8_t *age = pf_age(pf);
+
+		if (!z_page_frame_is_evictable(pf)) {
+			/* Free page frames start afresh once mapped */
+			*age = 0U;
+			continue;
+		}
+
+		/* Sample and clear the accessed bit */
+		flags = arch_page_info_get(pf->addr, NULL, true);
+		if ((flags & ARCH_DATA_PAGE_ACCESSED) != 0UL) {
+			*age = 0U;
+		} else if (*age < UINT8_MAX) {
+			(*age)++;
+		}
+	}
+
+	irq_unlock(key);
+}
+
+struct z_page_frame *k_mem_paging_eviction_select(bool *dirty_ptr)
+{
+	struct z_page_frame *old_dirty = NULL;
+	struct z_page_frame *oldest = NULL;
+	struct z_page_frame *pf;
+	bool oldest_dirty = false;
+	uintptr_t flags;
+
+	for (size_t i = 0; i < Z_NUM_PAGE_FRAMES; i++) {
+		uint8_t *age;
+		bool dirty;
+
+		pf = &z_page_frames[hand];
+		hand = (hand + 1) % Z_NUM_PAGE_FRAMES;
+
+		if (!z_page_frame_is_evictable(pf)) {
+			continue;
+		}
+
+		age = pf_age(pf);
+		flags = arch_page_info_get(pf->addr, NULL, false);
+		dirty = (flags & ARCH_DATA_PAGE_DIRTY) != 0UL;
+
+		/* Implies a mismatch with page frame ontology and page
+		 * tables
+		 */
+		__ASSERT((flags & ARCH_DATA_PAGE_LOADED) != 0U,
+			 "non-present page, %s",
+			 ((flags & ARCH_DATA_PAGE_NOT_MAPPED) != 0U) ?
+			 "un-mapped" : "paged out");
+
+		if ((flags & ARCH_DATA_PAGE_ACCESSED) != 0UL) {
+			/* Second chance */
+			(void)arch_page_info_get(pf->addr, NULL, true);
+			*age = 0U;
+		}
+
+		if (*age >= CONFIG_EVICTION_WS_CLOCK_WINDOW) {
+			if (!dirty) {
+				*dirty_ptr = false;
+				*age = 0U;
+				return pf;
+			}
+			if (old_dirty == NULL) {
+				old_dirty = pf;
+			}
+		}
+
+		if (oldest == NULL || *age > *pf_age(oldest) ||
+		    (*age == *pf_age(oldest) && oldest_dirty && !dirty)) {
+			oldest = pf;
+			oldest_dirty = dirty;
+		}
+	}
+
+	pf = (old_dirty != NULL) ? old_dirty : oldest;
+
+	/* Shouldn't ever happen unless every page is pinned */
+	__ASSERT(pf != NULL, "no page to evict");
+
+	*dirty_ptr = (pf == oldest) ? oldest_dirty : true;
+	*pf_age(pf) = 0U;
+
+	return pf;
+}
+
+static K_TIMER_DEFINE(ws_clock_timer, ws_clock_periodic_update, NULL);
+
+void k_mem_paging_eviction_init(void)
+{
+	k_timer_start(&ws_clock_timer, K_NO_WAIT,
+		      K_MSEC(CONFIG_EVICTION_WS_CLOCK_PERIOD));
+}
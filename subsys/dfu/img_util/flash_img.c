@@ -13,6 +13,11 @@
 #include <zephyr/storage/flash_map.h>
 #include <zephyr/storage/stream_flash.h>
 
+#ifdef CONFIG_IMG_LZ4
+#include <zephyr/sys/byteorder.h>
+#include <lz4.h>
+#endif
+
 #ifdef CONFIG_IMG_ERASE_PROGRESSIVELY
 #include <bootutil/bootutil_public.h>
 #include <zephyr/dfu/mcuboot.h>
@@ -43,11 +48,155 @@ BUILD_ASSERT((CONFIG_IMG_BLOCK_BUF_SIZE % FLASH_WRITE_BLOCK_SIZE == 0),
 	     "FLASH_WRITE_BLOCK_SIZE");
 #endif
 
+#ifdef CONFIG_IMG_LZ4
+BUILD_ASSERT(FLASH_IMG_LZ4_BOUND(CONFIG_IMG_LZ4_BLOCK_SIZE) ==
+	     LZ4_COMPRESSBOUND(CONFIG_IMG_LZ4_BLOCK_SIZE));
+
+enum {
+	LZ4_STATE_HDR,
+	LZ4_STATE_BLOCK_LEN,
+	LZ4_STATE_BLOCK,
+	LZ4_STATE_STORED,
+};
+
+bool flash_img_lz4_is_stream(const uint8_t *data, size_t len, size_t *image_size)
+{
+	uint32_t block_size;
+
+	if (len < FLASH_IMG_LZ4_HDR_SIZE || sys_get_le32(data) != FLASH_IMG_LZ4_MAGIC) {
+		return false;
+	}
+
+	block_size = sys_get_le32(&data[8]);
+	if (block_size == 0 || block_size > CONFIG_IMG_LZ4_BLOCK_SIZE) {
+		return false;
+	}
+
+	*image_size = sys_get_le32(&data[4]);
+
+	return true;
+}
+
+void flash_img_lz4_enable(struct flash_img_context *ctx, struct flash_img_lz4 *lz4)
+{
+	ctx->lz4 = lz4;
+	lz4->state = LZ4_STATE_HDR;
+	lz4->in_len = 0;
+	lz4->in_need = FLASH_IMG_LZ4_HDR_SIZE;
+	lz4->out_total = 0;
+}
+
+/* Handle the header, length word or block completed in the input buffer */
+static int lz4_process(struct flash_img_context *ctx)
+{
+	struct flash_img_lz4 *lz4 = ctx->lz4;
+	const uint8_t *out = lz4->in;
+	uint32_t word;
+	int out_len;
+
+	switch (lz4->state) {
+	case LZ4_STATE_HDR:
+		if (!flash_img_lz4_is_stream(lz4->in, lz4->in_len, &lz4->image_size)) {
+			return -EINVAL;
+		}
+
+		lz4->block_size = sys_get_le32(&lz4->in[8]);
+		lz4->state = LZ4_STATE_BLOCK_LEN;
+		lz4->in_need = sizeof(uint32_t);
+		return 0;
+	case LZ4_STATE_BLOCK_LEN:
+		word = sys_get_le32(lz4->in);
+		lz4->in_need = word & ~FLASH_IMG_LZ4_BLOCK_STORED;
+
+		if (lz4->in_need == 0 ||
+		    lz4->in_need > ((word & FLASH_IMG_LZ4_BLOCK_STORED) ? lz4->block_size :
+				    LZ4_COMPRESSBOUND(lz4->block_size))) {
+			return -EINVAL;
+		}
+
+		lz4->state = (word & FLASH_IMG_LZ4_BLOCK_STORED) ? LZ4_STATE_STORED :
+			     LZ4_STATE_BLOCK;
+		return 0;
+	default:
+		if (lz4->state == LZ4_STATE_BLOCK) {
+			out_len = LZ4_decompress_safe((const char *)lz4->in, (char *)lz4->out,
+						      lz4->in_len, lz4->block_size);
+			if (out_len <= 0) {
+				return -EINVAL;
+			}
+
+			out = lz4->out;
+		} else {
+			out_len = lz4->in_len;
+		}
+
+		if ((size_t)out_len > lz4->image_size - lz4->out_total) {
+			return -EFBIG;
+		}
+
+		lz4->out_total += out_len;
+		lz4->state = LZ4_STATE_BLOCK_LEN;
+		lz4->in_need = sizeof(uint32_t);
+
+		return stream_flash_buffered_write(&ctx->stream, out, out_len, false);
+	}
+}
+
+static int lz4_write(struct flash_img_context *ctx, const uint8_t *data, size_t len)
+{
+	struct flash_img_lz4 *lz4 = ctx->lz4;
+	size_t chunk;
+	int rc;
+
+	while (len > 0) {
+		chunk = MIN(len, lz4->in_need - lz4->in_len);
+		memcpy(&lz4->in[lz4->in_len], data, chunk);
+		lz4->in_len += chunk;
+		data += chunk;
+		len -= chunk;
+
+		if (lz4->in_len < lz4->in_need) {
+			break;
+		}
+
+		rc = lz4_process(ctx);
+		lz4->in_len = 0;
+		if (rc != 0) {
+			return rc;
+		}
+	}
+
+	return 0;
+}
+#endif
+
 int flash_img_buffered_write(struct flash_img_context *ctx, const uint8_t *data,
 			     size_t len, bool flush)
 {
 	int rc;
 
+#ifdef CONFIG_IMG_LZ4
+	if (ctx->lz4 != NULL) {
+		rc = lz4_write(ctx, data, len);
+		if (rc != 0) {
+			return rc;
+		}
+
+		if (!flush) {
+			return 0;
+		}
+
+		/* The stream must end on a block boundary, with the whole image */
+		if (ctx->lz4->state != LZ4_STATE_BLOCK_LEN || ctx->lz4->in_len != 0 ||
+		    ctx->lz4->out_total != ctx->lz4->image_size) {
+			return -EINVAL;
+		}
+
+		ctx->lz4 = NULL;
+		len = 0;
+	}
+#endif
+
 	rc = stream_flash_buffered_write(&ctx->stream, data, len, flush);
 	if (!flush) {
 		return rc;
@@ -88,6 +237,10 @@ int flash_img_init_id(struct flash_img_context *ctx, uint8_t area_id)
 
 	flash_dev = flash_area_get_device(ctx->flash_area);
 
+#ifdef CONFIG_IMG_LZ4
+	ctx->lz4 = NULL;
+#endif
+
 	return stream_flash_init(&ctx->stream, flash_dev, ctx->buf,
 			CONFIG_IMG_BLOCK_BUF_SIZE, ctx->flash_area->fa_off,
 			ctx->flash_area->fa_size, NULL);
@@ -13,6 +13,8 @@
 #include <errno.h>
 #include <zephyr/device.h>
 
+#include "disk_cache.h"
+
 #define LOG_LEVEL CONFIG_DISK_LOG_LEVEL
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(disk);
@@ -60,6 +62,10 @@ int disk_access_init(const char *pdrv)
 
 	if ((disk != NULL) && (disk->ops != NULL) &&
 				(disk->ops->init != NULL)) {
+#ifdef CONFIG_DISK_CACHE
+		/* The media may have changed */
+		disk_cache_invalidate(disk);
+#endif
 		rc = disk->ops->init(disk);
 	}
 
@@ -87,7 +93,11 @@ int disk_access_read(const char *pdrv, uint8_t *data_buf,
 
 	if ((disk != NULL) && (disk->ops != NULL) &&
 				(disk->ops->read != NULL)) {
+#ifdef CONFIG_DISK_CACHE
+		rc = disk_cache_read(disk, data_buf, start_sector, num_sector);
+#else
 		rc = disk->ops->read(disk, data_buf, start_sector, num_sector);
+#endif
 	}
 
 	return rc;
@@ -101,7 +111,11 @@ int disk_access_write(const char *pdrv, const uint8_t *data_buf,
 
 	if ((disk != NULL) && (disk->ops != NULL) &&
 				(disk->ops->write != NULL)) {
+#ifdef CONFIG_DISK_CACHE
+		rc = disk_cache_write(disk, data_buf, start_sector, num_sector);
+#else
 		rc = disk->ops->write(disk, data_buf, start_sector, num_sector);
+#endif
 	}
 
 	return rc;
@@ -114,6 +128,14 @@ int disk_access_ioctl(const char *pdrv, uint8_t cmd, void *buf)
 
 	if ((disk != NULL) && (disk->ops != NULL) &&
 				(disk->ops->ioctl != NULL)) {
+#ifdef CONFIG_DISK_CACHE
+		if (cmd == DISK_IOCTL_CTRL_SYNC) {
+			rc = disk_cache_sync(disk);
+			if (rc != 0) {
+				return rc;
+			}
+		}
+#endif
 		rc = disk->ops->ioctl(disk, cmd, buf);
 	}
 
@@ -161,6 +183,10 @@ int disk_access_unregister(struct disk_info *disk)
 		rc = -EINVAL;
 		goto unreg_err;
 	}
+#ifdef CONFIG_DISK_CACHE
+	(void)disk_cache_sync(disk);
+	disk_cache_invalidate(disk);
+#endif
 	/* remove disk node from the list */
 	sys_dlist_remove(&disk->node);
 	LOG_DBG("disk interface(%s) unregistered", disk->name);
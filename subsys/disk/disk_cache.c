@@ -0,0 +1,379 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <errno.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/storage/disk_access.h>
+
+#include "disk_cache.h"
+
+#define LOG_LEVEL CONFIG_DISK_LOG_LEVEL
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(disk);
+
+#define CACHE_LINES		CONFIG_DISK_CACHE_LINES
+#define LINE_SECTORS		CONFIG_DISK_CACHE_LINE_SECTORS
+#define SECTOR_SIZE		CONFIG_DISK_CACHE_SECTOR_SIZE
+#define LINE_SIZE		(LINE_SECTORS * SECTOR_SIZE)
+#define READ_AHEAD		MIN(CONFIG_DISK_CACHE_READ_AHEAD, CACHE_LINES - 1)
+
+struct disk_cache_line {
+	/* Disk of the line, NULL if the line is unused */
+	struct disk_info *disk;
+	/* First sector of the line, a multiple of LINE_SECTORS */
+	uint32_t start;
+	/* Value of disk_cache_clock at the last access of the line */
+	uint32_t stamp;
+	bool dirty;
+};
+
+static struct disk_cache_line disk_cache_lines[CACHE_LINES];
+/* Lines read ahead are filled by a single read into consecutive buffers */
+static uint8_t disk_cache_buf[CACHE_LINES][LINE_SIZE] __aligned(4);
+static uint32_t disk_cache_clock;
+static struct disk_cache_stats disk_cache_stats;
+
+/* End of the last read, to detect sequential reads */
+static struct disk_info *disk_cache_seq_disk;
+static uint32_t disk_cache_seq_next;
+
+static K_MUTEX_DEFINE(disk_cache_lock);
+
+static inline int disk_cache_index(struct disk_cache_line *line)
+{
+	return line - disk_cache_lines;
+}
+
+static inline void disk_cache_touch(struct disk_cache_line *line)
+{
+	line->stamp = ++disk_cache_clock;
+}
+
+/* Get the number of sectors of a disk whose sectors can be cached */
+static int disk_cache_sector_count(struct disk_info *disk, uint32_t *count)
+{
+	uint32_t size;
+
+	if ((disk->ops->ioctl == NULL) ||
+	    (disk->ops->ioctl(disk, DISK_IOCTL_GET_SECTOR_SIZE, &size) != 0) ||
+	    (size != SECTOR_SIZE) ||
+	    (disk->ops->ioctl(disk, DISK_IOCTL_GET_SECTOR_COUNT, count) != 0)) {
+		return -ENOTSUP;
+	}
+
+	return 0;
+}
+
+static struct disk_cache_line *disk_cache_find(struct disk_info *disk,
+					       uint32_t start)
+{
+	for (int i = 0; i < CACHE_LINES; i++) {
+		if ((disk_cache_lines[i].disk == disk) &&
+		    (disk_cache_lines[i].start == start)) {
+			return &disk_cache_lines[i];
+		}
+	}
+
+	return NULL;
+}
+
+/* Write back the dirty line at index i, with the dirty lines following it
+ * in the cache which hold the following sectors of the disk.
+ */
+static int disk_cache_write_back(int i)
+{
+	struct disk_info *disk = disk_cache_lines[i].disk;
+	uint32_t start = disk_cache_lines[i].start;
+	int n = 1;
+	int rc;
+
+	while ((i + n < CACHE_LINES) && disk_cache_lines[i + n].dirty &&
+	       (disk_cache_lines[i + n].disk == disk) &&
+	       (disk_cache_lines[i + n].start == start + n * LINE_SECTORS)) {
+		n++;
+	}
+
+	rc = disk->ops->write(disk, disk_cache_buf[i], start, n * LINE_SECTORS);
+	if (rc != 0) {
+		LOG_ERR("Write back of sector %u failed: %d", start, rc);
+		return rc;
+	}
+
+	disk_cache_stats.write_backs += n;
+	while (n-- > 0) {
+		disk_cache_lines[i + n].dirty = false;
+	}
+
+	return 0;
+}
+
+/* Fill the line of the sector start and the following lines up to
+ * lines - 1 lines ahead, stopping at the first line already cached or
+ * extending past the disk, with a single read into the buffers of the
+ * least recently used consecutive lines.
+ */
+static struct disk_cache_line *disk_cache_fill(struct disk_info *disk,
+					       uint32_t start, uint32_t count,
+					       int lines, int *rc)
+{
+	uint32_t best_stamp = UINT32_MAX;
+	int best = 0;
+	int n = 1;
+
+	while ((n < lines) && (start + (n + 1) * LINE_SECTORS <= count) &&
+	       (disk_cache_find(disk, start + n * LINE_SECTORS) == NULL)) {
+		n++;
+	}
+
+	for (int w = 0; w + n <= CACHE_LINES; w++) {
+		uint32_t stamp = 0;
+
+		for (int i = w; i < w + n; i++) {
+			if (disk_cache_lines[i].disk != NULL) {
+				stamp = MAX(stamp, disk_cache_lines[i].stamp);
+			}
+		}
+
+		if (stamp < best_stamp) {
+			best_stamp = stamp;
+			best = w;
+		}
+	}
+
+	for (int i = best; i < best + n; i++) {
+		if (disk_cache_lines[i].dirty) {
+			*rc = disk_cache_write_back(i);
+			if (*rc != 0) {
+				return NULL;
+			}
+		}
+		disk_cache_lines[i].disk = NULL;
+	}
+
+	*rc = disk->ops->read(disk, disk_cache_buf[best], start, n * LINE_SECTORS);
+	if (*rc != 0) {
+		return NULL;
+	}
+
+	for (int i = 0; i < n; i++) {
+		disk_cache_lines[best + i].disk = disk;
+		disk_cache_lines[best + i].start = start + i * LINE_SECTORS;
+		disk_cache_touch(&disk_cache_lines[best + i]);
+	}
+
+	disk_cache_stats.read_ahead += n - 1;
+
+	return &disk_cache_lines[best];
+}
+
+/* Number of whole lines from sector start, not cached and within the disk,
+ * which are accessed directly instead of through the cache.
+ */
+static uint32_t disk_cache_uncached_lines(struct disk_info *disk,
+					  uint32_t start, uint32_t num_sector)
+{
+	uint32_t n = 0;
+
+	while ((num_sector - n * LINE_SECTORS >= LINE_SECTORS) &&
+	       (disk_cache_find(disk, start + n * LINE_SECTORS) == NULL)) {
+		n++;
+	}
+
+	return n;
+}
+
+int disk_cache_read(struct disk_info *disk, uint8_t *data_buf,
+		    uint32_t start_sector, uint32_t num_sector)
+{
+	struct disk_cache_line *line;
+	uint32_t count;
+	uint32_t line_start;
+	uint32_t off;
+	uint32_t n;
+	int lines;
+	int rc = 0;
+
+	k_mutex_lock(&disk_cache_lock, K_FOREVER);
+
+	if (disk_cache_sector_count(disk, &count) != 0) {
+		rc = disk->ops->read(disk, data_buf, start_sector, num_sector);
+		goto out;
+	}
+
+	if ((start_sector > count) || (num_sector > count - start_sector)) {
+		rc = -EINVAL;
+		goto out;
+	}
+
+	lines = ((disk_cache_seq_disk == disk) &&
+		 (disk_cache_seq_next == start_sector)) ? 1 + READ_AHEAD : 1;
+	disk_cache_seq_disk = disk;
+	disk_cache_seq_next = start_sector + num_sector;
+
+	while (num_sector > 0) {
+		line_start = ROUND_DOWN(start_sector, LINE_SECTORS);
+		off = start_sector - line_start;
+		n = MIN(num_sector, LINE_SECTORS - off);
+
+		line = disk_cache_find(disk, line_start);
+		if (line != NULL) {
+			disk_cache_stats.hits++;
+		} else if (line_start + LINE_SECTORS > count) {
+			/* The last sectors of the disk are not cached */
+			disk_cache_stats.misses++;
+			rc = disk->ops->read(disk, data_buf, start_sector, n);
+		} else if ((off == 0) && (num_sector >= LINE_SECTORS) &&
+			   (lines == 1)) {
+			n = disk_cache_uncached_lines(disk, start_sector,
+						      num_sector) * LINE_SECTORS;
+			disk_cache_stats.misses += n / LINE_SECTORS;
+			rc = disk->ops->read(disk, data_buf, start_sector, n);
+		} else {
+			disk_cache_stats.misses++;
+			line = disk_cache_fill(disk, line_start, count, lines, &rc);
+			lines = 1;
+		}
+
+		if (rc != 0) {
+			break;
+		}
+
+		if (line != NULL) {
+			memcpy(data_buf, &disk_cache_buf[disk_cache_index(line)][off * SECTOR_SIZE],
+			       n * SECTOR_SIZE);
+			disk_cache_touch(line);
+		}
+
+		data_buf += n * SECTOR_SIZE;
+		start_sector += n;
+		num_sector -= n;
+	}
+
+out:
+	k_mutex_unlock(&disk_cache_lock);
+
+	return rc;
+}
+
+int disk_cache_write(struct disk_info *disk, const uint8_t *data_buf,
+		     uint32_t start_sector, uint32_t num_sector)
+{
+	struct disk_cache_line *line;
+	uint32_t count;
+	uint32_t line_start;
+	uint32_t off;
+	uint32_t n;
+	int rc = 0;
+
+	k_mutex_lock(&disk_cache_lock, K_FOREVER);
+
+	if (disk_cache_sector_count(disk, &count) != 0) {
+		rc = disk->ops->write(disk, data_buf, start_sector, num_sector);
+		goto out;
+	}
+
+	if ((start_sector > count) || (num_sector > count - start_sector)) {
+		rc = -EINVAL;
+		goto out;
+	}
+
+	while (num_sector > 0) {
+		line_start = ROUND_DOWN(start_sector, LINE_SECTORS);
+		off = start_sector - line_start;
+		n = MIN(num_sector, LINE_SECTORS - off);
+
+		line = disk_cache_find(disk, line_start);
+		if (line != NULL) {
+			disk_cache_stats.hits++;
+		} else if (line_start + LINE_SECTORS > count) {
+			disk_cache_stats.misses++;
+			rc = disk->ops->write(disk, data_buf, start_sector, n);
+		} else if ((off == 0) && (num_sector >= LINE_SECTORS)) {
+			/* Whole lines are written through */
+			n = disk_cache_uncached_lines(disk, start_sector,
+						      num_sector) * LINE_SECTORS;
+			disk_cache_stats.misses += n / LINE_SECTORS;
+			rc = disk->ops->write(disk, data_buf, start_sector, n);
+		} else {
+			disk_cache_stats.misses++;
+			line = disk_cache_fill(disk, line_start, count, 1, &rc);
+		}
+
+		if (rc != 0) {
+			break;
+		}
+
+		if (line != NULL) {
+			memcpy(&disk_cache_buf[disk_cache_index(line)][off * SECTOR_SIZE], data_buf,
+			       n * SECTOR_SIZE);
+			line->dirty = true;
+			disk_cache_touch(line);
+		}
+
+		data_buf += n * SECTOR_SIZE;
+		start_sector += n;
+		num_sector -= n;
+	}
+
+out:
+	k_mutex_unlock(&disk_cache_lock);
+
+	return rc;
+}
+
+int disk_cache_sync(struct disk_info *disk)
+{
+	int rc = 0;
+
+	k_mutex_lock(&disk_cache_lock, K_FOREVER);
+
+	for (int i = 0; i < CACHE_LINES; i++) {
+		if ((disk_cache_lines[i].disk == disk) && disk_cache_lines[i].dirty) {
+			rc = disk_cache_write_back(i);
+			if (rc != 0) {
+				break;
+			}
+		}
+	}
+
+	k_mutex_unlock(&disk_cache_lock);
+
+	return rc;
+}
+
+void disk_cache_invalidate(struct disk_info *disk)
+{
+	k_mutex_lock(&disk_cache_lock, K_FOREVER);
+
+	for (int i = 0; i < CACHE_LINES; i++) {
+		if (disk_cache_lines[i].disk == disk) {
+			disk_cache_lines[i].disk = NULL;
+			disk_cache_lines[i].dirty = false;
+		}
+	}
+
+	if (disk_cache_seq_disk == disk) {
+		disk_cache_seq_disk = NULL;
+	}
+
+	k_mutex_unlock(&disk_cache_lock);
+}
+
+void disk_cache_stats_get(struct disk_cache_stats *stats)
+{
+	k_mutex_lock(&disk_cache_lock, K_FOREVER);
+	*stats = disk_cache_stats;
+	k_mutex_unlock(&disk_cache_lock);
+}
+
+void disk_cache_stats_reset(void)
+{
+	k_mutex_lock(&disk_cache_lock, K_FOREVER);
+	memset(&disk_cache_stats, 0, sizeof(disk_cache_stats));
+	k_mutex_unlock(&disk_cache_lock);
+}
@@ -0,0 +1,24 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_SUBSYS_DISK_DISK_CACHE_H_
+#define ZEPHYR_SUBSYS_DISK_DISK_CACHE_H_
+
+#include <zephyr/drivers/disk.h>
+
+int disk_cache_read(struct disk_info *disk, uint8_t *data_buf,
+		    uint32_t start_sector, uint32_t num_sector);
+
+int disk_cache_write(struct disk_info *disk, const uint8_t *data_buf,
+		     uint32_t start_sector, uint32_t num_sector);
+
+/* Write back the dirty lines of a disk */
+int disk_cache_sync(struct disk_info *disk);
+
+/* Drop the lines of a disk, including the dirty ones */
+void disk_cache_invalidate(struct disk_info *disk);
+
+#endif /* ZEPHYR_SUBSYS_DISK_DISK_CACHE_H_ */
@@ -0,0 +1,39 @@
+/* Copyright (c) 2023 Zephyr Project
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/dsp/stream.h>
+
+int zdsp_stream_process(struct zdsp_stream *stream, void *block, uint32_t block_size)
+{
+	if (block_size > stream->block_size) {
+		return -EINVAL;
+	}
+
+	for (size_t i = 0; i < stream->num_stages; i++) {
+		struct zdsp_stage *stage = &stream->stages[i];
+#ifdef CONFIG_DSP_STREAM_STATS
+		uint32_t start = k_cycle_get_32();
+#endif /* CONFIG_DSP_STREAM_STATS */
+
+		stage->fn(stage->ctx, block, block_size);
+
+#ifdef CONFIG_DSP_STREAM_STATS
+		stage->cycles += k_cycle_get_32() - start;
+		stage->blocks++;
+#endif /* CONFIG_DSP_STREAM_STATS */
+	}
+
+	return 0;
+}
+
+#ifdef CONFIG_DSP_STREAM_STATS
+void zdsp_stream_stats_reset(struct zdsp_stream *stream)
+{
+	for (size_t i = 0; i < stream->num_stages; i++) {
+		stream->stages[i].cycles = 0;
+		stream->stages[i].blocks = 0;
+	}
+}
+#endif /* CONFIG_DSP_STREAM_STATS */
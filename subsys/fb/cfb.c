@@ -59,6 +59,20 @@ struct char_framebuffer {
 
 	/** Inverted */
 	bool inverted;
+
+	/** First line changed since the last finalize */
+	uint16_t dirty_y0;
+
+	/** Line following the last line changed since the last finalize */
+	uint16_t dirty_y1;
+
+#if defined(CONFIG_CHARACTER_FRAMEBUFFER_GLYPH_CACHE)
+	/** Glyphs of the current font, ready to be copied to the framebuffer */
+	const uint8_t *glyphs;
+
+	/** Glyphs allocated, rather than pointing to the font data */
+	bool glyphs_allocated;
+#endif
 };
 
 static struct char_framebuffer char_fb;
@@ -83,11 +97,150 @@ static inline uint8_t get_glyph_byte(uint8_t *glyph_ptr, const struct cfb_font *
 	return 0;
 }
 
+static inline void mark_dirty(struct char_framebuffer *fb, int16_t y, int16_t height)
+{
+	const uint16_t y0 = CLAMP(y, 0, (int)fb->y_res);
+	const uint16_t y1 = CLAMP((int)y + height, 0, (int)fb->y_res);
+
+	if (y0 >= y1) {
+		return;
+	}
+
+	if (fb->dirty_y0 >= fb->dirty_y1) {
+		fb->dirty_y0 = y0;
+		fb->dirty_y1 = y1;
+	} else {
+		fb->dirty_y0 = MIN(fb->dirty_y0, y0);
+		fb->dirty_y1 = MAX(fb->dirty_y1, y1);
+	}
+}
+
+#if defined(CONFIG_CHARACTER_FRAMEBUFFER_GLYPH_CACHE)
+static void glyph_cache_free(struct char_framebuffer *fb)
+{
+	if (fb->glyphs_allocated) {
+		k_free((void *)fb->glyphs);
+	}
+
+	fb->glyphs = NULL;
+	fb->glyphs_allocated = false;
+}
+
+/*
+ * Store the glyphs of the current font as the display stores its tiles:
+ * for each column, the bytes of the 8-line rows from top to bottom, in the
+ * bit order of the display. Fonts already stored this way are used as is.
+ */
+static void glyph_cache_update(struct char_framebuffer *fb)
+{
+	const struct cfb_font *fptr = &(fb->fonts[fb->font_idx]);
+	const bool need_reverse = (((fb->screen_info & SCREEN_INFO_MONO_MSB_FIRST) != 0)
+			     != ((fptr->caps & CFB_FONT_MSB_FIRST) != 0));
+	const size_t tiles = fptr->height / 8U;
+	const size_t glyph_size = fptr->width * tiles;
+	uint8_t *glyphs;
+
+	glyph_cache_free(fb);
+
+	if (!(fb->screen_info & SCREEN_INFO_MONO_VTILED) || (fptr->height % 8U) != 0U) {
+		return;
+	}
+
+	if ((fptr->caps & CFB_FONT_MONO_VPACKED) && !need_reverse) {
+		fb->glyphs = fptr->data;
+		return;
+	}
+
+	glyphs = k_malloc((fptr->last_char - fptr->first_char + 1) * glyph_size);
+	if (!glyphs) {
+		LOG_WRN("No memory for the glyph cache");
+		return;
+	}
+
+	for (size_t c = fptr->first_char; c <= fptr->last_char; c++) {
+		uint8_t *glyph_ptr = get_glyph_ptr(fptr, c);
+		uint8_t *dst = &glyphs[(c - fptr->first_char) * glyph_size];
+
+		for (size_t g_x = 0; g_x < fptr->width; g_x++) {
+			for (size_t t = 0; t < tiles; t++) {
+				uint8_t byte = get_glyph_byte(glyph_ptr, fptr, g_x, t);
+
+				*dst++ = need_reverse ? byte_reverse(byte) : byte;
+			}
+		}
+	}
+
+	fb->glyphs = glyphs;
+	fb->glyphs_allocated = true;
+}
+
+/*
+ * Draw a glyph of the cache, a byte at a time. On a start row not on an
+ * 8-line boundary, each glyph byte is split between two framebuffer bytes.
+ */
+static void draw_glyph_vtmono(const struct char_framebuffer *fb, const uint8_t *glyph,
+			      const struct cfb_font *fptr, uint16_t x, uint16_t y,
+			      bool draw_bg)
+{
+	const bool msb_first = ((fb->screen_info & SCREEN_INFO_MONO_MSB_FIRST) != 0);
+	const size_t tiles = fptr->height / 8U;
+	const size_t rows = fb->y_res / 8U;
+	const size_t row = y / 8U;
+	const uint8_t offset = y % 8U;
+	uint8_t head_mask = BIT_MASK(offset);
+	uint8_t tail_mask = ~BIT_MASK(offset);
+
+	if (msb_first) {
+		head_mask = byte_reverse(head_mask);
+		tail_mask = byte_reverse(tail_mask);
+	}
+
+	for (size_t g_x = 0; g_x < fptr->width; g_x++, glyph += tiles) {
+		const int16_t fb_x = x + g_x;
+		uint8_t carry = 0U;
+		uint8_t *dst;
+		size_t t;
+
+		if (fb_x < 0 || fb->x_res <= fb_x) {
+			continue;
+		}
+
+		dst = &fb->buf[row * fb->x_res + fb_x];
+
+		for (t = 0; t < tiles && row + t < rows; t++, dst += fb->x_res) {
+			uint8_t byte = glyph[t];
+
+			if (offset != 0) {
+				const uint8_t next = msb_first ? byte << (8 - offset)
+							       : byte >> (8 - offset);
+
+				byte = carry | (msb_first ? byte >> offset : byte << offset);
+				carry = next;
+			}
+
+			if (draw_bg) {
+				*dst &= (t == 0) ? head_mask : 0U;
+			}
+
+			*dst |= byte;
+		}
+
+		if (offset != 0 && t == tiles && row + t < rows) {
+			if (draw_bg) {
+				*dst &= tail_mask;
+			}
+
+			*dst |= carry;
+		}
+	}
+}
+#endif /* CONFIG_CHARACTER_FRAMEBUFFER_GLYPH_CACHE */
+
 /*
  * Draw the monochrome character in the monochrome tiled framebuffer,
  * a byte is interpreted as 8 pixels ordered vertically among each other.
  */
-static uint8_t draw_char_vtmono(const struct char_framebuffer *fb,
+static uint8_t draw_char_vtmono(struct char_framebuffer *fb,
 				char c, uint16_t x, uint16_t y,
 				bool draw_bg)
 {
@@ -100,6 +253,17 @@ static uint8_t draw_char_vtmono(const struct char_framebuffer *fb,
 		c = ' ';
 	}
 
+	mark_dirty(fb, y, fptr->height);
+
+#if defined(CONFIG_CHARACTER_FRAMEBUFFER_GLYPH_CACHE)
+	if (fb->glyphs && y < fb->y_res) {
+		draw_glyph_vtmono(fb, &fb->glyphs[(c - fptr->first_char) * fptr->width *
+						  (fptr->height / 8U)],
+				  fptr, x, y, draw_bg);
+		return fptr->width;
+	}
+#endif
+
 	glyph_ptr = get_glyph_ptr(fptr, c);
 	if (!glyph_ptr) {
 		return 0;
@@ -202,6 +366,7 @@ static inline void draw_point(struct char_framebuffer *fb, int16_t x, int16_t y)
 	}
 
 	fb->buf[index + x] |= m;
+	mark_dirty(fb, y, 1);
 }
 
 static void draw_line(struct char_framebuffer *fb, int16_t x0, int16_t y0, int16_t x1, int16_t y1)
@@ -237,7 +402,7 @@ static void draw_line(struct char_framebuffer *fb, int16_t x0, int16_t y0, int16
 static int draw_text(const struct device *dev, const char *const str, int16_t x, int16_t y,
 		     bool wrap)
 {
-	const struct char_framebuffer *fb = &char_fb;
+	struct char_framebuffer *fb = &char_fb;
 	const struct cfb_font *fptr;
 
 	if (!fb->fonts || !fb->buf) {
@@ -311,7 +476,7 @@ int cfb_print(const struct device *dev, const char *const str, uint16_t x, uint1
 int cfb_invert_area(const struct device *dev, uint16_t x, uint16_t y,
 		    uint16_t width, uint16_t height)
 {
-	const struct char_framebuffer *fb = &char_fb;
+	struct char_framebuffer *fb = &char_fb;
 	const bool need_reverse = ((fb->screen_info & SCREEN_INFO_MONO_MSB_FIRST) != 0);
 
 	if (x >= fb->x_res || y >= fb->y_res) {
@@ -337,6 +502,8 @@ int cfb_invert_area(const struct device *dev, uint16_t x, uint16_t y,
 			height = fb->y_res - y;
 		}
 
+		mark_dirty(fb, y, height);
+
 		for (size_t i = x; i < x + width; i++) {
 			for (size_t j = y; j < (y + height); j++) {
 				/*
@@ -395,24 +562,23 @@ int cfb_invert_area(const struct device *dev, uint16_t x, uint16_t y,
 	return -EINVAL;
 }
 
-static int cfb_invert(const struct char_framebuffer *fb)
+static void cfb_invert(uint8_t *buf, size_t size)
 {
-	for (size_t i = 0; i < fb->x_res * fb->y_res / 8U; i++) {
-		fb->buf[i] = ~fb->buf[i];
+	for (size_t i = 0; i < size; i++) {
+		buf[i] = ~buf[i];
 	}
-
-	return 0;
 }
 
 int cfb_framebuffer_clear(const struct device *dev, bool clear_display)
 {
-	const struct char_framebuffer *fb = &char_fb;
+	struct char_framebuffer *fb = &char_fb;
 
 	if (!fb || !fb->buf) {
 		return -ENODEV;
 	}
 
 	memset(fb->buf, 0, fb->size);
+	mark_dirty(fb, 0, fb->y_res);
 
 	if (clear_display) {
 		cfb_framebuffer_finalize(dev);
@@ -430,6 +596,7 @@ int cfb_framebuffer_invert(const struct device *dev)
 	}
 
 	fb->inverted = !fb->inverted;
+	mark_dirty(fb, 0, fb->y_res);
 
 	return 0;
 }
@@ -437,27 +604,47 @@ int cfb_framebuffer_invert(const struct device *dev)
 int cfb_framebuffer_finalize(const struct device *dev)
 {
 	const struct display_driver_api *api = dev->api;
-	const struct char_framebuffer *fb = &char_fb;
+	struct char_framebuffer *fb = &char_fb;
 	struct display_buffer_descriptor desc;
+	uint16_t y0, y1;
+	uint8_t *buf;
 	int err;
 
 	if (!fb || !fb->buf) {
 		return -ENODEV;
 	}
 
-	desc.buf_size = fb->size;
+	if (fb->dirty_y0 >= fb->dirty_y1) {
+		return 0;
+	}
+
+	/*
+	 * Only the rows of tiles changed are written. The rows are contiguous
+	 * in the framebuffer, which the display drivers require.
+	 */
+	y0 = ROUND_DOWN(fb->dirty_y0, fb->ppt);
+	y1 = MIN(ROUND_UP(fb->dirty_y1, fb->ppt), fb->y_res);
+	buf = fb->buf + (size_t)y0 * fb->x_res / fb->ppt;
+
+	desc.buf_size = (size_t)(y1 - y0) * fb->x_res / fb->ppt;
 	desc.width = fb->x_res;
-	desc.height = fb->y_res;
+	desc.height = y1 - y0;
 	desc.pitch = fb->x_res;
 
 	if (!(fb->pixel_format & PIXEL_FORMAT_MONO10) != !(fb->inverted)) {
-		cfb_invert(fb);
-		err = api->write(dev, 0, 0, &desc, fb->buf);
-		cfb_invert(fb);
-		return err;
+		cfb_invert(buf, desc.buf_size);
+		err = api->write(dev, 0, y0, &desc, buf);
+		cfb_invert(buf, desc.buf_size);
+	} else {
+		err = api->write(dev, 0, y0, &desc, buf);
 	}
 
-	return api->write(dev, 0, 0, &desc, fb->buf);
+	if (err == 0) {
+		fb->dirty_y0 = 0U;
+		fb->dirty_y1 = 0U;
+	}
+
+	return err;
 }
 
 int cfb_get_display_parameter(const struct device *dev,
@@ -496,6 +683,10 @@ int cfb_framebuffer_set_font(const struct device *dev, uint8_t idx)
 
 	fb->font_idx = idx;
 
+#if defined(CONFIG_CHARACTER_FRAMEBUFFER_GLYPH_CACHE)
+	glyph_cache_update(fb);
+#endif
+
 	return 0;
 }
 
@@ -564,6 +755,14 @@ int cfb_framebuffer_init(const struct device *dev)
 	}
 
 	memset(fb->buf, 0, fb->size);
+	mark_dirty(fb, 0, fb->y_res);
+
+#if defined(CONFIG_CHARACTER_FRAMEBUFFER_GLYPH_CACHE)
+	glyph_cache_free(fb);
+	if (fb->numof_fonts > 0) {
+		glyph_cache_update(fb);
+	}
+#endif
 
 	return 0;
 }
@@ -0,0 +1,252 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include <zephyr/display/fb_dirty.h>
+#include <zephyr/drivers/display.h>
+#include <zephyr/init.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/util.h>
+
+LOG_MODULE_REGISTER(fb_dirty, CONFIG_FB_DIRTY_LOG_LEVEL);
+
+static K_THREAD_STACK_DEFINE(fb_dirty_work_q_stack, CONFIG_FB_DIRTY_WORK_QUEUE_STACK_SIZE);
+static struct k_work_q fb_dirty_work_q;
+
+static int fb_dirty_work_q_init(void)
+{
+	const struct k_work_queue_config cfg = {.name = "fb_dirty_wq"};
+
+	k_work_queue_init(&fb_dirty_work_q);
+	k_work_queue_start(&fb_dirty_work_q, fb_dirty_work_q_stack,
+			   K_THREAD_STACK_SIZEOF(fb_dirty_work_q_stack),
+			   CONFIG_FB_DIRTY_WORK_QUEUE_PRIORITY, &cfg);
+
+	return 0;
+}
+
+SYS_INIT(fb_dirty_work_q_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
+
+static uint32_t rect_area(const struct fb_dirty_rect *rect)
+{
+	return (uint32_t)rect->width * rect->height;
+}
+
+/* Overlapping or adjacent rectangles */
+static bool rects_touch(const struct fb_dirty_rect *a, const struct fb_dirty_rect *b)
+{
+	return a->x <= b->x + b->width && b->x <= a->x + a->width &&
+	       a->y <= b->y + b->height && b->y <= a->y + a->height;
+}
+
+static void rects_union(struct fb_dirty_rect *a, const struct fb_dirty_rect *b)
+{
+	uint16_t x2 = MAX(a->x + a->width, b->x + b->width);
+	uint16_t y2 = MAX(a->y + a->height, b->y + b->height);
+
+	a->x = MIN(a->x, b->x);
+	a->y = MIN(a->y, b->y);
+	a->width = x2 - a->x;
+	a->height = y2 - a->y;
+}
+
+static void remove_rect(struct fb_dirty *fb, uint8_t idx)
+{
+	fb->rects[idx] = fb->rects[--fb->n_rects];
+}
+
+void fb_dirty_mark(struct fb_dirty *fb, const struct fb_dirty_rect *rect)
+{
+	struct fb_dirty_rect cur = *rect;
+	struct fb_dirty_rect merged;
+	uint32_t growth, best_growth;
+	uint8_t best;
+	uint8_t i;
+
+	if (cur.x >= fb->width || cur.y >= fb->height || cur.width == 0 || cur.height == 0) {
+		return;
+	}
+
+	cur.width = MIN(cur.width, fb->width - cur.x);
+	cur.height = MIN(cur.height, fb->height - cur.y);
+
+	if (IS_ENABLED(CONFIG_FB_DIRTY_FULL_ROWS)) {
+		cur.x = 0;
+		cur.width = fb->width;
+	}
+
+	while (true) {
+		/* Absorb the rectangles touching the new one, which may then touch others */
+		for (i = 0; i < fb->n_rects; i++) {
+			if (rects_touch(&cur, &fb->rects[i])) {
+				break;
+			}
+		}
+
+		if (i < fb->n_rects) {
+			rects_union(&cur, &fb->rects[i]);
+			remove_rect(fb, i);
+			continue;
+		}
+
+		if (fb->n_rects < ARRAY_SIZE(fb->rects)) {
+			fb->rects[fb->n_rects++] = cur;
+			return;
+		}
+
+		/* All the rectangles are in use, merge with the one growing the least */
+		best = 0;
+		best_growth = UINT32_MAX;
+		for (i = 0; i < fb->n_rects; i++) {
+			merged = fb->rects[i];
+			rects_union(&merged, &cur);
+			growth = rect_area(&merged) - rect_area(&fb->rects[i]);
+			if (growth < best_growth) {
+				best_growth = growth;
+				best = i;
+			}
+		}
+
+		rects_union(&cur, &fb->rects[best]);
+		remove_rect(fb, best);
+	}
+}
+
+static int write_rects(struct fb_dirty *fb, const uint8_t *buf,
+		       const struct fb_dirty_rect *rects, uint8_t n_rects)
+{
+	struct display_buffer_descriptor desc;
+	size_t offset;
+	int ret;
+
+	for (uint8_t i = 0; i < n_rects; i++) {
+		/* The rows are written from the framebuffer, a display width apart */
+		desc.width = rects[i].width;
+		desc.height = rects[i].height;
+		desc.pitch = fb->width;
+		desc.buf_size = (uint32_t)fb->width * rects[i].height * fb->pixel_size;
+		offset = ((size_t)rects[i].y * fb->width + rects[i].x) * fb->pixel_size;
+
+		ret = display_write(fb->dev, rects[i].x, rects[i].y, &desc, &buf[offset]);
+		if (ret < 0) {
+			LOG_ERR("Failed to write %ux%u at %u,%u: %d", rects[i].width,
+				rects[i].height, rects[i].x, rects[i].y, ret);
+			return ret;
+		}
+	}
+
+	return 0;
+}
+
+static void flush_handler(struct k_work *work)
+{
+	struct fb_dirty *fb = CONTAINER_OF(work, struct fb_dirty, work);
+
+	/* The framebuffer flushed is the one not rendered into */
+	fb->flush_err = write_rects(fb, fb->bufs[fb->back ^ 1], fb->flush_rects,
+				    fb->n_flush_rects);
+
+	k_sem_give(&fb->idle);
+}
+
+int fb_dirty_init(struct fb_dirty *fb, const struct device *dev, uint8_t *buf0,
+		  uint8_t *buf1, size_t size)
+{
+	struct display_capabilities caps;
+	uint32_t bits;
+
+	display_get_capabilities(dev, &caps);
+
+	bits = DISPLAY_BITS_PER_PIXEL(caps.current_pixel_format);
+	if (bits == 0 || bits % 8 != 0) {
+		return -ENOTSUP;
+	}
+
+	if (size < (size_t)caps.x_resolution * caps.y_resolution * (bits / 8)) {
+		return -EINVAL;
+	}
+
+	memset(fb, 0, sizeof(*fb));
+	fb->dev = dev;
+	fb->bufs[0] = buf0;
+	fb->bufs[1] = buf1;
+	fb->width = caps.x_resolution;
+	fb->height = caps.y_resolution;
+	fb->pixel_size = bits / 8;
+	k_work_init(&fb->work, flush_handler);
+	k_sem_init(&fb->idle, 1, 1);
+
+	/* Both framebuffers hold the frame last flushed */
+	if (buf1 != NULL) {
+		memcpy(buf1, buf0, size);
+	}
+
+	return 0;
+}
+
+int fb_dirty_flush(struct fb_dirty *fb)
+{
+	const uint8_t *front;
+	uint8_t *back;
+	size_t offset;
+	int err;
+
+	(void)k_sem_take(&fb->idle, K_FOREVER);
+
+	err = fb->flush_err;
+	fb->flush_err = 0;
+
+	if (fb->n_rects == 0) {
+		k_sem_give(&fb->idle);
+		return err;
+	}
+
+	if (fb->bufs[1] == NULL) {
+		err = write_rects(fb, fb->bufs[0], fb->rects, fb->n_rects);
+		fb->n_rects = 0;
+		k_sem_give(&fb->idle);
+		return err;
+	}
+
+	memcpy(fb->flush_rects, fb->rects, fb->n_rects * sizeof(fb->rects[0]));
+	fb->n_flush_rects = fb->n_rects;
+	fb->n_rects = 0;
+
+	front = fb->bufs[fb->back];
+	fb->back ^= 1;
+	back = fb->bufs[fb->back];
+
+	(void)k_work_submit_to_queue(&fb_dirty_work_q, &fb->work);
+
+	/* Bring the other framebuffer up to date, it differs by the rectangles flushed */
+	for (uint8_t i = 0; i < fb->n_flush_rects; i++) {
+		const struct fb_dirty_rect *rect = &fb->flush_rects[i];
+
+		for (uint16_t row = rect->y; row < rect->y + rect->height; row++) {
+			offset = ((size_t)row * fb->width + rect->x) * fb->pixel_size;
+			memcpy(&back[offset], &front[offset], (size_t)rect->width * fb->pixel_size);
+		}
+	}
+
+	return err;
+}
+
+int fb_dirty_sync(struct fb_dirty *fb, k_timeout_t timeout)
+{
+	int err;
+
+	if (k_sem_take(&fb->idle, timeout) != 0) {
+		return -EAGAIN;
+	}
+
+	err = fb->flush_err;
+	fb->flush_err = 0;
+	k_sem_give(&fb->idle);
+
+	return err;
+}
@@ -72,6 +72,24 @@ int32_t ext2_bitmap_find_free(uint8_t *bm, uint32_t size)
 	return -ENOSPC;
 }
 
+int32_t ext2_bitmap_find_free_from(uint8_t *bm, uint32_t start, uint32_t size)
+{
+	uint32_t i = start;
+
+	while (i < size * 8) {
+		if ((i % 8 == 0) && (bm[i / 8] == UINT8_MAX)) {
+			/* all bits are set here */
+			i += 8;
+			continue;
+		}
+		if ((bm[i / 8] & BIT(i % 8)) == 0) {
+			return i;
+		}
+		i++;
+	}
+	return -ENOSPC;
+}
+
 uint32_t ext2_bitmap_count_set(uint8_t *bm, uint32_t size)
 {
 	int32_t count = 0;
@@ -51,6 +51,18 @@ int ext2_bitmap_unset(uint8_t *bm, uint32_t index, uint32_t size);
  */
 int32_t ext2_bitmap_find_free(uint8_t *bm, uint32_t size);
 
+/**
+ * @brief Find first bit set to zero in bitmap at or after given index
+ *
+ * @param bm Pointer to bitmap
+ * @param start Index in bitmap to start the search from
+ * @param size Size of bitmap in bytes
+ *
+ * @retval >=0 index of found bit;
+ * @retval -ENOSPC when not found;
+ */
+int32_t ext2_bitmap_find_free_from(uint8_t *bm, uint32_t start, uint32_t size);
+
 /**
  * @brief Helper function to count bits set in bitmap
  *
@@ -38,11 +38,8 @@ static int disk_read(const char *disk, uint8_t *buf, uint32_t start, uint32_t nu
 	int rc, loop = 0;
 
 	do {
-		rc = disk_access_ioctl(disk, DISK_IOCTL_CTRL_SYNC, NULL);
-		if (rc == 0) {
-			rc = disk_access_read(disk, buf, start, num);
-			LOG_DBG("disk read: (start:%d, num:%d) (ret: %d)", start, num, rc);
-		}
+		rc = disk_access_read(disk, buf, start, num);
+		LOG_DBG("disk read: (start:%d, num:%d) (ret: %d)", start, num, rc);
 	} while ((rc == -EBUSY) && (loop++ < 16));
 	return rc;
 }
@@ -52,11 +49,8 @@ static int disk_write(const char *disk, const uint8_t *buf, uint32_t start, uint
 	int rc, loop = 0;
 
 	do {
-		rc = disk_access_ioctl(disk, DISK_IOCTL_CTRL_SYNC, NULL);
-		if (rc == 0) {
-			rc = disk_access_write(disk, buf, start, num);
-			LOG_DBG("disk write: (start:%d, num:%d) (ret: %d)", start, num, rc);
-		}
+		rc = disk_access_write(disk, buf, start, num);
+		LOG_DBG("disk write: (start:%d, num:%d) (ret: %d)", start, num, rc);
 	} while ((rc == -EBUSY) && (loop++ < 16));
 	return rc;
 }
@@ -86,13 +80,14 @@ static int disk_prepare_range(struct disk_data *disk, uint32_t addr, uint32_t si
 	return 0;
 }
 
-static int disk_access_read_block(struct ext2_data *fs, void *buf, uint32_t block)
+static int disk_access_read_blocks(struct ext2_data *fs, void *buf, uint32_t block,
+		uint32_t count)
 {
 	int rc;
 	struct disk_data *disk = fs->backend;
 	uint32_t sector_start, sector_count;
 
-	rc = disk_prepare_range(disk, block * fs->block_size, fs->block_size,
+	rc = disk_prepare_range(disk, block * fs->block_size, count * fs->block_size,
 			&sector_start, &sector_count);
 	if (rc < 0) {
 		return rc;
@@ -100,13 +95,14 @@ static int disk_access_read_block(struct ext2_data *fs, void *buf, uint32_t bloc
 	return disk_read(disk->name, buf, sector_start, sector_count);
 }
 
-static int disk_access_write_block(struct ext2_data *fs, const void *buf, uint32_t block)
+static int disk_access_write_blocks(struct ext2_data *fs, const void *buf, uint32_t block,
+		uint32_t count)
 {
 	int rc;
 	struct disk_data *disk = fs->backend;
 	uint32_t sector_start, sector_count;
 
-	rc = disk_prepare_range(disk, block * fs->block_size, fs->block_size,
+	rc = disk_prepare_range(disk, block * fs->block_size, count * fs->block_size,
 			&sector_start, &sector_count);
 	if (rc < 0) {
 		return rc;
@@ -114,6 +110,16 @@ static int disk_access_write_block(struct ext2_data *fs, const void *buf, uint32
 	return disk_write(disk->name, buf, sector_start, sector_count);
 }
 
+static int disk_access_read_block(struct ext2_data *fs, void *buf, uint32_t block)
+{
+	return disk_access_read_blocks(fs, buf, block, 1);
+}
+
+static int disk_access_write_block(struct ext2_data *fs, const void *buf, uint32_t block)
+{
+	return disk_access_write_blocks(fs, buf, block, 1);
+}
+
 static int disk_access_read_superblock(struct ext2_data *fs, struct ext2_disk_superblock *sb)
 {
 	int rc;
@@ -141,6 +147,8 @@ static const struct ext2_backend_ops disk_access_ops = {
 	.get_write_size = disk_access_write_size,
 	.read_block = disk_access_read_block,
 	.write_block = disk_access_write_block,
+	.read_blocks = disk_access_read_blocks,
+	.write_blocks = disk_access_write_blocks,
 	.read_superblock = disk_access_read_superblock,
 	.sync = disk_access_sync,
 };
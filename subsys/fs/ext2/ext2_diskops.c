@@ -24,6 +24,7 @@ LOG_MODULE_DECLARE(ext2);
 /* Static declarations */
 static int get_level_offsets(struct ext2_data *fs, uint32_t block, uint32_t offsets[4]);
 static inline uint32_t get_ngroups(struct ext2_data *fs);
+static int write_deferred_bbitmap(struct ext2_data *fs);
 
 #define MAX_OFFSETS_SIZE 4
 /* Array of zeros to be used in inode block calculation */
@@ -253,6 +254,13 @@ int ext2_fetch_block_group(struct ext2_data *fs, uint32_t group)
 		return -ERANGE;
 	}
 
+	/* Deferred changes of the fetched group must be written before it is dropped. */
+	int rc = ext2_sync_block_alloc(fs);
+
+	if (rc < 0) {
+		return rc;
+	}
+
 	uint32_t groups_per_block = fs->block_size / sizeof(struct ext2_disk_bgroup);
 	uint32_t block = group / groups_per_block;
 	uint32_t offset = group % groups_per_block;
@@ -398,15 +406,32 @@ int ext2_fetch_inode(struct ext2_data *fs, uint32_t ino, struct ext2_inode *inod
 	return 0;
 }
 
+/* Number of blocks from the one at offset in the block list which are consecutive on disk */
+static uint32_t count_consecutive(const uint32_t *list, uint32_t offset, uint32_t list_len,
+		uint32_t max)
+{
+	uint32_t block = sys_le32_to_cpu(list[offset]);
+	uint32_t count = 1;
+
+	while ((count < max) && (offset + count < list_len) &&
+	       (sys_le32_to_cpu(list[offset + count]) == block + count)) {
+		count++;
+	}
+	return count;
+}
+
 /*
  * @param try_current -- if true then check if searched offset matches offset of currently fetched
  *        block on that level. If they match then it is the block we are looking for.
+ * @param ra -- maximum number of blocks to read at once on the last level, when the following
+ *        blocks are consecutive on disk.
  */
 static int fetch_level_blocks(struct ext2_inode *inode, uint32_t offsets[4], int lvl, int max_lvl,
-		bool try_current)
+		bool try_current, uint32_t ra)
 {
-	uint32_t block;
-	bool already_fetched = try_current && (offsets[lvl] == inode->offsets[lvl]);
+	uint32_t block, count = 1;
+	bool already_fetched = try_current && (offsets[lvl] == inode->offsets[lvl]) &&
+		(inode->blocks[lvl] != NULL);
 
 	/* all needed blocks fetched */
 	if (lvl > max_lvl) {
@@ -424,16 +449,25 @@ static int fetch_level_blocks(struct ext2_inode *inode, uint32_t offsets[4], int
 
 		if (lvl == 0) {
 			block = inode->i_block[offsets[0]];
+			while ((lvl == max_lvl) && (block != 0) && (count < ra) &&
+			       (offsets[0] + count < EXT2_INODE_BLOCK_1LVL) &&
+			       (inode->i_block[offsets[0] + count] == block + count)) {
+				count++;
+			}
 		} else {
 			uint32_t *list = (uint32_t *)inode->blocks[lvl - 1]->data;
 
 			block = sys_le32_to_cpu(list[offsets[lvl]]);
+			if (lvl == max_lvl && ra > 1 && block != 0) {
+				count = count_consecutive(list, offsets[lvl],
+						inode->i_fs->block_size / EXT2_BLOCK_NUM_SIZE, ra);
+			}
 		}
 
 		if (block == 0) {
 			inode->blocks[lvl] = ext2_get_empty_block(inode->i_fs);
 		} else {
-			inode->blocks[lvl] = ext2_get_block(inode->i_fs, block);
+			inode->blocks[lvl] = ext2_get_block_ra(inode->i_fs, block, count);
 		}
 
 		if (inode->blocks[lvl] == NULL) {
@@ -441,7 +475,16 @@ static int fetch_level_blocks(struct ext2_inode *inode, uint32_t offsets[4], int
 		}
 		LOG_DBG("[fetch] lvl:%d off:%d num:%d", lvl, offsets[lvl], block);
 	}
-	return fetch_level_blocks(inode, offsets, lvl + 1, max_lvl, try_current);
+	return fetch_level_blocks(inode, offsets, lvl + 1, max_lvl, try_current, ra);
+}
+
+/* Drop fetched blocks below the given level, they don't belong to the path anymore. */
+static void drop_deeper_blocks(struct ext2_inode *inode, int lvl)
+{
+	for (int i = lvl + 1; i < MAX_OFFSETS_SIZE; ++i) {
+		ext2_drop_block(inode->blocks[i]);
+		inode->blocks[i] = NULL;
+	}
 }
 
 int ext2_fetch_inode_block(struct ext2_inode *inode, uint32_t block)
@@ -456,19 +499,26 @@ int ext2_fetch_inode_block(struct ext2_inode *inode, uint32_t block)
 	struct ext2_data *fs = inode->i_fs;
 	int max_lvl, ret;
 	uint32_t offsets[MAX_OFFSETS_SIZE];
-	bool try_current = inode->flags & INODE_FETCHED_BLOCK;
+	bool try_current = inode->flags & (INODE_FETCHED_BLOCK | INODE_FETCHED_PATH);
 
 	max_lvl = get_level_offsets(fs, block, offsets);
+	if (max_lvl < 0) {
+		return max_lvl;
+	}
 
-	ret = fetch_level_blocks(inode, offsets, 0, max_lvl, try_current);
+	ret = fetch_level_blocks(inode, offsets, 0, max_lvl, try_current,
+			CONFIG_EXT2_READ_AHEAD_BLOCKS);
 	if (ret < 0) {
 		ext2_inode_drop_blocks(inode);
 		return ret;
 	}
 
+	drop_deeper_blocks(inode, max_lvl);
+
 	memcpy(inode->offsets, offsets, MAX_OFFSETS_SIZE * sizeof(uint32_t));
 	inode->block_lvl = max_lvl;
 	inode->block_num = block;
+	inode->flags &= ~INODE_FETCHED_PATH;
 	inode->flags |= INODE_FETCHED_BLOCK;
 
 	LOG_DBG("[ino:%d fetch]\t Lvl:%d {%d, %d, %d, %d}", inode->i_id, inode->block_lvl,
@@ -476,6 +526,39 @@ int ext2_fetch_inode_block(struct ext2_inode *inode, uint32_t block)
 	return 0;
 }
 
+int64_t ext2_inode_map_block(struct ext2_inode *inode, uint32_t block)
+{
+	struct ext2_data *fs = inode->i_fs;
+	int max_lvl, ret;
+	uint32_t offsets[MAX_OFFSETS_SIZE];
+	bool try_current = inode->flags & (INODE_FETCHED_BLOCK | INODE_FETCHED_PATH);
+
+	max_lvl = get_level_offsets(fs, block, offsets);
+	if (max_lvl < 0) {
+		return max_lvl;
+	}
+
+	if (max_lvl == 0) {
+		return inode->i_block[offsets[0]];
+	}
+
+	/* Fetch only the blocks with lists of block numbers, the pointer is in the last one. */
+	ret = fetch_level_blocks(inode, offsets, 0, max_lvl - 1, try_current, 0);
+	if (ret < 0) {
+		ext2_inode_drop_blocks(inode);
+		return ret;
+	}
+	drop_deeper_blocks(inode, max_lvl - 1);
+
+	memcpy(inode->offsets, offsets, MAX_OFFSETS_SIZE * sizeof(uint32_t));
+	inode->block_lvl = max_lvl;
+	inode->block_num = block;
+	inode->flags &= ~INODE_FETCHED_BLOCK;
+	inode->flags |= INODE_FETCHED_PATH;
+
+	return sys_le32_to_cpu(((uint32_t *)inode->blocks[max_lvl - 1]->data)[offsets[max_lvl]]);
+}
+
 static bool all_zero(const uint32_t *offsets, int lvl)
 {
 	for (int i = 0; i < lvl; ++i) {
@@ -707,6 +790,61 @@ int64_t ext2_inode_remove_blocks(struct ext2_inode *inode, uint32_t first)
 	}
 	return removed;
 }
+/*
+ * Allocate a block for the inode, preferably right after the previously allocated one. Regular
+ * files reserve a window of following blocks taken by the next allocations, so that the blocks
+ * of a file growing along with other files stay consecutive on disk.
+ */
+static int assign_inode_block_num(struct ext2_inode *inode, struct ext2_block *b)
+{
+	int64_t new_block;
+	uint32_t count = 1;
+
+	if (b->flags & EXT2_BLOCK_ASSIGNED) {
+		return -EINVAL;
+	}
+
+	if (inode->i_prealloc_count > 0) {
+		new_block = inode->i_prealloc_block;
+		inode->i_prealloc_block++;
+		inode->i_prealloc_count--;
+	} else {
+		if (IS_REG_FILE(inode->i_mode) && CONFIG_EXT2_PREALLOC_BLOCKS > 1) {
+			count = CONFIG_EXT2_PREALLOC_BLOCKS;
+		}
+
+		new_block = ext2_alloc_blocks(inode->i_fs, inode->i_goal, &count);
+		if (new_block < 0) {
+			return new_block;
+		}
+
+		inode->i_prealloc_block = new_block + 1;
+		inode->i_prealloc_count = count - 1;
+	}
+
+	inode->i_goal = new_block + 1;
+	b->num = new_block;
+	b->flags |= EXT2_BLOCK_ASSIGNED;
+	return 0;
+}
+
+int ext2_inode_release_prealloc(struct ext2_inode *inode)
+{
+	int rc;
+
+	if (inode->i_prealloc_count == 0) {
+		return 0;
+	}
+
+	rc = ext2_free_blocks(inode->i_fs, inode->i_prealloc_block, inode->i_prealloc_count);
+	if (rc < 0) {
+		return rc;
+	}
+
+	inode->i_prealloc_count = 0;
+	return 0;
+}
+
 static int alloc_level_blocks(struct ext2_inode *inode)
 {
 	int ret = 0;
@@ -723,7 +861,7 @@ static int alloc_level_blocks(struct ext2_inode *inode)
 		}
 
 		if (*block == 0) {
-			ret = ext2_assign_block_num(fs, inode->blocks[lvl]);
+			ret = assign_inode_block_num(inode, inode->blocks[lvl]);
 			if (ret < 0) {
 				return ret;
 			}
@@ -760,6 +898,12 @@ int ext2_commit_superblock(struct ext2_data *fs)
 	struct ext2_block *b;
 	uint32_t sblock_offset;
 
+	/* Free blocks count must not be written before the bitmap it describes. */
+	ret = write_deferred_bbitmap(fs);
+	if (ret < 0) {
+		return ret;
+	}
+
 	if (fs->block_size == 1024) {
 		sblock_offset = 0;
 		b = ext2_get_block(fs, 1);
@@ -794,6 +938,11 @@ int ext2_commit_bg(struct ext2_data *fs)
 	uint32_t offset = bg->num % groups_per_block;
 	uint32_t global_block = fs->sblock.s_first_data_block + 1 + block;
 
+	ret = write_deferred_bbitmap(fs);
+	if (ret < 0) {
+		return ret;
+	}
+
 	struct ext2_block *b = ext2_get_block(fs, global_block);
 
 	if (b == NULL) {
@@ -863,20 +1012,117 @@ int ext2_clear_inode(struct ext2_data *fs, uint32_t ino)
 	return ret;
 }
 
-int64_t ext2_alloc_block(struct ext2_data *fs)
+/* Write the block bitmap changed by allocations whose commit was deferred */
+static int write_deferred_bbitmap(struct ext2_data *fs)
+{
+	int rc;
+
+	if (!(fs->flags & EXT2_DATA_FLAGS_ALLOC_DIRTY)) {
+		return 0;
+	}
+
+	rc = ext2_write_block(fs, fs->bgroup.block_bitmap);
+	if (rc < 0) {
+		LOG_DBG("block bitmap write returned: %d", rc);
+		return -EIO;
+	}
+	fs->flags &= ~EXT2_DATA_FLAGS_ALLOC_DIRTY;
+	return 0;
+}
+
+/* Write superblock, block group and block bitmap after blocks were allocated or freed */
+static int commit_block_alloc(struct ext2_data *fs)
+{
+	int rc;
+
+	if (IS_ENABLED(CONFIG_EXT2_DEFERRED_ALLOC_COMMIT)) {
+		fs->flags |= EXT2_DATA_FLAGS_ALLOC_DIRTY;
+		return 0;
+	}
+
+	rc = ext2_commit_superblock(fs);
+	if (rc < 0) {
+		LOG_DBG("super block write returned: %d", rc);
+		return -EIO;
+	}
+	rc = ext2_commit_bg(fs);
+	if (rc < 0) {
+		LOG_DBG("block group write returned: %d", rc);
+		return -EIO;
+	}
+	rc = ext2_write_block(fs, fs->bgroup.block_bitmap);
+	if (rc < 0) {
+		LOG_DBG("block bitmap write returned: %d", rc);
+		return -EIO;
+	}
+	return 0;
+}
+
+int ext2_sync_block_alloc(struct ext2_data *fs)
+{
+	int rc;
+
+	if (!(fs->flags & EXT2_DATA_FLAGS_ALLOC_DIRTY)) {
+		return 0;
+	}
+
+	/* Superblock commit writes the block bitmap first. */
+	rc = ext2_commit_superblock(fs);
+	if (rc < 0) {
+		LOG_DBG("super block write returned: %d", rc);
+		return -EIO;
+	}
+	rc = ext2_commit_bg(fs);
+	if (rc < 0) {
+		LOG_DBG("block group write returned: %d", rc);
+		return -EIO;
+	}
+	return 0;
+}
+
+/* Find a free block in the fetched block group, at or after the goal slot if there is one. */
+static int32_t find_free_slot(struct ext2_data *fs, int64_t goal_slot)
+{
+	int32_t slot = -ENOSPC;
+
+	if (goal_slot >= 0) {
+		slot = ext2_bitmap_find_free_from(BGROUP_BLOCK_BITMAP(&fs->bgroup), goal_slot,
+				fs->block_size);
+	}
+	if (slot < 0) {
+		slot = ext2_bitmap_find_free(BGROUP_BLOCK_BITMAP(&fs->bgroup), fs->block_size);
+	}
+	return slot;
+}
+
+int64_t ext2_alloc_blocks(struct ext2_data *fs, uint32_t goal, uint32_t *count)
 {
 	int rc, bitmap_slot;
-	uint32_t group = 0, set;
+	uint32_t group = 0, set, allocated;
+	int64_t goal_slot = -1;
 	int32_t total;
 
+	if ((goal > fs->sblock.s_first_data_block) && (goal < fs->sblock.s_blocks_count)) {
+		group = (goal - fs->sblock.s_first_data_block) / fs->sblock.s_blocks_per_group;
+		goal_slot = (goal - fs->sblock.s_first_data_block) % fs->sblock.s_blocks_per_group;
+	}
+
 	rc = ext2_fetch_block_group(fs, group);
 	if (rc < 0) {
 		return rc;
 	}
 
+	if (fs->bgroup.bg_free_blocks_count == 0 && group != 0) {
+		/* Goal group is full, search from the first one */
+		group = 0;
+		goal_slot = -1;
+		rc = ext2_fetch_block_group(fs, group);
+	}
+
 	LOG_DBG("Free blocks: %d", fs->bgroup.bg_free_blocks_count);
 	while ((rc >= 0) && (fs->bgroup.bg_free_blocks_count == 0)) {
 		group++;
+		goal_slot = -1;
 		rc = ext2_fetch_block_group(fs, group);
 		if (rc == -ERANGE) {
 			/* reached last group */
@@ -892,7 +1138,7 @@ int64_t ext2_alloc_block(struct ext2_data *fs)
 		return rc;
 	}
 
-	bitmap_slot = ext2_bitmap_find_free(BGROUP_BLOCK_BITMAP(&fs->bgroup), fs->block_size);
+	bitmap_slot = find_free_slot(fs, goal_slot);
 	if (bitmap_slot < 0) {
 		LOG_WRN("Cannot find free block in group %d (rc: %d)", group, bitmap_slot);
 		return bitmap_slot;
@@ -903,13 +1149,24 @@ int64_t ext2_alloc_block(struct ext2_data *fs)
 
 	LOG_DBG("Found free block %d in group %d (total: %d)", bitmap_slot, group, total);
 
-	rc = ext2_bitmap_set(BGROUP_BLOCK_BITMAP(&fs->bgroup), bitmap_slot, fs->block_size);
-	if (rc < 0) {
-		return rc;
-	}
+	/* Take the free blocks following the found one, up to the requested count. */
+	allocated = 0;
+	do {
+		rc = ext2_bitmap_set(BGROUP_BLOCK_BITMAP(&fs->bgroup), bitmap_slot + allocated,
+				fs->block_size);
+		if (rc < 0) {
+			return rc;
+		}
+		allocated++;
+	} while ((allocated < *count) && (allocated < fs->bgroup.bg_free_blocks_count) &&
+		 (bitmap_slot + allocated < fs->sblock.s_blocks_per_group) &&
+		 (ext2_bitmap_find_free_from(BGROUP_BLOCK_BITMAP(&fs->bgroup),
+					     bitmap_slot + allocated, fs->block_size) ==
+		  bitmap_slot + allocated));
 
-	fs->bgroup.bg_free_blocks_count -= 1;
-	fs->sblock.s_free_blocks_count -= 1;
+	*count = allocated;
+	fs->bgroup.bg_free_blocks_count -= allocated;
+	fs->sblock.s_free_blocks_count -= allocated;
 
 	set = ext2_bitmap_count_set(BGROUP_BLOCK_BITMAP(&fs->bgroup), fs->sblock.s_blocks_count);
 
@@ -918,24 +1175,20 @@ int64_t ext2_alloc_block(struct ext2_data *fs)
 		return -EINVAL;
 	}
 
-	rc = ext2_commit_superblock(fs);
-	if (rc < 0) {
-		LOG_DBG("super block write returned: %d", rc);
-		return -EIO;
-	}
-	rc = ext2_commit_bg(fs);
-	if (rc < 0) {
-		LOG_DBG("block group write returned: %d", rc);
-		return -EIO;
-	}
-	rc = ext2_write_block(fs, fs->bgroup.block_bitmap);
+	rc = commit_block_alloc(fs);
 	if (rc < 0) {
-		LOG_DBG("block bitmap write returned: %d", rc);
-		return -EIO;
+		return rc;
 	}
 	return total;
 }
 
+int64_t ext2_alloc_block(struct ext2_data *fs, uint32_t goal)
+{
+	uint32_t count = 1;
+
+	return ext2_alloc_blocks(fs, goal, &count);
+}
+
 static int check_zero_inode(struct ext2_data *fs, uint32_t ino)
 {
 	int32_t itable_offset = get_itable_entry(fs, ino);
@@ -1037,9 +1290,9 @@ int32_t ext2_alloc_inode(struct ext2_data *fs)
 	return global_idx;
 }
 
-int ext2_free_block(struct ext2_data *fs, uint32_t block)
+int ext2_free_blocks(struct ext2_data *fs, uint32_t block, uint32_t count)
 {
-	LOG_DBG("Free block %d", block);
+	LOG_DBG("Free blocks %d (count %d)", block, count);
 
 	/* Block bitmaps tracks blocks starting from s_first_data_block. */
 	block -= fs->sblock.s_first_data_block;
@@ -1049,6 +1302,10 @@ int ext2_free_block(struct ext2_data *fs, uint32_t block)
 	uint32_t off = block % fs->sblock.s_blocks_per_group;
 	uint32_t set;
 
+	if (off + count > fs->sblock.s_blocks_per_group) {
+		return -EINVAL;
+	}
+
 	rc = ext2_fetch_block_group(fs, group);
 	if (rc < 0) {
 		return rc;
@@ -1059,13 +1316,15 @@ int ext2_free_block(struct ext2_data *fs, uint32_t block)
 		return rc;
 	}
 
-	rc = ext2_bitmap_unset(BGROUP_BLOCK_BITMAP(&fs->bgroup), off, fs->block_size);
-	if (rc < 0) {
-		return rc;
+	for (uint32_t i = 0; i < count; i++) {
+		rc = ext2_bitmap_unset(BGROUP_BLOCK_BITMAP(&fs->bgroup), off + i, fs->block_size);
+		if (rc < 0) {
+			return rc;
+		}
 	}
 
-	fs->bgroup.bg_free_blocks_count += 1;
-	fs->sblock.s_free_blocks_count += 1;
+	fs->bgroup.bg_free_blocks_count += count;
+	fs->sblock.s_free_blocks_count += count;
 
 	set = ext2_bitmap_count_set(BGROUP_BLOCK_BITMAP(&fs->bgroup), fs->sblock.s_blocks_count);
 
@@ -1074,22 +1333,12 @@ int ext2_free_block(struct ext2_data *fs, uint32_t block)
 		return -EINVAL;
 	}
 
-	rc = ext2_commit_superblock(fs);
-	if (rc < 0) {
-		LOG_DBG("super block write returned: %d", rc);
-		return -EIO;
-	}
-	rc = ext2_commit_bg(fs);
-	if (rc < 0) {
-		LOG_DBG("block group write returned: %d", rc);
-		return -EIO;
-	}
-	rc = ext2_write_block(fs, fs->bgroup.block_bitmap);
-	if (rc < 0) {
-		LOG_DBG("block bitmap write returned: %d", rc);
-		return -EIO;
-	}
-	return 0;
+	return commit_block_alloc(fs);
+}
+
+int ext2_free_block(struct ext2_data *fs, uint32_t block)
+{
+	return ext2_free_blocks(fs, block, 1);
 }
 
 int ext2_free_inode(struct ext2_data *fs, uint32_t ino, bool directory)
@@ -41,6 +41,31 @@ int ext2_fetch_inode(struct ext2_data *fs, uint32_t ino, struct ext2_inode *inod
  */
 int ext2_fetch_inode_block(struct ext2_inode *inode, uint32_t block);
 
+/**
+ * @brief Get the number of the disk block holding given inode block.
+ *
+ * Only the blocks with lists of block numbers are fetched into the inode structure, they are
+ * kept to map or fetch the next blocks of the inode.
+ *
+ * @param inode Inode structure
+ * @param block Number of inode block (0 - first block in that inode)
+ *
+ * @retval >0 number of the disk block
+ * @retval 0 the block is not allocated
+ * @retval <0 error
+ */
+int64_t ext2_inode_map_block(struct ext2_inode *inode, uint32_t block);
+
+/**
+ * @brief Free the blocks reserved for the next allocations of the inode.
+ *
+ * @param inode Inode structure
+ *
+ * @retval 0 on success
+ * @retval <0 error
+ */
+int ext2_inode_release_prealloc(struct ext2_inode *inode);
+
 /**
  * @brief Fetch block group into buffer in fs structure.
  *
@@ -170,11 +195,39 @@ int ext2_commit_bg(struct ext2_data *fs);
  * block group are updated and block is marked as used in block bitmap.
  *
  * @param fs File system data
+ * @param goal Block to search from, 0 to search from the first block group
  *
  * @retval >0 number of allocated block
  * @retval <0 error
  */
-int64_t ext2_alloc_block(struct ext2_data *fs);
+int64_t ext2_alloc_block(struct ext2_data *fs, uint32_t goal);
+
+/**
+ * @brief Reserve consecutive blocks for future use.
+ *
+ * Like ext2_alloc_block() but also reserves the free blocks following the found one.
+ *
+ * @param fs File system data
+ * @param goal Block to search from, 0 to search from the first block group
+ * @param count Number of blocks to reserve, set to the number of reserved blocks
+ *
+ * @retval >0 number of the first allocated block
+ * @retval <0 error
+ */
+int64_t ext2_alloc_blocks(struct ext2_data *fs, uint32_t goal, uint32_t *count);
+
+/**
+ * @brief Write superblock and block group changed by deferred block allocations.
+ *
+ * With @kconfig{CONFIG_EXT2_DEFERRED_ALLOC_COMMIT} allocating or freeing blocks only
+ * changes them in memory.
+ *
+ * @param fs File system data
+ *
+ * @retval 0 on success
+ * @retval <0 error
+ */
+int ext2_sync_block_alloc(struct ext2_data *fs);
 
 /**
  * @brief Reserve an inode for future use.
@@ -199,6 +252,18 @@ int32_t ext2_alloc_inode(struct ext2_data *fs);
  */
 int ext2_free_block(struct ext2_data *fs, uint32_t block);
 
+/**
+ * @brief Free consecutive blocks of one block group
+ *
+ * @param fs File system data
+ * @param block First block to free
+ * @param count Number of blocks to free
+ *
+ * @retval 0 on success
+ * @retval <0 error
+ */
+int ext2_free_blocks(struct ext2_data *fs, uint32_t block, uint32_t count);
+
 /**
  * @brief Free the inode
  *
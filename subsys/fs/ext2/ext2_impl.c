@@ -30,6 +30,12 @@ struct k_mem_slab ext2_block_memory_slab, ext2_block_struct_slab;
 char __aligned(sizeof(void *)) __ext2_block_memory_buffer[BLOCK_MEMORY_BUFFER_SIZE];
 char __aligned(sizeof(void *)) __ext2_block_struct_buffer[BLOCK_STRUCT_BUFFER_SIZE];
 
+#if CONFIG_EXT2_READ_AHEAD_BLOCKS > 0
+/* Blocks read ahead of the data block fetched by an inode */
+static uint8_t __aligned(sizeof(void *))
+	ext2_ra_buffer[CONFIG_EXT2_READ_AHEAD_BLOCKS * CONFIG_EXT2_MAX_BLOCK_SIZE];
+#endif
+
 /* Initialize heap memory allocator */
 K_HEAP_DEFINE(direntry_heap, MAX_DIRENTRY_SIZE);
 K_MEM_SLAB_DEFINE(inode_struct_slab, sizeof(struct ext2_inode), MAX_INODES, sizeof(void *));
@@ -105,6 +111,66 @@ struct ext2_block *ext2_get_block(struct ext2_data *fs, uint32_t block)
 	return b;
 }
 
+struct ext2_block *ext2_get_block_ra(struct ext2_data *fs, uint32_t block, uint32_t count)
+{
+#if CONFIG_EXT2_READ_AHEAD_BLOCKS > 0
+	int ret;
+	struct ext2_block *b;
+	bool cached = (fs->ra_count > 0) && (block >= fs->ra_block) &&
+		(block - fs->ra_block < fs->ra_count);
+
+	if (!cached && count <= 1) {
+		return ext2_get_block(fs, block);
+	}
+
+	b = get_block_struct();
+	if (!b) {
+		return NULL;
+	}
+	b->num = block;
+	b->flags = EXT2_BLOCK_ASSIGNED;
+
+	if (!cached) {
+		count = MIN(count, CONFIG_EXT2_READ_AHEAD_BLOCKS);
+		ret = fs->backend_ops->read_blocks(fs, ext2_ra_buffer, block, count);
+		if (ret < 0) {
+			LOG_ERR("get block: read ahead error %d", ret);
+			fs->ra_count = 0;
+			ext2_drop_block(b);
+			return NULL;
+		}
+		fs->ra_block = block;
+		fs->ra_count = count;
+	}
+	memcpy(b->data, ext2_ra_buffer + (block - fs->ra_block) * fs->block_size, fs->block_size);
+	return b;
+#else
+	ARG_UNUSED(count);
+
+	return ext2_get_block(fs, block);
+#endif
+}
+
+/* Drop the blocks held in the read-ahead buffer which are overwritten */
+static void ra_invalidate(struct ext2_data *fs, uint32_t block, uint32_t count)
+{
+	if ((fs->ra_count > 0) && (block < fs->ra_block + fs->ra_count) &&
+	    (fs->ra_block < block + count)) {
+		fs->ra_count = 0;
+	}
+}
+
+int ext2_read_blocks(struct ext2_data *fs, void *buf, uint32_t block, uint32_t count)
+{
+	return fs->backend_ops->read_blocks(fs, buf, block, count);
+}
+
+int ext2_write_blocks(struct ext2_data *fs, const void *buf, uint32_t block, uint32_t count)
+{
+	ra_invalidate(fs, block, count);
+	return fs->backend_ops->write_blocks(fs, buf, block, count);
+}
+
 struct ext2_block *ext2_get_empty_block(struct ext2_data *fs)
 {
 	struct ext2_block *b = get_block_struct();
@@ -126,6 +192,7 @@ int ext2_write_block(struct ext2_data *fs, struct ext2_block *b)
 		return -EINVAL;
 	}
 
+	ra_invalidate(fs, b->num, 1);
 	ret = fs->backend_ops->write_block(fs, b->data, b->num);
 	if (ret < 0) {
 		return ret;
@@ -168,7 +235,7 @@ int ext2_assign_block_num(struct ext2_data *fs, struct ext2_block *b)
 	}
 
 	/* Allocate block in the file system. */
-	new_block = ext2_alloc_block(fs);
+	new_block = ext2_alloc_block(fs, 0);
 	if (new_block < 0) {
 		return new_block;
 	}
@@ -363,6 +430,13 @@ int ext2_close_fs(struct ext2_data *fs)
 {
 	int ret = 0;
 
+	/* Free preallocated blocks also for inodes still referenced */
+	for (int32_t i = 0; i < fs->open_inodes; ++i) {
+		if (fs->inode_pool[i] != NULL) {
+			ext2_inode_release_prealloc(fs->inode_pool[i]);
+		}
+	}
+
 	/* Close all open inodes */
 	for (int32_t i = 0; i < fs->open_inodes; ++i) {
 		if (fs->inode_pool[i] != NULL) {
@@ -370,6 +444,11 @@ int ext2_close_fs(struct ext2_data *fs)
 		}
 	}
 
+	ret = ext2_sync_block_alloc(fs);
+	if (ret < 0) {
+		return ret;
+	}
+
 	/* To save file system as correct it must be writable and without errors */
 	if (!(fs->flags & (EXT2_DATA_FLAGS_RO | EXT2_DATA_FLAGS_ERR))) {
 		fs->sblock.s_state = EXT2_VALID_FS;
@@ -606,16 +685,77 @@ success:
 
 /* Inode operations --------------------------------------------------------- */
 
+/*
+ * Get the disk block of the first inode block and the number of following inode blocks
+ * (at most count) which are consecutive on disk.
+ *
+ * @retval >0 number of consecutive blocks
+ * @retval 0 first block is not allocated
+ * @retval <0 error
+ */
+static int64_t map_consecutive(struct ext2_inode *inode, uint32_t block, uint32_t count,
+		uint32_t *disk_block)
+{
+	int64_t first, next;
+	uint32_t n = 1;
+
+	first = ext2_inode_map_block(inode, block);
+	if (first <= 0) {
+		return first;
+	}
+
+	while (n < count) {
+		next = ext2_inode_map_block(inode, block + n);
+		if (next < 0) {
+			return next;
+		}
+		if (next != first + n) {
+			break;
+		}
+		n++;
+	}
+
+	*disk_block = (uint32_t)first;
+	return n;
+}
+
 ssize_t ext2_inode_read(struct ext2_inode *inode, void *buf, uint32_t offset, size_t nbytes)
 {
 	int rc = 0;
+	int64_t count;
 	ssize_t read = 0;
 	uint32_t block_size = inode->i_fs->block_size;
+	uint32_t disk_block;
 
 	while (read < nbytes && offset < inode->i_size) {
 
 		uint32_t block = offset / block_size;
 		uint32_t block_off = offset % block_size;
+		uint32_t left_in_file = inode->i_size - offset;
+		size_t left = nbytes - read;
+
+		if (block_off == 0 && MIN(left, left_in_file) >= 2 * block_size) {
+			/* Read whole blocks consecutive on disk directly into the buffer, single
+			 * blocks are fetched to use the read-ahead.
+			 */
+			count = map_consecutive(inode, block, MIN(left, left_in_file) / block_size,
+					&disk_block);
+			if (count < 0) {
+				rc = count;
+				break;
+			}
+			if (count > 0) {
+				rc = ext2_read_blocks(inode->i_fs, (uint8_t *)buf + read, disk_block,
+						count);
+				if (rc < 0) {
+					break;
+				}
+				read += count * block_size;
+				offset += count * block_size;
+				continue;
+			}
+			/* Not allocated block is read through the fetched (zeroed) block. */
+		}
 
 		rc = ext2_fetch_inode_block(inode, block);
 		if (rc < 0) {
@@ -623,8 +763,7 @@ ssize_t ext2_inode_read(struct ext2_inode *inode, void *buf, uint32_t offset, si
 		}
 
 		uint32_t left_on_blk = block_size - block_off;
-		uint32_t left_in_file = inode->i_size - offset;
-		size_t to_read = MIN(nbytes, MIN(left_on_blk, left_in_file));
+		size_t to_read = MIN(left, MIN(left_on_blk, left_in_file));
 
 		memcpy((uint8_t *)buf + read, inode_current_block_mem(inode) + block_off, to_read);
 
@@ -641,22 +780,46 @@ ssize_t ext2_inode_read(struct ext2_inode *inode, void *buf, uint32_t offset, si
 ssize_t ext2_inode_write(struct ext2_inode *inode, const void *buf, uint32_t offset, size_t nbytes)
 {
 	int rc = 0;
+	int64_t count;
 	ssize_t written = 0;
 	uint32_t block_size = inode->i_fs->block_size;
+	uint32_t start = offset;
+	uint32_t disk_block;
 
 	while (written < nbytes) {
 		uint32_t block = offset / block_size;
 		uint32_t block_off = offset % block_size;
+		size_t left = nbytes - written;
 
 		LOG_DBG("inode:%d Write to block %d (offset: %d-%zd/%d)",
-				inode->i_id, block, offset, offset + nbytes, inode->i_size);
+				inode->i_id, block, offset, start + nbytes, inode->i_size);
+
+		if (block_off == 0 && left >= block_size) {
+			/* Overwrite allocated whole blocks consecutive on disk directly. */
+			count = map_consecutive(inode, block, left / block_size, &disk_block);
+			if (count < 0) {
+				rc = count;
+				break;
+			}
+			if (count > 0) {
+				rc = ext2_write_blocks(inode->i_fs, (const uint8_t *)buf + written,
+						disk_block, count);
+				if (rc < 0) {
+					break;
+				}
+				written += count * block_size;
+				offset += count * block_size;
+				continue;
+			}
+			/* Not allocated block is allocated when the fetched block is committed. */
+		}
 
 		rc = ext2_fetch_inode_block(inode, block);
 		if (rc < 0) {
 			break;
 		}
 
-		size_t to_write = MIN(nbytes, block_size - block_off);
+		size_t to_write = MIN(left, block_size - block_off);
 
 		memcpy(inode_current_block_mem(inode) + block_off, (uint8_t *)buf + written,
 				to_write);
@@ -668,15 +831,16 @@ ssize_t ext2_inode_write(struct ext2_inode *inode, const void *buf, uint32_t off
 		}
 
 		written += to_write;
+		offset += to_write;
 	}
 
 	if (rc < 0) {
 		return rc;
 	}
 
-	if (offset + written > inode->i_size) {
-		LOG_DBG("New inode size: %d -> %zd", inode->i_size, offset + written);
-		inode->i_size = offset + written;
+	if (start + written > inode->i_size) {
+		LOG_DBG("New inode size: %d -> %zd", inode->i_size, start + written);
+		inode->i_size = start + written;
 		rc = ext2_commit_inode(inode);
 		if (rc < 0) {
 			return rc;
@@ -741,6 +905,13 @@ int ext2_inode_trunc(struct ext2_inode *inode, off_t length)
 
 		LOG_DBG("Inode trunc from blk: %d", start_blk);
 
+		/* Fetched blocks may be removed, and preallocated ones are past the new end. */
+		ext2_inode_drop_blocks(inode);
+		rc = ext2_inode_release_prealloc(inode);
+		if (rc < 0) {
+			return rc;
+		}
+
 		/* Remove blocks starting with start_blk. */
 		removed_blocks = ext2_inode_remove_blocks(inode, start_blk);
 		if (removed_blocks < 0) {
@@ -793,7 +964,12 @@ int ext2_inode_sync(struct ext2_inode *inode)
 			return ret;
 		}
 	}
-	return 0;
+
+	ret = ext2_sync_block_alloc(fs);
+	if (ret < 0) {
+		return ret;
+	}
+	return fs->backend_ops->sync(fs);
 }
 
 int ext2_get_direntry(struct ext2_file *dir, struct fs_dirent *ent)
@@ -1512,12 +1688,17 @@ int ext2_inode_drop(struct ext2_inode *inode)
 
 		ext2_inode_drop_blocks(inode);
 
+		int rc = ext2_inode_release_prealloc(inode);
+
+		if (rc < 0) {
+			return rc;
+		}
+
 		if (inode->flags & INODE_REMOVE) {
 			/* This is the inode that should be removed because
 			 * there was called unlink function on it.
 			 */
-			int rc = remove_inode(inode);
-
+			rc = remove_inode(inode);
 			if (rc < 0) {
 				return rc;
 			}
@@ -1540,6 +1721,7 @@ void ext2_inode_drop_blocks(struct ext2_inode *inode)
 {
 	for (int i = 0; i < 4; ++i) {
 		ext2_drop_block(inode->blocks[i]);
+		inode->blocks[i] = NULL;
 	}
-	inode->flags &= ~INODE_FETCHED_BLOCK;
+	inode->flags &= ~(INODE_FETCHED_BLOCK | INODE_FETCHED_PATH);
 }
@@ -28,8 +28,26 @@ int ext2_init_disk_access_backend(struct ext2_data *fs, const void *storage_dev,
  */
 struct ext2_block *ext2_get_block(struct ext2_data *fs, uint32_t block);
 
+/**
+ * @brief Get block from the disk, reading the following blocks ahead.
+ *
+ * The block and up to count - 1 following blocks are read at once into the read-ahead
+ * buffer, from which the next calls get them without accessing the disk.
+ */
+struct ext2_block *ext2_get_block_ra(struct ext2_data *fs, uint32_t block, uint32_t count);
+
 struct ext2_block *ext2_get_empty_block(struct ext2_data *fs);
 
+/**
+ * @brief Read consecutive blocks from the disk into a buffer.
+ */
+int ext2_read_blocks(struct ext2_data *fs, void *buf, uint32_t block, uint32_t count);
+
+/**
+ * @brief Write consecutive blocks from a buffer to the disk.
+ */
+int ext2_write_blocks(struct ext2_data *fs, const void *buf, uint32_t block, uint32_t count);
+
 /**
  * @brief Free the block structure.
  */
@@ -163,6 +163,8 @@ struct ext2_bgroup {
 /* Flags for inode */
 #define INODE_FETCHED_BLOCK BIT(0)
 #define INODE_REMOVE BIT(1)
+/* Only the indirect blocks leading to block_num are fetched */
+#define INODE_FETCHED_PATH BIT(2)
 
 struct ext2_inode {
 	struct ext2_data *i_fs;      /* pointer to file system data */
@@ -180,6 +182,10 @@ struct ext2_inode {
 	uint32_t block_num;        /* relative number of fetched block */
 	uint32_t offsets[4];       /* offsets describing path to fetched block */
 	struct ext2_block *blocks[4];   /* fetched blocks for each level */
+
+	uint32_t i_goal;           /* block to try first at next allocation */
+	uint32_t i_prealloc_block; /* first block preallocated for this inode */
+	uint32_t i_prealloc_count; /* number of blocks preallocated for this inode */
 };
 
 static inline struct ext2_block *inode_current_block(struct ext2_inode *inode)
@@ -212,6 +218,8 @@ struct ext2_file {
 
 #define EXT2_DATA_FLAGS_RO  BIT(0)
 #define EXT2_DATA_FLAGS_ERR BIT(1)
+/* Block bitmap, block group and superblock changed by block allocations not written yet */
+#define EXT2_DATA_FLAGS_ALLOC_DIRTY BIT(2)
 
 struct ext2_data;
 
@@ -220,6 +228,8 @@ struct ext2_backend_ops {
 	int64_t (*get_write_size)(struct ext2_data *fs);
 	int (*read_block)(struct ext2_data *fs, void *buf, uint32_t num);
 	int (*write_block)(struct ext2_data *fs, const void *buf, uint32_t num);
+	int (*read_blocks)(struct ext2_data *fs, void *buf, uint32_t num, uint32_t count);
+	int (*write_blocks)(struct ext2_data *fs, const void *buf, uint32_t num, uint32_t count);
 	int (*read_superblock)(struct ext2_data *fs, struct ext2_disk_superblock *sb);
 	int (*sync)(struct ext2_data *fs);
 };
@@ -243,6 +253,9 @@ struct ext2_data {
 	void *backend; /* pointer to implementation specific resource */
 	const struct ext2_backend_ops *backend_ops;
 	uint8_t flags;
+
+	uint32_t ra_block; /* first block held in the read-ahead buffer */
+	uint32_t ra_count; /* number of blocks held in the read-ahead buffer */
 };
 
 #endif /* __EXT2_STRUCT_H__ */
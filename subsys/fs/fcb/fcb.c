@@ -82,6 +82,8 @@ fcb_erase_sector(const struct fcb *fcb, const struct flash_sector *sector)
 		return -EIO;
 	}
 
+	fcb_summary_invalidate(fcb, sector);
+
 	rc = flash_area_erase(fcb->fap, sector->fs_off, sector->fs_size);
 
 	if (rc != 0) {
@@ -98,6 +100,7 @@ fcb_init(int f_area_id, struct fcb *fcb)
 	int rc;
 	int i;
 	uint8_t align;
+	uint32_t off;
 	int oldest = -1, newest = -1;
 	struct flash_sector *oldest_sector = NULL, *newest_sector = NULL;
 	struct fcb_disk_area fda;
@@ -159,9 +162,14 @@ fcb_init(int f_area_id, struct fcb *fcb)
 	fcb->f_active.fe_sector = newest_sector;
 	fcb->f_active.fe_elem_off = fcb_len_in_flash(fcb, sizeof(struct fcb_disk_area));
 	fcb->f_active_id = newest;
+	fcb_summary_invalidate_all(fcb);
 
+	/*
+	 * Find the end of the active sector from the element lengths only:
+	 * elements which fail the check are skipped over in the same way.
+	 */
 	while (1) {
-		rc = fcb_getnext_in_sector(fcb, &fcb->f_active);
+		rc = fcb_elem_hdr(fcb, &fcb->f_active);
 		if (rc == -ENOTSUP) {
 			rc = 0;
 			break;
@@ -169,6 +177,13 @@ fcb_init(int f_area_id, struct fcb *fcb)
 		if (rc != 0) {
 			break;
 		}
+		off = fcb->f_active.fe_data_off +
+		      fcb_len_in_flash(fcb, fcb->f_active.fe_data_len);
+		if (off + FCB_CRC_SZ > fcb->f_active.fe_sector->fs_size) {
+			rc = -EIO;
+			break;
+		}
+		fcb->f_active.fe_elem_off = off + fcb_len_in_flash(fcb, FCB_CRC_SZ);
 	}
 	k_mutex_init(&fcb->f_mtx);
 	return rc;
@@ -266,6 +281,9 @@ fcb_sector_hdr_init(struct fcb *fcb, struct flash_sector *sector, uint16_t id)
 	fda._pad = fcb->f_erase_value;
 	fda.fd_id = id;
 
+	/* The sector may have been summarized while erased */
+	fcb_summary_invalidate(fcb, sector);
+
 	rc = fcb_flash_write(fcb, sector, 0, &fda, sizeof(fda));
 	if (rc != 0) {
 		return -EIO;
@@ -321,6 +339,13 @@ fcb_offset_last_n(struct fcb *fcb, uint8_t entries,
 		entries = 1U;
 	}
 
+#ifdef CONFIG_FCB_SECTOR_SUMMARY
+	rc = fcb_summary_offset_last_n(fcb, entries, last_n_entry);
+	if (rc != -EAGAIN) {
+		return rc;
+	}
+#endif
+
 	i = 0;
 	(void)memset(&loc, 0, sizeof(loc));
 	while (!fcb_getnext(fcb, &loc)) {
@@ -136,5 +136,16 @@ fcb_append_finish(struct fcb *fcb, struct fcb_entry *loc)
 	if (rc) {
 		return -EIO;
 	}
+
+#ifdef CONFIG_FCB_SECTOR_SUMMARY
+	/*
+	 * Appends may have moved to the next sector since this element was
+	 * started, and its sector summarized without it.
+	 */
+	if (k_mutex_lock(&fcb->f_mtx, K_FOREVER) == 0) {
+		fcb_summary_invalidate(fcb, loc->fe_sector);
+		k_mutex_unlock(&fcb->f_mtx);
+	}
+#endif
 	return 0;
 }
@@ -66,12 +66,12 @@ fcb_elem_crc8(struct fcb *_fcb, struct fcb_entry *loc, uint8_t *c8p)
 	return 0;
 }
 
-#if IS_ENABLED(CONFIG_FCB_ALLOW_FIXED_ENDMARKER)
-/* Given the offset in flash sector, calculate the FCB entry data offset and size, and set
- * the fixed endmarker.
+/*
+ * Given offset in flash sector, fill in rest of the fcb_entry from the element
+ * length, without reading the data nor checking the endmarker.
  */
-static int
-fcb_elem_endmarker_fixed(struct fcb *_fcb, struct fcb_entry *loc, uint8_t *em)
+int
+fcb_elem_hdr(struct fcb *_fcb, struct fcb_entry *loc)
 {
 	uint8_t tmp_str[2];
 	int cnt;
@@ -94,6 +94,23 @@ fcb_elem_endmarker_fixed(struct fcb *_fcb, struct fcb_entry *loc, uint8_t *em)
 	loc->fe_data_off = loc->fe_elem_off + fcb_len_in_flash(_fcb, cnt);
 	loc->fe_data_len = len;
 
+	return 0;
+}
+
+#if IS_ENABLED(CONFIG_FCB_ALLOW_FIXED_ENDMARKER)
+/* Given the offset in flash sector, calculate the FCB entry data offset and size, and set
+ * the fixed endmarker.
+ */
+static int
+fcb_elem_endmarker_fixed(struct fcb *_fcb, struct fcb_entry *loc, uint8_t *em)
+{
+	int rc;
+
+	rc = fcb_elem_hdr(_fcb, loc);
+	if (rc) {
+		return rc;
+	}
+
 	*em = FCB_FIXED_ENDMARKER;
 	return 0;
 }
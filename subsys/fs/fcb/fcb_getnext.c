@@ -10,18 +10,41 @@
 #include <zephyr/fs/fcb.h>
 #include "fcb_priv.h"
 
+/*
+ * Like fcb_elem_info(), but uses the sector summary when there is one: the
+ * end of the sector is known and, if all its elements are valid, only their
+ * length is read.
+ */
+static int
+fcb_elem_info_summ(struct fcb *fcb, struct fcb_entry *loc)
+{
+	const struct fcb_sector_summary *fss;
+
+	fss = fcb_summary_get(fcb, loc->fe_sector);
+	if (fss != NULL) {
+		if (loc->fe_elem_off >= fss->fss_end) {
+			return -ENOTSUP;
+		}
+		if (fss->fss_clean) {
+			return fcb_elem_hdr(fcb, loc);
+		}
+	}
+
+	return fcb_elem_info(fcb, loc);
+}
+
 int
 fcb_getnext_in_sector(struct fcb *fcb, struct fcb_entry *loc)
 {
 	int rc;
 
-	rc = fcb_elem_info(fcb, loc);
+	rc = fcb_elem_info_summ(fcb, loc);
 	if (rc == 0 || rc == -EBADMSG) {
 		do {
 			loc->fe_elem_off = loc->fe_data_off +
 			  fcb_len_in_flash(fcb, loc->fe_data_len) +
 			  fcb_len_in_flash(fcb, FCB_CRC_SZ);
-			rc = fcb_elem_info(fcb, loc);
+			rc = fcb_elem_info_summ(fcb, loc);
 			if (rc != -EBADMSG) {
 				break;
 			}
@@ -56,7 +79,7 @@ fcb_getnext_nolock(struct fcb *fcb, struct fcb_entry *loc)
 		 * If offset is zero, we serve the first entry from the sector.
 		 */
 		loc->fe_elem_off = fcb_len_in_flash(fcb, sizeof(struct fcb_disk_area));
-		rc = fcb_elem_info(fcb, loc);
+		rc = fcb_elem_info_summ(fcb, loc);
 		switch (rc) {
 		case 0:
 			return 0;
@@ -90,7 +113,7 @@ next_sector:
 			}
 			loc->fe_sector = fcb_getnext_sector(fcb, loc->fe_sector);
 			loc->fe_elem_off = fcb_len_in_flash(fcb, sizeof(struct fcb_disk_area));
-			rc = fcb_elem_info(fcb, loc);
+			rc = fcb_elem_info_summ(fcb, loc);
 			switch (rc) {
 			case 0:
 				return 0;
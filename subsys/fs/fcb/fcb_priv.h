@@ -70,12 +70,40 @@ struct flash_sector *fcb_getnext_sector(struct fcb *fcb,
 int fcb_getnext_nolock(struct fcb *fcb, struct fcb_entry *loc);
 
 int fcb_elem_info(struct fcb *fcb, struct fcb_entry *loc);
+int fcb_elem_hdr(struct fcb *fcb, struct fcb_entry *loc);
 int fcb_elem_endmarker(struct fcb *fcb, struct fcb_entry *loc, uint8_t *crc8p);
 
 int fcb_sector_hdr_init(struct fcb *fcb, struct flash_sector *sector, uint16_t id);
 int fcb_sector_hdr_read(struct fcb *fcb, struct flash_sector *sector,
 			struct fcb_disk_area *fdap);
 
+#ifdef CONFIG_FCB_SECTOR_SUMMARY
+int fcb_sector_scan(struct fcb *fcb, struct flash_sector *sector,
+		    struct fcb_sector_summary *fss);
+const struct fcb_sector_summary *fcb_summary_get(struct fcb *fcb,
+						 struct flash_sector *sector);
+void fcb_summary_invalidate(const struct fcb *fcb,
+			    const struct flash_sector *sector);
+void fcb_summary_invalidate_all(struct fcb *fcb);
+int fcb_summary_offset_last_n(struct fcb *fcb, uint8_t entries,
+			      struct fcb_entry *last_n_entry);
+#else
+static inline const struct fcb_sector_summary *
+fcb_summary_get(struct fcb *fcb, struct flash_sector *sector)
+{
+	return NULL;
+}
+
+static inline void fcb_summary_invalidate(const struct fcb *fcb,
+					  const struct flash_sector *sector)
+{
+}
+
+static inline void fcb_summary_invalidate_all(struct fcb *fcb)
+{
+}
+#endif /* CONFIG_FCB_SECTOR_SUMMARY */
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,199 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include <zephyr/fs/fcb.h>
+#include "fcb_priv.h"
+
+/*
+ * Summaries are kept in RAM only, for the sectors which are not the active
+ * one: their content only changes when they are erased.
+ */
+
+/*
+ * Count the valid elements of a sector and find its end, checking all the
+ * elements.
+ */
+int
+fcb_sector_scan(struct fcb *fcb, struct flash_sector *sector,
+		struct fcb_sector_summary *fss)
+{
+	struct fcb_entry loc;
+	int rc;
+
+	loc.fe_sector = sector;
+	loc.fe_elem_off = fcb_len_in_flash(fcb, sizeof(struct fcb_disk_area));
+	fss->fss_cnt = 0U;
+	fss->fss_clean = true;
+
+	while (1) {
+		rc = fcb_elem_info(fcb, &loc);
+		if (rc == -ENOTSUP) {
+			break;
+		}
+		if (rc == 0) {
+			fss->fss_cnt++;
+		} else if (rc == -EBADMSG) {
+			fss->fss_clean = false;
+		} else {
+			return rc;
+		}
+		loc.fe_elem_off = loc.fe_data_off +
+		  fcb_len_in_flash(fcb, loc.fe_data_len) +
+		  fcb_len_in_flash(fcb, FCB_CRC_SZ);
+	}
+	fss->fss_end = loc.fe_elem_off;
+
+	return 0;
+}
+
+/*
+ * Get the summary of a sector, building it if it is not known yet. Returns
+ * NULL for the active sector, when summaries are not kept or if the sector
+ * could not be read.
+ */
+const struct fcb_sector_summary *
+fcb_summary_get(struct fcb *fcb, struct flash_sector *sector)
+{
+	struct fcb_sector_summary *fss;
+
+	if (fcb->f_summaries == NULL || sector == fcb->f_active.fe_sector) {
+		return NULL;
+	}
+
+	fss = &fcb->f_summaries[sector - fcb->f_sectors];
+	if (fss->fss_end == 0U) {
+		if (fcb_sector_scan(fcb, sector, fss) != 0) {
+			return NULL;
+		}
+	}
+
+	return fss;
+}
+
+void
+fcb_summary_invalidate(const struct fcb *fcb, const struct flash_sector *sector)
+{
+	if (fcb->f_summaries != NULL) {
+		fcb->f_summaries[sector - fcb->f_sectors].fss_end = 0U;
+	}
+}
+
+void
+fcb_summary_invalidate_all(struct fcb *fcb)
+{
+	if (fcb->f_summaries != NULL) {
+		memset(fcb->f_summaries, 0,
+		       fcb->f_sector_cnt * sizeof(*fcb->f_summaries));
+	}
+}
+
+/*
+ * Get the number of valid elements of a sector, scanning the active one.
+ */
+static int
+fcb_summary_cnt(struct fcb *fcb, struct flash_sector *sector, uint32_t *cnt)
+{
+	const struct fcb_sector_summary *fss;
+	struct fcb_sector_summary active;
+	int rc;
+
+	if (sector == fcb->f_active.fe_sector) {
+		rc = fcb_sector_scan(fcb, sector, &active);
+		if (rc) {
+			return rc;
+		}
+		*cnt = active.fss_cnt;
+		return 0;
+	}
+
+	fss = fcb_summary_get(fcb, sector);
+	if (fss == NULL) {
+		return -EIO;
+	}
+	*cnt = fss->fss_cnt;
+
+	return 0;
+}
+
+/*
+ * fcb_offset_last_n() counting the elements with the sector summaries, then
+ * walking only the sector of the wanted element. Returns -EAGAIN if the
+ * summaries cannot be used.
+ */
+int
+fcb_summary_offset_last_n(struct fcb *fcb, uint8_t entries,
+			  struct fcb_entry *last_n_entry)
+{
+	struct flash_sector *sector;
+	struct fcb_entry loc;
+	uint32_t active_cnt;
+	uint32_t total;
+	uint32_t skip;
+	uint32_t cnt;
+	int rc;
+
+	if (fcb->f_summaries == NULL) {
+		return -EAGAIN;
+	}
+
+	rc = k_mutex_lock(&fcb->f_mtx, K_FOREVER);
+	if (rc) {
+		return -EINVAL;
+	}
+
+	rc = fcb_summary_cnt(fcb, fcb->f_active.fe_sector, &active_cnt);
+	if (rc) {
+		rc = -EAGAIN;
+		goto out;
+	}
+
+	total = active_cnt;
+	for (sector = fcb->f_oldest; sector != fcb->f_active.fe_sector;
+	     sector = fcb_getnext_sector(fcb, sector)) {
+		rc = fcb_summary_cnt(fcb, sector, &cnt);
+		if (rc) {
+			rc = -EAGAIN;
+			goto out;
+		}
+		total += cnt;
+	}
+
+	if (total == 0U) {
+		rc = -ENOENT;
+		goto out;
+	}
+
+	/* Skip the sectors holding only elements before the wanted one */
+	skip = (total > entries) ? total - entries : 0U;
+	for (sector = fcb->f_oldest; sector != fcb->f_active.fe_sector;
+	     sector = fcb_getnext_sector(fcb, sector)) {
+		(void)fcb_summary_cnt(fcb, sector, &cnt);
+		if (skip < cnt) {
+			break;
+		}
+		skip -= cnt;
+	}
+
+	loc.fe_sector = sector;
+	loc.fe_elem_off = 0U;
+	rc = fcb_getnext_nolock(fcb, &loc);
+	while (rc == 0 && skip > 0U) {
+		rc = fcb_getnext_nolock(fcb, &loc);
+		skip--;
+	}
+	if (rc) {
+		rc = -ENOENT;
+		goto out;
+	}
+	*last_n_entry = loc;
+
+out:
+	k_mutex_unlock(&fcb->f_mtx);
+	return rc;
+}
@@ -168,13 +168,152 @@ static int errno_to_lfs(int error)
 
 #ifdef CONFIG_FS_LITTLEFS_FMP_DEV
 
+/* Block argument of cache_invalidate() for all blocks */
+#define CACHE_ALL_BLOCKS ((lfs_block_t)-1)
+
+#ifdef CONFIG_FS_LITTLEFS_SHARED_CACHE
+
+#define CACHE_LINE_SIZE CONFIG_FS_LITTLEFS_SHARED_CACHE_LINE_SIZE
+
+struct lfs_cache_line {
+	uint8_t data[CACHE_LINE_SIZE] __aligned(4);
+	const struct lfs_config *cfg;	/* NULL if the line is not valid */
+	lfs_block_t block;
+	lfs_off_t off;
+	uint32_t last_use;
+};
+
+/* Lines are shared by all file systems, which are locked separately */
+static K_MUTEX_DEFINE(cache_mutex);
+static struct lfs_cache_line cache_lines[CONFIG_FS_LITTLEFS_SHARED_CACHE_LINES];
+static uint32_t cache_use_count;
+static struct fs_littlefs_cache_stats cache_stats;
+
+static bool cache_usable(const struct lfs_config *c, lfs_size_t size)
+{
+	return (size <= CACHE_LINE_SIZE) &&
+	       ((CACHE_LINE_SIZE % c->read_size) == 0) &&
+	       ((c->block_size % CACHE_LINE_SIZE) == 0);
+}
+
+/* Get the line holding the piece of flash at off, reading it on a miss */
+static struct lfs_cache_line *cache_get(const struct lfs_config *c,
+					lfs_block_t block, lfs_off_t off,
+					int *rc)
+{
+	const struct flash_area *fa = c->context;
+	struct lfs_cache_line *line = &cache_lines[0];
+
+	for (size_t i = 0; i < ARRAY_SIZE(cache_lines); i++) {
+		struct lfs_cache_line *cl = &cache_lines[i];
+
+		if ((cl->cfg == c) && (cl->block == block) && (cl->off == off)) {
+			cache_stats.hits++;
+			cl->last_use = ++cache_use_count;
+			return cl;
+		}
+
+		/* Least recently used line, or any invalid one */
+		if ((line->cfg != NULL) &&
+		    ((cl->cfg == NULL) || (cl->last_use < line->last_use))) {
+			line = cl;
+		}
+	}
+
+	cache_stats.misses++;
+	line->cfg = NULL;
+
+	*rc = flash_area_read(fa, block * c->block_size + off, line->data,
+			      CACHE_LINE_SIZE);
+	if (*rc < 0) {
+		return NULL;
+	}
+
+	line->cfg = c;
+	line->block = block;
+	line->off = off;
+	line->last_use = ++cache_use_count;
+
+	return line;
+}
+
+static int cache_read(const struct lfs_config *c, lfs_block_t block,
+		      lfs_off_t off, uint8_t *buffer, lfs_size_t size)
+{
+	int rc = 0;
+
+	k_mutex_lock(&cache_mutex, K_FOREVER);
+
+	/* The read may span two lines */
+	while (size > 0) {
+		lfs_off_t line_off = ROUND_DOWN(off, CACHE_LINE_SIZE);
+		lfs_size_t len = MIN(size, line_off + CACHE_LINE_SIZE - off);
+		struct lfs_cache_line *line = cache_get(c, block, line_off, &rc);
+
+		if (line == NULL) {
+			break;
+		}
+
+		memcpy(buffer, &line->data[off - line_off], len);
+		buffer += len;
+		off += len;
+		size -= len;
+	}
+
+	k_mutex_unlock(&cache_mutex);
+
+	return rc;
+}
+
+/* Drop the lines of a block, or of all blocks */
+static void cache_invalidate(const struct lfs_config *c, lfs_block_t block)
+{
+	k_mutex_lock(&cache_mutex, K_FOREVER);
+
+	for (size_t i = 0; i < ARRAY_SIZE(cache_lines); i++) {
+		if ((cache_lines[i].cfg == c) &&
+		    ((block == CACHE_ALL_BLOCKS) || (cache_lines[i].block == block))) {
+			cache_lines[i].cfg = NULL;
+		}
+	}
+
+	k_mutex_unlock(&cache_mutex);
+}
+
+void fs_littlefs_cache_stats_get(struct fs_littlefs_cache_stats *stats)
+{
+	k_mutex_lock(&cache_mutex, K_FOREVER);
+	*stats = cache_stats;
+	k_mutex_unlock(&cache_mutex);
+}
+
+void fs_littlefs_cache_stats_reset(void)
+{
+	k_mutex_lock(&cache_mutex, K_FOREVER);
+	memset(&cache_stats, 0, sizeof(cache_stats));
+	k_mutex_unlock(&cache_mutex);
+}
+#else
+static inline void cache_invalidate(const struct lfs_config *c, lfs_block_t block)
+{
+}
+#endif /* CONFIG_FS_LITTLEFS_SHARED_CACHE */
+
 static int lfs_api_read(const struct lfs_config *c, lfs_block_t block,
 			lfs_off_t off, void *buffer, lfs_size_t size)
 {
 	const struct flash_area *fa = c->context;
 	size_t offset = block * c->block_size + off;
+	int rc;
+
+#ifdef CONFIG_FS_LITTLEFS_SHARED_CACHE
+	if (cache_usable(c, size)) {
+		rc = cache_read(c, block, off, buffer, size);
+		return errno_to_lfs(rc);
+	}
+#endif
 
-	int rc = flash_area_read(fa, offset, buffer, size);
+	rc = flash_area_read(fa, offset, buffer, size);
 
 	return errno_to_lfs(rc);
 }
@@ -185,6 +324,8 @@ static int lfs_api_prog(const struct lfs_config *c, lfs_block_t block,
 	const struct flash_area *fa = c->context;
 	size_t offset = block * c->block_size + off;
 
+	cache_invalidate(c, block);
+
 	int rc = flash_area_write(fa, offset, buffer, size);
 
 	return errno_to_lfs(rc);
@@ -195,6 +336,8 @@ static int lfs_api_erase(const struct lfs_config *c, lfs_block_t block)
 	const struct flash_area *fa = c->context;
 	size_t offset = block * c->block_size;
 
+	cache_invalidate(c, block);
+
 	int rc = flash_area_erase(fa, offset, c->block_size);
 
 	return errno_to_lfs(rc);
@@ -655,6 +798,9 @@ static int littlefs_flash_init(struct fs_littlefs *fs, void *dev_id)
 		return -ENODEV;
 	}
 
+	/* Lines may be left from a file system using the same configuration */
+	cache_invalidate(&fs->cfg, CACHE_ALL_BLOCKS);
+
 	fs->backend = (void *) *fap;
 	return 0;
 }
@@ -983,6 +1129,8 @@ static int littlefs_unmount(struct fs_mount_t *mountp)
 
 #ifdef CONFIG_FS_LITTLEFS_FMP_DEV
 	if (!littlefs_on_blkdev(mountp->flags)) {
+		/* The flash may be changed before the next mount */
+		cache_invalidate(&fs->cfg, CACHE_ALL_BLOCKS);
 		flash_area_close(fs->backend);
 	}
 #endif /* CONFIG_FS_LITTLEFS_FMP_DEV */
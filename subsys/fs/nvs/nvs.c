@@ -18,6 +18,25 @@ LOG_MODULE_REGISTER(fs_nvs, CONFIG_NVS_LOG_LEVEL);
 
 static int nvs_prev_ate(struct nvs_fs *fs, uint32_t *addr, struct nvs_ate *ate);
 static int nvs_ate_valid(struct nvs_fs *fs, const struct nvs_ate *entry);
+#ifdef CONFIG_NVS_LOOKUP_CACHE_CHECKPOINT
+static int nvs_flash_rd(struct nvs_fs *fs, uint32_t addr, void *data, size_t len);
+static int nvs_flash_ate_rd(struct nvs_fs *fs, uint32_t addr, struct nvs_ate *entry);
+#endif
+
+/* A checkpoint of the lookup cache is only valid at the address it was
+ * written to, gc does not copy it.
+ */
+static inline bool nvs_lookup_cache_is_ckpt(const struct nvs_ate *ate)
+{
+#ifdef CONFIG_NVS_LOOKUP_CACHE_CHECKPOINT
+	return (ate->id == CONFIG_NVS_LOOKUP_CACHE_CHECKPOINT_ID) &&
+	       (ate->len == NVS_LOOKUP_CACHE_CKPT_LEN);
+#else
+	ARG_UNUSED(ate);
+
+	return false;
+#endif
+}
 
 #ifdef CONFIG_NVS_LOOKUP_CACHE
 
@@ -40,14 +59,211 @@ static inline size_t nvs_lookup_cache_pos(uint16_t id)
 	return pos % CONFIG_NVS_LOOKUP_CACHE_SIZE;
 }
 
+#ifdef CONFIG_NVS_LOOKUP_CACHE_EXACT
+
+/* The entries are placed by linear probing from the hash position of the id.
+ * Entries are never freed, an entry of an id that no longer exists holds
+ * NVS_LOOKUP_CACHE_NO_ADDR, so that a search stops at the first unused entry.
+ * Returns CONFIG_NVS_LOOKUP_CACHE_SIZE if the id is not in the full cache.
+ */
+static size_t nvs_lookup_cache_find(struct nvs_fs *fs, uint16_t id, bool *found)
+{
+	size_t pos = nvs_lookup_cache_pos(id);
+
+	for (size_t i = 0; i < CONFIG_NVS_LOOKUP_CACHE_SIZE; i++) {
+		if (fs->lookup_cache_id[pos] == id) {
+			*found = true;
+			return pos;
+		}
+
+		if (fs->lookup_cache_id[pos] == NVS_LOOKUP_CACHE_NO_ID) {
+			*found = false;
+			return pos;
+		}
+
+		pos = (pos + 1) % CONFIG_NVS_LOOKUP_CACHE_SIZE;
+	}
+
+	*found = false;
+	return CONFIG_NVS_LOOKUP_CACHE_SIZE;
+}
+
+/* Returns the address of the latest ate of the id, NVS_LOOKUP_CACHE_NO_ADDR
+ * if the id does not exist, or the end of the fs to search all the fs for an
+ * id that did not fit in the cache.
+ */
+static uint32_t nvs_lookup_cache_get(struct nvs_fs *fs, uint16_t id)
+{
+	bool found;
+	size_t pos = nvs_lookup_cache_find(fs, id, &found);
+
+	if (found) {
+		return fs->lookup_cache[pos];
+	}
+
+	return fs->lookup_cache_full ? fs->ate_wra : NVS_LOOKUP_CACHE_NO_ADDR;
+}
+
+static void nvs_lookup_cache_set(struct nvs_fs *fs, uint16_t id, uint32_t addr)
+{
+	bool found;
+	size_t pos = nvs_lookup_cache_find(fs, id, &found);
+
+	if (pos == CONFIG_NVS_LOOKUP_CACHE_SIZE) {
+		fs->lookup_cache_full = true;
+		return;
+	}
+
+	fs->lookup_cache_id[pos] = id;
+	fs->lookup_cache[pos] = addr;
+}
+
+/* Set the address of the id unless a more recent ate is already cached */
+static void nvs_lookup_cache_add(struct nvs_fs *fs, uint16_t id, uint32_t addr)
+{
+	bool found;
+
+	(void)nvs_lookup_cache_find(fs, id, &found);
+	if (!found) {
+		nvs_lookup_cache_set(fs, id, addr);
+	}
+}
+
+static void nvs_lookup_cache_clear(struct nvs_fs *fs)
+{
+	memset(fs->lookup_cache, 0xff, sizeof(fs->lookup_cache));
+	memset(fs->lookup_cache_id, 0xff, sizeof(fs->lookup_cache_id));
+	fs->lookup_cache_full = false;
+}
+
+#else
+
+static inline uint32_t nvs_lookup_cache_get(struct nvs_fs *fs, uint16_t id)
+{
+	return fs->lookup_cache[nvs_lookup_cache_pos(id)];
+}
+
+static inline void nvs_lookup_cache_set(struct nvs_fs *fs, uint16_t id, uint32_t addr)
+{
+	fs->lookup_cache[nvs_lookup_cache_pos(id)] = addr;
+}
+
+static inline void nvs_lookup_cache_add(struct nvs_fs *fs, uint16_t id, uint32_t addr)
+{
+	uint32_t *cache_entry = &fs->lookup_cache[nvs_lookup_cache_pos(id)];
+
+	if (*cache_entry == NVS_LOOKUP_CACHE_NO_ADDR) {
+		*cache_entry = addr;
+	}
+}
+
+static inline void nvs_lookup_cache_clear(struct nvs_fs *fs)
+{
+	memset(fs->lookup_cache, 0xff, sizeof(fs->lookup_cache));
+}
+
+#endif /* CONFIG_NVS_LOOKUP_CACHE_EXACT */
+
+#ifdef CONFIG_NVS_LOOKUP_CACHE_CHECKPOINT
+
+/* The addresses of the checkpoint in the sectors written after it may point
+ * to other ates. Only the addresses of ates older than the checkpoint stay
+ * valid, as the sectors holding them were not rewritten since.
+ */
+static bool nvs_lookup_cache_ckpt_older(struct nvs_fs *fs, uint32_t ckpt_addr, uint32_t addr)
+{
+	uint32_t ckpt_sector = ckpt_addr >> ADDR_SECT_SHIFT;
+	uint32_t sector = addr >> ADDR_SECT_SHIFT;
+	uint32_t newer, dist;
+
+	if ((sector >= fs->sector_count) || ((addr & ADDR_OFFS_MASK) >= fs->sector_size)) {
+		return false;
+	}
+
+	newer = ((fs->ate_wra >> ADDR_SECT_SHIFT) + fs->sector_count - ckpt_sector) %
+		fs->sector_count;
+	dist = (sector + fs->sector_count - ckpt_sector) % fs->sector_count;
+
+	if (dist == 0U) {
+		return (addr & ADDR_OFFS_MASK) > (ckpt_addr & ADDR_OFFS_MASK);
+	}
+
+	return dist > newer;
+}
+
+/* Add the ids of the checkpoint that were not written after it */
+static int nvs_lookup_cache_ckpt_load(struct nvs_fs *fs, uint32_t ckpt_addr,
+				      const struct nvs_ate *ckpt_ate)
+{
+	int rc;
+	uint32_t addrs[16];
+	uint32_t rd_addr;
+	size_t count;
+	struct nvs_ate ate;
+
+	rd_addr = (ckpt_addr & ADDR_SECT_MASK) + ckpt_ate->offset;
+
+	for (size_t i = 0; i < CONFIG_NVS_LOOKUP_CACHE_SIZE; i += count) {
+		count = MIN(ARRAY_SIZE(addrs), CONFIG_NVS_LOOKUP_CACHE_SIZE - i);
+		rc = nvs_flash_rd(fs, rd_addr, addrs, count * sizeof(addrs[0]));
+		if (rc) {
+			return rc;
+		}
+		rd_addr += count * sizeof(addrs[0]);
+
+		for (size_t j = 0; j < count; j++) {
+			if (!nvs_lookup_cache_ckpt_older(fs, ckpt_addr, addrs[j])) {
+				continue;
+			}
+
+			rc = nvs_flash_ate_rd(fs, addrs[j], &ate);
+			if (rc) {
+				return rc;
+			}
+
+			if (ate.id != 0xFFFF && nvs_ate_valid(fs, &ate)) {
+				nvs_lookup_cache_add(fs, ate.id, addrs[j]);
+			}
+		}
+	}
+
+	return 0;
+}
+
+/* Write a checkpoint once enough ates were written since the previous one,
+ * which bounds the number of ates read by nvs_mount(). A checkpoint of a full
+ * cache would miss ids, none is written then.
+ */
+static void nvs_lookup_cache_ckpt_write(struct nvs_fs *fs)
+{
+	ssize_t rc;
+
+	if ((fs->lookup_cache_ckpt_ates < CONFIG_NVS_LOOKUP_CACHE_CHECKPOINT_INTERVAL) ||
+	    fs->lookup_cache_full) {
+		return;
+	}
+
+	rc = nvs_write(fs, CONFIG_NVS_LOOKUP_CACHE_CHECKPOINT_ID, fs->lookup_cache,
+		       NVS_LOOKUP_CACHE_CKPT_LEN);
+	if (rc < 0) {
+		LOG_WRN("Lookup cache checkpoint write failed: %d", (int)rc);
+	}
+
+	fs->lookup_cache_ckpt_ates = 0;
+}
+
+#endif /* CONFIG_NVS_LOOKUP_CACHE_CHECKPOINT */
+
 static int nvs_lookup_cache_rebuild(struct nvs_fs *fs)
 {
 	int rc;
 	uint32_t addr, ate_addr;
-	uint32_t *cache_entry;
 	struct nvs_ate ate;
 
-	memset(fs->lookup_cache, 0xff, sizeof(fs->lookup_cache));
+	nvs_lookup_cache_clear(fs);
+#ifdef CONFIG_NVS_LOOKUP_CACHE_CHECKPOINT
+	fs->lookup_cache_ckpt_ates = 0;
+#endif
 	addr = fs->ate_wra;
 
 	while (true) {
@@ -59,11 +275,19 @@ static int nvs_lookup_cache_rebuild(struct nvs_fs *fs)
 			return rc;
 		}
 
-		cache_entry = &fs->lookup_cache[nvs_lookup_cache_pos(ate.id)];
+#ifdef CONFIG_NVS_LOOKUP_CACHE_CHECKPOINT
+		fs->lookup_cache_ckpt_ates++;
+#endif
+
+		if (ate.id != 0xFFFF && nvs_ate_valid(fs, &ate)) {
+			nvs_lookup_cache_add(fs, ate.id, ate_addr);
 
-		if (ate.id != 0xFFFF && *cache_entry == NVS_LOOKUP_CACHE_NO_ADDR &&
-		    nvs_ate_valid(fs, &ate)) {
-			*cache_entry = ate_addr;
+#ifdef CONFIG_NVS_LOOKUP_CACHE_CHECKPOINT
+			/* The older ates are in the checkpoint */
+			if (nvs_lookup_cache_is_ckpt(&ate)) {
+				return nvs_lookup_cache_ckpt_load(fs, ate_addr, &ate);
+			}
+#endif
 		}
 
 		if (addr == fs->ate_wra) {
@@ -88,6 +312,36 @@ static void nvs_lookup_cache_invalidate(struct nvs_fs *fs, uint32_t sector)
 
 #endif /* CONFIG_NVS_LOOKUP_CACHE */
 
+#ifdef CONFIG_NVS_GC_BACKGROUND
+
+static K_THREAD_STACK_DEFINE(nvs_gc_stack, CONFIG_NVS_GC_BACKGROUND_STACK_SIZE);
+static struct k_work_q nvs_gc_work_q;
+
+/* A sector collected by gc but not erased yet holds no valid data, it is
+ * skipped as if it was erased.
+ */
+static inline bool nvs_gc_erase_pending(struct nvs_fs *fs, uint32_t addr)
+{
+	return fs->gc_erase_pending &&
+	       ((addr >> ADDR_SECT_SHIFT) == (fs->gc_erase_addr >> ADDR_SECT_SHIFT));
+}
+
+/* Leave the erase of a collected sector to the work queue. This is safe as
+ * the gc done ate is written, so that nvs_startup() erases the sector if the
+ * erase is interrupted.
+ */
+static void nvs_gc_erase_defer(struct nvs_fs *fs, uint32_t addr)
+{
+	fs->gc_erase_addr = addr & ADDR_SECT_MASK;
+	fs->gc_erase_pending = true;
+#ifdef CONFIG_NVS_LOOKUP_CACHE
+	nvs_lookup_cache_invalidate(fs, addr >> ADDR_SECT_SHIFT);
+#endif
+	(void)k_work_submit_to_queue(&nvs_gc_work_q, &fs->gc_work);
+}
+
+#endif /* CONFIG_NVS_GC_BACKGROUND */
+
 /* basic routines */
 /* nvs_al_size returns size aligned to fs->write_block_size */
 static inline size_t nvs_al_size(struct nvs_fs *fs, size_t len)
@@ -170,8 +424,11 @@ static int nvs_flash_ate_wrt(struct nvs_fs *fs, const struct nvs_ate *entry)
 #ifdef CONFIG_NVS_LOOKUP_CACHE
 	/* 0xFFFF is a special-purpose identifier. Exclude it from the cache */
 	if (entry->id != 0xFFFF) {
-		fs->lookup_cache[nvs_lookup_cache_pos(entry->id)] = fs->ate_wra;
+		nvs_lookup_cache_set(fs, entry->id, fs->ate_wra);
 	}
+#endif
+#ifdef CONFIG_NVS_LOOKUP_CACHE_CHECKPOINT
+	fs->lookup_cache_ckpt_ates++;
 #endif
 	fs->ate_wra -= nvs_al_size(fs, sizeof(struct nvs_ate));
 
@@ -496,6 +753,13 @@ static int nvs_prev_ate(struct nvs_fs *fs, uint32_t *addr, struct nvs_ate *ate)
 		*addr -= (1 << ADDR_SECT_SHIFT);
 	}
 
+#ifdef CONFIG_NVS_GC_BACKGROUND
+	if (nvs_gc_erase_pending(fs, *addr)) {
+		*addr = fs->ate_wra;
+		return 0;
+	}
+#endif
+
 	rc = nvs_flash_ate_rd(fs, *addr, &close_ate);
 	if (rc) {
 		return rc;
@@ -561,6 +825,10 @@ static int nvs_sector_close(struct nvs_fs *fs)
 
 	fs->data_wra = fs->ate_wra & ADDR_SECT_MASK;
 
+#ifdef CONFIG_NVS_GC_BACKGROUND
+	fs->gc_written = false;
+#endif
+
 	return 0;
 }
 
@@ -632,7 +900,7 @@ static int nvs_gc(struct nvs_fs *fs)
 		}
 
 #ifdef CONFIG_NVS_LOOKUP_CACHE
-		wlk_addr = fs->lookup_cache[nvs_lookup_cache_pos(gc_ate.id)];
+		wlk_addr = nvs_lookup_cache_get(fs, gc_ate.id);
 
 		if (wlk_addr == NVS_LOOKUP_CACHE_NO_ADDR) {
 			wlk_addr = fs->ate_wra;
@@ -658,9 +926,11 @@ static int nvs_gc(struct nvs_fs *fs)
 		} while (wlk_addr != fs->ate_wra);
 
 		/* if walk has reached the same address as gc_addr copy is
-		 * needed unless it is a deleted item.
+		 * needed unless it is a deleted item or a lookup cache
+		 * checkpoint.
 		 */
-		if ((wlk_prev_addr == gc_prev_addr) && gc_ate.len) {
+		if ((wlk_prev_addr == gc_prev_addr) && gc_ate.len &&
+		    !nvs_lookup_cache_is_ckpt(&gc_ate)) {
 			/* copy needed */
 			LOG_DBG("Moving %d, len %d", gc_ate.id, gc_ate.len);
 
@@ -697,6 +967,14 @@ gc_done:
 		}
 	}
 
+#ifdef CONFIG_NVS_GC_BACKGROUND
+	/* Once mounted, writes do not wait for the erase */
+	if (fs->ready) {
+		nvs_gc_erase_defer(fs, sec_addr);
+		return 0;
+	}
+#endif
+
 	/* Erase the gc'ed sector */
 	rc = nvs_flash_erase_sector(fs, sec_addr);
 	if (rc) {
@@ -705,6 +983,112 @@ gc_done:
 	return 0;
 }
 
+#ifdef CONFIG_NVS_GC_BACKGROUND
+/* Wait for the work queue to erase the collected sector, or erase it if the
+ * work queue did not get to it. Called with the nvs_lock held before
+ * closing a sector, as the next sector must be erased.
+ */
+static int nvs_gc_erase_wait(struct nvs_fs *fs)
+{
+	int rc;
+
+	while (fs->gc_erase_busy) {
+		k_condvar_wait(&fs->gc_erase_done, &fs->nvs_lock, K_FOREVER);
+	}
+
+	if (!fs->gc_erase_pending) {
+		return 0;
+	}
+
+	rc = nvs_flash_erase_sector(fs, fs->gc_erase_addr);
+	if (rc) {
+		return rc;
+	}
+
+	fs->gc_erase_pending = false;
+
+	return 0;
+}
+
+/* The sector being written is closed ahead of time when its free space is
+ * below the threshold, unless only gc wrote to it, in which case closing it
+ * would not free any space.
+ */
+static bool nvs_gc_background_needed(struct nvs_fs *fs)
+{
+	size_t threshold = ((size_t)fs->sector_size *
+			    CONFIG_NVS_GC_BACKGROUND_THRESHOLD) / 100U;
+
+	return fs->gc_written && ((fs->ate_wra - fs->data_wra) < threshold);
+}
+
+static void nvs_gc_work_handler(struct k_work *work)
+{
+	struct nvs_fs *fs = CONTAINER_OF(work, struct nvs_fs, gc_work);
+	uint32_t addr;
+	int rc;
+
+	k_mutex_lock(&fs->nvs_lock, K_FOREVER);
+
+	while (fs->ready) {
+		if (fs->gc_erase_pending) {
+			/* Writes can go on in the sector being written during
+			 * the erase.
+			 */
+			addr = fs->gc_erase_addr;
+			fs->gc_erase_busy = true;
+			k_mutex_unlock(&fs->nvs_lock);
+
+			rc = nvs_flash_erase_sector(fs, addr);
+
+			k_mutex_lock(&fs->nvs_lock, K_FOREVER);
+			fs->gc_erase_busy = false;
+			if (!rc) {
+				fs->gc_erase_pending = false;
+			}
+			k_condvar_broadcast(&fs->gc_erase_done);
+
+			if (rc) {
+				/* Retried by the write closing the sector */
+				LOG_ERR("Background erase of sector %d failed: %d",
+					addr >> ADDR_SECT_SHIFT, rc);
+				break;
+			}
+			continue;
+		}
+
+		if (!nvs_gc_background_needed(fs)) {
+			break;
+		}
+
+		LOG_DBG("Background gc of sector %d", fs->ate_wra >> ADDR_SECT_SHIFT);
+		rc = nvs_sector_close(fs);
+		if (!rc) {
+			rc = nvs_gc(fs);
+		}
+		if (rc) {
+			LOG_ERR("Background gc failed: %d", rc);
+			break;
+		}
+	}
+
+	k_mutex_unlock(&fs->nvs_lock);
+}
+
+static int nvs_gc_work_q_init(void)
+{
+	k_work_queue_init(&nvs_gc_work_q);
+	k_work_queue_start(&nvs_gc_work_q, nvs_gc_stack,
+			   K_THREAD_STACK_SIZEOF(nvs_gc_stack),
+			   K_LOWEST_APPLICATION_THREAD_PRIO, NULL);
+	k_thread_name_set(&nvs_gc_work_q.thread, "nvs_gc");
+
+	return 0;
+}
+
+SYS_INIT(nvs_gc_work_q_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
+#endif /* CONFIG_NVS_GC_BACKGROUND */
+
 static int nvs_startup(struct nvs_fs *fs)
 {
 	int rc;
@@ -870,9 +1254,14 @@ static int nvs_startup(struct nvs_fs *fs)
 		 * So, temporarily, we set the lookup cache to the end of the fs.
 		 * The cache will be rebuilt afterwards
 		 **/
+#ifdef CONFIG_NVS_LOOKUP_CACHE_EXACT
+		nvs_lookup_cache_clear(fs);
+		fs->lookup_cache_full = true;
+#else
 		for (i = 0; i < CONFIG_NVS_LOOKUP_CACHE_SIZE; i++) {
 			fs->lookup_cache[i] = fs->ate_wra;
 		}
+#endif
 #endif
 		rc = nvs_gc(fs);
 		goto end;
@@ -936,6 +1325,12 @@ int nvs_clear(struct nvs_fs *fs)
 		return -EACCES;
 	}
 
+#ifdef CONFIG_NVS_GC_BACKGROUND
+	struct k_work_sync sync;
+
+	(void)k_work_cancel_sync(&fs->gc_work, &sync);
+#endif
+
 	for (uint16_t i = 0; i < fs->sector_count; i++) {
 		addr = i << ADDR_SECT_SHIFT;
 		rc = nvs_flash_erase_sector(fs, addr);
@@ -957,6 +1352,22 @@ int nvs_mount(struct nvs_fs *fs)
 	struct flash_pages_info info;
 	size_t write_block_size;
 
+#ifdef CONFIG_NVS_GC_BACKGROUND
+	if (fs->ready) {
+		struct k_work_sync sync;
+
+		/* An interrupted background erase is redone by nvs_startup() */
+		(void)k_work_cancel_sync(&fs->gc_work, &sync);
+		fs->ready = false;
+	}
+
+	k_work_init(&fs->gc_work, nvs_gc_work_handler);
+	k_condvar_init(&fs->gc_erase_done);
+	fs->gc_erase_pending = false;
+	fs->gc_erase_busy = false;
+	fs->gc_written = false;
+#endif
+
 	k_mutex_init(&fs->nvs_lock);
 
 	fs->flash_parameters = flash_get_parameters(fs->flash_device);
@@ -998,6 +1409,11 @@ int nvs_mount(struct nvs_fs *fs)
 	/* nvs is ready for use */
 	fs->ready = true;
 
+#ifdef CONFIG_NVS_LOOKUP_CACHE_CHECKPOINT
+	/* Spare the next mount the ates read by this one */
+	nvs_lookup_cache_ckpt_write(fs);
+#endif
+
 	LOG_INF("%d Sectors of %d bytes", fs->sector_count, fs->sector_size);
 	LOG_INF("alloc wra: %d, %x",
 		(fs->ate_wra >> ADDR_SECT_SHIFT),
@@ -1037,7 +1453,7 @@ ssize_t nvs_write(struct nvs_fs *fs, uint16_t id, const void *data, size_t len)
 
 	/* find latest entry with same id */
 #ifdef CONFIG_NVS_LOOKUP_CACHE
-	wlk_addr = fs->lookup_cache[nvs_lookup_cache_pos(id)];
+	wlk_addr = nvs_lookup_cache_get(fs, id);
 
 	if (wlk_addr == NVS_LOOKUP_CACHE_NO_ADDR) {
 		goto no_cached_entry;
@@ -1122,6 +1538,13 @@ no_cached_entry:
 		}
 
 
+#ifdef CONFIG_NVS_GC_BACKGROUND
+		rc = nvs_gc_erase_wait(fs);
+		if (rc) {
+			goto end;
+		}
+#endif
+
 		rc = nvs_sector_close(fs);
 		if (rc) {
 			goto end;
@@ -1134,8 +1557,21 @@ no_cached_entry:
 		gc_count++;
 	}
 	rc = len;
+
+#ifdef CONFIG_NVS_GC_BACKGROUND
+	fs->gc_written = true;
+	if (nvs_gc_background_needed(fs)) {
+		(void)k_work_submit_to_queue(&nvs_gc_work_q, &fs->gc_work);
+	}
+#endif
 end:
 	k_mutex_unlock(&fs->nvs_lock);
+
+#ifdef CONFIG_NVS_LOOKUP_CACHE_CHECKPOINT
+	if ((rc >= 0) && (id != CONFIG_NVS_LOOKUP_CACHE_CHECKPOINT_ID)) {
+		nvs_lookup_cache_ckpt_write(fs);
+	}
+#endif
 	return rc;
 }
 
@@ -1167,7 +1603,7 @@ ssize_t nvs_read_hist(struct nvs_fs *fs, uint16_t id, void *data, size_t len,
 	cnt_his = 0U;
 
 #ifdef CONFIG_NVS_LOOKUP_CACHE
-	wlk_addr = fs->lookup_cache[nvs_lookup_cache_pos(id)];
+	wlk_addr = nvs_lookup_cache_get(fs, id);
 
 	if (wlk_addr == NVS_LOOKUP_CACHE_NO_ADDR) {
 		rc = -ENOENT;
@@ -29,6 +29,12 @@ extern "C" {
 #define NVS_BLOCK_SIZE 32
 
 #define NVS_LOOKUP_CACHE_NO_ADDR 0xFFFFFFFF
+#define NVS_LOOKUP_CACHE_NO_ID 0xFFFF
+
+#ifdef CONFIG_NVS_LOOKUP_CACHE_CHECKPOINT
+/* A checkpoint holds the address array of the lookup cache */
+#define NVS_LOOKUP_CACHE_CKPT_LEN (CONFIG_NVS_LOOKUP_CACHE_SIZE * sizeof(uint32_t))
+#endif
 
 /* Allocation Table Entry */
 struct nvs_ate {
@@ -413,6 +413,31 @@ static int cmd_statvfs(const struct shell *sh, size_t argc, char **argv)
 	return 0;
 }
 
+#if defined(CONFIG_FS_LITTLEFS_SHARED_CACHE)
+static int cmd_littlefs_cache(const struct shell *sh, size_t argc, char **argv)
+{
+	struct fs_littlefs_cache_stats stats;
+	uint32_t total;
+
+	if (argc > 1) {
+		if (strcmp(argv[1], "reset") != 0) {
+			shell_error(sh, "Unknown argument %s", argv[1]);
+			return -EINVAL;
+		}
+		fs_littlefs_cache_stats_reset();
+		return 0;
+	}
+
+	fs_littlefs_cache_stats_get(&stats);
+	total = stats.hits + stats.misses;
+
+	shell_print(sh, "hits %u, misses %u, hit rate %u%%", stats.hits,
+		    stats.misses, total ? (uint32_t)((uint64_t)stats.hits * 100U / total) : 0U);
+
+	return 0;
+}
+#endif
+
 static int cmd_write(const struct shell *sh, size_t argc, char **argv)
 {
 	char path[MAX_PATH_LEN];
@@ -808,6 +833,11 @@ SHELL_STATIC_SUBCMD_SET_CREATE(sub_fs_mount,
 SHELL_STATIC_SUBCMD_SET_CREATE(sub_fs,
 	SHELL_CMD(cd, NULL, "Change working directory", cmd_cd),
 	SHELL_CMD(ls, NULL, "List files in current directory", cmd_ls),
+#if defined(CONFIG_FS_LITTLEFS_SHARED_CACHE)
+	SHELL_CMD_ARG(littlefs_cache, NULL,
+		      "Show littlefs shared cache statistics [reset]",
+		      cmd_littlefs_cache, 1, 1),
+#endif
 	SHELL_CMD_ARG(mkdir, NULL, "Create directory", cmd_mkdir, 2, 0),
 #if defined(CONFIG_FAT_FILESYSTEM_ELM)		\
 	|| defined(CONFIG_FILE_SYSTEM_LITTLEFS)
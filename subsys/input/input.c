@@ -16,6 +16,27 @@ LOG_MODULE_REGISTER(input, CONFIG_INPUT_LOG_LEVEL);
 K_MSGQ_DEFINE(input_msgq, sizeof(struct input_event),
 	      CONFIG_INPUT_QUEUE_MAX_MSGS, 4);
 
+#ifdef CONFIG_INPUT_FRAMES
+
+/* Given for the events with the sync flag set, which complete a frame */
+static K_SEM_DEFINE(input_sync_sem, 0, 1);
+
+struct input_frame {
+	const struct device *dev;
+	/* Complete, held to merge the next frame of the device in it */
+	bool held;
+	/* Held and merging the next frame, not complete */
+	bool partial;
+	uint8_t n_evts;
+	uint32_t age;
+	struct input_event evts[CONFIG_INPUT_FRAME_MAX_EVENTS];
+};
+
+static struct input_frame input_frames[CONFIG_INPUT_FRAME_DEVICES];
+static uint32_t input_frame_age;
+
+#endif /* CONFIG_INPUT_FRAMES */
+
 #endif
 
 static void input_process(struct input_event *evt)
@@ -50,7 +71,19 @@ int input_report(const struct device *dev,
 	};
 
 #ifdef CONFIG_INPUT_MODE_THREAD
+#ifdef CONFIG_INPUT_FRAMES
+	int ret;
+
+	ret = k_msgq_put(&input_msgq, &evt, timeout);
+	if (ret == 0 && (sync || k_msgq_num_used_get(&input_msgq) >=
+			 CONFIG_INPUT_QUEUE_MAX_MSGS / 2)) {
+		k_sem_give(&input_sync_sem);
+	}
+
+	return ret;
+#else
 	return k_msgq_put(&input_msgq, &evt, timeout);
+#endif
 #else
 	input_process(&evt);
 	return 0;
@@ -59,6 +92,147 @@ int input_report(const struct device *dev,
 
 #ifdef CONFIG_INPUT_MODE_THREAD
 
+#ifdef CONFIG_INPUT_FRAMES
+
+static void input_frame_deliver(struct input_frame *frame)
+{
+	if (frame->n_evts > 0) {
+		STRUCT_SECTION_FOREACH(input_frame_listener, listener) {
+			if (listener->dev == NULL || listener->dev == frame->dev) {
+				listener->callback(frame->evts, frame->n_evts);
+			}
+		}
+	}
+
+	frame->dev = NULL;
+	frame->held = false;
+	frame->partial = false;
+	frame->n_evts = 0;
+}
+
+/* Frame in progress of the device, or a new one replacing the oldest if none is free */
+static struct input_frame *input_frame_get(const struct device *dev)
+{
+	struct input_frame *oldest = &input_frames[0];
+
+	for (size_t i = 0; i < ARRAY_SIZE(input_frames); i++) {
+		if (input_frames[i].n_evts > 0 && input_frames[i].dev == dev) {
+			return &input_frames[i];
+		}
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(input_frames); i++) {
+		if (input_frames[i].n_evts == 0) {
+			oldest = &input_frames[i];
+			break;
+		}
+
+		if (input_frame_age - input_frames[i].age > input_frame_age - oldest->age) {
+			oldest = &input_frames[i];
+		}
+	}
+
+	input_frame_deliver(oldest);
+	oldest->dev = dev;
+	oldest->age = input_frame_age++;
+
+	return oldest;
+}
+
+static bool input_frame_mergeable(const struct input_event *evt)
+{
+	return evt->type == INPUT_EV_ABS || evt->type == INPUT_EV_REL;
+}
+
+/* Merge the event with the one of the same code, false if there is none */
+static bool input_frame_coalesce(struct input_frame *frame, const struct input_event *evt)
+{
+	for (uint8_t i = 0; i < frame->n_evts; i++) {
+		struct input_event *prev = &frame->evts[i];
+
+		if (prev->type != evt->type || prev->code != evt->code) {
+			continue;
+		}
+
+		if (evt->type == INPUT_EV_ABS) {
+			prev->value = evt->value;
+		} else {
+			prev->value += evt->value;
+		}
+
+		return true;
+	}
+
+	return false;
+}
+
+static void input_frame_add(struct input_event *evt)
+{
+	struct input_frame *frame = input_frame_get(evt->dev);
+
+	/* Only frames of absolute and relative events are merged */
+	if (frame->held && !input_frame_mergeable(evt)) {
+		input_frame_deliver(frame);
+		frame = input_frame_get(evt->dev);
+	}
+
+	if (!frame->held || !input_frame_coalesce(frame, evt)) {
+		if (frame->n_evts == CONFIG_INPUT_FRAME_MAX_EVENTS) {
+			input_frame_deliver(frame);
+			frame = input_frame_get(evt->dev);
+		}
+
+		frame->evts[frame->n_evts++] = *evt;
+	}
+
+	if (frame->held && !frame->partial) {
+		/* The merged frame ends with the sync of the next one */
+		for (uint8_t i = 0; i < frame->n_evts; i++) {
+			frame->evts[i].sync = false;
+		}
+
+		frame->partial = true;
+	}
+
+	if (!evt->sync) {
+		return;
+	}
+
+	frame->evts[frame->n_evts - 1].sync = true;
+	frame->partial = false;
+
+	/* Hold the frame while more events are queued, the next frame may be merged in it */
+	if (IS_ENABLED(CONFIG_INPUT_FRAME_COALESCE) &&
+	    k_msgq_num_used_get(&input_msgq) > 0) {
+		frame->held = true;
+	} else {
+		input_frame_deliver(frame);
+	}
+}
+
+static void input_thread(void)
+{
+	struct input_event evt;
+
+	while (true) {
+		(void)k_sem_take(&input_sync_sem, K_FOREVER);
+
+		while (k_msgq_get(&input_msgq, &evt, K_NO_WAIT) == 0) {
+			input_process(&evt);
+			input_frame_add(&evt);
+		}
+
+		/* Caught up with the devices, deliver the complete frames held */
+		for (size_t i = 0; i < ARRAY_SIZE(input_frames); i++) {
+			if (input_frames[i].held && !input_frames[i].partial) {
+				input_frame_deliver(&input_frames[i]);
+			}
+		}
+	}
+}
+
+#else
+
 static void input_thread(void)
 {
 	struct input_event evt;
@@ -75,6 +249,8 @@ static void input_thread(void)
 	}
 }
 
+#endif /* CONFIG_INPUT_FRAMES */
+
 #define INPUT_THREAD_PRIORITY \
 	COND_CODE_1(CONFIG_INPUT_THREAD_PRIORITY_OVERRIDE, \
 		    (CONFIG_INPUT_THREAD_PRIORITY), (K_LOWEST_APPLICATION_THREAD_PRIO))
@@ -13,6 +13,13 @@
 
 #define BOND_NOTIFY_REPEAT_TO	K_MSEC(CONFIG_IPC_SERVICE_ICMSG_BOND_NOTIFY_REPEAT_TO_MS)
 #define SHMEM_ACCESS_TO		K_MSEC(CONFIG_IPC_SERVICE_ICMSG_SHMEM_ACCESS_TO_MS)
+#define TX_BUFFERS		CONFIG_IPC_SERVICE_ICMSG_TX_BUFFERS
+
+#ifdef CONFIG_IPC_SERVICE_ICMSG_NOTIFY_COALESCE
+#define NOTIFY_INTERVAL		CONFIG_IPC_SERVICE_ICMSG_NOTIFY_INTERVAL
+#else
+#define NOTIFY_INTERVAL		1
+#endif
 
 enum rx_buffer_state {
 	RX_BUFFER_STATE_RELEASED,
@@ -20,11 +27,6 @@ enum rx_buffer_state {
 	RX_BUFFER_STATE_HELD
 };
 
-enum tx_buffer_state {
-	TX_BUFFER_STATE_UNUSED,
-	TX_BUFFER_STATE_RESERVED
-};
-
 static const uint8_t magic[] = {0x45, 0x6d, 0x31, 0x6c, 0x31, 0x4b,
 				0x30, 0x72, 0x6e, 0x33, 0x6c, 0x69, 0x34};
 
@@ -73,42 +75,131 @@ static bool is_endpoint_ready(struct icmsg_data_t *dev_data)
 	return atomic_get(&dev_data->state) == ICMSG_STATE_READY;
 }
 
-static bool is_tx_buffer_reserved(struct icmsg_data_t *dev_data)
+static int lock_tx(struct icmsg_data_t *dev_data)
 {
-	return atomic_get(&dev_data->tx_buffer_state) ==
-			TX_BUFFER_STATE_RESERVED;
+#ifdef CONFIG_IPC_SERVICE_ICMSG_SHMEM_ACCESS_SYNC
+	return k_mutex_lock(&dev_data->tx_lock, SHMEM_ACCESS_TO);
+#else
+	return 0;
+#endif
 }
 
-static int reserve_tx_buffer_if_unused(struct icmsg_data_t *dev_data)
+static void unlock_tx(struct icmsg_data_t *dev_data)
 {
 #ifdef CONFIG_IPC_SERVICE_ICMSG_SHMEM_ACCESS_SYNC
-	int ret = k_mutex_lock(&dev_data->tx_lock, SHMEM_ACCESS_TO);
+	(void)k_mutex_unlock(&dev_data->tx_lock);
+#endif
+}
 
-	if (ret < 0) {
+/* The TX buffers are reserved one after the other in the shared memory, and
+ * the messages become visible to the remote in the order of the reservations.
+ * A message sent from a buffer reserved after one not sent yet is held until
+ * the latter is sent. The functions below are called with the TX lock held.
+ */
+static struct icmsg_tx_buf *get_tx_buf(struct icmsg_data_t *dev_data, uint8_t i)
+{
+	return &dev_data->tx_bufs[(dev_data->tx_head + i) % TX_BUFFERS];
+}
+
+static struct icmsg_tx_buf *find_tx_buf(struct icmsg_data_t *dev_data,
+					const void *data)
+{
+	for (uint8_t i = 0; i < dev_data->tx_count; i++) {
+		struct icmsg_tx_buf *tx_buf = get_tx_buf(dev_data, i);
+
+		if (tx_buf->data == data) {
+			return tx_buf;
+		}
+	}
+
+	return NULL;
+}
+
+static bool is_last_tx_buf(struct icmsg_data_t *dev_data,
+			   const struct icmsg_tx_buf *tx_buf)
+{
+	return tx_buf == get_tx_buf(dev_data, dev_data->tx_count - 1);
+}
+
+/* Reserve a TX buffer, returns its size, which can be smaller than requested */
+static int reserve_tx_buf(struct icmsg_data_t *dev_data, uint16_t size,
+			  struct icmsg_tx_buf **tx_buf)
+{
+	struct icmsg_tx_buf *last = NULL;
+	char *data;
+	int ret;
+
+	if (dev_data->tx_count == TX_BUFFERS) {
+		return -ENOBUFS;
+	}
+
+	if (dev_data->tx_count > 0) {
+		last = get_tx_buf(dev_data, dev_data->tx_count - 1);
+	}
+
+	ret = spsc_pbuf_alloc_after(dev_data->tx_ib,
+				    last ? last->data : NULL,
+				    last ? last->size : 0,
+				    size, &data);
+	if (ret <= 0) {
 		return ret;
 	}
-#endif
 
-	bool was_unused = atomic_cas(&dev_data->tx_buffer_state,
-				  TX_BUFFER_STATE_UNUSED, TX_BUFFER_STATE_RESERVED);
+	*tx_buf = get_tx_buf(dev_data, dev_data->tx_count);
+	(*tx_buf)->data = data;
+	(*tx_buf)->size = ret;
+	(*tx_buf)->len = 0;
 
-	return was_unused ? 0 : -EALREADY;
+	return ret;
 }
 
-static int release_tx_buffer(struct icmsg_data_t *dev_data)
+/* Make the oldest buffers sent visible to the remote, returns whether the
+ * remote must be notified.
+ */
+static bool commit_tx_bufs(struct icmsg_data_t *dev_data)
 {
-	bool was_reserved = atomic_cas(&dev_data->tx_buffer_state,
-					TX_BUFFER_STATE_RESERVED, TX_BUFFER_STATE_UNUSED);
+	bool was_empty = false;
+	uint8_t committed = 0;
 
-	if (!was_reserved) {
-		return -EALREADY;
+	while (dev_data->tx_count > 0) {
+		struct icmsg_tx_buf *tx_buf = get_tx_buf(dev_data, 0);
+
+		if (tx_buf->len == 0) {
+			break;
+		}
+
+		was_empty |= spsc_pbuf_commit_buf(dev_data->tx_ib, tx_buf->data,
+						  tx_buf->len);
+		dev_data->tx_head = (dev_data->tx_head + 1) % TX_BUFFERS;
+		dev_data->tx_count--;
+		committed++;
 	}
 
-#ifdef CONFIG_IPC_SERVICE_ICMSG_SHMEM_ACCESS_SYNC
-	return k_mutex_unlock(&dev_data->tx_lock);
-#else
-	return 0;
-#endif
+	if (committed == 0) {
+		return false;
+	}
+
+	if (!IS_ENABLED(CONFIG_IPC_SERVICE_ICMSG_NOTIFY_COALESCE)) {
+		return true;
+	}
+
+	/* The remote reads until the buffer is empty once notified, it only
+	 * needs a notification when the buffer was empty.
+	 */
+	dev_data->tx_unnotified = MIN(dev_data->tx_unnotified + committed, UINT8_MAX);
+	if (was_empty || dev_data->tx_unnotified >= NOTIFY_INTERVAL) {
+		dev_data->tx_unnotified = 0;
+		return true;
+	}
+
+	return false;
+}
+
+static int notify_remote(const struct icmsg_config_t *conf)
+{
+	__ASSERT_NO_MSG(conf->mbox_tx.dev != NULL);
+
+	return mbox_send(&conf->mbox_tx, NULL);
 }
 
 static bool is_rx_buffer_free(struct icmsg_data_t *dev_data)
@@ -267,6 +358,9 @@ int icmsg_open(const struct icmsg_config_t *conf,
 #ifdef CONFIG_IPC_SERVICE_ICMSG_SHMEM_ACCESS_SYNC
 	k_mutex_init(&dev_data->tx_lock);
 #endif
+	dev_data->tx_head = 0;
+	dev_data->tx_count = 0;
+	dev_data->tx_unnotified = 0;
 
 	dev_data->tx_ib = spsc_pbuf_init((void *)conf->tx_shm_addr,
 					 conf->tx_shm_size,
@@ -317,10 +411,9 @@ int icmsg_send(const struct icmsg_config_t *conf,
 	       struct icmsg_data_t *dev_data,
 	       const void *msg, size_t len)
 {
+	struct icmsg_tx_buf *tx_buf;
+	bool notify;
 	int ret;
-	int write_ret;
-	int release_ret;
-	int sent_bytes;
 
 	if (!is_endpoint_ready(dev_data)) {
 		return -EBUSY;
@@ -331,41 +424,50 @@ int icmsg_send(const struct icmsg_config_t *conf,
 		return -ENODATA;
 	}
 
-	ret = reserve_tx_buffer_if_unused(dev_data);
-	if (ret < 0) {
+	if (len >= SPSC_PBUF_MAX_LEN) {
+		return -EINVAL;
+	}
+
+	if (lock_tx(dev_data) < 0) {
 		return -ENOBUFS;
 	}
 
-	write_ret = spsc_pbuf_write(dev_data->tx_ib, msg, len);
-	release_ret = release_tx_buffer(dev_data);
-	__ASSERT_NO_MSG(!release_ret);
+	ret = reserve_tx_buf(dev_data, len, &tx_buf);
+	if (ret < 0) {
+		unlock_tx(dev_data);
+		return ret;
+	}
 
-	if (write_ret < 0) {
-		return write_ret;
-	} else if (write_ret < len) {
-		return -EBADMSG;
+	if (ret < len) {
+		/* Silently stop using the reserved space, what is allowed by SPSC API */
+		unlock_tx(dev_data);
+		return -ENOMEM;
 	}
-	sent_bytes = write_ret;
 
-	__ASSERT_NO_MSG(conf->mbox_tx.dev != NULL);
+	memcpy(tx_buf->data, msg, len);
+	tx_buf->len = len;
+	dev_data->tx_count++;
 
-	ret = mbox_send(&conf->mbox_tx, NULL);
-	if (ret) {
-		return ret;
+	notify = commit_tx_bufs(dev_data);
+	unlock_tx(dev_data);
+
+	if (notify) {
+		ret = notify_remote(conf);
+		if (ret) {
+			return ret;
+		}
 	}
 
-	return sent_bytes;
+	return len;
 }
 
 int icmsg_get_tx_buffer(const struct icmsg_config_t *conf,
 			struct icmsg_data_t *dev_data,
 			void **data, size_t *size)
 {
-	int ret;
-	int release_ret;
+	struct icmsg_tx_buf *tx_buf;
 	uint16_t requested_size;
-	int allocated_len;
-	char *allocated_buf;
+	int ret;
 
 	if (*size == 0) {
 		/* Requested allocation of maximal size.
@@ -377,57 +479,77 @@ int icmsg_get_tx_buffer(const struct icmsg_config_t *conf,
 		requested_size = *size;
 	}
 
-	ret = reserve_tx_buffer_if_unused(dev_data);
-	if (ret < 0) {
+	if (lock_tx(dev_data) < 0) {
 		return -ENOBUFS;
 	}
 
-	ret = spsc_pbuf_alloc(dev_data->tx_ib, requested_size, &allocated_buf);
+	ret = reserve_tx_buf(dev_data, requested_size, &tx_buf);
 	if (ret < 0) {
-		release_ret = release_tx_buffer(dev_data);
-		__ASSERT_NO_MSG(!release_ret);
+		unlock_tx(dev_data);
 		return ret;
 	}
-	allocated_len = ret;
 
-	if (*size == 0) {
-		/* Requested allocation of maximal size.
-		 * Pass the buffer that was allocated.
-		 */
-		*size = allocated_len;
-		*data = allocated_buf;
-		return 0;
+	if (ret == 0) {
+		/* No space left for any buffer */
+		unlock_tx(dev_data);
+		return *size == 0 ? -ENOBUFS : -ENOMEM;
 	}
 
-	if (*size == allocated_len) {
-		/* Allocated buffer is of requested size. */
-		*data = allocated_buf;
-		return 0;
+	if (*size != 0 && *size != ret) {
+		/* Allocated smaller buffer than requested.
+		 * Silently stop using the allocated buffer what is allowed by SPSC API
+		 */
+		unlock_tx(dev_data);
+		*size = ret;
+		return -ENOMEM;
 	}
 
-	/* Allocated smaller buffer than requested.
-	 * Silently stop using the allocated buffer what is allowed by SPSC API
-	 */
-	release_tx_buffer(dev_data);
-	*size = allocated_len;
-	return -ENOMEM;
+	dev_data->tx_count++;
+	unlock_tx(dev_data);
+
+	*size = ret;
+	*data = tx_buf->data;
+
+	return 0;
 }
 
 int icmsg_drop_tx_buffer(const struct icmsg_config_t *conf,
 			 struct icmsg_data_t *dev_data,
 			 const void *data)
 {
-	/* Silently stop using the allocated buffer what is allowed by SPSC API
-	 */
-	return release_tx_buffer(dev_data);
+	struct icmsg_tx_buf *tx_buf;
+	int ret = 0;
+
+	if (lock_tx(dev_data) < 0) {
+		return -EBUSY;
+	}
+
+	tx_buf = find_tx_buf(dev_data, data);
+	if (tx_buf == NULL || tx_buf->len != 0) {
+		ret = -EALREADY;
+	} else if (!is_last_tx_buf(dev_data, tx_buf)) {
+		/* The buffers reserved after this one follow it in the
+		 * shared memory, it cannot be given back.
+		 */
+		ret = -EBUSY;
+	} else {
+		/* Silently stop using the allocated buffer what is allowed by SPSC API
+		 */
+		dev_data->tx_count--;
+	}
+
+	unlock_tx(dev_data);
+
+	return ret;
 }
 
 int icmsg_send_nocopy(const struct icmsg_config_t *conf,
 		      struct icmsg_data_t *dev_data,
 		      const void *msg, size_t len)
 {
+	struct icmsg_tx_buf *tx_buf;
+	bool notify;
 	int ret;
-	int sent_bytes;
 
 	if (!is_endpoint_ready(dev_data)) {
 		return -EBUSY;
@@ -438,24 +560,44 @@ int icmsg_send_nocopy(const struct icmsg_config_t *conf,
 		return -ENODATA;
 	}
 
-	if (!is_tx_buffer_reserved(dev_data)) {
+	if (lock_tx(dev_data) < 0) {
+		return -EBUSY;
+	}
+
+	tx_buf = find_tx_buf(dev_data, msg);
+	if (tx_buf == NULL || tx_buf->len != 0) {
+		unlock_tx(dev_data);
 		return -ENXIO;
 	}
 
-	spsc_pbuf_commit(dev_data->tx_ib, len);
-	sent_bytes = len;
+	if (len > tx_buf->size) {
+		unlock_tx(dev_data);
+		return -EBADMSG;
+	}
 
-	ret = release_tx_buffer(dev_data);
-	__ASSERT_NO_MSG(!ret);
+	if (len < tx_buf->size) {
+		/* The buffers reserved after this one start at its end */
+		if (!is_last_tx_buf(dev_data, tx_buf)) {
+			unlock_tx(dev_data);
+			return -EINVAL;
+		}
 
-	__ASSERT_NO_MSG(conf->mbox_tx.dev != NULL);
+		tx_buf->size = len;
+	}
 
-	ret = mbox_send(&conf->mbox_tx, NULL);
-	if (ret) {
-		return ret;
+	tx_buf->len = len;
+
+	notify = commit_tx_bufs(dev_data);
+	unlock_tx(dev_data);
+
+	if (notify) {
+		ret = notify_remote(conf);
+		if (ret) {
+			return ret;
+		}
 	}
 
-	return sent_bytes;
+	return len;
 }
 
 #ifdef CONFIG_IPC_SERVICE_ICMSG_NOCOPY_RX
@@ -58,4 +58,24 @@ config LOG_BACKEND_FS_FILES_LIMIT
 	  Limit of number of files with logs. It is also limited by
 	  size of file system partition.
 
+config LOG_BACKEND_FS_COMPRESS
+	bool "Compressed dictionary log files"
+	depends on LOG_BACKEND_FS_OUTPUT_DICTIONARY
+	help
+	  When enabled, dictionary-based log messages are collected in RAM in
+	  blocks which are compressed and written to the log file as
+	  segments. This reduces the size of the log files and the number of
+	  flash writes. Messages still in the current block are lost on reset,
+	  the block is written when it is full or on panic. Log files are
+	  decoded with scripts/logging/dictionary/log_parser.py --fs-segments.
+
+config LOG_BACKEND_FS_COMPRESS_BLOCK_SIZE
+	int "Compression block size"
+	depends on LOG_BACKEND_FS_COMPRESS
+	default 512
+	range 64 4095
+	help
+	  Size of the block of log data compressed as one segment. It must
+	  fit in a log file together with the 12 bytes segment header.
+
 endif # LOG_BACKEND_FS
@@ -11,6 +11,7 @@
 #include <zephyr/logging/log_backend_std.h>
 #include <assert.h>
 #include <zephyr/fs/fs.h>
+#include <zephyr/sys/byteorder.h>
 
 #define MAX_PATH_LEN 256
 #define MAX_FLASH_WRITE_SIZE 256
@@ -451,8 +452,194 @@ BUILD_ASSERT(!IS_ENABLED(CONFIG_LOG_MODE_IMMEDIATE),
 
 #ifndef CONFIG_LOG_BACKEND_FS_TESTSUITE
 
+#if defined(CONFIG_LOG_BACKEND_FS_COMPRESS)
+/* Segments written to the log files when compression is enabled. Output of
+ * the dictionary formatter is collected in blocks, each block is compressed
+ * on its own and written to the file as one segment preceded by a header:
+ *
+ *	uint16_t magic;
+ *	uint8_t flags;
+ *	uint8_t reserved;
+ *	uint32_t index;
+ *	uint16_t raw_len;
+ *	uint16_t data_len;
+ *
+ * All fields are little endian. Index is incremented for every segment and
+ * starts from 0 on every boot. Blocks start on message boundaries so every
+ * segment can be decoded even if the preceding ones were rotated out.
+ *
+ * Compressed data is a sequence of groups of up to 8 items preceded by a
+ * control byte, bit n of which indicates if item n is a literal byte (0) or a
+ * back reference (1) encoded on 2 bytes: 12 bits of distance followed by
+ * 4 bits of length minus LZ_MIN_MATCH.
+ *
+ * Keep in sync with scripts/logging/dictionary/dictionary_parser/log_segment.py.
+ */
+#define SEGMENT_MAGIC 0x5a4c
+#define SEGMENT_FLAG_STORED BIT(0)
+#define SEGMENT_HDR_LEN 12
+#define BLOCK_SIZE CONFIG_LOG_BACKEND_FS_COMPRESS_BLOCK_SIZE
+
+#define LZ_MIN_MATCH 3
+#define LZ_MAX_MATCH (LZ_MIN_MATCH + 15)
+#define LZ_MAX_DISTANCE 4095
+#define LZ_HASH_BITS 8
+#define LZ_NO_POS UINT16_MAX
+
+BUILD_ASSERT(SEGMENT_HDR_LEN + BLOCK_SIZE <= CONFIG_LOG_BACKEND_FS_FILE_SIZE,
+	     "Compressed block does not fit in a log file.");
+
+static uint8_t block[BLOCK_SIZE];
+static size_t block_len;
+static uint32_t segment_index;
+static uint8_t __aligned(4) segment[SEGMENT_HDR_LEN + BLOCK_SIZE];
+static uint16_t lz_hash[BIT(LZ_HASH_BITS)];
+
+static inline uint32_t lz_hash_get(const uint8_t *data)
+{
+	uint32_t v = ((uint32_t)data[0] << 16) | ((uint32_t)data[1] << 8) | data[2];
+
+	return (v * 2654435761U) >> (32 - LZ_HASH_BITS);
+}
+
+/* Greedy LZ77 compression of a block. Returns compressed length or 0 if
+ * the result would not fit in @p dst_size bytes.
+ */
+static size_t lz_compress(const uint8_t *src, size_t len, uint8_t *dst,
+			  size_t dst_size)
+{
+	size_t in = 0;
+	size_t out = 0;
+	size_t ctrl = 0;
+	uint8_t item = 0;
+
+	memset(lz_hash, 0xff, sizeof(lz_hash));
+
+	while (in < len) {
+		size_t match_len = 0;
+		size_t distance = 0;
+
+		if (item == 0) {
+			if (out >= dst_size) {
+				return 0;
+			}
+			ctrl = out;
+			dst[out++] = 0;
+		}
+
+		if ((in + LZ_MIN_MATCH) <= len) {
+			uint32_t h = lz_hash_get(&src[in]);
+			uint16_t pos = lz_hash[h];
+
+			lz_hash[h] = in;
+			if ((pos != LZ_NO_POS) && ((in - pos) <= LZ_MAX_DISTANCE)) {
+				size_t max = MIN(LZ_MAX_MATCH, len - in);
+
+				while ((match_len < max) &&
+				       (src[pos + match_len] == src[in + match_len])) {
+					match_len++;
+				}
+				distance = in - pos;
+			}
+		}
+
+		if (match_len >= LZ_MIN_MATCH) {
+			if ((out + 2) > dst_size) {
+				return 0;
+			}
+			dst[ctrl] |= BIT(item);
+			dst[out++] = distance & 0xff;
+			dst[out++] = ((distance >> 8) & 0x0f) |
+				     ((match_len - LZ_MIN_MATCH) << 4);
+			in += match_len;
+		} else {
+			if (out >= dst_size) {
+				return 0;
+			}
+			dst[out++] = src[in++];
+		}
+
+		item = (item + 1) % 8;
+	}
+
+	return out;
+}
+
+static void block_flush(void)
+{
+	uint8_t *data = segment;
+	uint8_t flags = 0;
+	size_t len;
+	int processed;
+
+	if (block_len == 0) {
+		return;
+	}
+
+	len = lz_compress(block, block_len, &segment[SEGMENT_HDR_LEN], block_len - 1);
+	if (len == 0) {
+		memcpy(&segment[SEGMENT_HDR_LEN], block, block_len);
+		len = block_len;
+		flags = SEGMENT_FLAG_STORED;
+	}
+
+	sys_put_le16(SEGMENT_MAGIC, &segment[0]);
+	segment[2] = flags;
+	segment[3] = 0;
+	sys_put_le32(segment_index, &segment[4]);
+	sys_put_le16(block_len, &segment[8]);
+	sys_put_le16(len, &segment[10]);
+
+	len += SEGMENT_HDR_LEN;
+	do {
+		processed = write_log_to_file(data, len, NULL);
+		len -= processed;
+		data += processed;
+	} while (len != 0);
+
+	segment_index++;
+	block_len = 0;
+}
+
+static int write_log_compressed(uint8_t *data, size_t length, void *ctx)
+{
+	size_t len = MIN(length, BLOCK_SIZE - block_len);
+
+	ARG_UNUSED(ctx);
+
+	memcpy(&block[block_len], data, len);
+	block_len += len;
+	if (block_len == BLOCK_SIZE) {
+		block_flush();
+	}
+
+	return len;
+}
+
+/* Start a new block if the message would not fit in the current one. */
+static void block_reserve(struct log_msg *msg)
+{
+	size_t len = sizeof(struct log_dict_output_normal_msg_hdr_t) +
+		     msg->hdr.desc.package_len + msg->hdr.desc.data_len;
+
+	if ((block_len + len) > BLOCK_SIZE) {
+		block_flush();
+	}
+}
+
+#define LOG_OUTPUT_FUNC write_log_compressed
+#else
+static inline void block_flush(void) {}
+static inline void block_reserve(struct log_msg *msg)
+{
+	ARG_UNUSED(msg);
+}
+
+#define LOG_OUTPUT_FUNC write_log_to_file
+#endif /* CONFIG_LOG_BACKEND_FS_COMPRESS */
+
 static uint8_t __aligned(4) buf[MAX_FLASH_WRITE_SIZE];
-LOG_OUTPUT_DEFINE(log_output, write_log_to_file, buf, MAX_FLASH_WRITE_SIZE);
+LOG_OUTPUT_DEFINE(log_output, LOG_OUTPUT_FUNC, buf, MAX_FLASH_WRITE_SIZE);
 
 static void log_backend_fs_init(const struct log_backend *const backend)
 {
@@ -463,6 +650,7 @@ static void panic(struct log_backend const *const backend)
 	/* In case of panic deinitialize backend. It is better to keep
 	 * current data rather than log new and risk of failure.
 	 */
+	block_flush();
 	log_backend_deactivate(backend);
 }
 
@@ -484,6 +672,7 @@ static void process(const struct log_backend *const backend,
 
 	log_format_func_t log_output_func = log_format_func_t_get(log_format_current);
 
+	block_reserve(&msg->log);
 	log_output_func(&log_output, &msg->log, flags);
 }
 
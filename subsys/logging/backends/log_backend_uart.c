@@ -116,6 +116,16 @@ static void process(const struct log_backend *const backend,
 	log_output_func(&log_output_uart, &msg->log, flags);
 }
 
+static void process_batch(const struct log_backend *const backend,
+			  union log_msg_generic **msgs, size_t count)
+{
+	uint32_t flags = log_backend_std_get_flags();
+
+	log_format_func_t log_output_func = log_format_func_t_get(log_format_current);
+
+	log_backend_std_batch_process(&log_output_uart, log_output_func, msgs, count, flags);
+}
+
 static int format_set(const struct log_backend *const backend, uint32_t log_type)
 {
 	log_format_current = log_type;
@@ -191,6 +201,7 @@ static void dropped(const struct log_backend *const backend, uint32_t cnt)
 
 const struct log_backend_api log_backend_uart_api = {
 	.process = process,
+	.process_batch = process_batch,
 	.panic = panic,
 	.init = log_backend_uart_init,
 	.dropped = IS_ENABLED(CONFIG_LOG_MODE_IMMEDIATE) ? NULL : dropped,
@@ -382,6 +382,31 @@ static int cmd_log_mem(const struct shell *sh, size_t argc, char **argv)
 	return 0;
 }
 
+static int cmd_log_ratelimit(const struct shell *sh, size_t argc, char **argv)
+{
+	shell_print(sh, "%-40s | line  | level | suppressed", "module");
+	shell_print(sh, "----------------------------------------------------------------");
+
+	STRUCT_SECTION_FOREACH(log_ratelimit_site, site) {
+		const void *source = site->source;
+		uint32_t source_id;
+
+		if ((source == NULL) || (site->suppressed == 0U)) {
+			continue;
+		}
+
+		source_id = IS_ENABLED(CONFIG_LOG_RUNTIME_FILTERING) ?
+			log_dynamic_source_id((struct log_source_dynamic_data *)source) :
+			log_const_source_id(source);
+
+		shell_print(sh, "%-40s | %-5u | %-5s | %u",
+			    log_source_name_get(Z_LOG_LOCAL_DOMAIN_ID, source_id),
+			    site->line, severity_lvls[site->level], site->suppressed);
+	}
+
+	return 0;
+}
+
 SHELL_STATIC_SUBCMD_SET_CREATE(sub_log_backend,
 	SHELL_CMD_ARG(disable, &dsub_module_name,
 		  "'log disable <module_0> .. <module_n>' disables logs in "
@@ -438,6 +463,8 @@ SHELL_STATIC_SUBCMD_SET_CREATE(
 		       cmd_log_self_status),
 	SHELL_COND_CMD(CONFIG_LOG_MODE_DEFERRED, mem, NULL, "Logger memory usage",
 		       cmd_log_mem),
+	SHELL_COND_CMD(CONFIG_LOG_RATELIMIT_SITE, ratelimit, NULL,
+		       "Messages suppressed per call site", cmd_log_ratelimit),
 	SHELL_SUBCMD_SET_END);
 
 SHELL_CMD_REGISTER(log, &sub_log_stat, "Commands for controlling logger",
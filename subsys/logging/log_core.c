@@ -45,6 +45,10 @@ LOG_MODULE_REGISTER(log);
 #define CONFIG_LOG_PROCESSING_LATENCY_US 0
 #endif
 
+#ifndef CONFIG_LOG_PROCESS_BATCH_SIZE
+#define CONFIG_LOG_PROCESS_BATCH_SIZE 1
+#endif
+
 #ifndef CONFIG_LOG_BUFFER_SIZE
 #define CONFIG_LOG_BUFFER_SIZE 4
 #endif
@@ -132,6 +136,61 @@ static const struct mpsc_pbuf_buffer_config mpsc_config = {
 };
 #endif
 
+#ifdef CONFIG_LOG_BUFFER_PER_CPU
+/* CPU 0 uses log_buffer, other CPUs get a dedicated buffer each. Buffers are
+ * registered in the same iterable sections as link buffers so that messages
+ * are claimed in timestamp order by z_log_msg_claim_oldest().
+ */
+#define LOG_CPU_BUFFER_DEFINE(i, _) \
+	static STRUCT_SECTION_ITERABLE(log_msg_ptr, log_msg_ptr_cpu_##i); \
+	static STRUCT_SECTION_ITERABLE_ALTERNATE(log_mpsc_pbuf, mpsc_pbuf_buffer, \
+						 log_buffer_cpu_##i); \
+	static uint32_t __aligned(Z_LOG_MSG_ALIGNMENT) \
+		buf32_cpu_##i[CONFIG_LOG_BUFFER_SIZE / sizeof(int)]
+
+#define LOG_CPU_BUFFER_PTR(i, _) &log_buffer_cpu_##i
+#define LOG_CPU_BUF32_PTR(i, _) buf32_cpu_##i
+
+LISTIFY(UTIL_DEC(CONFIG_MP_MAX_NUM_CPUS), LOG_CPU_BUFFER_DEFINE, (;));
+
+static struct mpsc_pbuf_buffer *const cpu_log_buffer[] = {
+	&log_buffer,
+	LISTIFY(UTIL_DEC(CONFIG_MP_MAX_NUM_CPUS), LOG_CPU_BUFFER_PTR, (,))
+};
+
+static uint32_t *const cpu_buf32[] = {
+	buf32,
+	LISTIFY(UTIL_DEC(CONFIG_MP_MAX_NUM_CPUS), LOG_CPU_BUF32_PTR, (,))
+};
+
+BUILD_ASSERT(ARRAY_SIZE(cpu_log_buffer) == CONFIG_MP_MAX_NUM_CPUS);
+
+/* Buffer of the CPU the caller runs on. The caller may migrate afterwards,
+ * which is harmless as buffers accept concurrent producers.
+ */
+static struct mpsc_pbuf_buffer *cpu_buffer_get(void)
+{
+	return cpu_log_buffer[arch_curr_cpu()->id];
+}
+
+/* Buffer a message was allocated from. */
+static struct mpsc_pbuf_buffer *msg_buffer_get(const struct log_msg *msg)
+{
+	const uint32_t *addr = (const uint32_t *)msg;
+
+	for (size_t i = 0; i < ARRAY_SIZE(cpu_buf32); i++) {
+		if (addr >= cpu_buf32[i] && addr < &cpu_buf32[i][ARRAY_SIZE(buf32)]) {
+			return cpu_log_buffer[i];
+		}
+	}
+
+	return &log_buffer;
+}
+#else
+#define cpu_buffer_get() (&log_buffer)
+#define msg_buffer_get(msg) (&log_buffer)
+#endif /* CONFIG_LOG_BUFFER_PER_CPU */
+
 /* Check that default tag can fit in tag buffer. */
 COND_CODE_0(CONFIG_LOG_TAG_MAX_LEN, (),
 	(BUILD_ASSERT(sizeof(CONFIG_LOG_TAG_DEFAULT) <= CONFIG_LOG_TAG_MAX_LEN + 1,
@@ -141,6 +200,7 @@ static char tag[CONFIG_LOG_TAG_MAX_LEN + 1] =
 	COND_CODE_0(CONFIG_LOG_TAG_MAX_LEN, ({}), (CONFIG_LOG_TAG_DEFAULT));
 
 static void msg_process(union log_msg_generic *msg);
+static void msg_free(struct mpsc_pbuf_buffer *buffer, const union log_msg_generic *msg);
 
 static log_timestamp_t dummy_timestamp(void)
 {
@@ -488,6 +548,59 @@ void z_log_notify_backend_enabled(void)
 	backend_attached = true;
 }
 
+/* Claim up to CONFIG_LOG_PROCESS_BATCH_SIZE messages and pass them to the
+ * backends at once. Returns the number of processed messages.
+ */
+static size_t msg_batch_process(k_timeout_t *backoff)
+{
+	union log_msg_generic *msgs[CONFIG_LOG_PROCESS_BATCH_SIZE];
+	struct mpsc_pbuf_buffer *buffers[CONFIG_LOG_PROCESS_BATCH_SIZE];
+	size_t count = 0;
+
+	while (count < ARRAY_SIZE(msgs)) {
+		msgs[count] = z_log_msg_claim(backoff);
+		if (msgs[count] == NULL) {
+			break;
+		}
+
+		/* Messages may come from different buffers */
+		buffers[count] = curr_log_buffer;
+		count++;
+	}
+
+	if (count == 0) {
+		return 0;
+	}
+
+	atomic_sub(&buffered_cnt, count);
+
+	STRUCT_SECTION_FOREACH(log_backend, backend) {
+		union log_msg_generic *accepted[CONFIG_LOG_PROCESS_BATCH_SIZE];
+		size_t accepted_cnt = 0;
+
+		if (!log_backend_is_active(backend)) {
+			continue;
+		}
+
+		for (size_t i = 0; i < count; i++) {
+			if (msg_filter_check(backend, msgs[i])) {
+				accepted[accepted_cnt++] = msgs[i];
+			}
+		}
+
+		if (accepted_cnt > 0) {
+			log_backend_msg_batch_process(backend, accepted, accepted_cnt);
+		}
+	}
+
+	/* Free in claim order */
+	for (size_t i = 0; i < count; i++) {
+		msg_free(buffers[i], msgs[i]);
+	}
+
+	return count;
+}
+
 static inline bool z_log_unordered_pending(void)
 {
 	return IS_ENABLED(CONFIG_LOG_MULTIDOMAIN) && unordered_cnt;
@@ -501,18 +614,27 @@ bool z_impl_log_process(void)
 
 	k_timeout_t backoff = K_NO_WAIT;
 	union log_msg_generic *msg;
+	bool processed;
 
 	if (!backend_attached) {
 		return false;
 	}
 
-	msg = z_log_msg_claim(&backoff);
+	if (CONFIG_LOG_PROCESS_BATCH_SIZE > 1) {
+		processed = msg_batch_process(&backoff) > 0;
+	} else {
+		msg = z_log_msg_claim(&backoff);
+		processed = msg != NULL;
 
-	if (msg) {
-		atomic_dec(&buffered_cnt);
-		msg_process(msg);
-		z_log_msg_free(msg);
-	} else if (CONFIG_LOG_PROCESSING_LATENCY_US > 0 && !K_TIMEOUT_EQ(backoff, K_NO_WAIT)) {
+		if (msg) {
+			atomic_dec(&buffered_cnt);
+			msg_process(msg);
+			z_log_msg_free(msg);
+		}
+	}
+
+	if (!processed && CONFIG_LOG_PROCESSING_LATENCY_US > 0 &&
+	    !K_TIMEOUT_EQ(backoff, K_NO_WAIT)) {
 		/* If backoff is requested, it means that there are pending
 		 * messages but they are too new and processing shall back off
 		 * to allow arrival of newer messages from remote domains.
@@ -588,6 +710,14 @@ void z_log_msg_init(void)
 	mpsc_pbuf_init(&log_buffer, &mpsc_config);
 	curr_log_buffer = &log_buffer;
 #endif
+#ifdef CONFIG_LOG_BUFFER_PER_CPU
+	for (size_t i = 1; i < ARRAY_SIZE(cpu_log_buffer); i++) {
+		struct mpsc_pbuf_buffer_config config = mpsc_config;
+
+		config.buf = cpu_buf32[i];
+		mpsc_pbuf_init(cpu_log_buffer[i], &config);
+	}
+#endif
 }
 
 static struct log_msg *msg_alloc(struct mpsc_pbuf_buffer *buffer, uint32_t wlen)
@@ -602,7 +732,7 @@ static struct log_msg *msg_alloc(struct mpsc_pbuf_buffer *buffer, uint32_t wlen)
 
 struct log_msg *z_log_msg_alloc(uint32_t wlen)
 {
-	return msg_alloc(&log_buffer, wlen);
+	return msg_alloc(cpu_buffer_get(), wlen);
 }
 
 static void msg_commit(struct mpsc_pbuf_buffer *buffer, struct log_msg *msg)
@@ -624,7 +754,7 @@ static void msg_commit(struct mpsc_pbuf_buffer *buffer, struct log_msg *msg)
 void z_log_msg_commit(struct log_msg *msg)
 {
 	msg->hdr.timestamp = timestamp_func();
-	msg_commit(&log_buffer, msg);
+	msg_commit(msg_buffer_get(msg), msg);
 }
 
 union log_msg_generic *z_log_msg_local_claim(void)
@@ -711,7 +841,8 @@ union log_msg_generic *z_log_msg_claim(k_timeout_t *backoff)
 	STRUCT_SECTION_COUNT(log_mpsc_pbuf, &len);
 
 	/* Use only one buffer if others are not registered. */
-	if (IS_ENABLED(CONFIG_LOG_MULTIDOMAIN) && len > 1) {
+	if ((IS_ENABLED(CONFIG_LOG_MULTIDOMAIN) || IS_ENABLED(CONFIG_LOG_BUFFER_PER_CPU)) &&
+	    len > 1) {
 		return z_log_msg_claim_oldest(backoff);
 	}
 
@@ -746,7 +877,8 @@ bool z_log_msg_pending(void)
 
 	STRUCT_SECTION_COUNT(log_mpsc_pbuf, &len);
 
-	if (!IS_ENABLED(CONFIG_LOG_MULTIDOMAIN) || (len == 1)) {
+	if ((!IS_ENABLED(CONFIG_LOG_MULTIDOMAIN) && !IS_ENABLED(CONFIG_LOG_BUFFER_PER_CPU)) ||
+	    (len == 1)) {
 		return msg_pending(&log_buffer);
 	}
 
@@ -826,7 +958,21 @@ int log_mem_get_usage(uint32_t *buf_size, uint32_t *usage)
 		return -EINVAL;
 	}
 
+#ifdef CONFIG_LOG_BUFFER_PER_CPU
+	*buf_size = 0;
+	*usage = 0;
+
+	for (size_t i = 0; i < ARRAY_SIZE(cpu_log_buffer); i++) {
+		uint32_t size;
+		uint32_t used;
+
+		mpsc_pbuf_get_utilization(cpu_log_buffer[i], &size, &used);
+		*buf_size += size;
+		*usage += used;
+	}
+#else
 	mpsc_pbuf_get_utilization(&log_buffer, buf_size, usage);
+#endif
 
 	return 0;
 }
@@ -839,7 +985,26 @@ int log_mem_get_max_usage(uint32_t *max)
 		return -EINVAL;
 	}
 
+#ifdef CONFIG_LOG_BUFFER_PER_CPU
+	*max = 0;
+
+	/* Sum of the per buffer maximums, an upper bound of the total */
+	for (size_t i = 0; i < ARRAY_SIZE(cpu_log_buffer); i++) {
+		uint32_t buf_max;
+		int err;
+
+		err = mpsc_pbuf_get_max_utilization(cpu_log_buffer[i], &buf_max);
+		if (err < 0) {
+			return err;
+		}
+
+		*max += buf_max;
+	}
+
+	return 0;
+#else
 	return mpsc_pbuf_get_max_utilization(&log_buffer, max);
+#endif
 }
 
 static void log_backend_notify_all(enum log_backend_evt event,
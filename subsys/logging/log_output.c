@@ -14,6 +14,7 @@
 #include <time.h>
 #include <stdio.h>
 #include <stdbool.h>
+#include <string.h>
 
 #define LOG_COLOR_CODE_DEFAULT "\x1B[0m"
 #define LOG_COLOR_CODE_RED     "\x1B[1;31m"
@@ -36,6 +37,15 @@ static const char *const severity[] = {
 	"dbg"
 };
 
+/* Level prefixes emitted with a single copy by the fast formatter. */
+static const char *const severity_prefix[] = {
+	NULL,
+	"<err> ",
+	"<wrn> ",
+	"<inf> ",
+	"<dbg> "
+};
+
 static const char *const colors[] = {
 	NULL,
 	LOG_COLOR_CODE_RED,     /* err */
@@ -169,6 +179,37 @@ void log_output_flush(const struct log_output *output)
 	output->control_block->offset = 0;
 }
 
+/* Copy a block of data to the output buffer, flushing it whenever it fills. */
+static int out_str(const struct log_output *output, const char *str, size_t len)
+{
+	struct log_output_control_block *cb = output->control_block;
+	size_t rem = len;
+	size_t chunk;
+
+	while (rem != 0) {
+		if (cb->offset == output->size) {
+			log_output_flush(output);
+		}
+
+		chunk = MIN(rem, output->size - cb->offset);
+		memcpy(&output->buf[cb->offset], str, chunk);
+		atomic_add(&cb->offset, chunk);
+		str += chunk;
+		rem -= chunk;
+	}
+
+	return (int)len;
+}
+
+/* Render @p val as exactly @p digits zero padded decimal digits. */
+static void __attribute__((unused)) dec_fill(char *dst, uint32_t val, size_t digits)
+{
+	while (digits-- > 0) {
+		dst[digits] = '0' + (val % 10U);
+		val /= 10U;
+	}
+}
+
 static inline bool is_leap_year(uint32_t year)
 {
 	return (((year % 4 == 0) && (year % 100 != 0)) || (year % 400 == 0));
@@ -209,6 +250,108 @@ static void __attribute__((unused)) get_YMD_from_seconds(uint64_t seconds,
 	output_date->day += seconds / SECONDS_IN_DAY;
 }
 
+enum timestamp_kind {
+	TIMESTAMP_KIND_HMS = 1,
+	TIMESTAMP_KIND_LINUX,
+	TIMESTAMP_KIND_SYSLOG,
+};
+
+#if defined(CONFIG_LOG_OUTPUT_FAST_FORMAT)
+/* Render the seconds part of a formatted timestamp into the cache of the
+ * output. It only changes once per second so messages logged within the same
+ * second only need their sub-second digits rendered.
+ */
+static void timestamp_cache_update(struct log_output_control_block *cb,
+				   uint8_t kind, log_timestamp_t total_seconds,
+				   uint32_t hours, uint32_t mins, uint32_t seconds)
+{
+	int len;
+
+	if (kind == TIMESTAMP_KIND_SYSLOG) {
+#if defined(CONFIG_NEWLIB_LIBC)
+		struct tm *tm;
+		time_t time = total_seconds;
+
+		tm = gmtime(&time);
+		len = strftime(cb->ts_str, sizeof(cb->ts_str), "%FT%T", tm);
+#else
+		struct YMD_date date;
+
+		get_YMD_from_seconds(total_seconds, &date);
+		len = snprintk(cb->ts_str, sizeof(cb->ts_str),
+			       "%04u-%02u-%02uT%02u:%02u:%02u",
+			       date.year, date.month, date.day,
+			       hours % 24, mins, seconds);
+#endif
+	} else if (kind == TIMESTAMP_KIND_LINUX) {
+#if defined(CONFIG_LOG_TIMESTAMP_64BIT)
+		len = snprintk(cb->ts_str, sizeof(cb->ts_str), "[%5llu", total_seconds);
+#else
+		len = snprintk(cb->ts_str, sizeof(cb->ts_str), "[%5lu", total_seconds);
+#endif
+	} else {
+		len = snprintk(cb->ts_str, sizeof(cb->ts_str), "[%02u:%02u:%02u",
+			       hours, mins, seconds);
+	}
+
+	cb->ts_len = CLAMP(len, 0, (int)sizeof(cb->ts_str) - 1);
+	cb->ts_sec = total_seconds;
+	cb->ts_kind = kind;
+}
+
+static int timestamp_fast_print(const struct log_output *output, uint8_t kind,
+				log_timestamp_t total_seconds, uint32_t hours,
+				uint32_t mins, uint32_t seconds, uint32_t ms,
+				uint32_t us)
+{
+	struct log_output_control_block *cb = output->control_block;
+	char str[sizeof(cb->ts_str) + sizeof(".000,000] ")];
+	size_t len;
+
+	if ((cb->ts_kind != kind) || (cb->ts_sec != total_seconds)) {
+		timestamp_cache_update(cb, kind, total_seconds, hours, mins, seconds);
+	}
+
+	memcpy(str, cb->ts_str, cb->ts_len);
+	len = cb->ts_len;
+	str[len++] = '.';
+
+	if (kind == TIMESTAMP_KIND_HMS) {
+		dec_fill(&str[len], ms, 3);
+		len += 3;
+		str[len++] = ',';
+		dec_fill(&str[len], us, 3);
+		len += 3;
+		str[len++] = ']';
+	} else {
+		dec_fill(&str[len], ms * 1000U + us, 6);
+		len += 6;
+		str[len++] = (kind == TIMESTAMP_KIND_SYSLOG) ? 'Z' : ']';
+	}
+
+	str[len++] = ' ';
+
+	return out_str(output, str, len);
+}
+#else
+static inline int timestamp_fast_print(const struct log_output *output, uint8_t kind,
+				       log_timestamp_t total_seconds, uint32_t hours,
+				       uint32_t mins, uint32_t seconds, uint32_t ms,
+				       uint32_t us)
+{
+	ARG_UNUSED(output);
+	ARG_UNUSED(kind);
+	ARG_UNUSED(total_seconds);
+	ARG_UNUSED(hours);
+	ARG_UNUSED(mins);
+	ARG_UNUSED(seconds);
+	ARG_UNUSED(ms);
+	ARG_UNUSED(us);
+
+	return 0;
+}
+#endif /* CONFIG_LOG_OUTPUT_FAST_FORMAT */
+
 static int timestamp_print(const struct log_output *output,
 			   uint32_t flags, log_timestamp_t timestamp)
 {
@@ -253,6 +396,18 @@ static int timestamp_print(const struct log_output *output,
 
 		if (IS_ENABLED(CONFIG_LOG_OUTPUT_FORMAT_CUSTOM_TIMESTAMP)) {
 			length = log_custom_timestamp_print(output, timestamp, print_formatted);
+		} else if (IS_ENABLED(CONFIG_LOG_OUTPUT_FAST_FORMAT)) {
+			uint8_t kind = TIMESTAMP_KIND_HMS;
+
+			if (IS_ENABLED(CONFIG_LOG_BACKEND_NET) &&
+			    flags & LOG_OUTPUT_FLAG_FORMAT_SYSLOG) {
+				kind = TIMESTAMP_KIND_SYSLOG;
+			} else if (IS_ENABLED(CONFIG_LOG_OUTPUT_FORMAT_LINUX_TIMESTAMP)) {
+				kind = TIMESTAMP_KIND_LINUX;
+			}
+
+			length = timestamp_fast_print(output, kind, total_seconds,
+						      hours, mins, seconds, ms, us);
 		} else if (IS_ENABLED(CONFIG_LOG_BACKEND_NET) &&
 			   flags & LOG_OUTPUT_FLAG_FORMAT_SYSLOG) {
 #if defined(CONFIG_NEWLIB_LIBC)
@@ -305,7 +460,12 @@ static void color_print(const struct log_output *output,
 	if (color) {
 		const char *log_color = start && (colors[level] != NULL) ?
 				colors[level] : LOG_COLOR_CODE_DEFAULT;
-		print_formatted(output, "%s", log_color);
+
+		if (IS_ENABLED(CONFIG_LOG_OUTPUT_FAST_FORMAT)) {
+			out_str(output, log_color, strlen(log_color));
+		} else {
+			print_formatted(output, "%s", log_color);
+		}
 	}
 }
 
@@ -322,6 +482,61 @@ static void color_postfix(const struct log_output *output,
 }
 
 
+#if defined(CONFIG_LOG_OUTPUT_FAST_FORMAT)
+/* Length of the source name, the last one is cached as consecutive messages
+ * usually come from the same source.
+ */
+static size_t source_len_get(const struct log_output *output, const char *source)
+{
+	struct log_output_control_block *cb = output->control_block;
+
+	if (cb->source != source) {
+		cb->source = source;
+		cb->source_len = strlen(source);
+	}
+
+	return cb->source_len;
+}
+#else
+static inline size_t source_len_get(const struct log_output *output, const char *source)
+{
+	ARG_UNUSED(output);
+
+	return strlen(source);
+}
+#endif /* CONFIG_LOG_OUTPUT_FAST_FORMAT */
+
+static int ids_fast_print(const struct log_output *output,
+			  bool level_on,
+			  bool func_on,
+			  const char *domain,
+			  const char *source,
+			  uint32_t level)
+{
+	int total = 0;
+
+	if (level_on) {
+		total += out_str(output, severity_prefix[level], sizeof("<err> ") - 1);
+	}
+
+	if (domain) {
+		total += out_str(output, domain, strlen(domain));
+		total += out_str(output, "/", 1);
+	}
+
+	if (source) {
+		total += out_str(output, source, source_len_get(output, source));
+
+		if (func_on && ((1 << level) & LOG_FUNCTION_PREFIX_MASK)) {
+			total += out_str(output, ".", 1);
+		} else {
+			total += out_str(output, ": ", 2);
+		}
+	}
+
+	return total;
+}
+
 static int ids_print(const struct log_output *output,
 		     bool level_on,
 		     bool func_on,
@@ -331,6 +546,11 @@ static int ids_print(const struct log_output *output,
 {
 	int total = 0;
 
+	if (IS_ENABLED(CONFIG_LOG_OUTPUT_FAST_FORMAT) &&
+	    (!level_on || severity_prefix[level] != NULL)) {
+		return ids_fast_print(output, level_on, func_on, domain, source, level);
+	}
+
 	if (level_on) {
 		total += print_formatted(output, "<%s> ", severity[level]);
 	}
@@ -361,7 +581,13 @@ static void newline_print(const struct log_output *ctx, uint32_t flags)
 		return;
 	}
 
-	if ((flags & LOG_OUTPUT_FLAG_CRLF_LFONLY) != 0U) {
+	if (IS_ENABLED(CONFIG_LOG_OUTPUT_FAST_FORMAT)) {
+		if ((flags & LOG_OUTPUT_FLAG_CRLF_LFONLY) != 0U) {
+			out_str(ctx, "\n", 1);
+		} else {
+			out_str(ctx, "\r\n", 2);
+		}
+	} else if ((flags & LOG_OUTPUT_FLAG_CRLF_LFONLY) != 0U) {
 		print_formatted(ctx, "\n");
 	} else {
 		print_formatted(ctx, "\r\n");
@@ -457,7 +683,12 @@ static uint32_t prefix_print(const struct log_output *output,
 	}
 
 	if (tag) {
-		length += print_formatted(output, "%s ", tag);
+		if (IS_ENABLED(CONFIG_LOG_OUTPUT_FAST_FORMAT)) {
+			length += out_str(output, tag, strlen(tag));
+			length += out_str(output, " ", 1);
+		} else {
+			length += print_formatted(output, "%s ", tag);
+		}
 	}
 
 	if (stamp) {
@@ -529,7 +760,9 @@ void log_output_process(const struct log_output *output,
 		postfix_print(output, flags, level);
 	}
 
-	log_output_flush(output);
+	if (!(flags & LOG_OUTPUT_FLAG_SKIP_FLUSH)) {
+		log_output_flush(output);
+	}
 }
 
 void log_output_msg_process(const struct log_output *output,
@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+#include <zephyr/logging/log_core.h>
+#include <zephyr/kernel.h>
+#include <zephyr/spinlock.h>
+
+#define BURST CONFIG_LOG_RATELIMIT_SITE_BURST
+#define INTERVAL CONFIG_LOG_RATELIMIT_SITE_INTERVAL_MS
+
+static struct k_spinlock lock;
+
+static void site_refill(struct log_ratelimit_site *site, uint32_t now)
+{
+	uint32_t tokens = (now - site->last) / INTERVAL;
+
+	if (tokens == 0) {
+		return;
+	}
+
+	if ((site->tokens + tokens) >= BURST) {
+		site->tokens = BURST;
+		site->last = now;
+	} else {
+		site->tokens += tokens;
+		site->last += tokens * INTERVAL;
+	}
+}
+
+bool z_log_ratelimit_site_check(struct log_ratelimit_site *site,
+				const void *source, uint8_t level)
+{
+	uint32_t now = k_uptime_get_32();
+	uint32_t pending = 0;
+	k_spinlock_key_t key;
+	bool allowed;
+
+	key = k_spin_lock(&lock);
+
+	if (site->source == NULL) {
+		site->source = source;
+		site->level = level;
+		site->tokens = BURST;
+		site->last = now;
+	} else {
+		site_refill(site, now);
+	}
+
+	if (site->tokens > 0) {
+		site->tokens--;
+		pending = site->pending;
+		site->pending = 0;
+		allowed = true;
+	} else {
+		site->pending++;
+		site->suppressed++;
+		allowed = false;
+	}
+
+	k_spin_unlock(&lock, key);
+
+	if (pending > 0) {
+		z_log_msg_runtime_create(Z_LOG_LOCAL_DOMAIN_ID, source, level,
+					 NULL, 0, 0,
+					 "--- %u messages suppressed ---", pending);
+	}
+
+	return allowed;
+}
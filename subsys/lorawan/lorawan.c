@@ -543,8 +543,8 @@ int lorawan_set_conf_msg_tries(uint8_t tries)
 	return 0;
 }
 
-int lorawan_send(uint8_t port, uint8_t *data, uint8_t len,
-		 enum lorawan_message_type type)
+int lorawan_send_frame(uint8_t port, uint8_t *data, uint8_t len,
+		       enum lorawan_message_type type, uint32_t *dc_wait_ms)
 {
 	LoRaMacStatus_t status;
 	McpsReq_t mcps_req;
@@ -593,6 +593,9 @@ int lorawan_send(uint8_t port, uint8_t *data, uint8_t len,
 	status = LoRaMacMcpsRequest(&mcps_req);
 	if (status != LORAMAC_STATUS_OK) {
 		LOG_ERR("LoRaWAN Send failed: %s", lorawan_status2str(status));
+		if (status == LORAMAC_STATUS_DUTYCYCLE_RESTRICTED && dc_wait_ms != NULL) {
+			*dc_wait_ms = mcps_req.ReqReturn.DutyCycleWaitTime;
+		}
 		ret = lorawan_status2errno(status);
 		goto out;
 	}
@@ -621,6 +624,12 @@ out:
 	return ret;
 }
 
+int lorawan_send(uint8_t port, uint8_t *data, uint8_t len,
+		 enum lorawan_message_type type)
+{
+	return lorawan_send_frame(port, data, len, type, NULL);
+}
+
 int lorawan_set_battery_level_callback(uint8_t (*battery_lvl_cb)(void))
 {
 	if (battery_lvl_cb == NULL) {
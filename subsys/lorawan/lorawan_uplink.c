@@ -0,0 +1,252 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/lorawan/lorawan.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/slist.h>
+
+#include "lw_priv.h"
+
+LOG_MODULE_REGISTER(lorawan_uplink, CONFIG_LORAWAN_LOG_LEVEL);
+
+/* Largest application payload of all regions and datarates */
+#define FRAME_SIZE_MAX 242
+
+/* Delay before trying again while the stack is busy */
+#define BUSY_RETRY_DELAY K_SECONDS(1)
+
+struct uplink_msg {
+	sys_snode_t node;
+	lorawan_uplink_cb_t cb;
+	void *user_data;
+	/* uptime in ms when the message was queued */
+	int64_t queued;
+	enum lorawan_message_type type;
+	uint8_t port;
+	uint8_t len;
+	uint8_t data[CONFIG_LORAWAN_UPLINK_QUEUE_MSG_SIZE];
+};
+
+K_THREAD_STACK_DEFINE(uplink_stack_area, CONFIG_LORAWAN_UPLINK_QUEUE_THREAD_STACK_SIZE);
+
+/*
+ * lorawan_send() blocks until the end of the receive windows, and the
+ * LoRaWAN stack itself runs from the system work queue, so the frames are
+ * sent from a dedicated work queue.
+ */
+static struct k_work_q uplink_workq;
+static struct k_work_delayable uplink_work;
+
+static struct uplink_msg messages[CONFIG_LORAWAN_UPLINK_QUEUE_SIZE];
+static sys_slist_t free_list;
+static sys_slist_t msg_list;
+static struct k_spinlock lock;
+
+/* Move the messages making up the next frame from msg_list to batch */
+static uint8_t batch_get(sys_slist_t *batch, uint8_t *frame, uint8_t max_len)
+{
+	struct uplink_msg *first, *msg, *next;
+	sys_snode_t *prev = NULL;
+	uint8_t len;
+
+	first = SYS_SLIST_PEEK_HEAD_CONTAINER(&msg_list, first, node);
+	if (first == NULL) {
+		return 0;
+	}
+
+	(void)sys_slist_get(&msg_list);
+	sys_slist_append(batch, &first->node);
+	memcpy(frame, first->data, first->len);
+	len = first->len;
+
+	if (!IS_ENABLED(CONFIG_LORAWAN_UPLINK_QUEUE_AGGREGATE)) {
+		return len;
+	}
+
+	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&msg_list, msg, next, node) {
+		if (msg->port != first->port || msg->type != first->type ||
+		    len + msg->len > max_len) {
+			prev = &msg->node;
+			continue;
+		}
+
+		sys_slist_remove(&msg_list, prev, &msg->node);
+		sys_slist_append(batch, &msg->node);
+		memcpy(frame + len, msg->data, msg->len);
+		len += msg->len;
+	}
+
+	return len;
+}
+
+static void batch_done(sys_slist_t *batch, uint8_t port, int status)
+{
+	int64_t now = k_uptime_get();
+	struct uplink_msg *msg;
+	k_spinlock_key_t key;
+	sys_snode_t *node;
+
+	while ((node = sys_slist_get(batch)) != NULL) {
+		uint32_t latency_ms;
+
+		msg = CONTAINER_OF(node, struct uplink_msg, node);
+		latency_ms = (uint32_t)(now - msg->queued);
+
+		LOG_DBG("Message of %u bytes for port %u %s after %u ms", msg->len, port,
+			status ? "dropped" : "sent", latency_ms);
+
+		if (msg->cb != NULL) {
+			msg->cb(status, latency_ms, msg->user_data);
+		}
+
+		key = k_spin_lock(&lock);
+		sys_slist_append(&free_list, &msg->node);
+		k_spin_unlock(&lock, key);
+	}
+}
+
+static void uplink_handler(struct k_work *work)
+{
+	static uint8_t frame[FRAME_SIZE_MAX];
+	uint8_t max_next_payload_size, max_payload_size;
+	struct uplink_msg *first;
+	k_timeout_t delay = K_NO_WAIT;
+	uint32_t dc_wait_ms = 0;
+	k_spinlock_key_t key;
+	sys_slist_t batch;
+	uint8_t port, len;
+	int err;
+
+	ARG_UNUSED(work);
+
+	sys_slist_init(&batch);
+
+	/* The next payload size accounts for the pending MAC commands */
+	lorawan_get_payload_sizes(&max_next_payload_size, &max_payload_size);
+
+	key = k_spin_lock(&lock);
+	len = batch_get(&batch, frame, MIN(max_next_payload_size, sizeof(frame)));
+	k_spin_unlock(&lock, key);
+
+	first = SYS_SLIST_PEEK_HEAD_CONTAINER(&batch, first, node);
+	if (first == NULL) {
+		return;
+	}
+
+	port = first->port;
+
+	if (len > max_payload_size) {
+		/* Cannot be sent at the current datarate, even without MAC commands */
+		LOG_WRN("Message of %u bytes for port %u too long for the datarate", len, port);
+		batch_done(&batch, port, -EMSGSIZE);
+		goto next;
+	}
+
+	err = lorawan_send_frame(port, frame, len, first->type, &dc_wait_ms);
+	if (err == -ECONNREFUSED && dc_wait_ms > 0) {
+		/* Duty-cycle restricted: send the same frame once allowed */
+		LOG_DBG("Frame for port %u delayed by %u ms", port, dc_wait_ms);
+		delay = K_MSEC(dc_wait_ms);
+	} else if (err == -EAGAIN) {
+		/* An empty frame was sent instead to flush the pending MAC
+		 * commands, the payload size allowed next may differ.
+		 */
+		LOG_DBG("Frame for port %u not sent, retrying", port);
+	} else if (err == -EBUSY) {
+		delay = BUSY_RETRY_DELAY;
+	} else {
+		batch_done(&batch, port, err);
+		goto next;
+	}
+
+	/* Put the messages back at the head of the queue */
+	key = k_spin_lock(&lock);
+	sys_slist_merge_slist(&batch, &msg_list);
+	msg_list = batch;
+	k_spin_unlock(&lock, key);
+
+next:
+	key = k_spin_lock(&lock);
+	if (!sys_slist_is_empty(&msg_list)) {
+		k_work_reschedule_for_queue(&uplink_workq, &uplink_work, delay);
+	}
+	k_spin_unlock(&lock, key);
+}
+
+int lorawan_send_async(uint8_t port, const uint8_t *data, uint8_t len,
+		       enum lorawan_message_type type, lorawan_uplink_cb_t cb,
+		       void *user_data)
+{
+	struct uplink_msg *msg;
+	k_spinlock_key_t key;
+	sys_snode_t *node;
+	bool first;
+
+	if (port == 0 || data == NULL || len == 0) {
+		return -EINVAL;
+	}
+
+	if (len > sizeof(msg->data)) {
+		return -EMSGSIZE;
+	}
+
+	key = k_spin_lock(&lock);
+
+	node = sys_slist_get(&free_list);
+	if (node == NULL) {
+		k_spin_unlock(&lock, key);
+		LOG_WRN("Uplink queue full, message for port %u dropped", port);
+		return -ENOSPC;
+	}
+
+	msg = CONTAINER_OF(node, struct uplink_msg, node);
+	msg->cb = cb;
+	msg->user_data = user_data;
+	msg->queued = k_uptime_get();
+	msg->type = type;
+	msg->port = port;
+	msg->len = len;
+	memcpy(msg->data, data, len);
+
+	first = sys_slist_is_empty(&msg_list);
+	sys_slist_append(&msg_list, &msg->node);
+
+	/* A frame waiting for the duty cycle keeps its delay */
+	if (first) {
+		k_work_schedule_for_queue(&uplink_workq, &uplink_work, K_NO_WAIT);
+	}
+
+	k_spin_unlock(&lock, key);
+
+	return 0;
+}
+
+static int lorawan_uplink_init(void)
+{
+	sys_slist_init(&free_list);
+	sys_slist_init(&msg_list);
+
+	for (int i = 0; i < ARRAY_SIZE(messages); i++) {
+		sys_slist_append(&free_list, &messages[i].node);
+	}
+
+	k_work_queue_init(&uplink_workq);
+	k_work_queue_start(&uplink_workq, uplink_stack_area,
+			   K_THREAD_STACK_SIZEOF(uplink_stack_area),
+			   CONFIG_LORAWAN_UPLINK_QUEUE_THREAD_PRIORITY, NULL);
+
+	k_work_init_delayable(&uplink_work, uplink_handler);
+
+	k_thread_name_set(&uplink_workq.thread, "lorawan_uplink");
+
+	return 0;
+}
+
+SYS_INIT(lorawan_uplink_init, APPLICATION, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
@@ -7,10 +7,19 @@
 #ifndef ZEPHYR_SUBSYS_LORAWAN_LW_PRIV_H_
 #define ZEPHYR_SUBSYS_LORAWAN_LW_PRIV_H_
 
+#include <zephyr/lorawan/lorawan.h>
+
 const int lorawan_status2errno(unsigned int status);
 const char *lorawan_status2str(unsigned int status);
 
 const int lorawan_eventinfo2errno(unsigned int status);
 const char *lorawan_eventinfo2str(unsigned int status);
 
+/*
+ * lorawan_send() also reporting, when it fails with -ECONNREFUSED, the time
+ * in ms until the duty-cycle restrictions allow a transmission.
+ */
+int lorawan_send_frame(uint8_t port, uint8_t *data, uint8_t len,
+		       enum lorawan_message_type type, uint32_t *dc_wait_ms);
+
 #endif /* ZEPHYR_SUBSYS_LORAWAN_LW_PRIV_H_ */
@@ -0,0 +1,27 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef H_HASH_CHECKSUM_BUF_
+#define H_HASH_CHECKSUM_BUF_
+
+#include <zephyr/kernel.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Buffer the file data is read into by the hash/checksum functions. The functions are only
+ * called one at a time, from the MCUmgr transport work queue or from the background
+ * hash/checksum work queue.
+ */
+extern uint8_t fs_mgmt_hash_checksum_buf[CONFIG_MCUMGR_GRP_FS_CHECKSUM_HASH_CHUNK_SIZE];
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -108,6 +108,52 @@ static struct {
 	struct k_work_delayable file_close_work;
 } fs_mgmt_ctxt;
 
+#if CONFIG_MCUMGR_GRP_FS_UPLOAD_WINDOW > 0
+/* Upload chunk received ahead of the next offset, free when len is 0 */
+struct fs_mgmt_window_chunk {
+	size_t off;
+	size_t len;
+	uint8_t data[CONFIG_MCUMGR_GRP_FS_UPLOAD_WINDOW_CHUNK_SIZE];
+};
+
+static struct fs_mgmt_window_chunk fs_mgmt_window[CONFIG_MCUMGR_GRP_FS_UPLOAD_WINDOW];
+#endif
+
+#if defined(CONFIG_MCUMGR_GRP_FS_CHECKSUM_HASH_BACKGROUND)
+enum {
+	HASH_STATE_IDLE = 0,
+	HASH_STATE_RUNNING,
+	HASH_STATE_DONE,
+};
+
+static struct {
+	/** Whether a calculation is in progress or its result is waiting to be requested. */
+	atomic_t state;
+
+	/** Path of file being hashed. */
+	char path[CONFIG_MCUMGR_GRP_FS_PATH_LEN + 1];
+
+	/** Hash/checksum type. */
+	const struct fs_mgmt_hash_checksum_group *group;
+
+	/** Requested offset and length. */
+	uint64_t off;
+	uint64_t len;
+
+	/** Result: FS_MGMT_ERR code, length of the data hashed and hash/checksum. */
+	int rc;
+	size_t out_len;
+	uint8_t output[MCUMGR_GRP_FS_CHECKSUM_HASH_LARGEST_OUTPUT_SIZE];
+
+	/** Work item calculating the hash/checksum. */
+	struct k_work work;
+} fs_mgmt_hash_ctxt;
+
+static K_THREAD_STACK_DEFINE(fs_mgmt_hash_stack,
+			     CONFIG_MCUMGR_GRP_FS_CHECKSUM_HASH_BACKGROUND_STACK_SIZE);
+static struct k_work_q fs_mgmt_hash_work_q;
+#endif
+
 static const struct mgmt_handler fs_mgmt_handlers[];
 
 #if defined(CONFIG_MCUMGR_GRP_FS_CHECKSUM_HASH)
@@ -128,6 +174,9 @@ static void fs_mgmt_cleanup(void)
 		memset(fs_mgmt_ctxt.path, 0, sizeof(fs_mgmt_ctxt.path));
 		fs_close(&fs_mgmt_ctxt.file);
 		fs_mgmt_ctxt.transport = NULL;
+#if CONFIG_MCUMGR_GRP_FS_UPLOAD_WINDOW > 0
+		memset(fs_mgmt_window, 0, sizeof(fs_mgmt_window));
+#endif
 	}
 }
 
@@ -184,6 +233,79 @@ static bool fs_mgmt_file_rsp(zcbor_state_t *zse, int rc, uint64_t off)
 		     zcbor_uint64_put(zse, off);
 }
 
+#if CONFIG_MCUMGR_GRP_FS_UPLOAD_WINDOW > 0
+/**
+ * Keeps a chunk received ahead of the next offset, the chunk is dropped if it is too large or
+ * no entry is free; the client then sends it again.
+ */
+static void fs_mgmt_window_put(size_t off, const struct zcbor_string *file_data)
+{
+	struct fs_mgmt_window_chunk *free_chunk = NULL;
+
+	if (file_data->len > CONFIG_MCUMGR_GRP_FS_UPLOAD_WINDOW_CHUNK_SIZE) {
+		return;
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(fs_mgmt_window); i++) {
+		if (fs_mgmt_window[i].len == 0) {
+			free_chunk = free_chunk != NULL ? free_chunk : &fs_mgmt_window[i];
+		} else if (fs_mgmt_window[i].off == off) {
+			/* Sent again, already kept */
+			return;
+		}
+	}
+
+	if (free_chunk == NULL) {
+		LOG_DBG("No room for the chunk at offset %zu", off);
+		return;
+	}
+
+	free_chunk->off = off;
+	free_chunk->len = file_data->len;
+	memcpy(free_chunk->data, file_data->value, file_data->len);
+}
+
+/**
+ * Writes the kept chunks which continue at the next offset, and drops the ones left behind by a
+ * chunk of a different size.
+ *
+ * @return 0 on success, negative error code from fs_write() on failure.
+ */
+static int fs_mgmt_window_flush(void)
+{
+	struct fs_mgmt_window_chunk *chunk;
+	bool written;
+	int rc;
+
+	do {
+		written = false;
+
+		for (size_t i = 0; i < ARRAY_SIZE(fs_mgmt_window); i++) {
+			chunk = &fs_mgmt_window[i];
+
+			if (chunk->len == 0 || chunk->off > fs_mgmt_ctxt.off) {
+				continue;
+			}
+
+			if (chunk->off == fs_mgmt_ctxt.off) {
+				rc = fs_write(&fs_mgmt_ctxt.file, chunk->data, chunk->len);
+
+				if (rc < 0) {
+					return rc;
+				}
+
+				fs_mgmt_ctxt.off += chunk->len;
+				written = true;
+			}
+
+			chunk->len = 0;
+		}
+	} while (written);
+
+	return 0;
+}
+#endif
+
 /**
  * Cleans up open file handle and state when upload is finished.
  */
@@ -446,6 +568,9 @@ static int fs_mgmt_file_upload(struct smp_streamer *ctxt)
 		 * still be closed automatically after a timeout.
 		 */
 		fs_mgmt_ctxt.len = len;
+#if CONFIG_MCUMGR_GRP_FS_UPLOAD_WINDOW > 0
+		memset(fs_mgmt_window, 0, sizeof(fs_mgmt_window));
+#endif
 		rc = fs_mgmt_filelen(file_name, &existing_file_size);
 
 		if (rc != 0) {
@@ -463,6 +588,16 @@ static int fs_mgmt_file_upload(struct smp_streamer *ctxt)
 		}
 	}
 
+#if CONFIG_MCUMGR_GRP_FS_UPLOAD_WINDOW > 0
+	if (off > fs_mgmt_ctxt.off && off < fs_mgmt_ctxt.len && file_data.len > 0) {
+		/* Ahead of the next offset, written once the missing data is received */
+		fs_mgmt_window_put(off, &file_data);
+		ok = fs_mgmt_file_rsp(zse, MGMT_ERR_EOK, fs_mgmt_ctxt.off);
+		k_work_reschedule(&fs_mgmt_ctxt.file_close_work, FILE_CLOSE_IDLE_TIME);
+		goto end;
+	}
+#endif
+
 	/* Verify that the data offset matches the expected offset (i.e. current size of file) */
 	if (off > 0 && off != fs_mgmt_ctxt.off) {
 		/* Offset mismatch, send file length, client needs to handle this */
@@ -545,6 +680,17 @@ static int fs_mgmt_file_upload(struct smp_streamer *ctxt)
 		}
 
 		fs_mgmt_ctxt.off += file_data.len;
+
+#if CONFIG_MCUMGR_GRP_FS_UPLOAD_WINDOW > 0
+		rc = fs_mgmt_window_flush();
+
+		if (rc < 0) {
+			ok = smp_add_cmd_err(zse, MGMT_GROUP_ID_FS,
+					     FS_MGMT_ERR_FILE_WRITE_FAILED);
+			fs_mgmt_cleanup();
+			goto end;
+		}
+#endif
 	}
 
 	/* Send the response. */
@@ -641,6 +787,111 @@ end:
 #endif
 
 #if defined(CONFIG_MCUMGR_GRP_FS_CHECKSUM_HASH)
+/**
+ * Calculates the hash/checksum of a file range.
+ *
+ * @return 0 on success, FS_MGMT_ERR or MGMT_ERR code from the hash/checksum function on failure.
+ */
+static int fs_mgmt_hash_checksum_calc(const char *path,
+				      const struct fs_mgmt_hash_checksum_group *group,
+				      uint64_t off, uint64_t len, uint8_t *output, size_t *out_len)
+{
+	struct fs_file_t file;
+	int rc;
+
+	/* Open file for reading and pass to hash/checksum generation function */
+	fs_file_t_init(&file);
+	rc = fs_open(&file, path, FS_O_READ);
+
+	if (rc != 0) {
+		if (rc == -EINVAL) {
+			rc = FS_MGMT_ERR_FILE_INVALID_NAME;
+		} else if (rc == -ENOENT) {
+			rc = FS_MGMT_ERR_FILE_NOT_FOUND;
+		} else {
+			rc = FS_MGMT_ERR_UNKNOWN;
+		}
+
+		return rc;
+	}
+
+	/* Seek to file's desired offset, if parameter was provided */
+	if (off != 0) {
+		rc = fs_seek(&file, off, FS_SEEK_SET);
+
+		if (rc != 0) {
+			fs_close(&file);
+			return FS_MGMT_ERR_FILE_SEEK_FAILED;
+		}
+	}
+
+	/* Calculate hash/checksum using function */
+	*out_len = 0;
+	rc = group->function(&file, output, out_len, len);
+
+	fs_close(&file);
+
+	return rc;
+}
+
+#if defined(CONFIG_MCUMGR_GRP_FS_CHECKSUM_HASH_BACKGROUND)
+static void fs_mgmt_hash_work_handler(struct k_work *work)
+{
+	fs_mgmt_hash_ctxt.rc = fs_mgmt_hash_checksum_calc(fs_mgmt_hash_ctxt.path,
+							  fs_mgmt_hash_ctxt.group,
+							  fs_mgmt_hash_ctxt.off,
+							  fs_mgmt_hash_ctxt.len,
+							  fs_mgmt_hash_ctxt.output,
+							  &fs_mgmt_hash_ctxt.out_len);
+
+	atomic_set(&fs_mgmt_hash_ctxt.state, HASH_STATE_DONE);
+}
+
+/**
+ * Returns the result of the background calculation matching the request if it has finished,
+ * otherwise starts it if none is in progress.
+ *
+ * @return -EBUSY if the calculation has not finished, the result of
+ *	   fs_mgmt_hash_checksum_calc() otherwise.
+ */
+static int fs_mgmt_hash_checksum_background(const char *path,
+					    const struct fs_mgmt_hash_checksum_group *group,
+					    uint64_t off, uint64_t len, uint8_t *output,
+					    size_t *out_len)
+{
+	switch (atomic_get(&fs_mgmt_hash_ctxt.state)) {
+	case HASH_STATE_RUNNING:
+		return -EBUSY;
+
+	case HASH_STATE_DONE:
+		if (fs_mgmt_hash_ctxt.group == group && fs_mgmt_hash_ctxt.off == off &&
+		    fs_mgmt_hash_ctxt.len == len && strcmp(fs_mgmt_hash_ctxt.path, path) == 0) {
+			memcpy(output, fs_mgmt_hash_ctxt.output, group->output_size);
+			*out_len = fs_mgmt_hash_ctxt.out_len;
+			atomic_set(&fs_mgmt_hash_ctxt.state, HASH_STATE_IDLE);
+
+			return fs_mgmt_hash_ctxt.rc;
+		}
+
+		/* Result never requested, replaced by the new request */
+		break;
+
+	default:
+		break;
+	}
+
+	strcpy(fs_mgmt_hash_ctxt.path, path);
+	fs_mgmt_hash_ctxt.group = group;
+	fs_mgmt_hash_ctxt.off = off;
+	fs_mgmt_hash_ctxt.len = len;
+	atomic_set(&fs_mgmt_hash_ctxt.state, HASH_STATE_RUNNING);
+
+	k_work_submit_to_queue(&fs_mgmt_hash_work_q, &fs_mgmt_hash_ctxt.work);
+
+	return -EBUSY;
+}
+#endif
+
 /**
  * Command handler: fs hash/checksum (read)
  */
@@ -659,7 +910,6 @@ static int fs_mgmt_file_hash_checksum(struct smp_streamer *ctxt)
 	struct zcbor_string type = { 0 };
 	struct zcbor_string name = { 0 };
 	size_t decoded;
-	struct fs_file_t file;
 	const struct fs_mgmt_hash_checksum_group *group = NULL;
 
 	struct zcbor_map_decode_key_val fs_hash_checksum_decode[] = {
@@ -736,40 +986,17 @@ static int fs_mgmt_file_hash_checksum(struct smp_streamer *ctxt)
 		goto end;
 	}
 
-	/* Open file for reading and pass to hash/checksum generation function */
-	fs_file_t_init(&file);
-	rc = fs_open(&file, path, FS_O_READ);
-
-	if (rc != 0) {
-		if (rc == -EINVAL) {
-			rc = FS_MGMT_ERR_FILE_INVALID_NAME;
-		} else if (rc == -ENOENT) {
-			rc = FS_MGMT_ERR_FILE_NOT_FOUND;
-		} else {
-			rc = FS_MGMT_ERR_UNKNOWN;
-		}
-
-		ok = smp_add_cmd_err(zse, MGMT_GROUP_ID_FS, rc);
-		goto end;
-	}
-
-	/* Seek to file's desired offset, if parameter was provided */
-	if (off != 0) {
-		rc = fs_seek(&file, off, FS_SEEK_SET);
+#if defined(CONFIG_MCUMGR_GRP_FS_CHECKSUM_HASH_BACKGROUND)
+	rc = fs_mgmt_hash_checksum_background(path, group, off, len, (uint8_t *)output,
+					      &file_len);
 
-		if (rc != 0) {
-			ok = smp_add_cmd_err(zse, MGMT_GROUP_ID_FS,
-					     FS_MGMT_ERR_FILE_SEEK_FAILED);
-			fs_close(&file);
-			goto end;
-		}
+	if (rc == -EBUSY) {
+		/* The client sends the request again to get the result */
+		return MGMT_ERR_EBUSY;
 	}
-
-	/* Calculate hash/checksum using function */
-	file_len = 0;
-	rc = group->function(&file, output, &file_len, len);
-
-	fs_close(&file);
+#else
+	rc = fs_mgmt_hash_checksum_calc(path, group, off, len, (uint8_t *)output, &file_len);
+#endif
 
 	/* Encode the response */
 	if (rc != 0) {
@@ -973,6 +1200,14 @@ static void fs_mgmt_register_group(void)
 	k_sem_init(&fs_mgmt_ctxt.lock_sem, 1, 1);
 	k_work_init_delayable(&fs_mgmt_ctxt.file_close_work, file_close_work_handler);
 
+#if defined(CONFIG_MCUMGR_GRP_FS_CHECKSUM_HASH_BACKGROUND)
+	k_work_init(&fs_mgmt_hash_ctxt.work, fs_mgmt_hash_work_handler);
+	k_work_queue_start(&fs_mgmt_hash_work_q, fs_mgmt_hash_stack,
+			   K_THREAD_STACK_SIZEOF(fs_mgmt_hash_stack),
+			   CONFIG_MCUMGR_GRP_FS_CHECKSUM_HASH_BACKGROUND_THREAD_PRIO, NULL);
+	k_thread_name_set(&fs_mgmt_hash_work_q.thread, "fs_mgmt_hash");
+#endif
+
 	mgmt_register_group(&fs_mgmt_group);
 
 #if defined(CONFIG_MCUMGR_GRP_FS_CHECKSUM_HASH)
@@ -10,6 +10,10 @@
 
 #include <zephyr/mgmt/mcumgr/grp/fs_mgmt/fs_mgmt_hash_checksum.h>
 
+#include <mgmt/mcumgr/grp/fs_mgmt/fs_mgmt_hash_checksum_buf.h>
+
+uint8_t fs_mgmt_hash_checksum_buf[CONFIG_MCUMGR_GRP_FS_CHECKSUM_HASH_CHUNK_SIZE];
+
 static sys_slist_t fs_mgmt_hash_checksum_group_list =
 	SYS_SLIST_STATIC_INIT(&fs_mgmt_hash_checksum_group_list);
 
@@ -11,6 +11,7 @@
 #include <string.h>
 
 #include <mgmt/mcumgr/grp/fs_mgmt/fs_mgmt_config.h>
+#include <mgmt/mcumgr/grp/fs_mgmt/fs_mgmt_hash_checksum_buf.h>
 #include <mgmt/mcumgr/grp/fs_mgmt/fs_mgmt_hash_checksum_sha256.h>
 
 #if defined(CONFIG_TINYCRYPT_SHA256)
@@ -30,8 +31,8 @@ static int fs_mgmt_hash_checksum_sha256(struct fs_file_t *file, uint8_t *output,
 {
 	int rc = 0;
 	ssize_t bytes_read = 0;
-	size_t read_size = CONFIG_MCUMGR_GRP_FS_CHECKSUM_HASH_CHUNK_SIZE;
-	uint8_t buffer[CONFIG_MCUMGR_GRP_FS_CHECKSUM_HASH_CHUNK_SIZE];
+	size_t read_size = sizeof(fs_mgmt_hash_checksum_buf);
+	uint8_t *buffer = fs_mgmt_hash_checksum_buf;
 	struct tc_sha256_state_struct sha;
 
 	/* Clear variables prior to calculation */
@@ -77,8 +78,8 @@ static int fs_mgmt_hash_checksum_sha256(struct fs_file_t *file, uint8_t *output,
 {
 	int rc = 0;
 	ssize_t bytes_read = 0;
-	size_t read_size = CONFIG_MCUMGR_GRP_FS_CHECKSUM_HASH_CHUNK_SIZE;
-	uint8_t buffer[CONFIG_MCUMGR_GRP_FS_CHECKSUM_HASH_CHUNK_SIZE];
+	size_t read_size = sizeof(fs_mgmt_hash_checksum_buf);
+	uint8_t *buffer = fs_mgmt_hash_checksum_buf;
 	mbedtls_md_context_t mbed_hash_ctx;
 	const mbedtls_md_info_t *mbed_hash_info;
 
@@ -86,6 +86,17 @@ struct img_mgmt_state g_img_mgmt_state;
 static K_MUTEX_DEFINE(img_mgmt_mutex);
 #endif
 
+#if CONFIG_MCUMGR_GRP_IMG_UPLOAD_WINDOW > 0
+/* Upload chunk received ahead of the next offset, free when len is 0 */
+struct img_mgmt_window_chunk {
+	size_t off;
+	size_t len;
+	uint8_t data[CONFIG_MCUMGR_GRP_IMG_UPLOAD_WINDOW_CHUNK_SIZE];
+};
+
+static struct img_mgmt_window_chunk img_mgmt_window[CONFIG_MCUMGR_GRP_IMG_UPLOAD_WINDOW];
+#endif
+
 #ifdef CONFIG_MCUMGR_GRP_IMG_VERBOSE_ERR
 const char *img_mgmt_err_str_app_reject = "app reject";
 const char *img_mgmt_err_str_hdr_malformed = "header malformed";
@@ -315,9 +326,101 @@ static void img_mgmt_reset_upload(void)
 	img_mgmt_take_lock();
 	memset(&g_img_mgmt_state, 0, sizeof(g_img_mgmt_state));
 	g_img_mgmt_state.area_id = -1;
+#if CONFIG_MCUMGR_GRP_IMG_UPLOAD_WINDOW > 0
+	memset(img_mgmt_window, 0, sizeof(img_mgmt_window));
+#endif
 	img_mgmt_release_lock();
 }
 
+/**
+ * Whether the upload in progress is a compressed image, which is not checked against its hash.
+ */
+static inline bool img_mgmt_upload_compressed(void)
+{
+#ifdef CONFIG_IMG_LZ4
+	return g_img_mgmt_state.compressed;
+#else
+	return false;
+#endif
+}
+
+#if CONFIG_MCUMGR_GRP_IMG_UPLOAD_WINDOW > 0
+/**
+ * Keeps a chunk received ahead of the next offset, the chunk is dropped if it is too large or
+ * no entry is free; the client then sends it again.
+ */
+static void img_mgmt_window_put(const struct img_mgmt_upload_req *req)
+{
+	struct img_mgmt_window_chunk *free_chunk = NULL;
+
+	if (req->img_data.len > CONFIG_MCUMGR_GRP_IMG_UPLOAD_WINDOW_CHUNK_SIZE) {
+		return;
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(img_mgmt_window); i++) {
+		if (img_mgmt_window[i].len == 0) {
+			free_chunk = free_chunk != NULL ? free_chunk : &img_mgmt_window[i];
+		} else if (img_mgmt_window[i].off == req->off) {
+			/* Sent again, already kept */
+			return;
+		}
+	}
+
+	if (free_chunk == NULL) {
+		LOG_DBG("No room for the chunk at offset %zu", req->off);
+		return;
+	}
+
+	free_chunk->off = req->off;
+	free_chunk->len = req->img_data.len;
+	memcpy(free_chunk->data, req->img_data.value, req->img_data.len);
+}
+
+/**
+ * Writes the kept chunks which continue at the next offset, and drops the ones left behind by a
+ * chunk of a different size.
+ *
+ * @param last	Set to whether the last chunk of the image was written.
+ *
+ * @return 0 on success, IMG_MGMT_ERR code on failure.
+ */
+static int img_mgmt_window_flush(bool *last)
+{
+	struct img_mgmt_window_chunk *chunk;
+	bool written;
+	int rc;
+
+	do {
+		written = false;
+
+		for (size_t i = 0; i < ARRAY_SIZE(img_mgmt_window); i++) {
+			chunk = &img_mgmt_window[i];
+
+			if (chunk->len == 0 || chunk->off > g_img_mgmt_state.off) {
+				continue;
+			}
+
+			if (chunk->off == g_img_mgmt_state.off) {
+				*last = chunk->off + chunk->len == g_img_mgmt_state.size;
+
+				rc = img_mgmt_write_image_data(chunk->off, chunk->data, chunk->len,
+							       *last);
+				if (rc != 0) {
+					return rc;
+				}
+
+				g_img_mgmt_state.off += chunk->len;
+				written = true;
+			}
+
+			chunk->len = 0;
+		}
+	} while (written);
+
+	return 0;
+}
+#endif
+
 static int
 img_mgmt_get_other_slot(void)
 {
@@ -585,6 +688,14 @@ defined(CONFIG_MCUMGR_SMP_COMMAND_STATUS_HOOKS)
 
 		g_img_mgmt_state.off = 0;
 
+#ifdef CONFIG_IMG_LZ4
+		g_img_mgmt_state.compressed = action.compressed;
+#endif
+
+#if CONFIG_MCUMGR_GRP_IMG_UPLOAD_WINDOW > 0
+		memset(img_mgmt_window, 0, sizeof(img_mgmt_window));
+#endif
+
 #if defined(CONFIG_MCUMGR_GRP_IMG_STATUS_HOOKS)
 		(void)mgmt_callback_notify(MGMT_EVT_OP_IMG_MGMT_DFU_STARTED, NULL, 0, &err_rc,
 					   &err_group);
@@ -610,7 +721,8 @@ defined(CONFIG_MCUMGR_SMP_COMMAND_STATUS_HOOKS)
 		 * of the file that is being uploaded, do not attempt the check if the length
 		 * of the provided hash is less.
 		 */
-		if (g_img_mgmt_state.data_sha_len == IMG_MGMT_DATA_SHA_LEN) {
+		if (g_img_mgmt_state.data_sha_len == IMG_MGMT_DATA_SHA_LEN &&
+		    !img_mgmt_upload_compressed()) {
 			fic.match = g_img_mgmt_state.data_sha;
 			fic.clen = g_img_mgmt_state.size;
 
@@ -635,7 +747,13 @@ defined(CONFIG_MCUMGR_SMP_COMMAND_STATUS_HOOKS)
 #ifndef CONFIG_IMG_ERASE_PROGRESSIVELY
 		/* erase the entire req.size all at once */
 		if (action.erase) {
+#ifdef CONFIG_IMG_LZ4
+			/* A compressed image takes up more room once decompressed */
+			rc = img_mgmt_erase_image_data(0, action.compressed ? action.image_size :
+							  req.size);
+#else
 			rc = img_mgmt_erase_image_data(0, req.size);
+#endif
 			if (rc != 0) {
 				IMG_MGMT_UPLOAD_ACTION_SET_RC_RSN(&action,
 					img_mgmt_err_str_flash_erase_failed);
@@ -650,6 +768,14 @@ defined(CONFIG_MCUMGR_SMP_COMMAND_STATUS_HOOKS)
 #endif
 	}
 
+#if CONFIG_MCUMGR_GRP_IMG_UPLOAD_WINDOW > 0
+	if (req.off != g_img_mgmt_state.off) {
+		/* Ahead of the next offset, written once the missing data is received */
+		img_mgmt_window_put(&req);
+		goto end;
+	}
+#endif
+
 	/* Write the image data to flash. */
 	if (req.img_data.len != 0) {
 		/* If this is the last chunk */
@@ -661,7 +787,12 @@ defined(CONFIG_MCUMGR_SMP_COMMAND_STATUS_HOOKS)
 						    last);
 		if (rc == 0) {
 			g_img_mgmt_state.off += action.write_bytes;
-		} else {
+#if CONFIG_MCUMGR_GRP_IMG_UPLOAD_WINDOW > 0
+			rc = img_mgmt_window_flush(&last);
+#endif
+		}
+
+		if (rc != 0) {
 			/* Write failed, currently not able to recover from this */
 #if defined(CONFIG_MCUMGR_SMP_COMMAND_STATUS_HOOKS)
 			cmd_status_arg.status = IMG_MGMT_ID_UPLOAD_STATUS_COMPLETE;
@@ -686,19 +817,24 @@ defined(CONFIG_MCUMGR_SMP_COMMAND_STATUS_HOOKS)
 #ifdef CONFIG_IMG_ENABLE_IMAGE_CHECK
 			static struct flash_img_context ctx;
 
-			if (flash_img_init_id(&ctx, g_img_mgmt_state.area_id) == 0) {
-				struct flash_img_check fic = {
-					.match = g_img_mgmt_state.data_sha,
-					.clen = g_img_mgmt_state.size,
-				};
-
-				if (flash_img_check(&ctx, &fic, g_img_mgmt_state.area_id) == 0) {
-					data_match = true;
+			/* The hash of a compressed image is the one of the data uploaded */
+			if (!img_mgmt_upload_compressed()) {
+				if (flash_img_init_id(&ctx, g_img_mgmt_state.area_id) == 0) {
+					struct flash_img_check fic = {
+						.match = g_img_mgmt_state.data_sha,
+						.clen = g_img_mgmt_state.size,
+					};
+
+					if (flash_img_check(&ctx, &fic,
+							    g_img_mgmt_state.area_id) == 0) {
+						data_match = true;
+					} else {
+						LOG_ERR("Uploaded image sha256 hash verification "
+							"failed");
+					}
 				} else {
-					LOG_ERR("Uploaded image sha256 hash verification failed");
+					LOG_ERR("Uploaded image sha256 could not be checked");
 				}
-			} else {
-				LOG_ERR("Uploaded image sha256 could not be checked");
 			}
 #endif
 
@@ -732,7 +868,7 @@ end:
 		rc = img_mgmt_upload_good_rsp(ctxt);
 
 #ifdef CONFIG_IMG_ENABLE_IMAGE_CHECK
-		if (last && rc == MGMT_ERR_EOK) {
+		if (last && rc == MGMT_ERR_EOK && !img_mgmt_upload_compressed()) {
 			/* Append status to last packet */
 			ok = zcbor_tstr_put_lit(zse, "match")	&&
 			     zcbor_bool_put(zse, data_match);
@@ -374,6 +374,10 @@ int img_mgmt_read(int slot, unsigned int offset, void *dst, unsigned int num_byt
 	return 0;
 }
 
+#ifdef CONFIG_IMG_LZ4
+static struct flash_img_lz4 img_mgmt_lz4;
+#endif
+
 #if defined(CONFIG_MCUMGR_GRP_IMG_USE_HEAP_FOR_FLASH_IMG_CONTEXT)
 int img_mgmt_write_image_data(unsigned int offset, const void *data, unsigned int num_bytes,
 			      bool last)
@@ -407,6 +411,12 @@ int img_mgmt_write_image_data(unsigned int offset, const void *data, unsigned in
 			rc = IMG_MGMT_ERR_FLASH_OPEN_FAILED;
 			goto out;
 		}
+
+#ifdef CONFIG_IMG_LZ4
+		if (g_img_mgmt_state.compressed) {
+			flash_img_lz4_enable(ctx, &img_mgmt_lz4);
+		}
+#endif
 	}
 
 	if (flash_img_buffered_write(ctx, data, num_bytes, last) != 0) {
@@ -432,6 +442,12 @@ int img_mgmt_write_image_data(unsigned int offset, const void *data, unsigned in
 		if (flash_img_init_id(&ctx, g_img_mgmt_state.area_id) != 0) {
 			return IMG_MGMT_ERR_FLASH_OPEN_FAILED;
 		}
+
+#ifdef CONFIG_IMG_LZ4
+		if (g_img_mgmt_state.compressed) {
+			flash_img_lz4_enable(&ctx, &img_mgmt_lz4);
+		}
+#endif
 	}
 
 	if (flash_img_buffered_write(&ctx, data, num_bytes, last) != 0) {
@@ -558,6 +574,8 @@ int img_mgmt_upload_inspect(const struct img_mgmt_upload_req *req,
 {
 	const struct image_header *hdr;
 	struct image_version cur_ver;
+	size_t image_size;
+	bool compressed = false;
 	int rc;
 
 	memset(action, 0, sizeof(*action));
@@ -584,9 +602,28 @@ int img_mgmt_upload_inspect(const struct img_mgmt_upload_req *req,
 			return IMG_MGMT_ERR_INVALID_LENGTH;
 		}
 		action->size = req->size;
+		image_size = req->size;
 
 		hdr = (struct image_header *)req->img_data.value;
-		if (hdr->ih_magic != IMAGE_MAGIC) {
+
+#ifdef CONFIG_IMG_LZ4
+		/*
+		 * The image header of a compressed image is compressed too, it cannot be checked
+		 * here. MCUboot validates the image once decompressed.
+		 */
+		compressed = flash_img_lz4_is_stream(req->img_data.value, req->img_data.len,
+						     &image_size);
+		action->compressed = compressed;
+		action->image_size = image_size;
+#endif
+
+		if (compressed && req->upgrade) {
+			/* The version cannot be compared */
+			IMG_MGMT_UPLOAD_ACTION_SET_RC_RSN(action, img_mgmt_err_str_hdr_malformed);
+			return IMG_MGMT_ERR_INVALID_IMAGE_HEADER;
+		}
+
+		if (!compressed && hdr->ih_magic != IMAGE_MAGIC) {
 			IMG_MGMT_UPLOAD_ACTION_SET_RC_RSN(action, img_mgmt_err_str_magic_mismatch);
 			return IMG_MGMT_ERR_INVALID_IMAGE_HEADER_MAGIC;
 		}
@@ -625,16 +662,16 @@ int img_mgmt_upload_inspect(const struct img_mgmt_upload_req *req,
 		}
 
 		/* Check that the area is of sufficient size to store the new image */
-		if (req->size > fa->fa_size) {
+		if (image_size > fa->fa_size) {
 			IMG_MGMT_UPLOAD_ACTION_SET_RC_RSN(action,
 				img_mgmt_err_str_image_too_large);
 			flash_area_close(fa);
-			LOG_ERR("Upload too large for slot: %u > %u", req->size, fa->fa_size);
+			LOG_ERR("Upload too large for slot: %u > %u", image_size, fa->fa_size);
 			return IMG_MGMT_ERR_INVALID_IMAGE_TOO_LARGE;
 		}
 
 #if defined(CONFIG_MCUMGR_GRP_IMG_REJECT_DIRECT_XIP_MISMATCHED_SLOT)
-		if (hdr->ih_flags & IMAGE_F_ROM_FIXED) {
+		if (!compressed && (hdr->ih_flags & IMAGE_F_ROM_FIXED)) {
 			if (fa->fa_off != hdr->ih_load_addr) {
 				IMG_MGMT_UPLOAD_ACTION_SET_RC_RSN(action,
 					img_mgmt_err_str_image_bad_flash_addr);
@@ -675,10 +712,13 @@ int img_mgmt_upload_inspect(const struct img_mgmt_upload_req *req,
 		action->area_id = g_img_mgmt_state.area_id;
 		action->size = g_img_mgmt_state.size;
 
-		if (req->off != g_img_mgmt_state.off) {
+		if (req->off != g_img_mgmt_state.off &&
+		    (CONFIG_MCUMGR_GRP_IMG_UPLOAD_WINDOW == 0 || req->off < g_img_mgmt_state.off ||
+		     req->img_data.len == 0)) {
 			/*
 			 * Invalid offset. Drop the data, and respond with the offset we're
-			 * expecting data for.
+			 * expecting data for. Data ahead of that offset is kept, if possible,
+			 * until the missing data is received.
 			 */
 			return IMG_MGMT_ERR_OK;
 		}
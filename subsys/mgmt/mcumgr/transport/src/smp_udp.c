@@ -15,6 +15,7 @@
 #include <zephyr/init.h>
 #if defined(CONFIG_POSIX_API)
 #include <zephyr/posix/unistd.h>
+#include <zephyr/posix/poll.h>
 #include <zephyr/posix/sys/socket.h>
 #else
 #include <zephyr/net/socket.h>
@@ -58,7 +59,6 @@ struct config {
 	enum proto_type proto;
 	struct k_sem network_ready_sem;
 	struct smp_transport smp_transport;
-	char recv_buffer[CONFIG_MCUMGR_TRANSPORT_UDP_MTU];
 	struct k_thread thread;
 	K_KERNEL_STACK_MEMBER(stack, CONFIG_MCUMGR_TRANSPORT_UDP_STACK_SIZE);
 };
@@ -246,32 +246,55 @@ static void smp_udp_receive_thread(void *p1, void *p2, void *p3)
 	LOG_INF("Started (%s)", smp_udp_proto_to_name(conf->proto));
 
 	while (1) {
+		struct pollfd fds = {
+			.fd = conf->sock,
+			.events = POLLIN,
+		};
 		struct sockaddr addr;
 		socklen_t addr_len = sizeof(addr);
+		struct net_buf *nb;
+		char discard;
+		int len;
+
+		/* Only take an mcumgr buffer once a frame is pending, it is received directly
+		 * into the buffer.
+		 */
+		rc = poll(&fds, 1, -1);
+		if (rc < 0) {
+			LOG_ERR("poll error (%s): %i", smp_udp_proto_to_name(conf->proto), errno);
+			continue;
+		}
+
+		nb = smp_packet_alloc();
+		if (!nb) {
+			LOG_ERR("Failed to allocate mcumgr buffer");
+			/* No free space, drop SMP frame */
+			(void)recvfrom(conf->sock, &discard, sizeof(discard), MSG_DONTWAIT, NULL,
+				       NULL);
+			continue;
+		}
 
-		int len = recvfrom(conf->sock, conf->recv_buffer,
-				   CONFIG_MCUMGR_TRANSPORT_UDP_MTU,
-				   0, &addr, &addr_len);
+		len = recvfrom(conf->sock, nb->data,
+			       MIN(CONFIG_MCUMGR_TRANSPORT_UDP_MTU, net_buf_tailroom(nb)),
+			       MSG_DONTWAIT, &addr, &addr_len);
 
 		if (len > 0) {
 			struct sockaddr *ud;
-			struct net_buf *nb;
+
+			net_buf_add(nb, len);
 
 			/* Store sender address in user data for reply */
-			nb = smp_packet_alloc();
-			if (!nb) {
-				LOG_ERR("Failed to allocate mcumgr buffer");
-				/* No free space, drop SMP frame */
-				continue;
-			}
-			net_buf_add_mem(nb, conf->recv_buffer, len);
 			ud = net_buf_user_data(nb);
 			net_ipaddr_copy(ud, &addr);
 
 			smp_rx_req(&conf->smp_transport, nb);
-		} else if (len < 0) {
-			LOG_ERR("recvfrom error (%s): %i, %d", smp_udp_proto_to_name(conf->proto),
-				errno, len);
+		} else {
+			if (len < 0) {
+				LOG_ERR("recvfrom error (%s): %i, %d",
+					smp_udp_proto_to_name(conf->proto), errno, len);
+			}
+
+			smp_packet_free(nb);
 		}
 	}
 }
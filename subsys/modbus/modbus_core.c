@@ -262,6 +262,8 @@ int modbus_init_server(const int iface, struct modbus_iface_param param)
 
 	ctx->unit_id = param.server.unit_id;
 	ctx->mbs_user_cb = param.server.user_cb;
+	ctx->holding_map = param.server.holding_regs;
+	ctx->input_map = param.server.input_regs;
 	if (IS_ENABLED(CONFIG_MODBUS_FC08_DIAGNOSTIC)) {
 		modbus_reset_stats(ctx);
 	}
@@ -364,6 +366,8 @@ int modbus_disable(const uint8_t iface)
 	ctx->unit_id = 0;
 	ctx->mode = MODBUS_MODE_RTU;
 	ctx->mbs_user_cb = NULL;
+	ctx->holding_map.regs = NULL;
+	ctx->input_map.regs = NULL;
 	atomic_clear_bit(&ctx->state, MODBUS_STATE_CONFIGURED);
 
 	LOG_INF("Modbus interface %u disabled", iface);
@@ -118,6 +118,9 @@ struct modbus_context {
 	uint32_t rxwait_to;
 	/* Pointer to user server callbacks */
 	struct modbus_user_callbacks *mbs_user_cb;
+	/* Server's registers mapped in memory */
+	struct modbus_reg_map holding_map;
+	struct modbus_reg_map input_map;
 	/* Interface state */
 	atomic_t state;
 
@@ -76,6 +76,38 @@ int modbus_raw_submit_rx(const int iface, const struct modbus_adu *adu)
 	return 0;
 }
 
+int modbus_raw_server_txn(const int iface, struct modbus_adu *adu)
+{
+	struct modbus_context *ctx;
+	bool respond;
+
+	ctx = modbus_get_context(iface);
+	if (ctx == NULL) {
+		LOG_ERR("Interface %d not available", iface);
+		return -ENODEV;
+	}
+
+	if (!IS_ENABLED(CONFIG_MODBUS_SERVER) || ctx->client ||
+	    ctx->mode != MODBUS_MODE_RAW) {
+		LOG_ERR("Interface %d is not a raw ADU server", iface);
+		return -ENODEV;
+	}
+
+	/* The frames of the interface are shared by the callers */
+	k_mutex_lock(&ctx->iface_lock, K_FOREVER);
+
+	memcpy(&ctx->rx_adu, adu, sizeof(struct modbus_adu));
+	ctx->rx_adu_err = modbus_raw_rx_adu(ctx);
+	respond = modbus_server_handler(ctx);
+	if (respond) {
+		memcpy(adu, &ctx->tx_adu, sizeof(struct modbus_adu));
+	}
+
+	k_mutex_unlock(&ctx->iface_lock);
+
+	return respond ? 0 : -ENODATA;
+}
+
 void modbus_raw_put_header(const struct modbus_adu *adu, uint8_t *header)
 {
 	uint16_t length = MIN(adu->length, CONFIG_MODBUS_BUFFER_SIZE);
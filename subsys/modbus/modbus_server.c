@@ -91,6 +91,143 @@ static void mbs_exception_rsp(struct modbus_context *ctx, uint8_t excep_code)
 	ctx->tx_adu.length = 1;
 }
 
+/*
+ * Registers read and written through the callbacks for ranges of
+ * registers at once, in host byte order.
+ */
+#define MBS_REGS_CHUNK 16
+
+/* Registers of the map holding a whole request, NULL if there are none */
+static uint16_t *mbs_reg_map_get(const struct modbus_reg_map *map,
+				 uint16_t addr, uint16_t qty)
+{
+	if (map->regs == NULL || addr < map->start_addr ||
+	    (uint32_t)(addr - map->start_addr) + qty > map->num_regs) {
+		return NULL;
+	}
+
+	return &map->regs[addr - map->start_addr];
+}
+
+static int mbs_regs_read(const struct modbus_reg_map *map,
+			 int (*regs_rd)(uint16_t addr, uint16_t *regs, uint16_t num),
+			 int (*reg_rd)(uint16_t addr, uint16_t *reg),
+			 uint16_t addr, uint16_t qty, uint8_t *presp)
+{
+	uint16_t regs[MBS_REGS_CHUNK];
+	uint16_t *mapped;
+	uint16_t num;
+	int err;
+
+	mapped = mbs_reg_map_get(map, addr, qty);
+	if (mapped != NULL) {
+		for (uint16_t i = 0; i < qty; i++) {
+			sys_put_be16(mapped[i], &presp[i * sizeof(uint16_t)]);
+		}
+
+		return 0;
+	}
+
+	while (qty > 0) {
+		if (regs_rd != NULL) {
+			num = MIN(qty, ARRAY_SIZE(regs));
+			err = regs_rd(addr, regs, num);
+		} else if (reg_rd != NULL) {
+			num = 1;
+			err = reg_rd(addr, &regs[0]);
+		} else {
+			return -ENOTSUP;
+		}
+
+		if (err != 0) {
+			return err;
+		}
+
+		for (uint16_t i = 0; i < num; i++) {
+			sys_put_be16(regs[i], presp);
+			presp += sizeof(uint16_t);
+		}
+
+		addr += num;
+		qty -= num;
+	}
+
+	return 0;
+}
+
+static int mbs_hregs_write(struct modbus_context *ctx, uint16_t addr,
+			   uint16_t qty, const uint8_t *prx_data)
+{
+	int (*regs_wr)(uint16_t addr, const uint16_t *regs, uint16_t num) =
+		ctx->mbs_user_cb->holding_regs_wr;
+	uint16_t regs[MBS_REGS_CHUNK];
+	uint16_t *mapped;
+	uint16_t num;
+	int err;
+
+	mapped = mbs_reg_map_get(&ctx->holding_map, addr, qty);
+	if (mapped != NULL) {
+		for (uint16_t i = 0; i < qty; i++) {
+			mapped[i] = sys_get_be16(&prx_data[i * sizeof(uint16_t)]);
+		}
+
+		return 0;
+	}
+
+	while (qty > 0) {
+		num = regs_wr != NULL ? MIN(qty, ARRAY_SIZE(regs)) : 1;
+
+		for (uint16_t i = 0; i < num; i++) {
+			regs[i] = sys_get_be16(prx_data);
+			prx_data += sizeof(uint16_t);
+		}
+
+		if (regs_wr != NULL) {
+			err = regs_wr(addr, regs, num);
+		} else if (ctx->mbs_user_cb->holding_reg_wr != NULL) {
+			err = ctx->mbs_user_cb->holding_reg_wr(addr, regs[0]);
+		} else {
+			return -ENOTSUP;
+		}
+
+		if (err != 0) {
+			return err;
+		}
+
+		addr += num;
+		qty -= num;
+	}
+
+	return 0;
+}
+
+static int mbs_hregs_write_fp(struct modbus_context *ctx, uint16_t addr,
+			      uint16_t qty, const uint8_t *prx_data)
+{
+	for (uint16_t reg_cntr = 0; reg_cntr < qty; reg_cntr++) {
+		uint32_t reg_val = sys_get_be32(prx_data);
+		float fp;
+		int err;
+
+		/* Write to floating point register */
+		memcpy(&fp, &reg_val, sizeof(float));
+		prx_data += sizeof(uint32_t);
+		err = ctx->mbs_user_cb->holding_reg_wr_fp(addr + reg_cntr, fp);
+		if (err != 0) {
+			return err;
+		}
+	}
+
+	return 0;
+}
+
+static bool mbs_hregs_writable(const struct modbus_context *ctx)
+{
+	return ctx->holding_map.regs != NULL ||
+	       ctx->mbs_user_cb->holding_regs_wr != NULL ||
+	       ctx->mbs_user_cb->holding_reg_wr != NULL;
+}
+
 /*
  * FC 01 (0x01) Read Coils
  *
@@ -325,7 +462,9 @@ static bool mbs_fc03_hreg_read(struct modbus_context *ctx)
 	if ((reg_addr < MODBUS_FP_EXTENSIONS_ADDR) ||
 	    !IS_ENABLED(CONFIG_MODBUS_FP_EXTENSIONS)) {
 		/* Read integer register */
-		if (ctx->mbs_user_cb->holding_reg_rd == NULL) {
+		if (ctx->holding_map.regs == NULL &&
+		    ctx->mbs_user_cb->holding_regs_rd == NULL &&
+		    ctx->mbs_user_cb->holding_reg_rd == NULL) {
 			mbs_exception_rsp(ctx, MODBUS_EXC_ILLEGAL_FC);
 			return true;
 		}
@@ -362,37 +501,35 @@ static bool mbs_fc03_hreg_read(struct modbus_context *ctx)
 
 	/* Reset the pointer to the start of the response payload */
 	presp = &ctx->tx_adu.data[1];
-	/* Loop through each register requested. */
-	while (reg_qty > 0) {
-		if (reg_addr < MODBUS_FP_EXTENSIONS_ADDR) {
-			uint16_t reg;
-
-			/* Read integer register */
-			err = ctx->mbs_user_cb->holding_reg_rd(reg_addr, &reg);
-			if (err == 0) {
-				sys_put_be16(reg, presp);
-				presp += sizeof(uint16_t);
-			}
+	if ((reg_addr < MODBUS_FP_EXTENSIONS_ADDR) ||
+	    !IS_ENABLED(CONFIG_MODBUS_FP_EXTENSIONS)) {
+		/* Read integer registers */
+		err = mbs_regs_read(&ctx->holding_map, ctx->mbs_user_cb->holding_regs_rd,
+				    ctx->mbs_user_cb->holding_reg_rd, reg_addr, reg_qty, presp);
+		if (err != 0) {
+			LOG_INF("Holding register address not supported");
+			mbs_exception_rsp(ctx, MODBUS_EXC_ILLEGAL_DATA_ADDR);
+		}
 
-		} else if (IS_ENABLED(CONFIG_MODBUS_FP_EXTENSIONS)) {
-			float fp;
-			uint32_t reg;
+		return true;
+	}
 
-			/* Read floating-point register */
-			err = ctx->mbs_user_cb->holding_reg_rd_fp(reg_addr, &fp);
-			if (err == 0) {
-				memcpy(&reg, &fp, sizeof(reg));
-				sys_put_be32(reg, presp);
-				presp += sizeof(uint32_t);
-			}
-		}
+	/* Loop through each floating-point register requested. */
+	while (reg_qty > 0) {
+		float fp;
+		uint32_t reg;
 
+		err = ctx->mbs_user_cb->holding_reg_rd_fp(reg_addr, &fp);
 		if (err != 0) {
 			LOG_INF("Holding register address not supported");
 			mbs_exception_rsp(ctx, MODBUS_EXC_ILLEGAL_DATA_ADDR);
 			return true;
 		}
 
+		memcpy(&reg, &fp, sizeof(reg));
+		sys_put_be32(reg, presp);
+		presp += sizeof(uint32_t);
+
 		/* Increment current register address */
 		reg_addr++;
 		reg_qty--;
@@ -435,7 +572,9 @@ static bool mbs_fc04_inreg_read(struct modbus_context *ctx)
 	if ((reg_addr < MODBUS_FP_EXTENSIONS_ADDR) ||
 	    !IS_ENABLED(CONFIG_MODBUS_FP_EXTENSIONS)) {
 		/* Read integer register */
-		if (ctx->mbs_user_cb->input_reg_rd == NULL) {
+		if (ctx->input_map.regs == NULL &&
+		    ctx->mbs_user_cb->input_regs_rd == NULL &&
+		    ctx->mbs_user_cb->input_reg_rd == NULL) {
 			mbs_exception_rsp(ctx, MODBUS_EXC_ILLEGAL_FC);
 			return true;
 		}
@@ -472,37 +611,35 @@ static bool mbs_fc04_inreg_read(struct modbus_context *ctx)
 
 	/* Reset the pointer to the start of the response payload */
 	presp = &ctx->tx_adu.data[1];
-	/* Loop through each register requested. */
-	while (reg_qty > 0) {
-		if (reg_addr < MODBUS_FP_EXTENSIONS_ADDR) {
-			uint16_t reg;
-
-			/* Read integer register */
-			err = ctx->mbs_user_cb->input_reg_rd(reg_addr, &reg);
-			if (err == 0) {
-				sys_put_be16(reg, presp);
-				presp += sizeof(uint16_t);
-			}
+	if ((reg_addr < MODBUS_FP_EXTENSIONS_ADDR) ||
+	    !IS_ENABLED(CONFIG_MODBUS_FP_EXTENSIONS)) {
+		/* Read integer registers */
+		err = mbs_regs_read(&ctx->input_map, ctx->mbs_user_cb->input_regs_rd,
+				    ctx->mbs_user_cb->input_reg_rd, reg_addr, reg_qty, presp);
+		if (err != 0) {
+			LOG_INF("Input register address not supported");
+			mbs_exception_rsp(ctx, MODBUS_EXC_ILLEGAL_DATA_ADDR);
+		}
 
-		} else if (IS_ENABLED(CONFIG_MODBUS_FP_EXTENSIONS)) {
-			float fp;
-			uint32_t reg;
+		return true;
+	}
 
-			/* Read floating-point register */
-			err = ctx->mbs_user_cb->input_reg_rd_fp(reg_addr, &fp);
-			if (err == 0) {
-				memcpy(&reg, &fp, sizeof(reg));
-				sys_put_be32(reg, presp);
-				presp += sizeof(uint32_t);
-			}
-		}
+	/* Loop through each floating-point register requested. */
+	while (reg_qty > 0) {
+		float fp;
+		uint32_t reg;
 
+		err = ctx->mbs_user_cb->input_reg_rd_fp(reg_addr, &fp);
 		if (err != 0) {
 			LOG_INF("Input register address not supported");
 			mbs_exception_rsp(ctx, MODBUS_EXC_ILLEGAL_DATA_ADDR);
 			return true;
 		}
 
+		memcpy(&reg, &fp, sizeof(reg));
+		sys_put_be32(reg, presp);
+		presp += sizeof(uint32_t);
+
 		/* Increment current register number */
 		reg_addr++;
 		reg_qty--;
@@ -596,7 +733,7 @@ static bool mbs_fc06_hreg_write(struct modbus_context *ctx)
 		return false;
 	}
 
-	if (ctx->mbs_user_cb->holding_reg_wr == NULL) {
+	if (!mbs_hregs_writable(ctx)) {
 		mbs_exception_rsp(ctx, MODBUS_EXC_ILLEGAL_FC);
 		return true;
 	}
@@ -604,7 +741,7 @@ static bool mbs_fc06_hreg_write(struct modbus_context *ctx)
 	reg_addr = sys_get_be16(&ctx->rx_adu.data[0]);
 	reg_val = sys_get_be16(&ctx->rx_adu.data[2]);
 
-	err = ctx->mbs_user_cb->holding_reg_wr(reg_addr, reg_val);
+	err = mbs_hregs_write(ctx, reg_addr, 1, &ctx->rx_adu.data[2]);
 
 	if (err != 0) {
 		LOG_INF("Register address not supported");
@@ -848,7 +985,7 @@ static bool mbs_fc16_hregs_write(struct modbus_context *ctx)
 	if ((reg_addr < MODBUS_FP_EXTENSIONS_ADDR) ||
 	    !IS_ENABLED(CONFIG_MODBUS_FP_EXTENSIONS)) {
 		/* Write integer register */
-		if (ctx->mbs_user_cb->holding_reg_wr == NULL) {
+		if (!mbs_hregs_writable(ctx)) {
 			mbs_exception_rsp(ctx, MODBUS_EXC_ILLEGAL_FC);
 			return true;
 		}
@@ -892,30 +1029,19 @@ static bool mbs_fc16_hregs_write(struct modbus_context *ctx)
 	/* The 1st registers data byte is 6th element in payload */
 	prx_data = &ctx->rx_adu.data[5];
 
-	for (uint16_t reg_cntr = 0; reg_cntr < reg_qty; reg_cntr++) {
-		uint16_t addr = reg_addr + reg_cntr;
-
-		if ((reg_addr < MODBUS_FP_EXTENSIONS_ADDR) ||
-		    !IS_ENABLED(CONFIG_MODBUS_FP_EXTENSIONS)) {
-			uint16_t reg_val = sys_get_be16(prx_data);
-
-			prx_data += sizeof(uint16_t);
-			err = ctx->mbs_user_cb->holding_reg_wr(addr, reg_val);
-		} else {
-			uint32_t reg_val = sys_get_be32(prx_data);
-			float fp;
-
-			/* Write to floating point register */
-			memcpy(&fp, &reg_val, sizeof(float));
-			prx_data += sizeof(uint32_t);
-			err = ctx->mbs_user_cb->holding_reg_wr_fp(addr, fp);
-		}
+	if ((reg_addr < MODBUS_FP_EXTENSIONS_ADDR) ||
+	    !IS_ENABLED(CONFIG_MODBUS_FP_EXTENSIONS)) {
+		/* Write integer registers */
+		err = mbs_hregs_write(ctx, reg_addr, reg_qty, prx_data);
+	} else {
+		/* Write floating-point registers */
+		err = mbs_hregs_write_fp(ctx, reg_addr, reg_qty, prx_data);
+	}
 
-		if (err != 0) {
-			LOG_INF("Register address not supported");
-			mbs_exception_rsp(ctx, MODBUS_EXC_ILLEGAL_DATA_ADDR);
-			return true;
-		}
+	if (err != 0) {
+		LOG_INF("Register address not supported");
+		mbs_exception_rsp(ctx, MODBUS_EXC_ILLEGAL_DATA_ADDR);
+		return true;
 	}
 
 	/* Assemble response payload */
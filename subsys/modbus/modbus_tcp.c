@@ -0,0 +1,230 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(modbus_tcp, CONFIG_MODBUS_LOG_LEVEL);
+
+#include <zephyr/kernel.h>
+#include <zephyr/net/socket.h>
+#include <modbus_internal.h>
+
+#define MODBUS_TCP_MAX_CLIENTS	CONFIG_MODBUS_TCP_SERVER_MAX_CLIENTS
+
+struct modbus_tcp_client {
+	int sock;
+	/* Bytes of the request received */
+	size_t len;
+	/* MBAP header and function code, then the data, of the request */
+	uint8_t buf[MODBUS_MBAP_AND_FC_LENGTH + CONFIG_MODBUS_BUFFER_SIZE];
+};
+
+static struct modbus_tcp_client clients[MODBUS_TCP_MAX_CLIENTS];
+static struct zsock_pollfd fds[MODBUS_TCP_MAX_CLIENTS + 1];
+static struct modbus_adu tcp_adu;
+static int server_iface;
+static uint16_t server_port;
+static atomic_t started;
+static K_SEM_DEFINE(start_sem, 0, 1);
+
+static void client_close(struct modbus_tcp_client *client)
+{
+	LOG_DBG("Closing connection %d", client->sock);
+	(void)zsock_close(client->sock);
+	client->sock = -1;
+}
+
+static void client_accept(int serv)
+{
+	int sock;
+
+	sock = zsock_accept(serv, NULL, NULL);
+	if (sock < 0) {
+		LOG_ERR("Failed to accept connection (%d)", errno);
+		return;
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(clients); i++) {
+		if (clients[i].sock < 0) {
+			clients[i].sock = sock;
+			clients[i].len = 0;
+			LOG_DBG("Connection %d accepted", sock);
+			return;
+		}
+	}
+
+	LOG_WRN("Too many connections");
+	(void)zsock_close(sock);
+}
+
+static int client_reply(struct modbus_tcp_client *client)
+{
+	uint8_t header[MODBUS_MBAP_AND_FC_LENGTH];
+
+	modbus_raw_put_header(&tcp_adu, header);
+
+	if (zsock_send(client->sock, header, sizeof(header), 0) < 0 ||
+	    zsock_send(client->sock, tcp_adu.data, tcp_adu.length, 0) < 0) {
+		return -errno;
+	}
+
+	return 0;
+}
+
+/* Receive what is available of the request, answered once complete */
+static int client_process(struct modbus_tcp_client *client)
+{
+	size_t needed = MODBUS_MBAP_AND_FC_LENGTH;
+	ssize_t ret;
+	int err;
+
+	if (client->len >= MODBUS_MBAP_AND_FC_LENGTH) {
+		modbus_raw_get_header(&tcp_adu, client->buf);
+		needed += MIN(tcp_adu.length, sizeof(tcp_adu.data));
+	}
+
+	ret = zsock_recv(client->sock, &client->buf[client->len],
+			 needed - client->len, ZSOCK_MSG_DONTWAIT);
+	if (ret < 0) {
+		return errno == EAGAIN ? 0 : -errno;
+	}
+
+	if (ret == 0) {
+		return -ENOTCONN;
+	}
+
+	client->len += ret;
+
+	if (client->len == MODBUS_MBAP_AND_FC_LENGTH) {
+		/* The length of the data is known from the header */
+		modbus_raw_get_header(&tcp_adu, client->buf);
+		if (tcp_adu.length > 0) {
+			return 0;
+		}
+	} else if (client->len < needed) {
+		return 0;
+	}
+
+	modbus_raw_get_header(&tcp_adu, client->buf);
+	tcp_adu.length = client->len - MODBUS_MBAP_AND_FC_LENGTH;
+	memcpy(tcp_adu.data, &client->buf[MODBUS_MBAP_AND_FC_LENGTH],
+	       tcp_adu.length);
+	client->len = 0;
+
+	err = modbus_raw_server_txn(server_iface, &tcp_adu);
+	if (err == -ENODATA) {
+		return 0;
+	}
+
+	if (err != 0) {
+		modbus_raw_set_server_failure(&tcp_adu);
+	}
+
+	return client_reply(client);
+}
+
+static int server_socket(uint16_t port)
+{
+	struct sockaddr_in bind_addr = {
+		.sin_family = AF_INET,
+		.sin_addr.s_addr = htonl(INADDR_ANY),
+		.sin_port = htons(port),
+	};
+	int opt = 1;
+	int serv;
+
+	serv = zsock_socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	if (serv < 0) {
+		LOG_ERR("Failed to create socket (%d)", errno);
+		return -errno;
+	}
+
+	(void)zsock_setsockopt(serv, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
+
+	if (zsock_bind(serv, (struct sockaddr *)&bind_addr, sizeof(bind_addr)) < 0 ||
+	    zsock_listen(serv, MODBUS_TCP_MAX_CLIENTS) < 0) {
+		LOG_ERR("Failed to listen on port %u (%d)", port, errno);
+		(void)zsock_close(serv);
+		return -errno;
+	}
+
+	return serv;
+}
+
+static void modbus_tcp_server_thread(void)
+{
+	int serv;
+
+	(void)k_sem_take(&start_sem, K_FOREVER);
+
+	serv = server_socket(server_port);
+	if (serv < 0) {
+		atomic_clear(&started);
+		return;
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(clients); i++) {
+		clients[i].sock = -1;
+	}
+
+	LOG_INF("Modbus TCP server listening on port %u", server_port);
+
+	while (true) {
+		fds[0].fd = serv;
+		fds[0].events = ZSOCK_POLLIN;
+
+		for (size_t i = 0; i < ARRAY_SIZE(clients); i++) {
+			/* Negative descriptors are ignored */
+			fds[i + 1].fd = clients[i].sock;
+			fds[i + 1].events = ZSOCK_POLLIN;
+		}
+
+		if (zsock_poll(fds, ARRAY_SIZE(fds), -1) < 0) {
+			LOG_ERR("Failed to poll (%d)", errno);
+			k_sleep(K_MSEC(100));
+			continue;
+		}
+
+		for (size_t i = 0; i < ARRAY_SIZE(clients); i++) {
+			if (clients[i].sock < 0 || fds[i + 1].revents == 0) {
+				continue;
+			}
+
+			if ((fds[i + 1].revents & ZSOCK_POLLIN) == 0 ||
+			    client_process(&clients[i]) < 0) {
+				client_close(&clients[i]);
+			}
+		}
+
+		if ((fds[0].revents & ZSOCK_POLLIN) != 0) {
+			client_accept(serv);
+		}
+	}
+}
+
+K_THREAD_DEFINE(modbus_tcp_server, CONFIG_MODBUS_TCP_SERVER_STACK_SIZE,
+		modbus_tcp_server_thread, NULL, NULL, NULL,
+		CONFIG_MODBUS_TCP_SERVER_PRIORITY, 0, 0);
+
+int modbus_tcp_server_start(const int iface, uint16_t port)
+{
+	struct modbus_context *ctx;
+
+	ctx = modbus_get_context(iface);
+	if (ctx == NULL || ctx->client || ctx->mode != MODBUS_MODE_RAW) {
+		LOG_ERR("Interface %d is not a raw ADU server", iface);
+		return -ENODEV;
+	}
+
+	if (atomic_set(&started, 1) != 0) {
+		return -EALREADY;
+	}
+
+	server_iface = iface;
+	server_port = port;
+	k_sem_give(&start_sem);
+
+	return 0;
+}
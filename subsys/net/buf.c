@@ -17,6 +17,7 @@ LOG_MODULE_REGISTER(LOG_MODULE_NAME);
 #include <stddef.h>
 #include <string.h>
 #include <zephyr/sys/byteorder.h>
+#include <zephyr/cache.h>
 
 #include <zephyr/net/buf.h>
 
@@ -85,6 +86,112 @@ static inline struct net_buf *pool_get_uninit(struct net_buf_pool *pool,
 	return buf;
 }
 
+#if CONFIG_NET_BUF_POOL_CPU_CACHE > 0
+static struct net_buf_pool_cache *pool_cache_get(struct net_buf_pool *pool)
+{
+	return &pool->cache[COND_CODE_1(CONFIG_SMP, (arch_curr_cpu()->id), (0))];
+}
+
+static struct net_buf *pool_cache_alloc(struct net_buf_pool *pool)
+{
+	struct net_buf_pool_cache *cache = pool_cache_get(pool);
+	struct net_buf *buf = NULL;
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&cache->lock);
+
+	if (cache->count > 0U) {
+		buf = cache->bufs[--cache->count];
+	}
+
+	k_spin_unlock(&cache->lock, key);
+
+	return buf;
+}
+
+static bool pool_cache_free(struct net_buf_pool *pool, struct net_buf *buf)
+{
+	struct net_buf_pool_cache *cache = pool_cache_get(pool);
+	bool cached = false;
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&cache->lock);
+
+	/* Threads waiting for a buffer only look at the free LIFO */
+	if (cache->count < ARRAY_SIZE(cache->bufs) &&
+	    atomic_get(&pool->waiters) == 0) {
+		cache->bufs[cache->count++] = buf;
+		cached = true;
+	}
+
+	k_spin_unlock(&cache->lock, key);
+
+	return cached;
+}
+
+/* Called before waiting on the free LIFO: move the buffers cached by all
+ * the CPUs to it, and keep buffers freed from now on out of the caches
+ * until pool_cache_wait_end().
+ */
+static void pool_cache_wait_begin(struct net_buf_pool *pool)
+{
+	atomic_inc(&pool->waiters);
+
+	for (int i = 0; i < ARRAY_SIZE(pool->cache); i++) {
+		struct net_buf_pool_cache *cache = &pool->cache[i];
+		struct net_buf *head = NULL;
+		struct net_buf *tail = NULL;
+		k_spinlock_key_t key;
+
+		key = k_spin_lock(&cache->lock);
+
+		while (cache->count > 0U) {
+			struct net_buf *buf = cache->bufs[--cache->count];
+
+			buf->node.next = head ? &head->node : NULL;
+			head = buf;
+			tail = tail ? tail : buf;
+		}
+
+		k_spin_unlock(&cache->lock, key);
+
+		if (head) {
+			k_queue_append_list(&pool->free._queue, head, tail);
+		}
+	}
+}
+
+static void pool_cache_wait_end(struct net_buf_pool *pool)
+{
+	atomic_dec(&pool->waiters);
+}
+#else
+static inline struct net_buf *pool_cache_alloc(struct net_buf_pool *pool)
+{
+	ARG_UNUSED(pool);
+
+	return NULL;
+}
+
+static inline bool pool_cache_free(struct net_buf_pool *pool, struct net_buf *buf)
+{
+	ARG_UNUSED(pool);
+	ARG_UNUSED(buf);
+
+	return false;
+}
+
+static inline void pool_cache_wait_begin(struct net_buf_pool *pool)
+{
+	ARG_UNUSED(pool);
+}
+
+static inline void pool_cache_wait_end(struct net_buf_pool *pool)
+{
+	ARG_UNUSED(pool);
+}
+#endif /* CONFIG_NET_BUF_POOL_CPU_CACHE > 0 */
+
 void net_buf_reset(struct net_buf *buf)
 {
 	__ASSERT_NO_MSG(buf->flags == 0U);
@@ -232,6 +339,41 @@ static void data_unref(struct net_buf *buf, uint8_t *data)
 	pool->alloc->cb->unref(buf, data);
 }
 
+/* Initialize a buffer taken from the free LIFO or the uninitialized ones */
+static int buf_setup(struct net_buf_pool *pool, struct net_buf *buf,
+		     size_t size, k_timeout_t timeout)
+{
+	if (size) {
+#if __ASSERT_ON
+		size_t req_size = size;
+#endif
+		buf->__buf = data_alloc(buf, &size, timeout);
+		if (!buf->__buf) {
+			return -ENOMEM;
+		}
+
+#if __ASSERT_ON
+		NET_BUF_ASSERT(req_size <= size);
+#endif
+	} else {
+		buf->__buf = NULL;
+	}
+
+	buf->ref   = 1U;
+	buf->flags = 0U;
+	buf->frags = NULL;
+	buf->size  = size;
+	net_buf_reset(buf);
+
+#if defined(CONFIG_NET_BUF_POOL_USAGE)
+	atomic_dec(&pool->avail_count);
+	__ASSERT_NO_MSG(atomic_get(&pool->avail_count) >= 0);
+#else
+	ARG_UNUSED(pool);
+#endif
+	return 0;
+}
+
 #if defined(CONFIG_NET_BUF_LOG)
 struct net_buf *net_buf_alloc_len_debug(struct net_buf_pool *pool, size_t size,
 					k_timeout_t timeout, const char *func,
@@ -249,6 +391,11 @@ struct net_buf *net_buf_alloc_len(struct net_buf_pool *pool, size_t size,
 
 	NET_BUF_DBG("%s():%d: pool %p size %zu", func, line, pool, size);
 
+	buf = pool_cache_alloc(pool);
+	if (buf) {
+		goto success;
+	}
+
 	/* We need to prevent race conditions
 	 * when accessing pool->uninit_count.
 	 */
@@ -281,6 +428,16 @@ struct net_buf *net_buf_alloc_len(struct net_buf_pool *pool, size_t size,
 
 	k_spin_unlock(&pool->lock, key);
 
+	/* Flushing the per-CPU caches only pays off for a caller that is
+	 * going to wait, without a timeout just try the free LIFO.
+	 */
+	if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		buf = k_lifo_get(&pool->free, K_NO_WAIT);
+		goto done;
+	}
+
+	pool_cache_wait_begin(pool);
+
 #if defined(CONFIG_NET_BUF_LOG) && (CONFIG_NET_BUF_LOG_LEVEL >= LOG_LEVEL_WRN)
 	if (K_TIMEOUT_EQ(timeout, K_FOREVER)) {
 		uint32_t ref = k_uptime_get_32();
@@ -310,6 +467,9 @@ struct net_buf *net_buf_alloc_len(struct net_buf_pool *pool, size_t size,
 #else
 	buf = k_lifo_get(&pool->free, timeout);
 #endif
+	pool_cache_wait_end(pool);
+
+done:
 	if (!buf) {
 		NET_BUF_ERR("%s():%d: Failed to get free buffer", func, line);
 		return NULL;
@@ -318,37 +478,111 @@ struct net_buf *net_buf_alloc_len(struct net_buf_pool *pool, size_t size,
 success:
 	NET_BUF_DBG("allocated buf %p", buf);
 
-	if (size) {
-#if __ASSERT_ON
-		size_t req_size = size;
-#endif
-		timeout = sys_timepoint_timeout(end);
-		buf->__buf = data_alloc(buf, &size, timeout);
-		if (!buf->__buf) {
-			NET_BUF_ERR("%s():%d: Failed to allocate data",
-				    func, line);
+	if (buf_setup(pool, buf, size, sys_timepoint_timeout(end)) < 0) {
+		NET_BUF_ERR("%s():%d: Failed to allocate data", func, line);
+		net_buf_destroy(buf);
+		return NULL;
+	}
+
+	return buf;
+}
+
+struct net_buf *net_buf_alloc_bulk(struct net_buf_pool *pool, size_t size,
+				   size_t count, k_timeout_t timeout)
+{
+	k_timepoint_t end = sys_timepoint_calc(timeout);
+	struct net_buf *head = NULL;
+	struct net_buf *tail = NULL;
+	struct net_buf *buf;
+	sys_slist_t bufs;
+	k_spinlock_key_t key;
+
+	__ASSERT_NO_MSG(pool);
+	__ASSERT_NO_MSG(count > 0);
+
+	NET_BUF_DBG("pool %p size %zu count %zu", pool, size, count);
+
+	sys_slist_init(&bufs);
+
+	while (count > 0) {
+		buf = pool_cache_alloc(pool);
+		if (!buf) {
+			break;
+		}
+
+		sys_slist_append(&bufs, &buf->node);
+		count--;
+	}
+
+	/* Take whatever else is readily available with a single lock */
+	key = k_spin_lock(&pool->lock);
+
+	while (count > 0) {
+		buf = NULL;
+
+		if (pool->uninit_count < pool->buf_count) {
+			buf = k_lifo_get(&pool->free, K_NO_WAIT);
+		}
+
+		if (!buf && pool->uninit_count) {
+			buf = pool_get_uninit(pool, pool->uninit_count--);
+		}
+
+		if (!buf) {
+			break;
+		}
+
+		sys_slist_append(&bufs, &buf->node);
+		count--;
+	}
+
+	k_spin_unlock(&pool->lock, key);
+
+	while ((buf = (void *)sys_slist_get(&bufs)) != NULL) {
+		if (buf_setup(pool, buf, size, sys_timepoint_timeout(end)) < 0) {
+			NET_BUF_ERR("Failed to allocate data");
 			net_buf_destroy(buf);
-			return NULL;
+			goto fail;
 		}
 
-#if __ASSERT_ON
-		NET_BUF_ASSERT(req_size <= size);
-#endif
-	} else {
-		buf->__buf = NULL;
+		if (tail) {
+			tail->frags = buf;
+		} else {
+			head = buf;
+		}
+
+		tail = buf;
 	}
 
-	buf->ref   = 1U;
-	buf->flags = 0U;
-	buf->frags = NULL;
-	buf->size  = size;
-	net_buf_reset(buf);
+	/* Wait for the rest one by one */
+	while (count > 0) {
+		buf = net_buf_alloc_len(pool, size, sys_timepoint_timeout(end));
+		if (!buf) {
+			goto fail;
+		}
 
-#if defined(CONFIG_NET_BUF_POOL_USAGE)
-	atomic_dec(&pool->avail_count);
-	__ASSERT_NO_MSG(atomic_get(&pool->avail_count) >= 0);
-#endif
-	return buf;
+		if (tail) {
+			tail->frags = buf;
+		} else {
+			head = buf;
+		}
+
+		tail = buf;
+		count--;
+	}
+
+	return head;
+
+fail:
+	while ((buf = (void *)sys_slist_get(&bufs)) != NULL) {
+		net_buf_destroy(buf);
+	}
+
+	if (head) {
+		net_buf_unref_chain_bulk(head);
+	}
+
+	return NULL;
 }
 
 #if defined(CONFIG_NET_BUF_LOG)
@@ -458,6 +692,29 @@ void net_buf_put(struct k_fifo *fifo, struct net_buf *buf)
 	k_fifo_put(fifo, buf);
 }
 
+/* Release the data of a buffer whose last reference was dropped */
+static struct net_buf_pool *buf_release(struct net_buf *buf)
+{
+	struct net_buf_pool *pool;
+
+	if (buf->__buf) {
+		data_unref(buf, buf->__buf);
+		buf->__buf = NULL;
+	}
+
+	buf->data = NULL;
+	buf->frags = NULL;
+
+	pool = net_buf_pool_get(buf->pool_id);
+
+#if defined(CONFIG_NET_BUF_POOL_USAGE)
+	atomic_inc(&pool->avail_count);
+	__ASSERT_NO_MSG(atomic_get(&pool->avail_count) <= pool->buf_count);
+#endif
+
+	return pool;
+}
+
 #if defined(CONFIG_NET_BUF_LOG)
 void net_buf_unref_debug(struct net_buf *buf, const char *func, int line)
 #else
@@ -484,29 +741,76 @@ void net_buf_unref(struct net_buf *buf)
 			return;
 		}
 
-		if (buf->__buf) {
-			data_unref(buf, buf->__buf);
-			buf->__buf = NULL;
+		pool = buf_release(buf);
+
+		if (pool->destroy) {
+			pool->destroy(buf);
+		} else if (!pool_cache_free(pool, buf)) {
+			net_buf_destroy(buf);
 		}
 
-		buf->data = NULL;
-		buf->frags = NULL;
+		buf = frags;
+	}
+}
 
-		pool = net_buf_pool_get(buf->pool_id);
+void net_buf_unref_chain_bulk(struct net_buf *buf)
+{
+	struct net_buf_pool *list_pool = NULL;
+	struct net_buf *head = NULL;
+	struct net_buf *tail = NULL;
 
-#if defined(CONFIG_NET_BUF_POOL_USAGE)
-		atomic_inc(&pool->avail_count);
-		__ASSERT_NO_MSG(atomic_get(&pool->avail_count) <= pool->buf_count);
+	__ASSERT_NO_MSG(buf);
+
+	while (buf) {
+		struct net_buf *frags = buf->frags;
+		struct net_buf_pool *pool;
+
+#if defined(CONFIG_NET_BUF_LOG)
+		if (!buf->ref) {
+			NET_BUF_ERR("buf %p double free", buf);
+			break;
+		}
 #endif
 
+		NET_BUF_DBG("buf %p ref %u pool_id %u frags %p", buf, buf->ref,
+			    buf->pool_id, buf->frags);
+
+		if (--buf->ref > 0) {
+			break;
+		}
+
+		pool = buf_release(buf);
+
 		if (pool->destroy) {
 			pool->destroy(buf);
-		} else {
-			net_buf_destroy(buf);
+		} else if (!pool_cache_free(pool, buf)) {
+			/* Hand the buffers collected so far back to their
+			 * pool when the chain moves on to another one
+			 */
+			if (pool != list_pool && head) {
+				k_queue_append_list(&list_pool->free._queue,
+						    head, tail);
+				head = NULL;
+			}
+
+			buf->node.next = NULL;
+
+			if (head) {
+				tail->node.next = &buf->node;
+			} else {
+				head = buf;
+			}
+
+			tail = buf;
+			list_pool = pool;
 		}
 
 		buf = frags;
 	}
+
+	if (head) {
+		k_queue_append_list(&list_pool->free._queue, head, tail);
+	}
 }
 
 struct net_buf *net_buf_ref(struct net_buf *buf)
@@ -664,6 +968,48 @@ size_t net_buf_linearize(void *dst, size_t dst_len, struct net_buf *src,
 	return copied;
 }
 
+/* Number of fragments whose cache maintenance is batched together */
+#define CACHE_RANGES 8
+
+typedef int (*cache_ranges_op_t)(const struct sys_cache_range *ranges,
+				 size_t count);
+
+static int net_buf_cache_op(struct net_buf *buf, bool tailroom,
+			    cache_ranges_op_t op)
+{
+	struct sys_cache_range ranges[CACHE_RANGES];
+	size_t count = 0;
+	int err;
+
+	for (; buf; buf = buf->frags) {
+		ranges[count].addr = buf->data;
+		ranges[count].size = tailroom ? net_buf_max_len(buf) : buf->len;
+
+		if (ranges[count].size == 0U || ++count < ARRAY_SIZE(ranges)) {
+			continue;
+		}
+
+		err = op(ranges, count);
+		if (err) {
+			return err;
+		}
+
+		count = 0;
+	}
+
+	return count ? op(ranges, count) : 0;
+}
+
+int net_buf_cache_flush(struct net_buf *buf)
+{
+	return net_buf_cache_op(buf, false, sys_cache_data_flush_ranges);
+}
+
+int net_buf_cache_invd(struct net_buf *buf)
+{
+	return net_buf_cache_op(buf, true, sys_cache_data_invd_ranges);
+}
+
 /* This helper routine will append multiple bytes, if there is no place for
  * the data in current fragment then create new fragment and add it to
  * the buffer. It assumes that the buffer has at least one fragment.
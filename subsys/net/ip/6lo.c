@@ -46,6 +46,34 @@ static inline uint8_t get_6co_cid(struct net_icmpv6_nd_opt_6co *opt)
 static struct net_6lo_context ctx_6co[CONFIG_NET_MAX_6LO_CONTEXTS];
 #endif
 
+#if CONFIG_NET_6LO_COMPRESS_CACHE_SIZE > 0
+/* Largest IPHC header: dispatch, CID, TF, NH, HLIM and both addresses
+ * inlined, followed by a UDP NHC with the ports and checksum inlined.
+ */
+#define COMPRESS_CACHE_HDR_MAX (2 + 1 + 4 + 1 + 1 + 16 + 16 + 1 + 4 + 2)
+
+struct compress_cache_key {
+	struct net_if *iface;
+	/* IPv6 header with the payload length cleared, and UDP ports */
+	uint8_t hdr[NET_IPV6H_LEN + 2 * sizeof(uint16_t)];
+	uint8_t lladdr_src[8];
+	uint8_t lladdr_dst[8];
+	uint8_t lladdr_src_len;
+	uint8_t lladdr_dst_len;
+};
+
+struct compress_cache_entry {
+	struct compress_cache_key key;
+	uint8_t compressed[COMPRESS_CACHE_HDR_MAX];
+	/* Length of the compressed header, 0 if the entry is unused */
+	uint8_t compressed_len;
+};
+
+static struct compress_cache_entry compress_cache[CONFIG_NET_6LO_COMPRESS_CACHE_SIZE];
+static uint8_t compress_cache_next;
+static struct k_spinlock compress_cache_lock;
+#endif
+
 static const uint8_t udp_nhc_inline_size_table[] = {4, 3, 3, 1};
 
 static const uint8_t tf_inline_size_table[] = {4, 3, 1, 0};
@@ -157,6 +185,8 @@ static inline bool net_6lo_maddr_48_bit_compressible(struct in6_addr *addr)
 
 #if defined(CONFIG_NET_6LO_CONTEXT)
 /* RFC 6775, 4.2, 5.4.2, 5.4.3 and 7.2*/
+static inline void compress_cache_flush(void);
+
 static inline void set_6lo_context(struct net_if *iface, uint8_t index,
 				   struct net_icmpv6_nd_opt_6co *context)
 
@@ -170,6 +200,8 @@ static inline void set_6lo_context(struct net_if *iface, uint8_t index,
 	ctx_6co[index].cid = get_6co_cid(context);
 
 	net_ipv6_addr_copy_raw((uint8_t *)&ctx_6co[index].prefix, context->prefix);
+
+	compress_cache_flush();
 }
 
 void net_6lo_set_context(struct net_if *iface,
@@ -192,6 +224,7 @@ void net_6lo_set_context(struct net_if *iface,
 			/* Remove if lifetime is zero */
 			if (!context->lifetime) {
 				ctx_6co[i].is_used = false;
+				compress_cache_flush();
 				return;
 			}
 
@@ -832,13 +865,181 @@ sa_end:
 
 	compressed = inline_pos - pkt->buffer->data;
 
+	/* The link layers send the fragments as they are, so the payload
+	 * does not need to be moved against the compressed header.
+	 */
+	net_buf_pull(pkt->buffer, compressed);
 	net_pkt_cursor_init(pkt);
-	net_pkt_pull(pkt, compressed);
-	net_pkt_compact(pkt);
 
 	return compressed;
 }
 
+#if CONFIG_NET_6LO_COMPRESS_CACHE_SIZE > 0
+static inline void compress_cache_flush(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&compress_cache_lock);
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(compress_cache); i++) {
+		compress_cache[i].compressed_len = 0U;
+	}
+
+	k_spin_unlock(&compress_cache_lock, key);
+}
+
+static bool compress_cache_key_get(struct net_pkt *pkt, struct compress_cache_key *key)
+{
+	struct net_linkaddr *src = net_pkt_lladdr_src(pkt);
+	struct net_linkaddr *dst = net_pkt_lladdr_dst(pkt);
+	struct net_ipv6_hdr *ipv6 = NET_IPV6_HDR(pkt);
+	size_t hdr_len = NET_IPV6H_LEN;
+
+	if (pkt->frags->len < NET_IPV6H_LEN) {
+		return false;
+	}
+
+	if (ipv6->nexthdr == IPPROTO_UDP) {
+		hdr_len = NET_IPV6UDPH_LEN;
+		if (pkt->frags->len < hdr_len) {
+			return false;
+		}
+	}
+
+	if (src->len > sizeof(key->lladdr_src) || dst->len > sizeof(key->lladdr_dst)) {
+		return false;
+	}
+
+	/* Everything but the lengths and the UDP checksum ends up in the
+	 * compressed header.
+	 */
+	(void)memset(key, 0, sizeof(*key));
+
+	key->iface = net_pkt_iface(pkt);
+	memcpy(key->hdr, ipv6, NET_IPV6H_LEN);
+	UNALIGNED_PUT(0, (uint16_t *)&key->hdr[offsetof(struct net_ipv6_hdr, len)]);
+
+	if (hdr_len == NET_IPV6UDPH_LEN) {
+		memcpy(&key->hdr[NET_IPV6H_LEN], pkt->frags->data + NET_IPV6H_LEN,
+		       2 * sizeof(uint16_t));
+	}
+
+	memcpy(key->lladdr_src, src->addr, src->len);
+	key->lladdr_src_len = src->len;
+	memcpy(key->lladdr_dst, dst->addr, dst->len);
+	key->lladdr_dst_len = dst->len;
+
+	return true;
+}
+
+static int compress_cache_apply(struct net_pkt *pkt, const struct compress_cache_key *key)
+{
+	struct net_ipv6_hdr *ipv6 = NET_IPV6_HDR(pkt);
+	size_t hdr_len = NET_IPV6H_LEN;
+	k_spinlock_key_t lock_key;
+	uint16_t chksum = 0U;
+	int compressed = -ENOENT;
+	uint8_t *pos;
+	int i;
+
+	if (ipv6->nexthdr == IPPROTO_UDP) {
+		hdr_len = NET_IPV6UDPH_LEN;
+		chksum = UNALIGNED_GET(&((struct net_udp_hdr *)
+					 (pkt->frags->data + NET_IPV6H_LEN))->chksum);
+	}
+
+	lock_key = k_spin_lock(&compress_cache_lock);
+
+	for (i = 0; i < ARRAY_SIZE(compress_cache); i++) {
+		struct compress_cache_entry *entry = &compress_cache[i];
+
+		if (entry->compressed_len == 0U ||
+		    memcmp(&entry->key, key, sizeof(*key)) != 0) {
+			continue;
+		}
+
+		/* Same layout as compress_IPHC_header(), the compressed
+		 * header ends where the uncompressed one did.
+		 */
+		compressed = hdr_len - entry->compressed_len;
+		pos = pkt->frags->data + compressed;
+		memcpy(pos, entry->compressed, entry->compressed_len);
+
+		if (hdr_len == NET_IPV6UDPH_LEN) {
+			/* The checksum is inlined last */
+			UNALIGNED_PUT(chksum, (uint16_t *)(pos + entry->compressed_len -
+							   sizeof(chksum)));
+		}
+
+		break;
+	}
+
+	k_spin_unlock(&compress_cache_lock, lock_key);
+
+	if (compressed < 0) {
+		return compressed;
+	}
+
+	NET_DBG("pkt %p header compressed from cache", pkt);
+
+	net_buf_pull(pkt->buffer, compressed);
+	net_pkt_cursor_init(pkt);
+
+	return compressed;
+}
+
+static void compress_cache_store(struct net_pkt *pkt, const struct compress_cache_key *key,
+				 int compressed)
+{
+	size_t hdr_len = key->hdr[offsetof(struct net_ipv6_hdr, nexthdr)] == IPPROTO_UDP ?
+			 NET_IPV6UDPH_LEN : NET_IPV6H_LEN;
+	struct compress_cache_entry *entry;
+	k_spinlock_key_t lock_key;
+
+	if (hdr_len - compressed > COMPRESS_CACHE_HDR_MAX) {
+		return;
+	}
+
+	lock_key = k_spin_lock(&compress_cache_lock);
+
+	entry = &compress_cache[compress_cache_next];
+	compress_cache_next = (compress_cache_next + 1) % ARRAY_SIZE(compress_cache);
+
+	entry->key = *key;
+	entry->compressed_len = hdr_len - compressed;
+	memcpy(entry->compressed, pkt->frags->data, entry->compressed_len);
+
+	k_spin_unlock(&compress_cache_lock, lock_key);
+}
+
+static int compress_IPHC_header_cached(struct net_pkt *pkt)
+{
+	struct compress_cache_key key;
+	int compressed;
+
+	if (!compress_cache_key_get(pkt, &key)) {
+		return compress_IPHC_header(pkt);
+	}
+
+	compressed = compress_cache_apply(pkt, &key);
+	if (compressed >= 0) {
+		return compressed;
+	}
+
+	compressed = compress_IPHC_header(pkt);
+	if (compressed >= 0) {
+		compress_cache_store(pkt, &key, compressed);
+	}
+
+	return compressed;
+}
+#else
+static inline void compress_cache_flush(void)
+{
+}
+
+#define compress_IPHC_header_cached compress_IPHC_header
+#endif /* CONFIG_NET_6LO_COMPRESS_CACHE_SIZE > 0 */
+
 /* Helper to uncompress Traffic class and Flow label */
 static inline uint8_t *uncompress_tfl(uint16_t iphc, uint8_t *cursor,
 				  struct net_ipv6_hdr *ipv6)
@@ -1569,7 +1770,7 @@ static inline bool uncompress_ipv6_header(struct net_pkt *pkt)
 int net_6lo_compress(struct net_pkt *pkt, bool iphc)
 {
 	if (iphc) {
-		return compress_IPHC_header(pkt);
+		return compress_IPHC_header_cached(pkt);
 	} else {
 		return compress_ipv6_header(pkt);
 	}
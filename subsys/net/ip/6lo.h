@@ -23,8 +23,9 @@
  *  @brief Compress IPv6 packet as per RFC 6282
  *
  *  @details After this IPv6 packet and next header(if UDP), headers
- *  are compressed as per RFC 6282. After header compression data
- *  will be adjusted according to remaining space in fragments.
+ *  are compressed as per RFC 6282. With IPHC the compressed headers are
+ *  left in the first fragment and the data is not moved, so the fragments
+ *  of the packet are not full anymore.
  *
  *  @param Pointer to network packet
  *  @param iphc true for IPHC compression, false for IPv6 dispatch header
@@ -64,6 +64,52 @@ static struct net_conn conns[CONFIG_NET_MAX_CONN];
 static sys_slist_t conn_unused;
 static sys_slist_t conn_used;
 
+#if defined(CONFIG_NET_CONN_HASH)
+/* The UDP and TCP handlers bound to a local port are also linked in a
+ * bucket indexed by protocol and local port, all the other handlers in
+ * conn_wildcard. Like conn_used, the lists are kept newest first.
+ */
+static sys_slist_t conn_hash[CONFIG_NET_CONN_HASH_BUCKETS];
+static sys_slist_t conn_wildcard;
+static uint32_t conn_seq;
+
+/* The port is in network byte order */
+static inline sys_slist_t *conn_hash_bucket(uint16_t proto, uint16_t port)
+{
+	return &conn_hash[(ntohs(port) ^ proto) % CONFIG_NET_CONN_HASH_BUCKETS];
+}
+
+static sys_slist_t *conn_hash_list(struct net_conn *conn)
+{
+	uint16_t port = net_sin(&conn->local_addr)->sin_port;
+
+	if ((conn->proto == IPPROTO_UDP || conn->proto == IPPROTO_TCP) &&
+	    (conn->family == AF_INET || conn->family == AF_INET6 ||
+	     conn->family == AF_UNSPEC) && port != 0U) {
+		return conn_hash_bucket(conn->proto, port);
+	}
+
+	return &conn_wildcard;
+}
+
+static inline struct net_conn *conn_hash_node_to_conn(sys_snode_t *node)
+{
+	return node == NULL ? NULL :
+		CONTAINER_OF(node, struct net_conn, hash_node);
+}
+#endif /* CONFIG_NET_CONN_HASH */
+
+/* Iterates over the handlers that may match a received packet, in the order
+ * of conn_used.
+ */
+struct conn_iter {
+	sys_snode_t *node;
+#if defined(CONFIG_NET_CONN_HASH)
+	sys_snode_t *wildcard;
+	bool hashed;
+#endif
+};
+
 #if (CONFIG_NET_CONN_LOG_LEVEL >= LOG_LEVEL_DBG)
 static inline
 void conn_register_debug(struct net_conn *conn,
@@ -141,6 +187,10 @@ static void conn_set_used(struct net_conn *conn)
 
 	k_mutex_lock(&conn_lock, K_FOREVER);
 	sys_slist_prepend(&conn_used, &conn->node);
+#if defined(CONFIG_NET_CONN_HASH)
+	conn->seq = conn_seq++;
+	sys_slist_prepend(conn_hash_list(conn), &conn->hash_node);
+#endif
 	k_mutex_unlock(&conn_lock);
 }
 
@@ -397,6 +447,9 @@ int net_conn_unregister(struct net_conn_handle *handle)
 
 	k_mutex_lock(&conn_lock, K_FOREVER);
 	sys_slist_find_and_remove(&conn_used, &conn->node);
+#if defined(CONFIG_NET_CONN_HASH)
+	sys_slist_find_and_remove(conn_hash_list(conn), &conn->hash_node);
+#endif
 	k_mutex_unlock(&conn_lock);
 
 	conn_set_unused(conn);
@@ -567,6 +620,68 @@ static enum net_verdict conn_raw_socket(struct net_pkt *pkt,
 	return NET_OK;
 }
 
+static void conn_iter_init(struct conn_iter *iter, uint8_t family,
+			   uint8_t proto, uint16_t dst_port)
+{
+#if defined(CONFIG_NET_CONN_HASH)
+	/* Only the handlers of the destination port and the ones without a
+	 * local port can match an UDP or TCP packet.
+	 */
+	iter->hashed = (family == AF_INET || family == AF_INET6) &&
+		       (proto == IPPROTO_UDP || proto == IPPROTO_TCP);
+	if (iter->hashed) {
+		iter->node = sys_slist_peek_head(conn_hash_bucket(proto, dst_port));
+		iter->wildcard = sys_slist_peek_head(&conn_wildcard);
+		return;
+	}
+#else
+	ARG_UNUSED(family);
+	ARG_UNUSED(proto);
+	ARG_UNUSED(dst_port);
+#endif
+
+	iter->node = sys_slist_peek_head(&conn_used);
+}
+
+static struct net_conn *conn_iter_next(struct conn_iter *iter)
+{
+	struct net_conn *conn;
+
+#if defined(CONFIG_NET_CONN_HASH)
+	if (iter->hashed) {
+		struct net_conn *port_conn = conn_hash_node_to_conn(iter->node);
+		struct net_conn *wildcard_conn =
+			conn_hash_node_to_conn(iter->wildcard);
+
+		/* Merge both lists newest first, as the best match depends
+		 * on the order of the handlers.
+		 */
+		if (port_conn == NULL ||
+		    (wildcard_conn != NULL &&
+		     (int32_t)(wildcard_conn->seq - port_conn->seq) > 0)) {
+			if (wildcard_conn != NULL) {
+				iter->wildcard = sys_slist_peek_next(iter->wildcard);
+			}
+
+			return wildcard_conn;
+		}
+
+		iter->node = sys_slist_peek_next(iter->node);
+
+		return port_conn;
+	}
+#endif
+
+	if (iter->node == NULL) {
+		return NULL;
+	}
+
+	conn = CONTAINER_OF(iter->node, struct net_conn, node);
+	iter->node = sys_slist_peek_next(iter->node);
+
+	return conn;
+}
+
 enum net_verdict net_conn_input(struct net_pkt *pkt,
 				union net_ip_header *ip_hdr,
 				uint8_t proto,
@@ -621,6 +736,7 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 	bool is_bcast_pkt = false;
 	bool raw_pkt_delivered = false;
 	bool raw_pkt_continue = false;
+	struct conn_iter iter;
 	struct net_conn *conn;
 
 	if (IS_ENABLED(CONFIG_NET_IP)) {
@@ -639,7 +755,9 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 		}
 	}
 
-	SYS_SLIST_FOR_EACH_CONTAINER(&conn_used, conn, node) {
+	conn_iter_init(&iter, pkt_family, proto, dst_port);
+
+	for (conn = conn_iter_next(&iter); conn != NULL; conn = conn_iter_next(&iter)) {
 		/* Is the candidate connection matching the packet's interface? */
 		if (conn->context != NULL &&
 		    net_context_is_bound_to_iface(conn->context) &&
@@ -862,6 +980,14 @@ void net_conn_init(void)
 	sys_slist_init(&conn_unused);
 	sys_slist_init(&conn_used);
 
+#if defined(CONFIG_NET_CONN_HASH)
+	for (i = 0; i < CONFIG_NET_CONN_HASH_BUCKETS; i++) {
+		sys_slist_init(&conn_hash[i]);
+	}
+
+	sys_slist_init(&conn_wildcard);
+#endif
+
 	for (i = 0; i < CONFIG_NET_MAX_CONN; i++) {
 		sys_slist_prepend(&conn_unused, &conns[i].node);
 	}
@@ -54,6 +54,14 @@ struct net_conn {
 	/** Internal slist node */
 	sys_snode_t node;
 
+#if defined(CONFIG_NET_CONN_HASH)
+	/** Internal slist node for the hash table bucket */
+	sys_snode_t hash_node;
+
+	/** Registration order, newest first as in the list of handlers */
+	uint32_t seq;
+#endif
+
 	/** Remote socket address */
 	struct sockaddr remote_addr;
 
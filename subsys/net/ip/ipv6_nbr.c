@@ -255,6 +255,97 @@ void nbr_print(void)
 #define nbr_print(...)
 #endif
 
+#if defined(CONFIG_NET_IPV6_NBR_CACHE_HASH)
+#define NBR_HASH_BUCKETS CONFIG_NET_IPV6_MAX_NEIGHBORS
+#define NBR_HASH_END 0xff
+
+/* The neighbors are chained by their index in the pool into the bucket of
+ * their address hash. A neighbor stays in its chain when it is released
+ * and only moves when its entry is reused, so the chains need to be
+ * checked for the reference count.
+ */
+static uint8_t nbr_hash_head[NBR_HASH_BUCKETS] = {
+	[0 ... (NBR_HASH_BUCKETS - 1)] = NBR_HASH_END
+};
+static uint8_t nbr_hash_next[CONFIG_NET_IPV6_MAX_NEIGHBORS];
+static uint8_t nbr_hash_bucket[CONFIG_NET_IPV6_MAX_NEIGHBORS] = {
+	[0 ... (CONFIG_NET_IPV6_MAX_NEIGHBORS - 1)] = NBR_HASH_END
+};
+
+static uint8_t nbr_hash(const struct in6_addr *addr)
+{
+	uint32_t hash = UNALIGNED_GET(&addr->s6_addr32[0]) ^
+			UNALIGNED_GET(&addr->s6_addr32[1]) ^
+			UNALIGNED_GET(&addr->s6_addr32[2]) ^
+			UNALIGNED_GET(&addr->s6_addr32[3]);
+
+	hash *= 0x9e3779b1U;
+
+	return (hash >> 16) % NBR_HASH_BUCKETS;
+}
+
+static inline uint8_t nbr_index(struct net_nbr *nbr)
+{
+	return ((uint8_t *)nbr - (uint8_t *)net_neighbor_pool) /
+		sizeof(net_neighbor_pool[0]);
+}
+
+static void nbr_hash_add(struct net_nbr *nbr)
+{
+	uint8_t idx = nbr_index(nbr);
+	uint8_t bucket = nbr_hash(&net_ipv6_nbr_data(nbr)->addr);
+	uint8_t *link;
+
+	if (nbr_hash_bucket[idx] == bucket) {
+		return;
+	}
+
+	if (nbr_hash_bucket[idx] != NBR_HASH_END) {
+		link = &nbr_hash_head[nbr_hash_bucket[idx]];
+
+		while (*link != idx) {
+			link = &nbr_hash_next[*link];
+		}
+
+		*link = nbr_hash_next[idx];
+	}
+
+	nbr_hash_next[idx] = nbr_hash_head[bucket];
+	nbr_hash_bucket[idx] = bucket;
+	nbr_hash_head[bucket] = idx;
+}
+
+static struct net_nbr *nbr_lookup(struct net_nbr_table *table,
+				  struct net_if *iface,
+				  const struct in6_addr *addr)
+{
+	uint8_t i;
+
+	for (i = nbr_hash_head[nbr_hash(addr)]; i != NBR_HASH_END;
+	     i = nbr_hash_next[i]) {
+		struct net_nbr *nbr = get_nbr(i);
+
+		if (!nbr->ref) {
+			continue;
+		}
+
+		if (iface && nbr->iface != iface) {
+			continue;
+		}
+
+		if (net_ipv6_addr_cmp(&net_ipv6_nbr_data(nbr)->addr, addr)) {
+			return nbr;
+		}
+	}
+
+	return NULL;
+}
+#else
+static inline void nbr_hash_add(struct net_nbr *nbr)
+{
+	ARG_UNUSED(nbr);
+}
+
 static struct net_nbr *nbr_lookup(struct net_nbr_table *table,
 				  struct net_if *iface,
 				  const struct in6_addr *addr)
@@ -279,6 +370,7 @@ static struct net_nbr *nbr_lookup(struct net_nbr_table *table,
 
 	return NULL;
 }
+#endif /* CONFIG_NET_IPV6_NBR_CACHE_HASH */
 
 static inline void nbr_clear_ns_pending(struct net_ipv6_nbr_data *data)
 {
@@ -407,6 +499,7 @@ static void nbr_init(struct net_nbr *nbr, struct net_if *iface,
 	nbr->iface = iface;
 
 	net_ipaddr_copy(&net_ipv6_nbr_data(nbr)->addr, addr);
+	nbr_hash_add(nbr);
 	ipv6_nbr_set_state(nbr, state);
 	net_ipv6_nbr_data(nbr)->is_router = is_router;
 	net_ipv6_nbr_data(nbr)->pending = NULL;
@@ -784,9 +877,10 @@ enum net_verdict net_ipv6_prepare_for_send(struct net_pkt *pkt)
 
 #if defined(CONFIG_NET_IPV6_FRAGMENT)
 	/* If we have already fragmented the packet, the fragment id will
-	 * contain a proper value and we can skip other checks.
+	 * contain a proper value and we can skip other checks. TCP
+	 * super-segments are split in segments instead.
 	 */
-	if (net_pkt_ipv6_fragment_id(pkt) == 0U) {
+	if (net_pkt_ipv6_fragment_id(pkt) == 0U && net_pkt_gso_size(pkt) == 0U) {
 		uint16_t mtu = net_if_get_mtu(net_pkt_iface(pkt));
 		size_t pkt_len = net_pkt_get_len(pkt);
 
@@ -1476,7 +1476,8 @@ static int context_sendto(struct net_context *context,
 			  net_context_send_cb_t cb,
 			  k_timeout_t timeout,
 			  void *user_data,
-			  bool sendto)
+			  bool sendto,
+			  struct net_buf **frags)
 {
 	const struct msghdr *msghdr = NULL;
 	struct net_if *iface;
@@ -1499,6 +1500,13 @@ static int context_sendto(struct net_context *context,
 		return -EDESTADDRREQ;
 	}
 
+	/* Data buffers are only sent as is in UDP datagrams */
+	if (frags && (net_context_get_proto(context) != IPPROTO_UDP ||
+		      (IS_ENABLED(CONFIG_NET_OFFLOAD) &&
+		       net_if_is_ip_offloaded(net_context_get_iface(context))))) {
+		return -EOPNOTSUPP;
+	}
+
 	if (IS_ENABLED(CONFIG_NET_IPV6) &&
 	    net_context_get_family(context) == AF_INET6) {
 		const struct sockaddr_in6 *addr6 =
@@ -1689,7 +1697,22 @@ static int context_sendto(struct net_context *context,
 		return -ENETDOWN;
 	}
 
-	pkt = context_alloc_pkt(context, len, PKT_WAIT_TIME);
+	if (frags) {
+		size_t hdr_len = net_context_get_family(context) == AF_INET6 ?
+				 NET_IPV6UDPH_LEN : NET_IPV4UDPH_LEN;
+
+		len = net_buf_frags_len(*frags);
+
+		/* The datagram is not fragmented, it must fit in the MTU
+		 * along with the headers added in front of it
+		 */
+		if (iface && len + hdr_len > net_if_get_mtu(iface)) {
+			return -EMSGSIZE;
+		}
+	}
+
+	/* Only the headers are allocated when the data buffers are given */
+	pkt = context_alloc_pkt(context, frags ? 0 : len, PKT_WAIT_TIME);
 	if (!pkt) {
 		NET_ERR("Failed to allocate net_pkt");
 		return -ENOBUFS;
@@ -1697,7 +1720,7 @@ static int context_sendto(struct net_context *context,
 
 	tmp_len = net_pkt_available_payload_buffer(
 				pkt, net_context_get_proto(context));
-	if (tmp_len < len) {
+	if (!frags && tmp_len < len) {
 		if (net_context_get_type(context) == SOCK_DGRAM) {
 			NET_ERR("Available payload buffer (%zu) is not enough for requested DGRAM (%zu)",
 				tmp_len, len);
@@ -1750,12 +1773,18 @@ static int context_sendto(struct net_context *context,
 		}
 	} else if (IS_ENABLED(CONFIG_NET_UDP) &&
 	    net_context_get_proto(context) == IPPROTO_UDP) {
-		ret = context_setup_udp_packet(context, pkt, buf, len, msghdr,
+		ret = context_setup_udp_packet(context, pkt, buf,
+					       frags ? 0 : len, msghdr,
 					       dst_addr, addrlen);
 		if (ret < 0) {
 			goto fail;
 		}
 
+		if (frags) {
+			net_pkt_append_buffer(pkt, *frags);
+			*frags = NULL;
+		}
+
 		context_finalize_packet(context, pkt);
 
 		ret = net_send_data(pkt);
@@ -1868,7 +1897,7 @@ int net_context_send(struct net_context *context,
 	}
 
 	ret = context_sendto(context, buf, len, &context->remote,
-			     addrlen, cb, timeout, user_data, false);
+			     addrlen, cb, timeout, user_data, false, NULL);
 unlock:
 	k_mutex_unlock(&context->lock);
 
@@ -1887,7 +1916,7 @@ int net_context_sendmsg(struct net_context *context,
 	k_mutex_lock(&context->lock, K_FOREVER);
 
 	ret = context_sendto(context, msghdr, 0, NULL, 0,
-			     cb, timeout, user_data, true);
+			     cb, timeout, user_data, true, NULL);
 
 	k_mutex_unlock(&context->lock);
 
@@ -1908,13 +1937,50 @@ int net_context_sendto(struct net_context *context,
 	k_mutex_lock(&context->lock, K_FOREVER);
 
 	ret = context_sendto(context, buf, len, dst_addr, addrlen,
-			     cb, timeout, user_data, true);
+			     cb, timeout, user_data, true, NULL);
 
 	k_mutex_unlock(&context->lock);
 
 	return ret;
 }
 
+int net_context_sendto_buf(struct net_context *context,
+			   struct net_buf *frags,
+			   const struct sockaddr *dst_addr,
+			   socklen_t addrlen,
+			   k_timeout_t timeout)
+{
+	int ret;
+
+	k_mutex_lock(&context->lock, K_FOREVER);
+
+	if (!dst_addr) {
+		if (!(context->flags & NET_CONTEXT_REMOTE_ADDR_SET) ||
+		    !net_sin(&context->remote)->sin_port) {
+			ret = -EDESTADDRREQ;
+			goto unlock;
+		}
+
+		dst_addr = &context->remote;
+		addrlen = net_context_get_family(context) == AF_INET6 ?
+			  sizeof(struct sockaddr_in6) :
+			  sizeof(struct sockaddr_in);
+	}
+
+	ret = context_sendto(context, NULL, 0, dst_addr, addrlen,
+			     NULL, timeout, NULL, true, &frags);
+
+unlock:
+	k_mutex_unlock(&context->lock);
+
+	/* The data buffers are released if they were not sent */
+	if (frags) {
+		net_buf_unref(frags);
+	}
+
+	return ret;
+}
+
 enum net_verdict net_context_packet_received(struct net_conn *conn,
 					     struct net_pkt *pkt,
 					     union net_ip_header *ip_hdr,
@@ -2308,11 +2374,11 @@ static int set_context_rcvbuf(struct net_context *context,
 		return -EINVAL;
 	}
 
-	if ((rcvbuf_value < 0) || (rcvbuf_value > UINT16_MAX)) {
+	if ((rcvbuf_value < 0) || (rcvbuf_value > NET_TCP_MAX_WIN)) {
 		return -EINVAL;
 	}
 
-	context->options.rcvbuf = (uint16_t) rcvbuf_value;
+	context->options.rcvbuf = (uint32_t) rcvbuf_value;
 
 	return 0;
 #else
@@ -2330,11 +2396,11 @@ static int set_context_sndbuf(struct net_context *context,
 		return -EINVAL;
 	}
 
-	if ((sndbuf_value < 0) || (sndbuf_value > UINT16_MAX)) {
+	if ((sndbuf_value < 0) || (sndbuf_value > NET_TCP_MAX_WIN)) {
 		return -EINVAL;
 	}
 
-	context->options.sndbuf = (uint16_t) sndbuf_value;
+	context->options.sndbuf = (uint32_t) sndbuf_value;
 	return 0;
 #else
 	return -ENOTSUP;
@@ -401,6 +401,12 @@ static void net_queue_rx(struct net_if *iface, struct net_pkt *pkt)
 
 	if (NET_TC_RX_COUNT == 0) {
 		net_process_rx_packet(pkt);
+	} else if (IS_ENABLED(CONFIG_NET_GPTP_RX_FAST_PATH) &&
+		   net_gptp_is_rx_frame(iface, pkt)) {
+		/* Do not let gPTP frames wait behind other traffic in the
+		 * RX queues, they are handled in the context of the driver.
+		 */
+		net_process_rx_packet(pkt);
 	} else {
 		net_tc_submit_to_rx_queue(tc, pkt);
 	}
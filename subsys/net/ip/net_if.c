@@ -29,6 +29,7 @@ LOG_MODULE_REGISTER(net_if, CONFIG_NET_IF_LOG_LEVEL);
 #include "ipv4.h"
 #include "ipv6.h"
 #include "ipv4_autoconf_internal.h"
+#include "tcp_internal.h"
 
 #include "net_stats.h"
 
@@ -210,6 +211,17 @@ static void update_txtime_stats_detail(struct net_pkt *pkt,
 	}
 }
 
+static int net_if_l2_send(struct net_if *iface, struct net_pkt *pkt)
+{
+	/* TCP super-segments are split here if the device cannot do it */
+	if (IS_ENABLED(CONFIG_NET_TCP_GSO) && net_pkt_gso_size(pkt) > 0U &&
+	    net_if_need_tx_segmentation(iface)) {
+		return net_tcp_gso_send(iface, pkt);
+	}
+
+	return net_if_l2(iface)->send(iface, pkt);
+}
+
 static bool net_if_tx(struct net_if *iface, struct net_pkt *pkt)
 {
 	struct net_linkaddr ll_dst = {
@@ -264,7 +276,7 @@ static bool net_if_tx(struct net_if *iface, struct net_pkt *pkt)
 			}
 		}
 
-		status = net_if_l2(iface)->send(iface, pkt);
+		status = net_if_l2_send(iface, pkt);
 
 		if (IS_ENABLED(CONFIG_NET_PKT_TXTIME_STATS)) {
 			uint32_t end_tick = k_cycle_get_32();
@@ -4220,6 +4232,11 @@ bool net_if_need_calc_rx_checksum(struct net_if *iface)
 	return need_calc_checksum(iface, ETHERNET_HW_RX_CHKSUM_OFFLOAD);
 }
 
+bool net_if_need_tx_segmentation(struct net_if *iface)
+{
+	return need_calc_checksum(iface, ETHERNET_HW_TX_TSO);
+}
+
 int net_if_get_by_iface(struct net_if *iface)
 {
 	if (!(iface >= _net_if_list_start && iface < _net_if_list_end)) {
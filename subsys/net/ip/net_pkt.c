@@ -127,6 +127,19 @@ NET_BUF_POOL_FIXED_DEFINE(rx_bufs, CONFIG_NET_BUF_RX_COUNT, CONFIG_NET_BUF_DATA_
 NET_BUF_POOL_FIXED_DEFINE(tx_bufs, CONFIG_NET_BUF_TX_COUNT, CONFIG_NET_BUF_DATA_SIZE,
 			  CONFIG_NET_PKT_BUF_USER_DATA_SIZE, NULL);
 
+#if CONFIG_NET_BUF_LARGE_DATA_SIZE > 0
+#if CONFIG_NET_BUF_LARGE_DATA_SIZE <= CONFIG_NET_BUF_DATA_SIZE
+#error "CONFIG_NET_BUF_LARGE_DATA_SIZE must be larger than CONFIG_NET_BUF_DATA_SIZE"
+#endif
+
+NET_BUF_POOL_FIXED_DEFINE(rx_large_bufs, CONFIG_NET_BUF_LARGE_RX_COUNT,
+			  CONFIG_NET_BUF_LARGE_DATA_SIZE,
+			  CONFIG_NET_PKT_BUF_USER_DATA_SIZE, NULL);
+NET_BUF_POOL_FIXED_DEFINE(tx_large_bufs, CONFIG_NET_BUF_LARGE_TX_COUNT,
+			  CONFIG_NET_BUF_LARGE_DATA_SIZE,
+			  CONFIG_NET_PKT_BUF_USER_DATA_SIZE, NULL);
+#endif /* CONFIG_NET_BUF_LARGE_DATA_SIZE > 0 */
+
 #else /* !CONFIG_NET_BUF_FIXED_DATA_SIZE */
 
 NET_BUF_POOL_VAR_DEFINE(rx_bufs, CONFIG_NET_BUF_RX_COUNT, CONFIG_NET_BUF_DATA_POOL_SIZE,
@@ -136,6 +149,140 @@ NET_BUF_POOL_VAR_DEFINE(tx_bufs, CONFIG_NET_BUF_TX_COUNT, CONFIG_NET_BUF_DATA_PO
 
 #endif /* CONFIG_NET_BUF_FIXED_DATA_SIZE */
 
+#if defined(CONFIG_NET_PKT_ALLOC_STATS)
+static struct net_pkt_alloc_stats alloc_stats;
+static struct k_spinlock alloc_stats_lock;
+
+static inline uint32_t alloc_stats_start(void)
+{
+	return k_cycle_get_32();
+}
+
+static void pool_stats_update(struct net_pkt_pool_stats *stats, bool success,
+			      uint32_t start, uint16_t in_use)
+{
+	uint32_t wait_us = k_cyc_to_us_floor32(k_cycle_get_32() - start);
+
+	if (success) {
+		stats->allocs++;
+	} else {
+		stats->failures++;
+	}
+
+	stats->wait_us += wait_us;
+	stats->max_wait_us = MAX(stats->max_wait_us, wait_us);
+	stats->high_water = MAX(stats->high_water, in_use);
+}
+
+static void alloc_stats_pkt(struct k_mem_slab *slab, bool success,
+			    uint32_t start)
+{
+	struct net_pkt_pool_stats *stats;
+	k_spinlock_key_t key;
+
+	if (slab == &rx_pkts) {
+		stats = &alloc_stats.rx;
+	} else if (slab == &tx_pkts) {
+		stats = &alloc_stats.tx;
+	} else {
+		return;
+	}
+
+	key = k_spin_lock(&alloc_stats_lock);
+	pool_stats_update(stats, success, start, k_mem_slab_num_used_get(slab));
+	k_spin_unlock(&alloc_stats_lock, key);
+}
+
+static void alloc_stats_data(struct net_buf_pool *pool, struct net_buf *buf,
+			     size_t size, uint32_t start)
+{
+	struct net_pkt_pool_stats *stats;
+	k_spinlock_key_t key;
+	int bucket = 0;
+
+	if (pool == &rx_bufs) {
+		stats = &alloc_stats.rx_data;
+	} else if (pool == &tx_bufs) {
+		stats = &alloc_stats.tx_data;
+	} else {
+		return;
+	}
+
+	while (bucket < NET_PKT_ALLOC_STATS_BUCKETS - 1 && size > (32U << bucket)) {
+		bucket++;
+	}
+
+	key = k_spin_lock(&alloc_stats_lock);
+
+	pool_stats_update(stats, buf != NULL, start,
+			  pool->buf_count - atomic_get(&pool->avail_count));
+
+	alloc_stats.size_hist[bucket]++;
+
+	for (; buf; buf = buf->frags) {
+		alloc_stats.data_frags++;
+	}
+
+	k_spin_unlock(&alloc_stats_lock, key);
+}
+
+static void alloc_stats_compact(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&alloc_stats_lock);
+
+	alloc_stats.compactions++;
+	k_spin_unlock(&alloc_stats_lock, key);
+}
+
+void net_pkt_get_alloc_stats(struct net_pkt_alloc_stats *stats)
+{
+	k_spinlock_key_t key = k_spin_lock(&alloc_stats_lock);
+
+	*stats = alloc_stats;
+	k_spin_unlock(&alloc_stats_lock, key);
+
+	stats->rx.count = rx_pkts.num_blocks;
+	stats->tx.count = tx_pkts.num_blocks;
+	stats->rx_data.count = rx_bufs.buf_count;
+	stats->tx_data.count = tx_bufs.buf_count;
+}
+
+void net_pkt_clear_alloc_stats(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&alloc_stats_lock);
+
+	(void)memset(&alloc_stats, 0, sizeof(alloc_stats));
+	k_spin_unlock(&alloc_stats_lock, key);
+}
+#else
+static inline uint32_t alloc_stats_start(void)
+{
+	return 0;
+}
+
+static inline void alloc_stats_pkt(struct k_mem_slab *slab, bool success,
+				   uint32_t start)
+{
+	ARG_UNUSED(slab);
+	ARG_UNUSED(success);
+	ARG_UNUSED(start);
+}
+
+static inline void alloc_stats_data(struct net_buf_pool *pool,
+				    struct net_buf *buf, size_t size,
+				    uint32_t start)
+{
+	ARG_UNUSED(pool);
+	ARG_UNUSED(buf);
+	ARG_UNUSED(size);
+	ARG_UNUSED(start);
+}
+
+static inline void alloc_stats_compact(void)
+{
+}
+#endif /* CONFIG_NET_PKT_ALLOC_STATS */
+
 /* Allocation tracking is only available if separately enabled */
 #if defined(CONFIG_NET_DEBUG_NET_PKT_ALLOC)
 struct net_pkt_alloc {
@@ -284,6 +431,14 @@ const char *net_pkt_pool2str(struct net_buf_pool *pool)
 		return "TDATA";
 	}
 
+#if CONFIG_NET_BUF_LARGE_DATA_SIZE > 0
+	if (pool == &rx_large_bufs) {
+		return "RLDATA";
+	} else if (pool == &tx_large_bufs) {
+		return "TLDATA";
+	}
+#endif
+
 	return "EDATA";
 }
 
@@ -593,8 +748,9 @@ done:
 		return;
 	}
 
+	/* The fragments were already untracked above when debugging */
 	if (pkt->frags) {
-		net_pkt_frag_unref(pkt->frags);
+		net_buf_unref_chain_bulk(pkt->frags);
 	}
 
 	if (IS_ENABLED(CONFIG_NET_DEBUG_NET_PKT_NON_FRAGILE_ACCESS)) {
@@ -769,6 +925,8 @@ void net_pkt_compact(struct net_pkt *pkt)
 
 	NET_DBG("Compacting data in pkt %p", pkt);
 
+	alloc_stats_compact();
+
 	frag = pkt->frags;
 	prev = NULL;
 
@@ -843,6 +1001,20 @@ void net_pkt_get_info(struct k_mem_slab **rx,
 	}
 }
 
+#if CONFIG_NET_BUF_LARGE_DATA_SIZE > 0
+void net_pkt_get_large_info(struct net_buf_pool **rx_data,
+			    struct net_buf_pool **tx_data)
+{
+	if (rx_data) {
+		*rx_data = &rx_large_bufs;
+	}
+
+	if (tx_data) {
+		*tx_data = &tx_large_bufs;
+	}
+}
+#endif /* CONFIG_NET_BUF_LARGE_DATA_SIZE > 0 */
+
 #if defined(CONFIG_NET_DEBUG_NET_PKT_ALLOC)
 void net_pkt_print(void)
 {
@@ -857,6 +1029,21 @@ void net_pkt_print(void)
 
 #if defined(CONFIG_NET_BUF_FIXED_DATA_SIZE)
 
+static struct net_buf_pool *large_pool_get(struct net_buf_pool *pool)
+{
+#if CONFIG_NET_BUF_LARGE_DATA_SIZE > 0
+	if (pool == &rx_bufs) {
+		return &rx_large_bufs;
+	} else if (pool == &tx_bufs) {
+		return &tx_large_bufs;
+	}
+#else
+	ARG_UNUSED(pool);
+#endif
+
+	return NULL;
+}
+
 #if NET_LOG_LEVEL >= LOG_LEVEL_DBG
 static struct net_buf *pkt_alloc_buffer(struct net_buf_pool *pool,
 					size_t size, k_timeout_t timeout,
@@ -866,14 +1053,56 @@ static struct net_buf *pkt_alloc_buffer(struct net_buf_pool *pool,
 					size_t size, k_timeout_t timeout)
 #endif
 {
+	const struct net_buf_pool_fixed *fixed = pool->alloc->alloc_data;
+	struct net_buf_pool *large = large_pool_get(pool);
 	k_timepoint_t end = sys_timepoint_calc(timeout);
 	struct net_buf *first = NULL;
 	struct net_buf *current = NULL;
 
+	/* Fragments that all come from the same pool are taken at once */
+	if (!large || size <= CONFIG_NET_BUF_DATA_SIZE) {
+		first = net_buf_alloc_bulk(pool, fixed->data_size,
+					   MAX(DIV_ROUND_UP(size, fixed->data_size), 1),
+					   timeout);
+		if (!first) {
+			return NULL;
+		}
+
+		for (current = first; current; current = current->frags) {
+			if (current->size > size) {
+				current->size = size;
+			}
+
+			size -= current->size;
+
+#if CONFIG_NET_PKT_LOG_LEVEL >= LOG_LEVEL_DBG
+			NET_FRAG_CHECK_IF_NOT_IN_USE(current, current->ref + 1);
+
+			net_pkt_alloc_add(current, false, caller, line);
+
+			NET_DBG("%s (%s) [%d] frag %p ref %d (%s():%d)",
+				pool2str(pool), get_name(pool), get_frees(pool),
+				current, current->ref, caller, line);
+#endif
+		}
+
+		return first;
+	}
+
 	do {
-		struct net_buf *new;
+		struct net_buf *new = NULL;
+
+		/* What does not fit in a small fragment goes to a large one,
+		 * as long as there are some left.
+		 */
+		if (large && size > CONFIG_NET_BUF_DATA_SIZE) {
+			new = net_buf_alloc_fixed(large, K_NO_WAIT);
+		}
+
+		if (!new) {
+			new = net_buf_alloc_fixed(pool, timeout);
+		}
 
-		new = net_buf_alloc_fixed(pool, timeout);
 		if (!new) {
 			goto error;
 		}
@@ -1141,6 +1370,7 @@ int net_pkt_alloc_buffer(struct net_pkt *pkt,
 	struct net_buf_pool *pool = NULL;
 	size_t alloc_len = 0;
 	size_t hdr_len = 0;
+	uint32_t alloc_start;
 	struct net_buf *buf;
 
 	if (!size && proto == 0 && net_pkt_family(pkt) == AF_UNSPEC) {
@@ -1176,12 +1406,16 @@ int net_pkt_alloc_buffer(struct net_pkt *pkt,
 		pool = pkt->slab == &tx_pkts ? &tx_bufs : &rx_bufs;
 	}
 
+	alloc_start = alloc_stats_start();
+
 #if NET_LOG_LEVEL >= LOG_LEVEL_DBG
 	buf = pkt_alloc_buffer(pool, alloc_len, timeout, caller, line);
 #else
 	buf = pkt_alloc_buffer(pool, alloc_len, timeout);
 #endif
 
+	alloc_stats_data(pool, buf, alloc_len, alloc_start);
+
 	if (!buf) {
 #if NET_LOG_LEVEL >= LOG_LEVEL_DBG
 		NET_ERR("Data buffer (%zd) allocation failed (%s:%d)",
@@ -1206,6 +1440,7 @@ static struct net_pkt *pkt_alloc(struct k_mem_slab *slab, k_timeout_t timeout)
 {
 	struct net_pkt *pkt;
 	uint32_t create_time;
+	uint32_t alloc_start;
 	int ret;
 
 	if (k_is_in_isr()) {
@@ -1219,7 +1454,12 @@ static struct net_pkt *pkt_alloc(struct k_mem_slab *slab, k_timeout_t timeout)
 		ARG_UNUSED(create_time);
 	}
 
+	alloc_start = alloc_stats_start();
+
 	ret = k_mem_slab_alloc(slab, (void **)&pkt, timeout);
+
+	alloc_stats_pkt(slab, ret == 0, alloc_start);
+
 	if (ret) {
 		return NULL;
 	}
@@ -1849,6 +2089,8 @@ static void clone_pkt_attributes(struct net_pkt *pkt, struct net_pkt *clone_pkt)
 					  net_pkt_ipv6_next_hdr(pkt));
 	}
 
+	net_pkt_set_gso_size(clone_pkt, net_pkt_gso_size(pkt));
+
 	clone_pkt_cb(pkt, clone_pkt);
 }
 
@@ -1939,6 +2181,46 @@ struct net_pkt *net_pkt_shallow_clone(struct net_pkt *pkt, k_timeout_t timeout)
 	return clone_pkt;
 }
 
+struct net_pkt *net_pkt_clone_head(struct net_pkt *pkt, size_t len,
+				   size_t size, k_timeout_t timeout)
+{
+	bool overwrite = net_pkt_is_being_overwritten(pkt);
+	struct net_pkt_cursor backup;
+	struct net_pkt *clone_pkt;
+
+	NET_ASSERT(size >= len);
+
+#if NET_LOG_LEVEL >= LOG_LEVEL_DBG
+	clone_pkt = pkt_alloc_with_buffer(pkt->slab, net_pkt_iface(pkt), size,
+					  AF_UNSPEC, 0, timeout,
+					  __func__, __LINE__);
+#else
+	clone_pkt = pkt_alloc_with_buffer(pkt->slab, net_pkt_iface(pkt), size,
+					  AF_UNSPEC, 0, timeout);
+#endif
+	if (!clone_pkt) {
+		return NULL;
+	}
+
+	net_pkt_set_overwrite(pkt, true);
+	net_pkt_cursor_backup(pkt, &backup);
+	net_pkt_cursor_init(pkt);
+
+	if (net_pkt_copy(clone_pkt, pkt, len)) {
+		net_pkt_unref(clone_pkt);
+		clone_pkt = NULL;
+	} else {
+		clone_pkt_attributes(pkt, clone_pkt);
+	}
+
+	net_pkt_cursor_restore(pkt, &backup);
+	net_pkt_set_overwrite(pkt, overwrite);
+
+	NET_DBG("Cloned %zu bytes of %p to %p", len, pkt, clone_pkt);
+
+	return clone_pkt;
+}
+
 size_t net_pkt_remaining_data(struct net_pkt *pkt)
 {
 	struct net_buf *buf;
@@ -98,6 +98,10 @@ static inline enum net_verdict net_ipv6_input(struct net_pkt *pkt,
 #endif
 extern bool net_tc_submit_to_tx_queue(uint8_t tc, struct net_pkt *pkt);
 extern void net_tc_submit_to_rx_queue(uint8_t tc, struct net_pkt *pkt);
+#if defined(CONFIG_NET_TCP_GRO)
+extern struct net_pkt *net_tc_gro_receive(struct k_fifo *fifo,
+					  struct net_pkt *pkt);
+#endif
 extern enum net_verdict net_promisc_mode_input(struct net_pkt *pkt);
 
 char *net_sprint_addr(sa_family_t af, const void *addr);
@@ -136,9 +140,20 @@ void net_gptp_init(void);
  * @return Return the policy for network buffer.
  */
 enum net_verdict net_gptp_recv(struct net_if *iface, struct net_pkt *pkt);
+
+/**
+ * @brief Check if a received packet is a gPTP frame.
+ *
+ * @param iface Network interface the packet was received on.
+ * @param pkt Received packet, before L2 processing.
+ *
+ * @return True if the packet is a gPTP frame, false otherwise.
+ */
+bool net_gptp_is_rx_frame(struct net_if *iface, struct net_pkt *pkt);
 #else
 #define net_gptp_init()
 #define net_gptp_recv(iface, pkt) NET_DROP
+#define net_gptp_is_rx_frame(iface, pkt) false
 #endif /* CONFIG_NET_GPTP */
 
 #if defined(CONFIG_NET_IPV4_FRAGMENT)
@@ -264,6 +264,7 @@ static struct ethernet_capabilities eth_hw_caps[] = {
 	EC(ETHERNET_QBV,                  "IEEE 802.1Qbv (scheduled traffic)"),
 	EC(ETHERNET_QBU,                  "IEEE 802.1Qbu (frame preemption)"),
 	EC(ETHERNET_TXTIME,               "TXTIME"),
+	EC(ETHERNET_HW_TX_TSO,            "TCP segmentation offload"),
 	EC(ETHERNET_PROMISC_MODE,         "Promiscuous mode"),
 	EC(ETHERNET_PRIORITY_QUEUES,      "Priority queues"),
 	EC(ETHERNET_HW_FILTERING,         "MAC address filtering"),
@@ -1719,12 +1720,13 @@ static void arp_cb(struct arp_entry *entry, void *user_data)
 	int *count = data->user_data;
 
 	if (*count == 0) {
-		PR("     Interface  Link              Address\n");
+		PR("     Interface  Link              Age (s) Address\n");
 	}
 
-	PR("[%2d] %d          %s %s\n", *count,
+	PR("[%2d] %d          %s %7u %s\n", *count,
 	   net_if_get_by_iface(entry->iface),
 	   net_sprint_ll_addr(entry->eth.addr, sizeof(struct net_eth_addr)),
+	   (k_uptime_get_32() - entry->last_used) / MSEC_PER_SEC,
 	   net_sprint_ipv4_addr(&entry->ip));
 
 	(*count)++;
@@ -1752,6 +1754,7 @@ static int cmd_net_arp(const struct shell *sh, size_t argc, char *argv[])
 #if defined(CONFIG_NET_ARP)
 	if (!argv[arg]) {
 		/* ARP cache content */
+		struct net_arp_stats stats;
 		int count = 0;
 
 		user_data.sh = sh;
@@ -1760,6 +1763,11 @@ static int cmd_net_arp(const struct shell *sh, size_t argc, char *argv[])
 		if (net_arp_foreach(arp_cb, &user_data) == 0) {
 			PR("ARP cache is empty.\n");
 		}
+
+		net_arp_stats_get(&stats);
+		PR("Hits %u misses %u evictions %u pending drops %u\n",
+		   stats.hits, stats.misses, stats.evictions,
+		   stats.pending_drops);
 	}
 #else
 	print_arp_error(sh);
@@ -2298,6 +2306,76 @@ static int cmd_net_dns_query(const struct shell *sh, size_t argc,
 	return 0;
 }
 
+#if defined(CONFIG_DNS_RESOLVER_CACHE)
+static void dns_cache_cb(const char *query, enum dns_query_type type,
+			 const struct dns_addrinfo *info, uint32_t ttl,
+			 void *user_data)
+{
+	struct net_shell_user_data *data = user_data;
+	const struct shell *sh = data->sh;
+	int *count = data->user_data;
+	char addr[NET_IPV6_ADDR_LEN];
+
+	if (*count == 0) {
+		PR("%-8s %-40s %-6s %s\n", "Type", "Address", "TTL", "Name");
+	}
+
+	if (info == NULL) {
+		snprintk(addr, sizeof(addr), "<none>");
+	} else if (info->ai_family == AF_INET) {
+		net_addr_ntop(AF_INET, &net_sin(&info->ai_addr)->sin_addr,
+			      addr, sizeof(addr));
+	} else if (info->ai_family == AF_INET6) {
+		net_addr_ntop(AF_INET6, &net_sin6(&info->ai_addr)->sin6_addr,
+			      addr, sizeof(addr));
+	} else {
+		snprintk(addr, sizeof(addr), "<unknown>");
+	}
+
+	PR("%-8s %-40s %-6u %s\n",
+	   type == DNS_QUERY_TYPE_AAAA ? "AAAA" : "A", addr, ttl, query);
+
+	(*count)++;
+}
+#endif
+
+static int cmd_net_dns_cache(const struct shell *sh, size_t argc,
+			     char *argv[])
+{
+#if defined(CONFIG_DNS_RESOLVER_CACHE)
+	struct net_shell_user_data user_data;
+	int count = 0;
+
+	if (argc > 1) {
+		if (strcmp(argv[1], "flush") == 0) {
+			dns_cache_flush();
+			PR("DNS cache flushed.\n");
+			return 0;
+		}
+
+		PR_WARNING("Unknown option '%s'\n", argv[1]);
+		return -ENOEXEC;
+	}
+
+	user_data.sh = sh;
+	user_data.user_data = &count;
+
+	dns_cache_foreach(dns_cache_cb, &user_data);
+
+	if (count == 0) {
+		PR("DNS cache is empty.\n");
+	}
+#else
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	PR_INFO("Set %s to enable %s support.\n", "CONFIG_DNS_RESOLVER_CACHE",
+		"DNS cache");
+#endif
+
+	return 0;
+}
+
 static int cmd_net_dns(const struct shell *sh, size_t argc, char *argv[])
 {
 #if defined(CONFIG_DNS_RESOLVER)
@@ -3244,6 +3322,16 @@ static void gptp_print_port_info(const struct shell *sh, int port)
 	   "messages", "sent", port_param_ds->tx_pdelay_resp_fup_count);
 	PR("Announce %s %s                 : %u\n",
 	   "messages", "sent", port_param_ds->tx_announce_count);
+	PR("Local clock offset (ns)                : %" PRId64 "\n",
+	   port_param_ds->clock_offset);
+	PR("Local clock max offset (ns)            : %u\n",
+	   port_param_ds->clock_offset_max);
+	PR("Local clock jitter (ns)                : %u\n",
+	   port_param_ds->clock_jitter);
+	PR("Local clock steps                      : %u\n",
+	   port_param_ds->clock_step_count);
+	PR("Local clock offset outliers            : %u\n",
+	   port_param_ds->clock_outlier_count);
 #endif /* CONFIG_NET_GPTP_STATISTICS */
 }
 #endif /* CONFIG_NET_GPTP */
@@ -4066,11 +4154,19 @@ static int cmd_net_mem(const struct shell *sh, size_t argc, char *argv[])
 #if defined(CONFIG_NET_OFFLOAD) || defined(CONFIG_NET_NATIVE)
 	struct k_mem_slab *rx, *tx;
 	struct net_buf_pool *rx_data, *tx_data;
+#if CONFIG_NET_BUF_LARGE_DATA_SIZE > 0
+	struct net_buf_pool *rx_large, *tx_large;
+
+	net_pkt_get_large_info(&rx_large, &tx_large);
+#endif
 
 	net_pkt_get_info(&rx, &tx, &rx_data, &tx_data);
 
 #if defined(CONFIG_NET_BUF_FIXED_DATA_SIZE)
 	PR("Fragment length %d bytes\n", CONFIG_NET_BUF_DATA_SIZE);
+#if CONFIG_NET_BUF_LARGE_DATA_SIZE > 0
+	PR("Large fragment length %d bytes\n", CONFIG_NET_BUF_LARGE_DATA_SIZE);
+#endif
 #else
 	PR("Fragment data pool size %d bytes\n", CONFIG_NET_BUF_DATA_POOL_SIZE);
 #endif /* CONFIG_NET_BUF_FIXED_DATA_SIZE */
@@ -4091,6 +4187,14 @@ static int cmd_net_mem(const struct shell *sh, size_t argc, char *argv[])
 
 	PR("%p\t%d\t%ld\tTX DATA (%s)\n", tx_data, tx_data->buf_count,
 	   atomic_get(&tx_data->avail_count), tx_data->name);
+
+#if CONFIG_NET_BUF_LARGE_DATA_SIZE > 0
+	PR("%p\t%d\t%ld\tRX LARGE DATA (%s)\n", rx_large, rx_large->buf_count,
+	   atomic_get(&rx_large->avail_count), rx_large->name);
+
+	PR("%p\t%d\t%ld\tTX LARGE DATA (%s)\n", tx_large, tx_large->buf_count,
+	   atomic_get(&tx_large->avail_count), tx_large->name);
+#endif
 #else
 	PR("Address\t\tTotal\tName\n");
 
@@ -4098,6 +4202,10 @@ static int cmd_net_mem(const struct shell *sh, size_t argc, char *argv[])
 	PR("%p\t%d\tTX\n", tx, tx->num_blocks);
 	PR("%p\t%d\tRX DATA\n", rx_data, rx_data->buf_count);
 	PR("%p\t%d\tTX DATA\n", tx_data, tx_data->buf_count);
+#if CONFIG_NET_BUF_LARGE_DATA_SIZE > 0
+	PR("%p\t%d\tRX LARGE DATA\n", rx_large, rx_large->buf_count);
+	PR("%p\t%d\tTX LARGE DATA\n", tx_large, tx_large->buf_count);
+#endif
 	PR_INFO("Set %s to enable %s support.\n",
 		"CONFIG_NET_BUF_POOL_USAGE", "net_buf allocation");
 #endif /* CONFIG_NET_BUF_POOL_USAGE */
@@ -4125,6 +4233,121 @@ static int cmd_net_mem(const struct shell *sh, size_t argc, char *argv[])
 	return 0;
 }
 
+#if defined(CONFIG_NET_PKT_ALLOC_STATS)
+static void print_pool_stats(const struct shell *sh, const char *name,
+			     const struct net_pkt_pool_stats *stats)
+{
+	uint32_t calls = stats->allocs + stats->failures;
+
+	PR("%s\t%u\t%u\t%u\t%u\t%u\t%u\n", name, stats->count,
+	   stats->high_water, stats->allocs, stats->failures,
+	   calls ? (uint32_t)(stats->wait_us / calls) : 0U,
+	   stats->max_wait_us);
+}
+
+/* Recommend a pool size from its peak usage, with some headroom */
+static uint32_t tune_count(const struct net_pkt_pool_stats *stats)
+{
+	if (stats->allocs == 0U && stats->failures == 0U) {
+		return stats->count;
+	}
+
+	if (stats->failures > 0U) {
+		/* The pool ran out, its peak usage means nothing */
+		return stats->count + MAX(stats->count / 2U, 1U);
+	}
+
+	return stats->high_water + stats->high_water / 4U + 1U;
+}
+
+static int cmd_net_mem_tune(const struct shell *sh, size_t argc, char *argv[])
+{
+	struct net_pkt_alloc_stats stats;
+	uint32_t allocs = 0U;
+	int i;
+
+	if (argc > 1 && strcmp(argv[1], "reset") == 0) {
+		net_pkt_clear_alloc_stats();
+		PR("Allocation statistics cleared.\n");
+		return 0;
+	}
+
+	net_pkt_get_alloc_stats(&stats);
+
+	PR("Pool\tTotal\tPeak\tAllocs\tFails\tAvg us\tMax us\n");
+	print_pool_stats(sh, "RX", &stats.rx);
+	print_pool_stats(sh, "TX", &stats.tx);
+	print_pool_stats(sh, "RXDATA", &stats.rx_data);
+	print_pool_stats(sh, "TXDATA", &stats.tx_data);
+
+	PR("\nData allocation sizes:\n");
+
+	for (i = 0; i < NET_PKT_ALLOC_STATS_BUCKETS; i++) {
+		allocs += stats.size_hist[i];
+
+		if (i < NET_PKT_ALLOC_STATS_BUCKETS - 1) {
+			PR("  <= %u\t%u\n", 32U << i, stats.size_hist[i]);
+		} else {
+			PR("   > %u\t%u\n", 32U << (i - 1), stats.size_hist[i]);
+		}
+	}
+
+	if (allocs > 0U) {
+		PR("Buffers per data allocation %u.%u, %u compactions\n",
+		   stats.data_frags / allocs,
+		   (stats.data_frags % allocs) * 10U / allocs,
+		   stats.compactions);
+	}
+
+	PR("\nRecommended configuration:\n");
+	PR("CONFIG_NET_PKT_RX_COUNT=%u\n", tune_count(&stats.rx));
+	PR("CONFIG_NET_PKT_TX_COUNT=%u\n", tune_count(&stats.tx));
+
+#if defined(CONFIG_NET_BUF_FIXED_DATA_SIZE)
+	{
+		uint32_t frag_size = CONFIG_NET_BUF_DATA_SIZE;
+		uint32_t covered = 0U;
+
+		/* Smallest fragment holding 90% of the allocations in one
+		 * buffer, the other ones are chained.
+		 */
+		for (i = 0; allocs > 0U && i < NET_PKT_ALLOC_STATS_BUCKETS - 1; i++) {
+			covered += stats.size_hist[i];
+			if (covered * 10U >= allocs * 9U) {
+				frag_size = MAX(32U << i, 128U);
+				break;
+			}
+		}
+
+		/* Keep the same amount of peak data memory */
+		PR("CONFIG_NET_BUF_DATA_SIZE=%u\n", frag_size);
+		PR("CONFIG_NET_BUF_RX_COUNT=%u\n",
+		   DIV_ROUND_UP(tune_count(&stats.rx_data) *
+				CONFIG_NET_BUF_DATA_SIZE, frag_size));
+		PR("CONFIG_NET_BUF_TX_COUNT=%u\n",
+		   DIV_ROUND_UP(tune_count(&stats.tx_data) *
+				CONFIG_NET_BUF_DATA_SIZE, frag_size));
+	}
+#else
+	PR("CONFIG_NET_BUF_RX_COUNT=%u\n", tune_count(&stats.rx_data));
+	PR("CONFIG_NET_BUF_TX_COUNT=%u\n", tune_count(&stats.tx_data));
+#endif /* CONFIG_NET_BUF_FIXED_DATA_SIZE */
+
+	return 0;
+}
+#else
+static int cmd_net_mem_tune(const struct shell *sh, size_t argc, char *argv[])
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	PR_INFO("Set %s to enable %s support.\n",
+		"CONFIG_NET_PKT_ALLOC_STATS", "allocation statistics");
+
+	return 0;
+}
+#endif /* CONFIG_NET_PKT_ALLOC_STATS */
+
 static int cmd_net_nbr_rm(const struct shell *sh, size_t argc,
 			  char *argv[])
 {
@@ -6253,6 +6476,10 @@ SHELL_STATIC_SUBCMD_SET_CREATE(net_cmd_capture,
 );
 
 SHELL_STATIC_SUBCMD_SET_CREATE(net_cmd_dns,
+	SHELL_CMD(cache, NULL,
+		  "'net dns cache' shows the cached DNS answers.\n"
+		  "'net dns cache flush' removes all of them.",
+		  cmd_net_dns_cache),
 	SHELL_CMD(cancel, NULL, "Cancel all pending requests.",
 		  cmd_net_dns_cancel),
 	SHELL_CMD(query, NULL,
@@ -6576,6 +6803,15 @@ SHELL_STATIC_SUBCMD_SET_CREATE(net_cmd_ping,
 	SHELL_SUBCMD_SET_END
 );
 
+SHELL_STATIC_SUBCMD_SET_CREATE(net_cmd_mem,
+	SHELL_CMD(tune, NULL,
+		  "'net mem tune' recommends pool and fragment sizes from the "
+		  "observed allocations.\n"
+		  "'net mem tune reset' clears the allocation statistics.",
+		  cmd_net_mem_tune),
+	SHELL_SUBCMD_SET_END
+);
+
 SHELL_STATIC_SUBCMD_SET_CREATE(net_cmd_pkt,
 	SHELL_CMD(--help, NULL,
 		  "'net pkt [ptr in hex]' "
@@ -6624,7 +6860,7 @@ SHELL_STATIC_SUBCMD_SET_CREATE(net_commands,
 		  "Print information about IPv4 specific information and "
 		  "configuration.",
 		  cmd_net_ipv4),
-	SHELL_CMD(mem, NULL, "Print information about network memory usage.",
+	SHELL_CMD(mem, &net_cmd_mem, "Print information about network memory usage.",
 		  cmd_net_mem),
 	SHELL_CMD(nbr, &net_cmd_nbr, "Print neighbor information.",
 		  cmd_net_nbr),
@@ -13,23 +13,33 @@ LOG_MODULE_REGISTER(net_tc, CONFIG_NET_TC_LOG_LEVEL);
 #include <zephyr/net/net_core.h>
 #include <zephyr/net/net_pkt.h>
 #include <zephyr/net/net_stats.h>
+#include <zephyr/net/ethernet.h>
 
 #include "net_private.h"
 #include "net_stats.h"
 #include "net_tc_mapping.h"
+#include "ipv4.h"
 
 /* Template for thread name. The "xx" is either "TX" denoting transmit thread,
  * or "RX" denoting receive thread. The "q[y]" denotes the traffic class queue
  * where y indicates the traffic class id. The value of y can be from 0 to 7.
+ * With RX steering, ".z" denotes the flow queue of the traffic class.
  */
-#define MAX_NAME_LEN sizeof("xx_q[y]")
+#define MAX_NAME_LEN sizeof("xx_q[y.z]")
+
+/* Number of RX queues of each traffic class */
+#if defined(CONFIG_NET_TC_RX_STEERING)
+#define NET_TC_RX_QUEUES CONFIG_NET_TC_RX_STEERING_QUEUES
+#else
+#define NET_TC_RX_QUEUES 1
+#endif
 
 /* Stacks for TX work queue */
 K_KERNEL_STACK_ARRAY_DEFINE(tx_stack, NET_TC_TX_COUNT,
 			    CONFIG_NET_TX_STACK_SIZE);
 
 /* Stacks for RX work queue */
-K_KERNEL_STACK_ARRAY_DEFINE(rx_stack, NET_TC_RX_COUNT,
+K_KERNEL_STACK_ARRAY_DEFINE(rx_stack, NET_TC_RX_COUNT * NET_TC_RX_QUEUES,
 			    CONFIG_NET_RX_STACK_SIZE);
 
 #if NET_TC_TX_COUNT > 0
@@ -37,7 +47,8 @@ static struct net_traffic_class tx_classes[NET_TC_TX_COUNT];
 #endif
 
 #if NET_TC_RX_COUNT > 0
-static struct net_traffic_class rx_classes[NET_TC_RX_COUNT];
+/* The queues of a traffic class are next to each other */
+static struct net_traffic_class rx_classes[NET_TC_RX_COUNT * NET_TC_RX_QUEUES];
 #endif
 
 #if NET_TC_RX_COUNT > 0 || NET_TC_TX_COUNT > 0
@@ -60,12 +71,107 @@ bool net_tc_submit_to_tx_queue(uint8_t tc, struct net_pkt *pkt)
 	return true;
 }
 
+#if defined(CONFIG_NET_TC_RX_STEERING)
+#define FLOW_HASH_INIT 2166136261U
+#define FLOW_HASH_PRIME 16777619U
+
+static uint32_t flow_hash_add(uint32_t hash, const uint8_t *data, size_t len)
+{
+	while (len--) {
+		hash = (hash ^ *data++) * FLOW_HASH_PRIME;
+	}
+
+	return hash;
+}
+
+/* Hash the addresses, protocol and ports of IP packets received on
+ * Ethernet, when their headers are in the first buffer.
+ */
+static uint32_t tc_rx_flow_hash(struct net_pkt *pkt)
+{
+	uint32_t hash = FLOW_HASH_INIT;
+#if defined(CONFIG_NET_L2_ETHERNET)
+	struct net_buf *buf = pkt->buffer;
+	const uint8_t *ip;
+	size_t ports = 0;
+	uint8_t proto;
+
+	if (net_if_l2(net_pkt_iface(pkt)) != &NET_L2_GET_NAME(ETHERNET) ||
+	    buf == NULL || buf->len < sizeof(struct net_eth_hdr)) {
+		return 0;
+	}
+
+	ip = buf->data + sizeof(struct net_eth_hdr);
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) &&
+	    NET_ETH_HDR(pkt)->type == htons(NET_ETH_PTYPE_IP)) {
+		const struct net_ipv4_hdr *ipv4 = (const struct net_ipv4_hdr *)ip;
+
+		if (buf->len < sizeof(struct net_eth_hdr) + sizeof(*ipv4)) {
+			return 0;
+		}
+
+		proto = ipv4->proto;
+		hash = flow_hash_add(hash, ipv4->src, 2 * sizeof(struct in_addr));
+
+		/* Fragments of a datagram must not be reordered */
+		if ((ntohs(UNALIGNED_GET((uint16_t *)ipv4->offset)) & 0x3fff) == 0U) {
+			ports = (ipv4->vhl & NET_IPV4_IHL_MASK) * 4U;
+		}
+	} else if (IS_ENABLED(CONFIG_NET_IPV6) &&
+		   NET_ETH_HDR(pkt)->type == htons(NET_ETH_PTYPE_IPV6)) {
+		const struct net_ipv6_hdr *ipv6 = (const struct net_ipv6_hdr *)ip;
+
+		if (buf->len < sizeof(struct net_eth_hdr) + sizeof(*ipv6)) {
+			return 0;
+		}
+
+		proto = ipv6->nexthdr;
+		hash = flow_hash_add(hash, ipv6->src, 2 * sizeof(struct in6_addr));
+		ports = sizeof(*ipv6);
+	} else {
+		return 0;
+	}
+
+	hash = flow_hash_add(hash, &proto, sizeof(proto));
+
+	/* Source and destination ports */
+	if ((proto == IPPROTO_TCP || proto == IPPROTO_UDP) && ports > 0 &&
+	    buf->len >= sizeof(struct net_eth_hdr) + ports + 4) {
+		hash = flow_hash_add(hash, ip + ports, 4);
+	}
+#endif /* CONFIG_NET_L2_ETHERNET */
+
+	return hash;
+}
+
+static uint8_t tc_rx_queue(struct net_pkt *pkt)
+{
+	uint32_t hash = net_pkt_rx_hash(pkt);
+
+	if (hash == 0U) {
+		hash = tc_rx_flow_hash(pkt);
+		net_pkt_set_rx_hash(pkt, hash);
+	}
+
+	return hash % NET_TC_RX_QUEUES;
+}
+#else
+static inline uint8_t tc_rx_queue(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+#endif /* CONFIG_NET_TC_RX_STEERING */
+
 void net_tc_submit_to_rx_queue(uint8_t tc, struct net_pkt *pkt)
 {
 #if NET_TC_RX_COUNT > 0
 	net_pkt_set_rx_stats_tick(pkt, k_cycle_get_32());
 
-	submit_to_queue(&rx_classes[tc].fifo, pkt);
+	submit_to_queue(&rx_classes[tc * NET_TC_RX_QUEUES + tc_rx_queue(pkt)].fifo,
+			pkt);
 #else
 	ARG_UNUSED(tc);
 	ARG_UNUSED(pkt);
@@ -236,17 +342,230 @@ static void net_tc_rx_stats_priority_setup(struct net_if *iface,
 #endif
 #endif
 
+#if defined(CONFIG_NET_TCP_GRO)
+#define GRO_TCP_PSH 0x08
+#define GRO_TCP_ACK 0x10
+
+/* More fragments flag and fragment offset of the IPv4 header */
+#define GRO_IPV4_FRAG_MASK 0x3fff
+
+/* Canonical layout of the timestamps option: NOP, NOP, kind, length */
+#define GRO_TCP_TS_LEN 12
+#define GRO_TCP_TS_HDR 0x0101080a
+
+struct gro_hdr {
+	struct net_eth_hdr *eth;
+	uint8_t *ip;
+	/* Source address followed by the destination address */
+	uint8_t *addr;
+	struct net_tcp_hdr *tcp;
+	size_t addr_len;
+	size_t hdr_len;
+	size_t data_len;
+};
+
+/* Only untagged TCP segments carrying data and no other flag than PSH,
+ * with all the headers in the first buffer, are candidates for merging.
+ */
+static bool gro_parse(struct net_pkt *pkt, struct gro_hdr *hdr)
+{
+	struct net_buf *buf = pkt->buffer;
+	size_t len = net_pkt_get_len(pkt);
+	size_t ip_len;
+
+	if (buf == NULL || buf->len < sizeof(struct net_eth_hdr)) {
+		return false;
+	}
+
+	hdr->eth = (struct net_eth_hdr *)buf->data;
+	hdr->ip = buf->data + sizeof(struct net_eth_hdr);
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) &&
+	    hdr->eth->type == htons(NET_ETH_PTYPE_IP)) {
+		struct net_ipv4_hdr *ipv4 = (struct net_ipv4_hdr *)hdr->ip;
+
+		if (buf->len < sizeof(struct net_eth_hdr) + sizeof(*ipv4) ||
+		    ipv4->vhl != 0x45 || ipv4->proto != IPPROTO_TCP ||
+		    (ntohs(UNALIGNED_GET((uint16_t *)ipv4->offset)) &
+		     GRO_IPV4_FRAG_MASK) != 0U) {
+			return false;
+		}
+
+		ip_len = ntohs(UNALIGNED_GET(&ipv4->len));
+		hdr->addr = ipv4->src;
+		hdr->addr_len = 2 * sizeof(struct in_addr);
+		hdr->hdr_len = sizeof(*ipv4);
+	} else if (IS_ENABLED(CONFIG_NET_IPV6) &&
+		   hdr->eth->type == htons(NET_ETH_PTYPE_IPV6)) {
+		struct net_ipv6_hdr *ipv6 = (struct net_ipv6_hdr *)hdr->ip;
+
+		if (buf->len < sizeof(struct net_eth_hdr) + sizeof(*ipv6) ||
+		    ipv6->nexthdr != IPPROTO_TCP) {
+			return false;
+		}
+
+		ip_len = sizeof(*ipv6) + ntohs(UNALIGNED_GET(&ipv6->len));
+		hdr->addr = ipv6->src;
+		hdr->addr_len = 2 * sizeof(struct in6_addr);
+		hdr->hdr_len = sizeof(*ipv6);
+	} else {
+		return false;
+	}
+
+	/* Frames with padding are left alone */
+	if (sizeof(struct net_eth_hdr) + ip_len != len) {
+		return false;
+	}
+
+	hdr->hdr_len += sizeof(struct net_eth_hdr);
+	if (buf->len < hdr->hdr_len + sizeof(struct net_tcp_hdr)) {
+		return false;
+	}
+
+	hdr->tcp = (struct net_tcp_hdr *)(buf->data + hdr->hdr_len);
+	hdr->hdr_len += (hdr->tcp->offset >> 4) * 4U;
+
+	if ((hdr->tcp->offset >> 4) < 5 || buf->len < hdr->hdr_len ||
+	    len <= hdr->hdr_len ||
+	    (hdr->tcp->flags & ~GRO_TCP_PSH) != GRO_TCP_ACK) {
+		return false;
+	}
+
+	hdr->data_len = len - hdr->hdr_len;
+
+	return true;
+}
+
+/* The timestamps differ from segment to segment, the ones of the first
+ * segment are kept in the merged segment.
+ */
+static bool gro_tcp_opts_match(const struct gro_hdr *a, const struct gro_hdr *b)
+{
+	size_t len = (a->tcp->offset >> 4) * 4U - sizeof(struct net_tcp_hdr);
+	const uint8_t *opts_a = a->tcp->optdata;
+	const uint8_t *opts_b = b->tcp->optdata;
+
+	if (len >= GRO_TCP_TS_LEN &&
+	    UNALIGNED_GET((uint32_t *)opts_a) == htonl(GRO_TCP_TS_HDR) &&
+	    UNALIGNED_GET((uint32_t *)opts_b) == htonl(GRO_TCP_TS_HDR)) {
+		opts_a += GRO_TCP_TS_LEN;
+		opts_b += GRO_TCP_TS_LEN;
+		len -= GRO_TCP_TS_LEN;
+	}
+
+	return memcmp(opts_a, opts_b, len) == 0;
+}
+
+static bool gro_can_merge(struct net_pkt *pkt, const struct gro_hdr *hdr,
+			  struct net_pkt *next, const struct gro_hdr *next_hdr)
+{
+	uint32_t seq = ntohl(UNALIGNED_GET((uint32_t *)hdr->tcp->seq));
+	uint32_t next_seq = ntohl(UNALIGNED_GET((uint32_t *)next_hdr->tcp->seq));
+
+	return net_pkt_iface(pkt) == net_pkt_iface(next) &&
+	       hdr->eth->type == next_hdr->eth->type &&
+	       hdr->hdr_len == next_hdr->hdr_len &&
+	       hdr->data_len + next_hdr->data_len <= CONFIG_NET_TCP_GRO_MAX_SIZE &&
+	       !(hdr->tcp->flags & GRO_TCP_PSH) &&
+	       seq + hdr->data_len == next_seq &&
+	       memcmp(hdr->addr, next_hdr->addr, hdr->addr_len) == 0 &&
+	       hdr->tcp->src_port == next_hdr->tcp->src_port &&
+	       hdr->tcp->dst_port == next_hdr->tcp->dst_port &&
+	       memcmp(hdr->tcp->ack, next_hdr->tcp->ack, 4) == 0 &&
+	       memcmp(hdr->tcp->wnd, next_hdr->tcp->wnd, 2) == 0 &&
+	       gro_tcp_opts_match(hdr, next_hdr);
+}
+
+static void gro_merge(struct net_pkt *pkt, struct gro_hdr *hdr,
+		      struct net_pkt *next, const struct gro_hdr *next_hdr)
+{
+	struct net_buf *buf = next->buffer;
+	uint16_t len;
+
+	net_buf_pull(buf, next_hdr->hdr_len);
+	if (buf->len == 0U) {
+		next->buffer = buf->frags;
+		buf->frags = NULL;
+		net_buf_unref(buf);
+	}
+
+	net_pkt_append_buffer(pkt, next->buffer);
+	next->buffer = NULL;
+	net_pkt_unref(next);
+
+	hdr->tcp->flags |= next_hdr->tcp->flags & GRO_TCP_PSH;
+	hdr->data_len += next_hdr->data_len;
+
+	if (hdr->eth->type == htons(NET_ETH_PTYPE_IP)) {
+		struct net_ipv4_hdr *ipv4 = (struct net_ipv4_hdr *)hdr->ip;
+
+		len = ntohs(UNALIGNED_GET(&ipv4->len)) +
+		      next_hdr->data_len;
+		UNALIGNED_PUT(htons(len), &ipv4->len);
+
+		ipv4->chksum = 0U;
+		ipv4->chksum = ~calc_chksum(0, (uint8_t *)ipv4, sizeof(*ipv4));
+	} else {
+		struct net_ipv6_hdr *ipv6 = (struct net_ipv6_hdr *)hdr->ip;
+
+		len = ntohs(UNALIGNED_GET(&ipv6->len)) + next_hdr->data_len;
+		UNALIGNED_PUT(htons(len), &ipv6->len);
+	}
+}
+
+/* Merge the in-order segments of the same flow already waiting in the
+ * queue into the received packet, so that they go through the stack at
+ * once. Packets are never held back waiting for more segments. The
+ * segment checksums must have been verified by the network device, as
+ * the TCP checksum of the merged segment is not updated.
+ *
+ * Returns the packet that stopped the merging, if any.
+ */
+struct net_pkt *net_tc_gro_receive(struct k_fifo *fifo, struct net_pkt *pkt)
+{
+	struct gro_hdr hdr, next_hdr;
+	struct net_pkt *next;
+
+	if (net_if_l2(net_pkt_iface(pkt)) != &NET_L2_GET_NAME(ETHERNET) ||
+	    net_if_need_calc_rx_checksum(net_pkt_iface(pkt)) ||
+	    !gro_parse(pkt, &hdr)) {
+		return NULL;
+	}
+
+	while ((next = k_fifo_get(fifo, K_NO_WAIT)) != NULL) {
+		if (!gro_parse(next, &next_hdr) ||
+		    !gro_can_merge(pkt, &hdr, next, &next_hdr)) {
+			return next;
+		}
+
+		gro_merge(pkt, &hdr, next, &next_hdr);
+	}
+
+	return NULL;
+}
+#endif /* CONFIG_NET_TCP_GRO */
+
 #if NET_TC_RX_COUNT > 0
 static void tc_rx_handler(struct k_fifo *fifo)
 {
+	struct net_pkt *next = NULL;
 	struct net_pkt *pkt;
 
 	while (1) {
-		pkt = k_fifo_get(fifo, K_FOREVER);
-		if (pkt == NULL) {
-			continue;
+		if (next != NULL) {
+			pkt = next;
+			next = NULL;
+		} else {
+			pkt = k_fifo_get(fifo, K_FOREVER);
+			if (pkt == NULL) {
+				continue;
+			}
 		}
 
+#if defined(CONFIG_NET_TCP_GRO)
+		next = net_tc_gro_receive(fifo, pkt);
+#endif
+
 		net_process_rx_packet(pkt);
 	}
 }
@@ -343,12 +662,12 @@ void net_tc_rx_init(void)
 	net_if_foreach(net_tc_rx_stats_priority_setup, NULL);
 #endif
 
-	for (i = 0; i < NET_TC_RX_COUNT; i++) {
+	for (i = 0; i < NET_TC_RX_COUNT * NET_TC_RX_QUEUES; i++) {
 		uint8_t thread_priority;
 		int priority;
 		k_tid_t tid;
 
-		thread_priority = rx_tc2thread(i);
+		thread_priority = rx_tc2thread(i / NET_TC_RX_QUEUES);
 
 		priority = IS_ENABLED(CONFIG_NET_TC_THREAD_COOPERATIVE) ?
 			K_PRIO_COOP(thread_priority) :
@@ -378,10 +697,23 @@ void net_tc_rx_init(void)
 		if (IS_ENABLED(CONFIG_THREAD_NAME)) {
 			char name[MAX_NAME_LEN];
 
-			snprintk(name, sizeof(name), "rx_q[%d]", i);
+			if (NET_TC_RX_QUEUES > 1) {
+				snprintk(name, sizeof(name), "rx_q[%d.%d]",
+					 i / NET_TC_RX_QUEUES,
+					 i % NET_TC_RX_QUEUES);
+			} else {
+				snprintk(name, sizeof(name), "rx_q[%d]", i);
+			}
+
 			k_thread_name_set(tid, name);
 		}
 
+#if defined(CONFIG_NET_TC_RX_STEERING) && defined(CONFIG_SCHED_CPU_MASK)
+		/* Spread the queues of each traffic class over the CPUs */
+		(void)k_thread_cpu_pin(tid, (i % NET_TC_RX_QUEUES) %
+					    arch_num_cpus());
+#endif
+
 		k_thread_start(tid);
 	}
 #endif
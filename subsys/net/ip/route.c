@@ -276,15 +276,222 @@ static inline void update_route_access(struct net_route_entry *route)
 	sys_slist_prepend(&routes, &route->node);
 }
 
-struct net_route_entry *net_route_lookup(struct net_if *iface,
-					 struct in6_addr *dst)
+#if defined(CONFIG_NET_ROUTE_LPM_TRIE)
+/* Path compressed binary trie of the route prefixes. A node holds the
+ * routes having its prefix, and a node without routes is only kept as long
+ * as it branches to two children, so two nodes per route are enough.
+ */
+struct route_trie_node {
+	struct in6_addr prefix;
+	struct route_trie_node *parent;
+	struct route_trie_node *child[2];
+	sys_slist_t routes;
+	uint8_t len;
+	bool used;
+};
+
+static struct route_trie_node route_trie_nodes[2 * CONFIG_NET_MAX_ROUTES];
+static struct route_trie_node *route_trie;
+
+static inline int route_trie_bit(const struct in6_addr *addr, uint8_t pos)
+{
+	return (addr->s6_addr[pos / 8U] >> (7 - (pos % 8U))) & 1;
+}
+
+static uint8_t route_trie_common_len(const struct in6_addr *addr1,
+				     const struct in6_addr *addr2,
+				     uint8_t max_len)
+{
+	uint8_t len = 0U;
+
+	while (len < max_len) {
+		uint8_t diff = addr1->s6_addr[len / 8U] ^ addr2->s6_addr[len / 8U];
+
+		if (diff == 0U) {
+			len += 8U;
+			continue;
+		}
+
+		while (!(diff & 0x80)) {
+			diff <<= 1;
+			len++;
+		}
+
+		break;
+	}
+
+	return MIN(len, max_len);
+}
+
+static struct route_trie_node *route_trie_node_alloc(const struct in6_addr *addr,
+						     uint8_t len)
+{
+	struct route_trie_node *node;
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(route_trie_nodes); i++) {
+		node = &route_trie_nodes[i];
+
+		if (node->used) {
+			continue;
+		}
+
+		*node = (struct route_trie_node) {
+			.len = len,
+			.used = true,
+		};
+
+		/* Only keep the prefix bits of the address */
+		memcpy(node->prefix.s6_addr, addr->s6_addr, len / 8U);
+		if (len % 8U) {
+			node->prefix.s6_addr[len / 8U] =
+				addr->s6_addr[len / 8U] & (0xff << (8 - (len % 8U)));
+		}
+
+		return node;
+	}
+
+	return NULL;
+}
+
+static int route_trie_insert(struct net_route_entry *route)
+{
+	struct route_trie_node **link = &route_trie;
+	struct route_trie_node *parent = NULL;
+	struct route_trie_node *node, *new, *branch;
+	uint8_t len = route->prefix_len;
+	uint8_t common = 0U;
+
+	while ((node = *link) != NULL) {
+		common = route_trie_common_len(&node->prefix, &route->addr,
+					       MIN(node->len, len));
+		if (common < node->len) {
+			break;
+		}
+
+		if (node->len == len) {
+			sys_slist_append(&node->routes, &route->prefix_node);
+			return 0;
+		}
+
+		parent = node;
+		link = &node->child[route_trie_bit(&route->addr, node->len)];
+	}
+
+	new = route_trie_node_alloc(&route->addr, len);
+	if (!new) {
+		return -ENOMEM;
+	}
+
+	new->parent = parent;
+
+	if (node == NULL) {
+		*link = new;
+	} else if (common == len) {
+		/* The new prefix is a prefix of the one of the node */
+		new->child[route_trie_bit(&node->prefix, len)] = node;
+		node->parent = new;
+		*link = new;
+	} else {
+		/* The prefixes diverge, branch where they do */
+		branch = route_trie_node_alloc(&route->addr, common);
+		if (!branch) {
+			new->used = false;
+			return -ENOMEM;
+		}
+
+		branch->parent = parent;
+		branch->child[route_trie_bit(&node->prefix, common)] = node;
+		branch->child[route_trie_bit(&route->addr, common)] = new;
+		node->parent = branch;
+		new->parent = branch;
+		*link = branch;
+	}
+
+	sys_slist_append(&new->routes, &route->prefix_node);
+
+	return 0;
+}
+
+static void route_trie_compact(struct route_trie_node *node)
+{
+	struct route_trie_node *parent, *child;
+
+	while (node && sys_slist_is_empty(&node->routes)) {
+		if (node->child[0] && node->child[1]) {
+			break;
+		}
+
+		child = node->child[0] ? node->child[0] : node->child[1];
+		parent = node->parent;
+
+		if (child) {
+			child->parent = parent;
+		}
+
+		if (parent) {
+			parent->child[parent->child[1] == node] = child;
+		} else {
+			route_trie = child;
+		}
+
+		node->used = false;
+		node = parent;
+	}
+}
+
+static void route_trie_remove(struct net_route_entry *route)
+{
+	struct route_trie_node *node = route_trie;
+
+	while (node && node->len <= route->prefix_len &&
+	       net_ipv6_is_prefix(node->prefix.s6_addr, route->addr.s6_addr,
+				  node->len)) {
+		if (node->len == route->prefix_len) {
+			if (sys_slist_find_and_remove(&node->routes,
+						      &route->prefix_node)) {
+				route_trie_compact(node);
+			}
+
+			return;
+		}
+
+		node = node->child[route_trie_bit(&route->addr, node->len)];
+	}
+}
+
+static struct net_route_entry *route_find(struct net_if *iface,
+					  struct in6_addr *dst)
+{
+	struct route_trie_node *node = route_trie;
+	struct net_route_entry *route, *found = NULL;
+
+	while (node && net_ipv6_is_prefix(dst->s6_addr, node->prefix.s6_addr,
+					  node->len)) {
+		SYS_SLIST_FOR_EACH_CONTAINER(&node->routes, route, prefix_node) {
+			if (!iface || route->iface == iface) {
+				found = route;
+				break;
+			}
+		}
+
+		if (node->len >= 128) {
+			break;
+		}
+
+		node = node->child[route_trie_bit(dst, node->len)];
+	}
+
+	return found;
+}
+#else
+static struct net_route_entry *route_find(struct net_if *iface,
+					  struct in6_addr *dst)
 {
 	struct net_route_entry *route, *found = NULL;
 	uint8_t longest_match = 0U;
 	int i;
 
-	k_mutex_lock(&lock, K_FOREVER);
-
 	for (i = 0; i < CONFIG_NET_MAX_ROUTES && longest_match < 128; i++) {
 		struct net_nbr *nbr = get_nbr(i);
 
@@ -307,6 +514,18 @@ struct net_route_entry *net_route_lookup(struct net_if *iface,
 		}
 	}
 
+	return found;
+}
+#endif /* CONFIG_NET_ROUTE_LPM_TRIE */
+
+struct net_route_entry *net_route_lookup(struct net_if *iface,
+					 struct in6_addr *dst)
+{
+	struct net_route_entry *found;
+
+	k_mutex_lock(&lock, K_FOREVER);
+
+	found = route_find(iface, dst);
 	if (found) {
 		net_route_info("Found", found, dst);
 
@@ -451,6 +670,16 @@ struct net_route_entry *net_route_add(struct net_if *iface,
 	route->iface = iface;
 	route->preference = preference;
 
+#if defined(CONFIG_NET_ROUTE_LPM_TRIE)
+	if (route_trie_insert(route) < 0) {
+		NET_ERR("No route trie node available!");
+		release_nexthop_route(nexthop_route);
+		nbr_free(nbr);
+		route = NULL;
+		goto exit;
+	}
+#endif
+
 	net_route_update_lifetime(route, lifetime);
 
 	sys_slist_prepend(&routes, &route->node);
@@ -597,6 +826,10 @@ int net_route_del(struct net_route_entry *route)
 
 	sys_slist_find_and_remove(&routes, &route->node);
 
+#if defined(CONFIG_NET_ROUTE_LPM_TRIE)
+	route_trie_remove(route);
+#endif
+
 	nbr = net_route_get_nbr(route);
 	if (!nbr) {
 		k_mutex_unlock(&lock);
@@ -52,6 +52,11 @@ struct net_route_entry {
 	/** List of neighbors that the routes go through. */
 	sys_slist_t nexthop;
 
+#if defined(CONFIG_NET_ROUTE_LPM_TRIE)
+	/** Node in the list of routes with the same prefix. */
+	sys_snode_t prefix_node;
+#endif
+
 	/** Network interface for the route. */
 	struct net_if *iface;
 
@@ -10,6 +10,7 @@ LOG_MODULE_REGISTER(net_tcp, CONFIG_NET_TCP_LOG_LEVEL);
 #include <stdarg.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <limits.h>
 #include <zephyr/kernel.h>
 #include <zephyr/random/rand32.h>
 
@@ -62,14 +63,21 @@ static int tcp_tx_window =
 #define TCP_RTO_MS (tcp_rto)
 #endif
 
-/* Define the number of MSS sections the congestion window is initialized at */
-#define TCP_CONGESTION_INITIAL_WIN 1
-#define TCP_CONGESTION_INITIAL_SSTHRESH 3
-
 static sys_slist_t tcp_conns = SYS_SLIST_STATIC_INIT(&tcp_conns);
 
 static K_MUTEX_DEFINE(tcp_lock);
 
+/* Connections are also linked, oldest first, in a hash bucket selected by
+ * their endpoints so that received segments are looked up in one bucket
+ * under its own lock, without taking tcp_lock. Zeroed lists are empty.
+ */
+struct tcp_conn_bucket {
+	sys_slist_t conns;
+	struct k_spinlock lock;
+};
+
+static struct tcp_conn_bucket tcp_conn_buckets[CONFIG_NET_TCP_CONN_HASH_BUCKETS];
+
 K_MEM_SLAB_DEFINE_STATIC(tcp_conns_slab, sizeof(struct tcp),
 				CONFIG_NET_MAX_CONTEXTS, 4);
 
@@ -80,6 +88,8 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt);
 static bool is_destination_local(struct net_pkt *pkt);
 static void tcp_out(struct tcp *conn, uint8_t flags);
 static const char *tcp_state_to_str(enum tcp_state state, bool prefix);
+static void tcp_conn_hash_add(struct tcp *conn);
+static void tcp_conn_hash_remove(struct tcp *conn);
 
 int (*tcp_send_cb)(struct net_pkt *pkt) = NULL;
 size_t (*tcp_recv_cb)(struct tcp *conn, struct net_pkt *pkt) = NULL;
@@ -439,7 +449,7 @@ static void tcp_new_reno_dup_ack(struct tcp *conn)
 	int32_t new_win = conn->ca.cwnd;
 
 	new_win += conn_mss(conn);
-	conn->ca.cwnd = MIN(new_win, UINT16_MAX);
+	conn->ca.cwnd = MIN(new_win, NET_TCP_MAX_WIN);
 	tcp_new_reno_log(conn, "dup_ack");
 }
 
@@ -455,7 +465,7 @@ static void tcp_new_reno_pkts_acked(struct tcp *conn, uint32_t acked_len)
 			/* Implement a div_ceil	to avoid rounding to 0 */
 			new_win += ((win_inc * win_inc) + conn->ca.cwnd - 1) / conn->ca.cwnd;
 		}
-		conn->ca.cwnd = MIN(new_win, UINT16_MAX);
+		conn->ca.cwnd = MIN(new_win, NET_TCP_MAX_WIN);
 	} else {
 		/* Check if it is still in fast recovery mode */
 		if (conn->ca.pending_fast_retransmit_bytes <= acked_len) {
@@ -469,29 +479,65 @@ static void tcp_new_reno_pkts_acked(struct tcp *conn, uint32_t acked_len)
 	tcp_new_reno_log(conn, "pkts_acked");
 }
 
+STRUCT_SECTION_ITERABLE(tcp_ca_ops, tcp_ca_reno) = {
+	.name = "reno",
+	.init = tcp_new_reno_init,
+	.fast_retransmit = tcp_new_reno_fast_retransmit,
+	.timeout = tcp_new_reno_timeout,
+	.dup_ack = tcp_new_reno_dup_ack,
+	.pkts_acked = tcp_new_reno_pkts_acked,
+};
+
+static const struct tcp_ca_ops *tcp_ca_find(const char *name, size_t len)
+{
+	STRUCT_SECTION_FOREACH(tcp_ca_ops, ops) {
+		if (strlen(ops->name) == len &&
+		    strncmp(ops->name, name, len) == 0) {
+			return ops;
+		}
+	}
+
+	return NULL;
+}
+
+static const struct tcp_ca_ops *tcp_ca_default(void)
+{
+	const struct tcp_ca_ops *ops;
+
+	ops = tcp_ca_find(CONFIG_NET_TCP_CA_DEFAULT,
+			  strlen(CONFIG_NET_TCP_CA_DEFAULT));
+	if (ops == NULL) {
+		NET_WARN("Unknown congestion control %s, using %s",
+			 CONFIG_NET_TCP_CA_DEFAULT, tcp_ca_reno.name);
+		ops = &tcp_ca_reno;
+	}
+
+	return ops;
+}
+
 static void tcp_ca_init(struct tcp *conn)
 {
-	tcp_new_reno_init(conn);
+	conn->ca_ops->init(conn);
 }
 
 static void tcp_ca_fast_retransmit(struct tcp *conn)
 {
-	tcp_new_reno_fast_retransmit(conn);
+	conn->ca_ops->fast_retransmit(conn);
 }
 
 static void tcp_ca_timeout(struct tcp *conn)
 {
-	tcp_new_reno_timeout(conn);
+	conn->ca_ops->timeout(conn);
 }
 
 static void tcp_ca_dup_ack(struct tcp *conn)
 {
-	tcp_new_reno_dup_ack(conn);
+	conn->ca_ops->dup_ack(conn);
 }
 
 static void tcp_ca_pkts_acked(struct tcp *conn, uint32_t acked_len)
 {
-	tcp_new_reno_pkts_acked(conn, acked_len);
+	conn->ca_ops->pkts_acked(conn, acked_len);
 }
 #else
 
@@ -582,6 +628,7 @@ static int tcp_conn_unref(struct tcp *conn)
 	(void)k_work_cancel_delayable(&conn->ack_timer);
 
 	sys_slist_find_and_remove(&tcp_conns, &conn->next);
+	tcp_conn_hash_remove(conn);
 
 	memset(conn, 0, sizeof(*conn));
 
@@ -800,6 +847,13 @@ static bool tcp_options_check(struct tcp_options *recv_options,
 
 	recv_options->mss_found = false;
 	recv_options->wnd_found = false;
+#ifdef CONFIG_NET_TCP_SACK
+	recv_options->sack_perm_found = false;
+	recv_options->sack_cnt = 0;
+#endif
+#ifdef CONFIG_NET_TCP_TIMESTAMPS
+	recv_options->ts_found = false;
+#endif
 
 	for ( ; options && len >= 1; options += opt_len, len -= opt_len) {
 		opt = options[0];
@@ -845,9 +899,49 @@ static bool tcp_options_check(struct tcp_options *recv_options,
 				goto end;
 			}
 
-			recv_options->window = opt;
+			recv_options->window = options[2];
 			recv_options->wnd_found = true;
 			break;
+#ifdef CONFIG_NET_TCP_TIMESTAMPS
+		case NET_TCP_TIMESTAMP_OPT:
+			if (opt_len != NET_TCP_TIMESTAMP_SIZE) {
+				result = false;
+				goto end;
+			}
+
+			recv_options->tsval =
+				ntohl(UNALIGNED_GET((uint32_t *)(options + 2)));
+			recv_options->tsecr =
+				ntohl(UNALIGNED_GET((uint32_t *)(options + 6)));
+			recv_options->ts_found = true;
+			break;
+#endif
+#ifdef CONFIG_NET_TCP_SACK
+		case NET_TCP_SACK_PERM_OPT:
+			if (opt_len != NET_TCP_SACK_PERM_SIZE) {
+				result = false;
+				goto end;
+			}
+
+			recv_options->sack_perm_found = true;
+			break;
+		case NET_TCP_SACK_OPT:
+			if (((opt_len - 2) % NET_TCP_SACK_BLOCK_SIZE) != 0) {
+				result = false;
+				goto end;
+			}
+
+			for (int i = 2; i < opt_len &&
+			     recv_options->sack_cnt < NET_TCP_SACK_MAX_BLOCKS;
+			     i += NET_TCP_SACK_BLOCK_SIZE) {
+				struct tcp_sack_block *block =
+					&recv_options->sack[recv_options->sack_cnt++];
+
+				block->left = ntohl(UNALIGNED_GET((uint32_t *)(options + i)));
+				block->right = ntohl(UNALIGNED_GET((uint32_t *)(options + i + 4)));
+			}
+			break;
+#endif
 		default:
 			continue;
 		}
@@ -1021,6 +1115,379 @@ static int tcp_finalize_pkt(struct net_pkt *pkt)
 	return -EINVAL;
 }
 
+#ifdef CONFIG_NET_TCP_SACK
+/* Length of the SACK option to send, padded to a word with NOPs. The SYN
+ * segments carry the SACK permitted option, the other ones the block of
+ * out-of-order data held in the receive queue, if any.
+ */
+static size_t tcp_sack_opt_len(struct tcp *conn)
+{
+	if (conn->send_options.sack_perm_found) {
+		return 2 * NET_TCP_NOP_SIZE + NET_TCP_SACK_PERM_SIZE;
+	}
+
+	if (conn->sack_enabled && CONFIG_NET_TCP_RECV_QUEUE_TIMEOUT &&
+	    !net_pkt_is_empty(conn->queue_recv_data)) {
+		return 2 * NET_TCP_NOP_SIZE + 2 + NET_TCP_SACK_BLOCK_SIZE;
+	}
+
+	return 0;
+}
+
+static int net_tcp_set_sack_opt(struct tcp *conn, struct net_pkt *pkt)
+{
+	uint8_t opt[2 * NET_TCP_NOP_SIZE + 2 + NET_TCP_SACK_BLOCK_SIZE];
+	size_t len = tcp_sack_opt_len(conn);
+	uint32_t left;
+
+	if (len == 0) {
+		return 0;
+	}
+
+	opt[0] = NET_TCP_NOP_OPT;
+	opt[1] = NET_TCP_NOP_OPT;
+
+	if (conn->send_options.sack_perm_found) {
+		opt[2] = NET_TCP_SACK_PERM_OPT;
+		opt[3] = NET_TCP_SACK_PERM_SIZE;
+	} else {
+		left = tcp_get_seq(conn->queue_recv_data->buffer);
+
+		opt[2] = NET_TCP_SACK_OPT;
+		opt[3] = 2 + NET_TCP_SACK_BLOCK_SIZE;
+		UNALIGNED_PUT(htonl(left), (uint32_t *)&opt[4]);
+		UNALIGNED_PUT(htonl(left + net_pkt_get_len(conn->queue_recv_data)),
+			      (uint32_t *)&opt[8]);
+	}
+
+	return net_pkt_write(pkt, opt, len);
+}
+
+/* Adds a block to the scoreboard, merging it with the blocks it overlaps */
+static void tcp_sack_insert(struct tcp *conn, uint32_t left, uint32_t right)
+{
+	struct tcp_sack_block *sacked = conn->sacked;
+	int cnt = conn->sacked_cnt;
+	int i = 0;
+
+	while (i < cnt) {
+		if (net_tcp_seq_cmp(right, sacked[i].left) >= 0 &&
+		    net_tcp_seq_cmp(sacked[i].right, left) >= 0) {
+			if (net_tcp_seq_greater(left, sacked[i].left)) {
+				left = sacked[i].left;
+			}
+
+			if (net_tcp_seq_greater(sacked[i].right, right)) {
+				right = sacked[i].right;
+			}
+
+			cnt--;
+			memmove(&sacked[i], &sacked[i + 1],
+				(cnt - i) * sizeof(sacked[0]));
+			continue;
+		}
+
+		i++;
+	}
+
+	for (i = 0; i < cnt && net_tcp_seq_greater(left, sacked[i].left); i++) {
+	}
+
+	if (cnt == NET_TCP_SACK_MAX_BLOCKS) {
+		if (i == cnt) {
+			/* Only the lowest blocks are worth remembering */
+			conn->sacked_cnt = cnt;
+			return;
+		}
+
+		cnt--;
+	}
+
+	memmove(&sacked[i + 1], &sacked[i], (cnt - i) * sizeof(sacked[0]));
+	sacked[i].left = left;
+	sacked[i].right = right;
+	conn->sacked_cnt = cnt + 1;
+}
+
+/* Updates the scoreboard with a cumulative acknowledgment and the SACK
+ * blocks of the segment.
+ */
+static void tcp_sack_update(struct tcp *conn, uint32_t ack)
+{
+	uint32_t end = conn->seq + conn->send_data_total;
+	int cnt = 0;
+
+	if (!conn->sack_enabled) {
+		return;
+	}
+
+	if (net_tcp_seq_greater(conn->seq, ack)) {
+		ack = conn->seq;
+	}
+
+	for (int i = 0; i < conn->sacked_cnt; i++) {
+		struct tcp_sack_block block = conn->sacked[i];
+
+		if (!net_tcp_seq_greater(block.right, ack)) {
+			continue;
+		}
+
+		if (net_tcp_seq_greater(ack, block.left)) {
+			block.left = ack;
+		}
+
+		conn->sacked[cnt++] = block;
+	}
+
+	conn->sacked_cnt = cnt;
+
+	for (int i = 0; i < conn->recv_options.sack_cnt; i++) {
+		struct tcp_sack_block *block = &conn->recv_options.sack[i];
+		uint32_t left = block->left;
+
+		if (net_tcp_seq_greater(ack, left)) {
+			left = ack;
+		}
+
+		/* Ignore blocks of data that was acked or never sent */
+		if (!net_tcp_seq_greater(block->right, left) ||
+		    net_tcp_seq_greater(block->right, end)) {
+			continue;
+		}
+
+		tcp_sack_insert(conn, left, block->right);
+	}
+}
+
+/* Skips the data acknowledged selectively when resending, returns the
+ * length of data that can be sent before the next block of such data.
+ */
+static int tcp_sack_skip(struct tcp *conn)
+{
+	uint32_t next = conn->seq + conn->unacked_len;
+
+	for (int i = 0; i < conn->sacked_cnt; i++) {
+		struct tcp_sack_block *block = &conn->sacked[i];
+
+		if (net_tcp_seq_greater(block->left, next)) {
+			return block->left - next;
+		}
+
+		if (net_tcp_seq_greater(block->right, next)) {
+			conn->unacked_len += block->right - next;
+			next = block->right;
+		}
+	}
+
+	return INT_MAX;
+}
+#else
+static inline size_t tcp_sack_opt_len(struct tcp *conn)
+{
+	ARG_UNUSED(conn);
+
+	return 0;
+}
+
+static inline int net_tcp_set_sack_opt(struct tcp *conn, struct net_pkt *pkt)
+{
+	ARG_UNUSED(conn);
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+#endif /* CONFIG_NET_TCP_SACK */
+
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+/* Smallest shift for the whole receive window to be advertised */
+static uint8_t tcp_recv_wscale(struct tcp *conn)
+{
+	uint8_t shift = 0;
+
+	while (shift < NET_TCP_MAX_WSCALE &&
+	       (conn->recv_win_max >> shift) > UINT16_MAX) {
+		shift++;
+	}
+
+	return shift;
+}
+
+/* The window scale option is only sent in SYN segments */
+static size_t tcp_wscale_opt_len(struct tcp *conn)
+{
+	if (conn->send_options.wnd_found) {
+		return NET_TCP_NOP_SIZE + NET_TCP_WINDOW_SCALE_SIZE;
+	}
+
+	return 0;
+}
+
+static int net_tcp_set_wscale_opt(struct tcp *conn, struct net_pkt *pkt)
+{
+	uint8_t opt[NET_TCP_NOP_SIZE + NET_TCP_WINDOW_SCALE_SIZE];
+
+	if (!conn->send_options.wnd_found) {
+		return 0;
+	}
+
+	opt[0] = NET_TCP_NOP_OPT;
+	opt[1] = NET_TCP_WINDOW_SCALE_OPT;
+	opt[2] = NET_TCP_WINDOW_SCALE_SIZE;
+	opt[3] = conn->recv_wscale;
+
+	return net_pkt_write(pkt, opt, sizeof(opt));
+}
+
+/* The window field of SYN segments is never scaled */
+static uint16_t tcp_recv_win_field(struct tcp *conn, uint8_t flags)
+{
+	uint32_t win = conn->recv_win;
+
+	if (!(flags & SYN)) {
+		win >>= conn->recv_wscale;
+	}
+
+	return MIN(win, UINT16_MAX);
+}
+
+static uint32_t tcp_send_win_field(struct tcp *conn, struct tcphdr *th)
+{
+	uint32_t win = ntohs(th_win(th));
+
+	if (!(th_flags(th) & SYN)) {
+		win <<= conn->send_wscale;
+	}
+
+	return win;
+}
+#else
+static inline size_t tcp_wscale_opt_len(struct tcp *conn)
+{
+	ARG_UNUSED(conn);
+
+	return 0;
+}
+
+static inline int net_tcp_set_wscale_opt(struct tcp *conn, struct net_pkt *pkt)
+{
+	ARG_UNUSED(conn);
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+
+static inline uint16_t tcp_recv_win_field(struct tcp *conn, uint8_t flags)
+{
+	ARG_UNUSED(flags);
+
+	return MIN(conn->recv_win, UINT16_MAX);
+}
+
+static inline uint32_t tcp_send_win_field(struct tcp *conn, struct tcphdr *th)
+{
+	ARG_UNUSED(conn);
+
+	return ntohs(th_win(th));
+}
+#endif /* CONFIG_NET_TCP_WINDOW_SCALE */
+
+#ifdef CONFIG_NET_TCP_TIMESTAMPS
+/* The SYN segments offer the timestamps option, once negotiated it is
+ * sent in every segment.
+ */
+static size_t tcp_ts_opt_len(struct tcp *conn)
+{
+	if (conn->send_options.ts_found || conn->ts_enabled) {
+		return 2 * NET_TCP_NOP_SIZE + NET_TCP_TIMESTAMP_SIZE;
+	}
+
+	return 0;
+}
+
+static int net_tcp_set_ts_opt(struct tcp *conn, struct net_pkt *pkt)
+{
+	uint8_t opt[2 * NET_TCP_NOP_SIZE + NET_TCP_TIMESTAMP_SIZE];
+
+	if (tcp_ts_opt_len(conn) == 0) {
+		return 0;
+	}
+
+	opt[0] = NET_TCP_NOP_OPT;
+	opt[1] = NET_TCP_NOP_OPT;
+	opt[2] = NET_TCP_TIMESTAMP_OPT;
+	opt[3] = NET_TCP_TIMESTAMP_SIZE;
+	UNALIGNED_PUT(htonl(k_uptime_get_32() + conn->ts_offset),
+		      (uint32_t *)&opt[4]);
+	UNALIGNED_PUT(htonl(conn->ts_enabled ? conn->ts_recent : 0),
+		      (uint32_t *)&opt[8]);
+
+	return net_pkt_write(pkt, opt, sizeof(opt));
+}
+
+/* Keep the timestamp of the oldest segment not acknowledged yet to be
+ * echoed, RFC 7323 ch 4.3.
+ */
+static void tcp_ts_update(struct tcp *conn, struct tcphdr *th)
+{
+	if (!conn->ts_enabled || !conn->recv_options.ts_found) {
+		return;
+	}
+
+	if (!net_tcp_seq_greater(th_seq(th), conn->ack) &&
+	    net_tcp_seq_cmp(conn->recv_options.tsval, conn->ts_recent) >= 0) {
+		conn->ts_recent = conn->recv_options.tsval;
+	}
+}
+#else
+static inline size_t tcp_ts_opt_len(struct tcp *conn)
+{
+	ARG_UNUSED(conn);
+
+	return 0;
+}
+
+static inline int net_tcp_set_ts_opt(struct tcp *conn, struct net_pkt *pkt)
+{
+	ARG_UNUSED(conn);
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+
+static inline void tcp_ts_update(struct tcp *conn, struct tcphdr *th)
+{
+	ARG_UNUSED(conn);
+	ARG_UNUSED(th);
+}
+#endif /* CONFIG_NET_TCP_TIMESTAMPS */
+
+/* Length of the options to send in a segment, except the MSS option */
+static size_t tcp_opt_len(struct tcp *conn)
+{
+	return tcp_wscale_opt_len(conn) + tcp_ts_opt_len(conn) +
+	       tcp_sack_opt_len(conn);
+}
+
+/* Largest amount of data that fits in a segment along with the options */
+static int tcp_send_mss(struct tcp *conn)
+{
+	return conn_mss(conn) - tcp_ts_opt_len(conn) - tcp_sack_opt_len(conn);
+}
+
+/* Largest amount of data to send at once, a super-segment of several
+ * segments is split into segments of tcp_send_mss() when sent.
+ */
+static int tcp_send_len(struct tcp *conn)
+{
+	int mss = tcp_send_mss(conn);
+
+#if defined(CONFIG_NET_TCP_GSO)
+	return MAX(ROUND_DOWN(CONFIG_NET_TCP_GSO_MAX_SIZE, mss), mss);
+#else
+	return mss;
+#endif
+}
+
 static int tcp_header_add(struct tcp *conn, struct net_pkt *pkt, uint8_t flags,
 			  uint32_t seq)
 {
@@ -1042,8 +1509,10 @@ static int tcp_header_add(struct tcp *conn, struct net_pkt *pkt, uint8_t flags,
 		th->th_off++;
 	}
 
+	th->th_off += tcp_opt_len(conn) / 4;
+
 	UNALIGNED_PUT(flags, &th->th_flags);
-	UNALIGNED_PUT(htons(conn->recv_win), &th->th_win);
+	UNALIGNED_PUT(htons(tcp_recv_win_field(conn, flags)), &th->th_win);
 	UNALIGNED_PUT(htonl(seq), &th->th_seq);
 
 	if (ACK & flags) {
@@ -1101,6 +1570,62 @@ static int get_tcp_nodelay(struct tcp *conn, void *value, size_t *len)
 	return 0;
 }
 
+static int set_tcp_congestion(struct tcp *conn, const void *value, size_t len)
+{
+#ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
+	const struct tcp_ca_ops *ops;
+
+	/* The name does not need to be terminated */
+	len = strnlen(value, len);
+
+	ops = tcp_ca_find(value, len);
+	if (ops == NULL) {
+		return -ENOENT;
+	}
+
+	conn->ca_ops = ops;
+
+	/* A connection that is not established yet is initialized on
+	 * establishment.
+	 */
+	if (conn->state == TCP_ESTABLISHED || conn->state == TCP_CLOSE_WAIT) {
+		tcp_ca_init(conn);
+	}
+
+	return 0;
+#else
+	ARG_UNUSED(conn);
+	ARG_UNUSED(value);
+	ARG_UNUSED(len);
+
+	return -ENOPROTOOPT;
+#endif
+}
+
+static int get_tcp_congestion(struct tcp *conn, void *value, size_t *len)
+{
+#ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
+	size_t name_len = strlen(conn->ca_ops->name);
+
+	if (len == NULL || *len == 0) {
+		return -EINVAL;
+	}
+
+	name_len = MIN(name_len, *len - 1);
+	memcpy(value, conn->ca_ops->name, name_len);
+	((char *)value)[name_len] = '\0';
+	*len = name_len + 1;
+
+	return 0;
+#else
+	ARG_UNUSED(conn);
+	ARG_UNUSED(value);
+	ARG_UNUSED(len);
+
+	return -ENOPROTOOPT;
+#endif
+}
+
 static int net_tcp_set_mss_opt(struct tcp *conn, struct net_pkt *pkt)
 {
 	NET_PKT_DATA_ACCESS_DEFINE(mss_opt_access, struct tcp_mss_option);
@@ -1154,6 +1679,8 @@ static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		alloc_len += sizeof(uint32_t);
 	}
 
+	alloc_len += tcp_opt_len(conn);
+
 	pkt = tcp_pkt_alloc(conn, alloc_len);
 	if (!pkt) {
 		ret = -ENOBUFS;
@@ -1161,6 +1688,10 @@ static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 	}
 
 	if (data) {
+		if (net_pkt_get_len(data) > tcp_send_mss(conn)) {
+			net_pkt_set_gso_size(pkt, tcp_send_mss(conn));
+		}
+
 		/* Append the data buffer to the pkt */
 		net_pkt_append_buffer(pkt, data->buffer);
 		data->buffer = NULL;
@@ -1186,6 +1717,24 @@ static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		}
 	}
 
+	ret = net_tcp_set_wscale_opt(conn, pkt);
+	if (ret < 0) {
+		tcp_pkt_unref(pkt);
+		goto out;
+	}
+
+	ret = net_tcp_set_ts_opt(conn, pkt);
+	if (ret < 0) {
+		tcp_pkt_unref(pkt);
+		goto out;
+	}
+
+	ret = net_tcp_set_sack_opt(conn, pkt);
+	if (ret < 0) {
+		tcp_pkt_unref(pkt);
+		goto out;
+	}
+
 	ret = tcp_finalize_pkt(pkt);
 	if (ret < 0) {
 		tcp_pkt_unref(pkt);
@@ -1300,7 +1849,13 @@ static int tcp_send_data(struct tcp *conn)
 	int len;
 	struct net_pkt *pkt;
 
-	len = MIN(tcp_unsent_len(conn), conn_mss(conn));
+#ifdef CONFIG_NET_TCP_SACK
+	/* Do not send again the data the peer already has */
+	len = tcp_sack_skip(conn);
+	len = MIN(MIN(tcp_unsent_len(conn), tcp_send_len(conn)), len);
+#else
+	len = MIN(tcp_unsent_len(conn), tcp_send_len(conn));
+#endif
 	if (len < 0) {
 		ret = len;
 		goto out;
@@ -1441,6 +1996,15 @@ static void tcp_resend_data(struct k_work *work)
 		}
 	}
 
+#ifdef CONFIG_NET_TCP_SACK
+	/* The peer may have discarded the data it acknowledged selectively,
+	 * only trust the scoreboard for the first retransmission.
+	 */
+	if (conn->send_data_retries > 0) {
+		conn->sacked_cnt = 0;
+	}
+#endif
+
 	conn->data_mode = TCP_DATA_MODE_RESEND;
 	conn->unacked_len = 0;
 
@@ -1612,10 +2176,20 @@ static struct tcp *tcp_conn_alloc(void)
 
 	conn->in_connect = false;
 	conn->state = TCP_LISTEN;
-	conn->recv_win_max = tcp_rx_window;
+	conn->recv_win_max = MIN(tcp_rx_window, NET_TCP_MAX_WIN);
 	conn->recv_win = conn->recv_win_max;
-	conn->send_win_max = MAX(tcp_tx_window, NET_IPV6_MTU);
+	conn->send_win_max = MIN(MAX(tcp_tx_window, NET_IPV6_MTU),
+				 NET_TCP_MAX_WIN);
 	conn->send_win = conn->send_win_max;
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+	conn->recv_wscale = 0;
+	conn->send_wscale = 0;
+#endif
+#ifdef CONFIG_NET_TCP_TIMESTAMPS
+	conn->ts_offset = sys_rand32_get();
+	conn->ts_recent = 0;
+	conn->ts_enabled = false;
+#endif
 	conn->tcp_nodelay = false;
 #ifdef CONFIG_NET_TCP_FAST_RETRANSMIT
 	conn->dup_ack_cnt = 0;
@@ -1624,7 +2198,8 @@ static struct tcp *tcp_conn_alloc(void)
 	/* Initially set the congestion window at its max size, since only the MSS
 	 * is available as soon as the connection is established
 	 */
-	conn->ca.cwnd = UINT16_MAX;
+	conn->ca.cwnd = NET_TCP_MAX_WIN;
+	conn->ca_ops = tcp_ca_default();
 #endif
 
 	/* The ISN value will be set when we get the connection attempt or
@@ -1645,6 +2220,7 @@ static struct tcp *tcp_conn_alloc(void)
 	tcp_conn_ref(conn);
 
 	sys_slist_append(&tcp_conns, &conn->next);
+	tcp_conn_hash_add(conn);
 out:
 	NET_DBG("conn: %p", conn);
 
@@ -1682,38 +2258,97 @@ out:
 	return ret;
 }
 
-static bool tcp_endpoint_cmp(union tcp_endpoint *ep, struct net_pkt *pkt,
-			     enum pkt_addr which)
+static bool tcp_endpoint_cmp(union tcp_endpoint *ep, union tcp_endpoint *ep_pkt)
 {
-	union tcp_endpoint ep_tmp;
+	return !memcmp(ep, ep_pkt, tcp_endpoint_len(ep->sa.sa_family));
+}
 
-	if (tcp_endpoint_set(&ep_tmp, pkt, which) < 0) {
-		return false;
+static bool tcp_conn_cmp(struct tcp *conn, union tcp_endpoint *local,
+			 union tcp_endpoint *remote)
+{
+	return tcp_endpoint_cmp(&conn->src, local) &&
+		tcp_endpoint_cmp(&conn->dst, remote);
+}
+
+static uint8_t tcp_conn_hash(union tcp_endpoint *local,
+			     union tcp_endpoint *remote)
+{
+	uint32_t hash = 0U;
+
+	if (IS_ENABLED(CONFIG_NET_IPV6) && remote->sa.sa_family == AF_INET6) {
+		hash = UNALIGNED_GET(&remote->sin6.sin6_addr.s6_addr32[3]);
+	} else if (IS_ENABLED(CONFIG_NET_IPV4) &&
+		   remote->sa.sa_family == AF_INET) {
+		hash = UNALIGNED_GET(&remote->sin.sin_addr.s_addr);
 	}
 
-	return !memcmp(ep, &ep_tmp, tcp_endpoint_len(ep->sa.sa_family));
+	/* The port fields are at the same offset for both families */
+	hash ^= ((uint32_t)ntohs(local->sin.sin_port) << 16) |
+		ntohs(remote->sin.sin_port);
+	hash ^= hash >> 16;
+	hash ^= hash >> 8;
+
+	return hash % CONFIG_NET_TCP_CONN_HASH_BUCKETS;
+}
+
+static void tcp_conn_hash_add(struct tcp *conn)
+{
+	struct tcp_conn_bucket *bucket;
+	k_spinlock_key_t key;
+
+	conn->hash_bucket = tcp_conn_hash(&conn->src, &conn->dst);
+	bucket = &tcp_conn_buckets[conn->hash_bucket];
+
+	key = k_spin_lock(&bucket->lock);
+	sys_slist_append(&bucket->conns, &conn->hash_next);
+	k_spin_unlock(&bucket->lock, key);
 }
 
-static bool tcp_conn_cmp(struct tcp *conn, struct net_pkt *pkt)
+static void tcp_conn_hash_remove(struct tcp *conn)
 {
-	return tcp_endpoint_cmp(&conn->src, pkt, TCP_EP_DST) &&
-		tcp_endpoint_cmp(&conn->dst, pkt, TCP_EP_SRC);
+	struct tcp_conn_bucket *bucket = &tcp_conn_buckets[conn->hash_bucket];
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&bucket->lock);
+	sys_slist_find_and_remove(&bucket->conns, &conn->hash_next);
+	k_spin_unlock(&bucket->lock, key);
+}
+
+/* Must be called whenever the endpoints of the connection are changed */
+static void tcp_conn_rehash(struct tcp *conn)
+{
+	tcp_conn_hash_remove(conn);
+	tcp_conn_hash_add(conn);
 }
 
 static struct tcp *tcp_conn_search(struct net_pkt *pkt)
 {
-	bool found = false;
+	struct tcp_conn_bucket *bucket;
+	union tcp_endpoint local;
+	union tcp_endpoint remote;
+	struct tcp *found = NULL;
 	struct tcp *conn;
-	struct tcp *tmp;
+	k_spinlock_key_t key;
 
-	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&tcp_conns, conn, tmp, next) {
-		found = tcp_conn_cmp(conn, pkt);
-		if (found) {
+	if (tcp_endpoint_set(&local, pkt, TCP_EP_DST) < 0 ||
+	    tcp_endpoint_set(&remote, pkt, TCP_EP_SRC) < 0) {
+		return NULL;
+	}
+
+	bucket = &tcp_conn_buckets[tcp_conn_hash(&local, &remote)];
+
+	key = k_spin_lock(&bucket->lock);
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&bucket->conns, conn, hash_next) {
+		if (tcp_conn_cmp(conn, &local, &remote)) {
+			found = conn;
 			break;
 		}
 	}
 
-	return found ? conn : NULL;
+	k_spin_unlock(&bucket->lock, key);
+
+	return found;
 }
 
 static struct tcp *tcp_conn_new(struct net_pkt *pkt);
@@ -1750,6 +2385,9 @@ static enum net_verdict tcp_recv(struct net_conn *net_conn,
 		net_ipaddr_copy(&conn_old->context->remote, &conn->dst.sa);
 
 		conn->accepted_conn = conn_old;
+#ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
+		conn->ca_ops = conn_old->ca_ops;
+#endif
 	}
  in:
 	if (conn) {
@@ -1892,6 +2530,8 @@ static struct tcp *tcp_conn_new(struct net_pkt *pkt)
 		goto err;
 	}
 
+	tcp_conn_rehash(conn);
+
 	NET_DBG("conn: src: %s, dst: %s",
 		net_sprint_addr(conn->src.sa.sa_family,
 				(const void *)&conn->src.sin.sin_addr),
@@ -2221,7 +2861,7 @@ static void tcp_check_sock_options(struct tcp *conn)
 	if (sndbuf_opt > 0 && sndbuf_opt != conn->send_win_max) {
 		k_mutex_lock(&conn->lock, K_FOREVER);
 
-		conn->send_win_max = sndbuf_opt;
+		conn->send_win_max = MIN(sndbuf_opt, NET_TCP_MAX_WIN);
 		if (conn->send_win > conn->send_win_max) {
 			conn->send_win = conn->send_win_max;
 		}
@@ -2234,6 +2874,7 @@ static void tcp_check_sock_options(struct tcp *conn)
 
 		k_mutex_lock(&conn->lock, K_FOREVER);
 
+		rcvbuf_opt = MIN(rcvbuf_opt, NET_TCP_MAX_WIN);
 		diff = rcvbuf_opt - conn->recv_win_max;
 		conn->recv_win_max = rcvbuf_opt;
 		tcp_update_recv_wnd(conn, diff);
@@ -2295,6 +2936,16 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 		goto next_state;
 	}
 
+	/* Options are only parsed when present, do not use stale ones */
+	conn->recv_options.wnd_found = false;
+#ifdef CONFIG_NET_TCP_SACK
+	conn->recv_options.sack_perm_found = false;
+	conn->recv_options.sack_cnt = 0;
+#endif
+#ifdef CONFIG_NET_TCP_TIMESTAMPS
+	conn->recv_options.ts_found = false;
+#endif
+
 	if (tcp_options_len && !tcp_options_check(&conn->recv_options, pkt,
 						  tcp_options_len)) {
 		NET_DBG("DROP: Invalid TCP option list");
@@ -2320,7 +2971,9 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 	}
 
 	if (th) {
-		conn->send_win = ntohs(th_win(th));
+		tcp_ts_update(conn, th);
+
+		conn->send_win = tcp_send_win_field(conn, th);
 		if (conn->send_win > conn->send_win_max) {
 			NET_DBG("Lowering send window from %u to %u",
 				conn->send_win, conn->send_win_max);
@@ -2354,9 +3007,33 @@ next_state:
 		if (FL(&fl, ==, SYN)) {
 			/* Make sure our MSS is also sent in the ACK */
 			conn->send_options.mss_found = true;
+#ifdef CONFIG_NET_TCP_SACK
+			conn->sack_enabled = conn->recv_options.sack_perm_found;
+			conn->send_options.sack_perm_found = conn->sack_enabled;
+#endif
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+			if (conn->recv_options.wnd_found) {
+				conn->send_options.wnd_found = true;
+				conn->recv_wscale = tcp_recv_wscale(conn);
+				conn->send_wscale = MIN(conn->recv_options.window,
+							NET_TCP_MAX_WSCALE);
+			}
+#endif
+#ifdef CONFIG_NET_TCP_TIMESTAMPS
+			conn->ts_enabled = conn->recv_options.ts_found;
+			if (conn->ts_enabled) {
+				conn->ts_recent = conn->recv_options.tsval;
+			}
+#endif
 			conn_ack(conn, th_seq(th) + 1); /* capture peer's isn */
 			tcp_out(conn, SYN | ACK);
 			conn->send_options.mss_found = false;
+#ifdef CONFIG_NET_TCP_SACK
+			conn->send_options.sack_perm_found = false;
+#endif
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+			conn->send_options.wnd_found = false;
+#endif
 			conn_seq(conn, + 1);
 			next = TCP_SYN_RECEIVED;
 
@@ -2368,8 +3045,27 @@ next_state:
 			verdict = NET_OK;
 		} else {
 			conn->send_options.mss_found = true;
+#ifdef CONFIG_NET_TCP_SACK
+			conn->send_options.sack_perm_found = true;
+#endif
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+			conn->send_options.wnd_found = true;
+			conn->recv_wscale = tcp_recv_wscale(conn);
+#endif
+#ifdef CONFIG_NET_TCP_TIMESTAMPS
+			conn->send_options.ts_found = true;
+#endif
 			tcp_out(conn, SYN);
 			conn->send_options.mss_found = false;
+#ifdef CONFIG_NET_TCP_SACK
+			conn->send_options.sack_perm_found = false;
+#endif
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+			conn->send_options.wnd_found = false;
+#endif
+#ifdef CONFIG_NET_TCP_TIMESTAMPS
+			conn->send_options.ts_found = false;
+#endif
 			conn_seq(conn, + 1);
 			next = TCP_SYN_SENT;
 		}
@@ -2421,6 +3117,24 @@ next_state:
 		 */
 		if (FL(&fl, &, SYN | ACK, th && th_ack(th) == conn->seq)) {
 			tcp_send_timer_cancel(conn);
+#ifdef CONFIG_NET_TCP_SACK
+			conn->sack_enabled = conn->recv_options.sack_perm_found;
+#endif
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+			/* Both sides scale their window only if both offered to */
+			if (conn->recv_options.wnd_found) {
+				conn->send_wscale = MIN(conn->recv_options.window,
+							NET_TCP_MAX_WSCALE);
+			} else {
+				conn->recv_wscale = 0;
+			}
+#endif
+#ifdef CONFIG_NET_TCP_TIMESTAMPS
+			conn->ts_enabled = conn->recv_options.ts_found;
+			if (conn->ts_enabled) {
+				conn->ts_recent = conn->recv_options.tsval;
+			}
+#endif
 			conn_ack(conn, th_seq(th) + 1);
 			if (len) {
 				verdict = tcp_data_get(conn, pkt, &len);
@@ -2488,6 +3202,12 @@ next_state:
 			break;
 		}
 
+#ifdef CONFIG_NET_TCP_SACK
+		if (th && FL(&fl, &, ACK)) {
+			tcp_sack_update(conn, th_ack(th));
+		}
+#endif
+
 #ifdef CONFIG_NET_TCP_FAST_RETRANSMIT
 		if (th && (net_tcp_seq_cmp(th_ack(th), conn->seq) == 0)) {
 			/* Only if there is pending data, increment the duplicate ack count */
@@ -3241,6 +3961,8 @@ int net_tcp_connect(struct net_context *context,
 		ret = -EPROTONOSUPPORT;
 	}
 
+	tcp_conn_rehash(conn);
+
 	if (!(IS_ENABLED(CONFIG_NET_TEST_PROTOCOL) ||
 	      IS_ENABLED(CONFIG_NET_TEST))) {
 		conn->seq = tcp_init_isn(&conn->src.sa, &conn->dst.sa);
@@ -3407,13 +4129,116 @@ int net_tcp_finalize(struct net_pkt *pkt)
 
 	tcp_hdr->chksum = 0U;
 
-	if (net_if_need_calc_tx_checksum(net_pkt_iface(pkt))) {
+	/* The checksum of each segment of a super-segment is computed when
+	 * it is split.
+	 */
+	if (net_if_need_calc_tx_checksum(net_pkt_iface(pkt)) &&
+	    net_pkt_gso_size(pkt) == 0U) {
 		tcp_hdr->chksum = net_calc_chksum_tcp(pkt);
 	}
 
 	return net_pkt_set_data(pkt, &tcp_access);
 }
 
+#if defined(CONFIG_NET_TCP_GSO)
+static struct net_pkt *tcp_gso_segment(struct net_pkt *pkt, size_t hdr_len,
+				       size_t offset, size_t len, bool last)
+{
+	struct net_pkt *seg;
+	struct tcphdr *th;
+	uint8_t flags;
+
+	seg = net_pkt_clone_head(pkt, hdr_len, hdr_len + len, K_NO_WAIT);
+	if (!seg) {
+		return NULL;
+	}
+
+	net_pkt_set_gso_size(seg, 0U);
+
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+
+	if (net_pkt_skip(pkt, hdr_len + offset) ||
+	    net_pkt_copy(seg, pkt, len)) {
+		goto fail;
+	}
+
+	th = th_get(seg);
+	if (!th) {
+		goto fail;
+	}
+
+	UNALIGNED_PUT(htonl(th_seq(th) + offset), &th->th_seq);
+
+	/* Only the last segment pushes the data */
+	if (!last) {
+		flags = th_flags(th) & ~PSH;
+		UNALIGNED_PUT(flags, &th->th_flags);
+	}
+
+	if (tcp_finalize_pkt(seg) < 0) {
+		goto fail;
+	}
+
+	return seg;
+fail:
+	net_pkt_unref(seg);
+	return NULL;
+}
+
+int net_tcp_gso_send(struct net_if *iface, struct net_pkt *pkt)
+{
+	size_t mss = net_pkt_gso_size(pkt);
+	size_t hdr_len, data_len, offset, len;
+	struct net_pkt *seg;
+	struct tcphdr *th;
+	int sent = 0;
+	int ret;
+
+	th = th_get(pkt);
+	if (!th) {
+		return -ENOBUFS;
+	}
+
+	hdr_len = net_pkt_ip_hdr_len(pkt) + net_pkt_ip_opts_len(pkt) +
+		  th_off(th) * 4U;
+	data_len = net_pkt_get_len(pkt) - hdr_len;
+	if (data_len <= mss) {
+		net_pkt_set_gso_size(pkt, 0U);
+		return net_if_l2(iface)->send(iface, pkt);
+	}
+
+	for (offset = 0; offset < data_len; offset += len) {
+		len = MIN(mss, data_len - offset);
+
+		seg = tcp_gso_segment(pkt, hdr_len, offset, len,
+				      offset + len == data_len);
+		if (!seg) {
+			ret = -ENOBUFS;
+			goto out;
+		}
+
+		ret = net_if_l2(iface)->send(iface, seg);
+		if (ret < 0) {
+			net_pkt_unref(seg);
+			goto out;
+		}
+
+		sent += ret;
+	}
+
+out:
+	/* Segments that could not be sent are retransmitted by TCP */
+	if (sent == 0) {
+		return ret;
+	}
+
+	net_pkt_unref(pkt);
+
+	return sent;
+}
+#endif /* CONFIG_NET_TCP_GSO */
+
 struct net_tcp_hdr *net_tcp_input(struct net_pkt *pkt,
 				  struct net_pkt_data_access *tcp_access)
 {
@@ -3457,6 +4282,7 @@ static enum net_verdict tcp_input(struct net_conn *net_conn,
 			conn = context->tcp;
 			tcp_endpoint_set(&conn->dst, pkt, TCP_EP_SRC);
 			tcp_endpoint_set(&conn->src, pkt, TCP_EP_DST);
+			tcp_conn_rehash(conn);
 			/* Make an extra reference, the sanity check suite
 			 * will delete the connection explicitly
 			 */
@@ -3579,6 +4405,7 @@ enum net_verdict tp_input(struct net_conn *net_conn,
 				conn = context->tcp;
 				tcp_endpoint_set(&conn->dst, pkt, TCP_EP_SRC);
 				tcp_endpoint_set(&conn->src, pkt, TCP_EP_DST);
+				tcp_conn_rehash(conn);
 				conn->iface = pkt->iface;
 				tcp_conn_ref(conn);
 			}
@@ -3773,6 +4600,9 @@ int net_tcp_set_option(struct net_context *context,
 	case TCP_OPT_NODELAY:
 		ret = set_tcp_nodelay(conn, value, len);
 		break;
+	case TCP_OPT_CONGESTION:
+		ret = set_tcp_congestion(conn, value, len);
+		break;
 	}
 
 	k_mutex_unlock(&conn->lock);
@@ -3798,6 +4628,9 @@ int net_tcp_get_option(struct net_context *context,
 	case TCP_OPT_NODELAY:
 		ret = get_tcp_nodelay(conn, value, len);
 		break;
+	case TCP_OPT_CONGESTION:
+		ret = get_tcp_congestion(conn, value, len);
+		break;
 	}
 
 	k_mutex_unlock(&conn->lock);
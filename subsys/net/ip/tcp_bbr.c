@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Simplified BBR congestion control.
+ *
+ * The bottleneck bandwidth and the minimum round trip time are measured
+ * once per round trip, by timing how long it takes for the data in flight
+ * at the start of a sample to be acknowledged. The congestion window is
+ * grown exponentially until the bandwidth stops increasing, and is then
+ * kept at twice the estimated bandwidth delay product. As there is no
+ * packet pacing in the stack, the pacing gain cycles of BBR are not
+ * implemented.
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(net_tcp, CONFIG_NET_TCP_LOG_LEVEL);
+
+#include <zephyr/kernel.h>
+#include "tcp_internal.h"
+
+/* Congestion window gain over the bandwidth delay product */
+#define BBR_CWND_GAIN 2
+/* Smallest congestion window, in MSS */
+#define BBR_MIN_CWND 4
+/* Bandwidth samples are kept for this many rounds */
+#define BBR_BW_ROUNDS 10
+/* Minimum round trip time samples are kept for this long, in ms */
+#define BBR_MIN_RTT_MS 10000
+/* Rounds without 25% bandwidth growth before leaving startup */
+#define BBR_FULL_BW_ROUNDS 3
+
+static void tcp_bbr_log(struct tcp *conn, char *step)
+{
+	NET_DBG("conn: %p, ca %s, cwnd=%d, btl_bw=%u, min_rtt=%u, full=%d",
+		conn, step, conn->ca.cwnd, conn->ca.bbr.btl_bw,
+		conn->ca.bbr.min_rtt, conn->ca.bbr.filled_pipe);
+}
+
+static void tcp_bbr_init(struct tcp *conn)
+{
+	conn->ca.bbr = (struct tcp_bbr_state) {
+		.min_rtt = UINT32_MAX,
+	};
+	conn->ca.cwnd = conn_mss(conn) * TCP_CONGESTION_INITIAL_WIN;
+	conn->ca.ssthresh = NET_TCP_MAX_WIN;
+	conn->ca.pending_fast_retransmit_bytes = 0;
+	tcp_bbr_log(conn, "init");
+}
+
+static uint32_t tcp_bbr_min_cwnd(struct tcp *conn)
+{
+	return conn_mss(conn) * BBR_MIN_CWND;
+}
+
+/* Losses are not taken as a congestion signal, only the data still in
+ * flight is kept going.
+ */
+static void tcp_bbr_fast_retransmit(struct tcp *conn)
+{
+	conn->ca.cwnd = MIN(MAX(conn->unacked_len, tcp_bbr_min_cwnd(conn)),
+			    NET_TCP_MAX_WIN);
+	tcp_bbr_log(conn, "fast_retransmit");
+}
+
+static void tcp_bbr_timeout(struct tcp *conn)
+{
+	/* Retransmitted data gives no valid sample */
+	conn->ca.bbr.sampling = false;
+	conn->ca.cwnd = conn_mss(conn);
+	tcp_bbr_log(conn, "timeout");
+}
+
+static void tcp_bbr_dup_ack(struct tcp *conn)
+{
+	ARG_UNUSED(conn);
+}
+
+static void tcp_bbr_sample_start(struct tcp *conn, uint32_t now)
+{
+	struct tcp_bbr_state *bbr = &conn->ca.bbr;
+
+	bbr->sample_seq = conn->seq + conn->unacked_len;
+	bbr->sample_start = now;
+	bbr->delivered = 0;
+	bbr->sampling = true;
+}
+
+static void tcp_bbr_sample_end(struct tcp *conn, uint32_t now)
+{
+	struct tcp_bbr_state *bbr = &conn->ca.bbr;
+	uint32_t rtt = MAX(now - bbr->sample_start, 1);
+	uint32_t bw = (uint64_t)bbr->delivered * MSEC_PER_SEC / rtt;
+
+	bbr->round++;
+
+	if (rtt <= bbr->min_rtt ||
+	    (now - bbr->min_rtt_stamp) > BBR_MIN_RTT_MS) {
+		bbr->min_rtt = rtt;
+		bbr->min_rtt_stamp = now;
+	}
+
+	if (bw >= bbr->btl_bw ||
+	    (uint16_t)(bbr->round - bbr->btl_bw_round) > BBR_BW_ROUNDS) {
+		bbr->btl_bw = bw;
+		bbr->btl_bw_round = bbr->round;
+	}
+
+	if (!bbr->filled_pipe) {
+		if (bw >= bbr->full_bw + bbr->full_bw / 4) {
+			bbr->full_bw = bw;
+			bbr->full_bw_cnt = 0;
+		} else if (++bbr->full_bw_cnt >= BBR_FULL_BW_ROUNDS) {
+			bbr->filled_pipe = true;
+		}
+	}
+}
+
+static void tcp_bbr_pkts_acked(struct tcp *conn, uint32_t acked_len)
+{
+	struct tcp_bbr_state *bbr = &conn->ca.bbr;
+	uint32_t now = k_uptime_get_32();
+	uint64_t cwnd;
+
+	if (bbr->sampling) {
+		bbr->delivered += acked_len;
+
+		if (net_tcp_seq_cmp(conn->seq + acked_len, bbr->sample_seq) >= 0) {
+			tcp_bbr_sample_end(conn, now);
+			bbr->sampling = false;
+		}
+	}
+
+	if (!bbr->sampling) {
+		tcp_bbr_sample_start(conn, now);
+	}
+
+	if (!bbr->filled_pipe || bbr->min_rtt == UINT32_MAX) {
+		cwnd = conn->ca.cwnd + acked_len;
+	} else {
+		cwnd = (uint64_t)bbr->btl_bw * bbr->min_rtt * BBR_CWND_GAIN /
+		       MSEC_PER_SEC;
+		cwnd = MAX(cwnd, tcp_bbr_min_cwnd(conn));
+	}
+
+	conn->ca.cwnd = MIN(cwnd, NET_TCP_MAX_WIN);
+	tcp_bbr_log(conn, "pkts_acked");
+}
+
+STRUCT_SECTION_ITERABLE(tcp_ca_ops, tcp_ca_bbr) = {
+	.name = "bbr",
+	.init = tcp_bbr_init,
+	.fast_retransmit = tcp_bbr_fast_retransmit,
+	.timeout = tcp_bbr_timeout,
+	.dup_ack = tcp_bbr_dup_ack,
+	.pkts_acked = tcp_bbr_pkts_acked,
+};
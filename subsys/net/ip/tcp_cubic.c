@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* CUBIC congestion control according to RFC8312 */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(net_tcp, CONFIG_NET_TCP_LOG_LEVEL);
+
+#include <zephyr/kernel.h>
+#include "tcp_internal.h"
+
+/* Multiplicative decrease factor beta = 0.7 and C = 0.4, scaled by 10 */
+#define CUBIC_BETA 7
+#define CUBIC_C 4
+
+/* Growth is not computed further away than this from K, in ms */
+#define CUBIC_MAX_DELTA 100000
+
+static void tcp_cubic_log(struct tcp *conn, char *step)
+{
+	NET_DBG("conn: %p, ca %s, cwnd=%d, ssthres=%d, w_max=%d, k=%u",
+		conn, step, conn->ca.cwnd, conn->ca.ssthresh,
+		conn->ca.cubic.w_max, conn->ca.cubic.k);
+}
+
+static uint32_t cubic_root(uint64_t a)
+{
+	uint64_t y = 0;
+
+	for (int s = 63; s >= 0; s -= 3) {
+		y <<= 1;
+		if ((3 * y * (y + 1) + 1) <= (a >> s)) {
+			a -= (3 * y * (y + 1) + 1) << s;
+			y++;
+		}
+	}
+
+	return (uint32_t)y;
+}
+
+static void tcp_cubic_reduce(struct tcp *conn)
+{
+	uint16_t mss = conn_mss(conn);
+
+	/* Fast convergence: release bandwidth to new flows */
+	if (conn->ca.cwnd < conn->ca.cubic.w_max) {
+		conn->ca.cubic.w_max = conn->ca.cwnd * (10 + CUBIC_BETA) / 20;
+	} else {
+		conn->ca.cubic.w_max = conn->ca.cwnd;
+	}
+
+	conn->ca.ssthresh = MAX(mss * 2, conn->ca.cwnd * CUBIC_BETA / 10);
+	conn->ca.cubic.epoch_start = 0;
+}
+
+static void tcp_cubic_init(struct tcp *conn)
+{
+	conn->ca.cwnd = conn_mss(conn) * TCP_CONGESTION_INITIAL_WIN;
+	conn->ca.ssthresh = conn_mss(conn) * TCP_CONGESTION_INITIAL_SSTHRESH;
+	conn->ca.pending_fast_retransmit_bytes = 0;
+	conn->ca.cubic.epoch_start = 0;
+	conn->ca.cubic.w_max = 0;
+	tcp_cubic_log(conn, "init");
+}
+
+static void tcp_cubic_fast_retransmit(struct tcp *conn)
+{
+	if (conn->ca.pending_fast_retransmit_bytes == 0) {
+		tcp_cubic_reduce(conn);
+		conn->ca.cwnd = conn->ca.ssthresh;
+		conn->ca.pending_fast_retransmit_bytes = conn->unacked_len;
+		tcp_cubic_log(conn, "fast_retransmit");
+	}
+}
+
+static void tcp_cubic_timeout(struct tcp *conn)
+{
+	tcp_cubic_reduce(conn);
+	conn->ca.cwnd = conn_mss(conn);
+	conn->ca.pending_fast_retransmit_bytes = 0;
+	tcp_cubic_log(conn, "timeout");
+}
+
+static void tcp_cubic_dup_ack(struct tcp *conn)
+{
+	ARG_UNUSED(conn);
+}
+
+static void tcp_cubic_epoch_start(struct tcp *conn, uint32_t now)
+{
+	struct tcp_cubic_state *cubic = &conn->ca.cubic;
+	uint16_t mss = conn_mss(conn);
+
+	/* Zero means not started */
+	cubic->epoch_start = MAX(now, 1);
+
+	if (conn->ca.cwnd < cubic->w_max) {
+		/* K = cbrt((w_max - cwnd) / C), in ms with the window in bytes */
+		cubic->k = cubic_root((uint64_t)(cubic->w_max - conn->ca.cwnd) *
+				      (10000000000ULL / CUBIC_C) / mss);
+		cubic->origin = cubic->w_max;
+	} else {
+		cubic->k = 0;
+		cubic->origin = conn->ca.cwnd;
+	}
+}
+
+static uint32_t tcp_cubic_target(struct tcp *conn, uint32_t now)
+{
+	struct tcp_cubic_state *cubic = &conn->ca.cubic;
+	int64_t delta = (int64_t)(now - cubic->epoch_start) - cubic->k;
+	int64_t target;
+
+	delta = CLAMP(delta, -CUBIC_MAX_DELTA, CUBIC_MAX_DELTA);
+
+	/* W(t) = C * (t - K)^3 + origin, with t - K in ms */
+	target = cubic->origin +
+		 (delta * delta * delta / 1000) * CUBIC_C * conn_mss(conn) /
+		 10000000;
+
+	return (uint32_t)CLAMP(target, conn_mss(conn), NET_TCP_MAX_WIN);
+}
+
+static void tcp_cubic_pkts_acked(struct tcp *conn, uint32_t acked_len)
+{
+	uint32_t now = k_uptime_get_32();
+	uint32_t cwnd = conn->ca.cwnd;
+	uint32_t win_inc = MIN(acked_len, conn_mss(conn));
+	uint32_t target;
+	uint32_t inc;
+
+	if (conn->ca.pending_fast_retransmit_bytes != 0) {
+		/* Still in fast recovery mode */
+		if (conn->ca.pending_fast_retransmit_bytes <= acked_len) {
+			conn->ca.pending_fast_retransmit_bytes = 0;
+		} else {
+			conn->ca.pending_fast_retransmit_bytes -= acked_len;
+		}
+	} else if (cwnd < conn->ca.ssthresh) {
+		cwnd += win_inc;
+	} else {
+		if (conn->ca.cubic.epoch_start == 0) {
+			tcp_cubic_epoch_start(conn, now);
+		}
+
+		target = tcp_cubic_target(conn, now);
+
+		/* Grow at least as fast as New Reno would */
+		inc = DIV_ROUND_UP(win_inc * win_inc, cwnd);
+		if (target > cwnd) {
+			inc = MAX(inc, (target - cwnd) * win_inc / cwnd);
+		}
+
+		cwnd += inc;
+	}
+
+	conn->ca.cwnd = MIN(cwnd, NET_TCP_MAX_WIN);
+	tcp_cubic_log(conn, "pkts_acked");
+}
+
+STRUCT_SECTION_ITERABLE(tcp_ca_ops, tcp_ca_cubic) = {
+	.name = "cubic",
+	.init = tcp_cubic_init,
+	.fast_retransmit = tcp_cubic_fast_retransmit,
+	.timeout = tcp_cubic_timeout,
+	.dup_ack = tcp_cubic_dup_ack,
+	.pkts_acked = tcp_cubic_pkts_acked,
+};
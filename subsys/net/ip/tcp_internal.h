@@ -32,6 +32,7 @@ extern "C" {
 
 enum tcp_conn_option {
 	TCP_OPT_NODELAY	= 1,
+	TCP_OPT_CONGESTION = 2,
 };
 
 /**
@@ -258,6 +259,31 @@ static inline int net_tcp_finalize(struct net_pkt *pkt)
 }
 #endif
 
+/**
+ * @brief Split a TCP super-segment and send the segments
+ *
+ * @details The segments carry net_pkt_gso_size() bytes of data each and
+ *          are sent to the L2 of @a iface. This is used when the network
+ *          interface cannot split super-segments itself.
+ *
+ * @param iface Network interface to send the segments to
+ * @param pkt Network packet holding the super-segment, released if any
+ *            segment was sent
+ *
+ * @return Number of bytes sent, negative errno otherwise.
+ */
+#if defined(CONFIG_NET_TCP_GSO)
+int net_tcp_gso_send(struct net_if *iface, struct net_pkt *pkt);
+#else
+static inline int net_tcp_gso_send(struct net_if *iface, struct net_pkt *pkt)
+{
+	ARG_UNUSED(iface);
+	ARG_UNUSED(pkt);
+
+	return -ENOTSUP;
+}
+#endif
+
 /**
  * @brief Get pointer to TCP header in net_pkt
  *
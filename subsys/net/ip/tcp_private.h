@@ -129,7 +129,7 @@
 #define conn_send_data_dump(_conn)                                             \
 	({                                                                     \
 		NET_DBG("conn: %p total=%zd, unacked_len=%d, "                 \
-			"send_win=%hu, mss=%hu",                               \
+			"send_win=%u, mss=%hu",                               \
 			(_conn), net_pkt_get_len((_conn)->send_data),          \
 			_conn->unacked_len, _conn->send_win,                   \
 			(uint16_t)conn_mss((_conn)));                          \
@@ -209,31 +209,126 @@ union tcp_endpoint {
 #define NET_TCP_NOP_OPT          1
 #define NET_TCP_MSS_OPT          2
 #define NET_TCP_WINDOW_SCALE_OPT 3
+#define NET_TCP_SACK_PERM_OPT    4
+#define NET_TCP_SACK_OPT         5
+#define NET_TCP_TIMESTAMP_OPT    8
 
 /* TCP Option sizes */
 #define NET_TCP_END_SIZE          1
 #define NET_TCP_NOP_SIZE          1
 #define NET_TCP_MSS_SIZE          4
 #define NET_TCP_WINDOW_SCALE_SIZE 3
+#define NET_TCP_SACK_PERM_SIZE    2
+#define NET_TCP_SACK_BLOCK_SIZE   8
+#define NET_TCP_TIMESTAMP_SIZE    10
+
+/* Largest window scale shift, RFC 7323 ch 2.3 */
+#define NET_TCP_MAX_WSCALE        14
+
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+#define NET_TCP_MAX_WIN ((uint32_t)UINT16_MAX << NET_TCP_MAX_WSCALE)
+#else
+#define NET_TCP_MAX_WIN UINT16_MAX
+#endif
+
+/* As many blocks as fit in the 40 bytes of options */
+#define NET_TCP_SACK_MAX_BLOCKS   4
+
+struct tcp_sack_block {
+	uint32_t left;
+	uint32_t right;
+};
 
 struct tcp_options {
 	uint16_t mss;
 	uint16_t window;
+#ifdef CONFIG_NET_TCP_SACK
+	struct tcp_sack_block sack[NET_TCP_SACK_MAX_BLOCKS];
+	uint8_t sack_cnt;
+#endif
+#ifdef CONFIG_NET_TCP_TIMESTAMPS
+	uint32_t tsval;
+	uint32_t tsecr;
+#endif
 	bool mss_found : 1;
 	bool wnd_found : 1;
+#ifdef CONFIG_NET_TCP_SACK
+	bool sack_perm_found : 1;
+#endif
+#ifdef CONFIG_NET_TCP_TIMESTAMPS
+	bool ts_found : 1;
+#endif
 };
 
 #ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
 
+/* Define the number of MSS sections the congestion window is initialized at */
+#define TCP_CONGESTION_INITIAL_WIN 1
+#define TCP_CONGESTION_INITIAL_SSTHRESH 3
+
+/* Longest congestion control algorithm name, including the terminator */
+#define TCP_CA_NAME_MAX 16
+
+struct tcp;
+
+/* Congestion control algorithm, registered with STRUCT_SECTION_ITERABLE()
+ * and selected per connection with the TCP_CONGESTION socket option.
+ * All the callbacks are called with the connection lock held.
+ */
+struct tcp_ca_ops {
+	const char *name;
+	void (*init)(struct tcp *conn);
+	void (*fast_retransmit)(struct tcp *conn);
+	void (*timeout)(struct tcp *conn);
+	void (*dup_ack)(struct tcp *conn);
+	void (*pkts_acked)(struct tcp *conn, uint32_t acked_len);
+};
+
+#ifdef CONFIG_NET_TCP_CA_CUBIC
+struct tcp_cubic_state {
+	uint32_t epoch_start; /* start of the growth epoch, 0 when not started */
+	uint32_t k;           /* time to get back to w_max, in ms */
+	uint32_t w_max;       /* window before the last reduction */
+	uint32_t origin;      /* window the cubic function is centered at */
+};
+#endif
+
+#ifdef CONFIG_NET_TCP_CA_BBR
+struct tcp_bbr_state {
+	uint32_t btl_bw;        /* bottleneck bandwidth estimate, bytes/s */
+	uint32_t full_bw;       /* bandwidth at the last startup growth */
+	uint32_t min_rtt;       /* minimum round trip time, in ms */
+	uint32_t min_rtt_stamp; /* when min_rtt was measured */
+	uint32_t sample_seq;    /* sequence ending the ongoing sample */
+	uint32_t sample_start;  /* when the ongoing sample was started */
+	uint32_t delivered;     /* bytes acknowledged in the ongoing sample */
+	uint16_t round;         /* number of samples taken */
+	uint16_t btl_bw_round;  /* round btl_bw was measured at */
+	uint8_t full_bw_cnt;    /* rounds without bandwidth growth */
+	bool filled_pipe : 1;
+	bool sampling : 1;
+};
+#endif
+
 struct tcp_collision_avoidance_reno {
-	uint16_t cwnd;
-	uint16_t ssthresh;
-	uint16_t pending_fast_retransmit_bytes;
+	uint32_t cwnd;
+	uint32_t ssthresh;
+	uint32_t pending_fast_retransmit_bytes;
+	/* Per algorithm state */
+	union {
+#ifdef CONFIG_NET_TCP_CA_CUBIC
+		struct tcp_cubic_state cubic;
+#endif
+#ifdef CONFIG_NET_TCP_CA_BBR
+		struct tcp_bbr_state bbr;
+#endif
+	};
 };
 #endif
 
 struct tcp { /* TCP connection */
 	sys_snode_t next;
+	sys_snode_t hash_next; /* node in the lookup hash bucket */
 	struct net_context *context;
 	struct net_pkt *send_data;
 	struct net_pkt *queue_recv_data;
@@ -276,25 +371,46 @@ struct tcp { /* TCP connection */
 	enum tcp_data_mode data_mode;
 	uint32_t seq;
 	uint32_t ack;
-	uint16_t recv_win_max;
-	uint16_t recv_win;
-	uint16_t send_win_max;
-	uint16_t send_win;
+	uint32_t recv_win_max;
+	uint32_t recv_win;
+	uint32_t send_win_max;
+	uint32_t send_win;
+#ifdef CONFIG_NET_TCP_TIMESTAMPS
+	uint32_t ts_offset; /* random offset of the sent timestamps */
+	uint32_t ts_recent; /* timestamp to echo to the peer */
+#endif
 #ifdef CONFIG_NET_TCP_RANDOMIZED_RTO
 	uint16_t rto;
 #endif
 #ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
 	struct tcp_collision_avoidance_reno ca;
+	const struct tcp_ca_ops *ca_ops;
+#endif
+#ifdef CONFIG_NET_TCP_SACK
+	/* Data acknowledged selectively by the peer, sorted by sequence */
+	struct tcp_sack_block sacked[NET_TCP_SACK_MAX_BLOCKS];
+	uint8_t sacked_cnt;
 #endif
 	uint8_t send_data_retries;
 #ifdef CONFIG_NET_TCP_FAST_RETRANSMIT
 	uint8_t dup_ack_cnt;
 #endif
 	uint8_t zwp_retries;
+	uint8_t hash_bucket;
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+	uint8_t recv_wscale; /* shift of the advertised receive window */
+	uint8_t send_wscale; /* shift of the window advertised by the peer */
+#endif
 	bool in_retransmission : 1;
 	bool in_connect : 1;
 	bool in_close : 1;
 	bool tcp_nodelay : 1;
+#ifdef CONFIG_NET_TCP_SACK
+	bool sack_enabled : 1;
+#endif
+#ifdef CONFIG_NET_TCP_TIMESTAMPS
+	bool ts_enabled : 1;
+#endif
 };
 
 #define _flags(_fl, _op, _mask, _cond)					\
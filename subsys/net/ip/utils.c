@@ -505,6 +505,16 @@ static uint16_t offset_based_swap8(const uint8_t *data)
 	}
 }
 
+#if defined(CONFIG_64BIT)
+/* One's complement addition of 64-bit words, with end-around carry */
+static inline uint64_t chksum_add64(uint64_t sum, uint64_t data)
+{
+	sum += data;
+
+	return sum + (sum < data);
+}
+#endif
+
 /* Word based checksum calculation based on:
  * https://blogs.igalia.com/dpino/2018/06/14/fast-checksum-computation/
  * It’s not necessary to add octets as 16-bit words. Due to the associative property of addition,
@@ -516,6 +526,9 @@ uint16_t calc_chksum(uint16_t sum_in, const uint8_t *data, size_t len)
 {
 	uint64_t sum;
 	uint32_t *p;
+#if defined(CONFIG_64BIT)
+	uint64_t *q;
+#endif
 	size_t i = 0;
 	size_t pending = len;
 	int odd_start = ((uintptr_t)data & 0x01);
@@ -540,6 +553,35 @@ uint16_t calc_chksum(uint16_t sum_in, const uint8_t *data, size_t len)
 		sum = sum + *((uint16_t *)data);
 		data += sizeof(uint16_t);
 	}
+
+#if defined(CONFIG_64BIT)
+	/* On 64-bit CPUs, sum 64-bit words and add the carries back as we go */
+	if ((((uintptr_t)data & 0x04) != 0) && (pending >= sizeof(uint32_t))) {
+		pending -= sizeof(uint32_t);
+		sum = sum + *((uint32_t *)data);
+		data += sizeof(uint32_t);
+	}
+
+	q = (uint64_t *)data;
+
+	while (pending >= sizeof(uint64_t) * 4) {
+		pending -= sizeof(uint64_t) * 4;
+		sum = chksum_add64(sum, q[0]);
+		sum = chksum_add64(sum, q[1]);
+		sum = chksum_add64(sum, q[2]);
+		sum = chksum_add64(sum, q[3]);
+		q += 4;
+	}
+	while (pending >= sizeof(uint64_t)) {
+		pending -= sizeof(uint64_t);
+		sum = chksum_add64(sum, *q++);
+	}
+
+	/* Make room for the remaining 32-bit words */
+	sum = (sum & 0xffffffff) + (sum >> 32);
+	data = (uint8_t *)q;
+#endif
+
 	p = (uint32_t *)data;
 
 	/* Do loop unrolling for the very large data sets */
@@ -34,6 +34,124 @@ static struct k_work_delayable arp_request_timer;
 
 static struct k_mutex arp_mutex;
 
+static struct {
+	atomic_t hits;
+	atomic_t misses;
+	atomic_t evictions;
+	atomic_t pending_drops;
+} arp_stats;
+
+#if defined(CONFIG_NET_ARP_HASH)
+/* Table entries are also linked into a bucket selected by interface and
+ * address. Lookups walk the bucket without holding arp_mutex and are
+ * validated against arp_seq, which is odd while the table is modified.
+ */
+#define ARP_LOOKUP_RETRIES 3
+
+static sys_slist_t arp_hash[CONFIG_NET_ARP_HASH_BUCKETS];
+static atomic_t arp_seq;
+
+static inline sys_slist_t *arp_hash_bucket(struct net_if *iface,
+					   struct in_addr *addr)
+{
+	uint32_t hash = UNALIGNED_GET(&addr->s_addr) ^
+			(uint32_t)((uintptr_t)iface >> 2);
+
+	/* Fibonacci hashing, the low bits of an address vary the most */
+	hash *= 0x9e3779b1U;
+
+	return &arp_hash[(hash >> 16) % CONFIG_NET_ARP_HASH_BUCKETS];
+}
+#endif /* CONFIG_NET_ARP_HASH */
+
+static inline void arp_write_begin(void)
+{
+#if defined(CONFIG_NET_ARP_HASH)
+	atomic_inc(&arp_seq);
+#endif
+}
+
+static inline void arp_write_end(void)
+{
+#if defined(CONFIG_NET_ARP_HASH)
+	atomic_inc(&arp_seq);
+#endif
+}
+
+/* Must be called with arp_mutex held, like all the table modifications */
+static void arp_table_add(struct arp_entry *entry)
+{
+	entry->last_used = k_uptime_get_32();
+
+	arp_write_begin();
+
+	sys_slist_prepend(&arp_table, &entry->node);
+#if defined(CONFIG_NET_ARP_HASH)
+	sys_slist_prepend(arp_hash_bucket(entry->iface, &entry->ip),
+			  &entry->hash_node);
+#endif
+
+	arp_write_end();
+}
+
+static void arp_table_remove(struct arp_entry *entry, sys_snode_t *prev)
+{
+	arp_write_begin();
+
+	sys_slist_remove(&arp_table, prev, &entry->node);
+#if defined(CONFIG_NET_ARP_HASH)
+	sys_slist_find_and_remove(arp_hash_bucket(entry->iface, &entry->ip),
+				  &entry->hash_node);
+#endif
+
+	arp_write_end();
+}
+
+static void arp_table_set_eth(struct arp_entry *entry,
+			      struct net_eth_addr *hwaddr)
+{
+	arp_write_begin();
+	memcpy(&entry->eth, hwaddr, sizeof(struct net_eth_addr));
+	arp_write_end();
+}
+
+#if CONFIG_NET_ARP_PENDING_MAX > 0
+/* The queue length is tracked by the entry, a k_fifo cannot be counted
+ * without walking it.
+ */
+static inline bool arp_pending_queue_full(struct arp_entry *entry)
+{
+	return entry->pending_count >= CONFIG_NET_ARP_PENDING_MAX;
+}
+
+static inline void arp_pending_queued(struct arp_entry *entry)
+{
+	entry->pending_count++;
+}
+
+static inline void arp_pending_flushed(struct arp_entry *entry)
+{
+	entry->pending_count = 0U;
+}
+#else
+static inline bool arp_pending_queue_full(struct arp_entry *entry)
+{
+	ARG_UNUSED(entry);
+
+	return false;
+}
+
+static inline void arp_pending_queued(struct arp_entry *entry)
+{
+	ARG_UNUSED(entry);
+}
+
+static inline void arp_pending_flushed(struct arp_entry *entry)
+{
+	ARG_UNUSED(entry);
+}
+#endif
+
 static void arp_entry_cleanup(struct arp_entry *entry, bool pending)
 {
 	NET_DBG("%p", entry);
@@ -48,6 +166,8 @@ static void arp_entry_cleanup(struct arp_entry *entry, bool pending)
 				atomic_get(&pkt->atomic_ref) - 1);
 			net_pkt_unref(pkt);
 		}
+
+		arp_pending_flushed(entry);
 	}
 
 	entry->iface = NULL;
@@ -80,16 +200,89 @@ static struct arp_entry *arp_entry_find(sys_slist_t *list,
 	return NULL;
 }
 
+#if defined(CONFIG_NET_ARP_HASH)
+static struct arp_entry *arp_entry_find_hashed(struct net_if *iface,
+					       struct in_addr *dst)
+{
+	struct arp_entry *entry;
+	int steps = 0;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(arp_hash_bucket(iface, dst), entry,
+				     hash_node) {
+		if (entry->iface == iface &&
+		    net_ipv4_addr_cmp(&entry->ip, dst)) {
+			return entry;
+		}
+
+		/* A lockless walk can follow an entry that is moving to
+		 * another bucket, bound it and let the sequence check
+		 * discard the result.
+		 */
+		if (++steps >= CONFIG_NET_ARP_TABLE_SIZE) {
+			break;
+		}
+	}
+
+	return NULL;
+}
+
+/* Look up a table entry without arp_mutex. NULL means the caller must
+ * take the mutex, either because the address is not resolved or because
+ * the table was being modified.
+ */
+static struct arp_entry *arp_entry_lookup(struct net_if *iface,
+					  struct in_addr *dst)
+{
+	struct arp_entry *entry;
+	atomic_val_t seq;
+	int i;
+
+	for (i = 0; i < ARP_LOOKUP_RETRIES; i++) {
+		seq = atomic_get(&arp_seq);
+		if (seq & 1) {
+			/* Do not spin on a writer that may have been
+			 * preempted by this thread.
+			 */
+			break;
+		}
+
+		entry = arp_entry_find_hashed(iface, dst);
+
+		if (atomic_get(&arp_seq) == seq) {
+			if (entry) {
+				entry->last_used = k_uptime_get_32();
+			}
+
+			return entry;
+		}
+	}
+
+	return NULL;
+}
+#endif /* CONFIG_NET_ARP_HASH */
+
 static inline struct arp_entry *arp_entry_find_move_first(struct net_if *iface,
 							  struct in_addr *dst)
 {
-	sys_snode_t *prev = NULL;
 	struct arp_entry *entry;
 
 	NET_DBG("dst %s", net_sprint_ipv4_addr(dst));
 
+#if defined(CONFIG_NET_ARP_HASH)
+	/* Entries are not reordered for the lockless readers, eviction
+	 * uses the time of last use instead.
+	 */
+	entry = arp_entry_find_hashed(iface, dst);
+	if (entry) {
+		entry->last_used = k_uptime_get_32();
+	}
+#else
+	sys_snode_t *prev = NULL;
+
 	entry = arp_entry_find(&arp_table, iface, dst, &prev);
 	if (entry) {
+		entry->last_used = k_uptime_get_32();
+
 		/* Let's assume the target is going to be accessed
 		 * more than once here in a short time frame. So we
 		 * place the entry first in position into the table
@@ -100,6 +293,7 @@ static inline struct arp_entry *arp_entry_find_move_first(struct net_if *iface,
 			sys_slist_prepend(&arp_table, &entry->node);
 		}
 	}
+#endif
 
 	return entry;
 }
@@ -151,20 +345,35 @@ static struct arp_entry *arp_entry_get_free(void)
 
 static struct arp_entry *arp_entry_get_last_from_table(void)
 {
-	sys_snode_t *node;
+	struct arp_entry *entry, *oldest = NULL;
+	sys_snode_t *prev = NULL, *oldest_prev = NULL;
+	uint32_t now = k_uptime_get_32();
 
-	/* We assume last entry is the oldest one,
-	 * so is the preferred one to be taken out.
+	/* The least recently used entry is the preferred one to be taken
+	 * out. Without hashing the table is kept in use order so this is
+	 * the last entry.
 	 */
+	SYS_SLIST_FOR_EACH_CONTAINER(&arp_table, entry, node) {
+		if (!IS_ENABLED(CONFIG_NET_ARP_HASH)) {
+			oldest = entry;
+			oldest_prev = prev;
+		} else if (!oldest ||
+			   now - entry->last_used > now - oldest->last_used) {
+			oldest = entry;
+			oldest_prev = prev;
+		}
 
-	node = sys_slist_peek_tail(&arp_table);
-	if (!node) {
+		prev = &entry->node;
+	}
+
+	if (!oldest) {
 		return NULL;
 	}
 
-	sys_slist_find_and_remove(&arp_table, node);
+	arp_table_remove(oldest, oldest_prev);
+	atomic_inc(&arp_stats.evictions);
 
-	return CONTAINER_OF(node, struct arp_entry, node);
+	return oldest;
 }
 
 
@@ -283,6 +492,7 @@ static inline struct net_pkt *arp_prepare(struct net_if *iface,
 	if (entry) {
 		if (!net_pkt_ipv4_auto(pkt)) {
 			k_fifo_put(&entry->pending_queue, net_pkt_ref(pending));
+			arp_pending_queued(entry);
 		}
 
 		entry->iface = net_pkt_iface(pkt);
@@ -374,6 +584,13 @@ struct net_pkt *net_arp_prepare(struct net_pkt *pkt,
 		addr = request_ip;
 	}
 
+#if defined(CONFIG_NET_ARP_HASH)
+	entry = arp_entry_lookup(net_pkt_iface(pkt), addr);
+	if (entry) {
+		goto found;
+	}
+#endif
+
 	k_mutex_lock(&arp_mutex, K_FOREVER);
 
 	/* If the destination address is already known, we do not need
@@ -383,6 +600,8 @@ struct net_pkt *net_arp_prepare(struct net_pkt *pkt,
 	if (!entry) {
 		struct net_pkt *req;
 
+		atomic_inc(&arp_stats.misses);
+
 		entry = arp_entry_find_pending(net_pkt_iface(pkt), addr);
 		if (!entry) {
 			/* No pending, let's try to get a new entry */
@@ -396,9 +615,19 @@ struct net_pkt *net_arp_prepare(struct net_pkt *pkt,
 			 * in the pending list and if so, resend the request, otherwise just
 			 * append the packet to the request fifo list.
 			 */
+			if (!net_pkt_ipv4_auto(pkt) &&
+			    arp_pending_queue_full(entry)) {
+				NET_DBG("Pending queue of %s full, dropping %p",
+					net_sprint_ipv4_addr(addr), pkt);
+				atomic_inc(&arp_stats.pending_drops);
+				k_mutex_unlock(&arp_mutex);
+				return NULL;
+			}
+
 			if (!net_pkt_ipv4_auto(pkt) &&
 			    k_queue_unique_append(&entry->pending_queue._queue,
 						  net_pkt_ref(pkt))) {
+				arp_pending_queued(entry);
 				k_mutex_unlock(&arp_mutex);
 				return NULL;
 			}
@@ -423,6 +652,11 @@ struct net_pkt *net_arp_prepare(struct net_pkt *pkt,
 
 	k_mutex_unlock(&arp_mutex);
 
+#if defined(CONFIG_NET_ARP_HASH)
+found:
+#endif
+	atomic_inc(&arp_stats.hits);
+
 	net_pkt_lladdr_src(pkt)->addr =
 		(uint8_t *)net_if_get_link_addr(entry->iface)->addr;
 	net_pkt_lladdr_src(pkt)->len = sizeof(struct net_eth_addr);
@@ -453,7 +687,7 @@ static void arp_gratuitous(struct net_if *iface,
 			net_sprint_ll_addr((const uint8_t *)hwaddr,
 					   sizeof(struct net_eth_addr)));
 
-		memcpy(&entry->eth, hwaddr, sizeof(struct net_eth_addr));
+		arp_table_set_eth(entry, hwaddr);
 	}
 }
 
@@ -482,8 +716,7 @@ static void arp_update(struct net_if *iface,
 
 			arp_ent = arp_entry_find(&arp_table, iface, src, &prev);
 			if (arp_ent) {
-				memcpy(&arp_ent->eth, hwaddr,
-				       sizeof(struct net_eth_addr));
+				arp_table_set_eth(arp_ent, hwaddr);
 			} else {
 				/* Add new entry as it was not found and force
 				 * was set.
@@ -499,7 +732,7 @@ static void arp_update(struct net_if *iface,
 					arp_ent->iface = iface;
 					net_ipaddr_copy(&arp_ent->ip, src);
 					memcpy(&arp_ent->eth, hwaddr, sizeof(arp_ent->eth));
-					sys_slist_prepend(&arp_table, &arp_ent->node);
+					arp_table_add(arp_ent);
 				}
 			}
 		}
@@ -511,7 +744,7 @@ static void arp_update(struct net_if *iface,
 	memcpy(&entry->eth, hwaddr, sizeof(struct net_eth_addr));
 
 	/* Inserting entry into the table */
-	sys_slist_prepend(&arp_table, &entry->node);
+	arp_table_add(entry);
 
 	while (!k_fifo_is_empty(&entry->pending_queue)) {
 		pkt = k_fifo_get(&entry->pending_queue, K_FOREVER);
@@ -528,6 +761,8 @@ static void arp_update(struct net_if *iface,
 		net_if_queue_tx(iface, pkt);
 	}
 
+	arp_pending_flushed(entry);
+
 	k_mutex_unlock(&arp_mutex);
 }
 
@@ -726,9 +961,9 @@ void net_arp_clear_cache(struct net_if *iface)
 			continue;
 		}
 
+		arp_table_remove(entry, prev);
 		arp_entry_cleanup(entry, false);
 
-		sys_slist_remove(&arp_table, prev, &entry->node);
 		sys_slist_prepend(&arp_free_entries, &entry->node);
 	}
 
@@ -786,6 +1021,14 @@ int net_arp_foreach(net_arp_cb_t cb, void *user_data)
 	return ret;
 }
 
+void net_arp_stats_get(struct net_arp_stats *stats)
+{
+	stats->hits = atomic_get(&arp_stats.hits);
+	stats->misses = atomic_get(&arp_stats.misses);
+	stats->evictions = atomic_get(&arp_stats.evictions);
+	stats->pending_drops = atomic_get(&arp_stats.pending_drops);
+}
+
 void net_arp_init(void)
 {
 	int i;
@@ -798,6 +1041,12 @@ void net_arp_init(void)
 	sys_slist_init(&arp_pending_entries);
 	sys_slist_init(&arp_table);
 
+#if defined(CONFIG_NET_ARP_HASH)
+	for (i = 0; i < CONFIG_NET_ARP_HASH_BUCKETS; i++) {
+		sys_slist_init(&arp_hash[i]);
+	}
+#endif
+
 	for (i = 0; i < CONFIG_NET_ARP_TABLE_SIZE; i++) {
 		/* Inserting entry as free with initialised packet queue */
 		k_fifo_init(&arp_entries[i].pending_queue);
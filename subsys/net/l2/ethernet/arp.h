@@ -54,11 +54,18 @@ int net_arp_clear_pending(struct net_if *iface,
 
 struct arp_entry {
 	sys_snode_t node;
+#if defined(CONFIG_NET_ARP_HASH)
+	sys_snode_t hash_node;
+#endif
 	uint32_t req_start;
+	uint32_t last_used;
 	struct net_if *iface;
 	struct in_addr ip;
 	struct net_eth_addr eth;
 	struct k_fifo pending_queue;
+#if CONFIG_NET_ARP_PENDING_MAX > 0
+	uint8_t pending_count;
+#endif
 };
 
 typedef void (*net_arp_cb_t)(struct arp_entry *entry,
@@ -68,6 +75,20 @@ int net_arp_foreach(net_arp_cb_t cb, void *user_data);
 void net_arp_clear_cache(struct net_if *iface);
 void net_arp_init(void);
 
+/** ARP cache statistics */
+struct net_arp_stats {
+	/** Lookups resolved from the cache */
+	uint32_t hits;
+	/** Lookups of addresses not in the cache */
+	uint32_t misses;
+	/** Resolved entries reused for another address */
+	uint32_t evictions;
+	/** Packets dropped because their pending queue was full */
+	uint32_t pending_drops;
+};
+
+void net_arp_stats_get(struct net_arp_stats *stats);
+
 /**
  * @}
  */
@@ -14,8 +14,10 @@ LOG_MODULE_REGISTER(net_eth_bridge, CONFIG_NET_ETHERNET_BRIDGE_LOG_LEVEL);
 #include <zephyr/net/ethernet_bridge.h>
 #include <zephyr/sys/iterable_sections.h>
 #include <zephyr/sys/slist.h>
+#include <zephyr/sys/byteorder.h>
 
 #include "bridge.h"
+#include "net_private.h"
 
 extern struct eth_bridge _eth_bridge_list_start[];
 extern struct eth_bridge _eth_bridge_list_end[];
@@ -34,6 +36,136 @@ static void lock_bridge(struct eth_bridge *br)
 	k_mutex_lock(&br->lock, K_FOREVER);
 }
 
+#if ETH_BRIDGE_FDB_SIZE > 0
+#define FDB_AGEING_TIME_MS (CONFIG_NET_ETHERNET_BRIDGE_FDB_AGEING_TIME * MSEC_PER_SEC)
+
+static inline sys_slist_t *fdb_bucket(struct eth_bridge *br, const uint8_t *addr)
+{
+	/* The vendor part of the address does not vary much on a segment */
+	uint32_t hash = sys_get_be24(&addr[3]) ^ (addr[2] << 5);
+
+	return &br->fdb_buckets[hash % ETH_BRIDGE_FDB_SIZE];
+}
+
+static inline bool fdb_expired(struct eth_bridge_fdb_entry *entry, uint32_t now)
+{
+	return now - entry->last_seen >= FDB_AGEING_TIME_MS;
+}
+
+static void fdb_entry_remove(struct eth_bridge *br, struct eth_bridge_fdb_entry *entry)
+{
+	sys_slist_find_and_remove(fdb_bucket(br, entry->addr), &entry->node);
+	entry->iface = NULL;
+}
+
+static struct eth_bridge_fdb_entry *fdb_find(struct eth_bridge *br, const uint8_t *addr,
+					     uint32_t now)
+{
+	struct eth_bridge_fdb_entry *entry;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(fdb_bucket(br, addr), entry, node) {
+		if (memcmp(entry->addr, addr, sizeof(entry->addr)) != 0) {
+			continue;
+		}
+
+		if (fdb_expired(entry, now)) {
+			fdb_entry_remove(br, entry);
+			return NULL;
+		}
+
+		return entry;
+	}
+
+	return NULL;
+}
+
+static void fdb_learn(struct eth_bridge *br, struct net_if *iface, const uint8_t *addr)
+{
+	struct eth_bridge_fdb_entry *entry, *oldest = NULL;
+	uint32_t now = k_uptime_get_32();
+	int i;
+
+	/* Multicast source addresses are invalid, do not learn them */
+	if (addr[0] & 0x01) {
+		return;
+	}
+
+	entry = fdb_find(br, addr, now);
+	if (entry != NULL) {
+		if (entry->iface != iface) {
+			NET_DBG("%s moved to iface %p",
+				net_sprint_ll_addr(addr, sizeof(entry->addr)), iface);
+			entry->iface = iface;
+		}
+
+		entry->last_seen = now;
+		return;
+	}
+
+	/* Take a free entry, or reuse the entry unused for the longest time */
+	for (i = 0; i < ETH_BRIDGE_FDB_SIZE; i++) {
+		entry = &br->fdb[i];
+
+		if (entry->iface == NULL) {
+			oldest = entry;
+			break;
+		}
+
+		if (oldest == NULL || now - entry->last_seen > now - oldest->last_seen) {
+			oldest = entry;
+		}
+	}
+
+	entry = oldest;
+	if (entry->iface != NULL) {
+		fdb_entry_remove(br, entry);
+	}
+
+	memcpy(entry->addr, addr, sizeof(entry->addr));
+	entry->iface = iface;
+	entry->last_seen = now;
+	sys_slist_prepend(fdb_bucket(br, addr), &entry->node);
+
+	NET_DBG("%s learned on iface %p", net_sprint_ll_addr(addr, sizeof(entry->addr)), iface);
+}
+
+static void fdb_flush(struct eth_bridge *br, struct net_if *iface)
+{
+	int i;
+
+	for (i = 0; i < ETH_BRIDGE_FDB_SIZE; i++) {
+		if (br->fdb[i].iface != NULL && (iface == NULL || br->fdb[i].iface == iface)) {
+			fdb_entry_remove(br, &br->fdb[i]);
+		}
+	}
+}
+
+/* Interface a unicast packet must be sent on, NULL to send it on all of them */
+static struct net_if *fdb_lookup(struct eth_bridge *br, const uint8_t *addr)
+{
+	struct eth_bridge_fdb_entry *entry;
+
+	if (addr[0] & 0x01) {
+		return NULL;
+	}
+
+	entry = fdb_find(br, addr, k_uptime_get_32());
+
+	return entry != NULL ? entry->iface : NULL;
+}
+#else
+#define fdb_learn(...)
+#define fdb_flush(...)
+#define fdb_lookup(...) NULL
+#endif /* ETH_BRIDGE_FDB_SIZE > 0 */
+
+void eth_bridge_fdb_flush(struct eth_bridge *br, struct net_if *iface)
+{
+	lock_bridge(br);
+	fdb_flush(br, iface);
+	k_mutex_unlock(&br->lock);
+}
+
 void net_eth_bridge_foreach(eth_bridge_cb_t cb, void *user_data)
 {
 	STRUCT_SECTION_FOREACH(eth_bridge, br) {
@@ -115,6 +247,7 @@ int eth_bridge_iface_remove(struct eth_bridge *br, struct net_if *iface)
 
 	sys_slist_find_and_remove(&br->interfaces, &ctx->bridge.node);
 	ctx->bridge.instance = NULL;
+	fdb_flush(br, iface);
 
 	k_mutex_unlock(&br->lock);
 
@@ -165,75 +298,111 @@ static inline bool is_link_local_addr(struct net_eth_addr *addr)
 	return false;
 }
 
+static bool bridge_can_send(struct ethernet_context *ctx,
+			    struct ethernet_context *out_ctx)
+{
+	/* Don't xmit on the same interface as the incoming packet's */
+	if (ctx == out_ctx) {
+		return false;
+	}
+
+	/* Skip it if not allowed to transmit */
+	if (!out_ctx->bridge.allow_tx) {
+		return false;
+	}
+
+	/* Skip it if not up */
+	return net_if_flag_is_set(out_ctx->iface, NET_IF_UP);
+}
+
+static void bridge_send(struct net_pkt *pkt, struct net_pkt *out_pkt,
+			struct ethernet_context *out_ctx)
+{
+	NET_DBG("sending pkt %p as %p on iface %p", pkt, out_pkt, out_ctx->iface);
+
+	/*
+	 * Use AF_UNSPEC to avoid interference, set the output
+	 * interface and send the packet.
+	 */
+	net_pkt_set_family(out_pkt, AF_UNSPEC);
+	net_pkt_set_orig_iface(out_pkt, net_pkt_iface(pkt));
+	net_pkt_set_iface(out_pkt, out_ctx->iface);
+	net_if_queue_tx(out_ctx->iface, out_pkt);
+}
+
 enum net_verdict net_eth_bridge_input(struct ethernet_context *ctx,
 				      struct net_pkt *pkt)
 {
 	struct eth_bridge *br = ctx->bridge.instance;
+	struct net_eth_addr *dst = (struct net_eth_addr *)net_pkt_lladdr_dst(pkt)->addr;
+	struct net_eth_addr *src = (struct net_eth_addr *)net_pkt_lladdr_src(pkt)->addr;
+	struct net_if *out_iface;
 	sys_snode_t *node;
 
 	NET_DBG("new pkt %p", pkt);
 
 	/* Drop all link-local packets for now. */
-	if (is_link_local_addr((struct net_eth_addr *)net_pkt_lladdr_dst(pkt))) {
+	if (is_link_local_addr(dst)) {
 		return NET_DROP;
 	}
 
 	lock_bridge(br);
 
-	/*
-	 * Send packet to all registered interfaces for now.
-	 * Eventually we could get smarter with a MAC address cache.
-	 */
-	SYS_SLIST_FOR_EACH_NODE(&br->interfaces, node) {
-		struct ethernet_context *out_ctx;
+	fdb_learn(br, ctx->iface, src->addr);
+
+	SYS_SLIST_FOR_EACH_NODE(&br->listeners, node) {
+		struct eth_bridge_listener *l;
 		struct net_pkt *out_pkt;
 
-		out_ctx = CONTAINER_OF(node, struct ethernet_context, bridge.node);
+		l = CONTAINER_OF(node, struct eth_bridge_listener, node);
 
-		/* Don't xmit on the same interface as the incoming packet's */
-		if (ctx == out_ctx) {
+		out_pkt = net_pkt_shallow_clone(pkt, K_NO_WAIT);
+		if (out_pkt == NULL) {
 			continue;
 		}
 
-		/* Skip it if not allowed to transmit */
-		if (!out_ctx->bridge.allow_tx) {
-			continue;
-		}
+		k_fifo_put(&l->pkt_queue, out_pkt);
+	}
 
-		/* Skip it if not up */
-		if (!net_if_flag_is_set(out_ctx->iface, NET_IF_UP)) {
-			continue;
-		}
+	/* A station that was learned only needs the packet on its own
+	 * interface, which can then take the packet itself instead of
+	 * a clone.
+	 */
+	out_iface = fdb_lookup(br, dst->addr);
+	if (out_iface != NULL) {
+		struct ethernet_context *out_ctx = net_if_l2_data(out_iface);
 
-		out_pkt = net_pkt_shallow_clone(pkt, K_NO_WAIT);
-		if (out_pkt == NULL) {
-			continue;
-		}
+		k_mutex_unlock(&br->lock);
 
-		NET_DBG("sending pkt %p as %p on iface %p", pkt, out_pkt, out_ctx->iface);
+		if (!bridge_can_send(ctx, out_ctx)) {
+			/* The station is on the incoming segment already, or
+			 * cannot be reached from the bridge.
+			 */
+			net_pkt_unref(pkt);
+			return NET_OK;
+		}
 
-		/*
-		 * Use AF_UNSPEC to avoid interference, set the output
-		 * interface and send the packet.
-		 */
-		net_pkt_set_family(out_pkt, AF_UNSPEC);
-		net_pkt_set_orig_iface(out_pkt, net_pkt_iface(pkt));
-		net_pkt_set_iface(out_pkt, out_ctx->iface);
-		net_if_queue_tx(out_ctx->iface, out_pkt);
+		bridge_send(pkt, pkt, out_ctx);
+		return NET_OK;
 	}
 
-	SYS_SLIST_FOR_EACH_NODE(&br->listeners, node) {
-		struct eth_bridge_listener *l;
+	/* Unknown or multicast destination, send it to all the interfaces */
+	SYS_SLIST_FOR_EACH_NODE(&br->interfaces, node) {
+		struct ethernet_context *out_ctx;
 		struct net_pkt *out_pkt;
 
-		l = CONTAINER_OF(node, struct eth_bridge_listener, node);
+		out_ctx = CONTAINER_OF(node, struct ethernet_context, bridge.node);
+
+		if (!bridge_can_send(ctx, out_ctx)) {
+			continue;
+		}
 
 		out_pkt = net_pkt_shallow_clone(pkt, K_NO_WAIT);
 		if (out_pkt == NULL) {
 			continue;
 		}
 
-		k_fifo_put(&l->pkt_queue, out_pkt);
+		bridge_send(pkt, out_pkt, out_ctx);
 	}
 
 	k_mutex_unlock(&br->lock);
@@ -322,6 +322,24 @@ static void gptp_handle_msg(struct net_pkt *pkt)
 	}
 }
 
+bool net_gptp_is_rx_frame(struct net_if *iface, struct net_pkt *pkt)
+{
+	uint16_t type;
+
+	if (net_if_l2(iface) != &NET_L2_GET_NAME(ETHERNET) ||
+	    pkt->frags->len < sizeof(struct net_eth_vlan_hdr)) {
+		return false;
+	}
+
+	type = ntohs(NET_ETH_HDR(pkt)->type);
+
+	if (IS_ENABLED(CONFIG_NET_GPTP_VLAN) && type == NET_ETH_PTYPE_VLAN) {
+		type = ntohs(((struct net_eth_vlan_hdr *)NET_ETH_HDR(pkt))->type);
+	}
+
+	return type == NET_ETH_PTYPE_PTP;
+}
+
 enum net_verdict net_gptp_recv(struct net_if *iface, struct net_pkt *pkt)
 {
 	struct gptp_hdr *hdr = GPTP_HDR(pkt);
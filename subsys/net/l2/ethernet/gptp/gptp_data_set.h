@@ -526,6 +526,21 @@ struct gptp_port_param_ds {
 
 	/** Neighbor propagation delay threshold exceeded. */
 	uint32_t neighbor_prop_delay_exceeded;
+
+	/** Last offset of the local clock to the grand master in ns. */
+	int64_t clock_offset;
+
+	/** Largest absolute offset since the local clock was stepped. */
+	uint32_t clock_offset_max;
+
+	/** Mean absolute variation of the offset between two Sync, in ns. */
+	uint32_t clock_jitter;
+
+	/** Number of times the local clock was stepped. */
+	uint32_t clock_step_count;
+
+	/** Number of offsets ignored as outliers by the servo. */
+	uint32_t clock_outlier_count;
 };
 
 /**
@@ -730,6 +730,118 @@ static void gptp_mi_clk_slave_sync_compute(void)
 }
 
 #if defined(CONFIG_NET_GPTP_USE_DEFAULT_CLOCK_UPDATE)
+#if defined(CONFIG_NET_GPTP_STATISTICS)
+static void gptp_clock_stats_update(int port, int64_t offset)
+{
+	struct gptp_port_param_ds *param_ds = GPTP_PORT_PARAM_DS(port);
+	int64_t variation = offset - param_ds->clock_offset;
+	int64_t jitter = param_ds->clock_jitter;
+
+	if (variation < 0) {
+		variation = -variation;
+	}
+
+	jitter += (variation - jitter) / 16;
+	param_ds->clock_jitter = CLAMP(jitter, 0, UINT32_MAX);
+	param_ds->clock_offset = offset;
+
+	if (offset < 0) {
+		offset = -offset;
+	}
+
+	if (offset > param_ds->clock_offset_max) {
+		param_ds->clock_offset_max = MIN(offset, UINT32_MAX);
+	}
+}
+
+static void gptp_clock_stats_step(int port)
+{
+	struct gptp_port_param_ds *param_ds = GPTP_PORT_PARAM_DS(port);
+
+	param_ds->clock_offset = 0;
+	param_ds->clock_offset_max = 0;
+	param_ds->clock_step_count++;
+}
+#else
+#define gptp_clock_stats_update(port, offset)
+#define gptp_clock_stats_step(port)
+#endif /* CONFIG_NET_GPTP_STATISTICS */
+
+#if defined(CONFIG_NET_GPTP_SERVO_PI)
+/* Largest frequency adjustment of the local clock, in ppb. */
+#define GPTP_SERVO_MAX_PPB 500000.0
+
+/* Offsets below this value are never outliers, in ns. */
+#define GPTP_SERVO_OUTLIER_MIN_NS 100
+
+static struct gptp_servo {
+	/* Integral term, frequency error of the local clock in ppb. */
+	double drift;
+
+	/* Frequency adjustment applied to the local clock in ppb. */
+	double ppb;
+
+	/* Mean absolute offset to the grand master in ns. */
+	int64_t mean_offset;
+
+	/* Number of consecutive outliers. */
+	int outliers;
+
+	/* The local clock was stepped and is adjusted by the servo. */
+	bool locked;
+} servo;
+
+static void gptp_servo_lock(void)
+{
+	servo.drift = 0;
+	servo.ppb = 0;
+	servo.mean_offset = CONFIG_NET_GPTP_SERVO_STEP_THRESHOLD;
+	servo.outliers = 0;
+	servo.locked = true;
+}
+
+/* Adjust the frequency of the local clock from its offset to the grand
+ * master, in ns. Return false if the local clock must be stepped instead.
+ */
+static bool gptp_servo_sample(const struct device *clk, int port, int64_t offset)
+{
+	int64_t abs_offset = offset < 0 ? -offset : offset;
+	double ppb;
+
+	if (!servo.locked || abs_offset > CONFIG_NET_GPTP_SERVO_STEP_THRESHOLD) {
+		return false;
+	}
+
+	if (CONFIG_NET_GPTP_SERVO_OUTLIER_FACTOR > 0 &&
+	    servo.outliers < CONFIG_NET_GPTP_SERVO_MAX_OUTLIERS &&
+	    abs_offset > MAX(CONFIG_NET_GPTP_SERVO_OUTLIER_FACTOR * servo.mean_offset,
+			     GPTP_SERVO_OUTLIER_MIN_NS)) {
+		servo.outliers++;
+		GPTP_STATS_INC(port, clock_outlier_count);
+		return true;
+	}
+
+	servo.outliers = 0;
+	servo.mean_offset += (abs_offset - servo.mean_offset) / 16;
+
+	servo.drift += CONFIG_NET_GPTP_SERVO_KI * offset / 1000.0;
+	servo.drift = CLAMP(servo.drift, -GPTP_SERVO_MAX_PPB, GPTP_SERVO_MAX_PPB);
+
+	ppb = CONFIG_NET_GPTP_SERVO_KP * offset / 1000.0 + servo.drift;
+	ppb = CLAMP(ppb, -GPTP_SERVO_MAX_PPB, GPTP_SERVO_MAX_PPB);
+
+	/* The rate is relative to the current one of the local clock, which
+	 * already includes the previous adjustment.
+	 */
+	if (!ptp_clock_rate_adjust(clk, (NSEC_PER_SEC - ppb) /
+				   (NSEC_PER_SEC - servo.ppb))) {
+		servo.ppb = ppb;
+	}
+
+	return true;
+}
+#endif /* CONFIG_NET_GPTP_SERVO_PI */
+
 static void gptp_update_local_port_clock(void)
 {
 	struct gptp_clk_slave_sync_state *state;
@@ -749,13 +861,15 @@ static void gptp_update_local_port_clock(void)
 
 	port_ds = GPTP_PORT_DS(port);
 
-	/* Check if the last neighbor rate ratio can still be used */
-	if (!port_ds->neighbor_rate_ratio_valid) {
+	/* Check if the last neighbor rate ratio can still be used. The PI
+	 * servo only needs it to set the rate of the local clock when
+	 * stepping it, and adjusts the clock on each Sync otherwise.
+	 */
+	if (!IS_ENABLED(CONFIG_NET_GPTP_SERVO_PI) &&
+	    !port_ds->neighbor_rate_ratio_valid) {
 		return;
 	}
 
-	port_ds->neighbor_rate_ratio_valid = false;
-
 	second_diff = global_ds->sync_receipt_time.second -
 		(global_ds->sync_receipt_local_time / NSEC_PER_SEC);
 	nanosecond_diff =
@@ -777,12 +891,28 @@ static void gptp_update_local_port_clock(void)
 		nanosecond_diff = -(int64_t)NSEC_PER_SEC + nanosecond_diff;
 	}
 
+	gptp_clock_stats_update(port, -(second_diff * NSEC_PER_SEC +
+					nanosecond_diff));
+
+#if defined(CONFIG_NET_GPTP_SERVO_PI)
+	if (second_diff == 0 && gptp_servo_sample(clk, port, -nanosecond_diff)) {
+		return;
+	}
+
+	if (!port_ds->neighbor_rate_ratio_valid) {
+		return;
+	}
+#endif
+
+	port_ds->neighbor_rate_ratio_valid = false;
+
 	ptp_clock_rate_adjust(clk, port_ds->neighbor_rate_ratio);
 
 	/* If time difference is too high, set the clock value.
 	 * Otherwise, adjust it.
 	 */
-	if (second_diff || (second_diff == 0 &&
+	if (IS_ENABLED(CONFIG_NET_GPTP_SERVO_PI) ||
+	    second_diff || (second_diff == 0 &&
 			    (nanosecond_diff < -5000 ||
 			     nanosecond_diff > 5000))) {
 		bool underflow = false;
@@ -824,6 +954,11 @@ static void gptp_update_local_port_clock(void)
 		}
 
 		ptp_clock_set(clk, &tm);
+		gptp_clock_stats_step(port);
+
+#if defined(CONFIG_NET_GPTP_SERVO_PI)
+		gptp_servo_lock();
+#endif
 
 	skip_clock_set:
 		irq_unlock(key);
@@ -43,7 +43,31 @@ LOG_MODULE_REGISTER(net_ieee802154, CONFIG_NET_L2_IEEE802154_LOG_LEVEL);
 
 #define BUF_TIMEOUT K_MSEC(50)
 
-NET_BUF_POOL_DEFINE(tx_frame_buf_pool, 1, IEEE802154_MTU, 8, NULL);
+/**
+ * Called once per frame when its transmission is over, with 0 on success,
+ * -ECANCELED if the frame was dropped because an earlier frame of the same
+ * packet failed, or the error returned by ieee802154_radio_send().
+ */
+typedef void (*ieee802154_tx_done_cb_t)(struct net_if *iface, struct net_pkt *pkt,
+					struct net_buf *frame_buf, int status);
+
+/* Kept in the user data of each frame buffer. */
+struct ieee802154_tx_frame {
+	struct net_if *iface;
+	struct net_pkt *pkt; /* holds a reference until the frame is done */
+	ieee802154_tx_done_cb_t done;
+	bool last;	     /* last frame of pkt */
+	bool cancel;	     /* drop without sending */
+};
+
+#ifdef CONFIG_NET_L2_IEEE802154_TX_QUEUE
+#define TX_FRAME_BUF_COUNT CONFIG_NET_L2_IEEE802154_TX_QUEUE_SIZE
+#else
+#define TX_FRAME_BUF_COUNT 1
+#endif
+
+NET_BUF_POOL_DEFINE(tx_frame_buf_pool, TX_FRAME_BUF_COUNT, IEEE802154_MTU,
+		    sizeof(struct ieee802154_tx_frame), NULL);
 
 #define PKT_TITLE    "IEEE 802.15.4 packet content:"
 #define TX_PKT_TITLE "> " PKT_TITLE
@@ -176,24 +200,24 @@ inline int ieee802154_wait_for_ack(struct net_if *iface, bool ack_required)
 
 int ieee802154_radio_send(struct net_if *iface, struct net_pkt *pkt, struct net_buf *frag)
 {
+	enum ieee802154_hw_caps caps = ieee802154_radio_get_hw_capabilities(iface);
 	uint8_t remaining_attempts = CONFIG_NET_L2_IEEE802154_RADIO_TX_RETRIES + 1;
 	bool hw_csma, ack_required;
 	int ret;
 
 	NET_DBG("frag %p", frag);
 
-	if (ieee802154_radio_get_hw_capabilities(iface) & IEEE802154_HW_RETRANSMISSION) {
+	if (caps & IEEE802154_HW_RETRANSMISSION) {
 		/* A driver that claims retransmission capability must also be able
 		 * to wait for ACK frames otherwise it could not decide whether or
 		 * not retransmission is required in a standard conforming way.
 		 */
-		__ASSERT_NO_MSG(ieee802154_radio_get_hw_capabilities(iface) &
-				IEEE802154_HW_TX_RX_ACK);
+		__ASSERT_NO_MSG(caps & IEEE802154_HW_TX_RX_ACK);
 		remaining_attempts = 1;
 	}
 
 	hw_csma = IS_ENABLED(CONFIG_NET_L2_IEEE802154_RADIO_CSMA_CA) &&
-		  ieee802154_radio_get_hw_capabilities(iface) & IEEE802154_HW_CSMA;
+		  caps & IEEE802154_HW_CSMA;
 
 	/* Media access (CSMA, ALOHA, ...) and retransmission, see section 6.7.4.4. */
 	while (remaining_attempts) {
@@ -247,6 +271,109 @@ int ieee802154_radio_send(struct net_if *iface, struct net_pkt *pkt, struct net_
 	return -EIO;
 }
 
+static void ieee802154_tx_frame_done(struct net_buf *frame_buf, int status)
+{
+	struct ieee802154_tx_frame *frame = net_buf_user_data(frame_buf);
+
+	if (frame->done) {
+		frame->done(frame->iface, frame->pkt, frame_buf, status);
+	}
+
+	net_pkt_unref(frame->pkt);
+	net_buf_unref(frame_buf);
+}
+
+#ifdef CONFIG_NET_L2_IEEE802154_TX_QUEUE
+static K_FIFO_DEFINE(tx_frame_queue);
+
+#if defined(CONFIG_NET_TC_THREAD_COOPERATIVE)
+#define TX_THREAD_PRIORITY K_PRIO_COOP(CONFIG_NET_L2_IEEE802154_TX_THREAD_PRIO)
+#else
+#define TX_THREAD_PRIORITY K_PRIO_PREEMPT(CONFIG_NET_L2_IEEE802154_TX_THREAD_PRIO)
+#endif
+
+static void ieee802154_tx_thread(void)
+{
+	/* Packet whose remaining frames are dropped, only valid until its
+	 * last frame is done as the packet may be freed then.
+	 */
+	struct net_pkt *failed_pkt = NULL;
+
+	k_thread_name_set(NULL, "ieee802154_tx");
+
+	while (1) {
+		struct ieee802154_tx_frame *frame;
+		struct net_buf *frame_buf;
+		int ret;
+
+		frame_buf = net_buf_get(&tx_frame_queue, K_FOREVER);
+		if (frame_buf == NULL) {
+			continue;
+		}
+
+		frame = net_buf_user_data(frame_buf);
+
+		if (frame->cancel || frame->pkt == failed_pkt) {
+			ret = -ECANCELED;
+		} else {
+			ret = ieee802154_radio_send(frame->iface, frame->pkt, frame_buf);
+			if (ret) {
+				failed_pkt = frame->pkt;
+			}
+		}
+
+		if (frame->last && frame->pkt == failed_pkt) {
+			failed_pkt = NULL;
+		}
+
+		ieee802154_tx_frame_done(frame_buf, ret);
+	}
+}
+
+static K_THREAD_DEFINE(ieee802154_tx_handler, CONFIG_NET_L2_IEEE802154_TX_STACK_SIZE,
+		       (k_thread_entry_t)ieee802154_tx_thread, NULL, NULL, NULL,
+		       TX_THREAD_PRIORITY, 0, 0);
+#endif /* CONFIG_NET_L2_IEEE802154_TX_QUEUE */
+
+/**
+ * Submits a frame built from pkt and takes ownership of it. With
+ * CONFIG_NET_L2_IEEE802154_TX_QUEUE the frame is queued to the TX thread
+ * and 0 is returned, otherwise it is sent before returning the result.
+ * Either way the done callback reports the result of the frame.
+ */
+static int ieee802154_tx_frame_submit(struct net_if *iface, struct net_pkt *pkt,
+				      struct net_buf *frame_buf, bool last,
+				      ieee802154_tx_done_cb_t done)
+{
+	struct ieee802154_tx_frame *frame = net_buf_user_data(frame_buf);
+
+	frame->iface = iface;
+	frame->pkt = net_pkt_ref(pkt);
+	frame->done = done;
+	frame->last = last;
+
+#ifdef CONFIG_NET_L2_IEEE802154_TX_QUEUE
+	net_buf_put(&tx_frame_queue, frame_buf);
+
+	return 0;
+#else
+	int ret = frame->cancel ? -ECANCELED : ieee802154_radio_send(iface, pkt, frame_buf);
+
+	ieee802154_tx_frame_done(frame_buf, ret);
+
+	return ret;
+#endif
+}
+
+static void ieee802154_data_frame_done(struct net_if *iface, struct net_pkt *pkt,
+				       struct net_buf *frame_buf, int status)
+{
+	if (status) {
+		NET_DBG("Frame %p of pkt %p on iface %p not sent (%d)", frame_buf, pkt, iface,
+			status);
+	}
+}
+
 static inline void swap_and_set_pkt_ll_addr(struct net_linkaddr *addr, bool has_pan_id,
 					    enum ieee802154_addressing_mode mode,
 					    struct ieee802154_address_field *ll)
@@ -472,7 +599,6 @@ static int ieee802154_send(struct net_if *iface, struct net_pkt *pkt)
 {
 	struct ieee802154_context *ctx = net_if_l2_data(iface);
 	uint8_t ll_hdr_len = 0, authtag_len = 0;
-	static struct net_buf *frame_buf;
 	static struct net_buf *pkt_buf;
 	bool send_raw = false;
 	int len;
@@ -481,10 +607,6 @@ static int ieee802154_send(struct net_if *iface, struct net_pkt *pkt)
 	int requires_fragmentation = 0;
 #endif
 
-	if (frame_buf == NULL) {
-		frame_buf = net_buf_alloc(&tx_frame_buf_pool, K_FOREVER);
-	}
-
 	if (IS_ENABLED(CONFIG_NET_SOCKETS_PACKET) && net_pkt_family(pkt) == AF_PACKET) {
 		enum net_sock_type socket_type;
 		struct net_context *context;
@@ -535,27 +657,34 @@ static int ieee802154_send(struct net_if *iface, struct net_pkt *pkt)
 	len = 0;
 	pkt_buf = pkt->buffer;
 	while (pkt_buf) {
+		struct net_buf *frame_buf;
 		int ret;
 
-		/* Reinitializing frame_buf */
-		net_buf_reset(frame_buf);
+		/* Blocks while all frame buffers are queued or on air. */
+		frame_buf = net_buf_alloc(&tx_frame_buf_pool, K_FOREVER);
+		memset(net_buf_user_data(frame_buf), 0, sizeof(struct ieee802154_tx_frame));
 		net_buf_add(frame_buf, ll_hdr_len);
 
 #ifdef CONFIG_NET_L2_IEEE802154_FRAGMENT
 		if (requires_fragmentation) {
 			pkt_buf = ieee802154_6lo_fragment(&frag_ctx, frame_buf, true);
-		} else {
-			net_buf_add_mem(frame_buf, pkt_buf->data, pkt_buf->len);
-			pkt_buf = pkt_buf->frags;
-		}
-#else
-		if (ll_hdr_len + pkt_buf->len + authtag_len > IEEE802154_MTU) {
-			NET_ERR("Frame too long: %d", pkt_buf->len);
-			return -EINVAL;
-		}
-		net_buf_add_mem(frame_buf, pkt_buf->data, pkt_buf->len);
-		pkt_buf = pkt_buf->frags;
+		} else
 #endif /* CONFIG_NET_L2_IEEE802154_FRAGMENT */
+		{
+			/* The compressed packet is not compacted, it fits in
+			 * one frame but may still span several fragments.
+			 */
+			if (ll_hdr_len + net_pkt_get_len(pkt) + authtag_len > IEEE802154_MTU) {
+				NET_ERR("Frame too long: %zu", net_pkt_get_len(pkt));
+				net_buf_unref(frame_buf);
+				return -EINVAL;
+			}
+
+			while (pkt_buf) {
+				net_buf_add_mem(frame_buf, pkt_buf->data, pkt_buf->len);
+				pkt_buf = pkt_buf->frags;
+			}
+		}
 
 		__ASSERT_NO_MSG(authtag_len <= net_buf_tailroom(frame_buf));
 		net_buf_add(frame_buf, authtag_len);
@@ -563,15 +692,23 @@ static int ieee802154_send(struct net_if *iface, struct net_pkt *pkt)
 		if (!(send_raw || ieee802154_create_data_frame(ctx, net_pkt_lladdr_dst(pkt),
 							       net_pkt_lladdr_src(pkt),
 							       frame_buf, ll_hdr_len))) {
+			struct ieee802154_tx_frame *frame = net_buf_user_data(frame_buf);
+
+			/* Ends the frames of pkt already queued. */
+			frame->cancel = true;
+			(void)ieee802154_tx_frame_submit(iface, pkt, frame_buf, true,
+							 ieee802154_data_frame_done);
 			return -EINVAL;
 		}
 
-		ret = ieee802154_radio_send(iface, pkt, frame_buf);
+		/* The frame is released once submitted. */
+		len += frame_buf->len;
+
+		ret = ieee802154_tx_frame_submit(iface, pkt, frame_buf, pkt_buf == NULL,
+						 ieee802154_data_frame_done);
 		if (ret) {
 			return ret;
 		}
-
-		len += frame_buf->len;
 	}
 
 	net_pkt_unref(pkt);
@@ -37,13 +37,19 @@ static inline int unslotted_csma_ca_channel_access(struct net_if *iface)
 
 		if (be) {
 			uint8_t bo_n = sys_rand32_get() & ((1 << be) - 1);
+			uint32_t backoff_us = bo_n * IEEE802154_A_UNIT_BACKOFF_PERIOD_US(
+							     turnaround_time, symbol_period);
 
 			/* TODO: k_busy_wait() is too inaccurate on many platforms, the
 			 * radio API should expose a precise radio clock instead (which may
 			 * fall back to k_busy_wait() if the radio does not have a clock).
 			 */
-			k_busy_wait(bo_n * IEEE802154_A_UNIT_BACKOFF_PERIOD_US(turnaround_time,
-									       symbol_period));
+			if (IS_ENABLED(CONFIG_NET_L2_IEEE802154_RADIO_CSMA_CA_BACKOFF_SLEEP) &&
+			    backoff_us >= k_ticks_to_us_ceil32(1)) {
+				k_usleep(backoff_us);
+			} else {
+				k_busy_wait(backoff_us);
+			}
 		}
 
 		ret = ieee802154_radio_cca(iface);
@@ -33,12 +33,213 @@ static const struct wifi_mgmt_ops *const get_wifi_api(struct net_if *iface)
 	return off_api ? off_api->wifi_mgmt_api : NULL;
 }
 
+#if (CONFIG_WIFI_MGMT_SCAN_RESULTS_BUFFER_SIZE > 0) || defined(CONFIG_WIFI_MGMT_FAST_RECONNECT)
+static K_MUTEX_DEFINE(cache_lock);
+#endif
+
+#if CONFIG_WIFI_MGMT_SCAN_RESULTS_BUFFER_SIZE > 0
+/* Results of the last scan, one per BSSID, strongest first */
+static struct {
+	struct net_if *iface;
+	size_t count;
+	struct wifi_scan_result entries[CONFIG_WIFI_MGMT_SCAN_RESULTS_BUFFER_SIZE];
+} scan_results;
+
+static void scan_results_add(struct net_if *iface,
+			     const struct wifi_scan_result *entry)
+{
+	struct wifi_scan_result *entries = scan_results.entries;
+	size_t count, i;
+
+	k_mutex_lock(&cache_lock, K_FOREVER);
+
+	if (scan_results.iface != iface) {
+		goto out;
+	}
+
+	count = scan_results.count;
+
+	/* A BSS can be reported more than once, e.g. for each probe
+	 * response, only its strongest report is kept.
+	 */
+	if (entry->mac_length) {
+		for (i = 0; i < count; i++) {
+			if (entries[i].mac_length == entry->mac_length &&
+			    !memcmp(entries[i].mac, entry->mac, entry->mac_length)) {
+				break;
+			}
+		}
+
+		if (i < count) {
+			if (entry->rssi <= entries[i].rssi) {
+				goto out;
+			}
+
+			memmove(&entries[i], &entries[i + 1],
+				(count - i - 1) * sizeof(*entries));
+			count--;
+		}
+	}
+
+	i = 0;
+	while (i < count && entries[i].rssi >= entry->rssi) {
+		i++;
+	}
+
+	/* When full, the weakest result is dropped */
+	if (i < ARRAY_SIZE(scan_results.entries)) {
+		count = MIN(count, ARRAY_SIZE(scan_results.entries) - 1);
+		memmove(&entries[i + 1], &entries[i],
+			(count - i) * sizeof(*entries));
+		entries[i] = *entry;
+		count++;
+	}
+
+	scan_results.count = count;
+out:
+	k_mutex_unlock(&cache_lock);
+}
+#endif /* CONFIG_WIFI_MGMT_SCAN_RESULTS_BUFFER_SIZE > 0 */
+
+#ifdef CONFIG_WIFI_MGMT_FAST_RECONNECT
+static void last_network_update(struct k_work *work);
+
+static K_WORK_DEFINE(last_network_work, last_network_update);
+
+/* Network last connected to */
+static struct {
+	struct net_if *iface;
+	uint8_t ssid[WIFI_SSID_MAX_LEN];
+	uint8_t ssid_length;
+	uint8_t band;
+	uint8_t channel;
+	/* The connection in progress uses the channel above */
+	bool hinted;
+	/* Interface to read the status of once connected */
+	struct net_if *pending;
+} last_network;
+
+static void last_network_update(struct k_work *work)
+{
+	struct wifi_iface_status status = { 0 };
+	const struct wifi_mgmt_ops *wifi_mgmt_api;
+	struct net_if *iface;
+
+	k_mutex_lock(&cache_lock, K_FOREVER);
+	iface = last_network.pending;
+	last_network.pending = NULL;
+	k_mutex_unlock(&cache_lock);
+
+	if (!iface) {
+		return;
+	}
+
+	wifi_mgmt_api = get_wifi_api(iface);
+	if (wifi_mgmt_api == NULL || wifi_mgmt_api->iface_status == NULL ||
+	    wifi_mgmt_api->iface_status(net_if_get_device(iface), &status) ||
+	    status.state != WIFI_STATE_COMPLETED ||
+	    status.ssid_len == 0U || status.ssid_len > WIFI_SSID_MAX_LEN) {
+		return;
+	}
+
+	k_mutex_lock(&cache_lock, K_FOREVER);
+	last_network.iface = iface;
+	memcpy(last_network.ssid, status.ssid, status.ssid_len);
+	last_network.ssid_length = status.ssid_len;
+	last_network.band = status.band;
+	last_network.channel = status.channel;
+	k_mutex_unlock(&cache_lock);
+
+	NET_DBG("cached channel %u for the connected network", status.channel);
+}
+
+/* Fill in the channel of a connection request that does not specify one,
+ * so that the driver can skip the full scan before associating.
+ */
+static bool last_network_hint(struct net_if *iface,
+			      struct wifi_connect_req_params *params)
+{
+	bool hinted = false;
+
+	k_mutex_lock(&cache_lock, K_FOREVER);
+
+	if (params->channel != WIFI_CHANNEL_ANY) {
+		goto out;
+	}
+
+	if (last_network.iface == iface &&
+	    last_network.ssid_length == params->ssid_length &&
+	    !memcmp(last_network.ssid, params->ssid, params->ssid_length)) {
+		params->band = last_network.band;
+		params->channel = last_network.channel;
+		hinted = true;
+		goto out;
+	}
+
+#if CONFIG_WIFI_MGMT_SCAN_RESULTS_BUFFER_SIZE > 0
+	for (size_t i = 0; scan_results.iface == iface && i < scan_results.count; i++) {
+		const struct wifi_scan_result *entry = &scan_results.entries[i];
+
+		if (entry->ssid_length == params->ssid_length &&
+		    !memcmp(entry->ssid, params->ssid, params->ssid_length)) {
+			params->band = entry->band;
+			params->channel = entry->channel;
+			hinted = true;
+			break;
+		}
+	}
+#endif /* CONFIG_WIFI_MGMT_SCAN_RESULTS_BUFFER_SIZE > 0 */
+
+out:
+	last_network.hinted = hinted;
+	k_mutex_unlock(&cache_lock);
+
+	return hinted;
+}
+
+/* Returns whether the connection used a channel hint */
+static bool last_network_connect_result(struct net_if *iface, int status)
+{
+	bool hinted;
+
+	k_mutex_lock(&cache_lock, K_FOREVER);
+
+	hinted = last_network.hinted;
+	last_network.hinted = false;
+
+	if (status == 0) {
+		/* The driver may be holding its own locks here, its status
+		 * is read from the system work queue instead.
+		 */
+		last_network.pending = iface;
+		k_work_submit(&last_network_work);
+	} else if (hinted) {
+		NET_DBG("connection on the cached channel failed, forgetting it");
+		last_network.iface = NULL;
+	}
+
+	k_mutex_unlock(&cache_lock);
+
+	return hinted;
+}
+#endif /* CONFIG_WIFI_MGMT_FAST_RECONNECT */
+
+/* Start times of the connection phases in progress, 0 if none */
+static struct {
+	int64_t scan;
+	int64_t connect;
+	int64_t disconnect;
+} timing;
+
 static int wifi_connect(uint32_t mgmt_request, struct net_if *iface,
 			void *data, size_t len)
 {
 	struct wifi_connect_req_params *params =
 		(struct wifi_connect_req_params *)data;
 	const struct device *dev = net_if_get_device(iface);
+#ifdef CONFIG_WIFI_MGMT_FAST_RECONNECT
+	struct wifi_connect_req_params hinted_params;
+#endif /* CONFIG_WIFI_MGMT_FAST_RECONNECT */
 
 	const struct wifi_mgmt_ops *const wifi_mgmt_api = get_wifi_api(iface);
 
@@ -69,6 +270,19 @@ static int wifi_connect(uint32_t mgmt_request, struct net_if *iface,
 		return -EINVAL;
 	}
 
+	if (IS_ENABLED(CONFIG_WIFI_MGMT_CONNECT_TIMING)) {
+		timing.connect = k_uptime_get();
+	}
+
+#ifdef CONFIG_WIFI_MGMT_FAST_RECONNECT
+	/* The caller's parameters are left untouched */
+	hinted_params = *params;
+	if (last_network_hint(iface, &hinted_params)) {
+		NET_DBG("using cached channel %u", hinted_params.channel);
+		params = &hinted_params;
+	}
+#endif /* CONFIG_WIFI_MGMT_FAST_RECONNECT */
+
 	return wifi_mgmt_api->connect(dev, params);
 }
 
@@ -86,16 +300,24 @@ static void scan_result_cb(struct net_if *iface, int status,
 			.status = status,
 		};
 
+		if (IS_ENABLED(CONFIG_WIFI_MGMT_CONNECT_TIMING) && timing.scan) {
+			LOG_INF("Scan %s in %u ms", status ? "failed" : "done",
+				(uint32_t)(k_uptime_get() - timing.scan));
+			timing.scan = 0;
+		}
+
 		net_mgmt_event_notify_with_info(NET_EVENT_WIFI_SCAN_DONE,
 						iface, &scan_status,
 						sizeof(struct wifi_status));
 		return;
 	}
 
-#ifndef CONFIG_WIFI_MGMT_RAW_SCAN_RESULTS_ONLY
+#if CONFIG_WIFI_MGMT_SCAN_RESULTS_BUFFER_SIZE > 0
+	scan_results_add(iface, entry);
+#elif !defined(CONFIG_WIFI_MGMT_RAW_SCAN_RESULTS_ONLY)
 	net_mgmt_event_notify_with_info(NET_EVENT_WIFI_SCAN_RESULT, iface,
 					entry, sizeof(struct wifi_scan_result));
-#endif /* CONFIG_WIFI_MGMT_RAW_SCAN_RESULTS_ONLY */
+#endif /* CONFIG_WIFI_MGMT_SCAN_RESULTS_BUFFER_SIZE > 0 */
 }
 
 static int wifi_scan(uint32_t mgmt_request, struct net_if *iface,
@@ -163,11 +385,52 @@ static int wifi_scan(uint32_t mgmt_request, struct net_if *iface,
 		}
 	}
 
+#if CONFIG_WIFI_MGMT_SCAN_RESULTS_BUFFER_SIZE > 0
+	k_mutex_lock(&cache_lock, K_FOREVER);
+	scan_results.iface = iface;
+	scan_results.count = 0;
+	k_mutex_unlock(&cache_lock);
+#endif /* CONFIG_WIFI_MGMT_SCAN_RESULTS_BUFFER_SIZE > 0 */
+
+	if (IS_ENABLED(CONFIG_WIFI_MGMT_CONNECT_TIMING)) {
+		timing.scan = k_uptime_get();
+	}
+
 	return wifi_mgmt_api->scan(dev, params, scan_result_cb);
 }
 
 NET_MGMT_REGISTER_REQUEST_HANDLER(NET_REQUEST_WIFI_SCAN, wifi_scan);
 
+static int wifi_scan_results(uint32_t mgmt_request, struct net_if *iface,
+			     void *data, size_t len)
+{
+#if CONFIG_WIFI_MGMT_SCAN_RESULTS_BUFFER_SIZE > 0
+	struct wifi_scan_results *results = data;
+
+	if (!data || len != sizeof(*results) ||
+	    (!results->results && results->max_count)) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&cache_lock, K_FOREVER);
+
+	results->count = 0;
+	if (scan_results.iface == iface) {
+		results->count = MIN(results->max_count, scan_results.count);
+		memcpy(results->results, scan_results.entries,
+		       results->count * sizeof(*results->results));
+	}
+
+	k_mutex_unlock(&cache_lock);
+
+	return 0;
+#else
+	return -ENOTSUP;
+#endif /* CONFIG_WIFI_MGMT_SCAN_RESULTS_BUFFER_SIZE > 0 */
+}
+
+NET_MGMT_REGISTER_REQUEST_HANDLER(NET_REQUEST_WIFI_SCAN_RESULTS, wifi_scan_results);
+
 static int wifi_disconnect(uint32_t mgmt_request, struct net_if *iface,
 			   void *data, size_t len)
 {
@@ -188,6 +451,26 @@ void wifi_mgmt_raise_connect_result_event(struct net_if *iface, int status)
 	struct wifi_status cnx_status = {
 		.status = status,
 	};
+	bool hinted = false;
+
+#ifdef CONFIG_WIFI_MGMT_FAST_RECONNECT
+	hinted = last_network_connect_result(iface, status);
+#endif /* CONFIG_WIFI_MGMT_FAST_RECONNECT */
+
+	if (IS_ENABLED(CONFIG_WIFI_MGMT_CONNECT_TIMING) && timing.connect) {
+		int64_t now = k_uptime_get();
+
+		LOG_INF("Connection %s in %u ms%s", status ? "failed" : "done",
+			(uint32_t)(now - timing.connect),
+			hinted ? " on the cached channel" : "");
+		timing.connect = 0;
+
+		if (status == 0 && timing.disconnect) {
+			LOG_INF("Reconnected %u ms after the disconnection",
+				(uint32_t)(now - timing.disconnect));
+			timing.disconnect = 0;
+		}
+	}
 
 	net_mgmt_event_notify_with_info(NET_EVENT_WIFI_CONNECT_RESULT,
 					iface, &cnx_status,
@@ -200,6 +483,10 @@ void wifi_mgmt_raise_disconnect_result_event(struct net_if *iface, int status)
 		.status = status,
 	};
 
+	if (IS_ENABLED(CONFIG_WIFI_MGMT_CONNECT_TIMING) && status == 0) {
+		timing.disconnect = k_uptime_get();
+	}
+
 	net_mgmt_event_notify_with_info(NET_EVENT_WIFI_DISCONNECT_RESULT,
 					iface, &cnx_status,
 					sizeof(struct wifi_status));
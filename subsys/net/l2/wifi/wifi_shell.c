@@ -89,10 +89,8 @@ static bool parse_number(const struct shell *sh, long *param, char *str, long mi
 	return true;
 }
 
-static void handle_wifi_scan_result(struct net_mgmt_event_callback *cb)
+static void print_wifi_scan_result(const struct wifi_scan_result *entry)
 {
-	const struct wifi_scan_result *entry =
-		(const struct wifi_scan_result *)cb->info;
 	uint8_t mac_string_buf[sizeof("xx:xx:xx:xx:xx:xx")];
 
 	scan_result++;
@@ -116,6 +114,31 @@ static void handle_wifi_scan_result(struct net_mgmt_event_callback *cb)
 	      wifi_mfp_txt(entry->mfp));
 }
 
+static void handle_wifi_scan_result(struct net_mgmt_event_callback *cb)
+{
+	print_wifi_scan_result((const struct wifi_scan_result *)cb->info);
+}
+
+#if CONFIG_WIFI_MGMT_SCAN_RESULTS_BUFFER_SIZE > 0
+static void print_wifi_scan_results(struct net_if *iface)
+{
+	static struct wifi_scan_result entries[CONFIG_WIFI_MGMT_SCAN_RESULTS_BUFFER_SIZE];
+	struct wifi_scan_results results = {
+		.results = entries,
+		.max_count = ARRAY_SIZE(entries),
+	};
+
+	if (net_mgmt(NET_REQUEST_WIFI_SCAN_RESULTS, iface, &results, sizeof(results))) {
+		print(context.sh, SHELL_WARNING, "Scan results not available\n");
+		return;
+	}
+
+	for (size_t i = 0; i < results.count; i++) {
+		print_wifi_scan_result(&entries[i]);
+	}
+}
+#endif /* CONFIG_WIFI_MGMT_SCAN_RESULTS_BUFFER_SIZE > 0 */
+
 #ifdef CONFIG_WIFI_MGMT_RAW_SCAN_RESULTS
 static int wifi_freq_to_channel(int frequency)
 {
@@ -191,7 +214,8 @@ static void handle_wifi_raw_scan_result(struct net_mgmt_event_callback *cb)
 }
 #endif /* CONFIG_WIFI_MGMT_RAW_SCAN_RESULTS */
 
-static void handle_wifi_scan_done(struct net_mgmt_event_callback *cb)
+static void handle_wifi_scan_done(struct net_mgmt_event_callback *cb,
+				  struct net_if *iface)
 {
 	const struct wifi_status *status =
 		(const struct wifi_status *)cb->info;
@@ -200,6 +224,9 @@ static void handle_wifi_scan_done(struct net_mgmt_event_callback *cb)
 		print(context.sh, SHELL_WARNING,
 		      "Scan request failed (%d)\n", status->status);
 	} else {
+#if CONFIG_WIFI_MGMT_SCAN_RESULTS_BUFFER_SIZE > 0
+		print_wifi_scan_results(iface);
+#endif /* CONFIG_WIFI_MGMT_SCAN_RESULTS_BUFFER_SIZE > 0 */
 		print(context.sh, SHELL_NORMAL, "Scan request done\n");
 	}
 
@@ -302,7 +329,7 @@ static void wifi_mgmt_event_handler(struct net_mgmt_event_callback *cb,
 		handle_wifi_scan_result(cb);
 		break;
 	case NET_EVENT_WIFI_SCAN_DONE:
-		handle_wifi_scan_done(cb);
+		handle_wifi_scan_done(cb, iface);
 		break;
 	case NET_EVENT_WIFI_CONNECT_RESULT:
 		handle_wifi_connect_result(cb);
@@ -0,0 +1,419 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(net_capture, CONFIG_NET_CAPTURE_LOG_LEVEL);
+
+#include <zephyr/kernel.h>
+#include <string.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/mpsc_pbuf.h>
+#include <zephyr/net/net_core.h>
+#include <zephyr/net/net_ip.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/net/ethernet.h>
+#include <zephyr/net/capture.h>
+
+#define PCAPNG_BLOCK_SHB 0x0A0D0D0A
+#define PCAPNG_BLOCK_IDB 0x00000001
+#define PCAPNG_BLOCK_EPB 0x00000006
+#define PCAPNG_BYTE_ORDER_MAGIC 0x1A2B3C4D
+#define PCAPNG_OPT_IF_TSRESOL 9
+
+#define LINKTYPE_ETHERNET 1
+#define LINKTYPE_RAW 101
+
+/* Enough of the frame to reach the ports behind a VLAN tag and an
+ * IPv6 header.
+ */
+#define FILTER_HDR_LEN 64
+
+#define RING_WLEN (CONFIG_NET_CAPTURE_RING_SIZE / sizeof(uint32_t))
+
+struct pcapng_shb {
+	uint32_t type;
+	uint32_t len;
+	uint32_t magic;
+	uint16_t major;
+	uint16_t minor;
+	uint64_t section_len;
+	uint32_t len_trailer;
+} __packed;
+
+struct pcapng_idb {
+	uint32_t type;
+	uint32_t len;
+	uint16_t linktype;
+	uint16_t reserved;
+	uint32_t snaplen;
+	uint16_t tsresol_code;
+	uint16_t tsresol_len;
+	uint8_t tsresol[4];
+	uint32_t end_of_opt;
+	uint32_t len_trailer;
+} __packed;
+
+struct pcapng_epb {
+	uint32_t type;
+	uint32_t len;
+	uint32_t iface_id;
+	uint32_t ts_high;
+	uint32_t ts_low;
+	uint32_t caplen;
+	uint32_t origlen;
+} __packed;
+
+/* Ring record, the Enhanced Packet Block follows the ring header word */
+struct capture_record {
+	MPSC_PBUF_HDR;
+	uint32_t wlen: 32 - MPSC_PBUF_HDR_BITS;
+	struct pcapng_epb epb;
+	uint8_t data[];
+};
+
+#define RECORD_MAX_LEN (sizeof(struct capture_record) + \
+			ROUND_UP(CONFIG_NET_CAPTURE_RING_SNAPLEN, 4) + \
+			sizeof(uint32_t))
+
+BUILD_ASSERT(RECORD_MAX_LEN < CONFIG_NET_CAPTURE_RING_SIZE,
+	     "CONFIG_NET_CAPTURE_RING_SIZE cannot hold a packet");
+
+static uint32_t ring_buf[RING_WLEN];
+static struct mpsc_pbuf_buffer ring;
+static bool ring_ready;
+
+static K_MUTEX_DEFINE(ring_lock);
+
+/* Record claimed from the ring that did not fit the reader buffer */
+static const union mpsc_pbuf_generic *pending;
+
+static struct net_if *ring_iface;
+static struct net_capture_filter ring_filter;
+static uint16_t ring_linktype;
+
+static atomic_t stat_captured;
+static atomic_t stat_truncated;
+static atomic_t stat_filtered;
+static atomic_t stat_dropped;
+
+static uint32_t record_get_wlen(const union mpsc_pbuf_generic *packet)
+{
+	return ((const struct capture_record *)packet)->wlen;
+}
+
+static bool filter_addr_match(const struct net_addr *addr, const uint8_t *src,
+			      const uint8_t *dst, size_t len)
+{
+	const uint8_t *match = addr->family == AF_INET ?
+		(const uint8_t *)&addr->in_addr : (const uint8_t *)&addr->in6_addr;
+
+	if (addr->family == AF_UNSPEC) {
+		return true;
+	}
+
+	return memcmp(match, src, len) == 0 || memcmp(match, dst, len) == 0;
+}
+
+static bool filter_match(struct net_pkt *pkt)
+{
+	const struct net_capture_filter *filter = &ring_filter;
+	uint8_t hdr[FILTER_HDR_LEN];
+	sa_family_t family;
+	uint8_t proto;
+	size_t offset = 0;
+	size_t len;
+
+	if (filter->family == AF_UNSPEC && filter->proto == 0 &&
+	    filter->port == 0 && filter->addr.family == AF_UNSPEC) {
+		return true;
+	}
+
+	len = net_buf_linearize(hdr, sizeof(hdr), pkt->buffer, 0, sizeof(hdr));
+
+	if (ring_linktype == LINKTYPE_ETHERNET) {
+		uint16_t type;
+
+		if (len < sizeof(struct net_eth_hdr)) {
+			return false;
+		}
+
+		type = sys_get_be16(&hdr[12]);
+		offset = sizeof(struct net_eth_hdr);
+
+		if (type == NET_ETH_PTYPE_VLAN && len >= offset + 4) {
+			type = sys_get_be16(&hdr[offset + 2]);
+			offset += 4;
+		}
+
+		if (type != NET_ETH_PTYPE_IP && type != NET_ETH_PTYPE_IPV6) {
+			return false;
+		}
+	}
+
+	if (len <= offset) {
+		return false;
+	}
+
+	if ((hdr[offset] & 0xf0) == 0x40 && len >= offset + sizeof(struct net_ipv4_hdr)) {
+		const struct net_ipv4_hdr *ip = (const struct net_ipv4_hdr *)&hdr[offset];
+
+		family = AF_INET;
+		proto = ip->proto;
+
+		if (filter->addr.family == AF_INET6 ||
+		    !filter_addr_match(&filter->addr, ip->src, ip->dst,
+				       sizeof(struct in_addr))) {
+			return false;
+		}
+
+		offset += (ip->vhl & 0x0f) * 4;
+	} else if ((hdr[offset] & 0xf0) == 0x60 &&
+		   len >= offset + sizeof(struct net_ipv6_hdr)) {
+		const struct net_ipv6_hdr *ip = (const struct net_ipv6_hdr *)&hdr[offset];
+
+		/* Extension headers are not walked */
+		family = AF_INET6;
+		proto = ip->nexthdr;
+
+		if (filter->addr.family == AF_INET ||
+		    !filter_addr_match(&filter->addr, ip->src, ip->dst,
+				       sizeof(struct in6_addr))) {
+			return false;
+		}
+
+		offset += sizeof(struct net_ipv6_hdr);
+	} else {
+		return false;
+	}
+
+	if ((filter->family != AF_UNSPEC && filter->family != family) ||
+	    (filter->proto != 0 && filter->proto != proto)) {
+		return false;
+	}
+
+	if (filter->port != 0) {
+		if ((proto != IPPROTO_TCP && proto != IPPROTO_UDP) ||
+		    len < offset + 2 * sizeof(uint16_t)) {
+			return false;
+		}
+
+		if (sys_get_be16(&hdr[offset]) != filter->port &&
+		    sys_get_be16(&hdr[offset + 2]) != filter->port) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+static uint64_t capture_timestamp(struct net_pkt *pkt)
+{
+	struct net_ptp_time *ts = net_pkt_timestamp(pkt);
+
+	/* Prefer the driver or PTP timestamp when the packet has one */
+	if (ts != NULL && (ts->second != 0 || ts->nanosecond != 0)) {
+		return ts->second * NSEC_PER_SEC + ts->nanosecond;
+	}
+
+	return k_ticks_to_ns_floor64(k_uptime_ticks());
+}
+
+void net_capture_ring_pkt(struct net_if *iface, struct net_pkt *pkt)
+{
+	struct capture_record *record;
+	size_t origlen, caplen;
+	uint32_t epb_len;
+	uint64_t ts;
+
+	if (iface != ring_iface || iface == NULL) {
+		return;
+	}
+
+	if (!filter_match(pkt)) {
+		atomic_inc(&stat_filtered);
+		return;
+	}
+
+	ts = capture_timestamp(pkt);
+	origlen = net_pkt_get_len(pkt);
+	caplen = MIN(origlen, CONFIG_NET_CAPTURE_RING_SNAPLEN);
+	epb_len = sizeof(struct pcapng_epb) + ROUND_UP(caplen, 4) + sizeof(uint32_t);
+
+	record = (struct capture_record *)mpsc_pbuf_alloc(
+		&ring, 1 + epb_len / sizeof(uint32_t), K_NO_WAIT);
+	if (record == NULL) {
+		atomic_inc(&stat_dropped);
+		return;
+	}
+
+	record->wlen = 1 + epb_len / sizeof(uint32_t);
+	record->epb.type = PCAPNG_BLOCK_EPB;
+	record->epb.len = epb_len;
+	record->epb.iface_id = 0;
+	record->epb.ts_high = ts >> 32;
+	record->epb.ts_low = (uint32_t)ts;
+	record->epb.caplen = caplen;
+	record->epb.origlen = origlen;
+
+	net_buf_linearize(record->data, caplen, pkt->buffer, 0, caplen);
+	memset(&record->data[caplen], 0, ROUND_UP(caplen, 4) - caplen);
+	UNALIGNED_PUT(epb_len, (uint32_t *)&record->data[ROUND_UP(caplen, 4)]);
+
+	mpsc_pbuf_commit(&ring, (union mpsc_pbuf_generic *)record);
+
+	atomic_inc(&stat_captured);
+	if (caplen < origlen) {
+		atomic_inc(&stat_truncated);
+	}
+}
+
+int net_capture_ring_enable(struct net_if *iface,
+			    const struct net_capture_filter *filter)
+{
+	const struct mpsc_pbuf_buffer_config config = {
+		.buf = ring_buf,
+		.size = ARRAY_SIZE(ring_buf),
+		.get_wlen = record_get_wlen,
+		.flags = IS_POWER_OF_TWO(ARRAY_SIZE(ring_buf)) ? MPSC_PBUF_SIZE_POW2 : 0,
+	};
+
+	if (iface == NULL) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&ring_lock, K_FOREVER);
+
+	ring_iface = NULL;
+
+	if (filter != NULL) {
+		ring_filter = *filter;
+	} else {
+		memset(&ring_filter, 0, sizeof(ring_filter));
+	}
+
+	ring_linktype = LINKTYPE_RAW;
+#if defined(CONFIG_NET_L2_ETHERNET)
+	if (net_if_l2(iface) == &NET_L2_GET_NAME(ETHERNET)) {
+		ring_linktype = LINKTYPE_ETHERNET;
+	}
+#endif
+
+	mpsc_pbuf_init(&ring, &config);
+	ring_ready = true;
+	pending = NULL;
+
+	atomic_clear(&stat_captured);
+	atomic_clear(&stat_truncated);
+	atomic_clear(&stat_filtered);
+	atomic_clear(&stat_dropped);
+
+	ring_iface = iface;
+
+	k_mutex_unlock(&ring_lock);
+
+	NET_DBG("Capturing iface %d into ring", net_if_get_by_iface(iface));
+
+	return 0;
+}
+
+int net_capture_ring_disable(void)
+{
+	int ret = 0;
+
+	k_mutex_lock(&ring_lock, K_FOREVER);
+
+	if (ring_iface == NULL) {
+		ret = -EALREADY;
+	}
+
+	ring_iface = NULL;
+
+	k_mutex_unlock(&ring_lock);
+
+	return ret;
+}
+
+int net_capture_ring_header(uint8_t *buf, size_t len)
+{
+	struct pcapng_shb shb = {
+		.type = PCAPNG_BLOCK_SHB,
+		.len = sizeof(struct pcapng_shb),
+		.magic = PCAPNG_BYTE_ORDER_MAGIC,
+		.major = 1,
+		.minor = 0,
+		.section_len = UINT64_MAX,
+		.len_trailer = sizeof(struct pcapng_shb),
+	};
+	struct pcapng_idb idb = {
+		.type = PCAPNG_BLOCK_IDB,
+		.len = sizeof(struct pcapng_idb),
+		.linktype = ring_linktype,
+		.snaplen = CONFIG_NET_CAPTURE_RING_SNAPLEN,
+		.tsresol_code = PCAPNG_OPT_IF_TSRESOL,
+		.tsresol_len = 1,
+		/* Nanosecond resolution */
+		.tsresol = { 9 },
+		.len_trailer = sizeof(struct pcapng_idb),
+	};
+
+	if (len < sizeof(shb) + sizeof(idb)) {
+		return -ENOBUFS;
+	}
+
+	memcpy(buf, &shb, sizeof(shb));
+	memcpy(buf + sizeof(shb), &idb, sizeof(idb));
+
+	return sizeof(shb) + sizeof(idb);
+}
+
+int net_capture_ring_read(uint8_t *buf, size_t len)
+{
+	const struct capture_record *record;
+	size_t copied = 0;
+	size_t epb_len;
+
+	k_mutex_lock(&ring_lock, K_FOREVER);
+
+	while (ring_ready) {
+		if (pending == NULL) {
+			pending = mpsc_pbuf_claim(&ring);
+			if (pending == NULL) {
+				break;
+			}
+		}
+
+		record = (const struct capture_record *)pending;
+		epb_len = record->epb.len;
+
+		if (epb_len > len - copied) {
+			break;
+		}
+
+		memcpy(buf + copied, &record->epb, epb_len);
+		copied += epb_len;
+
+		mpsc_pbuf_free(&ring, pending);
+		pending = NULL;
+	}
+
+	k_mutex_unlock(&ring_lock);
+
+	if (copied == 0 && pending != NULL) {
+		return -ENOBUFS;
+	}
+
+	return copied;
+}
+
+void net_capture_ring_stats_get(struct net_capture_ring_stats *stats)
+{
+	stats->captured = atomic_get(&stat_captured);
+	stats->truncated = atomic_get(&stat_truncated);
+	stats->filtered = atomic_get(&stat_filtered);
+	stats->dropped = atomic_get(&stat_dropped);
+}
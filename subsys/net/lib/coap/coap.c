@@ -125,6 +125,37 @@ static inline bool insert_be16(struct coap_packet *cpkt, uint16_t data, size_t o
 	return true;
 }
 
+static inline void option_index_invalidate(struct coap_packet *cpkt)
+{
+#if defined(CONFIG_COAP_OPTION_INDEX)
+	cpkt->opt_indexed = false;
+#endif
+}
+
+static inline void option_index_add(struct coap_packet *cpkt,
+				    uint16_t code, uint16_t offset)
+{
+#if defined(CONFIG_COAP_OPTION_INDEX)
+	if (!cpkt->opt_indexed) {
+		return;
+	}
+
+	if (cpkt->opt_count >= ARRAY_SIZE(cpkt->opt_index)) {
+		/* Too many options, lookups walk the options instead */
+		cpkt->opt_indexed = false;
+		return;
+	}
+
+	cpkt->opt_index[cpkt->opt_count].code = code;
+	cpkt->opt_index[cpkt->opt_count].offset = offset;
+	cpkt->opt_count++;
+#else
+	ARG_UNUSED(cpkt);
+	ARG_UNUSED(code);
+	ARG_UNUSED(offset);
+#endif
+}
+
 static inline bool append(struct coap_packet *cpkt, const uint8_t *data, uint16_t len)
 {
 	if (data == NULL || !enough_space(cpkt, len)) {
@@ -325,6 +356,8 @@ int coap_packet_append_option(struct coap_packet *cpkt, uint16_t code,
 		return -EINVAL;
 	}
 
+	option_index_invalidate(cpkt);
+
 	if (code < cpkt->delta) {
 		NET_DBG("Option is not added in ascending order");
 		return insert_option(cpkt, code, value, len);
@@ -346,6 +379,52 @@ int coap_packet_append_option(struct coap_packet *cpkt, uint16_t code,
 	return 0;
 }
 
+int coap_packet_append_options(struct coap_packet *cpkt,
+			       const struct coap_option *options, size_t num)
+{
+	uint32_t code = 0U;
+	uint32_t next;
+	size_t i;
+	int r;
+
+	if (!cpkt || (num && !options)) {
+		return -EINVAL;
+	}
+
+	/* Encode the options one code at a time, in ascending order, so
+	 * each one lands at the end of the packet without moving data.
+	 */
+	while (1) {
+		next = UINT32_MAX;
+
+		for (i = 0; i < num; i++) {
+			if (options[i].delta >= code && options[i].delta < next) {
+				next = options[i].delta;
+			}
+		}
+
+		if (next == UINT32_MAX) {
+			break;
+		}
+
+		for (i = 0; i < num; i++) {
+			if (options[i].delta != next) {
+				continue;
+			}
+
+			r = coap_packet_append_option(cpkt, next, options[i].value,
+						      options[i].len);
+			if (r < 0) {
+				return r;
+			}
+		}
+
+		code = next + 1U;
+	}
+
+	return 0;
+}
+
 int coap_append_option_int(struct coap_packet *cpkt, uint16_t code,
 			   unsigned int val)
 {
@@ -674,6 +753,8 @@ int coap_packet_remove_option(struct coap_packet *cpkt, uint16_t code)
 		return 0;
 	}
 
+	option_index_invalidate(cpkt);
+
 	/* Find the requested option */
 	while (offset < cpkt->hdr_len + cpkt->opt_len) {
 		r = parse_option(cpkt->data, offset, &offset, cpkt->hdr_len + cpkt->opt_len,
@@ -738,6 +819,10 @@ int coap_packet_parse(struct coap_packet *cpkt, uint8_t *data, uint16_t len,
 	cpkt->opt_len = 0U;
 	cpkt->hdr_len = 0U;
 	cpkt->delta = 0U;
+#if defined(CONFIG_COAP_OPTION_INDEX)
+	cpkt->opt_indexed = true;
+	cpkt->opt_count = 0U;
+#endif
 
 	/* Token lengths 9-15 are reserved. */
 	tkl = cpkt->data[0] & 0x0f;
@@ -761,13 +846,23 @@ int coap_packet_parse(struct coap_packet *cpkt, uint8_t *data, uint16_t len,
 
 	while (1) {
 		struct coap_option *option;
+		uint16_t opt_offset = offset;
+		uint16_t prev_opt_len = opt_len;
 
 		option = num < opt_num ? &options[num++] : NULL;
 		ret = parse_option(cpkt->data, offset, &offset, cpkt->max_len,
 				   &delta, &opt_len, option);
 		if (ret < 0) {
+			option_index_invalidate(cpkt);
 			return -EILSEQ;
-		} else if (ret == 0) {
+		}
+
+		/* Nothing is consumed when the payload marker is reached */
+		if (opt_len != prev_opt_len) {
+			option_index_add(cpkt, delta, opt_offset);
+		}
+
+		if (ret == 0) {
 			break;
 		}
 	}
@@ -778,6 +873,54 @@ int coap_packet_parse(struct coap_packet *cpkt, uint8_t *data, uint16_t len,
 	return 0;
 }
 
+#if defined(CONFIG_COAP_OPTION_INDEX)
+static int find_indexed_options(const struct coap_packet *cpkt, uint16_t code,
+				struct coap_option *options, uint16_t veclen)
+{
+	const struct coap_option_index *index = cpkt->opt_index;
+	uint8_t low = 0U;
+	uint8_t high = cpkt->opt_count;
+	uint16_t num = 0U;
+	uint16_t opt_len;
+	uint16_t offset;
+	uint16_t delta;
+	uint8_t i;
+	int r;
+
+	/* Options are sorted by code, find the first one matching */
+	while (low < high) {
+		uint8_t mid = low + (high - low) / 2U;
+
+		if (index[mid].code < code) {
+			low = mid + 1U;
+		} else {
+			high = mid;
+		}
+	}
+
+	for (i = low; i < cpkt->opt_count && num < veclen; i++) {
+		if (index[i].code != code) {
+			break;
+		}
+
+		/* Option delta is relative to the previous option */
+		delta = i > 0U ? index[i - 1U].code : 0U;
+		offset = index[i].offset;
+		opt_len = 0U;
+
+		r = parse_option(cpkt->data, offset, &offset, cpkt->max_len,
+				 &delta, &opt_len, &options[num]);
+		if (r < 0) {
+			return -EINVAL;
+		}
+
+		num++;
+	}
+
+	return num;
+}
+#endif /* CONFIG_COAP_OPTION_INDEX */
+
 int coap_find_options(const struct coap_packet *cpkt, uint16_t code,
 		      struct coap_option *options, uint16_t veclen)
 {
@@ -792,6 +935,12 @@ int coap_find_options(const struct coap_packet *cpkt, uint16_t code,
 		return 0;
 	}
 
+#if defined(CONFIG_COAP_OPTION_INDEX)
+	if (cpkt->opt_indexed) {
+		return find_indexed_options(cpkt, code, options, veclen);
+	}
+#endif
+
 	offset = cpkt->hdr_len;
 	opt_len = 0U;
 	delta = 0U;
@@ -65,6 +65,9 @@ static void reset_internal_request(struct coap_client_internal_request *request)
 	request->last_id = 0;
 	request->retry_count = 0;
 	reset_block_contexts(request);
+#if CONFIG_COAP_CLIENT_BLOCK_WINDOW > 1
+	request->window_active = false;
+#endif
 }
 
 static int coap_client_schedule_poll(struct coap_client *client, int sock,
@@ -286,6 +289,20 @@ static int coap_client_init_request(struct coap_client *client,
 		}
 	}
 
+#if CONFIG_COAP_CLIENT_BLOCK_WINDOW > 1
+	/* Ask for the size of the resource, needed to pipeline the block requests */
+	if (req->method == COAP_METHOD_GET && !req->payload &&
+	    internal_req->recv_blk_ctx.current == 0) {
+		ret = coap_append_size2_option(&internal_req->request,
+					       &internal_req->recv_blk_ctx);
+
+		if (ret < 0) {
+			LOG_ERR("Failed to append size 2 option");
+			goto out;
+		}
+	}
+#endif
+
 	/* Blockwise receive ongoing, request next block. */
 	if (internal_req->recv_blk_ctx.current > 0) {
 		ret = coap_append_block2_option(&internal_req->request,
@@ -471,6 +488,293 @@ static void report_callback_error(struct coap_client_internal_request *internal_
 	}
 }
 
+#if CONFIG_COAP_CLIENT_BLOCK_WINDOW > 1
+static void window_stop(struct coap_client_internal_request *internal_req)
+{
+	internal_req->window_active = false;
+
+	for (int i = 0; i < CONFIG_COAP_CLIENT_BLOCK_WINDOW; i++) {
+		coap_pending_clear(&internal_req->window[i].pending);
+		internal_req->window[i].state = COAP_CLIENT_BLOCK_FREE;
+	}
+}
+
+static void window_finish(struct coap_client_internal_request *internal_req)
+{
+	window_stop(internal_req);
+	internal_req->request_ongoing = false;
+}
+
+static struct coap_client_block *window_block_with_id(
+	struct coap_client_internal_request *internal_req, uint16_t message_id)
+{
+	for (int i = 0; i < CONFIG_COAP_CLIENT_BLOCK_WINDOW; i++) {
+		if (internal_req->window[i].state == COAP_CLIENT_BLOCK_IN_FLIGHT &&
+		    internal_req->window[i].pending.id == message_id) {
+			return &internal_req->window[i];
+		}
+	}
+
+	return NULL;
+}
+
+static struct coap_client_block *window_block_with_num(
+	struct coap_client_internal_request *internal_req, uint32_t num,
+	enum coap_client_block_state state)
+{
+	for (int i = 0; i < CONFIG_COAP_CLIENT_BLOCK_WINDOW; i++) {
+		if (internal_req->window[i].state == state &&
+		    internal_req->window[i].num == num) {
+			return &internal_req->window[i];
+		}
+	}
+
+	return NULL;
+}
+
+static int window_send_block(struct coap_client *client,
+			     struct coap_client_internal_request *internal_req,
+			     struct coap_client_block *block, uint32_t num, bool resend)
+{
+	uint16_t block_in_bytes = coap_block_size_to_bytes(internal_req->recv_blk_ctx.block_size);
+	int ret;
+
+	k_mutex_lock(&client->send_mutex, K_FOREVER);
+
+	/* All the blocks share the token, each one gets its own message ID */
+	internal_req->last_id = resend ? block->pending.id : coap_next_id();
+	internal_req->recv_blk_ctx.current = num * block_in_bytes;
+
+	ret = coap_client_init_request(client, &internal_req->coap_request, internal_req,
+				       true);
+	if (ret < 0) {
+		LOG_ERR("Error creating a CoAP request");
+		goto out;
+	}
+
+	if (!resend) {
+		ret = coap_pending_init(&block->pending, &internal_req->request,
+					&client->address, internal_req->retry_count);
+		if (ret < 0) {
+			LOG_ERR("Error creating pending");
+			goto out;
+		}
+
+		coap_pending_cycle(&block->pending);
+		block->num = num;
+		block->state = COAP_CLIENT_BLOCK_IN_FLIGHT;
+	}
+
+	ret = send_request(client->fd, internal_req->request.data,
+			   internal_req->request.offset, 0, &client->address,
+			   client->socklen);
+	if (ret < 0) {
+		LOG_ERR("Error sending block %u request", num);
+		ret = -errno;
+	} else {
+		ret = 0;
+	}
+out:
+	k_mutex_unlock(&client->send_mutex);
+
+	return ret;
+}
+
+/* Request blocks until the window is full or every block is requested */
+static int window_fill(struct coap_client *client,
+		       struct coap_client_internal_request *internal_req)
+{
+	int ret;
+
+	for (int i = 0; i < CONFIG_COAP_CLIENT_BLOCK_WINDOW; i++) {
+		if (internal_req->window_next >= internal_req->window_blocks) {
+			break;
+		}
+
+		if (internal_req->window[i].state != COAP_CLIENT_BLOCK_FREE) {
+			continue;
+		}
+
+		ret = window_send_block(client, internal_req, &internal_req->window[i],
+					internal_req->window_next, false);
+		if (ret < 0) {
+			return ret;
+		}
+
+		internal_req->window_next++;
+	}
+
+	return 0;
+}
+
+/* Start pipelining the remaining blocks of a download once the first block
+ * told its size. Returns -ENOTSUP if the transfer has to stay sequential.
+ */
+static int window_start(struct coap_client *client,
+			struct coap_client_internal_request *internal_req,
+			const struct coap_packet *response)
+{
+	uint16_t block_in_bytes = coap_block_size_to_bytes(internal_req->recv_blk_ctx.block_size);
+	int size;
+	int ret;
+
+	if (internal_req->coap_request.payload || block_in_bytes > CONFIG_COAP_CLIENT_BLOCK_SIZE) {
+		return -ENOTSUP;
+	}
+
+	size = coap_get_option_int(response, COAP_OPTION_SIZE2);
+	if (size <= 0) {
+		return -ENOTSUP;
+	}
+
+	internal_req->window_blocks = DIV_ROUND_UP(size, block_in_bytes);
+	internal_req->window_next = internal_req->recv_blk_ctx.current / block_in_bytes;
+	internal_req->window_deliver = internal_req->window_next;
+
+	if (internal_req->window_next >= internal_req->window_blocks) {
+		return -ENOTSUP;
+	}
+
+	window_stop(internal_req);
+	internal_req->window_active = true;
+
+	ret = window_fill(client, internal_req);
+	if (ret < 0) {
+		window_stop(internal_req);
+		return ret;
+	}
+
+	return 0;
+}
+
+static void window_deliver_block(struct coap_client_internal_request *internal_req,
+				 uint8_t response_code, const uint8_t *payload, uint16_t len,
+				 bool last)
+{
+	uint16_t block_in_bytes = coap_block_size_to_bytes(internal_req->recv_blk_ctx.block_size);
+
+	internal_req->offset = internal_req->window_deliver * block_in_bytes;
+	internal_req->window_deliver++;
+
+	if (internal_req->coap_request.cb) {
+		internal_req->coap_request.cb(response_code, internal_req->offset, payload, len,
+					      last, internal_req->coap_request.user_data);
+	}
+}
+
+static int handle_window_response(struct coap_client *client,
+				  struct coap_client_internal_request *internal_req,
+				  const struct coap_packet *response, uint8_t response_code,
+				  const uint8_t *payload, uint16_t payload_len)
+{
+	struct coap_client_block *block;
+	int block_option;
+	uint32_t num;
+	bool last;
+	int ret;
+
+	block_option = coap_get_option_int(response, COAP_OPTION_BLOCK2);
+	if (block_option < 0) {
+		/* Error response to one of the blocks, it ends the transfer */
+		if (internal_req->coap_request.cb) {
+			internal_req->coap_request.cb(response_code, internal_req->offset,
+						      payload, payload_len, true,
+						      internal_req->coap_request.user_data);
+		}
+		window_finish(internal_req);
+		return 0;
+	}
+
+	num = GET_BLOCK_NUM(block_option);
+	block = window_block_with_num(internal_req, num, COAP_CLIENT_BLOCK_IN_FLIGHT);
+	if (block == NULL) {
+		LOG_DBG("Dropping duplicate block %u", num);
+		return 1;
+	}
+
+	coap_pending_clear(&block->pending);
+	last = !GET_MORE(block_option) || num + 1 >= internal_req->window_blocks;
+
+	if (num == internal_req->window_deliver) {
+		block->state = COAP_CLIENT_BLOCK_FREE;
+		window_deliver_block(internal_req, response_code, payload, payload_len, last);
+	} else {
+		/* Hold the block back until the preceding ones are delivered */
+		if (payload_len > sizeof(block->payload)) {
+			LOG_ERR("Block %u too large: %u", num, payload_len);
+			report_callback_error(internal_req, -EMSGSIZE);
+			window_finish(internal_req);
+			return -EMSGSIZE;
+		}
+
+		memcpy(block->payload, payload, payload_len);
+		block->len = payload_len;
+		block->response_code = response_code;
+		block->last = last;
+		block->state = COAP_CLIENT_BLOCK_RECEIVED;
+		last = false;
+	}
+
+	while (!last) {
+		block = window_block_with_num(internal_req, internal_req->window_deliver,
+					      COAP_CLIENT_BLOCK_RECEIVED);
+		if (block == NULL) {
+			break;
+		}
+
+		block->state = COAP_CLIENT_BLOCK_FREE;
+		last = block->last;
+		window_deliver_block(internal_req, block->response_code, block->payload,
+				     block->len, last);
+	}
+
+	if (last) {
+		window_finish(internal_req);
+		return 0;
+	}
+
+	ret = window_fill(client, internal_req);
+	if (ret < 0) {
+		report_callback_error(internal_req, ret);
+		window_finish(internal_req);
+		return ret;
+	}
+
+	return 1;
+}
+
+static int window_resend_handler(struct coap_client *client,
+				 struct coap_client_internal_request *internal_req)
+{
+	int64_t now = k_uptime_get();
+	int ret = 0;
+
+	for (int i = 0; i < CONFIG_COAP_CLIENT_BLOCK_WINDOW; i++) {
+		struct coap_client_block *block = &internal_req->window[i];
+
+		if (block->state != COAP_CLIENT_BLOCK_IN_FLIGHT ||
+		    block->pending.t0 + block->pending.timeout > now) {
+			continue;
+		}
+
+		if (!coap_pending_cycle(&block->pending)) {
+			LOG_ERR("Timeout for block %u, no more retries left", block->num);
+			report_callback_error(internal_req, -ETIMEDOUT);
+			window_finish(internal_req);
+			return -ETIMEDOUT;
+		}
+
+		LOG_DBG("Timeout for block %u, retrying send", block->num);
+		ret = window_send_block(client, internal_req, block, block->num, true);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	return ret;
+}
+#endif /* CONFIG_COAP_CLIENT_BLOCK_WINDOW > 1 */
+
 static bool timeout_expired(struct coap_client_internal_request *internal_req)
 {
 	return (internal_req->request_ongoing &&
@@ -521,6 +825,12 @@ static int coap_client_resend_handler(void)
 
 	for (int i = 0; i < num_clients; i++) {
 		for (int j = 0; j < CONFIG_COAP_CLIENT_MAX_REQUESTS; j++) {
+#if CONFIG_COAP_CLIENT_BLOCK_WINDOW > 1
+			if (clients[i]->requests[j].window_active) {
+				ret = window_resend_handler(clients[i], &clients[i]->requests[j]);
+				continue;
+			}
+#endif
 			if (timeout_expired(&clients[i]->requests[j])) {
 				ret = resend_request(clients[i], &clients[i]->requests[j]);
 			}
@@ -689,6 +999,12 @@ struct coap_client_internal_request *get_request_with_id(struct coap_client *cli
 		    client->requests[i].pending.id == message_id) {
 			return &client->requests[i];
 		}
+#if CONFIG_COAP_CLIENT_BLOCK_WINDOW > 1
+		if (client->requests[i].window_active &&
+		    window_block_with_id(&client->requests[i], message_id) != NULL) {
+			return &client->requests[i];
+		}
+#endif
 	}
 
 	return NULL;
@@ -754,6 +1070,19 @@ static int handle_response(struct coap_client *client, const struct coap_packet
 	/* Separate response coming */
 	if (payload_len == 0 && response_type == COAP_TYPE_ACK &&
 	    response_code == COAP_CODE_EMPTY) {
+#if CONFIG_COAP_CLIENT_BLOCK_WINDOW > 1
+		if (internal_req->window_active) {
+			struct coap_client_block *block =
+				window_block_with_id(internal_req, coap_header_get_id(response));
+
+			if (block != NULL) {
+				block->pending.t0 = k_uptime_get();
+				block->pending.timeout = COAP_SEPARATE_TIMEOUT;
+				block->pending.retries = 0;
+			}
+			return 1;
+		}
+#endif
 		internal_req->pending.t0 = k_uptime_get_32();
 		internal_req->pending.timeout = internal_req->pending.t0 + COAP_SEPARATE_TIMEOUT;
 		internal_req->pending.retries = 0;
@@ -787,6 +1116,18 @@ static int handle_response(struct coap_client *client, const struct coap_packet
 		coap_pending_clear(&internal_req->pending);
 	}
 
+#if CONFIG_COAP_CLIENT_BLOCK_WINDOW > 1
+	/* Blocks requested ahead are matched by their block number */
+	if (internal_req->window_active) {
+		ret = handle_window_response(client, internal_req, response, response_code,
+					     payload, payload_len);
+		if (ret <= 0) {
+			client->response_ready = false;
+		}
+		return ret;
+	}
+#endif
+
 	/* Check if block2 exists */
 	block_option = coap_get_option_int(response, COAP_OPTION_BLOCK2);
 	if (block_option > 0) {
@@ -836,6 +1177,15 @@ static int handle_response(struct coap_client *client, const struct coap_packet
 
 	/* If this wasn't last block, send the next request */
 	if (blockwise_transfer && !last_block) {
+#if CONFIG_COAP_CLIENT_BLOCK_WINDOW > 1
+		ret = window_start(client, internal_req, response);
+		if (ret == 0) {
+			return 1;
+		} else if (ret != -ENOTSUP) {
+			LOG_ERR("Error requesting blocks ahead");
+			goto fail;
+		}
+#endif
 		k_mutex_lock(&client->send_mutex, K_FOREVER);
 		ret = coap_client_init_request(client, &internal_req->coap_request, internal_req,
 					       false);
@@ -0,0 +1,198 @@
+/** @file
+ * @brief DNS resolver cache
+ *
+ * Answers received by the DNS resolver kept until their TTL expires.
+ */
+
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(net_dns_resolve, CONFIG_DNS_RESOLVER_LOG_LEVEL);
+
+#include <zephyr/kernel.h>
+#include <string.h>
+#include <strings.h>
+#include <errno.h>
+
+#include <zephyr/net/dns_resolve.h>
+#include "dns_cache.h"
+
+#define DNS_CACHE_NAME_LEN CONFIG_DNS_RESOLVER_CACHE_MAX_NAME_LEN
+
+struct dns_cache_entry {
+	/* Uptime in ms at which the entry expires, 0 if the entry is free */
+	int64_t expiry;
+	struct dns_addrinfo info;
+	enum dns_query_type type;
+	/* The name has no address of this type */
+	bool negative;
+	char query[DNS_CACHE_NAME_LEN + 1];
+};
+
+static struct dns_cache_entry dns_cache[CONFIG_DNS_RESOLVER_CACHE_MAX_ENTRIES];
+
+static K_MUTEX_DEFINE(dns_cache_lock);
+
+/* Must be invoked with cache lock held */
+static bool dns_cache_entry_valid(struct dns_cache_entry *entry, int64_t now)
+{
+	if (entry->expiry != 0 && entry->expiry <= now) {
+		NET_DBG("Cached %s expired", entry->query);
+		entry->expiry = 0;
+	}
+
+	return entry->expiry != 0;
+}
+
+static bool dns_cache_entry_match(struct dns_cache_entry *entry,
+				  const char *query, enum dns_query_type type)
+{
+	return entry->type == type &&
+	       strncasecmp(entry->query, query, sizeof(entry->query)) == 0;
+}
+
+/* Must be invoked with cache lock held */
+static struct dns_cache_entry *dns_cache_get_entry(int64_t now)
+{
+	struct dns_cache_entry *oldest = &dns_cache[0];
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(dns_cache); i++) {
+		if (!dns_cache_entry_valid(&dns_cache[i], now)) {
+			return &dns_cache[i];
+		}
+
+		if (dns_cache[i].expiry < oldest->expiry) {
+			oldest = &dns_cache[i];
+		}
+	}
+
+	/* Evict the entry that would expire first */
+	NET_DBG("Evicting cached %s", oldest->query);
+
+	return oldest;
+}
+
+void dns_cache_add(const char *query, enum dns_query_type type,
+		   const struct dns_addrinfo *info, uint32_t ttl)
+{
+	struct dns_cache_entry *entry;
+	int64_t now;
+
+	if (ttl == 0U || strlen(query) > DNS_CACHE_NAME_LEN) {
+		return;
+	}
+
+	k_mutex_lock(&dns_cache_lock, K_FOREVER);
+
+	now = k_uptime_get();
+	entry = dns_cache_get_entry(now);
+
+	entry->expiry = now + (int64_t)ttl * MSEC_PER_SEC;
+	entry->type = type;
+	entry->negative = (info == NULL);
+	strcpy(entry->query, query);
+
+	if (info) {
+		memcpy(&entry->info, info, sizeof(entry->info));
+	}
+
+	NET_DBG("Cached %s%s for %u s", query, info ? "" : " (negative)", ttl);
+
+	k_mutex_unlock(&dns_cache_lock);
+}
+
+void dns_cache_remove(const char *query, enum dns_query_type type)
+{
+	int i;
+
+	k_mutex_lock(&dns_cache_lock, K_FOREVER);
+
+	for (i = 0; i < ARRAY_SIZE(dns_cache); i++) {
+		if (dns_cache[i].expiry != 0 &&
+		    dns_cache_entry_match(&dns_cache[i], query, type)) {
+			dns_cache[i].expiry = 0;
+		}
+	}
+
+	k_mutex_unlock(&dns_cache_lock);
+}
+
+int dns_cache_find(const char *query, enum dns_query_type type,
+		   struct dns_addrinfo *info, size_t info_len)
+{
+	bool cached = false;
+	int found = 0;
+	int64_t now;
+	int i;
+
+	if (strlen(query) > DNS_CACHE_NAME_LEN) {
+		return -ENOENT;
+	}
+
+	k_mutex_lock(&dns_cache_lock, K_FOREVER);
+
+	now = k_uptime_get();
+
+	for (i = 0; i < ARRAY_SIZE(dns_cache); i++) {
+		struct dns_cache_entry *entry = &dns_cache[i];
+
+		if (!dns_cache_entry_valid(entry, now) ||
+		    !dns_cache_entry_match(entry, query, type)) {
+			continue;
+		}
+
+		cached = true;
+
+		if (entry->negative || found >= info_len) {
+			continue;
+		}
+
+		memcpy(&info[found++], &entry->info, sizeof(*info));
+	}
+
+	k_mutex_unlock(&dns_cache_lock);
+
+	return cached ? found : -ENOENT;
+}
+
+void dns_cache_foreach(dns_cache_cb_t cb, void *user_data)
+{
+	int64_t now;
+	int i;
+
+	k_mutex_lock(&dns_cache_lock, K_FOREVER);
+
+	now = k_uptime_get();
+
+	for (i = 0; i < ARRAY_SIZE(dns_cache); i++) {
+		struct dns_cache_entry *entry = &dns_cache[i];
+
+		if (!dns_cache_entry_valid(entry, now)) {
+			continue;
+		}
+
+		cb(entry->query, entry->type,
+		   entry->negative ? NULL : &entry->info,
+		   (uint32_t)((entry->expiry - now) / MSEC_PER_SEC), user_data);
+	}
+
+	k_mutex_unlock(&dns_cache_lock);
+}
+
+void dns_cache_flush(void)
+{
+	int i;
+
+	k_mutex_lock(&dns_cache_lock, K_FOREVER);
+
+	for (i = 0; i < ARRAY_SIZE(dns_cache); i++) {
+		dns_cache[i].expiry = 0;
+	}
+
+	k_mutex_unlock(&dns_cache_lock);
+}
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef DNS_CACHE_H_
+#define DNS_CACHE_H_
+
+#include <errno.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <zephyr/net/dns_resolve.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(CONFIG_DNS_RESOLVER_CACHE)
+/**
+ * @brief Add an answer to the DNS cache
+ *
+ * @param query Name that was resolved
+ * @param type Type of the query
+ * @param info Address of the answer, or NULL to remember that the name
+ *             has no address of this type
+ * @param ttl Time to live of the answer in seconds, nothing is cached if 0
+ */
+void dns_cache_add(const char *query, enum dns_query_type type,
+		   const struct dns_addrinfo *info, uint32_t ttl);
+
+/**
+ * @brief Remove the cached answers of a name
+ *
+ * @param query Name to remove
+ * @param type Type of the query
+ */
+void dns_cache_remove(const char *query, enum dns_query_type type);
+
+/**
+ * @brief Look up the cached answers of a name
+ *
+ * @param query Name to look up
+ * @param type Type of the query
+ * @param info Array receiving the cached addresses
+ * @param info_len Number of elements in @a info
+ *
+ * @return Number of addresses copied to @a info, 0 if the name is known
+ *         to have no address, or -ENOENT if nothing is cached
+ */
+int dns_cache_find(const char *query, enum dns_query_type type,
+		   struct dns_addrinfo *info, size_t info_len);
+#else
+static inline void dns_cache_add(const char *query, enum dns_query_type type,
+				 const struct dns_addrinfo *info, uint32_t ttl)
+{
+	ARG_UNUSED(query);
+	ARG_UNUSED(type);
+	ARG_UNUSED(info);
+	ARG_UNUSED(ttl);
+}
+
+static inline void dns_cache_remove(const char *query,
+				    enum dns_query_type type)
+{
+	ARG_UNUSED(query);
+	ARG_UNUSED(type);
+}
+
+static inline int dns_cache_find(const char *query, enum dns_query_type type,
+				 struct dns_addrinfo *info, size_t info_len)
+{
+	ARG_UNUSED(query);
+	ARG_UNUSED(type);
+	ARG_UNUSED(info);
+	ARG_UNUSED(info_len);
+
+	return -ENOENT;
+}
+#endif /* CONFIG_DNS_RESOLVER_CACHE */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DNS_CACHE_H_ */
@@ -26,6 +26,7 @@ LOG_MODULE_REGISTER(net_dns_resolve, CONFIG_DNS_RESOLVER_LOG_LEVEL);
 #include <zephyr/net/dns_resolve.h>
 #include "dns_pack.h"
 #include "dns_internal.h"
+#include "dns_cache.h"
 
 #define DNS_SERVER_COUNT CONFIG_DNS_RESOLVER_MAX_SERVERS
 #define SERVER_COUNT     (DNS_SERVER_COUNT + DNS_MAX_MCAST_SERVERS)
@@ -472,7 +473,7 @@ int dns_validate_msg(struct dns_resolve_context *ctx,
 		     uint16_t *query_hash)
 {
 	struct dns_addrinfo info = { 0 };
-	uint32_t ttl; /* RR ttl, so far it is not passed to caller */
+	uint32_t ttl; /* RR ttl, only used by the cache */
 	uint8_t *src, *addr;
 	const char *query_name;
 	int address_size;
@@ -633,6 +634,15 @@ query_known:
 			src = dns_msg->msg + dns_msg->response_position;
 			memcpy(addr, src, address_size);
 
+			if (items == 0) {
+				dns_cache_remove(ctx->queries[*query_idx].query,
+						 ctx->queries[*query_idx].query_type);
+			}
+
+			dns_cache_add(ctx->queries[*query_idx].query,
+				      ctx->queries[*query_idx].query_type,
+				      &info, ttl);
+
 			invoke_query_callback(DNS_EAI_INPROGRESS, &info,
 					      &ctx->queries[*query_idx]);
 			items++;
@@ -701,6 +711,14 @@ query_known:
 	}
 
 	if (items == 0) {
+#if defined(CONFIG_DNS_RESOLVER_CACHE)
+		dns_cache_remove(ctx->queries[*query_idx].query,
+				 ctx->queries[*query_idx].query_type);
+		dns_cache_add(ctx->queries[*query_idx].query,
+			      ctx->queries[*query_idx].query_type,
+			      NULL, CONFIG_DNS_RESOLVER_CACHE_NEGATIVE_TTL);
+#endif
+
 		ret = DNS_EAI_NODATA;
 	} else {
 		ret = DNS_EAI_ALLDONE;
@@ -1105,6 +1123,35 @@ static void query_timeout(struct k_work *work)
 	k_mutex_unlock(&pending_query->ctx->lock);
 }
 
+static int dns_resolve_from_cache(const char *query,
+				  enum dns_query_type type,
+				  dns_resolve_cb_t cb,
+				  void *user_data)
+{
+	struct dns_addrinfo info[CONFIG_DNS_RESOLVER_AI_MAX_ENTRIES];
+	int count, i;
+
+	count = dns_cache_find(query, type, info, ARRAY_SIZE(info));
+	if (count < 0) {
+		return count;
+	}
+
+	NET_DBG("Resolved %s from cache (%d addresses)", query, count);
+
+	if (count == 0) {
+		cb(DNS_EAI_NODATA, NULL, user_data);
+		return 0;
+	}
+
+	for (i = 0; i < count; i++) {
+		cb(DNS_EAI_INPROGRESS, &info[i], user_data);
+	}
+
+	cb(DNS_EAI_ALLDONE, NULL, user_data);
+
+	return 0;
+}
+
 int dns_resolve_name(struct dns_resolve_context *ctx,
 		     const char *query,
 		     enum dns_query_type type,
@@ -1182,6 +1229,15 @@ int dns_resolve_name(struct dns_resolve_context *ctx,
 	}
 
 try_resolve:
+	if (IS_ENABLED(CONFIG_DNS_RESOLVER_CACHE) &&
+	    dns_resolve_from_cache(query, type, cb, user_data) == 0) {
+		if (dns_id) {
+			*dns_id = 0U;
+		}
+
+		return 0;
+	}
+
 	k_mutex_lock(&ctx->lock, K_FOREVER);
 
 	if (ctx->state != DNS_RESOLVE_CONTEXT_ACTIVE) {
@@ -0,0 +1,844 @@
+/** @file
+ * @brief HTTP server
+ *
+ * HTTP/1.1 server for the services defined with HTTP_SERVICE_DEFINE().
+ */
+
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_http_server, CONFIG_NET_HTTP_LOG_LEVEL);
+
+#include <zephyr/kernel.h>
+#include <string.h>
+#include <errno.h>
+#include <stdbool.h>
+#include <stdarg.h>
+#include <stdio.h>
+
+#include <zephyr/net/net_ip.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/net/http/server.h>
+#include <zephyr/net/http/status.h>
+
+#if defined(CONFIG_HTTP_SERVER_FS)
+#include <zephyr/fs/fs.h>
+#endif
+
+#define MAX_HEADER_LEN 192
+#define CHUNK_HEADER_LEN 10
+
+/* Control socket, listening sockets and client sockets */
+#define MAX_FDS (1 + CONFIG_HTTP_SERVER_MAX_SERVICES + \
+		 CONFIG_HTTP_SERVER_MAX_CLIENTS)
+
+static K_THREAD_STACK_DEFINE(http_server_stack, CONFIG_HTTP_SERVER_STACK_SIZE);
+static struct k_thread http_server_thread_data;
+static K_MUTEX_DEFINE(http_server_lock);
+static bool http_server_running;
+
+/* Written by http_server_stop() to wake up the server thread */
+static int ctrl_sock[2] = { -1, -1 };
+
+static struct {
+	const struct http_service_desc *service;
+	int fd;
+} listeners[CONFIG_HTTP_SERVER_MAX_SERVICES];
+static int num_listeners;
+
+static struct http_client_ctx clients[CONFIG_HTTP_SERVER_MAX_CLIENTS];
+
+/* Only used from the server thread */
+static char header_buf[MAX_HEADER_LEN];
+#if defined(CONFIG_HTTP_SERVER_FS)
+static uint8_t fs_buf[CONFIG_HTTP_SERVER_FS_BUFFER_SIZE];
+#endif
+
+static const char *status_str(uint16_t status)
+{
+	switch (status) {
+	case HTTP_200_OK:
+		return "OK";
+	case HTTP_400_BAD_REQUEST:
+		return "Bad Request";
+	case HTTP_404_NOT_FOUND:
+		return "Not Found";
+	case HTTP_405_METHOD_NOT_ALLOWED:
+		return "Method Not Allowed";
+	case HTTP_414_URI_TOO_LONG:
+		return "URI Too Long";
+	case HTTP_503_SERVICE_UNAVAILABLE:
+		return "Service Unavailable";
+	default:
+		return "Internal Server Error";
+	}
+}
+
+static int sendv_all(int sock, struct iovec *iov, int iovcnt)
+{
+	struct msghdr msg = { 0 };
+	ssize_t out_len;
+
+	while (iovcnt > 0) {
+		msg.msg_iov = iov;
+		msg.msg_iovlen = iovcnt;
+
+		out_len = zsock_sendmsg(sock, &msg, 0);
+		if (out_len < 0) {
+			return -errno;
+		}
+
+		while (iovcnt > 0 && out_len >= iov->iov_len) {
+			out_len -= iov->iov_len;
+			iov++;
+			iovcnt--;
+		}
+
+		if (iovcnt > 0) {
+			iov->iov_base = (uint8_t *)iov->iov_base + out_len;
+			iov->iov_len -= out_len;
+		}
+	}
+
+	return 0;
+}
+
+static int sendall(int sock, const void *buf, size_t len)
+{
+	struct iovec iov = {
+		.iov_base = (void *)buf,
+		.iov_len = len,
+	};
+
+	return sendv_all(sock, &iov, 1);
+}
+
+static int header_append(int len, const char *fmt, ...)
+{
+	va_list ap;
+
+	if (len < 0 || len >= sizeof(header_buf)) {
+		return -ENOMEM;
+	}
+
+	va_start(ap, fmt);
+	len += vsnprintk(header_buf + len, sizeof(header_buf) - len, fmt, ap);
+	va_end(ap);
+
+	return len;
+}
+
+/* Format the response header, content_len < 0 selects chunked encoding.
+ * HTTP/1.0 clients do not understand chunked encoding, they get an identity
+ * body delimited by closing the connection instead.
+ */
+static int format_header(struct http_client_ctx *client, uint16_t status,
+			 ssize_t content_len)
+{
+	const struct http_resource_detail *detail =
+		status == HTTP_200_OK ? client->resource : NULL;
+	int len;
+
+	len = header_append(0, "HTTP/1.1 %u %s\r\n", status, status_str(status));
+
+	if (detail != NULL && detail->content_type != NULL) {
+		len = header_append(len, "Content-Type: %s\r\n",
+				    detail->content_type);
+	}
+
+	if (detail != NULL && detail->content_encoding != NULL) {
+		len = header_append(len, "Content-Encoding: %s\r\n",
+				    detail->content_encoding);
+	}
+
+	if (content_len < 0 && client->http_1_0) {
+		client->keep_alive = false;
+	} else if (content_len < 0) {
+		len = header_append(len, "Transfer-Encoding: chunked\r\n");
+	} else {
+		len = header_append(len, "Content-Length: %zd\r\n", content_len);
+	}
+
+	len = header_append(len, "%s\r\n",
+			    client->keep_alive ? "" : "Connection: close\r\n");
+	if (len < 0 || len >= sizeof(header_buf)) {
+		NET_ERR("Response header too long");
+		return -ENOMEM;
+	}
+
+	client->response_started = true;
+
+	return len;
+}
+
+static int send_response(struct http_client_ctx *client, uint16_t status,
+			 const void *body, size_t body_len)
+{
+	struct iovec iov[2];
+	int len;
+
+	len = format_header(client, status, body_len);
+	if (len < 0) {
+		return len;
+	}
+
+	iov[0].iov_base = header_buf;
+	iov[0].iov_len = len;
+	iov[1].iov_base = (void *)body;
+	iov[1].iov_len = client->method == HTTP_HEAD ? 0 : body_len;
+
+	return sendv_all(client->fd, iov, ARRAY_SIZE(iov));
+}
+
+static int send_error(struct http_client_ctx *client, uint16_t status)
+{
+	return send_response(client, status, NULL, 0);
+}
+
+int http_server_send_chunk(struct http_client_ctx *client, const void *data,
+			   size_t len)
+{
+	char chunk_header[CHUNK_HEADER_LEN + 1];
+	struct iovec iov[3];
+	int ret;
+
+	if (!client->response_started) {
+		ret = format_header(client, HTTP_200_OK, -1);
+		if (ret < 0) {
+			return ret;
+		}
+
+		ret = sendall(client->fd, header_buf, ret);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	if (len == 0 || client->method == HTTP_HEAD) {
+		return 0;
+	}
+
+	if (client->http_1_0) {
+		return sendall(client->fd, data, len);
+	}
+
+	iov[0].iov_base = chunk_header;
+	iov[0].iov_len = snprintk(chunk_header, sizeof(chunk_header),
+				  "%zx\r\n", len);
+	iov[1].iov_base = (void *)data;
+	iov[1].iov_len = len;
+	iov[2].iov_base = "\r\n";
+	iov[2].iov_len = 2;
+
+	return sendv_all(client->fd, iov, ARRAY_SIZE(iov));
+}
+
+static int serve_dynamic(struct http_client_ctx *client)
+{
+	const struct http_resource_detail_dynamic *detail =
+		CONTAINER_OF(client->resource,
+			     struct http_resource_detail_dynamic, common);
+	int ret;
+
+	ret = detail->cb(client, NULL, 0, true, detail->user_data);
+	if (ret < 0) {
+		return client->response_started ? ret :
+			send_error(client, HTTP_500_INTERNAL_SERVER_ERROR);
+	}
+
+	ret = http_server_send_chunk(client, NULL, 0);
+	if (ret < 0 || client->method == HTTP_HEAD || client->http_1_0) {
+		return ret;
+	}
+
+	return sendall(client->fd, "0\r\n\r\n", 5);
+}
+
+#if defined(CONFIG_HTTP_SERVER_FS)
+static int serve_fs(struct http_client_ctx *client)
+{
+	const struct http_resource_detail_fs *detail =
+		CONTAINER_OF(client->resource, struct http_resource_detail_fs,
+			     common);
+	struct fs_dirent entry;
+	struct fs_file_t file;
+	ssize_t len;
+	int ret;
+
+	fs_file_t_init(&file);
+
+	if (fs_stat(detail->path, &entry) < 0 || entry.type != FS_DIR_ENTRY_FILE ||
+	    fs_open(&file, detail->path, FS_O_READ) < 0) {
+		NET_DBG("Cannot open %s", detail->path);
+		return send_error(client, HTTP_404_NOT_FOUND);
+	}
+
+	ret = format_header(client, HTTP_200_OK, entry.size);
+	if (ret < 0) {
+		goto out;
+	}
+
+	ret = sendall(client->fd, header_buf, ret);
+	if (ret < 0 || client->method == HTTP_HEAD) {
+		goto out;
+	}
+
+	/* Stream the file to the socket without staging it as a whole */
+	while ((len = fs_read(&file, fs_buf, sizeof(fs_buf))) > 0) {
+		ret = sendall(client->fd, fs_buf, len);
+		if (ret < 0) {
+			goto out;
+		}
+	}
+
+	if (len < 0) {
+		NET_ERR("Cannot read %s (%zd)", detail->path, len);
+		ret = len;
+	}
+
+out:
+	fs_close(&file);
+
+	return ret;
+}
+#endif /* CONFIG_HTTP_SERVER_FS */
+
+static int serve_resource(struct http_client_ctx *client)
+{
+	const struct http_resource_detail_static *detail_static;
+
+	switch (client->resource->type) {
+	case HTTP_RESOURCE_TYPE_STATIC:
+		detail_static = CONTAINER_OF(client->resource,
+					     struct http_resource_detail_static,
+					     common);
+		return send_response(client, HTTP_200_OK,
+				     detail_static->static_data,
+				     detail_static->static_data_len);
+	case HTTP_RESOURCE_TYPE_DYNAMIC:
+		return serve_dynamic(client);
+#if defined(CONFIG_HTTP_SERVER_FS)
+	case HTTP_RESOURCE_TYPE_FS:
+		return serve_fs(client);
+#endif
+	default:
+		return send_error(client, HTTP_500_INTERNAL_SERVER_ERROR);
+	}
+}
+
+static const struct http_resource_detail *
+find_resource(const struct http_service_desc *service, const char *path)
+{
+	if (service->res_begin == NULL) {
+		return NULL;
+	}
+
+	HTTP_SERVICE_FOREACH_RESOURCE(service, res) {
+		if (strcmp(res->resource, path) == 0) {
+			return res->detail;
+		}
+	}
+
+	return NULL;
+}
+
+static int on_message_begin(struct http_parser *parser)
+{
+	struct http_client_ctx *client = parser->data;
+
+	client->resource = NULL;
+	client->url_len = 0;
+	client->status = 0;
+	client->keep_alive = true;
+	client->http_1_0 = false;
+	client->response_started = false;
+	client->url_overflow = false;
+
+	return 0;
+}
+
+static int on_url(struct http_parser *parser, const char *at, size_t length)
+{
+	struct http_client_ctx *client = parser->data;
+
+	if (client->url_len + length > HTTP_SERVER_MAX_URL_LENGTH) {
+		client->url_overflow = true;
+		return 0;
+	}
+
+	memcpy(client->url + client->url_len, at, length);
+	client->url_len += length;
+
+	return 0;
+}
+
+static int on_headers_complete(struct http_parser *parser)
+{
+	struct http_client_ctx *client = parser->data;
+	char *query;
+
+	client->method = parser->method;
+	client->http_1_0 = parser->http_major == 1 && parser->http_minor == 0;
+
+	/* A dynamic resource may start its response while the body is
+	 * received, the header must already reflect the connection type.
+	 */
+	client->keep_alive = http_should_keep_alive(parser);
+
+	if (client->url_overflow) {
+		client->status = HTTP_414_URI_TOO_LONG;
+		return 0;
+	}
+
+	client->url[client->url_len] = '\0';
+
+	query = strchr(client->url, '?');
+	if (query != NULL) {
+		*query = '\0';
+	}
+
+	client->resource = find_resource(client->service, client->url);
+	if (client->resource == NULL) {
+		client->status = HTTP_404_NOT_FOUND;
+	} else if (client->method >= 32 ||
+		   !(client->resource->bitmask_of_supported_http_methods &
+		     BIT(client->method))) {
+		client->status = HTTP_405_METHOD_NOT_ALLOWED;
+	}
+
+	NET_DBG("[%d] %s %s", client->fd, http_method_str(client->method),
+		client->url);
+
+	return 0;
+}
+
+static int on_body(struct http_parser *parser, const char *at, size_t length)
+{
+	struct http_client_ctx *client = parser->data;
+	const struct http_resource_detail_dynamic *detail;
+
+	if (client->status != 0 ||
+	    client->resource->type != HTTP_RESOURCE_TYPE_DYNAMIC) {
+		return 0;
+	}
+
+	detail = CONTAINER_OF(client->resource,
+			      struct http_resource_detail_dynamic, common);
+
+	if (detail->cb(client, (const uint8_t *)at, length, false,
+		       detail->user_data) < 0) {
+		if (client->response_started) {
+			return -1;
+		}
+
+		client->status = HTTP_500_INTERNAL_SERVER_ERROR;
+	}
+
+	return 0;
+}
+
+static int on_message_complete(struct http_parser *parser)
+{
+	struct http_client_ctx *client = parser->data;
+	int ret;
+
+	if (!http_should_keep_alive(parser)) {
+		client->keep_alive = false;
+	}
+
+	if (client->status != 0) {
+		ret = send_error(client, client->status);
+	} else {
+		ret = serve_resource(client);
+	}
+
+	if (ret < 0) {
+		NET_DBG("[%d] Cannot send response (%d)", client->fd, ret);
+		return -1;
+	}
+
+	return 0;
+}
+
+static const struct http_parser_settings parser_settings = {
+	.on_message_begin = on_message_begin,
+	.on_url = on_url,
+	.on_headers_complete = on_headers_complete,
+	.on_body = on_body,
+	.on_message_complete = on_message_complete,
+};
+
+static void client_close(struct http_client_ctx *client)
+{
+	NET_DBG("[%d] Closing connection", client->fd);
+
+	zsock_close(client->fd);
+	client->fd = -1;
+	client->service = NULL;
+}
+
+static void client_recv(struct http_client_ctx *client)
+{
+	ssize_t len;
+
+	len = zsock_recv(client->fd, client->buffer, sizeof(client->buffer), 0);
+	if (len <= 0) {
+		if (len < 0) {
+			NET_DBG("[%d] Receive error (%d)", client->fd, -errno);
+		}
+
+		client_close(client);
+		return;
+	}
+
+	client->last_activity = k_uptime_get();
+
+	/* Pipelined requests are answered in order, the parser invokes the
+	 * callbacks of each message found in the segment.
+	 */
+	(void)http_parser_execute(&client->parser, &parser_settings,
+				  (const char *)client->buffer, len);
+
+	if (HTTP_PARSER_ERRNO(&client->parser) != HPE_OK) {
+		NET_DBG("[%d] Parse error %s", client->fd,
+			http_errno_name(HTTP_PARSER_ERRNO(&client->parser)));
+
+		if (!client->response_started) {
+			client->keep_alive = false;
+			(void)send_error(client, HTTP_400_BAD_REQUEST);
+		}
+
+		client_close(client);
+		return;
+	}
+
+	if (!client->keep_alive) {
+		client_close(client);
+	}
+}
+
+static void client_accept(const struct http_service_desc *service,
+			  int listen_fd)
+{
+	static const char busy[] = "HTTP/1.1 503 Service Unavailable\r\n"
+				   "Content-Length: 0\r\n"
+				   "Connection: close\r\n\r\n";
+	struct http_client_ctx *client = NULL;
+	size_t service_clients = 0;
+	int fd;
+
+	fd = zsock_accept(listen_fd, NULL, NULL);
+	if (fd < 0) {
+		NET_DBG("Accept failed (%d)", -errno);
+		return;
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(clients); i++) {
+		struct http_client_ctx *ctx = &clients[i];
+
+		if (ctx->fd < 0) {
+			if (client == NULL) {
+				client = ctx;
+			}
+		} else if (ctx->service == service) {
+			service_clients++;
+		}
+	}
+
+	if (client == NULL ||
+	    (service->concurrent > 0 && service_clients >= service->concurrent)) {
+		NET_DBG("No free connection for service %s", service->host);
+		(void)sendall(fd, busy, sizeof(busy) - 1);
+		zsock_close(fd);
+		return;
+	}
+
+	client->fd = fd;
+	client->service = service;
+	client->resource = NULL;
+	client->response_started = false;
+	client->keep_alive = true;
+	client->last_activity = k_uptime_get();
+
+	http_parser_init(&client->parser, HTTP_REQUEST);
+	client->parser.data = client;
+
+	NET_DBG("[%d] Connection accepted for service %s", fd, service->host);
+}
+
+/* Poll timeout until the next idle connection expires, -1 if none */
+static int idle_timeout(void)
+{
+	int64_t now = k_uptime_get();
+	int64_t timeout = -1;
+
+	if (CONFIG_HTTP_SERVER_IDLE_TIMEOUT == 0) {
+		return -1;
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(clients); i++) {
+		struct http_client_ctx *client = &clients[i];
+		int64_t remaining;
+
+		if (client->fd < 0) {
+			continue;
+		}
+
+		remaining = client->last_activity +
+			    CONFIG_HTTP_SERVER_IDLE_TIMEOUT - now;
+		if (remaining <= 0) {
+			NET_DBG("[%d] Connection idle", client->fd);
+			client_close(client);
+			continue;
+		}
+
+		if (timeout < 0 || remaining < timeout) {
+			timeout = remaining;
+		}
+	}
+
+	return (int)timeout;
+}
+
+static void http_server_thread(void *p1, void *p2, void *p3)
+{
+	struct zsock_pollfd fds[MAX_FDS];
+	struct http_client_ctx *polled[CONFIG_HTTP_SERVER_MAX_CLIENTS];
+	int num_polled;
+	int ret;
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		int timeout = idle_timeout();
+		int nfds = 0;
+
+		fds[nfds].fd = ctrl_sock[0];
+		fds[nfds++].events = ZSOCK_POLLIN;
+
+		for (int i = 0; i < num_listeners; i++) {
+			fds[nfds].fd = listeners[i].fd;
+			fds[nfds++].events = ZSOCK_POLLIN;
+		}
+
+		num_polled = 0;
+
+		for (int i = 0; i < ARRAY_SIZE(clients); i++) {
+			struct http_client_ctx *client = &clients[i];
+
+			if (client->fd < 0) {
+				continue;
+			}
+
+			polled[num_polled++] = client;
+			fds[nfds].fd = client->fd;
+			fds[nfds++].events = ZSOCK_POLLIN;
+		}
+
+		ret = zsock_poll(fds, nfds, timeout);
+		if (ret < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+
+			NET_ERR("Poll failed (%d)", -errno);
+			break;
+		}
+
+		if (fds[0].revents != 0) {
+			break;
+		}
+
+		for (int i = 0; i < num_listeners; i++) {
+			if (fds[1 + i].revents & ZSOCK_POLLIN) {
+				client_accept(listeners[i].service,
+					      listeners[i].fd);
+			}
+		}
+
+		for (int i = 0; i < num_polled; i++) {
+			short revents = fds[1 + num_listeners + i].revents;
+
+			if (revents & ZSOCK_POLLIN) {
+				client_recv(polled[i]);
+			} else if (revents & (ZSOCK_POLLERR | ZSOCK_POLLHUP |
+					      ZSOCK_POLLNVAL)) {
+				client_close(polled[i]);
+			}
+		}
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(clients); i++) {
+		struct http_client_ctx *client = &clients[i];
+
+		if (client->fd >= 0) {
+			client_close(client);
+		}
+	}
+}
+
+static int listener_setup(const struct http_service_desc *service)
+{
+	struct sockaddr_storage addr_storage = { 0 };
+	struct sockaddr *addr = (struct sockaddr *)&addr_storage;
+	socklen_t addrlen = sizeof(struct sockaddr_in);
+	uint16_t port = *service->port;
+	int fd;
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) &&
+	    zsock_inet_pton(AF_INET, service->host,
+			    &net_sin(addr)->sin_addr) == 1) {
+		addr->sa_family = AF_INET;
+		net_sin(addr)->sin_port = htons(port);
+	} else if (IS_ENABLED(CONFIG_NET_IPV6)) {
+		/* A host name is served on any address */
+		if (zsock_inet_pton(AF_INET6, service->host,
+				    &net_sin6(addr)->sin6_addr) != 1) {
+			net_ipaddr_copy(&net_sin6(addr)->sin6_addr,
+					&in6addr_any);
+		}
+
+		addr->sa_family = AF_INET6;
+		net_sin6(addr)->sin6_port = htons(port);
+		addrlen = sizeof(struct sockaddr_in6);
+	} else {
+		addr->sa_family = AF_INET;
+		net_sin(addr)->sin_addr.s_addr = INADDR_ANY;
+		net_sin(addr)->sin_port = htons(port);
+	}
+
+	fd = zsock_socket(addr->sa_family, SOCK_STREAM, IPPROTO_TCP);
+	if (fd < 0) {
+		NET_ERR("Cannot create socket for %s (%d)", service->host,
+			-errno);
+		return -errno;
+	}
+
+	if (zsock_bind(fd, addr, addrlen) < 0 ||
+	    zsock_listen(fd, MAX(service->backlog, 1)) < 0) {
+		NET_ERR("Cannot listen on %s:%u (%d)", service->host, port,
+			-errno);
+		zsock_close(fd);
+		return -errno;
+	}
+
+	if (port == 0) {
+		/* Report the ephemeral port back to the service definition */
+		addrlen = sizeof(addr_storage);
+		if (zsock_getsockname(fd, addr, &addrlen) == 0) {
+			*service->port = ntohs(net_sin(addr)->sin_port);
+		}
+	}
+
+	NET_DBG("Listening on %s:%u", service->host, *service->port);
+
+	return fd;
+}
+
+static void listeners_close(void)
+{
+	for (int i = 0; i < num_listeners; i++) {
+		zsock_close(listeners[i].fd);
+	}
+
+	num_listeners = 0;
+}
+
+int http_server_start(void)
+{
+	int ret = 0;
+	int fd;
+
+	k_mutex_lock(&http_server_lock, K_FOREVER);
+
+	if (http_server_running) {
+		ret = -EALREADY;
+		goto out;
+	}
+
+	HTTP_SERVICE_FOREACH(service) {
+		if (num_listeners >= ARRAY_SIZE(listeners)) {
+			NET_ERR("Too many services, see "
+				"CONFIG_HTTP_SERVER_MAX_SERVICES");
+			ret = -ENOMEM;
+			goto error;
+		}
+
+		fd = listener_setup(service);
+		if (fd < 0) {
+			ret = fd;
+			goto error;
+		}
+
+		listeners[num_listeners].service = service;
+		listeners[num_listeners++].fd = fd;
+	}
+
+	if (zsock_socketpair(AF_UNIX, SOCK_STREAM, 0, ctrl_sock) < 0) {
+		ret = -errno;
+		goto error;
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(clients); i++) {
+		struct http_client_ctx *client = &clients[i];
+
+		client->fd = -1;
+		client->service = NULL;
+	}
+
+	k_thread_create(&http_server_thread_data, http_server_stack,
+			K_THREAD_STACK_SIZEOF(http_server_stack),
+			http_server_thread, NULL, NULL, NULL,
+			K_PRIO_PREEMPT(CONFIG_NUM_PREEMPT_PRIORITIES - 1), 0,
+			K_NO_WAIT);
+	k_thread_name_set(&http_server_thread_data, "http_server");
+
+	http_server_running = true;
+	goto out;
+
+error:
+	listeners_close();
+out:
+	k_mutex_unlock(&http_server_lock);
+
+	return ret;
+}
+
+int http_server_stop(void)
+{
+	int ret = 0;
+	char c = 0;
+
+	k_mutex_lock(&http_server_lock, K_FOREVER);
+
+	if (!http_server_running) {
+		ret = -EALREADY;
+		goto out;
+	}
+
+	if (zsock_send(ctrl_sock[1], &c, sizeof(c), 0) < 0) {
+		ret = -errno;
+		goto out;
+	}
+
+	(void)k_thread_join(&http_server_thread_data, K_FOREVER);
+
+	zsock_close(ctrl_sock[0]);
+	zsock_close(ctrl_sock[1]);
+	ctrl_sock[0] = -1;
+	ctrl_sock[1] = -1;
+
+	listeners_close();
+	http_server_running = false;
+
+out:
+	k_mutex_unlock(&http_server_lock);
+
+	return ret;
+}
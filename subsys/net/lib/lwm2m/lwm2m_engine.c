@@ -539,6 +539,7 @@ int lwm2m_socket_add(struct lwm2m_ctx *ctx)
 	sock_fds[sock_nfds].events = ZSOCK_POLLIN;
 	sock_nfds++;
 
+	lwm2m_observer_index_invalidate();
 	lwm2m_engine_wake_up();
 
 	return 0;
@@ -576,25 +577,56 @@ void lwm2m_socket_del(struct lwm2m_ctx *ctx)
 		/* Remove the last entry. */
 		sock_ctx[sock_nfds] = NULL;
 		sock_fds[sock_nfds].fd = -1;
+		lwm2m_observer_index_invalidate();
 		break;
 	}
 	lwm2m_engine_wake_up();
 }
 
+#if defined(CONFIG_LWM2M_NOTIFY_COALESCE)
+static bool notifications_due(struct lwm2m_ctx *ctx, const int64_t timestamp)
+{
+	struct observe_node *obs;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&ctx->observer, obs, node) {
+		if (obs->event_timestamp && timestamp >= obs->event_timestamp &&
+		    !obs->active_tx_operation) {
+			return true;
+		}
+	}
+
+	return false;
+}
+#endif
+
 static void check_notifications(struct lwm2m_ctx *ctx, const int64_t timestamp)
 {
 	struct observe_node *obs;
+	int64_t due = timestamp;
 	int rc;
 
 	lwm2m_registry_lock();
+#if defined(CONFIG_LWM2M_NOTIFY_COALESCE)
+	/* Send the notifications becoming due soon along with a due one */
+	if (notifications_due(ctx, timestamp)) {
+		due = timestamp + CONFIG_LWM2M_NOTIFY_COALESCE_WINDOW_MS;
+	}
+#endif
 	SYS_SLIST_FOR_EACH_CONTAINER(&ctx->observer, obs, node) {
-		if (!obs->event_timestamp || timestamp < obs->event_timestamp) {
+		if (!obs->event_timestamp || due < obs->event_timestamp) {
 			continue;
 		}
 		/* Check That There is not pending process*/
 		if (obs->active_tx_operation) {
 			continue;
 		}
+#if defined(CONFIG_LWM2M_NOTIFY_COALESCE)
+		/* Sending ahead of time must still honor the minimum period */
+		if (timestamp < obs->event_timestamp &&
+		    !engine_observe_pmin_elapsed(obs, ctx->srv_obj_inst, timestamp)) {
+			continue;
+		}
+#endif
 
 		rc = generate_notify_message(ctx, obs, NULL);
 		if (rc == -ENOMEM) {
@@ -604,7 +636,7 @@ static void check_notifications(struct lwm2m_ctx *ctx, const int64_t timestamp)
 		obs->event_timestamp =
 			engine_observe_shedule_next_event(obs, ctx->srv_obj_inst, timestamp);
 		obs->last_timestamp = timestamp;
-		if (!rc) {
+		if (!rc && !IS_ENABLED(CONFIG_LWM2M_NOTIFY_COALESCE)) {
 			/* create at most one notification */
 			goto cleanup;
 		}
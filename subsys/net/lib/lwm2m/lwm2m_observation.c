@@ -185,6 +185,165 @@ static bool lwm2m_notify_observer_list(sys_slist_t *path_list, const struct lwm2
 	return false;
 }
 
+#if defined(CONFIG_LWM2M_ENGINE_INDEX)
+#if defined(CONFIG_LWM2M_VERSION_1_1)
+#define OBSERVE_INDEX_SIZE (CONFIG_LWM2M_ENGINE_MAX_OBSERVER * 3)
+#define OBSERVE_INDEX_MAX_LEVEL LWM2M_PATH_LEVEL_RESOURCE_INST
+#else
+#define OBSERVE_INDEX_SIZE CONFIG_LWM2M_ENGINE_MAX_OBSERVER
+#define OBSERVE_INDEX_MAX_LEVEL LWM2M_PATH_LEVEL_RESOURCE
+#endif
+
+/* Observed path, the index is sorted so that a path comes right before
+ * the paths below it, like a flattened path trie.
+ */
+struct observe_index_entry {
+	struct lwm2m_obj_path path;
+	uint8_t obs;
+};
+
+static struct observe_index_entry observe_index[OBSERVE_INDEX_SIZE];
+static struct lwm2m_ctx *observe_index_ctx[CONFIG_LWM2M_ENGINE_MAX_OBSERVER];
+static size_t observe_index_count;
+static atomic_t observe_index_stale = ATOMIC_INIT(1);
+static K_MUTEX_DEFINE(observe_index_lock);
+
+void lwm2m_observer_index_invalidate(void)
+{
+	atomic_set(&observe_index_stale, 1);
+}
+
+/* Compare the first @a level components of two paths, a missing component
+ * sorts before any present one.
+ */
+static int observe_index_path_cmp(const struct lwm2m_obj_path *a,
+				  const struct lwm2m_obj_path *b, uint8_t level)
+{
+	const uint16_t ids_a[] = { a->obj_id, a->obj_inst_id, a->res_id, a->res_inst_id };
+	const uint16_t ids_b[] = { b->obj_id, b->obj_inst_id, b->res_id, b->res_inst_id };
+
+	for (uint8_t i = 0; i < level; i++) {
+		if (i >= a->level || i >= b->level) {
+			return (int)a->level - (int)b->level;
+		}
+
+		if (ids_a[i] != ids_b[i]) {
+			return ids_a[i] < ids_b[i] ? -1 : 1;
+		}
+	}
+
+	return 0;
+}
+
+static int observe_index_entry_cmp(const void *a, const void *b)
+{
+	const struct observe_index_entry *ea = a;
+	const struct observe_index_entry *eb = b;
+
+	return observe_index_path_cmp(&ea->path, &eb->path, LWM2M_PATH_LEVEL_RESOURCE_INST);
+}
+
+/* Must be invoked with observe_index_lock held */
+static void observe_index_rebuild(void)
+{
+	struct lwm2m_ctx **sock_ctx = lwm2m_sock_ctx();
+	struct lwm2m_obj_path_list *o_p;
+	struct observe_node *obs;
+	size_t count = 0;
+
+	atomic_set(&observe_index_stale, 0);
+
+	for (int i = 0; i < lwm2m_sock_nfds(); ++i) {
+		SYS_SLIST_FOR_EACH_CONTAINER(&sock_ctx[i]->observer, obs, node) {
+			uint8_t idx = obs - observe_node_data;
+
+			observe_index_ctx[idx] = sock_ctx[i];
+
+			SYS_SLIST_FOR_EACH_CONTAINER(&obs->path_list, o_p, node) {
+				/* Paths above the object level never match */
+				if (o_p->path.level < LWM2M_PATH_LEVEL_OBJECT) {
+					continue;
+				}
+
+				if (count >= ARRAY_SIZE(observe_index)) {
+					LOG_WRN("Observation index full");
+					atomic_set(&observe_index_stale, 1);
+					break;
+				}
+
+				observe_index[count].path = o_p->path;
+				observe_index[count].path.level =
+					MIN(o_p->path.level, OBSERVE_INDEX_MAX_LEVEL);
+				observe_index[count].obs = idx;
+				count++;
+			}
+		}
+	}
+
+	qsort(observe_index, count, sizeof(observe_index[0]), observe_index_entry_cmp);
+	observe_index_count = count;
+}
+
+/* First entry not sorting before @a path when compared up to @a level */
+static size_t observe_index_lower_bound(const struct lwm2m_obj_path *path, uint8_t level)
+{
+	size_t low = 0;
+	size_t high = observe_index_count;
+
+	while (low < high) {
+		size_t mid = low + (high - low) / 2;
+
+		if (observe_index_path_cmp(&observe_index[mid].path, path, level) < 0) {
+			low = mid + 1;
+		} else {
+			high = mid;
+		}
+	}
+
+	return low;
+}
+
+/* Mark the observers having a path that is a prefix of @a path, or that
+ * @a path is a prefix of. Returns false if the index can't be used.
+ */
+static bool observe_index_match(const struct lwm2m_obj_path *path, atomic_t *matched)
+{
+	struct lwm2m_obj_path prefix = *path;
+	uint8_t level = MIN(path->level, LWM2M_PATH_LEVEL_RESOURCE_INST);
+	size_t i;
+
+	if (atomic_get(&observe_index_stale)) {
+		observe_index_rebuild();
+
+		if (atomic_get(&observe_index_stale)) {
+			return false;
+		}
+	}
+
+	/* Observations of the parents of the path */
+	for (prefix.level = LWM2M_PATH_LEVEL_OBJECT; prefix.level < level; prefix.level++) {
+		for (i = observe_index_lower_bound(&prefix, prefix.level + 1);
+		     i < observe_index_count &&
+		     observe_index_path_cmp(&observe_index[i].path, &prefix,
+					    prefix.level + 1) == 0;
+		     i++) {
+			atomic_set_bit(matched, observe_index[i].obs);
+		}
+	}
+
+	/* Observations of the path and below it */
+	prefix.level = level;
+	for (i = observe_index_lower_bound(&prefix, level);
+	     i < observe_index_count &&
+	     observe_index_path_cmp(&observe_index[i].path, &prefix, level) == 0;
+	     i++) {
+		atomic_set_bit(matched, observe_index[i].obs);
+	}
+
+	return true;
+}
+#endif /* CONFIG_LWM2M_ENGINE_INDEX */
+
 int lwm2m_notify_observer(uint16_t obj_id, uint16_t obj_inst_id, uint16_t res_id)
 {
 	struct lwm2m_obj_path path;
@@ -333,12 +492,42 @@ int engine_observe_attribute_list_get(sys_slist_t *path_list, struct notificatio
 	return 0;
 }
 
-int lwm2m_notify_observer_path(const struct lwm2m_obj_path *path)
+static int lwm2m_notify_observer_node(struct lwm2m_ctx *ctx, struct observe_node *obs,
+				      const struct lwm2m_obj_path *path)
 {
-	struct observe_node *obs;
 	struct notification_attrs nattrs = {0};
 	int64_t timestamp;
+	int ret;
+
+	/* update the event time for this observer */
+	ret = engine_observe_attribute_list_get(&obs->path_list, &nattrs, ctx->srv_obj_inst);
+	if (ret < 0) {
+		return ret;
+	}
+
+	if (nattrs.pmin) {
+		timestamp = obs->last_timestamp + MSEC_PER_SEC * nattrs.pmin;
+	} else {
+		/* Trig immediately */
+		timestamp = k_uptime_get();
+	}
+
+	if (!obs->event_timestamp || obs->event_timestamp > timestamp) {
+		obs->resource_update = true;
+		obs->event_timestamp = timestamp;
+	}
+
+	LOG_DBG("NOTIFY EVENT %u/%u/%u", path->obj_id, path->obj_inst_id, path->res_id);
+	lwm2m_engine_wake_up();
+
+	return 0;
+}
+
+int lwm2m_notify_observer_path(const struct lwm2m_obj_path *path)
+{
+	struct observe_node *obs;
 	int ret = 0;
+	int count = 0;
 	int i;
 	struct lwm2m_ctx **sock_ctx = lwm2m_sock_ctx();
 
@@ -346,39 +535,46 @@ int lwm2m_notify_observer_path(const struct lwm2m_obj_path *path)
 		return 0;
 	}
 
+#if defined(CONFIG_LWM2M_ENGINE_INDEX)
+	ATOMIC_DEFINE(matched, CONFIG_LWM2M_ENGINE_MAX_OBSERVER) = {0};
+
+	k_mutex_lock(&observe_index_lock, K_FOREVER);
+	if (observe_index_match(path, matched)) {
+		for (i = 0; i < CONFIG_LWM2M_ENGINE_MAX_OBSERVER; i++) {
+			if (!atomic_test_bit(matched, i)) {
+				continue;
+			}
+
+			ret = lwm2m_notify_observer_node(observe_index_ctx[i],
+							 &observe_node_data[i], path);
+			if (ret < 0) {
+				break;
+			}
+
+			count++;
+		}
+
+		k_mutex_unlock(&observe_index_lock);
+		return ret < 0 ? ret : count;
+	}
+	k_mutex_unlock(&observe_index_lock);
+#endif
+
 	/* look for observers which match our resource */
 	for (i = 0; i < lwm2m_sock_nfds(); ++i) {
 		SYS_SLIST_FOR_EACH_CONTAINER(&sock_ctx[i]->observer, obs, node) {
 			if (lwm2m_notify_observer_list(&obs->path_list, path)) {
-				/* update the event time for this observer */
-				ret = engine_observe_attribute_list_get(&obs->path_list, &nattrs,
-									sock_ctx[i]->srv_obj_inst);
+				ret = lwm2m_notify_observer_node(sock_ctx[i], obs, path);
 				if (ret < 0) {
 					return ret;
 				}
 
-				if (nattrs.pmin) {
-					timestamp =
-						obs->last_timestamp + MSEC_PER_SEC * nattrs.pmin;
-				} else {
-					/* Trig immediately */
-					timestamp = k_uptime_get();
-				}
-
-				if (!obs->event_timestamp || obs->event_timestamp > timestamp) {
-					obs->resource_update = true;
-					obs->event_timestamp = timestamp;
-				}
-
-				LOG_DBG("NOTIFY EVENT %u/%u/%u", path->obj_id, path->obj_inst_id,
-					path->res_id);
-				ret++;
-				lwm2m_engine_wake_up();
+				count++;
 			}
 		}
 	}
 
-	return ret;
+	return count;
 }
 
 static struct observe_node *engine_allocate_observer(sys_slist_t *path_list, bool composite)
@@ -442,6 +638,7 @@ static void engine_observe_node_init(struct observe_node *obs, const uint8_t *to
 	obs->format = format;
 	obs->counter = OBSERVE_COUNTER_START;
 	sys_slist_append(&ctx->observer, &obs->node);
+	lwm2m_observer_index_invalidate();
 
 	SYS_SLIST_FOR_EACH_CONTAINER(&obs->path_list, tmp, node) {
 		LOG_DBG("OBSERVER ADDED %u/%u/%u/%u(%u)", tmp->path.obj_id, tmp->path.obj_inst_id,
@@ -468,6 +665,7 @@ static void remove_observer_path_from_list(struct lwm2m_ctx *ctx, struct observe
 	/* Remove from the list and add to free list */
 	sys_slist_remove(&obs->path_list, prev_node, &o_p->node);
 	sys_slist_append(&obs_obj_path_list, &o_p->node);
+	lwm2m_observer_index_invalidate();
 }
 
 static void engine_observe_single_path_id_remove(struct lwm2m_ctx *ctx, struct observe_node *obs,
@@ -708,6 +906,7 @@ void remove_observer_from_list(struct lwm2m_ctx *ctx, sys_snode_t *prev_node,
 	}
 	sys_slist_remove(&ctx->observer, prev_node, &obs->node);
 	(void)memset(obs, 0, sizeof(*obs));
+	lwm2m_observer_index_invalidate();
 }
 
 int engine_remove_observer_by_token(struct lwm2m_ctx *ctx, const uint8_t *token, uint8_t tkl)
@@ -1459,6 +1658,22 @@ int64_t engine_observe_shedule_next_event(struct observe_node *obs, uint16_t srv
 	return t_s;
 }
 
+#if defined(CONFIG_LWM2M_NOTIFY_COALESCE)
+bool engine_observe_pmin_elapsed(struct observe_node *obs, uint16_t srv_obj_inst,
+				 const int64_t timestamp)
+{
+	struct notification_attrs attrs;
+	int ret;
+
+	ret = engine_observe_attribute_list_get(&obs->path_list, &attrs, srv_obj_inst);
+	if (ret < 0) {
+		return false;
+	}
+
+	return obs->last_timestamp + MSEC_PER_SEC * attrs.pmin <= timestamp;
+}
+#endif /* CONFIG_LWM2M_NOTIFY_COALESCE */
+
 struct lwm2m_obj_path_list *lwm2m_engine_get_from_list(sys_slist_t *path_list)
 {
 	sys_snode_t *path_node = sys_slist_get(path_list);
@@ -32,6 +32,10 @@ const char *lwm2m_engine_get_attr_name(const struct lwm2m_attr *attr);
 
 void clear_attrs(void *ref);
 
+/* Check if the minimum period of an observation has elapsed */
+bool engine_observe_pmin_elapsed(struct observe_node *obs, uint16_t srv_obj_inst,
+				 const int64_t timestamp);
+
 int64_t engine_observe_shedule_next_event(struct observe_node *obs, uint16_t srv_obj_inst,
 					  const int64_t timestamp);
 
@@ -52,6 +56,13 @@ int lwm2m_engine_observation_handler(struct lwm2m_message *msg, int observe, uin
 
 void engine_remove_observer_by_id(uint16_t obj_id, int32_t obj_inst_id);
 
+#if defined(CONFIG_LWM2M_ENGINE_INDEX)
+/* Mark the observation index stale after observers or sockets change */
+void lwm2m_observer_index_invalidate(void);
+#else
+static inline void lwm2m_observer_index_invalidate(void) {}
+#endif
+
 /* path object list */
 struct lwm2m_obj_path_list {
 	sys_snode_t node;
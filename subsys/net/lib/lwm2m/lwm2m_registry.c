@@ -53,6 +53,9 @@ void lwm2m_registry_unlock(void)
 /* Resources */
 static sys_slist_t engine_obj_list;
 static sys_slist_t engine_obj_inst_list;
+#if defined(CONFIG_LWM2M_ENGINE_INDEX)
+static sys_slist_t engine_obj_inst_index[CONFIG_LWM2M_ENGINE_INDEX_BUCKETS];
+#endif
 
 /* Resource wrappers */
 sys_slist_t *lwm2m_engine_obj_list(void) { return &engine_obj_list; }
@@ -130,6 +133,15 @@ struct lwm2m_engine_obj *lwm2m_engine_get_obj(const struct lwm2m_obj_path *path)
 }
 /* Engine object instance */
 
+#if defined(CONFIG_LWM2M_ENGINE_INDEX)
+static sys_slist_t *engine_obj_inst_bucket(uint16_t obj_id, uint16_t obj_inst_id)
+{
+	uint32_t hash = (((uint32_t)obj_id << 16) | obj_inst_id) * 0x9e3779b1U;
+
+	return &engine_obj_inst_index[(hash >> 16) % ARRAY_SIZE(engine_obj_inst_index)];
+}
+#endif
+
 static void engine_register_obj_inst(struct lwm2m_engine_obj_inst *obj_inst)
 {
 #if defined(CONFIG_LWM2M_ACCESS_CONTROL_ENABLE)
@@ -141,6 +153,10 @@ static void engine_register_obj_inst(struct lwm2m_engine_obj_inst *obj_inst)
 #endif /* CONFIG_LWM2M_RD_CLIENT_SUPPORT_BOOTSTRAP */
 #endif /* CONFIG_LWM2M_ACCESS_CONTROL_ENABLE */
 	sys_slist_append(&engine_obj_inst_list, &obj_inst->node);
+#if defined(CONFIG_LWM2M_ENGINE_INDEX)
+	sys_slist_append(engine_obj_inst_bucket(obj_inst->obj->obj_id, obj_inst->obj_inst_id),
+			 &obj_inst->index_node);
+#endif
 }
 
 static void engine_unregister_obj_inst(struct lwm2m_engine_obj_inst *obj_inst)
@@ -150,17 +166,35 @@ static void engine_unregister_obj_inst(struct lwm2m_engine_obj_inst *obj_inst)
 #endif
 	engine_remove_observer_by_id(obj_inst->obj->obj_id, obj_inst->obj_inst_id);
 	sys_slist_find_and_remove(&engine_obj_inst_list, &obj_inst->node);
+#if defined(CONFIG_LWM2M_ENGINE_INDEX)
+	sys_slist_find_and_remove(engine_obj_inst_bucket(obj_inst->obj->obj_id,
+							 obj_inst->obj_inst_id),
+				  &obj_inst->index_node);
+#endif
 }
 
 struct lwm2m_engine_obj_inst *get_engine_obj_inst(int obj_id, int obj_inst_id)
 {
 	struct lwm2m_engine_obj_inst *obj_inst;
 
+#if defined(CONFIG_LWM2M_ENGINE_INDEX)
+	if (obj_id < 0 || obj_id > UINT16_MAX || obj_inst_id < 0 || obj_inst_id > UINT16_MAX) {
+		return NULL;
+	}
+
+	SYS_SLIST_FOR_EACH_CONTAINER(engine_obj_inst_bucket(obj_id, obj_inst_id), obj_inst,
+				     index_node) {
+		if (obj_inst->obj->obj_id == obj_id && obj_inst->obj_inst_id == obj_inst_id) {
+			return obj_inst;
+		}
+	}
+#else
 	SYS_SLIST_FOR_EACH_CONTAINER(&engine_obj_inst_list, obj_inst, node) {
 		if (obj_inst->obj->obj_id == obj_id && obj_inst->obj_inst_id == obj_inst_id) {
 			return obj_inst;
 		}
 	}
+#endif
 
 	return NULL;
 }
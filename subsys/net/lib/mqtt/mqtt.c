@@ -25,6 +25,10 @@ static void client_reset(struct mqtt_client *client)
 	client->internal.last_activity = 0U;
 	client->internal.rx_buf_datalen = 0U;
 	client->internal.remaining_payload = 0U;
+#if CONFIG_MQTT_PUBLISH_WINDOW > 0
+	memset(client->internal.unacked_publish, 0,
+	       sizeof(client->internal.unacked_publish));
+#endif
 }
 
 /** @brief Initialize tx buffer. */
@@ -114,7 +118,16 @@ static int client_read(struct mqtt_client *client)
 	int err_code;
 
 	if (client->internal.remaining_payload > 0) {
+#if defined(CONFIG_MQTT_PUBLISH_STREAM)
+		err_code = mqtt_handle_rx_payload(client);
+		if (err_code < 0) {
+			client_disconnect(client, err_code, true);
+		}
+
+		return err_code;
+#else
 		return -EBUSY;
+#endif
 	}
 
 	err_code = mqtt_handle_rx(client);
@@ -243,6 +256,9 @@ int mqtt_publish(struct mqtt_client *client,
 	struct buf_ctx packet;
 	struct iovec io_vector[2];
 	struct msghdr msg;
+#if CONFIG_MQTT_PUBLISH_WINDOW > 0
+	uint16_t *window_entry = NULL;
+#endif
 
 	NULL_PARAM_CHECK(client);
 	NULL_PARAM_CHECK(param);
@@ -261,6 +277,22 @@ int mqtt_publish(struct mqtt_client *client,
 		goto error;
 	}
 
+#if CONFIG_MQTT_PUBLISH_WINDOW > 0
+	if (param->message.topic.qos > MQTT_QOS_0_AT_MOST_ONCE) {
+		for (int i = 0; i < CONFIG_MQTT_PUBLISH_WINDOW; i++) {
+			if (client->internal.unacked_publish[i] == 0U) {
+				window_entry = &client->internal.unacked_publish[i];
+				break;
+			}
+		}
+
+		if (window_entry == NULL) {
+			err_code = -EAGAIN;
+			goto error;
+		}
+	}
+#endif
+
 	err_code = publish_encode(param, &packet);
 	if (err_code < 0) {
 		goto error;
@@ -277,6 +309,11 @@ int mqtt_publish(struct mqtt_client *client,
 	msg.msg_iovlen = ARRAY_SIZE(io_vector);
 
 	err_code = client_write_msg(client, &msg);
+#if CONFIG_MQTT_PUBLISH_WINDOW > 0
+	if (err_code == 0 && window_entry != NULL) {
+		*window_entry = param->message_id;
+	}
+#endif
 
 error:
 	NET_DBG("[CID %p]:[State 0x%02x]: << result 0x%08x",
@@ -162,6 +162,35 @@ void event_notify(struct mqtt_client *client, const struct mqtt_evt *evt);
  */
 int mqtt_handle_rx(struct mqtt_client *client);
 
+#if defined(CONFIG_MQTT_PUBLISH_STREAM)
+/**@brief Streams the remaining payload of a received PUBLISH message to the
+ *        application, as far as it is available from the transport.
+ *
+ * @param[in] client Identifies the client for which the data was received.
+ *
+ * @return 0 if the procedure is successful, an error code otherwise.
+ */
+int mqtt_handle_rx_payload(struct mqtt_client *client);
+#endif
+
+#if CONFIG_MQTT_PUBLISH_WINDOW > 0
+/**@brief Releases the window entry of an acknowledged published message.
+ *
+ * @param[in] client Client instance.
+ * @param[in] message_id Message ID of the acknowledged message.
+ */
+static inline void mqtt_publish_window_release(struct mqtt_client *client,
+					       uint16_t message_id)
+{
+	for (int i = 0; i < CONFIG_MQTT_PUBLISH_WINDOW; i++) {
+		if (client->internal.unacked_publish[i] == message_id) {
+			client->internal.unacked_publish[i] = 0U;
+			return;
+		}
+	}
+}
+#endif
+
 /**@brief Constructs/encodes Connect packet.
  *
  * @param[in] client Identifies the client for which the procedure is requested.
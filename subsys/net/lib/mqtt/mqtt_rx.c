@@ -63,6 +63,10 @@ static int mqtt_handle_packet(struct mqtt_client *client,
 
 		client->internal.remaining_payload =
 					evt.param.publish.message.payload.len;
+#if defined(CONFIG_MQTT_PUBLISH_STREAM)
+		client->internal.payload_len =
+					evt.param.publish.message.payload.len;
+#endif
 
 		NET_DBG("PUB QoS:%02x, message len %08x, topic len %08x",
 			 evt.param.publish.message.topic.qos,
@@ -77,6 +81,12 @@ static int mqtt_handle_packet(struct mqtt_client *client,
 		evt.type = MQTT_EVT_PUBACK;
 		err_code = publish_ack_decode(buf, &evt.param.puback);
 		evt.result = err_code;
+#if CONFIG_MQTT_PUBLISH_WINDOW > 0
+		if (err_code == 0) {
+			mqtt_publish_window_release(client,
+						    evt.param.puback.message_id);
+		}
+#endif
 		break;
 
 	case MQTT_PKT_TYPE_PUBREC:
@@ -101,6 +111,12 @@ static int mqtt_handle_packet(struct mqtt_client *client,
 		evt.type = MQTT_EVT_PUBCOMP;
 		err_code = publish_complete_decode(buf, &evt.param.pubcomp);
 		evt.result = err_code;
+#if CONFIG_MQTT_PUBLISH_WINDOW > 0
+		if (err_code == 0) {
+			mqtt_publish_window_release(client,
+						    evt.param.pubcomp.message_id);
+		}
+#endif
 		break;
 
 	case MQTT_PKT_TYPE_SUBACK:
@@ -288,5 +304,60 @@ int mqtt_handle_rx(struct mqtt_client *client)
 
 	client->internal.rx_buf_datalen = 0U;
 
+#if defined(CONFIG_MQTT_PUBLISH_STREAM)
+	/* Payload the application did not read in the PUBLISH callback. */
+	if (client->internal.remaining_payload > 0U) {
+		return mqtt_handle_rx_payload(client);
+	}
+#endif
+
+	return 0;
+}
+
+#if defined(CONFIG_MQTT_PUBLISH_STREAM)
+int mqtt_handle_rx_payload(struct mqtt_client *client)
+{
+	struct mqtt_evt evt;
+	uint32_t length;
+	int len;
+
+	evt.type = MQTT_EVT_PUBLISH_PAYLOAD;
+	evt.result = 0;
+
+	while (client->internal.remaining_payload > 0U) {
+		length = MIN(client->internal.remaining_payload,
+			     client->rx_buf_size);
+
+		len = mqtt_transport_read(client, client->rx_buf, length,
+					  false);
+		if (len < 0) {
+			if (len == -EAGAIN) {
+				return 0;
+			}
+
+			NET_ERR("[CID %p]: Transport read error: %d", client,
+				len);
+			return len;
+		}
+
+		if (len == 0) {
+			NET_ERR("[CID %p]: Connection closed.", client);
+			return -ENOTCONN;
+		}
+
+		evt.param.publish_payload.data = client->rx_buf;
+		evt.param.publish_payload.len = len;
+		evt.param.publish_payload.total_len =
+					client->internal.payload_len;
+		evt.param.publish_payload.offset =
+					client->internal.payload_len -
+					client->internal.remaining_payload;
+
+		client->internal.remaining_payload -= len;
+
+		event_notify(client, &evt);
+	}
+
 	return 0;
 }
+#endif /* CONFIG_MQTT_PUBLISH_STREAM */
@@ -259,6 +259,8 @@ int zsock_close_ctx(struct net_context *ctx)
 	 * as these are fail-free operations and we're closing
 	 * socket anyway.
 	 */
+	zsock_epoll_forget(ctx);
+
 	if (net_context_get_state(ctx) == NET_CONTEXT_LISTENING) {
 		(void)net_context_accept(ctx, NULL, K_NO_WAIT, NULL);
 	} else {
@@ -823,6 +825,112 @@ ssize_t zsock_sendto_ctx(struct net_context *ctx, const void *buf, size_t len,
 	return status;
 }
 
+#if defined(CONFIG_NET_SOCKETS_SEND_NOCOPY)
+struct nocopy_data {
+	zsock_send_done_cb_t cb;
+	void *user_data;
+	const void *buf;
+	size_t len;
+};
+
+static void nocopy_destroy(struct net_buf *buf)
+{
+	struct nocopy_data *data = net_buf_user_data(buf);
+
+	if (data->cb) {
+		data->cb(data->buf, data->len, data->user_data);
+	}
+
+	net_buf_destroy(buf);
+}
+
+NET_BUF_POOL_DEFINE(zsock_nocopy_pool, CONFIG_NET_SOCKETS_SEND_NOCOPY_COUNT, 0,
+		    sizeof(struct nocopy_data), nocopy_destroy);
+
+static ssize_t zsock_sendto_nocopy_ctx(struct net_context *ctx,
+				       const void *buf, size_t len, int flags,
+				       const struct sockaddr *dest_addr,
+				       socklen_t addrlen,
+				       zsock_send_done_cb_t cb, void *user_data)
+{
+	k_timeout_t timeout = K_FOREVER;
+	struct nocopy_data *data;
+	struct net_buf *frag;
+	int status;
+
+	if (net_context_get_type(ctx) != SOCK_DGRAM ||
+	    net_context_get_proto(ctx) != IPPROTO_UDP) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	if ((flags & ZSOCK_MSG_DONTWAIT) || sock_is_nonblock(ctx)) {
+		timeout = K_NO_WAIT;
+	} else {
+		net_context_get_option(ctx, NET_OPT_SNDTIMEO, &timeout, NULL);
+	}
+
+	/* The data is only read by the stack */
+	frag = net_buf_alloc_with_data(&zsock_nocopy_pool, (void *)buf, len, timeout);
+	if (frag == NULL) {
+		errno = K_TIMEOUT_EQ(timeout, K_NO_WAIT) ? EAGAIN : ENOBUFS;
+		return -1;
+	}
+
+	data = net_buf_user_data(frag);
+	data->cb = cb;
+	data->user_data = user_data;
+	data->buf = buf;
+	data->len = len;
+
+	status = net_context_recv(ctx, zsock_received_cb, K_NO_WAIT,
+				  ctx->user_data);
+	if (status < 0) {
+		net_buf_unref(frag);
+		errno = -status;
+		return -1;
+	}
+
+	status = net_context_sendto_buf(ctx, frag, dest_addr, addrlen, timeout);
+	if (status < 0) {
+		errno = -status;
+		return -1;
+	}
+
+	return status;
+}
+
+ssize_t zsock_sendto_nocopy(int sock, const void *buf, size_t len, int flags,
+			    const struct sockaddr *dest_addr, socklen_t addrlen,
+			    zsock_send_done_cb_t cb, void *user_data)
+{
+	const struct socket_op_vtable *vtable;
+	struct net_context *ctx;
+	struct k_mutex *lock;
+	ssize_t ret;
+
+	ctx = get_sock_vtable(sock, &vtable, &lock);
+	if (ctx == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	if (vtable != &sock_fd_op_vtable) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	ret = zsock_sendto_nocopy_ctx(ctx, buf, len, flags, dest_addr, addrlen,
+				      cb, user_data);
+
+	k_mutex_unlock(lock);
+
+	return ret;
+}
+#endif /* CONFIG_NET_SOCKETS_SEND_NOCOPY */
+
 ssize_t z_impl_zsock_sendto(int sock, const void *buf, size_t len, int flags,
 			   const struct sockaddr *dest_addr, socklen_t addrlen)
 {
@@ -997,6 +1105,49 @@ fail:
 #include <syscalls/zsock_sendmsg_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
+int zsock_sendmmsg(int sock, struct mmsghdr *msgvec, unsigned int vlen,
+		   int flags)
+{
+	const struct socket_op_vtable *vtable;
+	struct k_mutex *lock;
+	unsigned int count;
+	ssize_t ret = 0;
+	void *obj;
+
+	obj = get_sock_vtable(sock, &vtable, &lock);
+	if (obj == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	if (vtable->sendmsg == NULL) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	/* Let the TX traffic class thread process the whole batch at once
+	 * instead of being woken up for every datagram queued.
+	 */
+	k_sched_lock();
+
+	for (count = 0; count < vlen; count++) {
+		ret = vtable->sendmsg(obj, &msgvec[count].msg_hdr, flags);
+		if (ret < 0) {
+			break;
+		}
+
+		msgvec[count].msg_len = ret;
+	}
+
+	k_sched_unlock();
+
+	k_mutex_unlock(lock);
+
+	return (count > 0 || ret >= 0) ? count : -1;
+}
+
 static int sock_get_pkt_src_addr(struct net_pkt *pkt,
 				 enum net_ip_protocol proto,
 				 struct sockaddr *addr,
@@ -1160,6 +1311,53 @@ int zsock_wait_data(struct net_context *ctx, k_timeout_t *timeout)
 	return 0;
 }
 
+static int zsock_recv_dgram_src_addr(struct net_context *ctx,
+				     struct net_pkt *pkt,
+				     struct sockaddr *src_addr,
+				     socklen_t *addrlen)
+{
+	if (IS_ENABLED(CONFIG_NET_OFFLOAD) &&
+	    net_if_is_ip_offloaded(net_context_get_iface(ctx))) {
+		/*
+		 * Packets from offloaded IP stack do not have IP
+		 * headers, so src address cannot be figured out at this
+		 * point. The best we can do is returning remote address
+		 * if that was set using connect() call.
+		 */
+		if (ctx->flags & NET_CONTEXT_REMOTE_ADDR_SET) {
+			memcpy(src_addr, &ctx->remote,
+			       MIN(*addrlen, sizeof(ctx->remote)));
+		} else {
+			errno = ENOTSUP;
+			return -1;
+		}
+	} else {
+		int rv;
+
+		rv = sock_get_pkt_src_addr(pkt, net_context_get_proto(ctx),
+					   src_addr, *addrlen);
+		if (rv < 0) {
+			errno = -rv;
+			LOG_ERR("sock_get_pkt_src_addr %d", rv);
+			return -1;
+		}
+	}
+
+	/* addrlen is a value-result argument, set to actual
+	 * size of source address
+	 */
+	if (src_addr->sa_family == AF_INET) {
+		*addrlen = sizeof(struct sockaddr_in);
+	} else if (src_addr->sa_family == AF_INET6) {
+		*addrlen = sizeof(struct sockaddr_in6);
+	} else {
+		errno = ENOTSUP;
+		return -1;
+	}
+
+	return 0;
+}
+
 static inline ssize_t zsock_recv_dgram(struct net_context *ctx,
 				       void *buf,
 				       size_t max_len,
@@ -1209,45 +1407,9 @@ static inline ssize_t zsock_recv_dgram(struct net_context *ctx,
 
 	net_pkt_cursor_backup(pkt, &backup);
 
-	if (src_addr && addrlen) {
-		if (IS_ENABLED(CONFIG_NET_OFFLOAD) &&
-		    net_if_is_ip_offloaded(net_context_get_iface(ctx))) {
-			/*
-			 * Packets from offloaded IP stack do not have IP
-			 * headers, so src address cannot be figured out at this
-			 * point. The best we can do is returning remote address
-			 * if that was set using connect() call.
-			 */
-			if (ctx->flags & NET_CONTEXT_REMOTE_ADDR_SET) {
-				memcpy(src_addr, &ctx->remote,
-				       MIN(*addrlen, sizeof(ctx->remote)));
-			} else {
-				errno = ENOTSUP;
-				goto fail;
-			}
-		} else {
-			int rv;
-
-			rv = sock_get_pkt_src_addr(pkt, net_context_get_proto(ctx),
-						   src_addr, *addrlen);
-			if (rv < 0) {
-				errno = -rv;
-				LOG_ERR("sock_get_pkt_src_addr %d", rv);
-				goto fail;
-			}
-		}
-
-		/* addrlen is a value-result argument, set to actual
-		 * size of source address
-		 */
-		if (src_addr->sa_family == AF_INET) {
-			*addrlen = sizeof(struct sockaddr_in);
-		} else if (src_addr->sa_family == AF_INET6) {
-			*addrlen = sizeof(struct sockaddr_in6);
-		} else {
-			errno = ENOTSUP;
-			goto fail;
-		}
+	if (src_addr && addrlen &&
+	    zsock_recv_dgram_src_addr(ctx, pkt, src_addr, addrlen) < 0) {
+		goto fail;
 	}
 
 	recv_len = net_pkt_remaining_data(pkt);
@@ -1279,6 +1441,80 @@ fail:
 	return -1;
 }
 
+static int zsock_recvmmsg_ctx(struct net_context *ctx,
+			      struct mmsghdr *msgvec, unsigned int vlen,
+			      int flags)
+{
+	k_timeout_t timeout = K_FOREVER;
+	struct net_pkt *pkt;
+	unsigned int count;
+
+	if ((flags & ZSOCK_MSG_DONTWAIT) || sock_is_nonblock(ctx)) {
+		timeout = K_NO_WAIT;
+	} else {
+		int ret;
+
+		net_context_get_option(ctx, NET_OPT_RCVTIMEO, &timeout, NULL);
+
+		ret = zsock_wait_data(ctx, &timeout);
+		if (ret < 0) {
+			errno = -ret;
+			return -1;
+		}
+	}
+
+	errno = EAGAIN;
+
+	for (count = 0; count < vlen; count++) {
+		struct msghdr *msg = &msgvec[count].msg_hdr;
+		size_t recv_len;
+		size_t len = 0;
+
+		/* Only the first datagram is waited for */
+		pkt = k_fifo_get(&ctx->recv_q, count == 0 ? timeout : K_NO_WAIT);
+		if (pkt == NULL) {
+			break;
+		}
+
+		if (msg->msg_name != NULL &&
+		    zsock_recv_dgram_src_addr(ctx, pkt, msg->msg_name,
+					      &msg->msg_namelen) < 0) {
+			net_pkt_unref(pkt);
+			break;
+		}
+
+		recv_len = net_pkt_remaining_data(pkt);
+		msg->msg_controllen = 0;
+		msg->msg_flags = 0;
+
+		for (size_t i = 0; i < msg->msg_iovlen && len < recv_len; i++) {
+			size_t read_len = MIN(msg->msg_iov[i].iov_len,
+					      recv_len - len);
+
+			if (net_pkt_read(pkt, msg->msg_iov[i].iov_base,
+					 read_len)) {
+				break;
+			}
+
+			len += read_len;
+		}
+
+		if (len < recv_len) {
+			msg->msg_flags |= ZSOCK_MSG_TRUNC;
+		}
+
+		if (IS_ENABLED(CONFIG_NET_PKT_RXTIME_STATS)) {
+			net_socket_update_tc_rx_time(pkt, k_cycle_get_32());
+		}
+
+		net_pkt_unref(pkt);
+
+		msgvec[count].msg_len = (flags & ZSOCK_MSG_TRUNC) ? recv_len : len;
+	}
+
+	return count > 0 ? count : -1;
+}
+
 static size_t zsock_recv_stream_immediate(struct net_context *ctx, uint8_t **buf, size_t *max_len,
 					  int flags)
 {
@@ -1462,6 +1698,125 @@ ssize_t zsock_recvfrom_ctx(struct net_context *ctx, void *buf, size_t max_len,
 	return 0;
 }
 
+static ssize_t zsock_recv_pkt_ctx(struct net_context *ctx,
+				  struct net_pkt **pkt, int flags)
+{
+	enum net_sock_type sock_type = net_context_get_type(ctx);
+	k_timeout_t timeout = K_FOREVER;
+	struct net_pkt *p;
+	size_t len;
+	int ret;
+
+	*pkt = NULL;
+
+	if (flags & ~ZSOCK_MSG_DONTWAIT) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (sock_type == SOCK_STREAM) {
+		if (net_context_get_state(ctx) != NET_CONTEXT_CONNECTED) {
+			errno = ENOTCONN;
+			return -1;
+		}
+	} else if (sock_type != SOCK_DGRAM) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	if (sock_is_error(ctx)) {
+		errno = POINTER_TO_INT(ctx->user_data);
+		return -1;
+	}
+
+	if ((flags & ZSOCK_MSG_DONTWAIT) || sock_is_nonblock(ctx)) {
+		timeout = K_NO_WAIT;
+	} else {
+		net_context_get_option(ctx, NET_OPT_RCVTIMEO, &timeout, NULL);
+	}
+
+	while (true) {
+		if (sock_type == SOCK_STREAM && sock_is_eof(ctx)) {
+			return 0;
+		}
+
+		if (!K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			ret = zsock_wait_data(ctx, &timeout);
+			if (ret < 0) {
+				errno = -ret;
+				return -1;
+			}
+		}
+
+		p = k_fifo_get(&ctx->recv_q, K_NO_WAIT);
+		if (p == NULL) {
+			if (sock_type == SOCK_STREAM && sock_is_eof(ctx)) {
+				return 0;
+			}
+
+			errno = EAGAIN;
+			return -1;
+		}
+
+		if (sock_type == SOCK_STREAM && net_pkt_eof(p)) {
+			sock_set_eof(ctx);
+		}
+
+		len = net_pkt_remaining_data(p);
+		if (len > 0 || sock_type == SOCK_DGRAM) {
+			break;
+		}
+
+		/* Nothing left to read in this stream packet */
+		net_pkt_unref(p);
+	}
+
+	if (IS_ENABLED(CONFIG_NET_PKT_RXTIME_STATS)) {
+		net_socket_update_tc_rx_time(p, k_cycle_get_32());
+	}
+
+	if (sock_type == SOCK_STREAM) {
+		net_context_update_recv_wnd(ctx, len);
+	}
+
+	*pkt = p;
+
+	return len;
+}
+
+ssize_t zsock_recv_pkt(int sock, struct net_pkt **pkt, int flags)
+{
+	const struct socket_op_vtable *vtable;
+	struct net_context *ctx;
+	struct k_mutex *lock;
+	ssize_t ret;
+
+	ctx = get_sock_vtable(sock, &vtable, &lock);
+	if (ctx == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	/* The packets of other socket implementations are not net_pkts */
+	if (vtable != &sock_fd_op_vtable) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	ret = zsock_recv_pkt_ctx(ctx, pkt, flags);
+
+	k_mutex_unlock(lock);
+
+	return ret;
+}
+
+void zsock_recv_pkt_release(struct net_pkt *pkt)
+{
+	net_pkt_unref(pkt);
+}
+
 ssize_t z_impl_zsock_recvfrom(int sock, void *buf, size_t max_len, int flags,
 			     struct sockaddr *src_addr, socklen_t *addrlen)
 {
@@ -1500,6 +1855,65 @@ ssize_t z_vrfy_zsock_recvfrom(int sock, void *buf, size_t max_len, int flags,
 #include <syscalls/zsock_recvfrom_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
+int zsock_recvmmsg(int sock, struct mmsghdr *msgvec, unsigned int vlen,
+		   int flags)
+{
+	const struct socket_op_vtable *vtable;
+	struct k_mutex *lock;
+	unsigned int count;
+	ssize_t ret = 0;
+	void *obj;
+
+	if (flags & ZSOCK_MSG_PEEK) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	obj = get_sock_vtable(sock, &vtable, &lock);
+	if (obj == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	if (vtable == &sock_fd_op_vtable &&
+	    net_context_get_type(obj) == SOCK_DGRAM) {
+		ret = zsock_recvmmsg_ctx(obj, msgvec, vlen, flags);
+		k_mutex_unlock(lock);
+
+		return ret;
+	}
+
+	/* Other socket types only receive into a single buffer */
+	for (count = 0; count < vlen; count++) {
+		struct msghdr *msg = &msgvec[count].msg_hdr;
+
+		if (msg->msg_iovlen != 1) {
+			errno = EINVAL;
+			ret = -1;
+			break;
+		}
+
+		ret = vtable->recvfrom(obj, msg->msg_iov[0].iov_base,
+				       msg->msg_iov[0].iov_len,
+				       count == 0 ? flags : flags | ZSOCK_MSG_DONTWAIT,
+				       msg->msg_name,
+				       msg->msg_name != NULL ? &msg->msg_namelen : NULL);
+		if (ret < 0) {
+			break;
+		}
+
+		msg->msg_controllen = 0;
+		msg->msg_flags = 0;
+		msgvec[count].msg_len = ret;
+	}
+
+	k_mutex_unlock(lock);
+
+	return (count > 0 || ret >= 0) ? count : -1;
+}
+
 /* As this is limited function, we don't follow POSIX signature, with
  * "..." instead of last arg.
  */
@@ -2009,6 +2423,16 @@ int zsock_getsockopt_ctx(struct net_context *ctx, int level, int optname,
 		case TCP_NODELAY:
 			ret = net_tcp_get_option(ctx, TCP_OPT_NODELAY, optval, optlen);
 			return ret;
+
+		case TCP_CONGESTION:
+			ret = net_tcp_get_option(ctx, TCP_OPT_CONGESTION,
+						 optval, optlen);
+			if (ret < 0) {
+				errno = -ret;
+				return -1;
+			}
+
+			return 0;
 		}
 
 		break;
@@ -2307,6 +2731,16 @@ int zsock_setsockopt_ctx(struct net_context *ctx, int level, int optname,
 			ret = net_tcp_set_option(ctx,
 						 TCP_OPT_NODELAY, optval, optlen);
 			return ret;
+
+		case TCP_CONGESTION:
+			ret = net_tcp_set_option(ctx,
+						 TCP_OPT_CONGESTION, optval, optlen);
+			if (ret < 0) {
+				errno = -ret;
+				return -1;
+			}
+
+			return 0;
 		}
 		break;
 
@@ -0,0 +1,714 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* epoll() style readiness notification.
+ *
+ * Each registered socket is watched by a k_work_poll item armed on the
+ * objects the socket poll() support would wait for. When one of them
+ * becomes ready, the work handler moves the item to the ready list of its
+ * epoll instance. Waiting then only checks the items of the ready list:
+ * the ones still ready are reported, level triggered ones are kept in the
+ * ready list and the others are armed again.
+ *
+ * Socket objects are only touched with the socket lock held. The item
+ * state is protected by a spinlock shared by all the instances, so that
+ * it can be updated from the work handler.
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(net_sock, CONFIG_NET_SOCKETS_LOG_LEVEL);
+
+#include <zephyr/kernel.h>
+#include <zephyr/syscall_handler.h>
+#include <zephyr/sys/dlist.h>
+#include <zephyr/sys/fdtable.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/net/socket_epoll.h>
+#include "sockets_internal.h"
+
+/* Enough for the poll() support of native and TLS sockets */
+#define EPOLL_ITEM_EVENTS 3
+
+#define EPOLL_POLLED_EVENTS (ZSOCK_EPOLLIN | ZSOCK_EPOLLPRI | ZSOCK_EPOLLOUT)
+#define EPOLL_ALWAYS_EVENTS (ZSOCK_EPOLLERR | ZSOCK_EPOLLHUP)
+
+enum epoll_item_state {
+	EPOLL_ITEM_FREE,
+	/* Registered, neither watched nor ready */
+	EPOLL_ITEM_IDLE,
+	/* Watched by the k_work_poll item */
+	EPOLL_ITEM_ARMED,
+	/* In the ready list of the epoll instance */
+	EPOLL_ITEM_QUEUED,
+	/* Being checked by zsock_epoll_wait() */
+	EPOLL_ITEM_CHECKING,
+	/* Waiting for a triggered k_work_poll item to complete */
+	EPOLL_ITEM_FLUSHING,
+};
+
+struct epoll_instance;
+
+struct epoll_item {
+	struct k_work_poll work;
+	struct k_poll_event events[EPOLL_ITEM_EVENTS];
+	sys_dnode_t node;
+	struct epoll_instance *ep;
+	void *obj;
+	int fd;
+	uint32_t interest;
+	zsock_epoll_data_t data;
+	enum epoll_item_state state;
+	/* Removed while being checked, to be freed by the checker */
+	bool dead;
+};
+
+struct epoll_instance {
+	sys_dlist_t ready;
+	struct k_sem ready_sem;
+	bool in_use;
+};
+
+static struct epoll_item epoll_items[CONFIG_NET_SOCKETS_EPOLL_ITEMS];
+static struct epoll_instance epoll_instances[CONFIG_NET_SOCKETS_EPOLL_MAX];
+static struct k_spinlock epoll_lock;
+
+static const struct fd_op_vtable epoll_fd_op_vtable;
+
+/* Must be called with epoll_lock held */
+static void epoll_item_queue(struct epoll_item *item)
+{
+	item->state = EPOLL_ITEM_QUEUED;
+	sys_dlist_append(&item->ep->ready, &item->node);
+	k_sem_give(&item->ep->ready_sem);
+}
+
+/* Must be called with epoll_lock held */
+static void epoll_item_free(struct epoll_item *item)
+{
+	item->state = EPOLL_ITEM_FREE;
+	item->ep = NULL;
+	item->obj = NULL;
+	item->dead = false;
+}
+
+static void epoll_item_trigger(struct k_work *work)
+{
+	struct k_work_poll *pwork = CONTAINER_OF(work, struct k_work_poll, work);
+	struct epoll_item *item = CONTAINER_OF(pwork, struct epoll_item, work);
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&epoll_lock);
+
+	if (item->state == EPOLL_ITEM_ARMED) {
+		epoll_item_queue(item);
+	}
+
+	k_spin_unlock(&epoll_lock, key);
+}
+
+static int epoll_item_prepare(struct epoll_item *item,
+			      const struct fd_op_vtable *vtable,
+			      int *num_events)
+{
+	struct zsock_pollfd pfd = {
+		.fd = item->fd,
+		.events = item->interest & EPOLL_POLLED_EVENTS,
+	};
+	struct k_poll_event *pev = item->events;
+	int ret;
+
+	ret = z_fdtable_call_ioctl(vtable, item->obj, ZFD_IOCTL_POLL_PREPARE,
+				   &pfd, &pev, item->events + EPOLL_ITEM_EVENTS);
+	if (ret == -EXDEV) {
+		/* Offloaded sockets have no objects to watch */
+		return -EOPNOTSUPP;
+	}
+
+	*num_events = pev - item->events;
+
+	return ret;
+}
+
+/* Start watching an idle item, must be called with the socket lock held */
+static int epoll_item_arm(struct epoll_item *item,
+			  const struct fd_op_vtable *vtable)
+{
+	k_spinlock_key_t key;
+	int num_events;
+	int ret;
+
+	ret = epoll_item_prepare(item, vtable, &num_events);
+	if (ret < 0 && ret != -EALREADY) {
+		return ret;
+	}
+
+	key = k_spin_lock(&epoll_lock);
+
+	if (ret == -EALREADY) {
+		epoll_item_queue(item);
+	} else if (num_events > 0) {
+		item->state = EPOLL_ITEM_ARMED;
+	} else {
+		/* Nothing to watch, only EPOLLERR and EPOLLHUP of interest */
+		item->state = EPOLL_ITEM_IDLE;
+	}
+
+	k_spin_unlock(&epoll_lock, key);
+
+	if (ret == 0 && num_events > 0) {
+		ret = k_work_poll_submit(&item->work, item->events, num_events,
+					 K_FOREVER);
+		if (ret < 0) {
+			/* Let zsock_epoll_wait() check and arm it again */
+			key = k_spin_lock(&epoll_lock);
+			if (item->state == EPOLL_ITEM_ARMED) {
+				epoll_item_queue(item);
+			}
+			k_spin_unlock(&epoll_lock, key);
+		}
+	}
+
+	return 0;
+}
+
+/* Stop watching an item, and remove it from the ready list */
+static void epoll_item_disarm(struct epoll_item *item)
+{
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&epoll_lock);
+
+	if (item->state == EPOLL_ITEM_QUEUED) {
+		sys_dlist_remove(&item->node);
+		item->state = EPOLL_ITEM_IDLE;
+	} else if (item->state == EPOLL_ITEM_ARMED) {
+		if (k_work_poll_cancel(&item->work) == 0) {
+			item->state = EPOLL_ITEM_IDLE;
+		} else {
+			struct k_work_sync sync;
+
+			/* Already triggered, the work handler must be done
+			 * with the events before the item is reused.
+			 */
+			__ASSERT(k_current_get() !=
+				 k_work_queue_thread_get(&k_sys_work_q),
+				 "epoll used from the system work queue");
+
+			item->state = EPOLL_ITEM_FLUSHING;
+			k_spin_unlock(&epoll_lock, key);
+
+			(void)k_work_flush(&item->work.work, &sync);
+
+			key = k_spin_lock(&epoll_lock);
+			if (item->state == EPOLL_ITEM_FLUSHING) {
+				item->state = EPOLL_ITEM_IDLE;
+			}
+		}
+	}
+
+	k_spin_unlock(&epoll_lock, key);
+}
+
+static void epoll_item_release(struct epoll_item *item)
+{
+	k_spinlock_key_t key;
+
+	epoll_item_disarm(item);
+
+	key = k_spin_lock(&epoll_lock);
+
+	if (item->state == EPOLL_ITEM_CHECKING) {
+		item->dead = true;
+	} else if (item->state != EPOLL_ITEM_FREE) {
+		epoll_item_free(item);
+	}
+
+	k_spin_unlock(&epoll_lock, key);
+}
+
+void zsock_epoll_forget(void *obj)
+{
+	for (int i = 0; i < ARRAY_SIZE(epoll_items); i++) {
+		if (epoll_items[i].state != EPOLL_ITEM_FREE &&
+		    epoll_items[i].obj == obj) {
+			epoll_item_release(&epoll_items[i]);
+		}
+	}
+}
+
+static struct epoll_item *epoll_item_find(struct epoll_instance *ep,
+					  void *obj)
+{
+	for (int i = 0; i < ARRAY_SIZE(epoll_items); i++) {
+		if (epoll_items[i].state != EPOLL_ITEM_FREE &&
+		    epoll_items[i].ep == ep && epoll_items[i].obj == obj &&
+		    !epoll_items[i].dead) {
+			return &epoll_items[i];
+		}
+	}
+
+	return NULL;
+}
+
+static struct epoll_item *epoll_item_alloc(struct epoll_instance *ep,
+					   void *obj, int fd)
+{
+	struct epoll_item *item = NULL;
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&epoll_lock);
+
+	for (int i = 0; i < ARRAY_SIZE(epoll_items); i++) {
+		if (epoll_items[i].state == EPOLL_ITEM_FREE) {
+			item = &epoll_items[i];
+			item->state = EPOLL_ITEM_IDLE;
+			item->ep = ep;
+			item->obj = obj;
+			item->fd = fd;
+			break;
+		}
+	}
+
+	k_spin_unlock(&epoll_lock, key);
+
+	if (item != NULL) {
+		k_work_poll_init(&item->work, epoll_item_trigger);
+	}
+
+	return item;
+}
+
+static int epoll_close_vmeth(void *obj)
+{
+	struct epoll_instance *ep = obj;
+
+	for (int i = 0; i < ARRAY_SIZE(epoll_items); i++) {
+		if (epoll_items[i].state != EPOLL_ITEM_FREE &&
+		    epoll_items[i].ep == ep) {
+			epoll_item_release(&epoll_items[i]);
+		}
+	}
+
+	ep->in_use = false;
+
+	return 0;
+}
+
+static int epoll_ioctl_vmeth(void *obj, unsigned int request, va_list args)
+{
+	ARG_UNUSED(obj);
+	ARG_UNUSED(args);
+
+	switch (request) {
+	case ZFD_IOCTL_SET_LOCK:
+		return 0;
+
+	default:
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+}
+
+static ssize_t epoll_read_vmeth(void *obj, void *buffer, size_t count)
+{
+	ARG_UNUSED(obj);
+	ARG_UNUSED(buffer);
+	ARG_UNUSED(count);
+
+	errno = EINVAL;
+	return -1;
+}
+
+static ssize_t epoll_write_vmeth(void *obj, const void *buffer, size_t count)
+{
+	ARG_UNUSED(obj);
+	ARG_UNUSED(buffer);
+	ARG_UNUSED(count);
+
+	errno = EINVAL;
+	return -1;
+}
+
+static const struct fd_op_vtable epoll_fd_op_vtable = {
+	.read = epoll_read_vmeth,
+	.write = epoll_write_vmeth,
+	.close = epoll_close_vmeth,
+	.ioctl = epoll_ioctl_vmeth,
+};
+
+int z_impl_zsock_epoll_create1(int flags)
+{
+	struct epoll_instance *ep = NULL;
+	k_spinlock_key_t key;
+	int fd;
+
+	if (flags != 0) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	fd = z_reserve_fd();
+	if (fd < 0) {
+		return -1;
+	}
+
+	key = k_spin_lock(&epoll_lock);
+
+	for (int i = 0; i < ARRAY_SIZE(epoll_instances); i++) {
+		if (!epoll_instances[i].in_use) {
+			ep = &epoll_instances[i];
+			ep->in_use = true;
+			break;
+		}
+	}
+
+	k_spin_unlock(&epoll_lock, key);
+
+	if (ep == NULL) {
+		z_free_fd(fd);
+		errno = ENFILE;
+		return -1;
+	}
+
+	sys_dlist_init(&ep->ready);
+	k_sem_init(&ep->ready_sem, 0, 1);
+
+	z_finalize_fd(fd, ep, &epoll_fd_op_vtable);
+
+	return fd;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_zsock_epoll_create1(int flags)
+{
+	return z_impl_zsock_epoll_create1(flags);
+}
+#include <syscalls/zsock_epoll_create1_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+static void *epoll_get_fd_obj(int fd, const struct fd_op_vtable **vtable,
+			      struct k_mutex **lock)
+{
+	void *obj;
+
+	obj = z_get_fd_obj_and_vtable(fd, vtable, lock);
+
+#ifdef CONFIG_USERSPACE
+	if (obj != NULL && z_is_in_user_syscall()) {
+		struct z_object *zo;
+		int ret;
+
+		zo = z_object_find(obj);
+		ret = z_object_validate(zo, K_OBJ_NET_SOCKET, _OBJ_INIT_TRUE);
+		if (ret != 0) {
+			z_dump_object_error(ret, obj, zo, K_OBJ_NET_SOCKET);
+			errno = EBADF;
+			obj = NULL;
+		}
+	}
+#endif /* CONFIG_USERSPACE */
+
+	return obj;
+}
+
+int z_impl_zsock_epoll_ctl(int epfd, int op, int fd,
+			   struct zsock_epoll_event *event)
+{
+	const struct fd_op_vtable *vtable;
+	struct epoll_instance *ep;
+	struct epoll_item *item;
+	struct k_mutex *lock;
+	void *obj;
+	int ret = 0;
+
+	ep = z_get_fd_obj(epfd, &epoll_fd_op_vtable, EINVAL);
+	if (ep == NULL) {
+		return -1;
+	}
+
+	obj = epoll_get_fd_obj(fd, &vtable, &lock);
+	if (obj == NULL) {
+		return -1;
+	}
+
+	if (obj == ep) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (op != ZSOCK_EPOLL_CTL_DEL &&
+	    (event == NULL ||
+	     (event->events & ~(EPOLL_POLLED_EVENTS | EPOLL_ALWAYS_EVENTS |
+				ZSOCK_EPOLLONESHOT)) != 0)) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	item = epoll_item_find(ep, obj);
+
+	switch (op) {
+	case ZSOCK_EPOLL_CTL_ADD:
+		if (item != NULL) {
+			ret = -EEXIST;
+			break;
+		}
+
+		item = epoll_item_alloc(ep, obj, fd);
+		if (item == NULL) {
+			ret = -ENOMEM;
+			break;
+		}
+
+		item->interest = event->events;
+		item->data = event->data;
+
+		ret = epoll_item_arm(item, vtable);
+		if (ret < 0) {
+			epoll_item_release(item);
+		}
+
+		break;
+
+	case ZSOCK_EPOLL_CTL_MOD:
+		if (item == NULL) {
+			ret = -ENOENT;
+			break;
+		}
+
+		epoll_item_disarm(item);
+
+		item->interest = event->events;
+		item->data = event->data;
+
+		/* Being checked, the checker will use the new events */
+		if (item->state == EPOLL_ITEM_IDLE) {
+			ret = epoll_item_arm(item, vtable);
+		}
+
+		break;
+
+	case ZSOCK_EPOLL_CTL_DEL:
+		if (item == NULL) {
+			ret = -ENOENT;
+			break;
+		}
+
+		epoll_item_release(item);
+		break;
+
+	default:
+		ret = -EINVAL;
+		break;
+	}
+
+	k_mutex_unlock(lock);
+
+	if (ret < 0) {
+		errno = -ret;
+		return -1;
+	}
+
+	return 0;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_zsock_epoll_ctl(int epfd, int op, int fd,
+					 struct zsock_epoll_event *event)
+{
+	struct zsock_epoll_event event_copy;
+
+	if (event != NULL) {
+		Z_OOPS(z_user_from_copy(&event_copy, event,
+					sizeof(event_copy)));
+		event = &event_copy;
+	}
+
+	return z_impl_zsock_epoll_ctl(epfd, op, fd, event);
+}
+#include <syscalls/zsock_epoll_ctl_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+/* Check an item taken from the ready list. Returns the events to report,
+ * and leaves the item queued, armed or idle.
+ */
+static uint32_t epoll_item_check(struct epoll_item *item)
+{
+	const struct fd_op_vtable *vtable;
+	struct zsock_pollfd pfd;
+	struct k_poll_event *pev;
+	k_spinlock_key_t key;
+	struct k_mutex *lock;
+	uint32_t revents = 0;
+	int num_events;
+	void *obj;
+	int ret;
+
+	obj = z_get_fd_obj_and_vtable(item->fd, &vtable, &lock);
+	if (obj != item->obj) {
+		/* Closed without being forgotten, e.g. not a socket */
+		key = k_spin_lock(&epoll_lock);
+		epoll_item_free(item);
+		k_spin_unlock(&epoll_lock, key);
+
+		return 0;
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	key = k_spin_lock(&epoll_lock);
+	if (item->dead) {
+		epoll_item_free(item);
+		k_spin_unlock(&epoll_lock, key);
+		k_mutex_unlock(lock);
+
+		return 0;
+	}
+	k_spin_unlock(&epoll_lock, key);
+
+	ret = epoll_item_prepare(item, vtable, &num_events);
+	if (ret == 0 || ret == -EALREADY) {
+		if (num_events > 0) {
+			(void)k_poll(item->events, num_events, K_NO_WAIT);
+		}
+
+		pfd.fd = item->fd;
+		pfd.events = item->interest & EPOLL_POLLED_EVENTS;
+		pfd.revents = 0;
+		pev = item->events;
+
+		ret = z_fdtable_call_ioctl(vtable, obj, ZFD_IOCTL_POLL_UPDATE,
+					   &pfd, &pev);
+		if (ret == 0) {
+			revents = pfd.revents &
+				  (item->interest | EPOLL_ALWAYS_EVENTS);
+		}
+	}
+
+	key = k_spin_lock(&epoll_lock);
+
+	if (item->dead) {
+		/* Epoll instance closed meanwhile */
+		epoll_item_free(item);
+		k_spin_unlock(&epoll_lock, key);
+		revents = 0;
+	} else if (revents != 0) {
+		if (item->interest & ZSOCK_EPOLLONESHOT) {
+			item->state = EPOLL_ITEM_IDLE;
+		} else {
+			/* Level triggered, report it again until not ready */
+			epoll_item_queue(item);
+		}
+
+		k_spin_unlock(&epoll_lock, key);
+	} else {
+		item->state = EPOLL_ITEM_IDLE;
+		k_spin_unlock(&epoll_lock, key);
+
+		(void)epoll_item_arm(item, vtable);
+	}
+
+	k_mutex_unlock(lock);
+
+	return revents;
+}
+
+static int epoll_collect(struct epoll_instance *ep,
+			 struct zsock_epoll_event *events, int maxevents)
+{
+	struct epoll_item *item;
+	k_spinlock_key_t key;
+	sys_dnode_t *last;
+	sys_dnode_t *node;
+	uint32_t revents;
+	int count = 0;
+
+	key = k_spin_lock(&epoll_lock);
+
+	/* Items reported again are queued after the last one */
+	last = sys_dlist_peek_tail(&ep->ready);
+
+	while (last != NULL && count < maxevents) {
+		node = sys_dlist_get(&ep->ready);
+		if (node == NULL) {
+			break;
+		}
+
+		item = CONTAINER_OF(node, struct epoll_item, node);
+		item->state = EPOLL_ITEM_CHECKING;
+
+		k_spin_unlock(&epoll_lock, key);
+
+		revents = epoll_item_check(item);
+		if (revents != 0) {
+			events[count].events = revents;
+			events[count].data = item->data;
+			count++;
+		}
+
+		key = k_spin_lock(&epoll_lock);
+
+		if (node == last) {
+			break;
+		}
+	}
+
+	k_spin_unlock(&epoll_lock, key);
+
+	return count;
+}
+
+int z_impl_zsock_epoll_wait(int epfd, struct zsock_epoll_event *events,
+			    int maxevents, int timeout)
+{
+	struct epoll_instance *ep;
+	k_timepoint_t end;
+	int count;
+
+	ep = z_get_fd_obj(epfd, &epoll_fd_op_vtable, EINVAL);
+	if (ep == NULL) {
+		return -1;
+	}
+
+	if (maxevents <= 0) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	end = sys_timepoint_calc(timeout < 0 ? K_FOREVER : K_MSEC(timeout));
+
+	while (true) {
+		k_sem_reset(&ep->ready_sem);
+
+		count = epoll_collect(ep, events, maxevents);
+		if (count > 0) {
+			break;
+		}
+
+		if (k_sem_take(&ep->ready_sem,
+			       sys_timepoint_timeout(end)) != 0) {
+			break;
+		}
+	}
+
+	return count;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_zsock_epoll_wait(int epfd,
+					  struct zsock_epoll_event *events,
+					  int maxevents, int timeout)
+{
+	if (maxevents > 0) {
+		Z_OOPS(Z_SYSCALL_MEMORY_ARRAY_WRITE(events, maxevents,
+						    sizeof(*events)));
+	}
+
+	return z_impl_zsock_epoll_wait(epfd, events, maxevents, timeout);
+}
+#include <syscalls/zsock_epoll_wait_mrsh.c>
+#endif /* CONFIG_USERSPACE */
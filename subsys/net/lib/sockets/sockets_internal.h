@@ -36,6 +36,15 @@ static inline uintptr_t sock_get_flag(struct net_context *ctx, uintptr_t mask)
 
 void net_socket_update_tc_rx_time(struct net_pkt *pkt, uint32_t end_tick);
 
+#if defined(CONFIG_NET_SOCKETS_EPOLL)
+void zsock_epoll_forget(void *obj);
+#else
+static inline void zsock_epoll_forget(void *obj)
+{
+	ARG_UNUSED(obj);
+}
+#endif
+
 #if defined(CONFIG_NET_SOCKETS_SOCKOPT_TLS)
 bool net_socket_is_tls(void *obj);
 #else
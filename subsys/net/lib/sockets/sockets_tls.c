@@ -51,8 +51,14 @@ LOG_MODULE_REGISTER(net_sock_tls, CONFIG_NET_SOCKETS_LOG_LEVEL);
 #include <mbedtls/error.h>
 #include <mbedtls/platform.h>
 #include <mbedtls/ssl_cache.h>
+#include <mbedtls/ssl_ticket.h>
 #endif /* CONFIG_MBEDTLS */
 
+#if defined(CONFIG_NET_SOCKETS_TLS_SESSION_SETTINGS)
+#include <stdlib.h>
+#include <zephyr/settings/settings.h>
+#endif
+
 #include "sockets_internal.h"
 #include "tls_internal.h"
 
@@ -99,7 +105,7 @@ struct dtls_timing_context {
 
 /** TLS peer address/session ID mapping. */
 struct tls_session_cache {
-	/** Creation time. */
+	/** Last time the session was stored or used. */
 	int64_t timestamp;
 
 	/** Peer address. */
@@ -141,6 +147,29 @@ __net_socket struct tls_context {
 	/** Information whether TLS handshake is complete or not. */
 	struct k_sem tls_established;
 
+#if defined(CONFIG_NET_SOCKETS_TLS_HANDSHAKE_WORKQ)
+	/** Handshake of a non-blocking socket, run on the handshake work
+	 *  queue.
+	 */
+	struct k_work handshake_work;
+
+	/** Raised with the handshake result once the work is done. */
+	struct k_poll_signal handshake_signal;
+
+	/** Time at which the handshake work gives up. */
+	k_timepoint_t handshake_end;
+
+	/** Information whether the handshake work is pending or running,
+	 *  protected by the socket lock.
+	 */
+	bool handshake_pending;
+
+	/** Error of the handshake work, reported once by SO_ERROR,
+	 *  protected by the socket lock.
+	 */
+	int handshake_error;
+#endif
+
 	/* TLS socket mutex lock. */
 	struct k_mutex *lock;
 
@@ -233,6 +262,21 @@ static struct tls_session_cache client_cache[CONFIG_NET_SOCKETS_TLS_MAX_CLIENT_S
 static mbedtls_ssl_cache_context server_cache;
 #endif
 
+#if defined(MBEDTLS_SSL_TICKET_C)
+static mbedtls_ssl_ticket_context ticket_ctx;
+
+#if defined(MBEDTLS_GCM_C)
+#define TLS_TICKET_CIPHER MBEDTLS_CIPHER_AES_128_GCM
+#else
+#define TLS_TICKET_CIPHER MBEDTLS_CIPHER_AES_128_CCM
+#endif
+#endif /* MBEDTLS_SSL_TICKET_C */
+
+#if defined(CONFIG_NET_SOCKETS_TLS_SESSION_SETTINGS)
+#define TLS_SESSION_SETTINGS_KEY "net_tls/sess"
+#define TLS_SESSION_SETTINGS_KEY_LEN sizeof(TLS_SESSION_SETTINGS_KEY "/xxx")
+#endif
+
 /* A mutex for protecting TLS context allocation. */
 static struct k_mutex context_lock;
 
@@ -241,11 +285,111 @@ static struct k_mutex context_lock;
  */
 #define TLS_WAIT_MS 100
 
+#if defined(CONFIG_NET_SOCKETS_TLS_HANDSHAKE_WORKQ)
+static K_KERNEL_STACK_DEFINE(tls_handshake_stack,
+			     CONFIG_NET_SOCKETS_TLS_HANDSHAKE_STACK_SIZE);
+static struct k_work_q tls_handshake_workq;
+
+static void tls_handshake_work(struct k_work *work);
+#endif
+
+#if defined(CONFIG_NET_SOCKETS_TLS_SESSION_SETTINGS)
+/* A stored session is the peer address followed by the serialized session.
+ */
+static void tls_session_settings_save(int idx)
+{
+	struct tls_session_cache *entry = &client_cache[idx];
+	char key[TLS_SESSION_SETTINGS_KEY_LEN];
+	uint8_t *value;
+	size_t len;
+	int ret;
+
+	snprintk(key, sizeof(key), TLS_SESSION_SETTINGS_KEY "/%d", idx);
+
+	if (entry->session == NULL) {
+		(void)settings_delete(key);
+		return;
+	}
+
+	len = sizeof(entry->peer_addr) + entry->session_len;
+
+	value = mbedtls_calloc(1, len);
+	if (value == NULL) {
+		NET_ERR("Failed to allocate session settings buffer.");
+		return;
+	}
+
+	memcpy(value, &entry->peer_addr, sizeof(entry->peer_addr));
+	memcpy(value + sizeof(entry->peer_addr), entry->session,
+	       entry->session_len);
+
+	ret = settings_save_one(key, value, len);
+	if (ret < 0) {
+		NET_ERR("Failed to store session, err: %d.", ret);
+	}
+
+	mbedtls_free(value);
+}
+
+static int tls_session_settings_set(const char *name, size_t len,
+				    settings_read_cb read_cb, void *cb_arg)
+{
+	struct tls_session_cache *entry;
+	uint8_t *value;
+	char *end;
+	long idx;
+
+	idx = strtol(name, &end, 10);
+	if (end == name || *end != '\0' || idx < 0 ||
+	    idx >= ARRAY_SIZE(client_cache) ||
+	    len <= sizeof(entry->peer_addr)) {
+		return -EINVAL;
+	}
+
+	value = mbedtls_calloc(1, len);
+	if (value == NULL) {
+		return -ENOMEM;
+	}
+
+	if (read_cb(cb_arg, value, len) != len) {
+		mbedtls_free(value);
+		return -EIO;
+	}
+
+	entry = &client_cache[idx];
+
+	if (entry->session != NULL) {
+		mbedtls_free(entry->session);
+	}
+
+	/* Keep only the session in the buffer */
+	memcpy(&entry->peer_addr, value, sizeof(entry->peer_addr));
+	memmove(value, value + sizeof(entry->peer_addr),
+		len - sizeof(entry->peer_addr));
+
+	entry->session = value;
+	entry->session_len = len - sizeof(entry->peer_addr);
+	entry->timestamp = k_uptime_get();
+
+	return 0;
+}
+
+SETTINGS_STATIC_HANDLER_DEFINE(net_tls_sess, TLS_SESSION_SETTINGS_KEY, NULL,
+			       tls_session_settings_set, NULL, NULL);
+#else
+static inline void tls_session_settings_save(int idx)
+{
+	ARG_UNUSED(idx);
+}
+#endif /* CONFIG_NET_SOCKETS_TLS_SESSION_SETTINGS */
+
 static void tls_session_cache_reset(void)
 {
 	for (int i = 0; i < ARRAY_SIZE(client_cache); i++) {
 		if (client_cache[i].session != NULL) {
 			mbedtls_free(client_cache[i].session);
+			client_cache[i].session = NULL;
+			tls_session_settings_save(i);
 		}
 	}
 
@@ -270,6 +414,22 @@ static int tls_ctr_drbg_random(void *ctx, unsigned char *buf, size_t len)
 #endif
 }
 
+#if defined(MBEDTLS_SSL_TICKET_C)
+static void tls_ticket_init(void)
+{
+	int ret;
+
+	mbedtls_ssl_ticket_init(&ticket_ctx);
+
+	ret = mbedtls_ssl_ticket_setup(&ticket_ctx, tls_ctr_drbg_random, NULL,
+				       TLS_TICKET_CIPHER,
+				       CONFIG_NET_SOCKETS_TLS_SESSION_TICKET_LIFETIME);
+	if (ret != 0) {
+		NET_ERR("Failed to setup session tickets, err: 0x%x.", -ret);
+	}
+}
+#endif /* MBEDTLS_SSL_TICKET_C */
+
 #if defined(CONFIG_NET_SOCKETS_ENABLE_DTLS)
 /* mbedTLS-defined function for setting timer. */
 static void dtls_timing_set_delay(void *data, uint32_t int_ms, uint32_t fin_ms)
@@ -352,6 +512,19 @@ static int tls_init(void)
 	mbedtls_ssl_cache_init(&server_cache);
 #endif
 
+#if defined(MBEDTLS_SSL_TICKET_C)
+	tls_ticket_init();
+#endif
+
+#if defined(CONFIG_NET_SOCKETS_TLS_HANDSHAKE_WORKQ)
+	k_work_queue_start(&tls_handshake_workq, tls_handshake_stack,
+			   K_KERNEL_STACK_SIZEOF(tls_handshake_stack),
+			   K_PRIO_PREEMPT(CONFIG_NET_SOCKETS_TLS_HANDSHAKE_PRIO),
+			   &(struct k_work_queue_config){
+				   .name = "tls_handshake",
+			   });
+#endif
+
 	return 0;
 }
 
@@ -436,6 +609,10 @@ static struct tls_context *tls_alloc(void)
 
 	if (tls) {
 		k_sem_init(&tls->tls_established, 0, 1);
+#if defined(CONFIG_NET_SOCKETS_TLS_HANDSHAKE_WORKQ)
+		k_work_init(&tls->handshake_work, tls_handshake_work);
+		k_poll_signal_init(&tls->handshake_signal);
+#endif
 
 		mbedtls_ssl_init(&tls->ssl);
 		mbedtls_ssl_config_init(&tls->config);
@@ -547,6 +724,8 @@ static int tls_session_save(const struct sockaddr *peer_addr,
 {
 	struct tls_session_cache *entry = NULL;
 	size_t session_len;
+	uint8_t *buf;
+	bool changed;
 	int ret;
 
 	for (int i = 0; i < ARRAY_SIZE(client_cache); i++) {
@@ -571,34 +750,45 @@ static int tls_session_save(const struct sockaddr *peer_addr,
 		}
 	}
 
-	/* Allocate session and save */
-
-	if (entry->session != NULL) {
-		mbedtls_free(entry->session);
-		entry->session = NULL;
-	}
+	/* Serialize the session */
 
 	(void)mbedtls_ssl_session_save(session, NULL, 0, &session_len);
 
-	entry->session = mbedtls_calloc(1, session_len);
-	if (entry->session == NULL) {
+	buf = mbedtls_calloc(1, session_len);
+	if (buf == NULL) {
 		NET_ERR("Failed to allocate session buffer.");
 		return -ENOMEM;
 	}
 
-	ret = mbedtls_ssl_session_save(session, entry->session, session_len,
+	ret = mbedtls_ssl_session_save(session, buf, session_len,
 				       &session_len);
 	if (ret < 0) {
 		NET_ERR("Failed to serialize session, err: 0x%x.", -ret);
-		mbedtls_free(entry->session);
-		entry->session = NULL;
+		mbedtls_free(buf);
 		return -ENOMEM;
 	}
 
+	/* A resumed session serializes to the cached one, only write new
+	 * or changed sessions to the settings storage.
+	 */
+	changed = entry->session == NULL ||
+		  entry->session_len != session_len ||
+		  !peer_addr_cmp(&entry->peer_addr, peer_addr) ||
+		  memcmp(entry->session, buf, session_len) != 0;
+
+	if (entry->session != NULL) {
+		mbedtls_free(entry->session);
+	}
+
+	entry->session = buf;
 	entry->session_len = session_len;
 	entry->timestamp = k_uptime_get();
 	memcpy(&entry->peer_addr, peer_addr, sizeof(*peer_addr));
 
+	if (changed) {
+		tls_session_settings_save(entry - client_cache);
+	}
+
 	return 0;
 }
 
@@ -626,9 +816,13 @@ static int tls_session_get(const struct sockaddr *peer_addr,
 		/* Discard corrupted session data. */
 		mbedtls_free(entry->session);
 		entry->session = NULL;
+		tls_session_settings_save(entry - client_cache);
 		return -EIO;
 	}
 
+	/* Least recently used sessions are replaced first. */
+	entry->timestamp = k_uptime_get();
+
 	return 0;
 }
 
@@ -700,6 +894,12 @@ static void tls_session_purge(void)
 	mbedtls_ssl_cache_free(&server_cache);
 	mbedtls_ssl_cache_init(&server_cache);
 #endif
+
+#if defined(MBEDTLS_SSL_TICKET_C)
+	/* New ticket keys, so that the issued tickets are not accepted */
+	mbedtls_ssl_ticket_free(&ticket_ctx);
+	tls_ticket_init();
+#endif
 }
 
 static inline int time_left(uint32_t start, uint32_t timeout)
@@ -1241,6 +1441,103 @@ static int tls_mbedtls_handshake(struct tls_context *context,
 	return ret;
 }
 
+#if defined(CONFIG_NET_SOCKETS_TLS_HANDSHAKE_WORKQ)
+static void tls_handshake_work(struct k_work *work)
+{
+	struct tls_context *ctx = CONTAINER_OF(work, struct tls_context,
+					       handshake_work);
+	struct sockaddr addr;
+	socklen_t addrlen = sizeof(addr);
+	int ret;
+
+	/* Run the handshake in slices and requeue the work in between, so
+	 * that an unresponsive peer does not hold back the handshakes of the
+	 * other sockets. Requeueing fails once the work is being cancelled.
+	 */
+	ret = tls_mbedtls_handshake(ctx, K_MSEC(TLS_WAIT_MS));
+	if (ret == -EAGAIN) {
+		if (sys_timepoint_expired(ctx->handshake_end)) {
+			NET_ERR("TLS handshake timeout");
+			ret = -ETIMEDOUT;
+		} else if (k_work_submit_to_queue(&tls_handshake_workq,
+						  work) >= 0) {
+			return;
+		} else {
+			ret = -ECONNABORTED;
+		}
+	}
+
+	if (ret == 0 && zsock_getpeername(ctx->sock, &addr, &addrlen) == 0) {
+		tls_session_store(ctx, &addr, addrlen);
+	}
+
+	NET_DBG("Handshake of %p done (%d)", ctx, ret);
+
+	k_mutex_lock(ctx->lock, K_FOREVER);
+	ctx->handshake_error = -ret;
+	ctx->handshake_pending = false;
+	k_mutex_unlock(ctx->lock);
+
+	k_poll_signal_raise(&ctx->handshake_signal, ret);
+}
+
+/* Called with the socket lock held, like the other handshake state
+ * updates.
+ */
+static int tls_handshake_start(struct tls_context *ctx)
+{
+	k_poll_signal_reset(&ctx->handshake_signal);
+	ctx->handshake_error = 0;
+	ctx->handshake_pending = true;
+	ctx->handshake_end = sys_timepoint_calc(
+		K_MSEC(CONFIG_NET_SOCKETS_TLS_HANDSHAKE_TIMEOUT));
+
+	(void)k_work_submit_to_queue(&tls_handshake_workq,
+				     &ctx->handshake_work);
+
+	return -EINPROGRESS;
+}
+
+static void tls_handshake_cancel(struct tls_context *ctx)
+{
+	struct k_work_sync sync;
+
+	/* The work takes the socket lock to report its result, release it
+	 * while waiting for the work.
+	 */
+	k_mutex_unlock(ctx->lock);
+	(void)k_work_cancel_sync(&ctx->handshake_work, &sync);
+	k_mutex_lock(ctx->lock, K_FOREVER);
+
+	ctx->handshake_pending = false;
+}
+
+/* Return an error if the socket cannot be used because of its handshake
+ * work.
+ */
+static int tls_handshake_check(struct tls_context *ctx)
+{
+	if (ctx->handshake_pending) {
+		return -EAGAIN;
+	}
+
+	if (ctx->type == SOCK_STREAM && ctx->is_initialized &&
+	    !is_handshake_complete(ctx)) {
+		/* The handshake work failed. */
+		return -ENOTCONN;
+	}
+
+	return 0;
+}
+#else
+static inline int tls_handshake_check(struct tls_context *ctx)
+{
+	ARG_UNUSED(ctx);
+
+	return 0;
+}
+#endif /* CONFIG_NET_SOCKETS_TLS_HANDSHAKE_WORKQ */
+
 static int tls_mbedtls_init(struct tls_context *context, bool is_server)
 {
 	int role, type, ret;
@@ -1364,6 +1661,15 @@ static int tls_mbedtls_init(struct tls_context *context, bool is_server)
 	}
 #endif
 
+#if defined(MBEDTLS_SSL_TICKET_C)
+	if (is_server && context->options.cache_enabled) {
+		mbedtls_ssl_conf_session_tickets_cb(&context->config,
+						    mbedtls_ssl_ticket_write,
+						    mbedtls_ssl_ticket_parse,
+						    &ticket_ctx);
+	}
+#endif
+
 	ret = mbedtls_ssl_setup(&context->ssl,
 				&context->config);
 	if (ret != 0) {
@@ -1845,6 +2151,12 @@ int ztls_close_ctx(struct tls_context *ctx)
 {
 	int ret, err = 0;
 
+	zsock_epoll_forget(ctx);
+
+#if defined(CONFIG_NET_SOCKETS_TLS_HANDSHAKE_WORKQ)
+	tls_handshake_cancel(ctx);
+#endif
+
 	/* Try to send close notification. */
 	ctx->flags = 0;
 
@@ -1871,6 +2183,13 @@ int ztls_connect_ctx(struct tls_context *ctx, const struct sockaddr *addr,
 	int ret;
 	int sock_flags;
 
+#if defined(CONFIG_NET_SOCKETS_TLS_HANDSHAKE_WORKQ)
+	if (ctx->handshake_pending) {
+		errno = EALREADY;
+		return -1;
+	}
+#endif
+
 	sock_flags = zsock_fcntl(ctx->sock, F_GETFL, 0);
 	if (sock_flags < 0) {
 		return -EIO;
@@ -1902,6 +2221,13 @@ int ztls_connect_ctx(struct tls_context *ctx, const struct sockaddr *addr,
 
 		tls_session_restore(ctx, addr, addrlen);
 
+#if defined(CONFIG_NET_SOCKETS_TLS_HANDSHAKE_WORKQ)
+		if (sock_flags & O_NONBLOCK) {
+			ret = tls_handshake_start(ctx);
+			goto error;
+		}
+#endif
+
 		/* TODO For simplicity, TLS handshake blocks the socket
 		 * even for non-blocking socket.
 		 */
@@ -2135,6 +2461,14 @@ ssize_t ztls_sendto_ctx(struct tls_context *ctx, const void *buf, size_t len,
 			int flags, const struct sockaddr *dest_addr,
 			socklen_t addrlen)
 {
+	int ret;
+
+	ret = tls_handshake_check(ctx);
+	if (ret < 0) {
+		errno = -ret;
+		return -1;
+	}
+
 	ctx->flags = flags;
 
 	/* TLS */
@@ -2536,6 +2870,8 @@ ssize_t ztls_recvfrom_ctx(struct tls_context *ctx, void *buf, size_t max_len,
 			  int flags, struct sockaddr *src_addr,
 			  socklen_t *addrlen)
 {
+	int ret;
+
 	if (flags & ZSOCK_MSG_PEEK) {
 		/* TODO mbedTLS does not support 'peeking' This could be
 		 * bypassed by having intermediate buffer for peeking
@@ -2544,6 +2880,12 @@ ssize_t ztls_recvfrom_ctx(struct tls_context *ctx, void *buf, size_t max_len,
 		return -1;
 	}
 
+	ret = tls_handshake_check(ctx);
+	if (ret < 0) {
+		errno = -ret;
+		return -1;
+	}
+
 	ctx->flags = flags;
 
 	/* TLS */
@@ -2592,6 +2934,23 @@ static int ztls_poll_prepare_ctx(struct tls_context *ctx,
 	int ret;
 	short events = pfd->events;
 
+#if defined(CONFIG_NET_SOCKETS_TLS_HANDSHAKE_WORKQ)
+	/* Wait for the handshake work instead of the underlying socket. */
+	if (ctx->handshake_pending) {
+		if (*pev == pev_end) {
+			return -ENOMEM;
+		}
+
+		(*pev)->obj = &ctx->handshake_signal;
+		(*pev)->type = K_POLL_TYPE_SIGNAL;
+		(*pev)->mode = K_POLL_MODE_NOTIFY_ONLY;
+		(*pev)->state = K_POLL_STATE_NOT_READY;
+		(*pev)++;
+
+		return 0;
+	}
+#endif
+
 	/* DTLS client should wait for the handshake to complete before
 	 * it actually starts to poll for data.
 	 */
@@ -2736,6 +3095,23 @@ static int ztls_poll_update_ctx(struct tls_context *ctx,
 	int ret;
 	short events = pfd->events;
 
+#if defined(CONFIG_NET_SOCKETS_TLS_HANDSHAKE_WORKQ)
+	if ((*pev)->obj == &ctx->handshake_signal) {
+		if ((*pev)->state != K_POLL_STATE_NOT_READY) {
+			/* Connected, or failed with the error in SO_ERROR */
+			if (ctx->handshake_signal.result == 0) {
+				pfd->revents |= pfd->events & ZSOCK_POLLOUT;
+			} else {
+				pfd->revents |= ZSOCK_POLLERR;
+			}
+		}
+
+		(*pev)++;
+
+		return 0;
+	}
+#endif
+
 	obj = z_get_fd_obj_and_vtable(
 		ctx->sock, (const struct fd_op_vtable **)&vtable, &lock);
 	if (obj == NULL) {
@@ -2968,7 +3344,25 @@ int ztls_getsockopt_ctx(struct tls_context *ctx, int level, int optname,
 			return -1;
 		}
 		return err;
-	} else if (level != SOL_TLS) {
+	}
+
+#if defined(CONFIG_NET_SOCKETS_TLS_HANDSHAKE_WORKQ)
+	if (level == SOL_SOCKET && optname == SO_ERROR &&
+	    ctx->handshake_error != 0) {
+		if (*optlen != sizeof(int)) {
+			errno = EINVAL;
+			return -1;
+		}
+
+		/* Reported once, like the error of the underlying socket. */
+		*(int *)optval = ctx->handshake_error;
+		ctx->handshake_error = 0;
+
+		return 0;
+	}
+#endif
+
+	if (level != SOL_TLS) {
 		return zsock_getsockopt(ctx->sock, level, optname,
 					optval, optlen);
 	}
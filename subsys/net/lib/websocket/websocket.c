@@ -574,6 +574,46 @@ static int sendmsg_all(int sock, const struct msghdr *message, int flags)
 }
 #endif /* !defined(CONFIG_NET_TEST) */
 
+/* XOR data with the masking key, offset being the position of data[0] in
+ * the payload of the frame. The key is applied a word at a time once the
+ * data pointer is word aligned.
+ */
+static void websocket_mask(uint8_t *data, size_t len, uint32_t masking_value,
+			   size_t offset)
+{
+	uint32_t mask;
+	uint8_t shift;
+
+	/* Rotate the key so that its most significant byte applies to data[0] */
+	shift = (offset % 4) * 8;
+	mask = shift ? (masking_value << shift) | (masking_value >> (32 - shift)) :
+		       masking_value;
+
+	while (len > 0 && !IS_PTR_ALIGNED(data, uint32_t)) {
+		*data++ ^= mask >> 24;
+		mask = (mask << 8) | (mask >> 24);
+		len--;
+	}
+
+	if (len >= sizeof(uint32_t)) {
+		/* Key bytes in memory order */
+		uint32_t word_mask = sys_cpu_to_be32(mask);
+		uint32_t *words = (uint32_t *)data;
+
+		for (; len >= sizeof(uint32_t); len -= sizeof(uint32_t)) {
+			*words++ ^= word_mask;
+		}
+
+		data = (uint8_t *)words;
+	}
+
+	while (len > 0) {
+		*data++ ^= mask >> 24;
+		mask = (mask << 8) | (mask >> 24);
+		len--;
+	}
+}
+
 static int websocket_prepare_and_send(struct websocket_context *ctx,
 				      uint8_t *header, size_t header_len,
 				      uint8_t *payload, size_t payload_len,
@@ -687,8 +727,6 @@ int websocket_send_msg(int ws_sock, const uint8_t *payload, size_t payload_len,
 
 	/* Add masking value if needed */
 	if (mask) {
-		int i;
-
 		ctx->masking_value = sys_rand32_get();
 
 		header[hdr_len++] |= ctx->masking_value >> 24;
@@ -703,10 +741,8 @@ int websocket_send_msg(int ws_sock, const uint8_t *payload, size_t payload_len,
 			}
 
 			memcpy(data_to_send, payload, payload_len);
-
-			for (i = 0; i < payload_len; i++) {
-				data_to_send[i] ^= ctx->masking_value >> (8 * (3 - i % 4));
-			}
+			websocket_mask(data_to_send, payload_len,
+				       ctx->masking_value, 0);
 		}
 	}
 
@@ -945,12 +981,26 @@ int websocket_recv_msg(int ws_sock, uint8_t *buf, size_t buf_len,
 		size_t parsed_count;
 
 		if (ctx->recv_buf.count == 0) {
+			uint8_t *dst = ctx->recv_buf.buf;
+			size_t dst_len = ctx->recv_buf.size;
+			bool direct = false;
+
+			/* Within a frame payload, receive straight into the
+			 * caller buffer instead of copying through recv_buf.
+			 */
+			if (ctx->parser_state == WEBSOCKET_PARSER_STATE_PAYLOAD &&
+			    payload.count < payload.size) {
+				dst = &payload.buf[payload.count];
+				dst_len = MIN(payload.size - payload.count,
+					      ctx->parser_remaining);
+				direct = true;
+			}
 #if defined(CONFIG_NET_TEST)
-			size_t input_len = MIN(ctx->recv_buf.size,
+			size_t input_len = MIN(dst_len,
 					       test_data->input_len - test_data->input_pos);
 
 			if (input_len > 0) {
-				memcpy(ctx->recv_buf.buf,
+				memcpy(dst,
 				       &test_data->input_buf[test_data->input_pos], input_len);
 				test_data->input_pos += input_len;
 				ret = input_len;
@@ -963,8 +1013,8 @@ int websocket_recv_msg(int ws_sock, uint8_t *buf, size_t buf_len,
 
 			ret = wait_rx(ctx->real_sock, timeout_to_ms(&tout));
 			if (ret == 0) {
-				ret = recv(ctx->real_sock, ctx->recv_buf.buf,
-					   ctx->recv_buf.size, MSG_DONTWAIT);
+				ret = recv(ctx->real_sock, dst, dst_len,
+					   MSG_DONTWAIT);
 				if (ret < 0) {
 					ret = -errno;
 				}
@@ -984,9 +1034,19 @@ int websocket_recv_msg(int ws_sock, uint8_t *buf, size_t buf_len,
 				return -ENOTCONN;
 			}
 
-			ctx->recv_buf.count = ret;
+			NET_DBG("[%p] Received %d bytes%s", ctx, ret,
+				direct ? " of payload" : "");
 
-			NET_DBG("[%p] Received %d bytes", ctx, ret);
+			if (direct) {
+				payload.count += ret;
+				ctx->parser_remaining -= ret;
+				if (ctx->parser_remaining == 0) {
+					ctx->parser_state =
+						WEBSOCKET_PARSER_STATE_OPCODE;
+				}
+			} else {
+				ctx->recv_buf.count = ret;
+			}
 		}
 
 		ret = websocket_parse(ctx, &payload);
@@ -1019,15 +1079,8 @@ int websocket_recv_msg(int ws_sock, uint8_t *buf, size_t buf_len,
 
 	/* Unmask the data */
 	if (ctx->masked) {
-		uint8_t *mask_as_bytes = (uint8_t *)&ctx->masking_value;
-		size_t data_buf_offset = ctx->message_len - ctx->parser_remaining - payload.count;
-
-		for (size_t i = 0; i < payload.count; i++) {
-			size_t m = data_buf_offset % 4;
-
-			payload.buf[i] ^= mask_as_bytes[3 - m];
-			data_buf_offset++;
-		}
+		websocket_mask(payload.buf, payload.count, ctx->masking_value,
+			       ctx->message_len - ctx->parser_remaining - payload.count);
 	}
 
 	return payload.count;
@@ -213,6 +213,118 @@ void zperf_async_work_submit(struct k_work *work)
 	k_work_submit_to_queue(&zperf_work_q, work);
 }
 
+#if CONFIG_NET_ZPERF_MAX_STREAMS > 1
+struct zperf_stream {
+	struct k_thread thread;
+	const struct zperf_upload_params *param;
+	struct zperf_results *result;
+	size_t index;
+	int proto;
+	int ret;
+};
+
+static K_THREAD_STACK_ARRAY_DEFINE(zperf_stream_stacks,
+				   CONFIG_NET_ZPERF_MAX_STREAMS,
+				   CONFIG_NET_ZPERF_STREAM_STACK_SIZE);
+static struct zperf_stream zperf_streams[CONFIG_NET_ZPERF_MAX_STREAMS];
+static atomic_t zperf_streams_busy;
+
+static int zperf_upload_stream(const struct zperf_upload_params *param,
+			       int proto, size_t index,
+			       struct zperf_results *result)
+{
+	if (proto == IPPROTO_UDP) {
+		return zperf_udp_upload_stream(param, index, result);
+	}
+
+	return zperf_tcp_upload(param, result);
+}
+
+static void zperf_stream_thread(void *p1, void *p2, void *p3)
+{
+	struct zperf_stream *stream = p1;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	stream->ret = zperf_upload_stream(stream->param, stream->proto,
+					  stream->index, stream->result);
+}
+
+int zperf_upload_streams(const struct zperf_upload_params *param, int proto,
+			 size_t streams, struct zperf_results *results)
+{
+	int ret = 0;
+
+	if (param == NULL || results == NULL || streams == 0 ||
+	    streams > ARRAY_SIZE(zperf_streams) ||
+	    (proto != IPPROTO_UDP && proto != IPPROTO_TCP)) {
+		return -EINVAL;
+	}
+
+	if (!atomic_cas(&zperf_streams_busy, 0, 1)) {
+		return -EBUSY;
+	}
+
+	for (size_t i = 0; i < streams; i++) {
+		struct zperf_stream *stream = &zperf_streams[i];
+
+		memset(&results[i], 0, sizeof(results[i]));
+
+		stream->param = param;
+		stream->result = &results[i];
+		stream->index = i;
+		stream->proto = proto;
+		stream->ret = 0;
+
+		k_thread_create(&stream->thread, zperf_stream_stacks[i],
+				K_THREAD_STACK_SIZEOF(zperf_stream_stacks[i]),
+				zperf_stream_thread, stream, NULL, NULL,
+				k_thread_priority_get(k_current_get()), 0,
+				K_FOREVER);
+		k_thread_name_set(&stream->thread, "zperf_stream");
+#if defined(CONFIG_SCHED_CPU_MASK)
+		(void)k_thread_cpu_pin(&stream->thread, i % arch_num_cpus());
+#endif
+	}
+
+	/* Start the streams together once they were all set up */
+	for (size_t i = 0; i < streams; i++) {
+		k_thread_start(&zperf_streams[i].thread);
+	}
+
+	for (size_t i = 0; i < streams; i++) {
+		(void)k_thread_join(&zperf_streams[i].thread, K_FOREVER);
+
+		if (zperf_streams[i].ret < 0 && ret == 0) {
+			ret = zperf_streams[i].ret;
+		}
+	}
+
+	atomic_clear(&zperf_streams_busy);
+
+	return ret;
+}
+#else
+int zperf_upload_streams(const struct zperf_upload_params *param, int proto,
+			 size_t streams, struct zperf_results *results)
+{
+	if (param == NULL || results == NULL || streams != 1) {
+		return -EINVAL;
+	}
+
+	memset(results, 0, sizeof(*results));
+
+	if (proto == IPPROTO_UDP) {
+		return zperf_udp_upload(param, results);
+	} else if (proto == IPPROTO_TCP) {
+		return zperf_tcp_upload(param, results);
+	}
+
+	return -EINVAL;
+}
+#endif /* CONFIG_NET_ZPERF_MAX_STREAMS > 1 */
+
 static int zperf_init(void)
 {
 
@@ -103,6 +103,9 @@ int zperf_prepare_upload_sock(const struct sockaddr *peer_addr, int tos,
 
 uint32_t zperf_packet_duration(uint32_t packet_size, uint32_t rate_in_kbps);
 
+int zperf_udp_upload_stream(const struct zperf_upload_params *param,
+			    size_t stream, struct zperf_results *result);
+
 void zperf_async_work_submit(struct k_work *work);
 void zperf_udp_uploader_init(void);
 void zperf_tcp_uploader_init(void);
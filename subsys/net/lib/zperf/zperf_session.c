@@ -5,6 +5,8 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <string.h>
+
 #include <zephyr/logging/log.h>
 LOG_MODULE_DECLARE(net_zperf, CONFIG_NET_ZPERF_LOG_LEVEL);
 
@@ -100,6 +102,40 @@ void zperf_reset_session_stats(struct session *session)
 	session->error = 0U;
 	session->jitter = 0;
 	session->last_transit_time = 0;
+	session->latency_min = UINT32_MAX;
+	session->latency_max = 0U;
+	session->latency_sum = 0U;
+	memset(session->latency_hist, 0, sizeof(session->latency_hist));
+}
+
+void zperf_session_add_latency(struct session *session, int64_t latency_us)
+{
+	uint32_t latency = CLAMP(latency_us, 0, UINT32_MAX);
+	int bucket = 0;
+
+	if (latency >= 2U) {
+		bucket = MIN(31 - __builtin_clz(latency),
+			     ZPERF_LATENCY_HIST_BUCKETS - 1);
+	}
+
+	session->latency_hist[bucket]++;
+	session->latency_sum += latency;
+	session->latency_min = MIN(session->latency_min, latency);
+	session->latency_max = MAX(session->latency_max, latency);
+}
+
+void zperf_session_get_latency(const struct session *session,
+			       struct zperf_results *results)
+{
+	if (session->counter == 0U) {
+		return;
+	}
+
+	results->latency_min_in_us = session->latency_min;
+	results->latency_max_in_us = session->latency_max;
+	results->latency_avg_in_us = session->latency_sum / session->counter;
+	memcpy(results->latency_hist, session->latency_hist,
+	       sizeof(results->latency_hist));
 }
 
 void zperf_session_init(void)
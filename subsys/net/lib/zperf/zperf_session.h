@@ -50,6 +50,12 @@ struct session {
 	int32_t jitter;
 	int32_t last_transit_time;
 
+	/* One-way latency */
+	uint32_t latency_min;
+	uint32_t latency_max;
+	uint64_t latency_sum;
+	uint32_t latency_hist[ZPERF_LATENCY_HIST_BUCKETS];
+
 	/* Stats packet*/
 	struct zperf_server_hdr stat;
 };
@@ -58,5 +64,8 @@ struct session *get_session(const struct sockaddr *addr,
 			    enum session_proto proto);
 void zperf_session_init(void);
 void zperf_reset_session_stats(struct session *session);
+void zperf_session_add_latency(struct session *session, int64_t latency_us);
+void zperf_session_get_latency(const struct session *session,
+			       struct zperf_results *results);
 
 #endif /* __ZPERF_SESSION_H */
@@ -256,6 +256,35 @@ static int cmd_setip(const struct shell *sh, size_t argc, char *argv[])
 	return 0;
 }
 
+static bool udp_download_csv;
+
+static void udp_download_print_csv(const struct shell *sh,
+				   struct zperf_results *result,
+				   uint32_t rate_in_kbps)
+{
+	shell_fprintf(sh, SHELL_NORMAL,
+		      "time_us,rcvd,lost,outorder,bytes,rate_kbps,jitter_us,"
+		      "latency_min_us,latency_avg_us,latency_max_us");
+
+	for (int i = 0; i < ZPERF_LATENCY_HIST_BUCKETS; i++) {
+		shell_fprintf(sh, SHELL_NORMAL, ",hist_%uus",
+			      i == 0 ? 0U : BIT(i));
+	}
+
+	shell_fprintf(sh, SHELL_NORMAL, "\n%u,%u,%u,%u,%llu,%u,%u,%u,%u,%u",
+		      result->time_in_us, result->nb_packets_rcvd,
+		      result->nb_packets_lost, result->nb_packets_outorder,
+		      (unsigned long long)result->total_len, rate_in_kbps,
+		      result->jitter_in_us, result->latency_min_in_us,
+		      result->latency_avg_in_us, result->latency_max_in_us);
+
+	for (int i = 0; i < ZPERF_LATENCY_HIST_BUCKETS; i++) {
+		shell_fprintf(sh, SHELL_NORMAL, ",%u", result->latency_hist[i]);
+	}
+
+	shell_fprintf(sh, SHELL_NORMAL, "\n");
+}
+
 static void udp_session_cb(enum zperf_status status,
 			   struct zperf_results *result,
 			   void *user_data)
@@ -282,6 +311,11 @@ static void udp_session_cb(enum zperf_status status,
 
 		shell_fprintf(sh, SHELL_NORMAL, "End of session!\n");
 
+		if (udp_download_csv) {
+			udp_download_print_csv(sh, result, rate_in_kbps);
+			break;
+		}
+
 		shell_fprintf(sh, SHELL_NORMAL, " duration:\t\t");
 		print_number(sh, result->time_in_us, TIME_US, TIME_US_UNIT);
 		shell_fprintf(sh, SHELL_NORMAL, "\n");
@@ -301,6 +335,13 @@ static void udp_session_cb(enum zperf_status status,
 		print_number(sh, rate_in_kbps, KBPS, KBPS_UNIT);
 		shell_fprintf(sh, SHELL_NORMAL, "\n");
 
+		/* Only meaningful with synchronized clocks on both ends */
+		shell_fprintf(sh, SHELL_NORMAL,
+			      " latency min/avg/max:\t%u/%u/%u us\n",
+			      result->latency_min_in_us,
+			      result->latency_avg_in_us,
+			      result->latency_max_in_us);
+
 		break;
 	}
 
@@ -333,6 +374,12 @@ static int cmd_udp_download(const struct shell *sh, size_t argc,
 		struct zperf_download_params param = { 0 };
 		int ret;
 
+		udp_download_csv = argc >= 2 && strcmp(argv[1], "-c") == 0;
+		if (udp_download_csv) {
+			argc--;
+			argv++;
+		}
+
 		if (argc >= 2) {
 			param.port = strtoul(argv[1], NULL, 10);
 		} else {
@@ -501,9 +548,123 @@ static void tcp_upload_cb(enum zperf_status status,
 	}
 }
 
+static uint32_t upload_rate_kbps(const struct zperf_results *results,
+				 bool is_udp)
+{
+	if (is_udp) {
+		if (results->time_in_us == 0U) {
+			return 0U;
+		}
+
+		return (uint32_t)(((uint64_t)results->total_len * 8ULL *
+				   (uint64_t)USEC_PER_SEC) /
+				  ((uint64_t)results->time_in_us * 1024ULL));
+	}
+
+	if (results->client_time_in_us == 0U) {
+		return 0U;
+	}
+
+	return (uint32_t)(((uint64_t)results->nb_packets_sent *
+			   (uint64_t)results->packet_size * 8ULL *
+			   (uint64_t)USEC_PER_SEC) /
+			  ((uint64_t)results->client_time_in_us * 1024ULL));
+}
+
+static void shell_upload_print_csv(const struct shell *sh, const char *stream,
+				   bool is_udp,
+				   const struct zperf_results *results)
+{
+	shell_fprintf(sh, SHELL_NORMAL,
+		      "%s,%s,%u,%u,%u,%u,%u,%u,%llu,%u,%u\n", stream,
+		      is_udp ? "udp" : "tcp",
+		      is_udp ? results->time_in_us : results->client_time_in_us,
+		      results->nb_packets_sent, results->nb_packets_rcvd,
+		      results->nb_packets_lost, results->nb_packets_outorder,
+		      results->nb_packets_errors,
+		      (unsigned long long)(is_udp ? results->total_len :
+					   (uint64_t)results->nb_packets_sent *
+					   results->packet_size),
+		      upload_rate_kbps(results, is_udp), results->jitter_in_us);
+}
+
+static int execute_upload_streams(const struct shell *sh,
+				  const struct zperf_upload_params *param,
+				  bool is_udp, size_t streams, bool csv)
+{
+	static struct zperf_results results[CONFIG_NET_ZPERF_MAX_STREAMS];
+	struct zperf_results total = { 0 };
+	char name[12];
+	int ret;
+
+	ret = zperf_upload_streams(param, is_udp ? IPPROTO_UDP : IPPROTO_TCP,
+				   streams, results);
+	if (ret < 0) {
+		shell_fprintf(sh, SHELL_ERROR, "%s upload failed (%d)\n",
+			      is_udp ? "UDP" : "TCP", ret);
+		return ret;
+	}
+
+	if (csv) {
+		shell_fprintf(sh, SHELL_NORMAL,
+			      "stream,proto,time_us,sent,rcvd,lost,outorder,"
+			      "errors,bytes,rate_kbps,jitter_us\n");
+	}
+
+	for (size_t i = 0; i < streams; i++) {
+		total.nb_packets_sent += results[i].nb_packets_sent;
+		total.nb_packets_rcvd += results[i].nb_packets_rcvd;
+		total.nb_packets_lost += results[i].nb_packets_lost;
+		total.nb_packets_outorder += results[i].nb_packets_outorder;
+		total.nb_packets_errors += results[i].nb_packets_errors;
+		total.total_len += results[i].total_len;
+		total.time_in_us = MAX(total.time_in_us, results[i].time_in_us);
+		total.client_time_in_us = MAX(total.client_time_in_us,
+					      results[i].client_time_in_us);
+		total.jitter_in_us = MAX(total.jitter_in_us,
+					 results[i].jitter_in_us);
+		total.packet_size = results[i].packet_size;
+
+		if (csv) {
+			snprintk(name, sizeof(name), "%zu", i);
+			shell_upload_print_csv(sh, name, is_udp, &results[i]);
+			continue;
+		}
+
+		if (streams > 1) {
+			shell_fprintf(sh, SHELL_NORMAL, "-\nStream %zu:\n", i);
+		}
+
+		if (is_udp) {
+			shell_udp_upload_print_stats(sh, &results[i]);
+		} else {
+			shell_tcp_upload_print_stats(sh, &results[i]);
+		}
+	}
+
+	if (streams == 1) {
+		return 0;
+	}
+
+	if (csv) {
+		shell_upload_print_csv(sh, "total", is_udp, &total);
+	} else {
+		shell_fprintf(sh, SHELL_NORMAL, "-\nTotal of %zu streams:\n",
+			      streams);
+
+		if (is_udp) {
+			shell_udp_upload_print_stats(sh, &total);
+		} else {
+			shell_tcp_upload_print_stats(sh, &total);
+		}
+	}
+
+	return 0;
+}
+
 static int execute_upload(const struct shell *sh,
 			  const struct zperf_upload_params *param,
-			  bool is_udp, bool async)
+			  bool is_udp, bool async, size_t streams, bool csv)
 {
 	struct zperf_results results = { 0 };
 	int ret;
@@ -531,6 +692,17 @@ static int execute_upload(const struct shell *sh,
 		k_sleep(K_SECONDS(1));
 	}
 
+	if (streams > 1 || csv) {
+		if ((is_udp && !IS_ENABLED(CONFIG_NET_UDP)) ||
+		    (!is_udp && !IS_ENABLED(CONFIG_NET_TCP))) {
+			shell_fprintf(sh, SHELL_INFO, "%s not supported\n",
+				      is_udp ? "UDP" : "TCP");
+			return 0;
+		}
+
+		return execute_upload_streams(sh, param, is_udp, streams, csv);
+	}
+
 	if (is_udp && IS_ENABLED(CONFIG_NET_UDP)) {
 		uint32_t packet_duration =
 			zperf_packet_duration(param->packet_size, param->rate_kbps);
@@ -638,6 +810,8 @@ static int shell_cmd_upload(const struct shell *sh, size_t argc,
 	struct sockaddr_in ipv4 = { .sin_family = AF_INET };
 	char *port_str;
 	bool async = false;
+	bool csv = false;
+	size_t streams = 1;
 	bool is_udp;
 	int start = 0;
 	size_t opt_cnt = 0;
@@ -670,6 +844,27 @@ static int shell_cmd_upload(const struct shell *sh, size_t argc,
 			opt_cnt += 1;
 			break;
 
+		case 'P': {
+			int cnt = parse_arg(&i, argc, argv);
+
+			if (cnt < 1 || cnt > CONFIG_NET_ZPERF_MAX_STREAMS) {
+				shell_fprintf(sh, SHELL_WARNING,
+					      "Streams must be 1..%d: %s\n",
+					      CONFIG_NET_ZPERF_MAX_STREAMS,
+					      argv[i]);
+				return -ENOEXEC;
+			}
+
+			streams = cnt;
+			opt_cnt += 2;
+			break;
+		}
+
+		case 'c':
+			csv = true;
+			opt_cnt += 1;
+			break;
+
 		case 'n':
 			if (is_udp) {
 				shell_fprintf(sh, SHELL_WARNING,
@@ -687,6 +882,12 @@ static int shell_cmd_upload(const struct shell *sh, size_t argc,
 		}
 	}
 
+	if (async && (streams > 1 || csv)) {
+		shell_fprintf(sh, SHELL_WARNING,
+			      "-P and -c cannot be used with -a\n");
+		return -ENOEXEC;
+	}
+
 	start += opt_cnt;
 	argc -= opt_cnt;
 
@@ -792,7 +993,7 @@ static int shell_cmd_upload(const struct shell *sh, size_t argc,
 		param.rate_kbps = 10U;
 	}
 
-	return execute_upload(sh, &param, is_udp, async);
+	return execute_upload(sh, &param, is_udp, async, streams, csv);
 }
 
 static int cmd_tcp_upload(const struct shell *sh, size_t argc, char *argv[])
@@ -812,6 +1013,8 @@ static int shell_cmd_upload2(const struct shell *sh, size_t argc,
 	sa_family_t family;
 	uint8_t is_udp;
 	bool async = false;
+	bool csv = false;
+	size_t streams = 1;
 	int start = 0;
 	size_t opt_cnt = 0;
 
@@ -843,6 +1046,27 @@ static int shell_cmd_upload2(const struct shell *sh, size_t argc,
 			opt_cnt += 1;
 			break;
 
+		case 'P': {
+			int cnt = parse_arg(&i, argc, argv);
+
+			if (cnt < 1 || cnt > CONFIG_NET_ZPERF_MAX_STREAMS) {
+				shell_fprintf(sh, SHELL_WARNING,
+					      "Streams must be 1..%d: %s\n",
+					      CONFIG_NET_ZPERF_MAX_STREAMS,
+					      argv[i]);
+				return -ENOEXEC;
+			}
+
+			streams = cnt;
+			opt_cnt += 2;
+			break;
+		}
+
+		case 'c':
+			csv = true;
+			opt_cnt += 1;
+			break;
+
 		case 'n':
 			if (is_udp) {
 				shell_fprintf(sh, SHELL_WARNING,
@@ -860,6 +1084,12 @@ static int shell_cmd_upload2(const struct shell *sh, size_t argc,
 		}
 	}
 
+	if (async && (streams > 1 || csv)) {
+		shell_fprintf(sh, SHELL_WARNING,
+			      "-P and -c cannot be used with -a\n");
+		return -ENOEXEC;
+	}
+
 	start += opt_cnt;
 	argc -= opt_cnt;
 
@@ -930,7 +1160,7 @@ static int shell_cmd_upload2(const struct shell *sh, size_t argc,
 		param.rate_kbps = 10U;
 	}
 
-	return execute_upload(sh, &param, is_udp, async);
+	return execute_upload(sh, &param, is_udp, async, streams, csv);
 }
 
 static int cmd_tcp_upload2(const struct shell *sh, size_t argc,
@@ -1136,7 +1366,7 @@ SHELL_STATIC_SUBCMD_SET_CREATE(zperf_cmd_tcp_download,
 SHELL_STATIC_SUBCMD_SET_CREATE(zperf_cmd_tcp,
 	SHELL_CMD(upload, NULL,
 		  "[<options>] <dest ip> <dest port> <duration> <packet size>[K]\n"
-		  "<options>     command options (optional): [-S tos -a]\n"
+		  "<options>     command options (optional): [-S tos -a -P n -c]\n"
 		  "<dest ip>     IP destination\n"
 		  "<dest port>   port destination\n"
 		  "<duration>    of the test in seconds\n"
@@ -1145,13 +1375,15 @@ SHELL_STATIC_SUBCMD_SET_CREATE(zperf_cmd_tcp,
 		  "Available options:\n"
 		  "-S tos: Specify IPv4/6 type of service\n"
 		  "-a: Asynchronous call (shell will not block for the upload)\n"
+		  "-P n: Number of parallel streams, same rate for each\n"
+		  "-c: Print the results in CSV format\n"
 		  "-n: Disable Nagle's algorithm\n"
 		  "Example: tcp upload 192.0.2.2 1111 1 1K\n"
 		  "Example: tcp upload 2001:db8::2\n",
 		  cmd_tcp_upload),
 	SHELL_CMD(upload2, NULL,
 		  "[<options>] v6|v4 <duration> <packet size>[K] <baud rate>[K|M]\n"
-		  "<options>     command options (optional): [-S tos -a]\n"
+		  "<options>     command options (optional): [-S tos -a -P n -c]\n"
 		  "<v6|v4>:      Use either IPv6 or IPv4\n"
 		  "<duration>    Duration of the test in seconds\n"
 		  "<packet size> Size of the packet in byte or kilobyte "
@@ -1159,6 +1391,8 @@ SHELL_STATIC_SUBCMD_SET_CREATE(zperf_cmd_tcp,
 		  "Available options:\n"
 		  "-S tos: Specify IPv4/6 type of service\n"
 		  "-a: Asynchronous call (shell will not block for the upload)\n"
+		  "-P n: Number of parallel streams, same rate for each\n"
+		  "-c: Print the results in CSV format\n"
 		  "Example: tcp upload2 v6 1 1K\n"
 		  "Example: tcp upload2 v4\n"
 		  "-n: Disable Nagle's algorithm\n"
@@ -1188,7 +1422,7 @@ SHELL_STATIC_SUBCMD_SET_CREATE(zperf_cmd_udp,
 	SHELL_CMD(upload, NULL,
 		  "[<options>] <dest ip> [<dest port> <duration> <packet size>[K] "
 							"<baud rate>[K|M]]\n"
-		  "<options>     command options (optional): [-S tos -a]\n"
+		  "<options>     command options (optional): [-S tos -a -P n -c]\n"
 		  "<dest ip>     IP destination\n"
 		  "<dest port>   port destination\n"
 		  "<duration>    of the test in seconds\n"
@@ -1198,12 +1432,14 @@ SHELL_STATIC_SUBCMD_SET_CREATE(zperf_cmd_udp,
 		  "Available options:\n"
 		  "-S tos: Specify IPv4/6 type of service\n"
 		  "-a: Asynchronous call (shell will not block for the upload)\n"
+		  "-P n: Number of parallel streams, same rate for each\n"
+		  "-c: Print the results in CSV format\n"
 		  "Example: udp upload 192.0.2.2 1111 1 1K 1M\n"
 		  "Example: udp upload 2001:db8::2\n",
 		  cmd_udp_upload),
 	SHELL_CMD(upload2, NULL,
 		  "[<options>] v6|v4 [<duration> <packet size>[K] <baud rate>[K|M]]\n"
-		  "<options>     command options (optional): [-S tos -a]\n"
+		  "<options>     command options (optional): [-S tos -a -P n -c]\n"
 		  "<v6|v4>:      Use either IPv6 or IPv4\n"
 		  "<duration>    Duration of the test in seconds\n"
 		  "<packet size> Size of the packet in byte or kilobyte "
@@ -1212,6 +1448,8 @@ SHELL_STATIC_SUBCMD_SET_CREATE(zperf_cmd_udp,
 		  "Available options:\n"
 		  "-S tos: Specify IPv4/6 type of service\n"
 		  "-a: Asynchronous call (shell will not block for the upload)\n"
+		  "-P n: Number of parallel streams, same rate for each\n"
+		  "-c: Print the results in CSV format\n"
 		  "Example: udp upload2 v4 1 1K 1M\n"
 		  "Example: udp upload2 v6\n"
 #if defined(CONFIG_NET_IPV6) && defined(MY_IP6ADDR_SET)
@@ -1225,7 +1463,9 @@ SHELL_STATIC_SUBCMD_SET_CREATE(zperf_cmd_udp,
 		  ,
 		  cmd_udp_upload2),
 	SHELL_CMD(download, &zperf_cmd_udp_download,
-		  "[<port>]\n"
+		  "[-c] [<port>]\n"
+		  "-c: Print the results in CSV format, with the latency "
+							"histogram\n"
 		  "Example: udp download 5001\n",
 		  cmd_udp_download),
 	SHELL_SUBCMD_SET_END
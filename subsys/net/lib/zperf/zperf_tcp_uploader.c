@@ -40,14 +40,6 @@ static int tcp_upload(int sock,
 	/* Start the loop */
 	start_time = k_uptime_ticks();
 
-	(void)memset(sample_packet, 'z', sizeof(sample_packet));
-
-	/* Set the "flags" field in start of the packet to be 0.
-	 * As the protocol is not properly described anywhere, it is
-	 * not certain if this is a proper thing to do.
-	 */
-	(void)memset(sample_packet, 0, sizeof(uint32_t));
-
 	do {
 		/* Send the packet */
 		ret = zsock_send(sock, sample_packet, packet_size, 0);
@@ -179,5 +171,16 @@ int zperf_tcp_upload_async(const struct zperf_upload_params *param,
 
 void zperf_tcp_uploader_init(void)
 {
+	/* The packet is only read while uploading, so it is shared by all the
+	 * streams.
+	 */
+	(void)memset(sample_packet, 'z', sizeof(sample_packet));
+
+	/* Set the "flags" field in start of the packet to be 0.
+	 * As the protocol is not properly described anywhere, it is
+	 * not certain if this is a proper thing to do.
+	 */
+	(void)memset(sample_packet, 0, sizeof(uint32_t));
+
 	k_work_init(&tcp_async_upload_ctx.work, tcp_upload_async_work);
 }
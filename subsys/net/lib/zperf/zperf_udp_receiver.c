@@ -182,6 +182,7 @@ static void udp_received(int sock, const struct sockaddr *addr, uint8_t *data,
 			results.time_in_us = duration;
 			results.jitter_in_us = session->jitter;
 			results.packet_size = session->length / session->counter;
+			zperf_session_get_latency(session, &results);
 
 			if (udp_session_cb != NULL) {
 				udp_session_cb(ZPERF_SESSION_FINISHED, &results,
@@ -211,6 +212,11 @@ static void udp_received(int sock, const struct sockaddr *addr, uint8_t *data,
 
 			session->last_transit_time = transit_time;
 
+			zperf_session_add_latency(session,
+				(int64_t)k_ticks_to_us_floor64(time) -
+				((int64_t)ntohl(hdr->tv_sec) * USEC_PER_SEC +
+				 ntohl(hdr->tv_usec)));
+
 			/* Check header id */
 			if (id != session->next_id) {
 				if (id < session->next_id) {
@@ -14,9 +14,12 @@ LOG_MODULE_DECLARE(net_zperf, CONFIG_NET_ZPERF_LOG_LEVEL);
 
 #include "zperf_internal.h"
 
-static uint8_t sample_packet[sizeof(struct zperf_udp_datagram) +
-			     sizeof(struct zperf_client_hdr_v1) +
-			     PACKET_SIZE_MAX];
+#define SAMPLE_PACKET_SIZE (sizeof(struct zperf_udp_datagram) + \
+			    sizeof(struct zperf_client_hdr_v1) + \
+			    PACKET_SIZE_MAX)
+
+/* One packet buffer for each of the streams that can run in parallel */
+static uint8_t sample_packets[CONFIG_NET_ZPERF_MAX_STREAMS][SAMPLE_PACKET_SIZE];
 
 static struct zperf_async_upload_context udp_async_upload_ctx;
 
@@ -45,7 +48,7 @@ static inline void zperf_upload_decode_stat(const uint8_t *data,
 		ntohl(UNALIGNED_GET(&stat->jitter1)) * USEC_PER_SEC;
 }
 
-static inline int zperf_upload_fin(int sock,
+static inline int zperf_upload_fin(int sock, uint8_t *sample_packet,
 				   uint32_t nb_packets,
 				   uint64_t end_time,
 				   uint32_t packet_size,
@@ -83,7 +86,7 @@ static inline int zperf_upload_fin(int sock,
 		hdr->flags = 0;
 		hdr->num_of_threads = htonl(1);
 		hdr->port = 0;
-		hdr->buffer_len = sizeof(sample_packet) -
+		hdr->buffer_len = SAMPLE_PACKET_SIZE -
 			sizeof(*datagram) - sizeof(*hdr);
 		hdr->bandwidth = 0;
 		hdr->num_of_bytes = htonl(packet_size);
@@ -131,7 +134,7 @@ static inline int zperf_upload_fin(int sock,
 	return 0;
 }
 
-static int udp_upload(int sock, int port,
+static int udp_upload(int sock, uint8_t *sample_packet, int port,
 		      unsigned int duration_in_ms,
 		      unsigned int packet_size,
 		      unsigned int rate_in_kbps,
@@ -165,7 +168,7 @@ static int udp_upload(int sock, int port,
 	print_period = k_ms_to_ticks_ceil32(MSEC_PER_SEC);
 	print_time = start_time + print_period;
 
-	(void)memset(sample_packet, 'z', sizeof(sample_packet));
+	(void)memset(sample_packet, 'z', SAMPLE_PACKET_SIZE);
 
 	do {
 		struct zperf_udp_datagram *datagram;
@@ -212,7 +215,7 @@ static int udp_upload(int sock, int port,
 		hdr->flags = 0;
 		hdr->num_of_threads = htonl(1);
 		hdr->port = htonl(port);
-		hdr->buffer_len = sizeof(sample_packet) -
+		hdr->buffer_len = SAMPLE_PACKET_SIZE -
 			sizeof(*datagram) - sizeof(*hdr);
 		hdr->bandwidth = htonl(rate_in_kbps);
 		hdr->num_of_bytes = htonl(packet_size);
@@ -247,8 +250,8 @@ static int udp_upload(int sock, int port,
 
 	end_time = k_uptime_ticks();
 
-	ret = zperf_upload_fin(sock, nb_packets, end_time, packet_size,
-			       results);
+	ret = zperf_upload_fin(sock, sample_packet, nb_packets, end_time,
+			       packet_size, results);
 	if (ret < 0) {
 		return ret;
 	}
@@ -262,14 +265,15 @@ static int udp_upload(int sock, int port,
 	return 0;
 }
 
-int zperf_udp_upload(const struct zperf_upload_params *param,
-		     struct zperf_results *result)
+int zperf_udp_upload_stream(const struct zperf_upload_params *param,
+			    size_t stream, struct zperf_results *result)
 {
 	int port = 0;
 	int sock;
 	int ret;
 
-	if (param == NULL || result == NULL) {
+	if (param == NULL || result == NULL ||
+	    stream >= ARRAY_SIZE(sample_packets)) {
 		return -EINVAL;
 	}
 
@@ -289,14 +293,20 @@ int zperf_udp_upload(const struct zperf_upload_params *param,
 		return sock;
 	}
 
-	ret = udp_upload(sock, port, param->duration_ms, param->packet_size,
-			 param->rate_kbps, result);
+	ret = udp_upload(sock, sample_packets[stream], port, param->duration_ms,
+			 param->packet_size, param->rate_kbps, result);
 
 	zsock_close(sock);
 
 	return ret;
 }
 
+int zperf_udp_upload(const struct zperf_upload_params *param,
+		     struct zperf_results *result)
+{
+	return zperf_udp_upload_stream(param, 0, result);
+}
+
 static void udp_upload_async_work(struct k_work *work)
 {
 	struct zperf_async_upload_context *upload_ctx =
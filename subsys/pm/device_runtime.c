@@ -24,6 +24,72 @@ LOG_MODULE_DECLARE(pm_device, CONFIG_PM_DEVICE_LOG_LEVEL);
 
 #define EVENT_MASK		(EVENT_STATE_ACTIVE | EVENT_STATE_SUSPENDED)
 
+/**
+ * @brief Run a PM action on a device, accounting for it in its statistics.
+ *
+ * @param pm Device PM info.
+ * @param action Action to run.
+ *
+ * @return Result of the action callback.
+ */
+static int runtime_action(struct pm_device *pm, enum pm_device_action action)
+{
+	int ret;
+#ifdef CONFIG_PM_DEVICE_RUNTIME_STATS
+	uint32_t start = k_cycle_get_32();
+	uint32_t us;
+#endif
+
+	ret = pm->action_cb(pm->dev, action);
+
+#ifdef CONFIG_PM_DEVICE_RUNTIME_STATS
+	if (ret < 0) {
+		return ret;
+	}
+
+	us = k_cyc_to_us_ceil32(k_cycle_get_32() - start);
+
+	if (action == PM_DEVICE_ACTION_SUSPEND) {
+		pm->stats.suspend_count++;
+		pm->stats.suspend_last_us = us;
+		pm->stats.suspend_max_us = MAX(pm->stats.suspend_max_us, us);
+	} else if (action == PM_DEVICE_ACTION_RESUME) {
+		pm->stats.resume_count++;
+		pm->stats.resume_last_us = us;
+		pm->stats.resume_max_us = MAX(pm->stats.resume_max_us, us);
+	}
+#endif
+
+	return ret;
+}
+
+/**
+ * @brief Cancel a suspend that has been queued but not started yet.
+ *
+ * Must be called with the device lock held.
+ *
+ * @param pm Device PM info.
+ *
+ * @retval true If the suspend was cancelled, device is left active.
+ * @retval false If there was no suspend to cancel or it already started.
+ */
+static bool runtime_suspend_cancel(struct pm_device *pm)
+{
+	if ((pm->state != PM_DEVICE_STATE_SUSPENDING) ||
+	    (k_work_cancel_delayable(&pm->work) != 0)) {
+		return false;
+	}
+
+	pm->state = PM_DEVICE_STATE_ACTIVE;
+	k_event_set(&pm->event, BIT(pm->state));
+
+#ifdef CONFIG_PM_DEVICE_RUNTIME_STATS
+	pm->stats.cancel_count++;
+#endif
+
+	return true;
+}
+
 /**
  * @brief Suspend a device
  *
@@ -77,10 +143,10 @@ static int runtime_suspend(const struct device *dev, bool async)
 	if (async && !k_is_pre_kernel()) {
 		/* queue suspend */
 		pm->state = PM_DEVICE_STATE_SUSPENDING;
-		(void)k_work_schedule(&pm->work, K_NO_WAIT);
+		(void)k_work_schedule(&pm->work, K_MSEC(pm->suspend_delay_ms));
 	} else {
 		/* suspend now */
-		ret = pm->action_cb(pm->dev, PM_DEVICE_ACTION_SUSPEND);
+		ret = runtime_action(pm, PM_DEVICE_ACTION_SUSPEND);
 		if (ret < 0) {
 			pm->usage++;
 			goto unlock;
@@ -103,7 +169,7 @@ static void runtime_suspend_work(struct k_work *work)
 	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
 	struct pm_device *pm = CONTAINER_OF(dwork, struct pm_device, work);
 
-	ret = pm->action_cb(pm->dev, PM_DEVICE_ACTION_SUSPEND);
+	ret = runtime_action(pm, PM_DEVICE_ACTION_SUSPEND);
 
 	(void)k_sem_take(&pm->lock, K_FOREVER);
 	if (ret < 0) {
@@ -117,10 +183,18 @@ static void runtime_suspend_work(struct k_work *work)
 
 	/*
 	 * On async put, we have to suspend the domain when the device
-	 * finishes its operation
+	 * finishes its operation. A domain with a suspend delay is put
+	 * asynchronously as well, so that children going idle one after the
+	 * other only power the domain down once they are all done.
 	 */
 	if (PM_DOMAIN(pm) != NULL) {
-		(void)pm_device_runtime_put(PM_DOMAIN(pm));
+		const struct device *domain = PM_DOMAIN(pm);
+
+		if ((domain->pm != NULL) && (domain->pm->suspend_delay_ms > 0U)) {
+			(void)pm_device_runtime_put_async(domain);
+		} else {
+			(void)pm_device_runtime_put(domain);
+		}
 	}
 
 	__ASSERT(ret == 0, "Could not suspend device (%d)", ret);
@@ -151,6 +225,15 @@ int pm_device_runtime_get(const struct device *dev)
 		}
 	}
 
+	/*
+	 * If the device was about to be suspended, keep it as is: it (and its
+	 * domain) never stopped being active.
+	 */
+	if (runtime_suspend_cancel(pm)) {
+		pm->usage++;
+		goto unlock;
+	}
+
 	if (k_is_in_isr() && (pm->state == PM_DEVICE_STATE_SUSPENDING)) {
 		ret = -EWOULDBLOCK;
 		goto unlock;
@@ -192,7 +275,7 @@ int pm_device_runtime_get(const struct device *dev)
 		goto unlock;
 	}
 
-	ret = pm->action_cb(pm->dev, PM_DEVICE_ACTION_RESUME);
+	ret = runtime_action(pm, PM_DEVICE_ACTION_RESUME);
 	if (ret < 0) {
 		pm->usage--;
 		goto unlock;
@@ -250,6 +333,95 @@ int pm_device_runtime_put_async(const struct device *dev)
 	return ret;
 }
 
+static void runtime_get_async_work(struct k_work *work)
+{
+	struct pm_device_runtime_req *req =
+		CONTAINER_OF(work, struct pm_device_runtime_req, work);
+
+	req->cb(req->dev, pm_device_runtime_get(req->dev), req->user_data);
+}
+
+void pm_device_runtime_req_init(struct pm_device_runtime_req *req,
+				pm_device_runtime_cb_t cb, void *user_data)
+{
+	k_work_init(&req->work, runtime_get_async_work);
+	req->cb = cb;
+	req->user_data = user_data;
+}
+
+int pm_device_runtime_get_async(const struct device *dev,
+				struct pm_device_runtime_req *req)
+{
+	struct pm_device *pm = dev->pm;
+
+	if (k_work_is_pending(&req->work)) {
+		return -EBUSY;
+	}
+
+	req->dev = dev;
+
+	/* nothing that could be done asynchronously, complete right away */
+	if ((pm == NULL) || k_is_pre_kernel() ||
+	    !atomic_test_bit(&pm->flags, PM_DEVICE_FLAG_RUNTIME_ENABLED)) {
+		req->cb(dev, pm_device_runtime_get(dev), req->user_data);
+		return 0;
+	}
+
+	/* device already in use, just account for one more user */
+	if (k_sem_take(&pm->lock, K_NO_WAIT) == 0) {
+		if ((pm->state == PM_DEVICE_STATE_ACTIVE) && (pm->usage > 0U)) {
+			pm->usage++;
+			k_sem_give(&pm->lock);
+			req->cb(dev, 0, req->user_data);
+			return 0;
+		}
+
+		k_sem_give(&pm->lock);
+	}
+
+	(void)k_work_submit(&req->work);
+
+	return 0;
+}
+
+int pm_device_runtime_suspend_delay_set(const struct device *dev,
+					uint32_t delay_ms)
+{
+	struct pm_device *pm = dev->pm;
+
+	if (pm == NULL) {
+		return -ENOTSUP;
+	}
+
+	pm->suspend_delay_ms = delay_ms;
+
+	return 0;
+}
+
+#ifdef CONFIG_PM_DEVICE_RUNTIME_STATS
+int pm_device_runtime_stats_get(const struct device *dev,
+				struct pm_device_runtime_stats *stats)
+{
+	struct pm_device *pm = dev->pm;
+
+	if (pm == NULL) {
+		return -ENOTSUP;
+	}
+
+	if (!k_is_pre_kernel()) {
+		(void)k_sem_take(&pm->lock, K_FOREVER);
+	}
+
+	*stats = pm->stats;
+
+	if (!k_is_pre_kernel()) {
+		k_sem_give(&pm->lock);
+	}
+
+	return 0;
+}
+#endif /* CONFIG_PM_DEVICE_RUNTIME_STATS */
+
 __boot_func
 int pm_device_runtime_auto_enable(const struct device *dev)
 {
@@ -293,7 +465,7 @@ int pm_device_runtime_enable(const struct device *dev)
 	}
 
 	if (pm->state == PM_DEVICE_STATE_ACTIVE) {
-		ret = pm->action_cb(pm->dev, PM_DEVICE_ACTION_SUSPEND);
+		ret = runtime_action(pm, PM_DEVICE_ACTION_SUSPEND);
 		if (ret < 0) {
 			goto unlock;
 		}
@@ -335,6 +507,11 @@ int pm_device_runtime_disable(const struct device *dev)
 
 	/* wait until possible async suspend is completed */
 	if (!k_is_pre_kernel()) {
+		/* a cancelled suspend still has to release the domain */
+		if (runtime_suspend_cancel(pm) && (PM_DOMAIN(pm) != NULL)) {
+			(void)pm_device_runtime_put(PM_DOMAIN(pm));
+		}
+
 		while (pm->state == PM_DEVICE_STATE_SUSPENDING) {
 			k_sem_give(&pm->lock);
 
@@ -346,7 +523,7 @@ int pm_device_runtime_disable(const struct device *dev)
 
 	/* wake up the device if suspended */
 	if (pm->state == PM_DEVICE_STATE_SUSPENDED) {
-		ret = pm->action_cb(pm->dev, PM_DEVICE_ACTION_RESUME);
+		ret = runtime_action(pm, PM_DEVICE_ACTION_RESUME);
 		if (ret < 0) {
 			goto unlock;
 		}
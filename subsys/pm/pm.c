@@ -18,6 +18,7 @@
 #include <zephyr/pm/policy.h>
 #include <zephyr/tracing/tracing.h>
 
+#include "pm_policy_adaptive.h"
 #include "pm_stats.h"
 
 #include <zephyr/logging/log.h>
@@ -174,6 +175,7 @@ bool pm_system_suspend(int32_t ticks)
 {
 	uint8_t id = CURRENT_CPU;
 	k_spinlock_key_t key;
+	uint32_t idle_start = 0U;
 
 	SYS_PORT_TRACING_FUNC_ENTER(pm, system_suspend, ticks);
 
@@ -237,8 +239,15 @@ bool pm_system_suspend(int32_t ticks)
 	/* Enter power state */
 	pm_state_notify(true);
 	atomic_set_bit(z_post_ops_required, id);
+	if (IS_ENABLED(CONFIG_PM_POLICY_ADAPTIVE)) {
+		idle_start = k_cycle_get_32();
+	}
 	pm_state_set(z_cpus_pm_state[id].state, z_cpus_pm_state[id].substate_id);
 	pm_stats_stop();
+	if (IS_ENABLED(CONFIG_PM_POLICY_ADAPTIVE)) {
+		pm_policy_adaptive_update(id, &z_cpus_pm_state[id],
+					  k_cycle_get_32() - idle_start);
+	}
 
 	/* Wake up sequence starts here */
 #if defined(CONFIG_PM_DEVICE) && !defined(CONFIG_PM_DEVICE_RUNTIME_EXCLUSIVE)
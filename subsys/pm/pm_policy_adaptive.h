@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_SUBSYS_PM_PM_POLICY_ADAPTIVE_H_
+#define ZEPHYR_SUBSYS_PM_PM_POLICY_ADAPTIVE_H_
+
+#include <stdint.h>
+#include <zephyr/pm/state.h>
+
+#ifdef CONFIG_PM_POLICY_ADAPTIVE
+/**
+ * @brief Predict how long a CPU is going to stay idle.
+ *
+ * @param cpu CPU index.
+ * @param cyc Cycles until the next known wakeup (<0: none).
+ *
+ * @return Predicted idle duration in cycles (<0: unbounded).
+ */
+int64_t pm_policy_adaptive_predict(uint8_t cpu, int64_t cyc);
+
+/**
+ * @brief Feed back how long a CPU actually stayed idle.
+ *
+ * @param cpu CPU index.
+ * @param state State the CPU was in.
+ * @param idle_cyc Cycles spent in @p state.
+ */
+void pm_policy_adaptive_update(uint8_t cpu, const struct pm_state_info *state,
+			       uint32_t idle_cyc);
+
+/** @brief Forget the idle history of all CPUs. */
+void pm_policy_adaptive_reset(void);
+#else
+static inline void pm_policy_adaptive_update(uint8_t cpu,
+					     const struct pm_state_info *state,
+					     uint32_t idle_cyc) {}
+#endif /* CONFIG_PM_POLICY_ADAPTIVE */
+
+#endif /* ZEPHYR_SUBSYS_PM_PM_POLICY_ADAPTIVE_H_ */
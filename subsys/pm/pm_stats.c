@@ -29,6 +29,29 @@ static STATS_SECT_DECL(pm_stats) stats[CONFIG_MP_MAX_NUM_CPUS][PM_STATE_COUNT];
 #define PM_STAT_NAME_LEN sizeof("pm_cpu_XXX_state_X_stats")
 static char names[CONFIG_MP_MAX_NUM_CPUS][PM_STATE_COUNT][PM_STAT_NAME_LEN];
 static uint32_t time_start[CONFIG_MP_MAX_NUM_CPUS];
+
+#ifdef CONFIG_PM_POLICY_ADAPTIVE
+STATS_SECT_START(pm_policy_stats)
+STATS_SECT_ENTRY32(idle_count)
+STATS_SECT_ENTRY32(too_deep)
+STATS_SECT_ENTRY32(too_shallow)
+STATS_SECT_ENTRY32(last_predicted_us)
+STATS_SECT_ENTRY32(last_idle_us)
+STATS_SECT_END;
+
+STATS_NAME_START(pm_policy_stats)
+STATS_NAME(pm_policy_stats, idle_count)
+STATS_NAME(pm_policy_stats, too_deep)
+STATS_NAME(pm_policy_stats, too_shallow)
+STATS_NAME(pm_policy_stats, last_predicted_us)
+STATS_NAME(pm_policy_stats, last_idle_us)
+STATS_NAME_END(pm_policy_stats);
+
+static STATS_SECT_DECL(pm_policy_stats) policy_stats[CONFIG_MP_MAX_NUM_CPUS];
+
+#define PM_POLICY_STAT_NAME_LEN sizeof("pm_cpu_XXX_policy_stats")
+static char policy_names[CONFIG_MP_MAX_NUM_CPUS][PM_POLICY_STAT_NAME_LEN];
+#endif
 static uint32_t time_stop[CONFIG_MP_MAX_NUM_CPUS];
 
 static int pm_stats_init(void)
@@ -44,6 +67,14 @@ static int pm_stats_init(void)
 				   STATS_NAME_INIT_PARMS(pm_stats));
 			stats_register(names[i][j], &(stats[i][j].s_hdr));
 		}
+
+#ifdef CONFIG_PM_POLICY_ADAPTIVE
+		snprintk(policy_names[i], PM_POLICY_STAT_NAME_LEN,
+			 "pm_cpu_%03d_policy_stats", i);
+		stats_init(&(policy_stats[i].s_hdr), STATS_SIZE_32, 5U,
+			   STATS_NAME_INIT_PARMS(pm_policy_stats));
+		stats_register(policy_names[i], &(policy_stats[i].s_hdr));
+#endif
 	}
 
 	return 0;
@@ -70,3 +101,21 @@ void pm_stats_update(enum pm_state state)
 	STATS_INCN(stats[cpu][state], state_total_cycles, time_total);
 	STATS_SET(stats[cpu][state], state_last_cycles, time_total);
 }
+
+#ifdef CONFIG_PM_POLICY_ADAPTIVE
+void pm_stats_policy_update(uint8_t cpu, uint32_t predicted_us, uint32_t idle_us,
+			    bool too_deep, bool too_shallow)
+{
+	STATS_INC(policy_stats[cpu], idle_count);
+	STATS_SET(policy_stats[cpu], last_predicted_us, predicted_us);
+	STATS_SET(policy_stats[cpu], last_idle_us, idle_us);
+
+	if (too_deep) {
+		STATS_INC(policy_stats[cpu], too_deep);
+	}
+
+	if (too_shallow) {
+		STATS_INC(policy_stats[cpu], too_shallow);
+	}
+}
+#endif
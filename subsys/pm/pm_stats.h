@@ -8,6 +8,8 @@
 #ifndef ZEPHYR_SUBSYS_PM_PM_STATS_H_
 #define ZEPHYR_SUBSYS_PM_PM_STATS_H_
 
+#include <stdbool.h>
+#include <stdint.h>
 #include <zephyr/pm/state.h>
 
 #ifdef CONFIG_PM_STATS
@@ -20,4 +22,13 @@ static inline void pm_stats_stop(void) {}
 static inline void pm_stats_update(enum pm_state state) {}
 #endif /* CONFIG_PM_STATS */
 
+#if defined(CONFIG_PM_STATS) && defined(CONFIG_PM_POLICY_ADAPTIVE)
+void pm_stats_policy_update(uint8_t cpu, uint32_t predicted_us, uint32_t idle_us,
+			    bool too_deep, bool too_shallow);
+#else
+static inline void pm_stats_policy_update(uint8_t cpu, uint32_t predicted_us,
+					  uint32_t idle_us, bool too_deep,
+					  bool too_shallow) {}
+#endif
+
 #endif /* ZEPHYR_SUBSYS_PM_PM_STATS_H_ */
@@ -15,6 +15,8 @@
 #include <zephyr/sys/atomic.h>
 #include <zephyr/toolchain.h>
 
+#include "pm_policy_adaptive.h"
+
 #if DT_HAS_COMPAT_STATUS_OKAY(zephyr_power_state)
 
 #define DT_SUB_LOCK_INIT(node_id)				\
@@ -129,19 +131,21 @@ static void update_next_event(uint32_t cyc)
 	next_event_cyc = new_next_event_cyc;
 }
 
-#ifdef CONFIG_PM_POLICY_DEFAULT
-const struct pm_state_info *pm_policy_next_state(uint8_t cpu, int32_t ticks)
+#if defined(CONFIG_PM_POLICY_DEFAULT) || defined(CONFIG_PM_POLICY_ADAPTIVE)
+/**
+ * @brief Obtain the cycles until the next known wakeup.
+ *
+ * @return Cycles until the next kernel timeout or registered event, whichever
+ * comes first (<0: none).
+ */
+static int64_t next_wakeup_cyc(int32_t ticks)
 {
 	int64_t cyc = -1;
-	uint8_t num_cpu_states;
-	const struct pm_state_info *cpu_states;
 
 	if (ticks != K_TICKS_FOREVER) {
 		cyc = k_ticks_to_cyc_ceil32(ticks);
 	}
 
-	num_cpu_states = pm_state_cpu_get_all(cpu, &cpu_states);
-
 	if (next_event_cyc >= 0) {
 		uint32_t cyc_curr = k_cycle_get_32();
 		int64_t cyc_evt = next_event_cyc - cyc_curr;
@@ -163,27 +167,80 @@ const struct pm_state_info *pm_policy_next_state(uint8_t cpu, int32_t ticks)
 		}
 	}
 
-	for (int16_t i = (int16_t)num_cpu_states - 1; i >= 0; i--) {
-		const struct pm_state_info *state = &cpu_states[i];
-		uint32_t min_residency_cyc, exit_latency_cyc;
+	return cyc;
+}
 
-		/* check if there is a lock on state + substate */
-		if (pm_policy_state_lock_is_active(state->state, state->substate_id)) {
-			continue;
+/**
+ * @brief Check if a state can be entered for a given idle duration.
+ *
+ * @param state State to check.
+ * @param cyc Idle duration in cycles (<0: unbounded).
+ */
+static bool state_fits(const struct pm_state_info *state, int64_t cyc)
+{
+	uint32_t min_residency_cyc, exit_latency_cyc;
+
+	/* check if there is a lock on state + substate */
+	if (pm_policy_state_lock_is_active(state->state, state->substate_id)) {
+		return false;
+	}
+
+	min_residency_cyc = k_us_to_cyc_ceil32(state->min_residency_us);
+	exit_latency_cyc = k_us_to_cyc_ceil32(state->exit_latency_us);
+
+	/* skip state if it brings too much latency */
+	if ((max_latency_cyc >= 0) &&
+	    (exit_latency_cyc >= max_latency_cyc)) {
+		return false;
+	}
+
+	return (cyc < 0) || (cyc >= (min_residency_cyc + exit_latency_cyc));
+}
+#endif
+
+#ifdef CONFIG_PM_POLICY_DEFAULT
+const struct pm_state_info *pm_policy_next_state(uint8_t cpu, int32_t ticks)
+{
+	int64_t cyc = next_wakeup_cyc(ticks);
+	uint8_t num_cpu_states;
+	const struct pm_state_info *cpu_states;
+
+	num_cpu_states = pm_state_cpu_get_all(cpu, &cpu_states);
+
+	for (int16_t i = (int16_t)num_cpu_states - 1; i >= 0; i--) {
+		if (state_fits(&cpu_states[i], cyc)) {
+			return &cpu_states[i];
 		}
+	}
 
-		min_residency_cyc = k_us_to_cyc_ceil32(state->min_residency_us);
-		exit_latency_cyc = k_us_to_cyc_ceil32(state->exit_latency_us);
+	return NULL;
+}
+#endif
 
-		/* skip state if it brings too much latency */
-		if ((max_latency_cyc >= 0) &&
-		    (exit_latency_cyc >= max_latency_cyc)) {
-			continue;
+#ifdef CONFIG_PM_POLICY_ADAPTIVE
+const struct pm_state_info *pm_policy_next_state(uint8_t cpu, int32_t ticks)
+{
+	int64_t cyc = next_wakeup_cyc(ticks);
+	int64_t predicted_cyc = pm_policy_adaptive_predict(cpu, cyc);
+	uint8_t num_cpu_states;
+	const struct pm_state_info *cpu_states;
+
+	num_cpu_states = pm_state_cpu_get_all(cpu, &cpu_states);
+
+	for (int16_t i = (int16_t)num_cpu_states - 1; i >= 0; i--) {
+		if (state_fits(&cpu_states[i], predicted_cyc)) {
+			return &cpu_states[i];
 		}
+	}
 
-		if ((cyc < 0) ||
-		    (cyc >= (min_residency_cyc + exit_latency_cyc))) {
-			return state;
+	/*
+	 * Nothing pays off for the predicted duration: use the shallowest
+	 * state the next wakeup allows, so that idle durations keep being
+	 * measured and a wrong prediction can recover.
+	 */
+	for (uint8_t i = 0U; i < num_cpu_states; i++) {
+		if (state_fits(&cpu_states[i], cyc)) {
+			return &cpu_states[i];
 		}
 	}
 
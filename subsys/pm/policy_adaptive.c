@@ -0,0 +1,216 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "pm_policy_adaptive.h"
+#include "pm_stats.h"
+
+#include <string.h>
+
+#include <zephyr/init.h>
+#include <zephyr/kernel.h>
+#include <zephyr/pm/state.h>
+#include <zephyr/sys/time_units.h>
+#include <zephyr/sys/util.h>
+
+#define HISTORY_LEN CONFIG_PM_POLICY_ADAPTIVE_HISTORY
+
+/** Idle durations are kept in us, clamped so their squares can be summed */
+#define IDLE_US_MAX BIT(24)
+
+/** Variance (us^2) below which the history is considered regular */
+#define VARIANCE_SMALL_US2 400U
+
+/** Correction factors are fixed point, FACTOR_ONE meaning 1.0 */
+#define FACTOR_SHIFT 10U
+#define FACTOR_ONE BIT(FACTOR_SHIFT)
+/** Weight (as a power of two) given to the newest correction sample */
+#define FACTOR_DECAY_SHIFT 3U
+
+/**
+ * Expected idle durations are bucketed by powers of 8 us, so that short
+ * timer based predictions do not skew long ones and vice versa.
+ */
+#define NUM_BUCKETS 6U
+
+struct adaptive_cpu {
+	/** Last measured idle durations, in us */
+	uint32_t history[HISTORY_LEN];
+	/** Next history slot to be written */
+	uint8_t next;
+	/** Number of valid history entries */
+	uint8_t count;
+	/** Whether a prediction is waiting for feedback */
+	bool pending;
+	/** Bucket of the pending prediction */
+	uint8_t bucket;
+	/** Timer based expectation of the pending prediction (<0: none) */
+	int64_t expected_cyc;
+	/** Pending prediction (<0: unbounded) */
+	int64_t predicted_cyc;
+	/** Measured/expected idle duration ratio, per bucket */
+	uint32_t factor[NUM_BUCKETS];
+};
+
+static struct adaptive_cpu adaptive_cpus[CONFIG_MP_MAX_NUM_CPUS];
+
+static uint8_t bucket_get(int64_t cyc)
+{
+	uint64_t us = k_cyc_to_us_floor64((uint64_t)cyc) + 1U;
+
+	return MIN((uint8_t)(LOG2(us) / 3), NUM_BUCKETS - 1U);
+}
+
+/**
+ * @brief Obtain the typical idle duration observed in the history.
+ *
+ * The largest durations are discarded one at a time until the remaining
+ * ones are close to each other (standard deviation below 1/6th of the
+ * average, or small in absolute terms). Gives up if that requires
+ * discarding more than a quarter of the history.
+ *
+ * @return Typical idle duration in us, 0 if there is none.
+ */
+static uint32_t typical_idle_us(const struct adaptive_cpu *c)
+{
+	uint32_t limit = UINT32_MAX;
+
+	if (c->count < HISTORY_LEN) {
+		return 0U;
+	}
+
+	for (;;) {
+		uint64_t sum = 0U, sum_sq = 0U, avg, variance;
+		uint32_t max = 0U, n = 0U;
+
+		for (uint8_t i = 0U; i < HISTORY_LEN; i++) {
+			uint32_t us = c->history[i];
+
+			if (us > limit) {
+				continue;
+			}
+
+			sum += us;
+			sum_sq += (uint64_t)us * us;
+			max = MAX(max, us);
+			n++;
+		}
+
+		if ((n == 0U) || (n < (HISTORY_LEN * 3U) / 4U)) {
+			return 0U;
+		}
+
+		avg = sum / n;
+		variance = (sum_sq / n) - (avg * avg);
+
+		if ((variance <= VARIANCE_SMALL_US2) ||
+		    ((avg * avg) > (36U * variance))) {
+			return (uint32_t)avg;
+		}
+
+		limit = max - 1U;
+	}
+}
+
+int64_t pm_policy_adaptive_predict(uint8_t cpu, int64_t cyc)
+{
+	struct adaptive_cpu *c = &adaptive_cpus[cpu];
+	uint32_t typical_us = typical_idle_us(c);
+	int64_t predicted_cyc = cyc;
+
+	if (cyc >= 0) {
+		c->bucket = bucket_get(cyc);
+		predicted_cyc = (cyc * c->factor[c->bucket]) >> FACTOR_SHIFT;
+	}
+
+	if (typical_us != 0U) {
+		int64_t typical_cyc = (int64_t)k_us_to_cyc_ceil64(typical_us);
+
+		if ((predicted_cyc < 0) || (typical_cyc < predicted_cyc)) {
+			predicted_cyc = typical_cyc;
+		}
+	}
+
+	c->pending = true;
+	c->expected_cyc = cyc;
+	c->predicted_cyc = predicted_cyc;
+
+	return predicted_cyc;
+}
+
+void pm_policy_adaptive_update(uint8_t cpu, const struct pm_state_info *state,
+			       uint32_t idle_cyc)
+{
+	struct adaptive_cpu *c = &adaptive_cpus[cpu];
+	uint32_t idle_us = MIN(k_cyc_to_us_floor32(idle_cyc), IDLE_US_MAX);
+	uint32_t target_us = state->min_residency_us + state->exit_latency_us;
+	uint32_t predicted_us = UINT32_MAX;
+	const struct pm_state_info *cpu_states;
+	uint8_t num_cpu_states;
+	bool too_shallow = false;
+
+	/* a deeper state would have paid off */
+	num_cpu_states = pm_state_cpu_get_all(cpu, &cpu_states);
+	for (uint8_t i = 0U; i < num_cpu_states; i++) {
+		uint32_t us = cpu_states[i].min_residency_us +
+			      cpu_states[i].exit_latency_us;
+
+		if ((us > target_us) && (us <= idle_us)) {
+			too_shallow = true;
+			break;
+		}
+	}
+
+	c->history[c->next] = idle_us;
+	c->next = (c->next + 1U) % HISTORY_LEN;
+	if (c->count < HISTORY_LEN) {
+		c->count++;
+	}
+
+	if (c->pending) {
+		if (c->expected_cyc > 0) {
+			uint32_t *factor = &c->factor[c->bucket];
+			uint64_t ratio;
+
+			ratio = ((uint64_t)idle_cyc << FACTOR_SHIFT) /
+				(uint64_t)c->expected_cyc;
+			ratio = MIN(ratio, FACTOR_ONE);
+
+			*factor = *factor - (*factor >> FACTOR_DECAY_SHIFT) +
+				  ((uint32_t)ratio >> FACTOR_DECAY_SHIFT);
+		}
+
+		if (c->predicted_cyc >= 0) {
+			predicted_us = (uint32_t)MIN(
+				k_cyc_to_us_floor64((uint64_t)c->predicted_cyc),
+				UINT32_MAX - 1U);
+		}
+
+		c->pending = false;
+	}
+
+	pm_stats_policy_update(cpu, predicted_us, idle_us,
+			       idle_us < target_us, too_shallow);
+}
+
+void pm_policy_adaptive_reset(void)
+{
+	memset(adaptive_cpus, 0, sizeof(adaptive_cpus));
+
+	for (uint8_t i = 0U; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
+		for (uint8_t j = 0U; j < NUM_BUCKETS; j++) {
+			adaptive_cpus[i].factor[j] = FACTOR_ONE;
+		}
+	}
+}
+
+static int pm_policy_adaptive_init(void)
+{
+	pm_policy_adaptive_reset();
+
+	return 0;
+}
+
+SYS_INIT(pm_policy_adaptive_init, PRE_KERNEL_1, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
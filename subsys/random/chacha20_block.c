@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <zephyr/sys/byteorder.h>
+
+#include "chacha20_block.h"
+
+#define ROTL32(v, n) (((v) << (n)) | ((v) >> (32U - (n))))
+
+#define QUARTERROUND(a, b, c, d)			\
+	do {						\
+		a += b; d ^= a; d = ROTL32(d, 16U);	\
+		c += d; b ^= c; b = ROTL32(b, 12U);	\
+		a += b; d ^= a; d = ROTL32(d, 8U);	\
+		c += d; b ^= c; b = ROTL32(b, 7U);	\
+	} while (false)
+
+void chacha20_block(const uint32_t key[CHACHA20_KEY_WORDS],
+		    uint64_t counter, uint8_t out[CHACHA20_BLOCK_SIZE])
+{
+	uint32_t in[CHACHA20_BLOCK_WORDS] = {
+		0x61707865U, 0x3320646eU, 0x79622d32U, 0x6b206574U,
+		key[0], key[1], key[2], key[3],
+		key[4], key[5], key[6], key[7],
+		(uint32_t)counter, (uint32_t)(counter >> 32), 0U, 0U,
+	};
+	uint32_t x[CHACHA20_BLOCK_WORDS];
+
+	memcpy(x, in, sizeof(x));
+
+	for (int i = 0; i < 10; i++) {
+		QUARTERROUND(x[0], x[4], x[8], x[12]);
+		QUARTERROUND(x[1], x[5], x[9], x[13]);
+		QUARTERROUND(x[2], x[6], x[10], x[14]);
+		QUARTERROUND(x[3], x[7], x[11], x[15]);
+		QUARTERROUND(x[0], x[5], x[10], x[15]);
+		QUARTERROUND(x[1], x[6], x[11], x[12]);
+		QUARTERROUND(x[2], x[7], x[8], x[13]);
+		QUARTERROUND(x[3], x[4], x[9], x[14]);
+	}
+
+	for (int i = 0; i < CHACHA20_BLOCK_WORDS; i++) {
+		sys_put_le32(x[i] + in[i], &out[i * sizeof(uint32_t)]);
+	}
+
+	memset(x, 0, sizeof(x));
+	memset(in, 0, sizeof(in));
+}
@@ -0,0 +1,25 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_SUBSYS_RANDOM_CHACHA20_BLOCK_H_
+#define ZEPHYR_SUBSYS_RANDOM_CHACHA20_BLOCK_H_
+
+#include <stdint.h>
+
+#define CHACHA20_KEY_WORDS	8
+#define CHACHA20_BLOCK_WORDS	16
+#define CHACHA20_BLOCK_SIZE	(CHACHA20_BLOCK_WORDS * sizeof(uint32_t))
+#define CHACHA20_KEY_SIZE	(CHACHA20_KEY_WORDS * sizeof(uint32_t))
+
+/*
+ * ChaCha20 block function in its original layout: state words 12 and 13
+ * hold a 64-bit block counter, words 14 and 15 a 64-bit nonce, which is
+ * always zero here.
+ */
+void chacha20_block(const uint32_t key[CHACHA20_KEY_WORDS],
+		    uint64_t counter, uint8_t out[CHACHA20_BLOCK_SIZE]);
+
+#endif /* ZEPHYR_SUBSYS_RANDOM_CHACHA20_BLOCK_H_ */
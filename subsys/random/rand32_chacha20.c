@@ -0,0 +1,272 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * ChaCha20 based CSPRNG.
+ *
+ * Each CPU runs its own generator, so that callers never contend with each
+ * other: a ChaCha20 key and block counter, plus the unused part of the last
+ * keystream block. Once a request has been served the key is replaced by
+ * fresh keystream ("fast key erasure"), so that a later state compromise
+ * does not reveal past output.
+ *
+ * Generators are periodically reseeded from an entropy pool, which is kept
+ * full in the background by the system work queue using the non-blocking
+ * entropy API. If the pool happens to be empty the generator keeps going on
+ * its current key and reseeds next time: random number generation never
+ * waits for the entropy source once initialized.
+ */
+
+#include <zephyr/init.h>
+#include <zephyr/device.h>
+#include <zephyr/drivers/entropy.h>
+#include <zephyr/kernel.h>
+#include <zephyr/spinlock.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/util.h>
+#include <string.h>
+
+#include "chacha20_block.h"
+
+/* Output produced per interrupt locked section */
+#define CHUNK_SIZE		256U
+
+/* Delay before trying again to fill the pool when the source ran dry */
+#define POOL_RETRY_DELAY	K_MSEC(10)
+
+struct chacha20_drbg {
+	uint32_t key[CHACHA20_KEY_WORDS];
+	uint64_t counter;
+	/* unused keystream, at the end of buf */
+	uint8_t buf[CHACHA20_BLOCK_SIZE];
+	uint8_t avail;
+	uint32_t since_reseed;
+};
+
+static struct chacha20_drbg drbgs[CONFIG_MP_MAX_NUM_CPUS];
+
+static const struct device *const entropy_dev =
+	DEVICE_DT_GET(DT_CHOSEN(zephyr_entropy));
+
+static struct k_spinlock pool_lock;
+static uint8_t pool[CONFIG_CS_CHACHA20_POOL_SIZE];
+static size_t pool_len;
+static struct k_work_delayable pool_work;
+static bool pool_ready;
+
+enum {
+	SEED_NONE,
+	SEED_BUSY,
+	SEED_DONE,
+};
+
+/* Generators are seeded once, by the first caller or the init function */
+static atomic_t seed_state = ATOMIC_INIT(SEED_NONE);
+
+static void drbg_rekey(struct chacha20_drbg *d, const uint8_t *seed)
+{
+	for (int i = 0; i < CHACHA20_KEY_WORDS; i++) {
+		d->key[i] ^= sys_get_le32(&seed[i * sizeof(uint32_t)]);
+	}
+
+	d->counter = 0U;
+	d->avail = 0U;
+	memset(d->buf, 0, sizeof(d->buf));
+}
+
+static void drbg_generate(struct chacha20_drbg *d, uint8_t *dst, size_t len)
+{
+	uint8_t block[CHACHA20_BLOCK_SIZE];
+
+	while (len > 0) {
+		size_t n;
+
+		if (d->avail == 0U) {
+			chacha20_block(d->key, d->counter++, d->buf);
+			d->avail = CHACHA20_BLOCK_SIZE;
+		}
+
+		n = MIN(len, d->avail);
+		memcpy(dst, &d->buf[CHACHA20_BLOCK_SIZE - d->avail], n);
+		memset(&d->buf[CHACHA20_BLOCK_SIZE - d->avail], 0, n);
+		d->avail -= n;
+		dst += n;
+		len -= n;
+	}
+
+	/* fast key erasure */
+	chacha20_block(d->key, d->counter++, block);
+	memset(d->key, 0, sizeof(d->key));
+	drbg_rekey(d, block);
+	memset(block, 0, sizeof(block));
+}
+
+static bool pool_take(uint8_t *dst, size_t len)
+{
+	k_spinlock_key_t key = k_spin_lock(&pool_lock);
+	bool taken = false;
+
+	if (pool_len >= len) {
+		pool_len -= len;
+		memcpy(dst, &pool[pool_len], len);
+		memset(&pool[pool_len], 0, len);
+		taken = true;
+	}
+
+	k_spin_unlock(&pool_lock, key);
+
+	if (pool_ready) {
+		(void)k_work_schedule(&pool_work, K_NO_WAIT);
+	}
+
+	return taken;
+}
+
+static void pool_fill(struct k_work *work)
+{
+	uint8_t buf[CONFIG_CS_CHACHA20_POOL_SIZE];
+	k_spinlock_key_t key;
+	size_t need;
+	int ret;
+
+	ARG_UNUSED(work);
+
+	key = k_spin_lock(&pool_lock);
+	need = sizeof(pool) - pool_len;
+	k_spin_unlock(&pool_lock, key);
+
+	if (need == 0U) {
+		return;
+	}
+
+	ret = entropy_get_entropy_isr(entropy_dev, buf, need, 0U);
+	if (ret == -ENOTSUP) {
+		/* no non-blocking API, this is the work queue: block */
+		ret = entropy_get_entropy(entropy_dev, buf, need);
+		ret = (ret == 0) ? (int)need : ret;
+	}
+
+	if (ret > 0) {
+		key = k_spin_lock(&pool_lock);
+		ret = MIN((size_t)ret, sizeof(pool) - pool_len);
+		memcpy(&pool[pool_len], buf, ret);
+		pool_len += ret;
+		need = sizeof(pool) - pool_len;
+		k_spin_unlock(&pool_lock, key);
+	}
+
+	memset(buf, 0, sizeof(buf));
+
+	if (need > 0U) {
+		(void)k_work_schedule(&pool_work, POOL_RETRY_DELAY);
+	}
+}
+
+static int drbg_seed(struct chacha20_drbg *d)
+{
+	uint8_t seed[CHACHA20_KEY_SIZE];
+	int ret;
+
+	if (!device_is_ready(entropy_dev)) {
+		return -ENODEV;
+	}
+
+	ret = entropy_get_entropy(entropy_dev, seed, sizeof(seed));
+	if (ret != 0) {
+		return -EIO;
+	}
+
+	drbg_rekey(d, seed);
+	memset(seed, 0, sizeof(seed));
+	d->since_reseed = 0U;
+
+	return 0;
+}
+
+static int drbg_seed_all(void)
+{
+	unsigned int num_cpus = arch_num_cpus();
+	int ret = 0;
+
+	if (likely(atomic_get(&seed_state) == SEED_DONE)) {
+		return 0;
+	}
+
+	if (!atomic_cas(&seed_state, SEED_NONE, SEED_BUSY)) {
+		/* another CPU is seeding, there is no state to use yet */
+		return (atomic_get(&seed_state) == SEED_DONE) ? 0 : -EAGAIN;
+	}
+
+	for (unsigned int i = 0U; i < num_cpus && ret == 0; i++) {
+		ret = drbg_seed(&drbgs[i]);
+	}
+
+	atomic_set(&seed_state, (ret == 0) ? SEED_DONE : SEED_NONE);
+
+	return ret;
+}
+
+static void drbg_reseed(struct chacha20_drbg *d)
+{
+	uint8_t seed[CHACHA20_KEY_SIZE];
+
+	/* keep going on the current key if the pool ran dry */
+	if (pool_take(seed, sizeof(seed))) {
+		drbg_rekey(d, seed);
+		memset(seed, 0, sizeof(seed));
+		d->since_reseed = 0U;
+	}
+}
+
+int z_impl_sys_csrand_get(void *dst, uint32_t outlen)
+{
+	uint8_t *out = dst;
+	int ret;
+
+	/* only seeds before initialization is complete */
+	ret = drbg_seed_all();
+	if (ret != 0) {
+		return ret;
+	}
+
+	while (outlen > 0U) {
+		size_t n = MIN(outlen, CHUNK_SIZE);
+		unsigned int key = arch_irq_lock();
+		struct chacha20_drbg *d = &drbgs[_current_cpu->id];
+
+		if (d->since_reseed >= CONFIG_CS_CHACHA20_RESEED_INTERVAL) {
+			drbg_reseed(d);
+		}
+
+		drbg_generate(d, out, n);
+		d->since_reseed += n;
+
+		arch_irq_unlock(key);
+
+		out += n;
+		outlen -= n;
+	}
+
+	return 0;
+}
+
+static int chacha20_csprng_init(void)
+{
+	int ret;
+
+	ret = drbg_seed_all();
+	if (ret != 0) {
+		return ret;
+	}
+
+	k_work_init_delayable(&pool_work, pool_fill);
+	pool_ready = true;
+	(void)k_work_schedule(&pool_work, K_NO_WAIT);
+
+	return 0;
+}
+
+SYS_INIT(chacha20_csprng_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
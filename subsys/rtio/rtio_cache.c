@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/rtio/rtio.h>
+#include <zephyr/cache.h>
+
+/* Number of buffers whose cache maintenance is batched together */
+#define RTIO_CACHE_RANGES 8
+
+struct rtio_cache_batch {
+	struct sys_cache_range ranges[RTIO_CACHE_RANGES];
+	size_t count;
+	int (*op)(const struct sys_cache_range *ranges, size_t count);
+};
+
+static int rtio_cache_batch_run(struct rtio_cache_batch *batch)
+{
+	size_t count = batch->count;
+
+	batch->count = 0;
+
+	return count > 0 ? batch->op(batch->ranges, count) : 0;
+}
+
+static int rtio_cache_batch_add(struct rtio_cache_batch *batch, void *buf, size_t len)
+{
+	if (buf == NULL || len == 0) {
+		return 0;
+	}
+
+	batch->ranges[batch->count].addr = buf;
+	batch->ranges[batch->count].size = len;
+
+	if (++batch->count < ARRAY_SIZE(batch->ranges)) {
+		return 0;
+	}
+
+	return rtio_cache_batch_run(batch);
+}
+
+int rtio_txn_cache_flush(const struct rtio_iodev_sqe *iodev_sqe)
+{
+	struct rtio_cache_batch tx = { .op = sys_cache_data_flush_ranges };
+	struct rtio_cache_batch rx = { .op = sys_cache_data_flush_and_invd_ranges };
+	int rc = 0;
+
+	for (; rc == 0 && iodev_sqe != NULL; iodev_sqe = rtio_txn_next(iodev_sqe)) {
+		const struct rtio_sqe *sqe = &iodev_sqe->sqe;
+
+		switch (sqe->op) {
+		case RTIO_OP_TX:
+			rc = rtio_cache_batch_add(&tx, sqe->buf, sqe->buf_len);
+			break;
+		case RTIO_OP_RX:
+			rc = rtio_cache_batch_add(&rx, sqe->buf, sqe->buf_len);
+			break;
+		case RTIO_OP_TXRX:
+			rc = rtio_cache_batch_add(&tx, sqe->tx_buf, sqe->txrx_buf_len);
+			if (rc == 0) {
+				rc = rtio_cache_batch_add(&rx, sqe->rx_buf, sqe->txrx_buf_len);
+			}
+			break;
+		default:
+			break;
+		}
+	}
+
+	if (rc == 0) {
+		rc = rtio_cache_batch_run(&tx);
+	}
+	if (rc == 0) {
+		rc = rtio_cache_batch_run(&rx);
+	}
+
+	return rc;
+}
+
+int rtio_txn_cache_invd(const struct rtio_iodev_sqe *iodev_sqe)
+{
+	struct rtio_cache_batch rx = { .op = sys_cache_data_invd_ranges };
+	int rc = 0;
+
+	for (; rc == 0 && iodev_sqe != NULL; iodev_sqe = rtio_txn_next(iodev_sqe)) {
+		const struct rtio_sqe *sqe = &iodev_sqe->sqe;
+
+		if (sqe->op == RTIO_OP_RX) {
+			rc = rtio_cache_batch_add(&rx, sqe->buf, sqe->buf_len);
+		} else if (sqe->op == RTIO_OP_TXRX) {
+			rc = rtio_cache_batch_add(&rx, sqe->rx_buf, sqe->txrx_buf_len);
+		}
+	}
+
+	if (rc == 0) {
+		rc = rtio_cache_batch_run(&rx);
+	}
+
+	return rc;
+}
@@ -6,27 +6,122 @@
 
 #include <zephyr/rtio/rtio.h>
 #include <zephyr/kernel.h>
+#include <zephyr/timeout_q.h>
 
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(rtio_executor, CONFIG_RTIO_LOG_LEVEL);
 
+static void rtio_iodev_submit(struct rtio_iodev_sqe *iodev_sqe);
+
+#ifdef CONFIG_RTIO_DELAY
+static void rtio_executor_delay_expired(struct _timeout *t);
+
 /**
- * @brief Submit to an iodev a submission to work on
+ * @brief Start the next period of a periodic delay
  *
- * Should be called by the executor when it wishes to submit work
- * to an iodev.
+ * Called from the timeout handler, where the uptime is the time the period
+ * ended at, so that the periods do not drift as in z_timer_expiration_handler().
+ */
+static void rtio_executor_delay_rearm(struct rtio_iodev_sqe *iodev_sqe)
+{
+	k_timeout_t next = iodev_sqe->sqe.delay.timeout;
+
+	/* Already aligned to a tick boundary */
+	next.ticks = MAX(next.ticks - 1, 0);
+
+#ifdef CONFIG_TIMEOUT_64BIT
+	next = K_TIMEOUT_ABS_TICKS(k_uptime_ticks() + 1 + next.ticks);
+#endif
+	z_add_timeout(&iodev_sqe->sqe.delay.to, rtio_executor_delay_expired, next);
+}
+
+/**
+ * @brief End of a period of a periodic delay
  *
- * @param iodev_sqe Submission to work on
+ * Completes the delay without releasing it and submits the chain following
+ * it again, unless it is still running.
  */
-static inline void rtio_iodev_submit(struct rtio_iodev_sqe *iodev_sqe)
+static void rtio_executor_delay_period(struct rtio_iodev_sqe *iodev_sqe)
 {
+	struct rtio *r = iodev_sqe->r;
+	struct rtio_iodev_sqe *chain = rtio_iodev_sqe_next(iodev_sqe);
+	struct rtio_iodev_sqe *curr, *next;
+	bool running = false;
+	int result = 0;
+
+	for (curr = chain; curr != NULL; curr = rtio_iodev_sqe_next(curr)) {
+		running |= FIELD_GET(RTIO_SQE_PERIODIC_RUNNING, curr->sqe.flags) == 1;
+	}
+
 	if (FIELD_GET(RTIO_SQE_CANCELED, iodev_sqe->sqe.flags)) {
-		/* Canceled */
-		rtio_iodev_sqe_err(iodev_sqe, -ECANCELED);
+		if (running) {
+			/* Release the chain once it is done */
+			rtio_executor_delay_rearm(iodev_sqe);
+			return;
+		}
+
+		for (curr = iodev_sqe; curr != NULL; curr = next) {
+			next = rtio_iodev_sqe_next(curr);
+			rtio_sqe_pool_free(r->sqe_pool, curr);
+		}
 		return;
 	}
-	iodev_sqe->sqe.iodev->api->submit(iodev_sqe);
+
+	rtio_executor_delay_rearm(iodev_sqe);
+
+	if (running) {
+		LOG_DBG("Chain of periodic delay %p overran its period", (void *)iodev_sqe);
+		result = -EBUSY;
+	} else {
+		for (curr = chain; curr != NULL; curr = rtio_iodev_sqe_next(curr)) {
+			curr->sqe.flags |= RTIO_SQE_PERIODIC_RUNNING;
+		}
+	}
+
+	if (FIELD_GET(RTIO_SQE_NO_RESPONSE, iodev_sqe->sqe.flags) == 0) {
+		rtio_cqe_submit(r, result, iodev_sqe->sqe.userdata,
+				rtio_cqe_compute_flags(iodev_sqe));
+	}
+
+	if (chain != NULL && result == 0) {
+		rtio_iodev_submit(chain);
+	}
+}
+
+static void rtio_executor_delay_expired(struct _timeout *t)
+{
+	struct rtio_iodev_sqe *iodev_sqe = CONTAINER_OF(t, struct rtio_iodev_sqe, sqe.delay.to);
+
+	if (FIELD_GET(RTIO_SQE_MULTISHOT, iodev_sqe->sqe.flags)) {
+		rtio_executor_delay_period(iodev_sqe);
+	} else {
+		rtio_iodev_sqe_ok(iodev_sqe, 0);
+	}
+}
+
+static void rtio_executor_delay(struct rtio_iodev_sqe *iodev_sqe)
+{
+	k_timeout_t timeout = iodev_sqe->sqe.delay.timeout;
+
+	if (FIELD_GET(RTIO_SQE_MULTISHOT, iodev_sqe->sqe.flags)) {
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT) || K_TIMEOUT_EQ(timeout, K_FOREVER) ||
+		    Z_TICK_ABS(timeout.ticks) >= 0) {
+			/* A period must be relative and finite, complete only once */
+			iodev_sqe->sqe.flags &= ~RTIO_SQE_MULTISHOT;
+			rtio_iodev_sqe_err(iodev_sqe, -EINVAL);
+			return;
+		}
+
+		/* The chain following a periodic delay is reused each period */
+		for (struct rtio_iodev_sqe *curr = rtio_iodev_sqe_next(iodev_sqe); curr != NULL;
+		     curr = rtio_iodev_sqe_next(curr)) {
+			curr->sqe.flags |= RTIO_SQE_PERIODIC;
+		}
+	}
+
+	z_add_timeout(&iodev_sqe->sqe.delay.to, rtio_executor_delay_expired, timeout);
 }
+#endif /* CONFIG_RTIO_DELAY */
 
 /**
  * @brief Executor handled submissions
@@ -40,11 +135,72 @@ static void rtio_executor_op(struct rtio_iodev_sqe *iodev_sqe)
 		sqe->callback(iodev_sqe->r, sqe, sqe->arg0);
 		rtio_iodev_sqe_ok(iodev_sqe, 0);
 		break;
+#ifdef CONFIG_RTIO_DELAY
+	case RTIO_OP_DELAY:
+		rtio_executor_delay(iodev_sqe);
+		break;
+#endif
 	default:
 		rtio_iodev_sqe_err(iodev_sqe, -EINVAL);
 	}
 }
 
+/**
+ * @brief Submit to an iodev a submission to work on
+ *
+ * Should be called by the executor when it wishes to submit work
+ * to an iodev. Submissions without iodev are done by the executor.
+ *
+ * @param iodev_sqe Submission to work on
+ */
+static void rtio_iodev_submit(struct rtio_iodev_sqe *iodev_sqe)
+{
+	if (FIELD_GET(RTIO_SQE_CANCELED, iodev_sqe->sqe.flags)) {
+		/* Canceled */
+		rtio_iodev_sqe_err(iodev_sqe, -ECANCELED);
+		return;
+	}
+
+	if (iodev_sqe->sqe.iodev == NULL) {
+		rtio_executor_op(iodev_sqe);
+		return;
+	}
+
+	iodev_sqe->sqe.iodev->api->submit(iodev_sqe);
+}
+
+#ifdef CONFIG_RTIO_EXECUTOR_PRIO
+/**
+ * @brief Insert a submission in a list ordered by decreasing priority
+ *
+ * The list is linked through the queue node of the submissions, which is free
+ * once popped from the submission queue. Submissions of the same priority keep
+ * the order they were queued in.
+ *
+ * @param pending First submission of the list
+ * @param iodev_sqe Submission to insert
+ */
+static void rtio_executor_pend(struct rtio_mpsc_node **pending,
+			       struct rtio_iodev_sqe *iodev_sqe)
+{
+	struct rtio_mpsc_node *prev = NULL;
+	struct rtio_mpsc_node *curr = *pending;
+
+	while (curr != NULL &&
+	       CONTAINER_OF(curr, struct rtio_iodev_sqe, q)->sqe.prio >= iodev_sqe->sqe.prio) {
+		prev = curr;
+		curr = (struct rtio_mpsc_node *)mpsc_ptr_get(curr->next);
+	}
+
+	mpsc_ptr_set(iodev_sqe->q.next, curr);
+	if (prev == NULL) {
+		*pending = &iodev_sqe->q;
+	} else {
+		mpsc_ptr_set(prev->next, &iodev_sqe->q);
+	}
+}
+#endif /* CONFIG_RTIO_EXECUTOR_PRIO */
+
 /**
  * @brief Submit operations in the queue to iodevs
  *
@@ -55,47 +211,60 @@ static void rtio_executor_op(struct rtio_iodev_sqe *iodev_sqe)
 void rtio_executor_submit(struct rtio *r)
 {
 	struct rtio_mpsc_node *node = rtio_mpsc_pop(&r->sq);
+#ifdef CONFIG_RTIO_EXECUTOR_PRIO
+	struct rtio_mpsc_node *pending = NULL;
+#endif
 
 	while (node != NULL) {
 		struct rtio_iodev_sqe *iodev_sqe = CONTAINER_OF(node, struct rtio_iodev_sqe, q);
 		uint16_t canceled_mask = iodev_sqe->sqe.flags & RTIO_SQE_CANCELED;
 
-		iodev_sqe->r = r;
+		struct rtio_iodev_sqe *curr = iodev_sqe, *next;
 
-		if (iodev_sqe->sqe.iodev == NULL) {
-			rtio_executor_op(iodev_sqe);
-		} else {
-			struct rtio_iodev_sqe *curr = iodev_sqe, *next;
+		iodev_sqe->r = r;
 
-			/* Link up transaction or queue list if needed */
-			while (curr->sqe.flags & (RTIO_SQE_TRANSACTION | RTIO_SQE_CHAINED)) {
+		/* Link up transaction or queue list if needed */
+		while (curr->sqe.flags & (RTIO_SQE_TRANSACTION | RTIO_SQE_CHAINED)) {
 #ifdef CONFIG_ASSERT
-				bool transaction = iodev_sqe->sqe.flags & RTIO_SQE_TRANSACTION;
-				bool chained = iodev_sqe->sqe.flags & RTIO_SQE_CHAINED;
+			bool transaction = iodev_sqe->sqe.flags & RTIO_SQE_TRANSACTION;
+			bool chained = iodev_sqe->sqe.flags & RTIO_SQE_CHAINED;
 
-				__ASSERT(transaction != chained,
-					 "Expected chained or transaction flag, not both");
+			__ASSERT(transaction != chained,
+				 "Expected chained or transaction flag, not both");
 #endif
-				node = rtio_mpsc_pop(&iodev_sqe->r->sq);
-				next = CONTAINER_OF(node, struct rtio_iodev_sqe, q);
-				next->sqe.flags |= canceled_mask;
-				curr->next = next;
-				curr = next;
-				curr->r = r;
-
-				__ASSERT(
-					curr != NULL,
-					"Expected a valid sqe following transaction or chain flag");
-			}
-
-			curr->next = NULL;
+			node = rtio_mpsc_pop(&iodev_sqe->r->sq);
+			next = CONTAINER_OF(node, struct rtio_iodev_sqe, q);
+			next->sqe.flags |= canceled_mask;
+			curr->next = next;
+			curr = next;
 			curr->r = r;
 
-			rtio_iodev_submit(iodev_sqe);
+			__ASSERT(
+				curr != NULL,
+				"Expected a valid sqe following transaction or chain flag");
 		}
 
+		curr->next = NULL;
+		curr->r = r;
+
+#ifdef CONFIG_RTIO_EXECUTOR_PRIO
+		rtio_executor_pend(&pending, iodev_sqe);
+#else
+		rtio_iodev_submit(iodev_sqe);
+#endif
+
 		node = rtio_mpsc_pop(&r->sq);
 	}
+
+#ifdef CONFIG_RTIO_EXECUTOR_PRIO
+	/* Submit the chains and transactions by decreasing priority of their first sqe */
+	while (pending != NULL) {
+		struct rtio_iodev_sqe *iodev_sqe = CONTAINER_OF(pending, struct rtio_iodev_sqe, q);
+
+		pending = (struct rtio_mpsc_node *)mpsc_ptr_get(pending->next);
+		rtio_iodev_submit(iodev_sqe);
+	}
+#endif
 }
 
 /**
@@ -142,12 +311,17 @@ static inline void rtio_executor_done(struct rtio_iodev_sqe *iodev_sqe, int resu
 		cqe_flags = rtio_cqe_compute_flags(iodev_sqe);
 
 		next = rtio_iodev_sqe_next(curr);
-		if (is_multishot) {
-			rtio_executor_handle_multishot(r, curr, is_canceled);
-		}
-		if (!is_multishot || is_canceled) {
-			/* SQE is no longer needed, release it */
-			rtio_sqe_pool_free(r->sqe_pool, curr);
+		if (sqe_flags & RTIO_SQE_PERIODIC) {
+			/* SQE is reused by the periodic delay it is chained to */
+			curr->sqe.flags &= ~RTIO_SQE_PERIODIC_RUNNING;
+		} else {
+			if (is_multishot) {
+				rtio_executor_handle_multishot(r, curr, is_canceled);
+			}
+			if (!is_multishot || is_canceled) {
+				/* SQE is no longer needed, release it */
+				rtio_sqe_pool_free(r->sqe_pool, curr);
+			}
 		}
 		if (!is_canceled && FIELD_GET(RTIO_SQE_NO_RESPONSE, sqe_flags) == 0) {
 			/* Request was not canceled, generate a CQE */
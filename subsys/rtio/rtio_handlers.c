@@ -42,6 +42,13 @@ static inline bool rtio_vrfy_sqe(struct rtio_sqe *sqe)
 		valid_sqe &= Z_SYSCALL_MEMORY(sqe->tx_buf, sqe->txrx_buf_len, true);
 		valid_sqe &= Z_SYSCALL_MEMORY(sqe->rx_buf, sqe->txrx_buf_len, true);
 		break;
+#ifdef CONFIG_RTIO_DELAY
+	case RTIO_OP_DELAY:
+		/* The timeout is owned by the executor */
+		memset(&sqe->delay.to, 0, sizeof(sqe->delay.to));
+		sqe->flags &= ~(RTIO_SQE_PERIODIC | RTIO_SQE_PERIODIC_RUNNING);
+		break;
+#endif
 	default:
 		/* RTIO OP must be known and allowable from user mode
 		 * otherwise it is invalid
@@ -122,6 +129,77 @@ static inline int z_vrfy_rtio_cqe_copy_out(struct rtio *r,
 }
 #include <syscalls/rtio_cqe_copy_out_mrsh.c>
 
+#ifdef CONFIG_RTIO_USER_RING
+/**
+ * Copy the submissions produced to the submission ring shared with user mode
+ * into the submission queue, verifying the copies.
+ *
+ * Only whole chains and transactions are copied, the rest stays in the ring
+ * until the next submit. The producer index and the submissions are written
+ * by user mode, so that the flags are checked again on the copies.
+ *
+ * @retval 0 On success
+ * @retval -EINVAL If the producer index is out of the ring
+ */
+static int rtio_ring_sq_copy_in(struct rtio *r)
+{
+	struct rtio_ring *ring = r->ring;
+	const uint16_t chain_mask = RTIO_SQE_CHAINED | RTIO_SQE_TRANSACTION;
+	unsigned long in, count, copy = 0;
+	struct rtio_sqe *sqe = NULL;
+	k_spinlock_key_t key;
+	int rc = 0;
+
+	if (ring == NULL) {
+		return 0;
+	}
+
+	/* Submitting threads may race for the consumer index */
+	key = k_spin_lock(&ring->lock);
+
+	in = (unsigned long)atomic_get(&ring->sq->_spsc.in);
+	count = in - ring->sq_out;
+	if (count > ring->sq_mask + 1) {
+		rc = -EINVAL;
+		goto out;
+	}
+
+	count = MIN(count, rtio_sqe_acquirable(r));
+	for (unsigned long i = 0; i < count; i++) {
+		if ((ring->sqes[(ring->sq_out + i) & ring->sq_mask].flags & chain_mask) == 0) {
+			copy = i + 1;
+		}
+	}
+
+	for (unsigned long i = 0; i < copy; i++) {
+		sqe = rtio_sqe_acquire(r);
+		__ASSERT_NO_MSG(sqe != NULL);
+		*sqe = ring->sqes[(ring->sq_out + i) & ring->sq_mask];
+
+		if (!rtio_vrfy_sqe(sqe)) {
+			rtio_sqe_drop_all(r);
+			rc = -EINVAL;
+			goto out;
+		}
+	}
+
+	if (sqe != NULL && (sqe->flags & chain_mask) != 0) {
+		/* Modified since checked, the last chain would not end */
+		rtio_sqe_drop_all(r);
+		rc = -EINVAL;
+		goto out;
+	}
+
+	ring->sq_out += copy;
+	atomic_set(&ring->sq->_spsc.out, (atomic_val_t)ring->sq_out);
+
+out:
+	k_spin_unlock(&ring->lock, key);
+
+	return rc;
+}
+#endif /* CONFIG_RTIO_USER_RING */
+
 static inline int z_vrfy_rtio_submit(struct rtio *r, uint32_t wait_count)
 {
 	Z_OOPS(Z_SYSCALL_OBJ(r, K_OBJ_RTIO));
@@ -130,6 +208,10 @@ static inline int z_vrfy_rtio_submit(struct rtio *r, uint32_t wait_count)
 	Z_OOPS(Z_SYSCALL_OBJ(r->submit_sem, K_OBJ_SEM));
 #endif
 
+#ifdef CONFIG_RTIO_USER_RING
+	Z_OOPS(rtio_ring_sq_copy_in(r));
+#endif
+
 	return z_impl_rtio_submit(r, wait_count);
 }
 #include <syscalls/rtio_submit_mrsh.c>
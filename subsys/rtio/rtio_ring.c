@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <zephyr/rtio/rtio.h>
+#include <zephyr/kernel.h>
+
+/**
+ * @brief Produce a completion to the completion ring shared with user mode
+ *
+ * The consumer index is written by user mode, any value out of the ring is
+ * considered as a full ring.
+ *
+ * @retval 0 On success
+ * @retval -ENOMEM If the completion ring is full
+ */
+int rtio_ring_cqe_submit(struct rtio_ring *ring, int result, void *userdata, uint32_t flags)
+{
+	k_spinlock_key_t key = k_spin_lock(&ring->lock);
+	unsigned long out = (unsigned long)atomic_get(&ring->cq->_spsc.out);
+	struct rtio_cqe *cqe;
+	int rc = 0;
+
+	if (ring->cq_in - out > ring->cq_mask) {
+		rc = -ENOMEM;
+	} else {
+		cqe = &ring->cqes[ring->cq_in & ring->cq_mask];
+		cqe->result = result;
+		cqe->userdata = userdata;
+		cqe->flags = flags;
+		ring->cq_in++;
+		atomic_set(&ring->cq->_spsc.in, (atomic_val_t)ring->cq_in);
+	}
+
+	k_spin_unlock(&ring->lock, key);
+
+	return rc;
+}
@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <zephyr/drivers/disk.h>
 #include <zephyr/drivers/sdhc.h>
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
@@ -49,6 +50,9 @@
 #define MMC_SWITCH_CACHE_ON_ARG                                                                    \
 	(0xFC000000 & (0U << 26)) + (0x03000000 & (0b11 << 24)) + (0x00FF0000 & (33U << 16)) +     \
 		(0x0000FF00 & (1U << 8)) + (0x000000F7 & (0U << 3)) + (0x00000000 & (3U << 0))
+#define MMC_SWITCH_FLUSH_CACHE_ARG                                                                 \
+	(0xFC000000 & (0U << 26)) + (0x03000000 & (0b11 << 24)) + (0x00FF0000 & (32U << 16)) +     \
+		(0x0000FF00 & (1U << 8)) + (0x000000F7 & (0U << 3)) + (0x00000000 & (3U << 0))
 
 LOG_MODULE_DECLARE(sd, CONFIG_SD_LOG_LEVEL);
 
@@ -64,9 +68,19 @@ inline int mmc_read_blocks(struct sd_card *card, uint8_t *rbuf, uint32_t start_b
 	return card_read_blocks(card, rbuf, start_block, num_blocks);
 }
 
+/* Writes the content of the eMMC cache to the flash */
+static int mmc_flush_cache(struct sd_card *card);
+
 inline int mmc_ioctl(struct sd_card *card, uint8_t cmd, void *buf)
 {
-	return card_ioctl(card, cmd, buf);
+	int ret;
+
+	ret = card_ioctl(card, cmd, buf);
+	if (ret || (cmd != DISK_IOCTL_CTRL_SYNC) || !(card->flags & SD_MMC_CACHE_FLAG)) {
+		return ret;
+	}
+	/* Data written may still be in the card cache */
+	return mmc_flush_cache(card);
 }
 
 /* Sends CMD1 */
@@ -639,5 +653,35 @@ static int mmc_set_cache(struct sd_card *card, struct mmc_ext_csd *card_ext_csd)
 		return ret;
 	}
 	ret = sdmmc_wait_ready(card);
+	if (ret) {
+		return ret;
+	}
+	card->flags |= SD_MMC_CACHE_FLAG;
+	return 0;
+}
+
+static int mmc_flush_cache(struct sd_card *card)
+{
+	int ret;
+	struct sdhc_command cmd = {0};
+
+	ret = k_mutex_lock(&card->lock, K_NO_WAIT);
+	if (ret) {
+		LOG_WRN("Could not get SD card mutex");
+		return -EBUSY;
+	}
+	/* CMD6 to write to EXT CSD to flush cache */
+	cmd.opcode = SD_SWITCH;
+	cmd.arg = MMC_SWITCH_FLUSH_CACHE_ARG;
+	cmd.response_type = SD_RSP_TYPE_R1b;
+	cmd.timeout_ms = CONFIG_SD_DATA_TIMEOUT;
+	ret = sdhc_request(card->sdhc, &cmd, NULL);
+	if (ret) {
+		LOG_DBG("Error flushing card cache: %d", ret);
+		k_mutex_unlock(&card->lock);
+		return ret;
+	}
+	ret = sdmmc_wait_ready(card);
+	k_mutex_unlock(&card->lock);
 	return ret;
 }
@@ -471,6 +471,65 @@ int card_app_command(struct sd_card *card, int relative_card_address)
 	return 0;
 }
 
+#ifdef CONFIG_SD_CMD23
+/* CMD23 block count field is 16 bits wide */
+#define CARD_MAX_TRANSFER_BLOCKS 0xFFFFU
+#else
+#define CARD_MAX_TRANSFER_BLOCKS UINT32_MAX
+#endif
+
+/* Sends CMD23 to set the block count of the next multiple block transfer */
+static int card_set_block_count(struct sd_card *card, uint32_t num_blocks)
+{
+	int ret;
+	struct sdhc_command cmd = {0};
+
+	/* eMMC cards always support CMD23, SD cards report it in the SCR */
+	if ((card->type != CARD_MMC) && !(card->flags & SD_CMD23_FLAG)) {
+		return 0;
+	}
+
+	cmd.opcode = SD_SET_BLOCK_COUNT;
+	cmd.arg = num_blocks;
+	cmd.response_type = (SD_RSP_TYPE_R1 | SD_SPI_RSP_TYPE_R1);
+	cmd.timeout_ms = CONFIG_SD_CMD_TIMEOUT;
+	ret = sdhc_request(card->sdhc, &cmd, NULL);
+	if (ret) {
+		LOG_DBG("CMD23 failed: %d", ret);
+		return ret;
+	}
+	return sd_check_response(&cmd);
+}
+
+/* Sends ACMD23 so that the card pre-erases the blocks of the next write */
+static int card_set_pre_erase(struct sd_card *card, uint32_t num_blocks)
+{
+	int ret;
+	struct sdhc_command cmd = {0};
+
+	if (card->type != CARD_SDMMC) {
+		return 0;
+	}
+
+	ret = card_app_command(card, card->relative_addr);
+	if (ret) {
+		LOG_DBG("App CMD for ACMD23 failed");
+		return ret;
+	}
+
+	cmd.opcode = SD_APP_SET_WRITE_BLK_ERASE_CNT;
+	/* Erase count is bits [22:0] of the argument */
+	cmd.arg = num_blocks & 0x7FFFFFU;
+	cmd.response_type = (SD_RSP_TYPE_R1 | SD_SPI_RSP_TYPE_R1);
+	cmd.timeout_ms = CONFIG_SD_CMD_TIMEOUT;
+	ret = sdhc_request(card->sdhc, &cmd, NULL);
+	if (ret) {
+		LOG_DBG("ACMD23 failed: %d", ret);
+		return ret;
+	}
+	return sd_check_response(&cmd);
+}
+
 static int card_read(struct sd_card *card, uint8_t *rbuf, uint32_t start_block, uint32_t num_blocks)
 {
 	int ret;
@@ -487,8 +546,16 @@ static int card_read(struct sd_card *card, uint8_t *rbuf, uint32_t start_block,
 	 * commands. Therefore, we will not handle CMD12 or CMD23 at this layer.
 	 * The host SDHC driver is expected to recognize CMD17, CMD18, CMD24,
 	 * and CMD25 as special read/write commands and handle CMD23 and
-	 * CMD12 appropriately.
+	 * CMD12 appropriately. With CONFIG_SD_CMD23, CMD23 is sent here for
+	 * hosts which do not.
 	 */
+	if (IS_ENABLED(CONFIG_SD_CMD23) && (num_blocks > 1U)) {
+		ret = card_set_block_count(card, num_blocks);
+		if (ret) {
+			LOG_ERR("Failed to set block count: %d", ret);
+			return ret;
+		}
+	}
 	cmd.opcode = (num_blocks == 1U) ? SD_READ_SINGLE_BLOCK : SD_READ_MULTIPLE_BLOCK;
 	if (!(card->flags & SD_HIGH_CAPACITY_FLAG)) {
 		/* SDSC cards require block size in bytes, not blocks */
@@ -559,10 +626,11 @@ int card_read_blocks(struct sd_card *card, uint8_t *rbuf, uint32_t start_block,
 			k_mutex_unlock(&card->lock);
 			return -ENOBUFS;
 		}
-		rlen = sizeof(card->card_buffer) / card->block_size;
 		sector = 0;
 		buf_offset = rbuf;
 		while (sector < num_blocks) {
+			rlen = MIN(sizeof(card->card_buffer) / card->block_size,
+				   num_blocks - sector);
 			/* Read from disk to card buffer */
 			ret = card_read(card, card->card_buffer, sector + start_block, rlen);
 			if (ret) {
@@ -578,11 +646,17 @@ int card_read_blocks(struct sd_card *card, uint8_t *rbuf, uint32_t start_block,
 		}
 	} else {
 		/* Aligned buffers can be used directly */
-		ret = card_read(card, rbuf, start_block, num_blocks);
-		if (ret) {
-			LOG_ERR("Card read failed");
-			k_mutex_unlock(&card->lock);
-			return ret;
+		sector = 0;
+		while (sector < num_blocks) {
+			rlen = MIN(CARD_MAX_TRANSFER_BLOCKS, num_blocks - sector);
+			ret = card_read(card, rbuf + sector * card->block_size,
+					sector + start_block, rlen);
+			if (ret) {
+				LOG_ERR("Card read failed");
+				k_mutex_unlock(&card->lock);
+				return ret;
+			}
+			sector += rlen;
 		}
 	}
 	k_mutex_unlock(&card->lock);
@@ -642,8 +716,23 @@ static int card_write(struct sd_card *card, const uint8_t *wbuf, uint32_t start_
 
 	/*
 	 * See the note in card_read() above. We will not issue CMD23
-	 * or CMD12, and expect the host to handle those details.
+	 * or CMD12 unless CONFIG_SD_CMD23 is set, and expect the host to
+	 * handle those details.
 	 */
+	if (IS_ENABLED(CONFIG_SD_WRITE_PRE_ERASE) && (num_blocks > 1U)) {
+		/* Only a hint to the card, the write proceeds without it */
+		ret = card_set_pre_erase(card, num_blocks);
+		if (ret) {
+			LOG_DBG("Failed to set pre-erase count: %d", ret);
+		}
+	}
+	if (IS_ENABLED(CONFIG_SD_CMD23) && (num_blocks > 1U)) {
+		ret = card_set_block_count(card, num_blocks);
+		if (ret) {
+			LOG_ERR("Failed to set block count: %d", ret);
+			return ret;
+		}
+	}
 	cmd.opcode = (num_blocks == 1) ? SD_WRITE_SINGLE_BLOCK : SD_WRITE_MULTIPLE_BLOCK;
 	if (!(card->flags & SD_HIGH_CAPACITY_FLAG)) {
 		/* SDSC cards require block size in bytes, not blocks */
@@ -722,10 +811,11 @@ int card_write_blocks(struct sd_card *card, const uint8_t *wbuf, uint32_t start_
 			k_mutex_unlock(&card->lock);
 			return -ENOBUFS;
 		}
-		wlen = sizeof(card->card_buffer) / card->block_size;
 		sector = 0;
 		buf_offset = wbuf;
 		while (sector < num_blocks) {
+			wlen = MIN(sizeof(card->card_buffer) / card->block_size,
+				   num_blocks - sector);
 			/* Copy data into card buffer */
 			memcpy(card->card_buffer, buf_offset, wlen * card->block_size);
 			/* Write card buffer to disk */
@@ -741,11 +831,17 @@ int card_write_blocks(struct sd_card *card, const uint8_t *wbuf, uint32_t start_
 		}
 	} else {
 		/* We can use aligned buffers directly */
-		ret = card_write(card, wbuf, start_block, num_blocks);
-		if (ret) {
-			LOG_ERR("Write failed");
-			k_mutex_unlock(&card->lock);
-			return ret;
+		sector = 0;
+		while (sector < num_blocks) {
+			wlen = MIN(CARD_MAX_TRANSFER_BLOCKS, num_blocks - sector);
+			ret = card_write(card, wbuf + sector * card->block_size,
+					 sector + start_block, wlen);
+			if (ret) {
+				LOG_ERR("Write failed");
+				k_mutex_unlock(&card->lock);
+				return ret;
+			}
+			sector += wlen;
 		}
 	}
 	k_mutex_unlock(&card->lock);
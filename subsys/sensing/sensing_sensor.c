@@ -8,21 +8,40 @@
 #include <zephyr/sensing/sensing.h>
 #include <zephyr/sensing/sensing_sensor.h>
 #include <zephyr/sys/__assert.h>
+#include "sensor_mgmt.h"
 
 #include <zephyr/logging/log.h>
 LOG_MODULE_DECLARE(sensing, CONFIG_SENSING_LOG_LEVEL);
 
 int sensing_sensor_notify_data_ready(const struct device *dev)
 {
-	return -ENOTSUP;
+	struct sensing_sensor *sensor = get_sensor_by_dev(dev);
+
+	if (sensor == NULL) {
+		return -ENODEV;
+	}
+
+	return notify_sensor_data_ready(sensor);
 }
 
 int sensing_sensor_set_data_ready(const struct device *dev, bool data_ready)
 {
-	return -ENOTSUP;
+	struct sensing_sensor *sensor = get_sensor_by_dev(dev);
+
+	if (sensor == NULL) {
+		return -ENODEV;
+	}
+
+	return set_sensor_data_ready(sensor, data_ready);
 }
 
 int sensing_sensor_post_data(const struct device *dev, void *buf, int size)
 {
-	return -ENOTSUP;
+	struct sensing_sensor *sensor = get_sensor_by_dev(dev);
+
+	if (sensor == NULL) {
+		return -ENODEV;
+	}
+
+	return post_sensor_data(sensor, buf, size);
 }
@@ -11,6 +11,7 @@
 #include <zephyr/sensing/sensing_sensor.h>
 #include <zephyr/logging/log.h>
 #include <stdlib.h>
+#include <string.h>
 #include "sensor_mgmt.h"
 
 #define DT_DRV_COMPAT zephyr_sensing
@@ -35,12 +36,24 @@ struct sensing_context {
 	bool sensing_initialized;
 	int sensor_num;
 	struct sensing_sensor *sensors[SENSING_SENSOR_NUM];
+	/* connections and configurations, shared by the clients and the runtime thread */
+	struct k_mutex lock;
+	/* wakes the runtime thread up on configuration changes and data ready events */
+	struct k_sem event_sem;
+	struct k_thread runtime_thread;
 };
 
 static struct sensing_context sensing_ctx = {
 	.sensor_num = SENSING_SENSOR_NUM,
 };
 
+static K_KERNEL_STACK_DEFINE(runtime_stack, CONFIG_SENSING_RUNTIME_THREAD_STACK_SIZE);
+
+static inline uint64_t get_us(void)
+{
+	return k_ticks_to_us_floor64(k_uptime_ticks());
+}
+
 
 static int set_sensor_state(struct sensing_sensor *sensor, enum sensing_sensor_state state)
 {
@@ -60,6 +73,7 @@ static void init_connection(struct sensing_connection *conn,
 	conn->source = source;
 	conn->sink = sink;
 	conn->interval = 0;
+	conn->next_consume_time = 0;
 	memset(conn->sensitivity, 0x00, sizeof(conn->sensitivity));
 	/* link connection to its reporter's client_list */
 	sys_slist_append(&source->client_list, &conn->snode);
@@ -167,6 +181,8 @@ static int pre_init_sensor(struct sensing_sensor *sensor)
 		sensor->dev->name, sensor->info->minimal_interval);
 
 	sensor->interval = 0;
+	sensor->next_exec_time = EXEC_TIME_OFF;
+	atomic_clear(&sensor->flag);
 	sensor->sensitivity_count = sensor_ctx->register_info->sensitivity_count;
 	__ASSERT(sensor->sensitivity_count <= CONFIG_SENSING_MAX_SENSITIVITY_COUNT,
 		 "sensitivity count:%d should not exceed MAX_SENSITIVITY_COUNT",
@@ -180,6 +196,265 @@ static int pre_init_sensor(struct sensing_sensor *sensor)
 	return 0;
 }
 
+/* smallest interval requested by the clients of a sensor, 0 if none needs it */
+static uint32_t arbitrate_interval(struct sensing_sensor *sensor)
+{
+	struct sensing_connection *conn;
+	uint32_t interval = 0;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&sensor->client_list, conn, snode) {
+		if (conn->interval != 0 && (interval == 0 || conn->interval < interval)) {
+			interval = conn->interval;
+		}
+	}
+
+	return interval;
+}
+
+/* smallest sensitivity of the clients of a sensor sampling it, 0 reporting any change */
+static uint32_t arbitrate_sensitivity(struct sensing_sensor *sensor, int index)
+{
+	struct sensing_connection *conn;
+	uint32_t sensitivity = UINT32_MAX;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&sensor->client_list, conn, snode) {
+		if (conn->interval != 0) {
+			sensitivity = MIN(sensitivity, (uint32_t)conn->sensitivity[index]);
+		}
+	}
+
+	return sensitivity == UINT32_MAX ? 0 : sensitivity;
+}
+
+/* program the merged client requirements of a sensor once */
+static void config_sensor(struct sensing_sensor *sensor)
+{
+	const struct sensing_sensor_api *sensor_api = sensor->dev->api;
+	uint32_t interval = arbitrate_interval(sensor);
+	uint32_t sensitivity;
+	int ret;
+	int i;
+
+	if (interval != sensor->interval) {
+		LOG_DBG("sensor:%s interval:%d(us) -> %d(us)", sensor->dev->name,
+			sensor->interval, interval);
+
+		if (sensor_api->set_interval) {
+			ret = sensor_api->set_interval(sensor->dev, interval);
+			if (ret) {
+				LOG_ERR("sensor:%s set interval:%d error:%d", sensor->dev->name,
+					interval, ret);
+			}
+		}
+		sensor->interval = interval;
+		/* sample right away, the clients get the first sample without waiting */
+		sensor->next_exec_time = interval ? get_us() : EXEC_TIME_OFF;
+
+		/* a virtual sensor needs its reporters at its own interval */
+		for (i = 0; i < sensor->reporter_num; i++) {
+			sensor->conns[i].interval = interval;
+			sensor->conns[i].next_consume_time = 0;
+			atomic_set_bit(&sensor->conns[i].source->flag, SENSOR_LATER_CFG_BIT);
+		}
+	}
+
+	for (i = 0; i < sensor->sensitivity_count; i++) {
+		sensitivity = arbitrate_sensitivity(sensor, i);
+		if (sensitivity == (uint32_t)sensor->sensitivity[i]) {
+			continue;
+		}
+
+		if (sensor_api->set_sensitivity) {
+			ret = sensor_api->set_sensitivity(sensor->dev, i, sensitivity);
+			if (ret) {
+				LOG_ERR("sensor:%s set sensitivity index:%d error:%d",
+					sensor->dev->name, i, ret);
+			}
+		}
+		sensor->sensitivity[i] = sensitivity;
+	}
+}
+
+static void config_sensors(struct sensing_context *ctx)
+{
+	struct sensing_sensor *sensor;
+	bool pending;
+	int i;
+
+	/* virtual sensors configure their reporters, loop until it settles down */
+	do {
+		pending = false;
+		for_each_sensor(ctx, i, sensor) {
+			if (atomic_test_and_clear_bit(&sensor->flag, SENSOR_LATER_CFG_BIT)) {
+				config_sensor(sensor);
+				pending = true;
+			}
+		}
+	} while (pending);
+}
+
+/* whether a sample changed enough since the last one the client got */
+static bool sensitivity_passed(struct sensing_sensor *sensor, struct sensing_connection *conn)
+{
+	const struct sensing_sensor_api *sensor_api = sensor->dev->api;
+	bool tested = false;
+	int i;
+
+	if (!sensor_api->sensitivity_test || conn->next_consume_time == 0) {
+		return true;
+	}
+
+	for (i = 0; i < sensor->sensitivity_count; i++) {
+		if (conn->sensitivity[i] == 0) {
+			continue;
+		}
+
+		tested = true;
+		if (sensor_api->sensitivity_test(sensor->dev, i, conn->sensitivity[i],
+						 conn->data, sensor->sample_size,
+						 sensor->data_buf, sensor->sample_size) == 0) {
+			return true;
+		}
+	}
+
+	return !tested;
+}
+
+/* fan the sample of a sensor out to the clients which are due */
+static void send_data_to_clients(struct sensing_sensor *sensor, uint64_t cur_time)
+{
+	const struct sensing_sensor_api *sink_api;
+	struct sensing_connection *conn;
+	bool passed;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&sensor->client_list, conn, snode) {
+		/* clients slower than the sensor only get some of its samples */
+		if (conn->interval == 0 || cur_time < conn->next_consume_time) {
+			continue;
+		}
+
+		passed = sensitivity_passed(sensor, conn);
+
+		if (conn->next_consume_time == 0 ||
+		    conn->next_consume_time + conn->interval <= cur_time) {
+			conn->next_consume_time = cur_time + conn->interval;
+		} else {
+			conn->next_consume_time += conn->interval;
+		}
+
+		if (!passed) {
+			continue;
+		}
+
+		memcpy(conn->data, sensor->data_buf, sensor->sample_size);
+
+		if (conn->sink == NULL) {
+			if (conn->data_evt_cb) {
+				conn->data_evt_cb(conn, conn->data);
+			}
+		} else {
+			sink_api = conn->sink->dev->api;
+			if (sink_api->process) {
+				sink_api->process(conn->sink->dev, conn - conn->sink->conns,
+						  conn->data, sensor->sample_size);
+			}
+		}
+	}
+}
+
+static int read_sensor(struct sensing_sensor *sensor, uint64_t cur_time)
+{
+	const struct sensing_sensor_api *sensor_api = sensor->dev->api;
+	int ret;
+
+	if (!sensor_api->read_sample) {
+		return -ENOTSUP;
+	}
+
+	ret = sensor_api->read_sample(sensor->dev, sensor->data_buf, sensor->sample_size);
+	if (ret) {
+		LOG_ERR("sensor:%s read sample error:%d", sensor->dev->name, ret);
+		return ret;
+	}
+
+	send_data_to_clients(sensor, cur_time);
+
+	return 0;
+}
+
+/* sample the physical sensors which are due, returns the time of the next sampling */
+static uint64_t poll_sensors(struct sensing_context *ctx)
+{
+	uint64_t next_time = EXEC_TIME_OFF;
+	struct sensing_sensor *sensor;
+	uint64_t cur_time;
+	int i;
+
+	for_each_sensor(ctx, i, sensor) {
+		if (!is_phy_sensor(sensor) || sensor->interval == 0) {
+			continue;
+		}
+
+		cur_time = get_us();
+
+		if (sensor->mode == SENSOR_TRIGGER_MODE_DATA_READY) {
+			if (atomic_test_and_clear_bit(&sensor->flag, SENSOR_DATA_READY_BIT)) {
+				read_sensor(sensor, cur_time);
+			}
+			continue;
+		}
+
+		if (cur_time >= sensor->next_exec_time) {
+			read_sensor(sensor, cur_time);
+
+			/* keep the sampling times on the interval grid, unless late by one */
+			sensor->next_exec_time += sensor->interval;
+			if (sensor->next_exec_time <= cur_time) {
+				sensor->next_exec_time = cur_time + sensor->interval;
+			}
+		}
+
+		next_time = MIN(next_time, sensor->next_exec_time);
+	}
+
+	return next_time;
+}
+
+static void sensing_runtime_thread(void *p1, void *p2, void *p3)
+{
+	struct sensing_context *ctx = p1;
+	uint64_t next_time;
+	uint64_t cur_time;
+	k_timeout_t timeout;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		k_mutex_lock(&ctx->lock, K_FOREVER);
+		config_sensors(ctx);
+		next_time = poll_sensors(ctx);
+		k_mutex_unlock(&ctx->lock);
+
+		cur_time = get_us();
+		if (next_time == EXEC_TIME_OFF) {
+			timeout = K_FOREVER;
+		} else if (next_time <= cur_time) {
+			timeout = K_NO_WAIT;
+		} else {
+			timeout = K_USEC(next_time - cur_time);
+		}
+
+		k_sem_take(&ctx->event_sem, timeout);
+	}
+}
+
+static void wakeup_runtime(struct sensing_sensor *sensor, int bit)
+{
+	atomic_set_bit(&sensor->flag, bit);
+	k_sem_give(&sensing_ctx.event_sem);
+}
+
 static int sensing_init(void)
 {
 	struct sensing_context *ctx = &sensing_ctx;
@@ -195,6 +470,9 @@ static int sensing_init(void)
 		return 0;
 	}
 
+	k_mutex_init(&ctx->lock);
+	k_sem_init(&ctx->event_sem, 0, 1);
+
 	if (ctx->sensor_num == 0) {
 		LOG_WRN("no sensor created by device tree yet");
 		return 0;
@@ -221,6 +499,13 @@ static int sensing_init(void)
 		LOG_INF("sensing init, sensor:%s state:%d", sensor->dev->name, sensor->state);
 	}
 
+	k_thread_create(&ctx->runtime_thread, runtime_stack,
+			K_KERNEL_STACK_SIZEOF(runtime_stack), sensing_runtime_thread, ctx, NULL,
+			NULL, CONFIG_SENSING_RUNTIME_THREAD_PRIORITY, 0, K_NO_WAIT);
+	k_thread_name_set(&ctx->runtime_thread, "sensing_runtime");
+
+	ctx->sensing_initialized = true;
+
 	return ret;
 }
 
@@ -240,7 +525,9 @@ int open_sensor(struct sensing_sensor *sensor, struct sensing_connection **conn)
 	tmp_conn->data = (uint8_t *)tmp_conn + sizeof(*tmp_conn);
 
 	/* create connection from sensor to application(client = NULL) */
+	k_mutex_lock(&sensing_ctx.lock, K_FOREVER);
 	init_connection(tmp_conn, sensor, NULL);
+	k_mutex_unlock(&sensing_ctx.lock);
 
 	*conn = tmp_conn;
 
@@ -258,10 +545,17 @@ int close_sensor(struct sensing_connection **conn)
 
 	__ASSERT(!tmp_conn->sink, "sensor derived from device tree cannot be closed");
 
+	k_mutex_lock(&sensing_ctx.lock, K_FOREVER);
 	sys_slist_find_and_remove(&tmp_conn->source->client_list, &tmp_conn->snode);
+	k_mutex_unlock(&sensing_ctx.lock);
+
+	/* the remaining clients may need a lower rate */
+	if (tmp_conn->interval != 0) {
+		wakeup_runtime(tmp_conn->source, SENSOR_LATER_CFG_BIT);
+	}
 
 	*conn = NULL;
-	free(*conn);
+	free(tmp_conn);
 
 	return 0;
 }
@@ -287,22 +581,122 @@ int sensing_register_callback(struct sensing_connection *conn,
 
 int set_interval(struct sensing_connection *conn, uint32_t interval)
 {
-	return -ENOTSUP;
+	if (conn == NULL) {
+		return -ENODEV;
+	}
+
+	if (interval != 0 && interval < conn->source->info->minimal_interval) {
+		LOG_ERR("interval:%d(us) below sensor:%s minimal interval:%d(us)", interval,
+			conn->source->dev->name, conn->source->info->minimal_interval);
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&sensing_ctx.lock, K_FOREVER);
+	conn->interval = interval;
+	conn->next_consume_time = 0;
+	k_mutex_unlock(&sensing_ctx.lock);
+
+	/* the runtime merges the intervals of all the clients of the sensor */
+	wakeup_runtime(conn->source, SENSOR_LATER_CFG_BIT);
+
+	return 0;
 }
 
 int get_interval(struct sensing_connection *conn, uint32_t *interval)
 {
-	return -ENOTSUP;
+	if (conn == NULL) {
+		return -ENODEV;
+	}
+
+	*interval = conn->interval;
+
+	return 0;
 }
 
 int set_sensitivity(struct sensing_connection *conn, int8_t index, uint32_t sensitivity)
 {
-	return -ENOTSUP;
+	int i;
+
+	if (conn == NULL) {
+		return -ENODEV;
+	}
+
+	if (index < -1 || index >= conn->source->sensitivity_count) {
+		LOG_ERR("sensor:%s invalid sensitivity index:%d", conn->source->dev->name,
+			index);
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&sensing_ctx.lock, K_FOREVER);
+	/* index -1 sets all the data fields */
+	for (i = 0; i < conn->source->sensitivity_count; i++) {
+		if (index == -1 || index == i) {
+			conn->sensitivity[i] = sensitivity;
+		}
+	}
+	k_mutex_unlock(&sensing_ctx.lock);
+
+	wakeup_runtime(conn->source, SENSOR_LATER_CFG_BIT);
+
+	return 0;
 }
 
 int get_sensitivity(struct sensing_connection *conn, int8_t index, uint32_t *sensitivity)
 {
-	return -ENOTSUP;
+	if (conn == NULL) {
+		return -ENODEV;
+	}
+
+	/* index -1 gets the one of the first data field */
+	if (index < -1 || index >= conn->source->sensitivity_count ||
+	    (index == -1 && conn->source->sensitivity_count == 0)) {
+		return -EINVAL;
+	}
+
+	*sensitivity = conn->sensitivity[index == -1 ? 0 : index];
+
+	return 0;
+}
+
+int post_sensor_data(struct sensing_sensor *sensor, const void *buf, int size)
+{
+	if (buf == NULL || size <= 0 || size > sensor->sample_size) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&sensing_ctx.lock, K_FOREVER);
+	memcpy(sensor->data_buf, buf, size);
+	send_data_to_clients(sensor, get_us());
+	k_mutex_unlock(&sensing_ctx.lock);
+
+	return 0;
+}
+
+int notify_sensor_data_ready(struct sensing_sensor *sensor)
+{
+	if (sensor->mode != SENSOR_TRIGGER_MODE_DATA_READY) {
+		return -EINVAL;
+	}
+
+	wakeup_runtime(sensor, SENSOR_DATA_READY_BIT);
+
+	return 0;
+}
+
+int set_sensor_data_ready(struct sensing_sensor *sensor, bool data_ready)
+{
+	if (!is_phy_sensor(sensor)) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&sensing_ctx.lock, K_FOREVER);
+	sensor->mode = data_ready ? SENSOR_TRIGGER_MODE_DATA_READY : SENSOR_TRIGGER_MODE_POLLING;
+	sensor->next_exec_time = sensor->interval ? get_us() : EXEC_TIME_OFF;
+	k_mutex_unlock(&sensing_ctx.lock);
+
+	k_sem_give(&sensing_ctx.event_sem);
+
+	return 0;
 }
 
 int sensing_get_sensors(int *sensor_nums, const struct sensing_sensor_info **info)
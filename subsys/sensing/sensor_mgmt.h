@@ -10,6 +10,7 @@
 #include <zephyr/sensing/sensing_datatypes.h>
 #include <zephyr/sensing/sensing_sensor.h>
 #include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
 #include <zephyr/sys/slist.h>
 
 #ifdef __cplusplus
@@ -62,6 +63,17 @@ enum sensor_trigger_mode {
 	SENSOR_TRIGGER_MODE_DATA_READY = 2,
 };
 
+/* sensing_sensor flag bits */
+enum {
+	/* interval or sensitivity of a client changed, to be arbitrated by the runtime */
+	SENSOR_LATER_CFG_BIT,
+	/* data ready notified by the sensor, to be read by the runtime */
+	SENSOR_DATA_READY_BIT,
+};
+
+/* next_exec_time of a sensor which is not sampled */
+#define EXEC_TIME_OFF UINT64_MAX
+
 /**
  * @struct sensing_connection information
  * @brief sensing_connection indicates connection from reporter(source) to client(sink)
@@ -74,7 +86,9 @@ struct sensing_connection {
 	int sensitivity[CONFIG_SENSING_MAX_SENSITIVITY_COUNT];
 	/* copy sensor data to connection data buf from reporter */
 	void *data;
-	/* client(sink) next consume time */
+	/* client(sink) next consume time in micro seconds, 0 before the first sample */
+	uint64_t next_consume_time;
+	/* node in the reporter(source) client_list */
 	sys_snode_t snode;
 	/* post data to application */
 	sensing_data_event_t data_evt_cb;
@@ -101,6 +115,9 @@ struct sensing_sensor {
 	enum sensing_sensor_state state;
 	enum sensor_trigger_mode mode;
 	/* runtime info */
+	atomic_t flag;
+	/* next sampling time of a polled physical sensor in micro seconds */
+	uint64_t next_exec_time;
 	uint16_t sample_size;
 	void *data_buf;
 	struct sensing_connection *conns;
@@ -115,6 +132,9 @@ int set_interval(struct sensing_connection *conn, uint32_t interval);
 int get_interval(struct sensing_connection *con, uint32_t *sensitivity);
 int set_sensitivity(struct sensing_connection *conn, int8_t index, uint32_t interval);
 int get_sensitivity(struct sensing_connection *con, int8_t index, uint32_t *sensitivity);
+int post_sensor_data(struct sensing_sensor *sensor, const void *buf, int size);
+int notify_sensor_data_ready(struct sensing_sensor *sensor);
+int set_sensor_data_ready(struct sensing_sensor *sensor, bool data_ready);
 
 
 static inline bool is_phy_sensor(struct sensing_sensor *sensor)
@@ -42,9 +42,15 @@ struct settings_nvs {
 	struct {
 		uint16_t name_hash;
 		uint16_t name_id;
+#if CONFIG_SETTINGS_NVS_NAME_CACHE_SUBTREE
+		uint16_t subtree_hash;
+#endif
 	} cache[CONFIG_SETTINGS_NVS_NAME_CACHE_SIZE];
 
 	uint16_t cache_next;
+#if CONFIG_SETTINGS_NVS_NAME_CACHE_SUBTREE
+	bool cache_complete;
+#endif
 #endif
 };
 
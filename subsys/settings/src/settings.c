@@ -24,6 +24,131 @@ sys_slist_t settings_handlers;
 
 K_MUTEX_DEFINE(settings_lock);
 
+#if defined(CONFIG_SETTINGS_HANDLER_INDEX)
+/* Hash table of the handlers by name, with linear probing. A name is looked
+ * up by hashing its successive segment prefixes, so that a lookup takes as
+ * many probes as the name has segments whatever the number of handlers.
+ */
+struct settings_handler_index_entry {
+	struct settings_handler_static *handler;
+	uint32_t hash;
+};
+
+static struct settings_handler_index_entry
+	settings_handler_index[CONFIG_SETTINGS_HANDLER_INDEX_SIZE];
+
+/* Set when a handler did not fit, lookups then search all the handlers */
+static bool settings_handler_index_full;
+
+/* FNV-1a */
+#define SETTINGS_HANDLER_HASH_INIT 2166136261U
+
+static inline uint32_t settings_handler_hash_step(uint32_t hash, char c)
+{
+	return (hash ^ (uint8_t)c) * 16777619U;
+}
+
+static void settings_handler_index_add(struct settings_handler_static *handler)
+{
+	uint32_t hash = SETTINGS_HANDLER_HASH_INIT;
+	size_t pos;
+
+	for (const char *c = handler->name; *c != '\0'; c++) {
+		hash = settings_handler_hash_step(hash, *c);
+	}
+
+	pos = hash % CONFIG_SETTINGS_HANDLER_INDEX_SIZE;
+
+	for (size_t i = 0; i < CONFIG_SETTINGS_HANDLER_INDEX_SIZE; i++) {
+		if (settings_handler_index[pos].handler == NULL) {
+			settings_handler_index[pos].handler = handler;
+			settings_handler_index[pos].hash = hash;
+			return;
+		}
+
+		pos = (pos + 1) % CONFIG_SETTINGS_HANDLER_INDEX_SIZE;
+	}
+
+	LOG_WRN("Handler index full, increase CONFIG_SETTINGS_HANDLER_INDEX_SIZE");
+	settings_handler_index_full = true;
+}
+
+/* Get the handler named by the first len characters of name */
+static struct settings_handler_static *settings_handler_index_get(const char *name,
+								  size_t len, uint32_t hash)
+{
+	struct settings_handler_index_entry *entry;
+	size_t pos = hash % CONFIG_SETTINGS_HANDLER_INDEX_SIZE;
+
+	for (size_t i = 0; i < CONFIG_SETTINGS_HANDLER_INDEX_SIZE; i++) {
+		entry = &settings_handler_index[pos];
+
+		if (entry->handler == NULL) {
+			break;
+		}
+
+		if ((entry->hash == hash) && (strncmp(entry->handler->name, name, len) == 0) &&
+		    (entry->handler->name[len] == '\0')) {
+			return entry->handler;
+		}
+
+		pos = (pos + 1) % CONFIG_SETTINGS_HANDLER_INDEX_SIZE;
+	}
+
+	return NULL;
+}
+
+/* Same result as the search of all the handlers: the handler with the longest
+ * name matching the first segments of name.
+ */
+static struct settings_handler_static *settings_handler_index_lookup(const char *name,
+								     const char **next)
+{
+	struct settings_handler_static *bestmatch = NULL;
+	struct settings_handler_static *ch;
+	uint32_t hash = SETTINGS_HANDLER_HASH_INIT;
+
+	for (const char *c = name; true; c++) {
+		if ((*c == '\0') || (*c == SETTINGS_NAME_END) ||
+		    (*c == SETTINGS_NAME_SEPARATOR)) {
+			ch = settings_handler_index_get(name, c - name, hash);
+			if (ch) {
+				bestmatch = ch;
+				if (next) {
+					*next = (*c == SETTINGS_NAME_SEPARATOR) ? c + 1 : NULL;
+				}
+			}
+
+			if (*c != SETTINGS_NAME_SEPARATOR) {
+				break;
+			}
+		}
+
+		hash = settings_handler_hash_step(hash, *c);
+	}
+
+	return bestmatch;
+}
+
+/* Handlers cannot be taken out of the table, which is built again instead */
+static void settings_handler_index_build(void)
+{
+	memset(settings_handler_index, 0, sizeof(settings_handler_index));
+	settings_handler_index_full = false;
+
+	STRUCT_SECTION_FOREACH(settings_handler_static, ch) {
+		settings_handler_index_add(ch);
+	}
+
+#if defined(CONFIG_SETTINGS_DYNAMIC_HANDLERS)
+	struct settings_handler *ch;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&settings_handlers, ch, node) {
+		settings_handler_index_add((struct settings_handler_static *)ch);
+	}
+#endif /* CONFIG_SETTINGS_DYNAMIC_HANDLERS */
+}
+#endif /* CONFIG_SETTINGS_HANDLER_INDEX */
 
 void settings_store_init(void);
 
@@ -32,6 +157,9 @@ void settings_init(void)
 #if defined(CONFIG_SETTINGS_DYNAMIC_HANDLERS)
 	sys_slist_init(&settings_handlers);
 #endif /* CONFIG_SETTINGS_DYNAMIC_HANDLERS */
+#if defined(CONFIG_SETTINGS_HANDLER_INDEX)
+	settings_handler_index_build();
+#endif /* CONFIG_SETTINGS_HANDLER_INDEX */
 	settings_store_init();
 }
 
@@ -56,11 +184,31 @@ int settings_register(struct settings_handler *handler)
 		}
 	}
 	sys_slist_append(&settings_handlers, &handler->node);
+#if defined(CONFIG_SETTINGS_HANDLER_INDEX)
+	settings_handler_index_add((struct settings_handler_static *)handler);
+#endif /* CONFIG_SETTINGS_HANDLER_INDEX */
 
 end:
 	k_mutex_unlock(&settings_lock);
 	return rc;
 }
+
+bool settings_deregister(struct settings_handler *handler)
+{
+	bool found;
+
+	k_mutex_lock(&settings_lock, K_FOREVER);
+
+	found = sys_slist_find_and_remove(&settings_handlers, &handler->node);
+#if defined(CONFIG_SETTINGS_HANDLER_INDEX)
+	if (found) {
+		settings_handler_index_build();
+	}
+#endif /* CONFIG_SETTINGS_HANDLER_INDEX */
+
+	k_mutex_unlock(&settings_lock);
+	return found;
+}
 #endif /* CONFIG_SETTINGS_DYNAMIC_HANDLERS */
 
 int settings_name_steq(const char *name, const char *key, const char **next)
@@ -145,6 +293,12 @@ struct settings_handler_static *settings_parse_and_lookup(const char *name,
 		*next = NULL;
 	}
 
+#if defined(CONFIG_SETTINGS_HANDLER_INDEX)
+	if (!settings_handler_index_full) {
+		return settings_handler_index_lookup(name, next);
+	}
+#endif /* CONFIG_SETTINGS_HANDLER_INDEX */
+
 	STRUCT_SECTION_FOREACH(settings_handler_static, ch) {
 		if (!settings_name_steq(name, ch->name, &tmpnext)) {
 			continue;
@@ -400,9 +400,16 @@ int settings_backend_init(void)
 {
 	static struct flash_sector
 		settings_fcb_area[CONFIG_SETTINGS_FCB_NUM_AREAS + 1];
+#ifdef CONFIG_FCB_SECTOR_SUMMARY
+	static struct fcb_sector_summary
+		settings_fcb_summary[CONFIG_SETTINGS_FCB_NUM_AREAS + 1];
+#endif
 	static struct settings_fcb config_init_settings_fcb = {
 		.cf_fcb.f_magic = CONFIG_SETTINGS_FCB_MAGIC,
 		.cf_fcb.f_sectors = settings_fcb_area,
+#ifdef CONFIG_FCB_SECTOR_SUMMARY
+		.cf_fcb.f_summaries = settings_fcb_summary,
+#endif
 	};
 	uint32_t cnt = sizeof(settings_fcb_area) /
 		    sizeof(settings_fcb_area[0]);
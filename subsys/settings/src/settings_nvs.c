@@ -79,6 +79,15 @@ static void settings_nvs_cache_add(struct settings_nvs *cf, const char *name,
 {
 	uint16_t name_hash = crc16_ccitt(0xffff, name, strlen(name));
 
+#if CONFIG_SETTINGS_NVS_NAME_CACHE_SUBTREE
+	/* Overwriting a name, the cache no longer holds all the names */
+	if (cf->cache[cf->cache_next].name_id > NVS_NAMECNT_ID) {
+		cf->cache_complete = false;
+	}
+
+	cf->cache[cf->cache_next].subtree_hash =
+		crc16_ccitt(0xffff, name, settings_name_next(name, NULL));
+#endif
 	cf->cache[cf->cache_next].name_hash = name_hash;
 	cf->cache[cf->cache_next++].name_id = name_id;
 
@@ -116,70 +125,137 @@ static uint16_t settings_nvs_cache_match(struct settings_nvs *cf, const char *na
 
 	return NVS_NAMECNT_ID;
 }
+
+static void settings_nvs_cache_remove(struct settings_nvs *cf, uint16_t name_id)
+{
+	for (int i = 0; i < CONFIG_SETTINGS_NVS_NAME_CACHE_SIZE; i++) {
+		if (cf->cache[i].name_id == name_id) {
+			cf->cache[i].name_id = NVS_NAMECNT_ID;
+		}
+	}
+}
 #endif /* CONFIG_SETTINGS_NVS_NAME_CACHE */
 
-static int settings_nvs_load(struct settings_store *cs,
-			     const struct settings_load_arg *arg)
+static int settings_nvs_load_one(struct settings_nvs *cf, uint16_t name_id,
+				 const struct settings_load_arg *arg, bool cache_add)
 {
-	int ret = 0;
-	struct settings_nvs *cf = CONTAINER_OF(cs, struct settings_nvs, cf_store);
 	struct settings_nvs_read_fn_arg read_fn_arg;
 	char name[SETTINGS_MAX_NAME_LEN + SETTINGS_EXTRA_LEN + 1];
 	char buf;
 	ssize_t rc1, rc2;
-	uint16_t name_id = NVS_NAMECNT_ID;
 
-	name_id = cf->last_name_id + 1;
+	/* In the NVS backend, each setting item is stored in two NVS
+	 * entries one for the setting's name and one with the
+	 * setting's value.
+	 */
+	rc1 = nvs_read(&cf->cf_nvs, name_id, &name, sizeof(name));
+	rc2 = nvs_read(&cf->cf_nvs, name_id + NVS_NAME_ID_OFFSET,
+		       &buf, sizeof(buf));
 
-	while (1) {
+	if ((rc1 <= 0) && (rc2 <= 0)) {
+		return 0;
+	}
 
-		name_id--;
-		if (name_id == NVS_NAMECNT_ID) {
-			break;
+	if ((rc1 <= 0) || (rc2 <= 0)) {
+		/* Settings item is not stored correctly in the NVS.
+		 * NVS entry for its name or value is either missing
+		 * or deleted. Clean dirty entries to make space for
+		 * future settings item.
+		 */
+		if (name_id == cf->last_name_id) {
+			cf->last_name_id--;
+			nvs_write(&cf->cf_nvs, NVS_NAMECNT_ID,
+				  &cf->last_name_id, sizeof(uint16_t));
 		}
+		nvs_delete(&cf->cf_nvs, name_id);
+		nvs_delete(&cf->cf_nvs, name_id + NVS_NAME_ID_OFFSET);
+#if CONFIG_SETTINGS_NVS_NAME_CACHE
+		settings_nvs_cache_remove(cf, name_id);
+#endif
+		return 0;
+	}
 
-		/* In the NVS backend, each setting item is stored in two NVS
-		 * entries one for the setting's name and one with the
-		 * setting's value.
-		 */
-		rc1 = nvs_read(&cf->cf_nvs, name_id, &name, sizeof(name));
-		rc2 = nvs_read(&cf->cf_nvs, name_id + NVS_NAME_ID_OFFSET,
-			       &buf, sizeof(buf));
+	/* Found a name, this might not include a trailing \0 */
+	name[rc1] = '\0';
+	read_fn_arg.fs = &cf->cf_nvs;
+	read_fn_arg.id = name_id + NVS_NAME_ID_OFFSET;
 
-		if ((rc1 <= 0) && (rc2 <= 0)) {
+#if CONFIG_SETTINGS_NVS_NAME_CACHE
+	if (cache_add) {
+		settings_nvs_cache_add(cf, name, name_id);
+	}
+#else
+	ARG_UNUSED(cache_add);
+#endif
+
+	return settings_call_set_handler(name, rc2, settings_nvs_read_fn,
+					 &read_fn_arg, (void *)arg);
+}
+
+#if CONFIG_SETTINGS_NVS_NAME_CACHE_SUBTREE
+/* The cache holds all the names, only the ones in the first segment of the
+ * subtree are read.
+ */
+static int settings_nvs_load_cached(struct settings_nvs *cf,
+				    const struct settings_load_arg *arg)
+{
+	uint16_t subtree_hash;
+	int ret;
+
+	subtree_hash = crc16_ccitt(0xffff, arg->subtree,
+				   settings_name_next(arg->subtree, NULL));
+
+	for (int i = 0; i < CONFIG_SETTINGS_NVS_NAME_CACHE_SIZE; i++) {
+		if ((cf->cache[i].name_id <= NVS_NAMECNT_ID) ||
+		    (cf->cache[i].subtree_hash != subtree_hash)) {
 			continue;
 		}
 
-		if ((rc1 <= 0) || (rc2 <= 0)) {
-			/* Settings item is not stored correctly in the NVS.
-			 * NVS entry for its name or value is either missing
-			 * or deleted. Clean dirty entries to make space for
-			 * future settings item.
-			 */
-			if (name_id == cf->last_name_id) {
-				cf->last_name_id--;
-				nvs_write(&cf->cf_nvs, NVS_NAMECNT_ID,
-					  &cf->last_name_id, sizeof(uint16_t));
-			}
-			nvs_delete(&cf->cf_nvs, name_id);
-			nvs_delete(&cf->cf_nvs, name_id + NVS_NAME_ID_OFFSET);
-			continue;
+		ret = settings_nvs_load_one(cf, cf->cache[i].name_id, arg, false);
+		if (ret) {
+			return ret;
 		}
+	}
 
-		/* Found a name, this might not include a trailing \0 */
-		name[rc1] = '\0';
-		read_fn_arg.fs = &cf->cf_nvs;
-		read_fn_arg.id = name_id + NVS_NAME_ID_OFFSET;
+	return 0;
+}
+#endif /* CONFIG_SETTINGS_NVS_NAME_CACHE_SUBTREE */
 
-#if CONFIG_SETTINGS_NVS_NAME_CACHE
-		settings_nvs_cache_add(cf, name, name_id);
+static int settings_nvs_load(struct settings_store *cs,
+			     const struct settings_load_arg *arg)
+{
+	int ret = 0;
+	struct settings_nvs *cf = CONTAINER_OF(cs, struct settings_nvs, cf_store);
+	uint16_t name_id = NVS_NAMECNT_ID;
+
+#if CONFIG_SETTINGS_NVS_NAME_CACHE_SUBTREE
+	if (cf->cache_complete && arg && arg->subtree) {
+		return settings_nvs_load_cached(cf, arg);
+	}
+
+	/* Rebuild the cache from all the names */
+	for (int i = 0; i < CONFIG_SETTINGS_NVS_NAME_CACHE_SIZE; i++) {
+		cf->cache[i].name_id = NVS_NAMECNT_ID;
+	}
+	cf->cache_next = 0;
+	cf->cache_complete = true;
 #endif
 
-		ret = settings_call_set_handler(
-			name, rc2,
-			settings_nvs_read_fn, &read_fn_arg,
-			(void *)arg);
+	name_id = cf->last_name_id + 1;
+
+	while (1) {
+
+		name_id--;
+		if (name_id == NVS_NAMECNT_ID) {
+			break;
+		}
+
+		ret = settings_nvs_load_one(cf, name_id, arg, true);
 		if (ret) {
+#if CONFIG_SETTINGS_NVS_NAME_CACHE_SUBTREE
+			/* The remaining names were not added */
+			cf->cache_complete = false;
+#endif
 			break;
 		}
 	}
@@ -277,6 +353,9 @@ found:
 			return rc;
 		}
 
+#if CONFIG_SETTINGS_NVS_NAME_CACHE
+		settings_nvs_cache_remove(cf, name_id);
+#endif
 		return 0;
 	}
 
@@ -298,6 +377,9 @@ found:
 		if (rc < 0) {
 			return rc;
 		}
+#if CONFIG_SETTINGS_NVS_NAME_CACHE
+		settings_nvs_cache_add(cf, name, write_name_id);
+#endif
 	}
 
 	/* update the last_name_id and write to flash if required*/
@@ -330,6 +412,11 @@ int settings_nvs_backend_init(struct settings_nvs *cf)
 		return rc;
 	}
 
+#if CONFIG_SETTINGS_NVS_NAME_CACHE_SUBTREE
+	/* Filled by the first load */
+	cf->cache_complete = false;
+#endif
+
 	rc = nvs_read(&cf->cf_nvs, NVS_NAMECNT_ID, &last_name_id,
 		      sizeof(last_name_id));
 	if (rc < 0) {
@@ -88,6 +88,162 @@ int settings_load_subtree_direct(
 	return 0;
 }
 
+#ifdef CONFIG_SETTINGS_TXN
+/*
+ * Values written during a transaction, each stored as a header followed by
+ * the name with its terminating '\0' and by the value. The buffer is only
+ * accessed by the thread owning the transaction, which holds settings_lock.
+ */
+struct settings_txn_hdr {
+	uint16_t name_len;
+	uint16_t val_len;
+};
+
+static uint8_t settings_txn_buf[CONFIG_SETTINGS_TXN_BUFFER_SIZE];
+static size_t settings_txn_used;
+static k_tid_t settings_txn_owner;
+
+static size_t settings_txn_rec_len(const struct settings_txn_hdr *hdr)
+{
+	return sizeof(*hdr) + hdr->name_len + 1 + hdr->val_len;
+}
+
+static void settings_txn_remove(const char *name, size_t name_len)
+{
+	struct settings_txn_hdr hdr;
+	size_t off = 0;
+	size_t len;
+
+	while (off < settings_txn_used) {
+		memcpy(&hdr, &settings_txn_buf[off], sizeof(hdr));
+		len = settings_txn_rec_len(&hdr);
+		if (hdr.name_len == name_len &&
+		    !memcmp(&settings_txn_buf[off + sizeof(hdr)], name, name_len)) {
+			memmove(&settings_txn_buf[off], &settings_txn_buf[off + len],
+				settings_txn_used - off - len);
+			settings_txn_used -= len;
+			/* A name is buffered at most once */
+			return;
+		}
+		off += len;
+	}
+}
+
+static int settings_txn_add(const char *name, const void *value, size_t val_len)
+{
+	struct settings_txn_hdr hdr;
+	size_t name_len = strlen(name);
+	size_t off;
+
+	if (name_len > UINT16_MAX || val_len > UINT16_MAX) {
+		return -EINVAL;
+	}
+
+	settings_txn_remove(name, name_len);
+
+	hdr.name_len = name_len;
+	hdr.val_len = val_len;
+	if (settings_txn_rec_len(&hdr) > sizeof(settings_txn_buf) - settings_txn_used) {
+		return -ENOMEM;
+	}
+
+	off = settings_txn_used;
+	memcpy(&settings_txn_buf[off], &hdr, sizeof(hdr));
+	off += sizeof(hdr);
+	memcpy(&settings_txn_buf[off], name, name_len + 1);
+	off += name_len + 1;
+	if (val_len) {
+		memcpy(&settings_txn_buf[off], value, val_len);
+	}
+	settings_txn_used = off + val_len;
+
+	return 0;
+}
+
+static bool settings_txn_active(void)
+{
+	return settings_txn_owner == k_current_get();
+}
+
+static void settings_txn_end(void)
+{
+	settings_txn_used = 0;
+	settings_txn_owner = NULL;
+	k_mutex_unlock(&settings_lock);
+}
+
+int settings_txn_begin(void)
+{
+	k_mutex_lock(&settings_lock, K_FOREVER);
+
+	if (settings_txn_active()) {
+		k_mutex_unlock(&settings_lock);
+		return -EALREADY;
+	}
+
+	/* settings_lock is kept locked until the end of the transaction */
+	settings_txn_owner = k_current_get();
+	settings_txn_used = 0;
+
+	return 0;
+}
+
+int settings_txn_commit(void)
+{
+	struct settings_store *cs = settings_save_dst;
+	struct settings_txn_hdr hdr;
+	const char *name;
+	size_t off = 0;
+	int rc = 0;
+	int rc2;
+
+	if (!settings_txn_active()) {
+		return -EINVAL;
+	}
+
+	if (!cs) {
+		settings_txn_end();
+		return -ENOENT;
+	}
+
+	if (settings_txn_used && cs->cs_itf->csi_save_start) {
+		cs->cs_itf->csi_save_start(cs);
+	}
+
+	while (off < settings_txn_used) {
+		memcpy(&hdr, &settings_txn_buf[off], sizeof(hdr));
+		name = (const char *)&settings_txn_buf[off + sizeof(hdr)];
+		rc2 = cs->cs_itf->csi_save(cs, name,
+					   hdr.val_len ?
+					   (const char *)&name[hdr.name_len + 1] : NULL,
+					   hdr.val_len);
+		if (!rc) {
+			rc = rc2;
+		}
+		off += settings_txn_rec_len(&hdr);
+	}
+
+	if (settings_txn_used && cs->cs_itf->csi_save_end) {
+		cs->cs_itf->csi_save_end(cs);
+	}
+
+	settings_txn_end();
+
+	return rc;
+}
+
+int settings_txn_abort(void)
+{
+	if (!settings_txn_active()) {
+		return -EINVAL;
+	}
+
+	settings_txn_end();
+
+	return 0;
+}
+#endif /* CONFIG_SETTINGS_TXN */
+
 /*
  * Append a single value to persisted config. Don't store duplicate value.
  */
@@ -103,6 +259,14 @@ int settings_save_one(const char *name, const void *value, size_t val_len)
 
 	k_mutex_lock(&settings_lock, K_FOREVER);
 
+#ifdef CONFIG_SETTINGS_TXN
+	if (settings_txn_active()) {
+		rc = settings_txn_add(name, value, val_len);
+		k_mutex_unlock(&settings_lock);
+		return rc;
+	}
+#endif
+
 	rc = cs->cs_itf->csi_save(cs, name, (char *)value, val_len);
 
 	k_mutex_unlock(&settings_lock);
@@ -135,11 +135,48 @@ static int cmd_device_pm_toggle(const struct shell *sh,
 #define PM_SHELL_CMD
 #endif /* CONFIG_PM_DEVICE_RUNTIME  */
 
+#ifdef CONFIG_PM_DEVICE_RUNTIME_STATS
+static int cmd_device_pm_stats(const struct shell *sh,
+			       size_t argc, char **argv)
+{
+	const struct device *dev;
+	struct pm_device_runtime_stats stats;
+
+	dev = device_get_binding(argv[1]);
+	if (dev == NULL) {
+		shell_error(sh, "Device unknown (%s)", argv[1]);
+		return -ENODEV;
+	}
+
+	if (pm_device_runtime_stats_get(dev, &stats) < 0) {
+		shell_error(sh, "Device (%s) does not support power management",
+			    argv[1]);
+		return -ENOTSUP;
+	}
+
+	shell_print(sh, "suspend: %u (last %u us, max %u us)",
+		    stats.suspend_count, stats.suspend_last_us,
+		    stats.suspend_max_us);
+	shell_print(sh, "resume: %u (last %u us, max %u us)",
+		    stats.resume_count, stats.resume_last_us,
+		    stats.resume_max_us);
+	shell_print(sh, "cancelled suspend: %u", stats.cancel_count);
+
+	return 0;
+}
+#define PM_STATS_SHELL_CMD SHELL_CMD_ARG(pm_stats, NULL,			\
+					 "Show device runtime PM statistics",	\
+					 cmd_device_pm_stats, 2, 0),
+#else
+#define PM_STATS_SHELL_CMD
+#endif /* CONFIG_PM_DEVICE_RUNTIME_STATS */
+
 
 
 SHELL_STATIC_SUBCMD_SET_CREATE(sub_device,
 	SHELL_CMD(list, NULL, "List configured devices", cmd_device_list),
 	PM_SHELL_CMD
+	PM_STATS_SHELL_CMD
 	SHELL_SUBCMD_SET_END /* Array terminated. */
 );
 
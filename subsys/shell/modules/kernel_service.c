@@ -15,6 +15,7 @@
 #include <zephyr/drivers/timer/system_timer.h>
 #include <zephyr/kernel.h>
 #include <kernel_internal.h>
+#include <zephyr/kernel/boot_profile.h>
 #include <stdlib.h>
 #if defined(CONFIG_SYS_HEAP_RUNTIME_STATS) && (CONFIG_HEAP_MEM_POOL_SIZE > 0)
 #include <zephyr/sys/sys_heap.h>
@@ -270,6 +271,209 @@ static int cmd_kernel_heap(const struct shell *sh,
 }
 #endif
 
+#if defined(CONFIG_WORKQUEUE_STATS) || defined(CONFIG_SCHED_THREAD_USAGE_LATENCY)
+static void shell_print_hist(const struct shell *sh, const char *label,
+			     const uint32_t *hist, size_t buckets)
+{
+	shell_fprintf(sh, SHELL_NORMAL, "\t%s:", label);
+	for (size_t i = 0; i < buckets; i++) {
+		shell_fprintf(sh, SHELL_NORMAL, " %u", hist[i]);
+	}
+	shell_fprintf(sh, SHELL_NORMAL, "\n");
+}
+#endif
+
+#if defined(CONFIG_WORKQUEUE_STATS)
+
+static void shell_workq_dump(struct k_work_q *queue, void *user_data)
+{
+	const struct shell *sh = (const struct shell *)user_data;
+	const char *tname = k_thread_name_get(k_work_queue_thread_get(queue));
+	struct k_work_queue_stats stats;
+
+	if (k_work_queue_stats_get(queue, &stats) != 0) {
+		return;
+	}
+
+	shell_print(sh, "%p %-10s", queue, tname ? tname : "NA");
+	shell_print(sh, "\tpending: %u, max. pending: %u",
+		    stats.depth, stats.max_depth);
+	shell_print_hist(sh, "latency (log2 us)", stats.latency_hist,
+			 ARRAY_SIZE(stats.latency_hist));
+	shell_print_hist(sh, "runtime (log2 us)", stats.runtime_hist,
+			 ARRAY_SIZE(stats.runtime_hist));
+
+	for (int i = 0; i < ARRAY_SIZE(stats.handlers); i++) {
+		struct k_work_handler_stats *hs = &stats.handlers[i];
+
+		if (hs->handler == NULL) {
+			break;
+		}
+
+		shell_print(sh, "\thandler %p: count: %u, avg: %u us, max: %u us",
+			    (void *)hs->handler, hs->count,
+			    (uint32_t)k_cyc_to_us_floor64(hs->total_cycles / hs->count),
+			    k_cyc_to_us_floor32(hs->max_cycles));
+	}
+
+	if (stats.other_handlers != 0U) {
+		shell_print(sh, "\tother handlers: count: %u",
+			    stats.other_handlers);
+	}
+}
+
+static int cmd_kernel_workq(const struct shell *sh,
+			    size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	shell_print(sh, "Work queues:");
+	k_work_queue_foreach(shell_workq_dump, (void *)sh);
+
+	return 0;
+}
+#endif
+
+#if defined(CONFIG_KERNEL_OBJ_STATS)
+static void shell_obj_stats_dump(const char *name,
+				 const STATS_SECT_DECL(k_obj) *counters,
+				 void *user_data)
+{
+	const struct shell *sh = (const struct shell *)user_data;
+
+	shell_print(sh, "%-16s %10" PRIu64 " %10" PRIu64 " %12" PRIu64
+		    " %10" PRIu64, name,
+		    counters->contentions, counters->pends,
+		    counters->wait_us, counters->max_wait_us);
+}
+
+static int cmd_kernel_objstats(const struct shell *sh,
+			       size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	shell_print(sh, "%-16s %10s %10s %12s %10s", "object", "contended",
+		    "pends", "wait us", "max us");
+	k_obj_stats_foreach(shell_obj_stats_dump, (void *)sh);
+
+	return 0;
+}
+#endif
+
+#if defined(CONFIG_BOOT_PROFILE)
+static const char *const init_level_names[] = {
+	"EARLY", "PRE_KERNEL_1", "PRE_KERNEL_2",
+	"POST_KERNEL", "APPLICATION", "SMP",
+};
+
+static void shell_boot_profile_dump(const struct boot_profile_span *span,
+				    void *user_data)
+{
+	const struct shell *sh = (const struct shell *)user_data;
+	uint32_t start_us = k_cyc_to_us_floor32(span->start_cycles);
+	uint32_t took_us = k_cyc_to_us_floor32(span->end_cycles -
+					       span->start_cycles);
+
+	switch (span->step) {
+	case BOOT_PROFILE_BSS_ZERO:
+		shell_print(sh, "%10u %10u  bss", start_us, took_us);
+		break;
+	case BOOT_PROFILE_DATA_COPY:
+		shell_print(sh, "%10u %10u  data", start_us, took_us);
+		break;
+	case BOOT_PROFILE_LEVEL:
+		shell_print(sh, "%10u %10u  %s", start_us, took_us,
+			    init_level_names[span->level]);
+		break;
+	case BOOT_PROFILE_INIT:
+		if (span->entry->dev != NULL) {
+			shell_print(sh, "%10u %10u    %s", start_us, took_us,
+				    span->entry->dev->name);
+		} else {
+			shell_print(sh, "%10u %10u    %p", start_us, took_us,
+				    (void *)span->entry->init_fn.sys);
+		}
+		break;
+	case BOOT_PROFILE_MAIN:
+		shell_print(sh, "%10u %10s  main", start_us, "");
+		break;
+	default:
+		break;
+	}
+}
+
+static int cmd_kernel_bootprof(const struct shell *sh,
+			       size_t argc, char **argv)
+{
+	int missed;
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	shell_print(sh, "%10s %10s  %s", "start us", "took us", "step");
+	missed = boot_profile_foreach(shell_boot_profile_dump, (void *)sh);
+	if (missed > 0) {
+		shell_print(sh, "%d boot steps not recorded", missed);
+	}
+
+	return 0;
+}
+#endif
+
+#if defined(CONFIG_SCHED_THREAD_USAGE_LATENCY) && defined(CONFIG_THREAD_MONITOR)
+static void shell_latency_print(const struct shell *sh,
+				const k_thread_runtime_stats_t *stats)
+{
+	shell_print(sh, "\tpreemptions: %u, max. latency: %u cycles",
+		    stats->preemptions, stats->peak_latency_cycles);
+	shell_print_hist(sh, "latency (log2 cycles from 2^"
+			 STRINGIFY(CONFIG_SCHED_THREAD_USAGE_LATENCY_SHIFT) ")",
+			 stats->latency_hist, ARRAY_SIZE(stats->latency_hist));
+}
+
+static void shell_latency_dump(const struct k_thread *cthread, void *user_data)
+{
+	struct k_thread *thread = (struct k_thread *)cthread;
+	const struct shell *sh = (const struct shell *)user_data;
+	const char *tname = k_thread_name_get(thread);
+	k_thread_runtime_stats_t stats;
+
+	if (k_thread_runtime_stats_get(thread, &stats) != 0) {
+		return;
+	}
+
+	shell_print(sh, "%p %-10s", thread, tname ? tname : "NA");
+	shell_latency_print(sh, &stats);
+}
+
+static int cmd_kernel_latency(const struct shell *sh,
+			      size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	shell_print(sh, "Threads:");
+#ifdef CONFIG_SMP
+	k_thread_foreach_unlocked(shell_latency_dump, (void *)sh);
+#else
+	k_thread_foreach(shell_latency_dump, (void *)sh);
+#endif
+
+#ifdef CONFIG_SCHED_THREAD_USAGE_ALL
+	k_thread_runtime_stats_t stats;
+
+	if (k_thread_runtime_stats_all_get(&stats) == 0) {
+		shell_print(sh, "System:");
+		shell_latency_print(sh, &stats);
+	}
+#endif
+
+	return 0;
+}
+#endif
+
 static int cmd_kernel_sleep(const struct shell *sh,
 			    size_t argc, char **argv)
 {
@@ -370,9 +574,23 @@ SHELL_STATIC_SUBCMD_SET_CREATE(sub_kernel,
 #endif
 #if defined(CONFIG_SYS_HEAP_RUNTIME_STATS) && (CONFIG_HEAP_MEM_POOL_SIZE > 0)
 	SHELL_CMD(heap, NULL, "System heap usage statistics.", cmd_kernel_heap),
+#endif
+#if defined(CONFIG_SCHED_THREAD_USAGE_LATENCY) && defined(CONFIG_THREAD_MONITOR)
+	SHELL_CMD(latency, NULL, "Thread scheduling latency statistics.",
+		  cmd_kernel_latency),
 #endif
 	SHELL_CMD(uptime, NULL, "Kernel uptime.", cmd_kernel_uptime),
 	SHELL_CMD(version, NULL, "Kernel version.", cmd_kernel_version),
+#if defined(CONFIG_WORKQUEUE_STATS)
+	SHELL_CMD(workq, NULL, "Work queue statistics.", cmd_kernel_workq),
+#endif
+#if defined(CONFIG_KERNEL_OBJ_STATS)
+	SHELL_CMD(objstats, NULL, "Kernel object statistics.",
+		  cmd_kernel_objstats),
+#endif
+#if defined(CONFIG_BOOT_PROFILE)
+	SHELL_CMD(bootprof, NULL, "Boot profile.", cmd_kernel_bootprof),
+#endif
 	SHELL_CMD_ARG(sleep, NULL, "ms", cmd_kernel_sleep, 2, 0),
 #if defined(CONFIG_LOG_RUNTIME_FILTERING)
 	SHELL_CMD_ARG(log-level, NULL, "<module name> <severity (0-4)>",
@@ -560,6 +560,8 @@ static int exec_cmd(const struct shell *sh, size_t argc, const char **argv,
 		/* Bring back mutex to shell thread. */
 		k_mutex_lock(&sh->ctx->wr_mtx, K_FOREVER);
 		z_flag_cmd_ctx_set(sh, false);
+		/* Output buffered while the command was running. */
+		z_transport_buffer_flush(sh);
 	}
 
 	return ret_val;
@@ -972,6 +974,7 @@ static void state_collect(const struct shell *sh)
 				z_flag_cmd_ctx_set(sh, true);
 				bypass(sh, buf, count);
 				z_flag_cmd_ctx_set(sh, false);
+				z_transport_buffer_flush(sh);
 				/* Check if bypass mode ended. */
 				if (!(volatile shell_bypass_cb_t *)sh->ctx->bypass) {
 					state_set(sh, SHELL_STATE_ACTIVE);
@@ -1510,7 +1513,11 @@ void shell_vfprintf(const struct shell *sh, enum shell_vt100_color color,
 	if (!z_flag_cmd_ctx_get(sh) && !sh->ctx->bypass && z_flag_use_vt100_get(sh)) {
 		z_shell_print_prompt_and_cmd(sh);
 	}
-	z_transport_buffer_flush(sh);
+	/* Output of a command is flushed when the buffer is full or the command returns. */
+	if (!IS_ENABLED(CONFIG_SHELL_BULK_OUTPUT) || !z_flag_cmd_ctx_get(sh) ||
+	    (k_current_get() != sh->ctx->tid)) {
+		z_transport_buffer_flush(sh);
+	}
 	k_mutex_unlock(&sh->ctx->wr_mtx);
 }
 
@@ -72,6 +72,139 @@ static int settings_direct_loader(const char *key, size_t len,
 
 #endif /* CONFIG_STREAM_FLASH_PROGRESS */
 
+#ifdef CONFIG_STREAM_FLASH_ASYNC
+
+#define STREAM_FLASH_BUFFERS CONFIG_STREAM_FLASH_ASYNC_BUFFERS
+
+static void stream_flash_write_done(const struct device *dev,
+				    struct flash_async_op *op, int result)
+{
+	struct stream_flash_ctx *ctx = op->user_data;
+	struct stream_flash_async_buf *abuf =
+		CONTAINER_OF(op, struct stream_flash_async_buf, write_op);
+
+	/* Keep the error of the erase preceding the write */
+	if (abuf->rc == 0) {
+		abuf->rc = result;
+	}
+
+	k_sem_give(&ctx->async_done);
+}
+
+#ifdef CONFIG_STREAM_FLASH_ERASE
+static void stream_flash_erase_done(const struct device *dev,
+				    struct flash_async_op *op, int result)
+{
+	struct stream_flash_async_buf *abuf =
+		CONTAINER_OF(op, struct stream_flash_async_buf, erase_op);
+
+	if (result != 0) {
+		LOG_ERR("Error %d while erasing page", result);
+		abuf->rc = result;
+	}
+}
+#endif /* CONFIG_STREAM_FLASH_ERASE */
+
+/* Wait for the oldest writes until at most max_pending buffers are being
+ * written. The writes complete in order, after a failed one all of them
+ * are waited for and none is counted as written.
+ */
+static int stream_flash_async_wait(struct stream_flash_ctx *ctx,
+				   uint8_t max_pending)
+{
+	struct stream_flash_async_buf *abuf;
+	int rc = 0;
+
+	while (ctx->async_pending > ((rc != 0) ? 0 : max_pending)) {
+		abuf = &ctx->async[(ctx->async_head + STREAM_FLASH_BUFFERS -
+				    ctx->async_pending) % STREAM_FLASH_BUFFERS];
+
+		k_sem_take(&ctx->async_done, K_FOREVER);
+		ctx->async_pending--;
+		ctx->async_bytes -= abuf->bytes;
+
+		if (rc != 0) {
+			continue;
+		}
+
+		if (abuf->rc != 0) {
+			rc = abuf->rc;
+			LOG_ERR("flash_write error %d offset=0x%08lx", rc,
+				(long)abuf->write_op.offset);
+		} else {
+			ctx->bytes_written += abuf->bytes;
+		}
+	}
+
+	return rc;
+}
+
+static int flash_sync_async(struct stream_flash_ctx *ctx, size_t write_addr,
+			    size_t len)
+{
+	struct stream_flash_async_buf *abuf = &ctx->async[ctx->async_head];
+	int rc;
+
+	abuf->rc = 0;
+	abuf->write_op = (struct flash_async_op) {
+		.type = FLASH_ASYNC_OP_WRITE,
+		.offset = write_addr,
+		.data = ctx->buf,
+		.len = len,
+		.cb = stream_flash_write_done,
+		.user_data = ctx,
+	};
+
+#ifdef CONFIG_STREAM_FLASH_ERASE
+	struct flash_pages_info page;
+
+	rc = flash_get_page_info_by_offs(ctx->fdev,
+					 write_addr + ctx->buf_bytes - 1, &page);
+	if (rc != 0) {
+		LOG_ERR("Error %d while getting page info", rc);
+		return rc;
+	}
+
+	/* The operations are executed in order, the write follows the erase */
+	if (ctx->last_erased_page_start_offset != page.start_offset) {
+		abuf->erase_op = (struct flash_async_op) {
+			.type = FLASH_ASYNC_OP_ERASE,
+			.offset = page.start_offset,
+			.len = page.size,
+			.cb = stream_flash_erase_done,
+			.user_data = ctx,
+		};
+
+		rc = flash_async_submit(ctx->fdev, &abuf->erase_op);
+		if (rc != 0) {
+			LOG_ERR("flash_async_submit error %d offset=0x%08lx", rc,
+				(long)page.start_offset);
+			return rc;
+		}
+
+		ctx->last_erased_page_start_offset = page.start_offset;
+	}
+#endif /* CONFIG_STREAM_FLASH_ERASE */
+
+	rc = flash_async_submit(ctx->fdev, &abuf->write_op);
+	if (rc != 0) {
+		LOG_ERR("flash_async_submit error %d offset=0x%08zx", rc,
+			write_addr);
+		return rc;
+	}
+
+	abuf->bytes = ctx->buf_bytes;
+	ctx->async_bytes += ctx->buf_bytes;
+	ctx->async_pending++;
+	ctx->async_head = (ctx->async_head + 1) % STREAM_FLASH_BUFFERS;
+	ctx->buf = ctx->async_base + (ctx->async_head * ctx->buf_len);
+	ctx->buf_bytes = 0U;
+
+	return 0;
+}
+
+#endif /* CONFIG_STREAM_FLASH_ASYNC */
+
 #ifdef CONFIG_STREAM_FLASH_ERASE
 
 int stream_flash_erase_page(struct stream_flash_ctx *ctx, off_t off)
@@ -79,6 +212,13 @@ int stream_flash_erase_page(struct stream_flash_ctx *ctx, off_t off)
 	int rc;
 	struct flash_pages_info page;
 
+#ifdef CONFIG_STREAM_FLASH_ASYNC
+	rc = stream_flash_async_wait(ctx, 0);
+	if (rc != 0) {
+		return rc;
+	}
+#endif
+
 	rc = flash_get_page_info_by_offs(ctx->fdev, off, &page);
 	if (rc != 0) {
 		LOG_ERR("Error %d while getting page info", rc);
@@ -104,10 +244,19 @@ int stream_flash_erase_page(struct stream_flash_ctx *ctx, off_t off)
 
 #endif /* CONFIG_STREAM_FLASH_ERASE */
 
+static inline bool stream_flash_is_async(struct stream_flash_ctx *ctx)
+{
+#ifdef CONFIG_STREAM_FLASH_ASYNC
+	return ctx->async_base != NULL;
+#else
+	return false;
+#endif
+}
+
 static int flash_sync(struct stream_flash_ctx *ctx)
 {
 	int rc = 0;
-	size_t write_addr = ctx->offset + ctx->bytes_written;
+	size_t write_addr;
 	size_t buf_bytes_aligned;
 	size_t fill_length;
 	uint8_t filler;
@@ -117,7 +266,20 @@ static int flash_sync(struct stream_flash_ctx *ctx)
 		return 0;
 	}
 
-	if (IS_ENABLED(CONFIG_STREAM_FLASH_ERASE)) {
+	write_addr = ctx->offset + ctx->bytes_written;
+
+#ifdef CONFIG_STREAM_FLASH_ASYNC
+	/* Keep a buffer free to be filled once this one is submitted */
+	rc = stream_flash_async_wait(ctx, STREAM_FLASH_BUFFERS - 2);
+	if (rc != 0) {
+		return rc;
+	}
+
+	write_addr = ctx->offset + ctx->bytes_written + ctx->async_bytes;
+#endif
+
+	/* The asynchronous writes are preceded by their own erase */
+	if (IS_ENABLED(CONFIG_STREAM_FLASH_ERASE) && !stream_flash_is_async(ctx)) {
 
 		rc = stream_flash_erase_page(ctx,
 					     write_addr + ctx->buf_bytes - 1);
@@ -139,6 +301,13 @@ static int flash_sync(struct stream_flash_ctx *ctx)
 	}
 
 	buf_bytes_aligned = ctx->buf_bytes + fill_length;
+
+#ifdef CONFIG_STREAM_FLASH_ASYNC
+	if (stream_flash_is_async(ctx)) {
+		return flash_sync_async(ctx, write_addr, buf_bytes_aligned);
+	}
+#endif
+
 	rc = flash_write(ctx->fdev, write_addr, ctx->buf, buf_bytes_aligned);
 
 	if (rc != 0) {
@@ -181,12 +350,18 @@ int stream_flash_buffered_write(struct stream_flash_ctx *ctx, const uint8_t *dat
 	int processed = 0;
 	int rc = 0;
 	int buf_empty_bytes;
+	size_t pending;
 
 	if (!ctx) {
 		return -EFAULT;
 	}
 
-	if (ctx->bytes_written + ctx->buf_bytes + len > ctx->available) {
+	pending = ctx->bytes_written + ctx->buf_bytes;
+#ifdef CONFIG_STREAM_FLASH_ASYNC
+	pending += ctx->async_bytes;
+#endif
+
+	if (pending + len > ctx->available) {
 		return -ENOMEM;
 	}
 
@@ -216,6 +391,12 @@ int stream_flash_buffered_write(struct stream_flash_ctx *ctx, const uint8_t *dat
 		rc = flash_sync(ctx);
 	}
 
+#ifdef CONFIG_STREAM_FLASH_ASYNC
+	if (flush && rc == 0) {
+		rc = stream_flash_async_wait(ctx, 0);
+	}
+#endif
+
 	return rc;
 }
 
@@ -300,6 +481,28 @@ int stream_flash_init(struct stream_flash_ctx *ctx, const struct device *fdev,
 	ctx->last_erased_page_start_offset = -1;
 #endif
 
+#ifdef CONFIG_STREAM_FLASH_ASYNC
+	ctx->async_base = NULL;
+	ctx->async_head = 0U;
+	ctx->async_pending = 0U;
+	ctx->async_bytes = 0;
+
+	/* The callback reads back into the buffer, it is not split */
+	if (!cb) {
+		size_t part_len = buf_len / STREAM_FLASH_BUFFERS;
+
+		if (part_len == 0 ||
+		    part_len % flash_get_write_block_size(fdev)) {
+			LOG_ERR("Buffer part size is not aligned to minimal write-block-size");
+			return -EFAULT;
+		}
+
+		ctx->buf_len = part_len;
+		ctx->async_base = buf;
+		k_sem_init(&ctx->async_done, 0, STREAM_FLASH_BUFFERS);
+	}
+#endif
+
 	return 0;
 }
 
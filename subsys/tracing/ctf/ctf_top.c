@@ -7,8 +7,10 @@
 #include <zephyr/kernel.h>
 #include <zephyr/kernel_structs.h>
 #include <kernel_internal.h>
+#include <zephyr/sys/byteorder.h>
 #include <ctf_top.h>
-
+#include <tracing_core.h>
+#include <tracing_buffer.h>
 
 static void _get_thread_name(struct k_thread *thread,
 			     ctf_bounded_string_t *name)
@@ -22,8 +24,158 @@ static void _get_thread_name(struct k_thread *thread,
 	}
 }
 
+#if defined(CONFIG_TRACING_CTF_COMPACT)
+/* Event ID of the extended event header, which holds the full timestamp */
+#define CTF_COMPACT_EXTENDED 0xFF
+#define CTF_COMPACT_DELTA_MAX BIT_MASK(24)
+
+#define CTF_COMPACT_THREADS CONFIG_TRACING_CTF_COMPACT_THREADS
+
+struct ctf_compact_stream {
+	/* Timestamp of the last event put to the stream */
+	uint32_t last;
+	/* Dropped packet count when the last event was put */
+	uint32_t dropped;
+	bool started;
+	/* Next entry of the thread table to replace */
+	uint8_t next;
+	struct k_thread *threads[CTF_COMPACT_THREADS];
+};
+
+#if defined(CONFIG_TRACING_BUFFER_PER_CPU)
+static struct ctf_compact_stream compact_streams[CONFIG_MP_MAX_NUM_CPUS];
+
+static inline uint8_t compact_stream_id(void)
+{
+	return arch_curr_cpu()->id;
+}
+#else
+static struct ctf_compact_stream compact_streams[1];
+
+static inline uint8_t compact_stream_id(void)
+{
+	return 0;
+}
+#endif
+
+/* Must be called with the tracing lock held */
+static void compact_event_put(const uint8_t *event, uint32_t length)
+{
+	uint8_t id = compact_stream_id();
+	struct ctf_compact_stream *stream = &compact_streams[id];
+	uint32_t now = k_cyc_to_ns_floor64(k_cycle_get_32());
+	uint32_t dropped = tracing_buffer_stream_dropped_get(id);
+	uint8_t header[6];
+	tracing_data_t data[2] = {
+		{ .data = header },
+		{ .data = (uint8_t *)&event[1], .length = length - 1 },
+	};
+
+	/* The reader only extends the truncated timestamp correctly if it
+	 * decoded the previous event of the stream and less than the range
+	 * of the truncated timestamp passed since.
+	 */
+	if (!stream->started || dropped != stream->dropped ||
+	    (now - stream->last) > CTF_COMPACT_DELTA_MAX) {
+		header[0] = CTF_COMPACT_EXTENDED;
+		header[1] = event[0];
+		sys_put_le32(now, &header[2]);
+		data[0].length = 6;
+	} else {
+		header[0] = event[0];
+		sys_put_le24(now, &header[1]);
+		data[0].length = 4;
+	}
+
+	stream->last = now;
+	stream->dropped = dropped;
+	stream->started = true;
+
+	tracing_format_data(data, ARRAY_SIZE(data));
+}
+
+void ctf_compact_event_emit(const uint8_t *event, uint32_t length)
+{
+	if (!is_tracing_enabled() || is_tracing_thread()) {
+		return;
+	}
+
+	TRACING_LOCK();
+	compact_event_put(event, length);
+	TRACING_UNLOCK();
+}
+
+/* Must be called with the tracing lock held */
+static uint8_t compact_thread_index(struct k_thread *thread)
+{
+	struct ctf_compact_stream *stream = &compact_streams[compact_stream_id()];
+	uint32_t thread_id = (uint32_t)(uintptr_t)thread;
+	ctf_bounded_string_t name = { "unknown" };
+	uint8_t event[2 + sizeof(thread_id) + sizeof(name)];
+	uint8_t index;
+
+	for (index = 0; index < CTF_COMPACT_THREADS; index++) {
+		if (stream->threads[index] == thread) {
+			return index;
+		}
+	}
+
+	index = stream->next;
+	stream->next = (index + 1) % CTF_COMPACT_THREADS;
+	stream->threads[index] = thread;
+
+	_get_thread_name(thread, &name);
+	event[0] = CTF_EVENT_THREAD_INTERN;
+	event[1] = index;
+	memcpy(&event[2], &thread_id, sizeof(thread_id));
+	memcpy(&event[2 + sizeof(thread_id)], &name, sizeof(name));
+	compact_event_put(event, sizeof(event));
+
+	return index;
+}
+
+static void compact_thread_switched(uint8_t id, struct k_thread *thread)
+{
+	uint8_t event[2] = { id };
+
+	if (!is_tracing_enabled() || is_tracing_thread()) {
+		return;
+	}
+
+	TRACING_LOCK();
+	event[1] = compact_thread_index(thread);
+	compact_event_put(event, sizeof(event));
+	TRACING_UNLOCK();
+}
+
+/* Drop a thread from the tables so that it is interned again with its
+ * current name, or as a new thread reusing the same object.
+ */
+static void compact_thread_forget(struct k_thread *thread)
+{
+	TRACING_LOCK();
+	for (size_t s = 0; s < ARRAY_SIZE(compact_streams); s++) {
+		for (size_t i = 0; i < CTF_COMPACT_THREADS; i++) {
+			if (compact_streams[s].threads[i] == thread) {
+				compact_streams[s].threads[i] = NULL;
+			}
+		}
+	}
+	TRACING_UNLOCK();
+}
+#else
+static inline void compact_thread_forget(struct k_thread *thread)
+{
+	ARG_UNUSED(thread);
+}
+#endif /* CONFIG_TRACING_CTF_COMPACT */
+
 void sys_trace_k_thread_switched_out(void)
 {
+#if defined(CONFIG_TRACING_CTF_COMPACT)
+	compact_thread_switched(CTF_EVENT_THREAD_SWITCHED_OUT_COMPACT,
+				z_current_get());
+#else
 	ctf_bounded_string_t name = { "unknown" };
 	struct k_thread *thread;
 
@@ -31,10 +183,15 @@ void sys_trace_k_thread_switched_out(void)
 	_get_thread_name(thread, &name);
 
 	ctf_top_thread_switched_out((uint32_t)(uintptr_t)thread, name);
+#endif
 }
 
 void sys_trace_k_thread_switched_in(void)
 {
+#if defined(CONFIG_TRACING_CTF_COMPACT)
+	compact_thread_switched(CTF_EVENT_THREAD_SWITCHED_IN_COMPACT,
+				z_current_get());
+#else
 	struct k_thread *thread;
 	ctf_bounded_string_t name = { "unknown" };
 
@@ -42,6 +199,7 @@ void sys_trace_k_thread_switched_in(void)
 	_get_thread_name(thread, &name);
 
 	ctf_top_thread_switched_in((uint32_t)(uintptr_t)thread, name);
+#endif
 }
 
 void sys_trace_k_thread_priority_set(struct k_thread *thread)
@@ -57,6 +215,7 @@ void sys_trace_k_thread_create(struct k_thread *thread, size_t stack_size, int p
 {
 	ctf_bounded_string_t name = { "unknown" };
 
+	compact_thread_forget(thread);
 	_get_thread_name(thread, &name);
 	ctf_top_thread_create(
 		(uint32_t)(uintptr_t)thread,
@@ -78,6 +237,7 @@ void sys_trace_k_thread_abort(struct k_thread *thread)
 {
 	ctf_bounded_string_t name = { "unknown" };
 
+	compact_thread_forget(thread);
 	_get_thread_name(thread, &name);
 	ctf_top_thread_abort((uint32_t)(uintptr_t)thread, name);
 }
@@ -140,6 +300,7 @@ void sys_trace_k_thread_name_set(struct k_thread *thread, int ret)
 {
 	ctf_bounded_string_t name = { "unknown" };
 
+	compact_thread_forget(thread);
 	_get_thread_name(thread, &name);
 	ctf_top_thread_name_set(
 		(uint32_t)(uintptr_t)thread,
@@ -319,3 +480,33 @@ void sys_trace_k_timer_status_sync_exit(struct k_timer *timer, uint32_t result)
 		result
 		);
 }
+
+#if defined(CONFIG_TRACING_BUFFER_PER_CPU)
+#define CTF_PACKET_MAGIC 0xC1FC1FC1U
+
+/* Packet header and context of the per CPU streams, keep in sync with
+ * tsdl/per_cpu_streams.
+ */
+struct ctf_packet_header {
+	uint32_t magic;
+	uint32_t content_size;
+	uint32_t packet_size;
+	uint32_t events_discarded;
+	uint8_t cpu_id;
+} __packed;
+
+void tracing_stream_header_handle(uint8_t stream, uint32_t length,
+				  uint32_t dropped)
+{
+	uint32_t size = (sizeof(struct ctf_packet_header) + length) * 8U;
+	struct ctf_packet_header hdr = {
+		.magic = CTF_PACKET_MAGIC,
+		.content_size = size,
+		.packet_size = size,
+		.events_discarded = dropped,
+		.cpu_id = stream,
+	};
+
+	tracing_buffer_handle((uint8_t *)&hdr, sizeof(hdr));
+}
+#endif
@@ -41,7 +41,22 @@
 		tracing_format_raw_data(epacket, sizeof(epacket));              \
 	}
 
-#ifdef CONFIG_TRACING_CTF_TIMESTAMP
+#if defined(CONFIG_TRACING_CTF_COMPACT)
+/*
+ * Emit an event-packet starting with the event ID, the compact event
+ * header is prepended in place of the ID.
+ */
+void ctf_compact_event_emit(const uint8_t *event, uint32_t length);
+
+#define CTF_EVENT(...)                                                          \
+	{                                                                       \
+		uint8_t epacket[0 MAP(CTF_INTERNAL_FIELD_SIZE, ##__VA_ARGS__)]; \
+		uint8_t *epacket_cursor = &epacket[0];                          \
+										\
+		MAP(CTF_INTERNAL_FIELD_APPEND, ##__VA_ARGS__)                   \
+		ctf_compact_event_emit(epacket, sizeof(epacket));               \
+	}
+#elif defined(CONFIG_TRACING_CTF_TIMESTAMP)
 #define CTF_EVENT(...)                                                         \
 	{                                                                      \
 		const uint32_t tstamp = k_cyc_to_ns_floor64(k_cycle_get_32()); \
@@ -102,7 +117,10 @@ typedef enum {
 	CTF_EVENT_TIMER_STOP = 0x30,
 	CTF_EVENT_TIMER_STATUS_SYNC_ENTER = 0x31,
 	CTF_EVENT_TIMER_STATUS_SYNC_BLOCKING = 0x32,
-	CTF_EVENT_TIMER_STATUS_SYNC_EXIT = 0x33
+	CTF_EVENT_TIMER_STATUS_SYNC_EXIT = 0x33,
+	CTF_EVENT_THREAD_INTERN = 0x34,
+	CTF_EVENT_THREAD_SWITCHED_OUT_COMPACT = 0x35,
+	CTF_EVENT_THREAD_SWITCHED_IN_COMPACT = 0x36
 
 } ctf_event_t;
 
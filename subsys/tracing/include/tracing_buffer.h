@@ -104,6 +104,66 @@ int tracing_buffer_get_finish(uint32_t size);
  */
 uint32_t tracing_buffer_get(uint8_t *data, uint32_t size);
 
+/**
+ * @brief Get number of tracing streams.
+ *
+ * There is a stream per CPU if CONFIG_TRACING_BUFFER_PER_CPU is enabled,
+ * otherwise a single one. Put operations write to the stream of the current
+ * CPU and must be called with interrupts locked. Get operations without
+ * stream parameter only access the first stream.
+ *
+ * @return Number of streams.
+ */
+uint8_t tracing_buffer_stream_count(void);
+
+/**
+ * @brief Tracing stream is empty or not.
+ *
+ * @param stream Stream index.
+ *
+ * @return true if the stream is empty, or false if not.
+ */
+bool tracing_buffer_stream_is_empty(uint8_t stream);
+
+/**
+ * @brief Get address of the first valid data in a tracing stream.
+ *
+ * @param stream Stream index.
+ * @param data Pointer to the address. It's set to a location pointing to
+ *             the first valid data within the stream.
+ * @param size Requested buffer size (in bytes).
+ *
+ * @return Size of valid buffer which can be smaller than requested
+ *         if there isn't enough valid data or buffer wraps.
+ */
+uint32_t tracing_buffer_stream_get_claim(uint8_t stream, uint8_t **data,
+					 uint32_t size);
+
+/**
+ * @brief Indicate number of bytes read from claimed buffer of a stream.
+ *
+ * @param stream Stream index.
+ * @param size Number of bytes read from claimed buffer.
+ *
+ * @retval 0 Successful operation.
+ * @retval -EINVAL Given @a size exceeds available data of the stream.
+ */
+int tracing_buffer_stream_get_finish(uint8_t stream, uint32_t size);
+
+/**
+ * @brief Count a packet dropped by the current CPU.
+ */
+void tracing_buffer_drop_handle(void);
+
+/**
+ * @brief Get number of packets dropped from a stream.
+ *
+ * @param stream Stream index.
+ *
+ * @return Number of dropped packets since initialization.
+ */
+uint32_t tracing_buffer_stream_dropped_get(uint8_t stream);
+
 /**
  * @brief Get buffer from tracing command buffer.
  *
@@ -14,9 +14,16 @@
 extern "C" {
 #endif
 
+#if defined(CONFIG_TRACING_BUFFER_PER_CPU)
+/* Each CPU writes to its own stream so only local interrupts are locked. */
+#define TRACING_LOCK()		{ unsigned int key; key = arch_irq_lock()
+
+#define TRACING_UNLOCK()	{ arch_irq_unlock(key); } }
+#else
 #define TRACING_LOCK()		{ int key; key = irq_lock()
 
 #define TRACING_UNLOCK()	{ irq_unlock(key); } }
+#endif
 
 /**
  * @brief Check tracing enabled or not.
@@ -38,6 +45,21 @@ void tracing_buffer_handle(uint8_t *data, uint32_t length);
  */
 void tracing_packet_drop_handle(void);
 
+/**
+ * @brief Output the header of a packet of stream data.
+ *
+ * Called by the tracing thread before the data drained from a stream when
+ * CONFIG_TRACING_BUFFER_PER_CPU is enabled. The data always contains whole
+ * packets. Formats which need to identify the stream provide it, the
+ * default implementation outputs nothing.
+ *
+ * @param stream Stream index, which is the CPU which produced the data.
+ * @param length Length of the data following the header.
+ * @param dropped Number of packets dropped from the stream so far.
+ */
+void tracing_stream_header_handle(uint8_t stream, uint32_t length,
+				  uint32_t dropped);
+
 /**
  * @brief Handle tracing command.
  *
@@ -4,66 +4,128 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
 #include <zephyr/sys/ring_buffer.h>
+#include <tracing_buffer.h>
 
-static struct ring_buf tracing_ring_buf;
-static uint8_t tracing_buffer[CONFIG_TRACING_BUFFER_SIZE + 1];
+#if defined(CONFIG_TRACING_BUFFER_PER_CPU)
+#define TRACING_STREAMS CONFIG_MP_MAX_NUM_CPUS
+#else
+#define TRACING_STREAMS 1
+#endif
+
+/* With CONFIG_TRACING_BUFFER_PER_CPU there is one ring buffer per CPU. Each
+ * one is written only by its CPU, with local interrupts locked, and read only
+ * by the tracing thread so no lock is shared between the CPUs.
+ */
+static struct ring_buf tracing_ring_buf[TRACING_STREAMS];
+static uint8_t tracing_buffer[TRACING_STREAMS][CONFIG_TRACING_BUFFER_SIZE + 1];
+static atomic_t tracing_dropped[TRACING_STREAMS];
 static uint8_t tracing_cmd_buffer[CONFIG_TRACING_CMD_BUFFER_SIZE];
 
-uint32_t tracing_cmd_buffer_alloc(uint8_t **data)
+/* Ring buffer written by the current CPU, must be called with interrupts
+ * locked.
+ */
+static inline struct ring_buf *put_ring_buf(void)
 {
-	*data = &tracing_cmd_buffer[0];
-
-	return sizeof(tracing_cmd_buffer);
+#if defined(CONFIG_TRACING_BUFFER_PER_CPU)
+	return &tracing_ring_buf[arch_curr_cpu()->id];
+#else
+	return &tracing_ring_buf[0];
+#endif
 }
 
 uint32_t tracing_buffer_put_claim(uint8_t **data, uint32_t size)
 {
-	return ring_buf_put_claim(&tracing_ring_buf, data, size);
+	return ring_buf_put_claim(put_ring_buf(), data, size);
 }
 
 int tracing_buffer_put_finish(uint32_t size)
 {
-	return ring_buf_put_finish(&tracing_ring_buf, size);
+	return ring_buf_put_finish(put_ring_buf(), size);
 }
 
 uint32_t tracing_buffer_put(uint8_t *data, uint32_t size)
 {
-	return ring_buf_put(&tracing_ring_buf, data, size);
+	return ring_buf_put(put_ring_buf(), data, size);
 }
 
 uint32_t tracing_buffer_get_claim(uint8_t **data, uint32_t size)
 {
-	return ring_buf_get_claim(&tracing_ring_buf, data, size);
+	return ring_buf_get_claim(&tracing_ring_buf[0], data, size);
 }
 
 int tracing_buffer_get_finish(uint32_t size)
 {
-	return ring_buf_get_finish(&tracing_ring_buf, size);
+	return ring_buf_get_finish(&tracing_ring_buf[0], size);
 }
 
 uint32_t tracing_buffer_get(uint8_t *data, uint32_t size)
 {
-	return ring_buf_get(&tracing_ring_buf, data, size);
+	return ring_buf_get(&tracing_ring_buf[0], data, size);
 }
 
 void tracing_buffer_init(void)
 {
-	ring_buf_init(&tracing_ring_buf,
-		      sizeof(tracing_buffer), tracing_buffer);
+	for (int i = 0; i < TRACING_STREAMS; i++) {
+		ring_buf_init(&tracing_ring_buf[i],
+			      sizeof(tracing_buffer[i]), tracing_buffer[i]);
+		atomic_clear(&tracing_dropped[i]);
+	}
 }
 
 bool tracing_buffer_is_empty(void)
 {
-	return ring_buf_is_empty(&tracing_ring_buf);
+	for (int i = 0; i < TRACING_STREAMS; i++) {
+		if (!ring_buf_is_empty(&tracing_ring_buf[i])) {
+			return false;
+		}
+	}
+
+	return true;
 }
 
 uint32_t tracing_buffer_capacity_get(void)
 {
-	return ring_buf_capacity_get(&tracing_ring_buf);
+	return ring_buf_capacity_get(&tracing_ring_buf[0]);
 }
 
 uint32_t tracing_buffer_space_get(void)
 {
-	return ring_buf_space_get(&tracing_ring_buf);
+	return ring_buf_space_get(put_ring_buf());
+}
+
+uint8_t tracing_buffer_stream_count(void)
+{
+	return TRACING_STREAMS;
+}
+
+bool tracing_buffer_stream_is_empty(uint8_t stream)
+{
+	return ring_buf_is_empty(&tracing_ring_buf[stream]);
+}
+
+uint32_t tracing_buffer_stream_get_claim(uint8_t stream, uint8_t **data,
+					 uint32_t size)
+{
+	return ring_buf_get_claim(&tracing_ring_buf[stream], data, size);
+}
+
+int tracing_buffer_stream_get_finish(uint8_t stream, uint32_t size)
+{
+	return ring_buf_get_finish(&tracing_ring_buf[stream], size);
+}
+
+void tracing_buffer_drop_handle(void)
+{
+	unsigned int key = arch_irq_lock();
+
+	atomic_inc(&tracing_dropped[put_ring_buf() - tracing_ring_buf]);
+	arch_irq_unlock(key);
+}
+
+uint32_t tracing_buffer_stream_dropped_get(uint8_t stream)
+{
+	return (uint32_t)atomic_get(&tracing_dropped[stream]);
 }
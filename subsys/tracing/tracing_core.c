@@ -52,6 +52,28 @@ static K_SEM_DEFINE(tracing_thread_sem, 0, 1);
 static K_THREAD_STACK_DEFINE(tracing_thread_stack,
 			CONFIG_TRACING_THREAD_STACK_SIZE);
 
+/* Drain all the data of a stream as one packet. The data may wrap in the
+ * ring buffer so it is claimed in two parts, which splits no event since
+ * events are always put as a whole.
+ */
+static void tracing_stream_drain(uint8_t stream, uint32_t max_length)
+{
+	uint8_t *buf[2];
+	uint32_t length[2];
+
+	length[0] = tracing_buffer_stream_get_claim(stream, &buf[0], max_length);
+	length[1] = tracing_buffer_stream_get_claim(stream, &buf[1], max_length);
+
+	tracing_stream_header_handle(stream, length[0] + length[1],
+				     tracing_buffer_stream_dropped_get(stream));
+	tracing_buffer_handle(buf[0], length[0]);
+	if (length[1] != 0) {
+		tracing_buffer_handle(buf[1], length[1]);
+	}
+
+	tracing_buffer_stream_get_finish(stream, length[0] + length[1]);
+}
+
 static void tracing_thread_func(void *dummy1, void *dummy2, void *dummy3)
 {
 	uint8_t *transferring_buf;
@@ -64,6 +86,12 @@ static void tracing_thread_func(void *dummy1, void *dummy2, void *dummy3)
 	while (true) {
 		if (tracing_buffer_is_empty()) {
 			k_sem_take(&tracing_thread_sem, K_FOREVER);
+		} else if (IS_ENABLED(CONFIG_TRACING_BUFFER_PER_CPU)) {
+			for (uint8_t i = 0; i < tracing_buffer_stream_count(); i++) {
+				if (!tracing_buffer_stream_is_empty(i)) {
+					tracing_stream_drain(i, tracing_buffer_max_length);
+				}
+			}
 		} else {
 			transferring_length =
 				tracing_buffer_get_claim(
@@ -157,4 +185,13 @@ void tracing_buffer_handle(uint8_t *data, uint32_t length)
 void tracing_packet_drop_handle(void)
 {
 	atomic_inc(&tracing_packet_drop_num);
+	tracing_buffer_drop_handle();
+}
+
+__weak void tracing_stream_header_handle(uint8_t stream, uint32_t length,
+					 uint32_t dropped)
+{
+	ARG_UNUSED(stream);
+	ARG_UNUSED(length);
+	ARG_UNUSED(dropped);
 }
@@ -18,11 +18,16 @@
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(usbd_cdc_acm, CONFIG_USBD_CDC_ACM_LOG_LEVEL);
 
+#define CDC_ACM_BUF_SIZE		512
+
 /*
- * FIXME: buffer count per device.
+ * Each instance keeps CONFIG_USBD_CDC_ACM_RX_REQUESTS bulk OUT requests
+ * in flight, plus one bulk IN request.
  */
 NET_BUF_POOL_FIXED_DEFINE(cdc_acm_ep_pool,
-			  2, 512,
+			  DT_NUM_INST_STATUS_OKAY(zephyr_cdc_acm_uart) *
+			  (CONFIG_USBD_CDC_ACM_RX_REQUESTS + 1),
+			  CDC_ACM_BUF_SIZE,
 			  sizeof(struct udc_buf_info), NULL);
 
 #define CDC_ACM_DEFAULT_LINECODING	{sys_cpu_to_le32(115200), 0, 0, 8}
@@ -34,8 +39,7 @@ NET_BUF_POOL_FIXED_DEFINE(cdc_acm_ep_pool,
 #define CDC_ACM_CLASS_SUSPENDED		1
 #define CDC_ACM_IRQ_RX_ENABLED		2
 #define CDC_ACM_IRQ_TX_ENABLED		3
-#define CDC_ACM_RX_FIFO_BUSY		4
-#define CDC_ACM_LOCK			5
+#define CDC_ACM_LOCK			4
 
 static struct k_work_q cdc_acm_work_q;
 static K_KERNEL_STACK_DEFINE(cdc_acm_stack,
@@ -74,6 +78,8 @@ struct cdc_acm_uart_data {
 	struct k_work tx_fifo_work;
 	/* USBD CDC ACM RX fifo work */
 	struct k_work rx_fifo_work;
+	/* Number of bulk OUT requests in flight */
+	atomic_t rx_pending;
 	atomic_t state;
 	struct k_sem notif_sem;
 };
@@ -170,7 +176,7 @@ static int usbd_cdc_acm_request(struct usbd_class_node *const c_nd,
 		}
 
 		if (bi->ep == cdc_acm_get_bulk_out(c_nd)) {
-			atomic_clear_bit(&data->state, CDC_ACM_RX_FIFO_BUSY);
+			atomic_dec(&data->rx_pending);
 		}
 
 		goto ep_request_error;
@@ -186,7 +192,8 @@ static int usbd_cdc_acm_request(struct usbd_class_node *const c_nd,
 			cdc_acm_work_submit(&data->irq_cb_work);
 		}
 
-		atomic_clear_bit(&data->state, CDC_ACM_RX_FIFO_BUSY);
+		/* Re-arm, after the data is in the FIFO to account its space */
+		atomic_dec(&data->rx_pending);
 		cdc_acm_work_submit(&data->rx_fifo_work);
 	}
 
@@ -504,6 +511,7 @@ static void cdc_acm_rx_fifo_handler(struct k_work *work)
 	struct cdc_acm_uart_data *data;
 	struct usbd_class_node *c_nd;
 	struct net_buf *buf;
+	atomic_val_t pending;
 	uint8_t ep;
 	int ret;
 
@@ -516,26 +524,35 @@ static void cdc_acm_rx_fifo_handler(struct k_work *work)
 		return;
 	}
 
-	if (ring_buf_space_get(data->rx_fifo.rb) < cdc_acm_get_bulk_mps(c_nd)) {
-		LOG_INF("RX buffer to small, throttle");
-		return;
-	}
+	ep = cdc_acm_get_bulk_out(c_nd);
 
-	if (atomic_test_and_set_bit(&data->state, CDC_ACM_RX_FIFO_BUSY)) {
-		LOG_WRN("RX transfer already in progress");
-		return;
-	}
+	/*
+	 * Keep the requests queued back to back, so the endpoint does not
+	 * idle between a completion and the next request. A request is only
+	 * added when the FIFO has room for the ones in flight, each of them
+	 * may fill a whole buffer.
+	 */
+	while ((pending = atomic_get(&data->rx_pending)) <
+	       CONFIG_USBD_CDC_ACM_RX_REQUESTS) {
+		if (ring_buf_space_get(data->rx_fifo.rb) <
+		    pending * CDC_ACM_BUF_SIZE + cdc_acm_get_bulk_mps(c_nd)) {
+			LOG_INF("RX buffer to small, throttle");
+			return;
+		}
 
-	ep = cdc_acm_get_bulk_out(c_nd);
-	buf = cdc_acm_buf_alloc(ep);
-	if (buf == NULL) {
-		return;
-	}
+		buf = cdc_acm_buf_alloc(ep);
+		if (buf == NULL) {
+			return;
+		}
 
-	ret = usbd_ep_enqueue(c_nd, buf);
-	if (ret) {
-		LOG_ERR("Failed to enqueue net_buf for 0x%02x", ep);
-		net_buf_unref(buf);
+		atomic_inc(&data->rx_pending);
+		ret = usbd_ep_enqueue(c_nd, buf);
+		if (ret) {
+			LOG_ERR("Failed to enqueue net_buf for 0x%02x", ep);
+			atomic_dec(&data->rx_pending);
+			net_buf_unref(buf);
+			return;
+		}
 	}
 }
 
@@ -570,7 +587,7 @@ static void cdc_acm_irq_rx_enable(const struct device *dev)
 		cdc_acm_work_submit(&data->irq_cb_work);
 	}
 
-	if (!atomic_test_bit(&data->state, CDC_ACM_RX_FIFO_BUSY)) {
+	if (atomic_get(&data->rx_pending) < CONFIG_USBD_CDC_ACM_RX_REQUESTS) {
 		LOG_INF("rx_en: trigger rx_fifo_work");
 		cdc_acm_work_submit(&data->rx_fifo_work);
 	}
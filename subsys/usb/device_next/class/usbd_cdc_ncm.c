@@ -0,0 +1,1186 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#define DT_DRV_COMPAT zephyr_cdc_ncm_ethernet
+
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/net/ethernet.h>
+#include <zephyr/sys/byteorder.h>
+
+#include <eth.h>
+
+#include <zephyr/usb/usbd.h>
+#include <zephyr/usb/usb_ch9.h>
+#include <zephyr/usb/class/usb_cdc.h>
+#include <zephyr/drivers/usb/udc.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(cdc_ncm, CONFIG_USBD_CDC_NCM_LOG_LEVEL);
+
+#define CDC_NCM_EP_MPS_BULK		0
+#define CDC_NCM_EP_MPS_INT		16
+#define CDC_NCM_EP_INTERVAL_INT		0x0A
+
+/* Number of OUT transfers queued, one is received while the other is parsed */
+#define CDC_NCM_OUT_REQUESTS		2
+
+/* NCM10.pdf, 3.2.1 NTH16 and 3.3.1 NDP16 */
+#define NTH16_SIGNATURE			0x484D434E
+#define NDP16_SIGNATURE_NCM0		0x304D434E
+
+/* Datagrams and the NDP start on 4 byte boundaries in the NTBs sent */
+#define CDC_NCM_ALIGNMENT		4
+
+/* Only 16-bit NTBs are supported */
+#define CDC_NCM_NTB16_FORMAT		0x0001
+
+enum {
+	CDC_NCM_IFACE_UP,
+	CDC_NCM_CLASS_ENABLED,
+	CDC_NCM_CLASS_SUSPENDED,
+	CDC_NCM_NOTIFY_PENDING,
+};
+
+/* Packet filter used until the host sets one, NCM10.pdf, 6.2.4 */
+#define CDC_NCM_PACKET_FILTER_DEFAULT	(PACKET_TYPE_DIRECTED |			\
+					 PACKET_TYPE_BROADCAST |		\
+					 PACKET_TYPE_ALL_MULTICAST)
+
+/*
+ * Each instance has two IN transfers, one sent while the frames to send are
+ * gathered into the other one, and CDC_NCM_OUT_REQUESTS OUT transfers.
+ */
+NET_BUF_POOL_FIXED_DEFINE(cdc_ncm_in_pool,
+			  DT_NUM_INST_STATUS_OKAY(DT_DRV_COMPAT) * 2,
+			  CONFIG_USBD_CDC_NCM_NTB_IN_SIZE,
+			  sizeof(struct udc_buf_info), NULL);
+
+NET_BUF_POOL_FIXED_DEFINE(cdc_ncm_out_pool,
+			  DT_NUM_INST_STATUS_OKAY(DT_DRV_COMPAT) *
+			  CDC_NCM_OUT_REQUESTS,
+			  CONFIG_USBD_CDC_NCM_NTB_OUT_SIZE,
+			  sizeof(struct udc_buf_info), NULL);
+
+struct nth16 {
+	uint32_t dwSignature;
+	uint16_t wHeaderLength;
+	uint16_t wSequence;
+	uint16_t wBlockLength;
+	uint16_t wNdpIndex;
+} __packed;
+
+struct ndp16_datagram {
+	uint16_t wDatagramIndex;
+	uint16_t wDatagramLength;
+} __packed;
+
+struct ndp16 {
+	uint32_t dwSignature;
+	uint16_t wLength;
+	uint16_t wNextNdpIndex;
+} __packed;
+
+/* NCM10.pdf, 6.2.1 GetNtbParameters */
+struct ntb_parameters {
+	uint16_t wLength;
+	uint16_t bmNtbFormatsSupported;
+	uint32_t dwNtbInMaxSize;
+	uint16_t wNdpInDivisor;
+	uint16_t wNdpInPayloadRemainder;
+	uint16_t wNdpInAlignment;
+	uint16_t wReserved;
+	uint32_t dwNtbOutMaxSize;
+	uint16_t wNdpOutDivisor;
+	uint16_t wNdpOutPayloadRemainder;
+	uint16_t wNdpOutAlignment;
+	uint16_t wNtbOutMaxDatagrams;
+} __packed;
+
+struct cdc_ncm_notification {
+	union {
+		uint8_t bmRequestType;
+		struct usb_req_type_field RequestType;
+	};
+	uint8_t bNotificationType;
+	uint16_t wValue;
+	uint16_t wIndex;
+	uint16_t wLength;
+} __packed;
+
+struct cdc_ncm_eth_data {
+	struct usbd_class_node *c_nd;
+	struct usbd_desc_node *const mac_desc_nd;
+
+	struct net_if *iface;
+	uint8_t mac_addr[6];
+
+	struct k_sem notif_sem;
+	atomic_t state;
+	/* Frames passed to the host, as set by SetEthernetPacketFilter */
+	uint16_t packet_filter;
+	/* Number of OUT transfers queued */
+	atomic_t out_queued;
+
+	/* Protects the fields below, which describe the NTBs sent */
+	struct k_mutex tx_mutex;
+	/* Given when an NTB has been sent */
+	struct k_sem tx_sem;
+	/* NTB the frames to send are gathered into */
+	struct net_buf *tx_ntb;
+	/* An NTB is being sent */
+	bool tx_busy;
+	uint16_t tx_sequence;
+	/* Maximum size of the NTBs, as set by the host */
+	uint32_t tx_max_size;
+	uint8_t tx_count;
+	struct ndp16_datagram tx_datagrams[CONFIG_USBD_CDC_NCM_MAX_DATAGRAMS];
+};
+
+struct usbd_cdc_ncm_desc {
+	struct usb_association_descriptor iad;
+
+	struct usb_if_descriptor if0;
+	struct cdc_header_descriptor if0_header;
+	struct cdc_union_descriptor if0_union;
+	struct cdc_ecm_descriptor if0_ecm;
+	struct cdc_ncm_descriptor if0_ncm;
+	struct usb_ep_descriptor if0_int_ep;
+
+	struct usb_if_descriptor if1_0;
+
+	struct usb_if_descriptor if1_1;
+	struct usb_ep_descriptor if1_1_in_ep;
+	struct usb_ep_descriptor if1_1_out_ep;
+
+	struct usb_desc_header nil_desc;
+} __packed;
+
+static const struct ntb_parameters cdc_ncm_ntb_parameters = {
+	.wLength = sys_cpu_to_le16(sizeof(struct ntb_parameters)),
+	.bmNtbFormatsSupported = sys_cpu_to_le16(CDC_NCM_NTB16_FORMAT),
+	.dwNtbInMaxSize = sys_cpu_to_le32(CONFIG_USBD_CDC_NCM_NTB_IN_SIZE),
+	.wNdpInDivisor = sys_cpu_to_le16(CDC_NCM_ALIGNMENT),
+	.wNdpInPayloadRemainder = sys_cpu_to_le16(0),
+	.wNdpInAlignment = sys_cpu_to_le16(CDC_NCM_ALIGNMENT),
+	.dwNtbOutMaxSize = sys_cpu_to_le32(CONFIG_USBD_CDC_NCM_NTB_OUT_SIZE),
+	.wNdpOutDivisor = sys_cpu_to_le16(CDC_NCM_ALIGNMENT),
+	.wNdpOutPayloadRemainder = sys_cpu_to_le16(0),
+	.wNdpOutAlignment = sys_cpu_to_le16(CDC_NCM_ALIGNMENT),
+	.wNtbOutMaxDatagrams = sys_cpu_to_le16(0),
+};
+
+static uint8_t cdc_ncm_get_ctrl_if(struct usbd_class_node *const c_nd)
+{
+	struct usbd_cdc_ncm_desc *desc = c_nd->data->desc;
+
+	return desc->if0.bInterfaceNumber;
+}
+
+static uint8_t cdc_ncm_get_int_in(struct usbd_class_node *const c_nd)
+{
+	struct usbd_cdc_ncm_desc *desc = c_nd->data->desc;
+
+	return desc->if0_int_ep.bEndpointAddress;
+}
+
+static uint8_t cdc_ncm_get_bulk_in(struct usbd_class_node *const c_nd)
+{
+	struct usbd_cdc_ncm_desc *desc = c_nd->data->desc;
+
+	return desc->if1_1_in_ep.bEndpointAddress;
+}
+
+static uint8_t cdc_ncm_get_bulk_out(struct usbd_class_node *const c_nd)
+{
+	struct usbd_cdc_ncm_desc *desc = c_nd->data->desc;
+
+	return desc->if1_1_out_ep.bEndpointAddress;
+}
+
+static struct net_buf *cdc_ncm_buf_alloc(struct net_buf_pool *const pool,
+					 const uint8_t ep)
+{
+	struct net_buf *buf = NULL;
+	struct udc_buf_info *bi;
+
+	buf = net_buf_alloc(pool, K_NO_WAIT);
+	if (!buf) {
+		return NULL;
+	}
+
+	bi = udc_get_buf_info(buf);
+	memset(bi, 0, sizeof(struct udc_buf_info));
+	bi->ep = ep;
+
+	return buf;
+}
+
+static int cdc_ncm_out_start(struct usbd_class_node *const c_nd)
+{
+	const struct device *dev = c_nd->data->priv;
+	struct cdc_ncm_eth_data *data = dev->data;
+	struct net_buf *buf;
+	uint8_t ep;
+	int ret;
+
+	if (!atomic_test_bit(&data->state, CDC_NCM_CLASS_ENABLED)) {
+		return -EACCES;
+	}
+
+	ep = cdc_ncm_get_bulk_out(c_nd);
+
+	while (atomic_inc(&data->out_queued) < CDC_NCM_OUT_REQUESTS) {
+		buf = cdc_ncm_buf_alloc(&cdc_ncm_out_pool, ep);
+		if (buf == NULL) {
+			atomic_dec(&data->out_queued);
+			return -ENOMEM;
+		}
+
+		ret = usbd_ep_enqueue(c_nd, buf);
+		if (ret) {
+			LOG_ERR("Failed to enqueue net_buf for 0x%02x", ep);
+			atomic_dec(&data->out_queued);
+			net_buf_unref(buf);
+			return ret;
+		}
+	}
+
+	atomic_dec(&data->out_queued);
+
+	return 0;
+}
+
+static void cdc_ncm_rx_datagram(struct cdc_ncm_eth_data *const data,
+				const uint8_t *const dgram, const size_t len)
+{
+	struct net_pkt *pkt;
+
+	pkt = net_pkt_rx_alloc_with_buffer(data->iface, len,
+					   AF_UNSPEC, 0, K_FOREVER);
+	if (!pkt) {
+		LOG_ERR("No memory for net_pkt");
+		return;
+	}
+
+	if (net_pkt_write(pkt, dgram, len)) {
+		LOG_ERR("Unable to write into pkt");
+		net_pkt_unref(pkt);
+		return;
+	}
+
+	LOG_DBG("Received packet len %zu", len);
+	if (net_recv_data(data->iface, pkt) < 0) {
+		LOG_ERR("Packet %p dropped by network stack", pkt);
+		net_pkt_unref(pkt);
+	}
+}
+
+/* Pass the datagrams of a received NTB to the network stack */
+static void cdc_ncm_rx_ntb(struct cdc_ncm_eth_data *const data,
+			   const uint8_t *const ntb, size_t len)
+{
+	const uint8_t *ndp;
+	uint16_t ndp_idx;
+	uint16_t ndp_len;
+	uint16_t dgram_idx;
+	uint16_t dgram_len;
+	size_t max_ndps;
+
+	if (len < sizeof(struct nth16) ||
+	    sys_get_le32(ntb) != NTH16_SIGNATURE ||
+	    sys_get_le16(ntb + offsetof(struct nth16, wHeaderLength)) !=
+	    sizeof(struct nth16)) {
+		LOG_WRN("Invalid NTH16");
+		return;
+	}
+
+	len = MIN(len, sys_get_le16(ntb + offsetof(struct nth16, wBlockLength)));
+	ndp_idx = sys_get_le16(ntb + offsetof(struct nth16, wNdpIndex));
+
+	/* Each NDP takes at least 16 bytes, which bounds a malformed chain */
+	for (max_ndps = len / 16; ndp_idx != 0 && max_ndps > 0; max_ndps--) {
+		if (ndp_idx % CDC_NCM_ALIGNMENT ||
+		    ndp_idx < sizeof(struct nth16) ||
+		    ndp_idx + sizeof(struct ndp16) > len) {
+			LOG_WRN("Invalid NDP16 index %u", ndp_idx);
+			return;
+		}
+
+		ndp = ntb + ndp_idx;
+		ndp_len = sys_get_le16(ndp + offsetof(struct ndp16, wLength));
+		if (sys_get_le32(ndp) != NDP16_SIGNATURE_NCM0 ||
+		    ndp_len < 16 || ndp_idx + ndp_len > len) {
+			LOG_WRN("Invalid NDP16");
+			return;
+		}
+
+		for (size_t i = sizeof(struct ndp16);
+		     i + sizeof(struct ndp16_datagram) <= ndp_len;
+		     i += sizeof(struct ndp16_datagram)) {
+			dgram_idx = sys_get_le16(ndp + i);
+			dgram_len = sys_get_le16(ndp + i + sizeof(uint16_t));
+			if (dgram_idx == 0 || dgram_len == 0) {
+				/* Terminating entry */
+				break;
+			}
+
+			if (dgram_idx + dgram_len > len ||
+			    dgram_len > NET_ETH_MAX_FRAME_SIZE) {
+				LOG_WRN("Invalid datagram %u %u",
+					dgram_idx, dgram_len);
+				continue;
+			}
+
+			cdc_ncm_rx_datagram(data, ntb + dgram_idx, dgram_len);
+		}
+
+		ndp_idx = sys_get_le16(ndp + offsetof(struct ndp16, wNextNdpIndex));
+	}
+}
+
+static int cdc_ncm_acl_out_cb(struct usbd_class_node *const c_nd,
+			      struct net_buf *const buf, const int err)
+{
+	const struct device *dev = c_nd->data->priv;
+	struct cdc_ncm_eth_data *data = dev->data;
+
+	if (!err) {
+		cdc_ncm_rx_ntb(data, buf->data, buf->len);
+	}
+
+	net_buf_unref(buf);
+	atomic_dec(&data->out_queued);
+
+	if (err == -ECONNABORTED) {
+		return 0;
+	}
+
+	return cdc_ncm_out_start(c_nd);
+}
+
+/* Start the NTB the frames to send are gathered into */
+static int cdc_ncm_tx_ntb_start(struct cdc_ncm_eth_data *const data)
+{
+	struct nth16 *nth;
+
+	data->tx_ntb = cdc_ncm_buf_alloc(&cdc_ncm_in_pool,
+					 cdc_ncm_get_bulk_in(data->c_nd));
+	if (data->tx_ntb == NULL) {
+		return -ENOMEM;
+	}
+
+	/* Completed when the NTB is sent */
+	nth = net_buf_add(data->tx_ntb, sizeof(struct nth16));
+	memset(nth, 0, sizeof(struct nth16));
+	data->tx_count = 0;
+
+	return 0;
+}
+
+static size_t cdc_ncm_tx_ndp_len(const uint8_t count)
+{
+	/* The datagram pointers are followed by a terminating entry */
+	return sizeof(struct ndp16) +
+	       (count + 1) * sizeof(struct ndp16_datagram);
+}
+
+/* Whether a frame of @p len bytes can be added to the NTB being gathered */
+static bool cdc_ncm_tx_ntb_fits(struct cdc_ncm_eth_data *const data,
+				const size_t len)
+{
+	size_t ndp_idx;
+
+	if (data->tx_count == ARRAY_SIZE(data->tx_datagrams)) {
+		return false;
+	}
+
+	ndp_idx = ROUND_UP(ROUND_UP(data->tx_ntb->len, CDC_NCM_ALIGNMENT) + len,
+			   CDC_NCM_ALIGNMENT);
+
+	return ndp_idx + cdc_ncm_tx_ndp_len(data->tx_count + 1) <=
+	       data->tx_max_size;
+}
+
+static void cdc_ncm_tx_pad(struct net_buf *const buf)
+{
+	size_t pad = ROUND_UP(buf->len, CDC_NCM_ALIGNMENT) - buf->len;
+
+	memset(net_buf_add(buf, pad), 0, pad);
+}
+
+/* Complete the NTB gathered with its NDP, and send it */
+static int cdc_ncm_tx_ntb_send(struct cdc_ncm_eth_data *const data)
+{
+	struct usbd_class_node *c_nd = data->c_nd;
+	struct net_buf *buf = data->tx_ntb;
+	struct nth16 *nth = (struct nth16 *)buf->data;
+	struct ndp16 *ndp;
+	uint16_t bulk_mps;
+	int ret;
+
+	cdc_ncm_tx_pad(buf);
+	nth->dwSignature = sys_cpu_to_le32(NTH16_SIGNATURE);
+	nth->wHeaderLength = sys_cpu_to_le16(sizeof(struct nth16));
+	nth->wSequence = sys_cpu_to_le16(data->tx_sequence++);
+	nth->wNdpIndex = sys_cpu_to_le16(buf->len);
+
+	ndp = net_buf_add(buf, sizeof(struct ndp16));
+	ndp->dwSignature = sys_cpu_to_le32(NDP16_SIGNATURE_NCM0);
+	ndp->wLength = sys_cpu_to_le16(cdc_ncm_tx_ndp_len(data->tx_count));
+	ndp->wNextNdpIndex = 0;
+	net_buf_add_mem(buf, data->tx_datagrams,
+			data->tx_count * sizeof(struct ndp16_datagram));
+	memset(net_buf_add(buf, sizeof(struct ndp16_datagram)), 0,
+	       sizeof(struct ndp16_datagram));
+
+	nth->wBlockLength = sys_cpu_to_le16(buf->len);
+
+	/*
+	 * REVISE: It should be more abstract and
+	 * not pull UDC stuff in the class code.
+	 */
+	if (udc_device_speed(c_nd->data->uds_ctx->dev) == UDC_BUS_SPEED_FS) {
+		bulk_mps = 64;
+	} else {
+		bulk_mps = 512;
+	}
+
+	/* A full size NTB is not terminated by a ZLP */
+	if (!(buf->len % bulk_mps) && buf->len < data->tx_max_size) {
+		udc_ep_buf_set_zlp(buf);
+	}
+
+	data->tx_ntb = NULL;
+	ret = usbd_ep_enqueue(c_nd, buf);
+	if (ret) {
+		LOG_ERR("Failed to enqueue NTB");
+		net_buf_unref(buf);
+		return ret;
+	}
+
+	data->tx_busy = true;
+
+	return 0;
+}
+
+static int cdc_ncm_acl_in_cb(struct usbd_class_node *const c_nd,
+			     struct net_buf *const buf, const int err)
+{
+	const struct device *dev = c_nd->data->priv;
+	struct cdc_ncm_eth_data *data = dev->data;
+
+	net_buf_unref(buf);
+
+	k_mutex_lock(&data->tx_mutex, K_FOREVER);
+
+	data->tx_busy = false;
+
+	/* Send the frames gathered meanwhile right away */
+	if (data->tx_ntb != NULL && data->tx_count > 0 && !err) {
+		(void)cdc_ncm_tx_ntb_send(data);
+	}
+
+	k_mutex_unlock(&data->tx_mutex);
+	k_sem_give(&data->tx_sem);
+
+	return 0;
+}
+
+static int usbd_cdc_ncm_request(struct usbd_class_node *const c_nd,
+				struct net_buf *buf, int err)
+{
+	struct usbd_contex *uds_ctx = c_nd->data->uds_ctx;
+	const struct device *dev = c_nd->data->priv;
+	struct cdc_ncm_eth_data *data = dev->data;
+	struct udc_buf_info *bi;
+
+	bi = udc_get_buf_info(buf);
+
+	if (bi->ep == cdc_ncm_get_bulk_out(c_nd)) {
+		return cdc_ncm_acl_out_cb(c_nd, buf, err);
+	}
+
+	if (bi->ep == cdc_ncm_get_bulk_in(c_nd)) {
+		return cdc_ncm_acl_in_cb(c_nd, buf, err);
+	}
+
+	if (bi->ep == cdc_ncm_get_int_in(c_nd)) {
+		k_sem_give(&data->notif_sem);
+	}
+
+	return usbd_ep_buf_free(uds_ctx, buf);
+}
+
+static int cdc_ncm_notification_enqueue(struct usbd_class_node *const c_nd,
+					const bool connected)
+{
+	struct cdc_ncm_notification notification = {
+		.RequestType = {
+			.direction = USB_REQTYPE_DIR_TO_HOST,
+			.type = USB_REQTYPE_TYPE_CLASS,
+			.recipient = USB_REQTYPE_RECIPIENT_INTERFACE,
+		},
+		.bNotificationType = USB_CDC_NETWORK_CONNECTION,
+		.wValue = sys_cpu_to_le16((uint16_t)connected),
+		.wIndex = sys_cpu_to_le16(cdc_ncm_get_ctrl_if(c_nd)),
+		.wLength = 0,
+	};
+	struct net_buf *buf;
+	uint8_t ep;
+	int ret;
+
+	ep = cdc_ncm_get_int_in(c_nd);
+	buf = usbd_ep_buf_alloc(c_nd, ep, sizeof(struct cdc_ncm_notification));
+	if (buf == NULL) {
+		return -ENOMEM;
+	}
+
+	net_buf_add_mem(buf, &notification, sizeof(struct cdc_ncm_notification));
+	ret = usbd_ep_enqueue(c_nd, buf);
+	if (ret) {
+		LOG_ERR("Failed to enqueue net_buf for 0x%02x", ep);
+		net_buf_unref(buf);
+	}
+
+	/* The buffer is released in the request handler */
+	return ret;
+}
+
+static int cdc_ncm_send_notification(const struct device *dev,
+				     const bool connected)
+{
+	struct cdc_ncm_eth_data *data = dev->data;
+	int ret;
+
+	if (!atomic_test_bit(&data->state, CDC_NCM_CLASS_ENABLED)) {
+		LOG_INF("USB configuration is not enabled");
+		return 0;
+	}
+
+	if (atomic_test_bit(&data->state, CDC_NCM_CLASS_SUSPENDED)) {
+		/* The current state is notified once the bus resumes */
+		LOG_DBG("USB device is suspended, defer notification");
+		atomic_set_bit(&data->state, CDC_NCM_NOTIFY_PENDING);
+		return 0;
+	}
+
+	/* Do not count the completion of a deferred notification */
+	k_sem_reset(&data->notif_sem);
+
+	ret = cdc_ncm_notification_enqueue(data->c_nd, connected);
+	if (ret) {
+		return ret;
+	}
+
+	k_sem_take(&data->notif_sem, K_FOREVER);
+
+	return 0;
+}
+
+/* Drop the frames gathered, called when the data interface goes down */
+static void cdc_ncm_tx_reset(struct cdc_ncm_eth_data *const data)
+{
+	k_mutex_lock(&data->tx_mutex, K_FOREVER);
+
+	if (data->tx_ntb != NULL) {
+		net_buf_unref(data->tx_ntb);
+		data->tx_ntb = NULL;
+	}
+
+	/* NCM10.pdf, 7.2 the NTB parameters are reset with the interface */
+	data->tx_sequence = 0;
+	data->tx_max_size = CONFIG_USBD_CDC_NCM_NTB_IN_SIZE;
+
+	k_mutex_unlock(&data->tx_mutex);
+}
+
+static void usbd_cdc_ncm_update(struct usbd_class_node *const c_nd,
+				const uint8_t iface, const uint8_t alternate)
+{
+	struct usbd_cdc_ncm_desc *desc = c_nd->data->desc;
+	const uint8_t data_iface = desc->if1_1.bInterfaceNumber;
+	const struct device *dev = c_nd->data->priv;
+	struct cdc_ncm_eth_data *data = dev->data;
+
+	LOG_INF("New configuration, interface %u alternate %u",
+		iface, alternate);
+
+	if (data_iface == iface && alternate == 0) {
+		net_if_carrier_off(data->iface);
+		cdc_ncm_tx_reset(data);
+	}
+
+	if (data_iface == iface && alternate == 1) {
+		net_if_carrier_on(data->iface);
+		if (cdc_ncm_out_start(c_nd)) {
+			LOG_ERR("Failed to start OUT transfer");
+		}
+	}
+}
+
+static void usbd_cdc_ncm_enable(struct usbd_class_node *const c_nd)
+{
+	const struct device *dev = c_nd->data->priv;
+	struct cdc_ncm_eth_data *data = dev->data;
+
+	atomic_set_bit(&data->state, CDC_NCM_CLASS_ENABLED);
+	LOG_INF("Configuration enabled");
+}
+
+static void usbd_cdc_ncm_disable(struct usbd_class_node *const c_nd)
+{
+	const struct device *dev = c_nd->data->priv;
+	struct cdc_ncm_eth_data *data = dev->data;
+
+	if (atomic_test_and_clear_bit(&data->state, CDC_NCM_CLASS_ENABLED)) {
+		net_if_carrier_off(data->iface);
+	}
+
+	atomic_clear_bit(&data->state, CDC_NCM_CLASS_SUSPENDED);
+	atomic_clear_bit(&data->state, CDC_NCM_NOTIFY_PENDING);
+	data->packet_filter = CDC_NCM_PACKET_FILTER_DEFAULT;
+	cdc_ncm_tx_reset(data);
+	LOG_INF("Configuration disabled");
+}
+
+static void usbd_cdc_ncm_suspended(struct usbd_class_node *const c_nd)
+{
+	const struct device *dev = c_nd->data->priv;
+	struct cdc_ncm_eth_data *data = dev->data;
+
+	atomic_set_bit(&data->state, CDC_NCM_CLASS_SUSPENDED);
+}
+
+static void usbd_cdc_ncm_resumed(struct usbd_class_node *const c_nd)
+{
+	const struct device *dev = c_nd->data->priv;
+	struct cdc_ncm_eth_data *data = dev->data;
+
+	atomic_clear_bit(&data->state, CDC_NCM_CLASS_SUSPENDED);
+
+	/*
+	 * The transfer cannot complete while we run in the stack context,
+	 * queue the notification without waiting for it.
+	 */
+	if (atomic_test_and_clear_bit(&data->state, CDC_NCM_NOTIFY_PENDING) &&
+	    cdc_ncm_notification_enqueue(c_nd,
+					 atomic_test_bit(&data->state, CDC_NCM_IFACE_UP))) {
+		LOG_ERR("Failed to send deferred notification");
+	}
+}
+
+static int usbd_cdc_ncm_cth(struct usbd_class_node *const c_nd,
+			    const struct usb_setup_packet *const setup,
+			    struct net_buf *const buf)
+{
+	const struct device *dev = c_nd->data->priv;
+	struct cdc_ncm_eth_data *data = dev->data;
+	uint32_t ntb_input_size;
+	uint16_t ntb_format;
+	size_t min_len;
+
+	if (buf == NULL) {
+		errno = -ENOMEM;
+		return 0;
+	}
+
+	switch (setup->bRequest) {
+	case GET_NTB_PARAMETERS:
+		min_len = MIN(sizeof(cdc_ncm_ntb_parameters), setup->wLength);
+		net_buf_add_mem(buf, &cdc_ncm_ntb_parameters, min_len);
+		return 0;
+
+	case GET_NTB_FORMAT:
+		ntb_format = sys_cpu_to_le16(0);
+		min_len = MIN(sizeof(ntb_format), setup->wLength);
+		net_buf_add_mem(buf, &ntb_format, min_len);
+		return 0;
+
+	case GET_NTB_INPUT_SIZE:
+		ntb_input_size = sys_cpu_to_le32(data->tx_max_size);
+		min_len = MIN(sizeof(ntb_input_size), setup->wLength);
+		net_buf_add_mem(buf, &ntb_input_size, min_len);
+		return 0;
+
+	default:
+		break;
+	}
+
+	LOG_DBG("bmRequestType 0x%02x bRequest 0x%02x unsupported",
+		setup->bmRequestType, setup->bRequest);
+	errno = -ENOTSUP;
+
+	return 0;
+}
+
+static int usbd_cdc_ncm_ctd(struct usbd_class_node *const c_nd,
+			    const struct usb_setup_packet *const setup,
+			    const struct net_buf *const buf)
+{
+	const struct device *dev = c_nd->data->priv;
+	struct cdc_ncm_eth_data *data = dev->data;
+	uint32_t ntb_input_size;
+
+	if (setup->RequestType.recipient != USB_REQTYPE_RECIPIENT_INTERFACE) {
+		goto ctd_unsupported;
+	}
+
+	switch (setup->bRequest) {
+	case SET_ETHERNET_PACKET_FILTER:
+		data->packet_filter = setup->wValue;
+		LOG_DBG("Packet filter 0x%04x", data->packet_filter);
+		return 0;
+
+	case SET_NTB_FORMAT:
+		/* Only NTB16 is supported */
+		if (setup->wValue != 0) {
+			break;
+		}
+
+		return 0;
+
+	case SET_NTB_INPUT_SIZE:
+		if (buf == NULL || buf->len < sizeof(ntb_input_size)) {
+			break;
+		}
+
+		ntb_input_size = sys_get_le32(buf->data);
+		if (ntb_input_size < NET_ETH_MAX_FRAME_SIZE + sizeof(struct nth16) +
+		    cdc_ncm_tx_ndp_len(1) + CDC_NCM_ALIGNMENT) {
+			break;
+		}
+
+		k_mutex_lock(&data->tx_mutex, K_FOREVER);
+		data->tx_max_size = MIN(ntb_input_size,
+					CONFIG_USBD_CDC_NCM_NTB_IN_SIZE);
+		k_mutex_unlock(&data->tx_mutex);
+		LOG_INF("NTB input size %u", data->tx_max_size);
+		return 0;
+
+	default:
+		goto ctd_unsupported;
+	}
+
+	LOG_WRN("bRequest 0x%02x invalid", setup->bRequest);
+	errno = -EINVAL;
+
+	return 0;
+
+ctd_unsupported:
+	LOG_DBG("bmRequestType 0x%02x bRequest 0x%02x unsupported",
+		setup->bmRequestType, setup->bRequest);
+	errno = -ENOTSUP;
+
+	return 0;
+}
+
+static int usbd_cdc_ncm_init(struct usbd_class_node *const c_nd)
+{
+	struct usbd_cdc_ncm_desc *desc = c_nd->data->desc;
+	const uint8_t if_num = desc->if0.bInterfaceNumber;
+	const struct device *dev = c_nd->data->priv;
+	struct cdc_ncm_eth_data *const data = dev->data;
+
+	/* Update relevant b*Interface fields */
+	desc->iad.bFirstInterface = if_num;
+	desc->if0_union.bControlInterface = if_num;
+	desc->if0_union.bSubordinateInterface0 = if_num + 1;
+	LOG_DBG("CDC NCM class initialized");
+
+	if (usbd_add_descriptor(c_nd->data->uds_ctx, data->mac_desc_nd)) {
+		LOG_ERR("Failed to add iMACAddress string descriptor");
+	} else {
+		desc->if0_ecm.iMACAddress = data->mac_desc_nd->idx;
+	}
+
+	return 0;
+}
+
+static void usbd_cdc_ncm_shutdown(struct usbd_class_node *const c_nd)
+{
+	struct usbd_cdc_ncm_desc *desc = c_nd->data->desc;
+	const struct device *dev = c_nd->data->priv;
+	struct cdc_ncm_eth_data *const data = dev->data;
+
+	desc->if0_ecm.iMACAddress = 0;
+	sys_dlist_remove(&data->mac_desc_nd->node);
+}
+
+/* Check a frame against the packet filter set by the host */
+static bool cdc_ncm_filter_pass(struct cdc_ncm_eth_data *const data,
+				struct net_pkt *const pkt)
+{
+	struct net_eth_hdr *hdr = NET_ETH_HDR(pkt);
+	uint16_t filter = data->packet_filter;
+
+	if (filter & PACKET_TYPE_PROMISCUOUS) {
+		return true;
+	}
+
+	if (net_eth_is_addr_broadcast(&hdr->dst)) {
+		return filter & PACKET_TYPE_BROADCAST;
+	}
+
+	/* No multicast address list is kept, pass them all */
+	if (net_eth_is_addr_multicast(&hdr->dst)) {
+		return filter & (PACKET_TYPE_MULTICAST | PACKET_TYPE_ALL_MULTICAST);
+	}
+
+	return filter & PACKET_TYPE_DIRECTED;
+}
+
+/*
+ * The frames are gathered in an NTB while the previous one is sent, and the
+ * NTB is sent as soon as it completes. A frame is sent in an NTB of its own
+ * when the link is idle, so that aggregation adds no latency.
+ */
+static int cdc_ncm_send(const struct device *dev, struct net_pkt *const pkt)
+{
+	struct cdc_ncm_eth_data *const data = dev->data;
+	size_t len = net_pkt_get_len(pkt);
+	struct ndp16_datagram *dgram;
+	int ret = 0;
+
+	if (len > NET_ETH_MAX_FRAME_SIZE) {
+		LOG_WRN("Trying to send too large packet, drop");
+		return -ENOMEM;
+	}
+
+	if (!atomic_test_bit(&data->state, CDC_NCM_CLASS_ENABLED) ||
+	    !atomic_test_bit(&data->state, CDC_NCM_IFACE_UP)) {
+		LOG_INF("Configuration is not enabled or interface not ready");
+		return -EACCES;
+	}
+
+	if (!cdc_ncm_filter_pass(data, pkt)) {
+		/* The host asked not to receive such frames */
+		return 0;
+	}
+
+	k_mutex_lock(&data->tx_mutex, K_FOREVER);
+
+	while (data->tx_ntb == NULL || !cdc_ncm_tx_ntb_fits(data, len)) {
+		if (data->tx_ntb == NULL) {
+			ret = cdc_ncm_tx_ntb_start(data);
+			if (ret) {
+				LOG_ERR("Failed to allocate NTB");
+				goto send_exit;
+			}
+
+			continue;
+		}
+
+		if (data->tx_count == 0) {
+			LOG_WRN("Packet does not fit in an NTB, drop");
+			ret = -ENOMEM;
+			goto send_exit;
+		}
+
+		if (!data->tx_busy) {
+			ret = cdc_ncm_tx_ntb_send(data);
+			if (ret) {
+				goto send_exit;
+			}
+
+			continue;
+		}
+
+		/* The NTB is full, it is sent once the previous one is */
+		k_mutex_unlock(&data->tx_mutex);
+		k_sem_take(&data->tx_sem, K_FOREVER);
+		k_mutex_lock(&data->tx_mutex, K_FOREVER);
+
+		if (!atomic_test_bit(&data->state, CDC_NCM_CLASS_ENABLED)) {
+			ret = -EACCES;
+			goto send_exit;
+		}
+	}
+
+	cdc_ncm_tx_pad(data->tx_ntb);
+	dgram = &data->tx_datagrams[data->tx_count];
+	dgram->wDatagramIndex = sys_cpu_to_le16(data->tx_ntb->len);
+	dgram->wDatagramLength = sys_cpu_to_le16(len);
+
+	if (net_pkt_read(pkt, net_buf_add(data->tx_ntb, len), len)) {
+		LOG_ERR("Failed copy net_pkt");
+		net_buf_remove_mem(data->tx_ntb, len);
+		ret = -ENOBUFS;
+		goto send_exit;
+	}
+
+	data->tx_count++;
+
+	if (!data->tx_busy) {
+		ret = cdc_ncm_tx_ntb_send(data);
+	}
+
+send_exit:
+	k_mutex_unlock(&data->tx_mutex);
+
+	return ret;
+}
+
+static int cdc_ncm_set_config(const struct device *dev,
+			      const enum ethernet_config_type type,
+			      const struct ethernet_config *config)
+{
+	struct cdc_ncm_eth_data *data = dev->data;
+
+	if (type == ETHERNET_CONFIG_TYPE_MAC_ADDRESS) {
+		memcpy(data->mac_addr, config->mac_address.addr,
+		       sizeof(data->mac_addr));
+
+		return 0;
+	}
+
+	return -ENOTSUP;
+}
+
+static int cdc_ncm_get_config(const struct device *dev,
+			      enum ethernet_config_type type,
+			      struct ethernet_config *config)
+{
+	return -ENOTSUP;
+}
+
+static enum ethernet_hw_caps cdc_ncm_get_capabilities(const struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	return ETHERNET_LINK_10BASE_T;
+}
+
+static int cdc_ncm_iface_start(const struct device *dev)
+{
+	struct cdc_ncm_eth_data *data = dev->data;
+	int ret;
+
+	LOG_DBG("Start interface %p", data->iface);
+	ret = cdc_ncm_send_notification(dev, true);
+	if (!ret) {
+		atomic_set_bit(&data->state, CDC_NCM_IFACE_UP);
+	}
+
+	return ret;
+}
+
+static int cdc_ncm_iface_stop(const struct device *dev)
+{
+	struct cdc_ncm_eth_data *data = dev->data;
+	int ret;
+
+	LOG_DBG("Stop interface %p", data->iface);
+	ret = cdc_ncm_send_notification(dev, false);
+	if (!ret) {
+		atomic_clear_bit(&data->state, CDC_NCM_IFACE_UP);
+	}
+
+	return ret;
+}
+
+static void cdc_ncm_iface_init(struct net_if *const iface)
+{
+	const struct device *dev = net_if_get_device(iface);
+	struct cdc_ncm_eth_data *data = dev->data;
+
+	data->iface = iface;
+	ethernet_init(iface);
+	net_if_set_link_addr(iface, data->mac_addr,
+			     sizeof(data->mac_addr),
+			     NET_LINK_ETHERNET);
+
+	net_if_carrier_off(iface);
+
+	LOG_DBG("CDC NCM interface initialized");
+}
+
+static int usbd_cdc_ncm_preinit(const struct device *dev)
+{
+	struct cdc_ncm_eth_data *data = dev->data;
+
+	if (sys_get_le48(data->mac_addr) == sys_cpu_to_le48(0)) {
+		gen_random_mac(data->mac_addr, 0, 0, 0);
+	}
+
+	LOG_DBG("CDC NCM device initialized");
+
+	return 0;
+}
+
+static struct usbd_class_api usbd_cdc_ncm_api = {
+	.request = usbd_cdc_ncm_request,
+	.update = usbd_cdc_ncm_update,
+	.enable = usbd_cdc_ncm_enable,
+	.disable = usbd_cdc_ncm_disable,
+	.suspended = usbd_cdc_ncm_suspended,
+	.resumed = usbd_cdc_ncm_resumed,
+	.control_to_host = usbd_cdc_ncm_cth,
+	.control_to_dev = usbd_cdc_ncm_ctd,
+	.init = usbd_cdc_ncm_init,
+	.shutdown = usbd_cdc_ncm_shutdown,
+};
+
+static const struct ethernet_api cdc_ncm_eth_api = {
+	.iface_api.init = cdc_ncm_iface_init,
+	.get_config = cdc_ncm_get_config,
+	.set_config = cdc_ncm_set_config,
+	.get_capabilities = cdc_ncm_get_capabilities,
+	.send = cdc_ncm_send,
+	.start = cdc_ncm_iface_start,
+	.stop = cdc_ncm_iface_stop,
+};
+
+#define CDC_NCM_DEFINE_DESCRIPTOR(n)						\
+static struct usbd_cdc_ncm_desc cdc_ncm_desc_##n = {				\
+	.iad = {								\
+		.bLength = sizeof(struct usb_association_descriptor),		\
+		.bDescriptorType = USB_DESC_INTERFACE_ASSOC,			\
+		.bFirstInterface = 0,						\
+		.bInterfaceCount = 0x02,					\
+		.bFunctionClass = USB_BCC_CDC_CONTROL,				\
+		.bFunctionSubClass = NCM_SUBCLASS,				\
+		.bFunctionProtocol = 0,						\
+		.iFunction = 0,							\
+	},									\
+										\
+	.if0 = {								\
+		.bLength = sizeof(struct usb_if_descriptor),			\
+		.bDescriptorType = USB_DESC_INTERFACE,				\
+		.bInterfaceNumber = 0,						\
+		.bAlternateSetting = 0,						\
+		.bNumEndpoints = 1,						\
+		.bInterfaceClass = USB_BCC_CDC_CONTROL,				\
+		.bInterfaceSubClass = NCM_SUBCLASS,				\
+		.bInterfaceProtocol = 0,					\
+		.iInterface = 0,						\
+	},									\
+										\
+	.if0_header = {								\
+		.bFunctionLength = sizeof(struct cdc_header_descriptor),	\
+		.bDescriptorType = USB_DESC_CS_INTERFACE,			\
+		.bDescriptorSubtype = HEADER_FUNC_DESC,				\
+		.bcdCDC = sys_cpu_to_le16(USB_SRN_1_1),				\
+	},									\
+										\
+	.if0_union = {								\
+		.bFunctionLength = sizeof(struct cdc_union_descriptor),		\
+		.bDescriptorType = USB_DESC_CS_INTERFACE,			\
+		.bDescriptorSubtype = UNION_FUNC_DESC,				\
+		.bControlInterface = 0,						\
+		.bSubordinateInterface0 = 1,					\
+	},									\
+										\
+	.if0_ecm = {								\
+		.bFunctionLength = sizeof(struct cdc_ecm_descriptor),		\
+		.bDescriptorType = USB_DESC_CS_INTERFACE,			\
+		.bDescriptorSubtype = ETHERNET_FUNC_DESC,			\
+		.iMACAddress = 0,						\
+		.bmEthernetStatistics = sys_cpu_to_le32(0),			\
+		.wMaxSegmentSize = sys_cpu_to_le16(NET_ETH_MAX_FRAME_SIZE),	\
+		.wNumberMCFilters = sys_cpu_to_le16(0),				\
+		.bNumberPowerFilters = 0,					\
+	},									\
+										\
+	.if0_ncm = {								\
+		.bFunctionLength = sizeof(struct cdc_ncm_descriptor),		\
+		.bDescriptorType = USB_DESC_CS_INTERFACE,			\
+		.bDescriptorSubtype = NCM_FUNC_DESC,				\
+		.bcdNcmVersion = sys_cpu_to_le16(0x0100),			\
+		.bmNetworkCapabilities = BIT(0),				\
+	},									\
+										\
+	.if0_int_ep = {								\
+		.bLength = sizeof(struct usb_ep_descriptor),			\
+		.bDescriptorType = USB_DESC_ENDPOINT,				\
+		.bEndpointAddress = 0x81,					\
+		.bmAttributes = USB_EP_TYPE_INTERRUPT,				\
+		.wMaxPacketSize = sys_cpu_to_le16(CDC_NCM_EP_MPS_INT),		\
+		.bInterval = CDC_NCM_EP_INTERVAL_INT,				\
+	},									\
+										\
+	.if1_0 = {								\
+		.bLength = sizeof(struct usb_if_descriptor),			\
+		.bDescriptorType = USB_DESC_INTERFACE,				\
+		.bInterfaceNumber = 1,						\
+		.bAlternateSetting = 0,						\
+		.bNumEndpoints = 0,						\
+		.bInterfaceClass = USB_BCC_CDC_DATA,				\
+		.bInterfaceSubClass = 0,					\
+		.bInterfaceProtocol = NCM_DATA_PROTOCOL,			\
+		.iInterface = 0,						\
+	},									\
+										\
+	.if1_1 = {								\
+		.bLength = sizeof(struct usb_if_descriptor),			\
+		.bDescriptorType = USB_DESC_INTERFACE,				\
+		.bInterfaceNumber = 1,						\
+		.bAlternateSetting = 1,						\
+		.bNumEndpoints = 2,						\
+		.bInterfaceClass = USB_BCC_CDC_DATA,				\
+		.bInterfaceSubClass = 0,					\
+		.bInterfaceProtocol = NCM_DATA_PROTOCOL,			\
+		.iInterface = 0,						\
+	},									\
+										\
+	.if1_1_in_ep = {							\
+		.bLength = sizeof(struct usb_ep_descriptor),			\
+		.bDescriptorType = USB_DESC_ENDPOINT,				\
+		.bEndpointAddress = 0x82,					\
+		.bmAttributes = USB_EP_TYPE_BULK,				\
+		.wMaxPacketSize = sys_cpu_to_le16(CDC_NCM_EP_MPS_BULK),		\
+		.bInterval = 0,							\
+	},									\
+										\
+	.if1_1_out_ep = {							\
+		.bLength = sizeof(struct usb_ep_descriptor),			\
+		.bDescriptorType = USB_DESC_ENDPOINT,				\
+		.bEndpointAddress = 0x01,					\
+		.bmAttributes = USB_EP_TYPE_BULK,				\
+		.wMaxPacketSize = sys_cpu_to_le16(CDC_NCM_EP_MPS_BULK),		\
+		.bInterval = 0,							\
+	},									\
+										\
+	.nil_desc = {								\
+		.bLength = 0,							\
+		.bDescriptorType = 0,						\
+	},									\
+}
+
+#define USBD_CDC_NCM_DT_DEVICE_DEFINE(n)					\
+	CDC_NCM_DEFINE_DESCRIPTOR(n);						\
+	USBD_DESC_STRING_DEFINE(mac_desc_nd_##n,				\
+				DT_INST_PROP(n, remote_mac_address),		\
+				USBD_DUT_STRING_INTERFACE);			\
+										\
+	static struct usbd_class_data usbd_cdc_ncm_data_##n;			\
+										\
+	USBD_DEFINE_CLASS(cdc_ncm_##n,						\
+			  &usbd_cdc_ncm_api,					\
+			  &usbd_cdc_ncm_data_##n);				\
+										\
+	static struct cdc_ncm_eth_data eth_data_##n = {				\
+		.c_nd = &cdc_ncm_##n,						\
+		.mac_addr = DT_INST_PROP_OR(n, local_mac_address, {0}),		\
+		.notif_sem = Z_SEM_INITIALIZER(eth_data_##n.notif_sem, 0, 1),	\
+		.packet_filter = CDC_NCM_PACKET_FILTER_DEFAULT,			\
+		.tx_mutex = Z_MUTEX_INITIALIZER(eth_data_##n.tx_mutex),		\
+		.tx_sem = Z_SEM_INITIALIZER(eth_data_##n.tx_sem, 0, 1),		\
+		.tx_max_size = CONFIG_USBD_CDC_NCM_NTB_IN_SIZE,			\
+		.mac_desc_nd = &mac_desc_nd_##n,				\
+	};									\
+										\
+	static struct usbd_class_data usbd_cdc_ncm_data_##n = {			\
+		.desc = (struct usb_desc_header *)&cdc_ncm_desc_##n,		\
+		.priv = (void *)DEVICE_DT_GET(DT_DRV_INST(n)),			\
+	};									\
+										\
+	ETH_NET_DEVICE_DT_INST_DEFINE(n, usbd_cdc_ncm_preinit, NULL,		\
+		&eth_data_##n, NULL,						\
+		CONFIG_ETH_INIT_PRIORITY,					\
+		&cdc_ncm_eth_api,						\
+		NET_ETH_MTU);
+
+DT_INST_FOREACH_STATUS_OKAY(USBD_CDC_NCM_DT_DEVICE_DEFINE);
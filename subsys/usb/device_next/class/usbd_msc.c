@@ -75,6 +75,20 @@ NET_BUF_POOL_FIXED_DEFINE(msc_ep_pool,
 			  MSC_NUM_INSTANCES * 2, MSC_BUF_SIZE,
 			  sizeof(struct udc_buf_info), NULL);
 
+/* With two SCSI buffers, one is transferred while the other one is accessed
+ * on the disk.
+ */
+#if defined(CONFIG_USBD_MSC_DOUBLE_BUFFERING)
+#define MSC_NUM_SCSI_BUFS 2
+#else
+#define MSC_NUM_SCSI_BUFS 1
+#endif
+
+/* Data IN and OUT is transferred in place, from and to the SCSI buffers */
+NET_BUF_POOL_DEFINE(msc_scsi_pool,
+		    MSC_NUM_INSTANCES * MSC_NUM_SCSI_BUFS, 0,
+		    sizeof(struct udc_buf_info), NULL);
+
 struct msc_event {
 	struct usbd_class_node *node;
 	/* NULL to request Bulk-Only Mass Storage Reset
@@ -84,8 +98,11 @@ struct msc_event {
 	int err;
 };
 
-/* Each instance has 2 endpoints and can receive bulk only reset command */
-K_MSGQ_DEFINE(msc_msgq, sizeof(struct msc_event), MSC_NUM_INSTANCES * 3, 4);
+/* Each instance has 2 endpoints, up to one request per SCSI buffer on the
+ * Bulk-Out one, and can receive bulk only reset command
+ */
+K_MSGQ_DEFINE(msc_msgq, sizeof(struct msc_event),
+	      MSC_NUM_INSTANCES * (MSC_NUM_SCSI_BUFS + 2), 4);
 
 /* Make supported vendor request visible for the device stack */
 static const struct usbd_cctx_vendor_req msc_bot_vregs =
@@ -124,10 +141,18 @@ struct msc_bot_ctx {
 	struct scsi_ctx luns[CONFIG_USBD_MSC_LUNS_PER_INSTANCE];
 	struct CBW cbw;
 	struct CSW csw;
-	uint8_t scsi_buf[CONFIG_USBD_MSC_SCSI_BUFFER_SIZE];
+	uint8_t scsi_buf[MSC_NUM_SCSI_BUFS][CONFIG_USBD_MSC_SCSI_BUFFER_SIZE] __aligned(4);
+	/* Data IN bytes read, or Data OUT bytes requested, in each buffer */
+	size_t scsi_bytes[MSC_NUM_SCSI_BUFS];
+	/* Oldest SCSI buffer in use by the command, and number of them */
+	uint8_t scsi_head;
+	uint8_t scsi_count;
+	/* Data OUT requests queued, possibly left over by an aborted command */
+	uint8_t out_queued;
 	uint32_t transferred_data;
-	size_t scsi_offset;
-	size_t scsi_bytes;
+	/* Data OUT bytes expected by the command, and requested so far */
+	size_t write_len;
+	size_t requested_data;
 };
 
 static struct net_buf *msc_buf_alloc(const uint8_t ep)
@@ -147,6 +172,36 @@ static struct net_buf *msc_buf_alloc(const uint8_t ep)
 	return buf;
 }
 
+static struct net_buf *msc_scsi_buf_alloc(struct msc_bot_ctx *const ctx,
+					  const uint8_t ep, const uint8_t idx,
+					  const size_t len)
+{
+	struct net_buf *buf;
+	struct udc_buf_info *bi;
+
+	buf = net_buf_alloc_with_data(&msc_scsi_pool, ctx->scsi_buf[idx], len,
+				      K_NO_WAIT);
+	if (!buf) {
+		return NULL;
+	}
+
+	if (USB_EP_DIR_IS_OUT(ep)) {
+		/* Received from the start of the SCSI buffer */
+		net_buf_simple_reset(&buf->b);
+	}
+
+	bi = udc_get_buf_info(buf);
+	memset(bi, 0, sizeof(struct udc_buf_info));
+	bi->ep = ep;
+
+	return buf;
+}
+
+static bool msc_is_scsi_buf(struct net_buf *const buf)
+{
+	return net_buf_pool_get(buf->pool_id) == &msc_scsi_pool;
+}
+
 static uint8_t msc_get_bulk_in(struct usbd_class_node *const node)
 {
 	struct msc_bot_desc *desc = node->data->desc;
@@ -168,6 +223,11 @@ static void msc_queue_bulk_out_ep(struct usbd_class_node *const node)
 	uint8_t ep;
 	int ret;
 
+	if (ctx->out_queued) {
+		/* Data OUT request left over, it receives the CBW */
+		return;
+	}
+
 	if (atomic_test_and_set_bit(&ctx->bits, MSC_BULK_OUT_QUEUED)) {
 		/* Already queued */
 		return;
@@ -211,7 +271,15 @@ static void msc_reset_handler(struct usbd_class_node *node)
 	int i;
 
 	LOG_INF("Bulk-Only Mass Storage Reset");
+	/* Cancel the transfers of the aborted command, IN first so that its
+	 * cancellation is handled before a new CBW can be received.
+	 */
+	usbd_ep_dequeue(node->data->uds_ctx, msc_get_bulk_in(node));
+	usbd_ep_dequeue(node->data->uds_ctx, msc_get_bulk_out(node));
+
 	ctx->state = MSC_BBB_EXPECT_CBW;
+	ctx->scsi_head = 0;
+	ctx->scsi_count = 0;
 	for (i = 0; i < ctx->registered_luns; i++) {
 		scsi_reset(&ctx->luns[i]);
 	}
@@ -240,19 +308,40 @@ static bool is_cbw_meaningful(struct msc_bot_ctx *const ctx)
 	return true;
 }
 
-static void msc_process_read(struct msc_bot_ctx *ctx)
+/* Read the next SCSI Data IN into a free buffer, false if none was read */
+static bool msc_read_next(struct msc_bot_ctx *ctx)
 {
 	struct scsi_ctx *lun = &ctx->luns[ctx->cbw.bCBWLUN];
-	int bytes_queued = 0;
+	uint8_t idx;
+	size_t len;
+
+	if (ctx->scsi_count == MSC_NUM_SCSI_BUFS ||
+	    scsi_cmd_remaining_data_len(lun) == 0) {
+		return false;
+	}
+
+	idx = (ctx->scsi_head + ctx->scsi_count) % MSC_NUM_SCSI_BUFS;
+	len = scsi_read_data(lun, ctx->scsi_buf[idx]);
+	if (len == 0) {
+		return false;
+	}
+
+	ctx->scsi_bytes[idx] = len;
+	ctx->scsi_count++;
+
+	return true;
+}
+
+static void msc_process_read(struct msc_bot_ctx *ctx)
+{
 	struct net_buf *buf;
 	uint8_t ep;
 	size_t len;
 	int ret;
 
 	/* Fill SCSI Data IN buffer if there is no data available */
-	if (ctx->scsi_bytes == 0) {
-		ctx->scsi_bytes = scsi_read_data(lun, ctx->scsi_buf);
-		ctx->scsi_offset = 0;
+	if (ctx->scsi_count == 0) {
+		msc_read_next(ctx);
 	}
 
 	if (atomic_test_and_set_bit(&ctx->bits, MSC_BULK_IN_QUEUED)) {
@@ -261,41 +350,71 @@ static void msc_process_read(struct msc_bot_ctx *ctx)
 		return;
 	}
 
+	/* The whole buffer is queued at once, a zero length packet is sent
+	 * if there is no more SCSI IN data available
+	 */
+	len = ctx->scsi_count ? ctx->scsi_bytes[ctx->scsi_head] : 0;
 	ep = msc_get_bulk_in(ctx->class_node);
-	buf = msc_buf_alloc(ep);
+	buf = msc_scsi_buf_alloc(ctx, ep, ctx->scsi_head, len);
 	/* The pool is large enough to support all allocations. Failing alloc
 	 * indicates either a memory leak or logic error.
 	 */
 	__ASSERT_NO_MSG(buf);
 
-	while (ctx->scsi_bytes - ctx->scsi_offset > 0) {
-		len = MIN(ctx->scsi_bytes - ctx->scsi_offset,
-			  MSC_BUF_SIZE - bytes_queued);
-		if (len == 0) {
-			/* Either queued as much as possible or there is no more
-			 * SCSI IN data available
-			 */
-			break;
-		}
-
-		net_buf_add_mem(buf, &ctx->scsi_buf[ctx->scsi_offset], len);
-		bytes_queued += len;
-		ctx->scsi_offset += len;
-
-		if (ctx->scsi_bytes == ctx->scsi_offset) {
-			/* SCSI buffer can be reused now */
-			ctx->scsi_bytes = scsi_read_data(lun, ctx->scsi_buf);
-			ctx->scsi_offset = 0;
-		}
-	}
-
-	/* Either the net buf is full or there is no more SCSI data */
-	ctx->csw.dCSWDataResidue -= bytes_queued;
+	ctx->csw.dCSWDataResidue -= len;
 	ret = usbd_ep_enqueue(ctx->class_node, buf);
 	if (ret) {
 		LOG_ERR("Failed to enqueue net_buf for 0x%02x", ep);
 		net_buf_unref(buf);
 		atomic_clear_bit(&ctx->bits, MSC_BULK_IN_QUEUED);
+		return;
+	}
+
+	/* Access the disk while the buffer is transferred */
+	while (msc_read_next(ctx)) {
+	}
+}
+
+/* Queue SCSI Data OUT requests on the free buffers */
+static void msc_queue_write(struct msc_bot_ctx *ctx)
+{
+	struct scsi_ctx *lun = &ctx->luns[ctx->cbw.bCBWLUN];
+	struct net_buf *buf;
+	size_t chunk;
+	size_t len;
+	uint8_t idx;
+	uint8_t ep;
+	int ret;
+
+	/* Whole sectors, so that each request is processed on its own */
+	chunk = sizeof(ctx->scsi_buf[0]);
+	if (lun->sector_size) {
+		chunk -= chunk % lun->sector_size;
+	}
+
+	ep = msc_get_bulk_out(ctx->class_node);
+
+	while (ctx->scsi_count < MSC_NUM_SCSI_BUFS &&
+	       ctx->requested_data < ctx->write_len) {
+		idx = (ctx->scsi_head + ctx->scsi_count) % MSC_NUM_SCSI_BUFS;
+		len = MIN(chunk, ctx->write_len - ctx->requested_data);
+		buf = msc_scsi_buf_alloc(ctx, ep, idx, len);
+		/* The pool is large enough to support all allocations. Failing
+		 * alloc indicates either a memory leak or logic error.
+		 */
+		__ASSERT_NO_MSG(buf);
+
+		ret = usbd_ep_enqueue(ctx->class_node, buf);
+		if (ret) {
+			LOG_ERR("Failed to enqueue net_buf for 0x%02x", ep);
+			net_buf_unref(buf);
+			return;
+		}
+
+		ctx->scsi_bytes[idx] = len;
+		ctx->scsi_count++;
+		ctx->out_queued++;
+		ctx->requested_data += len;
 	}
 }
 
@@ -307,15 +426,18 @@ static void msc_process_cbw(struct msc_bot_ctx *ctx)
 	int cb_len;
 
 	cb_len = scsi_usb_boot_cmd_len(ctx->cbw.CBWCB, ctx->cbw.bCBWCBLength);
-	data_len = scsi_cmd(lun, ctx->cbw.CBWCB, cb_len, ctx->scsi_buf);
-	ctx->scsi_bytes = data_len;
-	ctx->scsi_offset = 0;
+	data_len = scsi_cmd(lun, ctx->cbw.CBWCB, cb_len, ctx->scsi_buf[0]);
+	ctx->scsi_head = 0;
+	ctx->scsi_count = data_len ? 1 : 0;
+	ctx->scsi_bytes[0] = data_len;
+	ctx->write_len = scsi_cmd_remaining_data_len(lun);
+	ctx->requested_data = 0;
 	cmd_is_data_read = scsi_cmd_is_data_read(lun);
 	cmd_is_data_write = scsi_cmd_is_data_write(lun);
 	data_len += scsi_cmd_remaining_data_len(lun);
 
 	/* Write commands must not return any data to initiator (host) */
-	__ASSERT_NO_MSG(cmd_is_data_read || ctx->scsi_bytes == 0);
+	__ASSERT_NO_MSG(cmd_is_data_read || ctx->scsi_count == 0);
 
 	if (ctx->cbw.dCBWDataTransferLength == 0) {
 		/* 6.7.1 Hn - Host expects no data transfers */
@@ -384,56 +506,39 @@ static void msc_process_cbw(struct msc_bot_ctx *ctx)
 static void msc_process_write(struct msc_bot_ctx *ctx,
 			      uint8_t *buf, size_t len)
 {
-	size_t tmp;
 	struct scsi_ctx *lun = &ctx->luns[ctx->cbw.bCBWLUN];
+	bool short_packet;
+	size_t tmp;
 
-	ctx->transferred_data += len;
-
-	while ((len > 0) && (scsi_cmd_remaining_data_len(lun) > 0)) {
-		/* Copy received data to the end of SCSI buffer */
-		tmp = MIN(len, sizeof(ctx->scsi_buf) - ctx->scsi_bytes);
-		memcpy(&ctx->scsi_buf[ctx->scsi_bytes], buf, tmp);
-		ctx->scsi_bytes += tmp;
-		buf += tmp;
-		len -= tmp;
-
-		/* Pass data to SCSI layer when either all transfer data bytes
-		 * have been received or SCSI buffer is full.
-		 */
-		while ((ctx->scsi_bytes >= scsi_cmd_remaining_data_len(lun)) ||
-		       (ctx->scsi_bytes == sizeof(ctx->scsi_buf))) {
-			tmp = scsi_write_data(lun, ctx->scsi_buf, ctx->scsi_bytes);
-			__ASSERT(tmp <= ctx->scsi_bytes,
-				 "Processed more data than requested");
-			if (tmp == 0) {
-				LOG_WRN("SCSI handler didn't process %d bytes",
-					ctx->scsi_bytes);
-				ctx->scsi_bytes = 0;
-			} else {
-				LOG_DBG("SCSI processed %d out of %d bytes",
-					tmp, ctx->scsi_bytes);
-			}
+	/* The requests complete in order, this is the oldest SCSI buffer */
+	__ASSERT_NO_MSG(ctx->scsi_count && buf == ctx->scsi_buf[ctx->scsi_head]);
+	short_packet = len < ctx->scsi_bytes[ctx->scsi_head];
+	ctx->scsi_head = (ctx->scsi_head + 1) % MSC_NUM_SCSI_BUFS;
+	ctx->scsi_count--;
 
-			ctx->csw.dCSWDataResidue -= tmp;
-			if (scsi_cmd_remaining_data_len(lun) == 0) {
-				/* Abandon any leftover data */
-				ctx->scsi_bytes = 0;
-				break;
-			}
+	ctx->transferred_data += len;
 
-			/* Move remaining data at the start of SCSI buffer. Note
-			 * that the copied length here is zero (and thus no copy
-			 * happens) when underlying sector size is equal to SCSI
-			 * buffer size.
-			 */
-			memmove(ctx->scsi_buf, &ctx->scsi_buf[tmp], ctx->scsi_bytes - tmp);
-			ctx->scsi_bytes -= tmp;
+	/* Pass data to SCSI layer, the next buffer is received meanwhile */
+	if (len > 0 && scsi_cmd_remaining_data_len(lun) > 0) {
+		tmp = scsi_write_data(lun, buf, len);
+		__ASSERT(tmp <= len, "Processed more data than requested");
+		if (tmp < len) {
+			LOG_WRN("SCSI handler didn't process %d bytes",
+				len - tmp);
+		} else {
+			LOG_DBG("SCSI processed %d bytes", tmp);
 		}
+
+		ctx->csw.dCSWDataResidue -= tmp;
 	}
 
+	/* A short packet ends the data the host sends, leftover requests
+	 * receive the next CBW
+	 */
 	if ((ctx->transferred_data >= ctx->cbw.dCBWDataTransferLength) ||
-	    (scsi_cmd_remaining_data_len(lun) == 0)) {
-		if (ctx->transferred_data < ctx->cbw.dCBWDataTransferLength) {
+	    (scsi_cmd_remaining_data_len(lun) == 0) || short_packet) {
+		if (ctx->transferred_data < ctx->cbw.dCBWDataTransferLength &&
+		    !short_packet) {
 			/* Case (11) Ho > Do and the transfer is still in
 			 * progress. We do not intend to process more data so
 			 * stall the Bulk-Out pipe.
@@ -504,7 +609,14 @@ static void msc_handle_bulk_in(struct msc_bot_ctx *ctx,
 		struct scsi_ctx *lun = &ctx->luns[ctx->cbw.bCBWLUN];
 
 		ctx->transferred_data += len;
-		if (ctx->scsi_bytes == 0) {
+		if (ctx->scsi_count) {
+			/* The buffer sent can be reused now */
+			ctx->scsi_head = (ctx->scsi_head + 1) % MSC_NUM_SCSI_BUFS;
+			ctx->scsi_count--;
+		}
+
+		if (ctx->scsi_count == 0 &&
+		    scsi_cmd_remaining_data_len(lun) == 0) {
 			if (ctx->csw.dCSWDataResidue > 0) {
 				/* Case (5) Hi > Di
 				 * While we may have sent short packet, device
@@ -582,7 +694,11 @@ static void usbd_msc_handle_request(struct usbd_class_node *node,
 
 ep_request_error:
 	if (bi->ep == msc_get_bulk_out(node)) {
-		atomic_clear_bit(&ctx->bits, MSC_BULK_OUT_QUEUED);
+		if (msc_is_scsi_buf(buf)) {
+			ctx->out_queued--;
+		} else {
+			atomic_clear_bit(&ctx->bits, MSC_BULK_OUT_QUEUED);
+		}
 	} else if (bi->ep == msc_get_bulk_in(node)) {
 		atomic_clear_bit(&ctx->bits, MSC_BULK_IN_QUEUED);
 	}
@@ -613,10 +729,13 @@ static void usbd_msc_thread(void *arg1, void *arg2, void *arg3)
 
 		switch (ctx->state) {
 		case MSC_BBB_EXPECT_CBW:
-		case MSC_BBB_PROCESS_WRITE:
 			/* Ensure we can accept next OUT packet */
 			msc_queue_bulk_out_ep(evt.node);
 			break;
+		case MSC_BBB_PROCESS_WRITE:
+			/* Keep receiving while the data is written */
+			msc_queue_write(ctx);
+			break;
 		default:
 			break;
 		}
@@ -635,7 +754,7 @@ static void usbd_msc_thread(void *arg1, void *arg2, void *arg3)
 		if (ctx->state == MSC_BBB_PROCESS_READ) {
 			msc_process_read(ctx);
 		} else if (ctx->state == MSC_BBB_PROCESS_WRITE) {
-			msc_queue_bulk_out_ep(evt.node);
+			msc_queue_write(ctx);
 		} else if (ctx->state == MSC_BBB_SEND_CSW) {
 			msc_send_csw(ctx);
 		}
@@ -72,6 +72,7 @@ enum scsi_opcode {
 	READ_CAPACITY_10 = 0x25,
 	READ_10 = 0x28,
 	WRITE_10 = 0x2A,
+	SYNCHRONIZE_CACHE_10 = 0x35,
 	MODE_SENSE_10 = 0x5A,
 };
 
@@ -301,6 +302,15 @@ SCSI_CMD_STRUCT(WRITE_10) {
 	uint8_t control;
 } __packed;
 
+SCSI_CMD_STRUCT(SYNCHRONIZE_CACHE_10) {
+	uint8_t opcode;
+	uint8_t immed;
+	uint32_t lba;
+	uint8_t group_number;
+	uint16_t number_of_blocks;
+	uint8_t control;
+} __packed;
+
 SCSI_CMD_STRUCT(MODE_SENSE_10) {
 	uint8_t opcode;
 	uint8_t llbaa_dbd;
@@ -797,6 +807,23 @@ SCSI_CMD_HANDLER(WRITE_10)
 	return good(ctx, 0);
 }
 
+/* SBC-4 5.31 SYNCHRONIZE CACHE (10) command
+ * The whole cache of the disk is written back, regardless of the range.
+ */
+SCSI_CMD_HANDLER(SYNCHRONIZE_CACHE_10)
+{
+	if (!ctx->medium_loaded || update_disk_info(ctx) != DISK_STATUS_OK) {
+		return not_ready(ctx, MEDIUM_NOT_PRESENT);
+	}
+
+	if (disk_access_ioctl(ctx->disk, DISK_IOCTL_CTRL_SYNC, NULL)) {
+		LOG_ERR("Disk cache sync failed");
+		return medium_error(ctx, WRITE_ERROR);
+	}
+
+	return good(ctx, 0);
+}
+
 /* SPC-5 6.15 MODE SENSE(10) command */
 SCSI_CMD_HANDLER(MODE_SENSE_10)
 {
@@ -876,6 +903,7 @@ size_t scsi_cmd(struct scsi_ctx *ctx, const uint8_t *cb, int len,
 	SCSI_CMD(READ_CAPACITY_10);
 	SCSI_CMD(READ_10);
 	SCSI_CMD(WRITE_10);
+	SCSI_CMD(SYNCHRONIZE_CACHE_10);
 	SCSI_CMD(MODE_SENSE_10);
 
 	LOG_ERR("Unknown SCSI opcode 0x%02x", cb[0]);
@@ -19,6 +19,7 @@
 #include "usbd_ch9.h"
 #include "usbd_class.h"
 #include "usbd_class_api.h"
+#include "usbd_endpoint.h"
 
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(usbd_core, CONFIG_USBD_LOG_LEVEL);
@@ -46,6 +47,10 @@ static int event_handler_ep_request(struct usbd_contex *const uds_ctx,
 	if (USB_EP_GET_IDX(bi->ep) == 0) {
 		ret = usbd_handle_ctrl_xfer(uds_ctx, event->buf, bi->err);
 	} else {
+		if (IS_ENABLED(CONFIG_USBD_EP_STATS)) {
+			usbd_ep_stats_completed(uds_ctx, event->buf, bi->err);
+		}
+
 		ret = usbd_class_handle_xfer(uds_ctx, event->buf, bi->err);
 	}
 
@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <string.h>
 #include <zephyr/sys/util.h>
 #include <zephyr/drivers/usb/udc.h>
 #include <zephyr/usb/usbd.h>
@@ -82,6 +83,83 @@ static void usbd_ep_ctrl_set_zlp(struct usbd_contex *const uds_ctx,
 	}
 }
 
+#if defined(CONFIG_USBD_EP_STATS)
+static struct usbd_ep_stats *usbd_ep_get_stats(struct usbd_contex *const uds_ctx,
+					       const uint8_t ep)
+{
+	if (USB_EP_DIR_IS_IN(ep)) {
+		return &uds_ctx->ep_stats[USB_EP_GET_IDX(ep) + 16U];
+	}
+
+	return &uds_ctx->ep_stats[USB_EP_GET_IDX(ep)];
+}
+
+static void usbd_ep_stats_queued(struct usbd_contex *const uds_ctx,
+				 const uint8_t ep)
+{
+	struct usbd_ep_stats *stats = usbd_ep_get_stats(uds_ctx, ep);
+	k_spinlock_key_t key = k_spin_lock(&uds_ctx->ep_stats_lock);
+	uint32_t now = k_cycle_get_32();
+
+	if (stats->since == 0) {
+		stats->since = k_uptime_get();
+		stats->timestamp = now;
+	}
+
+	if (stats->pending == 0) {
+		/* End of the idle period, the request is the oldest one */
+		stats->idle += now - stats->timestamp;
+		stats->timestamp = now;
+	}
+
+	stats->pending++;
+	stats->max_pending = MAX(stats->max_pending, stats->pending);
+
+	k_spin_unlock(&uds_ctx->ep_stats_lock, key);
+}
+
+static void usbd_ep_stats_unqueued(struct usbd_contex *const uds_ctx,
+				   const uint8_t ep)
+{
+	struct usbd_ep_stats *stats = usbd_ep_get_stats(uds_ctx, ep);
+	k_spinlock_key_t key = k_spin_lock(&uds_ctx->ep_stats_lock);
+
+	stats->pending--;
+
+	k_spin_unlock(&uds_ctx->ep_stats_lock, key);
+}
+
+void usbd_ep_stats_completed(struct usbd_contex *const uds_ctx,
+			     const struct net_buf *const buf, const int err)
+{
+	struct udc_buf_info *bi = udc_get_buf_info(buf);
+	struct usbd_ep_stats *stats = usbd_ep_get_stats(uds_ctx, bi->ep);
+	k_spinlock_key_t key = k_spin_lock(&uds_ctx->ep_stats_lock);
+	uint32_t now = k_cycle_get_32();
+
+	if (stats->pending == 0) {
+		/* Not queued with usbd_ep_enqueue() */
+		k_spin_unlock(&uds_ctx->ep_stats_lock, key);
+		return;
+	}
+
+	stats->requests++;
+	if (err) {
+		stats->errors++;
+	} else {
+		stats->bytes += buf->len;
+	}
+
+	/* The requests of an endpoint complete in order */
+	stats->latency = now - stats->timestamp;
+	stats->max_latency = MAX(stats->max_latency, stats->latency);
+	stats->timestamp = now;
+	stats->pending--;
+
+	k_spin_unlock(&uds_ctx->ep_stats_lock, key);
+}
+#endif
+
 /*
  * All the functions below are part of public USB device support API.
  */
@@ -133,6 +211,7 @@ int usbd_ep_enqueue(const struct usbd_class_node *const c_nd,
 {
 	struct usbd_contex *uds_ctx = c_nd->data->uds_ctx;
 	struct udc_buf_info *bi = udc_get_buf_info(buf);
+	int ret;
 
 	if (USB_EP_DIR_IS_IN(bi->ep)) {
 		if (usbd_is_suspended(uds_ctx)) {
@@ -142,7 +221,18 @@ int usbd_ep_enqueue(const struct usbd_class_node *const c_nd,
 
 	bi->owner = (void *)c_nd;
 
-	return udc_ep_enqueue(uds_ctx->dev, buf);
+#if defined(CONFIG_USBD_EP_STATS)
+	/* Accounted before, the request may complete before it returns */
+	usbd_ep_stats_queued(uds_ctx, bi->ep);
+	ret = udc_ep_enqueue(uds_ctx->dev, buf);
+	if (ret) {
+		usbd_ep_stats_unqueued(uds_ctx, bi->ep);
+	}
+#else
+	ret = udc_ep_enqueue(uds_ctx->dev, buf);
+#endif
+
+	return ret;
 }
 
 int usbd_ep_buf_free(struct usbd_contex *const uds_ctx, struct net_buf *buf)
@@ -150,6 +240,46 @@ int usbd_ep_buf_free(struct usbd_contex *const uds_ctx, struct net_buf *buf)
 	return udc_ep_buf_free(uds_ctx->dev, buf);
 }
 
+int usbd_ep_stats_get(struct usbd_contex *const uds_ctx, const uint8_t ep,
+		      struct usbd_ep_stats *const stats)
+{
+#if defined(CONFIG_USBD_EP_STATS)
+	k_spinlock_key_t key = k_spin_lock(&uds_ctx->ep_stats_lock);
+
+	*stats = *usbd_ep_get_stats(uds_ctx, ep);
+
+	k_spin_unlock(&uds_ctx->ep_stats_lock, key);
+
+	return 0;
+#else
+	return -ENOTSUP;
+#endif
+}
+
+int usbd_ep_stats_reset(struct usbd_contex *const uds_ctx, const uint8_t ep)
+{
+#if defined(CONFIG_USBD_EP_STATS)
+	struct usbd_ep_stats *stats = usbd_ep_get_stats(uds_ctx, ep);
+	k_spinlock_key_t key = k_spin_lock(&uds_ctx->ep_stats_lock);
+	uint32_t pending = stats->pending;
+
+	memset(stats, 0, sizeof(*stats));
+	stats->pending = pending;
+	stats->max_pending = pending;
+	if (pending) {
+		/* The oldest pending request is timed from now on */
+		stats->since = k_uptime_get();
+		stats->timestamp = k_cycle_get_32();
+	}
+
+	k_spin_unlock(&uds_ctx->ep_stats_lock, key);
+
+	return 0;
+#else
+	return -ENOTSUP;
+#endif
+}
+
 int usbd_ep_dequeue(struct usbd_contex *const uds_ctx, const uint8_t ep)
 {
 	return udc_ep_dequeue(uds_ctx->dev, ep);
@@ -96,4 +96,16 @@ int usbd_ep_disable(const struct device *dev,
 		    const uint8_t ep,
 		    uint32_t *const ep_bm);
 
+/**
+ * @brief Account a completed request in the endpoint statistics
+ *
+ * Called on completion, before the request is handed over to the class.
+ *
+ * @param[in] uds_ctx Pointer to USB device support context
+ * @param[in] buf     Pointer to UDC request buffer
+ * @param[in] err     Transfer result
+ */
+void usbd_ep_stats_completed(struct usbd_contex *const uds_ctx,
+			     const struct net_buf *const buf, const int err);
+
 #endif /* ZEPHYR_INCLUDE_USBD_ENDPOINT_H */
@@ -415,6 +415,54 @@ static int cmd_config_power(const struct shell *sh, size_t argc,
 	return ret;
 }
 
+static int cmd_ep_stats(const struct shell *sh, size_t argc,
+			char *argv[])
+{
+	struct usbd_ep_stats stats;
+	int64_t elapsed;
+	uint8_t ep;
+	int ret;
+
+	ep = strtol(argv[1], NULL, 16);
+	ret = usbd_ep_stats_get(my_uds_ctx, ep, &stats);
+	if (ret) {
+		shell_error(sh, "dev: failed to get ep 0x%02x statistics", ep);
+		return ret;
+	}
+
+	elapsed = stats.since ? k_uptime_get() - stats.since : 0;
+
+	shell_print(sh, "ep 0x%02x", ep);
+	shell_print(sh, "requests %u errors %u bytes %llu",
+		    stats.requests, stats.errors, stats.bytes);
+	shell_print(sh, "pending %u max %u",
+		    stats.pending, stats.max_pending);
+	shell_print(sh, "latency us %u max %u",
+		    k_cyc_to_us_floor32(stats.latency),
+		    k_cyc_to_us_floor32(stats.max_latency));
+	shell_print(sh, "idle ms %llu of %lld",
+		    k_cyc_to_ms_floor64(stats.idle), elapsed);
+	shell_print(sh, "throughput B/s %llu",
+		    elapsed ? stats.bytes * 1000U / elapsed : 0);
+
+	return 0;
+}
+
+static int cmd_ep_reset(const struct shell *sh, size_t argc,
+			char *argv[])
+{
+	uint8_t ep;
+	int ret;
+
+	ep = strtol(argv[1], NULL, 16);
+	ret = usbd_ep_stats_reset(my_uds_ctx, ep);
+	if (ret) {
+		shell_error(sh, "dev: failed to reset ep 0x%02x statistics", ep);
+	}
+
+	return ret;
+}
+
 static void class_node_name_lookup(size_t idx, struct shell_static_entry *entry)
 {
 	size_t match_idx = 0;
@@ -496,6 +544,14 @@ SHELL_STATIC_SUBCMD_SET_CREATE(class_cmds,
 	SHELL_SUBCMD_SET_END
 );
 
+SHELL_STATIC_SUBCMD_SET_CREATE(ep_cmds,
+	SHELL_CMD_ARG(stats, NULL, "<endpoint>",
+		      cmd_ep_stats, 2, 0),
+	SHELL_CMD_ARG(reset, NULL, "<endpoint>",
+		      cmd_ep_reset, 2, 0),
+	SHELL_SUBCMD_SET_END
+);
+
 SHELL_STATIC_SUBCMD_SET_CREATE(sub_usbd_cmds,
 	SHELL_CMD_ARG(wakeup, NULL, "[none]",
 		      cmd_wakeup_request, 1, 0),
@@ -519,6 +575,8 @@ SHELL_STATIC_SUBCMD_SET_CREATE(sub_usbd_cmds,
 		      NULL, 1, 0),
 	SHELL_CMD_ARG(class, &class_cmds, "class commands",
 		      NULL, 1, 0),
+	SHELL_COND_CMD_ARG(CONFIG_USBD_EP_STATS, ep, &ep_cmds,
+			   "endpoint statistics commands", NULL, 1, 0),
 	SHELL_SUBCMD_SET_END
 );
 
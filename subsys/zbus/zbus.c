@@ -3,12 +3,132 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <zephyr/init.h>
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
+#include <zephyr/sys/barrier.h>
 #include <zephyr/sys/printk.h>
 #include <zephyr/zbus/zbus.h>
 LOG_MODULE_REGISTER(zbus, CONFIG_ZBUS_LOG_LEVEL);
 
+#if defined(CONFIG_ZBUS_MSG_SUBSCRIBER)
+NET_BUF_POOL_VAR_DEFINE(_zbus_msg_subscribers_pool, CONFIG_ZBUS_MSG_SUBSCRIBER_NET_BUF_POOL_SIZE,
+			CONFIG_ZBUS_MSG_SUBSCRIBER_NET_BUF_POOL_DATA_SIZE,
+			sizeof(const struct zbus_channel *), NULL);
+
+/* Queue a reference to the snapshot of the message, taken for the first message subscriber */
+static int _zbus_deliver_msg(const struct zbus_channel *chan, const struct zbus_observer *obs,
+			     struct net_buf **snapshot, k_timepoint_t end_time)
+{
+	struct net_buf *buf;
+
+	if (*snapshot == NULL) {
+		*snapshot = net_buf_alloc_len(&_zbus_msg_subscribers_pool, chan->message_size,
+					      sys_timepoint_timeout(end_time));
+		if (*snapshot == NULL) {
+			return -ENOMEM;
+		}
+
+		net_buf_add_mem(*snapshot, chan->message, chan->message_size);
+	}
+
+	/* The clones share the data of the snapshot, each one is in its own FIFO */
+	buf = net_buf_clone(*snapshot, sys_timepoint_timeout(end_time));
+	if (buf == NULL) {
+		return -ENOMEM;
+	}
+
+	*(const struct zbus_channel **)net_buf_user_data(buf) = chan;
+	net_buf_put(obs->message_fifo, buf);
+
+	return 0;
+}
+#endif /* CONFIG_ZBUS_MSG_SUBSCRIBER */
+
+#if defined(CONFIG_ZBUS_ASYNC_LISTENER)
+#if defined(CONFIG_ZBUS_ASYNC_LISTENER_DEDICATED_WORK_QUEUE)
+static K_THREAD_STACK_DEFINE(_zbus_work_q_stack, CONFIG_ZBUS_ASYNC_LISTENER_WORK_QUEUE_STACK_SIZE);
+static struct k_work_q _zbus_work_q;
+
+static int _zbus_work_q_init(void)
+{
+	const struct k_work_queue_config cfg = {.name = "zbus_wq"};
+
+	k_work_queue_init(&_zbus_work_q);
+	k_work_queue_start(&_zbus_work_q, _zbus_work_q_stack,
+			   K_THREAD_STACK_SIZEOF(_zbus_work_q_stack),
+			   CONFIG_ZBUS_ASYNC_LISTENER_WORK_QUEUE_PRIORITY, &cfg);
+
+	return 0;
+}
+
+SYS_INIT(_zbus_work_q_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
+
+#define _ZBUS_WORK_Q (&_zbus_work_q)
+#else
+#define _ZBUS_WORK_Q (&k_sys_work_q)
+#endif /* CONFIG_ZBUS_ASYNC_LISTENER_DEDICATED_WORK_QUEUE */
+
+void _zbus_async_listener_handler(struct k_work *work)
+{
+	struct zbus_async_listener_work *async =
+		CONTAINER_OF(work, struct zbus_async_listener_work, work);
+	const struct zbus_channel *chan;
+
+	/* A single run may follow several notifications */
+	while (k_msgq_get(async->queue, &chan, K_NO_WAIT) == 0) {
+		async->obs->callback(chan);
+	}
+}
+
+static int _zbus_deliver_async(const struct zbus_channel *chan, const struct zbus_observer *obs,
+			       k_timepoint_t end_time)
+{
+	int err;
+
+	err = k_msgq_put(obs->async->queue, &chan, sys_timepoint_timeout(end_time));
+	if (err) {
+		return err;
+	}
+
+	err = k_work_submit_to_queue(_ZBUS_WORK_Q, &obs->async->work);
+
+	return err < 0 ? err : 0;
+}
+#endif /* CONFIG_ZBUS_ASYNC_LISTENER */
+
+#if defined(CONFIG_ZBUS_CHANNEL_STATS)
+/* Called with the channel's mutex held, as all the updates of the statistics */
+static void _zbus_stats_notified(const struct zbus_channel *chan, uint32_t start)
+{
+	struct zbus_channel_stats *stats = chan->stats;
+	uint32_t cycles = k_cycle_get_32() - start;
+
+	stats->notify_count++;
+	stats->notify_cycles_total += cycles;
+	stats->notify_cycles_max = MAX(stats->notify_cycles_max, cycles);
+}
+#endif /* CONFIG_ZBUS_CHANNEL_STATS */
+
+static inline void _zbus_call_listener(const struct zbus_channel *chan,
+				       const struct zbus_observer *obs)
+{
+#if defined(CONFIG_ZBUS_CHANNEL_STATS)
+	struct zbus_channel_stats *stats = chan->stats;
+	uint32_t start = k_cycle_get_32();
+	uint32_t cycles;
+
+	obs->callback(chan);
+
+	cycles = k_cycle_get_32() - start;
+	stats->listener_count++;
+	stats->listener_cycles_total += cycles;
+	stats->listener_cycles_max = MAX(stats->listener_cycles_max, cycles);
+#else
+	obs->callback(chan);
+#endif /* CONFIG_ZBUS_CHANNEL_STATS */
+}
+
 #if (CONFIG_ZBUS_RUNTIME_OBSERVERS_POOL_SIZE > 0)
 static inline void _zbus_notify_runtime_listeners(const struct zbus_channel *chan)
 {
@@ -20,13 +140,15 @@ static inline void _zbus_notify_runtime_listeners(const struct zbus_channel *cha
 
 		__ASSERT(obs_nd != NULL, "observer node is NULL");
 
-		if (obs_nd->obs->enabled && (obs_nd->obs->callback != NULL)) {
-			obs_nd->obs->callback(chan);
+		if (obs_nd->obs->enabled && (obs_nd->obs->callback != NULL) &&
+		    !_ZBUS_OBS_IS_ASYNC(obs_nd->obs)) {
+			_zbus_call_listener(chan, obs_nd->obs);
 		}
 	}
 }
 
 static inline int _zbus_notify_runtime_subscribers(const struct zbus_channel *chan,
+						   struct net_buf **snapshot,
 						   k_timepoint_t end_time)
 {
 	__ASSERT(chan != NULL, "chan is required");
@@ -50,6 +172,34 @@ static inline int _zbus_notify_runtime_subscribers(const struct zbus_channel *ch
 				last_error = err;
 			}
 		}
+
+#if defined(CONFIG_ZBUS_MSG_SUBSCRIBER)
+		if (obs_nd->obs->enabled && (obs_nd->obs->message_fifo != NULL)) {
+			err = _zbus_deliver_msg(chan, obs_nd->obs, snapshot, end_time);
+
+			_ZBUS_ASSERT(err == 0,
+				     "could not deliver message to observer %s. Error code %d",
+				     _ZBUS_OBS_NAME(obs_nd->obs), err);
+
+			if (err) {
+				last_error = err;
+			}
+		}
+#endif /* CONFIG_ZBUS_MSG_SUBSCRIBER */
+
+#if defined(CONFIG_ZBUS_ASYNC_LISTENER)
+		if (obs_nd->obs->enabled && _ZBUS_OBS_IS_ASYNC(obs_nd->obs)) {
+			err = _zbus_deliver_async(chan, obs_nd->obs, end_time);
+
+			_ZBUS_ASSERT(err == 0,
+				     "could not deliver notification to observer %s. Error code %d",
+				     _ZBUS_OBS_NAME(obs_nd->obs), err);
+
+			if (err) {
+				last_error = err;
+			}
+		}
+#endif /* CONFIG_ZBUS_ASYNC_LISTENER */
 	}
 
 	return last_error;
@@ -59,10 +209,17 @@ static inline int _zbus_notify_runtime_subscribers(const struct zbus_channel *ch
 static int _zbus_notify_observers(const struct zbus_channel *chan, k_timepoint_t end_time)
 {
 	int last_error = 0, err;
+#if defined(CONFIG_ZBUS_MSG_SUBSCRIBER)
+	struct net_buf *msg_buf = NULL;
+	struct net_buf **snapshot = &msg_buf;
+#else
+	struct net_buf **snapshot __maybe_unused = NULL;
+#endif /* CONFIG_ZBUS_MSG_SUBSCRIBER */
+
 	/* Notify static listeners */
 	for (const struct zbus_observer *const *obs = chan->observers; *obs != NULL; ++obs) {
-		if ((*obs)->enabled && ((*obs)->callback != NULL)) {
-			(*obs)->callback(chan);
+		if ((*obs)->enabled && ((*obs)->callback != NULL) && !_ZBUS_OBS_IS_ASYNC(*obs)) {
+			_zbus_call_listener(chan, *obs);
 		}
 	}
 
@@ -82,21 +239,92 @@ static int _zbus_notify_observers(const struct zbus_channel *chan, k_timepoint_t
 				last_error = err;
 			}
 		}
+
+#if defined(CONFIG_ZBUS_MSG_SUBSCRIBER)
+		if ((*obs)->enabled && ((*obs)->message_fifo != NULL)) {
+			err = _zbus_deliver_msg(chan, *obs, snapshot, end_time);
+			if (err) {
+				LOG_ERR("Observer %s at %p could not be given the message. Error code %d",
+					_ZBUS_OBS_NAME(*obs), *obs, err);
+				last_error = err;
+			}
+		}
+#endif /* CONFIG_ZBUS_MSG_SUBSCRIBER */
+
+#if defined(CONFIG_ZBUS_ASYNC_LISTENER)
+		/* Asynchronous listeners are notified along with the subscribers */
+		if ((*obs)->enabled && _ZBUS_OBS_IS_ASYNC(*obs)) {
+			err = _zbus_deliver_async(chan, *obs, end_time);
+			if (err) {
+				LOG_ERR("Observer %s at %p could not be notified. Error code %d",
+					_ZBUS_OBS_NAME(*obs), *obs, err);
+				last_error = err;
+			}
+		}
+#endif /* CONFIG_ZBUS_ASYNC_LISTENER */
 	}
 
 #if CONFIG_ZBUS_RUNTIME_OBSERVERS_POOL_SIZE > 0
-	err = _zbus_notify_runtime_subscribers(chan, end_time);
+	err = _zbus_notify_runtime_subscribers(chan, snapshot, end_time);
 	if (err) {
 		last_error = err;
 	}
 #endif /* CONFIG_ZBUS_RUNTIME_OBSERVERS_POOL_SIZE */
+
+#if defined(CONFIG_ZBUS_MSG_SUBSCRIBER)
+	/* The snapshot is freed once all the message subscribers are done with it */
+	if (msg_buf != NULL) {
+		net_buf_unref(msg_buf);
+	}
+#endif /* CONFIG_ZBUS_MSG_SUBSCRIBER */
 	return last_error;
 }
 
+#if defined(CONFIG_ZBUS_CHANNEL_SEQLOCK)
+/* Make the sequence odd before changing the message, and even again after */
+static inline void _zbus_seq_change(const struct zbus_channel *chan)
+{
+	if (chan->seq != NULL) {
+		barrier_dmem_fence_full();
+		atomic_inc(chan->seq);
+		barrier_dmem_fence_full();
+	}
+}
+
+/* Copy the message without the mutex, false if it is being changed or kept changing */
+static bool _zbus_seq_read(const struct zbus_channel *chan, void *msg)
+{
+	atomic_val_t seq;
+
+	for (int i = 0; i < CONFIG_ZBUS_CHANNEL_SEQLOCK_READ_RETRIES; i++) {
+		seq = atomic_get(chan->seq);
+		if ((seq & 1) != 0) {
+			/* The publisher may be preempted, wait for it on the mutex */
+			return false;
+		}
+
+		barrier_dmem_fence_full();
+		memcpy(msg, chan->message, chan->message_size);
+		barrier_dmem_fence_full();
+
+		if (atomic_get(chan->seq) == seq) {
+			return true;
+		}
+	}
+
+	return false;
+}
+#else
+#define _zbus_seq_change(_chan)
+#endif /* CONFIG_ZBUS_CHANNEL_SEQLOCK */
+
 int zbus_chan_pub(const struct zbus_channel *chan, const void *msg, k_timeout_t timeout)
 {
 	int err;
 	k_timepoint_t end_time = sys_timepoint_calc(timeout);
+#if defined(CONFIG_ZBUS_CHANNEL_STATS)
+	uint32_t start = k_cycle_get_32();
+#endif /* CONFIG_ZBUS_CHANNEL_STATS */
 
 	_ZBUS_ASSERT(!k_is_in_isr(), "zbus cannot be used inside ISRs");
 	_ZBUS_ASSERT(chan != NULL, "chan is required");
@@ -111,10 +339,16 @@ int zbus_chan_pub(const struct zbus_channel *chan, const void *msg, k_timeout_t
 		return err;
 	}
 
+	_zbus_seq_change(chan);
 	memcpy(chan->message, msg, chan->message_size);
+	_zbus_seq_change(chan);
 
 	err = _zbus_notify_observers(chan, end_time);
 
+#if defined(CONFIG_ZBUS_CHANNEL_STATS)
+	_zbus_stats_notified(chan, start);
+#endif /* CONFIG_ZBUS_CHANNEL_STATS */
+
 	k_mutex_unlock(chan->mutex);
 
 	return err;
@@ -128,6 +362,12 @@ int zbus_chan_read(const struct zbus_channel *chan, void *msg, k_timeout_t timeo
 	_ZBUS_ASSERT(chan != NULL, "chan is required");
 	_ZBUS_ASSERT(msg != NULL, "msg is required");
 
+#if defined(CONFIG_ZBUS_CHANNEL_SEQLOCK)
+	if (chan->seq != NULL && _zbus_seq_read(chan, msg)) {
+		return 0;
+	}
+#endif /* CONFIG_ZBUS_CHANNEL_SEQLOCK */
+
 	err = k_mutex_lock(chan->mutex, timeout);
 	if (err) {
 		return err;
@@ -142,6 +382,9 @@ int zbus_chan_notify(const struct zbus_channel *chan, k_timeout_t timeout)
 {
 	int err;
 	k_timepoint_t end_time = sys_timepoint_calc(timeout);
+#if defined(CONFIG_ZBUS_CHANNEL_STATS)
+	uint32_t start = k_cycle_get_32();
+#endif /* CONFIG_ZBUS_CHANNEL_STATS */
 
 	_ZBUS_ASSERT(!k_is_in_isr(), "zbus cannot be used inside ISRs");
 	_ZBUS_ASSERT(chan != NULL, "chan is required");
@@ -153,6 +396,10 @@ int zbus_chan_notify(const struct zbus_channel *chan, k_timeout_t timeout)
 
 	err = _zbus_notify_observers(chan, end_time);
 
+#if defined(CONFIG_ZBUS_CHANNEL_STATS)
+	_zbus_stats_notified(chan, start);
+#endif /* CONFIG_ZBUS_CHANNEL_STATS */
+
 	k_mutex_unlock(chan->mutex);
 
 	return err;
@@ -169,6 +416,9 @@ int zbus_chan_claim(const struct zbus_channel *chan, k_timeout_t timeout)
 		return err;
 	}
 
+	/* The message may be changed in place until the channel is finished */
+	_zbus_seq_change(chan);
+
 	return 0;
 }
 
@@ -177,11 +427,56 @@ int zbus_chan_finish(const struct zbus_channel *chan)
 	_ZBUS_ASSERT(!k_is_in_isr(), "zbus cannot be used inside ISRs");
 	_ZBUS_ASSERT(chan != NULL, "chan is required");
 
+#if defined(CONFIG_ZBUS_CHANNEL_SEQLOCK)
+	/* Only the owner changed the message, the others fail to unlock */
+	if (chan->mutex->owner == k_current_get()) {
+		_zbus_seq_change(chan);
+	}
+#endif /* CONFIG_ZBUS_CHANNEL_SEQLOCK */
+
 	int err = k_mutex_unlock(chan->mutex);
 
 	return err;
 }
 
+#if defined(CONFIG_ZBUS_CHANNEL_STATS)
+int zbus_chan_stats_get(const struct zbus_channel *chan, struct zbus_channel_stats *stats,
+			k_timeout_t timeout)
+{
+	int err;
+
+	_ZBUS_ASSERT(!k_is_in_isr(), "zbus cannot be used inside ISRs");
+	_ZBUS_ASSERT(chan != NULL, "chan is required");
+	_ZBUS_ASSERT(stats != NULL, "stats is required");
+
+	err = k_mutex_lock(chan->mutex, timeout);
+	if (err) {
+		return err;
+	}
+
+	*stats = *chan->stats;
+
+	return k_mutex_unlock(chan->mutex);
+}
+
+int zbus_chan_stats_reset(const struct zbus_channel *chan, k_timeout_t timeout)
+{
+	int err;
+
+	_ZBUS_ASSERT(!k_is_in_isr(), "zbus cannot be used inside ISRs");
+	_ZBUS_ASSERT(chan != NULL, "chan is required");
+
+	err = k_mutex_lock(chan->mutex, timeout);
+	if (err) {
+		return err;
+	}
+
+	memset(chan->stats, 0, sizeof(*chan->stats));
+
+	return k_mutex_unlock(chan->mutex);
+}
+#endif /* CONFIG_ZBUS_CHANNEL_STATS */
+
 int zbus_sub_wait(const struct zbus_observer *sub, const struct zbus_channel **chan,
 		  k_timeout_t timeout)
 {
@@ -195,3 +490,46 @@ int zbus_sub_wait(const struct zbus_observer *sub, const struct zbus_channel **c
 
 	return k_msgq_get(sub->queue, chan, timeout);
 }
+
+#if defined(CONFIG_ZBUS_MSG_SUBSCRIBER)
+int zbus_sub_wait_msg_buf(const struct zbus_observer *sub, const struct zbus_channel **chan,
+			  struct net_buf **buf, k_timeout_t timeout)
+{
+	_ZBUS_ASSERT(!k_is_in_isr(), "zbus cannot be used inside ISRs");
+	_ZBUS_ASSERT(sub != NULL, "sub is required");
+	_ZBUS_ASSERT(chan != NULL, "chan is required");
+	_ZBUS_ASSERT(buf != NULL, "buf is required");
+
+	if (sub->message_fifo == NULL) {
+		return -EINVAL;
+	}
+
+	*buf = net_buf_get(sub->message_fifo, timeout);
+	if (*buf == NULL) {
+		return K_TIMEOUT_EQ(timeout, K_NO_WAIT) ? -ENOMSG : -EAGAIN;
+	}
+
+	*chan = *(const struct zbus_channel **)net_buf_user_data(*buf);
+
+	return 0;
+}
+
+int zbus_sub_wait_msg(const struct zbus_observer *sub, const struct zbus_channel **chan, void *msg,
+		      k_timeout_t timeout)
+{
+	struct net_buf *buf;
+	int err;
+
+	_ZBUS_ASSERT(msg != NULL, "msg is required");
+
+	err = zbus_sub_wait_msg_buf(sub, chan, &buf, timeout);
+	if (err) {
+		return err;
+	}
+
+	memcpy(msg, buf->data, buf->len);
+	net_buf_unref(buf);
+
+	return 0;
+}
+#endif /* CONFIG_ZBUS_MSG_SUBSCRIBER */
@@ -16,11 +16,12 @@ struct k_mem_slab *zbus_runtime_obs_pool(void)
 	return &_zbus_runtime_obs_pool;
 }
 
-int zbus_chan_add_obs(const struct zbus_channel *chan, const struct zbus_observer *obs,
-		      k_timeout_t timeout)
+int zbus_chan_add_obs_with_prio(const struct zbus_channel *chan, const struct zbus_observer *obs,
+				uint8_t prio, k_timeout_t timeout)
 {
 	int err;
 	struct zbus_observer_node *obs_nd, *tmp;
+	struct zbus_observer_node *prev_obs_nd = NULL;
 	k_timepoint_t end_time = sys_timepoint_calc(timeout);
 
 	_ZBUS_ASSERT(!k_is_in_isr(), "ISR blocked");
@@ -40,13 +41,17 @@ int zbus_chan_add_obs(const struct zbus_channel *chan, const struct zbus_observe
 		return err;
 	}
 
-	/* Check if the observer is already a runtime observer */
+	/* Check if the observer is already a runtime observer, and find where to insert it */
 	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(chan->runtime_observers, obs_nd, tmp, node) {
 		if (obs_nd->obs == obs) {
 			k_mutex_unlock(chan->mutex);
 
 			return -EALREADY;
 		}
+
+		if (obs_nd->prio <= prio) {
+			prev_obs_nd = obs_nd;
+		}
 	}
 
 	err = k_mem_slab_alloc(&_zbus_runtime_obs_pool, (void **)&obs_nd,
@@ -61,14 +66,23 @@ int zbus_chan_add_obs(const struct zbus_channel *chan, const struct zbus_observe
 	}
 
 	obs_nd->obs = obs;
+	obs_nd->prio = prio;
 
-	sys_slist_append(chan->runtime_observers, &obs_nd->node);
+	/* After the observers of the same or higher priority */
+	sys_slist_insert(chan->runtime_observers, prev_obs_nd != NULL ? &prev_obs_nd->node : NULL,
+			 &obs_nd->node);
 
 	k_mutex_unlock(chan->mutex);
 
 	return 0;
 }
 
+int zbus_chan_add_obs(const struct zbus_channel *chan, const struct zbus_observer *obs,
+		      k_timeout_t timeout)
+{
+	return zbus_chan_add_obs_with_prio(chan, obs, ZBUS_OBS_PRIO_DEFAULT, timeout);
+}
+
 int zbus_chan_rm_obs(const struct zbus_channel *chan, const struct zbus_observer *obs,
 		     k_timeout_t timeout)
 {
@@ -21,6 +21,9 @@
 /* flag for performing the FIFO benchmark */
 #define FIFO_BENCH
 
+/* flag for performing the k_fifo benchmark */
+#define KFIFO_BENCH
+
 /* flag for performing the Mutex benchmark */
 #define MUTEX_BENCH
 
@@ -0,0 +1,68 @@
+/* kfifo_b.c */
+
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "master.h"
+
+#ifdef KFIFO_BENCH
+
+struct kfifo_item {
+	void *fifo_reserved;
+	uint32_t data;
+};
+
+static struct kfifo_item kfifo_items[NR_OF_KFIFO_RUNS];
+
+K_FIFO_DEFINE(DEMOKFIFO);
+
+/**
+ *
+ * @brief k_fifo throughput test
+ *
+ * Items are put with nobody waiting on the FIFO, which is the path
+ * CONFIG_QUEUE_LOCKFREE takes without the queue lock.
+ *
+ */
+void kfifo_test(void)
+{
+	uint32_t et; /* elapsed time */
+	int i;
+
+	PRINT_STRING(dashline);
+	et = BENCH_START();
+	for (i = 0; i < NR_OF_KFIFO_RUNS; i++) {
+		k_fifo_put(&DEMOKFIFO, &kfifo_items[i]);
+	}
+	et = TIME_STAMP_DELTA_GET(et);
+	check_result();
+
+	PRINT_F(FORMAT, "put item in k_fifo",
+		SYS_CLOCK_HW_CYCLES_TO_NS_AVG(et, NR_OF_KFIFO_RUNS));
+
+	et = BENCH_START();
+	for (i = 0; i < NR_OF_KFIFO_RUNS; i++) {
+		(void)k_fifo_get(&DEMOKFIFO, K_FOREVER);
+	}
+	et = TIME_STAMP_DELTA_GET(et);
+	check_result();
+
+	PRINT_F(FORMAT, "get item from k_fifo",
+		SYS_CLOCK_HW_CYCLES_TO_NS_AVG(et, NR_OF_KFIFO_RUNS));
+
+	et = BENCH_START();
+	for (i = 0; i < NR_OF_KFIFO_RUNS; i++) {
+		k_fifo_put(&DEMOKFIFO, &kfifo_items[i]);
+		(void)k_fifo_get(&DEMOKFIFO, K_FOREVER);
+	}
+	et = TIME_STAMP_DELTA_GET(et);
+	check_result();
+
+	PRINT_F(FORMAT, "average put and get item in k_fifo",
+		SYS_CLOCK_HW_CYCLES_TO_NS_AVG(et, NR_OF_KFIFO_RUNS));
+}
+
+#endif /* KFIFO_BENCH */
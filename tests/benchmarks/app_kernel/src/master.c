@@ -102,6 +102,7 @@ int main(void)
 			     "M E A S U R E M E N T S  |  nsec    |\n");
 		PRINT_STRING(dashline);
 		queue_test();
+		kfifo_test();
 		sema_test();
 		mutex_test();
 		memorymap_test();
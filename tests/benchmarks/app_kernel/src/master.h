@@ -37,6 +37,7 @@
 		   CONFIG_SYS_CLOCK_TICKS_PER_SEC / 10 : 1)
 #define NR_OF_NOP_RUNS 10000
 #define NR_OF_FIFO_RUNS 500
+#define NR_OF_KFIFO_RUNS 500
 #define NR_OF_SEMA_RUNS 500
 #define NR_OF_MUTEX_RUNS 1000
 #define NR_OF_POOL_RUNS 1000
@@ -97,6 +98,12 @@ extern void queue_test(void);
 #define queue_test dummy_test
 #endif
 
+#ifdef KFIFO_BENCH
+extern void kfifo_test(void);
+#else
+#define kfifo_test dummy_test
+#endif
+
 #ifdef MUTEX_BENCH
 extern void mutex_test(void);
 #else
@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+#include <zephyr/dsp/stream.h>
+#include <string.h>
+#include <arm_math.h>
+#include "../../common/benchmark_common.h"
+
+#define BLOCK_SIZE	(256)
+#define NUM_BLOCKS	(16)
+#define FIR_TAPS	(32)
+#define BIQUAD_STAGES	(2)
+
+static q15_t input[NUM_BLOCKS][BLOCK_SIZE];
+static q15_t expected[NUM_BLOCKS][BLOCK_SIZE];
+static q15_t tmp[BLOCK_SIZE];
+static q15_t output[BLOCK_SIZE];
+
+K_MEM_SLAB_DEFINE_STATIC(block_slab, BLOCK_SIZE * sizeof(q15_t), 1, 4);
+
+static q15_t fir_coeffs[FIR_TAPS];
+
+/* {b0, 0, b1, b2, a1, a2} per stage, halved for a post shift of 1 */
+static const q15_t biquad_coeffs[6 * BIQUAD_STAGES] = {
+	0x1000, 0, 0x2000, 0x1000, 0x0800, -0x0400,
+	0x1000, 0, 0x2000, 0x1000, 0x0400, -0x0200,
+};
+
+static arm_fir_instance_q15 fir;
+static q15_t fir_state[ZDSP_FIR_STATE_LEN(FIR_TAPS, BLOCK_SIZE)];
+static arm_biquad_casd_df1_inst_q15 biquad;
+static q15_t biquad_state[ZDSP_BIQUAD_DF1_STATE_LEN(BIQUAD_STAGES)];
+
+ZDSP_STREAM_DEFINE(chain, BLOCK_SIZE,
+		   ZDSP_STAGE(zdsp_stage_fir_q15, &fir),
+		   ZDSP_STAGE(zdsp_stage_biquad_df1_q15, &biquad));
+
+static void filters_init(void)
+{
+	zassert_equal(arm_fir_init_q15(&fir, FIR_TAPS, fir_coeffs, fir_state, BLOCK_SIZE),
+		      ARM_MATH_SUCCESS, "FIR init failed");
+	arm_biquad_cascade_df1_init_q15(&biquad, BIQUAD_STAGES, biquad_coeffs, biquad_state, 1);
+}
+
+static void *filtering_setup(void)
+{
+	uint32_t seed = 12345;
+
+	for (int i = 0; i < FIR_TAPS; i++) {
+		fir_coeffs[i] = 0x0300;
+	}
+
+	for (int i = 0; i < NUM_BLOCKS; i++) {
+		for (int j = 0; j < BLOCK_SIZE; j++) {
+			seed = seed * 1103515245U + 12345U;
+			input[i][j] = (q15_t)(seed >> 16);
+		}
+	}
+
+	/* Reference output of the chain, one filter call per stage */
+	filters_init();
+	for (int i = 0; i < NUM_BLOCKS; i++) {
+		arm_fir_q15(&fir, input[i], tmp, BLOCK_SIZE);
+		arm_biquad_cascade_df1_q15(&biquad, tmp, expected[i], BLOCK_SIZE);
+	}
+
+	return NULL;
+}
+
+ZTEST(filtering_stream_benchmark, test_benchmark_chain_copy_q15)
+{
+	uint32_t irq_key, timestamp, timespan = 0;
+
+	filters_init();
+
+	for (int i = 0; i < NUM_BLOCKS; i++) {
+		/* Begin benchmark */
+		benchmark_begin(&irq_key, &timestamp);
+
+		/* Each stage writes to a separate buffer */
+		arm_fir_q15(&fir, input[i], tmp, BLOCK_SIZE);
+		arm_biquad_cascade_df1_q15(&biquad, tmp, output, BLOCK_SIZE);
+
+		/* End benchmark */
+		timespan += benchmark_end(irq_key, timestamp);
+
+		zassert_mem_equal(output, expected[i], sizeof(expected[i]),
+				  "chain output differs in block %d", i);
+	}
+
+	/* Print result */
+	TC_PRINT(BENCHMARK_TYPE " = %u for %u samples\n", timespan, NUM_BLOCKS * BLOCK_SIZE);
+}
+
+ZTEST(filtering_stream_benchmark, test_benchmark_chain_stream_q15)
+{
+	uint32_t irq_key, timestamp, timespan = 0;
+	q15_t *block;
+
+	filters_init();
+	zdsp_stream_stats_reset(&chain);
+
+	zassert_ok(k_mem_slab_alloc(&block_slab, (void **)&block, K_NO_WAIT),
+		   "block allocation failed");
+
+	for (int i = 0; i < NUM_BLOCKS; i++) {
+		/* Stands for the block being filled, e.g. by a DMIC driver */
+		memcpy(block, input[i], sizeof(input[i]));
+
+		/* Begin benchmark */
+		benchmark_begin(&irq_key, &timestamp);
+
+		/* Both stages process the block in place */
+		zdsp_stream_process(&chain, block, BLOCK_SIZE);
+
+		/* End benchmark */
+		timespan += benchmark_end(irq_key, timestamp);
+
+		zassert_mem_equal(block, expected[i], sizeof(expected[i]),
+				  "stream output differs in block %d", i);
+	}
+
+	k_mem_slab_free(&block_slab, (void **)&block);
+
+	/* Print result */
+	TC_PRINT(BENCHMARK_TYPE " = %u for %u samples\n", timespan, NUM_BLOCKS * BLOCK_SIZE);
+	for (size_t i = 0; i < chain.num_stages; i++) {
+		TC_PRINT("stage %zu: %llu cycles for %u blocks\n", i, chain.stages[i].cycles,
+			 chain.stages[i].blocks);
+	}
+}
+
+ZTEST_SUITE(filtering_stream_benchmark, NULL, filtering_setup, NULL, NULL, NULL);
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/crc.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/timing/timing.h>
+
+/* CRC microbenchmark. For each function and buffer length the average
+ * number of cycles spent computing the CRC of the buffer is printed,
+ * along with the throughput.
+ */
+
+#define MAX_LEN 4096
+#define N_OPS 64
+
+static uint8_t buf[MAX_LEN] __aligned(8);
+static const size_t lengths[] = { 16, 64, 256, 1500, 4096 };
+
+/* Keep the compiler from optimizing the CRCs away */
+static volatile uint32_t result;
+
+static uint32_t run_crc32_ieee(size_t len)
+{
+	return crc32_ieee(buf, len);
+}
+
+static uint32_t run_crc32_c(size_t len)
+{
+	return crc32_c(0, buf, len, true, true);
+}
+
+static uint32_t run_crc16_ccitt(size_t len)
+{
+	return crc16_ccitt(0xffff, buf, len);
+}
+
+static uint32_t run_crc8_ccitt(size_t len)
+{
+	return crc8_ccitt(0xff, buf, len);
+}
+
+static const struct {
+	const char *name;
+	uint32_t (*run)(size_t len);
+} crcs[] = {
+	{ "crc32_ieee", run_crc32_ieee },
+	{ "crc32_c", run_crc32_c },
+	{ "crc16_ccitt", run_crc16_ccitt },
+	{ "crc8_ccitt", run_crc8_ccitt },
+};
+
+static void bench_len(int idx, size_t len)
+{
+	timing_t start, end;
+	uint32_t crc = 0U;
+	uint32_t cycles;
+
+	start = timing_counter_get();
+	for (int i = 0; i < N_OPS; i++) {
+		crc ^= crcs[idx].run(len);
+	}
+	end = timing_counter_get();
+
+	result = crc;
+	cycles = MAX((uint32_t)(timing_cycles_get(&start, &end) / N_OPS), 1U);
+
+	printk("%-11s len %4zu %8u cycles %6u bytes/kcycle\n", crcs[idx].name,
+	       len, cycles, (uint32_t)(len * 1000U / cycles));
+}
+
+int main(void)
+{
+	for (int i = 0; i < ARRAY_SIZE(buf); i++) {
+		buf[i] = (uint8_t)(i * 7U + 3U);
+	}
+
+	timing_init();
+	timing_start();
+
+	unsigned int key = irq_lock();
+
+	for (int i = 0; i < ARRAY_SIZE(crcs); i++) {
+		for (int j = 0; j < ARRAY_SIZE(lengths); j++) {
+			bench_len(i, lengths[j]);
+		}
+	}
+
+	irq_unlock(key);
+
+	timing_stop();
+	printk("fin\n");
+	return 0;
+}
@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @brief sys_hashmap implementations benchmarks
+ *
+ * @defgroup lib_hash_map_perf_tests Hashmap
+ */
+
+#include <stdlib.h>
+
+#include <zephyr/ztest.h>
+#include <zephyr/sys/hash_map.h>
+
+#define N_KEYS 256
+#define N_ROUNDS 16
+#define N_CHURN_OPS 4096
+
+SYS_HASHMAP_SC_DEFINE_STATIC(sc_map);
+SYS_HASHMAP_OA_LP_DEFINE_STATIC(oa_lp_map);
+SYS_HASHMAP_OA_RH_DEFINE_STATIC(oa_rh_map);
+
+static const struct {
+	const char *name;
+	struct sys_hashmap *map;
+} maps[] = {
+	{ "separate chaining", &sc_map },
+	{ "linear probe", &oa_lp_map },
+	{ "robin hood", &oa_rh_map },
+};
+
+/* Small deterministic PRNG, so that all the maps see the same pattern */
+static uint32_t rand_state;
+
+static uint32_t next_rand(void)
+{
+	rand_state = rand_state * 1103515245U + 12345U;
+
+	return rand_state >> 8;
+}
+
+static void hash_map_perf_after(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	for (size_t i = 0; i < ARRAY_SIZE(maps); i++) {
+		sys_hashmap_clear(maps[i].map, NULL, NULL);
+	}
+}
+
+/**
+ * @brief Measure the latency of inserts, lookups and removals
+ *
+ * @details Fill each map with N_KEYS keys, look all of them up along with
+ * as many missing keys, then remove them, and report the average number of
+ * cycles per operation.
+ *
+ * @ingroup lib_hash_map_perf_tests
+ */
+ZTEST(hash_map_perf, test_hash_map_insert_lookup_remove)
+{
+	for (size_t m = 0; m < ARRAY_SIZE(maps); m++) {
+		struct sys_hashmap *map = maps[m].map;
+		uint64_t insert_cycles = 0, get_cycles = 0, remove_cycles = 0;
+		uint32_t start;
+
+		for (int r = 0; r < N_ROUNDS; r++) {
+			start = k_cycle_get_32();
+			for (uint64_t k = 0; k < N_KEYS; k++) {
+				zassert_equal(1, sys_hashmap_insert(map, k * 3, k, NULL));
+			}
+			insert_cycles += k_cycle_get_32() - start;
+
+			start = k_cycle_get_32();
+			for (uint64_t k = 0; k < 2 * N_KEYS; k++) {
+				zassert_equal(k % 2 == 0,
+					      sys_hashmap_contains_key(map, k / 2 * 3 + k % 2));
+			}
+			get_cycles += k_cycle_get_32() - start;
+
+			start = k_cycle_get_32();
+			for (uint64_t k = 0; k < N_KEYS; k++) {
+				zassert_true(sys_hashmap_remove(map, k * 3, NULL));
+			}
+			remove_cycles += k_cycle_get_32() - start;
+		}
+
+		TC_PRINT("%s: insert %u, lookup %u, remove %u cycles/op\n", maps[m].name,
+			 (uint32_t)(insert_cycles / (N_ROUNDS * N_KEYS)),
+			 (uint32_t)(get_cycles / (N_ROUNDS * 2 * N_KEYS)),
+			 (uint32_t)(remove_cycles / (N_ROUNDS * N_KEYS)));
+	}
+}
+
+/**
+ * @brief Measure the lookups after many removals
+ *
+ * @details Keep each map half full while randomly inserting and removing
+ * keys, which leaves tombstones in the linear probe map, then report the
+ * average number of cycles of the operations and of the lookups which
+ * follow.
+ *
+ * @ingroup lib_hash_map_perf_tests
+ */
+ZTEST(hash_map_perf, test_hash_map_churn)
+{
+	for (size_t m = 0; m < ARRAY_SIZE(maps); m++) {
+		struct sys_hashmap *map = maps[m].map;
+		uint64_t churn_cycles = 0, get_cycles = 0;
+		uint32_t start;
+		uint64_t key;
+
+		rand_state = 1;
+
+		for (uint64_t k = 0; k < N_KEYS / 2; k++) {
+			zassert_equal(1, sys_hashmap_insert(map, k, k, NULL));
+		}
+
+		start = k_cycle_get_32();
+		for (int i = 0; i < N_CHURN_OPS; i++) {
+			key = next_rand() % N_KEYS;
+			if (!sys_hashmap_remove(map, key, NULL)) {
+				zassert_true(sys_hashmap_insert(map, key, key, NULL) >= 0);
+			}
+		}
+		churn_cycles += k_cycle_get_32() - start;
+
+		start = k_cycle_get_32();
+		for (int r = 0; r < N_ROUNDS; r++) {
+			for (uint64_t k = 0; k < N_KEYS; k++) {
+				(void)sys_hashmap_contains_key(map, k);
+			}
+		}
+		get_cycles += k_cycle_get_32() - start;
+
+		TC_PRINT("%s: %zu entries, churn %u, lookup %u cycles/op\n", maps[m].name,
+			 sys_hashmap_size(map), (uint32_t)(churn_cycles / N_CHURN_OPS),
+			 (uint32_t)(get_cycles / (N_ROUNDS * N_KEYS)));
+
+		sys_hashmap_clear(map, NULL, NULL);
+	}
+}
+
+/**
+ * @brief Measure the inserts in a preallocated map
+ *
+ * @details Reserve the buckets of the robin hood map for N_KEYS entries,
+ * then fill and empty it, and report the average number of cycles per
+ * operation, which involve no rehashing.
+ *
+ * @ingroup lib_hash_map_perf_tests
+ */
+ZTEST(hash_map_perf, test_hash_map_reserved)
+{
+	uint64_t insert_cycles = 0, remove_cycles = 0;
+	uint32_t start;
+
+	zassert_ok(sys_hashmap_oa_rh_reserve(&oa_rh_map, N_KEYS));
+
+	for (int r = 0; r < N_ROUNDS; r++) {
+		start = k_cycle_get_32();
+		for (uint64_t k = 0; k < N_KEYS; k++) {
+			zassert_equal(1, sys_hashmap_insert(&oa_rh_map, k * 3, k, NULL));
+		}
+		insert_cycles += k_cycle_get_32() - start;
+
+		start = k_cycle_get_32();
+		for (uint64_t k = 0; k < N_KEYS; k++) {
+			zassert_true(sys_hashmap_remove(&oa_rh_map, k * 3, NULL));
+		}
+		remove_cycles += k_cycle_get_32() - start;
+	}
+
+	TC_PRINT("robin hood reserved: insert %u, remove %u cycles/op\n",
+		 (uint32_t)(insert_cycles / (N_ROUNDS * N_KEYS)),
+		 (uint32_t)(remove_cycles / (N_ROUNDS * N_KEYS)));
+}
+
+ZTEST_SUITE(hash_map_perf, NULL, NULL, NULL, hash_map_perf_after, NULL);
@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @brief sys_heap allocation latency and fragmentation benchmarks
+ *
+ * @defgroup lib_heap_perf_tests Heap
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/sys/sys_heap.h>
+
+#define HEAP_SZ (16 * 1024)
+#define NUM_PTRS 128
+#define NUM_ROUNDS 64
+#define MIN_SMALL 16
+#define MAX_SMALL 128
+
+static uint8_t __aligned(8) heapmem[HEAP_SZ];
+static struct sys_heap heap;
+static void *ptrs[NUM_PTRS];
+
+/* Small deterministic PRNG, so that all runs see the same pattern */
+static uint32_t rand_state;
+
+static uint32_t next_rand(void)
+{
+	rand_state = rand_state * 1103515245U + 12345U;
+
+	return rand_state >> 8;
+}
+
+static size_t small_size(void)
+{
+	return MIN_SMALL + next_rand() % (MAX_SMALL - MIN_SMALL + 1);
+}
+
+/* Largest block that can be allocated from the heap right now. */
+static size_t largest_free_block(void)
+{
+	size_t lo = 0, hi = HEAP_SZ;
+
+	while (lo + 1 < hi) {
+		size_t mid = (lo + hi) / 2;
+		void *p = sys_heap_alloc(&heap, mid);
+
+		if (p != NULL) {
+			sys_heap_free(&heap, p);
+			lo = mid;
+		} else {
+			hi = mid;
+		}
+	}
+
+	return lo;
+}
+
+static void heap_perf_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	sys_heap_init(&heap, heapmem, HEAP_SZ);
+	memset(ptrs, 0, sizeof(ptrs));
+	rand_state = 1;
+}
+
+/**
+ * @brief Measure the latency of small allocations and frees
+ *
+ * @details Allocate and free batches of randomly sized 16 to 128 byte
+ * blocks, which is the typical size of allocations done by protocol and
+ * serialization code, and report the average number of cycles per
+ * operation.
+ *
+ * @ingroup lib_heap_perf_tests
+ *
+ * @see sys_heap_alloc(), sys_heap_free()
+ */
+ZTEST(heap_perf, test_heap_small_alloc_latency)
+{
+	uint64_t alloc_cycles = 0, free_cycles = 0;
+	uint32_t ops = 0;
+
+	for (int r = 0; r < NUM_ROUNDS; r++) {
+		uint32_t start = k_cycle_get_32();
+
+		for (int i = 0; i < NUM_PTRS; i++) {
+			ptrs[i] = sys_heap_alloc(&heap, small_size());
+			zassert_not_null(ptrs[i], "small allocation failed");
+		}
+		alloc_cycles += k_cycle_get_32() - start;
+
+		/* Free every other block first to mix up the heap */
+		start = k_cycle_get_32();
+		for (int i = 0; i < NUM_PTRS; i += 2) {
+			sys_heap_free(&heap, ptrs[i]);
+		}
+		for (int i = 1; i < NUM_PTRS; i += 2) {
+			sys_heap_free(&heap, ptrs[i]);
+		}
+		free_cycles += k_cycle_get_32() - start;
+
+		ops += NUM_PTRS;
+	}
+
+	zassert_true(sys_heap_validate(&heap), "heap is corrupted");
+
+	TC_PRINT("small alloc: %u cycles/op, small free: %u cycles/op\n",
+		 (uint32_t)(alloc_cycles / ops), (uint32_t)(free_cycles / ops));
+}
+
+/**
+ * @brief Measure the fragmentation left by a mixed workload
+ *
+ * @details Run a random mix of small allocations and frees with an
+ * occasional large one, then free the small blocks still held and
+ * report the remaining usable memory, the largest block that can be
+ * allocated and how many allocations failed on the way.
+ *
+ * @ingroup lib_heap_perf_tests
+ *
+ * @see sys_heap_alloc(), sys_heap_free(), sys_heap_runtime_stats_get()
+ */
+ZTEST(heap_perf, test_heap_fragmentation)
+{
+	struct sys_memory_stats stats;
+	uint32_t failed = 0;
+	size_t largest;
+	void *big;
+
+	for (int op = 0; op < NUM_PTRS * NUM_ROUNDS; op++) {
+		int i = next_rand() % NUM_PTRS;
+
+		if (ptrs[i] != NULL) {
+			sys_heap_free(&heap, ptrs[i]);
+			ptrs[i] = NULL;
+			continue;
+		}
+
+		size_t sz = (next_rand() % 16 == 0) ? HEAP_SZ / 16 : small_size();
+
+		ptrs[i] = sys_heap_alloc(&heap, sz);
+		if (ptrs[i] == NULL) {
+			failed++;
+		}
+	}
+
+	zassert_true(sys_heap_validate(&heap), "heap is corrupted");
+
+	/* Keep a few live blocks pinning the heap, free the rest */
+	for (int i = 0; i < NUM_PTRS; i++) {
+		if ((i % 16 != 0) && (ptrs[i] != NULL)) {
+			sys_heap_free(&heap, ptrs[i]);
+			ptrs[i] = NULL;
+		}
+	}
+
+	largest = largest_free_block();
+	zassert_equal(sys_heap_runtime_stats_get(&heap, &stats), 0);
+
+	TC_PRINT("failed allocs: %u, free: %zu, allocated: %zu, largest free block: %zu\n",
+		 failed, stats.free_bytes, stats.allocated_bytes, largest);
+
+	/* Freed small blocks must all be usable again by big requests */
+	big = sys_heap_alloc(&heap, largest);
+	zassert_not_null(big, "largest free block can't be allocated");
+	sys_heap_free(&heap, big);
+
+	zassert_true(sys_heap_validate(&heap), "heap is corrupted");
+}
+
+ZTEST_SUITE(heap_perf, NULL, NULL, heap_perf_before, NULL, NULL);
@@ -0,0 +1,35 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __BENCH_H__
+#define __BENCH_H__
+
+#include <stdint.h>
+
+/* Echoed back by the remote */
+#define BENCH_MSG_PING		0x01
+/* Counted by the remote */
+#define BENCH_MSG_DATA		0x02
+/* Ends a burst of data, the remote replies with a report */
+#define BENCH_MSG_END		0x03
+#define BENCH_MSG_REPORT	0x04
+
+#define BENCH_EPT_NAME		"bench"
+
+struct bench_hdr {
+	uint8_t type;
+	uint8_t reserved[3];
+	uint32_t seq;
+};
+
+struct bench_report {
+	struct bench_hdr hdr;
+	/* Data messages and bytes received since the previous report */
+	uint32_t msgs;
+	uint32_t bytes;
+};
+
+#endif /* __BENCH_H__ */
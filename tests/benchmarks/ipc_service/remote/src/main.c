@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/sys/printk.h>
+
+#include <zephyr/ipc/ipc_service.h>
+
+#include "bench.h"
+
+static K_SEM_DEFINE(bound_sem, 0, 1);
+static struct ipc_ept ep;
+static uint32_t rx_msgs;
+static uint32_t rx_bytes;
+
+static void ep_bound(void *priv)
+{
+	k_sem_give(&bound_sem);
+}
+
+static void ep_recv(const void *data, size_t len, void *priv)
+{
+	const struct bench_hdr *hdr = data;
+	struct bench_report report = {
+		.hdr.type = BENCH_MSG_REPORT,
+	};
+	int ret = 0;
+
+	if (len < sizeof(*hdr)) {
+		printk("Unexpected message of %zu bytes\n", len);
+		return;
+	}
+
+	switch (hdr->type) {
+	case BENCH_MSG_PING:
+		ret = ipc_service_send(&ep, data, len);
+		break;
+	case BENCH_MSG_DATA:
+		rx_msgs++;
+		rx_bytes += len;
+		break;
+	case BENCH_MSG_END:
+		report.hdr.seq = hdr->seq;
+		report.msgs = rx_msgs;
+		report.bytes = rx_bytes;
+		rx_msgs = 0;
+		rx_bytes = 0;
+		ret = ipc_service_send(&ep, &report, sizeof(report));
+		break;
+	default:
+		printk("Unexpected message type %u\n", hdr->type);
+		break;
+	}
+
+	if (ret < 0) {
+		printk("Failed to reply: %d\n", ret);
+	}
+}
+
+static struct ipc_ept_cfg ep_cfg = {
+	.name = BENCH_EPT_NAME,
+	.cb = {
+		.bound    = ep_bound,
+		.received = ep_recv,
+	},
+};
+
+int main(void)
+{
+	const struct device *ipc0_instance = DEVICE_DT_GET(DT_NODELABEL(ipc0));
+	int ret;
+
+	ret = ipc_service_open_instance(ipc0_instance);
+	if ((ret < 0) && (ret != -EALREADY)) {
+		printk("ipc_service_open_instance() failure: %d\n", ret);
+		return ret;
+	}
+
+	ret = ipc_service_register_endpoint(ipc0_instance, &ep, &ep_cfg);
+	if (ret < 0) {
+		printk("ipc_service_register_endpoint() failure: %d\n", ret);
+		return ret;
+	}
+
+	k_sem_take(&bound_sem, K_FOREVER);
+	printk("IPC service benchmark remote bound\n");
+
+	return 0;
+}
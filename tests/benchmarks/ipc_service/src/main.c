@@ -0,0 +1,290 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * The latency is measured as half the round trip of a message echoed back by
+ * the remote, as the cores do not share a timer. The throughput is the one of
+ * a burst of messages sent to the remote, until it reports having received
+ * them all.
+ */
+
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/sys/util.h>
+
+#include <zephyr/ipc/ipc_service.h>
+
+#include "bench.h"
+
+#define LATENCY_ITERATIONS	1000
+#define THROUGHPUT_MSGS		2000
+#define REPLY_TIMEOUT		K_MSEC(100)
+#define REPORT_TIMEOUT		K_SECONDS(5)
+
+/* Latencies below 2^(n + 1) microseconds are counted in the bucket n */
+#define HISTOGRAM_BUCKETS	12
+
+/* Fits in the default buffers of all the backends */
+static const uint16_t msg_sizes[] = { 16, 64, 256, 480 };
+
+static K_SEM_DEFINE(bound_sem, 0, 1);
+static K_SEM_DEFINE(pong_sem, 0, 1);
+static K_SEM_DEFINE(report_sem, 0, 1);
+
+static struct ipc_ept ep;
+static uint32_t pong_seq;
+static struct bench_report report;
+static uint8_t tx_buf[512] __aligned(4);
+
+struct latency_stats {
+	uint64_t total_ns;
+	uint32_t min_ns;
+	uint32_t max_ns;
+	uint32_t histogram[HISTOGRAM_BUCKETS];
+};
+
+static void ep_bound(void *priv)
+{
+	k_sem_give(&bound_sem);
+}
+
+static void ep_recv(const void *data, size_t len, void *priv)
+{
+	const struct bench_hdr *hdr = data;
+
+	if (len < sizeof(*hdr)) {
+		return;
+	}
+
+	if (hdr->type == BENCH_MSG_PING) {
+		pong_seq = hdr->seq;
+		k_sem_give(&pong_sem);
+	} else if (hdr->type == BENCH_MSG_REPORT && len >= sizeof(report)) {
+		memcpy(&report, data, sizeof(report));
+		k_sem_give(&report_sem);
+	}
+}
+
+static struct ipc_ept_cfg ep_cfg = {
+	.name = BENCH_EPT_NAME,
+	.cb = {
+		.bound    = ep_bound,
+		.received = ep_recv,
+	},
+};
+
+/* The payload is written once, either in place or in a buffer then copied */
+static void fill_msg(uint8_t *buf, uint8_t type, uint32_t seq, size_t len)
+{
+	struct bench_hdr *hdr = (struct bench_hdr *)buf;
+
+	hdr->type = type;
+	hdr->seq = seq;
+	memset(buf + sizeof(*hdr), (uint8_t)seq, len - sizeof(*hdr));
+}
+
+static int send_msg(bool nocopy, uint8_t type, uint32_t seq, size_t len)
+{
+	uint32_t size;
+	void *buf;
+	int ret;
+
+	if (!nocopy) {
+		fill_msg(tx_buf, type, seq, len);
+
+		do {
+			ret = ipc_service_send(&ep, tx_buf, len);
+		} while (ret == -ENOMEM);
+
+		return ret;
+	}
+
+	do {
+		size = len;
+		ret = ipc_service_get_tx_buffer(&ep, &buf, &size, K_NO_WAIT);
+	} while (ret == -ENOMEM || ret == -ENOBUFS);
+
+	if (ret < 0) {
+		return ret;
+	}
+
+	fill_msg(buf, type, seq, len);
+
+	ret = ipc_service_send_nocopy(&ep, buf, len);
+	if (ret < 0) {
+		(void)ipc_service_drop_tx_buffer(&ep, buf);
+	}
+
+	return ret;
+}
+
+static void print_latency(const struct latency_stats *stats)
+{
+	printk("  latency min %u avg %u max %u ns\n", stats->min_ns,
+	       (uint32_t)(stats->total_ns / LATENCY_ITERATIONS), stats->max_ns);
+
+	for (int i = 0; i < HISTOGRAM_BUCKETS; i++) {
+		if (stats->histogram[i] == 0) {
+			continue;
+		}
+
+		if (i == HISTOGRAM_BUCKETS - 1) {
+			printk("    >= %5u us: %u\n", BIT(i), stats->histogram[i]);
+		} else {
+			printk("    <  %5u us: %u\n", BIT(i + 1), stats->histogram[i]);
+		}
+	}
+}
+
+static int measure_latency(bool nocopy, size_t len)
+{
+	struct latency_stats stats = {
+		.min_ns = UINT32_MAX,
+	};
+	uint32_t start;
+	uint32_t ns;
+	int ret;
+
+	for (uint32_t seq = 0; seq < LATENCY_ITERATIONS; seq++) {
+		k_sem_reset(&pong_sem);
+
+		start = k_cycle_get_32();
+		ret = send_msg(nocopy, BENCH_MSG_PING, seq, len);
+		if (ret < 0) {
+			return ret;
+		}
+
+		if (k_sem_take(&pong_sem, REPLY_TIMEOUT) != 0 || pong_seq != seq) {
+			printk("  no reply to message %u\n", seq);
+			return -ETIMEDOUT;
+		}
+
+		ns = k_cyc_to_ns_floor64(k_cycle_get_32() - start) / 2;
+		stats.total_ns += ns;
+		stats.min_ns = MIN(stats.min_ns, ns);
+		stats.max_ns = MAX(stats.max_ns, ns);
+		stats.histogram[MIN(LOG2(MAX(ns / 1000, 1)),
+				    HISTOGRAM_BUCKETS - 1)]++;
+	}
+
+	print_latency(&stats);
+
+	return 0;
+}
+
+static int measure_throughput(bool nocopy, size_t len)
+{
+	uint64_t ns;
+	uint32_t start;
+	int ret;
+
+	k_sem_reset(&report_sem);
+
+	start = k_cycle_get_32();
+
+	for (uint32_t seq = 0; seq < THROUGHPUT_MSGS; seq++) {
+		ret = send_msg(nocopy, BENCH_MSG_DATA, seq, len);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	ret = send_msg(nocopy, BENCH_MSG_END, THROUGHPUT_MSGS, sizeof(struct bench_hdr));
+	if (ret < 0) {
+		return ret;
+	}
+
+	if (k_sem_take(&report_sem, REPORT_TIMEOUT) != 0) {
+		printk("  no report\n");
+		return -ETIMEDOUT;
+	}
+
+	ns = k_cyc_to_ns_floor64(k_cycle_get_32() - start);
+
+	if (report.msgs != THROUGHPUT_MSGS || report.bytes != THROUGHPUT_MSGS * len) {
+		printk("  remote received %u messages, %u bytes\n", report.msgs, report.bytes);
+		return -EIO;
+	}
+
+	printk("  throughput %u kB/s, %u msgs/s\n",
+	       (uint32_t)((uint64_t)report.bytes * NSEC_PER_SEC / 1024 / ns),
+	       (uint32_t)((uint64_t)report.msgs * NSEC_PER_SEC / ns));
+
+	return 0;
+}
+
+static int run(bool nocopy)
+{
+	int ret;
+
+	for (size_t i = 0; i < ARRAY_SIZE(msg_sizes); i++) {
+		printk("%s %u bytes\n", nocopy ? "nocopy" : "copy", msg_sizes[i]);
+
+		ret = measure_latency(nocopy, msg_sizes[i]);
+		if (ret < 0) {
+			return ret;
+		}
+
+		ret = measure_throughput(nocopy, msg_sizes[i]);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	return 0;
+}
+
+int main(void)
+{
+	const struct device *ipc0_instance = DEVICE_DT_GET(DT_NODELABEL(ipc0));
+	void *buf;
+	uint32_t size = 0;
+	int ret;
+
+	printk("IPC service benchmark on %s\n", ipc0_instance->name);
+
+	ret = ipc_service_open_instance(ipc0_instance);
+	if ((ret < 0) && (ret != -EALREADY)) {
+		printk("ipc_service_open_instance() failure: %d\n", ret);
+		return ret;
+	}
+
+	ret = ipc_service_register_endpoint(ipc0_instance, &ep, &ep_cfg);
+	if (ret < 0) {
+		printk("ipc_service_register_endpoint() failure: %d\n", ret);
+		return ret;
+	}
+
+	k_sem_take(&bound_sem, K_FOREVER);
+
+	ret = run(false);
+	if (ret < 0) {
+		printk("copy benchmark failure: %d\n", ret);
+		return ret;
+	}
+
+	ret = ipc_service_get_tx_buffer(&ep, &buf, &size, K_NO_WAIT);
+	if (ret == -ENOTSUP || ret == -EIO) {
+		printk("nocopy not supported by the backend\n");
+	} else {
+		if (ret == 0) {
+			(void)ipc_service_drop_tx_buffer(&ep, buf);
+		}
+
+		ret = run(true);
+		if (ret < 0) {
+			printk("nocopy benchmark failure: %d\n", ret);
+			return ret;
+		}
+	}
+
+	printk("PROJECT EXECUTION SUCCESSFUL\n");
+
+	return 0;
+}
@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/timing/timing.h>
+
+#include "net_private.h"
+
+LOG_MODULE_REGISTER(net_chksum_bench, LOG_LEVEL_NONE);
+
+/* Internet checksum microbenchmark. For each buffer length and start
+ * offset the average number of cycles spent summing the buffer with
+ * calc_chksum() is printed, along with the throughput.
+ */
+
+#define MAX_LEN 1514
+#define N_OPS 256
+
+static uint8_t buf[MAX_LEN + 8] __aligned(8);
+static const size_t lengths[] = { 20, 40, 64, 576, 1280, 1500 };
+static const size_t offsets[] = { 0, 1, 2 };
+
+/* Keep the compiler from optimizing the sums away */
+static volatile uint16_t result;
+
+static void bench_len(size_t len, size_t offset)
+{
+	timing_t start, end;
+	uint16_t sum = 0U;
+	uint32_t cycles;
+
+	start = timing_counter_get();
+	for (int i = 0; i < N_OPS; i++) {
+		sum = calc_chksum(sum, buf + offset, len);
+	}
+	end = timing_counter_get();
+
+	result = sum;
+	cycles = MAX((uint32_t)(timing_cycles_get(&start, &end) / N_OPS), 1U);
+
+	printk("len %4zu offset %zu %6u cycles %6u bytes/kcycle\n", len,
+	       offset, cycles, (uint32_t)(len * 1000U / cycles));
+}
+
+int main(void)
+{
+	for (int i = 0; i < ARRAY_SIZE(buf); i++) {
+		buf[i] = (uint8_t)(i * 7U + 3U);
+	}
+
+	timing_init();
+	timing_start();
+
+	unsigned int key = irq_lock();
+
+	for (int i = 0; i < ARRAY_SIZE(lengths); i++) {
+		for (int j = 0; j < ARRAY_SIZE(offsets); j++) {
+			bench_len(lengths[i], offsets[j]);
+		}
+	}
+
+	irq_unlock(key);
+
+	timing_stop();
+	printk("fin\n");
+	return 0;
+}
@@ -0,0 +1,365 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/net/dummy.h>
+#include <zephyr/net/socket.h>
+
+#include "ipv4.h"
+#include "udp_internal.h"
+
+/* Network stack microbenchmark. A dummy L2 interface stands in for a
+ * network driver: received packets are injected with net_recv_data() and
+ * sent packets are dropped by the driver's send callback, so that only
+ * the cost of the stack itself is measured. For each path the average
+ * number of cycles per packet (or per connection) is printed.
+ *
+ *  - udp rx: net_recv_data() until recv() on a UDP socket returns
+ *  - udp tx: sendto() on a UDP socket until the driver gets the packet
+ *  - tcp tx/rx: send() on a TCP socket until recv() returns on the peer,
+ *    over the loopback interface
+ *  - tcp connect: connect(), accept() and close() of both ends
+ *  - pkt alloc: net_pkt_alloc_with_buffer() and net_pkt_unref()
+ */
+
+#define N_OPS 64
+#define N_CONN 16
+#define PAYLOAD_LEN 64
+
+#define UDP_PORT 4242
+#define TCP_PORT 4243
+
+static struct net_if *bench_iface;
+static struct in_addr my_addr = { { { 192, 0, 2, 1 } } };
+static struct in_addr peer_addr = { { { 192, 0, 2, 2 } } };
+static struct in_addr netmask = { { { 255, 255, 255, 0 } } };
+
+static uint8_t payload[PAYLOAD_LEN];
+static uint8_t rx_buf[PAYLOAD_LEN];
+
+static K_SEM_DEFINE(tx_sem, 0, 1);
+static timing_t tx_end;
+
+static void bench_iface_init(struct net_if *iface)
+{
+	static uint8_t mac[] = { 0x00, 0x00, 0x5e, 0x00, 0x53, 0x01 };
+
+	net_if_set_link_addr(iface, mac, sizeof(mac), NET_LINK_DUMMY);
+	bench_iface = iface;
+}
+
+static int bench_send(const struct device *dev, struct net_pkt *pkt)
+{
+	ARG_UNUSED(dev);
+	ARG_UNUSED(pkt);
+
+	tx_end = timing_counter_get();
+	k_sem_give(&tx_sem);
+
+	return 0;
+}
+
+static struct dummy_api bench_if_api = {
+	.iface_api.init = bench_iface_init,
+	.send = bench_send,
+};
+
+NET_DEVICE_INIT(net_bench, "net_bench", NULL, NULL, NULL, NULL,
+		CONFIG_KERNEL_INIT_PRIORITY_DEFAULT, &bench_if_api, DUMMY_L2,
+		NET_L2_GET_CTX_TYPE(DUMMY_L2), NET_IPV4_MTU);
+
+static void print_result(const char *name, uint64_t cycles, uint32_t n)
+{
+	uint64_t avg = cycles / n;
+
+	printk("%-12s %8u cycles %8u ns\n", name, (uint32_t)avg,
+	       (uint32_t)timing_cycles_to_ns(avg));
+}
+
+static struct net_pkt *udp_pkt_build(void)
+{
+	struct net_pkt *pkt;
+
+	pkt = net_pkt_alloc_with_buffer(bench_iface, sizeof(payload), AF_INET,
+					IPPROTO_UDP, K_FOREVER);
+	if (pkt == NULL) {
+		return NULL;
+	}
+
+	if (net_ipv4_create(pkt, &peer_addr, &my_addr) ||
+	    net_udp_create(pkt, htons(UDP_PORT), htons(UDP_PORT)) ||
+	    net_pkt_write(pkt, payload, sizeof(payload))) {
+		net_pkt_unref(pkt);
+		return NULL;
+	}
+
+	net_pkt_cursor_init(pkt);
+	net_ipv4_finalize(pkt, IPPROTO_UDP);
+
+	return pkt;
+}
+
+static int bench_udp(void)
+{
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(UDP_PORT),
+		.sin_addr = my_addr,
+	};
+	struct sockaddr_in peer = {
+		.sin_family = AF_INET,
+		.sin_port = htons(UDP_PORT),
+		.sin_addr = peer_addr,
+	};
+	uint64_t rx_cycles = 0U, tx_cycles = 0U;
+	timing_t start, end;
+	int sock;
+
+	sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	if (sock < 0) {
+		return -errno;
+	}
+
+	if (bind(sock, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+		(void)close(sock);
+		return -errno;
+	}
+
+	for (int i = 0; i < N_OPS; i++) {
+		struct net_pkt *pkt = udp_pkt_build();
+
+		if (pkt == NULL) {
+			(void)close(sock);
+			return -ENOMEM;
+		}
+
+		start = timing_counter_get();
+		if (net_recv_data(bench_iface, pkt) < 0) {
+			net_pkt_unref(pkt);
+			(void)close(sock);
+			return -EIO;
+		}
+		if (recv(sock, rx_buf, sizeof(rx_buf), 0) != sizeof(rx_buf)) {
+			(void)close(sock);
+			return -EIO;
+		}
+		end = timing_counter_get();
+
+		rx_cycles += timing_cycles_get(&start, &end);
+	}
+
+	for (int i = 0; i < N_OPS; i++) {
+		start = timing_counter_get();
+		if (sendto(sock, payload, sizeof(payload), 0,
+			   (struct sockaddr *)&peer, sizeof(peer)) < 0) {
+			(void)close(sock);
+			return -errno;
+		}
+		if (k_sem_take(&tx_sem, K_SECONDS(1)) != 0) {
+			(void)close(sock);
+			return -ETIMEDOUT;
+		}
+
+		tx_cycles += timing_cycles_get(&start, &tx_end);
+	}
+
+	(void)close(sock);
+
+	print_result("udp rx", rx_cycles, N_OPS);
+	print_result("udp tx", tx_cycles, N_OPS);
+
+	return 0;
+}
+
+static int tcp_listen(void)
+{
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(TCP_PORT),
+		.sin_addr = INADDR_LOOPBACK_INIT,
+	};
+	int sock;
+
+	sock = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	if (sock < 0) {
+		return -errno;
+	}
+
+	if (bind(sock, (struct sockaddr *)&addr, sizeof(addr)) < 0 ||
+	    listen(sock, 1) < 0) {
+		(void)close(sock);
+		return -errno;
+	}
+
+	return sock;
+}
+
+static int tcp_connect(int listener, int *server)
+{
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(TCP_PORT),
+		.sin_addr = INADDR_LOOPBACK_INIT,
+	};
+	int sock;
+
+	sock = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	if (sock < 0) {
+		return -errno;
+	}
+
+	if (connect(sock, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+		(void)close(sock);
+		return -errno;
+	}
+
+	*server = accept(listener, NULL, NULL);
+	if (*server < 0) {
+		(void)close(sock);
+		return -errno;
+	}
+
+	return sock;
+}
+
+static int bench_tcp(void)
+{
+	uint64_t tx_cycles = 0U, rxtx_cycles = 0U, conn_cycles = 0U;
+	timing_t start, mid, end;
+	int listener, client, server;
+	int ret = 0;
+
+	listener = tcp_listen();
+	if (listener < 0) {
+		return listener;
+	}
+
+	client = tcp_connect(listener, &server);
+	if (client < 0) {
+		(void)close(listener);
+		return client;
+	}
+
+	for (int i = 0; i < N_OPS; i++) {
+		size_t len = 0U;
+
+		start = timing_counter_get();
+		if (send(client, payload, sizeof(payload), 0) != sizeof(payload)) {
+			ret = -EIO;
+			break;
+		}
+		mid = timing_counter_get();
+
+		/* segments may be coalesced or split on the way */
+		while (len < sizeof(rx_buf)) {
+			ssize_t n = recv(server, rx_buf + len,
+					 sizeof(rx_buf) - len, 0);
+
+			if (n <= 0) {
+				ret = -EIO;
+				break;
+			}
+			len += n;
+		}
+		end = timing_counter_get();
+
+		tx_cycles += timing_cycles_get(&start, &mid);
+		rxtx_cycles += timing_cycles_get(&start, &end);
+	}
+
+	(void)close(client);
+	(void)close(server);
+
+	for (int i = 0; ret == 0 && i < N_CONN; i++) {
+		start = timing_counter_get();
+		client = tcp_connect(listener, &server);
+		if (client < 0) {
+			ret = client;
+			break;
+		}
+		(void)close(client);
+		(void)close(server);
+		end = timing_counter_get();
+
+		conn_cycles += timing_cycles_get(&start, &end);
+	}
+
+	(void)close(listener);
+
+	if (ret == 0) {
+		uint64_t ns = timing_cycles_to_ns(conn_cycles / N_CONN);
+
+		print_result("tcp tx", tx_cycles, N_OPS);
+		print_result("tcp tx/rx", rxtx_cycles, N_OPS);
+		print_result("tcp connect", conn_cycles, N_CONN);
+		printk("tcp connect rate %u conn/s\n",
+		       (uint32_t)(NSEC_PER_SEC / MAX(ns, 1U)));
+	}
+
+	return ret;
+}
+
+static void bench_pkt_alloc(void)
+{
+	timing_t start, end;
+	uint64_t cycles;
+
+	start = timing_counter_get();
+	for (int i = 0; i < N_OPS; i++) {
+		struct net_pkt *pkt;
+
+		pkt = net_pkt_alloc_with_buffer(bench_iface, PAYLOAD_LEN,
+						AF_INET, IPPROTO_UDP, K_NO_WAIT);
+		if (pkt == NULL) {
+			printk("pkt alloc failed\n");
+			return;
+		}
+		net_pkt_unref(pkt);
+	}
+	end = timing_counter_get();
+
+	cycles = timing_cycles_get(&start, &end);
+	print_result("pkt alloc", cycles, N_OPS);
+}
+
+int main(void)
+{
+	int ret;
+
+	for (int i = 0; i < ARRAY_SIZE(payload); i++) {
+		payload[i] = (uint8_t)(i * 7U + 3U);
+	}
+
+	if (net_if_ipv4_addr_add(bench_iface, &my_addr, NET_ADDR_MANUAL,
+				 0) == NULL) {
+		printk("cannot add IPv4 address\n");
+		return 0;
+	}
+	net_if_ipv4_set_netmask(bench_iface, &netmask);
+
+	timing_init();
+	timing_start();
+
+	ret = bench_udp();
+	if (ret < 0) {
+		printk("udp benchmark failed (%d)\n", ret);
+	}
+
+	ret = bench_tcp();
+	if (ret < 0) {
+		printk("tcp benchmark failed (%d)\n", ret);
+	}
+
+	bench_pkt_alloc();
+
+	timing_stop();
+	printk("fin\n");
+	return 0;
+}
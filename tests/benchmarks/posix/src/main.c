@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <pthread.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/sys/util.h>
+
+#define ITERATIONS 1000
+#define STACK_SIZE 2048
+
+static K_THREAD_STACK_DEFINE(stack, STACK_SIZE);
+
+static pthread_key_t keys[CONFIG_MAX_PTHREAD_KEY_COUNT];
+
+static void print_avg(const char *name, uint32_t cycles)
+{
+	printk("%-17s avg %u ns\n", name,
+	       (uint32_t)(k_cyc_to_ns_floor64(cycles) / ITERATIONS));
+}
+
+static void *nop_fn(void *arg)
+{
+	return arg;
+}
+
+static int bench_create_join(void)
+{
+	pthread_attr_t attr;
+	pthread_t th;
+	uint32_t start;
+	int ret;
+
+	ret = pthread_attr_init(&attr);
+	if (ret != 0) {
+		return ret;
+	}
+
+	ret = pthread_attr_setstack(&attr, stack, STACK_SIZE);
+	if (ret != 0) {
+		return ret;
+	}
+
+	start = k_cycle_get_32();
+
+	for (int i = 0; i < ITERATIONS; i++) {
+		ret = pthread_create(&th, &attr, nop_fn, NULL);
+		if (ret != 0) {
+			return ret;
+		}
+
+		ret = pthread_join(th, NULL);
+		if (ret != 0) {
+			return ret;
+		}
+	}
+
+	print_avg("create/join", k_cycle_get_32() - start);
+
+	return pthread_attr_destroy(&attr);
+}
+
+static int bench_mutex(void)
+{
+	pthread_mutex_t mu;
+	uint32_t start;
+	int ret;
+
+	ret = pthread_mutex_init(&mu, NULL);
+	if (ret != 0) {
+		return ret;
+	}
+
+	start = k_cycle_get_32();
+
+	for (int i = 0; i < ITERATIONS; i++) {
+		(void)pthread_mutex_lock(&mu);
+		(void)pthread_mutex_unlock(&mu);
+	}
+
+	print_avg("mutex lock/unlock", k_cycle_get_32() - start);
+
+	return pthread_mutex_destroy(&mu);
+}
+
+/* Run in a pthread, the thread-specific data is the one of pthreads */
+static void *key_fn(void *arg)
+{
+	uint32_t start;
+	int ret;
+
+	for (size_t i = 0; i < ARRAY_SIZE(keys); i++) {
+		ret = pthread_setspecific(keys[i], INT_TO_POINTER(i + 1));
+		if (ret != 0) {
+			return INT_TO_POINTER(ret);
+		}
+	}
+
+	start = k_cycle_get_32();
+
+	for (int i = 0; i < ITERATIONS; i++) {
+		pthread_key_t key = keys[i % ARRAY_SIZE(keys)];
+
+		(void)pthread_setspecific(key, pthread_getspecific(key));
+	}
+
+	print_avg("key set/get", k_cycle_get_32() - start);
+
+	return NULL;
+}
+
+static int bench_key(void)
+{
+	pthread_attr_t attr;
+	pthread_t th;
+	void *retval;
+	int ret;
+
+	for (size_t i = 0; i < ARRAY_SIZE(keys); i++) {
+		ret = pthread_key_create(&keys[i], NULL);
+		if (ret != 0) {
+			return ret;
+		}
+	}
+
+	ret = pthread_attr_init(&attr);
+	if (ret != 0) {
+		return ret;
+	}
+
+	ret = pthread_attr_setstack(&attr, stack, STACK_SIZE);
+	if (ret != 0) {
+		return ret;
+	}
+
+	ret = pthread_create(&th, &attr, key_fn, NULL);
+	if (ret != 0) {
+		return ret;
+	}
+
+	ret = pthread_join(th, &retval);
+	if (ret != 0) {
+		return ret;
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(keys); i++) {
+		(void)pthread_key_delete(keys[i]);
+	}
+
+	(void)pthread_attr_destroy(&attr);
+
+	return POINTER_TO_INT(retval);
+}
+
+int main(void)
+{
+	int ret;
+
+	printk("POSIX benchmark on %s\n", CONFIG_BOARD);
+
+	ret = bench_create_join();
+	if (ret != 0) {
+		printk("create/join failure: %d\n", ret);
+		return ret;
+	}
+
+	ret = bench_mutex();
+	if (ret != 0) {
+		printk("mutex failure: %d\n", ret);
+		return ret;
+	}
+
+	ret = bench_key();
+	if (ret != 0) {
+		printk("key failure: %d\n", ret);
+		return ret;
+	}
+
+	printk("PROJECT EXECUTION SUCCESSFUL\n");
+
+	return 0;
+}
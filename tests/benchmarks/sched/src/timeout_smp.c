@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/timeout_q.h>
+#include <kswap.h>
+
+/* Timeout queue contention benchmark for SMP.  One thread per CPU
+ * concurrently arms and aborts its own timeout in a tight loop, which
+ * is what k_sleep()-heavy workers boil down to.  The average cost of
+ * an add/abort pair is printed per thread: with a single timeout queue
+ * it grows with the number of CPUs hammering the shared lock, with
+ * CONFIG_TIMEOUT_PER_CPU it should stay close to the single CPU cost.
+ *
+ * The same is then done with k_yield(), which contends on the
+ * scheduler lock, to compare spinlock implementations.
+ */
+
+#define N_PAIRS 10000
+#define STACK_SIZE 1024
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, CONFIG_MP_MAX_NUM_CPUS, STACK_SIZE);
+static struct k_thread threads[CONFIG_MP_MAX_NUM_CPUS];
+static struct _timeout timeouts[CONFIG_MP_MAX_NUM_CPUS];
+static uint32_t cycles[CONFIG_MP_MAX_NUM_CPUS];
+static atomic_t ready;
+
+static void expire_fn(struct _timeout *t)
+{
+	ARG_UNUSED(t);
+}
+
+static void worker_fn(void *arg1, void *arg2, void *arg3)
+{
+	int id = POINTER_TO_INT(arg1);
+	int nthreads = POINTER_TO_INT(arg2);
+	bool yield = POINTER_TO_INT(arg3);
+	uint32_t start;
+
+	/* Start all threads at (roughly) the same time */
+	atomic_inc(&ready);
+	while (atomic_get(&ready) < nthreads) {
+	}
+
+	start = k_cycle_get_32();
+	for (int i = 0; i < N_PAIRS; i++) {
+		if (yield) {
+			k_yield();
+		} else {
+			z_add_timeout(&timeouts[id], expire_fn, K_SECONDS(10));
+			z_abort_timeout(&timeouts[id]);
+		}
+	}
+	cycles[id] = k_cycle_get_32() - start;
+}
+
+static void run(int nthreads, bool yield)
+{
+	uint64_t tot = 0U;
+
+#ifdef CONFIG_SPINLOCK_STATS
+	k_spinlock_stats_reset(&sched_spinlock);
+#endif
+
+	atomic_set(&ready, 0);
+
+	for (int i = 0; i < nthreads; i++) {
+		z_init_timeout(&timeouts[i]);
+		k_thread_create(&threads[i], stacks[i], STACK_SIZE,
+				worker_fn, INT_TO_POINTER(i),
+				INT_TO_POINTER(nthreads), INT_TO_POINTER(yield),
+				K_PRIO_COOP(1), 0, K_NO_WAIT);
+	}
+
+	for (int i = 0; i < nthreads; i++) {
+		k_thread_join(&threads[i], K_FOREVER);
+		tot += cycles[i];
+	}
+
+	printk("%s cpus %d avg %u\n", yield ? "yield" : "timeout add/abort",
+	       nthreads, (uint32_t)(tot / ((uint64_t)nthreads * N_PAIRS)));
+
+#ifdef CONFIG_SPINLOCK_STATS
+	struct k_spinlock_stats stats;
+
+	k_spinlock_stats_get(&sched_spinlock, &stats);
+	printk("  sched lock taken %u contended %u avg wait %u max wait %u\n",
+	       stats.acquisitions, stats.contentions,
+	       stats.contentions ?
+	       (uint32_t)(stats.spin_cycles / stats.contentions) : 0U,
+	       stats.max_spin_cycles);
+#endif
+}
+
+void timeout_smp_bench(void)
+{
+	printk("timeout queues: %s, spinlocks: %s\n",
+	       IS_ENABLED(CONFIG_TIMEOUT_PER_CPU) ? "per-cpu" : "global",
+	       IS_ENABLED(CONFIG_SPINLOCK_TICKET) ? "ticket" :
+	       IS_ENABLED(CONFIG_SPINLOCK_MCS) ? "mcs" : "test-and-set");
+
+	for (int n = 1; n <= arch_num_cpus(); n++) {
+		run(n, false);
+	}
+
+	for (int n = 1; n <= arch_num_cpus(); n++) {
+		run(n, true);
+	}
+}
@@ -43,16 +43,29 @@ static inline int stamp(int state)
 
 static int yielder_status;
 
+/* Partition added to the domains of all threads when sharing, so that
+ * part of the memory map is the same across domains
+ */
+K_APPMEM_PARTITION_DEFINE(shared_partition);
+K_APP_DMEM(shared_partition) int shared_dummy;
+
+static bool share_partition;
+
 void yielder_entry(void *_thread, void *_tid, void *_nb_threads)
 {
 	struct k_app_thread *thread = (struct k_app_thread *) _thread;
 	int ret;
 
 	struct k_mem_partition *parts[] = {
+		&shared_partition,
 		thread->partition,
 	};
 
-	ret = k_mem_domain_init(&thread->domain, ARRAY_SIZE(parts), parts);
+	if (share_partition) {
+		ret = k_mem_domain_init(&thread->domain, ARRAY_SIZE(parts), parts);
+	} else {
+		ret = k_mem_domain_init(&thread->domain, 1, &parts[1]);
+	}
 	if (ret != 0) {
 		printk("k_mem_domain_init failed %d\n", ret);
 		yielder_status = 1;
@@ -67,7 +80,7 @@ void yielder_entry(void *_thread, void *_tid, void *_nb_threads)
 
 static k_tid_t threads[MAX_NB_THREADS];
 
-static int exec_test(uint8_t nb_threads)
+static int exec_test(uint8_t nb_threads, bool shared)
 {
 	if (nb_threads > MAX_NB_THREADS) {
 		printk("Too many threads\n");
@@ -75,6 +88,7 @@ static int exec_test(uint8_t nb_threads)
 	}
 
 	yielder_status = 0;
+	share_partition = shared;
 
 	for (size_t tid = 0; tid < nb_threads; tid++) {
 		app_threads[tid].partition = app_partitions[tid];
@@ -127,7 +141,18 @@ int main(void)
 	printk("user/user^n swapping (yield)\n");
 
 	for (size_t i = 0; nb_threads_list[i] > 0; i++) {
-		ret = exec_test(nb_threads_list[i]);
+		ret = exec_test(nb_threads_list[i], false);
+		if (ret != 0) {
+			printk("FAIL\n");
+			return 0;
+		}
+	}
+
+	printk("============================\n");
+	printk("user/user^n swapping (yield), shared partition\n");
+
+	for (size_t i = 0; nb_threads_list[i] > 0; i++) {
+		ret = exec_test(nb_threads_list[i], true);
 		if (ret != 0) {
 			printk("FAIL\n");
 			return 0;
@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * SMP scheduler benchmarks: cross-CPU wakeup latency, spinlock contention
+ * scaling, cross-CPU FIFO and work queue throughput, and thread migration
+ * cost.
+ */
+
+#include <zephyr/tc_util.h>
+#include "utils.h"
+
+int error_count;
+
+extern void wakeup_bench(void);
+extern void spinlock_bench(void);
+extern void queues_bench(void);
+extern void migration_bench(void);
+
+static K_THREAD_STACK_DEFINE(bench_stack, STACK_SIZE);
+static struct k_thread bench_thread;
+
+static void bench_main(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	timing_init();
+	timing_start();
+
+	TC_START("SMP scheduler benchmarks");
+	TC_PRINT("Timing results: Clock frequency: %u MHz, CPUs: %u\n",
+		 timing_freq_get_mhz(), arch_num_cpus());
+
+	wakeup_bench();
+
+	spinlock_bench();
+
+	queues_bench();
+
+	migration_bench();
+
+	timing_stop();
+
+	TC_END_REPORT(error_count);
+}
+
+int main(void)
+{
+	/* Measurements are driven from CPU 0 */
+	start_on_cpu(&bench_thread, bench_stack, bench_main, NULL, NULL, NULL,
+		     K_PRIO_PREEMPT(10), 0);
+	k_thread_join(&bench_thread, K_FOREVER);
+
+	return 0;
+}
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * Thread migration cost: a thread woken up repeatedly walks a small
+ * working set, either always on the same CPU or moved to the other CPU
+ * before each wakeup. The difference in the time taken by the walk is the
+ * cache cost of migrating; the cost of re-pinning the thread is reported
+ * separately.
+ */
+
+#include "utils.h"
+
+#define N_WAKEUPS 500
+#define WORKING_SET_SIZE 4096
+
+static K_THREAD_STACK_DEFINE(mover_stack, STACK_SIZE);
+static struct k_thread mover_thread;
+
+static K_SEM_DEFINE(wake_sem, 0, 1);
+static K_SEM_DEFINE(done_sem, 0, 1);
+
+static uint32_t working_set[WORKING_SET_SIZE / sizeof(uint32_t)];
+static uint64_t walk_cycles;
+
+static void mover(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (int i = 0; i < N_WAKEUPS; i++) {
+		timing_t start, end;
+
+		k_sem_take(&wake_sem, K_FOREVER);
+
+		start = timing_counter_get();
+		for (int j = 0; j < ARRAY_SIZE(working_set); j++) {
+			working_set[j]++;
+		}
+		end = timing_counter_get();
+
+		walk_cycles += timing_cycles_get(&start, &end);
+		k_sem_give(&done_sem);
+	}
+}
+
+static void run(bool migrate)
+{
+	uint64_t pin_cycles = 0U;
+
+	walk_cycles = 0U;
+
+	start_on_cpu(&mover_thread, mover_stack, mover, NULL, NULL, NULL,
+		     K_PRIO_PREEMPT(5), 1);
+
+	for (int i = 0; i < N_WAKEUPS; i++) {
+		if (migrate) {
+			int cpu = (i % (arch_num_cpus() - 1)) + 1;
+			timing_t start, end;
+			int ret;
+
+			/* Alternate between CPUs other than ours, the
+			 * thread must be pending to be pinned.
+			 */
+			do {
+				start = timing_counter_get();
+				ret = k_thread_cpu_pin(&mover_thread,
+						       (i & 1) ? cpu : 0);
+				end = timing_counter_get();
+			} while (ret != 0);
+
+			pin_cycles += timing_cycles_get(&start, &end);
+		}
+
+		k_sem_give(&wake_sem);
+		k_sem_take(&done_sem, K_FOREVER);
+	}
+
+	k_thread_join(&mover_thread, K_FOREVER);
+
+	if (migrate) {
+		PRINT_STATS_AVG("Working set walk after wakeup, migrated",
+				walk_cycles, N_WAKEUPS);
+		PRINT_STATS_AVG("Average k_thread_cpu_pin() of a pending thread",
+				pin_cycles, N_WAKEUPS);
+	} else {
+		PRINT_STATS_AVG("Working set walk after wakeup, same CPU",
+				walk_cycles, N_WAKEUPS);
+	}
+}
+
+void migration_bench(void)
+{
+	run(false);
+	run(true);
+}
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * Cross-CPU queue throughput: items are produced on CPU 0 and consumed on
+ * CPU 1, through a k_fifo and through a work queue. The average cost per
+ * item is reported, from the first item produced to the last consumed.
+ */
+
+#include "utils.h"
+
+#define N_ITEMS 500
+
+struct fifo_item {
+	void *fifo_reserved;
+	uint32_t seq;
+};
+
+static K_THREAD_STACK_DEFINE(consumer_stack, STACK_SIZE);
+static struct k_thread consumer_thread;
+static K_FIFO_DEFINE(bench_fifo);
+static struct fifo_item fifo_items[N_ITEMS];
+
+static K_THREAD_STACK_DEFINE(workq_stack, STACK_SIZE);
+static struct k_work_q workq;
+static struct k_work works[N_ITEMS];
+static atomic_t works_done;
+static K_SEM_DEFINE(works_sem, 0, 1);
+
+static timing_t start_stamp, end_stamp;
+
+static void fifo_consumer(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (int i = 0; i < N_ITEMS; i++) {
+		struct fifo_item *item = k_fifo_get(&bench_fifo, K_FOREVER);
+
+		if (item->seq != i) {
+			error_count++;
+		}
+	}
+
+	end_stamp = timing_counter_get();
+}
+
+static void fifo_bench(void)
+{
+	start_on_cpu(&consumer_thread, consumer_stack, fifo_consumer,
+		     NULL, NULL, NULL, K_PRIO_PREEMPT(5), 1);
+
+	/* Let the consumer pend */
+	k_busy_wait(100);
+
+	start_stamp = timing_counter_get();
+	for (int i = 0; i < N_ITEMS; i++) {
+		fifo_items[i].seq = i;
+		k_fifo_put(&bench_fifo, &fifo_items[i]);
+	}
+
+	k_thread_join(&consumer_thread, K_FOREVER);
+
+	PRINT_STATS_AVG("Average FIFO put/get, producer and consumer on 2 CPUs",
+			timing_cycles_get(&start_stamp, &end_stamp), N_ITEMS);
+}
+
+static void work_handler(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	if (atomic_inc(&works_done) == N_ITEMS - 1) {
+		end_stamp = timing_counter_get();
+		k_sem_give(&works_sem);
+	}
+}
+
+static void workq_bench(void)
+{
+	const struct k_work_queue_config cfg = {
+		.name = "bench_workq",
+	};
+
+	k_work_queue_start(&workq, workq_stack, K_THREAD_STACK_SIZEOF(workq_stack),
+			   K_PRIO_PREEMPT(5), &cfg);
+
+	/* The queue thread can only be pinned once it waits for work */
+	while (k_thread_cpu_pin(k_work_queue_thread_get(&workq), 1) != 0) {
+		k_msleep(1);
+	}
+
+	for (int i = 0; i < N_ITEMS; i++) {
+		k_work_init(&works[i], work_handler);
+	}
+	atomic_set(&works_done, 0);
+
+	start_stamp = timing_counter_get();
+	for (int i = 0; i < N_ITEMS; i++) {
+		(void)k_work_submit_to_queue(&workq, &works[i]);
+	}
+
+	k_sem_take(&works_sem, K_FOREVER);
+
+	PRINT_STATS_AVG("Average work item submit/run, submitter and queue on 2 CPUs",
+			timing_cycles_get(&start_stamp, &end_stamp), N_ITEMS);
+}
+
+void queues_bench(void)
+{
+	fifo_bench();
+
+	workq_bench();
+}
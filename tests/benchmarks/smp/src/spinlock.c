@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * Spinlock contention scaling: one thread per CPU takes and releases the
+ * same spinlock in a loop, with a short critical section. The average
+ * cost of a lock/unlock pair is reported from 1 to all CPUs.
+ */
+
+#include "utils.h"
+
+#define N_LOCKS 10000
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, CONFIG_MP_MAX_NUM_CPUS, STACK_SIZE);
+static struct k_thread threads[CONFIG_MP_MAX_NUM_CPUS];
+
+static struct k_spinlock bench_lock;
+static volatile uint32_t shared_counter;
+static uint64_t cycles[CONFIG_MP_MAX_NUM_CPUS];
+static atomic_t ready;
+
+static void locker(void *p1, void *p2, void *p3)
+{
+	int id = POINTER_TO_INT(p1);
+	int nthreads = POINTER_TO_INT(p2);
+	timing_t start, end;
+
+	ARG_UNUSED(p3);
+
+	atomic_inc(&ready);
+	wait_for(&ready, nthreads);
+
+	start = timing_counter_get();
+	for (int i = 0; i < N_LOCKS; i++) {
+		k_spinlock_key_t key = k_spin_lock(&bench_lock);
+
+		shared_counter++;
+		k_spin_unlock(&bench_lock, key);
+	}
+	end = timing_counter_get();
+
+	cycles[id] = timing_cycles_get(&start, &end);
+}
+
+static void run(int nthreads)
+{
+	char summary[64];
+	uint64_t total = 0U;
+
+	atomic_set(&ready, 0);
+	shared_counter = 0U;
+
+	/* Cooperative, so that each thread keeps its CPU to itself */
+	for (int i = 0; i < nthreads; i++) {
+		start_on_cpu(&threads[i], stacks[i], locker, INT_TO_POINTER(i),
+			     INT_TO_POINTER(nthreads), NULL, K_PRIO_COOP(1), i);
+	}
+
+	for (int i = 0; i < nthreads; i++) {
+		k_thread_join(&threads[i], K_FOREVER);
+		total += cycles[i];
+	}
+
+	if (shared_counter != (uint32_t)nthreads * N_LOCKS) {
+		printk("Spinlock lost updates: %u of %u\n", shared_counter,
+		       nthreads * N_LOCKS);
+		error_count++;
+	}
+
+	snprintk(summary, sizeof(summary),
+		 "Average spinlock lock/unlock, %d CPU(s)", nthreads);
+	PRINT_STATS_AVG(summary, total, (uint64_t)nthreads * N_LOCKS);
+}
+
+void spinlock_bench(void)
+{
+	printk("Spinlock implementation: %s\n",
+	       IS_ENABLED(CONFIG_SPINLOCK_TICKET) ? "ticket" :
+	       IS_ENABLED(CONFIG_SPINLOCK_MCS) ? "mcs" : "test-and-set");
+
+	for (int n = 1; n <= arch_num_cpus(); n++) {
+		run(n);
+	}
+}
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef _SMP_BENCH_UTILS_H
+#define _SMP_BENCH_UTILS_H
+
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/sys/printk.h>
+
+/* Same line format as latency_measure, so that the results can be
+ * recorded by the same twister harness regex and compared across
+ * releases.
+ */
+#ifdef CSV_FORMAT_OUTPUT
+#define FORMAT_STR   "%-60s,%s,%s\n"
+#define CYCLE_FORMAT "%8u"
+#define NSEC_FORMAT  "%8u"
+#else
+#define FORMAT_STR   "%-60s:%s , %s\n"
+#define CYCLE_FORMAT "%8u cycles"
+#define NSEC_FORMAT  "%8u ns"
+#endif
+
+#define PRINT_STATS(summary, cycles)                                          \
+	do {                                                                  \
+		char cycle_str[32];                                           \
+		char nsec_str[32];                                            \
+									      \
+		snprintk(cycle_str, sizeof(cycle_str), CYCLE_FORMAT,          \
+			 (uint32_t)(cycles));                                 \
+		snprintk(nsec_str, sizeof(nsec_str), NSEC_FORMAT,             \
+			 (uint32_t)timing_cycles_to_ns(cycles));              \
+		printk(FORMAT_STR, summary, cycle_str, nsec_str);             \
+	} while (0)
+
+#define PRINT_STATS_AVG(summary, cycles, count)                               \
+	do {                                                                  \
+		char cycle_str[32];                                           \
+		char nsec_str[32];                                            \
+									      \
+		snprintk(cycle_str, sizeof(cycle_str), CYCLE_FORMAT,          \
+			 (uint32_t)((cycles) / (count)));                     \
+		snprintk(nsec_str, sizeof(nsec_str), NSEC_FORMAT,             \
+			 (uint32_t)timing_cycles_to_ns_avg(cycles, count));   \
+		printk(FORMAT_STR, summary, cycle_str, nsec_str);             \
+	} while (0)
+
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+extern int error_count;
+
+/* Create a thread pinned to @p cpu and start it */
+static inline k_tid_t start_on_cpu(struct k_thread *thread,
+				   k_thread_stack_t *stack,
+				   k_thread_entry_t entry, void *p1, void *p2,
+				   void *p3, int prio, int cpu)
+{
+	k_tid_t tid = k_thread_create(thread, stack, STACK_SIZE, entry,
+				      p1, p2, p3, prio, 0, K_FOREVER);
+
+	(void)k_thread_cpu_pin(tid, cpu);
+	k_thread_start(tid);
+
+	return tid;
+}
+
+/* Spin until @p counter reaches @p value, to start threads together */
+static inline void wait_for(atomic_t *counter, atomic_val_t value)
+{
+	while (atomic_get(counter) < value) {
+		arch_spin_relax();
+	}
+}
+
+#endif /* _SMP_BENCH_UTILS_H */
@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * Cross-CPU wakeup latency: time from a k_sem_give() on CPU 0 to the
+ * woken thread running on CPU 1, which involves an IPI when CPU 1 is
+ * idle. The same measurement with both threads on CPU 0 is given as
+ * a reference.
+ */
+
+#include "utils.h"
+
+#define N_WAKEUPS 1000
+
+static K_THREAD_STACK_DEFINE(waiter_stack, STACK_SIZE);
+static struct k_thread waiter_thread;
+
+static K_SEM_DEFINE(wake_sem, 0, 1);
+static K_SEM_DEFINE(done_sem, 0, 1);
+
+static timing_t give_stamp;
+static uint64_t total_cycles;
+
+static void waiter(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (int i = 0; i < N_WAKEUPS; i++) {
+		timing_t now;
+
+		k_sem_take(&wake_sem, K_FOREVER);
+		now = timing_counter_get();
+		total_cycles += timing_cycles_get(&give_stamp, &now);
+		k_sem_give(&done_sem);
+	}
+}
+
+static uint64_t run(int cpu)
+{
+	total_cycles = 0U;
+
+	/* Higher priority than the driver thread, so that the same CPU
+	 * case switches to it right away.
+	 */
+	start_on_cpu(&waiter_thread, waiter_stack, waiter, NULL, NULL, NULL,
+		     K_PRIO_PREEMPT(5), cpu);
+
+	for (int i = 0; i < N_WAKEUPS; i++) {
+		/* Let the waiter pend and its CPU go idle */
+		k_busy_wait(50);
+
+		give_stamp = timing_counter_get();
+		k_sem_give(&wake_sem);
+		k_sem_take(&done_sem, K_FOREVER);
+	}
+
+	k_thread_join(&waiter_thread, K_FOREVER);
+
+	return total_cycles;
+}
+
+void wakeup_bench(void)
+{
+	PRINT_STATS_AVG("Wakeup latency, same CPU", run(0), N_WAKEUPS);
+	PRINT_STATS_AVG("Wakeup latency, other CPU (IPI)", run(1), N_WAKEUPS);
+}
@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef BENCH_H_
+#define BENCH_H_
+
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+
+/* Flash wear, as seen by the flash simulator */
+struct wear {
+	uint32_t bytes_written;
+	uint32_t pages_erased;
+};
+
+void wear_get(struct wear *w);
+void wear_print(const char *name, const struct wear *start, size_t written);
+
+static inline uint64_t bench_ns(timing_t *start, timing_t *end)
+{
+	return timing_cycles_to_ns(timing_cycles_get(start, end));
+}
+
+static inline void print_throughput(const char *name, size_t bytes,
+				    uint64_t ns)
+{
+	printk("%-20s %8u KiB/s\n", name,
+	       (uint32_t)(bytes * NSEC_PER_SEC / 1024U / MAX(ns, 1U)));
+}
+
+static inline void print_rate(const char *name, uint32_t n, uint64_t ns)
+{
+	uint64_t avg = ns / n;
+
+	printk("%-20s %8u us %8u ops/s\n", name,
+	       (uint32_t)(avg / NSEC_PER_USEC),
+	       (uint32_t)(NSEC_PER_SEC / MAX(avg, 1U)));
+}
+
+int bench_fs_mount(void);
+int bench_fs(void);
+int bench_nvs(void);
+int bench_settings(void);
+
+#endif /* BENCH_H_ */
@@ -0,0 +1,303 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <zephyr/fs/fs.h>
+#include <zephyr/random/rand32.h>
+
+#include "bench.h"
+
+#define BLOCK_SIZE CONFIG_BENCH_STORAGE_BLOCK_SIZE
+#define FILE_BLOCKS (CONFIG_BENCH_STORAGE_FILE_SIZE / BLOCK_SIZE)
+#define SMALL_FILES CONFIG_BENCH_STORAGE_SMALL_FILES
+#define SMALL_FILE_SIZE 32
+
+#if defined(CONFIG_FILE_SYSTEM_LITTLEFS)
+#include <zephyr/fs/littlefs.h>
+#include <zephyr/storage/flash_map.h>
+
+FS_LITTLEFS_DECLARE_DEFAULT_CONFIG(lfs_data);
+static struct fs_mount_t mnt = {
+	.type = FS_LITTLEFS,
+	.fs_data = &lfs_data,
+	.storage_dev = (void *)FIXED_PARTITION_ID(storage_partition),
+	.mnt_point = "/lfs",
+};
+#else
+
+#if defined(CONFIG_DISK_DRIVER_RAM)
+#define DISK_NAME CONFIG_DISK_RAM_VOLUME_NAME
+#elif defined(CONFIG_DISK_DRIVER_SDMMC)
+#define DISK_NAME CONFIG_SDMMC_VOLUME_NAME
+#elif defined(CONFIG_DISK_DRIVER_MMC)
+#define DISK_NAME CONFIG_MMC_VOLUME_NAME
+#else
+#error "Failed to select disk access type"
+#endif
+
+#if defined(CONFIG_FAT_FILESYSTEM_ELM)
+#include <ff.h>
+
+static FATFS fat_fs;
+static struct fs_mount_t mnt = {
+	.type = FS_FATFS,
+	.fs_data = &fat_fs,
+	.storage_dev = (void *)DISK_NAME,
+	.mnt_point = "/"DISK_NAME":",
+};
+#elif defined(CONFIG_FILE_SYSTEM_EXT2)
+static struct fs_mount_t mnt = {
+	.type = FS_EXT2,
+	.storage_dev = (void *)DISK_NAME,
+	.mnt_point = "/ext",
+};
+#else
+#error "Unsupported file system"
+#endif
+
+#endif /* CONFIG_FILE_SYSTEM_LITTLEFS */
+
+static uint8_t buf[BLOCK_SIZE];
+static char path[MAX_FILE_NAME + 1];
+
+static const char *bench_path(const char *name)
+{
+	snprintf(path, sizeof(path), "%s/%s", mnt.mnt_point, name);
+	return path;
+}
+
+int bench_fs_mount(void)
+{
+	int ret;
+
+#if defined(CONFIG_FILE_SYSTEM_LITTLEFS)
+	const struct flash_area *fa;
+
+	/* start from a blank file system */
+	ret = flash_area_open((uintptr_t)mnt.storage_dev, &fa);
+	if (ret == 0) {
+		ret = flash_area_erase(fa, 0, fa->fa_size);
+		flash_area_close(fa);
+	}
+#else
+	ret = fs_mkfs(mnt.type, (uintptr_t)mnt.storage_dev, NULL, 0);
+#endif
+	if (ret != 0) {
+		return ret;
+	}
+
+	return fs_mount(&mnt);
+}
+
+static int bench_seq(void)
+{
+	struct fs_file_t file;
+	timing_t start, end;
+	struct wear wear;
+	uint64_t ns;
+	int ret;
+
+	fs_file_t_init(&file);
+	wear_get(&wear);
+
+	start = timing_counter_get();
+	ret = fs_open(&file, bench_path("seq.bin"), FS_O_CREATE | FS_O_RDWR);
+	for (int i = 0; ret == 0 && i < FILE_BLOCKS; i++) {
+		ret = fs_write(&file, buf, sizeof(buf)) == sizeof(buf) ? 0 : -EIO;
+	}
+	if (ret == 0) {
+		ret = fs_close(&file);
+	}
+	end = timing_counter_get();
+
+	if (ret != 0) {
+		return ret;
+	}
+
+	ns = bench_ns(&start, &end);
+	print_throughput("seq write", FILE_BLOCKS * BLOCK_SIZE, ns);
+	wear_print("seq write wear", &wear, FILE_BLOCKS * BLOCK_SIZE);
+
+	start = timing_counter_get();
+	ret = fs_open(&file, bench_path("seq.bin"), FS_O_READ);
+	for (int i = 0; ret == 0 && i < FILE_BLOCKS; i++) {
+		ret = fs_read(&file, buf, sizeof(buf)) == sizeof(buf) ? 0 : -EIO;
+	}
+	if (ret == 0) {
+		ret = fs_close(&file);
+	}
+	end = timing_counter_get();
+
+	if (ret != 0) {
+		return ret;
+	}
+
+	ns = bench_ns(&start, &end);
+	print_throughput("seq read", FILE_BLOCKS * BLOCK_SIZE, ns);
+
+	return 0;
+}
+
+static int bench_random(void)
+{
+	static uint16_t offsets[FILE_BLOCKS];
+	struct fs_file_t file;
+	timing_t start, end;
+	struct wear wear;
+	uint64_t ns;
+	int ret;
+
+	for (int i = 0; i < FILE_BLOCKS; i++) {
+		offsets[i] = sys_rand32_get() % FILE_BLOCKS;
+	}
+
+	fs_file_t_init(&file);
+	wear_get(&wear);
+
+	/* the file written by bench_seq() is overwritten in place */
+	start = timing_counter_get();
+	ret = fs_open(&file, bench_path("seq.bin"), FS_O_RDWR);
+	for (int i = 0; ret == 0 && i < FILE_BLOCKS; i++) {
+		ret = fs_seek(&file, (off_t)offsets[i] * BLOCK_SIZE, FS_SEEK_SET);
+		if (ret == 0) {
+			ret = fs_write(&file, buf, sizeof(buf)) == sizeof(buf) ?
+			      0 : -EIO;
+		}
+	}
+	if (ret == 0) {
+		ret = fs_close(&file);
+	}
+	end = timing_counter_get();
+
+	if (ret != 0) {
+		return ret;
+	}
+
+	ns = bench_ns(&start, &end);
+	print_throughput("random write", FILE_BLOCKS * BLOCK_SIZE, ns);
+	wear_print("random write wear", &wear, FILE_BLOCKS * BLOCK_SIZE);
+
+	start = timing_counter_get();
+	ret = fs_open(&file, bench_path("seq.bin"), FS_O_READ);
+	for (int i = 0; ret == 0 && i < FILE_BLOCKS; i++) {
+		ret = fs_seek(&file, (off_t)offsets[i] * BLOCK_SIZE, FS_SEEK_SET);
+		if (ret == 0) {
+			ret = fs_read(&file, buf, sizeof(buf)) == sizeof(buf) ?
+			      0 : -EIO;
+		}
+	}
+	if (ret == 0) {
+		ret = fs_close(&file);
+	}
+	end = timing_counter_get();
+
+	if (ret != 0) {
+		return ret;
+	}
+
+	ns = bench_ns(&start, &end);
+	print_throughput("random read", FILE_BLOCKS * BLOCK_SIZE, ns);
+
+	return fs_unlink(bench_path("seq.bin"));
+}
+
+static int bench_small_files(void)
+{
+	struct fs_dirent entry;
+	struct fs_file_t file;
+	timing_t start, end;
+	struct wear wear;
+	char name[16];
+	uint64_t ns = 0U;
+	int ret = 0;
+
+	fs_file_t_init(&file);
+	wear_get(&wear);
+
+	for (int i = 0; ret == 0 && i < SMALL_FILES; i++) {
+		snprintf(name, sizeof(name), "f%03d.bin", i);
+		bench_path(name);
+
+		start = timing_counter_get();
+		ret = fs_open(&file, path, FS_O_CREATE | FS_O_WRITE);
+		if (ret == 0) {
+			if (fs_write(&file, buf, SMALL_FILE_SIZE) !=
+			    SMALL_FILE_SIZE) {
+				ret = -EIO;
+			}
+			if (fs_close(&file) != 0) {
+				ret = -EIO;
+			}
+		}
+		end = timing_counter_get();
+
+		ns += bench_ns(&start, &end);
+	}
+
+	if (ret != 0) {
+		return ret;
+	}
+
+	print_rate("create", SMALL_FILES, ns);
+	wear_print("create wear", &wear, SMALL_FILES * SMALL_FILE_SIZE);
+
+	ns = 0U;
+	for (int i = 0; ret == 0 && i < SMALL_FILES; i++) {
+		snprintf(name, sizeof(name), "f%03d.bin", i);
+		bench_path(name);
+
+		start = timing_counter_get();
+		ret = fs_stat(path, &entry);
+		end = timing_counter_get();
+
+		ns += bench_ns(&start, &end);
+	}
+
+	if (ret != 0) {
+		return ret;
+	}
+
+	print_rate("stat", SMALL_FILES, ns);
+
+	ns = 0U;
+	for (int i = 0; ret == 0 && i < SMALL_FILES; i++) {
+		snprintf(name, sizeof(name), "f%03d.bin", i);
+		bench_path(name);
+
+		start = timing_counter_get();
+		ret = fs_unlink(path);
+		end = timing_counter_get();
+
+		ns += bench_ns(&start, &end);
+	}
+
+	if (ret != 0) {
+		return ret;
+	}
+
+	print_rate("unlink", SMALL_FILES, ns);
+
+	return 0;
+}
+
+int bench_fs(void)
+{
+	int ret;
+
+	for (int i = 0; i < ARRAY_SIZE(buf); i++) {
+		buf[i] = (uint8_t)(i * 7U + 3U);
+	}
+
+	ret = bench_seq();
+	if (ret == 0) {
+		ret = bench_random();
+	}
+	if (ret == 0) {
+		ret = bench_small_files();
+	}
+
+	return ret;
+}
@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+
+#include "bench.h"
+
+/* Storage benchmark. Which parts run depends on the configuration:
+ *
+ *  - file system (LittleFS, FAT or ext2): sequential and random read and
+ *    write throughput, small file create, stat and unlink rates
+ *  - NVS: write latency, including stalls caused by garbage collection
+ *  - settings: settings_load() time against the number of keys stored
+ *
+ * On the flash simulator the flash wear caused by each measurement is
+ * also reported, per MiB written by the benchmark.
+ */
+
+int main(void)
+{
+	int ret;
+
+	timing_init();
+	timing_start();
+
+	if (IS_ENABLED(CONFIG_FILE_SYSTEM)) {
+		ret = bench_fs_mount();
+		if (ret == 0) {
+			ret = bench_fs();
+		}
+		if (ret != 0) {
+			printk("file system benchmark failed (%d)\n", ret);
+		}
+	}
+
+	/* settings stored in NVS own the storage partition */
+	if (IS_ENABLED(CONFIG_NVS) && !IS_ENABLED(CONFIG_SETTINGS)) {
+		ret = bench_nvs();
+		if (ret != 0) {
+			printk("NVS benchmark failed (%d)\n", ret);
+		}
+	}
+
+	if (IS_ENABLED(CONFIG_SETTINGS)) {
+		ret = bench_settings();
+		if (ret != 0) {
+			printk("settings benchmark failed (%d)\n", ret);
+		}
+	}
+
+	timing_stop();
+	printk("fin\n");
+	return 0;
+}
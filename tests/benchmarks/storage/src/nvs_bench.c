@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <zephyr/drivers/flash.h>
+#include <zephyr/fs/nvs.h>
+#include <zephyr/storage/flash_map.h>
+
+#include "bench.h"
+
+#define N_WRITES CONFIG_BENCH_STORAGE_NVS_WRITES
+#define ENTRY_SIZE CONFIG_BENCH_STORAGE_NVS_ENTRY_SIZE
+#define N_IDS 16
+
+/* A write taking longer than this many times the fastest one is
+ * considered to have been stalled by garbage collection.
+ */
+#define STALL_FACTOR 4
+
+static struct nvs_fs fs;
+static uint32_t latency_ns[N_WRITES];
+
+static int nvs_bench_mount(void)
+{
+	struct flash_pages_info info;
+	const struct flash_area *fa;
+	int ret;
+
+	ret = flash_area_open(FIXED_PARTITION_ID(storage_partition), &fa);
+	if (ret != 0) {
+		return ret;
+	}
+
+	/* start from a blank partition */
+	ret = flash_area_erase(fa, 0, fa->fa_size);
+	if (ret != 0) {
+		flash_area_close(fa);
+		return ret;
+	}
+
+	fs.flash_device = flash_area_get_device(fa);
+	fs.offset = fa->fa_off;
+	ret = flash_get_page_info_by_offs(fs.flash_device, fs.offset, &info);
+	if (ret == 0) {
+		fs.sector_size = info.size;
+		fs.sector_count = fa->fa_size / info.size;
+		ret = nvs_mount(&fs);
+	}
+
+	flash_area_close(fa);
+
+	return ret;
+}
+
+int bench_nvs(void)
+{
+	uint8_t data[ENTRY_SIZE];
+	uint32_t min = UINT32_MAX, max = 0U, stalls = 0U;
+	timing_t start, end;
+	struct wear wear;
+	uint64_t total = 0U;
+	int ret;
+
+	ret = nvs_bench_mount();
+	if (ret != 0) {
+		return ret;
+	}
+
+	wear_get(&wear);
+
+	for (int i = 0; i < N_WRITES; i++) {
+		ssize_t len;
+
+		/* every write changes the data, so none is skipped */
+		memset(data, i, sizeof(data));
+
+		start = timing_counter_get();
+		len = nvs_write(&fs, i % N_IDS, data, sizeof(data));
+		end = timing_counter_get();
+
+		if (len != sizeof(data)) {
+			return len < 0 ? (int)len : -EIO;
+		}
+
+		latency_ns[i] = (uint32_t)bench_ns(&start, &end);
+		total += latency_ns[i];
+		min = MIN(min, latency_ns[i]);
+		max = MAX(max, latency_ns[i]);
+	}
+
+	for (int i = 0; i < N_WRITES; i++) {
+		if (latency_ns[i] > min * STALL_FACTOR) {
+			stalls++;
+		}
+	}
+
+	printk("%-20s %8u us avg %8u us max %4u stalls\n", "nvs write",
+	       (uint32_t)(total / N_WRITES / NSEC_PER_USEC),
+	       max / NSEC_PER_USEC, stalls);
+	wear_print("nvs write wear", &wear, N_WRITES * ENTRY_SIZE);
+
+	return 0;
+}
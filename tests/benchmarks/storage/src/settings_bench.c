@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <zephyr/settings/settings.h>
+
+#include "bench.h"
+
+static const uint16_t key_counts[] = { 16, 64, 256 };
+static uint32_t loaded;
+
+static int bench_set(const char *name, size_t len, settings_read_cb read_cb,
+		     void *cb_arg)
+{
+	uint32_t val;
+
+	ARG_UNUSED(name);
+
+	if (len != sizeof(val) || read_cb(cb_arg, &val, sizeof(val)) < 0) {
+		return -EINVAL;
+	}
+
+	loaded++;
+
+	return 0;
+}
+
+SETTINGS_STATIC_HANDLER_DEFINE(bench, "bench", NULL, bench_set, NULL, NULL);
+
+int bench_settings(void)
+{
+	char name[SETTINGS_MAX_NAME_LEN + 1];
+	uint32_t stored = 0U;
+	timing_t start, end;
+	struct wear wear;
+	int ret;
+
+	ret = settings_subsys_init();
+	if (ret != 0) {
+		return ret;
+	}
+
+	wear_get(&wear);
+
+	for (int i = 0; i < ARRAY_SIZE(key_counts); i++) {
+		while (stored < key_counts[i]) {
+			snprintf(name, sizeof(name), "bench/k%u", stored);
+			ret = settings_save_one(name, &stored, sizeof(stored));
+			if (ret != 0) {
+				return ret;
+			}
+			stored++;
+		}
+
+		loaded = 0U;
+		start = timing_counter_get();
+		ret = settings_load();
+		end = timing_counter_get();
+
+		if (ret != 0) {
+			return ret;
+		}
+		if (loaded != stored) {
+			return -EIO;
+		}
+
+		printk("settings load %4u keys %8u us\n", stored,
+		       (uint32_t)(bench_ns(&start, &end) / NSEC_PER_USEC));
+	}
+
+	wear_print("settings save wear", &wear, stored * sizeof(stored));
+
+	return 0;
+}
@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <zephyr/stats/stats.h>
+
+#include "bench.h"
+
+#ifdef CONFIG_FLASH_SIMULATOR_STATS
+static int wear_walk(struct stats_hdr *hdr, void *arg, const char *name,
+		     uint16_t off)
+{
+	struct wear *w = arg;
+	uint32_t val = *(uint32_t *)((uint8_t *)hdr + off);
+
+	if (strcmp(name, "bytes_written") == 0) {
+		w->bytes_written = val;
+	} else if (strncmp(name, "erase_cycles_unit",
+			   sizeof("erase_cycles_unit") - 1) == 0) {
+		w->pages_erased += val;
+	}
+
+	return 0;
+}
+#endif
+
+void wear_get(struct wear *w)
+{
+	memset(w, 0, sizeof(*w));
+
+#ifdef CONFIG_FLASH_SIMULATOR_STATS
+	struct stats_hdr *hdr = stats_group_find("flash_sim_stats");
+
+	if (hdr != NULL) {
+		(void)stats_walk(hdr, wear_walk, w);
+	}
+#endif
+}
+
+void wear_print(const char *name, const struct wear *start, size_t written)
+{
+	struct wear end;
+	uint64_t div = MAX(written, 1U);
+
+	if (!IS_ENABLED(CONFIG_FLASH_SIMULATOR_STATS)) {
+		return;
+	}
+
+	wear_get(&end);
+
+	/* figures per MiB written by the application */
+	printk("%-20s %8u pages erased/MiB %8u KiB programmed/MiB\n", name,
+	       (uint32_t)((uint64_t)(end.pages_erased - start->pages_erased) *
+			  MB(1) / div),
+	       (uint32_t)((uint64_t)(end.bytes_written - start->bytes_written) *
+			  1024U / div));
+}
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/timing/timing.h>
+
+/* String microbenchmark. For each memory function, alignment and buffer
+ * length the average number of cycles spent per call is printed, along
+ * with the throughput.
+ */
+
+#define MAX_LEN 4096
+#define N_OPS 64
+
+static uint8_t src[MAX_LEN + 8] __aligned(8);
+static uint8_t dst[MAX_LEN + 8] __aligned(8);
+static const size_t lengths[] = { 16, 64, 256, 1500, 4096 };
+
+/* Keep the compiler from optimizing the comparisons away */
+static volatile int result;
+
+static int run_memcpy(uint8_t *d, const uint8_t *s, size_t len)
+{
+	(void)memcpy(d, s, len);
+	return 0;
+}
+
+static int run_memset(uint8_t *d, const uint8_t *s, size_t len)
+{
+	ARG_UNUSED(s);
+
+	(void)memset(d, 0x5a, len);
+	return 0;
+}
+
+static int run_memcmp(uint8_t *d, const uint8_t *s, size_t len)
+{
+	return memcmp(d, s, len);
+}
+
+static const struct {
+	const char *name;
+	int (*run)(uint8_t *d, const uint8_t *s, size_t len);
+} funcs[] = {
+	{ "memcpy", run_memcpy },
+	{ "memset", run_memset },
+	{ "memcmp", run_memcmp },
+};
+
+/* Offsets of the source and destination buffers */
+static const struct {
+	const char *name;
+	size_t s_off;
+	size_t d_off;
+} alignments[] = {
+	{ "aligned", 0, 0 },
+	{ "misaligned", 1, 2 },
+};
+
+static void bench_len(int f, int a, size_t len)
+{
+	uint8_t *d = &dst[alignments[a].d_off];
+	const uint8_t *s = &src[alignments[a].s_off];
+	timing_t start, end;
+	uint32_t cycles;
+	int ret = 0;
+
+	/* memcmp() compares equal buffers, the slowest case */
+	(void)memcpy(d, s, len);
+
+	start = timing_counter_get();
+	for (int i = 0; i < N_OPS; i++) {
+		ret |= funcs[f].run(d, s, len);
+	}
+	end = timing_counter_get();
+
+	result = ret;
+	cycles = MAX((uint32_t)(timing_cycles_get(&start, &end) / N_OPS), 1U);
+
+	printk("%-6s %-10s len %4zu %8u cycles %6u bytes/kcycle\n",
+	       funcs[f].name, alignments[a].name, len, cycles,
+	       (uint32_t)(len * 1000U / cycles));
+}
+
+int main(void)
+{
+	for (int i = 0; i < ARRAY_SIZE(src); i++) {
+		src[i] = (uint8_t)(i * 7U + 3U);
+	}
+
+	timing_init();
+	timing_start();
+
+	unsigned int key = irq_lock();
+
+	for (int f = 0; f < ARRAY_SIZE(funcs); f++) {
+		for (int a = 0; a < ARRAY_SIZE(alignments); a++) {
+			for (int j = 0; j < ARRAY_SIZE(lengths); j++) {
+				bench_len(f, a, lengths[j]);
+			}
+		}
+	}
+
+	irq_unlock(key);
+
+	timing_stop();
+	printk("fin\n");
+	return 0;
+}
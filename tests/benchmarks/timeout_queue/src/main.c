@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/timeout_q.h>
+
+/* Timeout queue microbenchmark.  For each queue depth N the queue is
+ * filled with N timeouts far enough in the future that none of them
+ * fires, then the average cost of one more insertion, of aborting a
+ * random timeout, and of announcing a tick on which (about) one
+ * timeout expires is printed.  The timer driver is left alone by
+ * announcing ticks directly, so results are only meaningful relative
+ * to each other.
+ */
+
+#define N_MAX 10000
+#define N_OPS 64
+
+/* Far enough that nothing armed below expires during a run */
+#define BASE_TICKS 1000000
+
+static struct _timeout timeouts[N_MAX + N_OPS];
+static const int depths[] = { 10, 100, 1000, N_MAX };
+static uint32_t lcg_state = 12345U;
+
+static uint32_t pseudo_rand(void)
+{
+	lcg_state = lcg_state * 1103515245U + 12345U;
+	return lcg_state >> 8;
+}
+
+static void expire_fn(struct _timeout *t)
+{
+	ARG_UNUSED(t);
+}
+
+static k_timeout_t far_timeout(void)
+{
+	return K_TICKS(BASE_TICKS + (pseudo_rand() % BASE_TICKS));
+}
+
+static uint32_t avg_cycles(timing_t start, timing_t end, int ops)
+{
+	return (uint32_t)(timing_cycles_get(&start, &end) / ops);
+}
+
+static void bench_depth(int n)
+{
+	timing_t start, end;
+	uint32_t add, abort, announce;
+
+	for (int i = 0; i < n; i++) {
+		z_add_timeout(&timeouts[i], expire_fn, far_timeout());
+	}
+
+	start = timing_counter_get();
+	for (int i = 0; i < N_OPS; i++) {
+		z_add_timeout(&timeouts[n + i], expire_fn, far_timeout());
+	}
+	end = timing_counter_get();
+	add = avg_cycles(start, end, N_OPS);
+
+	start = timing_counter_get();
+	for (int i = 0; i < N_OPS; i++) {
+		z_abort_timeout(&timeouts[pseudo_rand() % (n + N_OPS)]);
+	}
+	end = timing_counter_get();
+	abort = avg_cycles(start, end, N_OPS);
+
+	/* One timeout due on each of the next N_OPS ticks */
+	for (int i = 0; i < N_OPS; i++) {
+		z_abort_timeout(&timeouts[n + i]);
+		z_add_timeout(&timeouts[n + i], expire_fn, K_TICKS(i));
+	}
+
+	start = timing_counter_get();
+	for (int i = 0; i < N_OPS; i++) {
+		sys_clock_announce(1);
+	}
+	end = timing_counter_get();
+	announce = avg_cycles(start, end, N_OPS);
+
+	printk("N %5d add %5u abort %5u announce %5u\n", n, add, abort,
+	       announce);
+
+	for (int i = 0; i < n + N_OPS; i++) {
+		z_abort_timeout(&timeouts[i]);
+	}
+}
+
+int main(void)
+{
+	timing_init();
+	timing_start();
+
+	for (int i = 0; i < ARRAY_SIZE(timeouts); i++) {
+		z_init_timeout(&timeouts[i]);
+	}
+
+	/* Keep the timer ISR from announcing ticks behind our back */
+	unsigned int key = irq_lock();
+
+	for (int i = 0; i < ARRAY_SIZE(depths); i++) {
+		bench_depth(depths[i]);
+	}
+
+	irq_unlock(key);
+
+	timing_stop();
+	printk("fin\n");
+	return 0;
+}
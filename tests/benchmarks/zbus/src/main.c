@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * A publisher updates the channel periodically while readers of lower priority read it in a
+ * loop. The readers check that every message they read is whole, the publisher recording the
+ * time taken by each publication.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/zbus/zbus.h>
+
+#define MAX_READERS	 8
+#define READER_PRIO	 K_LOWEST_APPLICATION_THREAD_PRIO
+#define STACK_SIZE	 1024
+#define PUB_PERIOD	 K_MSEC(1)
+#define RUN_PUBLICATIONS 1000
+
+/* Orientation of an IMU, all the fields are equal in a whole message */
+struct orientation_msg {
+	uint32_t seq;
+	int32_t quat[4];
+};
+
+ZBUS_CHAN_DEFINE(mutex_chan,		 /* Name */
+		 struct orientation_msg, /* Message type */
+
+		 NULL,		       /* Validator */
+		 NULL,		       /* User data */
+		 ZBUS_OBSERVERS_EMPTY, /* observers */
+		 ZBUS_MSG_INIT(0)      /* Initial value */
+);
+
+ZBUS_CHAN_SEQLOCK_DEFINE(seqlock_chan,		 /* Name */
+			 struct orientation_msg, /* Message type */
+
+			 NULL,		       /* Validator */
+			 NULL,		       /* User data */
+			 ZBUS_OBSERVERS_EMPTY, /* observers */
+			 ZBUS_MSG_INIT(0)      /* Initial value */
+);
+
+static K_THREAD_STACK_ARRAY_DEFINE(reader_stacks, MAX_READERS, STACK_SIZE);
+static struct k_thread reader_threads[MAX_READERS];
+
+static const struct zbus_channel *bench_chan;
+static atomic_t running;
+static atomic_t reads;
+static atomic_t torn;
+
+static void reader(void *p1, void *p2, void *p3)
+{
+	struct orientation_msg msg;
+
+	while (atomic_get(&running)) {
+		if (zbus_chan_read(bench_chan, &msg, K_FOREVER) != 0) {
+			continue;
+		}
+
+		for (int i = 0; i < ARRAY_SIZE(msg.quat); i++) {
+			if (msg.quat[i] != (int32_t)msg.seq) {
+				atomic_inc(&torn);
+				break;
+			}
+		}
+
+		atomic_inc(&reads);
+	}
+}
+
+static int run(const char *name, const struct zbus_channel *chan, int readers)
+{
+	struct orientation_msg msg;
+	uint64_t pub_total = 0;
+	uint32_t pub_max = 0;
+	uint32_t start;
+	uint32_t cycles;
+	int64_t uptime;
+	int err;
+
+	bench_chan = chan;
+	atomic_set(&running, 1);
+	atomic_set(&reads, 0);
+	atomic_set(&torn, 0);
+
+	for (int i = 0; i < readers; i++) {
+		k_thread_create(&reader_threads[i], reader_stacks[i], STACK_SIZE, reader, NULL,
+				NULL, NULL, READER_PRIO, 0, K_NO_WAIT);
+	}
+
+	uptime = k_uptime_get();
+
+	for (uint32_t seq = 0; seq < RUN_PUBLICATIONS; seq++) {
+		msg.seq = seq;
+		for (int i = 0; i < ARRAY_SIZE(msg.quat); i++) {
+			msg.quat[i] = seq;
+		}
+
+		start = k_cycle_get_32();
+		err = zbus_chan_pub(chan, &msg, K_FOREVER);
+		cycles = k_cycle_get_32() - start;
+		if (err != 0) {
+			printk("publication failure: %d\n", err);
+			return err;
+		}
+
+		pub_total += cycles;
+		pub_max = MAX(pub_max, cycles);
+
+		k_sleep(PUB_PERIOD);
+	}
+
+	uptime = k_uptime_delta(&uptime);
+
+	atomic_set(&running, 0);
+	for (int i = 0; i < readers; i++) {
+		k_thread_join(&reader_threads[i], K_FOREVER);
+	}
+
+	if (atomic_get(&torn) != 0) {
+		printk("%ld torn reads\n", (long)atomic_get(&torn));
+		return -EIO;
+	}
+
+	printk("%-7s readers %d reads %u/s pub avg %u ns max %u ns\n", name, readers,
+	       (uint32_t)((uint64_t)atomic_get(&reads) * MSEC_PER_SEC / MAX(uptime, 1)),
+	       (uint32_t)(k_cyc_to_ns_floor64(pub_total) / RUN_PUBLICATIONS),
+	       (uint32_t)k_cyc_to_ns_floor64(pub_max));
+
+	return 0;
+}
+
+int main(void)
+{
+	int err;
+
+	printk("Zbus channel benchmark on %s\n", CONFIG_BOARD);
+
+	for (int readers = 1; readers <= MAX_READERS; readers *= 2) {
+		err = run("mutex", &mutex_chan, readers);
+		if (err != 0) {
+			return err;
+		}
+	}
+
+	for (int readers = 1; readers <= MAX_READERS; readers *= 2) {
+		err = run("seqlock", &seqlock_chan, readers);
+		if (err != 0) {
+			return err;
+		}
+	}
+
+	printk("PROJECT EXECUTION SUCCESSFUL\n");
+
+	return 0;
+}
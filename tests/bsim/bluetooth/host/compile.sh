@@ -58,6 +58,8 @@ app=tests/bsim/bluetooth/host/l2cap/send_on_connect compile
 app=tests/bsim/bluetooth/host/l2cap/send_on_connect conf_file=prj_ecred.conf compile
 
 app=tests/bsim/bluetooth/host/misc/disable compile
+app=tests/bsim/bluetooth/host/misc/benchmark compile
+app=tests/bsim/bluetooth/host/misc/benchmark conf_file=prj_large.conf compile
 
 app=tests/bsim/bluetooth/host/privacy/central compile
 app=tests/bsim/bluetooth/host/privacy/peripheral compile
@@ -0,0 +1,306 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "common.h"
+
+CREATE_FLAG(flag_mtu_exchanged);
+CREATE_FLAG(flag_notified);
+CREATE_FLAG(flag_l2cap_connected);
+
+static K_SEM_DEFINE(read_sem, 0, 1);
+static K_SEM_DEFINE(sent_sem, 0, 1);
+
+static uint32_t notify_count;
+static size_t notify_bytes;
+static uint64_t notify_first_us;
+static uint64_t notify_last_us;
+
+/* Only one SDU is sent at a time */
+NET_BUF_POOL_DEFINE(sdu_tx_pool, 1, BT_L2CAP_SDU_BUF_SIZE(SDU_LEN), 8, NULL);
+
+static struct bt_l2cap_le_chan l2cap_chan;
+
+static void device_found(const bt_addr_le_t *addr, int8_t rssi, uint8_t type,
+			 struct net_buf_simple *ad)
+{
+	struct bt_conn *conn;
+	int err;
+
+	err = bt_le_scan_stop();
+	if (err != 0) {
+		FAIL("Stop LE scan failed (err %d)\n", err);
+		return;
+	}
+
+	err = bt_conn_le_create(addr, BT_CONN_LE_CREATE_CONN, BT_LE_CONN_PARAM_DEFAULT, &conn);
+	if (err != 0) {
+		FAIL("Create conn failed (err %d)\n", err);
+		return;
+	}
+
+	bt_conn_unref(conn);
+}
+
+#if defined(CONFIG_BT_USER_DATA_LEN_UPDATE)
+CREATE_FLAG(flag_data_len_updated);
+
+static void data_len_updated(struct bt_conn *conn, struct bt_conn_le_data_len_info *info)
+{
+	printk("Data length updated: tx %u rx %u\n", info->tx_max_len, info->rx_max_len);
+	SET_FLAG(flag_data_len_updated);
+}
+
+BT_CONN_CB_DEFINE(central_conn_callbacks) = {
+	.le_data_len_updated = data_len_updated,
+};
+#endif /* CONFIG_BT_USER_DATA_LEN_UPDATE */
+
+static void mtu_exchanged(struct bt_conn *conn, uint8_t err,
+			  struct bt_gatt_exchange_params *params)
+{
+	if (err != 0) {
+		FAIL("MTU exchange failed (err %u)\n", err);
+		return;
+	}
+
+	SET_FLAG(flag_mtu_exchanged);
+}
+
+/* Use the largest ATT MTU and data length the configuration allows */
+static void update_mtu_and_data_len(void)
+{
+	static struct bt_gatt_exchange_params exchange_params = {
+		.func = mtu_exchanged,
+	};
+	int err;
+
+	err = bt_gatt_exchange_mtu(bench_conn, &exchange_params);
+	if (err != 0) {
+		FAIL("MTU exchange failed (err %d)\n", err);
+		return;
+	}
+
+	WAIT_FOR_FLAG(flag_mtu_exchanged);
+
+#if defined(CONFIG_BT_USER_DATA_LEN_UPDATE)
+	err = bt_conn_le_data_len_update(bench_conn, BT_LE_DATA_LEN_PARAM_MAX);
+	if (err != 0) {
+		FAIL("Data length update failed (err %d)\n", err);
+		return;
+	}
+
+	WAIT_FOR_FLAG(flag_data_len_updated);
+#endif
+}
+
+static uint8_t notified(struct bt_conn *conn, struct bt_gatt_subscribe_params *params,
+			const void *data, uint16_t length)
+{
+	uint64_t now = bench_now_us();
+
+	if (data == NULL) {
+		return BT_GATT_ITER_STOP;
+	}
+
+	/* the rate is measured from the reception of the first notification */
+	if (notify_count++ == 0U) {
+		notify_first_us = now;
+	} else {
+		notify_bytes += length;
+	}
+
+	notify_last_us = now;
+
+	if (notify_count == NOTIFY_COUNT) {
+		SET_FLAG(flag_notified);
+	}
+
+	return BT_GATT_ITER_CONTINUE;
+}
+
+static void bench_notify(void)
+{
+	static struct bt_gatt_subscribe_params subscribe_params = {
+		.notify = notified,
+		.value = BT_GATT_CCC_NOTIFY,
+	};
+	int err;
+
+	subscribe_params.value_handle = bt_gatt_attr_get_handle(bench_chrc_attr);
+	subscribe_params.ccc_handle = bt_gatt_attr_get_handle(bench_ccc_attr);
+
+	err = bt_gatt_subscribe(bench_conn, &subscribe_params);
+	if (err != 0) {
+		FAIL("Subscribe failed (err %d)\n", err);
+		return;
+	}
+
+	WAIT_FOR_FLAG(flag_notified);
+
+	bench_print_rate("notify", notify_bytes, notify_last_us - notify_first_us);
+}
+
+static uint8_t read_done(struct bt_conn *conn, uint8_t err, struct bt_gatt_read_params *params,
+			 const void *data, uint16_t length)
+{
+	if (err != 0 || length != READ_LEN) {
+		FAIL("Read failed (err %u, length %u)\n", err, length);
+	}
+
+	k_sem_give(&read_sem);
+
+	return BT_GATT_ITER_STOP;
+}
+
+static void bench_read(void)
+{
+	static struct bt_gatt_read_params read_params = {
+		.func = read_done,
+		.handle_count = 1,
+	};
+	uint64_t total = 0U, max = 0U;
+	int err;
+
+	read_params.single.handle = bt_gatt_attr_get_handle(bench_chrc_attr);
+
+	for (int i = 0; i < READ_COUNT; i++) {
+		uint64_t start = bench_now_us();
+		uint64_t us;
+
+		err = bt_gatt_read(bench_conn, &read_params);
+		if (err != 0) {
+			FAIL("Read failed (err %d)\n", err);
+			return;
+		}
+
+		k_sem_take(&read_sem, K_FOREVER);
+
+		us = bench_now_us() - start;
+		total += us;
+		max = MAX(max, us);
+	}
+
+	printk("att read: avg %u us max %u us\n", (uint32_t)(total / READ_COUNT), (uint32_t)max);
+}
+
+static void l2cap_connected(struct bt_l2cap_chan *chan)
+{
+	SET_FLAG(flag_l2cap_connected);
+}
+
+static int l2cap_recv(struct bt_l2cap_chan *chan, struct net_buf *buf)
+{
+	return 0;
+}
+
+static void l2cap_sent(struct bt_l2cap_chan *chan)
+{
+	k_sem_give(&sent_sem);
+}
+
+static const struct bt_l2cap_chan_ops l2cap_ops = {
+	.connected = l2cap_connected,
+	.recv = l2cap_recv,
+	.sent = l2cap_sent,
+};
+
+static void bench_l2cap(void)
+{
+	int err;
+
+	l2cap_chan.chan.ops = &l2cap_ops;
+	l2cap_chan.rx.mtu = SDU_LEN;
+
+	err = bt_l2cap_chan_connect(bench_conn, &l2cap_chan.chan, L2CAP_PSM);
+	if (err != 0) {
+		FAIL("L2CAP connect failed (err %d)\n", err);
+		return;
+	}
+
+	WAIT_FOR_FLAG(flag_l2cap_connected);
+
+	/* the peripheral measures the throughput */
+	for (int i = 0; i < SDU_COUNT; i++) {
+		struct net_buf *buf = net_buf_alloc(&sdu_tx_pool, K_FOREVER);
+
+		net_buf_reserve(buf, BT_L2CAP_SDU_CHAN_SEND_RESERVE);
+		net_buf_add_mem(buf, bench_data, SDU_LEN);
+
+		err = bt_l2cap_chan_send(&l2cap_chan.chan, buf);
+		if (err < 0) {
+			net_buf_unref(buf);
+			FAIL("L2CAP send failed (err %d)\n", err);
+			return;
+		}
+
+		k_sem_take(&sent_sem, K_FOREVER);
+	}
+}
+
+static void test_central_main(void)
+{
+	struct bt_le_scan_param scan_param = {
+		.type = BT_LE_SCAN_TYPE_ACTIVE,
+		.options = BT_LE_SCAN_OPT_NONE,
+		.interval = BT_GAP_SCAN_FAST_INTERVAL,
+		.window = BT_GAP_SCAN_FAST_WINDOW,
+	};
+	int err;
+
+	bench_init_data();
+
+	err = bt_enable(NULL);
+	if (err != 0) {
+		FAIL("Bluetooth init failed (err %d)\n", err);
+		return;
+	}
+
+	err = bt_le_scan_start(&scan_param, device_found);
+	if (err != 0) {
+		FAIL("Scanning failed to start (err %d)\n", err);
+		return;
+	}
+
+	WAIT_FOR_FLAG(bench_connected);
+
+	if (IS_ENABLED(CONFIG_BT_USER_DATA_LEN_UPDATE)) {
+		update_mtu_and_data_len();
+	}
+
+	printk("ATT MTU %u\n", bt_gatt_get_mtu(bench_conn));
+
+	bench_notify();
+	bench_read();
+	bench_l2cap();
+
+	err = bt_conn_disconnect(bench_conn, BT_HCI_ERR_REMOTE_USER_TERM_CONN);
+	if (err != 0) {
+		FAIL("Disconnect failed (err %d)\n", err);
+		return;
+	}
+
+	while (atomic_get(&bench_connected)) {
+		k_sleep(K_MSEC(10));
+	}
+
+	PASS("Benchmark central done\n");
+}
+
+static const struct bst_test_instance test_def[] = {
+	{
+		.test_id = "central",
+		.test_descr = "Host benchmark central (GATT client, L2CAP sender)",
+		.test_post_init_f = test_init,
+		.test_tick_f = test_tick,
+		.test_main_f = test_central_main
+	},
+	BSTEST_END_MARKER
+};
+
+struct bst_test_list *test_central_install(struct bst_test_list *tests)
+{
+	return bst_add_tests(tests, test_def);
+}
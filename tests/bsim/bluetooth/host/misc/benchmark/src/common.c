@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "common.h"
+
+uint8_t bench_data[SDU_LEN];
+
+struct bt_conn *bench_conn;
+atomic_t bench_connected;
+
+static void connected(struct bt_conn *conn, uint8_t err)
+{
+	char addr[BT_ADDR_LE_STR_LEN];
+
+	bt_addr_le_to_str(bt_conn_get_dst(conn), addr, sizeof(addr));
+
+	if (err != 0) {
+		FAIL("Failed to connect to %s (%u)\n", addr, err);
+		return;
+	}
+
+	printk("Connected to %s\n", addr);
+
+	bench_conn = bt_conn_ref(conn);
+	(void)atomic_set(&bench_connected, (atomic_t)true);
+}
+
+static void disconnected(struct bt_conn *conn, uint8_t reason)
+{
+	if (conn != bench_conn) {
+		return;
+	}
+
+	printk("Disconnected (reason 0x%02x)\n", reason);
+
+	bt_conn_unref(bench_conn);
+	bench_conn = NULL;
+	(void)atomic_set(&bench_connected, (atomic_t)false);
+}
+
+BT_CONN_CB_DEFINE(conn_callbacks) = {
+	.connected = connected,
+	.disconnected = disconnected,
+};
+
+void bench_init_data(void)
+{
+	for (size_t i = 0; i < sizeof(bench_data); i++) {
+		bench_data[i] = (uint8_t)i;
+	}
+}
+
+uint64_t bench_now_us(void)
+{
+	return k_ticks_to_us_floor64(k_uptime_ticks());
+}
+
+void bench_print_rate(const char *name, size_t bytes, uint64_t us)
+{
+	printk("%s: %zu bytes in %u ms, %u bps\n", name, bytes, (uint32_t)(us / 1000U),
+	       (uint32_t)((uint64_t)bytes * 8U * USEC_PER_SEC / MAX(us, 1U)));
+}
+
+void test_tick(bs_time_t HW_device_time)
+{
+	if (bst_result != Passed) {
+		FAIL("test failed (not passed after %i seconds)\n", WAIT_SECONDS);
+	}
+}
+
+void test_init(void)
+{
+	bst_ticker_set_next_tick_absolute(WAIT_TIME);
+	bst_result = In_progress;
+}
@@ -0,0 +1,89 @@
+/*
+ * Common functions and helpers for the host benchmark
+ *
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+
+#include "bs_types.h"
+#include "bs_tracing.h"
+#include "bstests.h"
+
+#include <zephyr/types.h>
+#include <stddef.h>
+#include <errno.h>
+
+#include <zephyr/bluetooth/bluetooth.h>
+#include <zephyr/bluetooth/hci.h>
+#include <zephyr/bluetooth/conn.h>
+#include <zephyr/bluetooth/uuid.h>
+#include <zephyr/bluetooth/gatt.h>
+#include <zephyr/bluetooth/l2cap.h>
+
+extern enum bst_result_t bst_result;
+
+#define WAIT_SECONDS 300                        /* seconds */
+#define WAIT_TIME (WAIT_SECONDS * USEC_PER_SEC) /* microseconds*/
+
+#define CREATE_FLAG(flag) static atomic_t flag = (atomic_t)false
+#define SET_FLAG(flag) (void)atomic_set(&flag, (atomic_t)true)
+#define UNSET_FLAG(flag) (void)atomic_set(&flag, (atomic_t)false)
+#define WAIT_FOR_FLAG(flag)                                                                        \
+	while (!(bool)atomic_get(&flag)) {                                                         \
+		(void)k_sleep(K_MSEC(1));                                                          \
+	}
+
+#define FAIL(...)                                                                                  \
+	do {                                                                                       \
+		bst_result = Failed;                                                               \
+		bs_trace_error_time_line(__VA_ARGS__);                                             \
+	} while (0)
+
+#define PASS(...)                                                                                  \
+	do {                                                                                       \
+		bst_result = Passed;                                                               \
+		bs_trace_info_time(1, __VA_ARGS__);                                                \
+	} while (0)
+
+#define BENCH_SERVICE_UUID                                                                         \
+	BT_UUID_DECLARE_128(0x01, 0x23, 0x45, 0x67, 0x89, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06,      \
+			    0x07, 0x08, 0x09, 0x00, 0x00)
+
+#define BENCH_CHRC_UUID                                                                            \
+	BT_UUID_DECLARE_128(0x01, 0x23, 0x45, 0x67, 0x89, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06,      \
+			    0x07, 0x08, 0x09, 0xFF, 0x00)
+
+/* Number of notifications sent by the peripheral */
+#define NOTIFY_COUNT 200
+/* Number of read requests sent by the central */
+#define READ_COUNT 50
+/* Size of the characteristic value read by the central */
+#define READ_LEN 20
+
+/* L2CAP CoC: SDUs sent by the central to the peripheral */
+#define L2CAP_PSM 0x0080
+#define SDU_COUNT 20
+#define SDU_LEN 2000
+
+/* Characteristic value, also used as notification and SDU payload */
+extern uint8_t bench_data[SDU_LEN];
+
+/* Both devices run the same image, hence have the same GATT database:
+ * the central uses the local handles rather than discovering them.
+ */
+extern const struct bt_gatt_attr *bench_chrc_attr;
+extern const struct bt_gatt_attr *bench_ccc_attr;
+
+/* Connection to the other device, set while connected */
+extern struct bt_conn *bench_conn;
+extern atomic_t bench_connected;
+
+void bench_init_data(void);
+uint64_t bench_now_us(void);
+void bench_print_rate(const char *name, size_t bytes, uint64_t us);
+
+void test_tick(bs_time_t HW_device_time);
+void test_init(void);
@@ -0,0 +1,22 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "bstests.h"
+
+extern struct bst_test_list *test_peripheral_install(struct bst_test_list *tests);
+extern struct bst_test_list *test_central_install(struct bst_test_list *tests);
+
+bst_test_install_t test_installers[] = {
+	test_peripheral_install,
+	test_central_install,
+	NULL
+};
+
+int main(void)
+{
+	bst_main();
+	return 0;
+}
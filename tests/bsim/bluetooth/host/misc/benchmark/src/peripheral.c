@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+
+#include "common.h"
+
+CREATE_FLAG(flag_subscribed);
+
+static ssize_t read_bench_chrc(struct bt_conn *conn, const struct bt_gatt_attr *attr, void *buf,
+			       uint16_t len, uint16_t offset)
+{
+	return bt_gatt_attr_read(conn, attr, buf, len, offset, bench_data, READ_LEN);
+}
+
+static void bench_subscribe(const struct bt_gatt_attr *attr, uint16_t value)
+{
+	if (value == BT_GATT_CCC_NOTIFY) {
+		SET_FLAG(flag_subscribed);
+	}
+}
+
+BT_GATT_SERVICE_DEFINE(bench_svc, BT_GATT_PRIMARY_SERVICE(BENCH_SERVICE_UUID),
+		       BT_GATT_CHARACTERISTIC(BENCH_CHRC_UUID,
+					      BT_GATT_CHRC_NOTIFY | BT_GATT_CHRC_READ,
+					      BT_GATT_PERM_READ, read_bench_chrc, NULL, NULL),
+		       BT_GATT_CCC(bench_subscribe, BT_GATT_PERM_READ | BT_GATT_PERM_WRITE));
+
+const struct bt_gatt_attr *bench_chrc_attr = &attr_bench_svc[2];
+const struct bt_gatt_attr *bench_ccc_attr = &attr_bench_svc[3];
+
+/* Only one SDU is received at a time */
+NET_BUF_POOL_DEFINE(sdu_rx_pool, 1, BT_L2CAP_SDU_BUF_SIZE(SDU_LEN), 8, NULL);
+
+static struct bt_l2cap_le_chan l2cap_chan;
+static uint64_t l2cap_start_us;
+static size_t l2cap_rx_bytes;
+static atomic_t l2cap_rx_count;
+
+static void notify(void)
+{
+	struct bt_gatt_notify_params params = {
+		.attr = bench_chrc_attr,
+		.data = bench_data,
+		.len = bt_gatt_get_mtu(bench_conn) - 3,
+	};
+	int err;
+
+	printk("Sending %u notifications of %u bytes\n", NOTIFY_COUNT, params.len);
+
+	for (int i = 0; i < NOTIFY_COUNT; i++) {
+		do {
+			err = bt_gatt_notify_cb(bench_conn, &params);
+
+			if (err == -ENOMEM) {
+				k_sleep(K_MSEC(1));
+			} else if (err) {
+				FAIL("Notify failed (err %d)\n", err);
+				return;
+			}
+		} while (err);
+	}
+}
+
+static struct net_buf *l2cap_alloc_buf(struct bt_l2cap_chan *chan)
+{
+	return net_buf_alloc(&sdu_rx_pool, K_NO_WAIT);
+}
+
+static int l2cap_recv(struct bt_l2cap_chan *chan, struct net_buf *buf)
+{
+	l2cap_rx_bytes += buf->len;
+
+	if (atomic_inc(&l2cap_rx_count) + 1 == SDU_COUNT) {
+		bench_print_rate("l2cap", l2cap_rx_bytes, bench_now_us() - l2cap_start_us);
+	}
+
+	return 0;
+}
+
+static void l2cap_connected(struct bt_l2cap_chan *chan)
+{
+	struct bt_l2cap_le_chan *le_chan = CONTAINER_OF(chan, struct bt_l2cap_le_chan, chan);
+
+	printk("L2CAP connected (tx mtu %u mps %u) (rx mtu %u mps %u)\n", le_chan->tx.mtu,
+	       le_chan->tx.mps, le_chan->rx.mtu, le_chan->rx.mps);
+
+	l2cap_start_us = bench_now_us();
+}
+
+static const struct bt_l2cap_chan_ops l2cap_ops = {
+	.connected = l2cap_connected,
+	.alloc_buf = l2cap_alloc_buf,
+	.recv = l2cap_recv,
+};
+
+static int l2cap_accept(struct bt_conn *conn, struct bt_l2cap_chan **chan)
+{
+	memset(&l2cap_chan, 0, sizeof(l2cap_chan));
+	l2cap_chan.chan.ops = &l2cap_ops;
+	l2cap_chan.rx.mtu = SDU_LEN;
+	*chan = &l2cap_chan.chan;
+
+	return 0;
+}
+
+static struct bt_l2cap_server l2cap_server = {
+	.psm = L2CAP_PSM,
+	.sec_level = BT_SECURITY_L1,
+	.accept = l2cap_accept,
+};
+
+static void test_peripheral_main(void)
+{
+	const struct bt_data ad[] = {
+		BT_DATA_BYTES(BT_DATA_FLAGS, (BT_LE_AD_GENERAL | BT_LE_AD_NO_BREDR)),
+	};
+	int err;
+
+	bench_init_data();
+
+	err = bt_enable(NULL);
+	if (err != 0) {
+		FAIL("Bluetooth init failed (err %d)\n", err);
+		return;
+	}
+
+	err = bt_l2cap_server_register(&l2cap_server);
+	if (err != 0) {
+		FAIL("Failed to register L2CAP server (err %d)\n", err);
+		return;
+	}
+
+	err = bt_le_adv_start(BT_LE_ADV_CONN_NAME, ad, ARRAY_SIZE(ad), NULL, 0);
+	if (err != 0) {
+		FAIL("Advertising failed to start (err %d)\n", err);
+		return;
+	}
+
+	WAIT_FOR_FLAG(bench_connected);
+
+	/* GATT notifications, received and timed by the central */
+	WAIT_FOR_FLAG(flag_subscribed);
+	notify();
+
+	/* L2CAP CoC, sent by the central and timed here */
+	while (atomic_get(&l2cap_rx_count) < SDU_COUNT) {
+		k_sleep(K_MSEC(10));
+	}
+
+	while (atomic_get(&bench_connected)) {
+		k_sleep(K_MSEC(10));
+	}
+
+	PASS("Benchmark peripheral done\n");
+}
+
+static const struct bst_test_instance test_def[] = {
+	{
+		.test_id = "peripheral",
+		.test_descr = "Host benchmark peripheral (GATT server, L2CAP receiver)",
+		.test_post_init_f = test_init,
+		.test_tick_f = test_tick,
+		.test_main_f = test_peripheral_main
+	},
+	BSTEST_END_MARKER
+};
+
+struct bst_test_list *test_peripheral_install(struct bst_test_list *tests)
+{
+	return bst_add_tests(tests, test_def);
+}
@@ -0,0 +1,22 @@
+#!/usr/bin/env bash
+# Copyright (c) 2023 Zephyr Project
+# SPDX-License-Identifier: Apache-2.0
+set -eu
+
+source ${ZEPHYR_BASE}/tests/bsim/sh_common.source
+
+verbosity_level=2
+EXECUTE_TIMEOUT=120
+
+cd ${BSIM_OUT_PATH}/bin
+
+bsim_exe=./bs_${BOARD}_tests_bsim_bluetooth_host_misc_benchmark_${conf}
+
+Execute ${bsim_exe} -v=${verbosity_level} -s=${simulation_id} -d=0 -testid=central
+
+Execute ${bsim_exe} -v=${verbosity_level} -s=${simulation_id} -d=1 -testid=peripheral
+
+Execute ./bs_2G4_phy_v1 -v=${verbosity_level} -s=${simulation_id} \
+    -D=2 -sim_length=300e6 $@
+
+wait_for_background_jobs
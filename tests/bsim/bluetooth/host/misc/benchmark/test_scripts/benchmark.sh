@@ -0,0 +1,8 @@
+#!/usr/bin/env bash
+# Copyright (c) 2023 Zephyr Project
+# SPDX-License-Identifier: Apache-2.0
+
+# ATT MTU 23, data length 27
+simulation_id="host_benchmark" \
+    conf="prj_conf" \
+    $(dirname "${BASH_SOURCE[0]}")/_run_test.sh
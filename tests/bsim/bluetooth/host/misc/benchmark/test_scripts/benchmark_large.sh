@@ -0,0 +1,8 @@
+#!/usr/bin/env bash
+# Copyright (c) 2023 Zephyr Project
+# SPDX-License-Identifier: Apache-2.0
+
+# ATT MTU 247, data length 251
+simulation_id="host_benchmark_large" \
+    conf="prj_large_conf" \
+    $(dirname "${BASH_SOURCE[0]}")/_run_test.sh
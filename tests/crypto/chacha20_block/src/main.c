@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+
+#include "chacha20_block.h"
+
+/*
+ * Keystream vectors for the original ChaCha20 layout (64-bit counter,
+ * nonce 0), from RFC 7539 appendix A.1 and draft-agl-tls-chacha20poly1305.
+ * The RFC's 32-bit counter and 96-bit nonce coincide with this layout for
+ * a zero nonce and counters below 2^32, the last vector covers the high
+ * counter word.
+ */
+struct block_vector {
+	uint32_t key[CHACHA20_KEY_WORDS];
+	uint64_t counter;
+	uint8_t out[CHACHA20_BLOCK_SIZE];
+};
+
+static const struct block_vector vectors[] = {
+	{
+		.key = { 0 },
+		.counter = 0U,
+		.out = {
+			0x76, 0xb8, 0xe0, 0xad, 0xa0, 0xf1, 0x3d, 0x90,
+			0x40, 0x5d, 0x6a, 0xe5, 0x53, 0x86, 0xbd, 0x28,
+			0xbd, 0xd2, 0x19, 0xb8, 0xa0, 0x8d, 0xed, 0x1a,
+			0xa8, 0x36, 0xef, 0xcc, 0x8b, 0x77, 0x0d, 0xc7,
+			0xda, 0x41, 0x59, 0x7c, 0x51, 0x57, 0x48, 0x8d,
+			0x77, 0x24, 0xe0, 0x3f, 0xb8, 0xd8, 0x4a, 0x37,
+			0x6a, 0x43, 0xb8, 0xf4, 0x15, 0x18, 0xa1, 0x1c,
+			0xc3, 0x87, 0xb6, 0x69, 0xb2, 0xee, 0x65, 0x86,
+		},
+	},
+	{
+		.key = { 0 },
+		.counter = 1U,
+		.out = {
+			0x9f, 0x07, 0xe7, 0xbe, 0x55, 0x51, 0x38, 0x7a,
+			0x98, 0xba, 0x97, 0x7c, 0x73, 0x2d, 0x08, 0x0d,
+			0xcb, 0x0f, 0x29, 0xa0, 0x48, 0xe3, 0x65, 0x69,
+			0x12, 0xc6, 0x53, 0x3e, 0x32, 0xee, 0x7a, 0xed,
+			0x29, 0xb7, 0x21, 0x76, 0x9c, 0xe6, 0x4e, 0x43,
+			0xd5, 0x71, 0x33, 0xb0, 0x74, 0xd8, 0x39, 0xd5,
+			0x31, 0xed, 0x1f, 0x28, 0x51, 0x0a, 0xfb, 0x45,
+			0xac, 0xe1, 0x0a, 0x1f, 0x4b, 0x79, 0x4d, 0x6f,
+		},
+	},
+	{
+		/* key bytes 00 .. 00 01 */
+		.key = { [7] = 0x01000000U },
+		.counter = 1U,
+		.out = {
+			0x3a, 0xeb, 0x52, 0x24, 0xec, 0xf8, 0x49, 0x92,
+			0x9b, 0x9d, 0x82, 0x8d, 0xb1, 0xce, 0xd4, 0xdd,
+			0x83, 0x20, 0x25, 0xe8, 0x01, 0x8b, 0x81, 0x60,
+			0xb8, 0x22, 0x84, 0xf3, 0xc9, 0x49, 0xaa, 0x5a,
+			0x8e, 0xca, 0x00, 0xbb, 0xb4, 0xa7, 0x3b, 0xda,
+			0xd1, 0x92, 0xb5, 0xc4, 0x2f, 0x73, 0xf2, 0xfd,
+			0x4e, 0x27, 0x36, 0x44, 0xc8, 0xb3, 0x61, 0x25,
+			0xa6, 0x4a, 0xdd, 0xeb, 0x00, 0x6c, 0x13, 0xa0,
+		},
+	},
+	{
+		/* key bytes 00 ff 00 .. 00 */
+		.key = { [0] = 0x0000ff00U },
+		.counter = 2U,
+		.out = {
+			0x72, 0xd5, 0x4d, 0xfb, 0xf1, 0x2e, 0xc4, 0x4b,
+			0x36, 0x26, 0x92, 0xdf, 0x94, 0x13, 0x7f, 0x32,
+			0x8f, 0xea, 0x8d, 0xa7, 0x39, 0x90, 0x26, 0x5e,
+			0xc1, 0xbb, 0xbe, 0xa1, 0xae, 0x9a, 0xf0, 0xca,
+			0x13, 0xb2, 0x5a, 0xa2, 0x6c, 0xb4, 0xa6, 0x48,
+			0xcb, 0x9b, 0x9d, 0x1b, 0xe6, 0x5b, 0x2c, 0x09,
+			0x24, 0xa6, 0x6c, 0x54, 0xd5, 0x45, 0xec, 0x1b,
+			0x73, 0x74, 0xf4, 0x87, 0x2e, 0x99, 0xf0, 0x96,
+		},
+	},
+	{
+		.key = { 0 },
+		.counter = BIT64(32),
+		.out = {
+			0x3d, 0xb4, 0x1d, 0x3a, 0xa0, 0xd3, 0x29, 0x28,
+			0x5d, 0xe6, 0xf2, 0x25, 0xe6, 0xe2, 0x4b, 0xd5,
+			0x9c, 0x9a, 0x17, 0x00, 0x69, 0x43, 0xd5, 0xc9,
+			0xb6, 0x80, 0xe3, 0x87, 0x3b, 0xdc, 0x68, 0x3a,
+			0x58, 0x19, 0x46, 0x98, 0x99, 0x98, 0x96, 0x90,
+			0xc2, 0x81, 0xcd, 0x17, 0xc9, 0x61, 0x59, 0xaf,
+			0x06, 0x82, 0xb5, 0xb9, 0x03, 0x46, 0x8a, 0x61,
+			0xf5, 0x02, 0x28, 0xcf, 0x09, 0x62, 0x2b, 0x5a,
+		},
+	},
+};
+
+ZTEST(chacha20_block, test_vectors)
+{
+	uint8_t out[CHACHA20_BLOCK_SIZE];
+
+	for (size_t i = 0; i < ARRAY_SIZE(vectors); i++) {
+		chacha20_block(vectors[i].key, vectors[i].counter, out);
+		zassert_mem_equal(out, vectors[i].out, sizeof(out), "vector %zu mismatch", i);
+	}
+}
+
+ZTEST_SUITE(chacha20_block, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,223 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/crypto/crypto.h>
+#include <zephyr/crypto/queue.h>
+
+#define CRYPTO_DRV_NAME CONFIG_CRYPTO_MBEDTLS_SHIM_DRV_NAME
+
+#define CAP_FLAGS (CAP_RAW_KEY | CAP_SEPARATE_IO_BUFS | CAP_SYNC_OPS)
+
+/* MACsec GCM-AES test vector 2.4.1 */
+static uint8_t gcm_key[16] = {
+	0x07, 0x1b, 0x11, 0x3b, 0x0c, 0xa7, 0x43, 0xfe, 0xcc, 0xcf, 0x3d, 0x05,
+	0x1f, 0x73, 0x73, 0x82
+};
+static uint8_t gcm_nonce[12] = {
+	0xf0, 0x76, 0x1e, 0x8d, 0xcd, 0x3d, 0x00, 0x01, 0x76, 0xd4, 0x57, 0xed
+};
+static uint8_t gcm_hdr[20] = {
+	0xe2, 0x01, 0x06, 0xd7, 0xcd, 0x0d, 0xf0, 0x76, 0x1e, 0x8d, 0xcd, 0x3d,
+	0x88, 0xe5, 0x4c, 0x2a, 0x76, 0xd4, 0x57, 0xed
+};
+static uint8_t gcm_data[42] = {
+	0x08, 0x00, 0x0f, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18,
+	0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f, 0x20, 0x21, 0x22, 0x23, 0x24,
+	0x25, 0x26, 0x27, 0x28, 0x29, 0x2a, 0x2b, 0x2c, 0x2d, 0x2e, 0x2f, 0x30,
+	0x31, 0x32, 0x33, 0x34, 0x00, 0x04
+};
+static const uint8_t gcm_expected[58] = {
+	0x13, 0xb4, 0xc7, 0x2b, 0x38, 0x9d, 0xc5, 0x01, 0x8e, 0x72, 0xa1, 0x71,
+	0xdd, 0x85, 0xa5, 0xd3, 0x75, 0x22, 0x74, 0xd3, 0xa0, 0x19, 0xfb, 0xca,
+	0xed, 0x09, 0xa4, 0x25, 0xcd, 0x9b, 0x2e, 0x1c, 0x9b, 0x72, 0xee, 0xe7,
+	0xc9, 0xde, 0x7d, 0x52, 0xb3, 0xf3,
+	0xd6, 0xa5, 0x28, 0x4f, 0x4a, 0x6d, 0x3f, 0xe2, 0x2a, 0x5d, 0x6c, 0x2b,
+	0x96, 0x04, 0x94, 0xc3
+};
+
+/* SHA-256("abc") */
+static uint8_t sha_data[3] = { 'a', 'b', 'c' };
+static const uint8_t sha_expected[32] = {
+	0xba, 0x78, 0x16, 0xbf, 0x8f, 0x01, 0xcf, 0xea, 0x41, 0x41, 0x40, 0xde,
+	0x5d, 0xae, 0x22, 0x23, 0xb0, 0x03, 0x61, 0xa3, 0x96, 0x17, 0x7a, 0x9c,
+	0xb4, 0x10, 0xff, 0x61, 0xf2, 0x00, 0x15, 0xad
+};
+
+static K_SEM_DEFINE(done_sem, 0, 1);
+static int done_status;
+static struct crypto_req *done_req;
+
+static void req_done(struct crypto_req *req, int status)
+{
+	done_req = req;
+	done_status = status;
+	k_sem_give(&done_sem);
+}
+
+static void wait_done(struct crypto_req *req)
+{
+	zassert_ok(k_sem_take(&done_sem, K_SECONDS(1)), "request not completed");
+	zassert_equal_ptr(done_req, req, "wrong request completed");
+	zassert_ok(done_status, "request failed");
+}
+
+static const struct cipher_ctx gcm_params = {
+	.keylen = sizeof(gcm_key),
+	.key.bit_stream = gcm_key,
+	.mode_params.gcm_info = {
+		.nonce_len = sizeof(gcm_nonce),
+		.tag_len = 16,
+	},
+	.flags = CAP_FLAGS,
+};
+
+ZTEST(crypto_queue, test_gcm)
+{
+	const struct device *dev = device_get_binding(CRYPTO_DRV_NAME);
+	static struct crypto_req req;
+	uint8_t encrypted[58] = {0};
+	uint8_t decrypted[42] = {0};
+	struct cipher_pkt encrypt = {
+		.in_buf = gcm_data,
+		.in_len = sizeof(gcm_data),
+		.out_buf_max = sizeof(encrypted),
+		.out_buf = encrypted,
+	};
+	struct cipher_pkt decrypt = {
+		.in_buf = encrypted,
+		.in_len = sizeof(gcm_data),
+		.out_buf = decrypted,
+		.out_buf_max = sizeof(decrypted),
+	};
+	struct cipher_aead_pkt aead = {
+		.ad = gcm_hdr,
+		.ad_len = sizeof(gcm_hdr),
+		.pkt = &encrypt,
+		.tag = encrypted + sizeof(gcm_data),
+	};
+	struct cipher_ctx *ctx;
+
+	ctx = crypto_session_cache_get(dev, &gcm_params, CRYPTO_CIPHER_ALGO_AES,
+				       CRYPTO_CIPHER_MODE_GCM,
+				       CRYPTO_CIPHER_OP_ENCRYPT);
+	zassert_not_null(ctx, "failed to get encryption session");
+
+	zassert_ok(crypto_queue_aead_op(&req, ctx, &aead, gcm_nonce, req_done,
+					NULL));
+	zassert_equal(req.type, CRYPTO_REQ_GCM);
+	wait_done(&req);
+	zassert_mem_equal(encrypted, gcm_expected, sizeof(gcm_expected));
+
+	crypto_session_cache_put(ctx);
+
+	ctx = crypto_session_cache_get(dev, &gcm_params, CRYPTO_CIPHER_ALGO_AES,
+				       CRYPTO_CIPHER_MODE_GCM,
+				       CRYPTO_CIPHER_OP_DECRYPT);
+	zassert_not_null(ctx, "failed to get decryption session");
+
+	aead.pkt = &decrypt;
+	zassert_ok(crypto_queue_aead_op(&req, ctx, &aead, gcm_nonce, req_done,
+					NULL));
+	wait_done(&req);
+	zassert_mem_equal(decrypted, gcm_data, sizeof(gcm_data));
+
+	crypto_session_cache_put(ctx);
+}
+
+ZTEST(crypto_queue, test_hash)
+{
+	const struct device *dev = device_get_binding(CRYPTO_DRV_NAME);
+	static struct crypto_req req;
+	uint8_t out[32] = {0};
+	struct hash_ctx ctx = {
+		.flags = CAP_SYNC_OPS | CAP_SEPARATE_IO_BUFS,
+	};
+	struct hash_pkt pkt = {
+		.in_buf = sha_data,
+		.in_len = sizeof(sha_data),
+		.out_buf = out,
+	};
+
+	zassert_ok(hash_begin_session(dev, &ctx, CRYPTO_HASH_ALGO_SHA256));
+
+	zassert_ok(crypto_queue_hash_op(&req, &ctx, &pkt, true, req_done, NULL));
+	wait_done(&req);
+	zassert_mem_equal(out, sha_expected, sizeof(sha_expected));
+
+	hash_free_session(dev, &ctx);
+}
+
+ZTEST(crypto_queue, test_invalid)
+{
+	static struct crypto_req req;
+	struct cipher_pkt pkt = {0};
+	struct cipher_ctx ctx = {
+		.flags = CAP_ASYNC_OPS,
+	};
+
+	req.type = CRYPTO_REQ_CBC;
+	req.cipher.ctx = &ctx;
+	req.cipher.pkt = &pkt;
+	zassert_equal(crypto_queue_submit(&req), -EINVAL,
+		      "asynchronous session accepted");
+
+	req.cipher.pkt = NULL;
+	ctx.flags = CAP_SYNC_OPS;
+	zassert_equal(crypto_queue_submit(&req), -EINVAL,
+		      "missing packet accepted");
+}
+
+ZTEST(crypto_queue, test_session_cache)
+{
+	const struct device *dev = device_get_binding(CRYPTO_DRV_NAME);
+	struct cipher_ctx params = gcm_params;
+	struct cipher_ctx *a, *b, *c;
+	uint8_t other_key[16];
+
+	a = crypto_session_cache_get(dev, &params, CRYPTO_CIPHER_ALGO_AES,
+				     CRYPTO_CIPHER_MODE_GCM,
+				     CRYPTO_CIPHER_OP_ENCRYPT);
+	zassert_not_null(a);
+	zassert_true(a->key.bit_stream != gcm_key, "key not copied");
+	crypto_session_cache_put(a);
+
+	/* same parameters: the session is reused */
+	b = crypto_session_cache_get(dev, &params, CRYPTO_CIPHER_ALGO_AES,
+				     CRYPTO_CIPHER_MODE_GCM,
+				     CRYPTO_CIPHER_OP_ENCRYPT);
+	zassert_equal_ptr(a, b, "session not reused");
+
+	/* different key: a new session */
+	memcpy(other_key, gcm_key, sizeof(other_key));
+	other_key[0] ^= 0xff;
+	params.key.bit_stream = other_key;
+	c = crypto_session_cache_get(dev, &params, CRYPTO_CIPHER_ALGO_AES,
+				     CRYPTO_CIPHER_MODE_GCM,
+				     CRYPTO_CIPHER_OP_ENCRYPT);
+	zassert_not_null(c);
+	zassert_true(b != c, "session reused for another key");
+
+	/* both in use: nothing can be evicted */
+	params.key.bit_stream = gcm_key;
+	zassert_is_null(crypto_session_cache_get(dev, &params,
+						 CRYPTO_CIPHER_ALGO_AES,
+						 CRYPTO_CIPHER_MODE_GCM,
+						 CRYPTO_CIPHER_OP_DECRYPT),
+			"session in use evicted");
+
+	crypto_session_cache_put(b);
+	crypto_session_cache_put(c);
+}
+
+static void crypto_queue_after(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	crypto_session_cache_flush();
+}
+
+ZTEST_SUITE(crypto_queue, NULL, NULL, NULL, crypto_queue_after, NULL);
@@ -364,3 +364,169 @@ ZTEST_USER(adc_basic, test_adc_invalid_request)
 {
 	zassert_true(test_task_invalid_request() == TC_PASS);
 }
+
+/*
+ * test_adc_stream
+ */
+#if defined(CONFIG_ADC_STREAM)
+#define STREAM_HALVES 6
+
+static K_SEM_DEFINE(stream_sem, 0, STREAM_HALVES);
+static struct adc_stream_data stream_data[STREAM_HALVES];
+static void *stream_user_data;
+static int stream_status;
+static int stream_calls;
+
+static void stream_callback(const struct device *dev, int status,
+			    const struct adc_stream_data *data, void *user_data)
+{
+	stream_user_data = user_data;
+
+	if (status != 0) {
+		stream_status = status;
+	} else if (stream_calls < STREAM_HALVES) {
+		stream_data[stream_calls] = *data;
+	}
+
+	stream_calls++;
+	k_sem_give(&stream_sem);
+}
+
+static bool stream_supported(const struct device *dev)
+{
+	int ret = adc_stream_stop(dev);
+
+	if (ret == -ENOTSUP) {
+		return false;
+	}
+
+	zassert_equal(ret, -EALREADY, "adc_stream_stop() returned %d while idle", ret);
+
+	return true;
+}
+
+static int test_task_stream(void)
+{
+	const struct device *dev = adc_channels[0].dev;
+	size_t half = sizeof(m_sample_buffer) / 2;
+	int calls;
+	int ret;
+	struct adc_sequence sequence = {
+		.buffer      = m_sample_buffer,
+		.buffer_size = sizeof(m_sample_buffer),
+	};
+
+	init_adc();
+	(void)adc_sequence_init_dt(&adc_channels[0], &sequence);
+
+	if (!stream_supported(dev)) {
+		ztest_test_skip();
+	}
+
+	k_sem_reset(&stream_sem);
+	stream_status = 0;
+	stream_calls = 0;
+
+	ret = adc_stream_start(dev, &sequence, stream_callback, &my_sequence_identifier);
+	zassert_equal(ret, 0, "adc_stream_start() failed with code %d", ret);
+
+	for (int i = 0; i < STREAM_HALVES; i++) {
+		zassert_ok(k_sem_take(&stream_sem, K_MSEC(1000)), "Half %d not delivered", i);
+	}
+
+	zassert_equal(adc_stream_stop(dev), 0);
+	zassert_equal(adc_stream_stop(dev), -EALREADY);
+
+	/* No callback once stopped */
+	calls = stream_calls;
+	k_msleep(10);
+	zassert_equal(stream_calls, calls, "Callback called after stop");
+
+	zassert_equal(stream_status, 0, "Sampling stopped with %d", stream_status);
+	zassert_equal(stream_user_data, &my_sequence_identifier);
+	check_samples(BUFFER_SIZE);
+
+	/* The halves are handed over in turn, timestamped in order */
+	for (int i = 0; i < STREAM_HALVES; i++) {
+		zassert_equal_ptr(stream_data[i].buffer,
+				  (uint8_t *)m_sample_buffer + (i % 2) * half,
+				  "Wrong half %d", i);
+		zassert_equal(stream_data[i].size, half);
+
+		if (i == 0) {
+			zassert_equal(stream_data[i].period_ns, 0);
+			continue;
+		}
+
+		zassert_true(stream_data[i].timestamp_ns > stream_data[i - 1].timestamp_ns,
+			     "Half %d delivered out of order", i);
+		zassert_true(stream_data[i].period_ns > 0, "No period for half %d", i);
+	}
+
+	/* The device is released for the other requests */
+	sequence.options = NULL;
+	ret = adc_read(dev, &sequence);
+	zassert_equal(ret, 0, "adc_read() after the stream failed with code %d", ret);
+
+	return TC_PASS;
+}
+
+static int test_task_stream_invalid(void)
+{
+	const struct device *dev = adc_channels[0].dev;
+	int ret;
+	const struct adc_sequence_options options = {
+		.interval_us = 100,
+	};
+	struct adc_sequence sequence = {
+		.buffer      = m_sample_buffer,
+		.buffer_size = sizeof(m_sample_buffer),
+	};
+
+	init_adc();
+	(void)adc_sequence_init_dt(&adc_channels[0], &sequence);
+
+	if (!stream_supported(dev)) {
+		ztest_test_skip();
+	}
+
+	ret = adc_stream_start(dev, &sequence, NULL, NULL);
+	zassert_equal(ret, -EINVAL, "Started without a callback (%d)", ret);
+
+	sequence.options = &options;
+	ret = adc_stream_start(dev, &sequence, stream_callback, NULL);
+	zassert_equal(ret, -ENOTSUP, "Started with an interval (%d)", ret);
+
+	/* Two samplings at least, one per half */
+	sequence.options = NULL;
+	sequence.buffer_size = sizeof(m_sample_buffer[0]);
+	ret = adc_stream_start(dev, &sequence, stream_callback, NULL);
+	zassert_equal(ret, -ENOMEM, "Started with a single sampling (%d)", ret);
+
+	/* None of the failures kept the device */
+	zassert_equal(adc_stream_stop(dev), -EALREADY);
+	sequence.buffer_size = sizeof(m_sample_buffer);
+	ret = adc_read(dev, &sequence);
+	zassert_equal(ret, 0, "adc_read() failed with code %d", ret);
+
+	return TC_PASS;
+}
+#endif /* defined(CONFIG_ADC_STREAM) */
+
+ZTEST(adc_basic, test_adc_stream)
+{
+#if defined(CONFIG_ADC_STREAM)
+	zassert_true(test_task_stream() == TC_PASS);
+#else
+	ztest_test_skip();
+#endif /* defined(CONFIG_ADC_STREAM) */
+}
+
+ZTEST(adc_basic, test_adc_stream_invalid)
+{
+#if defined(CONFIG_ADC_STREAM)
+	zassert_true(test_task_stream_invalid() == TC_PASS);
+#else
+	ztest_test_skip();
+#endif /* defined(CONFIG_ADC_STREAM) */
+}
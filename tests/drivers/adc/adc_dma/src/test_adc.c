@@ -531,3 +531,101 @@ ZTEST_USER(adc_dma, test_adc_invalid_request)
 {
 	zassert_true(test_task_invalid_request() == TC_PASS);
 }
+
+/*
+ * test_adc_stream
+ */
+#if defined(CONFIG_ADC_STREAM)
+#define STREAM_HALVES 4
+
+static K_SEM_DEFINE(stream_sem, 0, STREAM_HALVES);
+static struct adc_stream_data stream_data[STREAM_HALVES];
+static int stream_status;
+static int stream_calls;
+
+static void stream_callback(const struct device *dev, int status,
+			    const struct adc_stream_data *data, void *user_data)
+{
+	if (status != 0) {
+		stream_status = status;
+	} else if (stream_calls < STREAM_HALVES) {
+		stream_data[stream_calls] = *data;
+	}
+
+	stream_calls++;
+	k_sem_give(&stream_sem);
+}
+
+static int test_task_stream(void)
+{
+	int ret;
+	int calls;
+	size_t half = sizeof(m_sample_buffer) / 2;
+	const struct adc_sequence sequence = {
+#if defined(ADC_2ND_CHANNEL_ID)
+		.channels = BIT(ADC_1ST_CHANNEL_ID) | BIT(ADC_2ND_CHANNEL_ID),
+#else
+		.channels = BIT(ADC_1ST_CHANNEL_ID),
+#endif /* defined(ADC_2ND_CHANNEL_ID) */
+		.buffer = m_sample_buffer,
+		.buffer_size = sizeof(m_sample_buffer),
+		.resolution = ADC_RESOLUTION,
+	};
+
+	const struct device *adc_dev = init_adc();
+
+	if (!adc_dev) {
+		return TC_FAIL;
+	}
+
+	k_sem_reset(&stream_sem);
+	stream_status = 0;
+	stream_calls = 0;
+
+	ret = adc_stream_start(adc_dev, &sequence, stream_callback, NULL);
+	if (ret == -ENOTSUP) {
+		ztest_test_skip();
+	}
+	zassert_equal(ret, 0, "adc_stream_start() failed with code %d", ret);
+
+	for (int i = 0; i < STREAM_HALVES; i++) {
+		zassert_ok(k_sem_take(&stream_sem, K_MSEC(1000)), "Half %d not delivered", i);
+	}
+
+	zassert_equal(adc_stream_stop(adc_dev), 0);
+	zassert_equal(adc_stream_stop(adc_dev), -EALREADY);
+
+	calls = stream_calls;
+	k_msleep(10);
+	zassert_equal(stream_calls, calls, "Callback called after stop");
+	zassert_equal(stream_status, 0, "Sampling stopped with %d", stream_status);
+
+	/* The DMA fills both halves of the buffer in turn */
+	check_samples(BUFFER_SIZE);
+
+	for (int i = 0; i < STREAM_HALVES; i++) {
+		zassert_equal_ptr(stream_data[i].buffer,
+				  (uint8_t *)m_sample_buffer + (i % 2) * half,
+				  "Wrong half %d", i);
+		zassert_equal(stream_data[i].size, half);
+
+		if (i > 0) {
+			zassert_true(stream_data[i].timestamp_ns >
+				     stream_data[i - 1].timestamp_ns,
+				     "Half %d delivered out of order", i);
+			zassert_true(stream_data[i].period_ns > 0, "No period for half %d", i);
+		}
+	}
+
+	return TC_PASS;
+}
+#endif /* defined(CONFIG_ADC_STREAM) */
+
+ZTEST(adc_dma, test_adc_stream)
+{
+#if defined(CONFIG_ADC_STREAM)
+	zassert_true(test_task_stream() == TC_PASS);
+#else
+	ztest_test_skip();
+#endif /* defined(CONFIG_ADC_STREAM) */
+}
@@ -0,0 +1,189 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/drivers/can.h>
+#include <zephyr/drivers/can/rx_mgr.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+/* More filters than the hardware filters of the controller */
+#define TEST_FILTERS 24
+#define TEST_TIMEOUT K_MSEC(100)
+
+/* J1939 identifiers of neighbouring PGNs, from a few source addresses */
+#define TEST_ID(n) (0x18F00000U | (((n) / 4U) << 8) | (0x20U + (n) % 4U))
+
+static const struct device *const can_dev = DEVICE_DT_GET(DT_CHOSEN(zephyr_canbus));
+static struct can_rx_mgr mgr;
+static int filter_ids[TEST_FILTERS];
+static atomic_t received[TEST_FILTERS];
+static K_SEM_DEFINE(rx_sem, 0, TEST_FILTERS);
+
+static void rx_callback(const struct device *dev, struct can_frame *frame, void *user_data)
+{
+	uintptr_t n = (uintptr_t)user_data;
+
+	ARG_UNUSED(dev);
+
+	zassert_equal(frame->id, TEST_ID(n), "frame dispatched to the wrong filter");
+
+	atomic_inc(&received[n]);
+	k_sem_give(&rx_sem);
+}
+
+static void send_frame(uint32_t id)
+{
+	struct can_frame frame = {
+		.flags = CAN_FRAME_IDE,
+		.id = id,
+		.dlc = 1,
+	};
+	int err;
+
+	err = can_send(can_dev, &frame, TEST_TIMEOUT, NULL, NULL);
+	zassert_equal(err, 0, "failed to send frame (err %d)", err);
+}
+
+static void add_filters(void)
+{
+	struct can_filter filter = {
+		.flags = CAN_FILTER_DATA | CAN_FILTER_IDE,
+		.mask = CAN_EXT_ID_MASK,
+	};
+
+	for (uintptr_t n = 0; n < TEST_FILTERS; n++) {
+		filter.id = TEST_ID(n);
+		filter_ids[n] = can_rx_mgr_add_filter(&mgr, rx_callback, (void *)n, &filter);
+		zassert_true(filter_ids[n] >= 0, "failed to add filter %u (err %d)", n,
+			     filter_ids[n]);
+		atomic_set(&received[n], 0);
+	}
+}
+
+static void remove_filters(void)
+{
+	for (int n = 0; n < TEST_FILTERS; n++) {
+		if (filter_ids[n] >= 0) {
+			can_rx_mgr_remove_filter(&mgr, filter_ids[n]);
+			filter_ids[n] = -1;
+		}
+	}
+}
+
+/**
+ * @brief Test that each frame is dispatched to its filter only.
+ */
+ZTEST(can_rx_mgr, test_dispatch)
+{
+	struct can_rx_mgr_stats before;
+	struct can_rx_mgr_stats stats;
+	int err;
+
+	can_rx_mgr_get_stats(&mgr, &before);
+	add_filters();
+
+	can_rx_mgr_get_stats(&mgr, &stats);
+	zassert_true(stats.hw_filters > 0 && stats.hw_filters <= CONFIG_CAN_MAX_FILTER,
+		     "wrong number of hardware filters %u", stats.hw_filters);
+
+	for (int n = 0; n < TEST_FILTERS; n++) {
+		send_frame(TEST_ID(n));
+		err = k_sem_take(&rx_sem, TEST_TIMEOUT);
+		zassert_equal(err, 0, "frame %d not received", n);
+	}
+
+	for (int n = 0; n < TEST_FILTERS; n++) {
+		zassert_equal(atomic_get(&received[n]), 1, "filter %d called %d times", n,
+			      (int)atomic_get(&received[n]));
+	}
+
+	/* Not matching any filter, but possibly accepted by a merged hardware filter */
+	send_frame(TEST_ID(TEST_FILTERS));
+	zassert_not_equal(k_sem_take(&rx_sem, TEST_TIMEOUT), 0, "unexpected frame received");
+
+	can_rx_mgr_get_stats(&mgr, &stats);
+	zassert_equal(stats.hash_hits - before.hash_hits, TEST_FILTERS,
+		      "wrong number of hash hits %u", stats.hash_hits - before.hash_hits);
+	zassert_equal(stats.list_hits, before.list_hits, "unexpected list hits");
+}
+
+/**
+ * @brief Test that a removed filter is no longer called.
+ */
+ZTEST(can_rx_mgr, test_remove)
+{
+	add_filters();
+
+	can_rx_mgr_remove_filter(&mgr, filter_ids[0]);
+	filter_ids[0] = -1;
+
+	send_frame(TEST_ID(0));
+	zassert_not_equal(k_sem_take(&rx_sem, TEST_TIMEOUT), 0, "removed filter called");
+
+	send_frame(TEST_ID(1));
+	zassert_equal(k_sem_take(&rx_sem, TEST_TIMEOUT), 0, "frame not received");
+	zassert_equal(atomic_get(&received[1]), 1, "filter not called");
+}
+
+/**
+ * @brief Test that the filters beyond the maximum are refused.
+ */
+ZTEST(can_rx_mgr, test_no_space)
+{
+	struct can_filter filter = {
+		.flags = CAN_FILTER_DATA,
+		.mask = CAN_STD_ID_MASK,
+	};
+	int ids[CONFIG_CAN_RX_MGR_MAX_FILTERS];
+	int err;
+
+	for (int n = 0; n < CONFIG_CAN_RX_MGR_MAX_FILTERS; n++) {
+		filter.id = n;
+		ids[n] = can_rx_mgr_add_filter(&mgr, rx_callback, NULL, &filter);
+		zassert_true(ids[n] >= 0, "failed to add filter %d (err %d)", n, ids[n]);
+	}
+
+	filter.id = CONFIG_CAN_RX_MGR_MAX_FILTERS;
+	err = can_rx_mgr_add_filter(&mgr, rx_callback, NULL, &filter);
+	zassert_equal(err, -ENOSPC, "wrong error return code (err %d)", err);
+
+	for (int n = 0; n < CONFIG_CAN_RX_MGR_MAX_FILTERS; n++) {
+		can_rx_mgr_remove_filter(&mgr, ids[n]);
+	}
+}
+
+static void *can_rx_mgr_setup(void)
+{
+	int err;
+
+	zassert_true(device_is_ready(can_dev), "CAN device not ready");
+
+	(void)can_stop(can_dev);
+
+	err = can_set_mode(can_dev, CAN_MODE_LOOPBACK);
+	zassert_equal(err, 0, "failed to set loopback mode (err %d)", err);
+
+	err = can_start(can_dev);
+	zassert_equal(err, 0, "failed to start CAN controller (err %d)", err);
+
+	can_rx_mgr_init(&mgr, can_dev);
+
+	for (int n = 0; n < TEST_FILTERS; n++) {
+		filter_ids[n] = -1;
+	}
+
+	return NULL;
+}
+
+static void can_rx_mgr_after(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	remove_filters();
+	k_sem_reset(&rx_sem);
+}
+
+ZTEST_SUITE(can_rx_mgr, NULL, can_rx_mgr_setup, NULL, can_rx_mgr_after, NULL);
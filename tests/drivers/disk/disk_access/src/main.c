@@ -220,6 +220,45 @@ ZTEST(disk_driver, test_write)
 	}
 }
 
+#ifdef CONFIG_DISK_CACHE
+/* Test that the cache serves repeated accesses and writes back on sync */
+ZTEST(disk_driver, test_cache)
+{
+	struct disk_cache_stats stats;
+	int rc;
+
+	/* Write back what the other tests wrote */
+	rc = disk_access_ioctl(disk_pdrv, DISK_IOCTL_CTRL_SYNC, NULL);
+	zassert_equal(rc, 0, "Disk sync failed");
+
+	/* Write a single sector, which is cached until the sync */
+	disk_cache_stats_reset();
+	rc = write_sector_checked(scratch_buf[0], scratch_buf[1], 1, SECTOR_COUNT2);
+	zassert_equal(rc, 0, "Failed to write to disk");
+
+	rc = read_sector(scratch_buf[1], 1, SECTOR_COUNT2);
+	zassert_equal(rc, 0, "Failed to read from disk");
+	zassert_mem_equal(scratch_buf[0], scratch_buf[1], disk_sector_size,
+			  "Read data did not match data written to disk");
+
+	disk_cache_stats_get(&stats);
+	zassert_true(stats.hits >= 2, "Cached sector not hit");
+	zassert_equal(stats.write_backs, 0, "Sector written back before sync");
+
+	rc = disk_access_ioctl(disk_pdrv, DISK_IOCTL_CTRL_SYNC, NULL);
+	zassert_equal(rc, 0, "Disk sync failed");
+
+	disk_cache_stats_get(&stats);
+	zassert_equal(stats.write_backs, 1, "Sector not written back on sync");
+
+	/* Nothing is left to write back */
+	rc = disk_access_ioctl(disk_pdrv, DISK_IOCTL_CTRL_SYNC, NULL);
+	zassert_equal(rc, 0, "Disk sync failed");
+
+	disk_cache_stats_get(&stats);
+	zassert_equal(stats.write_backs, 1, "Clean sector written back");
+}
+#endif /* CONFIG_DISK_CACHE */
 
 static void *disk_driver_setup(void)
 {
@@ -480,6 +480,153 @@ static int test_loop_repeated_start_stop(const struct device *dma)
 	return TC_PASS;
 }
 
+static volatile int ring_status;
+
+static void dma_ring_callback(const struct device *dma_dev, void *arg,
+			      uint32_t id, int status)
+{
+	if (status < 0 || ring_status >= 0) {
+		ring_status = status;
+	}
+}
+
+static int test_loop_ring(const struct device *dma)
+{
+	struct dma_config ring_cfg = {0};
+	struct dma_block_config ring_block = {0};
+	static int chan_id;
+	unsigned int irq_key;
+	int64_t timeout;
+	int queued = 1;
+	int retired = 0;
+	int res;
+
+	TC_PRINT("DMA memory to memory descriptor ring started\n");
+
+	for (int i = 0; i < CONFIG_DMA_LOOP_TRANSFER_SIZE; i++) {
+		tx_data[i] = i;
+	}
+
+	memset(rx_data, 0, sizeof(rx_data));
+
+	if (!device_is_ready(dma)) {
+		TC_PRINT("dma controller device is not ready\n");
+		return TC_FAIL;
+	}
+
+	ring_cfg.channel_direction = MEMORY_TO_MEMORY;
+	ring_cfg.source_data_size = 1U;
+	ring_cfg.dest_data_size = 1U;
+	ring_cfg.source_burst_length = 1U;
+	ring_cfg.dest_burst_length = 1U;
+	ring_cfg.dma_callback = dma_ring_callback;
+	ring_cfg.block_count = 1U;
+	ring_cfg.head_block = &ring_block;
+
+#ifdef CONFIG_DMA_MCUX_TEST_SLOT_START
+	ring_cfg.dma_slot = CONFIG_DMA_MCUX_TEST_SLOT_START;
+#endif
+
+	chan_id = dma_request_channel(dma, NULL);
+	if (chan_id < 0) {
+		TC_PRINT("this platform do not support the dma channel\n");
+		chan_id = CONFIG_DMA_LOOP_TRANSFER_CHANNEL_NR;
+	}
+
+	/* Scatter/gather gives the channel a descriptor ring where it has one */
+	ring_block.dest_scatter_en = 1U;
+	ring_block.block_size = sizeof(tx_data);
+	ring_block.source_address = (uintptr_t)tx_data;
+	ring_block.dest_address = (uintptr_t)rx_data[0];
+	ring_status = 0;
+
+	if (dma_config(dma, chan_id, &ring_cfg)) {
+		TC_PRINT("ERROR: transfer config (%d)\n", chan_id);
+		return TC_FAIL;
+	}
+
+	if (dma_start(dma, chan_id)) {
+		TC_PRINT("ERROR: transfer start (%d)\n", chan_id);
+		return TC_FAIL;
+	}
+
+	/* Nothing is retired with the interrupts locked, the ring fills up */
+	irq_key = irq_lock();
+	do {
+		res = dma_enqueue(dma, chan_id, (uintptr_t)tx_data,
+				  (uintptr_t)rx_data[queued], sizeof(tx_data));
+	} while (res == 0 && ++queued < TRANSFER_LOOPS);
+	irq_unlock(irq_key);
+
+	if (res == -ENOSYS || res == -ENOTSUP) {
+		TC_PRINT("descriptor ring not supported\n");
+		dma_stop(dma, chan_id);
+		return TC_SKIP;
+	}
+
+	if (res != -ENOMEM) {
+		TC_PRINT("ERROR: ring of %d blocks not full (%d)\n", queued, res);
+		dma_stop(dma, chan_id);
+		return TC_FAIL;
+	}
+
+	/* Refill the ring as the blocks complete, without reconfiguring */
+	timeout = k_uptime_get() + SLEEPTIME;
+	while (retired < TRANSFER_LOOPS && k_uptime_get() < timeout) {
+		res = dma_dequeue(dma, chan_id);
+		if (res < 0 || retired + res > queued) {
+			TC_PRINT("ERROR: %d blocks retired out of %d (%d)\n",
+				 retired, queued, res);
+			dma_stop(dma, chan_id);
+			return TC_FAIL;
+		}
+		retired += res;
+
+		if (queued < TRANSFER_LOOPS) {
+			res = dma_enqueue(dma, chan_id, (uintptr_t)tx_data,
+					  (uintptr_t)rx_data[queued], sizeof(tx_data));
+			if (res == 0) {
+				queued++;
+			} else if (res != -ENOMEM) {
+				TC_PRINT("ERROR: enqueue block %d (%d)\n", queued, res);
+				dma_stop(dma, chan_id);
+				return TC_FAIL;
+			}
+		}
+
+		k_busy_wait(100);
+	}
+
+	dma_stop(dma, chan_id);
+
+	if (retired < TRANSFER_LOOPS) {
+		TC_PRINT("ERROR: %d blocks retired out of %d\n", retired, TRANSFER_LOOPS);
+		return TC_FAIL;
+	}
+
+	if (ring_status != DMA_STATUS_COMPLETE) {
+		TC_PRINT("ERROR: ring did not complete (%d)\n", ring_status);
+		return TC_FAIL;
+	}
+
+	if (dma_dequeue(dma, chan_id) != 0) {
+		TC_PRINT("ERROR: blocks retired twice\n");
+		return TC_FAIL;
+	}
+
+	TC_PRINT("Each RX buffer should contain the full TX buffer string.\n");
+
+	for (int i = 0; i < TRANSFER_LOOPS; i++) {
+		TC_PRINT("RX data Loop %d\n", i);
+		if (memcmp(tx_data, rx_data[i], CONFIG_DMA_LOOP_TRANSFER_SIZE)) {
+			return TC_FAIL;
+		}
+	}
+
+	TC_PRINT("Finished DMA: %s\n", dma->name);
+	return TC_PASS;
+}
+
 #define DMA_NAME(i, _)	test_dma ## i
 #define DMA_LIST	LISTIFY(CONFIG_DMA_LOOP_TRANSFER_NUMBER_OF_DMAS, DMA_NAME, (,))
 
@@ -509,3 +656,17 @@ FOR_EACH(TEST_LOOP_SUSPEND_RESUME, (), DMA_LIST);
 	}
 
 FOR_EACH(TEST_LOOP_REPEATED_START_STOP, (), DMA_LIST);
+
+#define TEST_LOOP_RING(dma_name)                                                                   \
+	ZTEST(dma_m2m_loop, test_ ## dma_name ## _m2m_loop_ring)                                   \
+	{                                                                                          \
+		const struct device *dma = DEVICE_DT_GET(DT_NODELABEL(dma_name));                  \
+		int res = test_loop_ring(dma);                                                     \
+                                                                                                   \
+		if (res == TC_SKIP) {                                                              \
+			ztest_test_skip();                                                         \
+		}                                                                                  \
+		zassert_true((res == TC_PASS));                                                    \
+	}
+
+FOR_EACH(TEST_LOOP_RING, (), DMA_LIST);
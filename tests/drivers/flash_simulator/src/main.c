@@ -312,6 +312,187 @@ ZTEST(flash_sim_api, test_get_mock)
 #endif
 }
 
+ZTEST(flash_sim_api, test_timing)
+{
+#ifdef CONFIG_FLASH_SIMULATOR_SIMULATE_TIMING
+	const uint32_t units = 2;
+	uint64_t expected_us;
+	int64_t start;
+	uint64_t elapsed_us;
+	int rc;
+
+	expected_us = CONFIG_FLASH_SIMULATOR_MIN_ERASE_TIME_US +
+		      units * CONFIG_FLASH_SIMULATOR_ERASE_UNIT_TIME_US;
+
+	start = k_uptime_ticks();
+	rc = flash_erase(flash_dev, FLASH_SIMULATOR_BASE_OFFSET,
+			 units * FLASH_SIMULATOR_ERASE_UNIT);
+	elapsed_us = k_ticks_to_us_ceil64(k_uptime_ticks() - start);
+	zassert_equal(0, rc, "flash_erase should succeed");
+	zassert_true(elapsed_us >= expected_us,
+		     "Erase took %llu us, expected at least %llu us",
+		     elapsed_us, expected_us);
+
+	expected_us = CONFIG_FLASH_SIMULATOR_MIN_WRITE_TIME_US +
+		      (FLASH_SIMULATOR_ERASE_UNIT / FLASH_SIMULATOR_PROG_UNIT) *
+		      (uint64_t)CONFIG_FLASH_SIMULATOR_WRITE_UNIT_TIME_NS / NSEC_PER_USEC;
+
+	memset(test_read_buf, 0, FLASH_SIMULATOR_ERASE_UNIT);
+	start = k_uptime_ticks();
+	rc = flash_write(flash_dev, FLASH_SIMULATOR_BASE_OFFSET, test_read_buf,
+			 FLASH_SIMULATOR_ERASE_UNIT);
+	elapsed_us = k_ticks_to_us_ceil64(k_uptime_ticks() - start);
+	zassert_equal(0, rc, "flash_write should succeed");
+	zassert_true(elapsed_us >= expected_us,
+		     "Write took %llu us, expected at least %llu us",
+		     elapsed_us, expected_us);
+#else
+	ztest_test_skip();
+#endif
+}
+
+#ifdef CONFIG_FLASH_ASYNC
+#define ASYNC_LEN 64
+
+struct async_result {
+	struct k_sem done;
+	enum flash_async_op_type order[4];
+	int results[4];
+	int count;
+	/* Reads left to chain from the callback */
+	int chained;
+};
+
+static void async_cb(const struct device *dev, struct flash_async_op *op,
+		     int result)
+{
+	struct async_result *res = op->user_data;
+
+	zassert_equal_ptr(dev, flash_dev, "Wrong device");
+
+	if (res->count < ARRAY_SIZE(res->order)) {
+		res->order[res->count] = op->type;
+		res->results[res->count] = result;
+	}
+
+	res->count++;
+
+	if (res->chained > 0) {
+		res->chained--;
+		op->offset += ASYNC_LEN;
+		op->data = (uint8_t *)op->data + ASYNC_LEN;
+		zassert_ok(flash_async_submit(dev, op), "Resubmit failed");
+		return;
+	}
+
+	k_sem_give(&res->done);
+}
+
+ZTEST(flash_sim_api, test_async_in_order)
+{
+	static uint8_t write_buf[ASYNC_LEN];
+	struct async_result res = { 0 };
+	struct flash_async_op ops[] = {
+		{
+			.type = FLASH_ASYNC_OP_ERASE,
+			.offset = FLASH_SIMULATOR_BASE_OFFSET,
+			.len = FLASH_SIMULATOR_ERASE_UNIT,
+		},
+		{
+			.type = FLASH_ASYNC_OP_WRITE,
+			.offset = FLASH_SIMULATOR_BASE_OFFSET,
+			.data = write_buf,
+			.len = ASYNC_LEN,
+		},
+		{
+			.type = FLASH_ASYNC_OP_READ,
+			.offset = FLASH_SIMULATOR_BASE_OFFSET,
+			.data = test_read_buf,
+			.len = ASYNC_LEN,
+		},
+	};
+
+	k_sem_init(&res.done, 0, ARRAY_SIZE(ops));
+
+	for (int i = 0; i < ASYNC_LEN; i++) {
+		write_buf[i] = i;
+	}
+	memset(test_read_buf, 0, ASYNC_LEN);
+
+	/* Submitted back to back, executed in order of submission */
+	for (int i = 0; i < ARRAY_SIZE(ops); i++) {
+		ops[i].cb = async_cb;
+		ops[i].user_data = &res;
+		zassert_ok(flash_async_submit(flash_dev, &ops[i]),
+			   "Submit %d failed", i);
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(ops); i++) {
+		zassert_ok(k_sem_take(&res.done, K_SECONDS(1)),
+			   "Callback %d not invoked", i);
+	}
+
+	zassert_equal(res.count, ARRAY_SIZE(ops));
+	for (int i = 0; i < ARRAY_SIZE(ops); i++) {
+		zassert_equal(res.order[i], ops[i].type, "Operation %d out of order", i);
+		zassert_equal(res.results[i], 0, "Operation %d failed", i);
+	}
+
+	zassert_mem_equal(test_read_buf, write_buf, ASYNC_LEN, "Read back differs");
+}
+
+ZTEST(flash_sim_api, test_async_errors)
+{
+	struct async_result res = { 0 };
+	struct flash_async_op op = {
+		.type = FLASH_ASYNC_OP_WRITE,
+		.offset = FLASH_SIMULATOR_BASE_OFFSET - 4,
+		.data = test_read_buf,
+		.len = 4,
+		.user_data = &res,
+	};
+
+	k_sem_init(&res.done, 0, 1);
+
+	/* Not queued, and no callback to invoke */
+	zassert_equal(flash_async_submit(flash_dev, &op), -EINVAL,
+		      "Operation without callback accepted");
+
+	/* Failures of queued operations are reported to the callback */
+	op.cb = async_cb;
+	zassert_ok(flash_async_submit(flash_dev, &op));
+	zassert_ok(k_sem_take(&res.done, K_SECONDS(1)), "Callback not invoked");
+
+	zassert_equal(res.count, 1);
+	zassert_equal(res.results[0], -EINVAL, "Out of bounds write succeeded");
+}
+
+ZTEST(flash_sim_api, test_async_resubmit)
+{
+	struct async_result res = { .chained = 3 };
+	struct flash_async_op op = {
+		.type = FLASH_ASYNC_OP_READ,
+		.offset = FLASH_SIMULATOR_BASE_OFFSET,
+		.data = test_read_buf,
+		.len = ASYNC_LEN,
+		.cb = async_cb,
+		.user_data = &res,
+	};
+
+	k_sem_init(&res.done, 0, 1);
+
+	/* The callback submits the same operation again for the next chunk */
+	zassert_ok(flash_async_submit(flash_dev, &op));
+	zassert_ok(k_sem_take(&res.done, K_SECONDS(1)), "Callback not invoked");
+
+	zassert_equal(res.count, 4);
+	zassert_equal(op.offset, FLASH_SIMULATOR_BASE_OFFSET + 3 * ASYNC_LEN);
+	for (int i = 0; i < res.count; i++) {
+		zassert_equal(res.results[i], 0, "Read %d failed", i);
+	}
+}
+#endif /* CONFIG_FLASH_ASYNC */
+
 void *flash_sim_setup(void)
 {
 	test_init();
@@ -12,6 +12,8 @@
 #include <zephyr/fff.h>
 #include <zephyr/ztest.h>
 
+#include "icm42688.h"
+#include "icm42688_decoder.h"
 #include "icm42688_emul.h"
 #include "icm42688_reg.h"
 
@@ -240,3 +242,130 @@ ZTEST_F(icm42688, test_interrupt)
 	/* Verify the handler was called */
 	zassert_equal(test_interrupt_trigger_handler_fake.call_count, 1);
 }
+
+/* Two FIFO packets at 1 kHz, the gyro being only available in the second one */
+static const struct {
+	struct icm42688_fifo_data header;
+	uint8_t packets[2][FIFO_PACKET_SIZE];
+} __packed test_fifo_buffer = {
+	.header = {
+		.header = {
+			.timestamp = 1000000000,
+			.is_fifo = true,
+			.accel_fs = ICM42688_ACCEL_FS_16G,
+			.gyro_fs = ICM42688_GYRO_FS_2000,
+		},
+		.int_status = BIT_INT_STATUS_FIFO_THS,
+		.accel_odr = ICM42688_ACCEL_ODR_1000,
+		.gyro_odr = ICM42688_GYRO_ODR_1000,
+		.fifo_count = 2 * FIFO_PACKET_SIZE,
+	},
+	.packets = {
+		/* Accel only, gyro not available yet */
+		{BIT_FIFO_HEADER_ACCEL, 0x40, 0x00, 0xc0, 0x00, 0x00, 0x00,
+		 0x80, 0x00, 0x80, 0x00, 0x80, 0x00, 0, 0, 0},
+		{BIT_FIFO_HEADER_ACCEL | BIT_FIFO_HEADER_GYRO, 0x40, 0x00, 0xc0, 0x00, 0x00,
+		 0x00, 0x40, 0x00, 0x00, 0x00, 0xc0, 0x00, 0, 0, 0},
+	},
+};
+
+ZTEST_F(icm42688, test_decode_fifo)
+{
+	const struct sensor_decoder_api *decoder;
+	const uint8_t *buffer = (const uint8_t *)&test_fifo_buffer;
+	sensor_frame_iterator_t fit = 0;
+	sensor_channel_iterator_t cit = 0;
+	enum sensor_channel channels[7];
+	q31_t values[7];
+	uint16_t frame_count;
+	uint64_t timestamp;
+	int8_t shift;
+
+	zassert_ok(sensor_get_decoder(fixture->dev, &decoder));
+
+	zassert_ok(decoder->get_frame_count(buffer, &frame_count));
+	zassert_equal(2, frame_count);
+	zassert_true(decoder->has_trigger(buffer, SENSOR_TRIG_FIFO_WATERMARK));
+	zassert_false(decoder->has_trigger(buffer, SENSOR_TRIG_FIFO_FULL));
+
+	/* The frames are one 1 kHz period apart, the last one at the header timestamp */
+	zassert_ok(decoder->get_frame_timestamp(buffer, 0, &timestamp));
+	zassert_equal(999000000, timestamp);
+	zassert_ok(decoder->get_frame_timestamp(buffer, 1, &timestamp));
+	zassert_equal(1000000000, timestamp);
+	zassert_equal(-EINVAL, decoder->get_frame_timestamp(buffer, 2, &timestamp));
+
+	/* First frame: temperature and accel */
+	zassert_equal(4, decoder->decode(buffer, &fit, &cit, channels, values, 7));
+	zassert_equal(1, fit);
+	zassert_equal(SENSOR_CHAN_DIE_TEMP, channels[0]);
+	zassert_equal(SENSOR_CHAN_ACCEL_X, channels[1]);
+	zassert_equal(SENSOR_CHAN_ACCEL_Z, channels[3]);
+
+	/* Half the 16 g range is 8 g */
+	zassert_ok(decoder->get_shift(buffer, SENSOR_CHAN_ACCEL_X, &shift));
+	zassert_within(8 * SENSOR_G / 1000, ((int64_t)values[1] << shift) * 1000 >> 31, 100);
+	zassert_within(-8 * SENSOR_G / 1000, ((int64_t)values[2] << shift) * 1000 >> 31, 100);
+	zassert_equal(0, values[3]);
+
+	/* Second frame: temperature, accel and gyro */
+	zassert_equal(7, decoder->decode(buffer, &fit, &cit, channels, values, 7));
+	zassert_equal(2, fit);
+	zassert_equal(SENSOR_CHAN_GYRO_Z, channels[6]);
+	zassert_equal(0, values[5]);
+
+	/* No more frames */
+	zassert_equal(0, decoder->decode(buffer, &fit, &cit, channels, values, 7));
+}
+
+ZTEST_F(icm42688, test_decode_fifo_channel)
+{
+	const struct sensor_decoder_api *decoder;
+	const uint8_t *buffer = (const uint8_t *)&test_fifo_buffer;
+	struct sensor_decoder_api fallback;
+	sensor_frame_iterator_t fit = 0;
+	sensor_channel_iterator_t cit = 0;
+	enum sensor_channel channels[7];
+	q31_t frame_values[2][7];
+	q31_t values[8];
+
+	zassert_ok(sensor_get_decoder(fixture->dev, &decoder));
+	zassert_not_null(decoder->decode_channel);
+
+	/* Reference values decoded frame by frame */
+	zassert_equal(4, decoder->decode(buffer, &fit, &cit, channels, frame_values[0], 7));
+	zassert_equal(7, decoder->decode(buffer, &fit, &cit, channels, frame_values[1], 7));
+
+	/* Both frames hold the accel, interleaved */
+	fit = 0;
+	zassert_equal(6, sensor_decode_channel(decoder, buffer, SENSOR_CHAN_ACCEL_XYZ, &fit,
+					       values, ARRAY_SIZE(values)));
+	zassert_equal(2, fit);
+	zassert_mem_equal(&values[0], &frame_values[0][1], 3 * sizeof(q31_t));
+	zassert_mem_equal(&values[3], &frame_values[1][1], 3 * sizeof(q31_t));
+	zassert_equal(0, sensor_decode_channel(decoder, buffer, SENSOR_CHAN_ACCEL_XYZ, &fit,
+					       values, ARRAY_SIZE(values)));
+
+	/* Only the second frame holds the gyro */
+	fit = 0;
+	zassert_equal(1, sensor_decode_channel(decoder, buffer, SENSOR_CHAN_GYRO_Y, &fit, values,
+					       ARRAY_SIZE(values)));
+	zassert_equal(frame_values[1][5], values[0]);
+
+	/* Out of room for a second frame */
+	fit = 0;
+	zassert_equal(3, sensor_decode_channel(decoder, buffer, SENSOR_CHAN_ACCEL_XYZ, &fit,
+					       values, 5));
+	zassert_equal(1, fit);
+
+	/* Decoding with the decode function gives the same values */
+	fallback = *decoder;
+	fallback.decode_channel = NULL;
+	fit = 0;
+	zassert_equal(6, sensor_decode_channel(&fallback, buffer, SENSOR_CHAN_ACCEL_XYZ, &fit,
+					       values, ARRAY_SIZE(values)));
+	zassert_mem_equal(&values[0], &frame_values[0][1], 3 * sizeof(q31_t));
+	zassert_mem_equal(&values[3], &frame_values[1][1], 3 * sizeof(q31_t));
+	zassert_equal(0, sensor_decode_channel(&fallback, buffer, SENSOR_CHAN_ACCEL_XYZ, &fit,
+					       values, ARRAY_SIZE(values)));
+}
@@ -0,0 +1,399 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+
+#include <zephyr/drivers/serial/uart_stream.h>
+#include <zephyr/drivers/uart.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#define CHUNKS CONFIG_UART_STREAM_CHUNKS
+#define CHUNK_SIZE 16
+#define RX_TIMEOUT_US 100
+
+/*
+ * Mock of a driver of the asynchronous API, the test plays its side of the reception: it fills
+ * the buffers and raises the events a driver would.
+ */
+struct uart_mock_data {
+	uart_callback_t cb;
+	void *user_data;
+	uint8_t *buf;
+	size_t len;
+	size_t offset;
+	uint8_t *next_buf;
+	int32_t timeout;
+	int enable_calls;
+	int enable_ret;
+};
+
+static struct device uart_mock;
+static struct uart_mock_data mock_data;
+static struct device_state mock_state = {
+	.init_res = 0,
+	.initialized = 1,
+};
+
+static void mock_event(struct uart_event *evt)
+{
+	mock_data.cb(&uart_mock, evt, mock_data.user_data);
+}
+
+static void mock_buf_event(enum uart_event_type type, uint8_t *buf)
+{
+	struct uart_event evt = {
+		.type = type,
+		.data.rx_buf.buf = buf,
+	};
+
+	mock_event(&evt);
+}
+
+static int uart_mock_callback_set(const struct device *dev, uart_callback_t callback,
+				  void *user_data)
+{
+	mock_data.cb = callback;
+	mock_data.user_data = user_data;
+
+	return 0;
+}
+
+static int uart_mock_rx_enable(const struct device *dev, uint8_t *buf, size_t len,
+			       int32_t timeout)
+{
+	mock_data.enable_calls++;
+	if (mock_data.enable_ret != 0) {
+		return mock_data.enable_ret;
+	}
+
+	mock_data.buf = buf;
+	mock_data.len = len;
+	mock_data.offset = 0;
+	mock_data.next_buf = NULL;
+	mock_data.timeout = timeout;
+
+	mock_buf_event(UART_RX_BUF_REQUEST, NULL);
+
+	return 0;
+}
+
+static int uart_mock_rx_buf_rsp(const struct device *dev, uint8_t *buf, size_t len)
+{
+	zassert_equal(len, CHUNK_SIZE);
+	mock_data.next_buf = buf;
+
+	return 0;
+}
+
+static int uart_mock_rx_disable(const struct device *dev)
+{
+	uint8_t *buf = mock_data.buf;
+	uint8_t *next_buf = mock_data.next_buf;
+	struct uart_event evt = {
+		.type = UART_RX_DISABLED,
+	};
+
+	zassert_not_null(buf, "Reception not enabled");
+
+	mock_data.buf = NULL;
+	mock_data.next_buf = NULL;
+
+	mock_buf_event(UART_RX_BUF_RELEASED, buf);
+	if (next_buf != NULL) {
+		mock_buf_event(UART_RX_BUF_RELEASED, next_buf);
+	}
+	mock_event(&evt);
+
+	return 0;
+}
+
+static const struct uart_driver_api mock_api = {
+	.callback_set = uart_mock_callback_set,
+	.rx_enable = uart_mock_rx_enable,
+	.rx_buf_rsp = uart_mock_rx_buf_rsp,
+	.rx_disable = uart_mock_rx_disable,
+};
+
+static struct device uart_mock = {
+	.api = &mock_api,
+	.data = &mock_data,
+	.state = &mock_state,
+};
+
+static uint8_t stream_buffer[CHUNKS * CHUNK_SIZE];
+static struct uart_stream stream;
+static uint8_t next_byte;
+static uint8_t read_byte;
+
+/* Receive len bytes in the current buffer, numbered in the order they are received */
+static void mock_receive(size_t len)
+{
+	struct uart_event evt = {
+		.type = UART_RX_RDY,
+		.data.rx.buf = mock_data.buf,
+		.data.rx.offset = mock_data.offset,
+		.data.rx.len = len,
+	};
+
+	zassert_not_null(mock_data.buf, "Reception not enabled");
+	zassert_true(mock_data.offset + len <= mock_data.len);
+
+	for (size_t i = 0; i < len; i++) {
+		mock_data.buf[mock_data.offset + i] = next_byte++;
+	}
+	mock_data.offset += len;
+
+	mock_event(&evt);
+}
+
+/* Fill the current buffer and switch to the next one, the reception stops without one */
+static void mock_buffer_full(void)
+{
+	uint8_t *buf = mock_data.buf;
+	struct uart_event evt = {
+		.type = UART_RX_DISABLED,
+	};
+
+	mock_receive(mock_data.len - mock_data.offset);
+
+	mock_data.buf = mock_data.next_buf;
+	mock_data.offset = 0;
+	mock_data.next_buf = NULL;
+
+	mock_buf_event(UART_RX_BUF_RELEASED, buf);
+
+	if (mock_data.buf != NULL) {
+		mock_buf_event(UART_RX_BUF_REQUEST, NULL);
+	} else {
+		mock_event(&evt);
+	}
+}
+
+/* Read up to size bytes, checking they come in the order they were received */
+static size_t read_checked(size_t size)
+{
+	uint8_t data[CHUNKS * CHUNK_SIZE];
+	size_t len;
+
+	len = uart_stream_read(&stream, data, size);
+
+	for (size_t i = 0; i < len; i++) {
+		zassert_equal(data[i], read_byte++, "Data differs at %zu", i);
+	}
+
+	return len;
+}
+
+/* Check that exactly len bytes are left to read */
+static void check_read(size_t len)
+{
+	zassert_equal(read_checked(CHUNKS * CHUNK_SIZE), len);
+}
+
+/* Returns the result of the signal of the stream, -EAGAIN if not raised */
+static int poll_stream(void)
+{
+	struct k_poll_event evt;
+
+	uart_stream_poll_event_init(&stream, &evt);
+	if (k_poll(&evt, 1, K_NO_WAIT) != 0) {
+		return -EAGAIN;
+	}
+
+	return evt.signal->result;
+}
+
+static void uart_stream_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	memset(&mock_data, 0, sizeof(mock_data));
+	next_byte = 0;
+	read_byte = 0;
+
+	zassert_ok(uart_stream_init(&stream, &uart_mock, stream_buffer, sizeof(stream_buffer),
+				    RX_TIMEOUT_US));
+	zassert_ok(uart_stream_start(&stream));
+}
+
+static void uart_stream_after(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	(void)uart_stream_stop(&stream);
+}
+
+ZTEST(uart_stream, test_init)
+{
+	struct uart_stream other;
+
+	zassert_equal(uart_stream_init(&other, &uart_mock, stream_buffer, CHUNKS - 1,
+				       RX_TIMEOUT_US), -EINVAL);
+
+	/* The reception starts on the first chunk, the driver asks for the next one */
+	zassert_equal(mock_data.enable_calls, 1);
+	zassert_equal_ptr(mock_data.buf, stream_buffer);
+	zassert_equal(mock_data.len, CHUNK_SIZE);
+	zassert_equal(mock_data.timeout, RX_TIMEOUT_US);
+	zassert_equal_ptr(mock_data.next_buf, stream_buffer + CHUNK_SIZE);
+
+	zassert_equal(uart_stream_start(&stream), -EALREADY);
+}
+
+ZTEST(uart_stream, test_claim_in_place)
+{
+	uint8_t *data;
+
+	zassert_equal(poll_stream(), -EAGAIN, "Signal raised without data");
+
+	mock_receive(5);
+	zassert_equal(poll_stream(), 0, "Signal not raised on data");
+
+	/* The data is read where the driver wrote it */
+	zassert_equal(uart_stream_claim(&stream, &data), 5);
+	zassert_equal_ptr(data, stream_buffer);
+
+	zassert_equal(uart_stream_finish(&stream, 6), -EINVAL);
+	zassert_ok(uart_stream_finish(&stream, 2));
+	zassert_equal(uart_stream_claim(&stream, &data), 3);
+	zassert_equal_ptr(data, stream_buffer + 2);
+	zassert_ok(uart_stream_finish(&stream, 3));
+
+	/* Nothing left, the signal waits for the next data */
+	zassert_equal(uart_stream_claim(&stream, &data), 0);
+	zassert_equal(poll_stream(), -EAGAIN, "Signal not reset");
+
+	mock_receive(1);
+	zassert_equal(poll_stream(), 0);
+	read_byte = 5;
+	check_read(1);
+}
+
+ZTEST(uart_stream, test_read_across_chunks)
+{
+	uint8_t *data;
+
+	mock_buffer_full();
+	zassert_equal_ptr(mock_data.buf, stream_buffer + CHUNK_SIZE);
+	zassert_equal_ptr(mock_data.next_buf, stream_buffer + 2 * CHUNK_SIZE);
+
+	mock_receive(4);
+
+	/* A claim stops at the end of a chunk */
+	zassert_equal(uart_stream_claim(&stream, &data), CHUNK_SIZE);
+	zassert_ok(uart_stream_finish(&stream, 0));
+
+	check_read(CHUNK_SIZE + 4);
+}
+
+ZTEST(uart_stream, test_ring_full)
+{
+	/* The driver gets no buffer once every chunk holds unread data */
+	for (int i = 0; i < CHUNKS - 1; i++) {
+		mock_buffer_full();
+	}
+	zassert_is_null(mock_data.next_buf, "Buffer given while the ring is full");
+
+	mock_buffer_full();
+	zassert_is_null(mock_data.buf, "Reception not stopped");
+	zassert_equal(mock_data.enable_calls, 1);
+
+	/* Reading a chunk restarts the reception on it */
+	zassert_equal(read_checked(CHUNK_SIZE), CHUNK_SIZE);
+	zassert_equal(mock_data.enable_calls, 2);
+	zassert_equal_ptr(mock_data.buf, stream_buffer);
+
+	check_read((CHUNKS - 1) * CHUNK_SIZE);
+
+	mock_receive(3);
+	check_read(3);
+}
+
+ZTEST(uart_stream, test_error_recovery)
+{
+	struct uart_event evt = {
+		.type = UART_RX_STOPPED,
+		.data.rx_stop.reason = UART_ERROR_OVERRUN,
+	};
+
+	mock_receive(3);
+
+	/* The driver stops on the error and disables the reception */
+	mock_event(&evt);
+	zassert_equal(poll_stream(), UART_ERROR_OVERRUN, "Error not signaled");
+	zassert_ok(uart_mock_rx_disable(&uart_mock));
+
+	/* The stream enables it again on its own, the data received is kept */
+	zassert_equal(mock_data.enable_calls, 2);
+	zassert_not_null(mock_data.buf);
+	check_read(3);
+
+	mock_receive(2);
+	check_read(2);
+}
+
+ZTEST(uart_stream, test_stop)
+{
+	mock_receive(4);
+
+	zassert_ok(uart_stream_stop(&stream));
+	zassert_is_null(mock_data.buf, "Reception not disabled");
+	zassert_equal(uart_stream_stop(&stream), -EALREADY);
+
+	/* Not enabled again once stopped, the data received can still be read */
+	zassert_equal(mock_data.enable_calls, 1);
+	check_read(4);
+
+	zassert_ok(uart_stream_start(&stream));
+	zassert_equal(mock_data.enable_calls, 2);
+	mock_receive(1);
+	check_read(1);
+}
+
+ZTEST(uart_stream, test_enable_failure)
+{
+	zassert_ok(uart_stream_stop(&stream));
+
+	mock_data.enable_ret = -EIO;
+	zassert_equal(uart_stream_start(&stream), -EIO);
+	zassert_equal(uart_stream_stop(&stream), -EALREADY, "Stream left running");
+
+	mock_data.enable_ret = 0;
+	zassert_ok(uart_stream_start(&stream));
+	mock_receive(CHUNK_SIZE);
+	check_read(CHUNK_SIZE);
+}
+
+static int forwarded;
+
+static void other_callback(const struct device *dev, struct uart_event *evt, void *user_data)
+{
+	zassert_equal_ptr(dev, &uart_mock);
+	zassert_equal_ptr(user_data, &forwarded);
+	zassert_equal(evt->type, UART_TX_DONE, "Reception event forwarded");
+
+	forwarded++;
+}
+
+ZTEST(uart_stream, test_forward_callback)
+{
+	struct uart_event evt = {
+		.type = UART_TX_DONE,
+	};
+
+	uart_stream_callback_set(&stream, other_callback, &forwarded);
+	forwarded = 0;
+
+	mock_event(&evt);
+	mock_receive(1);
+	mock_buffer_full();
+
+	zassert_equal(forwarded, 1);
+	check_read(CHUNK_SIZE);
+}
+
+ZTEST_SUITE(uart_stream, NULL, NULL, uart_stream_before, uart_stream_after, NULL);
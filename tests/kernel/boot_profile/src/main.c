@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/init.h>
+#include <zephyr/kernel/boot_profile.h>
+#include <zephyr/ztest.h>
+
+#define SLOW_INIT_MS 20
+
+static int slow_init(void)
+{
+	k_busy_wait(SLOW_INIT_MS * USEC_PER_MSEC);
+
+	return 0;
+}
+
+SYS_INIT(slow_init, POST_KERNEL, 99);
+
+struct profile {
+	const struct boot_profile_span *post_kernel;
+	const struct boot_profile_span *slow_init;
+	const struct boot_profile_span *main;
+};
+
+static void find_spans(const struct boot_profile_span *span, void *user_data)
+{
+	struct profile *profile = user_data;
+
+	if ((span->step == BOOT_PROFILE_LEVEL) && (span->level == 3)) {
+		profile->post_kernel = span;
+	} else if ((span->step == BOOT_PROFILE_INIT) &&
+		   (span->entry->init_fn.sys == slow_init)) {
+		profile->slow_init = span;
+	} else if (span->step == BOOT_PROFILE_MAIN) {
+		profile->main = span;
+	}
+}
+
+ZTEST(boot_profile, test_spans)
+{
+	struct profile profile = { 0 };
+	uint32_t took_us;
+
+	zassert_equal(boot_profile_foreach(find_spans, &profile), 0);
+	zassert_not_null(profile.post_kernel);
+	zassert_not_null(profile.slow_init);
+	zassert_not_null(profile.main);
+
+	took_us = k_cyc_to_us_floor32(profile.slow_init->end_cycles -
+				      profile.slow_init->start_cycles);
+	zassert_true(took_us >= SLOW_INIT_MS * USEC_PER_MSEC, "took %u us", took_us);
+
+	/* The init function is within its level, which is over before main() */
+	zassert_true(profile.slow_init->start_cycles >= profile.post_kernel->start_cycles);
+	zassert_true(profile.slow_init->end_cycles <= profile.post_kernel->end_cycles);
+	zassert_true(profile.post_kernel->end_cycles <= profile.main->start_cycles);
+}
+
+ZTEST_SUITE(boot_profile, NULL, NULL, NULL, NULL, NULL);
@@ -58,6 +58,29 @@ ZTEST(cache_api, test_data_cache_api)
 
 }
 
+ZTEST(cache_api, test_data_cache_api_ranges)
+{
+	struct sys_cache_range ranges[] = {
+		{ .addr = user_buffer, .size = SIZE / 4 },
+		{ .addr = user_buffer + SIZE / 2 + 3, .size = SIZE / 4 },
+		{ .addr = user_buffer + SIZE - 1, .size = 1 },
+		{ .addr = user_buffer, .size = 0 },
+	};
+	int ret;
+
+	ret = sys_cache_data_flush_ranges(ranges, ARRAY_SIZE(ranges));
+	zassert_true((ret == 0) || (ret == -ENOTSUP));
+
+	ret = sys_cache_data_invd_ranges(ranges, ARRAY_SIZE(ranges));
+	zassert_true((ret == 0) || (ret == -ENOTSUP));
+
+	ret = sys_cache_data_flush_and_invd_ranges(ranges, ARRAY_SIZE(ranges));
+	zassert_true((ret == 0) || (ret == -ENOTSUP));
+
+	ret = sys_cache_data_flush_ranges(ranges, 0);
+	zassert_true((ret == 0) || (ret == -ENOTSUP));
+}
+
 ZTEST_USER(cache_api, test_data_cache_api_user)
 {
 	int ret;
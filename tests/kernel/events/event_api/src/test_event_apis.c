@@ -29,6 +29,13 @@ static K_SEM_DEFINE(sync_sem, 0, 1);
 
 volatile static uint32_t test_events;
 
+#define NUM_BIT_WAITERS 4
+
+static struct k_thread tbit_waiters[NUM_BIT_WAITERS];
+static K_THREAD_STACK_ARRAY_DEFINE(sbit_waiters, NUM_BIT_WAITERS, STACK_SIZE);
+static K_EVENT_DEFINE(bit_event);
+static atomic_t bits_woken;
+
 static void entry_extra1(void *p1, void *p2, void *p3)
 {
 	uint32_t  events;
@@ -47,6 +54,15 @@ static void entry_extra2(void *p1, void *p2, void *p3)
 	k_event_post(&test_event, events);
 }
 
+static void entry_bit_waiter(void *p1, void *p2, void *p3)
+{
+	uint32_t  event = BIT(POINTER_TO_UINT(p1));
+
+	if (k_event_wait(&bit_event, event, false, LONG_TIMEOUT) == event) {
+		atomic_or(&bits_woken, event);
+	}
+}
+
 /**
  * Test the k_event_init() API.
  *
@@ -431,3 +447,44 @@ ZTEST(events_api, test_event_receive)
 
 	test_wake_multiple_threads();
 }
+
+/**
+ * Test waking threads waiting on single events.
+ *
+ * Each helper thread waits on a different event, so that with
+ * CONFIG_EVENTS_WAITER_INDEX they pend on separate wait queues. Posting
+ * events must only wake the threads waiting on them.
+ */
+
+ZTEST(events_api, test_event_wake_single_waiters)
+{
+	for (int i = 0; i < NUM_BIT_WAITERS; i++) {
+		(void) k_thread_create(&tbit_waiters[i], sbit_waiters[i],
+				       STACK_SIZE, entry_bit_waiter,
+				       UINT_TO_POINTER(i), NULL, NULL,
+				       K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	}
+
+	k_sleep(DELAY);
+
+	(void) k_event_post(&bit_event, BIT(2));
+	k_sleep(DELAY);
+	zassert_equal(atomic_get(&bits_woken), BIT(2));
+
+	/* Events already set do not wake again, unrelated events do not wake */
+	(void) k_event_post(&bit_event, BIT(2) | BIT(8) | BIT(24));
+	k_sleep(DELAY);
+	zassert_equal(atomic_get(&bits_woken), BIT(2));
+
+	(void) k_event_set(&bit_event, BIT(0) | BIT(3));
+	k_sleep(DELAY);
+	zassert_equal(atomic_get(&bits_woken), BIT(0) | BIT(2) | BIT(3));
+
+	(void) k_event_post(&bit_event, BIT(1));
+	k_sleep(DELAY);
+	zassert_equal(atomic_get(&bits_woken), BIT_MASK(NUM_BIT_WAITERS));
+
+	for (int i = 0; i < NUM_BIT_WAITERS; i++) {
+		zassert_ok(k_thread_join(&tbit_waiters[i], K_FOREVER));
+	}
+}
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/init.h>
+#include <zephyr/kernel/boot_profile.h>
+#include <zephyr/ztest.h>
+
+#define SLOW_INIT_MS 100
+
+static int64_t barrier_uptime;
+static bool barrier_saw_devices;
+static int timed_slow_inits;
+
+static int slow_init(const struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	k_msleep(SLOW_INIT_MS);
+
+	return 0;
+}
+
+DEVICE_DEFINE(slow_a, "slow_a", slow_init, NULL, NULL, NULL,
+	      POST_KERNEL, 50, NULL);
+DEVICE_DEFINE(slow_b, "slow_b", slow_init, NULL, NULL, NULL,
+	      POST_KERNEL, 50, NULL);
+
+static int barrier_init(void)
+{
+	barrier_uptime = k_uptime_get();
+	barrier_saw_devices = device_is_ready(DEVICE_GET(slow_a)) &&
+			      device_is_ready(DEVICE_GET(slow_b));
+
+	return 0;
+}
+
+SYS_INIT(barrier_init, POST_KERNEL, 51);
+
+ZTEST(init_parallel, test_barrier)
+{
+	/* The SYS_INIT() after the devices waits for both of them */
+	zassert_true(barrier_saw_devices);
+}
+
+ZTEST(init_parallel, test_concurrent)
+{
+	/* The two sleeping inits overlapped */
+	zassert_true(barrier_uptime < 2 * SLOW_INIT_MS,
+		     "inits took %lld ms", barrier_uptime);
+}
+
+static void count_slow_inits(const struct boot_profile_span *span, void *user_data)
+{
+	ARG_UNUSED(user_data);
+
+	if ((span->step == BOOT_PROFILE_INIT) &&
+	    (span->entry->dev == DEVICE_GET(slow_a) ||
+	     span->entry->dev == DEVICE_GET(slow_b))) {
+		zassert_true(k_cyc_to_us_floor32(span->end_cycles - span->start_cycles) >=
+			     (SLOW_INIT_MS - 1) * USEC_PER_MSEC);
+		timed_slow_inits++;
+	}
+}
+
+ZTEST(init_parallel, test_timing)
+{
+	zassert_equal(boot_profile_foreach(count_slow_inits, NULL), 0);
+	zassert_equal(timed_slow_inits, 2);
+}
+
+ZTEST_SUITE(init_parallel, NULL, NULL, NULL, NULL, NULL);
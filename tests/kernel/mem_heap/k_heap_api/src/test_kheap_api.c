@@ -6,6 +6,7 @@
 
 #include <zephyr/ztest.h>
 #include <zephyr/irq_offload.h>
+#include <zephyr/sys/heap_listener.h>
 #include "test_kheap.h"
 
 #define STACK_SIZE (512 + CONFIG_TEST_EXTRA_STACK_SIZE)
@@ -265,3 +266,93 @@ ZTEST(k_heap_api, test_k_heap_alloc_pending_null)
 
 	k_heap_free(&k_heap_test, p);
 }
+
+#ifdef CONFIG_KHEAP_CPU_CACHE
+#define CACHED_SIZE 32
+
+static size_t listener_bytes;
+
+static void cache_on_alloc(uintptr_t heap_id, void *mem, size_t bytes)
+{
+	ARG_UNUSED(heap_id);
+	ARG_UNUSED(mem);
+
+	listener_bytes += bytes;
+}
+
+static void cache_on_free(uintptr_t heap_id, void *mem, size_t bytes)
+{
+	ARG_UNUSED(heap_id);
+	ARG_UNUSED(mem);
+
+	listener_bytes -= bytes;
+}
+
+HEAP_LISTENER_ALLOC_DEFINE(cache_alloc_listener,
+			   HEAP_ID_FROM_POINTER(&k_heap_test.heap),
+			   cache_on_alloc);
+HEAP_LISTENER_FREE_DEFINE(cache_free_listener,
+			  HEAP_ID_FROM_POINTER(&k_heap_test.heap),
+			  cache_on_free);
+
+/**
+ * @brief Test the per-CPU cache of freed heap blocks
+ *
+ * @details A small block freed on a CPU is handed out again to the next
+ * allocation of the same size on that CPU, blocks held by the caches
+ * remain available to large allocations, and heap listeners see every
+ * allocation and free.
+ *
+ * @ingroup kernel_kheap_api_tests
+ *
+ * @see k_heap_alloc(), k_heap_free()
+ */
+ZTEST(k_heap_api, test_k_heap_cpu_cache)
+{
+	void *small[HEAP_SIZE / 64];
+	unsigned int key;
+	char *p, *q;
+	int n = 0;
+
+	heap_listener_register(&cache_alloc_listener);
+	heap_listener_register(&cache_free_listener);
+	listener_bytes = 0;
+
+	/* Don't migrate between the free and the allocation */
+	key = irq_lock();
+	p = k_heap_alloc(&k_heap_test, CACHED_SIZE, K_NO_WAIT);
+	zassert_not_null(p, "k_heap_alloc operation failed");
+	k_heap_free(&k_heap_test, p);
+	q = k_heap_alloc(&k_heap_test, CACHED_SIZE, K_NO_WAIT);
+	irq_unlock(key);
+
+	zassert_equal(p, q, "freed block was not reused from the cache");
+	k_heap_free(&k_heap_test, q);
+	zassert_equal(listener_bytes, 0, "listeners missed events");
+
+	/* Fill the heap with small blocks, then free them all: they must
+	 * still be usable by a large allocation.
+	 */
+	while (n < ARRAY_SIZE(small)) {
+		small[n] = k_heap_alloc(&k_heap_test, CACHED_SIZE, K_NO_WAIT);
+		if (small[n] == NULL) {
+			break;
+		}
+		n++;
+	}
+	zassert_true(n > 0, "k_heap_alloc operation failed");
+
+	for (int i = 0; i < n; i++) {
+		k_heap_free(&k_heap_test, small[i]);
+	}
+	zassert_equal(listener_bytes, 0, "listeners missed events");
+
+	p = k_heap_alloc(&k_heap_test, ALLOC_SIZE_2, K_NO_WAIT);
+	zassert_not_null(p, "cached blocks were not returned to the heap");
+	k_heap_free(&k_heap_test, p);
+	zassert_equal(listener_bytes, 0, "listeners missed events");
+
+	heap_listener_unregister(&cache_alloc_listener);
+	heap_listener_unregister(&cache_free_listener);
+}
+#endif /* CONFIG_KHEAP_CPU_CACHE */
@@ -104,6 +104,9 @@ static void print_paging_stats(struct k_mem_paging_stats_t *stats, const char *s
 #ifndef CONFIG_DEMAND_PAGING_ALLOW_IRQ
 	printk("    - in ISR: %lu\n", stats->pagefaults.in_isr);
 #endif
+#ifdef CONFIG_DEMAND_PAGING_PREFETCH
+	printk("    - Prefetched: %lu\n", stats->pagefaults.prefetched);
+#endif
 
 	printk("* Eviction (%s):\n", scope);
 	printk("    - Total pages evicted: %lu\n",
@@ -287,6 +290,41 @@ ZTEST(demand_paging_api, test_k_mem_unpin)
 	test_k_mem_page_out();
 }
 
+ZTEST(demand_paging_api, test_k_mem_prefetch_hint)
+{
+	Z_TEST_SKIP_IFNDEF(CONFIG_DEMAND_PAGING_PREFETCH);
+
+#ifdef CONFIG_DEMAND_PAGING_PREFETCH
+	unsigned long faults;
+	int key, ret;
+
+	ret = k_mem_paging_prefetch_hint(arena, HALF_BYTES, true);
+	zassert_equal(ret, 0, "k_mem_paging_prefetch_hint failed with %d", ret);
+
+	key = irq_lock();
+
+	ret = k_mem_page_out(arena, HALF_BYTES);
+	zassert_equal(ret, 0, "k_mem_page_out failed with %d", ret);
+
+	/* Only the pages not prefetched by an earlier fault are faulted in */
+	faults = z_num_pagefaults_get();
+	for (size_t i = 0; i < HALF_BYTES; i++) {
+		arena[i] = nums[i % 10];
+	}
+	faults = z_num_pagefaults_get() - faults;
+	irq_unlock(key);
+
+	zassert_true(faults < HALF_PAGES,
+		     "%lu page faults when fewer than %lu expected",
+		     faults, HALF_PAGES);
+
+	ret = k_mem_paging_prefetch_hint(arena, HALF_BYTES, false);
+	zassert_equal(ret, 0, "clearing the hint failed with %d", ret);
+	ret = k_mem_paging_prefetch_hint(arena, HALF_BYTES, false);
+	zassert_equal(ret, -ENOENT, "hint cleared twice");
+#endif /* CONFIG_DEMAND_PAGING_PREFETCH */
+}
+
 /* Show that even if we map enough anonymous memory to fill the backing
  * store, we can still handle pagefaults.
  * This eats up memory so should be last in the suite.
@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/kernel/syscall_batch.h>
+#include <zephyr/ztest.h>
+
+K_SEM_DEFINE(batch_sem, 0, 2);
+K_MSGQ_DEFINE(batch_msgq, sizeof(uint32_t), 1, 4);
+static struct k_poll_signal batch_signal;
+
+ZTEST_USER(syscall_batch, test_batch)
+{
+	uint32_t msg = 0x12345678;
+	uint32_t out;
+	unsigned int signaled;
+	int result;
+	struct k_syscall_batch_entry entries[] = {
+		{ .op = K_SYSCALL_BATCH_SEM_GIVE, .obj = &batch_sem },
+		{ .op = K_SYSCALL_BATCH_SEM_GIVE, .obj = &batch_sem },
+		{ .op = K_SYSCALL_BATCH_MSGQ_PUT, .obj = &batch_msgq, .data = &msg },
+		/* The message queue is full, the batch goes on */
+		{ .op = K_SYSCALL_BATCH_MSGQ_PUT, .obj = &batch_msgq, .data = &msg },
+		{ .op = K_SYSCALL_BATCH_POLL_SIGNAL_RAISE, .obj = &batch_signal,
+		  .signal_result = 42 },
+	};
+
+	zassert_equal(k_syscall_batch(entries, ARRAY_SIZE(entries)), 1);
+	zassert_equal(entries[2].ret, 0);
+	zassert_equal(entries[3].ret, -ENOMSG);
+	zassert_equal(entries[4].ret, 0);
+
+	zassert_equal(k_sem_count_get(&batch_sem), 2);
+	zassert_ok(k_msgq_get(&batch_msgq, &out, K_NO_WAIT));
+	zassert_equal(out, msg);
+	k_poll_signal_check(&batch_signal, &signaled, &result);
+	zassert_true(signaled);
+	zassert_equal(result, 42);
+}
+
+ZTEST_USER(syscall_batch, test_bad_op)
+{
+	struct k_syscall_batch_entry entries[] = {
+		{ .op = K_SYSCALL_BATCH_SEM_GIVE, .obj = &batch_sem },
+		{ .op = 0xff, .obj = &batch_sem },
+	};
+
+	zassert_equal(k_syscall_batch(entries, ARRAY_SIZE(entries)), -EINVAL);
+}
+
+static void *syscall_batch_setup(void)
+{
+	k_poll_signal_init(&batch_signal);
+	k_thread_access_grant(k_current_get(), &batch_sem, &batch_msgq,
+			      &batch_signal);
+
+	return NULL;
+}
+
+static void syscall_batch_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	k_sem_reset(&batch_sem);
+	k_msgq_purge(&batch_msgq);
+	k_poll_signal_reset(&batch_signal);
+}
+
+ZTEST_SUITE(syscall_batch, NULL, syscall_batch_setup, syscall_batch_before,
+	    NULL, NULL);
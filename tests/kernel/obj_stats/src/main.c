@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/stats/stats.h>
+
+#define STACK_SIZE (512 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define WAIT_MS    50
+
+K_SEM_DEFINE(sem, 0, 1);
+K_MUTEX_DEFINE(mutex);
+K_MSGQ_DEFINE(msgq, sizeof(uint32_t), 1, 4);
+
+static K_THREAD_STACK_DEFINE(helper_stack, STACK_SIZE);
+static struct k_thread helper_thread;
+
+static void sem_giver(void *p1, void *p2, void *p3)
+{
+	k_msleep(WAIT_MS);
+	k_sem_give(&sem);
+}
+
+static void mutex_holder(void *p1, void *p2, void *p3)
+{
+	k_mutex_lock(&mutex, K_FOREVER);
+	k_msleep(WAIT_MS);
+	k_mutex_unlock(&mutex);
+}
+
+static struct k_thread *start_helper(k_thread_entry_t entry)
+{
+	return k_thread_create(&helper_thread, helper_stack, STACK_SIZE,
+			       entry, NULL, NULL, NULL,
+			       K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+}
+
+ZTEST(obj_stats, test_sem)
+{
+	/* Unavailable without waiting: contended, no pend */
+	zassert_equal(k_sem_take(&sem, K_NO_WAIT), -EBUSY);
+	zassert_equal(sem.stats.counters.contentions, 1);
+	zassert_equal(sem.stats.counters.pends, 0);
+
+	start_helper(sem_giver);
+	zassert_ok(k_sem_take(&sem, K_FOREVER));
+	k_thread_join(&helper_thread, K_FOREVER);
+
+	zassert_equal(sem.stats.counters.contentions, 2);
+	zassert_equal(sem.stats.counters.pends, 1);
+	zassert_true(sem.stats.counters.max_wait_us >= (WAIT_MS - 1) * USEC_PER_MSEC);
+	zassert_equal(sem.stats.counters.wait_us, sem.stats.counters.max_wait_us);
+
+	/* The fast path is not accounted */
+	k_sem_give(&sem);
+	zassert_ok(k_sem_take(&sem, K_NO_WAIT));
+	zassert_equal(sem.stats.counters.contentions, 2);
+}
+
+ZTEST(obj_stats, test_mutex)
+{
+	start_helper(mutex_holder);
+	k_msleep(1);
+
+	zassert_ok(k_mutex_lock(&mutex, K_FOREVER));
+	k_mutex_unlock(&mutex);
+	k_thread_join(&helper_thread, K_FOREVER);
+
+	zassert_equal(mutex.stats.counters.contentions, 1);
+	zassert_equal(mutex.stats.counters.pends, 1);
+	zassert_true(mutex.stats.counters.wait_us > 0);
+}
+
+ZTEST(obj_stats, test_msgq_timeout)
+{
+	uint32_t data;
+
+	/* A pend ending in a timeout is accounted as well */
+	zassert_equal(k_msgq_get(&msgq, &data, K_MSEC(WAIT_MS)), -EAGAIN);
+	zassert_equal(msgq.stats.counters.contentions, 1);
+	zassert_equal(msgq.stats.counters.pends, 1);
+}
+
+static void check_group(const char *name, const STATS_SECT_DECL(k_obj) *counters,
+			void *user_data)
+{
+	int *found = user_data;
+
+	if (strcmp(name, "sem") == 0) {
+		zassert_equal(counters->contentions, sem.stats.counters.contentions);
+		(*found)++;
+	}
+}
+
+ZTEST(obj_stats, test_register)
+{
+	int found = 0;
+
+	zassert_ok(K_OBJ_STATS_REGISTER(&sem, "sem"));
+	zassert_not_null(stats_group_find("sem"));
+
+	k_obj_stats_foreach(check_group, &found);
+	zassert_equal(found, 1);
+}
+
+ZTEST_SUITE(obj_stats, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @brief Tests for in place access to the pipe buffer
+ * @ingroup kernel_pipe_tests
+ * @{
+ */
+
+#include <zephyr/ztest.h>
+
+#define CLAIM_PIPE_SIZE 8
+#define CLAIM_STACK_SIZE (512 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+K_PIPE_DEFINE(claim_pipe, CLAIM_PIPE_SIZE, 4);
+static struct k_pipe claim_bufferless;
+
+static K_THREAD_STACK_DEFINE(claim_stack, CLAIM_STACK_SIZE);
+static struct k_thread claim_thread;
+static unsigned char claim_rx[CLAIM_PIPE_SIZE];
+
+static void claim_reader(void *p1, void *p2, void *p3)
+{
+	size_t bytes_read;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	zassert_ok(k_pipe_get(&claim_pipe, claim_rx, (size_t)p1, &bytes_read,
+			      (size_t)p1, K_FOREVER));
+}
+
+static void claim_pipe_reset(void)
+{
+	k_pipe_flush(&claim_pipe);
+}
+
+/**
+ * @brief Claims on a bufferless pipe return no space
+ */
+ZTEST(pipe_api, test_pipe_claim_no_buffer)
+{
+	unsigned char *data;
+
+	zassert_equal(k_pipe_put_claim(&claim_bufferless, &data, 4), 0);
+	zassert_equal(k_pipe_get_claim(&claim_bufferless, &data, 4), 0);
+}
+
+/**
+ * @brief Data committed in place is read back in place and by k_pipe_get()
+ *
+ * Claims never extend beyond the end of the buffer, so wrapping data needs
+ * two claims.
+ */
+ZTEST(pipe_api, test_pipe_claim_commit)
+{
+	unsigned char *data;
+	unsigned char rx[CLAIM_PIPE_SIZE];
+	size_t bytes;
+
+	claim_pipe_reset();
+
+	/* Move the indices away from zero */
+	zassert_equal(k_pipe_put_claim(&claim_pipe, &data, 6), 6);
+	zassert_equal(k_pipe_write_avail(&claim_pipe), 2);
+	zassert_equal(k_pipe_read_avail(&claim_pipe), 0);
+	memset(data, 'x', 6);
+	zassert_ok(k_pipe_put_commit(&claim_pipe, 6));
+	zassert_equal(k_pipe_get_claim(&claim_pipe, &data, 6), 6);
+	zassert_ok(k_pipe_get_finish(&claim_pipe, 6));
+
+	/* A claim stops at the end of the buffer, the next one wraps */
+	zassert_equal(k_pipe_put_claim(&claim_pipe, &data, 5), 2);
+	memcpy(data, "ab", 2);
+	zassert_equal(k_pipe_put_claim(&claim_pipe, &data, 3), 3);
+	memcpy(data, "cde", 3);
+	zassert_equal(k_pipe_put_commit(&claim_pipe, 6), -EINVAL);
+	zassert_ok(k_pipe_put_commit(&claim_pipe, 5));
+	zassert_equal(k_pipe_read_avail(&claim_pipe), 5);
+
+	/* Finishing part of a claim releases only that part */
+	zassert_equal(k_pipe_get_claim(&claim_pipe, &data, CLAIM_PIPE_SIZE), 2);
+	zassert_mem_equal(data, "ab", 2);
+	zassert_ok(k_pipe_get_finish(&claim_pipe, 1));
+
+	zassert_ok(k_pipe_get(&claim_pipe, rx, sizeof(rx), &bytes, 1,
+			      K_NO_WAIT));
+	zassert_equal(bytes, 4);
+	zassert_mem_equal(rx, "bcde", 4);
+}
+
+/**
+ * @brief Claimed space is not used by k_pipe_put()
+ */
+ZTEST(pipe_api, test_pipe_claim_put_excluded)
+{
+	unsigned char *data;
+	unsigned char rx[CLAIM_PIPE_SIZE];
+	size_t bytes;
+
+	claim_pipe_reset();
+
+	zassert_equal(k_pipe_put_claim(&claim_pipe, &data, 3), 3);
+	memcpy(data, "abc", 3);
+
+	zassert_equal(k_pipe_put(&claim_pipe, (void *)"def", 3, &bytes, 1, K_NO_WAIT),
+		      -EIO);
+
+	zassert_ok(k_pipe_put_commit(&claim_pipe, 3));
+	zassert_ok(k_pipe_put(&claim_pipe, (void *)"def", 3, &bytes, 3, K_NO_WAIT));
+
+	zassert_ok(k_pipe_get(&claim_pipe, rx, sizeof(rx), &bytes, 6,
+			      K_NO_WAIT));
+	zassert_mem_equal(rx, "abcdef", 6);
+}
+
+/**
+ * @brief Committing data wakes up a waiting reader
+ */
+ZTEST(pipe_api_1cpu, test_pipe_claim_wake_reader)
+{
+	unsigned char *data;
+	k_tid_t tid;
+
+	claim_pipe_reset();
+
+	tid = k_thread_create(&claim_thread, claim_stack, CLAIM_STACK_SIZE,
+			      claim_reader, (void *)4, NULL, NULL,
+			      K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+
+	/* Let the reader pend on the empty pipe */
+	k_sleep(K_MSEC(10));
+
+	zassert_equal(k_pipe_put_claim(&claim_pipe, &data, 4), 4);
+	memcpy(data, "wxyz", 4);
+	zassert_ok(k_pipe_put_commit(&claim_pipe, 4));
+
+	zassert_ok(k_thread_join(tid, K_MSEC(100)));
+	zassert_mem_equal(claim_rx, "wxyz", 4);
+	zassert_equal(k_pipe_read_avail(&claim_pipe), 0);
+}
+
+/**
+ * @brief Data put while a get claim is outstanding does not overtake it
+ *
+ * A reader pending behind the claim gets the unfinished claimed bytes and
+ * the older buffered data before the newly put data.
+ */
+ZTEST(pipe_api_1cpu, test_pipe_claim_fifo_order)
+{
+	unsigned char *data;
+	size_t bytes;
+	k_tid_t tid;
+
+	claim_pipe_reset();
+
+	zassert_ok(k_pipe_put(&claim_pipe, (void *)"abcd", 4, &bytes, 4, K_NO_WAIT));
+	zassert_equal(k_pipe_get_claim(&claim_pipe, &data, 2), 2);
+	zassert_mem_equal(data, "ab", 2);
+
+	tid = k_thread_create(&claim_thread, claim_stack, CLAIM_STACK_SIZE,
+			      claim_reader, (void *)4, NULL, NULL,
+			      K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+
+	/* Let the reader pend behind the claim */
+	k_sleep(K_MSEC(10));
+
+	zassert_ok(k_pipe_put(&claim_pipe, (void *)"ef", 2, &bytes, 2, K_NO_WAIT));
+	zassert_equal(k_pipe_read_avail(&claim_pipe), 4);
+
+	/* Hand back "b" */
+	zassert_ok(k_pipe_get_finish(&claim_pipe, 1));
+
+	zassert_ok(k_thread_join(tid, K_MSEC(100)));
+	zassert_mem_equal(claim_rx, "bcde", 4);
+
+	zassert_ok(k_pipe_get(&claim_pipe, claim_rx, sizeof(claim_rx), &bytes, 1,
+			      K_NO_WAIT));
+	zassert_equal(bytes, 1);
+	zassert_mem_equal(claim_rx, "f", 1);
+}
+
+/**
+ * @}
+ */
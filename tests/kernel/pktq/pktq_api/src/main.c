@@ -0,0 +1,192 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @defgroup kernel_packet_queue_tests Packet Queue
+ * @ingroup all_tests
+ * @{
+ * @}
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/kernel/pktq.h>
+
+#define PKTQ_SIZE 64
+#define STACK_SIZE (512 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+K_PKTQ_DEFINE(pktq, PKTQ_SIZE);
+
+static K_THREAD_STACK_DEFINE(tstack, STACK_SIZE);
+static struct k_thread tdata;
+
+static const char records[][12] = { "a", "bcdef", "ghijklmnopq" };
+
+static void pktq_drain(void)
+{
+	const void *data;
+	size_t len;
+
+	while ((data = k_pktq_claim(&pktq, &len, K_NO_WAIT)) != NULL) {
+		k_pktq_free(&pktq, data);
+	}
+}
+
+static void *pktq_api_setup(void)
+{
+	k_thread_access_grant(k_current_get(), &pktq, &tdata, &tstack);
+
+	return NULL;
+}
+
+static void pktq_api_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	pktq_drain();
+}
+
+/**
+ * @brief Packets of different lengths are copied in and out in order
+ */
+ZTEST_USER(pktq_api, test_pktq_put_get)
+{
+	char rx[16];
+	int ret;
+
+	for (size_t i = 0; i < ARRAY_SIZE(records); i++) {
+		zassert_ok(k_pktq_put(&pktq, records[i], strlen(records[i]),
+				      K_NO_WAIT));
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(records); i++) {
+		ret = k_pktq_get(&pktq, rx, sizeof(rx), K_NO_WAIT);
+		zassert_equal(ret, strlen(records[i]), "got %d", ret);
+		zassert_mem_equal(rx, records[i], ret);
+	}
+
+	zassert_equal(k_pktq_get(&pktq, rx, sizeof(rx), K_NO_WAIT), -ENOMSG);
+	zassert_equal(k_pktq_get(&pktq, rx, sizeof(rx), K_MSEC(10)), -EAGAIN);
+}
+
+/**
+ * @brief A full packet queue rejects packets, oversized ones never fit
+ */
+ZTEST_USER(pktq_api, test_pktq_full)
+{
+	static const uint8_t data[PKTQ_SIZE] = { 0 };
+	int count = 0;
+
+	zassert_equal(k_pktq_put(&pktq, data, PKTQ_SIZE, K_NO_WAIT), -EINVAL);
+
+	while (k_pktq_put(&pktq, data, 8, K_NO_WAIT) == 0) {
+		count++;
+	}
+
+	/* 4 byte header and 8 bytes of data per packet */
+	zassert_equal(count, PKTQ_SIZE / 12, "queued %d packets", count);
+	zassert_equal(k_pktq_put(&pktq, data, 8, K_MSEC(10)), -EAGAIN);
+}
+
+/**
+ * @brief A packet larger than the read buffer is kept in the queue
+ */
+ZTEST_USER(pktq_api, test_pktq_get_too_small)
+{
+	char rx[16];
+
+	zassert_ok(k_pktq_put(&pktq, records[2], 11, K_NO_WAIT));
+
+	zassert_equal(k_pktq_get(&pktq, rx, 4, K_NO_WAIT), -EMSGSIZE);
+	zassert_equal(k_pktq_get(&pktq, rx, sizeof(rx), K_NO_WAIT), 11);
+	zassert_mem_equal(rx, records[2], 11);
+}
+
+/**
+ * @brief Packets are claimed in allocation order, whatever the commit order
+ */
+ZTEST(pktq_api, test_pktq_zero_copy)
+{
+	const void *data;
+	char *first;
+	char *second;
+	size_t len;
+
+	first = k_pktq_alloc(&pktq, 5, K_NO_WAIT);
+	second = k_pktq_alloc(&pktq, 3, K_NO_WAIT);
+	zassert_not_null(first);
+	zassert_not_null(second);
+	zassert_equal((uintptr_t)first % sizeof(uint32_t), 0);
+
+	memcpy(second, "xyz", 3);
+	k_pktq_commit(&pktq, second);
+	zassert_is_null(k_pktq_claim(&pktq, &len, K_NO_WAIT));
+
+	memcpy(first, "uvwxy", 5);
+	k_pktq_commit(&pktq, first);
+
+	data = k_pktq_claim(&pktq, &len, K_NO_WAIT);
+	zassert_equal(data, first);
+	zassert_equal(len, 5);
+	k_pktq_free(&pktq, data);
+
+	data = k_pktq_claim(&pktq, &len, K_NO_WAIT);
+	zassert_equal(data, second);
+	zassert_equal(len, 3);
+	zassert_mem_equal(data, "xyz", 3);
+	k_pktq_free(&pktq, data);
+}
+
+static void tpktq_writer(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	k_sleep(K_MSEC(10));
+	zassert_ok(k_pktq_put(&pktq, records[1], 5, K_NO_WAIT));
+}
+
+/**
+ * @brief A waiting reader is woken up by a committed packet
+ */
+ZTEST_USER(pktq_api, test_pktq_get_wait)
+{
+	char rx[16];
+	k_tid_t tid;
+
+	tid = k_thread_create(&tdata, tstack, STACK_SIZE, tpktq_writer,
+			      NULL, NULL, NULL, K_PRIO_PREEMPT(0),
+			      K_USER | K_INHERIT_PERMS, K_NO_WAIT);
+
+	zassert_equal(k_pktq_get(&pktq, rx, sizeof(rx), K_FOREVER), 5);
+	zassert_mem_equal(rx, records[1], 5);
+
+	k_thread_join(tid, K_FOREVER);
+}
+
+/**
+ * @brief k_poll() reports packets in a packet queue
+ */
+ZTEST(pktq_api, test_pktq_poll)
+{
+	struct k_poll_event event = K_POLL_EVENT_INITIALIZER(
+		K_POLL_TYPE_PKTQ_DATA_AVAILABLE, K_POLL_MODE_NOTIFY_ONLY,
+		&pktq);
+	k_tid_t tid;
+
+	zassert_equal(k_poll(&event, 1, K_NO_WAIT), -EAGAIN);
+
+	tid = k_thread_create(&tdata, tstack, STACK_SIZE, tpktq_writer,
+			      NULL, NULL, NULL, K_PRIO_PREEMPT(0), 0,
+			      K_NO_WAIT);
+
+	zassert_ok(k_poll(&event, 1, K_FOREVER));
+	zassert_equal(event.state, K_POLL_STATE_PKTQ_DATA_AVAILABLE);
+
+	k_thread_join(tid, K_FOREVER);
+}
+
+ZTEST_SUITE(pktq_api, NULL, pktq_api_setup, pktq_api_before, NULL, NULL);
@@ -836,3 +836,102 @@ ZTEST(poll_api_1cpu, test_detect_is_polling)
 
 	k_thread_abort(tid);
 }
+
+static struct k_sem set_sems[3];
+static struct k_poll_signal set_signal;
+
+static void poll_set_raise(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	k_sleep(K_MSEC(50));
+	k_poll_signal_raise(&set_signal, SIGNAL_RESULT);
+}
+
+/**
+ * @brief Test persistent poll event sets
+ *
+ * @details Register semaphores and a signal in a set, and check that each
+ * wait only returns the triggered events, in order, and that events whose
+ * condition is still met are returned again.
+ *
+ * @ingroup kernel_poll_tests
+ *
+ * @see k_poll_set_init(), k_poll_set_wait(), k_poll_set_cleanup()
+ */
+ZTEST(poll_api_1cpu, test_poll_set)
+{
+	struct k_poll_event events[ARRAY_SIZE(set_sems) + 1];
+	struct k_poll_event *ready[ARRAY_SIZE(events)];
+	struct k_poll_set set;
+	int ret;
+
+	for (int i = 0; i < ARRAY_SIZE(set_sems); i++) {
+		k_sem_init(&set_sems[i], 0, 1);
+		k_poll_event_init(&events[i], K_POLL_TYPE_SEM_AVAILABLE,
+				  K_POLL_MODE_NOTIFY_ONLY, &set_sems[i]);
+	}
+	k_poll_signal_init(&set_signal);
+	k_poll_event_init(&events[3], K_POLL_TYPE_SIGNAL,
+			  K_POLL_MODE_NOTIFY_ONLY, &set_signal);
+
+	/* Already available at registration time */
+	k_sem_give(&set_sems[0]);
+
+	k_poll_set_init(&set, events, ARRAY_SIZE(events));
+
+	ret = k_poll_set_wait(&set, ready, ARRAY_SIZE(ready), K_NO_WAIT);
+	zassert_equal(ret, 1, "wrong number of ready events %d", ret);
+	zassert_equal_ptr(ready[0], &events[0], "wrong ready event");
+	zassert_equal(events[0].state, K_POLL_STATE_SEM_AVAILABLE);
+	zassert_ok(k_sem_take(&set_sems[0], K_NO_WAIT));
+
+	/* Nothing left ready once the semaphore is taken */
+	ret = k_poll_set_wait(&set, ready, ARRAY_SIZE(ready), K_MSEC(10));
+	zassert_equal(ret, -EAGAIN, "unexpected ready events %d", ret);
+
+	/* Returned in the order they triggered, one at a time */
+	k_sem_give(&set_sems[2]);
+	k_sem_give(&set_sems[1]);
+
+	ret = k_poll_set_wait(&set, ready, 1, K_NO_WAIT);
+	zassert_equal(ret, 1, "wrong number of ready events %d", ret);
+	zassert_equal_ptr(ready[0], &events[2], "wrong ready event");
+
+	/* Semaphore 2 not taken: it is ready again, after semaphore 1 */
+	ret = k_poll_set_wait(&set, ready, ARRAY_SIZE(ready), K_NO_WAIT);
+	zassert_equal(ret, 2, "wrong number of ready events %d", ret);
+	zassert_equal_ptr(ready[0], &events[1], "wrong ready event");
+	zassert_equal_ptr(ready[1], &events[2], "wrong ready event");
+	zassert_ok(k_sem_take(&set_sems[1], K_NO_WAIT));
+	zassert_ok(k_sem_take(&set_sems[2], K_NO_WAIT));
+
+	/* Blocking wait, woken up by another thread */
+	k_thread_create(&test_thread, test_stack,
+			K_THREAD_STACK_SIZEOF(test_stack), poll_set_raise,
+			NULL, NULL, NULL, K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+
+	ret = k_poll_set_wait(&set, ready, ARRAY_SIZE(ready), K_FOREVER);
+	zassert_equal(ret, 1, "wrong number of ready events %d", ret);
+	zassert_equal_ptr(ready[0], &events[3], "wrong ready event");
+	zassert_equal(events[3].state, K_POLL_STATE_SIGNALED);
+	zassert_equal(set_signal.result, SIGNAL_RESULT);
+
+	k_thread_join(&test_thread, K_FOREVER);
+
+	/* The signal stays raised, so it is returned again */
+	ret = k_poll_set_wait(&set, ready, ARRAY_SIZE(ready), K_NO_WAIT);
+	zassert_equal(ret, 1, "wrong number of ready events %d", ret);
+	zassert_equal_ptr(ready[0], &events[3], "wrong ready event");
+
+	k_poll_set_cleanup(&set);
+
+	for (int i = 0; i < ARRAY_SIZE(set_sems); i++) {
+		zassert_true(sys_dlist_is_empty(&set_sems[i].poll_events),
+			     "event still registered");
+	}
+	zassert_true(sys_dlist_is_empty(&set_signal.poll_events),
+		     "event still registered");
+}
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#ifdef CONFIG_SCHED_CBS
+
+#define CBS_STACK_SIZE (512 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define CBS_PERIOD_US 200000
+#define CBS_BUDGET_US (CBS_PERIOD_US / 10)
+
+static struct k_thread cbs_threads[2];
+static K_THREAD_STACK_ARRAY_DEFINE(cbs_stacks, 2, CBS_STACK_SIZE);
+
+static void cbs_spinner(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	/* k_busy_wait() lets the simulated time of the posix boards advance */
+	while (true) {
+		k_busy_wait(100);
+	}
+}
+
+static k_tid_t cbs_create(int i, k_timeout_t delay)
+{
+	return k_thread_create(&cbs_threads[i], cbs_stacks[i], CBS_STACK_SIZE,
+			       cbs_spinner, NULL, NULL, NULL,
+			       K_LOWEST_APPLICATION_THREAD_PRIO, 0, delay);
+}
+
+/**
+ * @brief Reservations overcommitting the CPU are rejected
+ *
+ * @ingroup kernel_sched_tests
+ */
+ZTEST(suite_cbs, test_cbs_admission)
+{
+	uint32_t half = CONFIG_SCHED_CBS_MAX_UTILIZATION * arch_num_cpus() *
+			(CBS_PERIOD_US / 200);
+	k_tid_t a = cbs_create(0, K_FOREVER);
+	k_tid_t b = cbs_create(1, K_FOREVER);
+
+	zassert_equal(k_thread_cbs_set(a, CBS_PERIOD_US + 1, CBS_PERIOD_US),
+		      -EINVAL);
+	zassert_ok(k_thread_cbs_set(a, half + 1, CBS_PERIOD_US));
+	zassert_equal(k_thread_cbs_set(b, half, CBS_PERIOD_US), -ENOSPC);
+
+	/* Changing a reservation replaces it */
+	zassert_ok(k_thread_cbs_set(a, half / 2, CBS_PERIOD_US));
+	zassert_ok(k_thread_cbs_set(b, half, CBS_PERIOD_US));
+	zassert_equal(k_thread_cbs_set(b, half + half / 2 + 1, CBS_PERIOD_US),
+		      -ENOSPC);
+
+	/* Aborting a thread releases its bandwidth */
+	k_thread_abort(a);
+	zassert_ok(k_thread_cbs_set(b, half + half / 2 + 1, CBS_PERIOD_US));
+
+	zassert_ok(k_thread_cbs_set(b, 0, 0));
+	k_thread_abort(b);
+}
+
+/**
+ * @brief A thread that never blocks only gets its budget
+ *
+ * @ingroup kernel_sched_tests
+ */
+ZTEST(suite_cbs, test_cbs_budget)
+{
+	k_thread_runtime_stats_t stats;
+	uint32_t start;
+	uint64_t used;
+	uint64_t elapsed;
+	k_tid_t tid = cbs_create(0, K_FOREVER);
+
+	zassert_ok(k_thread_cbs_set(tid, CBS_BUDGET_US, CBS_PERIOD_US));
+
+	start = k_cycle_get_32();
+	k_thread_start(tid);
+	k_sleep(K_USEC(5 * CBS_PERIOD_US));
+
+	zassert_ok(k_thread_runtime_stats_get(tid, &stats));
+	used = stats.execution_cycles;
+	elapsed = k_cycle_get_32() - start;
+	k_thread_abort(tid);
+
+	/* 10% budget, with a tick of overrun per period at most */
+	zassert_true(used >= elapsed / 20, "used %llu of %llu cycles",
+		     used, elapsed);
+	zassert_true(used <= elapsed / 4, "used %llu of %llu cycles",
+		     used, elapsed);
+}
+
+ZTEST_SUITE(suite_cbs, NULL, NULL, NULL, NULL, NULL);
+
+#endif /* CONFIG_SCHED_CBS */
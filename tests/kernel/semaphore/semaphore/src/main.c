@@ -787,6 +787,34 @@ ZTEST_USER(semaphore, test_k_sem_correct_count_limit)
 	}
 }
 
+/**
+ * @brief Test giving a semaphore several times at once
+ *
+ * @details
+ * - Verify k_sem_give_n() adds to the count when nobody waits.
+ * - Verify the count is still capped at the semaphore's limit.
+ * @ingroup kernel_semaphore_tests
+ * @see k_sem_give_n()
+ */
+ZTEST_USER(semaphore, test_k_sem_give_n_count_limit)
+{
+	k_sem_reset(&simple_sem);
+
+	k_sem_give_n(&simple_sem, 0);
+	expect_k_sem_count_get_nomsg(&simple_sem, 0U);
+
+	k_sem_give_n(&simple_sem, 3);
+	expect_k_sem_count_get_nomsg(&simple_sem, 3U);
+
+	k_sem_give_n(&simple_sem, SEM_MAX_VAL);
+	expect_k_sem_count_get_nomsg(&simple_sem, SEM_MAX_VAL);
+
+	k_sem_give_n(&simple_sem, UINT_MAX);
+	expect_k_sem_count_get_nomsg(&simple_sem, SEM_MAX_VAL);
+
+	k_sem_reset(&simple_sem);
+}
+
 /**
  * @brief Test semaphore give and take and its count from ISR
  * @see k_sem_give()
@@ -873,6 +901,54 @@ ZTEST(semaphore, test_sem_multiple_threads_wait)
 	}
 }
 
+/**
+ * @brief Test waking several waiting threads with one give
+ *
+ * @details
+ * - Let TOTAL_THREADS_WAITING threads pend on a semaphore.
+ * - Give it TOTAL_THREADS_WAITING + 2 times with k_sem_give_n().
+ * - Verify every thread got the semaphore and the count holds the
+ *   remaining two.
+ * @ingroup kernel_semaphore_tests
+ * @see k_sem_give_n()
+ */
+ZTEST(semaphore, test_sem_give_n_multiple_threads_wait)
+{
+	k_sem_reset(&simple_sem);
+	k_sem_reset(&multiple_thread_sem);
+
+	for (int i = 0; i < TOTAL_THREADS_WAITING; i++) {
+		k_thread_create(&multiple_tid[i],
+				multiple_stack[i], STACK_SIZE,
+				sem_multiple_threads_wait_helper,
+				NULL, NULL, NULL,
+				K_PRIO_PREEMPT(1),
+				K_USER | K_INHERIT_PERMS, K_NO_WAIT);
+	}
+
+	/* giving time for the other threads to execute  */
+	k_sleep(K_MSEC(500));
+
+	k_sem_give_n(&multiple_thread_sem, TOTAL_THREADS_WAITING + 2);
+
+	/* giving time for the other threads to execute  */
+	k_sleep(K_MSEC(500));
+
+	for (int i = 0; i < TOTAL_THREADS_WAITING; i++) {
+		expect_k_sem_take(&simple_sem, K_FOREVER, 0,
+			"Some of the threads did not get multiple_thread_sem: %d != %d");
+	}
+
+	expect_k_sem_count_get_nomsg(&simple_sem, 0U);
+	expect_k_sem_count_get_nomsg(&multiple_thread_sem, 2U);
+
+	for (int i = 0; i < TOTAL_THREADS_WAITING; i++) {
+		k_thread_join(&multiple_tid[i], K_FOREVER);
+	}
+
+	k_sem_reset(&multiple_thread_sem);
+}
+
 /**
  * @brief Test semaphore timeout period
  * @ingroup kernel_semaphore_tests
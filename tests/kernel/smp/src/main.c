@@ -572,6 +572,85 @@ ZTEST(smp, test_wakeup_threads)
 	cleanup_resources();
 }
 
+#if defined(CONFIG_SCHED_CPU_RUNQ) && defined(CONFIG_SCHED_CPU_MASK)
+static K_SEM_DEFINE(steal_sem, 0, MAX_NUM_THREADS);
+static volatile int steal_cpu_id[MAX_NUM_THREADS];
+
+static void thread_steal_entry(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+	int thread_num = POINTER_TO_INT(p1);
+
+	tinfo[thread_num].cpu_id = curr_cpu();
+
+	k_sem_take(&steal_sem, K_FOREVER);
+
+	/* Woken up on the ready queue of CPU 0, keep this CPU busy so
+	 * that the other threads have to be stolen by its idle peers
+	 */
+	steal_cpu_id[thread_num] = curr_cpu();
+	tinfo[thread_num].executed = 1;
+	k_busy_wait(DELAY_US);
+}
+#endif
+
+/**
+ * @brief Test work stealing between the per-CPU ready queues
+ *
+ * @ingroup kernel_smp_tests
+ *
+ * @details Spawn one thread per CPU pinned to CPU 0 and let them
+ * block there, so that they are all requeued on CPU 0 once unpinned
+ * and woken up. Check that the idle CPUs steal some of them.
+ */
+ZTEST(smp, test_cpu_runq_steal)
+{
+#if defined(CONFIG_SCHED_CPU_RUNQ) && defined(CONFIG_SCHED_CPU_MASK)
+	unsigned int num_threads = arch_num_cpus();
+	int stolen = 0;
+
+	for (int i = 0; i < num_threads; i++) {
+		tinfo[i].cpu_id = -1;
+		tinfo[i].tid = k_thread_create(&tthread[i], tstack[i],
+					       STACK_SIZE, thread_steal_entry,
+					       INT_TO_POINTER(i), NULL, NULL,
+					       K_PRIO_COOP(10), 0, K_FOREVER);
+		zassert_ok(k_thread_cpu_pin(tinfo[i].tid, 0));
+		k_thread_start(tinfo[i].tid);
+	}
+
+	for (int i = 0; i < num_threads; i++) {
+		while (tinfo[i].cpu_id == -1 ||
+		       !z_is_thread_pending(tinfo[i].tid)) {
+			k_msleep(1);
+		}
+		zassert_equal(tinfo[i].cpu_id, 0, "thread %d not on CPU 0", i);
+		zassert_ok(k_thread_cpu_mask_enable_all(tinfo[i].tid));
+	}
+
+	for (int i = 0; i < num_threads; i++) {
+		k_sem_give(&steal_sem);
+	}
+
+	k_msleep(TIMEOUT);
+
+	for (int i = 0; i < num_threads; i++) {
+		zassert_true(tinfo[i].executed == 1,
+			     "thread %d did not execute", i);
+		if (steal_cpu_id[i] != 0) {
+			stolen++;
+		}
+	}
+	zassert_true(stolen > 0, "no thread was stolen from CPU 0");
+
+	abort_threads(num_threads);
+	cleanup_resources();
+#else
+	ztest_test_skip();
+#endif
+}
+
 /* a thread for testing get current cpu */
 static void thread_get_cpu_entry(void *p1, void *p2, void *p3)
 {
@@ -44,15 +44,15 @@ ZTEST(spinlock, test_spinlock_basic)
 	k_spinlock_key_t key;
 	static struct k_spinlock l;
 
-	zassert_true(!l.locked, "Spinlock initialized to locked");
+	zassert_true(!z_spin_is_locked(&l), "Spinlock initialized to locked");
 
 	key = k_spin_lock(&l);
 
-	zassert_true(l.locked, "Spinlock failed to lock");
+	zassert_true(z_spin_is_locked(&l), "Spinlock failed to lock");
 
 	k_spin_unlock(&l, key);
 
-	zassert_true(!l.locked, "Spinlock failed to unlock");
+	zassert_true(!z_spin_is_locked(&l), "Spinlock failed to unlock");
 }
 
 void bounce_once(int id, bool trylock)
@@ -164,7 +164,7 @@ ZTEST(spinlock, test_spinlock_mutual_exclusion)
 
 	key = k_spin_lock(&lock_runtime);
 
-	zassert_true(lock_runtime.locked, "Spinlock failed to lock");
+	zassert_true(z_spin_is_locked(&lock_runtime), "Spinlock failed to lock");
 
 	/* check irq has not locked */
 	zassert_true(arch_irq_unlocked(key.key),
@@ -184,7 +184,7 @@ ZTEST(spinlock, test_spinlock_mutual_exclusion)
 
 	k_spin_unlock(&lock_runtime, key);
 
-	zassert_true(!lock_runtime.locked, "Spinlock failed to unlock");
+	zassert_true(!z_spin_is_locked(&lock_runtime), "Spinlock failed to unlock");
 }
 
 void trylock_fn(void *p1, void *p2, void *p3)
@@ -227,6 +227,70 @@ ZTEST(spinlock, test_trylock)
 	zassert_true(trylock_successes > 0);
 }
 
+/**
+ * @brief Test spinlock contention statistics
+ *
+ * @ingroup kernel_spinlock_tests
+ *
+ * @see k_spinlock_stats_get(), k_spinlock_stats_reset()
+ */
+ZTEST(spinlock, test_spinlock_stats)
+{
+#ifndef CONFIG_SPINLOCK_STATS
+	ztest_test_skip();
+#else
+	static struct k_spinlock l;
+	struct k_spinlock_stats stats;
+	k_spinlock_key_t key;
+
+	k_spinlock_stats_reset(&l);
+
+	for (int i = 0; i < 10; i++) {
+		key = k_spin_lock(&l);
+		k_spin_unlock(&l, key);
+	}
+
+	zassert_ok(k_spin_trylock(&l, &key));
+	k_spin_unlock(&l, key);
+
+	k_spinlock_stats_get(&l, &stats);
+
+	/* Reading the statistics takes the lock too */
+	zassert_equal(stats.acquisitions, 12, "Wrong acquisition count %u",
+		      stats.acquisitions);
+	zassert_equal(stats.contentions, 0, "Uncontended lock waited for");
+	zassert_equal(stats.spin_cycles, 0, "Uncontended lock waited for");
+
+	/* Now have both CPUs fight over the lock */
+	k_spinlock_stats_reset(&bounce_lock);
+
+	k_thread_create(&cpu1_thread, cpu1_stack, CPU1_STACK_SIZE,
+			cpu1_fn, NULL, NULL, NULL,
+			0, 0, K_NO_WAIT);
+
+	k_busy_wait(10);
+
+	for (int i = 0; i < 1000; i++) {
+		bounce_once(1234, false);
+	}
+
+	bounce_done = 1;
+
+	k_thread_join(&cpu1_thread, K_FOREVER);
+
+	k_spinlock_stats_get(&bounce_lock, &stats);
+
+	TC_PRINT("acquisitions %u contentions %u spin cycles %llu max %u\n",
+		 stats.acquisitions, stats.contentions,
+		 (unsigned long long)stats.spin_cycles,
+		 stats.max_spin_cycles);
+
+	zassert_true(stats.acquisitions >= 1000, "Acquisitions not counted");
+	zassert_true(stats.contentions <= stats.acquisitions);
+	zassert_true(stats.max_spin_cycles <= stats.spin_cycles);
+#endif
+}
+
 static void before(void *ctx)
 {
 	ARG_UNUSED(ctx);
@@ -324,6 +324,24 @@ void stest_thread_launch(uint32_t flags, bool drop)
 	ret = k_thread_stack_space_get(&test_thread, &unused);
 	zassert_equal(ret, 0, "failed to calculate unused stack space\n");
 	printk("target thread unused stack space: %zu\n", unused);
+
+#ifdef CONFIG_STACK_WATERMARK
+	size_t watermark, again;
+
+	/* Gaps in the used stack may hide some usage from the watermark,
+	 * but never make it report more usage than there is
+	 */
+	ret = k_thread_stack_watermark_get(&test_thread, &watermark);
+	zassert_equal(ret, 0, "failed to get stack watermark\n");
+	zassert_true(watermark >= unused, "watermark %zu below unused space %zu",
+		     watermark, unused);
+
+	/* Resuming from the previous boundary finds the same one */
+	ret = k_thread_stack_watermark_get(&test_thread, &again);
+	zassert_equal(ret, 0, "failed to get stack watermark\n");
+	zassert_equal(again, watermark, "watermark moved from %zu to %zu",
+		      watermark, again);
+#endif
 }
 
 void scenario_entry(void *stack_obj, size_t obj_size, size_t reported_size,
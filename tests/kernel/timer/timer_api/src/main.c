@@ -64,6 +64,7 @@ static struct k_timer status_timer;
 static struct k_timer status_anytime_timer;
 static struct k_timer status_sync_timer;
 static struct k_timer remain_timer;
+static struct k_timer slack_timer;
 
 static ZTEST_BMEM struct timer_data tdata;
 
@@ -420,6 +421,41 @@ ZTEST_USER(timer_api, test_timer_periodicity)
 	k_timer_stop(&periodicity_timer);
 }
 
+/**
+ * @brief Test timer slack
+ *
+ * Starts a periodic timer with k_timer_start_slack() and checks that
+ * every expiry happens no earlier than requested and no later than the
+ * slack allows, i.e. that deferred expiries don't make the period drift.
+ *
+ * @ingroup kernel_timer_tests
+ *
+ * @see k_timer_start_slack(), k_timer_status_sync(), k_uptime_ticks()
+ */
+ZTEST_USER(timer_api, test_timer_slack)
+{
+	k_ticks_t period = k_ms_to_ticks_ceil32(PERIOD);
+	k_ticks_t slack = k_ms_to_ticks_ceil32(PERIOD / 2);
+	k_ticks_t start, late;
+
+	tick_sync();
+
+	start = k_uptime_ticks();
+	k_timer_start_slack(&slack_timer, K_TICKS(period), K_TICKS(period),
+			    K_TICKS(slack));
+
+	for (int i = 1; i <= EXPIRE_TIMES; i++) {
+		k_timer_status_sync(&slack_timer);
+		late = k_uptime_ticks() - (start + i * period);
+
+		/** TESTPOINT: expiry within the slack of the requested one */
+		TIMER_ASSERT(late >= 0 && late <= slack + 2, &slack_timer);
+	}
+
+	/* cleanup environment */
+	k_timer_stop(&slack_timer);
+}
+
 /**
  * @brief Test Timer status and time remaining before next expiry
  *
@@ -830,6 +866,7 @@ void *setup_timer_api(void)
 	timer_init(&status_anytime_timer, NULL, NULL);
 	timer_init(&status_sync_timer, duration_expire, duration_stop);
 	timer_init(&remain_timer, duration_expire, duration_stop);
+	timer_init(&slack_timer, NULL, NULL);
 
 	if (IS_ENABLED(CONFIG_MULTITHREADING)) {
 		k_thread_access_grant(k_current_get(), &ktimer, &timer0, &timer1,
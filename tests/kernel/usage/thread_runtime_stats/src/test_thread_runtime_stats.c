@@ -539,5 +539,82 @@ ZTEST(usage_api, test_thread_stats_usage)
 	k_thread_abort(tid);
 }
 
+#ifdef CONFIG_SCHED_THREAD_USAGE_LATENCY
+#define LATENCY_WAKEUPS 10
+
+static K_SEM_DEFINE(latency_sem, 0, 1);
+
+/**
+ * @brief Helper thread to test_thread_stats_latency()
+ */
+void helper_latency(void *p1, void *p2, void *p3)
+{
+	while (1) {
+		k_sem_take(&latency_sem, K_FOREVER);
+	}
+}
+
+/**
+ * @brief Test ready to run latency and preemption statistics
+ *
+ * Wake up a higher priority helper thread repeatedly. Each wakeup must be
+ * recorded in the helper's latency histogram, and must preempt the main
+ * thread.
+ */
+ZTEST(usage_api, test_thread_stats_latency)
+{
+	k_tid_t  tid;
+	k_thread_runtime_stats_t  main_stats1;
+	k_thread_runtime_stats_t  main_stats2;
+	k_thread_runtime_stats_t  helper_stats;
+	k_thread_runtime_stats_t  sys_stats;
+	uint32_t  wakeups = 0;
+
+	main_thread = _current;
+	tid = k_thread_create(&helper_thread, helper_stack,
+			      K_THREAD_STACK_SIZEOF(helper_stack),
+			      helper_latency, NULL, NULL, NULL,
+			      k_thread_priority_get(_current) - 1, 0,
+			      K_NO_WAIT);
+
+	/* Let the helper run to its first wait */
+	k_sleep(K_TICKS(1));
+
+	k_thread_runtime_stats_get(tid, &helper_stats);
+	zassert_equal(helper_stats.preemptions, 0);
+
+	k_thread_runtime_stats_get(main_thread, &main_stats1);
+
+	for (int i = 0; i < LATENCY_WAKEUPS; i++) {
+		k_sem_give(&latency_sem);
+	}
+
+	k_thread_runtime_stats_get(main_thread, &main_stats2);
+	k_thread_runtime_stats_get(tid, &helper_stats);
+	k_thread_runtime_stats_all_get(&sys_stats);
+
+	for (int i = 0; i < ARRAY_SIZE(helper_stats.latency_hist); i++) {
+		wakeups += helper_stats.latency_hist[i];
+	}
+
+	/* One more for starting the helper */
+	zassert_equal(wakeups, LATENCY_WAKEUPS + 1, "%u wakeups", wakeups);
+	zassert_true(helper_stats.peak_latency_cycles > 0);
+	zassert_true(main_stats2.preemptions - main_stats1.preemptions >=
+		     LATENCY_WAKEUPS);
+#ifdef CONFIG_SCHED_THREAD_USAGE_ALL
+	zassert_true(sys_stats.peak_latency_cycles >=
+		     helper_stats.peak_latency_cycles);
+#endif
+
+	k_thread_abort(tid);
+}
+#else
+ZTEST(usage_api, test_thread_stats_latency)
+{
+	ztest_test_skip();
+}
+#endif
+
 ZTEST_SUITE(usage_api, NULL, NULL,
 		ztest_simple_1cpu_before, ztest_simple_1cpu_after, NULL);
@@ -1441,6 +1441,97 @@ ZTEST(work_1cpu, test_1cpu_system_reschedule)
 		     "long %u > %u\n", elapsed_ms, max_ms);
 }
 
+#ifdef CONFIG_WORKQUEUE_STATS
+static void stats_foreach_cb(struct k_work_q *queue, void *user_data)
+{
+	if (queue == &coophi_queue) {
+		*(bool *)user_data = true;
+	}
+}
+
+static uint32_t hist_sum(const uint32_t *hist)
+{
+	uint32_t sum = 0;
+
+	for (int i = 0; i < CONFIG_WORKQUEUE_STATS_HIST_BUCKETS; i++) {
+		sum += hist[i];
+	}
+
+	return sum;
+}
+
+/* Check depth, latency and handler accounting of a queue. */
+ZTEST(work_1cpu, test_1cpu_queue_stats)
+{
+	struct k_work_queue_stats stats;
+	bool found = false;
+	int rc;
+
+	zassert_equal(k_work_queue_stats_get(NULL, &stats), -EINVAL);
+	zassert_equal(k_work_queue_stats_get(&coophi_queue, NULL), -EINVAL);
+
+	k_work_queue_foreach(stats_foreach_cb, &found);
+	zassert_true(found);
+
+	reset_counters();
+	k_work_init(&common_work, counter_handler);
+	k_work_init(&common_work1, counter_handler);
+	k_work_queue_stats_reset(&coophi_queue);
+
+	/* Queue two items and cancel one before it runs. */
+	rc = k_work_submit_to_queue(&coophi_queue, &common_work);
+	zassert_equal(rc, 1);
+	rc = k_work_submit_to_queue(&coophi_queue, &common_work1);
+	zassert_equal(rc, 1);
+
+	rc = k_work_queue_stats_get(&coophi_queue, &stats);
+	zassert_equal(rc, 0);
+	zassert_equal(stats.depth, 2);
+	zassert_equal(stats.max_depth, 2);
+
+	zassert_equal(k_work_cancel(&common_work1), 0);
+	rc = k_work_queue_stats_get(&coophi_queue, &stats);
+	zassert_equal(rc, 0);
+	zassert_equal(stats.depth, 1);
+
+	/* Let the remaining one run. */
+	k_sleep(K_TICKS(1));
+	zassert_equal(coophi_counter(), 1);
+	zassert_equal(k_sem_take(&sync_sem, K_NO_WAIT), 0);
+
+	rc = k_work_queue_stats_get(&coophi_queue, &stats);
+	zassert_equal(rc, 0);
+	zassert_equal(stats.depth, 0);
+	zassert_equal(stats.max_depth, 2);
+	zassert_equal(hist_sum(stats.latency_hist), 1);
+	zassert_equal(hist_sum(stats.runtime_hist), 1);
+	zassert_equal(stats.handlers[0].handler, counter_handler);
+	zassert_equal(stats.handlers[0].count, 1);
+	zassert_equal(stats.other_handlers, 0);
+
+	/* Flushes are not accounted for. */
+	rc = k_work_submit_to_queue(&coophi_queue, &common_work);
+	zassert_equal(rc, 1);
+	zassert_true(k_work_flush(&common_work, &work_sync));
+	zassert_equal(k_sem_take(&sync_sem, K_NO_WAIT), 0);
+
+	rc = k_work_queue_stats_get(&coophi_queue, &stats);
+	zassert_equal(rc, 0);
+	zassert_equal(stats.depth, 0);
+	zassert_equal(hist_sum(stats.runtime_hist), 2);
+	zassert_equal(stats.handlers[0].count, 2);
+	zassert_is_null(stats.handlers[1].handler);
+
+	/* Reset keeps the current depth only. */
+	k_work_queue_stats_reset(&coophi_queue);
+	rc = k_work_queue_stats_get(&coophi_queue, &stats);
+	zassert_equal(rc, 0);
+	zassert_equal(stats.max_depth, 0);
+	zassert_equal(hist_sum(stats.latency_hist), 0);
+	zassert_is_null(stats.handlers[0].handler);
+}
+#endif /* CONFIG_WORKQUEUE_STATS */
+
 ZTEST(work, test_nop)
 {
 	ztest_test_skip();
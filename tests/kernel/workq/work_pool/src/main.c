@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+
+#define NUM_WORKERS 3
+#define NUM_ITEMS 16
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define WORKER_PRIORITY K_PRIO_PREEMPT(1)
+
+K_WORK_Q_POOL_DEFINE(test_pool, NUM_WORKERS, STACK_SIZE);
+
+static struct k_work items[NUM_ITEMS];
+static struct k_work_sync work_sync;
+static atomic_t run_count;
+static struct k_thread *ran_on[NUM_ITEMS];
+
+/* Blocks the worker running it until released */
+static struct k_work blocker;
+static K_SEM_DEFINE(blocker_started, 0, 1);
+static K_SEM_DEFINE(blocker_release, 0, 1);
+
+static void item_handler(struct k_work *work)
+{
+	ran_on[work - items] = k_current_get();
+	atomic_inc(&run_count);
+}
+
+static void blocker_handler(struct k_work *work)
+{
+	k_sem_give(&blocker_started);
+	k_sem_take(&blocker_release, K_FOREVER);
+}
+
+static void *pool_setup(void)
+{
+	k_work_q_pool_start(&test_pool, WORKER_PRIORITY, NULL);
+
+	return NULL;
+}
+
+static void pool_before(void *fixture)
+{
+	atomic_clear(&run_count);
+
+	for (int i = 0; i < NUM_ITEMS; i++) {
+		k_work_init(&items[i], item_handler);
+		ran_on[i] = NULL;
+	}
+}
+
+/**
+ * @brief Test that work submitted to a pool runs on its workers
+ *
+ * @see k_work_q_pool_submit()
+ */
+ZTEST(work_pool, test_pool_submit)
+{
+	for (int i = 0; i < NUM_ITEMS; i++) {
+		zassert_equal(k_work_q_pool_submit(&test_pool, &items[i]), 1);
+	}
+
+	for (int i = 0; i < NUM_ITEMS; i++) {
+		(void)k_work_flush(&items[i], &work_sync);
+	}
+
+	zassert_equal(atomic_get(&run_count), NUM_ITEMS);
+
+	for (int i = 0; i < NUM_ITEMS; i++) {
+		bool found = false;
+
+		for (int q = 0; q < NUM_WORKERS; q++) {
+			if (ran_on[i] ==
+			    k_work_queue_thread_get(&test_pool.queues[q])) {
+				found = true;
+			}
+		}
+
+		zassert_true(found, "item %d not run by a pool worker", i);
+	}
+}
+
+/**
+ * @brief Test that work queued to a busy worker is taken over
+ *
+ * Block the first worker, queue items behind the blocker and check that
+ * the other workers of the pool run them, and that flush still finds
+ * them.
+ *
+ * @see k_work_submit_to_queue(), k_work_flush()
+ */
+ZTEST(work_pool, test_pool_steal)
+{
+	struct k_work_q *busy = &test_pool.queues[0];
+
+	k_work_init(&blocker, blocker_handler);
+	zassert_equal(k_work_submit_to_queue(busy, &blocker), 1);
+	zassert_equal(k_sem_take(&blocker_started, K_SECONDS(1)), 0);
+
+	for (int i = 0; i < NUM_ITEMS; i++) {
+		zassert_equal(k_work_submit_to_queue(busy, &items[i]), 1);
+	}
+
+	for (int i = 0; i < NUM_ITEMS; i++) {
+		(void)k_work_flush(&items[i], &work_sync);
+	}
+
+	zassert_equal(atomic_get(&run_count), NUM_ITEMS);
+
+	for (int i = 0; i < NUM_ITEMS; i++) {
+		zassert_not_equal(ran_on[i], k_work_queue_thread_get(busy),
+				  "item %d waited for the busy worker", i);
+		zassert_equal(k_work_busy_get(&items[i]), 0);
+	}
+
+	/* The blocker itself is still running on the first worker */
+	zassert_equal(k_work_busy_get(&blocker), K_WORK_RUNNING);
+	k_sem_give(&blocker_release);
+	zassert_true(k_work_flush(&blocker, &work_sync));
+	zassert_equal(k_work_busy_get(&blocker), 0);
+}
+
+ZTEST_SUITE(work_pool, NULL, pool_setup, pool_before, NULL, NULL);
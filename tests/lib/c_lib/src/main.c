@@ -205,6 +205,32 @@ ZTEST(test_c_lib, test_strlen)
 	zassert_equal(strnlen(buffer, BUFSIZE), 5, "strnlen failed");
 }
 
+/**
+ *
+ * @brief Test string length function on every alignment
+ *
+ * @see strlen().
+ *
+ */
+ZTEST(test_c_lib, test_strlen_alignment)
+{
+	char str[4 * sizeof(uintptr_t) + 1] __aligned(sizeof(uintptr_t));
+
+	for (size_t start = 0; start < sizeof(uintptr_t); start++) {
+		for (size_t end = start; end < sizeof(str); end++) {
+			(void)memset(str, 0xff, sizeof(str));
+			str[end] = '\0';
+			zassert_equal(strlen(&str[start]), end - start,
+				      "strlen failed from %zu to %zu", start, end);
+		}
+	}
+
+	/* bytes with the high bit set next to a null byte */
+	(void)memset(str, 0x80, sizeof(str));
+	str[sizeof(uintptr_t) + 1] = '\0';
+	zassert_equal(strlen(str), sizeof(uintptr_t) + 1, "strlen failed");
+}
+
 /**
  *
  * @brief Test string compare function
@@ -590,6 +616,64 @@ ZTEST(test_c_lib, test_memcpy)
 		0, "memcpy failed");
 }
 
+/**
+ * @brief Test memory functions on every alignment
+ *
+ * @see memcpy(), memset(), memcmp().
+ */
+ZTEST(test_c_lib, test_mem_alignment)
+{
+	unsigned char src[8 * sizeof(uintptr_t)] __aligned(sizeof(uintptr_t));
+	unsigned char dst[8 * sizeof(uintptr_t)] __aligned(sizeof(uintptr_t));
+	const size_t max_len = sizeof(src) - sizeof(uintptr_t);
+
+	for (size_t i = 0; i < sizeof(src); i++) {
+		src[i] = i * 7 + 1;
+	}
+
+	for (size_t s_off = 0; s_off < sizeof(uintptr_t); s_off++) {
+		for (size_t d_off = 0; d_off < sizeof(uintptr_t); d_off++) {
+			for (size_t len = 0; len <= max_len; len++) {
+				(void)memset(dst, 0, sizeof(dst));
+				(void)memcpy(&dst[d_off], &src[s_off], len);
+
+				for (size_t i = 0; i < sizeof(dst); i++) {
+					unsigned char expected =
+						((i < d_off) || (i >= d_off + len)) ?
+						0 : src[s_off + i - d_off];
+
+					zassert_equal(dst[i], expected,
+						      "memcpy failed from %zu to %zu of %zu",
+						      s_off, d_off, len);
+				}
+
+				zassert_equal(memcmp(&dst[d_off], &src[s_off], len), 0,
+					      "memcmp failed from %zu to %zu of %zu",
+					      s_off, d_off, len);
+				if (len > 0) {
+					dst[d_off + len - 1] ^= 0x01;
+					zassert_not_equal(memcmp(&dst[d_off], &src[s_off], len), 0,
+							  "memcmp failed from %zu to %zu of %zu",
+							  s_off, d_off, len);
+				}
+			}
+		}
+	}
+
+	for (size_t off = 0; off < sizeof(uintptr_t); off++) {
+		for (size_t len = 0; len <= max_len; len++) {
+			(void)memset(dst, 0, sizeof(dst));
+			(void)memset(&dst[off], 0x5a, len);
+
+			for (size_t i = 0; i < sizeof(dst); i++) {
+				zassert_equal(dst[i],
+					      ((i < off) || (i >= off + len)) ? 0 : 0x5a,
+					      "memset failed at %zu of %zu", off, len);
+			}
+		}
+	}
+}
+
 /**
  * @brief Test memmove operation
  *
@@ -893,6 +893,54 @@ ZTEST(cbprintf_package, test_cbprintf_package_convert)
 
 }
 
+ZTEST(cbprintf_package, test_cbprintf_package_convert_ptr_check)
+{
+#if Z_C_GENERIC
+	int slen, clen, clen_nocheck;
+	static const char test_str[] = "test %s %p %s";
+	char test_str1[] = "test str1";
+	char test_ptr[] = "not a string";
+	char test_str2[] = "test str2";
+	/* Static package records the char pointer passed to %p as a string. */
+	uint32_t flags = CBPRINTF_PACKAGE_ADD_RW_STR_POS;
+	struct test_cbprintf_covert_ctx ctx;
+
+#define TEST_FMT test_str, test_str1, test_ptr, test_str2
+	char exp_str[256];
+
+	snprintfcb(exp_str, sizeof(exp_str), TEST_FMT);
+
+	CBPRINTF_STATIC_PACKAGE(NULL, 0, slen, 0, flags, TEST_FMT);
+	zassert_true(slen > 0);
+
+	uint8_t __aligned(CBPRINTF_PACKAGE_ALIGNMENT) spackage[slen];
+
+	memset(&ctx, 0, sizeof(ctx));
+	CBPRINTF_STATIC_PACKAGE(spackage, slen, slen, 0, flags, TEST_FMT);
+	zassert_true(slen > 0);
+
+	uint32_t copy_flags = CBPRINTF_PACKAGE_CONVERT_RW_STR |
+			      CBPRINTF_PACKAGE_CONVERT_PTR_CHECK;
+
+	clen_nocheck = cbprintf_package_convert(spackage, slen, NULL, 0,
+						CBPRINTF_PACKAGE_CONVERT_RW_STR, NULL, 0);
+	clen = cbprintf_package_convert(spackage, slen, NULL, 0, copy_flags, NULL, 0);
+	zassert_true(clen > 0);
+	/* Only the strings passed to %s are copied. */
+	zassert_equal(clen_nocheck - clen, (int)sizeof(test_ptr) + 1);
+
+	clen = cbprintf_package_convert(spackage, slen, convert_cb, &ctx, copy_flags, NULL, 0);
+	zassert_true(clen > 0);
+	zassert_true(ctx.null);
+	zassert_equal((int)ctx.offset, clen);
+
+	check_package(ctx.buf, ctx.offset, exp_str);
+#undef TEST_FMT
+#else
+	ztest_test_skip();
+#endif
+}
+
 /**
  * @brief Log information about variable sizes and alignment.
  *
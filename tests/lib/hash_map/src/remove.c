@@ -37,3 +37,30 @@ ZTEST(hash_map, test_remove_false)
 	zassert_equal(1, sys_hashmap_insert(&map, 1, 1, NULL));
 	zassert_false(sys_hashmap_remove(&map, 42, NULL));
 }
+
+ZTEST(hash_map, test_remove_interleaved)
+{
+	for (size_t i = 0; i < MANY; ++i) {
+		zassert_equal(1, sys_hashmap_insert(&map, i, i, NULL));
+	}
+
+	/* remove every other entry, the remaining ones must still be found */
+	for (size_t i = 0; i < MANY; i += 2) {
+		zassert_true(sys_hashmap_remove(&map, i, NULL));
+	}
+
+	for (size_t i = 0; i < MANY; ++i) {
+		zassert_equal(i % 2 == 1, sys_hashmap_contains_key(&map, i), "key %zu", i);
+	}
+
+	for (size_t i = 0; i < MANY; i += 2) {
+		zassert_equal(1, sys_hashmap_insert(&map, i, i, NULL));
+	}
+
+	for (size_t i = 0; i < MANY; ++i) {
+		uint64_t value = ~i;
+
+		zassert_true(sys_hashmap_get(&map, i, &value), "key %zu", i);
+		zassert_equal(i, value);
+	}
+}
@@ -0,0 +1,39 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/sys/hash_map.h>
+
+#include "_main.h"
+
+ZTEST(hash_map, test_reserve)
+{
+#ifdef CONFIG_SYS_HASH_MAP_CHOICE_OA_RH
+	void *buckets;
+
+	zassert_equal(-EINVAL, sys_hashmap_oa_rh_reserve(&map, SIZE_MAX));
+	zassert_ok(sys_hashmap_oa_rh_reserve(&map, MANY));
+	zassert_true(sys_hashmap_is_empty(&map));
+
+	buckets = map.data->buckets;
+	zassert_not_null(buckets);
+
+	/* neither growing nor shrinking within the reserved size */
+	for (size_t i = 0; i < MANY; ++i) {
+		zassert_equal(1, sys_hashmap_insert(&map, i, i, NULL));
+		zassert_equal(buckets, map.data->buckets);
+	}
+
+	for (size_t i = 0; i < MANY; ++i) {
+		zassert_true(sys_hashmap_remove(&map, i, NULL));
+		zassert_equal(buckets, map.data->buckets);
+	}
+
+	zassert_true(sys_hashmap_is_empty(&map));
+#else
+	ztest_test_skip();
+#endif
+}
@@ -996,6 +996,21 @@ ZTEST(lib_json_test, test_json_key_not_in_descr)
 	zassert_equal(ret, 0, "No items should be decoded");
 }
 
+ZTEST(lib_json_test, test_json_key_order)
+{
+	struct test_nested ts = { 0 };
+	char encoded[] = "{\"nested_string\":\"last\",\"nested_bool\":true,"
+			 "\"nested_int\":42,\"nested_int\":43}";
+	int ret;
+
+	ret = json_obj_parse(encoded, sizeof(encoded) - 1, nested_descr,
+			     ARRAY_SIZE(nested_descr), &ts);
+	zassert_equal(ret, 0b111, "All the items should be decoded");
+	zassert_equal(ts.nested_int, 42, "A repeated key is skipped");
+	zassert_true(ts.nested_bool, "Boolean not decoded correctly");
+	zassert_true(!strcmp(ts.nested_string, "last"), "String not decoded correctly");
+}
+
 ZTEST(lib_json_test, test_json_escape)
 {
 	char buf[42];
@@ -274,5 +274,67 @@ ZTEST(lib_p4wq_1cpu, test_p4wq_simple)
 	zassert_true(has_run, "high-priority item didn't run");
 }
 
+K_P4WQ_DEFINE(batch_wq, 1, 2048);
+
+static struct k_p4wq_work batch_items[4];
+static int batch_order[ARRAY_SIZE(batch_items)];
+static int batch_count;
+
+static void batch_handler(struct k_p4wq_work *work)
+{
+	int idx = ARRAY_INDEX(batch_items, work);
+
+	batch_order[batch_count++] = idx;
+
+	/* Queue the others behind us, in reverse deadline order */
+	if (idx == 0) {
+		for (int i = ARRAY_SIZE(batch_items) - 1; i > 0; i--) {
+			batch_items[i].deadline = k_us_to_cyc_ceil32(100 * i);
+			k_p4wq_submit(&batch_wq, &batch_items[i]);
+		}
+	}
+}
+
+/* Items of the same priority run in deadline order, batched or not */
+ZTEST(lib_p4wq_1cpu, test_p4wq_batch)
+{
+	k_thread_priority_set(k_current_get(), 2);
+
+#ifdef CONFIG_P4WQ_STATS
+	k_p4wq_stats_reset(&batch_wq);
+#endif
+
+	batch_count = 0;
+	for (int i = 0; i < ARRAY_SIZE(batch_items); i++) {
+		batch_items[i] = (struct k_p4wq_work){};
+		batch_items[i].priority = 3;
+		batch_items[i].handler = batch_handler;
+	}
+
+	k_p4wq_submit(&batch_wq, &batch_items[0]);
+	k_msleep(10);
+
+	zassert_equal(batch_count, ARRAY_SIZE(batch_items),
+		      "ran %d items", batch_count);
+	for (int i = 0; i < ARRAY_SIZE(batch_items); i++) {
+		zassert_equal(batch_order[i], i, "wrong order");
+	}
+
+#ifdef CONFIG_P4WQ_STATS
+	struct k_p4wq_stats stats;
+
+	k_p4wq_stats_get(&batch_wq, &stats);
+	zassert_equal(stats.items, ARRAY_SIZE(batch_items));
+	zassert_true(stats.wait_max > 0);
+	zassert_true(stats.wait_total >= stats.wait_max);
+
+	/* The single queue thread takes the last two along with the
+	 * first of the three submitted from the handler.
+	 */
+	zassert_equal(stats.batched, CONFIG_P4WQ_BATCH_SIZE > 1 ? 2 : 0,
+		      "%u items batched", stats.batched);
+#endif
+}
+
 ZTEST_SUITE(lib_p4wq, NULL, NULL, NULL, NULL, NULL);
 ZTEST_SUITE(lib_p4wq_1cpu, NULL, NULL, ztest_simple_1cpu_before, ztest_simple_1cpu_after, NULL);
@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/smf.h>
+
+/*
+ * Event Test Transition:
+ *
+ *	IDLE --(EVENT_START)--> ACTIVE --(EVENT_STOP)--> terminate
+ *
+ * EVENT_PING events received in ACTIVE are counted, the ones received in
+ * IDLE are ignored.
+ */
+
+#ifdef CONFIG_SMF_ANCESTOR_SUPPORT
+#define EVENT_STATE(_run) SMF_CREATE_STATE(NULL, _run, NULL, NULL)
+#else
+#define EVENT_STATE(_run) SMF_CREATE_STATE(NULL, _run, NULL)
+#endif
+
+#define TEST_OBJECT(o) ((struct test_object *)o)
+
+#define TEST_TERMINATE_VALUE 1
+
+enum test_event {
+	EVENT_START,
+	EVENT_PING,
+	EVENT_STOP,
+};
+
+enum test_state {
+	STATE_IDLE,
+	STATE_ACTIVE,
+};
+
+K_MSGQ_DEFINE(test_events, sizeof(uint32_t), 8, sizeof(uint32_t));
+
+static struct test_object {
+	struct smf_ctx ctx;
+	uint32_t event;
+	uint32_t pings;
+} test_obj;
+
+static const struct smf_state test_states[];
+
+static void idle_run(void *obj)
+{
+	struct test_object *o = TEST_OBJECT(obj);
+
+	if (o->event == EVENT_START) {
+		smf_set_state(SMF_CTX(obj), &test_states[STATE_ACTIVE]);
+	}
+}
+
+static void active_run(void *obj)
+{
+	struct test_object *o = TEST_OBJECT(obj);
+
+	if (o->event == EVENT_PING) {
+		o->pings++;
+	} else if (o->event == EVENT_STOP) {
+		smf_set_terminate(SMF_CTX(obj), TEST_TERMINATE_VALUE);
+	}
+}
+
+static const struct smf_state test_states[] = {
+	[STATE_IDLE] = EVENT_STATE(idle_run),
+	[STATE_ACTIVE] = EVENT_STATE(active_run),
+};
+
+ZTEST(smf_tests, test_smf_event)
+{
+	const uint32_t events[] = {
+		EVENT_PING, EVENT_START, EVENT_PING, EVENT_PING, EVENT_STOP,
+	};
+	int32_t ret;
+
+	smf_set_initial(SMF_CTX(&test_obj), &test_states[STATE_IDLE]);
+
+	for (int i = 0; i < ARRAY_SIZE(events); i++) {
+		zassert_equal(k_msgq_put(&test_events, &events[i], K_NO_WAIT), 0,
+			      "Failed to post event %d", i);
+	}
+
+	do {
+		ret = smf_run_event(SMF_CTX(&test_obj), &test_events,
+				    &test_obj.event, K_NO_WAIT);
+	} while (ret == 0);
+
+	zassert_equal(ret, TEST_TERMINATE_VALUE, "Unexpected return value %d", ret);
+	zassert_equal(test_obj.pings, 2, "Unexpected ping count %u", test_obj.pings);
+
+	/* Once terminated, the events are left in the queue */
+	zassert_equal(k_msgq_put(&test_events, &events[0], K_NO_WAIT), 0,
+		      "Failed to post event");
+	ret = smf_run_event(SMF_CTX(&test_obj), &test_events, &test_obj.event,
+			    K_NO_WAIT);
+	zassert_equal(ret, TEST_TERMINATE_VALUE, "Unexpected return value %d", ret);
+	zassert_equal(k_msgq_num_used_get(&test_events), 1, "Event consumed");
+	k_msgq_purge(&test_events);
+
+	smf_set_initial(SMF_CTX(&test_obj), &test_states[STATE_IDLE]);
+	ret = smf_run_event(SMF_CTX(&test_obj), &test_events, &test_obj.event,
+			    K_NO_WAIT);
+	zassert_equal(ret, -EAGAIN, "Expected -EAGAIN without events, got %d", ret);
+}
@@ -423,11 +423,25 @@ static const struct smf_state test_states[] = {
 	[D] = SMF_CREATE_STATE(d_entry, NULL, NULL, NULL),
 };
 
+#ifdef CONFIG_SMF_TRANSITION_TABLE
+SMF_TABLE_DEFINE(test_table, test_states);
+#endif
+
+static void test_set_initial(struct smf_ctx *ctx, const struct smf_state *init_state)
+{
+#ifdef CONFIG_SMF_TRANSITION_TABLE
+	smf_table_init(&test_table);
+	smf_set_initial_table(ctx, &test_table, init_state);
+#else
+	smf_set_initial(ctx, init_state);
+#endif
+}
+
 ZTEST(smf_tests, test_smf_hierarchical_5_ancestors)
 {
 	test_obj.tv_idx = 0;
 	test_obj.transition_bits = 0;
-	smf_set_initial((struct smf_ctx *)&test_obj, &test_states[A]);
+	test_set_initial((struct smf_ctx *)&test_obj, &test_states[A]);
 
 	for (int i = 0; i < SMF_RUN; i++) {
 		if (smf_run_state((struct smf_ctx *)&test_obj) < 0) {
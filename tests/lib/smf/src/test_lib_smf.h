@@ -10,5 +10,6 @@
 void test_smf_flat(void);
 void test_smf_hierarchical(void);
 void test_smf_hierarchical_5_ancestors(void);
+void test_smf_event(void);
 
 #endif /* ZEPHYR_TEST_LIB_SMF_H_ */
@@ -335,6 +335,76 @@ ZTEST(test_spsc_pbuf, test_0cpy_corner2)
 	PACKET_WRITE(pb, capacity, 0, 2, exp_len);
 }
 
+static void packet_fill(char *buf, uint16_t len, uint8_t id)
+{
+	for (uint16_t i = 0; i < len; i++) {
+		buf[i] = id + i;
+	}
+}
+
+ZTEST(test_spsc_pbuf, test_0cpy_alloc_after)
+{
+	static uint8_t buffer[128] __aligned(MAX(Z_SPSC_PBUF_DCACHE_LINE, 4));
+	struct spsc_pbuf *pb;
+	uint32_t capacity;
+	char *start;
+	char *buf1;
+	char *buf2;
+	char *buf3;
+	uint16_t len1;
+	uint16_t len2;
+	int rv;
+
+	pb = spsc_pbuf_init(buffer, sizeof(buffer), 0);
+	capacity = spsc_pbuf_capacity(pb);
+
+	/* Two packets allocated before being committed. */
+	len1 = 16;
+	rv = spsc_pbuf_alloc_after(pb, NULL, 0, len1, &buf1);
+	zassert_equal(rv, len1);
+	start = buf1;
+	rv = spsc_pbuf_alloc_after(pb, buf1, len1, len1, &buf2);
+	zassert_equal(rv, len1);
+	zassert_equal(buf2 - buf1, TLEN(len1));
+
+	packet_fill(buf2, len1, 1);
+	packet_fill(buf1, len1, 0);
+
+	/* Not visible to the consumer until committed. */
+	PACKET_CONSUME(pb, 0, 0);
+
+	zassert_true(spsc_pbuf_commit_buf(pb, buf1, len1));
+	zassert_false(spsc_pbuf_commit_buf(pb, buf2, len1));
+
+	PACKET_CONSUME(pb, len1, 0);
+	PACKET_CONSUME(pb, len1, 1);
+	PACKET_CONSUME(pb, 0, 0);
+
+	/* Leave less than a packet at the end, the next allocation wraps. */
+	len2 = capacity - 2 * TLEN(len1) - HDR_LEN - 8;
+	rv = spsc_pbuf_alloc_after(pb, NULL, 0, len2, &buf1);
+	zassert_equal(rv, len2);
+	rv = spsc_pbuf_alloc_after(pb, buf1, len2, len1, &buf2);
+	zassert_equal(rv, len1);
+	zassert_equal(buf2, start);
+
+	/* Only the space up to the packets not freed yet is left for a third one. */
+	rv = spsc_pbuf_alloc_after(pb, buf2, len1, len1, &buf3);
+	zassert_true(rv < len1, "Unexpected rv:%d", rv);
+
+	packet_fill(buf1, len2, 2);
+	packet_fill(buf2, len1, 3);
+
+	/* The consumer stops on the padding until the wrapped packet is committed. */
+	zassert_true(spsc_pbuf_commit_buf(pb, buf1, len2));
+	PACKET_CONSUME(pb, len2, 2);
+	PACKET_CONSUME(pb, 0, 0);
+
+	zassert_true(spsc_pbuf_commit_buf(pb, buf2, len1));
+	PACKET_CONSUME(pb, len1, 3);
+	PACKET_CONSUME(pb, 0, 0);
+}
+
 ZTEST(test_spsc_pbuf, test_largest_alloc)
 {
 	static uint8_t buffer[128] __aligned(MAX(Z_SPSC_PBUF_DCACHE_LINE, 4));
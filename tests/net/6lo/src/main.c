@@ -1171,6 +1171,16 @@ ZTEST(t_6lo, test_loop)
 
 		test_6lo(tests[count].data);
 	}
+
+#if CONFIG_NET_6LO_COMPRESS_CACHE_SIZE > 0
+	/* Compress the same flows again, from the cached headers */
+	for (count = 0; count < ARRAY_SIZE(tests); count++) {
+		TC_PRINT("Starting %s (cached)\n", tests[count].name);
+
+		test_6lo(tests[count].data);
+		test_6lo(tests[count].data);
+	}
+#endif
 	net_pkt_print();
 }
 
@@ -647,4 +647,246 @@ ZTEST(arp_fn_tests, test_arp)
 	}
 }
 
+static struct in_addr stats_src = { { { 192, 168, 0, 1 } } };
+static struct in_addr stats_dst[] = {
+	{ { { 192, 168, 0, 10 } } },
+	{ { { 192, 168, 0, 11 } } },
+	{ { { 192, 168, 0, 12 } } },
+};
+static struct net_eth_addr stats_hwaddr[] = {
+	{ { 0x02, 0x00, 0x5e, 0x00, 0x00, 0x10 } },
+	{ { 0x02, 0x00, 0x5e, 0x00, 0x00, 0x11 } },
+	{ { 0x02, 0x00, 0x5e, 0x00, 0x00, 0x12 } },
+};
+
+static struct net_if *arp_stats_iface_setup(void)
+{
+	struct in_addr netmask = { { { 255, 255, 255, 0 } } };
+	struct net_if_addr *ifaddr;
+	struct net_if *iface;
+
+	net_arp_init();
+	net_arp_clear_cache(NULL);
+
+	iface = net_if_lookup_by_dev(DEVICE_GET(net_arp_test));
+	net_if_ipv4_set_netmask(iface, &netmask);
+
+	ifaddr = net_if_ipv4_addr_add(iface, &stats_src, NET_ADDR_MANUAL, 0);
+	zassert_not_null(ifaddr, "Cannot add address");
+	ifaddr->addr_state = NET_ADDR_PREFERRED;
+
+	return iface;
+}
+
+static struct net_pkt *ipv4_pkt_alloc(struct net_if *iface, struct in_addr *dst)
+{
+	struct net_ipv4_hdr *ipv4;
+	struct net_pkt *pkt;
+	int len = strlen(app_data);
+
+	pkt = net_pkt_alloc_with_buffer(iface, sizeof(struct net_ipv4_hdr) + len,
+					AF_INET, 0, K_SECONDS(1));
+	zassert_not_null(pkt, "out of mem");
+
+	ipv4 = (struct net_ipv4_hdr *)net_buf_add(pkt->buffer,
+						  sizeof(struct net_ipv4_hdr));
+	net_ipv4_addr_copy_raw(ipv4->src, (uint8_t *)&stats_src);
+	net_ipv4_addr_copy_raw(ipv4->dst, (uint8_t *)dst);
+
+	memcpy(net_buf_add(pkt->buffer, len), app_data, len);
+
+	return pkt;
+}
+
+/* Start resolving @p dst, the caller keeps its own reference to @p pkt */
+static void arp_request(struct net_pkt *pkt, struct in_addr *dst)
+{
+	struct net_pkt *req;
+
+	req = net_arp_prepare(pkt, dst, NULL);
+	zassert_not_null(req, "ARP request not created");
+	zassert_not_equal(req, pkt, "%s should not be resolved",
+			  net_sprint_ipv4_addr(dst));
+
+	net_pkt_unref(req);
+}
+
+/* Feed in the ARP reply of @p addr and let the pending packets go out */
+static void arp_reply(struct net_if *iface, struct in_addr *addr,
+		      struct net_eth_addr *hwaddr)
+{
+	struct net_eth_hdr *eth_hdr = NULL;
+	struct net_arp_hdr *arp_hdr;
+	struct net_pkt *req, *reply;
+
+	req = net_pkt_alloc_with_buffer(iface, sizeof(struct net_arp_hdr),
+					AF_UNSPEC, 0, K_SECONDS(1));
+	zassert_not_null(req, "out of mem request");
+
+	arp_hdr = NET_ARP_HDR(req);
+	net_buf_add(req->buffer, sizeof(struct net_arp_hdr));
+	net_ipv4_addr_copy_raw(arp_hdr->dst_ipaddr, (uint8_t *)addr);
+	net_ipv4_addr_copy_raw(arp_hdr->src_ipaddr, (uint8_t *)&stats_src);
+
+	reply = prepare_arp_reply(iface, req, hwaddr, &eth_hdr);
+	zassert_not_null(reply, "ARP reply generation failed");
+	zassert_equal(net_arp_input(reply, eth_hdr), NET_OK);
+
+	net_pkt_unref(req);
+
+	/* Let the TX path send the packets that were waiting */
+	k_msleep(10);
+}
+
+static bool arp_cached(struct in_addr *addr, struct net_eth_addr *hwaddr)
+{
+	entry_found = false;
+	expected_hwaddr = hwaddr;
+	net_arp_foreach(arp_cb, addr);
+
+	return entry_found;
+}
+
+ZTEST(arp_fn_tests, test_arp_stats_lru)
+{
+	struct net_arp_stats before, after;
+	struct net_pkt *pkt[4];
+	struct net_if *iface;
+	int i;
+
+	Z_TEST_SKIP_IFNDEF(CONFIG_NET_L2_ETHERNET);
+
+	if (CONFIG_NET_ARP_TABLE_SIZE != 2) {
+		ztest_test_skip();
+	}
+
+	iface = arp_stats_iface_setup();
+
+	/* Fill the table with the first two addresses */
+	for (i = 0; i < 2; i++) {
+		pkt[i] = ipv4_pkt_alloc(iface, &stats_dst[i]);
+
+		net_arp_stats_get(&before);
+		arp_request(pkt[i], &stats_dst[i]);
+		net_arp_stats_get(&after);
+		zassert_equal(after.misses - before.misses, 1, "miss not counted");
+		zassert_equal(after.hits - before.hits, 0, "unexpected hit");
+
+		arp_reply(iface, &stats_dst[i], &stats_hwaddr[i]);
+		zassert_true(arp_cached(&stats_dst[i], &stats_hwaddr[i]),
+			     "%s not resolved", net_sprint_ipv4_addr(&stats_dst[i]));
+	}
+
+	/* Use the first address again, the second one becomes the least
+	 * recently used entry.
+	 */
+	pkt[2] = ipv4_pkt_alloc(iface, &stats_dst[0]);
+
+	net_arp_stats_get(&before);
+	zassert_equal(net_arp_prepare(pkt[2], &stats_dst[0], NULL), pkt[2],
+		      "cached address not resolved");
+	net_arp_stats_get(&after);
+	zassert_equal(after.hits - before.hits, 1, "hit not counted");
+	zassert_equal(after.misses - before.misses, 0, "unexpected miss");
+
+	k_msleep(10);
+
+	/* A third address takes over the least recently used entry */
+	pkt[3] = ipv4_pkt_alloc(iface, &stats_dst[2]);
+
+	net_arp_stats_get(&before);
+	arp_request(pkt[3], &stats_dst[2]);
+	net_arp_stats_get(&after);
+	zassert_equal(after.misses - before.misses, 1, "miss not counted");
+	zassert_equal(after.evictions - before.evictions, 1, "eviction not counted");
+
+	zassert_true(arp_cached(&stats_dst[0], &stats_hwaddr[0]),
+		     "most recently used entry was evicted");
+	zassert_false(arp_cached(&stats_dst[1], &stats_hwaddr[1]),
+		      "least recently used entry was kept");
+
+	net_arp_clear_cache(NULL);
+
+	for (i = 0; i < ARRAY_SIZE(pkt); i++) {
+		net_pkt_unref(pkt[i]);
+	}
+}
+
+ZTEST(arp_fn_tests, test_arp_pending_drops)
+{
+	struct net_pkt *pkt[CONFIG_NET_ARP_PENDING_MAX + 1];
+	struct net_arp_stats before, after;
+	struct net_pkt *ret;
+	struct net_if *iface;
+	int i;
+
+	Z_TEST_SKIP_IFNDEF(CONFIG_NET_L2_ETHERNET);
+
+	if (CONFIG_NET_ARP_PENDING_MAX == 0) {
+		ztest_test_skip();
+	}
+
+	iface = arp_stats_iface_setup();
+
+	net_arp_stats_get(&before);
+
+	pkt[0] = ipv4_pkt_alloc(iface, &stats_dst[0]);
+	arp_request(pkt[0], &stats_dst[0]);
+
+	/* Queue up to the limit behind the pending request */
+	for (i = 1; i < CONFIG_NET_ARP_PENDING_MAX; i++) {
+		pkt[i] = ipv4_pkt_alloc(iface, &stats_dst[0]);
+		ret = net_arp_prepare(pkt[i], &stats_dst[0], NULL);
+		zassert_is_null(ret, "packet %d not queued", i);
+	}
+
+	net_arp_stats_get(&after);
+	zassert_equal(after.pending_drops - before.pending_drops, 0,
+		      "packet dropped below the limit");
+
+	/* One more is dropped without taking a reference */
+	pkt[i] = ipv4_pkt_alloc(iface, &stats_dst[0]);
+	ret = net_arp_prepare(pkt[i], &stats_dst[0], NULL);
+	zassert_is_null(ret, "packet over the limit not dropped");
+	zassert_equal(atomic_get(&pkt[i]->atomic_ref), 1,
+		      "dropped packet still referenced");
+
+	net_arp_stats_get(&after);
+	zassert_equal(after.pending_drops - before.pending_drops, 1,
+		      "drop not counted");
+	zassert_equal(after.misses - before.misses, CONFIG_NET_ARP_PENDING_MAX + 1,
+		      "misses not counted");
+
+	/* Resolving the address flushes the queue, which is usable again */
+	arp_reply(iface, &stats_dst[0], &stats_hwaddr[0]);
+
+	for (i = 0; i < CONFIG_NET_ARP_PENDING_MAX; i++) {
+		zassert_equal(atomic_get(&pkt[i]->atomic_ref), 1,
+			      "queued packet %d not sent", i);
+	}
+
+	net_arp_clear_cache(NULL);
+
+	net_pkt_unref(pkt[0]);
+	pkt[0] = ipv4_pkt_alloc(iface, &stats_dst[0]);
+
+	net_arp_stats_get(&before);
+	arp_request(pkt[0], &stats_dst[0]);
+
+	for (i = 1; i < CONFIG_NET_ARP_PENDING_MAX; i++) {
+		zassert_is_null(net_arp_prepare(pkt[i], &stats_dst[0], NULL),
+				"packet %d not queued after a flush", i);
+	}
+
+	net_arp_stats_get(&after);
+	zassert_equal(after.pending_drops - before.pending_drops, 0,
+		      "pending count not reset by the flush");
+
+	net_arp_clear_cache(NULL);
+
+	for (i = 0; i < ARRAY_SIZE(pkt); i++) {
+		net_pkt_unref(pkt[i]);
+	}
+}
+
 ZTEST_SUITE(arp_fn_tests, NULL, NULL, NULL, NULL, NULL);
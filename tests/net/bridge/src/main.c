@@ -218,9 +218,10 @@ static void test_iface_setup(void)
 }
 
 /*
- * Simulate a packet reception from the outside world
+ * Simulate a packet reception from the outside world, to the station
+ * at dst or to an arbitrary one if dst is NULL
  */
-static void _recv_data(struct net_if *iface)
+static void _recv_data_to(struct net_if *iface, const struct net_eth_addr *dst)
 {
 	struct net_pkt *pkt;
 	struct net_eth_hdr eth_hdr;
@@ -245,6 +246,10 @@ static void _recv_data(struct net_if *iface)
 	eth_hdr.dst.addr[4] = net_if_get_by_iface(iface);
 	eth_hdr.dst.addr[5] = 0x55;
 
+	if (dst != NULL) {
+		eth_hdr.dst = *dst;
+	}
+
 	eth_hdr.src.addr[0] = 0xa2;
 	eth_hdr.src.addr[1] = 0x11;
 	eth_hdr.src.addr[2] = 0x22;
@@ -265,6 +270,11 @@ static void _recv_data(struct net_if *iface)
 	zassert_equal(ret, 0, "");
 }
 
+static void _recv_data(struct net_if *iface)
+{
+	_recv_data_to(iface, NULL);
+}
+
 static void test_recv_before_bridging(void)
 {
 	/* fake some packet reception */
@@ -352,6 +362,79 @@ static void test_recv_with_bridge(void)
 	check_free_packet_count();
 }
 
+#if CONFIG_NET_ETHERNET_BRIDGE_FDB_SIZE > 0
+/* Source address of the packets received on iface by _recv_data() */
+static void station_addr(struct net_if *iface, struct net_eth_addr *addr)
+{
+	*addr = (struct net_eth_addr){ { 0xa2, 0x11, 0x22, net_if_get_by_iface(iface),
+					 0x77, 0x88 } };
+}
+
+static void check_sent_only_on(struct net_if *iface)
+{
+	int j;
+
+	/* give time to the processing threads to run */
+	k_sleep(K_MSEC(100));
+
+	for (j = 0; j < 3; j++) {
+		struct net_pkt *pkt = eth_fake_data[j].sent_pkt;
+
+		if (eth_fake_data[j].iface != iface) {
+			zassert_is_null(pkt, "pkt sent on iface %d",
+					net_if_get_by_iface(eth_fake_data[j].iface));
+			continue;
+		}
+
+		zassert_not_null(pkt, "");
+		eth_fake_data[j].sent_pkt = NULL;
+		net_pkt_unref(pkt);
+	}
+}
+
+static void test_recv_learned(void)
+{
+	struct net_eth_addr addr;
+
+	/* The stations behind each interface were learned by now */
+	station_addr(fake_iface[0], &addr);
+	_recv_data_to(fake_iface[2], &addr);
+	check_sent_only_on(fake_iface[0]);
+
+	station_addr(fake_iface[2], &addr);
+	_recv_data_to(fake_iface[0], &addr);
+	check_sent_only_on(fake_iface[2]);
+
+	/* Not sent to a station behind an interface without TX */
+	station_addr(fake_iface[1], &addr);
+	_recv_data_to(fake_iface[0], &addr);
+	check_sent_only_on(NULL);
+
+	/* Nor back to the segment of the station */
+	station_addr(fake_iface[0], &addr);
+	_recv_data_to(fake_iface[0], &addr);
+	check_sent_only_on(NULL);
+
+	/* Forgotten stations are flooded to again */
+	eth_bridge_fdb_flush(&test_bridge, fake_iface[2]);
+	station_addr(fake_iface[2], &addr);
+	_recv_data_to(fake_iface[1], &addr);
+	k_sleep(K_MSEC(100));
+	zassert_not_null(eth_fake_data[0].sent_pkt, "");
+	zassert_not_null(eth_fake_data[2].sent_pkt, "");
+	net_pkt_unref(eth_fake_data[0].sent_pkt);
+	net_pkt_unref(eth_fake_data[2].sent_pkt);
+	eth_fake_data[0].sent_pkt = NULL;
+	eth_fake_data[2].sent_pkt = NULL;
+
+	check_free_packet_count();
+}
+#else
+static void test_recv_learned(void)
+{
+}
+#endif
+
 static void test_recv_after_bridging(void)
 {
 	int ret;
@@ -374,6 +457,7 @@ ZTEST(net_eth_bridge, test_net_eth_bridge)
 	test_recv_before_bridging();
 	test_setup_bridge();
 	test_recv_with_bridge();
+	test_recv_learned();
 	test_recv_after_bridging();
 }
 
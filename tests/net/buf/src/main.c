@@ -70,6 +70,7 @@ static void var_destroy(struct net_buf *buf);
 NET_BUF_POOL_HEAP_DEFINE(bufs_pool, 10, USER_DATA_HEAP, buf_destroy);
 NET_BUF_POOL_FIXED_DEFINE(fixed_pool, 10, 128, USER_DATA_FIXED, fixed_destroy);
 NET_BUF_POOL_VAR_DEFINE(var_pool, 10, 1024, USER_DATA_VAR, var_destroy);
+NET_BUF_POOL_FIXED_DEFINE(bulk_pool, 10, 128, USER_DATA_FIXED, NULL);
 
 static void buf_destroy(struct net_buf *buf)
 {
@@ -461,6 +462,58 @@ ZTEST(net_buf_tests, test_net_buf_var_pool)
 	zassert_equal(destroy_called, 3, "Incorrect destroy callback count");
 }
 
+ZTEST(net_buf_tests, test_net_buf_bulk)
+{
+	struct net_buf *buf, *frag;
+	int i, count;
+
+	for (i = 0; i < 3; i++) {
+		buf = net_buf_alloc_bulk(&bulk_pool, 128, bulk_pool.buf_count,
+					 K_NO_WAIT);
+		zassert_not_null(buf, "Failed to get buffers");
+
+		count = 0;
+		for (frag = buf; frag; frag = frag->frags) {
+			zassert_equal(frag->ref, 1, "Invalid reference count");
+			zassert_equal(net_buf_tailroom(frag), 128,
+				      "Invalid buffer size");
+			count++;
+		}
+
+		zassert_equal(count, bulk_pool.buf_count,
+			      "Incorrect number of buffers");
+
+		zassert_is_null(net_buf_alloc_len(&bulk_pool, 128, K_NO_WAIT),
+				"Pool should be empty");
+
+		net_buf_unref_chain_bulk(buf);
+	}
+
+	/* A partial allocation gives back what it got */
+	buf = net_buf_alloc_len(&bulk_pool, 128, K_NO_WAIT);
+	zassert_not_null(buf, "Failed to get buffer");
+
+	zassert_is_null(net_buf_alloc_bulk(&bulk_pool, 128,
+					   bulk_pool.buf_count, K_NO_WAIT),
+			"Allocation should fail");
+
+	frag = net_buf_alloc_bulk(&bulk_pool, 128, bulk_pool.buf_count - 1,
+				  K_NO_WAIT);
+	zassert_not_null(frag, "Failed to get buffers");
+
+	net_buf_frag_add(buf, frag);
+	net_buf_unref_chain_bulk(buf);
+
+	/* Still referenced fragments are kept */
+	buf = net_buf_alloc_bulk(&bulk_pool, 128, 2, K_NO_WAIT);
+	zassert_not_null(buf, "Failed to get buffers");
+	frag = net_buf_ref(buf->frags);
+
+	net_buf_unref_chain_bulk(buf);
+	zassert_equal(frag->ref, 1, "Fragment was released");
+	net_buf_unref(frag);
+}
+
 ZTEST(net_buf_tests, test_net_buf_byte_order)
 {
 	struct net_buf *buf;
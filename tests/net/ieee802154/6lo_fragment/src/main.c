@@ -493,6 +493,9 @@ static bool test_fragment(struct net_fragment_data *data)
 	}
 
 	if (!ieee802154_6lo_requires_fragmentation(pkt, 0, 0)) {
+		/* Sent as a single frame, whatever the fragments */
+		net_pkt_compact(pkt);
+
 		f_pkt = pkt;
 		pkt = NULL;
 
@@ -0,0 +1,307 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/net/capture.h>
+#include <zephyr/net/dummy.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_ip.h>
+#include <zephyr/net/net_pkt.h>
+
+#define PCAPNG_BLOCK_SHB 0x0A0D0D0A
+#define PCAPNG_BLOCK_IDB 0x00000001
+#define PCAPNG_BLOCK_EPB 0x00000006
+#define LINKTYPE_RAW 101
+
+#define SHB_LEN 28
+#define IDB_LEN 32
+/* Type, length, interface, timestamp, captured and original lengths */
+#define EPB_HDR_LEN 28
+
+#define TEST_PORT 5353
+/* Behind the IPv4 header and the ports */
+#define PAYLOAD_OFFSET 24
+
+static struct net_if *test_iface;
+static uint8_t records[CONFIG_NET_CAPTURE_RING_SIZE];
+
+static int dummy_send(const struct device *dev, struct net_pkt *pkt)
+{
+	ARG_UNUSED(dev);
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+
+static void dummy_iface_init(struct net_if *iface)
+{
+	static uint8_t mac[] = { 0x00, 0x00, 0x5E, 0x00, 0x53, 0x01 };
+
+	net_if_set_link_addr(iface, mac, sizeof(mac), NET_LINK_DUMMY);
+}
+
+static struct dummy_api dummy_api = {
+	.iface_api.init = dummy_iface_init,
+	.send = dummy_send,
+};
+
+NET_DEVICE_INIT(capture_ring_test, "capture_ring_test", NULL, NULL, NULL, NULL,
+		CONFIG_KERNEL_INIT_PRIORITY_DEFAULT, &dummy_api, DUMMY_L2,
+		NET_L2_GET_CTX_TYPE(DUMMY_L2), 1280);
+
+static uint32_t get_u32(const uint8_t *buf)
+{
+	return UNALIGNED_GET((const uint32_t *)buf);
+}
+
+/* Raw IPv4 datagram of the given transport protocol, port and total length,
+ * the payload bytes are their offset in the packet.
+ */
+static struct net_pkt *make_pkt(uint8_t proto, uint16_t port, size_t len)
+{
+	struct net_ipv4_hdr ip = {
+		.vhl = 0x45,
+		.len = htons(len),
+		.ttl = 64,
+		.proto = proto,
+		.src = { 192, 0, 2, 2 },
+		.dst = { 192, 0, 2, 1 },
+	};
+	uint16_t ports[2] = { htons(49152), htons(port) };
+	struct net_pkt *pkt;
+
+	pkt = net_pkt_rx_alloc_with_buffer(test_iface, len, AF_UNSPEC, 0,
+					   K_NO_WAIT);
+	zassert_not_null(pkt, "Cannot allocate packet");
+
+	zassert_ok(net_pkt_write(pkt, &ip, sizeof(ip)));
+	zassert_ok(net_pkt_write(pkt, ports, sizeof(ports)));
+
+	for (size_t i = PAYLOAD_OFFSET; i < len; i++) {
+		zassert_ok(net_pkt_write_u8(pkt, (uint8_t)i));
+	}
+
+	net_pkt_cursor_init(pkt);
+
+	return pkt;
+}
+
+static void capture(uint8_t proto, uint16_t port, size_t len)
+{
+	struct net_pkt *pkt = make_pkt(proto, port, len);
+
+	net_capture_ring_pkt(test_iface, pkt);
+	net_pkt_unref(pkt);
+}
+
+/* Check the Enhanced Packet Block at buf, returns its length */
+static size_t check_epb(const uint8_t *buf, size_t origlen)
+{
+	size_t caplen = MIN(origlen, CONFIG_NET_CAPTURE_RING_SNAPLEN);
+	size_t len = EPB_HDR_LEN + ROUND_UP(caplen, 4) + sizeof(uint32_t);
+	uint64_t ts;
+
+	zassert_equal(get_u32(buf), PCAPNG_BLOCK_EPB);
+	zassert_equal(get_u32(buf + 4), len);
+	zassert_equal(get_u32(buf + 8), 0, "Wrong interface id");
+	zassert_equal(get_u32(buf + 20), caplen);
+	zassert_equal(get_u32(buf + 24), origlen);
+	zassert_equal(get_u32(buf + len - 4), len, "Wrong trailing length");
+
+	ts = ((uint64_t)get_u32(buf + 12) << 32) | get_u32(buf + 16);
+	zassert_true(ts <= k_ticks_to_ns_ceil64(k_uptime_ticks()),
+		     "Timestamp in the future");
+
+	zassert_equal(buf[EPB_HDR_LEN], 0x45, "Not the captured packet");
+	for (size_t i = PAYLOAD_OFFSET; i < caplen; i++) {
+		zassert_equal(buf[EPB_HDR_LEN + i], (uint8_t)i,
+			      "Data differs at %zu", i);
+	}
+
+	return len;
+}
+
+static void *capture_ring_setup(void)
+{
+	test_iface = net_if_lookup_by_dev(DEVICE_GET(capture_ring_test));
+	zassert_not_null(test_iface);
+
+	return NULL;
+}
+
+static void capture_ring_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	zassert_ok(net_capture_ring_enable(test_iface, NULL));
+}
+
+static void capture_ring_after(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	(void)net_capture_ring_disable();
+}
+
+ZTEST(net_capture_ring, test_header)
+{
+	uint8_t buf[SHB_LEN + IDB_LEN];
+
+	zassert_equal(net_capture_ring_header(buf, sizeof(buf) - 1), -ENOBUFS);
+	zassert_equal(net_capture_ring_header(buf, sizeof(buf)), sizeof(buf));
+
+	zassert_equal(get_u32(buf), PCAPNG_BLOCK_SHB);
+	zassert_equal(get_u32(buf + 4), SHB_LEN);
+	zassert_equal(get_u32(buf + 8), 0x1A2B3C4D, "Wrong byte order magic");
+	zassert_equal(get_u32(buf + SHB_LEN - 4), SHB_LEN);
+
+	zassert_equal(get_u32(buf + SHB_LEN), PCAPNG_BLOCK_IDB);
+	zassert_equal(get_u32(buf + SHB_LEN + 4), IDB_LEN);
+	zassert_equal(UNALIGNED_GET((uint16_t *)(buf + SHB_LEN + 8)), LINKTYPE_RAW);
+	zassert_equal(get_u32(buf + SHB_LEN + 12), CONFIG_NET_CAPTURE_RING_SNAPLEN);
+	zassert_equal(get_u32(buf + SHB_LEN + IDB_LEN - 4), IDB_LEN);
+}
+
+ZTEST(net_capture_ring, test_capture_and_read)
+{
+	struct net_capture_ring_stats stats;
+	size_t offset = 0;
+	int len;
+
+	zassert_equal(net_capture_ring_read(records, sizeof(records)), 0,
+		      "Ring not empty");
+
+	capture(IPPROTO_UDP, TEST_PORT, 40);
+	capture(IPPROTO_UDP, TEST_PORT, 41);
+
+	len = net_capture_ring_read(records, sizeof(records));
+	zassert_true(len > 0, "No records (%d)", len);
+
+	offset += check_epb(records, 40);
+	offset += check_epb(records + offset, 41);
+	zassert_equal(offset, len, "Unexpected records");
+
+	zassert_equal(net_capture_ring_read(records, sizeof(records)), 0,
+		      "Records read twice");
+
+	net_capture_ring_stats_get(&stats);
+	zassert_equal(stats.captured, 2);
+	zassert_equal(stats.truncated, 0);
+	zassert_equal(stats.filtered, 0);
+	zassert_equal(stats.dropped, 0);
+}
+
+ZTEST(net_capture_ring, test_truncate)
+{
+	struct net_capture_ring_stats stats;
+	size_t origlen = CONFIG_NET_CAPTURE_RING_SNAPLEN + 37;
+	int len;
+
+	capture(IPPROTO_UDP, TEST_PORT, origlen);
+
+	len = net_capture_ring_read(records, sizeof(records));
+	zassert_equal(len, check_epb(records, origlen));
+
+	net_capture_ring_stats_get(&stats);
+	zassert_equal(stats.captured, 1);
+	zassert_equal(stats.truncated, 1);
+}
+
+ZTEST(net_capture_ring, test_filter)
+{
+	struct net_capture_filter filter = {
+		.family = AF_INET,
+		.proto = IPPROTO_UDP,
+		.port = TEST_PORT,
+	};
+	struct net_capture_ring_stats stats;
+	int len;
+
+	zassert_ok(net_capture_ring_enable(test_iface, &filter));
+
+	capture(IPPROTO_UDP, TEST_PORT + 1, 40);
+	capture(IPPROTO_TCP, TEST_PORT, 40);
+	capture(IPPROTO_UDP, TEST_PORT, 42);
+
+	len = net_capture_ring_read(records, sizeof(records));
+	zassert_equal(len, check_epb(records, 42), "Wrong packet captured");
+
+	net_capture_ring_stats_get(&stats);
+	zassert_equal(stats.captured, 1);
+	zassert_equal(stats.filtered, 2);
+}
+
+ZTEST(net_capture_ring, test_ring_full)
+{
+	struct net_capture_ring_stats stats;
+	size_t offset = 0;
+	int count = 0;
+	int len;
+
+	/* Records in the ring are kept, the new packets are dropped */
+	for (int i = 0; i < 20; i++) {
+		capture(IPPROTO_UDP, TEST_PORT, 40);
+	}
+
+	net_capture_ring_stats_get(&stats);
+	zassert_true(stats.dropped > 0, "Ring never full");
+	zassert_equal(stats.captured + stats.dropped, 20);
+
+	len = net_capture_ring_read(records, sizeof(records));
+	while (offset < len) {
+		offset += check_epb(records + offset, 40);
+		count++;
+	}
+
+	zassert_equal(count, stats.captured, "Records lost");
+
+	/* Room is made by reading */
+	capture(IPPROTO_UDP, TEST_PORT, 40);
+	len = net_capture_ring_read(records, sizeof(records));
+	zassert_equal(len, check_epb(records, 40));
+}
+
+ZTEST(net_capture_ring, test_read_short_buffer)
+{
+	size_t epb_len = EPB_HDR_LEN + 40 + sizeof(uint32_t);
+	int len;
+
+	capture(IPPROTO_UDP, TEST_PORT, 40);
+	capture(IPPROTO_UDP, TEST_PORT, 40);
+
+	/* Only whole records are read, the rest stays for the next read */
+	zassert_equal(net_capture_ring_read(records, epb_len - 1), -ENOBUFS);
+
+	len = net_capture_ring_read(records, epb_len + 1);
+	zassert_equal(len, check_epb(records, 40));
+
+	len = net_capture_ring_read(records, sizeof(records));
+	zassert_equal(len, check_epb(records, 40));
+}
+
+ZTEST(net_capture_ring, test_disable)
+{
+	int len;
+
+	capture(IPPROTO_UDP, TEST_PORT, 40);
+
+	zassert_ok(net_capture_ring_disable());
+	zassert_equal(net_capture_ring_disable(), -EALREADY);
+
+	/* Not captured anymore, the records already there are kept */
+	capture(IPPROTO_UDP, TEST_PORT, 44);
+
+	len = net_capture_ring_read(records, sizeof(records));
+	zassert_equal(len, check_epb(records, 40));
+}
+
+ZTEST(net_capture_ring, test_enable_invalid)
+{
+	zassert_equal(net_capture_ring_enable(NULL, NULL), -EINVAL);
+}
+
+ZTEST_SUITE(net_capture_ring, NULL, capture_ring_setup, capture_ring_before,
+	    capture_ring_after, NULL);
@@ -1110,6 +1110,70 @@ ZTEST(coap, test_build_options_out_of_order_0)
 			  "Built packet doesn't match reference packet");
 }
 
+ZTEST(coap, test_build_options_unordered)
+{
+	struct coap_option options[] = {
+		{ .delta = COAP_OPTION_CONTENT_FORMAT, .len = 1, .value = { 60 } },
+		{ .delta = COAP_OPTION_URI_PATH, .len = 3, .value = { 'o', 'n', 'e' } },
+		{ .delta = COAP_OPTION_BLOCK2, .len = 1, .value = { 0x19 } },
+		{ .delta = COAP_OPTION_OBSERVE, .len = 0 },
+		{ .delta = COAP_OPTION_URI_PATH, .len = 3, .value = { 't', 'w', 'o' } },
+	};
+	struct coap_packet cpkt;
+	struct coap_packet ref;
+	struct coap_option found[2];
+	static const char token[] = "token";
+	uint8_t *data = data_buf[0];
+	int r;
+
+	r = coap_packet_init(&cpkt, data, COAP_BUF_SIZE, COAP_VERSION_1, COAP_TYPE_CON,
+			     strlen(token), token, COAP_METHOD_GET, 0x1234);
+	zassert_equal(r, 0, "Could not initialize packet");
+
+	r = coap_packet_append_options(&cpkt, options, ARRAY_SIZE(options));
+	zassert_equal(r, 0, "Could not append options");
+
+	r = coap_packet_init(&ref, data_buf[1], COAP_BUF_SIZE, COAP_VERSION_1, COAP_TYPE_CON,
+			     strlen(token), token, COAP_METHOD_GET, 0x1234);
+	zassert_equal(r, 0, "Could not initialize packet");
+
+	r = coap_packet_append_option(&ref, COAP_OPTION_OBSERVE, NULL, 0);
+	zassert_equal(r, 0, "Could not append option");
+	r = coap_packet_append_option(&ref, COAP_OPTION_URI_PATH, "one", 3);
+	zassert_equal(r, 0, "Could not append option");
+	r = coap_packet_append_option(&ref, COAP_OPTION_URI_PATH, "two", 3);
+	zassert_equal(r, 0, "Could not append option");
+	r = coap_append_option_int(&ref, COAP_OPTION_CONTENT_FORMAT, 60);
+	zassert_equal(r, 0, "Could not append option");
+	r = coap_append_option_int(&ref, COAP_OPTION_BLOCK2, 0x19);
+	zassert_equal(r, 0, "Could not append option");
+
+	zassert_equal(cpkt.offset, ref.offset, "Wrong data size");
+	zassert_mem_equal(cpkt.data, ref.data, ref.offset,
+			  "Built packet doesn't match reference packet");
+
+	r = coap_packet_parse(&cpkt, data, cpkt.offset, NULL, 0);
+	zassert_equal(r, 0, "Could not parse packet");
+
+	r = coap_find_options(&cpkt, COAP_OPTION_URI_PATH, found, ARRAY_SIZE(found));
+	zassert_equal(r, 2, "Could not find options");
+	zassert_mem_equal(found[0].value, "one", 3, "Wrong option content");
+	zassert_mem_equal(found[1].value, "two", 3, "Wrong option content");
+
+	r = coap_find_options(&cpkt, COAP_OPTION_OBSERVE, found, 1);
+	zassert_equal(r, 1, "Could not find option");
+	zassert_equal(found[0].len, 0, "Wrong option len");
+
+	r = coap_get_option_int(&cpkt, COAP_OPTION_CONTENT_FORMAT);
+	zassert_equal(r, 60, "Wrong option content");
+
+	r = coap_get_option_int(&cpkt, COAP_OPTION_BLOCK2);
+	zassert_equal(r, 0x19, "Wrong option content");
+
+	r = coap_find_options(&cpkt, COAP_OPTION_ACCEPT, found, 1);
+	zassert_equal(r, 0, "Found unexpected option");
+}
+
 #define ASSERT_OPTIONS(cpkt, expected_opt_len, expected_data, expected_data_len)                   \
 	do {                                                                                       \
 		static const uint8_t expected_hdr_len = 9;                                         \
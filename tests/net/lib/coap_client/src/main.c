@@ -396,3 +396,261 @@ ZTEST(coap_client, test_unmatching_tokens)
 		      last_response_code);
 	k_sleep(K_MSEC(1));
 }
+
+#if CONFIG_COAP_CLIENT_BLOCK_WINDOW > 1
+#define WINDOW_BLOCK_SIZE    16
+#define WINDOW_RESOURCE_LEN  120
+#define WINDOW_BLOCKS        DIV_ROUND_UP(WINDOW_RESOURCE_LEN, WINDOW_BLOCK_SIZE)
+#define WINDOW_MAX_RESPONSES 16
+#define WINDOW_MSG_LEN       64
+
+enum window_server_mode {
+	WINDOW_IN_ORDER,
+	WINDOW_REVERSED,   /* Latest response first */
+	WINDOW_DUPLICATED, /* Every response repeated as a NON message */
+};
+
+static enum window_server_mode window_mode;
+static int window_drop_block;
+static int window_requests[WINDOW_BLOCKS];
+
+static uint8_t window_responses[WINDOW_MAX_RESPONSES][WINDOW_MSG_LEN];
+static size_t window_response_len[WINDOW_MAX_RESPONSES];
+static int window_response_count;
+
+static uint8_t window_resource[WINDOW_RESOURCE_LEN];
+static uint8_t window_received[WINDOW_RESOURCE_LEN];
+static size_t window_received_len;
+static int window_callbacks;
+static int window_errors;
+static bool window_last;
+
+static void window_queue_response(uint8_t type, uint16_t id, const uint8_t *token, uint8_t tkl,
+				  uint32_t num)
+{
+	size_t offset = num * WINDOW_BLOCK_SIZE;
+	size_t len = MIN(WINDOW_BLOCK_SIZE, WINDOW_RESOURCE_LEN - offset);
+	bool more = offset + len < WINDOW_RESOURCE_LEN;
+	struct coap_packet response;
+	int i = window_response_count;
+
+	if (i == WINDOW_MAX_RESPONSES ||
+	    coap_packet_init(&response, window_responses[i], WINDOW_MSG_LEN, COAP_VERSION_1,
+			     type, tkl, token, COAP_RESPONSE_CODE_CONTENT, id) < 0 ||
+	    coap_append_option_int(&response, COAP_OPTION_BLOCK2,
+				   (num << 4) | (more ? 0x08 : 0x00)) < 0 ||
+	    coap_append_option_int(&response, COAP_OPTION_SIZE2, WINDOW_RESOURCE_LEN) < 0 ||
+	    coap_packet_append_payload_marker(&response) < 0 ||
+	    coap_packet_append_payload(&response, &window_resource[offset], len) < 0) {
+		LOG_ERR("Cannot queue response to block %u", num);
+		window_errors++;
+		return;
+	}
+
+	window_response_len[i] = response.offset;
+	window_response_count++;
+}
+
+/* Serves the resource in blocks of WINDOW_BLOCK_SIZE bytes */
+static ssize_t z_impl_zsock_sendto_window_fake(int sock, void *buf, size_t len, int flags,
+					       const struct sockaddr *dest_addr, socklen_t addrlen)
+{
+	uint8_t data[WINDOW_MSG_LEN];
+	uint8_t token[COAP_TOKEN_MAX_LEN];
+	struct coap_packet request;
+	uint8_t tkl;
+	uint16_t id;
+	uint32_t num = 0;
+	int block2;
+
+	memcpy(data, buf, MIN(len, sizeof(data)));
+	if (len > sizeof(data) ||
+	    coap_packet_parse(&request, data, len, NULL, 0) < 0) {
+		LOG_ERR("Invalid request");
+		window_errors++;
+		return len;
+	}
+
+	/* Ignore the client's ACKs and resets */
+	if (coap_header_get_type(&request) != COAP_TYPE_CON) {
+		return len;
+	}
+
+	tkl = coap_header_get_token(&request, token);
+	id = coap_header_get_id(&request);
+	block2 = coap_get_option_int(&request, COAP_OPTION_BLOCK2);
+	if (block2 > 0) {
+		num = block2 >> 4;
+	}
+
+	if (num >= WINDOW_BLOCKS) {
+		LOG_ERR("Request for block %u beyond the resource", num);
+		window_errors++;
+		return len;
+	}
+
+	window_requests[num]++;
+	if ((int)num == window_drop_block && window_requests[num] == 1) {
+		LOG_INF("Losing request for block %u", num);
+		return len;
+	}
+
+	window_queue_response(COAP_TYPE_ACK, id, token, tkl, num);
+	if (window_mode == WINDOW_DUPLICATED) {
+		window_queue_response(COAP_TYPE_NON_CON, id ^ 0x8000, token, tkl, num);
+	}
+
+	set_socket_events(ZSOCK_POLLIN);
+
+	return len;
+}
+
+static ssize_t z_impl_zsock_recvfrom_window_fake(int sock, void *buf, size_t max_len, int flags,
+						 struct sockaddr *src_addr, socklen_t *addrlen)
+{
+	int i = (window_mode == WINDOW_REVERSED) ? window_response_count - 1 : 0;
+	size_t len;
+
+	if (window_response_count == 0) {
+		clear_socket_events();
+		errno = EAGAIN;
+		return -1;
+	}
+
+	len = MIN(window_response_len[i], max_len);
+	memcpy(buf, window_responses[i], len);
+
+	window_response_count--;
+	memmove(&window_responses[i], &window_responses[i + 1],
+		(window_response_count - i) * WINDOW_MSG_LEN);
+	memmove(&window_response_len[i], &window_response_len[i + 1],
+		(window_response_count - i) * sizeof(window_response_len[0]));
+
+	if (window_response_count == 0) {
+		clear_socket_events();
+	}
+
+	return len;
+}
+
+static void window_callback(int16_t code, size_t offset, const uint8_t *payload, size_t len,
+			    bool last_block, void *user_data)
+{
+	window_callbacks++;
+
+	if (code != COAP_RESPONSE_CODE_CONTENT || window_last ||
+	    offset != window_received_len || offset + len > sizeof(window_received)) {
+		LOG_ERR("Unexpected block: code %d offset %zu len %zu", code, offset, len);
+		window_errors++;
+		return;
+	}
+
+	memcpy(&window_received[offset], payload, len);
+	window_received_len += len;
+	window_last = last_block;
+}
+
+static void window_setup(void *data)
+{
+	/* Let the requests of the previous tests end */
+	clear_socket_events();
+	for (int i = 0; i < CONFIG_COAP_CLIENT_MAX_REQUESTS; i++) {
+		for (int t = 0; t < 100 && client.requests[i].request_ongoing; t++) {
+			k_sleep(K_MSEC(100));
+		}
+	}
+
+	DO_FOREACH_FAKE(RESET_FAKE);
+	FFF_RESET_HISTORY();
+
+	z_impl_zsock_recvfrom_fake.custom_fake = z_impl_zsock_recvfrom_window_fake;
+	z_impl_zsock_sendto_fake.custom_fake = z_impl_zsock_sendto_window_fake;
+
+	for (int i = 0; i < WINDOW_RESOURCE_LEN; i++) {
+		window_resource[i] = (uint8_t)(i * 7 + 1);
+	}
+
+	window_mode = WINDOW_IN_ORDER;
+	window_drop_block = -1;
+	window_response_count = 0;
+	memset(window_requests, 0, sizeof(window_requests));
+	memset(window_received, 0, sizeof(window_received));
+	window_received_len = 0;
+	window_callbacks = 0;
+	window_errors = 0;
+	window_last = false;
+}
+
+static void window_download(k_timeout_t duration)
+{
+	struct sockaddr address = {0};
+	struct coap_client_request client_request = {
+		.method = COAP_METHOD_GET,
+		.confirmable = true,
+		.path = test_path,
+		.fmt = COAP_CONTENT_FORMAT_TEXT_PLAIN,
+		.cb = window_callback,
+		.payload = NULL,
+		.len = 0
+	};
+	int ret;
+
+	ret = coap_client_req(&client, 0, &address, &client_request, -1);
+	zassert_true(ret >= 0, "Sending request failed, %d", ret);
+
+	k_sleep(duration);
+
+	zassert_equal(window_errors, 0, "Unexpected blocks or requests");
+	zassert_true(window_last, "Last block not received");
+	zassert_equal(window_callbacks, WINDOW_BLOCKS, "Each block must be delivered once");
+	zassert_equal(window_received_len, WINDOW_RESOURCE_LEN);
+	zassert_mem_equal(window_received, window_resource, WINDOW_RESOURCE_LEN);
+}
+
+ZTEST_SUITE(coap_client_window, NULL, NULL, window_setup, NULL, NULL);
+
+ZTEST(coap_client_window, test_window_out_of_order)
+{
+	/* The blocks requested ahead are answered in reverse order and must be
+	 * held back until the preceding ones are delivered.
+	 */
+	window_mode = WINDOW_REVERSED;
+
+	window_download(K_MSEC(1000));
+
+	for (int i = 0; i < WINDOW_BLOCKS; i++) {
+		zassert_equal(window_requests[i], 1, "Block %d requested %d times", i,
+			      window_requests[i]);
+	}
+}
+
+ZTEST(coap_client_window, test_window_duplicates)
+{
+	window_mode = WINDOW_DUPLICATED;
+
+	window_download(K_MSEC(1000));
+
+	for (int i = 0; i < WINDOW_BLOCKS; i++) {
+		zassert_equal(window_requests[i], 1, "Block %d requested %d times", i,
+			      window_requests[i]);
+	}
+}
+
+ZTEST(coap_client_window, test_window_retransmission)
+{
+	/* The request for block 2 is lost once, the blocks after it wait for
+	 * its retransmission.
+	 */
+	window_drop_block = 2;
+
+	window_download(K_MSEC(CONFIG_COAP_INIT_ACK_TIMEOUT_MS + 1000));
+
+	zassert_equal(window_requests[2], 2, "Block 2 not retransmitted");
+	for (int i = 0; i < WINDOW_BLOCKS; i++) {
+		if (i != 2) {
+			zassert_equal(window_requests[i], 1, "Block %d requested %d times", i,
+				      window_requests[i]);
+		}
+	}
+}
+#endif /* CONFIG_COAP_CLIENT_BLOCK_WINDOW > 1 */
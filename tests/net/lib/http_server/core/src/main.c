@@ -0,0 +1,239 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+
+#include <zephyr/ztest.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/net/http/server.h>
+
+#define INDEX_HTML "<html><body>Hello</body></html>"
+
+static uint16_t test_http_service_port;
+HTTP_SERVICE_DEFINE(test_http_service, "127.0.0.1", &test_http_service_port, 1, 2, NULL);
+
+static struct http_resource_detail_static index_detail = {
+	.common = {
+		.bitmask_of_supported_http_methods = BIT(HTTP_GET) | BIT(HTTP_HEAD),
+		.type = HTTP_RESOURCE_TYPE_STATIC,
+		.content_type = "text/html",
+	},
+	.static_data = INDEX_HTML,
+	.static_data_len = sizeof(INDEX_HTML) - 1,
+};
+HTTP_RESOURCE_DEFINE(index_resource, test_http_service, "/", &index_detail);
+
+static int echo_cb(struct http_client_ctx *client, const uint8_t *data, size_t len, bool final,
+		   void *user_data)
+{
+	ARG_UNUSED(user_data);
+
+	if (final) {
+		return 0;
+	}
+
+	return http_server_send_chunk(client, data, len);
+}
+
+static struct http_resource_detail_dynamic echo_detail = {
+	.common = {
+		.bitmask_of_supported_http_methods = BIT(HTTP_POST),
+		.type = HTTP_RESOURCE_TYPE_DYNAMIC,
+	},
+	.cb = echo_cb,
+};
+HTTP_RESOURCE_DEFINE(echo_resource, test_http_service, "/echo", &echo_detail);
+
+static int client_fd = -1;
+static char response[512];
+
+static void client_connect(void)
+{
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(test_http_service_port),
+	};
+	struct timeval timeo = {
+		.tv_sec = 1,
+	};
+
+	zassert_equal(zsock_inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr), 1);
+
+	client_fd = zsock_socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	zassert_true(client_fd >= 0, "socket failed (%d)", errno);
+	zassert_ok(zsock_setsockopt(client_fd, SOL_SOCKET, SO_RCVTIMEO, &timeo, sizeof(timeo)));
+	zassert_ok(zsock_connect(client_fd, (struct sockaddr *)&addr, sizeof(addr)));
+}
+
+static void client_send(const char *request)
+{
+	zassert_equal(zsock_send(client_fd, request, strlen(request), 0), strlen(request));
+}
+
+static int count_occurrences(const char *str, const char *sub)
+{
+	int count = 0;
+
+	while ((str = strstr(str, sub)) != NULL) {
+		str += strlen(sub);
+		count++;
+	}
+
+	return count;
+}
+
+/* Receive until @p end was received @p count times, the connection closes or times out */
+static size_t client_recv_until(const char *end, int count)
+{
+	size_t total = 0;
+	ssize_t len;
+
+	response[0] = '\0';
+
+	while (total < sizeof(response) - 1) {
+		len = zsock_recv(client_fd, response + total, sizeof(response) - 1 - total, 0);
+		if (len <= 0) {
+			break;
+		}
+
+		total += len;
+		response[total] = '\0';
+
+		if (end != NULL && count_occurrences(response, end) >= count) {
+			break;
+		}
+	}
+
+	return total;
+}
+
+static void *http_server_core_setup(void)
+{
+	zassert_ok(http_server_start());
+	zassert_not_equal(test_http_service_port, 0, "ephemeral port not reported");
+
+	return NULL;
+}
+
+static void http_server_core_after(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	if (client_fd >= 0) {
+		zsock_close(client_fd);
+		client_fd = -1;
+	}
+
+	/* Let the server release the connection */
+	k_msleep(100);
+}
+
+static void http_server_core_teardown(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	zassert_ok(http_server_stop());
+}
+
+ZTEST(http_server_core, test_static_keep_alive)
+{
+	client_connect();
+
+	/* Two pipelined requests on a persistent connection */
+	client_send("GET / HTTP/1.1\r\nHost: 127.0.0.1\r\n\r\n"
+		    "GET /?q=1 HTTP/1.1\r\nHost: 127.0.0.1\r\n\r\n");
+
+	client_recv_until(INDEX_HTML, 2);
+
+	zassert_equal(count_occurrences(response, "HTTP/1.1 200 OK\r\n"), 2, "%s", response);
+	zassert_equal(count_occurrences(response, "Content-Type: text/html\r\n"), 2);
+	zassert_equal(count_occurrences(response, "Content-Length: 31\r\n"), 2);
+	zassert_equal(count_occurrences(response, INDEX_HTML), 2);
+	zassert_is_null(strstr(response, "Connection: close"));
+}
+
+ZTEST(http_server_core, test_connection_close)
+{
+	client_connect();
+
+	client_send("HEAD / HTTP/1.1\r\nConnection: close\r\n\r\n");
+
+	/* The server closes the connection after the response */
+	client_recv_until(NULL, 0);
+
+	zassert_true(strncmp(response, "HTTP/1.1 200 OK\r\n", 17) == 0, "%s", response);
+	zassert_not_null(strstr(response, "Connection: close\r\n"));
+	zassert_is_null(strstr(response, INDEX_HTML));
+}
+
+ZTEST(http_server_core, test_errors)
+{
+	client_connect();
+
+	client_send("GET /missing HTTP/1.1\r\n\r\n");
+	client_recv_until("\r\n\r\n", 1);
+	zassert_true(strncmp(response, "HTTP/1.1 404 Not Found\r\n", 24) == 0, "%s", response);
+
+	client_send("POST / HTTP/1.1\r\nContent-Length: 0\r\n\r\n");
+	client_recv_until("\r\n\r\n", 1);
+	zassert_true(strncmp(response, "HTTP/1.1 405 Method Not Allowed\r\n", 33) == 0, "%s",
+		     response);
+}
+
+ZTEST(http_server_core, test_dynamic_chunked)
+{
+	client_connect();
+
+	client_send("POST /echo HTTP/1.1\r\n"
+		    "Transfer-Encoding: chunked\r\n\r\n"
+		    "5\r\nhello\r\n0\r\n\r\n");
+
+	client_recv_until("0\r\n\r\n", 1);
+
+	zassert_true(strncmp(response, "HTTP/1.1 200 OK\r\n", 17) == 0, "%s", response);
+	zassert_not_null(strstr(response, "Transfer-Encoding: chunked\r\n"));
+	zassert_not_null(strstr(response, "\r\n\r\n5\r\nhello\r\n0\r\n\r\n"));
+}
+
+ZTEST(http_server_core, test_dynamic_http_1_0)
+{
+	client_connect();
+
+	client_send("POST /echo HTTP/1.0\r\n"
+		    "Connection: keep-alive\r\n"
+		    "Content-Length: 5\r\n\r\n"
+		    "hello");
+
+	/* An identity body delimited by the server closing the connection */
+	client_recv_until(NULL, 0);
+
+	zassert_true(strncmp(response, "HTTP/1.1 200 OK\r\n", 17) == 0, "%s", response);
+	zassert_is_null(strstr(response, "Transfer-Encoding"), "%s", response);
+	zassert_not_null(strstr(response, "Connection: close\r\n"), "%s", response);
+	zassert_not_null(strstr(response, "\r\n\r\nhello"), "%s", response);
+	zassert_is_null(strstr(response, "0\r\n\r\n"), "%s", response);
+}
+
+ZTEST(http_server_core, test_service_busy)
+{
+	int first_fd;
+
+	/* The service accepts a single concurrent client */
+	client_connect();
+	first_fd = client_fd;
+	client_send("GET / HTTP/1.1\r\n\r\n");
+	client_recv_until(INDEX_HTML, 1);
+
+	client_connect();
+	client_recv_until(NULL, 0);
+	zassert_true(strncmp(response, "HTTP/1.1 503 Service Unavailable\r\n", 34) == 0, "%s",
+		     response);
+
+	zsock_close(first_fd);
+}
+
+ZTEST_SUITE(http_server_core, NULL, http_server_core_setup, NULL, http_server_core_after,
+	    http_server_core_teardown);
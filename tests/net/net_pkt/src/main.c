@@ -1239,4 +1239,88 @@ ZTEST(net_pkt_test_suite, test_net_pkt_shallow_clone_append_buf_2)
 	test_net_pkt_shallow_clone_append_buf(2);
 }
 
+#if defined(CONFIG_NET_PKT_ALLOC_STATS)
+ZTEST(net_pkt_test_suite, test_net_pkt_alloc_stats)
+{
+	struct net_pkt_alloc_stats stats;
+	struct net_pkt *pkt;
+
+	net_pkt_clear_alloc_stats();
+
+	pkt = net_pkt_alloc_with_buffer(eth_if, 20, AF_UNSPEC, 0, K_NO_WAIT);
+	zassert_not_null(pkt, "Pkt not allocated");
+	net_pkt_unref(pkt);
+
+	pkt = net_pkt_rx_alloc_with_buffer(eth_if, 1000, AF_UNSPEC, 0,
+					   K_NO_WAIT);
+	zassert_not_null(pkt, "Pkt not allocated");
+	net_pkt_compact(pkt);
+	net_pkt_unref(pkt);
+
+	net_pkt_get_alloc_stats(&stats);
+
+	zassert_equal(stats.tx.allocs, 1, "Invalid TX allocations");
+	zassert_equal(stats.rx.allocs, 1, "Invalid RX allocations");
+	zassert_equal(stats.tx_data.allocs, 1, "Invalid TX data allocations");
+	zassert_equal(stats.rx_data.allocs, 1, "Invalid RX data allocations");
+	zassert_equal(stats.tx.failures + stats.rx.failures, 0, "Failures");
+	zassert_equal(stats.tx.count, CONFIG_NET_PKT_TX_COUNT, "Invalid count");
+	zassert_true(stats.tx.high_water >= 1, "Invalid high water mark");
+	zassert_true(stats.rx_data.high_water >= 1, "Invalid high water mark");
+	zassert_equal(stats.size_hist[0], 1, "Invalid size histogram");
+	zassert_equal(stats.size_hist[5], 1, "Invalid size histogram");
+	zassert_true(stats.data_frags >= 2, "Invalid buffer count");
+	zassert_equal(stats.compactions, 1, "Invalid compaction count");
+
+	net_pkt_clear_alloc_stats();
+	net_pkt_get_alloc_stats(&stats);
+
+	zassert_equal(stats.tx.allocs, 0, "Statistics not cleared");
+}
+#endif /* CONFIG_NET_PKT_ALLOC_STATS */
+
+#if CONFIG_NET_BUF_LARGE_DATA_SIZE > 0
+ZTEST(net_pkt_test_suite, test_net_pkt_large_pools)
+{
+	struct net_pkt *pkts[CONFIG_NET_BUF_LARGE_TX_COUNT];
+	struct net_buf_pool *tx_data, *tx_large;
+	struct net_pkt *pkt;
+	int i;
+
+	net_pkt_get_info(NULL, NULL, NULL, &tx_data);
+	net_pkt_get_large_info(NULL, &tx_large);
+
+	/* Small allocations use the small fragments */
+	pkt = net_pkt_alloc_with_buffer(eth_if, 20, AF_UNSPEC, 0, K_NO_WAIT);
+	zassert_not_null(pkt, "Pkt not allocated");
+	zassert_equal(net_buf_pool_get(pkt->buffer->pool_id), tx_data,
+		      "Small fragment expected");
+	zassert_is_null(pkt->buffer->frags, "Single fragment expected");
+	net_pkt_unref(pkt);
+
+	/* Large ones use the large fragments while there are some left */
+	for (i = 0; i < ARRAY_SIZE(pkts); i++) {
+		pkts[i] = net_pkt_alloc_with_buffer(eth_if, 1000, AF_UNSPEC, 0,
+						    K_NO_WAIT);
+		zassert_not_null(pkts[i], "Pkt not allocated");
+		zassert_equal(net_buf_pool_get(pkts[i]->buffer->pool_id),
+			      tx_large, "Large fragment expected");
+		zassert_is_null(pkts[i]->buffer->frags,
+				"Single fragment expected");
+	}
+
+	pkt = net_pkt_alloc_with_buffer(eth_if, 1000, AF_UNSPEC, 0, K_NO_WAIT);
+	zassert_not_null(pkt, "Pkt not allocated");
+	zassert_equal(net_buf_pool_get(pkt->buffer->pool_id), tx_data,
+		      "Small fragments expected");
+	zassert_true(net_pkt_available_buffer(pkt) >= 1000,
+		     "Not enough buffer space");
+	net_pkt_unref(pkt);
+
+	for (i = 0; i < ARRAY_SIZE(pkts); i++) {
+		net_pkt_unref(pkts[i]);
+	}
+}
+#endif /* CONFIG_NET_BUF_LARGE_DATA_SIZE > 0 */
+
 ZTEST_SUITE(net_pkt_test_suite, NULL, NULL, NULL, NULL, NULL);
@@ -1161,6 +1161,55 @@ ZTEST(net_socket_tcp, test_so_type)
 		      "Not all TCP contexts properly cleaned up");
 }
 
+ZTEST(net_socket_tcp, test_tcp_congestion)
+{
+	struct sockaddr_in bind_addr4;
+	char name[16];
+	socklen_t optlen = sizeof(name);
+	int sock, rv;
+
+	prepare_sock_tcp_v4(MY_IPV4_ADDR, ANY_PORT, &sock, &bind_addr4);
+
+	rv = getsockopt(sock, IPPROTO_TCP, TCP_CONGESTION, name, &optlen);
+	zassert_equal(rv, 0, "getsockopt failed (%d)", errno);
+	zassert_equal(strcmp(name, CONFIG_NET_TCP_CA_DEFAULT), 0,
+		      "getsockopt got invalid name %s", name);
+	zassert_equal(optlen, strlen(name) + 1, "getsockopt got invalid size");
+
+	/* The name does not need to be terminated */
+	rv = setsockopt(sock, IPPROTO_TCP, TCP_CONGESTION, "reno", 4);
+	zassert_equal(rv, 0, "setsockopt failed (%d)", errno);
+
+	rv = setsockopt(sock, IPPROTO_TCP, TCP_CONGESTION, "unknown",
+			sizeof("unknown"));
+	zassert_equal(rv, -1, "setsockopt succeeded");
+	zassert_equal(errno, ENOENT, "setsockopt got invalid errno (%d)", errno);
+
+	if (IS_ENABLED(CONFIG_NET_TCP_CA_CUBIC)) {
+		rv = setsockopt(sock, IPPROTO_TCP, TCP_CONGESTION, "cubic",
+				sizeof("cubic"));
+		zassert_equal(rv, 0, "setsockopt failed (%d)", errno);
+	}
+
+	if (IS_ENABLED(CONFIG_NET_TCP_CA_BBR)) {
+		rv = setsockopt(sock, IPPROTO_TCP, TCP_CONGESTION, "bbr",
+				sizeof("bbr"));
+		zassert_equal(rv, 0, "setsockopt failed (%d)", errno);
+
+		optlen = sizeof(name);
+		rv = getsockopt(sock, IPPROTO_TCP, TCP_CONGESTION, name, &optlen);
+		zassert_equal(rv, 0, "getsockopt failed (%d)", errno);
+		zassert_equal(strcmp(name, "bbr"), 0,
+			      "getsockopt got invalid name %s", name);
+	}
+
+	test_close(sock);
+
+	zassert_equal(wait_for_n_tcp_contexts(0, TCP_TEARDOWN_TIMEOUT),
+		      0,
+		      "Not all TCP contexts properly cleaned up");
+}
+
 ZTEST(net_socket_tcp, test_so_protocol)
 {
 	struct sockaddr_in bind_addr4;
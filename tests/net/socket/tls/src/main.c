@@ -11,6 +11,7 @@ LOG_MODULE_REGISTER(net_test, CONFIG_NET_SOCKETS_LOG_LEVEL);
 #include <fcntl.h>
 #include <zephyr/net/socket.h>
 #include <zephyr/net/tls_credentials.h>
+#include <zephyr/settings/settings.h>
 
 #include "../../socket_helpers.h"
 
@@ -645,4 +646,306 @@ ZTEST(net_socket_tls, test_close_while_accept)
 	zassert_equal(errno, EINTR, "Unexpected errno value: %d", errno);
 }
 
+#if defined(CONFIG_NET_SOCKETS_TLS_HANDSHAKE_WORKQ)
+/* Start the handshake of a non-blocking client on the work queue */
+static void handshake_workq_connect(int *c_sock, struct sockaddr_in *s_saddr)
+{
+	struct sockaddr_in c_saddr;
+
+	prepare_sock_tls_v4(MY_IPV4_ADDR, ANY_PORT, c_sock, &c_saddr, IPPROTO_TLS_1_2);
+
+	test_config_psk(-1, *c_sock);
+
+	zassert_ok(fcntl(*c_sock, F_SETFL, O_NONBLOCK), "fcntl failed");
+
+	zassert_equal(connect(*c_sock, (struct sockaddr *)s_saddr, sizeof(*s_saddr)), -1,
+		      "connect did not return an error");
+	zassert_equal(errno, EINPROGRESS, "Unexpected errno value: %d", errno);
+}
+
+ZTEST(net_socket_tls, test_v4_handshake_workq)
+{
+	struct sockaddr_in s_saddr = { 0 };
+	struct pollfd fds;
+	struct sockaddr addr;
+	socklen_t addrlen = sizeof(addr);
+	uint8_t rx_buf[sizeof(TEST_STR_SMALL) - 1];
+	socklen_t optlen = sizeof(int);
+	int optval;
+	int c_sock;
+	int s_sock;
+	int new_sock;
+
+	prepare_sock_tls_v4(MY_IPV4_ADDR, SERVER_PORT + 1, &s_sock, &s_saddr, IPPROTO_TLS_1_2);
+
+	test_config_psk(s_sock, -1);
+
+	test_bind(s_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+	test_listen(s_sock);
+
+	handshake_workq_connect(&c_sock, &s_saddr);
+
+	/* The server has not answered yet */
+	zassert_equal(send(c_sock, TEST_STR_SMALL, sizeof(rx_buf), 0), -1,
+		      "send did not fail during the handshake");
+	zassert_equal(errno, EAGAIN, "Unexpected errno value: %d", errno);
+
+	test_accept(s_sock, &new_sock, &addr, &addrlen);
+
+	fds.fd = c_sock;
+	fds.events = POLLOUT;
+	fds.revents = 0;
+	zassert_equal(poll(&fds, 1, 1000), 1, "handshake not done");
+	zassert_equal(fds.revents, POLLOUT, "Unexpected revents 0x%x", fds.revents);
+
+	zassert_ok(getsockopt(c_sock, SOL_SOCKET, SO_ERROR, &optval, &optlen),
+		   "getsockopt failed (%d)", errno);
+	zassert_equal(optval, 0, "Unexpected SO_ERROR %d", optval);
+
+	test_send(c_sock, TEST_STR_SMALL, sizeof(rx_buf), 0);
+
+	zassert_equal(recv(new_sock, rx_buf, sizeof(rx_buf), MSG_WAITALL), sizeof(rx_buf),
+		      "Invalid length received");
+	zassert_mem_equal(rx_buf, TEST_STR_SMALL, sizeof(rx_buf), "Invalid data received");
+
+	test_close(new_sock);
+	test_close(c_sock);
+	test_close(s_sock);
+	k_sleep(TCP_TEARDOWN_TIMEOUT);
+}
+
+ZTEST(net_socket_tls, test_v4_handshake_workq_fail)
+{
+	struct sockaddr_in s_saddr = { 0 };
+	struct pollfd fds;
+	socklen_t optlen = sizeof(int);
+	uint32_t start;
+	int optval;
+	int c_sock;
+	int s_sock;
+
+	/* The connections are never accepted, so the server never answers */
+	prepare_sock_tls_v4(MY_IPV4_ADDR, SERVER_PORT + 2, &s_sock, &s_saddr, IPPROTO_TLS_1_2);
+
+	test_bind(s_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+	test_listen(s_sock);
+
+	handshake_workq_connect(&c_sock, &s_saddr);
+
+	fds.fd = c_sock;
+	fds.events = POLLOUT;
+	fds.revents = 0;
+	zassert_equal(poll(&fds, 1, CONFIG_NET_SOCKETS_TLS_HANDSHAKE_TIMEOUT + 1000), 1,
+		      "handshake did not time out");
+	zassert_equal(fds.revents, POLLERR, "Unexpected revents 0x%x", fds.revents);
+
+	/* The error is reported once */
+	zassert_ok(getsockopt(c_sock, SOL_SOCKET, SO_ERROR, &optval, &optlen),
+		   "getsockopt failed (%d)", errno);
+	zassert_equal(optval, ETIMEDOUT, "Unexpected SO_ERROR %d", optval);
+
+	zassert_ok(getsockopt(c_sock, SOL_SOCKET, SO_ERROR, &optval, &optlen),
+		   "getsockopt failed (%d)", errno);
+	zassert_equal(optval, 0, "SO_ERROR reported twice");
+
+	zassert_equal(send(c_sock, TEST_STR_SMALL, strlen(TEST_STR_SMALL), 0), -1,
+		      "send did not fail after the handshake failed");
+	zassert_equal(errno, ENOTCONN, "Unexpected errno value: %d", errno);
+
+	test_close(c_sock);
+
+	/* Closing the socket aborts a running handshake without waiting for
+	 * its timeout.
+	 */
+	handshake_workq_connect(&c_sock, &s_saddr);
+
+	start = k_uptime_get_32();
+	test_close(c_sock);
+	zassert_true(k_uptime_get_32() - start < CONFIG_NET_SOCKETS_TLS_HANDSHAKE_TIMEOUT,
+		     "close waited for the handshake");
+
+	test_close(s_sock);
+	k_sleep(TCP_TEARDOWN_TIMEOUT);
+}
+#endif /* CONFIG_NET_SOCKETS_TLS_HANDSHAKE_WORKQ */
+
+#if defined(CONFIG_NET_SOCKETS_TLS_SESSION_SETTINGS)
+#define SETTINGS_RAM_ENTRIES 4
+#define SETTINGS_RAM_NAME_LEN 32
+#define SETTINGS_RAM_VALUE_LEN 512
+
+/* A settings back-end keeping the values in RAM, so that the test can
+ * check what was written and how often.
+ */
+static struct settings_ram_entry {
+	char name[SETTINGS_RAM_NAME_LEN];
+	uint8_t value[SETTINGS_RAM_VALUE_LEN];
+	size_t len;
+	int writes;
+} settings_ram[SETTINGS_RAM_ENTRIES];
+
+static struct settings_ram_entry *settings_ram_find(const char *name)
+{
+	for (int i = 0; i < ARRAY_SIZE(settings_ram); i++) {
+		if (strcmp(settings_ram[i].name, name) == 0) {
+			return &settings_ram[i];
+		}
+	}
+
+	return NULL;
+}
+
+static ssize_t settings_ram_read_cb(void *cb_arg, void *data, size_t len)
+{
+	struct settings_ram_entry *entry = cb_arg;
+
+	len = MIN(len, entry->len);
+	memcpy(data, entry->value, len);
+
+	return len;
+}
+
+static int settings_ram_load(struct settings_store *cs,
+			     const struct settings_load_arg *arg)
+{
+	ARG_UNUSED(cs);
+
+	for (int i = 0; i < ARRAY_SIZE(settings_ram); i++) {
+		if (settings_ram[i].len == 0) {
+			continue;
+		}
+
+		(void)settings_call_set_handler(settings_ram[i].name,
+						settings_ram[i].len,
+						settings_ram_read_cb,
+						&settings_ram[i], arg);
+	}
+
+	return 0;
+}
+
+static int settings_ram_save(struct settings_store *cs, const char *name,
+			     const char *value, size_t val_len)
+{
+	struct settings_ram_entry *entry;
+
+	ARG_UNUSED(cs);
+
+	if (val_len > SETTINGS_RAM_VALUE_LEN) {
+		return -ENOMEM;
+	}
+
+	entry = settings_ram_find(name);
+	if (entry == NULL) {
+		if (strlen(name) >= SETTINGS_RAM_NAME_LEN) {
+			return -ENOMEM;
+		}
+
+		/* Unused entries have an empty name */
+		entry = settings_ram_find("");
+		if (entry == NULL) {
+			return -ENOMEM;
+		}
+
+		strcpy(entry->name, name);
+	}
+
+	/* A zero length deletes the value */
+	memcpy(entry->value, value, val_len);
+	entry->len = val_len;
+	entry->writes++;
+
+	return 0;
+}
+
+static const struct settings_store_itf settings_ram_itf = {
+	.csi_load = settings_ram_load,
+	.csi_save = settings_ram_save,
+};
+
+static struct settings_store settings_ram_store = {
+	.cs_itf = &settings_ram_itf,
+};
+
+int settings_backend_init(void)
+{
+	settings_dst_register(&settings_ram_store);
+	settings_src_register(&settings_ram_store);
+
+	return 0;
+}
+
+static void session_settings_connect(int s_sock, struct sockaddr_in *s_saddr)
+{
+	int cache = TLS_SESSION_CACHE_ENABLED;
+	struct sockaddr_in c_saddr;
+	struct sockaddr addr;
+	socklen_t addrlen = sizeof(addr);
+	int c_sock;
+	int new_sock;
+
+	prepare_sock_tls_v4(MY_IPV4_ADDR, ANY_PORT, &c_sock, &c_saddr, IPPROTO_TLS_1_2);
+
+	test_config_psk(-1, c_sock);
+	zassert_ok(setsockopt(c_sock, SOL_TLS, TLS_SESSION_CACHE, &cache, sizeof(cache)),
+		   "Failed to enable the client session cache");
+
+	spawn_client_connect_thread(c_sock, (struct sockaddr *)s_saddr);
+
+	test_accept(s_sock, &new_sock, &addr, &addrlen);
+
+	/* The client stores its session when connect() returns */
+	k_thread_join(&client_connect_thread, K_FOREVER);
+
+	test_close(new_sock);
+	test_close(c_sock);
+}
+
+ZTEST(net_socket_tls, test_v4_session_settings)
+{
+	int cache = TLS_SESSION_CACHE_ENABLED;
+	struct sockaddr_in s_saddr = { 0 };
+	struct settings_ram_entry *entry;
+	int s_sock;
+
+	zassert_ok(settings_subsys_init(), "settings init failed");
+
+	prepare_sock_tls_v4(MY_IPV4_ADDR, SERVER_PORT, &s_sock, &s_saddr, IPPROTO_TLS_1_2);
+
+	test_config_psk(s_sock, -1);
+	zassert_ok(setsockopt(s_sock, SOL_TLS, TLS_SESSION_CACHE, &cache, sizeof(cache)),
+		   "Failed to enable the server session cache");
+
+	test_bind(s_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+	test_listen(s_sock);
+
+	/* The full handshake stores the new session along with the peer */
+	session_settings_connect(s_sock, &s_saddr);
+
+	/* The cache is empty, so the session takes the first entry */
+	entry = settings_ram_find("net_tls/sess/0");
+	zassert_not_null(entry, "session not stored");
+	zassert_equal(entry->writes, 1, "session written %d times", entry->writes);
+	zassert_true(entry->len > sizeof(struct sockaddr), "stored session too short");
+	zassert_mem_equal(entry->value, &s_saddr, sizeof(s_saddr), "wrong peer stored");
+
+	/* Replace the cached session with the stored one, as after a reboot */
+	zassert_ok(settings_load_subtree("net_tls/sess"), "settings load failed");
+
+	/* The reloaded session is resumed. A full handshake would store a new
+	 * session, and an unchanged one is not written again.
+	 */
+	session_settings_connect(s_sock, &s_saddr);
+	zassert_equal(entry->writes, 1, "resumed session written again");
+
+	/* Purging the cache deletes the stored session */
+	zassert_ok(setsockopt(s_sock, SOL_TLS, TLS_SESSION_CACHE_PURGE, &cache, sizeof(cache)),
+		   "Failed to purge the session cache");
+	zassert_equal(entry->len, 0, "stored session not deleted");
+
+	test_close(s_sock);
+	k_sleep(TCP_TEARDOWN_TIMEOUT);
+}
+#endif /* CONFIG_NET_SOCKETS_TLS_SESSION_SETTINGS */
+
 ZTEST_SUITE(net_socket_tls, NULL, NULL, NULL, NULL, NULL);
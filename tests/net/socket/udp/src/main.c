@@ -1293,6 +1293,177 @@ ZTEST(net_socket_udp, test_23_v6_dgram_overflow)
 			    BUF_AND_SIZE(test_str_all_tx_bufs));
 }
 
+ZTEST(net_socket_udp, test_24_v4_recv_pkt)
+{
+	int client_sock;
+	int server_sock;
+	struct sockaddr_in client_addr;
+	struct sockaddr_in server_addr;
+	struct net_pkt *pkt;
+	ssize_t len;
+	int rv;
+
+	prepare_sock_udp_v4(MY_IPV4_ADDR, ANY_PORT, &client_sock, &client_addr);
+	prepare_sock_udp_v4(MY_IPV4_ADDR, SERVER_PORT, &server_sock, &server_addr);
+
+	rv = bind(server_sock, (struct sockaddr *)&server_addr,
+		  sizeof(server_addr));
+	zassert_equal(rv, 0, "bind failed");
+
+	len = zsock_recv_pkt(server_sock, &pkt, ZSOCK_MSG_DONTWAIT);
+	zassert_equal(len, -1, "recv_pkt without data succeeded");
+	zassert_equal(errno, EAGAIN, "unexpected errno (%d)", errno);
+	zassert_is_null(pkt, "packet returned without data");
+
+	len = sendto(client_sock, BUF_AND_SIZE(TEST_STR2), 0,
+		     (struct sockaddr *)&server_addr, sizeof(server_addr));
+	zassert_equal(len, STRLEN(TEST_STR2), "sendto failed");
+
+	len = zsock_recv_pkt(server_sock, &pkt, 0);
+	zassert_equal(len, STRLEN(TEST_STR2), "invalid recv_pkt length");
+	zassert_not_null(pkt, "no packet returned");
+
+	rv = net_pkt_read(pkt, rx_buf, len);
+	zassert_equal(rv, 0, "cannot read packet data");
+	zassert_mem_equal(rx_buf, TEST_STR2, len, "invalid data");
+
+	zsock_recv_pkt_release(pkt);
+
+	len = zsock_recv_pkt(server_sock, &pkt, ZSOCK_MSG_PEEK);
+	zassert_equal(len, -1, "recv_pkt with MSG_PEEK succeeded");
+	zassert_equal(errno, EINVAL, "unexpected errno (%d)", errno);
+
+	rv = close(client_sock);
+	zassert_equal(rv, 0, "close failed");
+	rv = close(server_sock);
+	zassert_equal(rv, 0, "close failed");
+}
+
+static K_SEM_DEFINE(nocopy_done, 0, 1);
+
+static void nocopy_done_cb(const void *buf, size_t len, void *user_data)
+{
+	zassert_equal_ptr(buf, TEST_STR2, "invalid buffer");
+	zassert_equal(len, STRLEN(TEST_STR2), "invalid length");
+	zassert_equal_ptr(user_data, &nocopy_done, "invalid user data");
+
+	k_sem_give(&nocopy_done);
+}
+
+ZTEST(net_socket_udp, test_25_v6_sendto_nocopy)
+{
+	int client_sock;
+	int server_sock;
+	struct sockaddr_in6 client_addr;
+	struct sockaddr_in6 server_addr;
+	ssize_t len;
+	int rv;
+
+	prepare_sock_udp_v6(MY_IPV6_ADDR, ANY_PORT, &client_sock, &client_addr);
+	prepare_sock_udp_v6(MY_IPV6_ADDR, SERVER_PORT, &server_sock, &server_addr);
+
+	rv = bind(server_sock, (struct sockaddr *)&server_addr,
+		  sizeof(server_addr));
+	zassert_equal(rv, 0, "bind failed");
+
+	len = zsock_sendto_nocopy(client_sock, BUF_AND_SIZE(TEST_STR2), 0,
+				  (struct sockaddr *)&server_addr,
+				  sizeof(server_addr), nocopy_done_cb,
+				  &nocopy_done);
+	zassert_equal(len, STRLEN(TEST_STR2), "sendto_nocopy failed");
+
+	rv = k_sem_take(&nocopy_done, K_MSEC(100));
+	zassert_equal(rv, 0, "buffer not released");
+
+	len = recv(server_sock, rx_buf, sizeof(rx_buf), 0);
+	zassert_equal(len, STRLEN(TEST_STR2), "invalid recv length");
+	zassert_mem_equal(rx_buf, TEST_STR2, len, "invalid data");
+
+	rv = close(client_sock);
+	zassert_equal(rv, 0, "close failed");
+	rv = close(server_sock);
+	zassert_equal(rv, 0, "close failed");
+}
+
+ZTEST(net_socket_udp, test_26_v4_sendmmsg_recvmmsg)
+{
+	int client_sock;
+	int server_sock;
+	struct sockaddr_in client_addr;
+	struct sockaddr_in server_addr;
+	struct sockaddr_in src_addr[3];
+	struct iovec tx_iov[2];
+	struct iovec rx_iov[3];
+	struct mmsghdr tx_msgs[2];
+	struct mmsghdr rx_msgs[3];
+	char rx_small[2];
+	int rv;
+
+	prepare_sock_udp_v4(MY_IPV4_ADDR, ANY_PORT, &client_sock, &client_addr);
+	prepare_sock_udp_v4(MY_IPV4_ADDR, SERVER_PORT, &server_sock, &server_addr);
+
+	rv = bind(server_sock, (struct sockaddr *)&server_addr,
+		  sizeof(server_addr));
+	zassert_equal(rv, 0, "bind failed");
+
+	memset(tx_msgs, 0, sizeof(tx_msgs));
+	tx_iov[0].iov_base = TEST_STR_SMALL;
+	tx_iov[0].iov_len = STRLEN(TEST_STR_SMALL);
+	tx_iov[1].iov_base = TEST_STR2;
+	tx_iov[1].iov_len = STRLEN(TEST_STR2);
+
+	for (int i = 0; i < ARRAY_SIZE(tx_msgs); i++) {
+		tx_msgs[i].msg_hdr.msg_name = &server_addr;
+		tx_msgs[i].msg_hdr.msg_namelen = sizeof(server_addr);
+		tx_msgs[i].msg_hdr.msg_iov = &tx_iov[i];
+		tx_msgs[i].msg_hdr.msg_iovlen = 1;
+	}
+
+	rv = sendmmsg(client_sock, tx_msgs, ARRAY_SIZE(tx_msgs), 0);
+	zassert_equal(rv, 2, "sendmmsg failed");
+	zassert_equal(tx_msgs[0].msg_len, STRLEN(TEST_STR_SMALL), "");
+	zassert_equal(tx_msgs[1].msg_len, STRLEN(TEST_STR2), "");
+
+	k_msleep(10);
+
+	/* The second datagram does not fit and is truncated */
+	memset(rx_msgs, 0, sizeof(rx_msgs));
+	rx_iov[0].iov_base = rx_buf;
+	rx_iov[0].iov_len = sizeof(rx_buf);
+	rx_iov[1].iov_base = rx_small;
+	rx_iov[1].iov_len = sizeof(rx_small);
+	rx_iov[2].iov_base = rx_buf;
+	rx_iov[2].iov_len = sizeof(rx_buf);
+
+	for (int i = 0; i < ARRAY_SIZE(rx_msgs); i++) {
+		rx_msgs[i].msg_hdr.msg_name = &src_addr[i];
+		rx_msgs[i].msg_hdr.msg_namelen = sizeof(src_addr[i]);
+		rx_msgs[i].msg_hdr.msg_iov = &rx_iov[i];
+		rx_msgs[i].msg_hdr.msg_iovlen = 1;
+	}
+
+	rv = recvmmsg(server_sock, rx_msgs, ARRAY_SIZE(rx_msgs), 0, NULL);
+	zassert_equal(rv, 2, "recvmmsg failed (%d)", rv);
+	zassert_equal(rx_msgs[0].msg_len, STRLEN(TEST_STR_SMALL), "");
+	zassert_mem_equal(rx_buf, TEST_STR_SMALL, STRLEN(TEST_STR_SMALL), "");
+	zassert_equal(rx_msgs[0].msg_hdr.msg_flags, 0, "");
+	zassert_equal(rx_msgs[1].msg_len, sizeof(rx_small), "");
+	zassert_mem_equal(rx_small, TEST_STR2, sizeof(rx_small), "");
+	zassert_equal(rx_msgs[1].msg_hdr.msg_flags, ZSOCK_MSG_TRUNC, "");
+	zassert_equal(rx_msgs[1].msg_hdr.msg_namelen, sizeof(struct sockaddr_in), "");
+	zassert_equal(src_addr[1].sin_family, AF_INET, "");
+
+	rv = recvmmsg(server_sock, rx_msgs, ARRAY_SIZE(rx_msgs),
+		      ZSOCK_MSG_DONTWAIT, NULL);
+	zassert_equal(rv, -1, "recvmmsg should fail");
+	zassert_equal(errno, EAGAIN, "");
+
+	rv = close(client_sock);
+	zassert_equal(rv, 0, "close failed");
+	rv = close(server_sock);
+	zassert_equal(rv, 0, "close failed");
+}
+
 static void after(void *arg)
 {
 	ARG_UNUSED(arg);
@@ -32,6 +32,7 @@ LOG_MODULE_REGISTER(net_test, CONFIG_NET_TCP_LOG_LEVEL);
 #include "tcp.h"
 #include "tcp_private.h"
 #include "net_stats.h"
+#include "net_private.h"
 
 #include <zephyr/ztest.h>
 
@@ -129,6 +130,8 @@ static void handle_client_closing_test(sa_family_t af, struct tcphdr *th);
 static void handle_data_fin1_test(sa_family_t af, struct tcphdr *th);
 static void handle_data_during_fin1_test(sa_family_t af, struct tcphdr *th);
 static void handle_server_recv_out_of_order(struct net_pkt *pkt);
+static void handle_client_rehash_test(sa_family_t af, struct tcphdr *th);
+static void handle_client_gso_test(struct net_pkt *pkt, struct tcphdr *th);
 
 static void verify_flags(struct tcphdr *th, uint8_t flags,
 			 const char *fun, int line)
@@ -273,7 +276,12 @@ static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
 	}
 
 	th->th_flags = flags;
-	th->th_win = NET_IPV6_MTU;
+	if (test_case_no == 13U) {
+		/* Room for the whole super-segment */
+		th->th_win = htons(NET_IPV6_MTU);
+	} else {
+		th->th_win = NET_IPV6_MTU;
+	}
 	th->th_seq = htonl(seq);
 
 	if (ACK & flags) {
@@ -430,6 +438,12 @@ static int tester_send(const struct device *dev, struct net_pkt *pkt)
 	case 11:
 		handle_data_during_fin1_test(net_pkt_family(pkt), &th);
 		break;
+	case 12:
+		handle_client_rehash_test(net_pkt_family(pkt), &th);
+		break;
+	case 13:
+		handle_client_gso_test(pkt, &th);
+		break;
 	default:
 		zassert_true(false, "Undefined test case");
 	}
@@ -658,6 +672,19 @@ static void handle_server_test(sa_family_t af, struct tcphdr *th)
 		break;
 	case T_SYN_ACK:
 		test_verify_flags(th, SYN | ACK);
+		if (test_case_no == 4) {
+			/* The peer SYN offered SACK, window scaling and
+			 * timestamps, so the enabled ones are expected along
+			 * with the MSS option.
+			 */
+			uint8_t off = 6U;
+
+			off += IS_ENABLED(CONFIG_NET_TCP_SACK) ? 1U : 0U;
+			off += IS_ENABLED(CONFIG_NET_TCP_WINDOW_SCALE) ? 1U : 0U;
+			off += IS_ENABLED(CONFIG_NET_TCP_TIMESTAMPS) ? 3U : 0U;
+
+			zassert_equal(th->th_off, off, "unexpected options length");
+		}
 		seq++;
 		ack = ntohl(th->th_seq) + 1U;
 		reply = prepare_ack_packet(af, htons(MY_PORT),
@@ -1811,4 +1838,227 @@ ZTEST(net_tcp, test_server_out_of_order_data)
 	test_server_timeout_out_of_order_data();
 }
 
+static void handle_client_rehash_test(sa_family_t af, struct tcphdr *th)
+{
+	struct net_pkt *reply;
+	int ret;
+
+	/* The connections are handled one at a time, reply to each on its ports */
+	switch (th->th_flags) {
+	case SYN:
+		seq = 0U;
+		ack = ntohl(th->th_seq) + 1U;
+		reply = prepare_syn_ack_packet(af, th->th_dport, th->th_sport);
+		break;
+	case FIN | ACK:
+		seq = 1U;
+		ack = ntohl(th->th_seq) + 1U;
+		reply = prepare_fin_ack_packet(af, th->th_dport, th->th_sport);
+		break;
+	case ACK:
+		/* Handshake or close completed */
+		test_sem_give();
+		return;
+	default:
+		zassert_true(false, "%s unexpected flags 0x%02x", __func__,
+			     th->th_flags);
+		return;
+	}
+
+	ret = net_recv_data(net_iface, reply);
+	if (ret < 0) {
+		zassert_true(false, "%s failed", __func__);
+	}
+}
+
+/* Test case scenario IPv4
+ *   connect two contexts to different peer ports,
+ *   expect both handshakes to complete, each SYN ACK being looked up
+ *   in the bucket the connection was rehashed to by connect,
+ *   close both connections.
+ *   any failures cause test case to fail.
+ */
+ZTEST(net_tcp, test_client_conn_rehash_ipv4)
+{
+	struct sockaddr_in peer = peer_addr_s;
+	struct net_context *ctx[2];
+	int ret;
+
+	test_case_no = 12;
+
+	for (int i = 0; i < ARRAY_SIZE(ctx); i++) {
+		ret = net_context_get(AF_INET, SOCK_STREAM, IPPROTO_TCP, &ctx[i]);
+		zassert_ok(ret, "Failed to get net_context");
+
+		net_context_ref(ctx[i]);
+
+		peer.sin_port = htons(PEER_PORT + i);
+		ret = net_context_connect(ctx[i], (struct sockaddr *)&peer,
+					  sizeof(struct sockaddr_in), NULL,
+					  K_MSEC(100), NULL);
+		zassert_ok(ret, "Failed to connect to peer %d", i);
+
+		/* Peer will release the semaphore after the final ACK */
+		test_sem_take(K_MSEC(100), __LINE__);
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(ctx); i++) {
+		zassert_equal(net_context_get_state(ctx[i]), NET_CONTEXT_CONNECTED,
+			      "Connection %d not established", i);
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(ctx); i++) {
+		net_context_put(ctx[i]);
+
+		/* Peer will release the semaphore after the ACK of its FIN */
+		test_sem_take(K_MSEC(100), __LINE__);
+	}
+
+	/* Let the connections leave TIME_WAIT */
+	k_sleep(K_MSEC(CONFIG_NET_TCP_TIME_WAIT_DELAY));
+}
+
+#define GSO_DATA_LEN 300
+
+static size_t gso_received;
+
+static void handle_client_gso_test(struct net_pkt *pkt, struct tcphdr *th)
+{
+	/* Segments carry the MSS of the interface, no options are used */
+	size_t mss = net_if_get_mtu(net_iface) - NET_IPV4TCPH_LEN;
+	size_t hdr_len = net_pkt_ip_hdr_len(pkt) + th->th_off * 4U;
+	size_t len = net_pkt_get_len(pkt) - hdr_len;
+	struct net_pkt *reply;
+	uint8_t byte;
+	int ret;
+
+	switch (t_state) {
+	case T_SYN:
+		test_verify_flags(th, SYN);
+		seq = 0U;
+		ack = ntohl(th->th_seq) + 1U;
+		reply = prepare_syn_ack_packet(AF_INET, htons(MY_PORT),
+					       th->th_sport);
+		t_state = T_SYN_ACK;
+		break;
+	case T_SYN_ACK:
+		test_verify_flags(th, ACK);
+		gso_received = 0U;
+		t_state = T_DATA;
+		test_sem_give();
+		return;
+	case T_DATA:
+		zassert_equal(ntohl(th->th_seq), ack + gso_received,
+			      "Segment out of sequence");
+		zassert_equal(net_calc_chksum_ipv4(pkt), 0, "Bad IPv4 checksum");
+		zassert_equal(net_calc_chksum_tcp(pkt), 0, "Bad TCP checksum");
+
+		/* Only the last segment is shorter and pushes the data */
+		if (gso_received + len < GSO_DATA_LEN) {
+			zassert_equal(len, mss, "Segment is not MSS-sized");
+			test_verify_flags(th, ACK);
+		} else {
+			zassert_equal(gso_received + len, GSO_DATA_LEN,
+				      "Too much data");
+			test_verify_flags(th, PSH | ACK);
+		}
+
+		net_pkt_cursor_init(pkt);
+		net_pkt_skip(pkt, hdr_len);
+		for (size_t i = 0; i < len; i++) {
+			net_pkt_read_u8(pkt, &byte);
+			zassert_equal(byte, (uint8_t)(gso_received + i),
+				      "Data differs at %zu", gso_received + i);
+		}
+
+		gso_received += len;
+		if (gso_received < GSO_DATA_LEN) {
+			return;
+		}
+
+		seq++;
+		ack += GSO_DATA_LEN;
+		reply = prepare_ack_packet(AF_INET, htons(MY_PORT),
+					   th->th_sport);
+		t_state = T_FIN;
+		test_sem_give();
+		break;
+	case T_FIN:
+		test_verify_flags(th, FIN | ACK);
+		ack = ack + 1U;
+		t_state = T_FIN_ACK;
+		reply = prepare_fin_ack_packet(AF_INET, htons(MY_PORT),
+					       th->th_sport);
+		break;
+	case T_FIN_ACK:
+		test_verify_flags(th, ACK);
+		test_sem_give();
+		return;
+	default:
+		zassert_true(false, "%s unexpected state", __func__);
+		return;
+	}
+
+	ret = net_recv_data(net_iface, reply);
+	if (ret < 0) {
+		zassert_true(false, "%s failed", __func__);
+	}
+}
+
+/* Test case scenario IPv4
+ *   send SYN,
+ *   expect SYN ACK,
+ *   send ACK,
+ *   send data worth several segments in one super-segment,
+ *   expect it split in MSS-sized segments with consecutive sequence
+ *   numbers and valid checksums, only the last one with PSH,
+ *   expect ACK,
+ *   send FIN,
+ *   expect FIN ACK,
+ *   send ACK.
+ *   any failures cause test case to fail.
+ */
+ZTEST(net_tcp, test_client_gso_ipv4)
+{
+	uint8_t data[GSO_DATA_LEN];
+	struct net_context *ctx;
+	int ret;
+
+	Z_TEST_SKIP_IFNDEF(CONFIG_NET_TCP_GSO);
+
+	for (size_t i = 0; i < sizeof(data); i++) {
+		data[i] = (uint8_t)i;
+	}
+
+	t_state = T_SYN;
+	test_case_no = 13;
+	seq = ack = 0;
+
+	ret = net_context_get(AF_INET, SOCK_STREAM, IPPROTO_TCP, &ctx);
+	zassert_ok(ret, "Failed to get net_context");
+
+	net_context_ref(ctx);
+
+	ret = net_context_connect(ctx, (struct sockaddr *)&peer_addr_s,
+				  sizeof(struct sockaddr_in), NULL,
+				  K_MSEC(100), NULL);
+	zassert_ok(ret, "Failed to connect to peer");
+
+	/* Peer will release the semaphore after the ACK of its SYN ACK */
+	test_sem_take(K_MSEC(100), __LINE__);
+
+	ret = net_context_send(ctx, data, sizeof(data), NULL, K_NO_WAIT, NULL);
+	zassert_equal(ret, sizeof(data), "Failed to send data to peer");
+
+	/* Peer will release the semaphore after all the segments */
+	test_sem_take(K_MSEC(100), __LINE__);
+
+	net_context_put(ctx);
+
+	/* Peer will release the semaphore after the ACK of its FIN */
+	test_sem_take(K_MSEC(100), __LINE__);
+
+	k_sleep(K_MSEC(CONFIG_NET_TCP_TIME_WAIT_DELAY));
+}
+
 ZTEST_SUITE(net_tcp, NULL, presetup, NULL, NULL, NULL);
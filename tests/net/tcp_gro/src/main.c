@@ -0,0 +1,355 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/net/ethernet.h>
+#include <zephyr/net/net_ip.h>
+#include <zephyr/net/net_pkt.h>
+
+#include "ipv4.h"
+#include "net_private.h"
+
+#define TCP_FIN 0x01
+#define TCP_PSH 0x08
+#define TCP_ACK 0x10
+
+#define SEQ	1000U
+#define MSS	100U
+
+#define HDR_LEN (sizeof(struct net_eth_hdr) + sizeof(struct net_ipv4_hdr) + \
+		 sizeof(struct net_tcp_hdr))
+
+static const uint8_t opts_nop[] = { 1, 1, 1, 1 };
+static const uint8_t opts_wscale[] = { 1, 3, 3, 7 };
+
+struct eth_context {
+	uint8_t mac_addr[6];
+};
+
+static struct eth_context eth_ctx_offload = {
+	.mac_addr = { 0x00, 0x00, 0x5E, 0x00, 0x53, 0x01 },
+};
+
+static struct eth_context eth_ctx_no_offload = {
+	.mac_addr = { 0x00, 0x00, 0x5E, 0x00, 0x53, 0x02 },
+};
+
+static const struct net_eth_addr peer_mac = {
+	{ 0x00, 0x00, 0x5E, 0x00, 0x53, 0x03 }
+};
+
+static const struct in_addr peer_addr = { { { 192, 0, 2, 2 } } };
+static const struct in_addr my_addr = { { { 192, 0, 2, 1 } } };
+
+static struct net_if *iface_offload;
+static struct net_if *iface_no_offload;
+
+static K_FIFO_DEFINE(queue);
+
+static void eth_iface_init(struct net_if *iface)
+{
+	const struct device *dev = net_if_get_device(iface);
+	struct eth_context *context = dev->data;
+
+	net_if_set_link_addr(iface, context->mac_addr,
+			     sizeof(context->mac_addr),
+			     NET_LINK_ETHERNET);
+
+	ethernet_init(iface);
+}
+
+static int eth_send(const struct device *dev, struct net_pkt *pkt)
+{
+	ARG_UNUSED(dev);
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+
+static enum ethernet_hw_caps eth_offload_caps(const struct device *dev)
+{
+	return ETHERNET_HW_RX_CHKSUM_OFFLOAD;
+}
+
+static enum ethernet_hw_caps eth_no_offload_caps(const struct device *dev)
+{
+	return 0;
+}
+
+static struct ethernet_api api_funcs_offload = {
+	.iface_api.init = eth_iface_init,
+
+	.get_capabilities = eth_offload_caps,
+	.send = eth_send,
+};
+
+static struct ethernet_api api_funcs_no_offload = {
+	.iface_api.init = eth_iface_init,
+
+	.get_capabilities = eth_no_offload_caps,
+	.send = eth_send,
+};
+
+ETH_NET_DEVICE_INIT(eth_gro_offload, "eth_gro_offload", NULL, NULL,
+		    &eth_ctx_offload, NULL, CONFIG_ETH_INIT_PRIORITY,
+		    &api_funcs_offload, NET_ETH_MTU);
+
+ETH_NET_DEVICE_INIT(eth_gro_no_offload, "eth_gro_no_offload", NULL, NULL,
+		    &eth_ctx_no_offload, NULL, CONFIG_ETH_INIT_PRIORITY,
+		    &api_funcs_no_offload, NET_ETH_MTU);
+
+/* Payload byte at sequence number seq, so that merged data can be checked */
+static uint8_t seq_byte(uint32_t seq)
+{
+	return (uint8_t)(seq * 7U);
+}
+
+static struct net_pkt *make_segment(struct net_if *iface, uint32_t seq,
+				    uint8_t flags, const uint8_t *opts,
+				    size_t opts_len, size_t data_len)
+{
+	struct eth_context *ctx = net_if_get_device(iface)->data;
+	size_t ip_len = sizeof(struct net_ipv4_hdr) +
+			sizeof(struct net_tcp_hdr) + opts_len + data_len;
+	struct net_eth_hdr eth = {
+		.type = htons(NET_ETH_PTYPE_IP),
+	};
+	struct net_ipv4_hdr ipv4 = {
+		.vhl = 0x45,
+		.len = htons(ip_len),
+		.offset = { NET_IPV4_DF << 5, 0 },
+		.ttl = 64,
+		.proto = IPPROTO_TCP,
+	};
+	struct net_tcp_hdr tcp = {
+		.src_port = htons(4242),
+		.dst_port = htons(80),
+		.offset = ((sizeof(tcp) + opts_len) / 4U) << 4,
+		.flags = flags,
+		.wnd = { 0x10, 0x00 },
+	};
+	struct net_pkt *pkt;
+
+	memcpy(&eth.dst, ctx->mac_addr, sizeof(eth.dst));
+	memcpy(&eth.src, &peer_mac, sizeof(eth.src));
+	memcpy(ipv4.src, &peer_addr, sizeof(ipv4.src));
+	memcpy(ipv4.dst, &my_addr, sizeof(ipv4.dst));
+	ipv4.chksum = ~calc_chksum(0, (uint8_t *)&ipv4, sizeof(ipv4));
+	UNALIGNED_PUT(htonl(seq), (uint32_t *)tcp.seq);
+	UNALIGNED_PUT(htonl(1U), (uint32_t *)tcp.ack);
+
+	pkt = net_pkt_rx_alloc_with_buffer(iface,
+					   sizeof(eth) + ip_len,
+					   AF_UNSPEC, 0, K_NO_WAIT);
+	zassert_not_null(pkt, "Cannot allocate segment");
+
+	zassert_ok(net_pkt_write(pkt, &eth, sizeof(eth)));
+	zassert_ok(net_pkt_write(pkt, &ipv4, sizeof(ipv4)));
+	zassert_ok(net_pkt_write(pkt, &tcp, sizeof(tcp)));
+	zassert_ok(net_pkt_write(pkt, opts, opts_len));
+
+	for (size_t i = 0; i < data_len; i++) {
+		zassert_ok(net_pkt_write_u8(pkt, seq_byte(seq + i)));
+	}
+
+	net_pkt_cursor_init(pkt);
+
+	return pkt;
+}
+
+static struct net_pkt *make_data(uint32_t seq, uint8_t flags)
+{
+	return make_segment(iface_offload, seq, TCP_ACK | flags, opts_nop,
+			    sizeof(opts_nop), MSS);
+}
+
+static struct net_ipv4_hdr *pkt_ipv4(struct net_pkt *pkt)
+{
+	return (struct net_ipv4_hdr *)(pkt->buffer->data +
+				       sizeof(struct net_eth_hdr));
+}
+
+static struct net_tcp_hdr *pkt_tcp(struct net_pkt *pkt)
+{
+	return (struct net_tcp_hdr *)(pkt->buffer->data +
+				      sizeof(struct net_eth_hdr) +
+				      sizeof(struct net_ipv4_hdr));
+}
+
+/* Check the headers and the payload of a segment of data_len bytes */
+static void check_segment(struct net_pkt *pkt, size_t opts_len,
+			  size_t data_len)
+{
+	struct net_ipv4_hdr *ipv4 = pkt_ipv4(pkt);
+	uint8_t byte;
+
+	zassert_equal(net_pkt_get_len(pkt), HDR_LEN + opts_len + data_len);
+	zassert_equal(ntohs(ipv4->len), net_pkt_get_len(pkt) -
+		      sizeof(struct net_eth_hdr));
+	zassert_equal(calc_chksum(0, (uint8_t *)ipv4, sizeof(*ipv4)), 0xffff,
+		      "Bad IPv4 header checksum");
+	zassert_equal(ntohl(UNALIGNED_GET((uint32_t *)pkt_tcp(pkt)->seq)), SEQ);
+
+	net_pkt_cursor_init(pkt);
+	zassert_ok(net_pkt_skip(pkt, HDR_LEN + opts_len));
+
+	for (size_t i = 0; i < data_len; i++) {
+		zassert_ok(net_pkt_read_u8(pkt, &byte));
+		zassert_equal(byte, seq_byte(SEQ + i), "Payload differs at %zu", i);
+	}
+}
+
+static void *gro_setup(void)
+{
+	iface_offload = net_if_lookup_by_dev(DEVICE_GET(eth_gro_offload));
+	iface_no_offload = net_if_lookup_by_dev(DEVICE_GET(eth_gro_no_offload));
+
+	zassert_not_null(iface_offload);
+	zassert_not_null(iface_no_offload);
+
+	return NULL;
+}
+
+static void gro_after(void *fixture)
+{
+	struct net_pkt *pkt;
+
+	ARG_UNUSED(fixture);
+
+	while ((pkt = k_fifo_get(&queue, K_NO_WAIT)) != NULL) {
+		net_pkt_unref(pkt);
+	}
+}
+
+ZTEST(net_tcp_gro, test_merge_in_order)
+{
+	struct net_pkt *pkt = make_data(SEQ, 0);
+
+	k_fifo_put(&queue, make_data(SEQ + MSS, 0));
+	k_fifo_put(&queue, make_data(SEQ + 2 * MSS, 0));
+
+	zassert_is_null(net_tc_gro_receive(&queue, pkt));
+	zassert_true(k_fifo_is_empty(&queue), "Segments left in the queue");
+
+	check_segment(pkt, sizeof(opts_nop), 3 * MSS);
+	zassert_equal(pkt_tcp(pkt)->flags, TCP_ACK);
+
+	net_pkt_unref(pkt);
+}
+
+ZTEST(net_tcp_gro, test_merge_timestamps)
+{
+	uint8_t ts1[] = { 1, 1, 8, 10, 0, 0, 0, 1, 0, 0, 0, 9 };
+	uint8_t ts2[] = { 1, 1, 8, 10, 0, 0, 0, 2, 0, 0, 0, 9 };
+	struct net_pkt *pkt;
+
+	/* Only the timestamps differ, the ones of the first segment stay */
+	pkt = make_segment(iface_offload, SEQ, TCP_ACK, ts1, sizeof(ts1), MSS);
+	k_fifo_put(&queue, make_segment(iface_offload, SEQ + MSS, TCP_ACK,
+					ts2, sizeof(ts2), MSS));
+
+	zassert_is_null(net_tc_gro_receive(&queue, pkt));
+
+	check_segment(pkt, sizeof(ts1), 2 * MSS);
+	zassert_mem_equal(pkt_tcp(pkt)->optdata, ts1, sizeof(ts1));
+
+	net_pkt_unref(pkt);
+}
+
+ZTEST(net_tcp_gro, test_out_of_order)
+{
+	struct net_pkt *pkt = make_data(SEQ, 0);
+	struct net_pkt *next = make_data(SEQ + 2 * MSS, 0);
+
+	k_fifo_put(&queue, next);
+
+	zassert_equal_ptr(net_tc_gro_receive(&queue, pkt), next,
+			  "Segment after a gap was merged");
+	check_segment(pkt, sizeof(opts_nop), MSS);
+
+	net_pkt_unref(next);
+	net_pkt_unref(pkt);
+}
+
+ZTEST(net_tcp_gro, test_differing_flags)
+{
+	struct net_pkt *pkt = make_data(SEQ, 0);
+	struct net_pkt *next = make_data(SEQ + MSS, TCP_FIN);
+
+	k_fifo_put(&queue, next);
+
+	zassert_equal_ptr(net_tc_gro_receive(&queue, pkt), next,
+			  "FIN segment was merged");
+	check_segment(pkt, sizeof(opts_nop), MSS);
+
+	net_pkt_unref(next);
+	net_pkt_unref(pkt);
+}
+
+ZTEST(net_tcp_gro, test_differing_options)
+{
+	struct net_pkt *pkt = make_data(SEQ, 0);
+	struct net_pkt *next;
+
+	next = make_segment(iface_offload, SEQ + MSS, TCP_ACK, opts_wscale,
+			    sizeof(opts_wscale), MSS);
+	k_fifo_put(&queue, next);
+
+	zassert_equal_ptr(net_tc_gro_receive(&queue, pkt), next,
+			  "Segment with other options was merged");
+	check_segment(pkt, sizeof(opts_nop), MSS);
+
+	net_pkt_unref(next);
+	net_pkt_unref(pkt);
+}
+
+ZTEST(net_tcp_gro, test_flush_on_psh)
+{
+	struct net_pkt *pkt = make_data(SEQ, 0);
+	struct net_pkt *next = make_data(SEQ + 2 * MSS, 0);
+
+	/* The PSH segment is merged and ends the merge */
+	k_fifo_put(&queue, make_data(SEQ + MSS, TCP_PSH));
+	k_fifo_put(&queue, next);
+
+	zassert_equal_ptr(net_tc_gro_receive(&queue, pkt), next,
+			  "Segment after PSH was merged");
+	check_segment(pkt, sizeof(opts_nop), 2 * MSS);
+	zassert_equal(pkt_tcp(pkt)->flags, TCP_ACK | TCP_PSH);
+
+	net_pkt_unref(next);
+	net_pkt_unref(pkt);
+}
+
+ZTEST(net_tcp_gro, test_no_hold_back)
+{
+	struct net_pkt *pkt = make_data(SEQ, 0);
+
+	/* No timer: with nothing queued the segment is passed on as is */
+	zassert_is_null(net_tc_gro_receive(&queue, pkt));
+	check_segment(pkt, sizeof(opts_nop), MSS);
+
+	net_pkt_unref(pkt);
+}
+
+ZTEST(net_tcp_gro, test_no_rx_chksum_offload)
+{
+	struct net_pkt *pkt;
+
+	pkt = make_segment(iface_no_offload, SEQ, TCP_ACK, opts_nop,
+			   sizeof(opts_nop), MSS);
+	k_fifo_put(&queue, make_segment(iface_no_offload, SEQ + MSS, TCP_ACK,
+					opts_nop, sizeof(opts_nop), MSS));
+
+	/* Nothing is dequeued when the checksums are not verified */
+	zassert_is_null(net_tc_gro_receive(&queue, pkt));
+	zassert_false(k_fifo_is_empty(&queue));
+	check_segment(pkt, sizeof(opts_nop), MSS);
+
+	net_pkt_unref(pkt);
+}
+
+ZTEST_SUITE(net_tcp_gro, NULL, gro_setup, NULL, gro_after, NULL);
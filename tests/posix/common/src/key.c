@@ -213,3 +213,37 @@ ZTEST(posix_apis, test_key_Nto1_thread)
 	}
 	printk("\n");
 }
+
+static void *thread_key_reuse(void *p1)
+{
+	pthread_key_t old_key;
+	pthread_key_t new_key;
+
+	zassert_ok(pthread_key_create(&old_key, NULL), "attempt to create key failed");
+	zassert_ok(pthread_setspecific(old_key, p1), "pthread_setspecific failed");
+	zassert_ok(pthread_key_delete(old_key), "attempt to delete key failed");
+
+	zassert_ok(pthread_key_create(&new_key, NULL), "attempt to create key failed");
+
+	/* TESTPOINT: Check that the value of the deleted key is not inherited */
+	zassert_not_equal(old_key, new_key, "deleted key handle reused");
+	zassert_is_null(pthread_getspecific(new_key), "value of the deleted key retrieved");
+	zassert_equal(pthread_setspecific(old_key, p1), EINVAL, "deleted key accepted");
+
+	zassert_ok(pthread_key_delete(new_key), "attempt to delete key failed");
+
+	return NULL;
+}
+
+ZTEST(posix_apis, test_key_reuse)
+{
+	pthread_attr_t attr;
+	pthread_t newthread;
+
+	zassert_ok(pthread_attr_init(&attr), "Unable to create pthread object attr");
+	zassert_ok(pthread_attr_setstack(&attr, &stackp[0][0], STACKSZ));
+	zassert_ok(pthread_create(&newthread, &attr, thread_key_reuse, INT_TO_POINTER(1)),
+		   "attempt to create thread failed");
+	zassert_ok(pthread_join(newthread, NULL));
+	zassert_ok(pthread_attr_destroy(&attr));
+}
@@ -193,6 +193,29 @@ ZTEST(posix_apis, test_mutex_resource_leak)
 	}
 }
 
+/**
+ * @brief Test that a destroyed mutex is not taken for a new one
+ *
+ * @details The pool slot of the destroyed mutex is reused by the new mutex,
+ * the handle of the destroyed mutex must still be rejected.
+ */
+ZTEST(posix_apis, test_mutex_stale_handle)
+{
+	pthread_mutex_t m;
+	pthread_mutex_t stale;
+
+	zassert_ok(pthread_mutex_init(&m, NULL), "failed to init mutex");
+	stale = m;
+	zassert_ok(pthread_mutex_destroy(&m), "failed to destroy mutex");
+	zassert_ok(pthread_mutex_init(&m, NULL), "failed to init mutex");
+
+	zassert_not_equal(m, stale, "destroyed mutex handle reused");
+	zassert_equal(pthread_mutex_lock(&stale), EINVAL, "destroyed mutex locked");
+	zassert_equal(pthread_mutex_destroy(&stale), EINVAL, "destroyed mutex destroyed twice");
+
+	zassert_ok(pthread_mutex_destroy(&m), "failed to destroy mutex");
+}
+
 #define TIMEDLOCK_TIMEOUT_MS       200
 #define TIMEDLOCK_TIMEOUT_DELAY_MS 100
 
@@ -0,0 +1,201 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+
+#include <zephyr/audio/graph.h>
+#include <zephyr/ztest.h>
+
+#define BLOCK_SIZE 16
+#define N_BLOCKS 8
+
+K_MEM_SLAB_DEFINE_STATIC(test_slab, BLOCK_SIZE, N_BLOCKS, 4);
+
+static struct audio_graph graphs[2];
+static struct audio_node inc_nodes[2];
+static struct audio_node sink_nodes[2];
+static struct audio_node mixer;
+
+/* First byte of the blocks reaching the sinks, in order */
+static uint8_t received[16];
+static size_t n_received;
+
+static int inc_process(struct audio_node *node, void **blocks)
+{
+	uint8_t *data = blocks[0];
+
+	for (size_t i = 0; i < audio_node_block_size(node); i++) {
+		data[i]++;
+	}
+
+	return 0;
+}
+
+static int sink_process(struct audio_node *node, void **blocks)
+{
+	uint8_t *data = blocks[0];
+
+	if (n_received < ARRAY_SIZE(received)) {
+		received[n_received++] = data[0];
+	}
+
+	return 0;
+}
+
+static int fail_process(struct audio_node *node, void **blocks)
+{
+	return -EIO;
+}
+
+static int mixer_process(struct audio_node *node, void **blocks)
+{
+	uint8_t *dst = blocks[0];
+	uint8_t *src = blocks[1];
+
+	for (size_t i = 0; i < audio_node_block_size(node); i++) {
+		dst[i] += src[i];
+	}
+
+	return 0;
+}
+
+static int push_block(struct audio_node *node, uint8_t port, uint8_t value)
+{
+	void *block;
+	int ret;
+
+	zassert_ok(k_mem_slab_alloc(&test_slab, &block, K_NO_WAIT));
+	memset(block, value, BLOCK_SIZE);
+
+	ret = audio_graph_push(node, port, block);
+	if (ret < 0) {
+		k_mem_slab_free(&test_slab, &block);
+	}
+
+	return ret;
+}
+
+/* The pipeline i is inc_nodes[i] -> sink_nodes[i] */
+static void setup_pipeline(int i, uint32_t deadline_us)
+{
+	audio_graph_init(&graphs[i], &test_slab, deadline_us);
+	audio_node_init(&inc_nodes[i], "inc", inc_process, 1, NULL);
+	audio_node_init(&sink_nodes[i], "sink", sink_process, 1, NULL);
+	audio_graph_add(&graphs[i], &inc_nodes[i]);
+	audio_graph_add(&graphs[i], &sink_nodes[i]);
+	zassert_ok(audio_graph_connect(&inc_nodes[i], &sink_nodes[i], 0));
+}
+
+ZTEST(audio_graph, test_pipeline)
+{
+	setup_pipeline(0, 1000);
+	audio_graph_start(&graphs[0]);
+
+	for (uint8_t i = 0; i < 3; i++) {
+		zassert_ok(push_block(&inc_nodes[0], 0, i * 10));
+	}
+
+	k_sleep(K_MSEC(10));
+
+	zassert_equal(n_received, 3);
+	zassert_equal(received[0], 1);
+	zassert_equal(received[1], 11);
+	zassert_equal(received[2], 21);
+	zassert_equal(graphs[0].stats.blocks, 3);
+	zassert_equal(inc_nodes[0].stats.blocks, 3);
+	zassert_equal(sink_nodes[0].stats.blocks, 3);
+	zassert_equal(k_mem_slab_num_used_get(&test_slab), 0, "blocks not freed");
+
+	audio_graph_stats_report(&graphs[0]);
+}
+
+ZTEST(audio_graph, test_earliest_deadline_first)
+{
+	setup_pipeline(0, 100000);
+	setup_pipeline(1, 1000);
+	audio_graph_start(&graphs[0]);
+	audio_graph_start(&graphs[1]);
+
+	/* The test thread is cooperative, the graph runs once it sleeps */
+	zassert_ok(push_block(&inc_nodes[0], 0, 10));
+	zassert_ok(push_block(&inc_nodes[1], 0, 20));
+
+	k_sleep(K_MSEC(10));
+
+	zassert_equal(n_received, 2);
+	zassert_equal(received[0], 21, "block of later deadline run first");
+	zassert_equal(received[1], 11);
+}
+
+ZTEST(audio_graph, test_mixer)
+{
+	audio_graph_init(&graphs[0], &test_slab, 1000);
+	audio_node_init(&mixer, "mixer", mixer_process, 2, NULL);
+	audio_node_init(&sink_nodes[0], "sink", sink_process, 1, NULL);
+	audio_graph_add(&graphs[0], &mixer);
+	audio_graph_add(&graphs[0], &sink_nodes[0]);
+	zassert_ok(audio_graph_connect(&mixer, &sink_nodes[0], 0));
+	zassert_equal(audio_graph_connect(&sink_nodes[0], &mixer, 2), -EINVAL);
+	audio_graph_start(&graphs[0]);
+
+	zassert_ok(push_block(&mixer, 0, 1));
+	k_sleep(K_MSEC(10));
+	zassert_equal(n_received, 0, "mixer run with a single input");
+
+	zassert_ok(push_block(&mixer, 1, 2));
+	k_sleep(K_MSEC(10));
+	zassert_equal(n_received, 1);
+	zassert_equal(received[0], 3);
+	zassert_equal(k_mem_slab_num_used_get(&test_slab), 0, "blocks not freed");
+}
+
+ZTEST(audio_graph, test_queue_full)
+{
+	setup_pipeline(0, 1000);
+
+	/* Not started, the blocks stay queued */
+	for (int i = 0; i < CONFIG_AUDIO_GRAPH_QUEUE_DEPTH; i++) {
+		zassert_ok(push_block(&inc_nodes[0], 0, i));
+	}
+
+	zassert_equal(push_block(&inc_nodes[0], 0, 0), -ENOBUFS);
+	zassert_equal(push_block(&inc_nodes[0], 1, 0), -EINVAL);
+	zassert_equal(inc_nodes[0].stats.dropped, 1);
+
+	audio_graph_start(&graphs[0]);
+	zassert_ok(push_block(&inc_nodes[0], 0, 0));
+	k_sleep(K_MSEC(10));
+
+	zassert_equal(n_received, CONFIG_AUDIO_GRAPH_QUEUE_DEPTH + 1);
+}
+
+ZTEST(audio_graph, test_error)
+{
+	setup_pipeline(0, 1000);
+	inc_nodes[0].process = fail_process;
+	audio_graph_start(&graphs[0]);
+
+	zassert_ok(push_block(&inc_nodes[0], 0, 0));
+	k_sleep(K_MSEC(10));
+
+	zassert_equal(n_received, 0);
+	zassert_equal(inc_nodes[0].stats.errors, 1);
+	zassert_equal(k_mem_slab_num_used_get(&test_slab), 0, "block not freed");
+}
+
+static void audio_graph_before(void *fixture)
+{
+	n_received = 0;
+}
+
+static void audio_graph_after(void *fixture)
+{
+	audio_graph_stop(&graphs[0]);
+	audio_graph_stop(&graphs[1]);
+	zassert_equal(k_mem_slab_num_used_get(&test_slab), 0, "blocks not freed");
+}
+
+ZTEST_SUITE(audio_graph, NULL, NULL, audio_graph_before, audio_graph_after, NULL);
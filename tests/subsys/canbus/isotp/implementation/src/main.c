@@ -411,6 +411,60 @@ ZTEST(isotp_implementation, test_buffer_allocation_wait)
 	isotp_unbind(&recv_ctx);
 }
 
+ZTEST(isotp_implementation, test_mux)
+{
+	const struct can_filter mux_filter = {
+		.flags = CAN_FILTER_DATA,
+		.id = rx_addr.std_id,
+		.mask = CAN_STD_ID_MASK & ~0x2
+	};
+	const struct isotp_msg_id rx_addr_2 = {
+		.std_id = rx_addr.std_id | 0x2,
+		.ide = 0,
+		.use_ext_addr = 0
+	};
+	struct isotp_recv_ctx recv_ctx_2;
+	struct isotp_rx_mux mux;
+	int ret, i;
+
+	ret = isotp_rx_mux_init(&mux, can_dev, &mux_filter);
+	zassert_equal(ret, ISOTP_N_OK, "Mux init failed (%d)", ret);
+
+	ret = isotp_bind_mux(&recv_ctx, &mux, &rx_addr, &tx_addr, &fc_opts,
+			     K_NO_WAIT);
+	zassert_equal(ret, ISOTP_N_OK, "Binding failed (%d)", ret);
+
+	ret = isotp_bind_mux(&recv_ctx_2, &mux, &rx_addr_2, &tx_addr, &fc_opts,
+			     K_NO_WAIT);
+	zassert_equal(ret, ISOTP_N_OK, "Binding failed (%d)", ret);
+
+	for (i = 0; i < NUMBER_OF_REPETITIONS; i++) {
+		send_test_data(can_dev, random_data, sizeof(random_data));
+		receive_test_data_net(&recv_ctx, random_data, sizeof(random_data), 0);
+	}
+
+	/* Only the context of the identifier receives the data */
+	ret = isotp_recv(&recv_ctx_2, data_buf, sizeof(data_buf), K_MSEC(50));
+	zassert_equal(ret, ISOTP_RECV_TIMEOUT,
+		      "Expected timeout but got %d", ret);
+
+	ret = isotp_send(&send_ctx, can_dev, random_data, DATA_SIZE_SF,
+			 &rx_addr_2, &tx_addr, send_complete_cb, NULL);
+	zassert_equal(ret, 0, "Send returned %d", ret);
+	get_sf_net(&recv_ctx_2);
+
+	isotp_unbind(&recv_ctx_2);
+	isotp_unbind(&recv_ctx);
+
+	/* Not accepted by the filter of the multiplexer */
+	ret = isotp_bind_mux(&recv_ctx, &mux, &tx_addr, &rx_addr, &fc_opts,
+			     K_NO_WAIT);
+	zassert_equal(ret, ISOTP_NO_FREE_FILTER, "Expected %d but got %d",
+		      ISOTP_NO_FREE_FILTER, ret);
+
+	isotp_rx_mux_deinit(&mux);
+}
+
 void *isotp_implementation_setup(void)
 {
 	int ret;
@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/debug/profiler.h>
+
+#define SAMPLE_FREQ 100
+#define SAMPLE_COUNT 20
+
+/* Size of busy_spin() is well below this */
+#define BUSY_SPIN_MAX_SIZE 256
+
+static volatile bool spin_done;
+
+static void spin_expiry(struct k_timer *timer)
+{
+	spin_done = true;
+}
+
+static K_TIMER_DEFINE(spin_timer, spin_expiry, NULL);
+
+static __noinline void busy_spin(void)
+{
+	while (!spin_done) {
+	}
+}
+
+ZTEST(profiler, test_invalid)
+{
+	zassert_equal(profiler_start(0, 0), -EINVAL);
+	zassert_equal(profiler_start(CONFIG_SYS_CLOCK_TICKS_PER_SEC + 1, 0),
+		      -EINVAL);
+
+	zassert_ok(profiler_start(SAMPLE_FREQ, 0));
+	zassert_equal(profiler_start(SAMPLE_FREQ, 0), -EALREADY);
+	profiler_stop();
+}
+
+ZTEST(profiler, test_hot_function)
+{
+	uintptr_t start = (uintptr_t)busy_spin & ~1UL;
+	const uintptr_t *samples;
+	uint32_t hits = 0;
+	uint32_t total = 0;
+	size_t used;
+
+	zassert_ok(profiler_start(SAMPLE_FREQ, SAMPLE_COUNT));
+
+	/* Spin until the profiler took all the samples */
+	k_timer_start(&spin_timer, K_MSEC(MSEC_PER_SEC * (SAMPLE_COUNT + 1) / SAMPLE_FREQ),
+		      K_NO_WAIT);
+	busy_spin();
+	profiler_stop();
+
+	used = profiler_samples_get(0, &samples);
+	zassert_true(used > 0, "no samples");
+
+	for (size_t i = 0; i < used; i += samples[i] + 1) {
+		zassert_true(samples[i] >= 1 &&
+			     samples[i] <= CONFIG_PROFILER_STACK_DEPTH);
+		total++;
+		if (samples[i + 1] - start < BUSY_SPIN_MAX_SIZE) {
+			hits++;
+		}
+	}
+
+	zassert_true(hits > total / 2, "%u of %u samples in busy_spin()",
+		     hits, total);
+}
+
+ZTEST_SUITE(profiler, NULL, NULL, NULL, NULL, NULL);
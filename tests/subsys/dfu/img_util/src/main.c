@@ -9,6 +9,11 @@
 #include <zephyr/storage/flash_map.h>
 #include <zephyr/dfu/flash_img.h>
 
+#ifdef CONFIG_IMG_LZ4
+#include <zephyr/sys/byteorder.h>
+#include <lz4.h>
+#endif
+
 #define SLOT0_PARTITION		slot0_partition
 #define SLOT1_PARTITION		slot1_partition
 
@@ -165,4 +170,122 @@ ZTEST(img_util, test_check_flash)
 	flash_area_close(ctx.flash_area);
 }
 
+#ifdef CONFIG_IMG_LZ4
+#define LZ4_IMAGE_SIZE (3 * CONFIG_IMG_LZ4_BLOCK_SIZE + 100)
+
+static uint8_t lz4_image[LZ4_IMAGE_SIZE];
+static uint8_t lz4_stream[FLASH_IMG_LZ4_HDR_SIZE +
+			  4 * (sizeof(uint32_t) + FLASH_IMG_LZ4_BOUND(CONFIG_IMG_LZ4_BLOCK_SIZE))];
+static struct flash_img_lz4 lz4_state;
+
+/* Compress the image in blocks, the ones which do not compress are stored */
+static size_t lz4_stream_build(void)
+{
+	size_t len = FLASH_IMG_LZ4_HDR_SIZE;
+	uint32_t x = 1;
+	int block_len;
+	int out_len;
+
+	/* Compressible first half, pseudo random second half */
+	for (size_t i = 0; i < LZ4_IMAGE_SIZE; i++) {
+		if (i < LZ4_IMAGE_SIZE / 2) {
+			lz4_image[i] = i / 7;
+		} else {
+			x ^= x << 13;
+			x ^= x >> 17;
+			x ^= x << 5;
+			lz4_image[i] = x;
+		}
+	}
+
+	sys_put_le32(FLASH_IMG_LZ4_MAGIC, &lz4_stream[0]);
+	sys_put_le32(LZ4_IMAGE_SIZE, &lz4_stream[4]);
+	sys_put_le32(CONFIG_IMG_LZ4_BLOCK_SIZE, &lz4_stream[8]);
+
+	for (size_t off = 0; off < LZ4_IMAGE_SIZE; off += block_len) {
+		block_len = MIN(CONFIG_IMG_LZ4_BLOCK_SIZE, LZ4_IMAGE_SIZE - off);
+		out_len = LZ4_compress_default((const char *)&lz4_image[off],
+					       (char *)&lz4_stream[len + sizeof(uint32_t)],
+					       block_len,
+					       FLASH_IMG_LZ4_BOUND(CONFIG_IMG_LZ4_BLOCK_SIZE));
+		zassert_true(out_len > 0, "Compression failure");
+
+		if (out_len >= block_len) {
+			memcpy(&lz4_stream[len + sizeof(uint32_t)], &lz4_image[off], block_len);
+			sys_put_le32(block_len | FLASH_IMG_LZ4_BLOCK_STORED, &lz4_stream[len]);
+			out_len = block_len;
+		} else {
+			sys_put_le32(out_len, &lz4_stream[len]);
+		}
+
+		len += sizeof(uint32_t) + out_len;
+	}
+
+	return len;
+}
+
+ZTEST(img_util, test_lz4)
+{
+	const struct flash_area *fa;
+	struct flash_img_context ctx;
+	size_t image_size;
+	size_t len;
+	uint8_t temp;
+	int ret;
+
+	len = lz4_stream_build();
+	zassert_true(len < LZ4_IMAGE_SIZE, "Image not compressed");
+
+	zassert_true(flash_img_lz4_is_stream(lz4_stream, len, &image_size),
+		     "Stream not detected");
+	zassert_equal(image_size, LZ4_IMAGE_SIZE, "Wrong image size");
+	zassert_false(flash_img_lz4_is_stream(lz4_image, LZ4_IMAGE_SIZE, &image_size),
+		      "Raw image detected as a stream");
+
+	ret = flash_img_init_id(&ctx, SLOT1_PARTITION_ID);
+	zassert_true(ret == 0, "Flash img init");
+	ret = flash_area_erase(ctx.flash_area, 0, ctx.flash_area->fa_size);
+	zassert_true(ret == 0, "Flash erase failure (%d)", ret);
+
+	/* Split the stream at odd offsets, across the block boundaries */
+	flash_img_lz4_enable(&ctx, &lz4_state);
+	for (size_t off = 0; off < len; off += 77) {
+		ret = flash_img_buffered_write(&ctx, &lz4_stream[off], MIN(77, len - off),
+					       false);
+		zassert_true(ret == 0, "Decompressing write failure (%d)", ret);
+	}
+
+	ret = flash_img_buffered_write(&ctx, NULL, 0, true);
+	zassert_true(ret == 0, "Decompressing flush failure (%d)", ret);
+	zassert_equal(flash_img_bytes_written(&ctx), LZ4_IMAGE_SIZE, "Wrong size written");
+
+	ret = flash_area_open(SLOT1_PARTITION_ID, &fa);
+	zassert_true(ret == 0, "Flash area open failure (%d)", ret);
+
+	for (size_t i = 0; i < LZ4_IMAGE_SIZE; i++) {
+		zassert_true(flash_area_read(fa, i, &temp, 1) == 0, "Flash read failure");
+		zassert_equal(temp, lz4_image[i], "Wrong data at offset %zu", i);
+	}
+
+	flash_area_close(fa);
+
+	/* A truncated stream is rejected on the final write */
+	ret = flash_img_init_id(&ctx, SLOT1_PARTITION_ID);
+	zassert_true(ret == 0, "Flash img init");
+	flash_img_lz4_enable(&ctx, &lz4_state);
+	ret = flash_img_buffered_write(&ctx, lz4_stream, len - 1, true);
+	zassert_equal(ret, -EINVAL, "Truncated stream accepted");
+	flash_area_close(ctx.flash_area);
+
+	/* So is a corrupted block */
+	lz4_stream[FLASH_IMG_LZ4_HDR_SIZE] = 0xff;
+	ret = flash_img_init_id(&ctx, SLOT1_PARTITION_ID);
+	zassert_true(ret == 0, "Flash img init");
+	flash_img_lz4_enable(&ctx, &lz4_state);
+	ret = flash_img_buffered_write(&ctx, lz4_stream, len, true);
+	zassert_equal(ret, -EINVAL, "Corrupted stream accepted");
+	flash_area_close(ctx.flash_area);
+}
+#endif
+
 ZTEST_SUITE(img_util, NULL, NULL, NULL, NULL, NULL);
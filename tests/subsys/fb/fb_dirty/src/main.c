@@ -0,0 +1,295 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+
+#include <zephyr/display/fb_dirty.h>
+#include <zephyr/drivers/display.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#define WIDTH 16
+#define HEIGHT 8
+#define PIXEL_SIZE 2
+#define FB_SIZE (WIDTH * HEIGHT * PIXEL_SIZE)
+#define MAX_WRITES 8
+
+/* Mock display, copying the rectangles written to its screen */
+struct display_mock_write {
+	struct fb_dirty_rect rect;
+	uint16_t pitch;
+	const uint8_t *buf;
+};
+
+static struct display_mock_write writes[MAX_WRITES];
+static int n_writes;
+static int write_ret;
+static enum display_pixel_format pixel_format;
+static uint8_t screen[FB_SIZE];
+
+static int display_mock_write(const struct device *dev, const uint16_t x, const uint16_t y,
+			      const struct display_buffer_descriptor *desc, const void *buf)
+{
+	const uint8_t *src = buf;
+
+	if (write_ret != 0) {
+		return write_ret;
+	}
+
+	zassert_true(n_writes < MAX_WRITES, "Too many writes");
+	zassert_true(x + desc->width <= WIDTH && y + desc->height <= HEIGHT,
+		     "Write out of the screen");
+
+	writes[n_writes++] = (struct display_mock_write){
+		.rect = { x, y, desc->width, desc->height },
+		.pitch = desc->pitch,
+		.buf = buf,
+	};
+
+	for (uint16_t row = 0; row < desc->height; row++) {
+		memcpy(&screen[((y + row) * WIDTH + x) * PIXEL_SIZE],
+		       &src[row * desc->pitch * PIXEL_SIZE], desc->width * PIXEL_SIZE);
+	}
+
+	return 0;
+}
+
+static void display_mock_get_capabilities(const struct device *dev,
+					  struct display_capabilities *caps)
+{
+	memset(caps, 0, sizeof(*caps));
+	caps->x_resolution = WIDTH;
+	caps->y_resolution = HEIGHT;
+	caps->supported_pixel_formats = PIXEL_FORMAT_RGB_565 | PIXEL_FORMAT_MONO01;
+	caps->current_pixel_format = pixel_format;
+}
+
+static const struct display_driver_api display_mock_api = {
+	.write = display_mock_write,
+	.get_capabilities = display_mock_get_capabilities,
+};
+
+static struct device_state display_mock_state = {
+	.init_res = 0,
+	.initialized = 1,
+};
+
+static struct device display_mock = {
+	.api = &display_mock_api,
+	.state = &display_mock_state,
+};
+
+static uint8_t bufs[2][FB_SIZE];
+static struct fb_dirty fb;
+
+static void fill(uint8_t *buf, const struct fb_dirty_rect *rect, uint8_t value)
+{
+	for (uint16_t row = rect->y; row < rect->y + rect->height; row++) {
+		memset(&buf[(row * WIDTH + rect->x) * PIXEL_SIZE], value,
+		       rect->width * PIXEL_SIZE);
+	}
+}
+
+static void render(const struct fb_dirty_rect *rect, uint8_t value)
+{
+	fill(fb_dirty_buffer(&fb), rect, value);
+	fb_dirty_mark(&fb, rect);
+}
+
+/* The rectangle is written with the pitch of the framebuffer, from where it is in it */
+static void check_write(int idx, const uint8_t *buf, uint16_t x, uint16_t y, uint16_t width,
+			uint16_t height)
+{
+	const struct display_mock_write *write = &writes[idx];
+
+	if (IS_ENABLED(CONFIG_FB_DIRTY_FULL_ROWS)) {
+		x = 0;
+		width = WIDTH;
+	}
+
+	zassert_equal(write->rect.x, x, "Write %d at x %u", idx, write->rect.x);
+	zassert_equal(write->rect.y, y, "Write %d at y %u", idx, write->rect.y);
+	zassert_equal(write->rect.width, width, "Write %d of width %u", idx, write->rect.width);
+	zassert_equal(write->rect.height, height, "Write %d of height %u", idx,
+		      write->rect.height);
+	zassert_equal(write->pitch, WIDTH);
+	zassert_equal_ptr(write->buf, &buf[(y * WIDTH + x) * PIXEL_SIZE]);
+}
+
+static void fb_dirty_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	memset(bufs, 0, sizeof(bufs));
+	memset(screen, 0, sizeof(screen));
+	n_writes = 0;
+	write_ret = 0;
+	pixel_format = PIXEL_FORMAT_RGB_565;
+}
+
+ZTEST(fb_dirty, test_init)
+{
+	pixel_format = PIXEL_FORMAT_MONO01;
+	zassert_equal(fb_dirty_init(&fb, &display_mock, bufs[0], NULL, FB_SIZE), -ENOTSUP);
+
+	pixel_format = PIXEL_FORMAT_RGB_565;
+	zassert_equal(fb_dirty_init(&fb, &display_mock, bufs[0], NULL, FB_SIZE - 1), -EINVAL);
+
+	/* The second framebuffer starts with the contents of the first one */
+	memset(bufs[0], 0x5a, FB_SIZE);
+	zassert_ok(fb_dirty_init(&fb, &display_mock, bufs[0], bufs[1], FB_SIZE));
+	zassert_mem_equal(bufs[1], bufs[0], FB_SIZE);
+	zassert_equal_ptr(fb_dirty_buffer(&fb), bufs[0]);
+
+	/* Nothing changed, nothing written */
+	zassert_ok(fb_dirty_flush(&fb));
+	zassert_ok(fb_dirty_sync(&fb, K_FOREVER));
+	zassert_equal(n_writes, 0);
+}
+
+ZTEST(fb_dirty, test_merge)
+{
+	zassert_ok(fb_dirty_init(&fb, &display_mock, bufs[0], NULL, FB_SIZE));
+
+	/* Overlapping and touching rectangles are merged, the others kept apart */
+	render(&(struct fb_dirty_rect){ 1, 1, 2, 2 }, 1);
+	render(&(struct fb_dirty_rect){ 2, 2, 2, 2 }, 2);
+	render(&(struct fb_dirty_rect){ 4, 1, 1, 1 }, 3);
+	render(&(struct fb_dirty_rect){ 1, 6, 3, 1 }, 4);
+
+	zassert_ok(fb_dirty_flush(&fb));
+
+	zassert_equal(n_writes, 2);
+	check_write(0, bufs[0], 1, 1, 4, 3);
+	check_write(1, bufs[0], 1, 6, 3, 1);
+	zassert_mem_equal(screen, bufs[0], FB_SIZE);
+
+	/* The rectangles are written once */
+	zassert_ok(fb_dirty_flush(&fb));
+	zassert_equal(n_writes, 2);
+}
+
+ZTEST(fb_dirty, test_clip)
+{
+	zassert_ok(fb_dirty_init(&fb, &display_mock, bufs[0], NULL, FB_SIZE));
+
+	fb_dirty_mark(&fb, &(struct fb_dirty_rect){ WIDTH, 0, 4, 4 });
+	fb_dirty_mark(&fb, &(struct fb_dirty_rect){ 0, HEIGHT, 4, 4 });
+	fb_dirty_mark(&fb, &(struct fb_dirty_rect){ 2, 2, 0, 4 });
+	zassert_ok(fb_dirty_flush(&fb));
+	zassert_equal(n_writes, 0, "Rectangle out of the screen written");
+
+	fb_dirty_mark(&fb, &(struct fb_dirty_rect){ WIDTH - 2, HEIGHT - 3, 10, 10 });
+	zassert_ok(fb_dirty_flush(&fb));
+	zassert_equal(n_writes, 1);
+	check_write(0, bufs[0], WIDTH - 2, HEIGHT - 3, 2, 3);
+}
+
+ZTEST(fb_dirty, test_max_rects)
+{
+	Z_TEST_SKIP_IFDEF(CONFIG_FB_DIRTY_FULL_ROWS);
+
+	zassert_ok(fb_dirty_init(&fb, &display_mock, bufs[0], NULL, FB_SIZE));
+
+	for (uint16_t x = 0; x < CONFIG_FB_DIRTY_MAX_RECTS * 4; x += 4) {
+		render(&(struct fb_dirty_rect){ x, 0, 1, 1 }, x + 1);
+	}
+
+	/* One too many, merged with the rectangle growing the least */
+	render(&(struct fb_dirty_rect){ 8, 3, 1, 1 }, 0xff);
+
+	zassert_ok(fb_dirty_flush(&fb));
+	zassert_equal(n_writes, CONFIG_FB_DIRTY_MAX_RECTS);
+	zassert_mem_equal(screen, bufs[0], FB_SIZE);
+
+	for (int i = 0; i < n_writes; i++) {
+		if (writes[i].rect.x == 8) {
+			check_write(i, bufs[0], 8, 0, 1, 4);
+			return;
+		}
+	}
+
+	zassert_unreachable("Rectangle not merged");
+}
+
+ZTEST(fb_dirty, test_full_rows)
+{
+	Z_TEST_SKIP_IFNDEF(CONFIG_FB_DIRTY_FULL_ROWS);
+
+	zassert_ok(fb_dirty_init(&fb, &display_mock, bufs[0], NULL, FB_SIZE));
+
+	/* Rectangles on different columns of the same rows become one */
+	render(&(struct fb_dirty_rect){ 1, 2, 1, 2 }, 1);
+	render(&(struct fb_dirty_rect){ 10, 3, 2, 2 }, 2);
+
+	zassert_ok(fb_dirty_flush(&fb));
+	zassert_equal(n_writes, 1);
+	check_write(0, bufs[0], 0, 2, WIDTH, 3);
+	zassert_mem_equal(screen, bufs[0], FB_SIZE);
+}
+
+ZTEST(fb_dirty, test_double_buffer)
+{
+	struct fb_dirty_rect first = { 2, 1, 3, 2 };
+	struct fb_dirty_rect second = { 8, 4, 4, 3 };
+
+	zassert_ok(fb_dirty_init(&fb, &display_mock, bufs[0], bufs[1], FB_SIZE));
+
+	render(&first, 1);
+	zassert_ok(fb_dirty_flush(&fb));
+
+	/* Rendering goes on in the other framebuffer, brought up to date */
+	zassert_equal_ptr(fb_dirty_buffer(&fb), bufs[1]);
+	zassert_mem_equal(bufs[1], bufs[0], FB_SIZE);
+
+	zassert_ok(fb_dirty_sync(&fb, K_FOREVER));
+	zassert_equal(n_writes, 1);
+	check_write(0, bufs[0], first.x, first.y, first.width, first.height);
+	zassert_mem_equal(screen, bufs[0], FB_SIZE);
+
+	/* The next frame is written from the other framebuffer */
+	render(&second, 2);
+	zassert_ok(fb_dirty_flush(&fb));
+	zassert_equal_ptr(fb_dirty_buffer(&fb), bufs[0]);
+
+	zassert_ok(fb_dirty_sync(&fb, K_FOREVER));
+	zassert_equal(n_writes, 2);
+	check_write(1, bufs[1], second.x, second.y, second.width, second.height);
+	zassert_mem_equal(screen, bufs[1], FB_SIZE);
+	zassert_mem_equal(bufs[0], bufs[1], FB_SIZE);
+}
+
+ZTEST(fb_dirty, test_write_error)
+{
+	struct fb_dirty_rect rect = { 0, 0, 1, 1 };
+
+	/* Reported by the flush itself with a single framebuffer */
+	zassert_ok(fb_dirty_init(&fb, &display_mock, bufs[0], NULL, FB_SIZE));
+	write_ret = -EIO;
+	render(&rect, 1);
+	zassert_equal(fb_dirty_flush(&fb), -EIO);
+
+	/* Reported once by the next sync or flush with two framebuffers */
+	zassert_ok(fb_dirty_init(&fb, &display_mock, bufs[0], bufs[1], FB_SIZE));
+	render(&rect, 1);
+	zassert_ok(fb_dirty_flush(&fb));
+	zassert_equal(fb_dirty_sync(&fb, K_FOREVER), -EIO);
+	zassert_ok(fb_dirty_sync(&fb, K_FOREVER));
+
+	render(&rect, 2);
+	zassert_ok(fb_dirty_flush(&fb));
+	render(&rect, 3);
+	zassert_equal(fb_dirty_flush(&fb), -EIO);
+	zassert_equal(fb_dirty_sync(&fb, K_FOREVER), -EIO);
+
+	write_ret = 0;
+	render(&rect, 4);
+	zassert_ok(fb_dirty_flush(&fb));
+	zassert_ok(fb_dirty_sync(&fb, K_FOREVER));
+	zassert_equal(n_writes, 1);
+}
+
+ZTEST_SUITE(fb_dirty, NULL, NULL, fb_dirty_before, NULL, NULL);
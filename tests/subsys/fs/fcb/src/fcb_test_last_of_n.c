@@ -75,3 +75,48 @@ ZTEST(fcb_test_with_4sectors_set, test_fcb_last_of_n)
 		     areas[0].fe_data_len == loc.fe_data_len,
 		     "fcb_offset_last_n: fetched wrong n-th location");
 }
+
+ZTEST(fcb_test_with_4sectors_set, test_fcb_last_of_n_sectors)
+{
+	static struct fcb_entry areas[300];
+	const uint8_t last_n[] = { 1U, 100U, 200U, 255U };
+	struct fcb *fcb;
+	int rc;
+	struct fcb_entry loc;
+	uint8_t test_data[128] = {0};
+	int i;
+	int j;
+
+	fcb = &test_fcb;
+	fcb->f_scratch_cnt = 1U;
+
+	/*
+	 * Add enough fcbs to fill several sectors.
+	 */
+	for (i = 0; i < ARRAY_SIZE(areas); i++) {
+		rc = fcb_append(fcb, sizeof(test_data), &loc);
+		zassert_true(rc == 0, "fcb_append call failure");
+
+		rc = flash_area_write(fcb->fap, FCB_ENTRY_FA_DATA_OFF(loc),
+				      test_data, sizeof(test_data));
+		zassert_true(rc == 0, "flash_area_write call failure");
+
+		rc = fcb_append_finish(fcb, &loc);
+		zassert_true(rc == 0, "fcb_append_finish call failure");
+
+		areas[i] = loc;
+	}
+
+	/* Twice, the second time from the sector summaries if enabled */
+	for (j = 0; j < 2; j++) {
+		for (i = 0; i < ARRAY_SIZE(last_n); i++) {
+			rc = fcb_offset_last_n(fcb, last_n[i], &loc);
+			zassert_true(rc == 0, "fcb_offset_last_n call failure");
+			zassert_true(areas[ARRAY_SIZE(areas) - last_n[i]].fe_sector ==
+				     loc.fe_sector &&
+				     areas[ARRAY_SIZE(areas) - last_n[i]].fe_data_off ==
+				     loc.fe_data_off,
+				     "fcb_offset_last_n: fetched wrong n-th location");
+		}
+	}
+}
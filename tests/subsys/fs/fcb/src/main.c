@@ -47,6 +47,9 @@ struct flash_sector test_fcb_sector[] = {
 	}
 };
 
+#ifdef CONFIG_FCB_SECTOR_SUMMARY
+static struct fcb_sector_summary test_fcb_summary[ARRAY_SIZE(test_fcb_sector)];
+#endif
 
 void test_fcb_wipe(void)
 {
@@ -118,6 +121,9 @@ void fcb_tc_pretest(int sectors, struct fcb *_fcb)
 	_fcb->f_erase_value = fcb_test_erase_value;
 	_fcb->f_sector_cnt = sectors;
 	_fcb->f_sectors = test_fcb_sector; /* XXX */
+#ifdef CONFIG_FCB_SECTOR_SUMMARY
+	_fcb->f_summaries = test_fcb_summary;
+#endif
 
 	rc = 0;
 	rc = fcb_init(TEST_FCB_FLASH_AREA_ID, _fcb);
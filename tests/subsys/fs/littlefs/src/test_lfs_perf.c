@@ -6,6 +6,7 @@
 
 /* littlefs performance testing */
 
+#include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
 #include <zephyr/kernel.h>
@@ -157,6 +158,113 @@ out_mnt:
 	return rv;
 }
 
+static void print_rate(const char *tag, const char *what, size_t nops,
+		       uint32_t t0, uint32_t t1)
+{
+	if (t1 == t0) {
+		t1++;
+	}
+
+	TC_PRINT("%s %s %zu in %u ms: %u op/s\n", tag, what, nops, (t1 - t0),
+		 (uint32_t)(nops * 1000U / (t1 - t0)));
+}
+
+/* Metadata heavy workload: records appended to several files in turn,
+ * opening and closing them each time like the settings file backend
+ * and log rotation do.
+ */
+static int open_stat_append(const char *tag,
+			    struct fs_mount_t *mp,
+			    size_t nfiles,
+			    size_t nrounds)
+{
+	struct testfs_path path;
+	struct fs_dirent stat;
+	struct fs_file_t file;
+	char name[8];
+	uint32_t t0;
+	uint32_t t1;
+	int rc;
+	int rv = TC_FAIL;
+
+	fs_file_t_init(&file);
+	TC_PRINT("clearing %s for %s open/stat/append test\n",
+		 mp->mnt_point, tag);
+	if (testfs_lfs_wipe_partition(mp) != TC_PASS) {
+		return TC_FAIL;
+	}
+
+	rc = fs_mount(mp);
+	if (rc != 0) {
+		TC_PRINT("Mount %s failed: %d\n", mp->mnt_point, rc);
+		return TC_FAIL;
+	}
+
+#ifdef CONFIG_FS_LITTLEFS_SHARED_CACHE
+	fs_littlefs_cache_stats_reset();
+#endif
+
+	t0 = k_uptime_get_32();
+	for (size_t r = 0; r < nrounds; ++r) {
+		for (size_t i = 0; i < nfiles; ++i) {
+			snprintf(name, sizeof(name), "log%zu", i);
+			testfs_path_init(&path, mp, name, TESTFS_PATH_END);
+
+			rc = fs_open(&file, path.path,
+				     FS_O_CREATE | FS_O_WRITE | FS_O_APPEND);
+			if (rc != 0) {
+				TC_PRINT("Failed to open %s: %d\n", path.path, rc);
+				goto out_mnt;
+			}
+
+			rc = fs_write(&file, HELLO, sizeof(HELLO));
+			(void)fs_close(&file);
+			if (rc != sizeof(HELLO)) {
+				TC_PRINT("Failed to append to %s: %d\n", path.path, rc);
+				goto out_mnt;
+			}
+		}
+	}
+	t1 = k_uptime_get_32();
+	print_rate(tag, "open+append+close", nrounds * nfiles, t0, t1);
+
+	t0 = k_uptime_get_32();
+	for (size_t r = 0; r < nrounds; ++r) {
+		for (size_t i = 0; i < nfiles; ++i) {
+			snprintf(name, sizeof(name), "log%zu", i);
+			testfs_path_init(&path, mp, name, TESTFS_PATH_END);
+
+			rc = fs_stat(path.path, &stat);
+			if (rc != 0) {
+				TC_PRINT("Failed to stat %s: %d\n", path.path, rc);
+				goto out_mnt;
+			}
+			if (stat.size != nrounds * sizeof(HELLO)) {
+				TC_PRINT("File size %zu not %zu\n", stat.size,
+					 nrounds * sizeof(HELLO));
+				goto out_mnt;
+			}
+		}
+	}
+	t1 = k_uptime_get_32();
+	print_rate(tag, "stat", nrounds * nfiles, t0, t1);
+
+#ifdef CONFIG_FS_LITTLEFS_SHARED_CACHE
+	struct fs_littlefs_cache_stats cache;
+
+	fs_littlefs_cache_stats_get(&cache);
+	TC_PRINT("%s shared cache: %u hits, %u misses\n", tag, cache.hits,
+		 cache.misses);
+#endif
+
+	rv = TC_PASS;
+
+out_mnt:
+	(void)fs_unmount(mp);
+
+	return rv;
+}
+
 static int custom_write_test(const char *tag,
 			     const struct fs_mount_t *mp,
 			     const struct lfs_config *cfgp,
@@ -232,6 +340,13 @@ ZTEST(littlefs, test_lfs_perf)
 		      TC_PASS,
 		      "failed");
 
+	k_sleep(K_MSEC(100));   /* flush log messages */
+	zassert_equal(open_stat_append("small 4 files 16 rounds",
+				       &testfs_small_mnt,
+				       4, 16),
+		      TC_PASS,
+		      "failed");
+
 	if (IS_ENABLED(CONFIG_APP_TEST_CUSTOM)) {
 		k_sleep(K_MSEC(100));   /* flush log messages */
 		zassert_equal(small_8_1K_cust(), TC_PASS,
@@ -869,3 +869,124 @@ ZTEST_F(nvs, test_nvs_cache_gc)
 	zassert_equal(num, 2, "invalid cache content after gc");
 #endif
 }
+
+/*
+ * Test that nvs_mount() rebuilds the lookup cache from the checkpoint and the
+ * ATEs written after it
+ */
+ZTEST_F(nvs, test_nvs_cache_checkpoint)
+{
+#ifdef CONFIG_NVS_LOOKUP_CACHE_CHECKPOINT
+	int err;
+	uint32_t data, ates;
+	uint32_t ckpt[CONFIG_NVS_LOOKUP_CACHE_SIZE];
+	uint32_t values[16];
+	const uint16_t max_id = ARRAY_SIZE(values);
+
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0, "nvs_mount call failure: %d", err);
+
+	/* Write enough ATEs for a checkpoint, with gc of the older sectors */
+	for (data = 0; data < 2 * CONFIG_NVS_LOOKUP_CACHE_CHECKPOINT_INTERVAL; data++) {
+		err = nvs_write(&fixture->fs, data % max_id, &data, sizeof(data));
+		zassert_equal(err, sizeof(data), "nvs_write call failure: %d", err);
+		values[data % max_id] = data;
+	}
+
+	err = nvs_read(&fixture->fs, CONFIG_NVS_LOOKUP_CACHE_CHECKPOINT_ID, ckpt, sizeof(ckpt));
+	zassert_equal(err, sizeof(ckpt), "checkpoint not written: %d", err);
+
+	/* Updates and deletes after the checkpoint */
+	for (uint16_t id = 0; id < 3; id++) {
+		values[id] = data++;
+		err = nvs_write(&fixture->fs, id, &values[id], sizeof(values[id]));
+		zassert_equal(err, sizeof(values[id]), "nvs_write call failure: %d", err);
+	}
+	err = nvs_delete(&fixture->fs, 3);
+	zassert_true(err == 0, "nvs_delete call failure: %d", err);
+
+	ates = fixture->fs.lookup_cache_ckpt_ates;
+	zassert_true(ates < CONFIG_NVS_LOOKUP_CACHE_CHECKPOINT_INTERVAL, "no recent checkpoint");
+
+	memset(fixture->fs.lookup_cache, 0xAA, sizeof(fixture->fs.lookup_cache));
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0, "nvs_mount call failure: %d", err);
+
+	/* Only the free ATE, the ATEs after the checkpoint and the checkpoint
+	 * were read
+	 */
+	zassert_true(fixture->fs.lookup_cache_ckpt_ates <= ates + 2,
+		     "mount read %u ATEs", fixture->fs.lookup_cache_ckpt_ates);
+
+	for (uint16_t id = 0; id < max_id; id++) {
+		err = nvs_read(&fixture->fs, id, &data, sizeof(data));
+		if (id == 3) {
+			zassert_equal(err, -ENOENT, "deleted entry found: %d", err);
+			continue;
+		}
+		zassert_equal(err, sizeof(data), "nvs_read call failure: %d", err);
+		zassert_equal(data, values[id], "incorrect data read for id %u", id);
+	}
+#else
+	ztest_test_skip();
+#endif
+}
+
+/*
+ * Test that the background gc closes the sector being written ahead of time
+ * and erases the collected sector
+ */
+ZTEST_F(nvs, test_nvs_gc_background)
+{
+#ifdef CONFIG_NVS_GC_BACKGROUND
+	int err;
+	uint8_t erased[32];
+	uint8_t rd_buf[32];
+	const uint16_t max_id = 10;
+	uint16_t writes = 0;
+	uint32_t addr, threshold;
+	off_t offset;
+
+	fixture->fs.sector_count = 3;
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0, "nvs_mount call failure: %d", err);
+
+	threshold = fixture->fs.sector_size * CONFIG_NVS_GC_BACKGROUND_THRESHOLD / 100U;
+
+	/* Fill the first sector up to the threshold */
+	while (fixture->fs.ate_wra - fixture->fs.data_wra >= threshold) {
+		write_content(max_id, writes, writes + 1, &fixture->fs);
+		writes++;
+	}
+	zassert_equal(fixture->fs.ate_wra >> ADDR_SECT_SHIFT, 0, "unexpected write sector");
+
+	/* Let the work queue close the sector */
+	k_sleep(K_MSEC(100));
+
+	zassert_equal(fixture->fs.ate_wra >> ADDR_SECT_SHIFT, 1, "sector not closed by gc");
+	zassert_false(fixture->fs.gc_erase_pending, "collected sector not erased");
+
+	/* The sector after the write sector is erased */
+	memset(erased, fixture->fs.flash_parameters->erase_value, sizeof(erased));
+	addr = 2 << ADDR_SECT_SHIFT;
+	offset = fixture->fs.offset + fixture->fs.sector_size * (addr >> ADDR_SECT_SHIFT);
+	for (uint32_t i = 0; i < fixture->fs.sector_size; i += sizeof(rd_buf)) {
+		err = flash_read(fixture->fs.flash_device, offset + i, rd_buf, sizeof(rd_buf));
+		zassert_true(err == 0, "flash_read call failure: %d", err);
+		zassert_mem_equal(rd_buf, erased, sizeof(rd_buf), "sector not erased");
+	}
+
+	check_content(MIN(writes, max_id), &fixture->fs);
+
+	/* A write closing the sector before the background erase erases it */
+	write_content(max_id, writes, writes + 3 * fixture->fs.sector_size / 40U,
+		      &fixture->fs);
+	check_content(max_id, &fixture->fs);
+
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0, "nvs_mount call failure: %d", err);
+	check_content(max_id, &fixture->fs);
+#else
+	ztest_test_skip();
+#endif
+}
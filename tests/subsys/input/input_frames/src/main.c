@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+
+#include <zephyr/input/input.h>
+#include <zephyr/ztest.h>
+#include <zephyr/device.h>
+
+static const struct device fake_dev;
+
+static int event_count;
+static int frame_count;
+static struct input_event last_frame[CONFIG_INPUT_FRAME_MAX_EVENTS];
+static size_t last_frame_len;
+
+static void input_cb(struct input_event *evt)
+{
+	event_count++;
+}
+INPUT_CALLBACK_DEFINE(&fake_dev, input_cb);
+
+static void input_frame_cb(const struct input_event *evts, size_t n_evts)
+{
+	frame_count++;
+	memcpy(last_frame, evts, n_evts * sizeof(evts[0]));
+	last_frame_len = n_evts;
+}
+INPUT_FRAME_CALLBACK_DEFINE(&fake_dev, input_frame_cb);
+
+/* The test thread is cooperative, the input thread runs once it sleeps */
+static void report_frames(int n_frames)
+{
+	for (int i = 0; i < n_frames; i++) {
+		zassert_ok(input_report_abs(&fake_dev, INPUT_ABS_X, 10 * i, false, K_FOREVER));
+		zassert_ok(input_report_abs(&fake_dev, INPUT_ABS_Y, 10 * i + 1, false,
+					    K_FOREVER));
+		zassert_ok(input_report_rel(&fake_dev, INPUT_REL_WHEEL, 1, true, K_FOREVER));
+	}
+
+	k_sleep(K_MSEC(10));
+}
+
+ZTEST(input_frames, test_frame)
+{
+	report_frames(1);
+
+	zassert_equal(event_count, 3);
+	zassert_equal(frame_count, 1);
+	zassert_equal(last_frame_len, 3);
+	zassert_equal(last_frame[0].code, INPUT_ABS_X);
+	zassert_equal(last_frame[1].code, INPUT_ABS_Y);
+	zassert_equal(last_frame[2].code, INPUT_REL_WHEEL);
+	zassert_false(last_frame[0].sync);
+	zassert_true(last_frame[2].sync);
+}
+
+ZTEST(input_frames, test_no_wakeup_before_sync)
+{
+	zassert_ok(input_report_abs(&fake_dev, INPUT_ABS_X, 1, false, K_FOREVER));
+	k_sleep(K_MSEC(10));
+
+	zassert_equal(event_count, 0, "input thread woken up before the sync");
+
+	zassert_ok(input_report_abs(&fake_dev, INPUT_ABS_Y, 2, true, K_FOREVER));
+	k_sleep(K_MSEC(10));
+
+	zassert_equal(event_count, 2);
+	zassert_equal(frame_count, 1);
+	zassert_equal(last_frame_len, 2);
+}
+
+ZTEST(input_frames, test_lagging_frames)
+{
+	report_frames(3);
+
+	/* The listeners of the events get all of them */
+	zassert_equal(event_count, 9);
+
+	if (!IS_ENABLED(CONFIG_INPUT_FRAME_COALESCE)) {
+		zassert_equal(frame_count, 3);
+		zassert_equal(last_frame[0].value, 20);
+		return;
+	}
+
+	zassert_equal(frame_count, 1);
+	zassert_equal(last_frame_len, 3);
+	zassert_equal(last_frame[0].value, 20, "last absolute position");
+	zassert_equal(last_frame[1].value, 21, "last absolute position");
+	zassert_equal(last_frame[2].value, 3, "sum of the relative motions");
+	zassert_false(last_frame[0].sync);
+	zassert_false(last_frame[1].sync);
+	zassert_true(last_frame[2].sync);
+}
+
+ZTEST(input_frames, test_key_not_merged)
+{
+	report_frames(1);
+	zassert_ok(input_report_key(&fake_dev, INPUT_KEY_A, 1, true, K_FOREVER));
+	k_sleep(K_MSEC(10));
+
+	zassert_equal(frame_count, 2);
+	zassert_equal(last_frame_len, 1);
+	zassert_equal(last_frame[0].code, INPUT_KEY_A);
+}
+
+static void input_frames_before(void *fixture)
+{
+	event_count = 0;
+	frame_count = 0;
+	last_frame_len = 0;
+}
+
+ZTEST_SUITE(input_frames, NULL, NULL, input_frames_before, NULL, NULL);
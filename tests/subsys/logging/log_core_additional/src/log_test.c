@@ -320,6 +320,47 @@ ZTEST(test_log_core_additional, test_log_severity)
 		      "Unexpected amount of messages received by the backend.");
 }
 
+#if defined(CONFIG_LOG_RATELIMIT_SITE)
+static void log_storm_site(int i)
+{
+	LOG_WRN("storm message %d", i);
+}
+
+/**
+ * @brief Rate limiting of messages per call site
+ *
+ * @details Messages above the burst allowed for a call site are suppressed,
+ *          the number of suppressed messages is logged with the next message
+ *          allowed for the site.
+ *
+ * @addtogroup logging
+ */
+ZTEST(test_log_core_additional, test_log_ratelimit_site)
+{
+	log_setup(false);
+
+	for (int i = 0; i < CONFIG_LOG_RATELIMIT_SITE_BURST + 5; i++) {
+		log_storm_site(i);
+	}
+
+	while (log_test_process()) {
+	}
+
+	zassert_equal(backend1_cb.counter, CONFIG_LOG_RATELIMIT_SITE_BURST,
+		      "Unexpected amount of messages received by the backend.");
+
+	k_msleep(CONFIG_LOG_RATELIMIT_SITE_INTERVAL_MS);
+	log_storm_site(0);
+
+	while (log_test_process()) {
+	}
+
+	/* Number of suppressed messages followed by the message. */
+	zassert_equal(backend1_cb.counter, CONFIG_LOG_RATELIMIT_SITE_BURST + 2,
+		      "Unexpected amount of messages received by the backend.");
+}
+#endif
+
 /**
  * @brief Customizable timestamping in log messages
  *
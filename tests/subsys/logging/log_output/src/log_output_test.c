@@ -76,6 +76,30 @@ ZTEST(test_log_output, test_raw)
 	zassert_equal(strcmp(exp_str, mock_buffer), 0);
 }
 
+ZTEST(test_log_output, test_skip_flush)
+{
+	char package[256];
+	static const char *exp_str = SNAME ": " TEST_STR "\r\n" SNAME ": " TEST_STR "\r\n";
+	int err;
+
+	err = cbprintf_package(package, sizeof(package), 0, TEST_STR);
+	zassert_true(err > 0);
+
+	/* Output is written only when the output buffer is full */
+	for (int i = 0; i < 2; i++) {
+		log_output_process(&log_output, 0, NULL, SNAME, LOG_LEVEL_INF, package, NULL, 0,
+				   LOG_OUTPUT_FLAG_SKIP_FLUSH);
+	}
+
+	zassert_true(mock_len < strlen(exp_str));
+	zassert_equal(mock_len % sizeof(log_output_buf), 0);
+
+	log_output_flush(&log_output);
+
+	mock_buffer[mock_len] = '\0';
+	zassert_equal(strcmp(exp_str, mock_buffer), 0);
+}
+
 ZTEST(test_log_output, test_no_flags_dname)
 {
 	char package[256];
@@ -148,6 +172,31 @@ ZTEST(test_log_output, test_format_ts)
 	zassert_equal(strcmp(exp_str, mock_buffer), 0);
 }
 
+ZTEST(test_log_output, test_format_ts_same_second)
+{
+	char package[256];
+	static const char *exp_str =
+		"[00:00:01.000,001] " SNAME ": " TEST_STR "\r\n"
+		"[00:00:01.500,000] " SNAME ": " TEST_STR "\r\n"
+		"[00:00:02.000,000] " SNAME ": " TEST_STR "\r\n";
+	static const log_timestamp_t timestamps[] = { 1000001, 1500000, 2000000 };
+	uint32_t flags = LOG_OUTPUT_FLAG_TIMESTAMP | LOG_OUTPUT_FLAG_FORMAT_TIMESTAMP;
+	int err;
+
+	log_output_timestamp_freq_set(1000000);
+
+	err = cbprintf_package(package, sizeof(package), 0, TEST_STR);
+	zassert_true(err > 0);
+
+	for (int i = 0; i < ARRAY_SIZE(timestamps); i++) {
+		log_output_process(&log_output, timestamps[i], NULL, SNAME,
+				   LOG_LEVEL_INF, package, NULL, 0, flags);
+	}
+
+	mock_buffer[mock_len] = '\0';
+	zassert_equal(strcmp(exp_str, mock_buffer), 0);
+}
+
 ZTEST(test_log_output, test_ts_to_us)
 {
 	log_output_timestamp_freq_set(1000000);
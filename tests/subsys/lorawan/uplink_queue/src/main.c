@@ -0,0 +1,305 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/lorawan/lorawan.h>
+#include <zephyr/ztest.h>
+
+#include "lw_priv.h"
+
+#define QUEUE_SIZE CONFIG_LORAWAN_UPLINK_QUEUE_SIZE
+#define MSG_SIZE CONFIG_LORAWAN_UPLINK_QUEUE_MSG_SIZE
+#define MAX_FRAMES 8
+#define PAYLOAD_SIZE 51
+#define DC_WAIT_MS 100
+#define DONE_TIMEOUT K_SECONDS(5)
+
+/* Mock of the LoRaWAN stack, recording the frames sent and returning the results scripted */
+struct mock_frame {
+	uint8_t port;
+	uint8_t len;
+	enum lorawan_message_type type;
+	uint8_t data[PAYLOAD_SIZE];
+};
+
+static struct mock_frame frames[MAX_FRAMES];
+static int n_frames;
+static int send_ret[MAX_FRAMES];
+static uint32_t send_dc_wait_ms[MAX_FRAMES];
+static uint8_t max_next_payload;
+static uint8_t max_payload;
+
+void lorawan_get_payload_sizes(uint8_t *max_next_payload_size, uint8_t *max_payload_size)
+{
+	*max_next_payload_size = max_next_payload;
+	*max_payload_size = max_payload;
+}
+
+int lorawan_send_frame(uint8_t port, uint8_t *data, uint8_t len,
+		       enum lorawan_message_type type, uint32_t *dc_wait_ms)
+{
+	int i = n_frames;
+
+	zassert_true(i < MAX_FRAMES, "Too many frames");
+	zassert_true(len <= max_next_payload, "Frame of %u bytes too long", len);
+
+	frames[i].port = port;
+	frames[i].len = len;
+	frames[i].type = type;
+	memcpy(frames[i].data, data, len);
+	n_frames++;
+
+	*dc_wait_ms = send_dc_wait_ms[i];
+
+	return send_ret[i];
+}
+
+/* Outcome of a queued message, as reported to its callback */
+struct uplink_result {
+	int status;
+	uint32_t latency_ms;
+	int calls;
+};
+
+static struct uplink_result results[MAX_FRAMES];
+static K_SEM_DEFINE(done_sem, 0, MAX_FRAMES);
+
+static void uplink_cb(int status, uint32_t latency_ms, void *user_data)
+{
+	struct uplink_result *result = user_data;
+
+	result->status = status;
+	result->latency_ms = latency_ms;
+	result->calls++;
+
+	k_sem_give(&done_sem);
+}
+
+/* Queue len bytes numbered from first, reported in results[idx] */
+static int send(int idx, uint8_t port, uint8_t first, uint8_t len,
+		enum lorawan_message_type type)
+{
+	uint8_t data[MSG_SIZE + 1];
+
+	for (uint8_t i = 0; i < len; i++) {
+		data[i] = first + i;
+	}
+
+	return lorawan_send_async(port, data, len, type, uplink_cb, &results[idx]);
+}
+
+static void wait_done(int count)
+{
+	for (int i = 0; i < count; i++) {
+		zassert_ok(k_sem_take(&done_sem, DONE_TIMEOUT), "Message not reported");
+	}
+
+	zassert_equal(k_sem_count_get(&done_sem), 0, "Message reported twice");
+}
+
+static void check_frame(int idx, uint8_t port, enum lorawan_message_type type,
+			const uint8_t *data, uint8_t len)
+{
+	zassert_true(idx < n_frames, "Frame %d not sent", idx);
+	zassert_equal(frames[idx].port, port, "Frame %d on port %u", idx, frames[idx].port);
+	zassert_equal(frames[idx].type, type, "Frame %d of wrong type", idx);
+	zassert_equal(frames[idx].len, len, "Frame %d of %u bytes", idx, frames[idx].len);
+	zassert_mem_equal(frames[idx].data, data, len, "Frame %d differs", idx);
+}
+
+static void check_result(int idx, int status)
+{
+	zassert_equal(results[idx].calls, 1, "Message %d reported %d times", idx,
+		      results[idx].calls);
+	zassert_equal(results[idx].status, status, "Message %d reported %d", idx,
+		      results[idx].status);
+}
+
+static void uplink_queue_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	memset(frames, 0, sizeof(frames));
+	memset(send_ret, 0, sizeof(send_ret));
+	memset(send_dc_wait_ms, 0, sizeof(send_dc_wait_ms));
+	memset(results, 0, sizeof(results));
+	n_frames = 0;
+	max_next_payload = PAYLOAD_SIZE;
+	max_payload = PAYLOAD_SIZE;
+	k_sem_reset(&done_sem);
+}
+
+ZTEST(lorawan_uplink_queue, test_invalid)
+{
+	uint8_t data[MSG_SIZE + 1] = { 0 };
+
+	zassert_equal(lorawan_send_async(0, data, 1, LORAWAN_MSG_UNCONFIRMED, NULL, NULL),
+		      -EINVAL);
+	zassert_equal(lorawan_send_async(1, NULL, 1, LORAWAN_MSG_UNCONFIRMED, NULL, NULL),
+		      -EINVAL);
+	zassert_equal(lorawan_send_async(1, data, 0, LORAWAN_MSG_UNCONFIRMED, NULL, NULL),
+		      -EINVAL);
+	zassert_equal(lorawan_send_async(1, data, MSG_SIZE + 1, LORAWAN_MSG_UNCONFIRMED, NULL,
+					 NULL), -EMSGSIZE);
+
+	k_msleep(10);
+	zassert_equal(n_frames, 0, "Invalid message sent");
+}
+
+ZTEST(lorawan_uplink_queue, test_send_in_order)
+{
+	uint8_t data[] = { 0x10, 0x11, 0x12, 0x13, 0x14 };
+
+	zassert_ok(send(0, 1, 0x00, 3, LORAWAN_MSG_UNCONFIRMED));
+	zassert_ok(send(1, 2, 0x10, 5, LORAWAN_MSG_CONFIRMED));
+	zassert_ok(lorawan_send_async(3, data, 2, LORAWAN_MSG_UNCONFIRMED, NULL, NULL));
+
+	/* Copied when queued */
+	memset(data, 0, sizeof(data));
+
+	wait_done(2);
+	k_msleep(10);
+
+	zassert_equal(n_frames, 3);
+	check_frame(0, 1, LORAWAN_MSG_UNCONFIRMED, (uint8_t[]){ 0x00, 0x01, 0x02 }, 3);
+	check_frame(1, 2, LORAWAN_MSG_CONFIRMED,
+		    (uint8_t[]){ 0x10, 0x11, 0x12, 0x13, 0x14 }, 5);
+	check_frame(2, 3, LORAWAN_MSG_UNCONFIRMED, (uint8_t[]){ 0x10, 0x11 }, 2);
+	check_result(0, 0);
+	check_result(1, 0);
+}
+
+ZTEST(lorawan_uplink_queue, test_queue_full)
+{
+	for (int i = 0; i < QUEUE_SIZE; i++) {
+		zassert_ok(send(i, i + 1, i, 1, LORAWAN_MSG_UNCONFIRMED));
+	}
+
+	zassert_equal(send(QUEUE_SIZE, 1, 0, 1, LORAWAN_MSG_UNCONFIRMED), -ENOSPC);
+
+	wait_done(QUEUE_SIZE);
+	zassert_equal(n_frames, QUEUE_SIZE);
+
+	/* The entries are free again once reported */
+	for (int i = 0; i < QUEUE_SIZE; i++) {
+		check_result(i, 0);
+		zassert_ok(send(i, 1, i, 1, LORAWAN_MSG_UNCONFIRMED));
+	}
+
+	wait_done(QUEUE_SIZE);
+}
+
+ZTEST(lorawan_uplink_queue, test_aggregate)
+{
+	max_next_payload = 10;
+
+	/* Same port and type concatenated as long as they fit in the next frame */
+	zassert_ok(send(0, 1, 0x00, 4, LORAWAN_MSG_UNCONFIRMED));
+	zassert_ok(send(1, 2, 0x10, 3, LORAWAN_MSG_UNCONFIRMED));
+	zassert_ok(send(2, 1, 0x04, 4, LORAWAN_MSG_UNCONFIRMED));
+	zassert_ok(send(3, 1, 0x20, 4, LORAWAN_MSG_UNCONFIRMED));
+	zassert_ok(send(4, 1, 0x30, 2, LORAWAN_MSG_CONFIRMED));
+
+	wait_done(5);
+
+	zassert_equal(n_frames, 4);
+	check_frame(0, 1, LORAWAN_MSG_UNCONFIRMED,
+		    (uint8_t[]){ 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07 }, 8);
+	check_frame(1, 2, LORAWAN_MSG_UNCONFIRMED, (uint8_t[]){ 0x10, 0x11, 0x12 }, 3);
+	check_frame(2, 1, LORAWAN_MSG_UNCONFIRMED, (uint8_t[]){ 0x20, 0x21, 0x22, 0x23 }, 4);
+	check_frame(3, 1, LORAWAN_MSG_CONFIRMED, (uint8_t[]){ 0x30, 0x31 }, 2);
+
+	for (int i = 0; i < 5; i++) {
+		check_result(i, 0);
+	}
+}
+
+ZTEST(lorawan_uplink_queue, test_too_long_for_datarate)
+{
+	max_next_payload = 4;
+	max_payload = 8;
+
+	/* Dropped without being sent, the next messages still go out */
+	zassert_ok(send(0, 1, 0x00, 12, LORAWAN_MSG_UNCONFIRMED));
+	zassert_ok(send(1, 2, 0x10, 4, LORAWAN_MSG_UNCONFIRMED));
+
+	wait_done(2);
+
+	check_result(0, -EMSGSIZE);
+	check_result(1, 0);
+	zassert_equal(n_frames, 1);
+	check_frame(0, 2, LORAWAN_MSG_UNCONFIRMED, (uint8_t[]){ 0x10, 0x11, 0x12, 0x13 }, 4);
+}
+
+ZTEST(lorawan_uplink_queue, test_duty_cycle)
+{
+	uint8_t data[] = { 0x00, 0x01 };
+
+	send_ret[0] = -ECONNREFUSED;
+	send_dc_wait_ms[0] = DC_WAIT_MS;
+
+	zassert_ok(send(0, 1, 0x00, 2, LORAWAN_MSG_UNCONFIRMED));
+	k_msleep(10);
+	zassert_equal(n_frames, 1);
+
+	/* Queued behind the delayed frame, not sent before it */
+	zassert_ok(send(1, 2, 0x10, 1, LORAWAN_MSG_UNCONFIRMED));
+	k_msleep(10);
+	zassert_equal(n_frames, 1, "Message sent during the duty-cycle wait");
+
+	wait_done(2);
+
+	zassert_equal(n_frames, 3);
+	check_frame(0, 1, LORAWAN_MSG_UNCONFIRMED, data, sizeof(data));
+	check_frame(1, 1, LORAWAN_MSG_UNCONFIRMED, data, sizeof(data));
+	check_frame(2, 2, LORAWAN_MSG_UNCONFIRMED, (uint8_t[]){ 0x10 }, 1);
+	check_result(0, 0);
+	check_result(1, 0);
+
+	zassert_true(results[0].latency_ms >= DC_WAIT_MS, "Latency of %u ms",
+		     results[0].latency_ms);
+}
+
+ZTEST(lorawan_uplink_queue, test_retry)
+{
+	/* Only MAC commands went out, the frame is sent again */
+	send_ret[0] = -EAGAIN;
+
+	zassert_ok(send(0, 1, 0x00, 3, LORAWAN_MSG_CONFIRMED));
+	zassert_ok(send(1, 1, 0x03, 2, LORAWAN_MSG_CONFIRMED));
+
+	wait_done(2);
+
+	zassert_equal(n_frames, 2);
+	check_frame(0, 1, LORAWAN_MSG_CONFIRMED, (uint8_t[]){ 0x00, 0x01, 0x02, 0x03, 0x04 },
+		    5);
+	check_frame(1, 1, LORAWAN_MSG_CONFIRMED, (uint8_t[]){ 0x00, 0x01, 0x02, 0x03, 0x04 },
+		    5);
+	check_result(0, 0);
+	check_result(1, 0);
+}
+
+ZTEST(lorawan_uplink_queue, test_send_error)
+{
+	/* Reported to every message of the frame, not sent again */
+	send_ret[0] = -EIO;
+
+	zassert_ok(send(0, 1, 0x00, 3, LORAWAN_MSG_CONFIRMED));
+	zassert_ok(send(1, 1, 0x03, 2, LORAWAN_MSG_CONFIRMED));
+	zassert_ok(send(2, 2, 0x10, 2, LORAWAN_MSG_CONFIRMED));
+
+	wait_done(3);
+
+	zassert_equal(n_frames, 2);
+	check_result(0, -EIO);
+	check_result(1, -EIO);
+	check_result(2, 0);
+	check_frame(1, 2, LORAWAN_MSG_CONFIRMED, (uint8_t[]){ 0x10, 0x11 }, 2);
+}
+
+ZTEST_SUITE(lorawan_uplink_queue, NULL, NULL, uplink_queue_before, NULL, NULL);
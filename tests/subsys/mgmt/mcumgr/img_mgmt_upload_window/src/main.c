@@ -0,0 +1,262 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/net/buf.h>
+#include <zephyr/storage/flash_map.h>
+#include <zephyr/mgmt/mcumgr/mgmt/mgmt.h>
+#include <zephyr/mgmt/mcumgr/transport/smp_dummy.h>
+#include <zephyr/mgmt/mcumgr/grp/img_mgmt/img_mgmt.h>
+#include <zcbor_common.h>
+#include <zcbor_decode.h>
+#include <zcbor_encode.h>
+#include <mgmt/mcumgr/util/zcbor_bulk.h>
+#include <string.h>
+#include <smp_internal.h>
+#include "smp_test_util.h"
+
+#define SMP_RESPONSE_WAIT_TIME 3
+#define ZCBOR_BUFFER_SIZE 128
+#define OUTPUT_BUFFER_SIZE 128
+#define ZCBOR_HISTORY_ARRAY_SIZE 4
+
+/* 8 chunks, the first one holds the image header */
+#define IMAGE_SIZE 256
+#define CHUNK_SIZE 32
+#define CHUNK_OFF(n) ((n) * CHUNK_SIZE)
+
+BUILD_ASSERT(CHUNK_SIZE >= sizeof(struct image_header), "Image header does not fit in a chunk");
+BUILD_ASSERT(2 * CHUNK_SIZE <= CONFIG_MCUMGR_GRP_IMG_UPLOAD_WINDOW_CHUNK_SIZE,
+	     "Overrun chunk cannot be buffered");
+
+/* One spare chunk so that a chunk can be sent past the end of the image */
+static uint8_t image[IMAGE_SIZE + CHUNK_SIZE];
+static uint8_t flash_data[IMAGE_SIZE];
+static struct net_buf *nb;
+static uint8_t seq;
+
+struct group_error {
+	uint16_t group;
+	uint16_t rc;
+	bool found;
+};
+
+struct upload_rsp {
+	uint32_t off;
+	bool off_found;
+	struct group_error err;
+};
+
+static bool mcumgr_ret_decode(zcbor_state_t *state, struct group_error *result)
+{
+	bool ok;
+	size_t decoded;
+	uint32_t tmp_group;
+	uint32_t tmp_rc;
+
+	struct zcbor_map_decode_key_val output_decode[] = {
+		ZCBOR_MAP_DECODE_KEY_DECODER("group", zcbor_uint32_decode, &tmp_group),
+		ZCBOR_MAP_DECODE_KEY_DECODER("rc", zcbor_uint32_decode, &tmp_rc),
+	};
+
+	result->found = false;
+
+	ok = zcbor_map_decode_bulk(state, output_decode, ARRAY_SIZE(output_decode), &decoded) == 0;
+
+	if (ok &&
+	    zcbor_map_decode_bulk_key_found(output_decode, ARRAY_SIZE(output_decode), "group") &&
+	    zcbor_map_decode_bulk_key_found(output_decode, ARRAY_SIZE(output_decode), "rc")) {
+		result->group = (uint16_t)tmp_group;
+		result->rc = (uint16_t)tmp_rc;
+		result->found = true;
+	}
+
+	return ok;
+}
+
+static void fill_image(uint8_t seed)
+{
+	struct image_header *hdr = (struct image_header *)image;
+
+	for (size_t i = 0; i < sizeof(image); i++) {
+		image[i] = (uint8_t)(seed + i);
+	}
+
+	memset(hdr, 0, sizeof(*hdr));
+	hdr->ih_magic = IMAGE_MAGIC;
+	hdr->ih_hdr_size = sizeof(*hdr);
+	hdr->ih_img_size = IMAGE_SIZE - sizeof(*hdr);
+}
+
+/* Sends the image data at the given offset and decodes the response */
+static void upload(uint32_t off, size_t len, struct upload_rsp *rsp)
+{
+	uint8_t buffer[ZCBOR_BUFFER_SIZE];
+	uint8_t buffer_out[OUTPUT_BUFFER_SIZE];
+	uint16_t buffer_size = 0;
+	zcbor_state_t zse[ZCBOR_HISTORY_ARRAY_SIZE] = { 0 };
+	zcbor_state_t zsd[ZCBOR_HISTORY_ARRAY_SIZE] = { 0 };
+	size_t decoded = 0;
+	bool received;
+	bool ok;
+
+	struct zcbor_map_decode_key_val output_decode[] = {
+		ZCBOR_MAP_DECODE_KEY_DECODER("off", zcbor_uint32_decode, &rsp->off),
+		ZCBOR_MAP_DECODE_KEY_DECODER("err", mcumgr_ret_decode, &rsp->err),
+	};
+
+	memset(rsp, 0, sizeof(*rsp));
+	zcbor_new_encode_state(zse, 2, buffer, ARRAY_SIZE(buffer), 0);
+
+	ok = create_img_mgmt_upload_packet(zse, off, &image[off], len, IMAGE_SIZE, buffer,
+					   buffer_out, &buffer_size, ++seq);
+	zassert_true(ok, "Expected packet creation to be successful");
+
+	smp_dummy_enable();
+	smp_dummy_clear_state();
+
+	(void)smp_dummy_tx_pkt(buffer_out, buffer_size);
+	smp_dummy_add_data();
+
+	received = smp_dummy_wait_for_data(SMP_RESPONSE_WAIT_TIME);
+	zassert_true(received, "Expected to receive data but timed out");
+
+	nb = smp_dummy_get_outgoing();
+	smp_dummy_disable();
+
+	(void)net_buf_pull_mem(nb, sizeof(struct smp_hdr));
+	zcbor_new_decode_state(zsd, 4, nb->data, nb->len, 1);
+	ok = zcbor_map_decode_bulk(zsd, output_decode, ARRAY_SIZE(output_decode), &decoded) == 0;
+	zassert_true(ok, "Expected decode to be successful");
+
+	rsp->off_found = zcbor_map_decode_bulk_key_found(output_decode, ARRAY_SIZE(output_decode),
+							 "off");
+
+	net_buf_unref(nb);
+	nb = NULL;
+}
+
+/* Sends a chunk and checks the offset the server reports it expects next */
+static void upload_chunk(size_t chunk, uint32_t expected_off)
+{
+	struct upload_rsp rsp;
+
+	upload(CHUNK_OFF(chunk), CHUNK_SIZE, &rsp);
+
+	zassert_false(rsp.err.found, "Unexpected error %d for chunk %zu", rsp.err.rc, chunk);
+	zassert_true(rsp.off_found, "Expected to get off in response to chunk %zu", chunk);
+	zassert_equal(rsp.off, expected_off, "Expected offset %u after chunk %zu, got %u",
+		      expected_off, chunk, rsp.off);
+}
+
+static void check_flash(void)
+{
+	const struct flash_area *fa;
+	int rc;
+
+	rc = flash_area_open(FIXED_PARTITION_ID(slot1_partition), &fa);
+	zassert_equal(rc, 0, "Expected to open the secondary slot");
+
+	rc = flash_area_read(fa, 0, flash_data, sizeof(flash_data));
+	flash_area_close(fa);
+
+	zassert_equal(rc, 0, "Expected to read the secondary slot");
+	zassert_mem_equal(flash_data, image, IMAGE_SIZE, "Expected uploaded image in flash");
+}
+
+ZTEST(img_mgmt_upload_window, test_out_of_order)
+{
+	fill_image(0x10);
+
+	upload_chunk(0, CHUNK_OFF(1));
+
+	/* Ahead of the next offset: kept, the missing offset is reported */
+	upload_chunk(3, CHUNK_OFF(1));
+	upload_chunk(2, CHUNK_OFF(1));
+
+	/* Filling the gap writes the kept chunks too */
+	upload_chunk(1, CHUNK_OFF(4));
+
+	upload_chunk(5, CHUNK_OFF(4));
+	upload_chunk(4, CHUNK_OFF(6));
+	upload_chunk(7, CHUNK_OFF(6));
+	upload_chunk(6, IMAGE_SIZE);
+
+	check_flash();
+}
+
+ZTEST(img_mgmt_upload_window, test_duplicates)
+{
+	fill_image(0x40);
+
+	upload_chunk(0, CHUNK_OFF(1));
+
+	/* A chunk kept twice is written once */
+	upload_chunk(2, CHUNK_OFF(1));
+	upload_chunk(2, CHUNK_OFF(1));
+	upload_chunk(1, CHUNK_OFF(3));
+
+	/* Chunks already written are dropped */
+	upload_chunk(1, CHUNK_OFF(3));
+	upload_chunk(2, CHUNK_OFF(3));
+
+	upload_chunk(3, CHUNK_OFF(4));
+	upload_chunk(4, CHUNK_OFF(5));
+	upload_chunk(5, CHUNK_OFF(6));
+	upload_chunk(6, CHUNK_OFF(7));
+	upload_chunk(7, IMAGE_SIZE);
+
+	check_flash();
+}
+
+ZTEST(img_mgmt_upload_window, test_window_full)
+{
+	fill_image(0x70);
+
+	upload_chunk(0, CHUNK_OFF(1));
+
+	/* Chunks 2 to 5 fill the window, chunk 6 is dropped */
+	BUILD_ASSERT(CONFIG_MCUMGR_GRP_IMG_UPLOAD_WINDOW == 4, "Test expects a window of 4");
+	upload_chunk(2, CHUNK_OFF(1));
+	upload_chunk(3, CHUNK_OFF(1));
+	upload_chunk(4, CHUNK_OFF(1));
+	upload_chunk(5, CHUNK_OFF(1));
+	upload_chunk(6, CHUNK_OFF(1));
+	upload_chunk(1, CHUNK_OFF(6));
+
+	/* The dropped chunk has to be sent again */
+	upload_chunk(7, CHUNK_OFF(6));
+	upload_chunk(6, IMAGE_SIZE);
+
+	check_flash();
+}
+
+ZTEST(img_mgmt_upload_window, test_overrun)
+{
+	struct upload_rsp rsp;
+
+	fill_image(0xa0);
+
+	upload_chunk(0, CHUNK_OFF(1));
+
+	/* A chunk ahead of the next offset must still end within the image */
+	upload(CHUNK_OFF(7), 2 * CHUNK_SIZE, &rsp);
+
+	zassert_true(rsp.err.found, "Expected to get err in response");
+	zassert_equal(rsp.err.group, MGMT_GROUP_ID_IMAGE, "Expected image group error");
+	zassert_equal(rsp.err.rc, IMG_MGMT_ERR_INVALID_IMAGE_DATA_OVERRUN,
+		      "Expected IMG_MGMT_ERR_INVALID_IMAGE_DATA_OVERRUN error");
+}
+
+static void cleanup_test(void *p)
+{
+	if (nb != NULL) {
+		net_buf_unref(nb);
+		nb = NULL;
+	}
+}
+
+ZTEST_SUITE(img_mgmt_upload_window, NULL, NULL, NULL, cleanup_test, NULL);
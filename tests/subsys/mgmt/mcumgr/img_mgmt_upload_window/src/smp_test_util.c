@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "smp_test_util.h"
+#include <zephyr/mgmt/mcumgr/grp/img_mgmt/img_mgmt.h>
+#include <zephyr/net/buf.h>
+#include <zephyr/sys/byteorder.h>
+#include <zcbor_encode.h>
+
+/* SMP header function for generating img_mgmt upload command header */
+void smp_make_hdr(struct smp_hdr *rsp_hdr, size_t len, uint8_t seq)
+{
+	*rsp_hdr = (struct smp_hdr) {
+		.nh_len = sys_cpu_to_be16(len),
+		.nh_flags = 0,
+		.nh_op = MGMT_OP_WRITE,
+		.nh_group = sys_cpu_to_be16(MGMT_GROUP_ID_IMAGE),
+		.nh_seq = seq,
+		.nh_id = IMG_MGMT_ID_UPLOAD,
+		.nh_version = 1,
+	};
+}
+
+/* Function for creating an img_mgmt upload command, the image size is only sent at offset 0 */
+bool create_img_mgmt_upload_packet(zcbor_state_t *zse, uint32_t off, const uint8_t *data,
+				   size_t data_len, uint32_t image_len, uint8_t *buffer,
+				   uint8_t *output_buffer, uint16_t *buffer_size, uint8_t seq)
+{
+	bool ok;
+
+	ok = zcbor_map_start_encode(zse, 3)				&&
+	     zcbor_tstr_put_lit(zse, "off")				&&
+	     zcbor_uint32_put(zse, off)					&&
+	     zcbor_tstr_put_lit(zse, "data")				&&
+	     zcbor_bstr_encode_ptr(zse, data, data_len);
+
+	if (ok && off == 0) {
+		ok = zcbor_tstr_put_lit(zse, "len")			&&
+		     zcbor_uint32_put(zse, image_len);
+	}
+
+	ok = ok && zcbor_map_end_encode(zse, 3);
+
+	*buffer_size = (zse->payload_mut - buffer);
+	smp_make_hdr((struct smp_hdr *)output_buffer, *buffer_size, seq);
+	memcpy(&output_buffer[sizeof(struct smp_hdr)], buffer, *buffer_size);
+	*buffer_size += sizeof(struct smp_hdr);
+
+	return ok;
+}
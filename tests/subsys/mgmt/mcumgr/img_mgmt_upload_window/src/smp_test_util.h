@@ -0,0 +1,23 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef H_SMP_TEST_UTIL_
+#define H_SMP_TEST_UTIL_
+
+#include <zephyr/ztest.h>
+#include <zephyr/mgmt/mcumgr/mgmt/mgmt.h>
+#include <zcbor_common.h>
+#include <smp_internal.h>
+
+/* SMP header function for generating img_mgmt upload command header */
+void smp_make_hdr(struct smp_hdr *rsp_hdr, size_t len, uint8_t seq);
+
+/* Function for creating an img_mgmt upload command, the image size is only sent at offset 0 */
+bool create_img_mgmt_upload_packet(zcbor_state_t *zse, uint32_t off, const uint8_t *data,
+				   size_t data_len, uint32_t image_len, uint8_t *buffer,
+				   uint8_t *output_buffer, uint16_t *buffer_size, uint8_t seq);
+
+#endif
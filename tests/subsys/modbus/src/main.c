@@ -71,4 +71,30 @@ ZTEST(modbus, test_setup_raw)
 	test_server_disable();
 }
 
+ZTEST(modbus, test_setup_raw_bulk)
+{
+	test_server_setup_raw_bulk();
+	test_client_setup_raw();
+	test_coil_wr_rd();
+	test_di_rd();
+	test_input_reg();
+	test_holding_reg();
+	test_diagnostic();
+	test_client_disable();
+	test_server_disable();
+}
+
+ZTEST(modbus, test_setup_raw_map)
+{
+	test_server_setup_raw_map();
+	test_client_setup_raw();
+	test_coil_wr_rd();
+	test_di_rd();
+	test_input_reg();
+	test_holding_reg();
+	test_diagnostic();
+	test_client_disable();
+	test_server_disable();
+}
+
 ZTEST_SUITE(modbus, NULL, NULL, NULL, NULL, NULL);
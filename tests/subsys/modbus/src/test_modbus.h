@@ -33,6 +33,8 @@ void test_server_setup_low_odd(void);
 void test_server_setup_high_even(void);
 void test_server_setup_ascii(void);
 void test_server_setup_raw(void);
+void test_server_setup_raw_bulk(void);
+void test_server_setup_raw_map(void);
 void test_server_disable(void);
 
 void test_client_setup_low_none(void);
@@ -171,6 +171,52 @@ static struct modbus_user_callbacks mbs_cbs = {
 	.holding_reg_wr_fp = holding_reg_wr_fp,
 };
 
+static int input_regs_rd(uint16_t addr, uint16_t *regs, uint16_t num)
+{
+	if (addr + num > ARRAY_SIZE(holding_reg)) {
+		return -ENOTSUP;
+	}
+
+	memcpy(regs, &holding_reg[addr], num * sizeof(uint16_t));
+
+	return 0;
+}
+
+static int holding_regs_rd(uint16_t addr, uint16_t *regs, uint16_t num)
+{
+	if (addr + num > ARRAY_SIZE(holding_reg)) {
+		return -ENOTSUP;
+	}
+
+	memcpy(regs, &holding_reg[addr], num * sizeof(uint16_t));
+
+	return 0;
+}
+
+static int holding_regs_wr(uint16_t addr, const uint16_t *regs, uint16_t num)
+{
+	if (addr + num > ARRAY_SIZE(holding_reg)) {
+		return -ENOTSUP;
+	}
+
+	memcpy(&holding_reg[addr], regs, num * sizeof(uint16_t));
+
+	return 0;
+}
+
+static struct modbus_user_callbacks mbs_cbs_bulk = {
+	.coil_rd = coil_rd,
+	.coil_wr = coil_wr,
+	.discrete_input_rd = discrete_input_rd,
+	.input_reg_rd_fp = input_reg_rd_fp,
+	.holding_reg_rd_fp = holding_reg_rd_fp,
+	.holding_reg_wr_fp = holding_reg_wr_fp,
+	/* Register callbacks for ranges of registers */
+	.input_regs_rd = input_regs_rd,
+	.holding_regs_rd = holding_regs_rd,
+	.holding_regs_wr = holding_regs_wr,
+};
+
 static struct modbus_iface_param server_param = {
 	.mode = MODBUS_MODE_RTU,
 	.server = {
@@ -281,6 +327,50 @@ void test_server_setup_raw(void)
 	}
 }
 
+void test_server_setup_raw_bulk(void)
+{
+	char iface_name[] = "RAW_1";
+	int err;
+
+	server_iface = modbus_iface_get_by_name(iface_name);
+	server_param.mode = MODBUS_MODE_RAW;
+	server_param.rawcb.raw_tx_cb = server_raw_cb;
+	server_param.server.user_cb = &mbs_cbs_bulk;
+
+	if (IS_ENABLED(CONFIG_MODBUS_SERVER)) {
+		err = modbus_init_server(server_iface, server_param);
+		zassert_equal(err, 0, "Failed to configure RAW server");
+	} else {
+		ztest_test_skip();
+	}
+
+	server_param.server.user_cb = &mbs_cbs;
+}
+
+void test_server_setup_raw_map(void)
+{
+	char iface_name[] = "RAW_1";
+	int err;
+
+	server_iface = modbus_iface_get_by_name(iface_name);
+	server_param.mode = MODBUS_MODE_RAW;
+	server_param.rawcb.raw_tx_cb = server_raw_cb;
+	/* Served from memory, the callbacks serve the other registers */
+	server_param.server.holding_regs.regs = holding_reg;
+	server_param.server.holding_regs.num_regs = ARRAY_SIZE(holding_reg);
+	server_param.server.input_regs = server_param.server.holding_regs;
+
+	if (IS_ENABLED(CONFIG_MODBUS_SERVER)) {
+		err = modbus_init_server(server_iface, server_param);
+		zassert_equal(err, 0, "Failed to configure RAW server");
+	} else {
+		ztest_test_skip();
+	}
+
+	server_param.server.holding_regs.regs = NULL;
+	server_param.server.input_regs.regs = NULL;
+}
+
 void test_server_disable(void)
 {
 	int err;
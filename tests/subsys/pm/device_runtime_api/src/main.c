@@ -217,6 +217,109 @@ ZTEST(device_runtime_api, test_api)
 	zassert_equal(ret, 0);
 }
 
+static void get_async_done(const struct device *dev, int ret, void *user_data)
+{
+	struct k_sem *done = user_data;
+
+	zassert_equal(dev, test_dev);
+	zassert_equal(ret, 0);
+
+	k_sem_give(done);
+}
+
+/**
+ * @brief Test asynchronous get and delayed asynchronous put.
+ *
+ * Scenarios tested:
+ *
+ * - asynchronous get (resume needed)
+ * - asynchronous get (device already in use)
+ * - delayed asynchronous put + get (suspend cancelled)
+ * - delayed asynchronous put until suspended
+ */
+ZTEST(device_runtime_api, test_api_async_get_delayed_put)
+{
+	int ret;
+	enum pm_device_state state;
+	struct pm_device_runtime_req req;
+	struct pm_device_runtime_stats before, after;
+	struct k_sem done;
+
+	k_sem_init(&done, 0, 1);
+	pm_device_runtime_req_init(&req, get_async_done, &done);
+
+	ret = pm_device_runtime_stats_get(test_dev, &before);
+	zassert_equal(ret, 0);
+
+	/*** asynchronous get (resume needed) ***/
+
+	/* usage: 0, +1, resume: yes (queued) */
+	ret = pm_device_runtime_get_async(test_dev, &req);
+	zassert_equal(ret, 0);
+
+	ret = k_sem_take(&done, K_MSEC(100));
+	zassert_equal(ret, 0);
+
+	(void)pm_device_state_get(test_dev, &state);
+	zassert_equal(state, PM_DEVICE_STATE_ACTIVE);
+
+	/*** asynchronous get (device already in use) ***/
+
+	/* usage: 1, +1, resume: no, completed right away */
+	ret = pm_device_runtime_get_async(test_dev, &req);
+	zassert_equal(ret, 0);
+
+	ret = k_sem_take(&done, K_NO_WAIT);
+	zassert_equal(ret, 0);
+
+	/* usage: 2, -1, suspend: no */
+	ret = pm_device_runtime_put(test_dev);
+	zassert_equal(ret, 0);
+
+	/*** delayed asynchronous put + get (suspend cancelled) ***/
+
+	ret = pm_device_runtime_suspend_delay_set(test_dev, 50);
+	zassert_equal(ret, 0);
+
+	/* usage: 1, -1, suspend: yes (delayed) */
+	ret = pm_device_runtime_put_async(test_dev);
+	zassert_equal(ret, 0);
+
+	k_sleep(K_MSEC(10));
+
+	(void)pm_device_state_get(test_dev, &state);
+	zassert_equal(state, PM_DEVICE_STATE_SUSPENDING);
+
+	/* usage: 0, +1, resume: no (suspend cancelled) */
+	ret = pm_device_runtime_get(test_dev);
+	zassert_equal(ret, 0);
+
+	(void)pm_device_state_get(test_dev, &state);
+	zassert_equal(state, PM_DEVICE_STATE_ACTIVE);
+
+	/*** delayed asynchronous put until suspended ***/
+
+	/* usage: 1, -1, suspend: yes (delayed) */
+	ret = pm_device_runtime_put_async(test_dev);
+	zassert_equal(ret, 0);
+
+	k_sleep(K_MSEC(100));
+
+	(void)pm_device_state_get(test_dev, &state);
+	zassert_equal(state, PM_DEVICE_STATE_SUSPENDED);
+
+	ret = pm_device_runtime_suspend_delay_set(test_dev,
+						  CONFIG_PM_DEVICE_RUNTIME_SUSPEND_DELAY_MS);
+	zassert_equal(ret, 0);
+
+	/* one resume, one suspend, one cancelled suspend */
+	ret = pm_device_runtime_stats_get(test_dev, &after);
+	zassert_equal(ret, 0);
+	zassert_equal(after.resume_count - before.resume_count, 1);
+	zassert_equal(after.suspend_count - before.suspend_count, 1);
+	zassert_equal(after.cancel_count - before.cancel_count, 1);
+}
+
 DEVICE_DEFINE(pm_unsupported_device, "PM Unsupported", NULL, NULL, NULL, NULL,
 	      APPLICATION, 0, NULL);
 
@@ -9,6 +9,10 @@
 #include <zephyr/sys_clock.h>
 #include <zephyr/ztest.h>
 
+#ifdef CONFIG_PM_POLICY_ADAPTIVE
+#include <pm_policy_adaptive.h>
+#endif
+
 void pm_state_set(enum pm_state state, uint8_t substate_id)
 {
 	ARG_UNUSED(substate_id);
@@ -23,7 +27,7 @@ void pm_state_exit_post_ops(enum pm_state state, uint8_t substate_id)
 	irq_unlock(0);
 }
 
-#ifdef CONFIG_PM_POLICY_DEFAULT
+#if defined(CONFIG_PM_POLICY_DEFAULT) || defined(CONFIG_PM_POLICY_ADAPTIVE)
 /**
  * @brief Test the behavior of pm_policy_next_state() when
  * CONFIG_PM_POLICY_DEFAULT=y.
@@ -273,7 +277,55 @@ ZTEST(policy_api, test_pm_policy_next_state_default_latency)
 {
 	ztest_test_skip();
 }
-#endif /* CONFIG_PM_POLICY_DEFAULT */
+#endif /* CONFIG_PM_POLICY_DEFAULT || CONFIG_PM_POLICY_ADAPTIVE */
+
+#ifdef CONFIG_PM_POLICY_ADAPTIVE
+/**
+ * @brief Test that the idle history is taken into account when
+ * CONFIG_PM_POLICY_ADAPTIVE=y.
+ */
+ZTEST(policy_api, test_pm_policy_next_state_adaptive)
+{
+	const struct pm_state_info *next;
+
+	pm_policy_adaptive_reset();
+
+	/* cpu 0 keeps waking up after 200ms despite having no timeout */
+	for (uint8_t i = 0U; i < CONFIG_PM_POLICY_ADAPTIVE_HISTORY; i++) {
+		next = pm_policy_next_state(0U, K_TICKS_FOREVER);
+		zassert_equal(next->state, PM_STATE_SUSPEND_TO_RAM);
+		pm_policy_adaptive_update(0U, next, k_us_to_cyc_floor32(200000));
+	}
+
+	/* suspend to ram no longer pays off, runtime idle does */
+	next = pm_policy_next_state(0U, K_TICKS_FOREVER);
+	zassert_equal(next->state, PM_STATE_RUNTIME_IDLE);
+
+	/* an earlier timeout still wins */
+	next = pm_policy_next_state(0U, k_us_to_ticks_floor32(50000));
+	zassert_is_null(next);
+
+	/* history now too short for any state: fall back to the shallowest */
+	for (uint8_t i = 0U; i < CONFIG_PM_POLICY_ADAPTIVE_HISTORY; i++) {
+		next = pm_policy_next_state(0U, K_TICKS_FOREVER);
+		pm_policy_adaptive_update(0U, next, k_us_to_cyc_floor32(50000));
+	}
+
+	next = pm_policy_next_state(0U, K_TICKS_FOREVER);
+	zassert_equal(next->state, PM_STATE_RUNTIME_IDLE);
+
+	/* cpu 1 history is independent */
+	next = pm_policy_next_state(1U, K_TICKS_FOREVER);
+	zassert_equal(next->state, PM_STATE_SUSPEND_TO_RAM);
+
+	pm_policy_adaptive_reset();
+}
+#else
+ZTEST(policy_api, test_pm_policy_next_state_adaptive)
+{
+	ztest_test_skip();
+}
+#endif /* CONFIG_PM_POLICY_ADAPTIVE */
 
 #ifdef CONFIG_PM_POLICY_CUSTOM
 const struct pm_state_info *pm_policy_next_state(uint8_t cpu, int32_t ticks)
@@ -304,7 +356,7 @@ ZTEST(policy_api, test_pm_policy_next_state_custom)
 }
 #endif /* CONFIG_PM_POLICY_CUSTOM */
 
-#ifdef CONFIG_PM_POLICY_DEFAULT
+#if defined(CONFIG_PM_POLICY_DEFAULT) || defined(CONFIG_PM_POLICY_ADAPTIVE)
 /* note: we can't easily mock k_cycle_get_32(), so test is not ideal */
 ZTEST(policy_api, test_pm_policy_events)
 {
@@ -366,6 +418,6 @@ ZTEST(policy_api, test_pm_policy_events)
 {
 	ztest_test_skip();
 }
-#endif /* CONFIG_PM_POLICY_CUSTOM */
+#endif /* CONFIG_PM_POLICY_DEFAULT || CONFIG_PM_POLICY_ADAPTIVE */
 
 ZTEST_SUITE(policy_api, NULL, NULL, NULL, NULL, NULL);
@@ -274,6 +274,52 @@ ZTEST_USER(rtio_api, test_rtio_syscalls)
 	}
 }
 
+#ifdef CONFIG_RTIO_USER_RING
+RTIO_DEFINE_WITH_RING(r_ring, SQE_POOL_SIZE, CQE_POOL_SIZE);
+#endif
+
+/**
+ * @brief Test the rings shared with user mode
+ *
+ * Ensures that the submissions produced in place to the submission ring are
+ * all submitted by a single call, and that their completions are consumed in
+ * place from the completion ring.
+ */
+ZTEST_USER(rtio_api, test_rtio_ring)
+{
+#ifdef CONFIG_RTIO_USER_RING
+	struct rtio_sq_ring *sq = RTIO_RING_SQ(r_ring);
+	struct rtio_cq_ring *cq = RTIO_RING_CQ(r_ring);
+	struct rtio_sqe *sqe;
+	struct rtio_cqe *cqe;
+	int res;
+
+	for (int j = 0; j < TEST_REPEATS; j++) {
+		for (int i = 0; i < SQE_POOL_SIZE; i++) {
+			sqe = rtio_spsc_acquire(sq);
+			zassert_not_null(sqe, "Expected a valid sqe");
+			rtio_sqe_prep_nop(sqe, &iodev_test_syscall, &syscall_bufs[i]);
+		}
+		rtio_spsc_produce_all(sq);
+
+		res = rtio_submit(&r_ring, SQE_POOL_SIZE);
+		zassert_ok(res, "Should return ok from rtio_submit");
+
+		for (int i = 0; i < SQE_POOL_SIZE; i++) {
+			cqe = rtio_spsc_consume(cq);
+			zassert_not_null(cqe, "Expected a valid cqe");
+			zassert_ok(cqe->result, "Result should be ok");
+			zassert_equal_ptr(cqe->userdata, &syscall_bufs[i],
+					  "Expected in order completions");
+			rtio_spsc_release(cq);
+		}
+		zassert_is_null(rtio_spsc_consume(cq), "Expected no more cqes");
+	}
+#else
+	ztest_test_skip();
+#endif
+}
+
 RTIO_BMEM uint8_t mempool_data[MEM_BLK_SIZE];
 
 static void test_rtio_simple_mempool_(struct rtio *r, int run_count)
@@ -595,6 +641,154 @@ ZTEST(rtio_api, test_rtio_transaction)
 	}
 }
 
+/**
+ * @brief Test that submissions are handed to the iodev by priority
+ *
+ * Ensures that with CONFIG_RTIO_EXECUTOR_PRIO the submissions queued together
+ * complete by decreasing priority on an iodev working through them in order.
+ */
+ZTEST(rtio_api, test_rtio_prio)
+{
+#ifdef CONFIG_RTIO_EXECUTOR_PRIO
+	const uint8_t prios[3] = {RTIO_PRIO_LOW, RTIO_PRIO_HIGH, RTIO_PRIO_NORM};
+	const int expected[3] = {1, 2, 0};
+	uintptr_t userdata[3] = {0, 1, 2};
+	struct rtio_sqe *sqe;
+	struct rtio_cqe *cqe;
+	int res;
+
+	rtio_iodev_test_init(&iodev_test_simple);
+
+	for (int i = 0; i < ARRAY_SIZE(prios); i++) {
+		sqe = rtio_sqe_acquire(&r_simple);
+		zassert_not_null(sqe, "Expected a valid sqe");
+		rtio_sqe_prep_nop(sqe, (struct rtio_iodev *)&iodev_test_simple, &userdata[i]);
+		sqe->prio = prios[i];
+	}
+
+	res = rtio_submit(&r_simple, ARRAY_SIZE(prios));
+	zassert_ok(res, "Should return ok from rtio_execute");
+
+	for (int i = 0; i < ARRAY_SIZE(expected); i++) {
+		cqe = rtio_cqe_consume(&r_simple);
+		zassert_not_null(cqe, "Expected a valid cqe");
+		zassert_ok(cqe->result, "Result should be ok");
+		zassert_equal_ptr(cqe->userdata, &userdata[expected[i]],
+				  "Expected completions by decreasing priority");
+		rtio_cqe_release(&r_simple, cqe);
+	}
+#else
+	ztest_test_skip();
+#endif
+}
+
+#ifdef CONFIG_RTIO_DELAY
+RTIO_DEFINE(r_delay, SQE_POOL_SIZE, CQE_POOL_SIZE);
+
+static atomic_t delay_callbacks;
+
+static void rtio_delay_callback(struct rtio *r, const struct rtio_sqe *sqe, void *arg0)
+{
+	ARG_UNUSED(r);
+	ARG_UNUSED(sqe);
+	ARG_UNUSED(arg0);
+
+	atomic_inc(&delay_callbacks);
+}
+#endif /* CONFIG_RTIO_DELAY */
+
+/**
+ * @brief Test a delay chained to a callback
+ *
+ * Ensures that the callback runs once the delay elapsed and that both complete.
+ */
+ZTEST(rtio_api, test_rtio_delay)
+{
+#ifdef CONFIG_RTIO_DELAY
+	uintptr_t userdata[2] = {0, 1};
+	struct rtio_sqe *sqe;
+	struct rtio_cqe *cqe;
+	int64_t start;
+
+	atomic_set(&delay_callbacks, 0);
+
+	sqe = rtio_sqe_acquire(&r_delay);
+	zassert_not_null(sqe, "Expected a valid sqe");
+	rtio_sqe_prep_delay(sqe, K_MSEC(20), &userdata[0]);
+	sqe->flags |= RTIO_SQE_CHAINED;
+
+	sqe = rtio_sqe_acquire(&r_delay);
+	zassert_not_null(sqe, "Expected a valid sqe");
+	rtio_sqe_prep_callback(sqe, rtio_delay_callback, NULL, &userdata[1]);
+
+	start = k_uptime_get();
+	zassert_ok(rtio_submit(&r_delay, 2), "Should return ok from rtio_submit");
+	zassert_true(k_uptime_get() - start >= 20, "Completed before the delay");
+	zassert_equal(atomic_get(&delay_callbacks), 1, "Expected the callback to run once");
+
+	for (int i = 0; i < ARRAY_SIZE(userdata); i++) {
+		cqe = rtio_cqe_consume(&r_delay);
+		zassert_not_null(cqe, "Expected a valid cqe");
+		zassert_ok(cqe->result, "Result should be ok");
+		zassert_equal_ptr(cqe->userdata, &userdata[i], "Expected completions in order");
+		rtio_cqe_release(&r_delay, cqe);
+	}
+#else
+	ztest_test_skip();
+#endif
+}
+
+/**
+ * @brief Test a periodic delay chained to a callback
+ *
+ * Ensures that the callback runs each period until the delay is canceled, and
+ * that the submissions are released once canceled.
+ */
+ZTEST(rtio_api, test_rtio_delay_periodic)
+{
+#ifdef CONFIG_RTIO_DELAY
+	uintptr_t userdata[2] = {0, 1};
+	struct rtio_sqe sqe[SQE_POOL_SIZE];
+	struct rtio_sqe *handle;
+	struct rtio_cqe cqe;
+
+	atomic_set(&delay_callbacks, 0);
+
+	rtio_sqe_prep_delay(&sqe[0], K_MSEC(10), &userdata[0]);
+	sqe[0].flags |= RTIO_SQE_MULTISHOT | RTIO_SQE_CHAINED;
+	rtio_sqe_prep_callback(&sqe[1], rtio_delay_callback, NULL, &userdata[1]);
+	zassert_ok(rtio_sqe_copy_in_get_handles(&r_delay, sqe, &handle, 2));
+	rtio_submit(&r_delay, 0);
+
+	for (int i = 0; i < TEST_REPEATS; i++) {
+		for (int j = 0; j < ARRAY_SIZE(userdata); j++) {
+			zassert_equal(1, rtio_cqe_copy_out(&r_delay, &cqe, 1, K_MSEC(100)));
+			zassert_ok(cqe.result, "Result should be ok");
+			zassert_equal_ptr(cqe.userdata, &userdata[j], "Expected completions in order");
+		}
+	}
+	zassert_true(atomic_get(&delay_callbacks) >= TEST_REPEATS,
+		     "Expected the callback to run each period");
+
+	rtio_sqe_cancel(handle);
+	k_msleep(30);
+	while (rtio_cqe_copy_out(&r_delay, &cqe, 1, K_NO_WAIT)) {
+	}
+
+	/* Check that the SQE pool is empty by filling it all the way */
+	for (int i = 0; i < SQE_POOL_SIZE; ++i) {
+		rtio_sqe_prep_nop(&sqe[i], NULL, NULL);
+	}
+	zassert_ok(rtio_sqe_copy_in(&r_delay, sqe, SQE_POOL_SIZE));
+	rtio_submit(&r_delay, SQE_POOL_SIZE);
+	for (int i = 0; i < SQE_POOL_SIZE; ++i) {
+		zassert_equal(1, rtio_cqe_copy_out(&r_delay, &cqe, 1, K_FOREVER));
+	}
+#else
+	ztest_test_skip();
+#endif
+}
+
 #define THROUGHPUT_ITERS 100000
 RTIO_DEFINE(r_throughput, SQE_POOL_SIZE, CQE_POOL_SIZE);
 
@@ -664,6 +858,9 @@ static void rtio_api_before(void *a)
 	k_mem_domain_add_thread(&rtio_domain, k_current_get());
 	rtio_access_grant(&r_simple, k_current_get());
 	rtio_access_grant(&r_syscall, k_current_get());
+#ifdef CONFIG_RTIO_USER_RING
+	rtio_access_grant(&r_ring, k_current_get());
+#endif
 	k_object_access_grant(&iodev_test_simple, k_current_get());
 	k_object_access_grant(&iodev_test_syscall, k_current_get());
 #endif
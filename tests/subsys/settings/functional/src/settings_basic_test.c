@@ -228,14 +228,6 @@ static struct settings_handler val3_settings = {
 	.h_commit = val3_commit,
 };
 
-/* helper routine to remove a handler from settings */
-int settings_deregister(struct settings_handler *handler)
-{
-	extern sys_slist_t settings_handlers;
-
-	return sys_slist_find_and_remove(&settings_handlers, &handler->node);
-}
-
 ZTEST(settings_functional, test_register_and_loading)
 {
 	int rc, err;
@@ -474,6 +466,79 @@ ZTEST(settings_functional, test_direct_loading)
 	settings_deregister(&val123_settings);
 }
 
+#ifdef CONFIG_SETTINGS_TXN
+ZTEST(settings_functional, test_txn)
+{
+	int rc;
+	uint8_t val;
+
+	settings_subsys_init();
+	val = 11;
+	settings_save_one("val/1", &val, sizeof(uint8_t));
+	val = 23;
+	settings_save_one("val/2", &val, sizeof(uint8_t));
+	settings_delete("val/3");
+
+	rc = settings_register(&val123_settings);
+	zassert_true(rc == 0);
+
+	zassert_equal(-EINVAL, settings_txn_commit());
+	zassert_equal(-EINVAL, settings_txn_abort());
+
+	rc = settings_txn_begin();
+	zassert_true(rc == 0);
+	zassert_equal(-EALREADY, settings_txn_begin());
+
+	val = 12;
+	rc = settings_save_one("val/1", &val, sizeof(uint8_t));
+	zassert_true(rc == 0);
+	val = 35;
+	rc = settings_save_one("val/3", &val, sizeof(uint8_t));
+	zassert_true(rc == 0);
+	val = 13;
+	rc = settings_save_one("val/1", &val, sizeof(uint8_t));
+	zassert_true(rc == 0);
+	rc = settings_delete("val/2");
+	zassert_true(rc == 0);
+
+	/* Nothing is persisted before the commit */
+	memset(&data, 0, sizeof(data));
+	rc = settings_load_subtree("val");
+	zassert_true(rc == 0);
+	zassert_equal(11, data.val1);
+	zassert_equal(23, data.val2);
+	zassert_false(data.en3);
+
+	rc = settings_txn_commit();
+	zassert_true(rc == 0);
+
+	memset(&data, 0, sizeof(data));
+	rc = settings_load_subtree("val");
+	zassert_true(rc == 0);
+	zassert_equal(13, data.val1);
+	zassert_false(data.en2);
+	zassert_equal(35, data.val3);
+
+	/* Aborted values are dropped */
+	rc = settings_txn_begin();
+	zassert_true(rc == 0);
+	val = 14;
+	rc = settings_save_one("val/1", &val, sizeof(uint8_t));
+	zassert_true(rc == 0);
+	rc = settings_txn_abort();
+	zassert_true(rc == 0);
+
+	memset(&data, 0, sizeof(data));
+	rc = settings_load_subtree("val");
+	zassert_true(rc == 0);
+	zassert_equal(13, data.val1);
+
+	settings_delete("val/1");
+	settings_delete("val/3");
+	settings_deregister(&val123_settings);
+}
+#endif /* CONFIG_SETTINGS_TXN */
+
 struct test_loading_data {
 	const char *n;
 	const char *v;
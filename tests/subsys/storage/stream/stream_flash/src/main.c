@@ -643,6 +643,45 @@ ZTEST(lib_stream_flash, test_stream_flash_progress_clear)
 #endif
 }
 
+#ifdef CONFIG_STREAM_FLASH_ASYNC
+ZTEST(lib_stream_flash, test_stream_flash_async_write)
+{
+	int rc;
+	size_t len = (page_size * 2) + 100;
+
+	init_target();
+
+	/* Without callback the buffer is split in parts */
+	memset(&ctx, 0, sizeof(ctx));
+	rc = stream_flash_init(&ctx, fdev, generic_buf, BUF_LEN, FLASH_BASE, 0,
+			       NULL);
+	zassert_equal(rc, 0, "expected success");
+
+	rc = stream_flash_buffered_write(&ctx, write_buf, len, false);
+	zassert_equal(rc, 0, "expected success");
+
+	/* The last buffer is not counted before its write completes */
+	zassert_true(stream_flash_bytes_written(&ctx) <= len - 100,
+		     "too many bytes written");
+
+	rc = stream_flash_buffered_write(&ctx, NULL, 0, true);
+	zassert_equal(rc, 0, "expected success");
+	zassert_equal(stream_flash_bytes_written(&ctx), len,
+		      "expected all bytes written");
+
+	VERIFY_WRITTEN(0, len);
+	VERIFY_ERASED(len, page_size - 100);
+
+	/* A buffer whose parts are not a multiple of the write block size is
+	 * rejected.
+	 */
+	rc = stream_flash_init(&ctx, fdev, generic_buf,
+			       flash_get_write_block_size(fdev), FLASH_BASE, 0,
+			       NULL);
+	zassert_equal(rc, -EFAULT, "expected failure");
+}
+#endif /* CONFIG_STREAM_FLASH_ASYNC */
+
 void lib_stream_flash_before(void *data)
 {
 	zassume_true(device_is_ready(fdev), "Device is not ready");
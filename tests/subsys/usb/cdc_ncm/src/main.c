@@ -0,0 +1,556 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+
+#include <zephyr/ztest.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/ethernet.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/usb/usbd.h>
+#include <zephyr/usb/usbh.h>
+#include <zephyr/usb/class/usb_cdc.h>
+#include <zephyr/drivers/usb/uhc.h>
+
+#include "usbh_ch9.h"
+
+/* The NCM function is enumerated by a host on the virtual bus */
+USBH_CONTROLLER_DEFINE(uhs_ctx, DEVICE_DT_GET(DT_NODELABEL(zephyr_uhc0)));
+
+USBD_DEVICE_DEFINE(test_usbd, DEVICE_DT_GET(DT_NODELABEL(zephyr_udc0)),
+		   0x2fe3, 0xffff);
+USBD_DESC_LANG_DEFINE(test_lang);
+USBD_CONFIGURATION_DEFINE(test_config, 0, 200);
+
+#define TEST_ADDR		2
+#define TEST_XFER_TIMEOUT	1000
+#define TEST_NTB_SIZE		512
+
+#define REQTYPE_STD_DEV_IN	0x80
+#define REQTYPE_STD_DEV_OUT	0x00
+#define REQTYPE_STD_IF_OUT	0x01
+#define REQTYPE_CLASS_IF_IN	0xa1
+#define REQTYPE_CLASS_IF_OUT	0x21
+
+#define NTH16_SIGNATURE		0x484D434E
+#define NDP16_SIGNATURE_NCM0	0x304D434E
+#define NTH16_LEN		12
+#define NDP16_LEN		8
+
+/* ARP request or reply in an Ethernet frame */
+struct test_arp_frame {
+	struct net_eth_hdr eth;
+	uint16_t hwtype;
+	uint16_t protocol;
+	uint8_t hwlen;
+	uint8_t protolen;
+	uint16_t opcode;
+	struct net_eth_addr src_hwaddr;
+	uint8_t src_ipaddr[4];
+	struct net_eth_addr dst_hwaddr;
+	uint8_t dst_ipaddr[4];
+} __packed;
+
+static const struct net_eth_addr host_mac = {{ 0x00, 0x00, 0x5e, 0x00, 0x53, 0x01 }};
+static const struct net_eth_addr dev_mac = {{ 0x00, 0x00, 0x5e, 0x00, 0x53, 0x00 }};
+static const uint8_t host_ip[4] = { 192, 0, 2, 2 };
+static const struct in_addr dev_ip = {{{ 192, 0, 2, 1 }}};
+
+struct test_result {
+	struct uhc_transfer *xfer;
+	int err;
+};
+
+K_MSGQ_DEFINE(test_result_msgq, sizeof(struct test_result), 4, sizeof(void *));
+static K_SEM_DEFINE(test_connected, 0, 1);
+
+/* What the host learned while enumerating the device */
+static struct {
+	struct usb_device_descriptor dev_desc;
+	uint8_t ctrl_if;
+	uint8_t data_if;
+	uint8_t int_in;
+	uint8_t bulk_in;
+	uint8_t bulk_out;
+	uint16_t bulk_mps;
+	uint8_t net_caps;
+	bool ncm_func;
+} test_dev;
+
+static uint8_t test_buf[TEST_NTB_SIZE];
+static struct net_if *test_iface;
+
+static int test_host_request(struct usbh_contex *const ctx,
+			     struct uhc_transfer *const xfer, int err)
+{
+	struct test_result result = {
+		.xfer = xfer,
+		.err = err,
+	};
+
+	return k_msgq_put(&test_result_msgq, &result, K_NO_WAIT);
+}
+
+static int test_host_connected(struct usbh_contex *const ctx)
+{
+	k_sem_give(&test_connected);
+
+	return 0;
+}
+
+USBH_DEFINE_CLASS(test_host_class) = {
+	.request = test_host_request,
+	.connected = test_host_connected,
+};
+
+static struct uhc_transfer *test_wait_xfer(int *err)
+{
+	struct test_result result;
+
+	zassert_ok(k_msgq_get(&test_result_msgq, &result, K_SECONDS(5)),
+		   "transfer did not complete");
+	*err = result.err;
+
+	return result.xfer;
+}
+
+/* Returns the length of the data stage of an IN request, or an error */
+static int test_control(const uint8_t addr, const uint8_t bmRequestType,
+			const uint8_t bRequest, const uint16_t wValue,
+			const uint16_t wIndex, const uint16_t wLength,
+			void *const data)
+{
+	struct uhc_transfer *xfer;
+	struct net_buf *buf;
+	int ret;
+
+	zassert_ok(usbh_req_setup(uhs_ctx.dev, addr, bmRequestType, bRequest,
+				  wValue, wIndex, wLength, NULL));
+
+	xfer = test_wait_xfer(&ret);
+
+	/* The setup stage comes first, followed by the data stage */
+	buf = net_buf_get(&xfer->done, K_NO_WAIT);
+	if (buf != NULL) {
+		uhc_xfer_buf_free(uhs_ctx.dev, buf);
+	}
+
+	if (ret == 0 && wLength != 0 && data != NULL) {
+		buf = net_buf_get(&xfer->done, K_NO_WAIT);
+		zassert_not_null(buf, "no data stage");
+		ret = MIN(buf->len, wLength);
+		memcpy(data, buf->data, ret);
+		uhc_xfer_buf_free(uhs_ctx.dev, buf);
+	}
+
+	zassert_ok(uhc_xfer_free(uhs_ctx.dev, xfer));
+
+	return ret;
+}
+
+/* Returns the number of bytes received for an IN endpoint, or an error */
+static int test_bulk(const uint8_t ep, uint8_t *const data, const size_t len,
+		     const uint16_t timeout)
+{
+	struct uhc_transfer *xfer;
+	struct net_buf *buf;
+	int ret;
+
+	xfer = uhc_xfer_alloc(uhs_ctx.dev, TEST_ADDR, ep, 0,
+			      test_dev.bulk_mps, timeout, NULL);
+	zassert_not_null(xfer, "failed to allocate transfer");
+
+	buf = uhc_xfer_buf_alloc(uhs_ctx.dev, xfer, len);
+	zassert_not_null(buf, "failed to allocate transfer buffer");
+
+	if (USB_EP_DIR_IS_OUT(ep)) {
+		net_buf_add_mem(buf, data, len);
+	}
+
+	zassert_ok(uhc_ep_enqueue(uhs_ctx.dev, xfer));
+	xfer = test_wait_xfer(&ret);
+
+	if (ret == 0 && USB_EP_DIR_IS_IN(ep)) {
+		buf = net_buf_get(&xfer->done, K_NO_WAIT);
+		zassert_not_null(buf, "no data received");
+		ret = buf->len;
+		memcpy(data, buf->data, ret);
+		uhc_xfer_buf_free(uhs_ctx.dev, buf);
+	}
+
+	zassert_ok(uhc_xfer_free(uhs_ctx.dev, xfer));
+
+	return ret;
+}
+
+static void test_parse_config(const uint8_t *desc, const size_t len)
+{
+	const struct usb_if_descriptor *if_desc = NULL;
+	const struct usb_ep_descriptor *ep_desc;
+	const struct cdc_ncm_descriptor *ncm_desc;
+	size_t i;
+
+	for (i = 0; i + 2 <= len && desc[i] != 0; i += desc[i]) {
+		switch (desc[i + 1]) {
+		case USB_DESC_INTERFACE:
+			if_desc = (const void *)&desc[i];
+			if (if_desc->bInterfaceClass == USB_BCC_CDC_CONTROL &&
+			    if_desc->bInterfaceSubClass == NCM_SUBCLASS) {
+				test_dev.ctrl_if = if_desc->bInterfaceNumber;
+			}
+
+			if (if_desc->bInterfaceClass == USB_BCC_CDC_DATA &&
+			    if_desc->bAlternateSetting == 1) {
+				test_dev.data_if = if_desc->bInterfaceNumber;
+			}
+
+			break;
+		case USB_DESC_CS_INTERFACE:
+			ncm_desc = (const void *)&desc[i];
+			if (ncm_desc->bDescriptorSubtype == NCM_FUNC_DESC) {
+				test_dev.ncm_func = true;
+				test_dev.net_caps = ncm_desc->bmNetworkCapabilities;
+			}
+
+			break;
+		case USB_DESC_ENDPOINT:
+			ep_desc = (const void *)&desc[i];
+			zassert_not_null(if_desc, "endpoint outside an interface");
+
+			if (if_desc->bInterfaceClass == USB_BCC_CDC_CONTROL) {
+				test_dev.int_in = ep_desc->bEndpointAddress;
+			} else if (USB_EP_DIR_IS_IN(ep_desc->bEndpointAddress)) {
+				test_dev.bulk_in = ep_desc->bEndpointAddress;
+				test_dev.bulk_mps = sys_le16_to_cpu(ep_desc->wMaxPacketSize);
+			} else {
+				test_dev.bulk_out = ep_desc->bEndpointAddress;
+			}
+
+			break;
+		default:
+			break;
+		}
+	}
+}
+
+static void *cdc_ncm_setup(void)
+{
+	struct usb_cfg_descriptor cfg_desc;
+	static uint8_t cfg[256];
+	int ret;
+
+	test_iface = net_if_lookup_by_dev(DEVICE_DT_GET(DT_NODELABEL(cdc_ncm_eth0)));
+	zassert_not_null(test_iface, "no NCM interface");
+	zassert_not_null(net_if_ipv4_addr_add(test_iface, (struct in_addr *)&dev_ip,
+					      NET_ADDR_MANUAL, 0));
+
+	zassert_ok(usbd_add_descriptor(&test_usbd, &test_lang));
+	zassert_ok(usbd_add_configuration(&test_usbd, &test_config));
+	zassert_ok(usbd_register_class(&test_usbd, "cdc_ncm_0", 1));
+
+	zassert_ok(usbh_init(&uhs_ctx));
+	zassert_ok(usbh_enable(&uhs_ctx));
+	zassert_ok(usbd_init(&test_usbd));
+	zassert_ok(usbd_enable(&test_usbd));
+
+	zassert_ok(k_sem_take(&test_connected, K_SECONDS(1)), "device not connected");
+
+	/* Reset the bus, the frame timer runs once it is resumed */
+	zassert_ok(uhc_bus_reset(uhs_ctx.dev));
+	k_msleep(10);
+	zassert_ok(uhc_bus_resume(uhs_ctx.dev));
+	k_msleep(10);
+
+	ret = test_control(0, REQTYPE_STD_DEV_IN, USB_SREQ_GET_DESCRIPTOR,
+			   USB_DESC_DEVICE << 8, 0, sizeof(test_dev.dev_desc),
+			   &test_dev.dev_desc);
+	zassert_equal(ret, sizeof(test_dev.dev_desc), "GetDescriptor(Device) failed (%d)", ret);
+
+	ret = test_control(0, REQTYPE_STD_DEV_OUT, USB_SREQ_SET_ADDRESS,
+			   TEST_ADDR, 0, 0, NULL);
+	zassert_ok(ret, "SetAddress failed (%d)", ret);
+	k_msleep(10);
+
+	ret = test_control(TEST_ADDR, REQTYPE_STD_DEV_IN, USB_SREQ_GET_DESCRIPTOR,
+			   USB_DESC_CONFIGURATION << 8, 0, sizeof(cfg_desc), &cfg_desc);
+	zassert_equal(ret, sizeof(cfg_desc), "GetDescriptor(Configuration) failed (%d)", ret);
+	zassert_true(sys_le16_to_cpu(cfg_desc.wTotalLength) <= sizeof(cfg));
+
+	ret = test_control(TEST_ADDR, REQTYPE_STD_DEV_IN, USB_SREQ_GET_DESCRIPTOR,
+			   USB_DESC_CONFIGURATION << 8, 0,
+			   sys_le16_to_cpu(cfg_desc.wTotalLength), cfg);
+	zassert_equal(ret, sys_le16_to_cpu(cfg_desc.wTotalLength));
+	test_parse_config(cfg, ret);
+
+	ret = test_control(TEST_ADDR, REQTYPE_STD_DEV_OUT, USB_SREQ_SET_CONFIGURATION,
+			   cfg_desc.bConfigurationValue, 0, 0, NULL);
+	zassert_ok(ret, "SetConfiguration failed (%d)", ret);
+
+	return NULL;
+}
+
+static void cdc_ncm_before(void *fixture)
+{
+	int ret;
+
+	ARG_UNUSED(fixture);
+
+	/* The data interface carries the frames in alternate setting 1 */
+	ret = test_control(TEST_ADDR, REQTYPE_STD_IF_OUT, USB_SREQ_SET_INTERFACE,
+			   1, test_dev.data_if, 0, NULL);
+	zassert_ok(ret, "SetInterface failed (%d)", ret);
+
+	/* Let the OUT transfers be queued */
+	k_msleep(50);
+}
+
+static void cdc_ncm_after(void *fixture)
+{
+	int ret;
+
+	ARG_UNUSED(fixture);
+
+	ret = test_control(TEST_ADDR, REQTYPE_CLASS_IF_OUT, SET_ETHERNET_PACKET_FILTER,
+			   PACKET_TYPE_DIRECTED | PACKET_TYPE_BROADCAST |
+			   PACKET_TYPE_ALL_MULTICAST, test_dev.ctrl_if, 0, NULL);
+	zassert_ok(ret, "SetEthernetPacketFilter failed (%d)", ret);
+
+	ret = test_control(TEST_ADDR, REQTYPE_STD_IF_OUT, USB_SREQ_SET_INTERFACE,
+			   0, test_dev.data_if, 0, NULL);
+	zassert_ok(ret, "SetInterface failed (%d)", ret);
+}
+
+/* Send an ARP request for the device address in an NTB of its own */
+static void test_send_arp_request(void)
+{
+	struct test_arp_frame frame = {
+		.eth.type = htons(NET_ETH_PTYPE_ARP),
+		.hwtype = htons(1),
+		.protocol = htons(NET_ETH_PTYPE_IP),
+		.hwlen = sizeof(struct net_eth_addr),
+		.protolen = sizeof(host_ip),
+		.opcode = htons(1),
+	};
+	const size_t dgram_idx = NTH16_LEN;
+	const size_t ndp_idx = ROUND_UP(dgram_idx + sizeof(frame), 4);
+	const size_t len = ndp_idx + NDP16_LEN + 2 * 4;
+	int ret;
+
+	memset(&frame.eth.dst, 0xff, sizeof(frame.eth.dst));
+	frame.eth.src = host_mac;
+	frame.src_hwaddr = host_mac;
+	memcpy(frame.src_ipaddr, host_ip, sizeof(host_ip));
+	memcpy(frame.dst_ipaddr, &dev_ip, sizeof(dev_ip));
+
+	memset(test_buf, 0, len);
+	sys_put_le32(NTH16_SIGNATURE, &test_buf[0]);
+	sys_put_le16(NTH16_LEN, &test_buf[4]);
+	sys_put_le16(len, &test_buf[8]);
+	sys_put_le16(ndp_idx, &test_buf[10]);
+	memcpy(&test_buf[dgram_idx], &frame, sizeof(frame));
+
+	/* A single datagram followed by the terminating entry */
+	sys_put_le32(NDP16_SIGNATURE_NCM0, &test_buf[ndp_idx]);
+	sys_put_le16(NDP16_LEN + 2 * 4, &test_buf[ndp_idx + 4]);
+	sys_put_le16(dgram_idx, &test_buf[ndp_idx + NDP16_LEN]);
+	sys_put_le16(sizeof(frame), &test_buf[ndp_idx + NDP16_LEN + 2]);
+
+	ret = test_bulk(test_dev.bulk_out, test_buf, len, TEST_XFER_TIMEOUT);
+	zassert_ok(ret, "NTB OUT transfer failed (%d)", ret);
+}
+
+/* Look for the ARP reply of the device in the NTB received */
+static bool test_ntb_has_arp_reply(const size_t len)
+{
+	const struct test_arp_frame *frame;
+	uint16_t ndp_idx;
+	uint16_t ndp_len;
+	uint16_t dgram_idx;
+	uint16_t dgram_len;
+
+	zassert_true(len >= NTH16_LEN);
+	zassert_equal(sys_get_le32(&test_buf[0]), NTH16_SIGNATURE, "invalid NTH16");
+	zassert_equal(sys_get_le16(&test_buf[8]), len, "invalid NTB length");
+
+	ndp_idx = sys_get_le16(&test_buf[10]);
+	zassert_true(ndp_idx % 4 == 0 && ndp_idx + NDP16_LEN <= len, "invalid NDP16 index");
+	zassert_equal(sys_get_le32(&test_buf[ndp_idx]), NDP16_SIGNATURE_NCM0, "invalid NDP16");
+	ndp_len = sys_get_le16(&test_buf[ndp_idx + 4]);
+	zassert_true(ndp_idx + ndp_len <= len, "invalid NDP16 length");
+
+	for (size_t i = NDP16_LEN; i + 4 <= ndp_len; i += 4) {
+		dgram_idx = sys_get_le16(&test_buf[ndp_idx + i]);
+		dgram_len = sys_get_le16(&test_buf[ndp_idx + i + 2]);
+		if (dgram_idx == 0 || dgram_len == 0) {
+			break;
+		}
+
+		zassert_true(dgram_idx + dgram_len <= len, "invalid datagram");
+		if (dgram_len < sizeof(*frame)) {
+			continue;
+		}
+
+		frame = (const void *)&test_buf[dgram_idx];
+		if (frame->eth.type != htons(NET_ETH_PTYPE_ARP) ||
+		    frame->opcode != htons(2)) {
+			continue;
+		}
+
+		zassert_mem_equal(&frame->eth.dst, &host_mac, sizeof(host_mac));
+		zassert_mem_equal(&frame->eth.src, &dev_mac, sizeof(dev_mac));
+		zassert_mem_equal(&frame->src_hwaddr, &dev_mac, sizeof(dev_mac));
+		zassert_mem_equal(frame->src_ipaddr, &dev_ip, sizeof(dev_ip));
+		zassert_mem_equal(&frame->dst_hwaddr, &host_mac, sizeof(host_mac));
+		zassert_mem_equal(frame->dst_ipaddr, host_ip, sizeof(host_ip));
+
+		return true;
+	}
+
+	return false;
+}
+
+/* Read the NTBs sent by the device until the ARP reply is found */
+static bool test_recv_arp_reply(const uint16_t timeout)
+{
+	int ret;
+
+	/* Let the stack answer, the host polls an idle endpoint in a loop */
+	k_msleep(50);
+
+	for (int i = 0; i < 4; i++) {
+		ret = test_bulk(test_dev.bulk_in, test_buf, sizeof(test_buf), timeout);
+		if (ret == -ETIMEDOUT) {
+			return false;
+		}
+
+		zassert_true(ret > 0, "NTB IN transfer failed (%d)", ret);
+		if (test_ntb_has_arp_reply(ret)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+ZTEST(cdc_ncm, test_enumeration)
+{
+	struct {
+		uint16_t wLength;
+		uint16_t bmNtbFormatsSupported;
+		uint32_t dwNtbInMaxSize;
+		uint16_t wNdpInDivisor;
+		uint16_t wNdpInPayloadRemainder;
+		uint16_t wNdpInAlignment;
+		uint16_t wReserved;
+		uint32_t dwNtbOutMaxSize;
+		uint16_t wNdpOutDivisor;
+		uint16_t wNdpOutPayloadRemainder;
+		uint16_t wNdpOutAlignment;
+		uint16_t wNtbOutMaxDatagrams;
+	} __packed params;
+	int ret;
+
+	zassert_equal(test_dev.dev_desc.bDescriptorType, USB_DESC_DEVICE);
+	zassert_equal(sys_le16_to_cpu(test_dev.dev_desc.idVendor), 0x2fe3);
+	zassert_equal(sys_le16_to_cpu(test_dev.dev_desc.idProduct), 0xffff);
+
+	zassert_true(test_dev.ncm_func, "no NCM functional descriptor");
+	zassert_equal(test_dev.net_caps & BIT(0), BIT(0),
+		      "SetEthernetPacketFilter not advertised");
+	zassert_true(USB_EP_DIR_IS_IN(test_dev.int_in), "no notification endpoint");
+	zassert_true(USB_EP_DIR_IS_IN(test_dev.bulk_in), "no bulk IN endpoint");
+	zassert_true(USB_EP_DIR_IS_OUT(test_dev.bulk_out) && test_dev.bulk_out != 0,
+		     "no bulk OUT endpoint");
+	zassert_not_equal(test_dev.bulk_mps, 0);
+	zassert_equal(test_dev.data_if, test_dev.ctrl_if + 1);
+
+	ret = test_control(TEST_ADDR, REQTYPE_CLASS_IF_IN, GET_NTB_PARAMETERS,
+			   0, test_dev.ctrl_if, sizeof(params), &params);
+	zassert_equal(ret, sizeof(params), "GetNtbParameters failed (%d)", ret);
+	zassert_equal(sys_le16_to_cpu(params.wLength), sizeof(params));
+	zassert_equal(sys_le16_to_cpu(params.bmNtbFormatsSupported) & BIT(0), BIT(0),
+		      "NTB16 not supported");
+	zassert_equal(sys_le32_to_cpu(params.dwNtbInMaxSize), CONFIG_USBD_CDC_NCM_NTB_IN_SIZE);
+	zassert_equal(sys_le32_to_cpu(params.dwNtbOutMaxSize), CONFIG_USBD_CDC_NCM_NTB_OUT_SIZE);
+}
+
+ZTEST(cdc_ncm, test_ntb_round_trip)
+{
+	test_send_arp_request();
+	zassert_true(test_recv_arp_reply(TEST_XFER_TIMEOUT), "no ARP reply received");
+}
+
+ZTEST(cdc_ncm, test_packet_filter)
+{
+	int ret;
+
+	/* Directed frames are no longer passed to the host */
+	ret = test_control(TEST_ADDR, REQTYPE_CLASS_IF_OUT, SET_ETHERNET_PACKET_FILTER,
+			   PACKET_TYPE_BROADCAST, test_dev.ctrl_if, 0, NULL);
+	zassert_ok(ret, "SetEthernetPacketFilter failed (%d)", ret);
+
+	test_send_arp_request();
+	zassert_false(test_recv_arp_reply(100), "ARP reply not filtered");
+
+	ret = test_control(TEST_ADDR, REQTYPE_CLASS_IF_OUT, SET_ETHERNET_PACKET_FILTER,
+			   PACKET_TYPE_DIRECTED, test_dev.ctrl_if, 0, NULL);
+	zassert_ok(ret, "SetEthernetPacketFilter failed (%d)", ret);
+
+	test_send_arp_request();
+	zassert_true(test_recv_arp_reply(TEST_XFER_TIMEOUT), "no ARP reply received");
+}
+
+/* Read the NetworkConnection notification of the device */
+static void test_recv_notification(const bool connected)
+{
+	struct uhc_transfer *xfer;
+	struct net_buf *buf;
+	int ret;
+
+	xfer = uhc_xfer_alloc(uhs_ctx.dev, TEST_ADDR, test_dev.int_in, 0,
+			      16, TEST_XFER_TIMEOUT, NULL);
+	zassert_not_null(xfer, "failed to allocate transfer");
+	zassert_not_null(uhc_xfer_buf_alloc(uhs_ctx.dev, xfer, 16));
+	zassert_ok(uhc_ep_enqueue(uhs_ctx.dev, xfer));
+
+	xfer = test_wait_xfer(&ret);
+	zassert_ok(ret, "notification not received (%d)", ret);
+
+	buf = net_buf_get(&xfer->done, K_NO_WAIT);
+	zassert_not_null(buf);
+	zassert_equal(buf->len, 8);
+	zassert_equal(buf->data[0], REQTYPE_CLASS_IF_IN);
+	zassert_equal(buf->data[1], USB_CDC_NETWORK_CONNECTION);
+	zassert_equal(sys_get_le16(&buf->data[2]), connected);
+	zassert_equal(sys_get_le16(&buf->data[4]), test_dev.ctrl_if);
+	uhc_xfer_buf_free(uhs_ctx.dev, buf);
+
+	zassert_ok(uhc_xfer_free(uhs_ctx.dev, xfer));
+}
+
+ZTEST(cdc_ncm, test_suspend_notification)
+{
+	/* The state changes while suspended are notified on resume */
+	zassert_ok(uhc_bus_suspend(uhs_ctx.dev));
+	k_msleep(10);
+	zassert_ok(net_if_down(test_iface));
+	zassert_ok(uhc_bus_resume(uhs_ctx.dev));
+	k_msleep(10);
+	test_recv_notification(false);
+
+	zassert_ok(uhc_bus_suspend(uhs_ctx.dev));
+	k_msleep(10);
+	zassert_ok(net_if_up(test_iface));
+	zassert_ok(uhc_bus_resume(uhs_ctx.dev));
+	k_msleep(10);
+	test_recv_notification(true);
+
+	/* The frames flow again once the interface is up */
+	test_send_arp_request();
+	zassert_true(test_recv_arp_reply(TEST_XFER_TIMEOUT), "no ARP reply received");
+}
+
+ZTEST_SUITE(cdc_ncm, NULL, cdc_ncm_setup, cdc_ncm_before, cdc_ncm_after, NULL);
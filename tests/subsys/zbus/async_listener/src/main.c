@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/zbus/zbus.h>
+#include <zephyr/ztest.h>
+LOG_MODULE_DECLARE(zbus, CONFIG_ZBUS_LOG_LEVEL);
+
+#define LISTENER_BUSY_US 100
+
+struct sensor_msg {
+	int temp;
+	int press;
+};
+
+ZBUS_CHAN_DEFINE(sensor_chan,	    /* Name */
+		 struct sensor_msg, /* Message type */
+
+		 NULL,				/* Validator */
+		 NULL,				/* User data */
+		 ZBUS_OBSERVERS(async_lis, lis), /* observers */
+		 ZBUS_MSG_INIT(0)		/* Initial value */
+);
+
+static atomic_t async_count;
+static atomic_t sync_count;
+static const struct zbus_channel *async_chan;
+static struct sensor_msg async_msg;
+static int async_err;
+
+static void async_callback(const struct zbus_channel *chan)
+{
+	/* The channel is not locked, the message is read as a subscriber does */
+	async_err = zbus_chan_read(chan, &async_msg, K_MSEC(100));
+	async_chan = chan;
+	atomic_inc(&async_count);
+}
+
+ZBUS_ASYNC_LISTENER_DEFINE(async_lis, async_callback, 4);
+
+static void callback(const struct zbus_channel *chan)
+{
+	k_busy_wait(LISTENER_BUSY_US);
+	atomic_inc(&sync_count);
+}
+
+ZBUS_LISTENER_DEFINE(lis, callback);
+
+static void before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	/* Let the previous notifications run */
+	k_msleep(50);
+
+	atomic_clear(&async_count);
+	atomic_clear(&sync_count);
+	async_chan = NULL;
+	zassert_equal(0, zbus_chan_stats_reset(&sensor_chan, K_NO_WAIT), NULL);
+}
+
+ZTEST(async_listener, test_async_callback)
+{
+	struct sensor_msg msg = {.temp = 20, .press = 1000};
+
+	zassert_equal(0, zbus_chan_pub(&sensor_chan, &msg, K_MSEC(100)), NULL);
+
+	/* The synchronous listener ran in the publisher's context, not the asynchronous one */
+	zassert_equal(1, atomic_get(&sync_count), NULL);
+	zassert_equal(0, atomic_get(&async_count), NULL);
+
+	k_msleep(50);
+
+	zassert_equal(1, atomic_get(&async_count), NULL);
+	zassert_equal(0, async_err, NULL);
+	zassert_equal_ptr(&sensor_chan, async_chan, NULL);
+	zassert_equal(20, async_msg.temp, NULL);
+	zassert_equal(1000, async_msg.press, NULL);
+}
+
+ZTEST(async_listener, test_async_queue)
+{
+	struct sensor_msg msg;
+
+	for (int i = 1; i <= 4; i++) {
+		msg = (struct sensor_msg){.temp = i, .press = 10 * i};
+		zassert_equal(0, zbus_chan_pub(&sensor_chan, &msg, K_MSEC(100)), NULL);
+	}
+
+	/* The queue is full until the work queue runs */
+	msg.temp = 5;
+	zassert_equal(-ENOMSG, zbus_chan_pub(&sensor_chan, &msg, K_NO_WAIT), NULL);
+
+	k_msleep(50);
+
+	/* The callback ran once per queued notification */
+	zassert_equal(4, atomic_get(&async_count), NULL);
+	zassert_equal(5, async_msg.temp, NULL);
+}
+
+ZTEST(async_listener, test_channel_stats)
+{
+	struct sensor_msg msg = {.temp = 20, .press = 1000};
+	struct zbus_channel_stats stats;
+
+	for (int i = 0; i < 3; i++) {
+		zassert_equal(0, zbus_chan_pub(&sensor_chan, &msg, K_MSEC(100)), NULL);
+	}
+	zassert_equal(0, zbus_chan_notify(&sensor_chan, K_MSEC(100)), NULL);
+
+	zassert_equal(0, zbus_chan_stats_get(&sensor_chan, &stats, K_NO_WAIT), NULL);
+	zassert_equal(4, stats.notify_count, NULL);
+
+	/* Only the synchronous listener is accounted */
+	zassert_equal(4, stats.listener_count, NULL);
+	zassert_true(stats.listener_cycles_max >= k_us_to_cyc_floor32(LISTENER_BUSY_US), NULL);
+	zassert_true(stats.listener_cycles_total >= stats.listener_cycles_max, NULL);
+	zassert_true(stats.notify_cycles_max >= stats.listener_cycles_max, NULL);
+	zassert_true(stats.notify_cycles_total >= stats.listener_cycles_total, NULL);
+
+	zassert_equal(0, zbus_chan_stats_reset(&sensor_chan, K_NO_WAIT), NULL);
+	zassert_equal(0, zbus_chan_stats_get(&sensor_chan, &stats, K_NO_WAIT), NULL);
+	zassert_equal(0, stats.notify_count, NULL);
+	zassert_equal(0, stats.listener_cycles_total, NULL);
+}
+
+ZTEST_SUITE(async_listener, NULL, NULL, before, NULL, NULL);
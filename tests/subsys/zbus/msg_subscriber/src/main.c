@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2023 Zephyr Project
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/zbus/zbus.h>
+#include <zephyr/ztest.h>
+LOG_MODULE_DECLARE(zbus, CONFIG_ZBUS_LOG_LEVEL);
+
+struct sensor_msg {
+	int temp;
+	int press;
+};
+
+ZBUS_MSG_SUBSCRIBER_DEFINE(msg_sub1);
+ZBUS_MSG_SUBSCRIBER_DEFINE(msg_sub2);
+ZBUS_MSG_SUBSCRIBER_DEFINE(rt_msg_sub);
+ZBUS_SUBSCRIBER_DEFINE(sub, 4);
+
+ZBUS_CHAN_DEFINE(sensor_chan,	    /* Name */
+		 struct sensor_msg, /* Message type */
+
+		 NULL,						  /* Validator */
+		 NULL,						  /* User data */
+		 ZBUS_OBSERVERS(msg_sub1, msg_sub2, sub),	  /* observers */
+		 ZBUS_MSG_INIT(0)				  /* Initial value */
+);
+
+static void before(void *fixture)
+{
+	struct net_buf *buf;
+	const struct zbus_channel *chan;
+
+	ARG_UNUSED(fixture);
+
+	while (zbus_sub_wait_msg_buf(&msg_sub1, &chan, &buf, K_NO_WAIT) == 0) {
+		net_buf_unref(buf);
+	}
+
+	while (zbus_sub_wait_msg_buf(&msg_sub2, &chan, &buf, K_NO_WAIT) == 0) {
+		net_buf_unref(buf);
+	}
+
+	k_msgq_purge(sub.queue);
+}
+
+ZTEST(msg_subscriber, test_no_message_lost)
+{
+	const struct zbus_channel *chan;
+	struct sensor_msg msg;
+
+	for (int i = 1; i <= 3; i++) {
+		msg = (struct sensor_msg){.temp = i, .press = 10 * i};
+		zassert_equal(0, zbus_chan_pub(&sensor_chan, &msg, K_NO_WAIT), NULL);
+	}
+
+	/* Every message subscriber receives every published message, in order */
+	for (int i = 1; i <= 3; i++) {
+		zassert_equal(0, zbus_sub_wait_msg(&msg_sub1, &chan, &msg, K_NO_WAIT), NULL);
+		zassert_equal_ptr(&sensor_chan, chan, NULL);
+		zassert_equal(i, msg.temp, NULL);
+		zassert_equal(10 * i, msg.press, NULL);
+
+		zassert_equal(0, zbus_sub_wait_msg(&msg_sub2, &chan, &msg, K_NO_WAIT), NULL);
+		zassert_equal(i, msg.temp, NULL);
+	}
+
+	zassert_equal(-ENOMSG, zbus_sub_wait_msg(&msg_sub1, &chan, &msg, K_NO_WAIT), NULL);
+	zassert_equal(-EAGAIN, zbus_sub_wait_msg(&msg_sub1, &chan, &msg, K_MSEC(10)), NULL);
+
+	/* The other subscribers only read the current message */
+	zassert_equal(0, zbus_sub_wait(&sub, &chan, K_NO_WAIT), NULL);
+	zassert_equal(0, zbus_chan_read(chan, &msg, K_NO_WAIT), NULL);
+	zassert_equal(3, msg.temp, NULL);
+}
+
+ZTEST(msg_subscriber, test_shared_snapshot)
+{
+	struct sensor_msg msg = {.temp = 5, .press = 6};
+	const struct zbus_channel *chan;
+	struct net_buf *buf1;
+	struct net_buf *buf2;
+
+	zassert_equal(0, zbus_chan_pub(&sensor_chan, &msg, K_NO_WAIT), NULL);
+
+	zassert_equal(0, zbus_sub_wait_msg_buf(&msg_sub1, &chan, &buf1, K_NO_WAIT), NULL);
+	zassert_equal(0, zbus_sub_wait_msg_buf(&msg_sub2, &chan, &buf2, K_NO_WAIT), NULL);
+
+	/* The message is copied once for all the message subscribers */
+	zassert_equal_ptr(buf1->data, buf2->data, "Snapshot must be shared");
+	zassert_equal(sizeof(msg), buf1->len, NULL);
+	zassert_mem_equal(&msg, buf1->data, sizeof(msg), NULL);
+
+	/* The snapshot is not changed by a new publication */
+	msg.temp = 7;
+	zassert_equal(0, zbus_chan_pub(&sensor_chan, &msg, K_NO_WAIT), NULL);
+	zassert_equal(5, ((struct sensor_msg *)buf1->data)->temp, NULL);
+
+	net_buf_unref(buf1);
+	net_buf_unref(buf2);
+}
+
+ZTEST(msg_subscriber, test_runtime_msg_subscriber)
+{
+	struct sensor_msg msg = {.temp = 8, .press = 9};
+	const struct zbus_channel *chan;
+
+	zassert_equal(0, zbus_chan_add_obs(&sensor_chan, &rt_msg_sub, K_NO_WAIT), NULL);
+	zassert_equal(0, zbus_chan_pub(&sensor_chan, &msg, K_NO_WAIT), NULL);
+	zassert_equal(0, zbus_chan_rm_obs(&sensor_chan, &rt_msg_sub, K_NO_WAIT), NULL);
+
+	memset(&msg, 0, sizeof(msg));
+	zassert_equal(0, zbus_sub_wait_msg(&rt_msg_sub, &chan, &msg, K_NO_WAIT), NULL);
+	zassert_equal(8, msg.temp, NULL);
+	zassert_equal(-EINVAL, zbus_sub_wait_msg(&sub, &chan, &msg, K_NO_WAIT), NULL);
+}
+
+ZTEST_SUITE(msg_subscriber, NULL, NULL, before, NULL, NULL);
@@ -170,4 +170,40 @@ ZTEST(basic, test_specification_based__zbus_obs_add_rm_obs_busy)
 	zassert_equal(0, zbus_chan_finish(&chan2), NULL);
 }
 
+static int prio_order[2];
+static int prio_count;
+
+static void prio_callback1(const struct zbus_channel *chan)
+{
+	prio_order[prio_count++] = 1;
+}
+
+static void prio_callback2(const struct zbus_channel *chan)
+{
+	prio_order[prio_count++] = 2;
+}
+
+ZBUS_LISTENER_DEFINE(lis_prio1, prio_callback1);
+ZBUS_LISTENER_DEFINE(lis_prio2, prio_callback2);
+
+ZTEST(basic, test_zbus_obs_add_with_prio)
+{
+	struct sensor_data_msg sd = {.a = 10, .b = 100};
+
+	prio_count = 0;
+
+	zassert_equal(0, zbus_chan_add_obs(&chan3, &lis_prio1, K_MSEC(200)), NULL);
+	zassert_equal(0, zbus_chan_add_obs_with_prio(&chan3, &lis_prio2, 5, K_MSEC(200)), NULL);
+	zassert_equal(-EALREADY, zbus_chan_add_obs_with_prio(&chan3, &lis_prio1, 5, K_MSEC(200)),
+		      "It cannot be added twice");
+
+	zassert_equal(0, zbus_chan_pub(&chan3, &sd, K_MSEC(500)), NULL);
+	zassert_equal(2, prio_count, NULL);
+	zassert_equal(2, prio_order[0], "The higher priority observer must be notified first");
+	zassert_equal(1, prio_order[1], NULL);
+
+	zassert_equal(0, zbus_chan_rm_obs(&chan3, &lis_prio2, K_MSEC(200)), NULL);
+	zassert_equal(0, zbus_chan_rm_obs(&chan3, &lis_prio1, K_MSEC(200)), NULL);
+}
+
 ZTEST_SUITE(basic, NULL, NULL, NULL, NULL, NULL);
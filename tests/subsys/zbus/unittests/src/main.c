@@ -358,6 +358,12 @@ static bool check_chan_iterator(const struct zbus_channel *chan)
 	case 6:
 		zassert_mem_equal__(zbus_chan_name(chan), "version_chan", 12, "Must be equal");
 		break;
+#if defined(CONFIG_ZBUS_CHANNEL_SEQLOCK)
+	case 7:
+		zassert_mem_equal__(zbus_chan_name(chan), "version_seqlock_chan", 20,
+				    "Must be equal");
+		break;
+#endif
 	default:
 		zassert_unreachable(NULL);
 	}
@@ -536,6 +542,50 @@ ZTEST(basic, test_specification_based__zbus_obs_set_enable)
 	zassert_equal(0, zbus_chan_rm_obs(&aux1_chan, &rt_fast_lis, K_MSEC(200)), NULL);
 }
 
+#if defined(CONFIG_ZBUS_CHANNEL_SEQLOCK)
+ZBUS_CHAN_SEQLOCK_DEFINE(version_seqlock_chan, /* Name */
+			 struct version_msg,   /* Message type */
+
+			 NULL,			   /* Validator */
+			 NULL,			   /* User data */
+			 ZBUS_OBSERVERS(fast_lis), /* observers */
+			 ZBUS_MSG_INIT(0)	   /* Initial value */
+);
+
+ZTEST(basic, test_seqlock_channel)
+{
+	struct version_msg msg = {.major = 1, .minor = 2, .build = 3};
+	struct version_msg current = {0};
+
+	count_fast = 0;
+
+	zassert_equal(0, zbus_chan_pub(&version_seqlock_chan, &msg, K_NO_WAIT), NULL);
+	zassert_equal(1, count_fast, "Listener must be notified");
+	zassert_equal(0, atomic_get(version_seqlock_chan.seq) & 1,
+		      "Message must not be changing");
+
+	zassert_equal(0, zbus_chan_read(&version_seqlock_chan, &current, K_NO_WAIT), NULL);
+	zassert_mem_equal(&msg, &current, sizeof(msg), "Read message must be the published one");
+
+	/* The message changed in place is read once the channel is finished */
+	zassert_equal(0, zbus_chan_claim(&version_seqlock_chan, K_NO_WAIT), NULL);
+	zassert_equal(1, atomic_get(version_seqlock_chan.seq) & 1, "Message must be changing");
+	((struct version_msg *)zbus_chan_msg(&version_seqlock_chan))->build = 10;
+	zassert_equal(0, zbus_chan_finish(&version_seqlock_chan), NULL);
+	zassert_equal(0, atomic_get(version_seqlock_chan.seq) & 1,
+		      "Message must not be changing");
+
+	zassert_equal(0, zbus_chan_read(&version_seqlock_chan, &current, K_NO_WAIT), NULL);
+	zassert_equal(10, current.build, "Read message must be the changed one");
+	zassert_equal(-EFAULT, zbus_chan_read(&version_seqlock_chan, NULL, K_NO_WAIT), NULL);
+}
+#else
+ZTEST(basic, test_seqlock_channel)
+{
+	ztest_test_skip();
+}
+#endif
+
 ZBUS_SUBSCRIBER_DEFINE(foo_sub, 1);
 
 static void isr_sub_wait(const void *operation)
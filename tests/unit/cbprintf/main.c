@@ -76,6 +76,13 @@
 #define CONFIG_LOG 0
 #endif
 
+#ifdef CONFIG_CBPRINTF_FORMAT_PLAN_CACHE
+/* The host linker places the read-only data between the text and the data */
+extern const char etext[];
+extern const char __data_start[];
+#define CBPRINTF_TEST_FORMAT_IS_CONST(fmt) (((fmt) >= etext) && ((fmt) < __data_start))
+#endif
+
 #include <zephyr/sys/cbprintf.h>
 #include "../../../lib/os/cbprintf.c"
 
@@ -1334,6 +1341,49 @@ ZTEST(prf, test_cbpprintf)
 	zassert_equal(rc, -EINVAL);
 }
 
+ZTEST(prf, test_cbprintf_format_plan)
+{
+	if (!IS_ENABLED(CONFIG_CBPRINTF_FORMAT_PLAN_CACHE)) {
+		TC_PRINT("disabled\n");
+		return;
+	}
+
+	static const char fmt_many[] = "%d %d %d %d %d %d %d %d %d %d";
+	char fmt[] = "<%d>";	/* not const */
+	int rc;
+
+	/* The plan is built on the first use, and used on the next ones,
+	 * the conversions beyond the plan being parsed.
+	 */
+	for (int i = 0; i < 2; i++) {
+		reset_out();
+		rc = cbprintf(out, &outbuf, fmt_many,
+			      0, 1, 2, 3, 4, 5, 6, 7, 8, 9);
+		outbuf_null_terminate(&outbuf);
+		zassert_equal(rc, 19);
+		zassert_equal(strcmp(buf, "0 1 2 3 4 5 6 7 8 9"), 0,
+			      "got '%s'", buf);
+
+		reset_out();
+		rc = cbprintf(out, &outbuf, "[%-*.*s]", 6, 2, "abcd");
+		outbuf_null_terminate(&outbuf);
+		zassert_equal(rc, 8);
+		zassert_equal(strcmp(buf, "[ab    ]"), 0, "got '%s'", buf);
+	}
+
+	/* A format which may change is not planned */
+	reset_out();
+	rc = cbprintf(out, &outbuf, fmt, 255);
+	outbuf_null_terminate(&outbuf);
+	zassert_equal(strcmp(buf, "<255>"), 0, "got '%s'", buf);
+
+	fmt[2] = 'x';
+	reset_out();
+	rc = cbprintf(out, &outbuf, fmt, 255);
+	outbuf_null_terminate(&outbuf);
+	zassert_equal(strcmp(buf, "<ff>"), 0, "got '%s'", buf);
+}
+
 ZTEST(prf, test_nop)
 {
 }
@@ -1377,6 +1427,9 @@ static void *cbprintf_setup(void)
 	if (IS_ENABLED(CONFIG_CBPRINTF_LIBC_SUBSTS)) {
 		TC_PRINT(" LIBC_SUBSTS\n");
 	}
+	if (IS_ENABLED(CONFIG_CBPRINTF_FORMAT_PLAN_CACHE)) {
+		TC_PRINT(" FORMAT_PLAN_CACHE\n");
+	}
 
 	printf("sizeof:  int=%zu long=%zu ptr=%zu long long=%zu double=%zu long double=%zu\n",
 	       sizeof(int), sizeof(long), sizeof(void *), sizeof(long long),
@@ -50,6 +50,38 @@ ZTEST(crc, test_crc32_ieee)
 	zassert_equal(crc32_ieee(test3, sizeof(test3)), 0x20089AA4);
 }
 
+ZTEST(crc, test_crc32_ieee_lengths)
+{
+	uint8_t data[67];
+	uint32_t crc, ref;
+
+	for (size_t i = 0; i < sizeof(data); i++) {
+		data[i] = (uint8_t)(i * 37U + 11U);
+	}
+
+	/* Check against a bitwise computation all the lengths, at all the
+	 * offsets within a word, and split in two updates.
+	 */
+	for (size_t offset = 0; offset < 4; offset++) {
+		for (size_t len = 0; len <= sizeof(data) - offset; len++) {
+			ref = 0xffffffffU;
+			for (size_t i = 0; i < len; i++) {
+				ref ^= data[offset + i];
+				for (int j = 0; j < 8; j++) {
+					ref = (ref >> 1) ^ (0xedb88320U & -(ref & 1U));
+				}
+			}
+			ref = ~ref;
+
+			zassert_equal(crc32_ieee(&data[offset], len), ref);
+
+			crc = crc32_ieee_update(0, &data[offset], len / 3);
+			crc = crc32_ieee_update(crc, &data[offset + len / 3], len - len / 3);
+			zassert_equal(crc, ref);
+		}
+	}
+}
+
 ZTEST(crc, test_crc16)
 {
 	uint8_t test[] = { '1', '2', '3', '4', '5', '6', '7', '8', '9' };